@@ -185,6 +185,18 @@ def add_build_arguments(parser):
         action="store_false",
         # help="don't emit latency data in debugging logs"
     )
+    # build.log_level_threshold
+    parser.add_argument( "--log-level-threshold",
+        choices=["Verbose","Info","Warn","Error"],
+        default="Verbose",
+        help="compile out log statements below the specified level (default: Verbose)"
+    )
+    # build.trace_points
+    parser.add_argument( "--with-trace-points", "--trace-points",
+        action="store_true",
+        default=False,
+        help="compile in the engine trace points (default: False)"
+    )
     # build.output
     parser.add_argument( "--output",
         metavar="FILE",
@@ -126,6 +126,8 @@ class BuilderHandler(BaseHandler):
             "-o", f"with_unit_tests={self.get_arg('with_unit_tests',False)}",
             "-o", f"with_sensitive_logs={self.get_arg('with_sensitive_logs',False)}",
             "-o", f"with_latency_logs={self.get_arg('with_latency_logs',False)}",
+            "-o", f"log_level_threshold={self.get_arg('log_level_threshold','Verbose')}",
+            "-o", f"with_trace_points={self.get_arg('with_trace_points',False)}",
             "-o", f"with_sampleapp={self.get_arg('with_sampleapp',False)}",
             "-o", f"with_docs={self.get_arg('with_docs',True)}",
             "-s", f"build_type={'Debug' if self.get_arg('debug') else 'Release'}"
@@ -25,6 +25,26 @@ if (AAC_EMIT_LATENCY_LOGS)
     add_definitions(-DAAC_LATENCY_LOGS_ENABLED)
 endif()
 
+# Compile in the AACE_TRACE trace points of the engine.
+if (AAC_ENABLE_TRACE_POINTS)
+    add_definitions(-DAAC_TRACE_ENABLED)
+endif()
+
+# Compile out the log statements below a level (Verbose|Info|Warn|Error). Critical log
+# statements and metrics are not affected.
+if (AAC_LOG_LEVEL_THRESHOLD)
+    string(TOUPPER "${AAC_LOG_LEVEL_THRESHOLD}" AAC_LOG_LEVEL_THRESHOLD_UPPER)
+    if (AAC_LOG_LEVEL_THRESHOLD_UPPER STREQUAL "INFO")
+        add_definitions(-DAAC_LOG_LEVEL_THRESHOLD=1)
+    elseif (AAC_LOG_LEVEL_THRESHOLD_UPPER STREQUAL "WARN")
+        add_definitions(-DAAC_LOG_LEVEL_THRESHOLD=3)
+    elseif (AAC_LOG_LEVEL_THRESHOLD_UPPER STREQUAL "ERROR")
+        add_definitions(-DAAC_LOG_LEVEL_THRESHOLD=4)
+    elseif (NOT AAC_LOG_LEVEL_THRESHOLD_UPPER STREQUAL "VERBOSE")
+        message(FATAL_ERROR "Unknown log level threshold: ${AAC_LOG_LEVEL_THRESHOLD}")
+    endif()
+endif()
+
 # NOTE: we should remove this when we get rid of the rapidjson dependencies
 add_definitions(-DRAPIDJSON_HAS_STDSTRING)
 
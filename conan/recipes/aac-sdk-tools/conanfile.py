@@ -20,6 +20,8 @@ class AacSdkTools(ConanFile):
         "with_unit_tests": [True,False],
         "with_sensitive_logs": [True,False],
         "with_latency_logs": [True,False],
+        "log_level_threshold": ["Verbose","Info","Warn","Error"],
+        "with_trace_points": [True,False],
         "with_sampleapp": [True,False],
         "with_docs": [True,False]
     }
@@ -32,6 +34,8 @@ class AacSdkTools(ConanFile):
         "with_unit_tests": False,
         "with_sensitive_logs": False,
         "with_latency_logs": False,
+        "log_level_threshold": "Verbose",
+        "with_trace_points": False,
         "with_sampleapp": False,
         "with_docs": True
     }
@@ -50,6 +54,8 @@ class AacSdkTools(ConanFile):
                 self.options[req].with_unit_tests = self.options.with_unit_tests
                 self.options[req].with_sensitive_logs = self.options.with_sensitive_logs
                 self.options[req].with_latency_logs = self.options.with_latency_logs
+                self.options[req].log_level_threshold = self.options.log_level_threshold
+                self.options[req].with_trace_points = self.options.with_trace_points
                 self.options[req].with_docs = self.options.with_docs
         if self.options.with_sampleapp:
             if self.settings.os == "Android":
@@ -142,10 +148,13 @@ class BaseSdkModule(object):
         "with_aasb": [True, False],
         "with_messages": [True,False],
         "with_unit_tests": [True, False],
+        "with_benchmarks": [True, False],
         "with_jni": [True, False],
         "with_android_libs": [True, False],
         "with_sensitive_logs": [True, False],
         "with_latency_logs": [True, False],
+        "log_level_threshold": ["Verbose", "Info", "Warn", "Error"],
+        "with_trace_points": [True, False],
         "with_coverage_tests": [True, False],
         "with_address_sanitizer": [True, False],
         "with_docs": [True, False],
@@ -158,10 +167,13 @@ class BaseSdkModule(object):
         "with_aasb": True,
         "with_messages": True,
         "with_unit_tests": False,
+        "with_benchmarks": False,
         "with_jni": True,
         "with_android_libs": True,
         "with_sensitive_logs": False,
         "with_latency_logs": False,
+        "log_level_threshold": "Verbose",
+        "with_trace_points": False,
         "with_coverage_tests": False,
         "with_address_sanitizer": False,
         "with_docs": True,
@@ -306,14 +318,20 @@ class BaseSdkModule(object):
         # can only have unit tests with engine
         if self.options.with_unit_tests and not self.options.with_engine:
             raise ConanInvalidConfiguration("Unit tests are not supported unless building with engine!")
+        # benchmarks drive the engine implementation directly
+        if self.options.with_benchmarks and not self.options.with_engine:
+            raise ConanInvalidConfiguration("Benchmarks are not supported unless building with engine!")
 
     def get_cmake_definitions(self):
         return {
             "AAC_EMIT_SENSITIVE_LOGS": utils.bool_value(self.options.with_sensitive_logs,"1","0"),
             "AAC_EMIT_LATENCY_LOGS": utils.bool_value(self.options.with_latency_logs,"1","0"),
+            "AAC_LOG_LEVEL_THRESHOLD": self.options.log_level_threshold,
+            "AAC_ENABLE_TRACE_POINTS": utils.bool_value(self.options.with_trace_points,"1","0"),
             "AAC_ENABLE_COVERAGE": utils.bool_value(self.options.with_coverage_tests,"1","0"),
             "AAC_ENABLE_ADDRESS_SANITIZER": utils.bool_value(self.options.with_address_sanitizer,"1","0"),
             "AAC_ENABLE_UNIT_TESTS": utils.bool_value(self.options.get_safe("with_unit_tests", default=False),"1","0"),
+            "AAC_ENABLE_BENCHMARKS": utils.bool_value(self.options.get_safe("with_benchmarks", default=False),"1","0"),
             "CONAN_SYSTEM_INCLUDES": "OFF"
         }
 
@@ -86,6 +86,11 @@ def imports( obj, dest_folder ):
             out.write( f"set(AAC_UNIT_TESTS{cmake_file_path_sep}" )
             out.writelines( cmake_file_path_sep.join( utils.list_files( source_path, "testing/unit/tests", "cpp", False, False ) ) )
             out.write( ")\n" )
+        # write benchmark sources cmake variable list
+        if obj.options.get_safe( "with_benchmarks", default=False ):
+            out.write( f"set(AAC_BENCHMARKS{cmake_file_path_sep}" )
+            out.writelines( cmake_file_path_sep.join( utils.list_files( source_path, "testing/benchmark", "cpp", False, False ) ) )
+            out.write( ")\n" )
 
         # write includes cmake variable list
         out.write( f"set(AAC_INCLUDES{cmake_file_path_sep}" )
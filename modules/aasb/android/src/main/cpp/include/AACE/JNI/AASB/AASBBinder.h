@@ -32,6 +32,9 @@ public:
 
 private:
     JObject m_obj;
+
+    // the method receiving the UTF-8 bytes of the messages, resolved once
+    JMethod m_messageReceivedMethod;
 };
 
 class AASBBinder : public aace::jni::core::PlatformInterfaceBinder {
@@ -28,13 +28,23 @@ AASBBinder::AASBBinder(jobject obj) {
 }
 
 AASBHandler::AASBHandler(jobject obj) : m_obj(obj, "com/amazon/aace/aasb/AASB") {
+    try_with_context {
+        m_messageReceivedMethod = m_obj.getMethod("messageReceivedUtf8", "([B)V");
+        ThrowIfNull(m_messageReceivedMethod, "invalidMessageReceivedMethod");
+    }
+    catch_with_ex {
+        AACE_JNI_ERROR(TAG, "AASBHandler", ex.what());
+    }
 }
 
 void AASBHandler::messageReceived(const std::string& message) {
     try_with_context {
-        ThrowIfNot(
-            m_obj.invoke<void>("messageReceived", "(Ljava/lang/String;)V", nullptr, JString(message).get()),
-            "invokeFailed");
+        // the message is passed as its UTF-8 bytes, which Java decodes
+        jbyteArray bytes = JString::newUtf8Bytes(env, message);
+        ThrowIfNull(bytes, "createMessageBytesFailed");
+        bool delivered = m_obj.invoke<void>(m_messageReceivedMethod, nullptr, bytes);
+        env->DeleteLocalRef(bytes);
+        ThrowIfNot(delivered, "invokeFailed");
     }
     catch_with_ex {
         AACE_JNI_ERROR(TAG, "messageReceived", ex.what());
@@ -68,12 +78,12 @@ JNIEXPORT void JNICALL Java_com_amazon_aace_aasb_AASB_disposeBinder(JNIEnv* env,
 }
 
 JNIEXPORT void JNICALL
-Java_com_amazon_aace_aasb_AASB_publish(JNIEnv* env, jobject /* this */, jlong ref, jstring message) {
+Java_com_amazon_aace_aasb_AASB_publish(JNIEnv* env, jobject /* this */, jlong ref, jbyteArray message) {
     try {
         auto aasbBinder = AASB_BINDER(ref);
         ThrowIfNull(aasbBinder, "invalidAASBBinder");
 
-        aasbBinder->getAASB()->publish(JString(message).toStdStr());
+        aasbBinder->getAASB()->publish(JString::fromUtf8Bytes(env, message));
     } catch (const std::exception& ex) {
         AACE_JNI_ERROR(TAG, "Java_com_amazon_aace_aasb_AASB_publish", ex.what());
     }
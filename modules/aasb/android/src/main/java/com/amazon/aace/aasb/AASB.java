@@ -17,6 +17,8 @@ package com.amazon.aace.aasb;
 
 import com.amazon.aace.core.PlatformInterface;
 
+import java.nio.charset.StandardCharsets;
+
 /**
  * The @c AASB class should be extended by to provide an implementation of the AASB interface.
  */
@@ -24,13 +26,19 @@ abstract public class AASB extends PlatformInterface {
     public void messageReceived(String message) {}
 
     public final void publish(String message) {
-        publish(getNativeRef(), message);
+        // the message is passed as its UTF-8 bytes, rather than converted by JNI to modified UTF-8
+        publish(getNativeRef(), message.getBytes(StandardCharsets.UTF_8));
     }
 
     public final AASBStream openStream(String streamId, AASBStream.Mode mode) {
         return openStream(getNativeRef(), streamId, mode);
     }
 
+    // called by the Engine with the UTF-8 bytes of a message
+    private void messageReceivedUtf8(byte[] message) {
+        messageReceived(new String(message, StandardCharsets.UTF_8));
+    }
+
     // NativeRef implementation
     final protected long createNativeRef() {
         return createBinder();
@@ -43,7 +51,7 @@ abstract public class AASB extends PlatformInterface {
     // Native Engine JNI methods
     private native long createBinder();
     private native void disposeBinder(long nativeRef);
-    private native void publish(long nativeRef, String message);
+    private native void publish(long nativeRef, byte[] message);
     private native AASBStream openStream(long nativeRef, String streamId, AASBStream.Mode mode);
 }
 
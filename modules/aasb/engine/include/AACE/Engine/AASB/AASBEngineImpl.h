@@ -19,13 +19,17 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <AACE/AASB/AASB.h>
 #include <AACE/AASB/AASBEngineInterfaces.h>
 
 #include <AACE/Engine/MessageBroker/MessageBrokerInterface.h>
+#include <AACE/Engine/MessageBroker/MessageBrokerServiceInterface.h>
 #include <AACE/Engine/MessageBroker/StreamManagerInterface.h>
 
+#include "PlatformDeliveryQueue.h"
+
 namespace aace {
 namespace engine {
 namespace aasb {
@@ -38,26 +42,40 @@ private:
 
     bool initialize(
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager);
+        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+        const aace::engine::messageBroker::MessageBrokerServiceInterface::PlatformDeliveryConfig& deliveryConfig);
+
+    // delivers an outgoing message through the AASB platform interface
+    void deliver(const aace::engine::messageBroker::Message& message);
 
 public:
-    virtual ~AASBEngineImpl() = default;
+    virtual ~AASBEngineImpl();
 
     static std::shared_ptr<AASBEngineImpl> create(
         std::shared_ptr<aace::aasb::AASB> aasbPlatformInterface,
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager);
+        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+        const aace::engine::messageBroker::MessageBrokerServiceInterface::PlatformDeliveryConfig& deliveryConfig =
+            aace::engine::messageBroker::MessageBrokerServiceInterface::PlatformDeliveryConfig());
+
+    // stops the delivery of the outgoing messages
+    void shutdown();
 
     // aace::aasb::AASBEngineInterface
     void onPublish(const std::string& message) override;
+    void onPublish(const std::vector<uint8_t>& message) override;
     std::shared_ptr<aace::aasb::AASBStream> onOpenStream(
         const std::string& streamId,
         aace::core::MessageStream::Mode mode) override;
 
 private:
     std::shared_ptr<aace::aasb::AASB> m_aasbPlatformInterface;
+    aace::aasb::AASB::WireFormat m_wireFormat;
     std::weak_ptr<aace::engine::messageBroker::MessageBrokerInterface> m_messageBroker;
     std::weak_ptr<aace::engine::messageBroker::StreamManagerInterface> m_streamManager;
+
+    // the queue of the outgoing messages, or nullptr if they are delivered on the dispatching thread
+    std::unique_ptr<PlatformDeliveryQueue> m_deliveryQueue;
 };
 
 }  // namespace aasb
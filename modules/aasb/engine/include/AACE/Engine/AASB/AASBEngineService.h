@@ -42,6 +42,7 @@ protected:
     bool configure(std::shared_ptr<std::istream> configuration) override;
     bool start() override;
     bool stop() override;
+    bool shutdown() override;
 
     bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) override;
 
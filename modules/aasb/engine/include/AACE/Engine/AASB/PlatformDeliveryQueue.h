@@ -0,0 +1,112 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_AASB_PLATFORM_DELIVERY_QUEUE_H
+#define AACE_ENGINE_AASB_PLATFORM_DELIVERY_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <AACE/Engine/MessageBroker/Message.h>
+#include <AACE/Engine/MessageBroker/MessageBrokerServiceInterface.h>
+
+namespace aace {
+namespace engine {
+namespace aasb {
+
+/**
+ * Delivers the outgoing messages to the platform on a dedicated thread, so a slow platform handler doesn't block
+ * the message broker thread dispatching the messages.
+ *
+ * The messages are delivered in the order they are pushed. When the queue is full, the overflow policy of the
+ * topic of a message decides whether the message waits for room, drops the oldest queued message of the topic,
+ * or is dropped.
+ */
+class PlatformDeliveryQueue {
+public:
+    using Message = aace::engine::messageBroker::Message;
+    using OverflowPolicy = aace::engine::messageBroker::MessageBrokerServiceInterface::OverflowPolicy;
+    using PlatformDeliveryConfig = aace::engine::messageBroker::MessageBrokerServiceInterface::PlatformDeliveryConfig;
+
+    /// Delivers a message to the platform.
+    using DeliveryHandler = std::function<void(const Message& message)>;
+
+    /**
+     * Creates a @c PlatformDeliveryQueue and starts its delivery thread.
+     *
+     * @param handler The function delivering the messages to the platform.
+     * @param config The size of the queue, which must not be 0, and the overflow policies.
+     * @return The @c PlatformDeliveryQueue, or @c nullptr if the parameters are invalid.
+     */
+    static std::unique_ptr<PlatformDeliveryQueue> create(DeliveryHandler handler, const PlatformDeliveryConfig& config);
+
+    ~PlatformDeliveryQueue();
+
+    /**
+     * Queues a message for the platform. A message with the @c BLOCK policy waits for room in the queue, unless it
+     * is pushed by the delivery thread itself.
+     *
+     * @param message The message to deliver.
+     * @return @c false if the message was dropped.
+     */
+    bool push(const Message& message);
+
+    /// Stops the delivery thread, the messages still queued are dropped.
+    void shutdown();
+
+private:
+    PlatformDeliveryQueue(DeliveryHandler handler, const PlatformDeliveryConfig& config);
+
+    /// A queued message and the time it was pushed
+    struct Entry {
+        Message message;
+        std::chrono::steady_clock::time_point pushed;
+    };
+
+    /// Returns the overflow policy of a topic.
+    OverflowPolicy getOverflowPolicy(const std::string& topic) const;
+
+    /// Delivers the queued messages until the queue is shut down.
+    void deliveryLoop();
+
+    DeliveryHandler m_handler;
+    size_t m_queueSize;
+    std::unordered_map<std::string, OverflowPolicy> m_overflowPolicies;
+    OverflowPolicy m_defaultOverflowPolicy;
+
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::deque<Entry> m_queue;
+    bool m_isShutdown = false;
+
+    /// The number of delivered messages, to sample the queue latency
+    uint64_t m_deliveredCount = 0;
+
+    std::thread m_thread;
+};
+
+}  // namespace aasb
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_AASB_PLATFORM_DELIVERY_QUEUE_H
@@ -16,6 +16,8 @@
 #include <AACE/Engine/AASB/AASBEngineImpl.h>
 #include <AACE/Engine/Core/EngineMacros.h>
 
+#include <nlohmann/json.hpp>
+
 namespace aace {
 namespace engine {
 namespace aasb {
@@ -24,13 +26,18 @@ namespace aasb {
 static const std::string TAG("aace.aasb.AASBEngineImpl");
 
 AASBEngineImpl::AASBEngineImpl(std::shared_ptr<aace::aasb::AASB> aasbPlatformInterface) :
-        m_aasbPlatformInterface(aasbPlatformInterface) {
+        m_aasbPlatformInterface(aasbPlatformInterface), m_wireFormat(aace::aasb::AASB::WireFormat::JSON) {
+}
+
+AASBEngineImpl::~AASBEngineImpl() {
+    shutdown();
 }
 
 std::shared_ptr<AASBEngineImpl> AASBEngineImpl::create(
     std::shared_ptr<aace::aasb::AASB> aasbPlatformInterface,
     std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager) {
+    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+    const aace::engine::messageBroker::MessageBrokerServiceInterface::PlatformDeliveryConfig& deliveryConfig) {
     std::shared_ptr<AASBEngineImpl> aasbEngineImpl = nullptr;
 
     try {
@@ -40,7 +47,8 @@ std::shared_ptr<AASBEngineImpl> AASBEngineImpl::create(
         ThrowIfNull(messageBroker, "invalidMessageBrokerInterface");
         ThrowIfNull(streamManager, "invalidStreamManagerInterface");
 
-        ThrowIfNot(aasbEngineImpl->initialize(messageBroker, streamManager), "initializeFailed");
+        ThrowIfNot(
+            aasbEngineImpl->initialize(messageBroker, streamManager, deliveryConfig), "initializeFailed");
 
         // set the engine interface
         aasbPlatformInterface->setEngineInterface(aasbEngineImpl);
@@ -54,20 +62,37 @@ std::shared_ptr<AASBEngineImpl> AASBEngineImpl::create(
 
 bool AASBEngineImpl::initialize(
     std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager) {
+    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+    const aace::engine::messageBroker::MessageBrokerServiceInterface::PlatformDeliveryConfig& deliveryConfig) {
     try {
         m_messageBroker = messageBroker;
         m_streamManager = streamManager;
+        m_wireFormat = m_aasbPlatformInterface->getWireFormat();
+
+        // deliver the outgoing messages on a dedicated thread, so a slow platform handler doesn't block the
+        // message broker dispatch
+        std::weak_ptr<AASBEngineImpl> wp = shared_from_this();
+        if (deliveryConfig.queueSize > 0) {
+            m_deliveryQueue = PlatformDeliveryQueue::create(
+                [wp](const aace::engine::messageBroker::Message& message) {
+                    if (auto sp = wp.lock()) {
+                        sp->deliver(message);
+                    }
+                },
+                deliveryConfig);
+            ThrowIfNull(m_deliveryQueue, "createDeliveryQueueFailed");
+        }
 
         // subscribe to all outgoing messages from the message broker, and route them
         // through the AASB platform interface...
-        std::weak_ptr<AASBEngineImpl> wp = shared_from_this();
         messageBroker->subscribe(
             "*",
             [wp](const aace::engine::messageBroker::Message& message) {
                 if (auto sp = wp.lock()) {
-                    if (sp->m_aasbPlatformInterface != nullptr) {
-                        sp->m_aasbPlatformInterface->messageReceived(message.str());
+                    if (sp->m_deliveryQueue != nullptr) {
+                        sp->m_deliveryQueue->push(message);
+                    } else {
+                        sp->deliver(message);
                     }
                 } else {
                     AACE_ERROR(LX(TAG, "initialize").d("reason", "invalidWeakPtrReference"));
@@ -82,11 +107,31 @@ bool AASBEngineImpl::initialize(
     }
 }
 
+void AASBEngineImpl::deliver(const aace::engine::messageBroker::Message& message) {
+    if (m_aasbPlatformInterface == nullptr) {
+        return;
+    }
+    AACE_TRACE_SCOPE("platform", message.topic());
+    // binary messages are encoded from the parsed message, without serializing it as JSON text
+    if (m_wireFormat == aace::aasb::AASB::WireFormat::BINARY) {
+        m_aasbPlatformInterface->messageReceived(message.binary());
+    } else {
+        m_aasbPlatformInterface->messageReceived(message.str());
+    }
+}
+
+void AASBEngineImpl::shutdown() {
+    if (m_deliveryQueue != nullptr) {
+        m_deliveryQueue->shutdown();
+    }
+}
+
 //
 // aace::aasb::AASBEngineInterface
 //
 
 void AASBEngineImpl::onPublish(const std::string& message) {
+    AACE_TRACE_SCOPE("platform", "AASB.onPublish");
     try {
         auto m_messageBroker_lock = m_messageBroker.lock();
         ThrowIfNull(m_messageBroker_lock, "invalidMessageBrokerReference");
@@ -97,6 +142,22 @@ void AASBEngineImpl::onPublish(const std::string& message) {
     }
 }
 
+void AASBEngineImpl::onPublish(const std::vector<uint8_t>& message) {
+    AACE_TRACE_SCOPE("platform", "AASB.onPublish");
+    try {
+        auto m_messageBroker_lock = m_messageBroker.lock();
+        ThrowIfNull(m_messageBroker_lock, "invalidMessageBrokerReference");
+
+        // the message broker routes messages by their text, so the message is published as compact JSON
+        auto json = nlohmann::json::from_cbor(message, true, false);
+        ThrowIf(json.is_discarded(), "invalidBinaryMessage");
+
+        m_messageBroker_lock->publish(json.dump(), aace::engine::messageBroker::Message::Direction::INCOMING).send();
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    }
+}
+
 std::shared_ptr<aace::aasb::AASBStream> AASBEngineImpl::onOpenStream(
     const std::string& streamId,
     aace::aasb::AASBStream::Mode mode) {
@@ -85,6 +85,18 @@ bool AASBEngineService::stop() {
     }
 }
 
+bool AASBEngineService::shutdown() {
+    try {
+        if (m_aasbEngineImpl != nullptr) {
+            m_aasbEngineImpl->shutdown();
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool AASBEngineService::registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) {
     try {
         ReturnIf(registerPlatformInterfaceType<aace::aasb::AASB>(platformInterface), true);
@@ -105,7 +117,10 @@ bool AASBEngineService::registerPlatformInterfaceType(std::shared_ptr<aace::aasb
         ThrowIfNull(messageBrokerServiceInterface, "invalidMessageBrokerServiceInterface");
 
         m_aasbEngineImpl = AASBEngineImpl::create(
-            aasb, messageBrokerServiceInterface->getMessageBroker(), messageBrokerServiceInterface->getStreamManager());
+            aasb,
+            messageBrokerServiceInterface->getMessageBroker(),
+            messageBrokerServiceInterface->getStreamManager(),
+            messageBrokerServiceInterface->getPlatformDeliveryConfig());
         ThrowIfNull(m_aasbEngineImpl, "createAASBEngineImplFailed");
 
         return true;
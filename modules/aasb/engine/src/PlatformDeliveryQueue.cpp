@@ -0,0 +1,187 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/AASB/PlatformDeliveryQueue.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+
+namespace aace {
+namespace engine {
+namespace aasb {
+
+using namespace aace::engine::utils::metrics;
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.aasb.PlatformDeliveryQueue");
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "AASBDelivery";
+
+/// Metric for the time a sampled message waited in the queue
+static const std::string METRIC_QUEUE_LATENCY = "QueueLatency";
+
+/// Metric for the number of messages queued when a sampled message was delivered
+static const std::string METRIC_QUEUE_DEPTH = "QueueDepth";
+
+/// Metric for a message dropped because the queue was full
+static const std::string METRIC_DROPPED = "Dropped";
+
+/// Metric for the topic of a message
+static const std::string METRIC_MESSAGE_TOPIC = "Topic";
+
+/// One of every @c QUEUE_LATENCY_SAMPLE_INTERVAL delivered messages emits its queue latency
+static const uint64_t QUEUE_LATENCY_SAMPLE_INTERVAL = 100;
+
+std::unique_ptr<PlatformDeliveryQueue> PlatformDeliveryQueue::create(
+    DeliveryHandler handler,
+    const PlatformDeliveryConfig& config) {
+    try {
+        ThrowIfNot(handler, "invalidDeliveryHandler");
+        ThrowIf(config.queueSize == 0, "invalidQueueSize");
+        return std::unique_ptr<PlatformDeliveryQueue>(new PlatformDeliveryQueue(std::move(handler), config));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+PlatformDeliveryQueue::PlatformDeliveryQueue(DeliveryHandler handler, const PlatformDeliveryConfig& config) :
+        m_handler(std::move(handler)),
+        m_queueSize(config.queueSize),
+        m_overflowPolicies(config.overflowPolicies),
+        m_defaultOverflowPolicy(OverflowPolicy::BLOCK) {
+    auto it = m_overflowPolicies.find("*");
+    if (it != m_overflowPolicies.end()) {
+        m_defaultOverflowPolicy = it->second;
+        m_overflowPolicies.erase(it);
+    }
+    m_thread = std::thread(&PlatformDeliveryQueue::deliveryLoop, this);
+}
+
+PlatformDeliveryQueue::~PlatformDeliveryQueue() {
+    shutdown();
+}
+
+PlatformDeliveryQueue::OverflowPolicy PlatformDeliveryQueue::getOverflowPolicy(const std::string& topic) const {
+    auto it = m_overflowPolicies.find(topic);
+    return it != m_overflowPolicies.end() ? it->second : m_defaultOverflowPolicy;
+}
+
+bool PlatformDeliveryQueue::push(const Message& message) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_isShutdown) {
+        return false;
+    }
+    if (m_queue.size() >= m_queueSize) {
+        auto topic = message.topic();
+        auto policy = getOverflowPolicy(topic);
+        // the delivery thread can't wait for itself to take a message, so its messages overflow the queue
+        if (policy == OverflowPolicy::BLOCK && std::this_thread::get_id() != m_thread.get_id()) {
+            m_notFull.wait(lock, [this] { return m_isShutdown || m_queue.size() < m_queueSize; });
+            if (m_isShutdown) {
+                return false;
+            }
+        } else if (policy == OverflowPolicy::DROP_OLDEST || policy == OverflowPolicy::DROP_NEWEST) {
+            auto dropped = m_queue.end();
+            if (policy == OverflowPolicy::DROP_OLDEST) {
+                for (auto it = m_queue.begin(); it != m_queue.end(); it++) {
+                    if (it->message.topic() == topic) {
+                        dropped = it;
+                        break;
+                    }
+                }
+            }
+            bool dropNewest = dropped == m_queue.end();
+            if (!dropNewest) {
+                m_queue.erase(dropped);
+                m_queue.push_back({message, std::chrono::steady_clock::now()});
+            }
+            lock.unlock();
+
+            AACE_WARN(LX(TAG).m("messageDropped").d("topic", topic).d("queueSize", m_queueSize));
+            emitMetrics(
+                METRIC_PROGRAM_NAME_SUFFIX,
+                "push",
+                {{METRIC_DROPPED, 1}},
+                {{METRIC_MESSAGE_TOPIC, topic}},
+                {});
+            return !dropNewest;
+        }
+    }
+    m_queue.push_back({message, std::chrono::steady_clock::now()});
+    AACE_TRACE_COUNTER("platform", "AASB.deliveryQueue", static_cast<int64_t>(m_queue.size()));
+    m_notEmpty.notify_one();
+    return true;
+}
+
+void PlatformDeliveryQueue::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isShutdown) {
+            return;
+        }
+        m_isShutdown = true;
+        if (!m_queue.empty()) {
+            AACE_WARN(LX(TAG).m("pendingMessagesDropped").d("count", m_queue.size()));
+            m_queue.clear();
+        }
+    }
+    m_notEmpty.notify_all();
+    m_notFull.notify_all();
+    if (m_thread.joinable() && std::this_thread::get_id() != m_thread.get_id()) {
+        m_thread.join();
+    } else if (m_thread.joinable()) {
+        // shut down by the platform handler, the thread exits once the handler returns
+        m_thread.detach();
+    }
+}
+
+void PlatformDeliveryQueue::deliveryLoop() {
+    aace::engine::utils::threading::ThreadPolicy::ScopedThread scopedThread("AASB.delivery");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_notEmpty.wait(lock, [this] { return m_isShutdown || !m_queue.empty(); });
+        if (m_isShutdown) {
+            return;
+        }
+        auto entry = std::move(m_queue.front());
+        m_queue.pop_front();
+        auto queueDepth = m_queue.size();
+        bool sampled = m_deliveredCount++ % QUEUE_LATENCY_SAMPLE_INTERVAL == 0;
+        lock.unlock();
+        m_notFull.notify_one();
+
+        if (sampled) {
+            using Milliseconds = std::chrono::duration<double, std::milli>;
+            emitMetrics(
+                METRIC_PROGRAM_NAME_SUFFIX,
+                "deliveryLoop",
+                {{METRIC_QUEUE_DEPTH, static_cast<int>(queueDepth)}},
+                {{METRIC_MESSAGE_TOPIC, entry.message.topic()}},
+                {{METRIC_QUEUE_LATENCY, Milliseconds(std::chrono::steady_clock::now() - entry.pushed).count()}});
+        }
+        try {
+            m_handler(entry.message);
+        } catch (std::exception& ex) {
+            AACE_ERROR(LX(TAG).d("reason", ex.what()).d("topic", entry.message.topic()));
+        }
+        lock.lock();
+    }
+}
+
+}  // namespace aasb
+}  // namespace engine
+}  // namespace aace
@@ -19,7 +19,9 @@
 #include <AACE/Core/PlatformInterface.h>
 #include "AASBEngineInterfaces.h"
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace aace {
 namespace aasb {
@@ -40,6 +42,37 @@ protected:
 public:
     virtual ~AASB();
 
+    /**
+     * Describes the format of the AASB messages exchanged with the Engine.
+     */
+    enum class WireFormat {
+        /**
+         * The messages are JSON text.
+         */
+        JSON,
+
+        /**
+         * The messages are CBOR encoded, and decoded with the @c fromBinary() of the generated AASB messages.
+         */
+        BINARY
+    };
+
+    /**
+     * Returns the format of the AASB messages exchanged with the Engine. The format is read once, when the
+     * platform interface is registered with the Engine. The default format is @c JSON.
+     *
+     * @return The format of the messages received by the platform implementation.
+     */
+    virtual WireFormat getWireFormat();
+
+    /**
+     * Notifies the platform implementation that an AASB message has been received from the Engine, when the
+     * wire format is @c BINARY.
+     *
+     * @param [in] message The CBOR encoded AASB message.
+     */
+    virtual void messageReceived(const std::vector<uint8_t>& message);
+
     /**
      * Notifies the platform implementation that an AASB message has been received from the Engine.
      *
@@ -57,6 +90,13 @@ public:
      */
     void publish(const std::string& message);
 
+    /**
+     * Publishes a CBOR encoded AASB message to the Engine, such as the @c toBinary() of a generated AASB message.
+     *
+     * @param [in] message The CBOR encoded AASB message.
+     */
+    void publish(const std::vector<uint8_t>& message);
+
     /**
      * Opens an AASB stream that has been registered by the Engine.
      *
@@ -16,7 +16,10 @@
 #ifndef AACE_AASB_AASB_ENGINE_INTERFACE_H
 #define AACE_AASB_AASB_ENGINE_INTERFACE_H
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "AASBStream.h"
 
@@ -26,6 +29,7 @@ namespace aasb {
 class AASBEngineInterface {
 public:
     virtual void onPublish(const std::string& message) = 0;
+    virtual void onPublish(const std::vector<uint8_t>& message) = 0;
     virtual std::shared_ptr<AASBStream> onOpenStream(const std::string& streamId, AASBStream::Mode mode) = 0;
 };
 
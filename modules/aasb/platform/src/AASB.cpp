@@ -20,6 +20,13 @@ namespace aasb {
 
 AASB::~AASB() = default;
 
+AASB::WireFormat AASB::getWireFormat() {
+    return WireFormat::JSON;
+}
+
+void AASB::messageReceived(const std::vector<uint8_t>& message) {
+}
+
 void AASB::setEngineInterface(std::shared_ptr<AASBEngineInterface> aasbEngineInterface) {
     m_aasbEngineInterface = aasbEngineInterface;
 }
@@ -34,6 +41,12 @@ void AASB::publish(const std::string& message) {
     }
 }
 
+void AASB::publish(const std::vector<uint8_t>& message) {
+    if (m_aasbEngineInterface != nullptr) {
+        m_aasbEngineInterface->onPublish(message);
+    }
+}
+
 std::shared_ptr<AASBStream> AASB::openStream(const std::string& streamId, AASBStream::Mode mode) {
     return m_aasbEngineInterface != nullptr ? m_aasbEngineInterface->onOpenStream(streamId, mode) : nullptr;
 }
@@ -20,7 +20,10 @@
 #include <thread>
 #include <deque>
 #include <unordered_map>
+#include <unordered_set>
 #include <condition_variable>
+#include <mutex>
+#include <vector>
 
 #include <AVSCommon/SDKInterfaces/AuthObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/AuthDelegateInterface.h>
@@ -28,12 +31,16 @@
 #include <AVSCommon/Utils/DeviceInfo.h>
 
 #include <AACE/Network/NetworkInfoProvider.h>
+#include <AACE/Engine/Network/BackgroundTransferScheduler.h>
 #include <AACE/Engine/Network/NetworkInfoObserver.h>
 #include <AACE/Engine/Network/NetworkObservableInterface.h>
+#include <AACE/Engine/Storage/LocalStorageInterface.h>
 
 #include "AddressBookObserver.h"
 #include "AddressBookServiceInterface.h"
 #include "AddressBookCloudUploaderRESTAgent.h"
+#include "AddressBookSyncIndex.h"
+#include "ContactNameIndex.h"
 
 namespace aace {
 namespace engine {
@@ -108,7 +115,10 @@ private:
         NetworkInfoObserver::NetworkStatus networkStatus,
         std::shared_ptr<aace::engine::network::NetworkObservableInterface> networkObserver,
         std::shared_ptr<aace::engine::alexa::AlexaEndpointInterface> alexaEndpoints,
-        bool cleanAllAddressBooksAtStart);
+        bool cleanAllAddressBooksAtStart,
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage,
+        std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler,
+        std::shared_ptr<ContactNameIndex> contactNameIndex);
 
 public:
     static std::shared_ptr<AddressBookCloudUploader> create(
@@ -118,7 +128,10 @@ public:
         NetworkInfoObserver::NetworkStatus networkStatus,
         std::shared_ptr<aace::engine::network::NetworkObservableInterface> networkObserver,
         std::shared_ptr<aace::engine::alexa::AlexaEndpointInterface> alexaEndpoints,
-        bool cleanAllAddressBooksAtStart);
+        bool cleanAllAddressBooksAtStart,
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage = nullptr,
+        std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler = nullptr,
+        std::shared_ptr<ContactNameIndex> contactNameIndex = nullptr);
 
     // AddressBookObserver
     bool addressBookAdded(std::shared_ptr<AddressBookEntity> addressBookEntity) override;
@@ -144,12 +157,34 @@ private:
 
     void eventLoop(bool cleanAllAddressBooksAtStart);  // Infinite loop
     const Event popNextEventFromQ();
+    /// Asks the background transfer scheduler for the window of the next upload. @c m_mutex must be held.
+    void requestTransferLocked();
 
     bool handleUpload(std::shared_ptr<AddressBookEntity> addressBookEntity);
     bool handleRemove(std::shared_ptr<AddressBookEntity> addressBookEntity);
 
     bool checkAndAutoProvisionAccount();
     std::string prepareForUpload(std::shared_ptr<AddressBookEntity> addressBookEntity);
+    /**
+     * Returns the cloud address book the address book was synced to, and keeps only the entries added since in
+     * @c documents. An address book whose upload was interrupted is resumed the same way, from the entries of its
+     * checkpoint. Returns an empty string if the address book must be uploaded again, because it is not synced,
+     * the cloud address book was replaced, or entries were changed or removed since the last sync.
+     */
+    std::string prepareForDeltaUpload(
+        std::shared_ptr<AddressBookEntity> addressBookEntity,
+        const AddressBookSyncIndex::EntryHashes& entryHashes,
+        std::vector<std::shared_ptr<rapidjson::Document>>& documents);
+    /**
+     * Uploads the batches of entries to the cloud address book, with up to @c MAX_CONCURRENT_BATCH_UPLOADS batches in
+     * flight. Each batch is released once uploaded, and added to the checkpoint of the upload. If a batch fails, the
+     * remaining batches are not uploaded. The cloud address book is kept for the next attempt to resume the upload,
+     * or deleted if the local storage is not available.
+     */
+    bool uploadDocuments(
+        const std::string& addressBookSourceId,
+        const std::string& cloudAddressBookId,
+        std::vector<std::shared_ptr<rapidjson::Document>>& documents);
     bool upload(const std::string& cloudAddressBookId, std::shared_ptr<rapidjson::Document>);
     bool uploadEntries(const std::string& cloudAddressBookId, std::shared_ptr<rapidjson::Document> document);
 
@@ -168,7 +203,7 @@ private:
         std::shared_ptr<rapidjson::Document> document,
         HTTPResponse& httpResponse);
     UploadFlowState handleParseHTTPResponse(const HTTPResponse& httpResponse);
-    UploadFlowState handleError(const std::string& addressBookId);
+    void handleError(const std::string& addressBookId);
 
     void logNetworkMetrics(const HTTPResponse& httpResponse);
 
@@ -203,6 +238,21 @@ private:
     NetworkInfoObserver::NetworkStatus m_networkStatus;
 
     std::thread m_eventThread;
+
+    /// Defers the uploads on a weak wifi signal, a metered link or during a voice interaction, null if not available
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> m_backgroundTransferScheduler;
+    bool m_isTransferRequested = false;
+    bool m_isTransferAllowed = false;
+
+    /// Sync state of the uploaded address books, null if the local storage is not available
+    std::shared_ptr<AddressBookSyncIndex> m_syncIndex;
+
+    /// Names of the contacts of the address books, for the resolution on the device, null if not available
+    std::shared_ptr<ContactNameIndex> m_contactNameIndex;
+
+    /// Entries the cloud failed to add during the current upload, protected by m_failedEntriesMutex
+    std::unordered_set<std::string> m_failedEntryIds;
+    std::mutex m_failedEntriesMutex;
 };
 
 inline std::ostream& operator<<(std::ostream& stream, const AddressBookCloudUploader::UploadFlowState& state) {
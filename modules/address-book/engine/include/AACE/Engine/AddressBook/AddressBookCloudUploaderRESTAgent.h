@@ -29,6 +29,7 @@
 #include <AVSCommon/Utils/DeviceInfo.h>
 
 #include <AACE/Engine/Alexa/AlexaEndpointInterface.h>
+#include <AACE/Engine/Alexa/HttpClientPool.h>
 #include "AACE/Engine/Utils/JSON/JSON.h"
 
 namespace aace {
@@ -118,7 +119,9 @@ private:
         const std::string& url,
         const std::vector<std::string> headerLines,
         const std::string& data,
-        std::chrono::seconds timeout);
+        std::chrono::seconds timeout,
+        aace::engine::alexa::HttpClientPool::ContentEncoding encoding =
+            aace::engine::alexa::HttpClientPool::ContentEncoding::IDENTITY);
     HTTPResponse doGet(const std::string& url, const std::vector<std::string>& headers);
     HTTPResponse doDelete(const std::string& url, const std::vector<std::string>& headers);
 
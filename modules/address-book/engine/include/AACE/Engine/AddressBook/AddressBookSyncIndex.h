@@ -0,0 +1,174 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ADDRESS_BOOK_ADDRESS_BOOK_SYNC_INDEX_H
+#define AACE_ENGINE_ADDRESS_BOOK_ADDRESS_BOOK_SYNC_INDEX_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <AACE/Engine/Storage/LocalStorageInterface.h>
+
+namespace aace {
+namespace engine {
+namespace addressBook {
+
+/**
+ * Persists the state of the address books synced to the cloud: for each address book source, the id of the cloud
+ * address book it was uploaded to, and a content hash of each of its entries. The next upload of the address book
+ * compares the hashes of its entries to find the entries added, changed or removed since.
+ *
+ * The index also persists a checkpoint of each upload in progress: the cloud address book the entries are uploaded
+ * to, and the hashes of the entries the cloud acknowledged so far. An upload interrupted by a network loss or an
+ * Engine shutdown is resumed from its checkpoint instead of uploading the whole address book again.
+ */
+class AddressBookSyncIndex {
+public:
+    /// Maps the id of an entry to the hash of its content
+    using EntryHashes = std::unordered_map<std::string, std::string>;
+
+    /// The entries added, changed and removed between two versions of an address book
+    struct Delta {
+        std::vector<std::string> added;
+        std::vector<std::string> changed;
+        std::vector<std::string> removed;
+    };
+
+    static std::shared_ptr<AddressBookSyncIndex> create(
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage);
+
+    /// Returns a hash of the content of an entry, which is stable across Engine runs.
+    static std::string hash(const std::string& content);
+
+    /// Returns the entries added, changed and removed from @c synced to @c current.
+    static Delta computeDelta(const EntryHashes& synced, const EntryHashes& current);
+
+    /**
+     * Loads the sync state of an address book source.
+     *
+     * @param addressBookSourceId The address book source.
+     * @param [out] cloudAddressBookId The cloud address book the source was synced to.
+     * @param [out] entryHashes The hashes of the synced entries.
+     * @return @c false if the source is not synced.
+     */
+    bool load(const std::string& addressBookSourceId, std::string& cloudAddressBookId, EntryHashes& entryHashes);
+
+    /**
+     * Saves the sync state of an address book source, replacing its previous state.
+     *
+     * @param addressBookSourceId The address book source.
+     * @param cloudAddressBookId The cloud address book the source was synced to.
+     * @param entryHashes The hashes of the synced entries.
+     * @return @c false if the state could not be saved, in which case the source is not synced.
+     */
+    bool save(
+        const std::string& addressBookSourceId,
+        const std::string& cloudAddressBookId,
+        const EntryHashes& entryHashes);
+
+    /// Forgets the sync state of an address book source.
+    bool remove(const std::string& addressBookSourceId);
+
+    /// Forgets the sync state of all the address book sources. The checkpoints of the uploads are kept.
+    bool clear();
+
+    /**
+     * Loads the checkpoint of the upload of an address book source.
+     *
+     * @param addressBookSourceId The address book source.
+     * @param [out] cloudAddressBookId The cloud address book the source is uploaded to.
+     * @param [out] entryHashes The hashes of the entries acknowledged by the cloud.
+     * @return @c false if the source has no upload in progress.
+     */
+    bool loadCheckpoint(
+        const std::string& addressBookSourceId,
+        std::string& cloudAddressBookId,
+        EntryHashes& entryHashes);
+
+    /**
+     * Starts the checkpoint of the upload of an address book source, replacing its previous checkpoint.
+     *
+     * @param addressBookSourceId The address book source.
+     * @param cloudAddressBookId The cloud address book the source is uploaded to.
+     * @param entryHashes The hashes of the entries already in the cloud address book.
+     * @return @c false if the checkpoint could not be saved.
+     */
+    bool saveCheckpoint(
+        const std::string& addressBookSourceId,
+        const std::string& cloudAddressBookId,
+        const EntryHashes& entryHashes);
+
+    /**
+     * Adds the entries of a batch acknowledged by the cloud to the checkpoint of the upload of an address book source.
+     *
+     * @param addressBookSourceId The address book source.
+     * @param entryHashes The hashes of the entries of the batch.
+     * @return @c false if the source has no upload in progress, or the checkpoint could not be saved.
+     */
+    bool addToCheckpoint(const std::string& addressBookSourceId, const EntryHashes& entryHashes);
+
+    /// Forgets the checkpoint of the upload of an address book source.
+    bool removeCheckpoint(const std::string& addressBookSourceId);
+
+    /**
+     * Forgets the checkpoints which were not updated for @c maxAge.
+     *
+     * @param maxAge The age after which an upload is not resumed.
+     * @return The cloud address books of the uploads which can still be resumed.
+     */
+    std::unordered_set<std::string> pruneCheckpoints(std::chrono::milliseconds maxAge);
+
+private:
+    AddressBookSyncIndex(std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage);
+
+    /// Returns the table of the entry hashes of an address book source.
+    static std::string getEntriesTable(const std::string& addressBookSourceId);
+
+    /// Returns the table of the acknowledged entry hashes of the upload of an address book source.
+    static std::string getCheckpointEntriesTable(const std::string& addressBookSourceId);
+
+    /// Reads the cloud address book of a source from @c indexTable, and the hashes of its entries from @c entriesTable
+    bool loadLocked(
+        const std::string& indexTable,
+        const std::string& entriesTable,
+        const std::string& addressBookSourceId,
+        std::string& cloudAddressBookId,
+        EntryHashes& entryHashes);
+
+    /// Removes the state of a source from @c indexTable and @c entriesTable
+    void removeLocked(
+        const std::string& indexTable,
+        const std::string& entriesTable,
+        const std::string& addressBookSourceId);
+
+    /// Removes the checkpoint of a source and its time
+    void removeCheckpointLocked(const std::string& addressBookSourceId);
+
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> m_localStorage;
+
+    /// Serializes the updates of the index
+    std::mutex m_mutex;
+};
+
+}  // namespace addressBook
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ADDRESS_BOOK_ADDRESS_BOOK_SYNC_INDEX_H
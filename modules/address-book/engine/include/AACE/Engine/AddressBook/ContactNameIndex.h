@@ -0,0 +1,123 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ADDRESS_BOOK_CONTACT_NAME_INDEX_H
+#define AACE_ENGINE_ADDRESS_BOOK_CONTACT_NAME_INDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <AACE/Engine/Contacts/ContactResolverInterface.h>
+
+namespace aace {
+namespace engine {
+namespace addressBook {
+
+/**
+ * Indexes the names of the contacts of the connected address books on the device, so they are resolved while the
+ * upload to the cloud is still running. The names are split into normalized words, which are kept in a trie for
+ * the exact and prefix matches, and in a map of their phonetic keys for the names that only sound alike.
+ *
+ * The index is kept in memory only, and is rebuilt each time an address book is added or removed.
+ */
+class ContactNameIndex : public aace::engine::contacts::ContactResolverInterface {
+public:
+    /// A contact of an address book
+    struct Entry {
+        /// The id of the contact in its address book
+        std::string entryId;
+        /// The names of the contact, its full name first, then its nickname and its phonetic name
+        std::vector<std::string> names;
+        /// The phone numbers of the contact
+        std::vector<std::string> phoneNumbers;
+    };
+
+    static std::shared_ptr<ContactNameIndex> create();
+
+    /**
+     * Returns the words of a name: lower case, without the punctuation, and with the apostrophes removed, so
+     * "O'Brien, Mary-Ann" gives "obrien", "mary" and "ann". The non ASCII characters are kept as they are.
+     */
+    static std::vector<std::string> normalize(const std::string& name);
+
+    /// Returns the Soundex key of a normalized word, or an empty string if the word does not start with a letter.
+    static std::string phoneticKey(const std::string& word);
+
+    /**
+     * Indexes the contacts of an address book source, replacing its previous contacts.
+     *
+     * @param addressBookSourceId The address book source.
+     * @param entries The contacts of the address book.
+     */
+    void update(const std::string& addressBookSourceId, std::vector<Entry> entries);
+
+    /// Removes the contacts of an address book source.
+    void remove(const std::string& addressBookSourceId);
+
+    /// Removes the contacts of all the address book sources.
+    void clear();
+
+    /// Returns the number of contacts indexed.
+    size_t getContactCount();
+
+    // aace::engine::contacts::ContactResolverInterface
+    std::vector<Match> resolve(const std::string& name, size_t maxMatches) override;
+
+private:
+    /// A contact indexed
+    struct Contact {
+        std::string addressBookSourceId;
+        Entry entry;
+    };
+
+    /// A node of the trie of the words, the nodes are kept in one vector and refer to each other by their index
+    struct TrieNode {
+        /// The next character of the word and the node it leads to, sorted by character
+        std::vector<std::pair<char, uint32_t>> children;
+        /// The contacts having the word ending at this node
+        std::vector<uint32_t> contacts;
+    };
+
+    ContactNameIndex() = default;
+
+    /// Rebuilds the trie and the phonetic keys from the contacts. @c m_mutex must be held.
+    void rebuildLocked();
+
+    /// Adds a word of a contact to the trie. @c m_mutex must be held.
+    void insertLocked(const std::string& word, uint32_t contact);
+
+    /// Returns the node a word ends at, or @c nullptr if no word starts with it. @c m_mutex must be held.
+    const TrieNode* findLocked(const std::string& word) const;
+
+    /// Adds the contacts of a node and of all the nodes below it. @c m_mutex must be held.
+    void collectLocked(const TrieNode& node, std::vector<uint32_t>& contacts) const;
+
+    /// Serializes the access to the index
+    std::mutex m_mutex;
+    std::vector<Contact> m_contacts;
+    std::vector<TrieNode> m_trie;
+    std::unordered_map<std::string, std::vector<uint32_t>> m_phoneticKeys;
+};
+
+}  // namespace addressBook
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ADDRESS_BOOK_CONTACT_NAME_INDEX_H
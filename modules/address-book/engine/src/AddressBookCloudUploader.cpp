@@ -13,18 +13,18 @@
  * permissions and limitations under the License.
  */
 
-// JSON for Modern C++
-#include <nlohmann/json.hpp>
-
 #include <typeinfo>
 #include <rapidjson/error/en.h>
 #include <rapidjson/pointer.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/writer.h>
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 
 #include <AACE/Engine/Core/EngineMacros.h>
 #include <AACE/Engine/Utils/Metrics/Metrics.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+#include <AACE/Engine/Utils/Threading/ThreadPool.h>
 #include <AACE/Engine/Network/NetworkEngineService.h>
 #include <AACE/Engine/AddressBook/AddressBookCloudUploader.h>
 
@@ -40,6 +40,9 @@ static const std::string TAG("aace.addressBook.addressBookCloudUploader");
 /// Upload entries batch size
 static const int UPLOAD_BATCH_SIZE = 100;
 
+/// The most batches of entries uploaded concurrently
+static const size_t MAX_CONCURRENT_BATCH_UPLOADS = 3;
+
 /// Max allowed phone numbers per entry
 static const int MAX_ALLOWED_ADDRESSES_PER_ENTRY = 30;
 
@@ -55,6 +58,9 @@ static const int MAX_ALLOWED_ADDRESS_LINE_SIZE = 60;
 /// Max event retry
 static const int MAX_EVENT_RETRY = 3;
 
+/// The age after which an interrupted upload is not resumed, and its cloud address book is cleaned at start
+static const std::chrono::milliseconds MAX_UPLOAD_CHECKPOINT_AGE = std::chrono::hours(24);
+
 /// Invalid Address Id
 static const std::string INVALID_ADDRESS_BOOK_SOURCE_ID = "INVALID";
 
@@ -91,8 +97,6 @@ static const std::string METRIC_NETWORK_ERROR = "Network.Error";
 /// Address book AVS service type
 static const std::string ADDRESS_BOOK_SERVICE_TYPE_AVS = "AVS";
 
-using json = nlohmann::json;
-
 AddressBookCloudUploader::AddressBookCloudUploader() :
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG), m_isShuttingDown(false), m_isAuthRefreshed(false) {
 }
@@ -104,7 +108,10 @@ std::shared_ptr<AddressBookCloudUploader> AddressBookCloudUploader::create(
     NetworkInfoObserver::NetworkStatus networkStatus,
     std::shared_ptr<aace::engine::network::NetworkObservableInterface> networkObserver,
     std::shared_ptr<aace::engine::alexa::AlexaEndpointInterface> alexaEndpoints,
-    bool cleanAllAddressBooksAtStart) {
+    bool cleanAllAddressBooksAtStart,
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage,
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler,
+    std::shared_ptr<ContactNameIndex> contactNameIndex) {
     try {
         auto addressBookCloudUploader = std::shared_ptr<AddressBookCloudUploader>(new AddressBookCloudUploader());
         ThrowIfNot(
@@ -115,7 +122,10 @@ std::shared_ptr<AddressBookCloudUploader> AddressBookCloudUploader::create(
                 networkStatus,
                 networkObserver,
                 alexaEndpoints,
-                cleanAllAddressBooksAtStart),
+                cleanAllAddressBooksAtStart,
+                localStorage,
+                backgroundTransferScheduler,
+                contactNameIndex),
             "initializeAddressBookCloudUploaderFailed");
 
         return addressBookCloudUploader;
@@ -132,18 +142,31 @@ bool AddressBookCloudUploader::initialize(
     NetworkInfoObserver::NetworkStatus networkStatus,
     std::shared_ptr<aace::engine::network::NetworkObservableInterface> networkObserver,
     std::shared_ptr<aace::engine::alexa::AlexaEndpointInterface> alexaEndpoints,
-    bool cleanAllAddressBooksAtStart) {
+    bool cleanAllAddressBooksAtStart,
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage,
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler,
+    std::shared_ptr<ContactNameIndex> contactNameIndex) {
     try {
         m_addressBookService = addressBookService;
         m_authDelegate = authDelegate;
         m_deviceInfo = deviceInfo;
         m_networkStatus = networkStatus;
         m_networkObserver = networkObserver;
+        m_backgroundTransferScheduler = backgroundTransferScheduler;
+        m_contactNameIndex = contactNameIndex;
 
         m_addressBookCloudUploaderRESTAgent = aace::engine::addressBook::AddressBookCloudUploaderRESTAgent::create(
             authDelegate, m_deviceInfo, alexaEndpoints);
         ThrowIfNull(m_addressBookCloudUploaderRESTAgent, "createAddressBookCloudRESTAgentFailed");
 
+        // Without the local storage, every upload replaces the whole cloud address book.
+        if (localStorage != nullptr) {
+            m_syncIndex = AddressBookSyncIndex::create(localStorage);
+            ThrowIfNull(m_syncIndex, "createAddressBookSyncIndexFailed");
+        } else {
+            AACE_DEBUG(LX(TAG).m("localStorageNotAvailable"));
+        }
+
         m_authDelegate->addAuthObserver(shared_from_this());
         if (m_networkObserver != nullptr) {  // This could be null when NetworkInfoProvider interface is not registered.
             m_networkObserver->addObserver(shared_from_this());
@@ -257,6 +280,12 @@ bool AddressBookCloudUploader::addressBookRemoved(std::shared_ptr<AddressBookEnt
                 METRIC_PROGRAM_NAME_SUFFIX, "addressBookRemoved", METRIC_REMOVE_ADDRESS_BOOK_NAVIGATION, 1);
         }
 
+        // The contacts stop resolving as soon as the address book is removed. If it is being uploaded, the queued
+        // REMOVE event removes its contacts again once the upload completes.
+        if (m_contactNameIndex != nullptr) {
+            m_contactNameIndex->remove(addressBookSourceId);
+        }
+
         std::lock_guard<std::mutex> guard(m_mutex);
         if (m_addressBookEventQ.size() > 0) {
             if (isEventEnqueuedLocked(Event::Type::ADD, addressBookEntity)) {
@@ -304,6 +333,385 @@ void AddressBookCloudUploader::removeMatchingAddEventFromQueueLocked(
     }
 }
 
+/// Returns the hashes of the content of the entries of the documents
+static AddressBookSyncIndex::EntryHashes hashEntries(
+    const std::vector<std::shared_ptr<rapidjson::Document>>& documents) {
+    AddressBookSyncIndex::EntryHashes entryHashes;
+    for (const auto& document : documents) {
+        const auto& entries = (*document)["entries"];
+        for (auto entry = entries.Begin(); entry != entries.End(); entry++) {
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            (*entry)["data"].Accept(writer);
+            entryHashes[(*entry)["entrySourceId"].GetString()] = AddressBookSyncIndex::hash(buffer.GetString());
+        }
+    }
+    return entryHashes;
+}
+
+/// Returns the batches of the entries of the documents selected by their id
+static std::vector<std::shared_ptr<rapidjson::Document>> selectEntries(
+    const std::vector<std::shared_ptr<rapidjson::Document>>& documents,
+    const std::vector<std::string>& entryIds) {
+    std::unordered_set<std::string> selected(entryIds.begin(), entryIds.end());
+    std::vector<std::shared_ptr<rapidjson::Document>> selection;
+    for (const auto& document : documents) {
+        const auto& entries = (*document)["entries"];
+        for (auto entry = entries.Begin(); entry != entries.End(); entry++) {
+            if (selected.count((*entry)["entrySourceId"].GetString()) == 0) {
+                continue;
+            }
+            if (selection.empty() ||
+                (*selection.back())["entries"].Size() >= static_cast<rapidjson::SizeType>(UPLOAD_BATCH_SIZE)) {
+                auto batch = std::make_shared<rapidjson::Document>();
+                batch->SetObject();
+                rapidjson::Value batchEntries(rapidjson::kArrayType);
+                batch->AddMember("entries", batchEntries, batch->GetAllocator());
+                selection.push_back(batch);
+            }
+            auto& batch = *selection.back();
+            rapidjson::Value copy(*entry, batch.GetAllocator());
+            batch["entries"].PushBack(copy, batch.GetAllocator());
+        }
+    }
+    return selection;
+}
+
+/// A string field of an entry payload
+struct StringField {
+    std::string value;
+    /// Whether the field is in the payload
+    bool present = false;
+    /// Whether the value of the field is not a string
+    bool invalid = false;
+};
+
+/// A number field of an entry payload
+struct NumberField {
+    float value = 0;
+    /// Whether the field is in the payload
+    bool present = false;
+    /// Whether the value of the field is not a number
+    bool invalid = false;
+};
+
+/// The fields of the payload of an entry used by the upload
+struct EntryPayload {
+    /// The type of the value of a list field
+    enum class ListType {
+        /// The field is missing, null or empty
+        EMPTY,
+        /// The field is a nonempty array
+        ARRAY,
+        /// The field is another nonempty value
+        OTHER
+    };
+
+    struct PhoneNumber {
+        /// Whether the element of the list is an object
+        bool isObject = true;
+        StringField label;
+        StringField number;
+    };
+
+    struct PostalAddress {
+        /// Whether the element of the list is an object
+        bool isObject = true;
+        StringField label;
+        StringField addressLine1;
+        StringField addressLine2;
+        StringField addressLine3;
+        StringField city;
+        StringField stateOrRegion;
+        StringField districtOrCounty;
+        StringField postalCode;
+        StringField countryCode;
+        NumberField latitudeInDegrees;
+        NumberField longitudeInDegrees;
+        NumberField accuracyInMeters;
+    };
+
+    StringField entryId;
+    /// Whether the name field is an object
+    bool hasName = false;
+    StringField firstName;
+    StringField lastName;
+    StringField nickName;
+    StringField phoneticFirstName;
+    StringField phoneticLastName;
+    ListType phoneNumbersType = ListType::EMPTY;
+    std::vector<PhoneNumber> phoneNumbers;
+    ListType postalAddressesType = ListType::EMPTY;
+    std::vector<PostalAddress> postalAddresses;
+};
+
+/**
+ * Reads the fields of an entry payload in a single pass, without building a document of the payload. The other
+ * fields are skipped, and the lists keep one element over the most addresses of an entry, so the entry can tell
+ * it was truncated.
+ */
+class EntryPayloadReader : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, EntryPayloadReader> {
+public:
+    explicit EntryPayloadReader(EntryPayload& payload) : m_payload(payload) {
+    }
+
+    bool Null() {
+        return value(ValueType::NULL_VALUE);
+    }
+
+    bool Bool(bool) {
+        return value(ValueType::BOOL);
+    }
+
+    bool Int(int number) {
+        return value(ValueType::NUMBER, nullptr, 0, number);
+    }
+
+    bool Uint(unsigned number) {
+        return value(ValueType::NUMBER, nullptr, 0, number);
+    }
+
+    bool Int64(int64_t number) {
+        return value(ValueType::NUMBER, nullptr, 0, static_cast<double>(number));
+    }
+
+    bool Uint64(uint64_t number) {
+        return value(ValueType::NUMBER, nullptr, 0, static_cast<double>(number));
+    }
+
+    bool Double(double number) {
+        return value(ValueType::NUMBER, nullptr, 0, number);
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool) {
+        return value(ValueType::STRING, str, length);
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool) {
+        m_key.assign(str, length);
+        return true;
+    }
+
+    bool StartObject() {
+        return startContainer(true);
+    }
+
+    bool EndObject(rapidjson::SizeType memberCount) {
+        return endContainer(memberCount);
+    }
+
+    bool StartArray() {
+        return startContainer(false);
+    }
+
+    bool EndArray(rapidjson::SizeType elementCount) {
+        return endContainer(elementCount);
+    }
+
+private:
+    /// The container the reader is in
+    enum class Context { ROOT, NAME, PHONE_NUMBERS, PHONE_NUMBER, POSTAL_ADDRESSES, POSTAL_ADDRESS, SKIPPED };
+
+    /// The type of a value other than an object or an array
+    enum class ValueType { NULL_VALUE, BOOL, NUMBER, STRING };
+
+    struct Frame {
+        Context context;
+        /// The type of the list field of the container, which is empty if the container has no members
+        EntryPayload::ListType* listType;
+    };
+
+    /// Returns the string field of the current key in the current object, or @c nullptr.
+    StringField* stringField() {
+        switch (m_frames.back().context) {
+            case Context::NAME:
+                if (m_key == "firstName") return &m_payload.firstName;
+                if (m_key == "lastName") return &m_payload.lastName;
+                if (m_key == "nickName") return &m_payload.nickName;
+                if (m_key == "phoneticFirstName") return &m_payload.phoneticFirstName;
+                if (m_key == "phoneticLastName") return &m_payload.phoneticLastName;
+                return nullptr;
+            case Context::PHONE_NUMBER:
+                if (m_key == "label") return &m_payload.phoneNumbers.back().label;
+                if (m_key == "number") return &m_payload.phoneNumbers.back().number;
+                return nullptr;
+            case Context::POSTAL_ADDRESS: {
+                auto& postalAddress = m_payload.postalAddresses.back();
+                if (m_key == "label") return &postalAddress.label;
+                if (m_key == "addressLine1") return &postalAddress.addressLine1;
+                if (m_key == "addressLine2") return &postalAddress.addressLine2;
+                if (m_key == "addressLine3") return &postalAddress.addressLine3;
+                if (m_key == "city") return &postalAddress.city;
+                if (m_key == "stateOrRegion") return &postalAddress.stateOrRegion;
+                if (m_key == "districtOrCounty") return &postalAddress.districtOrCounty;
+                if (m_key == "postalCode") return &postalAddress.postalCode;
+                if (m_key == "countryCode") return &postalAddress.countryCode;
+                return nullptr;
+            }
+            case Context::ROOT:
+                return m_key == "entryId" ? &m_payload.entryId : nullptr;
+            default:
+                return nullptr;
+        }
+    }
+
+    /// Returns the number field of the current key in the current object, or @c nullptr.
+    NumberField* numberField() {
+        if (m_frames.back().context != Context::POSTAL_ADDRESS) {
+            return nullptr;
+        }
+        auto& postalAddress = m_payload.postalAddresses.back();
+        if (m_key == "latitudeInDegrees") return &postalAddress.latitudeInDegrees;
+        if (m_key == "longitudeInDegrees") return &postalAddress.longitudeInDegrees;
+        if (m_key == "accuracyInMeters") return &postalAddress.accuracyInMeters;
+        return nullptr;
+    }
+
+    /// Returns the list field of the current key in the root object, or @c nullptr.
+    EntryPayload::ListType* listType() {
+        if (m_frames.back().context != Context::ROOT) {
+            return nullptr;
+        }
+        if (m_key == "phoneNumbers") return &m_payload.phoneNumbersType;
+        if (m_key == "postalAddresses") return &m_payload.postalAddressesType;
+        return nullptr;
+    }
+
+    /// Marks the field of the current key as invalid, for a value of the wrong type.
+    void setInvalid() {
+        if (auto field = stringField()) {
+            field->value.clear();
+            field->present = true;
+            field->invalid = true;
+        } else if (auto field = numberField()) {
+            field->present = true;
+            field->invalid = true;
+        } else if (m_frames.back().context == Context::ROOT && m_key == "name") {
+            m_payload.hasName = false;
+        }
+    }
+
+    /// Adds an element to the list of the current array, returns whether the list has room for it.
+    bool addElement() {
+        if (m_frames.back().context == Context::PHONE_NUMBERS &&
+            m_payload.phoneNumbers.size() <= static_cast<size_t>(MAX_ALLOWED_ADDRESSES_PER_ENTRY)) {
+            m_payload.phoneNumbers.emplace_back();
+            return true;
+        }
+        if (m_frames.back().context == Context::POSTAL_ADDRESSES &&
+            m_payload.postalAddresses.size() <= static_cast<size_t>(MAX_ALLOWED_ADDRESSES_PER_ENTRY)) {
+            m_payload.postalAddresses.emplace_back();
+            return true;
+        }
+        return false;
+    }
+
+    /// Handles a value other than an object or an array.
+    bool value(ValueType type, const char* str = nullptr, rapidjson::SizeType length = 0, double number = 0) {
+        if (m_frames.empty()) {
+            // the payload is not an object
+            return true;
+        }
+        switch (m_frames.back().context) {
+            case Context::PHONE_NUMBERS:
+                if (addElement()) m_payload.phoneNumbers.back().isObject = false;
+                return true;
+            case Context::POSTAL_ADDRESSES:
+                if (addElement()) m_payload.postalAddresses.back().isObject = false;
+                return true;
+            case Context::SKIPPED:
+                return true;
+            default:
+                break;
+        }
+        if (auto containerListType = listType()) {
+            *containerListType =
+                type == ValueType::NULL_VALUE ? EntryPayload::ListType::EMPTY : EntryPayload::ListType::OTHER;
+            return true;
+        }
+        if (type == ValueType::STRING) {
+            if (auto field = stringField()) {
+                field->value.assign(str, length);
+                field->present = true;
+                field->invalid = false;
+                return true;
+            }
+        } else if (type == ValueType::NUMBER) {
+            if (auto field = numberField()) {
+                field->value = static_cast<float>(number);
+                field->present = true;
+                field->invalid = false;
+                return true;
+            }
+        }
+        setInvalid();
+        return true;
+    }
+
+    bool startContainer(bool isObject) {
+        if (m_frames.empty()) {
+            m_frames.push_back({isObject ? Context::ROOT : Context::SKIPPED, nullptr});
+            return true;
+        }
+        auto context = Context::SKIPPED;
+        EntryPayload::ListType* containerListType = nullptr;
+        switch (m_frames.back().context) {
+            case Context::ROOT:
+                if (m_key == "name" && isObject) {
+                    m_payload.hasName = true;
+                    m_payload.firstName = m_payload.lastName = m_payload.nickName = StringField();
+                    m_payload.phoneticFirstName = m_payload.phoneticLastName = StringField();
+                    context = Context::NAME;
+                } else if (auto type = listType()) {
+                    // a list which is an object is invalid unless it is empty
+                    *type = isObject ? EntryPayload::ListType::OTHER : EntryPayload::ListType::ARRAY;
+                    containerListType = type;
+                    if (!isObject && type == &m_payload.phoneNumbersType) {
+                        m_payload.phoneNumbers.clear();
+                        context = Context::PHONE_NUMBERS;
+                    } else if (!isObject) {
+                        m_payload.postalAddresses.clear();
+                        context = Context::POSTAL_ADDRESSES;
+                    }
+                } else {
+                    setInvalid();
+                }
+                break;
+            case Context::PHONE_NUMBERS:
+                if (addElement()) {
+                    m_payload.phoneNumbers.back().isObject = isObject;
+                    context = isObject ? Context::PHONE_NUMBER : Context::SKIPPED;
+                }
+                break;
+            case Context::POSTAL_ADDRESSES:
+                if (addElement()) {
+                    m_payload.postalAddresses.back().isObject = isObject;
+                    context = isObject ? Context::POSTAL_ADDRESS : Context::SKIPPED;
+                }
+                break;
+            case Context::SKIPPED:
+                break;
+            default:
+                setInvalid();
+                break;
+        }
+        m_frames.push_back({context, containerListType});
+        return true;
+    }
+
+    bool endContainer(rapidjson::SizeType count) {
+        if (m_frames.back().listType != nullptr && count == 0) {
+            *m_frames.back().listType = EntryPayload::ListType::EMPTY;
+        }
+        m_frames.pop_back();
+        return true;
+    }
+
+    EntryPayload& m_payload;
+    std::vector<Frame> m_frames;
+    std::string m_key;
+};
+
 class AddressBookEntriesFactory : public aace::addressBook::AddressBook::IAddressBookEntriesFactory {
 public:
     AddressBookEntriesFactory(
@@ -328,6 +736,7 @@ private:
             // size before assignment that causes incorrect indexes for later usage.
             auto index = m_ids.size();
             m_ids[entryId] = index;
+            m_indexEntries.push_back({entryId, {}, {}});
 
             auto bucketIndex = m_ids[entryId] / UPLOAD_BATCH_SIZE;
             auto entriesIndex = m_ids[entryId] % UPLOAD_BATCH_SIZE;
@@ -380,39 +789,71 @@ private:
         return document.GetAllocator();
     }
 
+    /// Adds the names of an entry to its contact name index entry.
+    void indexNames(
+        const std::string& entryId,
+        const std::string& firstName,
+        const std::string& lastName,
+        const std::string& nickName,
+        const std::string& phoneticFirstName,
+        const std::string& phoneticLastName) {
+        auto join = [](const std::string& first, const std::string& last) {
+            return first.empty() || last.empty() ? first + last : first + " " + last;
+        };
+        auto& names = m_indexEntries[m_ids[entryId]].names;
+        for (const auto& name : {join(firstName, lastName), nickName, join(phoneticFirstName, phoneticLastName)}) {
+            if (!name.empty()) {
+                names.push_back(name);
+            }
+        }
+    }
+
 public:
+    /// Returns the entries for the contact name index, in the order they were added.
+    std::vector<ContactNameIndex::Entry>& getIndexEntries() {
+        return m_indexEntries;
+    }
+
     bool addEntry(const std::string& payload) {
         bool success = true;
         try {
             ThrowIf(payload.empty(), "payloadEmpty");
-            auto entryPayload = json::parse(payload);
 
-            ThrowIfNot(
-                entryPayload.contains("entryId") && entryPayload["entryId"].is_string(), "entryIdMissingOrNotString");
-            ThrowIf(entryPayload["entryId"].empty(), "entryIdEmpty");
+            // read the fields of the entry in one pass, they are copied once into the upload document
+            EntryPayload entryPayload;
+            EntryPayloadReader entryPayloadReader(entryPayload);
+            rapidjson::Reader reader;
+            rapidjson::StringStream stream(payload.c_str());
+            auto result = reader.Parse<rapidjson::kParseValidateEncodingFlag>(stream, entryPayloadReader);
+            if (!result) {
+                AACE_ERROR(LX(TAG)
+                               .m("payLoadParseError")
+                               .d("exception", rapidjson::GetParseError_En(result.Code()))
+                               .d("offset", result.Offset()));
+                return false;
+            }
 
-            std::string entryId = entryPayload["entryId"];
+            ThrowIfNot(entryPayload.entryId.present && !entryPayload.entryId.invalid, "entryIdMissingOrNotString");
+            ThrowIf(entryPayload.entryId.value.empty(), "entryIdEmpty");
+
+            const std::string& entryId = entryPayload.entryId.value;
             AACE_DEBUG(LX(TAG).d("entryId", entryId));
 
             ThrowIf(entryId.size() > MAX_ALLOWED_ENTRY_ID_SIZE, "entryIdSizeExceedsMaxSize");
-            ThrowIfNot(entryPayload.contains("name") && entryPayload["name"].is_object(), "nameMissingOrInvalid");
-
-            auto& nameNode = entryPayload["name"];
+            ThrowIfNot(entryPayload.hasName, "nameMissingOrInvalid");
 
-            // clang-format off
             // Sanitize name  field types
-            ThrowIfNot((nameNode.contains("firstName") ? nameNode["firstName"].is_string() : true), "firstNameInvalid");
-            ThrowIfNot((nameNode.contains("lastName") ? nameNode["lastName"].is_string() : true), "lastNameInvalid");
-            ThrowIfNot((nameNode.contains("nickName") ? nameNode["nickName"].is_string() : true), "nickNameInvalid");
-            ThrowIfNot((nameNode.contains("phoneticFirstName") ? nameNode["phoneticFirstName"].is_string() : true), "phoneticFirstNameInvalid");
-            ThrowIfNot((nameNode.contains("phoneticLastName") ? nameNode["phoneticLastName"].is_string() : true), "phoneticLastNameInvalid");
-            // clang-format on
-
-            std::string firstName = nameNode.value("firstName", "");
-            std::string lastName = nameNode.value("lastName", "");
-            std::string nickName = nameNode.value("nickName", "");
-            std::string phoneticFirstName = nameNode.value("phoneticFirstName", "");
-            std::string phoneticLastName = nameNode.value("phoneticLastName", "");
+            ThrowIf(entryPayload.firstName.invalid, "firstNameInvalid");
+            ThrowIf(entryPayload.lastName.invalid, "lastNameInvalid");
+            ThrowIf(entryPayload.nickName.invalid, "nickNameInvalid");
+            ThrowIf(entryPayload.phoneticFirstName.invalid, "phoneticFirstNameInvalid");
+            ThrowIf(entryPayload.phoneticLastName.invalid, "phoneticLastNameInvalid");
+
+            const std::string& firstName = entryPayload.firstName.value;
+            const std::string& lastName = entryPayload.lastName.value;
+            const std::string& nickName = entryPayload.nickName.value;
+            const std::string& phoneticFirstName = entryPayload.phoneticFirstName.value;
+            const std::string& phoneticLastName = entryPayload.phoneticLastName.value;
 
             // Sanitize field size
             auto totalSize = firstName.size() + lastName.size() + nickName.size() + phoneticFirstName.size() +
@@ -441,11 +882,12 @@ public:
             if (!phoneticLastName.empty()) name.AddMember("phoneticLastName", phoneticLastName, allocator);
 
             data.AddMember("name", name, allocator);
+            indexNames(entryId, firstName, lastName, nickName, phoneticFirstName, phoneticLastName);
 
-            if (entryPayload.contains("phoneNumbers") && !entryPayload["phoneNumbers"].empty()) {
+            if (entryPayload.phoneNumbersType != EntryPayload::ListType::EMPTY) {
                 // Consider phone numbers only when the address book type is CONTACT
                 if (m_addressBookEntity->getType() == AddressBookType::CONTACT) {
-                    if (!entryPayload["phoneNumbers"].is_array()) {
+                    if (entryPayload.phoneNumbersType != EntryPayload::ListType::ARRAY) {
                         Throw("phoneNumbersFieldIsNotAnArray");
                     }
 
@@ -457,22 +899,21 @@ public:
                     auto& addresses = data["addresses"];
 
                     int counter = 0;
-                    for (auto& phoneNumber : entryPayload["phoneNumbers"]) {
+                    for (const auto& phoneNumber : entryPayload.phoneNumbers) {
                         if (++counter > MAX_ALLOWED_ADDRESSES_PER_ENTRY) {
                             AACE_WARN(LX(TAG).m("maxAllowedPhoneNumberEntriesReached"));
                             success = false;
                             break;  // bail out
                         }
 
-                        // clang-format off
                         // Sanitize phone number field types
-                        ThrowIfNot((phoneNumber.contains("label") ? phoneNumber["label"].is_string() : true), "phoneNumberLabelInvalid");
-                        ThrowIfNot((phoneNumber.contains("number") ? phoneNumber["number"].is_string() : true), "phoneNumberNumberInvalid");
-                        // clang-format on
+                        ThrowIfNot(phoneNumber.isObject, "phoneNumberNotAnObject");
+                        ThrowIf(phoneNumber.label.invalid, "phoneNumberLabelInvalid");
+                        ThrowIf(phoneNumber.number.invalid, "phoneNumberNumberInvalid");
 
                         // Sanitize phone number field sizes
-                        std::string label = phoneNumber.value("label", "");
-                        std::string number = phoneNumber.value("number", "");
+                        const std::string& label = phoneNumber.label.value;
+                        const std::string& number = phoneNumber.number.value;
 
                         totalSize = label.size() + number.size();
                         if (totalSize > MAX_ALLOWED_CHARACTERS) {
@@ -492,6 +933,7 @@ public:
                         if (!number.empty()) address.AddMember("value", number, allocator);
 
                         addresses.PushBack(address, allocator);
+                        if (!number.empty()) m_indexEntries[m_ids[entryId]].phoneNumbers.push_back(number);
                     }
                 } else {
                     AACE_WARN(LX(TAG).m("phoneNumbersNotSupportedInNavigationType"));
@@ -499,10 +941,10 @@ public:
                 }
             }
 
-            if (entryPayload.contains("postalAddresses") && !entryPayload["postalAddresses"].empty()) {
+            if (entryPayload.postalAddressesType != EntryPayload::ListType::EMPTY) {
                 // Consider postal addresses  only when the address book type is NAVIGATION
                 if (m_addressBookEntity->getType() == AddressBookType::NAVIGATION) {
-                    if (!entryPayload["postalAddresses"].is_array()) {
+                    if (entryPayload.postalAddressesType != EntryPayload::ListType::ARRAY) {
                         Throw("postalAddressesFieldIsNotAnArray");
                     }
 
@@ -514,40 +956,44 @@ public:
                     auto& addresses = data["addresses"];
 
                     int counter = 0;
-                    for (auto& postalAddress : entryPayload["postalAddresses"]) {
+                    for (const auto& postalAddress : entryPayload.postalAddresses) {
                         if (++counter > MAX_ALLOWED_ADDRESSES_PER_ENTRY) {
                             AACE_WARN(LX(TAG).m("maxAllowedPostalAddressEntriesReached"));
                             success = false;
                             break;  // bail out
                         }
 
-                        // clang-format off
                         // Sanitize postal address fields types
-                        ThrowIfNot((postalAddress.contains("label") ? postalAddress["label"].is_string() : true), "postalAddressLabelInvalid");
-                        ThrowIfNot((postalAddress.contains("addressLine1") ? postalAddress["addressLine1"].is_string() : true), "postalAddressAddressLine1Invalid");
-                        ThrowIfNot((postalAddress.contains("addressLine2") ? postalAddress["addressLine2"].is_string() : true), "postalAddressAddressLine2Invalid");
-                        ThrowIfNot((postalAddress.contains("city") ? postalAddress["city"].is_string() : true), "postalAddressCityInvalid");
-                        ThrowIfNot((postalAddress.contains("stateOrRegion") ? postalAddress["stateOrRegion"].is_string() : true), "postalAddressStateOrRegionInvalid");
-                        ThrowIfNot((postalAddress.contains("districtOrCounty") ? postalAddress["districtOrCounty"].is_string() : true), "postalAddressDistrictOrCountyInvalid");
-                        ThrowIfNot((postalAddress.contains("postalCode") ? postalAddress["postalCode"].is_string() : true), "postalAddressPostalCodeInvalid");
-                        ThrowIfNot((postalAddress.contains("countryCode") ? postalAddress["countryCode"].is_string() : true), "postalAddressCountryCodeInvalid");
-                        ThrowIfNot(postalAddress.contains("latitudeInDegrees") && postalAddress["latitudeInDegrees"].is_number(), "postalAddressLatitudeInDegreesNotPresetOrInvalid");
-                        ThrowIfNot(postalAddress.contains("longitudeInDegrees") && postalAddress["longitudeInDegrees"].is_number(), "postalAddressLongitudeInDegreesNotPresetOrInvalid");
-                        ThrowIfNot((postalAddress.contains("accuracyInMeters") ? postalAddress["accuracyInMeters"].is_number() : true), "postalAddressAccuracyInMetersInvalid");
-                        // clang-format on
-
-                        std::string label = postalAddress.value("label", "");
-                        std::string addressLine1 = postalAddress.value("addressLine1", "");
-                        std::string addressLine2 = postalAddress.value("addressLine2", "");
-                        std::string addressLine3 = postalAddress.value("addressLine3", "");
-                        std::string city = postalAddress.value("city", "");
-                        std::string stateOrRegion = postalAddress.value("stateOrRegion", "");
-                        std::string districtOrCounty = postalAddress.value("districtOrCounty", "");
-                        std::string postalCode = postalAddress.value("postalCode", "");
-                        std::string countryCode = postalAddress.value("countryCode", "");
-                        float latitudeInDegrees = postalAddress.value("latitudeInDegrees", 0.0f);
-                        float longitudeInDegrees = postalAddress.value("longitudeInDegrees", 0.0f);
-                        float accuracyInMeters = postalAddress.value("accuracyInMeters", 0.0f);
+                        ThrowIfNot(postalAddress.isObject, "postalAddressNotAnObject");
+                        ThrowIf(postalAddress.label.invalid, "postalAddressLabelInvalid");
+                        ThrowIf(postalAddress.addressLine1.invalid, "postalAddressAddressLine1Invalid");
+                        ThrowIf(postalAddress.addressLine2.invalid, "postalAddressAddressLine2Invalid");
+                        ThrowIf(postalAddress.addressLine3.invalid, "postalAddressAddressLine3Invalid");
+                        ThrowIf(postalAddress.city.invalid, "postalAddressCityInvalid");
+                        ThrowIf(postalAddress.stateOrRegion.invalid, "postalAddressStateOrRegionInvalid");
+                        ThrowIf(postalAddress.districtOrCounty.invalid, "postalAddressDistrictOrCountyInvalid");
+                        ThrowIf(postalAddress.postalCode.invalid, "postalAddressPostalCodeInvalid");
+                        ThrowIf(postalAddress.countryCode.invalid, "postalAddressCountryCodeInvalid");
+                        ThrowIfNot(
+                            postalAddress.latitudeInDegrees.present && !postalAddress.latitudeInDegrees.invalid,
+                            "postalAddressLatitudeInDegreesNotPresetOrInvalid");
+                        ThrowIfNot(
+                            postalAddress.longitudeInDegrees.present && !postalAddress.longitudeInDegrees.invalid,
+                            "postalAddressLongitudeInDegreesNotPresetOrInvalid");
+                        ThrowIf(postalAddress.accuracyInMeters.invalid, "postalAddressAccuracyInMetersInvalid");
+
+                        const std::string& label = postalAddress.label.value;
+                        const std::string& addressLine1 = postalAddress.addressLine1.value;
+                        const std::string& addressLine2 = postalAddress.addressLine2.value;
+                        const std::string& addressLine3 = postalAddress.addressLine3.value;
+                        const std::string& city = postalAddress.city.value;
+                        const std::string& stateOrRegion = postalAddress.stateOrRegion.value;
+                        const std::string& districtOrCounty = postalAddress.districtOrCounty.value;
+                        const std::string& postalCode = postalAddress.postalCode.value;
+                        const std::string& countryCode = postalAddress.countryCode.value;
+                        float latitudeInDegrees = postalAddress.latitudeInDegrees.value;
+                        float longitudeInDegrees = postalAddress.longitudeInDegrees.value;
+                        float accuracyInMeters = postalAddress.accuracyInMeters.value;
 
                         // Sanitize postal address fields sizes
                         if (addressLine1.size() > MAX_ALLOWED_ADDRESS_LINE_SIZE) {
@@ -646,9 +1092,6 @@ public:
                 }
             }
             return success;
-        } catch (json::parse_error& ex) {
-            AACE_ERROR(LX(TAG).m("payLoadParseError").d("exception", ex.what()));
-            return false;
         } catch (std::exception& ex) {
             AACE_ERROR(LX(TAG).d("reason", ex.what()));
             return false;
@@ -731,6 +1174,7 @@ public:
             if (!phoneticLastName.empty()) name.AddMember("phoneticLastName", phoneticLastName, allocator);
 
             data.AddMember("name", name, allocator);
+            indexNames(entryId, firstName, lastName, nickname, phoneticFirstName, phoneticLastName);
 
             return true;
         } catch (std::exception& ex) {
@@ -769,6 +1213,7 @@ public:
             if (!number.empty()) address.AddMember("value", number, allocator);
 
             addresses.PushBack(address, allocator);
+            if (!number.empty()) m_indexEntries[m_ids[entryId]].phoneNumbers.push_back(number);
 
             return true;
         } catch (std::exception& ex) {
@@ -864,6 +1309,7 @@ private:
     std::shared_ptr<AddressBookEntity> m_addressBookEntity;
     std::vector<std::shared_ptr<rapidjson::Document>>& m_documents;
     std::unordered_map<std::string, rapidjson::SizeType> m_ids;
+    std::vector<ContactNameIndex::Entry> m_indexEntries;
 };
 
 bool AddressBookCloudUploader::handleUpload(std::shared_ptr<AddressBookEntity> addressBookEntity) {
@@ -885,6 +1331,11 @@ bool AddressBookCloudUploader::handleUpload(std::shared_ptr<AddressBookEntity> a
             return true;
         }
 
+        // The contacts are resolved on the device while they are uploaded.
+        if (m_contactNameIndex != nullptr && addressBookEntity->getType() == AddressBookType::CONTACT) {
+            m_contactNameIndex->update(addressBookSourceId, std::move(factory->getIndexEntries()));
+        }
+
         if (documents.size() <= 0) {
             // Its the empty document.
             AACE_WARN(LX(TAG, "handleUpload")
@@ -902,23 +1353,70 @@ bool AddressBookCloudUploader::handleUpload(std::shared_ptr<AddressBookEntity> a
             }
         }
 
-        //Preparing for the upload
-        auto cloudAddressBookId = prepareForUpload(addressBookEntity);
-        ThrowIf(cloudAddressBookId.empty(), "prepareUploadFailed");
+        auto entryHashes = hashEntries(documents);
+
+        auto cloudAddressBookId = prepareForDeltaUpload(addressBookEntity, entryHashes, documents);
+        if (!cloudAddressBookId.empty() && documents.empty()) {
+            // The upload may have been interrupted after its last batch was acknowledged.
+            std::string checkpointedId;
+            AddressBookSyncIndex::EntryHashes checkpointedEntryHashes;
+            if (m_syncIndex != nullptr &&
+                m_syncIndex->loadCheckpoint(addressBookSourceId, checkpointedId, checkpointedEntryHashes)) {
+                ThrowIfNot(
+                    m_syncIndex->save(addressBookSourceId, cloudAddressBookId, entryHashes), "saveSyncStateFailed");
+                m_syncIndex->removeCheckpoint(addressBookSourceId);
+            }
+            AACE_INFO(LX(TAG, "handleUpload")
+                          .m("AddressBookUnchanged")
+                          .d("addressBookSourceId", addressBookSourceId)
+                          .d("numberOfEntries", numberOfEntries));
+            return true;
+        }
 
-        double uploadStartTimer = getCurrentTimeInMs();
+        // Forget the sync state until the upload completes, so a partial upload is never taken for a synced one.
+        if (m_syncIndex != nullptr) {
+            ThrowIfNot(m_syncIndex->remove(addressBookSourceId), "removeSyncStateFailed");
+        }
 
-        //Upload json document in a loop.
-        for (auto document : documents) {
-            ThrowIfNot(upload(cloudAddressBookId, document), "uploadDocumentFailed");
+        if (cloudAddressBookId.empty()) {
+            //Preparing for the upload
+            cloudAddressBookId = prepareForUpload(addressBookEntity);
+            ThrowIf(cloudAddressBookId.empty(), "prepareUploadFailed");
         }
 
-        // It is assumed that between contacts and navigation addresses the difference is payload that should not
-        // influence the latency for uploading one batch of address book entries.
-        double totalDuration = getCurrentTimeInMs() - uploadStartTimer;
-        double timeToUploadOneBatch = totalDuration / documents.size();
-        emitTimerMetrics(
-            METRIC_PROGRAM_NAME_SUFFIX, "handleUpload", METRIC_TIME_TO_UPLOAD_ONE_BATCH, timeToUploadOneBatch);
+        if (m_syncIndex != nullptr) {
+            // The entries left out of the upload are already in the cloud address book, and each batch is added to
+            // the checkpoint once acknowledged, so an interrupted upload resumes after the last acknowledged batch.
+            auto acknowledgedHashes = entryHashes;
+            for (const auto& entry : hashEntries(documents)) {
+                acknowledgedHashes.erase(entry.first);
+            }
+            if (!m_syncIndex->saveCheckpoint(addressBookSourceId, cloudAddressBookId, acknowledgedHashes)) {
+                AACE_WARN(
+                    LX(TAG, "handleUpload").d("addressBookSourceId", addressBookSourceId).m("saveCheckpointFailed"));
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_failedEntriesMutex);
+            m_failedEntryIds.clear();
+        }
+        ThrowIfNot(uploadDocuments(addressBookSourceId, cloudAddressBookId, documents), "uploadDocumentsFailed");
+
+        if (m_syncIndex != nullptr) {
+            {
+                // The entries the cloud failed to add are left out of the index, so the next upload adds them.
+                std::lock_guard<std::mutex> lock(m_failedEntriesMutex);
+                for (const auto& entryId : m_failedEntryIds) {
+                    entryHashes.erase(entryId);
+                }
+            }
+            if (!m_syncIndex->save(addressBookSourceId, cloudAddressBookId, entryHashes)) {
+                AACE_WARN(
+                    LX(TAG, "handleUpload").d("addressBookSourceId", addressBookSourceId).m("saveSyncStateFailed"));
+            }
+            m_syncIndex->removeCheckpoint(addressBookSourceId);
+        }
 
         AACE_INFO(LX(TAG, "handleUpload")
                       .m("SuccessfullyUploaded")
@@ -935,10 +1433,16 @@ bool AddressBookCloudUploader::handleUpload(std::shared_ptr<AddressBookEntity> a
 bool AddressBookCloudUploader::handleRemove(std::shared_ptr<AddressBookEntity> addressBookEntity) {
     std::string addressBookSourceId = INVALID_ADDRESS_BOOK_SOURCE_ID;
     try {
-        ThrowIfNot(m_addressBookCloudUploaderRESTAgent->isAccountProvisioned(), "accountNotProvisioned");
-
         addressBookSourceId = addressBookEntity->getSourceId();
+        if (m_contactNameIndex != nullptr) {
+            m_contactNameIndex->remove(addressBookSourceId);
+        }
+        ThrowIfNot(m_addressBookCloudUploaderRESTAgent->isAccountProvisioned(), "accountNotProvisioned");
 
+        if (m_syncIndex != nullptr) {
+            ThrowIfNot(m_syncIndex->remove(addressBookSourceId), "removeSyncStateFailed");
+            ThrowIfNot(m_syncIndex->removeCheckpoint(addressBookSourceId), "removeCheckpointFailed");
+        }
         ThrowIfNot(deleteAddressBook(addressBookEntity), "addressBookDeleteFailed");
 
         AACE_INFO(LX(TAG, "handleRemove")
@@ -958,6 +1462,7 @@ bool AddressBookCloudUploader::handleRemove(std::shared_ptr<AddressBookEntity> a
 
 void AddressBookCloudUploader::eventLoop(bool cleanAllAddressBooksAtStart) {
     AACE_INFO(LX(TAG));
+    aace::engine::utils::threading::ThreadPolicy::ScopedThread scopedThread("AddressBook.uploader");
     bool cleanAllAddressBooks = cleanAllAddressBooksAtStart;
     while (!m_isShuttingDown) {
         // Clean up previous address books in cloud.
@@ -1035,16 +1540,25 @@ void AddressBookCloudUploader::eventLoop(bool cleanAllAddressBooksAtStart) {
 
 const Event AddressBookCloudUploader::popNextEventFromQ() {
     std::unique_lock<std::mutex> queueLock{m_mutex};
-    auto shouldNotWait = [this]() {
-        return (
-            m_isShuttingDown ||
-            (!m_addressBookEventQ.empty() && m_networkStatus == NetworkStatus::CONNECTED && m_isAuthRefreshed));
+    auto isReady = [this]() {
+        return !m_addressBookEventQ.empty() && m_networkStatus == NetworkStatus::CONNECTED && m_isAuthRefreshed;
+    };
+    auto shouldNotWait = [this, &isReady]() {
+        return m_isShuttingDown || (isReady() && (m_backgroundTransferScheduler == nullptr || m_isTransferAllowed));
     };
 
-    if (!shouldNotWait()) {
-        m_waitStatusChange.wait(queueLock, shouldNotWait);
+    while (!shouldNotWait()) {
+        if (isReady() && !m_isTransferRequested) {
+            requestTransferLocked();
+            continue;
+        }
+        m_waitStatusChange.wait(queueLock);
     }
 
+    // each upload waits for its own transfer window
+    m_isTransferRequested = false;
+    m_isTransferAllowed = false;
+
     if (!m_addressBookEventQ.empty()) {
         auto event = m_addressBookEventQ.front();
         m_addressBookEventQ.pop_front();
@@ -1055,6 +1569,82 @@ const Event AddressBookCloudUploader::popNextEventFromQ() {
     return Event::INVALID();
 }
 
+void AddressBookCloudUploader::requestTransferLocked() {
+    m_isTransferRequested = true;
+    std::weak_ptr<AddressBookCloudUploader> wp = shared_from_this();
+    auto submitted = m_backgroundTransferScheduler->submit(
+        "AddressBook.upload", aace::engine::network::BackgroundTransferScheduler::Priority::BACKGROUND, [wp]() {
+            if (auto uploader = wp.lock()) {
+                std::lock_guard<std::mutex> guard(uploader->m_mutex);
+                uploader->m_isTransferAllowed = true;
+                uploader->m_waitStatusChange.notify_all();
+            }
+        });
+    if (!submitted) {
+        // the scheduler is shutdown, so the upload isn't deferred
+        m_isTransferAllowed = true;
+    }
+}
+
+std::string AddressBookCloudUploader::prepareForDeltaUpload(
+    std::shared_ptr<AddressBookEntity> addressBookEntity,
+    const AddressBookSyncIndex::EntryHashes& entryHashes,
+    std::vector<std::shared_ptr<rapidjson::Document>>& documents) {
+    std::string addressBookSourceId = addressBookEntity->getSourceId();
+    try {
+        if (m_syncIndex == nullptr) {
+            return std::string();
+        }
+        ThrowIfNot(m_addressBookCloudUploaderRESTAgent->isAccountProvisioned(), "accountNotProvisioned");
+
+        std::string syncedCloudAddressBookId;
+        AddressBookSyncIndex::EntryHashes syncedEntryHashes;
+        if (!m_syncIndex->load(addressBookSourceId, syncedCloudAddressBookId, syncedEntryHashes)) {
+            // An interrupted upload is resumed like a delta upload, from the entries acknowledged by the cloud.
+            if (!m_syncIndex->loadCheckpoint(addressBookSourceId, syncedCloudAddressBookId, syncedEntryHashes)) {
+                AACE_DEBUG(LX(TAG).d("addressBookSourceId", addressBookSourceId).m("addressBookNotSynced"));
+                return std::string();
+            }
+            AACE_INFO(LX(TAG)
+                          .d("addressBookSourceId", addressBookSourceId)
+                          .d("acknowledgedEntries", syncedEntryHashes.size())
+                          .m("resumingUpload"));
+        }
+
+        // The cloud address book may have been deleted or replaced since the last sync, for example by another
+        // address book of the same type, or after the user changed.
+        std::string cloudAddressBookId;
+        ThrowIfNot(
+            m_addressBookCloudUploaderRESTAgent->getCloudAddressBookId(
+                m_deviceInfo->getDeviceSerialNumber(), addressBookEntity->toJSONAddressBookType(), cloudAddressBookId),
+            "getCloudAddressBookIdFailed");
+        if (cloudAddressBookId != syncedCloudAddressBookId) {
+            AACE_INFO(LX(TAG).d("addressBookSourceId", addressBookSourceId).m("cloudAddressBookChanged"));
+            return std::string();
+        }
+
+        // The entries of a cloud address book can only be added, so a changed or removed entry requires to upload
+        // the address book again.
+        auto delta = AddressBookSyncIndex::computeDelta(syncedEntryHashes, entryHashes);
+        AACE_INFO(LX(TAG)
+                      .d("addressBookSourceId", addressBookSourceId)
+                      .d("added", delta.added.size())
+                      .d("changed", delta.changed.size())
+                      .d("removed", delta.removed.size()));
+        if (!delta.changed.empty() || !delta.removed.empty()) {
+            return std::string();
+        }
+
+        documents = selectEntries(documents, delta.added);
+        return cloudAddressBookId;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "prepareForDeltaUpload")
+                       .d("addressBookSourceId", addressBookSourceId)
+                       .d("reason", ex.what()));
+        return std::string();
+    }
+}
+
 std::string AddressBookCloudUploader::prepareForUpload(std::shared_ptr<AddressBookEntity> addressBookEntity) {
     AACE_DEBUG(LX(TAG));
     try {
@@ -1087,6 +1677,95 @@ bool AddressBookCloudUploader::upload(
     }
 }
 
+bool AddressBookCloudUploader::uploadDocuments(
+    const std::string& addressBookSourceId,
+    const std::string& cloudAddressBookId,
+    std::vector<std::shared_ptr<rapidjson::Document>>& documents) {
+    // the state of the upload, protected by the mutex
+    std::mutex mutex;
+    std::condition_variable completed;
+    size_t next = 0;
+    size_t running = 0;
+    bool failed = false;
+    double totalDuration = 0;
+
+    // uploads the next batch until all the batches are uploaded, or one of them failed
+    auto uploadBatches = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!failed && !m_isShuttingDown && next < documents.size()) {
+            // take the batch out of the list, so it is released as soon as it is uploaded
+            auto document = std::move(documents[next++]);
+            lock.unlock();
+
+            AddressBookSyncIndex::EntryHashes batchHashes;
+            if (m_syncIndex != nullptr) {
+                batchHashes = hashEntries({document});
+            }
+
+            double uploadStartTimer = getCurrentTimeInMs();
+            bool success = upload(cloudAddressBookId, document);
+            double duration = getCurrentTimeInMs() - uploadStartTimer;
+            document.reset();
+
+            if (success && m_syncIndex != nullptr) {
+                {
+                    std::lock_guard<std::mutex> failedEntriesLock(m_failedEntriesMutex);
+                    for (const auto& entryId : m_failedEntryIds) {
+                        batchHashes.erase(entryId);
+                    }
+                }
+                if (!m_syncIndex->addToCheckpoint(addressBookSourceId, batchHashes)) {
+                    AACE_WARN(LX(TAG, "uploadDocuments")
+                                  .d("addressBookSourceId", addressBookSourceId)
+                                  .m("addToCheckpointFailed"));
+                }
+            }
+
+            lock.lock();
+            totalDuration += duration;
+            failed = failed || !success;
+        }
+        running--;
+        completed.notify_all();
+    };
+
+    auto pool = aace::engine::utils::threading::ThreadPool::create(
+        std::min(MAX_CONCURRENT_BATCH_UPLOADS, documents.size()));
+    if (pool != nullptr) {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (size_t j = 0; j < pool->getThreadCount(); j++) {
+            running++;
+            if (!pool->post([&uploadBatches]() { uploadBatches(); })) {
+                AACE_ERROR(LX(TAG, "uploadDocuments").d("reason", "postFailed"));
+                running--;
+                failed = true;
+            }
+        }
+        completed.wait(lock, [&]() { return running == 0; });
+    } else {
+        AACE_WARN(LX(TAG, "uploadDocuments").d("reason", "createThreadPoolFailed").m("Uploading the batches serially"));
+        running++;
+        uploadBatches();
+    }
+
+    if (failed) {
+        // The cloud address book of a checkpointed upload is kept, so the next attempt resumes the upload.
+        if (m_syncIndex == nullptr) {
+            handleError(cloudAddressBookId);
+        }
+        return false;
+    }
+
+    // It is assumed that between contacts and navigation addresses the difference is payload that should not
+    // influence the latency for uploading one batch of address book entries.
+    if (next > 0) {
+        emitTimerMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX, "uploadDocuments", METRIC_TIME_TO_UPLOAD_ONE_BATCH, totalDuration / next);
+    }
+
+    return next == documents.size();
+}
+
 bool AddressBookCloudUploader::uploadEntries(
     const std::string& cloudAddressBookId,
     std::shared_ptr<rapidjson::Document> document) {
@@ -1107,7 +1786,8 @@ bool AddressBookCloudUploader::uploadEntries(
                 nextFlowState = handleParseHTTPResponse(httpResponse);
                 break;
             case UploadFlowState::ERROR:
-                nextFlowState = handleError(cloudAddressBookId);
+                // the cloud address book is deleted by uploadDocuments, once the batches in flight are completed
+                nextFlowState = UploadFlowState::FINISH;
                 success = false;
                 break;
             case UploadFlowState::FINISH:
@@ -1119,7 +1799,7 @@ bool AddressBookCloudUploader::uploadEntries(
     return success;
 }
 
-AddressBookCloudUploader::UploadFlowState AddressBookCloudUploader::handleError(const std::string& cloudAddressBookId) {
+void AddressBookCloudUploader::handleError(const std::string& cloudAddressBookId) {
     try {
         ThrowIfNot(
             m_addressBookCloudUploaderRESTAgent->deleteCloudAddressBook(cloudAddressBookId),
@@ -1127,8 +1807,6 @@ AddressBookCloudUploader::UploadFlowState AddressBookCloudUploader::handleError(
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "handleError").d("reason", ex.what()));
     }
-
-    return UploadFlowState::FINISH;
 }
 
 AddressBookCloudUploader::UploadFlowState AddressBookCloudUploader::handleUploadEntries(
@@ -1173,6 +1851,11 @@ AddressBookCloudUploader::UploadFlowState AddressBookCloudUploader::handleParseH
         // Continue to upload rest of the entries, even if there are one or more failed entries.
         if (failedEntries.size()) {
             AACE_WARN(LX(TAG, "handleParse").d("NumberOfFailedEntries", failedEntries.size()));
+            std::lock_guard<std::mutex> lock(m_failedEntriesMutex);
+            while (!failedEntries.empty()) {
+                m_failedEntryIds.insert(failedEntries.front());
+                failedEntries.pop();
+            }
         }
 
         return UploadFlowState::FINISH;
@@ -1263,6 +1946,20 @@ bool AddressBookCloudUploader::cleanAllCloudAddressBooks() {
             return false;
         }
 
+        // The cloud address books of the recent interrupted uploads are kept, so their upload is resumed.
+        std::unordered_set<std::string> checkpointedCloudAddressBookIds;
+        if (m_syncIndex != nullptr) {
+            ThrowIfNot(m_syncIndex->clear(), "clearSyncIndexFailed");
+            checkpointedCloudAddressBookIds = m_syncIndex->pruneCheckpoints(MAX_UPLOAD_CHECKPOINT_AGE);
+        }
+        auto isCheckpointed = [&checkpointedCloudAddressBookIds](const std::string& cloudAddressBookId) {
+            if (checkpointedCloudAddressBookIds.count(cloudAddressBookId) == 0) {
+                return false;
+            }
+            AACE_INFO(LX(TAG, "cleanAllCloudAddressBooks").m("keepingCheckpointedAddressBook"));
+            return true;
+        };
+
         if (!m_addressBookCloudUploaderRESTAgent->isAccountProvisioned()) {
             // Account not provisioned, no further action required.
             AACE_DEBUG(LX(TAG).m("accountNotProvisioned"));
@@ -1276,7 +1973,7 @@ bool AddressBookCloudUploader::cleanAllCloudAddressBooks() {
         ThrowIfNot(
             m_addressBookCloudUploaderRESTAgent->getCloudAddressBookId(dsn, "automotive", cloudAddressBookId),
             "getCloudAddressBookIdFailed");
-        if (!cloudAddressBookId.empty()) {
+        if (!cloudAddressBookId.empty() && !isCheckpointed(cloudAddressBookId)) {
             ThrowIfNot(
                 m_addressBookCloudUploaderRESTAgent->deleteCloudAddressBook(cloudAddressBookId),
                 "deleteCloudAddressBookFailed");
@@ -1288,7 +1985,7 @@ bool AddressBookCloudUploader::cleanAllCloudAddressBooks() {
             m_addressBookCloudUploaderRESTAgent->getCloudAddressBookId(
                 dsn, "automotivePostalAddress", cloudAddressBookId),
             "getCloudAddressBookIdFailed");
-        if (!cloudAddressBookId.empty()) {
+        if (!cloudAddressBookId.empty() && !isCheckpointed(cloudAddressBookId)) {
             ThrowIfNot(
                 m_addressBookCloudUploaderRESTAgent->deleteCloudAddressBook(cloudAddressBookId),
                 "deleteCloudAddressBookFailed");
@@ -15,8 +15,7 @@
 
 #include <AACE/Engine/Core/EngineMacros.h>
 #include <AACE/Engine/AddressBook/AddressBookCloudUploaderRESTAgent.h>
-
-#include "zlib.h"
+#include <AACE/Engine/Alexa/HttpClientPool.h>
 
 namespace aace {
 namespace engine {
@@ -167,14 +166,10 @@ AddressBookCloudUploaderRESTAgent::HTTPResponse AddressBookCloudUploaderRESTAgen
     const std::string& url,
     const std::vector<std::string> headerLines,
     const std::string& data,
-    std::chrono::seconds timeout) {
+    std::chrono::seconds timeout,
+    aace::engine::alexa::HttpClientPool::ContentEncoding encoding) {
     try {
-        // Creating the HttpPost on every doPost is by design to ensure that curl in libcurlUtils uses the
-        // latest provided curl options.
-        auto httpPost = alexaClientSDK::avsCommon::utils::libcurlUtils::HttpPost::create();
-        ThrowIfNull(httpPost, "nullHttpPost");
-
-        return httpPost->doPost(url, headerLines, data, timeout);
+        return aace::engine::alexa::HttpClientPool::getInstance()->doPost(url, headerLines, data, timeout, encoding);
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "doPost").d("reason", ex.what()));
         return AddressBookCloudUploaderRESTAgent::HTTPResponse();
@@ -185,12 +180,7 @@ AddressBookCloudUploaderRESTAgent::HTTPResponse AddressBookCloudUploaderRESTAgen
     const std::string& url,
     const std::vector<std::string>& headers) {
     try {
-        // Creating the HttpGet on every doGet is by design to ensure that curl in libcurlUtils uses the
-        // latest provided curl options.
-        auto httpGet = alexaClientSDK::avsCommon::utils::libcurlUtils::HttpGet::create();
-        ThrowIfNull(httpGet, "nullHttpGet");
-
-        return httpGet->doGet(url, headers, DEFAULT_HTTP_TIMEOUT);
+        return aace::engine::alexa::HttpClientPool::getInstance()->doGet(url, headers, DEFAULT_HTTP_TIMEOUT);
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "doGet").d("reason", ex.what()));
         return AddressBookCloudUploaderRESTAgent::HTTPResponse();
@@ -201,12 +191,7 @@ AddressBookCloudUploaderRESTAgent::HTTPResponse AddressBookCloudUploaderRESTAgen
     const std::string& url,
     const std::vector<std::string>& headers) {
     try {
-        // Creating the HttpDelete on every doDelete is by design to ensure that curl in libcurlUtils uses the
-        // latest provided curl options.
-        auto httpDelete = alexaClientSDK::avsCommon::utils::libcurlUtils::HttpDelete::create();
-        ThrowIfNull(httpDelete, "nullHttpDelete");
-
-        return httpDelete->doDelete(url, headers, DEFAULT_HTTP_TIMEOUT);
+        return aace::engine::alexa::HttpClientPool::getInstance()->doDelete(url, headers, DEFAULT_HTTP_TIMEOUT);
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "doDelete").d("reason", ex.what()));
         return AddressBookCloudUploaderRESTAgent::HTTPResponse();
@@ -452,46 +437,6 @@ bool AddressBookCloudUploaderRESTAgent::getCloudAddressBookId(
     }
 }
 
-/**
- * Compress input byte stream with gzip.
- *
- * @param bytes the input byte stream
- * @param gzipped the output compressed stream
- * @return Z_OK if success. zlib error code otherwise.
- */
-static int gzip(const std::string& bytes, std::string& gzipped) {
-    z_stream zstr;
-    zstr.zalloc = Z_NULL;
-    zstr.zfree = Z_NULL;
-    zstr.opaque = Z_NULL;
-    zstr.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(bytes.data()));
-    zstr.avail_in = bytes.length();
-
-    int ret = deflateInit2(&zstr, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
-    if (ret != Z_OK) {
-        deflateEnd(&zstr);
-        return ret;
-    }
-
-    size_t maxOut = deflateBound(&zstr, bytes.length()) + 12;
-    gzipped.resize(maxOut);
-    zstr.next_out = reinterpret_cast<Bytef*>(&gzipped[0]);
-    zstr.avail_out = gzipped.capacity();
-    ret = deflate(&zstr, Z_FINISH);
-    if (Z_STREAM_END != ret) {
-        deflateEnd(&zstr);
-        return ret;
-    }
-
-    ret = deflateEnd(&zstr);
-    if (Z_OK != ret) {
-        return ret;
-    }
-
-    gzipped.resize(zstr.total_out);
-    return Z_OK;
-}
-
 AddressBookCloudUploaderRESTAgent::HTTPResponse AddressBookCloudUploaderRESTAgent::uploadDocumentToCloud(
     std::shared_ptr<rapidjson::Document> document,
     const std::string& cloudAddressBookId) {
@@ -500,20 +445,18 @@ AddressBookCloudUploaderRESTAgent::HTTPResponse AddressBookCloudUploaderRESTAgen
     auto httpHeaderData = buildCommonHTTPHeader();
     httpHeaderData.insert(httpHeaderData.end(), CONTENT_TYPE_APPLICATION_JSON);
 
+    // the entries are compressed by the client pool, which sends them as is if they can't be compressed
     auto content = aace::engine::utils::json::toString(*document);
-    std::string gzipped;
-    int ret = gzip(content, gzipped);
-    if (ret == Z_OK) {
-        httpHeaderData.insert(httpHeaderData.end(), "Content-Encoding: gzip");
-        content = std::move(gzipped);
-    } else {
-        AACE_ERROR(LX(TAG, "failedToCompressContent").d("error", ret));
-    }
 
     auto url = m_acmsEndpoint + FORWARD_SLASH + USERS_PATH + FORWARD_SLASH + getPceId() + FORWARD_SLASH +
                ADDRESSBOOK_PATH + FORWARD_SLASH + cloudAddressBookId + FORWARD_SLASH + ENTRIES_PATH;
     for (int retryCount = 0; retryCount < HTTP_RETRY_COUNT; retryCount++) {
-        httpResponse = doPost(url, httpHeaderData, content, DEFAULT_HTTP_TIMEOUT);
+        httpResponse = doPost(
+            url,
+            httpHeaderData,
+            content,
+            DEFAULT_HTTP_TIMEOUT,
+            aace::engine::alexa::HttpClientPool::ContentEncoding::GZIP);
         switch (httpResponse.code) {
             case HTTPResponseCode::SUCCESS_OK:
                 return httpResponse;
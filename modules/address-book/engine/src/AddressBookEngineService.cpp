@@ -20,6 +20,7 @@
 #include <AACE/Engine/Core/EngineMacros.h>
 #include <AACE/Engine/Alexa/AlexaEngineService.h>
 #include <AACE/Engine/Network/NetworkEngineService.h>
+#include <AACE/Engine/Storage/LocalStorageInterface.h>
 #include <AACE/Engine/Utils/Metrics/Metrics.h>
 
 #include <AACE/Engine/AddressBook/AddressBookEngineService.h>
@@ -122,6 +123,22 @@ bool AddressBookEngineService::registerPlatformInterfaceType(
             getContext()->getServiceInterface<aace::engine::alexa::AlexaEndpointInterface>("aace.alexa");
         ThrowIfNull(alexaEndpoints, "alexaEndpointsInvalid");
 
+        // the local storage keeps the sync state of the address books, so the next uploads only send the new entries
+        auto localStorage =
+            getContext()->getServiceInterface<aace::engine::storage::LocalStorageInterface>("aace.storage");
+
+        // the uploads are deferred on a weak wifi signal, a metered link or during a voice interaction
+        auto backgroundTransferScheduler =
+            getContext()->getServiceInterface<aace::engine::network::BackgroundTransferScheduler>("aace.network");
+
+        // the contacts are resolved on the device by the services calling or messaging them, such as phone control
+        // and messaging, while the address books are uploaded
+        auto contactNameIndex = ContactNameIndex::create();
+        ThrowIfNull(contactNameIndex, "createContactNameIndexFailed");
+        ThrowIfNot(
+            registerServiceInterface<aace::engine::contacts::ContactResolverInterface>(contactNameIndex),
+            "registerContactResolverInterfaceFailed");
+
         m_addressBookCloudUploader = aace::engine::addressBook::AddressBookCloudUploader::create(
             m_addressBookEngineImpl,
             authDelegate,
@@ -129,7 +146,10 @@ bool AddressBookEngineService::registerPlatformInterfaceType(
             networkStatus,
             networkObserver,
             alexaEndpoints,
-            m_cleanAllAddressBooksAtStart);
+            m_cleanAllAddressBooksAtStart,
+            localStorage,
+            backgroundTransferScheduler,
+            contactNameIndex);
         ThrowIfNull(m_addressBookCloudUploader, "createAddressBookCloudUploaderFailed");
 
         // set the engine interface reference
@@ -0,0 +1,341 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include <AACE/Engine/AddressBook/AddressBookSyncIndex.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace addressBook {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.addressBook.addressBookSyncIndex");
+
+/// Table mapping each synced address book source to its cloud address book. A source is only synced once its key
+/// is written, after its entry hashes, so an interrupted save never leaves a partial index behind.
+static const std::string SYNC_INDEX_TABLE = "aace.addressBook.syncIndex";
+
+/// Prefix of the tables of the entry hashes of each address book source
+static const std::string ENTRIES_TABLE_PREFIX = "aace.addressBook.syncIndex.";
+
+/// Table mapping each address book source with an upload in progress to its cloud address book
+static const std::string CHECKPOINT_TABLE = "aace.addressBook.uploadCheckpoint";
+
+/// Table of the time each checkpoint was last updated, in milliseconds since the epoch
+static const std::string CHECKPOINT_TIME_TABLE = "aace.addressBook.uploadCheckpointTime";
+
+/// Prefix of the tables of the acknowledged entry hashes of each upload in progress
+static const std::string CHECKPOINT_ENTRIES_TABLE_PREFIX = "aace.addressBook.uploadCheckpoint.";
+
+/// FNV-1a 64 bit offset basis
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+/// FNV-1a 64 bit prime
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/// Returns the current time in milliseconds since the epoch, which is kept across Engine runs
+static std::string getCurrentTime() {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+
+std::shared_ptr<AddressBookSyncIndex> AddressBookSyncIndex::create(
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage) {
+    try {
+        ThrowIfNull(localStorage, "invalidLocalStorage");
+        return std::shared_ptr<AddressBookSyncIndex>(new AddressBookSyncIndex(localStorage));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+AddressBookSyncIndex::AddressBookSyncIndex(std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage) :
+        m_localStorage(localStorage) {
+}
+
+std::string AddressBookSyncIndex::hash(const std::string& content) {
+    // std::hash is not guaranteed to be the same across Engine builds, so the persisted hashes use FNV-1a
+    uint64_t value = FNV_OFFSET_BASIS;
+    for (auto c : content) {
+        value ^= static_cast<uint8_t>(c);
+        value *= FNV_PRIME;
+    }
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return std::string(buffer);
+}
+
+AddressBookSyncIndex::Delta AddressBookSyncIndex::computeDelta(const EntryHashes& synced, const EntryHashes& current) {
+    Delta delta;
+    for (const auto& entry : current) {
+        auto it = synced.find(entry.first);
+        if (it == synced.end()) {
+            delta.added.push_back(entry.first);
+        } else if (it->second != entry.second) {
+            delta.changed.push_back(entry.first);
+        }
+    }
+    for (const auto& entry : synced) {
+        if (current.find(entry.first) == current.end()) {
+            delta.removed.push_back(entry.first);
+        }
+    }
+    return delta;
+}
+
+std::string AddressBookSyncIndex::getEntriesTable(const std::string& addressBookSourceId) {
+    return ENTRIES_TABLE_PREFIX + addressBookSourceId;
+}
+
+std::string AddressBookSyncIndex::getCheckpointEntriesTable(const std::string& addressBookSourceId) {
+    return CHECKPOINT_ENTRIES_TABLE_PREFIX + addressBookSourceId;
+}
+
+bool AddressBookSyncIndex::loadLocked(
+    const std::string& indexTable,
+    const std::string& entriesTable,
+    const std::string& addressBookSourceId,
+    std::string& cloudAddressBookId,
+    EntryHashes& entryHashes) {
+    if (!m_localStorage->containsKey(indexTable, addressBookSourceId)) {
+        return false;
+    }
+    cloudAddressBookId = m_localStorage->get(indexTable, addressBookSourceId);
+    ThrowIf(cloudAddressBookId.empty(), "invalidCloudAddressBookId");
+
+    entryHashes.clear();
+    if (m_localStorage->containsTable(entriesTable)) {
+        ThrowIfNot(
+            m_localStorage->forEach(
+                entriesTable,
+                [&entryHashes](const std::string& key, const std::string& value) {
+                    entryHashes[key] = value;
+                    return true;
+                }),
+            "readEntriesFailed");
+    }
+    return true;
+}
+
+void AddressBookSyncIndex::removeLocked(
+    const std::string& indexTable,
+    const std::string& entriesTable,
+    const std::string& addressBookSourceId) {
+    if (m_localStorage->containsKey(indexTable, addressBookSourceId)) {
+        ThrowIfNot(m_localStorage->removeKey(indexTable, addressBookSourceId), "removeStateFailed");
+    }
+    if (m_localStorage->containsTable(entriesTable)) {
+        ThrowIfNot(m_localStorage->removeTable(entriesTable), "removeEntriesFailed");
+    }
+}
+
+void AddressBookSyncIndex::removeCheckpointLocked(const std::string& addressBookSourceId) {
+    removeLocked(CHECKPOINT_TABLE, getCheckpointEntriesTable(addressBookSourceId), addressBookSourceId);
+    if (m_localStorage->containsKey(CHECKPOINT_TIME_TABLE, addressBookSourceId)) {
+        ThrowIfNot(m_localStorage->removeKey(CHECKPOINT_TIME_TABLE, addressBookSourceId), "removeCheckpointTimeFailed");
+    }
+}
+
+bool AddressBookSyncIndex::load(
+    const std::string& addressBookSourceId,
+    std::string& cloudAddressBookId,
+    EntryHashes& entryHashes) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return loadLocked(
+            SYNC_INDEX_TABLE,
+            getEntriesTable(addressBookSourceId),
+            addressBookSourceId,
+            cloudAddressBookId,
+            entryHashes);
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "load").d("addressBookSourceId", addressBookSourceId).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool AddressBookSyncIndex::save(
+    const std::string& addressBookSourceId,
+    const std::string& cloudAddressBookId,
+    const EntryHashes& entryHashes) {
+    try {
+        ThrowIf(cloudAddressBookId.empty(), "invalidCloudAddressBookId");
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // forget the previous state first, so the source is not synced until all of its entries are written
+        auto table = getEntriesTable(addressBookSourceId);
+        removeLocked(SYNC_INDEX_TABLE, table, addressBookSourceId);
+
+        std::vector<aace::engine::storage::LocalStorageInterface::KeyValuePair> values(
+            entryHashes.begin(), entryHashes.end());
+        if (!values.empty()) {
+            ThrowIfNot(m_localStorage->putBatch(table, values), "putEntriesFailed");
+        }
+        ThrowIfNot(
+            m_localStorage->put(SYNC_INDEX_TABLE, addressBookSourceId, cloudAddressBookId), "putSyncStateFailed");
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "save").d("addressBookSourceId", addressBookSourceId).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool AddressBookSyncIndex::remove(const std::string& addressBookSourceId) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        removeLocked(SYNC_INDEX_TABLE, getEntriesTable(addressBookSourceId), addressBookSourceId);
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "remove").d("addressBookSourceId", addressBookSourceId).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool AddressBookSyncIndex::clear() {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_localStorage->containsTable(SYNC_INDEX_TABLE)) {
+            return true;
+        }
+        auto addressBookSourceIds = m_localStorage->keys(SYNC_INDEX_TABLE);
+        ThrowIfNot(m_localStorage->removeTable(SYNC_INDEX_TABLE), "removeSyncIndexFailed");
+        for (const auto& addressBookSourceId : addressBookSourceIds) {
+            auto table = getEntriesTable(addressBookSourceId);
+            if (m_localStorage->containsTable(table)) {
+                ThrowIfNot(m_localStorage->removeTable(table), "removeEntriesFailed");
+            }
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "clear").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool AddressBookSyncIndex::loadCheckpoint(
+    const std::string& addressBookSourceId,
+    std::string& cloudAddressBookId,
+    EntryHashes& entryHashes) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return loadLocked(
+            CHECKPOINT_TABLE,
+            getCheckpointEntriesTable(addressBookSourceId),
+            addressBookSourceId,
+            cloudAddressBookId,
+            entryHashes);
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "loadCheckpoint").d("addressBookSourceId", addressBookSourceId).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool AddressBookSyncIndex::saveCheckpoint(
+    const std::string& addressBookSourceId,
+    const std::string& cloudAddressBookId,
+    const EntryHashes& entryHashes) {
+    try {
+        ThrowIf(cloudAddressBookId.empty(), "invalidCloudAddressBookId");
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // as for the sync state, the checkpoint is only valid once its key is written after its entries
+        auto table = getCheckpointEntriesTable(addressBookSourceId);
+        removeLocked(CHECKPOINT_TABLE, table, addressBookSourceId);
+
+        std::vector<aace::engine::storage::LocalStorageInterface::KeyValuePair> values(
+            entryHashes.begin(), entryHashes.end());
+        if (!values.empty()) {
+            ThrowIfNot(m_localStorage->putBatch(table, values), "putEntriesFailed");
+        }
+        ThrowIfNot(
+            m_localStorage->put(CHECKPOINT_TIME_TABLE, addressBookSourceId, getCurrentTime()),
+            "putCheckpointTimeFailed");
+        ThrowIfNot(
+            m_localStorage->put(CHECKPOINT_TABLE, addressBookSourceId, cloudAddressBookId), "putCheckpointFailed");
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "saveCheckpoint").d("addressBookSourceId", addressBookSourceId).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool AddressBookSyncIndex::addToCheckpoint(const std::string& addressBookSourceId, const EntryHashes& entryHashes) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ThrowIfNot(m_localStorage->containsKey(CHECKPOINT_TABLE, addressBookSourceId), "uploadNotInProgress");
+
+        // an entry written before an interruption was acknowledged, so a partially written batch is still valid
+        std::vector<aace::engine::storage::LocalStorageInterface::KeyValuePair> values(
+            entryHashes.begin(), entryHashes.end());
+        if (!values.empty()) {
+            ThrowIfNot(
+                m_localStorage->putBatch(getCheckpointEntriesTable(addressBookSourceId), values), "putEntriesFailed");
+        }
+        ThrowIfNot(
+            m_localStorage->put(CHECKPOINT_TIME_TABLE, addressBookSourceId, getCurrentTime()),
+            "putCheckpointTimeFailed");
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "addToCheckpoint").d("addressBookSourceId", addressBookSourceId).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool AddressBookSyncIndex::removeCheckpoint(const std::string& addressBookSourceId) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        removeCheckpointLocked(addressBookSourceId);
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "removeCheckpoint").d("addressBookSourceId", addressBookSourceId).d("reason", ex.what()));
+        return false;
+    }
+}
+
+std::unordered_set<std::string> AddressBookSyncIndex::pruneCheckpoints(std::chrono::milliseconds maxAge) {
+    std::unordered_set<std::string> cloudAddressBookIds;
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_localStorage->containsTable(CHECKPOINT_TABLE)) {
+            return cloudAddressBookIds;
+        }
+        auto now = std::stoll(getCurrentTime());
+        for (const auto& addressBookSourceId : m_localStorage->keys(CHECKPOINT_TABLE)) {
+            auto time = m_localStorage->get(CHECKPOINT_TIME_TABLE, addressBookSourceId, "0");
+            if (now - std::stoll(time) <= maxAge.count()) {
+                cloudAddressBookIds.insert(m_localStorage->get(CHECKPOINT_TABLE, addressBookSourceId));
+                continue;
+            }
+            AACE_INFO(LX(TAG, "pruneCheckpoints").d("addressBookSourceId", addressBookSourceId).m("checkpointExpired"));
+            removeCheckpointLocked(addressBookSourceId);
+        }
+        return cloudAddressBookIds;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "pruneCheckpoints").d("reason", ex.what()));
+        return cloudAddressBookIds;
+    }
+}
+
+}  // namespace addressBook
+}  // namespace engine
+}  // namespace aace
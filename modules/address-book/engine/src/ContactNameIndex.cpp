@@ -0,0 +1,269 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <AACE/Engine/AddressBook/ContactNameIndex.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace addressBook {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.addressBook.contactNameIndex");
+
+/// Length of the Soundex keys
+static const size_t PHONETIC_KEY_SIZE = 4;
+
+/// Soundex digit of each letter from 'a' to 'z', 0 for the letters that are not coded
+static const char SOUNDEX_CODES[] = "01230120022455012623010202";
+
+static bool isLetter(char c) {
+    return c >= 'a' && c <= 'z';
+}
+
+std::shared_ptr<ContactNameIndex> ContactNameIndex::create() {
+    return std::shared_ptr<ContactNameIndex>(new ContactNameIndex());
+}
+
+std::vector<std::string> ContactNameIndex::normalize(const std::string& name) {
+    std::vector<std::string> words;
+    std::string word;
+    for (auto c : name) {
+        auto byte = static_cast<unsigned char>(c);
+        if (byte >= 0x80 || (c >= '0' && c <= '9') || isLetter(c)) {
+            word.push_back(c);
+        } else if (c >= 'A' && c <= 'Z') {
+            word.push_back(static_cast<char>(c - 'A' + 'a'));
+        } else if (c == '\'') {
+            // "O'Brien" is one word
+            continue;
+        } else if (!word.empty()) {
+            words.push_back(std::move(word));
+            word.clear();
+        }
+    }
+    if (!word.empty()) {
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+std::string ContactNameIndex::phoneticKey(const std::string& word) {
+    if (word.empty() || !isLetter(word[0])) {
+        return "";
+    }
+    std::string key(1, word[0]);
+    auto previous = SOUNDEX_CODES[word[0] - 'a'];
+    for (size_t i = 1; i < word.size() && key.size() < PHONETIC_KEY_SIZE; i++) {
+        auto c = word[i];
+        if (!isLetter(c)) {
+            continue;
+        }
+        auto code = SOUNDEX_CODES[c - 'a'];
+        if (code != '0' && code != previous) {
+            key.push_back(code);
+        }
+        // 'h' and 'w' don't separate two letters of the same code, the vowels do
+        if (c != 'h' && c != 'w') {
+            previous = code;
+        }
+    }
+    key.resize(PHONETIC_KEY_SIZE, '0');
+    return key;
+}
+
+void ContactNameIndex::update(const std::string& addressBookSourceId, std::vector<Entry> entries) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_contacts.erase(
+        std::remove_if(
+            m_contacts.begin(),
+            m_contacts.end(),
+            [&addressBookSourceId](const Contact& contact) {
+                return contact.addressBookSourceId == addressBookSourceId;
+            }),
+        m_contacts.end());
+    for (auto& entry : entries) {
+        m_contacts.push_back({addressBookSourceId, std::move(entry)});
+    }
+    rebuildLocked();
+    AACE_DEBUG(LX(TAG).d("addressBookSourceId", addressBookSourceId).d("contacts", m_contacts.size()));
+}
+
+void ContactNameIndex::remove(const std::string& addressBookSourceId) {
+    update(addressBookSourceId, {});
+}
+
+void ContactNameIndex::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_contacts.clear();
+    rebuildLocked();
+}
+
+size_t ContactNameIndex::getContactCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_contacts.size();
+}
+
+std::vector<ContactNameIndex::Match> ContactNameIndex::resolve(const std::string& name, size_t maxMatches) {
+    auto words = normalize(name);
+    if (words.empty() || maxMatches == 0) {
+        return {};
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // the match of a contact is the weakest match of the words of the name, and a contact is dropped as soon as a
+    // word does not match it
+    std::unordered_map<uint32_t, MatchType> candidates;
+    for (size_t i = 0; i < words.size(); i++) {
+        std::unordered_map<uint32_t, MatchType> wordMatches;
+        if (auto node = findLocked(words[i])) {
+            std::vector<uint32_t> contacts;
+            collectLocked(*node, contacts);
+            for (auto contact : contacts) {
+                wordMatches.emplace(contact, MatchType::PREFIX);
+            }
+            for (auto contact : node->contacts) {
+                wordMatches[contact] = MatchType::EXACT;
+            }
+        }
+        auto it = m_phoneticKeys.find(phoneticKey(words[i]));
+        if (it != m_phoneticKeys.end()) {
+            for (auto contact : it->second) {
+                wordMatches.emplace(contact, MatchType::PHONETIC);
+            }
+        }
+
+        if (i == 0) {
+            candidates = std::move(wordMatches);
+            continue;
+        }
+        for (auto candidate = candidates.begin(); candidate != candidates.end();) {
+            auto wordMatch = wordMatches.find(candidate->first);
+            if (wordMatch == wordMatches.end()) {
+                candidate = candidates.erase(candidate);
+            } else {
+                candidate->second = std::max(candidate->second, wordMatch->second);
+                candidate++;
+            }
+        }
+    }
+
+    std::vector<std::pair<MatchType, uint32_t>> ranked;
+    for (const auto& candidate : candidates) {
+        ranked.emplace_back(candidate.second, candidate.first);
+    }
+    std::sort(
+        ranked.begin(),
+        ranked.end(),
+        [this](const std::pair<MatchType, uint32_t>& a, const std::pair<MatchType, uint32_t>& b) {
+            if (a.first != b.first) {
+                return a.first < b.first;
+            }
+            const auto& aNames = m_contacts[a.second].entry.names;
+            const auto& bNames = m_contacts[b.second].entry.names;
+            auto aName = aNames.empty() ? std::string() : aNames.front();
+            auto bName = bNames.empty() ? std::string() : bNames.front();
+            return aName != bName ? aName < bName : a.second < b.second;
+        });
+    if (ranked.size() > maxMatches) {
+        ranked.resize(maxMatches);
+    }
+
+    std::vector<Match> matches;
+    for (const auto& rank : ranked) {
+        const auto& contact = m_contacts[rank.second];
+        auto contactName = contact.entry.names.empty() ? std::string() : contact.entry.names.front();
+        matches.push_back(
+            {contact.addressBookSourceId, contact.entry.entryId, contactName, contact.entry.phoneNumbers, rank.first});
+    }
+    AACE_DEBUG(LX(TAG).d("candidates", candidates.size()).d("matches", matches.size()));
+    return matches;
+}
+
+void ContactNameIndex::rebuildLocked() {
+    m_trie.clear();
+    m_trie.emplace_back();
+    m_phoneticKeys.clear();
+    for (size_t i = 0; i < m_contacts.size(); i++) {
+        auto contact = static_cast<uint32_t>(i);
+        std::unordered_set<std::string> phoneticKeys;
+        for (const auto& name : m_contacts[i].entry.names) {
+            for (const auto& word : normalize(name)) {
+                insertLocked(word, contact);
+                auto key = phoneticKey(word);
+                if (!key.empty() && phoneticKeys.insert(key).second) {
+                    m_phoneticKeys[key].push_back(contact);
+                }
+            }
+        }
+    }
+    m_trie.shrink_to_fit();
+}
+
+void ContactNameIndex::insertLocked(const std::string& word, uint32_t contact) {
+    uint32_t node = 0;
+    for (auto c : word) {
+        auto& children = m_trie[node].children;
+        auto it = std::lower_bound(
+            children.begin(), children.end(), c, [](const std::pair<char, uint32_t>& child, char value) {
+                return child.first < value;
+            });
+        if (it != children.end() && it->first == c) {
+            node = it->second;
+        } else {
+            auto child = static_cast<uint32_t>(m_trie.size());
+            children.insert(it, {c, child});
+            // the child is linked before the node is added, since adding it may move the nodes
+            m_trie.emplace_back();
+            node = child;
+        }
+    }
+    // the contacts are indexed in order, so a repeated word of the same contact is the last one of the node
+    auto& contacts = m_trie[node].contacts;
+    if (contacts.empty() || contacts.back() != contact) {
+        contacts.push_back(contact);
+    }
+}
+
+const ContactNameIndex::TrieNode* ContactNameIndex::findLocked(const std::string& word) const {
+    uint32_t node = 0;
+    for (auto c : word) {
+        const auto& children = m_trie[node].children;
+        auto it = std::lower_bound(
+            children.begin(), children.end(), c, [](const std::pair<char, uint32_t>& child, char value) {
+                return child.first < value;
+            });
+        if (it == children.end() || it->first != c) {
+            return nullptr;
+        }
+        node = it->second;
+    }
+    return &m_trie[node];
+}
+
+void ContactNameIndex::collectLocked(const TrieNode& node, std::vector<uint32_t>& contacts) const {
+    contacts.insert(contacts.end(), node.contacts.begin(), node.contacts.end());
+    for (const auto& child : node.children) {
+        collectLocked(m_trie[child.second], contacts);
+    }
+}
+
+}  // namespace addressBook
+}  // namespace engine
+}  // namespace aace
@@ -585,6 +585,48 @@ TEST_F(AddressBookCloudUploaderTest, AddingEntryWithSameEntryIdShouldFail) {
     EXPECT_TRUE(waitEvent.wait(TIMEOUT));
 }
 
+TEST_F(AddressBookCloudUploaderTest, VerifyEntryPayloadFieldTypes) {
+    alexaClientSDK::avsCommon::utils::WaitEvent waitEvent;
+    EXPECT_CALL(*m_mockAuthDelegate, getAuthToken())
+        .Times(testing::AtLeast(1))
+        .WillRepeatedly(testing::Return(std::string(AUTH_TOKEN)));
+    EXPECT_CALL(*m_mockAddressBookServiceInterface, getEntries(testing::_, testing::_))
+        .Times(testing::AtLeast(1))
+        .WillRepeatedly(testing::Invoke(
+            [&waitEvent](
+                const std::string& id,
+                std::weak_ptr<aace::addressBook::AddressBook::IAddressBookEntriesFactory> factory) -> bool {
+                if (auto sharedRef = factory.lock()) {
+                    // the fields the upload does not use are skipped
+                    EXPECT_TRUE(sharedRef->addEntry(
+                        R"({"extra":{"entryId":1,"name":"x"},"entryId":"001","name":{"firstName":"Alice",)"
+                        R"("other":[{"firstName":1}]},"phoneNumbers":[{"label":"HOME","number":"1234","type":{}}],)"
+                        R"("postalAddresses":null})"));
+                    EXPECT_TRUE(sharedRef->addEntry(R"({"entryId":"002","name":{},"phoneNumbers":{}})"));
+                    EXPECT_FALSE(sharedRef->addEntry(R"({"entryId":3,"name":{"firstName":"Alice"}})"));
+                    EXPECT_FALSE(sharedRef->addEntry(R"({"entryId":"","name":{"firstName":"Alice"}})"));
+                    EXPECT_FALSE(sharedRef->addEntry(R"({"entryId":"004","name":"Alice"})"));
+                    EXPECT_FALSE(sharedRef->addEntry(R"({"entryId":"005","name":{"firstName":["Alice"]}})"));
+                    EXPECT_FALSE(sharedRef->addEntry(R"({"entryId":"006","name":{},"phoneNumbers":{"a":1}})"));
+                    EXPECT_FALSE(sharedRef->addEntry(R"({"entryId":"007","name":{},"phoneNumbers":[{"label":1}]})"));
+                    EXPECT_FALSE(sharedRef->addEntry(R"({"entryId":"008","name":{},"phoneNumbers":["1234"]})"));
+                    EXPECT_FALSE(sharedRef->addEntry(R"([{"entryId":"009","name":{}}])"));
+                    EXPECT_FALSE(sharedRef->addEntry(R"({"entryId":"010","name":{})"));
+                }
+                waitEvent.wakeUp();
+                return true;
+            }));
+
+    m_addressBookCloudUploader->onNetworkInfoChanged(aace::network::NetworkInfoProvider::NetworkStatus::CONNECTED, 123);
+    m_addressBookCloudUploader->onAuthStateChange(
+        alexaClientSDK::avsCommon::sdkInterfaces::AuthObserverInterface::State::REFRESHED,
+        alexaClientSDK::avsCommon::sdkInterfaces::AuthObserverInterface::Error::SUCCESS);
+
+    m_addressBookCloudUploader->addressBookAdded(m_mockContactAddressBook);
+
+    EXPECT_TRUE(waitEvent.wait(TIMEOUT));
+}
+
 TEST_F(AddressBookCloudUploaderTest, AddingTwoPhoneNumbersShouldPass_deprecated) {
     alexaClientSDK::avsCommon::utils::WaitEvent waitEvent;
     EXPECT_CALL(*m_mockAuthDelegate, getAuthToken())
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/AddressBook/AddressBookSyncIndex.h>
+#include <AACE/Test/Unit/Storage/InMemoryLocalStorage.h>
+
+namespace aace {
+namespace test {
+namespace unit {
+namespace addressBook {
+
+using aace::engine::addressBook::AddressBookSyncIndex;
+using aace::test::unit::storage::InMemoryLocalStorage;
+
+class AddressBookSyncIndexTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_localStorage = std::make_shared<InMemoryLocalStorage>();
+        m_syncIndex = AddressBookSyncIndex::create(m_localStorage);
+        ASSERT_NE(m_syncIndex, nullptr);
+    }
+
+protected:
+    std::shared_ptr<InMemoryLocalStorage> m_localStorage;
+    std::shared_ptr<AddressBookSyncIndex> m_syncIndex;
+};
+
+TEST_F(AddressBookSyncIndexTest, CreateWithNullLocalStorageShouldFail) {
+    EXPECT_EQ(AddressBookSyncIndex::create(nullptr), nullptr);
+}
+
+TEST_F(AddressBookSyncIndexTest, HashShouldDependOnContent) {
+    EXPECT_EQ(AddressBookSyncIndex::hash("{\"name\":\"Alice\"}"), AddressBookSyncIndex::hash("{\"name\":\"Alice\"}"));
+    EXPECT_NE(AddressBookSyncIndex::hash("{\"name\":\"Alice\"}"), AddressBookSyncIndex::hash("{\"name\":\"Bob\"}"));
+    // FNV-1a of the empty string is its offset basis
+    EXPECT_EQ(AddressBookSyncIndex::hash(""), "cbf29ce484222325");
+}
+
+TEST_F(AddressBookSyncIndexTest, ComputeDeltaShouldFindAddedChangedAndRemovedEntries) {
+    AddressBookSyncIndex::EntryHashes synced = {{"1", "a"}, {"2", "b"}, {"3", "c"}};
+    AddressBookSyncIndex::EntryHashes current = {{"1", "a"}, {"2", "x"}, {"4", "d"}};
+
+    auto delta = AddressBookSyncIndex::computeDelta(synced, current);
+    EXPECT_EQ(delta.added, std::vector<std::string>({"4"}));
+    EXPECT_EQ(delta.changed, std::vector<std::string>({"2"}));
+    EXPECT_EQ(delta.removed, std::vector<std::string>({"3"}));
+
+    delta = AddressBookSyncIndex::computeDelta(synced, synced);
+    EXPECT_TRUE(delta.added.empty() && delta.changed.empty() && delta.removed.empty());
+}
+
+TEST_F(AddressBookSyncIndexTest, LoadUnsyncedAddressBookShouldFail) {
+    std::string cloudAddressBookId;
+    AddressBookSyncIndex::EntryHashes entryHashes;
+    EXPECT_FALSE(m_syncIndex->load("source", cloudAddressBookId, entryHashes));
+}
+
+TEST_F(AddressBookSyncIndexTest, SaveShouldReplaceSyncState) {
+    ASSERT_TRUE(m_syncIndex->save("source", "cloud1", {{"1", "a"}, {"2", "b"}}));
+    ASSERT_TRUE(m_syncIndex->save("source", "cloud2", {{"3", "c"}}));
+
+    std::string cloudAddressBookId;
+    AddressBookSyncIndex::EntryHashes entryHashes;
+    ASSERT_TRUE(m_syncIndex->load("source", cloudAddressBookId, entryHashes));
+    EXPECT_EQ(cloudAddressBookId, "cloud2");
+    EXPECT_EQ(entryHashes, AddressBookSyncIndex::EntryHashes({{"3", "c"}}));
+}
+
+TEST_F(AddressBookSyncIndexTest, SaveWithEmptyCloudAddressBookIdShouldFail) {
+    EXPECT_FALSE(m_syncIndex->save("source", "", {{"1", "a"}}));
+}
+
+TEST_F(AddressBookSyncIndexTest, RemoveShouldForgetOnlyTheSource) {
+    ASSERT_TRUE(m_syncIndex->save("source1", "cloud1", {{"1", "a"}}));
+    ASSERT_TRUE(m_syncIndex->save("source2", "cloud2", {{"2", "b"}}));
+    ASSERT_TRUE(m_syncIndex->remove("source1"));
+
+    std::string cloudAddressBookId;
+    AddressBookSyncIndex::EntryHashes entryHashes;
+    EXPECT_FALSE(m_syncIndex->load("source1", cloudAddressBookId, entryHashes));
+    EXPECT_TRUE(m_syncIndex->load("source2", cloudAddressBookId, entryHashes));
+    EXPECT_EQ(cloudAddressBookId, "cloud2");
+
+    // removing an unsynced source is not an error
+    EXPECT_TRUE(m_syncIndex->remove("source3"));
+}
+
+TEST_F(AddressBookSyncIndexTest, ClearShouldForgetAllTheSources) {
+    ASSERT_TRUE(m_syncIndex->save("source1", "cloud1", {{"1", "a"}}));
+    ASSERT_TRUE(m_syncIndex->save("source2", "cloud2", {{"2", "b"}}));
+    ASSERT_TRUE(m_syncIndex->clear());
+
+    std::string cloudAddressBookId;
+    AddressBookSyncIndex::EntryHashes entryHashes;
+    EXPECT_FALSE(m_syncIndex->load("source1", cloudAddressBookId, entryHashes));
+    EXPECT_FALSE(m_syncIndex->load("source2", cloudAddressBookId, entryHashes));
+    EXPECT_EQ(m_localStorage->getTableCount(), 0u);
+}
+
+TEST_F(AddressBookSyncIndexTest, CheckpointShouldAccumulateAcknowledgedBatches) {
+    std::string cloudAddressBookId;
+    AddressBookSyncIndex::EntryHashes entryHashes;
+    EXPECT_FALSE(m_syncIndex->loadCheckpoint("source", cloudAddressBookId, entryHashes));
+    // a batch can't be acknowledged before the upload is started
+    EXPECT_FALSE(m_syncIndex->addToCheckpoint("source", {{"1", "a"}}));
+
+    ASSERT_TRUE(m_syncIndex->saveCheckpoint("source", "cloud1", {{"1", "a"}}));
+    ASSERT_TRUE(m_syncIndex->addToCheckpoint("source", {{"2", "b"}, {"3", "c"}}));
+    ASSERT_TRUE(m_syncIndex->loadCheckpoint("source", cloudAddressBookId, entryHashes));
+    EXPECT_EQ(cloudAddressBookId, "cloud1");
+    EXPECT_EQ(entryHashes, AddressBookSyncIndex::EntryHashes({{"1", "a"}, {"2", "b"}, {"3", "c"}}));
+
+    // a new upload replaces the checkpoint
+    ASSERT_TRUE(m_syncIndex->saveCheckpoint("source", "cloud2", {}));
+    ASSERT_TRUE(m_syncIndex->loadCheckpoint("source", cloudAddressBookId, entryHashes));
+    EXPECT_EQ(cloudAddressBookId, "cloud2");
+    EXPECT_TRUE(entryHashes.empty());
+
+    // the checkpoint is independent of the sync state
+    EXPECT_FALSE(m_syncIndex->load("source", cloudAddressBookId, entryHashes));
+}
+
+TEST_F(AddressBookSyncIndexTest, ClearShouldKeepTheCheckpoints) {
+    ASSERT_TRUE(m_syncIndex->save("source", "cloud1", {{"1", "a"}}));
+    ASSERT_TRUE(m_syncIndex->saveCheckpoint("source", "cloud2", {{"2", "b"}}));
+    ASSERT_TRUE(m_syncIndex->clear());
+
+    std::string cloudAddressBookId;
+    AddressBookSyncIndex::EntryHashes entryHashes;
+    EXPECT_FALSE(m_syncIndex->load("source", cloudAddressBookId, entryHashes));
+    EXPECT_TRUE(m_syncIndex->loadCheckpoint("source", cloudAddressBookId, entryHashes));
+    EXPECT_EQ(cloudAddressBookId, "cloud2");
+}
+
+TEST_F(AddressBookSyncIndexTest, RemoveCheckpointShouldForgetTheUpload) {
+    ASSERT_TRUE(m_syncIndex->saveCheckpoint("source", "cloud1", {{"1", "a"}}));
+    ASSERT_TRUE(m_syncIndex->removeCheckpoint("source"));
+
+    std::string cloudAddressBookId;
+    AddressBookSyncIndex::EntryHashes entryHashes;
+    EXPECT_FALSE(m_syncIndex->loadCheckpoint("source", cloudAddressBookId, entryHashes));
+
+    // removing a source without an upload in progress is not an error
+    EXPECT_TRUE(m_syncIndex->removeCheckpoint("source"));
+}
+
+TEST_F(AddressBookSyncIndexTest, PruneCheckpointsShouldForgetTheExpiredUploads) {
+    ASSERT_TRUE(m_syncIndex->saveCheckpoint("source1", "cloud1", {{"1", "a"}}));
+    ASSERT_TRUE(m_syncIndex->saveCheckpoint("source2", "cloud2", {{"2", "b"}}));
+
+    EXPECT_EQ(
+        m_syncIndex->pruneCheckpoints(std::chrono::hours(1)), std::unordered_set<std::string>({"cloud1", "cloud2"}));
+
+    // a negative age expires the checkpoints saved until now
+    EXPECT_TRUE(m_syncIndex->pruneCheckpoints(std::chrono::milliseconds(-1)).empty());
+    std::string cloudAddressBookId;
+    AddressBookSyncIndex::EntryHashes entryHashes;
+    EXPECT_FALSE(m_syncIndex->loadCheckpoint("source1", cloudAddressBookId, entryHashes));
+    EXPECT_FALSE(m_syncIndex->loadCheckpoint("source2", cloudAddressBookId, entryHashes));
+}
+
+}  // namespace addressBook
+}  // namespace unit
+}  // namespace test
+}  // namespace aace
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/AddressBook/ContactNameIndex.h>
+
+namespace aace {
+namespace test {
+namespace unit {
+namespace addressBook {
+
+using aace::engine::addressBook::ContactNameIndex;
+using MatchType = aace::engine::contacts::ContactResolverInterface::MatchType;
+
+class ContactNameIndexTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_index = ContactNameIndex::create();
+        ASSERT_NE(m_index, nullptr);
+        m_index->update(
+            "phone",
+            {{"1", {"John Smith", "Johnny"}, {"+12065550100"}},
+             {"2", {"Jon Smyth"}, {"+12065550101", "+12065550102"}},
+             {"3", {"Mary-Ann O'Brien"}, {}},
+             {"4", {"Joanna Smith"}, {}}});
+    }
+
+protected:
+    /// Returns the ids of the entries matching a name, the best matches first
+    std::vector<std::string> resolveIds(const std::string& name, size_t maxMatches = 10) {
+        std::vector<std::string> ids;
+        for (const auto& match : m_index->resolve(name, maxMatches)) {
+            ids.push_back(match.entryId);
+        }
+        return ids;
+    }
+
+    std::shared_ptr<ContactNameIndex> m_index;
+};
+
+TEST_F(ContactNameIndexTest, NormalizeShouldSplitAndLowerCaseTheWords) {
+    EXPECT_EQ(ContactNameIndex::normalize("O'Brien, Mary-Ann"), std::vector<std::string>({"obrien", "mary", "ann"}));
+    EXPECT_EQ(ContactNameIndex::normalize("  Dr. JOHN  "), std::vector<std::string>({"dr", "john"}));
+    EXPECT_EQ(ContactNameIndex::normalize("Zoë"), std::vector<std::string>({"zo\xc3\xab"}));
+    EXPECT_TRUE(ContactNameIndex::normalize(" - ").empty());
+}
+
+TEST_F(ContactNameIndexTest, PhoneticKeyShouldMatchSoundex) {
+    EXPECT_EQ(ContactNameIndex::phoneticKey("robert"), "r163");
+    EXPECT_EQ(ContactNameIndex::phoneticKey("rupert"), "r163");
+    EXPECT_EQ(ContactNameIndex::phoneticKey("ashcraft"), "a261");
+    EXPECT_EQ(ContactNameIndex::phoneticKey("pfister"), "p236");
+    EXPECT_EQ(ContactNameIndex::phoneticKey("lee"), "l000");
+    EXPECT_EQ(ContactNameIndex::phoneticKey("42"), "");
+}
+
+TEST_F(ContactNameIndexTest, ResolveShouldRankExactBeforePrefixBeforePhoneticMatches) {
+    auto matches = m_index->resolve("john smith", 10);
+    ASSERT_EQ(matches.size(), 3u);
+    EXPECT_EQ(matches[0].entryId, "1");
+    EXPECT_EQ(matches[0].name, "John Smith");
+    EXPECT_EQ(matches[0].addressBookSourceId, "phone");
+    EXPECT_EQ(matches[0].phoneNumbers, std::vector<std::string>({"+12065550100"}));
+    EXPECT_EQ(matches[0].matchType, MatchType::EXACT);
+    // "joanna" and "jon" sound like "john", and "smyth" like "smith"
+    EXPECT_EQ(matches[1].entryId, "4");
+    EXPECT_EQ(matches[1].matchType, MatchType::PHONETIC);
+    EXPECT_EQ(matches[2].entryId, "2");
+    EXPECT_EQ(matches[2].matchType, MatchType::PHONETIC);
+
+    // "jo" starts John, Johnny, Jon and Joanna
+    EXPECT_EQ(resolveIds("jo"), std::vector<std::string>({"4", "1", "2"}));
+    EXPECT_EQ(resolveIds("smith"), std::vector<std::string>({"4", "1", "2"}));
+}
+
+TEST_F(ContactNameIndexTest, ResolveShouldMatchEveryWordOfTheName) {
+    EXPECT_EQ(resolveIds("obrien"), std::vector<std::string>({"3"}));
+    EXPECT_EQ(resolveIds("mary ann"), std::vector<std::string>({"3"}));
+    EXPECT_EQ(resolveIds("OBRIEN"), std::vector<std::string>({"3"}));
+    EXPECT_TRUE(resolveIds("mary smith").empty());
+    EXPECT_TRUE(resolveIds("").empty());
+}
+
+TEST_F(ContactNameIndexTest, ResolveShouldReturnAtMostMaxMatches) {
+    EXPECT_EQ(resolveIds("jo", 1), std::vector<std::string>({"4"}));
+    EXPECT_TRUE(resolveIds("jo", 0).empty());
+}
+
+TEST_F(ContactNameIndexTest, UpdateShouldReplaceTheContactsOfTheSourceOnly) {
+    m_index->update("sim", {{"1", {"Bob Stone"}, {"+12065550103"}}});
+    EXPECT_EQ(m_index->getContactCount(), 5u);
+
+    m_index->update("phone", {{"5", {"Alice Stone"}, {}}});
+    EXPECT_EQ(m_index->getContactCount(), 2u);
+    EXPECT_TRUE(resolveIds("john").empty());
+
+    auto matches = m_index->resolve("stone", 10);
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_EQ(matches[0].addressBookSourceId, "phone");
+    EXPECT_EQ(matches[1].addressBookSourceId, "sim");
+}
+
+TEST_F(ContactNameIndexTest, RemoveAndClearShouldRemoveTheContacts) {
+    m_index->update("sim", {{"1", {"Bob Stone"}, {}}});
+    m_index->remove("phone");
+    EXPECT_EQ(m_index->getContactCount(), 1u);
+    EXPECT_TRUE(resolveIds("john").empty());
+    EXPECT_EQ(resolveIds("bob"), std::vector<std::string>({"1"}));
+
+    m_index->clear();
+    EXPECT_EQ(m_index->getContactCount(), 0u);
+    EXPECT_TRUE(resolveIds("bob").empty());
+}
+
+}  // namespace addressBook
+}  // namespace unit
+}  // namespace test
+}  // namespace aace
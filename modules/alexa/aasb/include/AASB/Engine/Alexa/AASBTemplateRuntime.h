@@ -42,6 +42,11 @@ public:
         PlayerActivity audioPlayerState,
         std::chrono::milliseconds offset,
         FocusState focusState) override;
+    bool renderPlayerInfoDelta(
+        const std::string& patch,
+        PlayerActivity audioPlayerState,
+        std::chrono::milliseconds offset,
+        FocusState focusState) override;
     void clearPlayerInfo() override;
 
 private:
@@ -60,10 +60,10 @@ bool AASBDoNotDisturb::initialize(std::shared_ptr<aace::engine::messageBroker::M
                 auto sp = wp.lock();
                 ThrowIfNull(sp, "invalidWeakPtrReference");
 
-                aasb::message::alexa::doNotDisturb::DoNotDisturbChangedMessage::Payload payload =
-                    nlohmann::json::parse(message.payload());
+                auto doNotDisturbChanged =
+                    message.as<aasb::message::alexa::doNotDisturb::DoNotDisturbChangedMessage>();
 
-                sp->doNotDisturbChanged(payload.doNotDisturb);
+                sp->doNotDisturbChanged(doNotDisturbChanged->payload.doNotDisturb);
             } catch (std::exception& ex) {
                 AACE_ERROR(LX(TAG, "DoNotDisturbChangedMessage").d("reason", ex.what()));
             }
@@ -83,10 +83,11 @@ void AASBDoNotDisturb::setDoNotDisturb(const bool doNotDisturb) {
         auto m_messageBroker_lock = m_messageBroker.lock();
         ThrowIfNull(m_messageBroker_lock, "invalidMessageBrokerReference");
 
-        aasb::message::alexa::doNotDisturb::SetDoNotDisturbMessage message;
-        message.payload.doNotDisturb = doNotDisturb;
+        // the message is only serialized if a subscriber reads its text
+        auto message = std::make_shared<aasb::message::alexa::doNotDisturb::SetDoNotDisturbMessage>();
+        message->payload.doNotDisturb = doNotDisturb;
 
-        m_messageBroker_lock->publish(message.toString()).send();
+        m_messageBroker_lock->publish(message).send();
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
     }
@@ -136,6 +136,34 @@ void AASBTemplateRuntime::renderPlayerInfo(
     }
 }
 
+bool AASBTemplateRuntime::renderPlayerInfoDelta(
+    const std::string& patch,
+    PlayerActivity audioPlayerState,
+    std::chrono::milliseconds offset,
+    FocusState focusState) {
+    try {
+        AACE_VERBOSE(LX(TAG));
+
+        auto m_messageBroker_lock = m_messageBroker.lock();
+        ThrowIfNull(m_messageBroker_lock, "invalidMessageBrokerReference");
+
+        aasb::message::alexa::templateRuntime::RenderPlayerInfoMessage message;
+
+        message.payload.payload = patch;
+        message.payload.audioPlayerState =
+            static_cast<aasb::message::alexa::templateRuntime::PlayerActivity>(audioPlayerState);
+        message.payload.offset = offset.count();
+        message.payload.focusState = static_cast<aasb::message::alexa::templateRuntime::FocusState>(focusState);
+        message.payload.delta = true;
+
+        m_messageBroker_lock->publish(message.toString()).send();
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
 void AASBTemplateRuntime::clearPlayerInfo() {
     try {
         AACE_VERBOSE(LX(TAG));
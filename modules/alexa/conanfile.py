@@ -5,6 +5,8 @@ class AutoSdkModulePkg(ConanFile):
     python_requires_extend = "aac-sdk-tools.BaseSdkModule"
     module_name = "alexa"
     module_requires = ["core"]
+    # zlib compresses the request bodies and inflates the responses of the engine REST agents
+    module_system_libs = ["z"]
     # the package name must be defined in sub-class for some conan commands to work
     name = f"aac-module-{module_name}"
 
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_ADAPTIVE_BUFFERING_H
+#define AACE_ENGINE_ALEXA_ADAPTIVE_BUFFERING_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * Tracks the buffer underruns of the audio channels, and derives the duration of audio the platform should buffer
+ * before it starts a playback.
+ *
+ * The underruns are tracked for each channel and network type, which is the network interface the Engine uses.
+ * When a playback ends, the underruns per playback and the duration of the underruns are averaged with the previous
+ * playbacks of the channel on the same network, and the prebuffer target covers the time the playback is expected
+ * to stall: the minimum prebuffer plus the average underruns per playback times their average duration, up to the
+ * maximum prebuffer. The target grows after the playbacks on a poor link stall, and returns to the minimum as the
+ * playbacks on a good link don't.
+ *
+ * The tracker is thread safe.
+ */
+class AdaptiveBuffering {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        /// The prebuffer target of a channel without underruns.
+        std::chrono::milliseconds minPrebuffer{500};
+        /// The largest prebuffer target.
+        std::chrono::milliseconds maxPrebuffer{10000};
+        /// The weight of the last playback in the averages, in the range (0,1].
+        double smoothing = 0.3;
+    };
+
+    /// The network type of the tracker, until it is set.
+    static const std::string DEFAULT_NETWORK_TYPE;
+
+    /**
+     * Creates the tracker.
+     *
+     * @return The tracker, or @c nullptr if the configuration is invalid.
+     */
+    static std::shared_ptr<AdaptiveBuffering> create(const Config& config);
+
+    /// Sets the type of the network the following playbacks use, such as the name of the network interface.
+    void setNetworkType(const std::string& networkType);
+
+    /// Notifies the tracker that the playback of a channel started or resumed.
+    void onPlaybackStarted(const std::string& channel, Clock::time_point now = Clock::now());
+
+    /// Notifies the tracker that the playback of a channel ran out of buffered audio.
+    void onBufferUnderrun(const std::string& channel, Clock::time_point now = Clock::now());
+
+    /// Notifies the tracker that the playback of a channel resumed after an underrun.
+    void onBufferRefilled(const std::string& channel, Clock::time_point now = Clock::now());
+
+    /// Notifies the tracker that the playback of a channel stopped, paused, finished, or failed.
+    void onPlaybackEnded(const std::string& channel, Clock::time_point now = Clock::now());
+
+    /// Returns the duration of audio the platform should buffer before it starts the next playback of a channel.
+    std::chrono::milliseconds getPrebufferTarget(const std::string& channel);
+
+private:
+    AdaptiveBuffering(const Config& config);
+
+    /// The underruns of the running playback of a channel.
+    struct Playback {
+        std::string networkType;
+        int underruns = 0;
+        std::chrono::milliseconds stalled{0};
+        bool underrun = false;
+        Clock::time_point underrunTime;
+    };
+
+    /// The averages of the playbacks of a channel on a network type.
+    struct Statistics {
+        double underrunsPerPlayback = 0;
+        double underrunDuration = 0;
+    };
+
+    /// Adds the running underrun of a playback to its stalled time.
+    static void endUnderrun(Playback& playback, Clock::time_point now);
+
+    const Config m_config;
+
+    std::mutex m_mutex;
+    std::string m_networkType;
+    // the running playbacks by channel
+    std::map<std::string, Playback> m_playbacks;
+    // the statistics by channel and network type
+    std::map<std::pair<std::string, std::string>, Statistics> m_statistics;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_ADAPTIVE_BUFFERING_H
@@ -84,6 +84,7 @@
 #include "AACE/Engine/Alexa/DeviceSetupEngineImpl.h"
 #include "AACE/Engine/Alexa/ExternalMediaAdapterRegistrationInterface.h"
 #include "AACE/Engine/Alexa/LocaleAssetsManager.h"
+#include "AACE/Engine/Alexa/VoiceActivityTransferObserver.h"
 #include "AACE/Engine/Audio/AudioEngineService.h"
 #include "AACE/Engine/Core/EngineService.h"
 #include "AACE/Engine/Location/LocationEngineService.h"
@@ -97,11 +98,14 @@
 #include "AACE/Engine/Vehicle/VehicleEngineService.h"
 #include <AACE/Engine/Alexa/AlexaEngineLocationStateProvider.h>
 
+#include "AdaptiveBuffering.h"
 #include "AlertsEngineImpl.h"
 #include "AlexaClientEngineImpl.h"
 #include "AlexaComponentInterface.h"
 #include "AlexaEndpointInterface.h"
 #include "AlexaEngineClientObserver.h"
+#include "ConnectionWarmup.h"
+#include "VoiceTurnMonitor.h"
 #include "AlexaEngineLogger.h"
 #include "AlexaSpeakerEngineImpl.h"
 #include "AudioPlayerEngineImpl.h"
@@ -116,6 +120,7 @@
 #include "GeolocationServiceInterface.h"
 #include "MediaPlaybackRequestorEngineImpl.h"
 #include "NotificationsEngineImpl.h"
+#include "OpusSpeechEncoderContext.h"
 #include "PlaybackControllerEngineImpl.h"
 #include "SpeechRecognizerEngineImpl.h"
 #include "SpeechSynthesizerEngineImpl.h"
@@ -313,6 +318,9 @@ protected:
     bool setup() override;
     bool start() override;
     bool stop() override;
+    bool suspend() override;
+    bool resume() override;
+    bool prepareShutdown() override;
     bool shutdown() override;
     bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) override;
     bool engineStarted() override;
@@ -366,6 +374,7 @@ private:
     std::shared_ptr<alexaClientSDK::afml::VisualActivityTracker> m_visualActivityTracker;
     std::shared_ptr<alexaClientSDK::avsCommon::avs::attachment::AttachmentManager> m_attachmentManager;
     std::shared_ptr<alexaClientSDK::avsCommon::avs::DialogUXStateAggregator> m_dialogUXStateAggregator;
+    std::shared_ptr<VoiceActivityTransferObserver> m_voiceActivityTransferObserver;
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> m_contextManager;
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::DirectiveSequencerInterface> m_directiveSequencer;
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::endpoints::EndpointBuilderInterface>
@@ -425,22 +434,59 @@ private:
     std::string m_acmsEndpoint;
     std::string m_featureDiscoveryEndpoint;
 
+    /// The time the discovered features are served from the cache before they are requested again
+    std::chrono::seconds m_featureDiscoveryCacheTimeToLive = std::chrono::hours(24);
+
+    /// Whether the changes of the player info of an audio item are rendered as deltas
+    bool m_renderPlayerInfoDeltas = false;
+
     alexaClientSDK::avsCommon::utils::AudioFormat m_audioFormat;
     AuthObserverInterface::State m_authState;
     bool m_capabilitiesConfigured = false;
     /// Whether the AlexaEngineService has already been configured
     bool m_configured = false;
+    /// Whether the AlexaEngineService initialized the Alexa Client SDK, which is shared by the engines of the process
+    bool m_deviceSDKInitialized = false;
     /// Whether the AlexaEngineService has already been started once
     bool m_previouslyStarted = false;
     std::mutex m_connectionMutex;
+    /// Whether the engine is suspended, when the AVS connection is not enabled
+    bool m_suspended = false;
     bool m_encoderEnabled;
     std::string m_encoderName;
+    OpusSpeechEncoderContext::Config m_encoderConfig;
+    SpeechRecognizerEngineImpl::AudioBufferConfig m_audioBufferConfig;
+    aace::engine::audio::VoiceActivityGate::Config m_voiceActivityGateConfig;
+    bool m_speculativeWakewordVerification = false;
+    bool m_stagedLocaleSwitch = false;
     alexaClientSDK::avsCommon::sdkInterfaces::softwareInfo::FirmwareVersion m_firmwareVersion = 1;
     NetworkInfoObserver::NetworkStatus m_networkStatus;
     std::string m_externalMediaPlayerAgent;
+    /// The time the events of the external media adapters are held to be sent in a batch
+    std::chrono::milliseconds m_externalMediaPlayerEventBatchWindow = std::chrono::milliseconds::zero();
+    /// The time the discovered players are held to be reported in a single event
+    std::chrono::milliseconds m_externalMediaPlayerDiscoveryReportWindow = std::chrono::milliseconds::zero();
+    /// Whether the authorizations of an unchanged set of discovered players are restored instead of reporting it
+    bool m_restoreDiscoveredPlayerAuthorizations = false;
+    /// The file the audio channel trace is exported to at shutdown, or empty
+    std::string m_audioChannelTraceFile;
+    /// The service level objective of the response latency of the voice turns, or zero if none
+    std::chrono::milliseconds m_voiceTurnResponseLatencySlo = std::chrono::milliseconds::zero();
+    /// The time the media may take to resume once the dialog of a voice turn ends
+    std::chrono::milliseconds m_voiceTurnMediaResumeTimeout = VoiceTurnMonitor::DEFAULT_MEDIA_RESUME_TIMEOUT;
     /// Holds the connection state to AVS before changing the network interface.
     bool m_previousAVSConnectionState = false;
     bool m_speakerManagerEnabled;
+    /// The time the presses that follow a skip are collected to request only the net skips
+    std::chrono::milliseconds m_buttonCoalescingWindow = PlaybackButtonCoalescer::DEFAULT_WINDOW;
+    /// The time a local volume change waits for the volume to settle before it is reported to AVS
+    std::chrono::milliseconds m_volumeReportDelay = AlexaSpeakerEngineImpl::DEFAULT_VOLUME_REPORT_DELAY;
+    /// The time a local band level change waits for the levels to settle before they are reported to AVS
+    std::chrono::milliseconds m_bandLevelReportDelay = EqualizerControllerEngineImpl::DEFAULT_BAND_LEVEL_REPORT_DELAY;
+    /// The size of the read ahead buffer of each audio output source, 0 to read the sources when the platform reads
+    size_t m_audioOutputReadAheadSize = 0;
+    /// The buffer underruns of the audio channels, which size the prebuffer of the platform, if it is enabled
+    std::shared_ptr<AdaptiveBuffering> m_adaptiveBuffering;
     std::string m_timezone;
 
     /// Holds the provider names in scenarios where application supports multiple authorizations.
@@ -470,6 +516,12 @@ private:
     // client observer
     std::shared_ptr<AlexaEngineClientObserver> m_clientObserver;
 
+    // warms up the endpoints when the network is connected
+    std::shared_ptr<ConnectionWarmup> m_connectionWarmup;
+
+    // measures the latency of the voice turns
+    std::shared_ptr<VoiceTurnMonitor> m_voiceTurnMonitor;
+
     // location service
     std::shared_ptr<GeolocationServiceInterface> m_geolocationProvider;
 
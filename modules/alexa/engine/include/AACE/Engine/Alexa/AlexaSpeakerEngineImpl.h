@@ -16,33 +16,74 @@
 #ifndef AACE_ENGINE_ALEXA_ALEXA_SPEAKER_ENGINE_IMPL_H
 #define AACE_ENGINE_ALEXA_ALEXA_SPEAKER_ENGINE_IMPL_H
 
+#include <chrono>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #include <SpeakerManager/SpeakerManager.h>
 
 #include <AACE/Alexa/AlexaSpeaker.h>
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
 
 namespace aace {
 namespace engine {
 namespace alexa {
 
+/**
+ * Applies the local volume changes of the platform, and reports them to AVS.
+ *
+ * A volume knob calls @c onLocalSetVolume() or @c onLocalAdjustVolume() for each step, and the speaker manager sends a
+ * @c VolumeChanged event to AVS for each call. When the volume report delay is not zero, the local changes are
+ * applied to the speakers at once without notifications, and the settled volume is reported once, with a single
+ * @c VolumeChanged event and @c speakerSettingsChanged() call, when no change was made for the delay.
+ */
 class AlexaSpeakerEngineImpl
         : public aace::alexa::AlexaSpeakerEngineInterface
         , public alexaClientSDK::avsCommon::sdkInterfaces::SpeakerManagerObserverInterface
         , public alexaClientSDK::avsCommon::utils::RequiresShutdown
         , public std::enable_shared_from_this<AlexaSpeakerEngineImpl> {
 private:
-    AlexaSpeakerEngineImpl(std::shared_ptr<aace::alexa::AlexaSpeaker> alexaSpeakerPlatformInterface);
+    AlexaSpeakerEngineImpl(
+        std::shared_ptr<aace::alexa::AlexaSpeaker> alexaSpeakerPlatformInterface,
+        std::chrono::milliseconds volumeReportDelay);
 
     bool initialize(std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::SpeakerManagerInterface> speakerManager);
 
     alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type convert(SpeakerType type);
     SpeakerType convert(alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type type);
 
+    /**
+     * Restarts the wait for the volume of a speaker type to settle. @c m_mutex must be held.
+     *
+     * @param type The speaker type.
+     */
+    void restartReportTimerLocked(alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type type);
+
+    /**
+     * Reports the settled volume of a speaker type to AVS and to the platform.
+     *
+     * @param type The speaker type.
+     */
+    void reportVolume(alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type type);
+
 public:
+    /// The default time a local volume change waits for the volume to settle before it is reported
+    static const std::chrono::milliseconds DEFAULT_VOLUME_REPORT_DELAY;
+
+    /**
+     * Creates the Alexa speaker engine implementation.
+     *
+     * @param alexaSpeakerPlatformInterface The platform interface.
+     * @param speakerManager The speaker manager.
+     * @param volumeReportDelay The time a local volume change waits for the volume to settle before it is reported,
+     *        or zero to report each change.
+     */
     static std::shared_ptr<AlexaSpeakerEngineImpl> create(
         std::shared_ptr<aace::alexa::AlexaSpeaker> alexaSpeakerPlatformInterface,
-        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::SpeakerManagerInterface> speakerManager);
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::SpeakerManagerInterface> speakerManager,
+        std::chrono::milliseconds volumeReportDelay = DEFAULT_VOLUME_REPORT_DELAY);
 
     // aace::alexa::AlexaSpeakerEngineInterface
     void onLocalSetVolume(SpeakerType type, int8_t volume) override;
@@ -61,6 +102,18 @@ protected:
 private:
     std::shared_ptr<aace::alexa::AlexaSpeaker> m_alexaSpeakerPlatformInterface;
     std::weak_ptr<alexaClientSDK::avsCommon::sdkInterfaces::SpeakerManagerInterface> m_speakerManager;
+    const std::chrono::milliseconds m_volumeReportDelay;
+
+    std::mutex m_mutex;
+    /// The pending volume reports of the speaker types
+    std::map<
+        alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type,
+        aace::engine::utils::threading::TimerWheel::TimerId>
+        m_reportTimers;
+    bool m_shutdown = false;
+
+    /// Declared last so the reports are finished before the other members are destroyed
+    aace::engine::utils::threading::Executor m_executor;
 };
 
 }  // namespace alexa
@@ -17,8 +17,10 @@
 #define AACE_ENGINE_ALEXA_AUDIO_CHANNEL_ENGINE_IMPL_H
 
 #include <istream>
+#include <mutex>
 #include <set>
 #include <atomic>
+#include <vector>
 
 #include <AVSCommon/SDKInterfaces/AuthDelegateInterface.h>
 #include <AVSCommon/SDKInterfaces/AuthObserverInterface.h>
@@ -33,8 +35,12 @@
 #include <AACE/Alexa/AlexaEngineInterfaces.h>
 #include <AACE/Engine/Audio/AudioOutputChannelInterface.h>
 #include <AACE/Engine/Audio/IStreamAudioStream.h>
+#include <AACE/Engine/Audio/ReadAheadBuffer.h>
 
+#include "AdaptiveBuffering.h"
+#include "AudioChannelTrace.h"
 #include "DuckingInterface.h"
+#include "PlaybackPositionTracker.h"
 
 namespace aace {
 namespace engine {
@@ -70,12 +76,30 @@ public:
     int64_t getMediaPosition();
     int64_t getMediaDuration();
 
+    /**
+     * Reads the sources into a ring buffer ahead of the platform, on a filler thread, so the reads of the platform
+     * are served from the buffer and don't wait for the attachment or the stream. When it is enabled, the
+     * attachment preroll is not used.
+     *
+     * @param size The size of the read ahead buffer of each source, or 0 to read the sources when the platform reads.
+     */
+    void setReadAhead(size_t size);
+
+    /**
+     * Tracks the buffer underruns of the channel, and sends the prebuffer target derived from them to the platform
+     * before each @c prepare().
+     *
+     * @param adaptiveBuffering The tracker shared by the channels, or @c nullptr to send no buffering hint.
+     */
+    void setAdaptiveBuffering(std::shared_ptr<AdaptiveBuffering> adaptiveBuffering);
+
     //
     // aace::audio::AudioOutputEngineInterface
     //
     void onMediaStateChanged(MediaState state) override;
     void onMediaError(MediaError error, const std::string& description) override;
     void onAudioFocusEvent(FocusAction action) override;
+    void onMediaPositionChanged(int64_t position) override;
 
     //
     // alexaClientSDK::avsCommon::utils::mediaPlayer::MediaPlayerInterface
@@ -146,6 +170,15 @@ protected:
 
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface> getChannelVolumeInterface();
 
+    /**
+     * Reads ahead the start of each attachment source while the platform prepares the channel, so the first reads
+     * of the platform return the buffered audio at once.
+     *
+     * @param size The most bytes read ahead, or 0 to read the attachments only when the platform reads them.
+     * @param timeout The longest time the attachment is read ahead.
+     */
+    void setAttachmentPreroll(size_t size, std::chrono::milliseconds timeout);
+
 private:
     enum class PendingEventState { NONE, PLAYBACK_STARTED, PLAYBACK_PAUSED, PLAYBACK_RESUMED, PLAYBACK_STOPPED };
 
@@ -160,10 +193,19 @@ private:
     void execDuckingStopped();
     void setMediaStateChangeInitiator(MediaStateChangeInitiator initiator);
 
+    /**
+     * Returns the playback position from the positions reported by the platform, or queries the platform
+     * if no recent position was reported.
+     */
+    std::chrono::milliseconds getPlaybackPosition();
+
+    /// Sends the prebuffer target of the channel to the platform, before it prepares the next source.
+    void sendBufferingHint(const std::shared_ptr<aace::engine::audio::AudioOutputChannelInterface>& outputChannel);
+
     //
     // MediaPlayerEngineInterface executor methods
     //
-    void executeMediaStateChanged(SourceId id, MediaState state);
+    void executeMediaStateChanged(SourceId id, MediaState state, AudioChannelTrace::Clock::time_point reported);
     void executeMediaError(SourceId id, MediaError error, const std::string& description);
     void executePlaybackStarted(SourceId id);
     void executePlaybackFinished(SourceId id);
@@ -233,6 +275,10 @@ private:
     alexaClientSDK::avsCommon::utils::mediaPlayer::MediaPlayerInterface::SourceId m_currentId;
     std::string m_url;
     std::chrono::milliseconds m_savedOffset;
+    // the position reported by the platform, so the state changes don't query the position
+    PlaybackPositionTracker m_positionTracker;
+    // the platform round trips and the latency of the state transitions
+    AudioChannelTrace m_trace;
     bool m_muted;
     int8_t m_volume;
 
@@ -248,6 +294,14 @@ private:
     // global counter for media source id
     static SourceId s_nextId;
 
+    // executor reading ahead the attachment sources, so the platform prepare is not delayed
+    alexaClientSDK::avsCommon::utils::threading::Executor m_prerollExecutor;
+    size_t m_prerollSize;
+    std::chrono::milliseconds m_prerollTimeout;
+    size_t m_readAheadSize;
+    // the underruns of the channel, which size the platform prebuffer
+    std::shared_ptr<AdaptiveBuffering> m_adaptiveBuffering;
+
     //variable for storing the mixability of the current stream
     bool m_mayDuck;
 
@@ -307,16 +361,46 @@ public:
 
     // aace::audio::AudioStream
     ssize_t read(char* data, const size_t size) override;
+    ssize_t timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) override;
     bool isClosed() override;
     AudioFormat getAudioFormat() override;
 
     void close();
 
+    /**
+     * Reads the start of the attachment into a buffer the first reads are served from. The read ahead stops at the
+     * first read of the platform.
+     *
+     * @param size The most bytes read ahead.
+     * @param timeout The longest time the attachment is read ahead.
+     * @return The number of bytes read ahead.
+     */
+    size_t preroll(size_t size, std::chrono::milliseconds timeout);
+
+    /**
+     * Starts reading the attachment into a ring buffer the reads are served from, until the attachment is closed.
+     *
+     * @param size The size of the buffer in bytes.
+     * @return @c false if the buffer can't be created.
+     */
+    bool startReadAhead(size_t size);
+
 private:
     std::shared_ptr<alexaClientSDK::avsCommon::avs::attachment::AttachmentReader> m_attachmentReader;
     alexaClientSDK::avsCommon::avs::attachment::AttachmentReader::ReadStatus m_status;
     std::atomic<bool> m_closed;
     AudioFormat m_audioFormat;
+
+    // serializes the read ahead and the reads of the platform
+    std::mutex m_mutex;
+    std::vector<char> m_prerollBuffer;
+    size_t m_prerollOffset;
+    // the attachment was read to its end by the read ahead
+    bool m_attachmentDrained;
+    std::atomic<bool> m_reading;
+
+    // the read ahead buffer, declared last to stop reading the attachment first
+    std::unique_ptr<aace::engine::audio::ReadAheadBuffer> m_readAhead;
 };
 
 }  // namespace alexa
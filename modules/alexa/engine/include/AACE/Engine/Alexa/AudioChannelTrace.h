@@ -0,0 +1,231 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_AUDIO_CHANNEL_TRACE_H
+#define AACE_ENGINE_ALEXA_AUDIO_CHANNEL_TRACE_H
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * Traces the state transitions of an audio channel, and measures the latency of each transition.
+ *
+ * The channel records the platform calls with their round trip duration, the media states and focus events the
+ * platform reports, and the reports handled by the channel. The events of all the channels form one trace stream,
+ * delivered to the listeners and kept for export in the Chrome trace event format while the trace is recording.
+ * The latency of the transitions is emitted as metrics whether the trace is recording or not:
+ * - @c PrepareToPlaying from the platform @c prepare() call to the report of the @c PLAYING state.
+ * - @c PauseToResumed from the platform @c pause() call to the report of the @c PLAYING state after a resume.
+ * - @c StopToStopped from the platform @c stop() call, made when the channel loses the focus, to the report of the
+ *   @c STOPPED state.
+ *
+ * The calls and transitions of all the channels are also delivered to the transition listeners, whether the trace is
+ * recording or not.
+ *
+ * The calls, reports and transitions of a channel are recorded by its executor, except the reports, which are
+ * recorded by the platform thread making them.
+ */
+class AudioChannelTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// The platform calls of the channel
+    enum class Call { PREPARE, PLAY, PAUSE, RESUME, STOP, START_DUCKING, STOP_DUCKING };
+
+    /// The transitions of the channel whose latency is measured
+    enum class Transition { STARTED, RESUMED, STOPPED };
+
+    /// An event of the trace stream
+    struct Event {
+        /// The name of the channel
+        std::string channel;
+        /// The name of the event, such as the platform call or the report
+        std::string name;
+        /// The details of the event, such as the reported state
+        std::string detail;
+        /// The time of the event
+        Clock::time_point start;
+        /// The duration of the event, such as the platform round trip, or zero for an instant
+        Clock::duration duration;
+    };
+
+    /// Receives the events of the trace stream
+    class Listener {
+    public:
+        virtual ~Listener() = default;
+
+        /**
+         * Called for each event recorded while the trace is recording, by the thread recording it.
+         *
+         * @param event The event.
+         */
+        virtual void onTraceEvent(const Event& event) = 0;
+    };
+
+    /// Receives the calls and transitions of the channels, whether the trace is recording or not
+    class TransitionListener {
+    public:
+        virtual ~TransitionListener() = default;
+
+        /**
+         * Called for each platform call of a channel, by the executor of the channel.
+         *
+         * @param channel The name of the channel.
+         * @param call The call.
+         * @param time The time the call was made.
+         */
+        virtual void onChannelCall(const std::string& channel, Call call, Clock::time_point time) = 0;
+
+        /**
+         * Called for each completed transition of a channel, by the executor of the channel.
+         *
+         * @param channel The name of the channel.
+         * @param transition The transition.
+         * @param reported The time the platform reported the new state.
+         */
+        virtual void onChannelTransition(
+            const std::string& channel,
+            Transition transition,
+            Clock::time_point reported) = 0;
+    };
+
+    /// Times a platform call from its construction to its destruction
+    class CallScope {
+    public:
+        CallScope(AudioChannelTrace& trace, Call call);
+        ~CallScope();
+
+        CallScope(const CallScope&) = delete;
+        CallScope& operator=(const CallScope&) = delete;
+
+    private:
+        AudioChannelTrace& m_trace;
+        const Call m_call;
+        const Clock::time_point m_start;
+    };
+
+    /**
+     * @param channel The name of the channel.
+     */
+    explicit AudioChannelTrace(const std::string& channel);
+
+    /**
+     * Records a platform call.
+     *
+     * @param call The call.
+     * @param start The time the call was made.
+     * @param end The time the call returned.
+     */
+    void recordCall(Call call, Clock::time_point start, Clock::time_point end);
+
+    /**
+     * Records a report of the platform.
+     *
+     * @param name The name of the report, such as @c onMediaStateChanged.
+     * @param detail The details of the report, such as the reported state.
+     * @param time The time of the report.
+     */
+    void recordReport(const std::string& name, const std::string& detail, Clock::time_point time);
+
+    /**
+     * Records a report of the platform handled by the channel, and the time the report waited to be handled.
+     *
+     * @param name The name of the report.
+     * @param detail The details of the report.
+     * @param reported The time of the report.
+     */
+    void recordHandled(const std::string& name, const std::string& detail, Clock::time_point reported);
+
+    /**
+     * Records a completed transition, and emits its latency.
+     *
+     * @param transition The transition.
+     * @param reported The time the platform reported the new state.
+     */
+    void recordTransition(Transition transition, Clock::time_point reported);
+
+    /// Returns the name of the channel.
+    const std::string& getChannel() const;
+
+    /// Returns the last latency measured for a transition, or a negative duration if none was measured.
+    std::chrono::milliseconds getLastLatency(Transition transition) const;
+
+    /// Clears the recorded events, and starts recording.
+    static void start();
+
+    /// Stops recording, and keeps the recorded events until the next @c start().
+    static void stop();
+
+    /// Returns @c true while the trace is recording.
+    static bool isRecording();
+
+    /// Adds a listener of the trace stream.
+    static void addListener(std::shared_ptr<Listener> listener);
+
+    /// Removes a listener of the trace stream.
+    static void removeListener(std::shared_ptr<Listener> listener);
+
+    /// Adds a listener of the calls and transitions of the channels.
+    static void addTransitionListener(std::shared_ptr<TransitionListener> listener);
+
+    /// Removes a listener of the calls and transitions of the channels.
+    static void removeTransitionListener(std::shared_ptr<TransitionListener> listener);
+
+    /// Returns the recorded events, the oldest first.
+    static std::vector<Event> getEvents();
+
+    /// Returns the recorded events as a Chrome trace event JSON document, with a track for each channel.
+    static std::string toJson();
+
+    /**
+     * Writes the recorded events to a file, as a Chrome trace event JSON document.
+     *
+     * @param path The path of the file.
+     * @return @c false if the file could not be written.
+     */
+    static bool exportTrace(const std::string& path);
+
+private:
+    /// Adds an event to the trace stream, if the trace is recording.
+    void record(const std::string& name, const std::string& detail, Clock::time_point start, Clock::duration duration);
+
+    /// Returns the transition listeners, and drops the expired ones.
+    static std::vector<std::shared_ptr<TransitionListener>> getTransitionListeners();
+
+    /// Emits the latency of a transition, and records it in the trace stream.
+    void emitLatency(const std::string& key, Transition transition, Clock::time_point from, Clock::time_point to);
+
+    const std::string m_channel;
+
+    /// The start of the last calls the transitions are measured from, or the epoch if the call was not made
+    Clock::time_point m_prepareTime;
+    Clock::time_point m_pauseTime;
+    Clock::time_point m_stopTime;
+
+    /// The last latency measured for each transition
+    std::chrono::milliseconds m_lastLatency[3];
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_AUDIO_CHANNEL_TRACE_H
@@ -16,11 +16,15 @@
 #ifndef AACE_ENGINE_ALEXA_AUTHORIZATION_MANAGER_H
 #define AACE_ENGINE_ALEXA_AUTHORIZATION_MANAGER_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <unordered_map>
 
 #include <AVSCommon/SDKInterfaces/AuthDelegateInterface.h>
 #include <AVSCommon/SDKInterfaces/AuthObserverInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
 #include <RegistrationManager/RegistrationManagerInterface.h>
 
 #include "AuthorizationManagerInterface.h"
@@ -38,15 +42,36 @@ class AuthorizationManager
         , public alexaClientSDK::avsCommon::utils::RequiresShutdown
         , public std::enable_shared_from_this<AuthorizationManager> {
 public:
+    /**
+     * The ages of the auth token cached. The cache spares the authorization adapter, which may ask the platform for
+     * the token, one call for each request sent to AVS.
+     */
+    struct TokenCacheConfiguration {
+        /// The age after which the token is fetched again in the background, while the cached token is still used
+        std::chrono::milliseconds refreshAfter = std::chrono::seconds(30);
+        /// The age after which the cached token is not used anymore, and @c getAuthToken() fetches the token
+        std::chrono::milliseconds maxAge = std::chrono::minutes(5);
+    };
+
     /**
      * Creates the reference of @c AuthorizationManager
      * 
      * @param storage Used for storing and retrieving the authorization adapter state
-     * @param customerDataManager Component to register this component as a customer data container
      * @return On successful returns the reference to the @c AuthorizationManager otherwise returns the nullptr
      */
     static std::shared_ptr<AuthorizationManager> create(std::shared_ptr<AuthorizationManagerStorageInterface> storage);
 
+    /**
+     * Creates the reference of @c AuthorizationManager
+     * 
+     * @param storage Used for storing and retrieving the authorization adapter state
+     * @param tokenCacheConfiguration The ages of the auth token cached
+     * @return On successful returns the reference to the @c AuthorizationManager otherwise returns the nullptr
+     */
+    static std::shared_ptr<AuthorizationManager> create(
+        std::shared_ptr<AuthorizationManagerStorageInterface> storage,
+        const TokenCacheConfiguration& tokenCacheConfiguration);
+
     /**
      * Get the reference to class that implements @c AuthDelegateInterface
      * 
@@ -100,9 +125,11 @@ private:
      * Constructor
      * 
      * @param storage Stores and retrieves the active authorization from persistent storage.
-     * @param customerDataManager Component to register this component as a customer data container
+     * @param tokenCacheConfiguration The ages of the auth token cached
      */
-    AuthorizationManager(std::shared_ptr<AuthorizationManagerStorageInterface> storage);
+    AuthorizationManager(
+        std::shared_ptr<AuthorizationManagerStorageInterface> storage,
+        const TokenCacheConfiguration& tokenCacheConfiguration);
 
     /**
      * Initializes the @c AuthorizationManager object
@@ -147,6 +174,20 @@ private:
      */
     bool clearAdapterStateLocked();
 
+    /**
+     * Fetches the auth token from the active adapter and caches it. The concurrent calls are coalesced into one
+     * fetch, the calls waiting for it get the token it fetched.
+     *
+     * @note This function must be called without holding @c m_activeAdapterMutex.
+     */
+    std::string fetchAuthToken();
+
+    /// Fetches the auth token on @c m_tokenRefreshExecutor, unless a background fetch is already pending.
+    void requestBackgroundTokenRefresh();
+
+    /// Drops the cached auth token, and the token of any fetch in progress.
+    void invalidateAuthToken();
+
 private:
     /// Alias for @c AdapterState
     using AdapterState = AuthorizationManagerStorage::AdapterState;
@@ -187,6 +228,33 @@ private:
 
     /// To serialize the access to @c m_metricsEmissionListener
     std::mutex m_metricEmissionListenerMutex;
+
+    /// An auth token fetched from the active adapter
+    struct CachedToken {
+        std::string token;
+        std::chrono::steady_clock::time_point fetchTime;
+    };
+
+    /// The ages of the auth token cached
+    const TokenCacheConfiguration m_tokenCacheConfiguration;
+
+    /// The cached auth token, null if none. Read with @c std::atomic_load, so @c getAuthToken() doesn't lock.
+    std::shared_ptr<const CachedToken> m_cachedToken;
+
+    /// Incremented each time the token is invalidated, so a fetch started before doesn't cache its token
+    uint64_t m_tokenGeneration;
+
+    /// To serialize the updates of @c m_cachedToken and @c m_tokenGeneration
+    std::mutex m_tokenCacheMutex;
+
+    /// To coalesce the concurrent fetches of the auth token
+    std::mutex m_tokenFetchMutex;
+
+    /// Whether a background fetch of the auth token is pending
+    std::atomic<bool> m_tokenRefreshPending;
+
+    /// Fetches the auth token ahead of the expiry of the cached token
+    alexaClientSDK::avsCommon::utils::threading::Executor m_tokenRefreshExecutor;
 };
 
 }  // namespace alexa
@@ -16,10 +16,16 @@
 #ifndef AACE_ENGINE_ALEXA_AUTHORIZEDSENDER_H_
 #define AACE_ENGINE_ALEXA_AUTHORIZEDSENDER_H_
 
+#include <chrono>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+#include <AVSCommon/AVS/MessageRequest.h>
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 
@@ -38,19 +44,50 @@ namespace alexa {
  * the sender has an authorized @c playerId. This also means that this class will block
  * events that do not have a @c playerId field in the payload. By default, no players
  * are authorized.
+ *
+ * A @c PlayerMessageRequest is tagged with its @c playerId when the event is built, so its
+ * JSON is not parsed. The messages can also be sent in batches: each message is held until
+ * the end of a batch window started by the first message held, and all the messages held
+ * are then sent in order, so a burst of player events is sent with a single task.
  */
-class AuthorizedSender : public alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface {
+class AuthorizedSender
+        : public alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface
+        , public std::enable_shared_from_this<AuthorizedSender> {
 public:
+    /**
+     * A @c MessageRequest of an event built for a player, tagged with the @c playerId of the player.
+     */
+    class PlayerMessageRequest : public alexaClientSDK::avsCommon::avs::MessageRequest {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param playerId The @c playerId in the payload of the event.
+         * @param jsonContent The JSON of the event.
+         */
+        PlayerMessageRequest(const std::string& playerId, const std::string& jsonContent);
+
+        /// @return The @c playerId in the payload of the event.
+        const std::string& getPlayerId() const;
+
+    private:
+        /// The @c playerId in the payload of the event.
+        const std::string m_playerId;
+    };
+
     ~AuthorizedSender() override;
 
     /**
      * Creates an instance of the @c AuthorizedSender.
      *
      * @param messageSender Sends messages to the cloud.
+     * @param batchWindow The time the messages are held to be sent in a batch, or zero to send each message
+     * as soon as it is authorized.
      * @return A valid instance if creation was successful, else a nullptr.
      */
     static std::shared_ptr<AuthorizedSender> create(
-        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender);
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
+        std::chrono::milliseconds batchWindow = std::chrono::milliseconds::zero());
 
     /// @name MessageSenderInterface Functions
     /// @{
@@ -69,9 +106,32 @@ private:
      * Constructor.
      *
      * @param messageSender Sends messages to the cloud.
+     * @param batchWindow The time the messages are held to be sent in a batch.
      * @return A constructed @c AuthorizedSender object.
      */
-    AuthorizedSender(std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender);
+    AuthorizedSender(
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
+        std::chrono::milliseconds batchWindow);
+
+    /// A message and the @c playerId of its event.
+    using PendingMessage = std::pair<std::string, std::shared_ptr<alexaClientSDK::avsCommon::avs::MessageRequest>>;
+
+    /**
+     * Gets the @c playerId in the payload of the event of a message that is not tagged with its @c playerId.
+     *
+     * @param request The message.
+     * @param [out] playerId The @c playerId of the event.
+     * @return @c true if the event has a @c playerId, else @c false.
+     */
+    static bool parsePlayerId(
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::MessageRequest> request,
+        std::string& playerId);
+
+    /// Sends a message if its player is authorized. @c m_updatePlayersMutex must be held.
+    void sendAuthorizedMessageLocked(const PendingMessage& message);
+
+    /// Sends the messages held for the current batch.
+    void flushPendingMessages();
 
     /// Mutex to protect @c m_playersIds.
     std::mutex m_updatePlayersMutex;
@@ -82,6 +142,18 @@ private:
     /// Holds the authorized playerIds.
     std::unordered_set<std::string> m_authorizedPlayerIds;
 
+    /// The time the messages are held to be sent in a batch.
+    const std::chrono::milliseconds m_batchWindow;
+
+    /// Mutex to protect @c m_pendingMessages and @c m_batchTimer.
+    std::mutex m_pendingMessagesMutex;
+
+    /// The messages held for the current batch, in the order they were sent.
+    std::vector<PendingMessage> m_pendingMessages;
+
+    /// The timer of the end of the current batch window.
+    aace::engine::utils::threading::TimerWheel::TimerId m_batchTimer;
+
     /// Executor used to serialize calls to sendMessage
     alexaClientSDK::avsCommon::utils::threading::Executor m_executor;
 };
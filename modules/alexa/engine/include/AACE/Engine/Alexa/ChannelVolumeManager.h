@@ -20,6 +20,7 @@
 #include <mutex>
 
 #include "DuckingInterface.h"
+#include "DuckingMixer.h"
 
 namespace aace {
 namespace engine {
@@ -37,6 +38,9 @@ public:
      * @param speaker The @c SpeakerInterface associated with this instance.
      * @param type The @c ChannelVolumeInterface type associated with this instance.
      * @param volumeCurve The volume curve mapping to be used for channel attenuation.
+     * @param duckingInterface The interface ducking the channel.
+     * @param duckingMixer The mixer batching the ducking changes of the channels, or @c nullptr to duck the channel
+     * directly, waiting for the ducking to be applied.
      * @return ChannelVolumeManager
      */
     static std::shared_ptr<ChannelVolumeManager> create(
@@ -44,7 +48,8 @@ public:
         alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type type =
             alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type::AVS_SPEAKER_VOLUME,
         std::function<int8_t(int8_t)> volumeCurve = nullptr,
-        std::shared_ptr<DuckingInterface> duckingInterface = nullptr);
+        std::shared_ptr<DuckingInterface> duckingInterface = nullptr,
+        std::shared_ptr<DuckingMixer> duckingMixer = nullptr);
 
     /// ChannelVolumeInterface Functions.
     /// @{
@@ -78,7 +83,8 @@ private:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::SpeakerInterface> speaker,
         alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type type,
         VolumeCurveFunction volumeCurve,
-        std::shared_ptr<DuckingInterface> duckingInterface);
+        std::shared_ptr<DuckingInterface> duckingInterface,
+        std::shared_ptr<DuckingMixer> duckingMixer);
 
     /**
      * Default Volume Curve Implementation that determines the desired attenuated
@@ -119,6 +125,9 @@ private:
     /// The underlying @c DuckingInterface
     std::shared_ptr<DuckingInterface> m_DuckingInterface;
 
+    /// The mixer the ducking changes are batched by, or @c nullptr
+    std::shared_ptr<DuckingMixer> m_duckingMixer;
+
     /// Speaker Type
     const alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type m_type;
 };
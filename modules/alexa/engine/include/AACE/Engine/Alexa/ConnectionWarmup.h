@@ -0,0 +1,125 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_CONNECTION_WARMUP_H
+#define AACE_ENGINE_ALEXA_CONNECTION_WARMUP_H
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <AVSCommon/SDKInterfaces/ConnectionStatusObserverInterface.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * Warms up the endpoints of the engine when the network comes back, and measures the time it takes for the AVS
+ * connection to be ready.
+ *
+ * The token refresh and the AVS connection each resolve their host when they start, and the connection is only
+ * enabled once the token is refreshed. The warmup resolves the hosts of the endpoints in the background as soon
+ * as the network is connected, in parallel with the token refresh and the connection, so the system resolver
+ * already has their addresses when they are needed.
+ */
+class ConnectionWarmup : public alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface {
+public:
+    /// Resolves a host, returns whether it was resolved.
+    using Resolver = std::function<bool(const std::string& host)>;
+
+    /**
+     * Creates a @c ConnectionWarmup.
+     *
+     * @param resolver The function resolving the hosts of the endpoints.
+     * @return The @c ConnectionWarmup, or @c nullptr if @c resolver is empty.
+     */
+    static std::shared_ptr<ConnectionWarmup> create(Resolver resolver = resolveHost);
+
+    ~ConnectionWarmup();
+
+    /**
+     * Starts a warmup when the network is connected. The hosts of @c urls are resolved in the background, and the
+     * time to ready is emitted once the AVS connection is connected.
+     *
+     * @param urls The URLs of the endpoints to warm up.
+     */
+    void onNetworkConnected(const std::vector<std::string>& urls);
+
+    /// Cancels the warmup in progress, if any, when the network is disconnected.
+    void onNetworkDisconnected();
+
+    /// Waits for the resolutions in progress and stops the warmup.
+    void shutdown();
+
+    /**
+     * Returns the host of a URL.
+     *
+     * @param url The URL, such as @c https://alexa.na.gateway.devices.a2z.com.
+     * @return The host of the URL, or an empty string if the URL has no host.
+     */
+    static std::string getHost(const std::string& url);
+
+    /**
+     * Resolves a host with the system resolver.
+     *
+     * @param host The host to resolve.
+     * @return @c true if the host has an address.
+     */
+    static bool resolveHost(const std::string& host);
+
+    // ConnectionStatusObserverInterface
+    void onConnectionStatusChanged(
+        const alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status status,
+        const alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::ChangedReason reason)
+        override;
+
+private:
+    ConnectionWarmup(Resolver resolver);
+
+    /// Resolves the hosts of a warmup.
+    void executeResolve(const std::vector<std::string>& hosts, uint64_t warmupId);
+
+    /// The function resolving the hosts
+    Resolver m_resolver;
+
+    /// Serializes the access to the state of the warmup
+    std::mutex m_mutex;
+
+    /// Whether a warmup is waiting for the AVS connection to be connected
+    bool m_warmingUp = false;
+
+    /// The identifier of the current warmup, so the resolutions of a cancelled warmup are skipped
+    uint64_t m_warmupId = 0;
+
+    /// The time the network of the current warmup was connected
+    std::chrono::steady_clock::time_point m_networkConnectedTime;
+
+    /// Whether the warmup is shut down
+    bool m_isShutdown = false;
+
+    /// Resolves the hosts off the thread of the network observer
+    alexaClientSDK::avsCommon::utils::threading::Executor m_executor;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_CONNECTION_WARMUP_H
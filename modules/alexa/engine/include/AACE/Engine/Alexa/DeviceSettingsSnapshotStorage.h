@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_DEVICE_SETTINGS_SNAPSHOT_STORAGE_H
+#define AACE_ENGINE_ALEXA_DEVICE_SETTINGS_SNAPSHOT_STORAGE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
+#include <Settings/Storage/DeviceSettingStorageInterface.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * A device setting storage which reads all the settings of the database in a single query when it is opened, and
+ * serves the reads of the settings from this snapshot.
+ *
+ * Each setting configured at startup restores its value from the storage, so the locale, time zone, wake word
+ * confirmation and other settings are initialized from the snapshot instead of querying the database one at a time.
+ * The changes are written to the database first, and to the snapshot when they succeed. If the snapshot can't be
+ * read, the reads fall back to the database.
+ */
+class DeviceSettingsSnapshotStorage : public alexaClientSDK::settings::storage::DeviceSettingStorageInterface {
+public:
+    /**
+     * Creates the storage of the database configured in @c deviceSettings.databaseFilePath.
+     *
+     * @returns The storage, or @c nullptr if the database isn't configured.
+     */
+    static std::shared_ptr<DeviceSettingsSnapshotStorage> create(
+        const alexaClientSDK::avsCommon::utils::configuration::ConfigurationNode& configurationRoot);
+
+    /**
+     * Creates a storage wrapping a device setting storage.
+     *
+     * @param storage The storage the changes are written to.
+     * @param databaseFilePath The path of the database of @c storage, which the snapshot is read from.
+     * @returns The storage, or @c nullptr if an argument is invalid.
+     */
+    static std::shared_ptr<DeviceSettingsSnapshotStorage> create(
+        std::shared_ptr<alexaClientSDK::settings::storage::DeviceSettingStorageInterface> storage,
+        const std::string& databaseFilePath);
+
+    /// Returns the number of settings in the snapshot, or zero if it wasn't read.
+    size_t getSnapshotSize();
+
+    /// @name DeviceSettingStorageInterface
+    /// @{
+    bool open() override;
+    void close() override;
+    bool storeSetting(
+        const std::string& key,
+        const std::string& value,
+        alexaClientSDK::settings::SettingStatus status) override;
+    bool storeSettings(
+        const std::vector<std::tuple<std::string, std::string, alexaClientSDK::settings::SettingStatus>>& data)
+        override;
+    SettingStatusAndValue loadSetting(const std::string& key) override;
+    bool deleteSetting(const std::string& key) override;
+    bool updateSettingStatus(const std::string& key, alexaClientSDK::settings::SettingStatus status) override;
+    /// @}
+
+private:
+    DeviceSettingsSnapshotStorage(
+        std::shared_ptr<alexaClientSDK::settings::storage::DeviceSettingStorageInterface> storage,
+        const std::string& databaseFilePath);
+
+    /// Reads all the settings of the database into the snapshot, in a single query.
+    bool readSnapshotLocked();
+
+    std::shared_ptr<alexaClientSDK::settings::storage::DeviceSettingStorageInterface> m_storage;
+    std::string m_databaseFilePath;
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, SettingStatusAndValue> m_snapshot;
+    bool m_snapshotRead = false;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_DEVICE_SETTINGS_SNAPSHOT_STORAGE_H
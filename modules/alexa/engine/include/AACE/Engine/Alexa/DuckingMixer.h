@@ -0,0 +1,123 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_DUCKING_MIXER_H
+#define AACE_ENGINE_ALEXA_DUCKING_MIXER_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+
+#include "DuckingInterface.h"
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * Applies the ducking changes of all the audio channels in one batch for each focus transition.
+ *
+ * The focus manager ducks and restores the channels one at a time, so a quick sequence of focus changes, such as an
+ * alert followed by a speech prompt over media, calls the platform media players for each change, and the media
+ * pumps as it is ducked, restored, and ducked again. The mixer keeps the target state of each channel instead, and
+ * applies the channels whose target differs from their applied state in one task: a new ducking is applied at once,
+ * with the other pending changes, while a restore waits for the release time, and is dropped if the channel is ducked
+ * again meanwhile.
+ */
+class DuckingMixer : public std::enable_shared_from_this<DuckingMixer> {
+public:
+    /// The default time a restored channel waits for the focus to settle before its volume is restored
+    static const std::chrono::milliseconds DEFAULT_RELEASE_TIME;
+
+    /**
+     * Creates a ducking mixer.
+     *
+     * @param releaseTime The time a restore waits for the focus to settle.
+     */
+    static std::shared_ptr<DuckingMixer> create(std::chrono::milliseconds releaseTime = DEFAULT_RELEASE_TIME);
+
+    /// Returns the mixer shared by the audio channels of the engine.
+    static std::shared_ptr<DuckingMixer> getDefault();
+
+    ~DuckingMixer();
+
+    /**
+     * Sets the target ducking state of a channel. The channel is called from the mixer thread.
+     *
+     * @param channel The channel.
+     * @param ducked @c true to duck the channel, @c false to restore its volume.
+     */
+    void setDucked(std::shared_ptr<DuckingInterface> channel, bool ducked);
+
+    /// Applies the pending changes, including the restores waiting for the release time, and waits for them.
+    void flush();
+
+    /// Returns the number of channels whose target state is not applied yet.
+    size_t getPendingCount();
+
+    /// Drops the pending changes, and refuses new ones.
+    void shutdown();
+
+private:
+    /// The state of a channel
+    struct Channel {
+        std::weak_ptr<DuckingInterface> channel;
+        const DuckingInterface* key;
+        bool target;
+        bool applied;
+    };
+
+    DuckingMixer(std::chrono::milliseconds releaseTime);
+
+    /// Queues the batch of the new duckings, unless it is already queued. @c m_mutex must be held.
+    void scheduleApplyLocked();
+
+    /// Restarts the wait for the focus to settle before the restores are applied. @c m_mutex must be held.
+    void restartReleaseTimerLocked();
+
+    /// Cancels the wait for the focus to settle. @c m_mutex must be held.
+    void cancelReleaseTimerLocked();
+
+    /**
+     * Applies the changes of all the channels in one batch.
+     *
+     * @param release Whether the restores are applied, or only the new duckings.
+     */
+    void apply(bool release);
+
+    const std::chrono::milliseconds m_releaseTime;
+
+    std::mutex m_mutex;
+    std::vector<Channel> m_channels;
+    bool m_applyQueued;
+    aace::engine::utils::threading::TimerWheel::TimerId m_releaseTimer;
+    bool m_shutdown;
+
+    /// The number of changes requested since the last batch, to log the changes coalesced by the batch
+    size_t m_requestCount;
+
+    /// Declared last so the batch task is finished before the other members are destroyed
+    aace::engine::utils::threading::Executor m_executor;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_DUCKING_MIXER_H
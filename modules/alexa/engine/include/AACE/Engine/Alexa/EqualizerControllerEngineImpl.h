@@ -16,7 +16,10 @@
 #ifndef AACE_ENGINE_ALEXA_EQUALIZER_CONTROLLER_ENGINE_IMPL_H
 #define AACE_ENGINE_ALEXA_EQUALIZER_CONTROLLER_ENGINE_IMPL_H
 
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include <acsdkEqualizer/EqualizerCapabilityAgent.h>
 #include <acsdkEqualizerImplementations/EqualizerController.h>
@@ -34,12 +37,19 @@
 #include "AACE/Alexa/AlexaEngineInterfaces.h"
 #include "AACE/Alexa/EqualizerController.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/Threading/Executor.h"
+#include "AACE/Engine/Utils/Threading/TimerWheel.h"
 
 namespace aace {
 namespace engine {
 namespace alexa {
 
-/// EqualizerController Engine implementation
+/**
+ * EqualizerController Engine implementation
+ *
+ * The local band level changes are applied to the platform at once, and the settled band levels are saved and
+ * reported to AVS with a single @c EqualizerChanged event, when no local change was made for the report delay.
+ */
 class EqualizerControllerEngineImpl
         : public aace::alexa::EqualizerControllerEngineInterface
         , public alexaClientSDK::acsdkEqualizerInterfaces::EqualizerInterface
@@ -47,6 +57,9 @@ class EqualizerControllerEngineImpl
         , public alexaClientSDK::avsCommon::utils::RequiresShutdown
         , public std::enable_shared_from_this<EqualizerControllerEngineImpl> {
 public:
+    /// The default time a local band level change waits for the levels to settle before they are reported
+    static const std::chrono::milliseconds DEFAULT_BAND_LEVEL_REPORT_DELAY;
+
     /**
      * Factory method to create an EqualizerControllerEngineImpl instance
      *
@@ -57,6 +70,8 @@ public:
      * @param exceptionEncounteredSender Interface to report exceptions to AVS
      * @param contextManager Interface to provide equalizer state to AVS
      * @param messageSender Interface to send events to AVS
+     * @param bandLevelReportDelay The time a local band level change waits for the levels to settle before they
+     *        are reported, or zero to report each change
      *
      * @return A new instance of @c EqualizerControllerEngineImpl on success, @c nullptr otherwise
      */
@@ -69,7 +84,8 @@ public:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface>
             exceptionEncounteredSender,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender);
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
+        std::chrono::milliseconds bandLevelReportDelay = DEFAULT_BAND_LEVEL_REPORT_DELAY);
 
     // EqualizerInterface functions
     virtual void setEqualizerBandLevels(
@@ -98,8 +114,11 @@ private:
      * EqualizerControllerEngineImpl constructor
      *
      * @param equalizerPlatformInterface The associated @c EqualizerController platform interface instance
+     * @param bandLevelReportDelay The time a local band level change waits for the levels to settle
      */
-    EqualizerControllerEngineImpl(std::shared_ptr<aace::alexa::EqualizerController> equalizerPlatformInterface);
+    EqualizerControllerEngineImpl(
+        std::shared_ptr<aace::alexa::EqualizerController> equalizerPlatformInterface,
+        std::chrono::milliseconds bandLevelReportDelay);
 
     /**
      * Initialize the @c EqualizerControllerEngineImpl instance
@@ -123,6 +142,28 @@ private:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender);
 
+    /**
+     * Applies local band level changes to the platform, and restarts the wait for the levels to settle.
+     * @c m_mutex must be held.
+     *
+     * @param bandLevels The changed band levels, in the configured min/max range
+     */
+    void applyLocalBandLevelsLocked(const alexaClientSDK::acsdkEqualizerInterfaces::EqualizerBandLevelMap& bandLevels);
+
+    /// Restarts the wait for the band levels to settle. @c m_mutex must be held.
+    void restartReportTimerLocked();
+
+    /// Saves and reports the settled local band levels through the @c EqualizerController.
+    void reportBandLevels();
+
+    /**
+     * Returns the level a band is applied at on the platform, or its default level. @c m_mutex must be held.
+     *
+     * @param band The band
+     * @return The level
+     */
+    int getBandLevelLocked(alexaClientSDK::acsdkEqualizerInterfaces::EqualizerBand band);
+
     /**
      * Truncate the band level setting for @a bandLevel to the configured min/max range
      *
@@ -248,6 +289,28 @@ private:
 
     /// The component for providing equalizer capabilities and configuration settings
     std::shared_ptr<alexaClientSDK::acsdkEqualizerInterfaces::EqualizerConfigurationInterface> m_configuration;
+
+    const std::chrono::milliseconds m_bandLevelReportDelay;
+
+    /// Protects the band levels, and serializes the calls to the platform
+    std::mutex m_mutex;
+    /// The band levels applied on the platform
+    alexaClientSDK::acsdkEqualizerInterfaces::EqualizerBandLevelMap m_bandLevels;
+    /// The band levels of the @c EqualizerController state, which tell the bands a directive changes apart
+    alexaClientSDK::acsdkEqualizerInterfaces::EqualizerBandLevelMap m_controllerBandLevels;
+    /// The local band level changes that are not reported yet
+    alexaClientSDK::acsdkEqualizerInterfaces::EqualizerBandLevelMap m_pendingBandLevels;
+    aace::engine::utils::threading::TimerWheel::TimerId m_reportTimer =
+        aace::engine::utils::threading::TimerWheel::INVALID_TIMER;
+    /// The thread reporting the settled band levels, which the @c EqualizerController applies back on
+    std::thread::id m_reportingThread;
+    bool m_shutdown = false;
+
+    /// Serializes the reports
+    std::mutex m_reportMutex;
+
+    /// Declared last so the reports are finished before the other members are destroyed
+    aace::engine::utils::threading::Executor m_executor;
 };
 
 }  // namespace alexa
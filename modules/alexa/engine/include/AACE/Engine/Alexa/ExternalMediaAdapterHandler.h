@@ -17,6 +17,7 @@
 #define AACE_ENGINE_ALEXA_EXTERNAL_MEDIA_ADAPTER_HANDLER_H
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -71,6 +72,8 @@ protected:
         const std::vector<aace::alexa::ExternalMediaAdapter::DiscoveredPlayerInfo>& discoveredPlayers);
     bool removeDiscoveredPlayer(const std::string& localPlayerId);
     void reportPlaybackSessionId(const std::string& localPlayerId, const std::string& sessionId);
+    void reportStateChanged();
+    void stopAdapterStateQueries();
 
     // ExternalMediaAdapterHandler interface
     virtual bool handleAuthorization(
@@ -154,6 +157,28 @@ private:
     std::unordered_map<std::string, PlayerInfo> m_playerInfoMap;
     std::unordered_map<std::string, std::string> m_alexaToLocalPlayerIdMap;
 
+    /// Queries the state of a player on its own executor, and returns the state, or @c nullptr on failure.
+    std::shared_future<std::shared_ptr<AdapterState>> queryAdapterState(
+        const std::string& localPlayerId,
+        const AdapterState& defaultState);
+    std::shared_ptr<AdapterState> executeQueryAdapterState(
+        const std::string& localPlayerId,
+        const AdapterState& defaultState);
+
+    /**
+     * The executors querying the player states, by local player id, so the players are queried concurrently
+     * and a player is not queried again while its last query is pending.
+     */
+    std::unordered_map<std::string, std::shared_ptr<alexaClientSDK::avsCommon::utils::threading::Executor>>
+        m_stateQueryExecutors;
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<AdapterState>>> m_pendingStateQueries;
+
+    /// The last state of each player, used when a player doesn't return its state before the deadline.
+    std::unordered_map<std::string, AdapterState> m_lastAdapterStates;
+
+    /// Serializes access to the state queries.
+    std::mutex m_stateQueryMutex;
+
     bool m_muted;
     int8_t m_volume;
 
@@ -172,6 +197,9 @@ class FocusHandlerInterface {
 public:
     virtual void setFocus(const std::string& playerId, bool focusAcquire) = 0;
     virtual void setDefaultPlayerFocus() = 0;
+
+    /// Called when the state of a player may have changed, so the cached context state is out of date.
+    virtual void onAdapterStateChanged() = 0;
 };
 
 }  // namespace alexa
@@ -16,6 +16,8 @@
 #ifndef AACE_ENGINE_ALEXA_EXTERNAL_MEDIA_PLAYER_H
 #define AACE_ENGINE_ALEXA_EXTERNAL_MEDIA_PLAYER_H
 
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -23,6 +25,7 @@
 #include <string>
 #include <utility>
 #include <unordered_map>
+#include <vector>
 
 #include <acsdkAudioPlayerInterfaces/AudioPlayerObserverInterface.h>
 #include <AVSCommon/AVS/CapabilityAgent.h>
@@ -144,6 +147,9 @@ public:
      * @param contextManager The AVS Context manager used to generate system context for events.
      * @param exceptionSender The object to use for sending AVS Exception messages.
      * @param playbackRouter The @c PlaybackRouterInterface instance to use when @c ExternalMediaPlayer becomes active.
+     * @param externalMediaAdapterRegistration Provides the information of the registered external media adapters.
+     * @param eventBatchWindow The time the events of the adapters are held to be sent in a batch, or zero to send
+     * each event as soon as it is authorized.
      * @return A @c std::shared_ptr to the new @c ExternalMediaPlayer instance.
      */
     static std::shared_ptr<ExternalMediaPlayer> create(
@@ -159,12 +165,19 @@ public:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::PlaybackRouterInterface> playbackRouter,
         std::shared_ptr<aace::engine::alexa::ExternalMediaAdapterRegistrationInterface>
-            externalMediaAdapterRegistration);
+            externalMediaAdapterRegistration,
+        std::chrono::milliseconds eventBatchWindow = std::chrono::milliseconds::zero());
 
     // adapterHandler specific code
     void addAdapterHandler(std::shared_ptr<ExternalMediaAdapterHandlerInterface> adapterHandler);
     void removeAdapterHandler(std::shared_ptr<ExternalMediaAdapterHandlerInterface> adapterHandler);
 
+    /**
+     * Marks the cached states of the players of the adapter handlers as out of date, so they are queried again
+     * for the next context request. The adapter handlers call it when a player reports a change of its state.
+     */
+    void invalidateAdapterStates();
+
     void executeOnFocusChanged(
         alexaClientSDK::avsCommon::avs::FocusState newFocus,
         alexaClientSDK::avsCommon::avs::MixingBehavior behavior);
@@ -259,6 +272,7 @@ public:
      * adapter.
      * @param adapterCreationMap The map of <PlayerId, AdapterCreateFunction> to be used to create the adapters.
      * @param focusManager Used to control channel focus.
+     * @param eventBatchWindow The time the events of the adapters are held to be sent in a batch.
      *
      * @return true if successful, otherwise false.
      */
@@ -266,7 +280,8 @@ public:
         const AdapterMediaPlayerMap& mediaPlayers,
         const AdapterSpeakerMap& speakers,
         const AdapterCreationMap& adapterCreationMap,
-        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::FocusManagerInterface> focusManager);
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
+        std::chrono::milliseconds eventBatchWindow);
 
 private:
     /**
@@ -304,6 +319,19 @@ private:
     // adapterHandler specific code
     std::string providePlaybackState(std::vector<aace::engine::alexa::AdapterState> adapterStates);
 
+    /**
+     * Queries the states of the players of the adapter handlers, if the cached states are out of date.
+     *
+     * @return @c true if the states were queried.
+     */
+    bool refreshAdapterStates();
+
+    /**
+     * Returns the cached states, with the offset of the playing players advanced by the time since the states
+     * were queried.
+     */
+    std::vector<aace::engine::alexa::AdapterState> getCurrentAdapterStates();
+
     /**
      * This function deserializes a @c Directive's payload into a @c rapidjson::Document.
      *
@@ -622,6 +650,28 @@ private:
     // adapterHandler specific code
     std::unordered_set<std::shared_ptr<ExternalMediaAdapterHandlerInterface>> m_adapterHandlers;
 
+    /// The states of the players of the adapter handlers, cached for the context requests. Used by the executor.
+    std::vector<aace::engine::alexa::AdapterState> m_cachedAdapterStates;
+
+    /// The time @c m_cachedAdapterStates were queried.
+    std::chrono::steady_clock::time_point m_cachedAdapterStatesTime;
+
+    /// Whether a player of @c m_cachedAdapterStates is playing, so its offset changes over time.
+    bool m_cachedAdapterStatesPlaying = false;
+
+    /// Whether @c m_cachedAdapterStates are out of date. Set by any thread when a player state changes.
+    std::atomic<bool> m_adapterStatesDirty{true};
+
+    /// The session state built from @c m_cachedAdapterStates, or empty if it is not built yet.
+    std::string m_cachedSessionState;
+
+    /// The playback state built from @c m_cachedAdapterStates, or empty if it is not built yet or if it changes
+    /// over time.
+    std::string m_cachedPlaybackState;
+
+    /// Whether the RenderPlayerInfoCards observer has to be notified of @c m_cachedAdapterStates.
+    bool m_renderPlayerInfoCardsPending = false;
+
     /// The @c FocusManager used to manage usage of the channel.
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::FocusManagerInterface> m_focusManager;
 
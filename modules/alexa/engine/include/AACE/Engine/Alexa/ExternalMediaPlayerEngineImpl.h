@@ -53,6 +53,8 @@
 #include "AACE/Engine/Alexa/ExternalMediaAdapterHandler.h"
 #include "AACE/Engine/Network/NetworkInfoObserver.h"
 #include "AACE/Engine/Network/NetworkObservableInterface.h"
+#include "AACE/Engine/Storage/LocalStorageInterface.h"
+#include "AACE/Engine/Utils/Threading/TimerWheel.h"
 
 #include <rapidjson/document.h>
 
@@ -89,16 +91,35 @@ private:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::PlaybackRouterInterface> playbackRouter,
         std::shared_ptr<aace::engine::alexa::AudioPlayerObserverDelegate> audioPlayerObserverDelegate,
         std::shared_ptr<aace::engine::alexa::ExternalMediaAdapterRegistrationInterface>
-            externalMediaAdapterRegistration);
+            externalMediaAdapterRegistration,
+        std::chrono::milliseconds eventBatchWindow,
+        std::chrono::milliseconds discoveryReportWindow,
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage);
 
     std::shared_ptr<aace::engine::alexa::ExternalMediaAdapterHandlerInterface> getAdapter(const std::string& playerId);
     std::string getLocalPlayerIdForSource(aace::alexa::LocalMediaSource::Source source);
 
+    /// Reports the players discovered within the discovery report window.
+    void flushDiscoveredPlayers();
+
     // functions with the "Locked" suffix must only be called if the calling thread holds @c m_playersMutex
 
     void sendDiscoveredPlayersIfReadyLocked(const DiscoveredPlayerMap& discoveredPlayers);
     std::string createReportDiscoveredPlayersEventLocked(const DiscoveredPlayerMap& discoveredPlayers);
     std::string createAuthorizationCompleteEventLocked();
+    std::vector<aace::engine::alexa::PlayerInfo> applyAuthorizationsLocked(
+        const std::vector<aace::engine::alexa::PlayerInfo>& authorizedPlayerList);
+
+    /**
+     * Applies the authorizations saved by a previous Engine run instead of reporting the discovered players, if they
+     * are the players that were authorized. Only the first report of the Engine run is restored.
+     *
+     * @returns @c true if the authorizations were restored.
+     */
+    bool restoreAuthorizationsLocked(const DiscoveredPlayerMap& discoveredPlayers);
+
+    /// Saves the authorizations of the discovered players once all of them are acknowledged.
+    void saveAuthorizationsLocked();
 
 public:
     static std::shared_ptr<ExternalMediaPlayerEngineImpl> create(
@@ -115,7 +136,10 @@ public:
         std::shared_ptr<aace::engine::alexa::AudioPlayerObserverDelegate> audioPlayerObserverDelegate,
         std::shared_ptr<aace::engine::alexa::ExternalMediaAdapterRegistrationInterface>
             externalMediaAdapterRegistration,
-        bool duckingEnabled);
+        bool duckingEnabled,
+        std::chrono::milliseconds eventBatchWindow = std::chrono::milliseconds::zero(),
+        std::chrono::milliseconds discoveryReportWindow = std::chrono::milliseconds::zero(),
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage = nullptr);
 
     std::shared_ptr<aace::engine::alexa::ExternalMediaPlayer> getExternalMediaPlayerCapabilityAgent();
 
@@ -157,6 +181,7 @@ public:
     // FocusHandlerInterface
     void setFocus(const std::string& playerId, bool focusAcquire) override;
     void setDefaultPlayerFocus() override;
+    void onAdapterStateChanged() override;
 
     // alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface
     void onConnectionStatusChanged(const Status status, const ChangedReason reason) override;
@@ -216,6 +241,26 @@ private:
      */
     std::unordered_map<std::string, PlayerInfo> m_authorizationStateMap;
 
+    /**
+     * The players discovered within this window are reported in a single ReportDiscoveredPlayers event, or each
+     * report is sent at once if it is zero.
+     */
+    std::chrono::milliseconds m_discoveryReportWindow = std::chrono::milliseconds::zero();
+
+    /// The timer of the end of the discovery report window. Access is serialized by @c m_playersMutex.
+    aace::engine::utils::threading::TimerWheel::TimerId m_discoveryReportTimer =
+        aace::engine::utils::threading::TimerWheel::INVALID_TIMER;
+
+    /**
+     * The storage of the authorizations of the discovered players, which are restored instead of reporting the same
+     * players again in the next Engine run, or @c nullptr if the players are always reported.
+     */
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> m_localStorage;
+
+    /// Whether the first report of the Engine run was attempted to be restored. Access is serialized by
+    /// @c m_playersMutex.
+    bool m_authorizationsRestoreAttempted = false;
+
     /**
      * The current state of connection to an Alexa endpoint. Access is serialized by @c m_connectionMutex
      */
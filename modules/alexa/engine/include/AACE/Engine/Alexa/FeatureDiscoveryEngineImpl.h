@@ -16,6 +16,7 @@
 #ifndef AACE_ENGINE_ALEXA_FEATURE_DISCOVERY_ENGINE_IMPL_H
 #define AACE_ENGINE_ALEXA_FEATURE_DISCOVERY_ENGINE_IMPL_H
 
+#include <chrono>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -24,6 +25,8 @@
 #include "AACE/Engine/Core/EngineService.h"
 #include "AACE/Engine/PropertyManager/PropertyManagerServiceInterface.h"
 #include "AACE/Engine/Alexa/FeatureDiscoveryRESTAgent.h"
+#include "AACE/Engine/Network/BackgroundTransferScheduler.h"
+#include "AACE/Engine/Storage/LocalStorageInterface.h"
 #include "AACE/Engine/Utils/Threading/Executor.h"
 
 namespace aace {
@@ -35,12 +38,23 @@ class FeatureDiscoveryEngineImpl
         , public alexaClientSDK::avsCommon::utils::RequiresShutdown
         , public std::enable_shared_from_this<FeatureDiscoveryEngineImpl> {
 private:
-    FeatureDiscoveryEngineImpl(std::shared_ptr<aace::alexa::FeatureDiscovery> platfromInterface);
+    FeatureDiscoveryEngineImpl(
+        std::shared_ptr<aace::alexa::FeatureDiscovery> platfromInterface,
+        std::chrono::seconds cacheTimeToLive);
 
 public:
+    /**
+     * Creates the FeatureDiscovery engine implementation.
+     *
+     * @param platfromInterface The FeatureDiscovery platform interface
+     * @param engineContext The engine context
+     * @param cacheTimeToLive The time the features received from the cloud are served from the cache without being
+     *        requested again, or @c 0 to request them for each discovery request.
+     */
     static std::shared_ptr<FeatureDiscoveryEngineImpl> create(
         std::shared_ptr<aace::alexa::FeatureDiscovery> platfromInterface,
-        std::shared_ptr<aace::engine::core::EngineContext> engineContext);
+        std::shared_ptr<aace::engine::core::EngineContext> engineContext,
+        std::chrono::seconds cacheTimeToLive = std::chrono::seconds::zero());
 
 protected:
     void doShutdown() override;
@@ -50,6 +64,24 @@ private:
     bool initialize(std::shared_ptr<aace::engine::core::EngineContext> engineContext);
     void executeOnGetFeatures(const std::string& requestId, const std::string& discoveryRequests);
 
+    /**
+     * Gets the features of a request, from the cache if they are cached. Features that are older than the time to
+     * live are still returned, so they show without waiting for the cloud, and they are requested again in the
+     * background for the next request. Called on the executor.
+     */
+    std::vector<FeatureDiscoveryRESTAgent::LocalizedFeature> getFeatures(
+        const std::string& url,
+        const std::string& locale);
+
+    /// Requests the features of a cached response again, and updates the cache. Called on the executor.
+    void executeRevalidate(const std::string& key, const std::string& url, const std::string& locale);
+
+    /// Requests the features from the cloud, and caches the response if it has features. Called on the executor.
+    std::vector<FeatureDiscoveryRESTAgent::LocalizedFeature> requestFeatures(
+        const std::string& key,
+        const std::string& url,
+        const std::string& locale);
+
 public:
     bool onGetFeatures(const std::string& requestId, const std::string& discoveryRequests) override;
 
@@ -59,6 +91,24 @@ private:
     std::shared_ptr<aace::engine::alexa::FeatureDiscoveryRESTAgent> m_featureDiscoveryRESTAgent;
     std::string m_tag;
     std::unordered_set<std::string> m_validCombinations;
+    /// Defers the requests during a voice interaction, null if not available
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> m_backgroundTransferScheduler;
+
+    /// A response of the cloud, and the time it was received
+    struct CachedResponse {
+        std::string body;
+        std::chrono::system_clock::time_point time;
+    };
+
+    /// The time the cached responses are served without being requested again, or @c 0 if they are not cached
+    std::chrono::seconds m_cacheTimeToLive;
+    /// Persists the cached responses, null if not available
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> m_localStorage;
+    /// The cached responses, keyed by locale and URL, loaded from the local storage when first requested
+    std::unordered_map<std::string, CachedResponse> m_cache;
+    /// The keys of the responses requested again in the background
+    std::unordered_set<std::string> m_revalidating;
+
     aace::engine::utils::threading::Executor m_executor;
 };
 
@@ -0,0 +1,302 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_HTTP_CLIENT_POOL_H
+#define AACE_ENGINE_ALEXA_HTTP_CLIENT_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <AVSCommon/Utils/LibcurlUtils/HttpDelete.h>
+#include <AVSCommon/Utils/LibcurlUtils/HttpGet.h>
+#include <AVSCommon/Utils/LibcurlUtils/HttpPost.h>
+#include <AVSCommon/Utils/LibcurlUtils/HttpPut.h>
+#include <AVSCommon/Utils/LibcurlUtils/HTTPResponse.h>
+
+#include <AACE/Engine/Utils/Threading/ThreadPool.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * A process wide pool of the libcurl HTTP clients used by the engine REST agents.
+ *
+ * A request checks out an idle client of its method, or creates one, and returns it to the pool once it completes.
+ * A client resets its curl handle before each request, so it applies the latest curl options such as the network
+ * interface and the proxy headers, while the curl handle keeps its open connections, its DNS cache and its TLS
+ * sessions. The requests to the same host after the first one therefore reuse the connection instead of paying for
+ * a new TCP and TLS handshake. Concurrent requests use different clients, so the pool is safe to use from any
+ * thread.
+ *
+ * A POST or PUT request can compress its body with gzip or deflate. The body is sent with the matching
+ * @c Content-Encoding header, and the request advertises with @c Accept-Encoding that it accepts a compressed
+ * response, which the pool inflates before returning it, so the callers always get the plain body.
+ *
+ * A request can also be sent asynchronously, and its response is passed to a callback. The asynchronous requests
+ * share a few request threads, instead of each caller blocking a thread of its own until the response arrives, so
+ * a flow waiting for a response, such as an @c AsyncFlow, holds no thread.
+ */
+class HttpClientPool {
+public:
+    using HTTPResponse = alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse;
+
+    /// The encodings of a request body
+    enum class ContentEncoding {
+        /// The body is sent as is
+        IDENTITY,
+        /// The body is compressed in the gzip format
+        GZIP,
+        /// The body is compressed in the zlib format, which HTTP calls deflate
+        DEFLATE
+    };
+
+    /// Receives the response of an asynchronous request, on a request thread
+    using ResponseCallback = std::function<void(const HTTPResponse& response)>;
+
+    /// Performs a request with the pool, on a request thread
+    using Request = std::function<HTTPResponse(HttpClientPool& pool)>;
+
+    /// The smallest body that is compressed, the smaller ones don't get any shorter
+    static const size_t MIN_COMPRESSED_BODY_SIZE;
+
+    /// The number of request threads of the asynchronous requests
+    static const size_t REQUEST_THREAD_COUNT;
+
+    /// Returns the pool shared by the engine services.
+    static std::shared_ptr<HttpClientPool> getInstance();
+
+    /**
+     * Performs an HTTP POST request with a pooled client.
+     *
+     * @param url The URL of the request.
+     * @param headerLines The HTTP headers of the request.
+     * @param data The body of the request.
+     * @param timeout The timeout of the request.
+     * @param encoding The encoding of the body. The body is sent as is if it is shorter than
+     *        @c MIN_COMPRESSED_BODY_SIZE, or if the headers already have a @c Content-Encoding.
+     * @return The response, or an empty @c HTTPResponse if the request could not be sent.
+     */
+    HTTPResponse doPost(
+        const std::string& url,
+        const std::vector<std::string>& headerLines,
+        const std::string& data,
+        std::chrono::seconds timeout,
+        ContentEncoding encoding = ContentEncoding::IDENTITY);
+
+    /**
+     * Performs an HTTP POST request with a pooled client, with a URL encoded form as the body.
+     *
+     * @param url The URL of the request.
+     * @param headerLines The HTTP headers of the request.
+     * @param data The fields of the form.
+     * @param timeout The timeout of the request.
+     * @return The response, or an empty @c HTTPResponse if the request could not be sent.
+     */
+    HTTPResponse doPost(
+        const std::string& url,
+        const std::vector<std::string>& headerLines,
+        const std::vector<std::pair<std::string, std::string>>& data,
+        std::chrono::seconds timeout);
+
+    /**
+     * Performs an HTTP GET request with a pooled client.
+     *
+     * @param url The URL of the request.
+     * @param headers The HTTP headers of the request.
+     * @param timeout The timeout of the request.
+     * @return The response, or an empty @c HTTPResponse if the request could not be sent.
+     */
+    HTTPResponse doGet(const std::string& url, const std::vector<std::string>& headers, std::chrono::seconds timeout);
+
+    /**
+     * Performs an HTTP DELETE request with a pooled client.
+     *
+     * @param url The URL of the request.
+     * @param headers The HTTP headers of the request.
+     * @param timeout The timeout of the request.
+     * @return The response, or an empty @c HTTPResponse if the request could not be sent.
+     */
+    HTTPResponse doDelete(
+        const std::string& url,
+        const std::vector<std::string>& headers,
+        std::chrono::seconds timeout);
+
+    /**
+     * Performs an HTTP PUT request with a pooled client.
+     *
+     * @param url The URL of the request.
+     * @param headers The HTTP headers of the request.
+     * @param data The body of the request.
+     * @param encoding The encoding of the body, as for @c doPost().
+     * @return The response, or an empty @c HTTPResponse if the request could not be sent.
+     */
+    HTTPResponse doPut(
+        const std::string& url,
+        const std::vector<std::string>& headers,
+        const std::string& data,
+        ContentEncoding encoding = ContentEncoding::IDENTITY);
+
+    /**
+     * Performs a request asynchronously on a request thread. The requests beyond the number of request threads are
+     * queued until a thread is free.
+     *
+     * @param request Performs the request with the pool, with the synchronous methods.
+     * @param callback Receives the response, on the request thread. The callback must not block for long, and
+     *        should hand the response to the caller, such as storing it and waking up its @c AsyncFlow.
+     * @return @c false if the request could not be queued, in which case the callback is not called.
+     */
+    bool submit(Request request, ResponseCallback callback);
+
+    /**
+     * Performs an HTTP POST request asynchronously, with a URL encoded form as the body.
+     *
+     * @param url The URL of the request.
+     * @param headerLines The HTTP headers of the request.
+     * @param data The fields of the form.
+     * @param timeout The timeout of the request.
+     * @param callback Receives the response, or an empty @c HTTPResponse if the request could not be sent.
+     * @return @c false if the request could not be queued, in which case the callback is not called.
+     */
+    bool doPostAsync(
+        const std::string& url,
+        const std::vector<std::string>& headerLines,
+        const std::vector<std::pair<std::string, std::string>>& data,
+        std::chrono::seconds timeout,
+        ResponseCallback callback);
+
+    /**
+     * Performs an HTTP GET request asynchronously.
+     *
+     * @param url The URL of the request.
+     * @param headers The HTTP headers of the request.
+     * @param timeout The timeout of the request.
+     * @param callback Receives the response, or an empty @c HTTPResponse if the request could not be sent.
+     * @return @c false if the request could not be queued, in which case the callback is not called.
+     */
+    bool doGetAsync(
+        const std::string& url,
+        const std::vector<std::string>& headers,
+        std::chrono::seconds timeout,
+        ResponseCallback callback);
+
+    /**
+     * Closes the idle clients and their connections. The clients of the requests in progress are closed when the
+     * requests complete. This is called when the network interface changes, so no request reuses a connection
+     * of the previous interface.
+     */
+    void clear();
+
+    /// Returns the number of idle clients in the pool.
+    size_t getIdleClientCount();
+
+    /**
+     * Cancels the requests, or resumes them. While the pool is cancelled, the requests fail right away with an
+     * empty @c HTTPResponse instead of being sent, so the services shutting down don't wait for the network or
+     * retry. The requests in progress still complete or time out, since a libcurl client can't be interrupted.
+     * The engine cancels the pool when it shuts down with a deadline.
+     *
+     * @param cancelled Whether the requests are cancelled.
+     */
+    void setCancelled(bool cancelled);
+
+    /// Returns @c true if the requests are cancelled.
+    bool isCancelled() const;
+
+    /**
+     * Compresses a body.
+     *
+     * @param data The body to compress.
+     * @param encoding The encoding, other than @c IDENTITY.
+     * @param [out] compressed The compressed body.
+     * @return @c true if the body was compressed.
+     */
+    static bool compressBody(const std::string& data, ContentEncoding encoding, std::string& compressed);
+
+    /**
+     * Inflates a body compressed with gzip or deflate, which is recognized from its header.
+     *
+     * @param data The body to inflate.
+     * @param [out] inflated The inflated body.
+     * @return @c true if the body was compressed and is inflated, @c false if it is not compressed or is corrupted.
+     */
+    static bool inflateBody(const std::string& data, std::string& inflated);
+
+private:
+    HttpClientPool() = default;
+
+    /// The idle clients of an HTTP method
+    template <typename Client>
+    class Clients {
+    public:
+        /// Returns an idle client, or a new one, and the generation of the pool it belongs to.
+        std::pair<std::unique_ptr<Client>, uint64_t> acquire();
+
+        /// Returns a client to the pool, unless the pool was cleared since it was acquired.
+        void release(std::unique_ptr<Client> client, uint64_t generation);
+
+        void clear();
+
+        size_t size();
+
+    private:
+        std::mutex m_mutex;
+        std::vector<std::unique_ptr<Client>> m_idle;
+        uint64_t m_generation = 0;
+    };
+
+    /// Performs a request with a client checked out of @c clients
+    template <typename Client, typename Send>
+    HTTPResponse perform(Clients<Client>& clients, const std::string& event, Send request);
+
+    /**
+     * Performs a request with a body, compressed with @c encoding.
+     *
+     * @param request Sends the headers and the body it is given with a client checked out of @c clients.
+     */
+    template <typename Client, typename Send>
+    HTTPResponse performEncoded(
+        Clients<Client>& clients,
+        const std::string& event,
+        const std::vector<std::string>& headers,
+        const std::string& data,
+        ContentEncoding encoding,
+        Send request);
+
+    Clients<alexaClientSDK::avsCommon::utils::libcurlUtils::HttpPost> m_postClients;
+    Clients<alexaClientSDK::avsCommon::utils::libcurlUtils::HttpGet> m_getClients;
+    Clients<alexaClientSDK::avsCommon::utils::libcurlUtils::HttpDelete> m_deleteClients;
+    Clients<alexaClientSDK::avsCommon::utils::libcurlUtils::HttpPut> m_putClients;
+
+    std::atomic<bool> m_cancelled{false};
+
+    /// The request threads, created with the first asynchronous request
+    std::shared_ptr<aace::engine::utils::threading::ThreadPool> m_requestThreads;
+    std::mutex m_requestThreadsMutex;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_HTTP_CLIENT_POOL_H
@@ -21,6 +21,7 @@
 #include <chrono>
 
 #include <AIP/Initiator.h>
+#include <AVSCommon/AVS/AudioInputStream.h>
 
 namespace aace {
 namespace engine {
@@ -40,6 +41,23 @@ public:
      */
     virtual bool shouldBlock(const std::string& wakeword, const std::chrono::milliseconds& timeout);
 
+    /**
+     * Function used to verify if the detected wakeword should be blocked, given the audio of the wakeword.
+     * @param wakeword The wakeword being detected
+     * @param stream The stream the wakeword was detected in
+     * @param beginIndex The index in @c stream of the first sample of the wakeword
+     * @param endIndex The index in @c stream of the sample after the wakeword
+     * @param timeout The timeout for the verification
+     * @return Returns @c true if the wakeword should be blocked, @c false otherwise
+     * @note By default, calls @c shouldBlock(wakeword, timeout)
+     */
+    virtual bool shouldBlock(
+        const std::string& wakeword,
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+        alexaClientSDK::avsCommon::avs::AudioInputStream::Index beginIndex,
+        alexaClientSDK::avsCommon::avs::AudioInputStream::Index endIndex,
+        const std::chrono::milliseconds& timeout);
+
     /**
      * Function used to verify if the initiator should be blocked.
      * @param initiator The initiator being used
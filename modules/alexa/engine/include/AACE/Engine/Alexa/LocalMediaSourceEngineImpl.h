@@ -16,7 +16,9 @@
 #ifndef AACE_ENGINE_ALEXA_LOCAL_MEDIA_SOURCE_ENGINE_IMPL_H
 #define AACE_ENGINE_ALEXA_LOCAL_MEDIA_SOURCE_ENGINE_IMPL_H
 
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "ExternalMediaAdapterInterface.h"
@@ -33,6 +35,16 @@ namespace aace {
 namespace engine {
 namespace alexa {
 
+/**
+ * Reports a local media source to the external media player.
+ *
+ * The state of the source is kept current by the player events: each event or error of the platform, and each
+ * operation requested by Alexa, queues a refresh, which queries the platform state on the state executor, converts
+ * it, and then reports the state change to the external media player. The adapter state queries return the converted
+ * state without calling the platform, with the track offset of a playing source advanced by the time elapsed since
+ * the refresh, so the context of a @c Recognize event never waits for the platform. The platform is queried by the
+ * adapter state query only until the first refresh completes.
+ */
 class LocalMediaSourceEngineImpl
         : public ExternalMediaAdapterHandler
         , public aace::alexa::LocalMediaSourceEngineInterface {
@@ -54,6 +66,18 @@ private:
     std::string getPlayerId(Source source);
     void setDefaultPlayerFocus();
 
+    /// Converts the state of the platform to the adapter state.
+    void convertState(
+        const aace::alexa::LocalMediaSource::LocalMediaSourceState& platformState,
+        Source platformSource,
+        aace::engine::alexa::AdapterState& state);
+
+    /// Queues a refresh of the state, unless one is already queued.
+    void scheduleStateRefresh();
+
+    /// Queries and converts the state of the platform, and reports the state change.
+    void refreshState();
+
 public:
     static std::shared_ptr<LocalMediaSourceEngineImpl> create(
         std::shared_ptr<aace::alexa::LocalMediaSource> platformLocalMediaSource,
@@ -112,6 +136,20 @@ private:
 
     std::string m_localPlayerId;
     std::unordered_map<std::string, ContentSelector> m_contentSelectorNameMap;
+
+    /// Serializes access to the converted state
+    std::mutex m_stateMutex;
+    /// Whether a refresh of the state completed
+    bool m_stateValid = false;
+    /// Whether a refresh is queued and not started yet
+    bool m_stateRefreshQueued = false;
+    /// The converted state of the last refresh
+    aace::engine::alexa::AdapterState m_state;
+    /// The time of the last refresh, to advance the track offset of a playing source
+    std::chrono::steady_clock::time_point m_stateTime;
+
+    /// Refreshes the state, so the platform is never queried from the context of a request
+    alexaClientSDK::avsCommon::utils::threading::Executor m_stateExecutor;
 };
 
 }  // namespace alexa
@@ -16,15 +16,20 @@
 #ifndef ALEXA_CLIENT_SDK_SAMPLEAPP_INCLUDE_SAMPLEAPP_LOCALEASSETSMANAGER_H_
 #define ALEXA_CLIENT_SDK_SAMPLEAPP_INCLUDE_SAMPLEAPP_LOCALEASSETSMANAGER_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
 #include <unordered_set>
 
 #include <acsdkShutdownManagerInterfaces/ShutdownNotifierInterface.h>
 #include <AVSCommon/SDKInterfaces/LocaleAssetsManagerInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+
+#include "WakewordEngineAdapter.h"
 
 namespace aace {
 namespace engine {
@@ -35,6 +40,10 @@ namespace alexa {
  *
  * This manager will use the @c AlexaClientSDKConfig.json to retrieve the supported locales. For devices with wake word
  * enabled this class will support "ALEXA" only.
+ *
+ * The wake word engine is initialized with the active locale only. Once it is set, the assets of the other supported
+ * locales are prefetched in the background, and a locale change loads the new wake word model next to the active one,
+ * which keeps listening until the new model is ready.
  */
 class LocaleAssetsManager
         : public alexaClientSDK::avsCommon::sdkInterfaces::LocaleAssetsManagerInterface
@@ -47,6 +56,18 @@ public:
      */
     static std::shared_ptr<LocaleAssetsManager> create(bool enableWakeWord);
 
+    /**
+     * Sets the wake word engine whose assets are changed with the locale, and starts prefetching the assets of the
+     * other supported locales in the background.
+     *
+     * @param wakewordEngineAdapter The wake word engine, initialized with @c activeLocale.
+     * @param activeLocale The locale the wake word engine was initialized with, the locales of a multilingual setting
+     * separated by '/'.
+     */
+    void setWakewordEngineAdapter(
+        std::shared_ptr<WakewordEngineAdapter> wakewordEngineAdapter,
+        const Locale& activeLocale);
+
     /// @name LocaleAssetsManagerInterface methods
     /// @{
     bool changeAssets(const Locales& locales, const WakeWords& wakeWords) override;
@@ -89,6 +110,23 @@ private:
      */
     bool initialize(bool enableWakeWord);
 
+    /**
+     * Changes the locale of the wake word engine. This is called from the executor.
+     *
+     * @param wakewordEngineAdapter The wake word engine.
+     * @param locale The new locale.
+     * @return @c true if the wake word engine uses @c locale; otherwise, @c false.
+     */
+    bool executeChangeLocale(std::shared_ptr<WakewordEngineAdapter> wakewordEngineAdapter, const Locale& locale);
+
+    /**
+     * Prefetches the assets of a locale. This is called from the executor.
+     *
+     * @param wakewordEngineAdapter The wake word engine.
+     * @param locale The locale to prefetch.
+     */
+    void executePrefetchLocale(std::shared_ptr<WakewordEngineAdapter> wakewordEngineAdapter, const Locale& locale);
+
     /// Set with the supported wake words. This object doesn't support different wake words per locale.
     WakeWordsSets m_supportedWakeWords;
 
@@ -109,6 +147,21 @@ private:
     /// Set with observers.
     std::unordered_set<std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::LocaleAssetsObserverInterface>>
         m_observers;
+
+    /// Mutex to synchronize access to the wake word engine and its locale.
+    std::mutex m_wakewordMutex;
+
+    /// The wake word engine, or @c nullptr until it is set.
+    std::shared_ptr<WakewordEngineAdapter> m_wakewordEngineAdapter;
+
+    /// The locale of the wake word engine.
+    Locale m_activeLocale;
+
+    /// Whether the ongoing locale change was cancelled.
+    std::atomic<bool> m_changeCancelled;
+
+    /// Executor loading the assets, so the prefetches and the changes don't overlap.
+    alexaClientSDK::avsCommon::utils::threading::Executor m_executor;
 };
 
 }  // namespace alexa
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_OPUS_SPEECH_ENCODER_CONTEXT_H
+#define AACE_ENGINE_ALEXA_OPUS_SPEECH_ENCODER_CONTEXT_H
+
+#include <memory>
+#include <string>
+
+#include <AVSCommon/Utils/AudioFormat.h>
+#include <SpeechEncoder/EncoderContext.h>
+
+struct OpusEncoder;
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * OpusSpeechEncoderContext encodes the 16 kHz mono LPCM audio of the speech recognizer to Opus
+ * frames of 20 ms, with a constant bitrate and a configurable complexity, for the audio attachment
+ * of the @c Recognize event.
+ *
+ * The @c SpeechEncoder runs the context on its own thread, which reads the audio input stream
+ * one frame at a time, so the encoder never buffers more than a frame. The context registers the
+ * encoder thread with the @c ThreadPolicy as @c SpeechEncoder, and lowers its priority to the
+ * configured nice value, so encoding doesn't compete with the audio capture and the wake word
+ * engines. A policy configured for the @c SpeechEncoder thread replaces the nice value.
+ */
+class OpusSpeechEncoderContext : public alexaClientSDK::speechencoder::EncoderContext {
+public:
+    /// The name of the encoder thread
+    static constexpr const char* THREAD_NAME = "SpeechEncoder";
+
+    /// The encoder configuration
+    struct Config {
+        /// The constant bitrate in bits per second, a multiple of 400 from 6000 to 128000
+        int bitrate = 32000;
+        /// The encoder complexity from 0 to 10, lower values use less CPU
+        int complexity = 5;
+        /// The nice value of the encoder thread, from -20 to 19
+        int nice = 10;
+    };
+
+    /**
+     * Creates an encoder context with the default configuration.
+     *
+     * @returns The context.
+     */
+    static std::shared_ptr<OpusSpeechEncoderContext> create();
+
+    /**
+     * Creates an encoder context.
+     *
+     * @param config The encoder configuration.
+     * @returns The context, or @c nullptr if the configuration is invalid.
+     */
+    static std::shared_ptr<OpusSpeechEncoderContext> create(const Config& config);
+
+    ~OpusSpeechEncoderContext() override;
+
+    // alexaClientSDK::speechencoder::EncoderContext
+    bool init(alexaClientSDK::avsCommon::utils::AudioFormat inputFormat) override;
+    size_t getInputFrameSize() override;
+    size_t getOutputFrameSize() override;
+    bool requiresFullyRead() override;
+    alexaClientSDK::avsCommon::utils::AudioFormat getAudioFormat() override;
+    std::string getAVSFormatName() override;
+    bool start() override;
+    ssize_t processSamples(void* samples, size_t nWords, uint8_t* buffer) override;
+    void close() override;
+
+private:
+    OpusSpeechEncoderContext(const Config& config);
+
+    /// Lowers the priority of the encoder thread, and registers it with the thread policies.
+    void registerEncoderThread();
+
+    const Config m_config;
+    alexaClientSDK::avsCommon::utils::AudioFormat m_inputFormat;
+    alexaClientSDK::avsCommon::utils::AudioFormat m_outputFormat;
+    OpusEncoder* m_encoder = nullptr;
+    bool m_threadRegistered = false;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_OPUS_SPEECH_ENCODER_CONTEXT_H
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_PLAYBACK_BUTTON_COALESCER_H
+#define AACE_ENGINE_ALEXA_PLAYBACK_BUTTON_COALESCER_H
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <AACE/Alexa/AlexaEngineInterfaces.h>
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * Collapses the rapid presses of the @c NEXT and @c PREVIOUS buttons into the net number of skips.
+ *
+ * Each press of @c NEXT or @c PREVIOUS is a request sent to AVS, and the requests are sent one after the other, so
+ * skipping five tracks queues five round trips, and a @c PREVIOUS press that undoes a @c NEXT press still waits for
+ * both. The coalescer passes the first press to the handler at once, and counts the presses that follow it until no
+ * press is made for the coalescing window: the presses in opposite directions cancel each other, and only the net
+ * number of skips is passed to the handler when the window ends. AVS has no request to skip several tracks at once,
+ * so the handler is called once for each remaining skip. The other buttons end the window: the pending skips are
+ * passed to the handler first, then the button.
+ */
+class PlaybackButtonCoalescer : public std::enable_shared_from_this<PlaybackButtonCoalescer> {
+public:
+    using PlaybackButton = aace::alexa::PlaybackControllerEngineInterface::PlaybackButton;
+
+    /// The handler of the buttons, which is called with the coalescer lock held, and must not block
+    using Handler = std::function<void(PlaybackButton button)>;
+
+    /// The default time the presses that follow a skip are collected before the net skips are passed to the handler
+    static const std::chrono::milliseconds DEFAULT_WINDOW;
+
+    /**
+     * Creates a playback button coalescer.
+     *
+     * @param handler The handler of the buttons.
+     * @param window The time the presses that follow a skip are collected, or zero to pass each press to the handler.
+     * @returns The coalescer, or @c nullptr if the handler is empty or the window is negative.
+     */
+    static std::shared_ptr<PlaybackButtonCoalescer> create(
+        Handler handler,
+        std::chrono::milliseconds window = DEFAULT_WINDOW);
+
+    ~PlaybackButtonCoalescer();
+
+    /**
+     * Handles a button press.
+     *
+     * @param button The button.
+     */
+    void buttonPressed(PlaybackButton button);
+
+    /// Passes the pending skips to the handler, and ends the window.
+    void flush();
+
+    /// Returns the net number of pending skips, positive for @c NEXT and negative for @c PREVIOUS.
+    int getPendingSkips();
+
+    /// Drops the pending skips, and ignores the presses that follow.
+    void shutdown();
+
+private:
+    PlaybackButtonCoalescer(Handler handler, std::chrono::milliseconds window);
+
+    /// Restarts the wait for the presses to settle. @c m_mutex must be held.
+    void restartWindowTimerLocked();
+
+    /// Passes the pending skips to the handler, and ends the window. @c m_mutex must be held.
+    void flushLocked();
+
+    const Handler m_handler;
+    const std::chrono::milliseconds m_window;
+
+    std::mutex m_mutex;
+    /// Whether a skip was passed to the handler, and the presses that follow it are collected
+    bool m_windowOpen;
+    int m_pendingSkips;
+    aace::engine::utils::threading::TimerWheel::TimerId m_windowTimer;
+    /// Incremented when the window timer is restarted, so a timer that expired meanwhile is ignored
+    uint64_t m_windowGeneration;
+    bool m_shutdown;
+
+    /// The number of presses collected in the window, to log the presses coalesced
+    size_t m_pressCount;
+
+    /// Declared last so the window task is finished before the other members are destroyed
+    aace::engine::utils::threading::Executor m_executor;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_PLAYBACK_BUTTON_COALESCER_H
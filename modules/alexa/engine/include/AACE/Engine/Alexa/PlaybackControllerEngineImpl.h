@@ -21,6 +21,7 @@
 #include <PlaybackController/PlaybackRouter.h>
 
 #include "AACE/Alexa/PlaybackController.h"
+#include "PlaybackButtonCoalescer.h"
 
 namespace aace {
 namespace engine {
@@ -36,15 +37,26 @@ private:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::endpoints::EndpointCapabilitiesRegistrarInterface>
             capabilitiesRegistrar,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
-        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager);
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
+        std::chrono::milliseconds buttonCoalescingWindow);
+
+    /// Sends a button press, which the button coalescer passes from the platform.
+    void sendButton(PlaybackButton button);
 
 public:
+    /**
+     * Creates the playback controller engine implementation.
+     *
+     * @param buttonCoalescingWindow The time the @c NEXT and @c PREVIOUS presses that follow a skip are collected
+     *        to request only the net skips, or zero to request each press.
+     */
     static std::shared_ptr<PlaybackControllerEngineImpl> create(
         std::shared_ptr<aace::alexa::PlaybackController> playbackControllerPlatformInterface,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::endpoints::EndpointCapabilitiesRegistrarInterface>
             capabilitiesRegistrar,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
-        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager);
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
+        std::chrono::milliseconds buttonCoalescingWindow = PlaybackButtonCoalescer::DEFAULT_WINDOW);
 
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::PlaybackRouterInterface> getPlaybackRouter();
 
@@ -60,6 +72,7 @@ private:
     std::shared_ptr<alexaClientSDK::capabilityAgents::playbackController::PlaybackController>
         m_playbackControllerCapabilityAgent;
     std::shared_ptr<alexaClientSDK::capabilityAgents::playbackController::PlaybackRouter> m_playbackRouter;
+    std::shared_ptr<PlaybackButtonCoalescer> m_buttonCoalescer;
 };
 
 }  // namespace alexa
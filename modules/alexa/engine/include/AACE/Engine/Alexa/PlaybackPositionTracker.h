@@ -0,0 +1,81 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_PLAYBACK_POSITION_TRACKER_H
+#define AACE_ENGINE_ALEXA_PLAYBACK_POSITION_TRACKER_H
+
+#include <chrono>
+#include <mutex>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * Tracks the playback position of a platform media player from the positions the platform reports.
+ *
+ * Between two reports the position is interpolated with a monotonic clock while the media is playing, and is
+ * frozen while it is not. The tracker only knows the position once the platform has reported one for the current
+ * source, and forgets it if the media plays for longer than the maximum age without a new report, so a caller
+ * can fall back to querying the platform.
+ *
+ * The tracker is thread safe.
+ */
+class PlaybackPositionTracker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// The longest time the position is interpolated without a new report, by default.
+    static constexpr std::chrono::milliseconds DEFAULT_MAX_AGE{5000};
+
+    PlaybackPositionTracker(std::chrono::milliseconds maxAge = DEFAULT_MAX_AGE);
+
+    /// Sets the position reported by the platform.
+    void update(std::chrono::milliseconds position, Clock::time_point now = Clock::now());
+
+    /// Starts or stops the interpolation of the position, when the media starts or stops playing.
+    void setPlaying(bool playing, Clock::time_point now = Clock::now());
+
+    /**
+     * Gets the current position.
+     *
+     * @param [out] position The current position.
+     * @return @c true if the position is known, else @c false.
+     */
+    bool getPosition(std::chrono::milliseconds& position, Clock::time_point now = Clock::now()) const;
+
+    /// Forgets the position, when the source changes.
+    void reset();
+
+private:
+    std::chrono::milliseconds interpolate(Clock::time_point now) const;
+
+    const std::chrono::milliseconds m_maxAge;
+
+    mutable std::mutex m_mutex;
+    bool m_known = false;
+    bool m_playing = false;
+    // the position at m_positionTime
+    std::chrono::milliseconds m_position{0};
+    Clock::time_point m_positionTime;
+    // the time of the last report
+    Clock::time_point m_updateTime;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_PLAYBACK_POSITION_TRACKER_H
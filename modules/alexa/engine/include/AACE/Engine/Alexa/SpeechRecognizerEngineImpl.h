@@ -16,6 +16,7 @@
 #ifndef AACE_ENGINE_ALEXA_SPEECH_RECOGNIZER_ENGINE_IMPL_H
 #define AACE_ENGINE_ALEXA_SPEECH_RECOGNIZER_ENGINE_IMPL_H
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -44,10 +45,12 @@
 
 #include <AACE/Alexa/SpeechRecognizer.h>
 #include <AACE/Engine/Audio/AudioManagerInterface.h>
+#include <AACE/Engine/Audio/VoiceActivityGate.h>
 #include "AACE/Engine/PropertyManager/PropertyManagerServiceInterface.h"
 #include <AACE/Alexa/AlexaClient.h>
 
 #include "InitiatorVerifier.h"
+#include "VoiceTurnMonitor.h"
 #include "WakewordEngineAdapter.h"
 #include "WakewordObserverInterface.h"
 
@@ -62,10 +65,30 @@ class SpeechRecognizerEngineImpl
         , public alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface
         , public alexaClientSDK::avsCommon::utils::RequiresShutdown
         , public std::enable_shared_from_this<SpeechRecognizerEngineImpl> {
+public:
+    /**
+     * The configuration of the ring buffer the captured audio is written to. The buffer is shared by the audio input
+     * processor, the wakeword engine and any other reader of @c getAudioInputStream().
+     */
+    struct AudioBufferConfig {
+        /// Creates the default configuration, with 15 seconds of audio and 10 readers.
+        AudioBufferConfig();
+
+        /// The amount of audio data kept in the buffer, which is halved when the buffer is created while the
+        /// memory is low, and quartered while it is critical, down to 5 seconds.
+        std::chrono::milliseconds duration;
+        /// The maximum number of readers of the buffer.
+        size_t maxReaders;
+    };
+
 private:
     SpeechRecognizerEngineImpl(
         std::shared_ptr<aace::alexa::SpeechRecognizer> speechRecognizerPlatformInterface,
-        const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat);
+        const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat,
+        const AudioBufferConfig& audioBufferConfig,
+        const aace::engine::audio::VoiceActivityGate::Config& voiceActivityGateConfig,
+        bool speculativeWakewordVerification,
+        std::shared_ptr<VoiceTurnMonitor> voiceTurnMonitor);
 
     bool initialize(
         std::shared_ptr<aace::engine::audio::AudioManagerInterface> audioManager,
@@ -113,7 +136,12 @@ public:
         std::shared_ptr<alexaClientSDK::speechencoder::SpeechEncoder> speechEncoder = nullptr,
         std::shared_ptr<aace::engine::alexa::WakewordEngineAdapter> wakewordEngineAdapter = nullptr,
         const std::vector<std::shared_ptr<aace::engine::alexa::InitiatorVerifier>>& initiatorVerifiers =
-            std::vector<std::shared_ptr<aace::engine::alexa::InitiatorVerifier>>());
+            std::vector<std::shared_ptr<aace::engine::alexa::InitiatorVerifier>>(),
+        const AudioBufferConfig& audioBufferConfig = AudioBufferConfig(),
+        const aace::engine::audio::VoiceActivityGate::Config& voiceActivityGateConfig =
+            aace::engine::audio::VoiceActivityGate::Config(),
+        bool speculativeWakewordVerification = false,
+        std::shared_ptr<VoiceTurnMonitor> voiceTurnMonitor = nullptr);
 
     /// @name @c aace::alexa::SpeechRecognizerEngineInterface functions
     /// @{
@@ -128,6 +156,13 @@ public:
     bool enableWakewordDetection();
     bool disableWakewordDetection();
 
+    /**
+     * Returns the stream the captured audio is written to, so that other consumers of the voice audio can read it
+     * with readers of their own instead of capturing it again. The number of readers is limited by the
+     * @c maxReaders of the audio buffer configuration.
+     */
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> getAudioInputStream();
+
     /// @name @c alexaClientSDK::avsCommon::sdkInterfaces::AudioInputProcessorObserverInterface functions
     /// @{
     void onStateChanged(
@@ -177,6 +212,19 @@ private:
 
     bool initializeAudioInputStream();
 
+    /**
+     * Starts the capture of a wakeword at once, and verifies the wakeword while its Recognize event is streamed.
+     * The capture is cancelled if an initiator verifier blocks the wakeword. The platform and the observers are only
+     * notified of the wakeword once it is verified.
+     */
+    void startSpeculativeWakewordCapture(
+        alexaClientSDK::avsCommon::avs::AudioInputStream::Index beginIndex,
+        alexaClientSDK::avsCommon::avs::AudioInputStream::Index endIndex,
+        const std::string& keyword);
+
+    /// Notifies the platform and the observers of a verified wakeword.
+    void notifyWakewordDetected(const std::string& keyword);
+
     /**
      * Blocks up to the specified @a duration until the @ SpeechRecognizerEngineImpl expecting audio state
      * transitions to the caller's expected state.
@@ -218,9 +266,23 @@ private:
     std::shared_ptr<alexaClientSDK::capabilityAgents::aip::AudioInputProcessor> m_audioInputProcessor;
 
     alexaClientSDK::avsCommon::utils::AudioFormat m_audioFormat;
+    AudioBufferConfig m_audioBufferConfig;
     std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> m_audioInputStream;
     std::unique_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream::Writer> m_audioInputWriter;
 
+    /**
+     * Holds back the silence from the wakeword engine while no speech is captured, if it is enabled. Only used by
+     * @c write().
+     */
+    aace::engine::audio::VoiceActivityGate::Config m_voiceActivityGateConfig;
+    std::unique_ptr<aace::engine::audio::VoiceActivityGate> m_voiceActivityGate;
+
+    /// Whether the capture of a wakeword starts before the wakeword is verified.
+    const bool m_speculativeWakewordVerification;
+
+    /// Measures the latency of the voice turns, if any.
+    std::shared_ptr<VoiceTurnMonitor> m_voiceTurnMonitor;
+
     std::shared_ptr<aace::engine::audio::AudioInputChannelInterface> m_audioInputChannel;
     /**
      * The current audio input channel ID. Access is serialized by @c m_expectingAudioMutex.
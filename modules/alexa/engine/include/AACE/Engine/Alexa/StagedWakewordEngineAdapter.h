@@ -0,0 +1,138 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_STAGED_WAKEWORD_ENGINE_ADAPTER_H
+#define AACE_ENGINE_ALEXA_STAGED_WAKEWORD_ENGINE_ADAPTER_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include "WakewordEngineAdapter.h"
+#include "WakewordPipeline.h"
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * A wakeword engine adapter which changes the locale of the wrapped adapter without a stall of the detection.
+ *
+ * The new locale is prepared in the background on a second instance of the wakeword engine, initialized with the
+ * same stream and enabled next to the active instance, which keeps detecting in the meantime. The instances are then
+ * swapped atomically: if the wakeword engine is fed by a @c WakewordPipeline, the swap happens between two batches,
+ * so both instances have been delivered the same frames and no frame falls between them. The detections of the
+ * instance that is not active are dropped, and the previous instance is released once the swap is complete.
+ *
+ * If the second instance can't be created or initialized, the locale is changed in place with
+ * @c WakewordEngineAdapter::changeLocale() of the active instance.
+ *
+ * The time during which no instance is detecting, the "deaf window", is emitted as the @c LocaleSwitchDeafWindow
+ * timer metric of each change, and the time spent preparing the new locale as the @c LocaleSwitchPreparation metric.
+ */
+class StagedWakewordEngineAdapter
+        : public WakewordEngineAdapter
+        , public std::enable_shared_from_this<StagedWakewordEngineAdapter> {
+public:
+    /// Creates a new instance of the wakeword engine, or returns @c nullptr if it can't be created.
+    using AdapterFactory = std::function<std::shared_ptr<WakewordEngineAdapter>()>;
+
+    /// Returns the pipeline reading a stream, or @c nullptr if the stream is not read by a pipeline.
+    using PipelineLookup = std::function<std::shared_ptr<WakewordPipeline>(
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream)>;
+
+    /**
+     * Creates a staged adapter.
+     *
+     * @param adapter The active instance of the wakeword engine.
+     * @param adapterFactory The factory of the instances the new locales are prepared on.
+     * @param pipelineLookup The lookup of the pipeline the instances are fed by, if any.
+     * @returns The adapter, or @c nullptr if @c adapter or @c adapterFactory is invalid.
+     */
+    static std::shared_ptr<StagedWakewordEngineAdapter> create(
+        std::shared_ptr<WakewordEngineAdapter> adapter,
+        AdapterFactory adapterFactory,
+        PipelineLookup pipelineLookup = nullptr);
+
+    /// Returns the active instance of the wakeword engine.
+    std::shared_ptr<WakewordEngineAdapter> getActiveAdapter();
+
+    /// @name WakewordEngineAdapter
+    /// @{
+    bool initialize(
+        const std::string& defaultLocale,
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream>& audioInputStream,
+        alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat) override;
+    bool enable() override;
+    bool disable() override;
+    bool prefetchLocale(const std::string& locale) override;
+    bool changeLocale(const std::string& locale) override;
+    void addKeyWordObserver(
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::KeyWordObserverInterface> keyWordObserver) override;
+    void removeKeyWordObserver(
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::KeyWordObserverInterface> keyWordObserver) override;
+    /// @}
+
+private:
+    /// Forwards the detections of an instance to the staged adapter.
+    class Router;
+
+    StagedWakewordEngineAdapter(
+        std::shared_ptr<WakewordEngineAdapter> adapter,
+        AdapterFactory adapterFactory,
+        PipelineLookup pipelineLookup);
+
+    /// Notifies the observers of a detection, if @c source is the active instance.
+    void onKeyWordDetected(
+        const WakewordEngineAdapter* source,
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+        const std::string& keyword,
+        alexaClientSDK::avsCommon::avs::AudioInputStream::Index beginIndex,
+        alexaClientSDK::avsCommon::avs::AudioInputStream::Index endIndex,
+        std::shared_ptr<const std::vector<char>> KWDMetadata);
+
+    /// Prepares the locale on a new instance, and swaps it with the active one. Returns @c false if it can't.
+    bool stageLocale(const std::string& locale);
+
+    /// Changes the locale of the active instance in place.
+    bool changeLocaleInPlace(const std::string& locale);
+
+    AdapterFactory m_adapterFactory;
+    PipelineLookup m_pipelineLookup;
+
+    // serializes the changes of locale
+    std::mutex m_changeMutex;
+
+    // serializes enabling and disabling the detection with the swap of the instances
+    std::mutex m_stateMutex;
+    bool m_enabled = false;
+
+    // guards the state below, and is never held while an instance is called
+    std::mutex m_mutex;
+    std::shared_ptr<WakewordEngineAdapter> m_activeAdapter;
+    std::shared_ptr<Router> m_activeRouter;
+    std::unordered_set<std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::KeyWordObserverInterface>> m_observers;
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> m_audioInputStream;
+    alexaClientSDK::avsCommon::utils::AudioFormat m_audioFormat;
+    bool m_initialized = false;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_STAGED_WAKEWORD_ENGINE_ADAPTER_H
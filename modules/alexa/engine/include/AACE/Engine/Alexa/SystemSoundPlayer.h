@@ -17,7 +17,9 @@
 #define AACE_ENGINE_ALEXA_SYSTEM_SOUND_PLAYER_H
 
 #include <future>
+#include <map>
 #include <memory>
+#include <vector>
 
 #include <AVSCommon/SDKInterfaces/Audio/SystemSoundAudioFactoryInterface.h>
 #include <AVSCommon/SDKInterfaces/SystemSoundPlayerInterface.h>
@@ -44,6 +46,17 @@ private:
 
     std::shared_ptr<aace::engine::audio::AudioOutputChannelInterface> getAudioChannel();
 
+    /**
+     * A system sound loaded in memory, so that the latency critical tones play without reading their resources
+     * again. A WAV sound is decoded to its PCM samples, which the audio output can play without decoding them.
+     */
+    struct SystemSound {
+        std::shared_ptr<const std::vector<char>> data;
+        aace::audio::AudioFormat format;
+    };
+
+    bool loadTone(Tone tone);
+
 public:
     static std::shared_ptr<SystemSoundPlayer> create(
         std::shared_ptr<aace::engine::audio::AudioManagerInterface> audioManager,
@@ -54,6 +67,7 @@ public:
     void onMediaStateChanged(MediaState state) override;
     void onMediaError(MediaError error, const std::string& description) override;
     void onAudioFocusEvent(FocusAction action) override;
+    void onMediaPositionChanged(int64_t position) override;
 
     // alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface
     std::shared_future<bool> playTone(Tone tone) override;
@@ -66,6 +80,9 @@ private:
     std::shared_future<bool> m_sharedFuture;
     std::promise<bool> m_playTonePromise;
     std::mutex m_mutex;
+
+    // The tones loaded in memory. A tone that can't be loaded is loaded again when it is played.
+    std::map<Tone, SystemSound> m_tones;
 };
 
 //
@@ -75,24 +92,27 @@ private:
 class SystemSoundAudioStream : public aace::audio::AudioStream {
 private:
     SystemSoundAudioStream(
-        std::shared_ptr<std::istream> stream,
-        alexaClientSDK::avsCommon::utils::MediaType mediaType,
+        std::shared_ptr<const std::vector<char>> data,
+        aace::audio::AudioFormat format,
         alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone tone);
 
 public:
     static std::shared_ptr<SystemSoundAudioStream> create(
-        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::audio::SystemSoundAudioFactoryInterface> audioFactory,
+        std::shared_ptr<const std::vector<char>> data,
+        aace::audio::AudioFormat format,
         alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone tone);
 
     // aace::audio::AudioStream
     ssize_t read(char* data, const size_t size) override;
     bool isClosed() override;
+    AudioFormat getAudioFormat() override;
     std::vector<aace::audio::AudioStreamProperty> getProperties() override;
 
 private:
-    std::shared_ptr<std::istream> m_stream;
+    std::shared_ptr<const std::vector<char>> m_data;
+    size_t m_offset;
+    aace::audio::AudioFormat m_format;
     alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone m_tone;
-    bool m_closed;
 };
 
 }  // namespace alexa
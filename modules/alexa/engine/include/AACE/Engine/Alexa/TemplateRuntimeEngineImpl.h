@@ -25,6 +25,8 @@
 #include <SmartScreenSDKInterfaces/TemplateRuntimeObserverInterface.h>
 #include <TemplateRuntimeCapabilityAgent/TemplateRuntime.h>
 
+#include <nlohmann/json.hpp>
+
 #include "AACE/Alexa/AlexaEngineInterfaces.h"
 #include "AACE/Alexa/TemplateRuntime.h"
 
@@ -40,7 +42,9 @@ class TemplateRuntimeEngineImpl
         , public alexaClientSDK::avsCommon::utils::RequiresShutdown
         , public std::enable_shared_from_this<TemplateRuntimeEngineImpl> {
 private:
-    TemplateRuntimeEngineImpl(std::shared_ptr<aace::alexa::TemplateRuntime> templateRuntimePlatformInterface);
+    TemplateRuntimeEngineImpl(
+        std::shared_ptr<aace::alexa::TemplateRuntime> templateRuntimePlatformInterface,
+        bool renderPlayerInfoDeltas);
 
     bool initialize(
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::endpoints::EndpointCapabilitiesRegistrarInterface>
@@ -62,7 +66,8 @@ public:
             renderPlayerInfoCardsProviderInterfaces,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<alexaClientSDK::avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
-        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender);
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
+        bool renderPlayerInfoDeltas = false);
 
     void setRenderPlayerInfoCardsProviderInterface(
         std::unordered_set<
@@ -87,6 +92,17 @@ public:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MediaPropertiesInterface> mediaProperties) override;
     void clearPlayerInfoCard(const std::string& token) override;
 
+    /**
+     * Creates the JSON merge patch (RFC 7386) that changes @c source into @c target.
+     *
+     * @param [in] source The previous document
+     * @param [in] target The new document
+     * @param [out] patch The merge patch
+     * @return @c false if the change can't be described by a merge patch, which is the case of a @c null value in
+     *         @c target, since a @c null value of a merge patch removes the field.
+     */
+    static bool createMergePatch(const nlohmann::json& source, const nlohmann::json& target, nlohmann::json& patch);
+
 protected:
     virtual void doShutdown() override;
 
@@ -99,6 +115,11 @@ private:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::RenderPlayerInfoCardsProviderInterface>>
         m_renderPlayerInfoCardsProviderInterfaces;
     std::mutex m_mutex;
+
+    /// Whether the changes of the player info of the same audio item are rendered as deltas
+    bool m_renderPlayerInfoDeltas;
+    /// The last player info rendered, the source of the next delta, or @c null if there is none
+    nlohmann::json m_lastPlayerInfo;
 };
 
 }  // namespace alexa
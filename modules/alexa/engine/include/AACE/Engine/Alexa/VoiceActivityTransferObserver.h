@@ -0,0 +1,58 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_VOICE_ACTIVITY_TRANSFER_OBSERVER_H
+#define AACE_ENGINE_ALEXA_VOICE_ACTIVITY_TRANSFER_OBSERVER_H
+
+#include <memory>
+
+#include <AVSCommon/SDKInterfaces/DialogUXStateObserverInterface.h>
+
+#include "AACE/Engine/Network/BackgroundTransferScheduler.h"
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * Tells the background transfer scheduler when a voice interaction is active, from the start of the listening to
+ * the end of Alexa's speech, so the deferrable transfers don't compete with the voice traffic.
+ */
+class VoiceActivityTransferObserver : public alexaClientSDK::avsCommon::sdkInterfaces::DialogUXStateObserverInterface {
+public:
+    /**
+     * Creates a voice activity transfer observer.
+     *
+     * @param backgroundTransferScheduler The scheduler told about the voice interactions.
+     * @return The observer, or @c nullptr if @c backgroundTransferScheduler is null.
+     */
+    static std::shared_ptr<VoiceActivityTransferObserver> create(
+        std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler);
+
+    // DialogUXStateObserverInterface
+    void onDialogUXStateChanged(DialogUXState newState) override;
+
+private:
+    VoiceActivityTransferObserver(
+        std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler);
+
+    std::weak_ptr<aace::engine::network::BackgroundTransferScheduler> m_backgroundTransferScheduler;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_VOICE_ACTIVITY_TRANSFER_OBSERVER_H
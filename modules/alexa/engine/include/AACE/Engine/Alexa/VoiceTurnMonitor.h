@@ -0,0 +1,189 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_VOICE_TURN_MONITOR_H
+#define AACE_ENGINE_ALEXA_VOICE_TURN_MONITOR_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <AVSCommon/SDKInterfaces/DialogUXStateObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/MessageObserverInterface.h>
+#include <AVSCommon/Utils/Timing/Timer.h>
+
+#include "AudioChannelTrace.h"
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * Measures the latency of the stages of each voice turn, and logs the breakdown of the turns whose response latency
+ * breaches the service level objective.
+ *
+ * A turn starts when a wakeword is detected or the capture starts, and is identified by the @c dialogRequestId of the
+ * first directive received after the capture started. The speech recognizer reports the wakeword, the start of the
+ * capture and the end of speech, the directives received on the connection report the first directive, and the
+ * speech synthesizer channel reports the TTS prepare and the first audio out. The turn completes when a media
+ * channel resumes or stops ducking after the turn, or when no media resumes within a timeout of the end of the
+ * dialog. The latency of each stage, measured from the previous stage of the turn, is emitted as metrics when the turn
+ * completes:
+ * - @c WakewordToCaptureStart from the wakeword detection to the start of the capture.
+ * - @c CaptureStartToEndOfSpeech from the start of the capture to the end of speech.
+ * - @c EndOfSpeechToFirstDirective from the end of speech to the first directive of the turn.
+ * - @c FirstDirectiveToTtsPrepare from the first directive to the @c prepare() of the speech synthesizer channel.
+ * - @c TtsPrepareToFirstAudioOut from the @c prepare() to the @c PLAYING state of the speech synthesizer channel.
+ * - @c DialogIdleToMediaResume from the end of the dialog to the media resuming.
+ * - @c EndOfSpeechToFirstAudioOut, the response latency the service level objective applies to.
+ */
+class VoiceTurnMonitor
+        : public alexaClientSDK::avsCommon::sdkInterfaces::MessageObserverInterface
+        , public alexaClientSDK::avsCommon::sdkInterfaces::DialogUXStateObserverInterface
+        , public AudioChannelTrace::TransitionListener {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// The stages of a turn, in the order they happen
+    enum class Stage {
+        WAKEWORD,
+        CAPTURE_STARTED,
+        END_OF_SPEECH,
+        FIRST_DIRECTIVE,
+        TTS_PREPARED,
+        FIRST_AUDIO_OUT,
+        MEDIA_RESUMED
+    };
+
+    /// The number of stages of a turn
+    static const int STAGE_COUNT = 7;
+
+    /// The default time the media may take to resume once the dialog ends
+    static const std::chrono::milliseconds DEFAULT_MEDIA_RESUME_TIMEOUT;
+
+    /// The timestamps of a turn
+    struct Turn {
+        /// The @c dialogRequestId of the turn, or an empty string if no directive of the turn was received
+        std::string dialogRequestId;
+        /// The time of each stage, or the epoch if the stage did not happen
+        Clock::time_point stages[STAGE_COUNT];
+        /// The time the dialog of the turn ended, or the epoch if it did not end
+        Clock::time_point dialogIdle;
+
+        /// Returns the time of a stage.
+        Clock::time_point get(Stage stage) const;
+
+        /// Returns @c true if the stage happened.
+        bool has(Stage stage) const;
+
+        /// Returns the latency from one stage to another, or a negative duration if one of them did not happen.
+        std::chrono::milliseconds getLatency(Stage from, Stage to) const;
+    };
+
+    /**
+     * Creates a @c VoiceTurnMonitor.
+     *
+     * @param responseLatencySlo The service level objective of the response latency, from the end of speech to the
+     *        first audio out. A zero objective disables the breach logs.
+     * @param mediaResumeTimeout The time the media may take to resume once the dialog of a turn ends.
+     * @return The @c VoiceTurnMonitor, or @c nullptr if a duration is negative.
+     */
+    static std::shared_ptr<VoiceTurnMonitor> create(
+        std::chrono::milliseconds responseLatencySlo = std::chrono::milliseconds::zero(),
+        std::chrono::milliseconds mediaResumeTimeout = DEFAULT_MEDIA_RESUME_TIMEOUT);
+
+    ~VoiceTurnMonitor();
+
+    /// Starts a turn when a wakeword is detected.
+    void onWakewordDetected();
+
+    /// Records the start of the capture, which starts a turn if it was not started by a wakeword.
+    void onCaptureStarted();
+
+    /// Records the end of speech of the turn.
+    void onEndOfSpeech();
+
+    /// Returns the last completed turn.
+    Turn getLastTurn() const;
+
+    /// Stops the media resume timeout, and drops the turn in progress.
+    void shutdown();
+
+    // MessageObserverInterface
+    void receive(const std::string& contextId, const std::string& message) override;
+
+    // DialogUXStateObserverInterface
+    void onDialogUXStateChanged(
+        alexaClientSDK::avsCommon::sdkInterfaces::DialogUXStateObserverInterface::DialogUXState newState) override;
+
+    // AudioChannelTrace::TransitionListener
+    void onChannelCall(const std::string& channel, AudioChannelTrace::Call call, Clock::time_point time) override;
+    void onChannelTransition(
+        const std::string& channel,
+        AudioChannelTrace::Transition transition,
+        Clock::time_point reported) override;
+
+private:
+    VoiceTurnMonitor(std::chrono::milliseconds responseLatencySlo, std::chrono::milliseconds mediaResumeTimeout);
+
+    /// Starts a new turn, and returns the turn it replaces if it has to be completed. Called with the lock held.
+    bool startTurn(Turn& completed);
+
+    /// Records a stage of the current turn, if it did not happen yet. Called with the lock held.
+    void recordStage(Stage stage, Clock::time_point time);
+
+    /// Completes the current turn, and returns it. Called with the lock held.
+    Turn completeTurn();
+
+    /// Completes the turn whose media did not resume in time.
+    void executeMediaResumeTimeout(uint64_t turnId);
+
+    /// Emits the metrics of a completed turn, and logs its breakdown if it breached the objective.
+    void report(const Turn& turn);
+
+    /// The service level objective of the response latency
+    const std::chrono::milliseconds m_responseLatencySlo;
+
+    /// The time the media may take to resume once the dialog ends
+    const std::chrono::milliseconds m_mediaResumeTimeout;
+
+    /// Serializes the access to the turns
+    mutable std::mutex m_mutex;
+
+    /// The turn in progress
+    Turn m_turn;
+
+    /// Whether a turn is in progress
+    bool m_turnActive = false;
+
+    /// The identifier of the turn in progress, so the timeout of a completed turn is skipped
+    uint64_t m_turnId = 0;
+
+    /// The last completed turn, whose late directives are not taken for the first directive of the next turn
+    Turn m_lastTurn;
+
+    /// Whether the monitor is shut down
+    bool m_isShutdown = false;
+
+    /// Completes the turns whose media does not resume
+    alexaClientSDK::avsCommon::utils::timing::Timer m_mediaResumeTimer;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_VOICE_TURN_MONITOR_H
@@ -28,6 +28,9 @@ namespace alexa {
  * WakewordEngineAdapter is engine interface for supporting the Wakeword Engine Integration 
  * with the Auto SDK 
  * 
+ * An adapter should open its model files with @c aace::engine::utils::memory::MappedAssetRegistry rather than read
+ * them into heap buffers, so the primary and secondary adapters, and the adapters of several Engines, share the
+ * read-only pages of the models.
  */
 class WakewordEngineAdapter {
 public:
@@ -69,6 +72,34 @@ public:
      **/
     virtual bool disable() = 0;
 
+    /**
+     * Loads the assets of a locale ahead of a change, such as mapping its model files and calling
+     * @c MappedAsset::willNeed(), without replacing the model used for detection. It is called in the background
+     * for the supported locales other than the active one.
+     *
+     * The default implementation loads nothing.
+     *
+     * @param locale The locale to prefetch.
+     * @return returns @c true on successful, otherwise @false.
+     **/
+    virtual bool prefetchLocale(const std::string& locale) {
+        return true;
+    }
+
+    /**
+     * Changes the locale of the Wakeword detection. The model of the new locale is loaded next to the active one,
+     * which keeps detecting until the new model is ready, then the models are swapped.
+     *
+     * The default implementation keeps the locale the Wakeword Engine was initialized with.
+     *
+     * @param locale The new locale, in the format of the default locale given to @c initialize: the locales of a
+     * multilingual setting are separated by '/', such as "en-US/es-US".
+     * @return returns @c true on successful, otherwise @false and the active model is kept.
+     **/
+    virtual bool changeLocale(const std::string& locale) {
+        return true;
+    }
+
     /**
      * Adds the specified observer to the list of observers to notify of key word detection events.
      *
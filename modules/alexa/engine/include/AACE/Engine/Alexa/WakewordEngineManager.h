@@ -18,9 +18,11 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include "WakewordEngineAdapter.h"
+#include "WakewordPipeline.h"
 
 namespace aace {
 namespace engine {
@@ -57,8 +59,41 @@ public:
      */
     std::shared_ptr<WakewordEngineAdapter> createAdapter(const AdapterType& type, const std::string& name = "");
 
+    /**
+     * Get the @c WakewordPipeline reading an audio input stream
+     *
+     * The wake-word engines initialized with the same stream share the pipeline, and its single reader, by adding
+     * themselves as consumers of its frames. The pipeline is created by the first engine, with its configuration,
+     * and it is kept as long as one of the engines holds it.
+     *
+     * @param stream The stream of audio data the wake-word engine was initialized with
+     * @param audioFormat The format of the audio data located within the stream
+     * @param config The configuration of the pipeline, if it is created
+     *
+     * @return returns the pipeline reading @c stream, or @c nullptr if it can't be created.
+     *
+     */
+    std::shared_ptr<WakewordPipeline> getPipeline(
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+        const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat,
+        const WakewordPipeline::Config& config = WakewordPipeline::Config());
+
+    /**
+     * Find the @c WakewordPipeline reading an audio input stream, without creating it
+     *
+     * @param stream The stream of audio data the wake-word engine was initialized with
+     *
+     * @return returns the pipeline reading @c stream, or @c nullptr if no wake-word engine holds one.
+     *
+     */
+    std::shared_ptr<WakewordPipeline> findPipeline(
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream);
+
 private:
     std::unordered_map<std::string, WakewordEngineAdapterFactory> m_factoryMap;
+
+    std::mutex m_pipelinesMutex;
+    std::unordered_map<alexaClientSDK::avsCommon::avs::AudioInputStream*, std::weak_ptr<WakewordPipeline>> m_pipelines;
 };
 
 }  // namespace alexa
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_ALEXA_WAKEWORD_PIPELINE_H
+#define AACE_ENGINE_ALEXA_WAKEWORD_PIPELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/**
+ * A batch of consecutive audio frames delivered by a @c WakewordPipeline.
+ */
+struct WakewordFrameBatch {
+    /// The index in the stream of the first sample of the batch.
+    alexaClientSDK::avsCommon::avs::AudioInputStream::Index beginIndex = 0;
+    /// The number of samples of a frame.
+    size_t frameSize = 0;
+    /// The number of frames of the batch.
+    size_t frameCount = 0;
+    /// The samples of the frames, @c frameCount * @c frameSize samples.
+    std::vector<int16_t> samples;
+    /// The level of each frame in dBFS.
+    std::vector<float> levels;
+    /// Whether voice activity is detected in each frame. All the frames are active if the VAD is disabled.
+    std::vector<bool> voiceActivity;
+    /// The number of features of a frame, or 0 if no features are computed.
+    size_t featureSize = 0;
+    /// The features of the frames, @c frameCount * @c featureSize values.
+    std::vector<float> features;
+};
+
+/**
+ * WakewordFrameConsumer is implemented by the wakeword engine adapters that are fed by a @c WakewordPipeline instead
+ * of reading the audio input stream themselves.
+ */
+class WakewordFrameConsumer {
+public:
+    virtual ~WakewordFrameConsumer() = default;
+
+    /**
+     * Called on the pipeline thread with the next batch of frames. The batch is only valid during the call, and
+     * the consumer should return quickly, since the consumers of a pipeline are called one after the other.
+     */
+    virtual void onFrames(const WakewordFrameBatch& batch) = 0;
+};
+
+/**
+ * WakewordPipeline is the shared front-end of the wakeword engines reading the same audio input stream.
+ *
+ * The pipeline reads the stream with a single reader, splits the audio into frames, measures the level of each
+ * frame for voice activity detection, optionally computes the features of each frame, and delivers the frames to
+ * all its consumers in batches. The consumers don't need a reader or a thread of their own, the framing and the
+ * features are computed once for all of them, and they are called once per batch rather than once per write.
+ */
+class WakewordPipeline {
+public:
+    /**
+     * Computes the features of a frame, such as its filterbank energies.
+     *
+     * @param frame The samples of the frame.
+     * @param frameSize The number of samples of the frame.
+     * @param features The @c featureSize features of the frame to compute.
+     */
+    using FeatureExtractor = std::function<void(const int16_t* frame, size_t frameSize, float* features)>;
+
+    struct Config {
+        /// Creates the default configuration, with batches of 5 frames of 10 ms, and no VAD or features.
+        Config();
+
+        /// The duration of a frame.
+        std::chrono::milliseconds frameDuration;
+        /// The number of frames delivered at once.
+        size_t framesPerBatch;
+        /// Whether the frames under @c vadThreshold are flagged as inactive.
+        bool vadEnabled;
+        /// The level in dBFS above which a frame has voice activity.
+        float vadThreshold;
+        /// The function computing the features of each frame, if any.
+        FeatureExtractor featureExtractor;
+        /// The number of features computed for a frame.
+        size_t featureSize;
+    };
+
+    ~WakewordPipeline();
+
+    /**
+     * Creates a pipeline reading @c stream, and starts reading the new audio written to the stream.
+     *
+     * @param stream The stream of 16-bit mono LPCM samples.
+     * @param audioFormat The format of the audio of the stream.
+     * @param config The configuration of the pipeline.
+     */
+    static std::shared_ptr<WakewordPipeline> create(
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+        const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat,
+        const Config& config = Config());
+
+    /// Adds a consumer of the frames. Returns @c false if the consumer was already added.
+    bool addConsumer(std::shared_ptr<WakewordFrameConsumer> consumer);
+
+    /**
+     * Removes a consumer of the frames. The consumer is not called once this function returns, so it must not be
+     * called from @c WakewordFrameConsumer::onFrames().
+     */
+    bool removeConsumer(std::shared_ptr<WakewordFrameConsumer> consumer);
+
+    /**
+     * Runs a task between two batches, so all the consumers have been delivered the same frames when it runs. The
+     * task is run on the calling thread with the consumers locked, so it must be short, and it must not add or remove
+     * consumers, or be called from @c WakewordFrameConsumer::onFrames().
+     */
+    void runBetweenBatches(const std::function<void()>& task);
+
+    /// Returns the stream read by the pipeline.
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> getStream() const;
+
+    /// Stops reading the stream.
+    void shutdown();
+
+private:
+    WakewordPipeline(
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+        size_t frameSize,
+        const Config& config);
+
+    void readLoop();
+    void processFrame(const int16_t* frame);
+    void deliverBatch();
+    void resetBatch();
+
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> m_stream;
+    std::unique_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream::Reader> m_reader;
+    const size_t m_frameSize;
+    const Config m_config;
+
+    // the batch in progress, only used by the pipeline thread
+    WakewordFrameBatch m_batch;
+
+    std::mutex m_consumersMutex;
+    std::vector<std::shared_ptr<WakewordFrameConsumer>> m_consumers;
+
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_ALEXA_WAKEWORD_PIPELINE_H
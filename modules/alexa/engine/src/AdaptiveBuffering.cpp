@@ -0,0 +1,143 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AACE/Engine/Alexa/AdaptiveBuffering.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.AdaptiveBuffering");
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "AdaptiveBuffering";
+
+const std::string AdaptiveBuffering::DEFAULT_NETWORK_TYPE = "default";
+
+std::shared_ptr<AdaptiveBuffering> AdaptiveBuffering::create(const Config& config) {
+    try {
+        ThrowIf(config.minPrebuffer.count() < 0, "invalidMinPrebuffer");
+        ThrowIf(config.maxPrebuffer < config.minPrebuffer, "invalidMaxPrebuffer");
+        ThrowIf(config.smoothing <= 0 || config.smoothing > 1, "invalidSmoothing");
+
+        return std::shared_ptr<AdaptiveBuffering>(new AdaptiveBuffering(config));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+AdaptiveBuffering::AdaptiveBuffering(const Config& config) : m_config(config), m_networkType(DEFAULT_NETWORK_TYPE) {
+}
+
+void AdaptiveBuffering::setNetworkType(const std::string& networkType) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_networkType = networkType.empty() ? DEFAULT_NETWORK_TYPE : networkType;
+}
+
+void AdaptiveBuffering::onPlaybackStarted(const std::string& channel, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // a resumed playback keeps the underruns and the network type of its start
+    if (m_playbacks.find(channel) == m_playbacks.end()) {
+        m_playbacks[channel].networkType = m_networkType;
+    }
+}
+
+void AdaptiveBuffering::onBufferUnderrun(const std::string& channel, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_playbacks.find(channel);
+    if (it == m_playbacks.end()) {
+        it = m_playbacks.emplace(channel, Playback()).first;
+        it->second.networkType = m_networkType;
+    }
+    auto& playback = it->second;
+    if (!playback.underrun) {
+        playback.underrun = true;
+        playback.underruns++;
+        playback.underrunTime = now;
+    }
+}
+
+void AdaptiveBuffering::onBufferRefilled(const std::string& channel, Clock::time_point now) {
+    std::string networkType;
+    std::chrono::milliseconds duration;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_playbacks.find(channel);
+        if (it == m_playbacks.end() || !it->second.underrun) {
+            return;
+        }
+        networkType = it->second.networkType;
+        duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second.underrunTime);
+        endUnderrun(it->second, now);
+    }
+
+    AACE_DEBUG(LX(TAG).d("channel", channel).d("networkType", networkType).d("duration", duration.count()));
+    aace::engine::utils::metrics::emitMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX,
+        "onBufferRefilled",
+        {{"BufferUnderrun", 1}},
+        {{"Channel", channel}, {"NetworkType", networkType}},
+        {{"UnderrunDuration", static_cast<double>(duration.count())}});
+}
+
+void AdaptiveBuffering::onPlaybackEnded(const std::string& channel, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_playbacks.find(channel);
+    if (it == m_playbacks.end()) {
+        return;
+    }
+    auto& playback = it->second;
+    endUnderrun(playback, now);
+
+    auto& statistics = m_statistics[std::make_pair(channel, playback.networkType)];
+    auto smoothing = m_config.smoothing;
+    statistics.underrunsPerPlayback =
+        (1 - smoothing) * statistics.underrunsPerPlayback + smoothing * playback.underruns;
+    if (playback.underruns > 0) {
+        // the duration only averages the playbacks with underruns, and starts from the first one
+        auto duration = static_cast<double>(playback.stalled.count()) / playback.underruns;
+        statistics.underrunDuration = statistics.underrunDuration > 0
+                                          ? (1 - smoothing) * statistics.underrunDuration + smoothing * duration
+                                          : duration;
+    }
+    m_playbacks.erase(it);
+}
+
+std::chrono::milliseconds AdaptiveBuffering::getPrebufferTarget(const std::string& channel) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_statistics.find(std::make_pair(channel, m_networkType));
+    if (it == m_statistics.end()) {
+        return m_config.minPrebuffer;
+    }
+    auto expectedStall = static_cast<int64_t>(it->second.underrunsPerPlayback * it->second.underrunDuration);
+    return std::min(m_config.maxPrebuffer, m_config.minPrebuffer + std::chrono::milliseconds(expectedStall));
+}
+
+void AdaptiveBuffering::endUnderrun(Playback& playback, Clock::time_point now) {
+    if (playback.underrun) {
+        playback.stalled += std::chrono::duration_cast<std::chrono::milliseconds>(now - playback.underrunTime);
+        playback.underrun = false;
+    }
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
@@ -34,7 +34,6 @@
 #include <AVSCommon/SDKInterfaces/Endpoints/EndpointCapabilitiesRegistrarInterface.h>
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
 #include <AVSCommon/Utils/LibcurlUtils/LibcurlHTTP2ConnectionFactory.h>
-#include <AVSCommon/Utils/LibcurlUtils/HttpPut.h>
 #include <AVSGatewayManager/Storage/AVSGatewayManagerStorage.h>
 #include <CapabilitiesDelegate/Storage/SQLiteCapabilitiesDelegateStorage.h>
 #include <CertifiedSender/SQLiteMessageStorage.h>
@@ -42,7 +41,6 @@
 #include <Endpoints/EndpointBuilder.h>
 #include <InterruptModel/InterruptModel.h>
 #include <PlaybackController/PlaybackRouter.h>
-#include <SpeechEncoder/OpusEncoderContext.h>
 #include <SQLiteStorage/SQLiteMiscStorage.h>
 #include <SynchronizeStateSender/SynchronizeStateSenderFactory.h>
 #include <System/LocaleHandler.h>
@@ -56,20 +54,24 @@
 #include <AACE/Alexa/AlexaProperties.h>
 #include <AACE/Core/CoreProperties.h>
 #include <AACE/Engine/Alexa/AlexaEngineService.h>
+#include <AACE/Engine/Alexa/HttpClientPool.h>
 #include <AACE/Engine/Alexa/AlexaAuthorizationProvider.h>
 #include <AACE/Engine/Alexa/AuthorizationManagerStorage.h>
 #include <AACE/Engine/Alexa/VehicleData.h>
 #include <AACE/Engine/Alexa/WakewordObservableInterface.h>
 #include <AACE/Engine/Alexa/InitiatorVerifier.h>
+#include <AACE/Engine/Alexa/StagedWakewordEngineAdapter.h>
 #include <AACE/Engine/Authorization/AuthorizationServiceInterface.h>
 #include <AACE/Engine/Core/EngineMacros.h>
 #include <AACE/Engine/Network/NetworkObservableInterface.h>
 #include <AACE/Engine/Utils/JSON/JSON.h>
 #include <AACE/Engine/Utils/String/StringUtils.h>
 #include <AACE/Engine/Utils/Metrics/Metrics.h>
+#include <AACE/Engine/Utils/Trace/BootTrace.h>
 #include <AACE/Vehicle/VehicleProperties.h>
 #include <AACE/Engine/Vehicle/VehiclePropertyInterface.h>
 #include <AACE/Engine/Alexa/AudioDuckingConfig.h>
+#include <AACE/Engine/Alexa/AudioChannelTrace.h>
 #include <AACE/Engine/Alexa/AlexaMetricSink.h>
 
 namespace aace {
@@ -110,6 +112,9 @@ static const std::string SERVICE_NAME_AUTH_PROVIDER = "alexa:auth-provider";
 /// Program Name for Metrics
 static const std::string METRIC_PROGRAM_NAME_SUFFIX = "AlexaEngineService";
 
+/// Whether the Alexa Client SDK is initialized by the Alexa service of an engine of the process
+static std::atomic<bool> s_deviceSDKInitialized{false};
+
 /// Default timeout for clearing the RenderTemplate display card when SpeechSynthesizer is in FINISHED state.
 static const std::chrono::milliseconds DEFAULT_TTS_FINISHED_TIMEOUT_MS{8000};
 
@@ -127,7 +132,8 @@ AlexaEngineService::AlexaEngineService(const aace::engine::core::ServiceDescript
         m_authState(AuthObserverInterface::State::UNINITIALIZED),
         m_configured(false),
         m_previouslyStarted(false),
-        m_encoderEnabled(false),
+        m_encoderEnabled(true),
+        m_encoderName("opus"),
         m_networkStatus(NetworkInfoObserver::NetworkStatus::UNKNOWN),
         m_externalMediaPlayerAgent(""),
         m_speakerManagerEnabled(true),
@@ -175,13 +181,15 @@ bool AlexaEngineService::registerProperties() {
                 std::placeholders::_2,
                 std::placeholders::_3,
                 std::placeholders::_4),
-            std::bind(&AlexaEngineService::getProperty_firmwareVersion, this)));
+            std::bind(&AlexaEngineService::getProperty_firmwareVersion, this),
+            true));
 
         // Register property - WAKEWORD_SUPPORTED
         propertyManager->registerProperty(aace::engine::propertyManager::PropertyDescription(
             aace::alexa::property::WAKEWORD_SUPPORTED,
             nullptr,
-            std::bind(&AlexaEngineService::getProperty_wakewordSupported, this)));
+            std::bind(&AlexaEngineService::getProperty_wakewordSupported, this),
+            true));
 
         // Register property - LOCALE
         propertyManager->registerProperty(aace::engine::propertyManager::PropertyDescription(
@@ -193,7 +201,8 @@ bool AlexaEngineService::registerProperties() {
                 std::placeholders::_2,
                 std::placeholders::_3,
                 std::placeholders::_4),
-            std::bind(&AlexaEngineService::getProperty_locale, this)));
+            std::bind(&AlexaEngineService::getProperty_locale, this),
+            true));
 
         // Register property - WAKEWORD_ENABLED
         propertyManager->registerProperty(aace::engine::propertyManager::PropertyDescription(
@@ -217,7 +226,8 @@ bool AlexaEngineService::registerProperties() {
                 std::placeholders::_2,
                 std::placeholders::_3,
                 std::placeholders::_4),
-            std::bind(&AlexaEngineService::getProperty_timezone, this)));
+            std::bind(&AlexaEngineService::getProperty_timezone, this),
+            true));
 
         return true;
     } catch (std::exception& ex) {
@@ -228,10 +238,17 @@ bool AlexaEngineService::registerProperties() {
 
 bool AlexaEngineService::configureDeviceSDK(std::shared_ptr<std::istream> configuration) {
     try {
+        aace::engine::utils::trace::BootTrace::Scope traceScope("configureDeviceSDK", "aace.alexa");
+
         // configure static interrupt model with audio ducking off
         std::shared_ptr<std::istream> duckingConfigStream =
             aace::engine::alexa::AudioDuckingConfig::getConfig(m_duckingEnabled);
 
+        // the configuration and the singletons of the Alexa Client SDK are process-wide, so the Alexa service of only
+        // one engine of the process is configured at a time
+        ThrowIf(s_deviceSDKInitialized.exchange(true), "alexaServiceOfAnotherEngineConfigured");
+        m_deviceSDKInitialized = true;
+
         // Initialize the Alexa Client SDK
         ThrowIfNot(
             alexaClientSDK::avsCommon::avs::initialization::AlexaClientSDKInit::initialize(
@@ -415,24 +432,138 @@ bool AlexaEngineService::configure(std::shared_ptr<std::istream> configuration)
             if (speakerManager.HasMember("enabled") && speakerManager["enabled"].IsBool()) {
                 m_speakerManagerEnabled = speakerManager["enabled"].GetBool();
             }
+
+            if (speakerManager.HasMember("volumeReportDelayInMilliseconds") &&
+                speakerManager["volumeReportDelayInMilliseconds"].IsUint()) {
+                m_volumeReportDelay =
+                    std::chrono::milliseconds(speakerManager["volumeReportDelayInMilliseconds"].GetUint());
+            }
+        }
+
+        if (alexaConfigRoot.HasMember("equalizer") && alexaConfigRoot["equalizer"].IsObject()) {
+            auto equalizer = alexaConfigRoot["equalizer"].GetObject();
+
+            if (equalizer.HasMember("bandLevelReportDelayInMilliseconds") &&
+                equalizer["bandLevelReportDelayInMilliseconds"].IsUint()) {
+                m_bandLevelReportDelay =
+                    std::chrono::milliseconds(equalizer["bandLevelReportDelayInMilliseconds"].GetUint());
+            }
+        }
+
+        if (alexaConfigRoot.HasMember("playbackController") && alexaConfigRoot["playbackController"].IsObject()) {
+            auto playbackController = alexaConfigRoot["playbackController"].GetObject();
+
+            if (playbackController.HasMember("buttonCoalescingWindowInMilliseconds") &&
+                playbackController["buttonCoalescingWindowInMilliseconds"].IsUint()) {
+                m_buttonCoalescingWindow =
+                    std::chrono::milliseconds(playbackController["buttonCoalescingWindowInMilliseconds"].GetUint());
+            }
+        }
+
+        if (alexaConfigRoot.HasMember("audioOutput") && alexaConfigRoot["audioOutput"].IsObject()) {
+            auto audioOutput = alexaConfigRoot["audioOutput"].GetObject();
+
+            if (audioOutput.HasMember("readAheadSize") && audioOutput["readAheadSize"].IsUint()) {
+                m_audioOutputReadAheadSize = audioOutput["readAheadSize"].GetUint();
+            }
+
+            if (audioOutput.HasMember("adaptiveBuffering") && audioOutput["adaptiveBuffering"].IsObject()) {
+                auto adaptiveBuffering = audioOutput["adaptiveBuffering"].GetObject();
+                AdaptiveBuffering::Config config;
+
+                if (adaptiveBuffering.HasMember("minPrebufferInMilliseconds") &&
+                    adaptiveBuffering["minPrebufferInMilliseconds"].IsUint()) {
+                    config.minPrebuffer =
+                        std::chrono::milliseconds(adaptiveBuffering["minPrebufferInMilliseconds"].GetUint());
+                }
+                if (adaptiveBuffering.HasMember("maxPrebufferInMilliseconds") &&
+                    adaptiveBuffering["maxPrebufferInMilliseconds"].IsUint()) {
+                    config.maxPrebuffer =
+                        std::chrono::milliseconds(adaptiveBuffering["maxPrebufferInMilliseconds"].GetUint());
+                }
+                if (adaptiveBuffering.HasMember("enabled") && adaptiveBuffering["enabled"].IsBool() &&
+                    adaptiveBuffering["enabled"].GetBool()) {
+                    m_adaptiveBuffering = AdaptiveBuffering::create(config);
+                    ThrowIfNull(m_adaptiveBuffering, "invalidAdaptiveBuffering");
+                    m_adaptiveBuffering->setNetworkType(
+                        alexaClientSDK::avsCommon::utils::libcurlUtils::CurlEasyHandleWrapper::getInterfaceName());
+                }
+            }
         }
 
         if (alexaConfigRoot.HasMember("speechRecognizer") && alexaConfigRoot["speechRecognizer"].IsObject()) {
             auto speechRecognizer = alexaConfigRoot["speechRecognizer"].GetObject();
 
+            // the speech is encoded with Opus unless the encoder is disabled
             if (speechRecognizer.HasMember("encoder") && speechRecognizer["encoder"].IsObject()) {
                 auto encoder = speechRecognizer["encoder"].GetObject();
 
-                ThrowIfNot(encoder.HasMember("name") && encoder["name"].IsString(), "encoderNameNotSpecified");
-                std::string name = encoder["name"].GetString();
+                if (encoder.HasMember("enabled")) {
+                    ThrowIfNot(encoder["enabled"].IsBool(), "invalidEncoderEnabled");
+                    m_encoderEnabled = encoder["enabled"].GetBool();
+                }
+
+                if (encoder.HasMember("name")) {
+                    ThrowIfNot(encoder["name"].IsString(), "invalidEncoderName");
+                    std::string name = encoder["name"].GetString();
 
-                // convert the name to lower case
-                std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) -> unsigned char {
-                    return static_cast<unsigned char>(std::tolower(c));
-                });
+                    // convert the name to lower case
+                    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) -> unsigned char {
+                        return static_cast<unsigned char>(std::tolower(c));
+                    });
+
+                    m_encoderName = name;
+                }
 
-                m_encoderName = name;
-                m_encoderEnabled = true;
+                if (encoder.HasMember("bitrate")) {
+                    ThrowIfNot(encoder["bitrate"].IsInt(), "invalidEncoderBitrate");
+                    m_encoderConfig.bitrate = encoder["bitrate"].GetInt();
+                }
+                if (encoder.HasMember("complexity")) {
+                    ThrowIfNot(encoder["complexity"].IsInt(), "invalidEncoderComplexity");
+                    m_encoderConfig.complexity = encoder["complexity"].GetInt();
+                }
+                if (encoder.HasMember("nice")) {
+                    ThrowIfNot(encoder["nice"].IsInt(), "invalidEncoderNice");
+                    m_encoderConfig.nice = encoder["nice"].GetInt();
+                }
+            }
+
+            if (speechRecognizer.HasMember("audioBuffer") && speechRecognizer["audioBuffer"].IsObject()) {
+                auto audioBuffer = speechRecognizer["audioBuffer"].GetObject();
+
+                if (audioBuffer.HasMember("duration") && audioBuffer["duration"].IsUint()) {
+                    m_audioBufferConfig.duration = std::chrono::milliseconds(audioBuffer["duration"].GetUint());
+                }
+                if (audioBuffer.HasMember("maxReaders") && audioBuffer["maxReaders"].IsUint()) {
+                    m_audioBufferConfig.maxReaders = audioBuffer["maxReaders"].GetUint();
+                }
+            }
+
+            if (speechRecognizer.HasMember("voiceActivityGate") && speechRecognizer["voiceActivityGate"].IsObject()) {
+                auto gate = speechRecognizer["voiceActivityGate"].GetObject();
+
+                if (gate.HasMember("enabled") && gate["enabled"].IsBool()) {
+                    m_voiceActivityGateConfig.enabled = gate["enabled"].GetBool();
+                }
+                if (gate.HasMember("threshold") && gate["threshold"].IsNumber()) {
+                    m_voiceActivityGateConfig.threshold = gate["threshold"].GetFloat();
+                }
+                if (gate.HasMember("preRoll") && gate["preRoll"].IsUint()) {
+                    m_voiceActivityGateConfig.preRoll = std::chrono::milliseconds(gate["preRoll"].GetUint());
+                }
+                if (gate.HasMember("hangover") && gate["hangover"].IsUint()) {
+                    m_voiceActivityGateConfig.hangover = std::chrono::milliseconds(gate["hangover"].GetUint());
+                }
+            }
+
+            if (speechRecognizer.HasMember("speculativeWakewordVerification") &&
+                speechRecognizer["speculativeWakewordVerification"].IsBool()) {
+                m_speculativeWakewordVerification = speechRecognizer["speculativeWakewordVerification"].GetBool();
+            }
+
+            if (speechRecognizer.HasMember("stagedLocaleSwitch") && speechRecognizer["stagedLocaleSwitch"].IsBool()) {
+                m_stagedLocaleSwitch = speechRecognizer["stagedLocaleSwitch"].GetBool();
             }
         }
 
@@ -456,12 +587,77 @@ bool AlexaEngineService::configure(std::shared_ptr<std::istream> configuration)
             }
         }
 
+        if (alexaConfigRoot.HasMember("featureDiscovery") && alexaConfigRoot["featureDiscovery"].IsObject()) {
+            auto featureDiscovery = alexaConfigRoot["featureDiscovery"].GetObject();
+
+            if (featureDiscovery.HasMember("cacheTimeToLiveInSeconds") &&
+                featureDiscovery["cacheTimeToLiveInSeconds"].IsUint()) {
+                m_featureDiscoveryCacheTimeToLive =
+                    std::chrono::seconds(featureDiscovery["cacheTimeToLiveInSeconds"].GetUint());
+            }
+        }
+
+        if (alexaConfigRoot.HasMember("templateRuntimeCapabilityAgent") &&
+            alexaConfigRoot["templateRuntimeCapabilityAgent"].IsObject()) {
+            auto templateRuntime = alexaConfigRoot["templateRuntimeCapabilityAgent"].GetObject();
+
+            if (templateRuntime.HasMember("renderPlayerInfoDeltas") &&
+                templateRuntime["renderPlayerInfoDeltas"].IsBool()) {
+                m_renderPlayerInfoDeltas = templateRuntime["renderPlayerInfoDeltas"].GetBool();
+            }
+        }
+
         if (alexaConfigRoot.HasMember("externalMediaPlayer") && alexaConfigRoot["externalMediaPlayer"].IsObject()) {
             auto externalMediaPlayer = alexaConfigRoot["externalMediaPlayer"].GetObject();
 
             if (externalMediaPlayer.HasMember("agent") && externalMediaPlayer["agent"].IsString()) {
                 m_externalMediaPlayerAgent = externalMediaPlayer["agent"].GetString();
             }
+
+            if (externalMediaPlayer.HasMember("eventBatchWindowInMilliseconds") &&
+                externalMediaPlayer["eventBatchWindowInMilliseconds"].IsUint()) {
+                m_externalMediaPlayerEventBatchWindow =
+                    std::chrono::milliseconds(externalMediaPlayer["eventBatchWindowInMilliseconds"].GetUint());
+            }
+
+            if (externalMediaPlayer.HasMember("discoveryReportWindowInMilliseconds") &&
+                externalMediaPlayer["discoveryReportWindowInMilliseconds"].IsUint()) {
+                m_externalMediaPlayerDiscoveryReportWindow =
+                    std::chrono::milliseconds(externalMediaPlayer["discoveryReportWindowInMilliseconds"].GetUint());
+            }
+
+            if (externalMediaPlayer.HasMember("restoreDiscoveredPlayerAuthorizations") &&
+                externalMediaPlayer["restoreDiscoveredPlayerAuthorizations"].IsBool()) {
+                m_restoreDiscoveredPlayerAuthorizations =
+                    externalMediaPlayer["restoreDiscoveredPlayerAuthorizations"].GetBool();
+            }
+        }
+
+        if (alexaConfigRoot.HasMember("audioChannelTrace") && alexaConfigRoot["audioChannelTrace"].IsObject()) {
+            auto audioChannelTrace = alexaConfigRoot["audioChannelTrace"].GetObject();
+
+            if (audioChannelTrace.HasMember("enabled") && audioChannelTrace["enabled"].IsBool() &&
+                audioChannelTrace["enabled"].GetBool()) {
+                aace::engine::alexa::AudioChannelTrace::start();
+            }
+            if (audioChannelTrace.HasMember("file") && audioChannelTrace["file"].IsString()) {
+                m_audioChannelTraceFile = audioChannelTrace["file"].GetString();
+            }
+        }
+
+        if (alexaConfigRoot.HasMember("voiceTurnMonitor") && alexaConfigRoot["voiceTurnMonitor"].IsObject()) {
+            auto voiceTurnMonitor = alexaConfigRoot["voiceTurnMonitor"].GetObject();
+
+            if (voiceTurnMonitor.HasMember("responseLatencySloInMilliseconds") &&
+                voiceTurnMonitor["responseLatencySloInMilliseconds"].IsUint()) {
+                m_voiceTurnResponseLatencySlo =
+                    std::chrono::milliseconds(voiceTurnMonitor["responseLatencySloInMilliseconds"].GetUint());
+            }
+            if (voiceTurnMonitor.HasMember("mediaResumeTimeoutInMilliseconds") &&
+                voiceTurnMonitor["mediaResumeTimeoutInMilliseconds"].IsUint()) {
+                m_voiceTurnMediaResumeTimeout =
+                    std::chrono::milliseconds(voiceTurnMonitor["mediaResumeTimeoutInMilliseconds"].GetUint());
+            }
         }
 
         if (alexaConfigRoot.HasMember("wakewordEngine") && alexaConfigRoot["wakewordEngine"].IsString()) {
@@ -901,6 +1097,22 @@ bool AlexaEngineService::preRegister() {
         ThrowIfNull(m_dialogUXStateAggregator, "createDialogUXStateAggregatorFailed");
         m_connectionManager->addConnectionStatusObserver(m_dialogUXStateAggregator);
 
+        // the deferrable network transfers wait for the end of the voice interactions
+        auto backgroundTransferScheduler =
+            getContext()->getServiceInterface<aace::engine::network::BackgroundTransferScheduler>("aace.network");
+        if (backgroundTransferScheduler != nullptr) {
+            m_voiceActivityTransferObserver = VoiceActivityTransferObserver::create(backgroundTransferScheduler);
+            ThrowIfNull(m_voiceActivityTransferObserver, "createVoiceActivityTransferObserverFailed");
+            m_dialogUXStateAggregator->addObserver(m_voiceActivityTransferObserver);
+        }
+
+        // Create the voice turn monitor - Measures the latency of the stages of the voice turns
+        m_voiceTurnMonitor = VoiceTurnMonitor::create(m_voiceTurnResponseLatencySlo, m_voiceTurnMediaResumeTimeout);
+        ThrowIfNull(m_voiceTurnMonitor, "createVoiceTurnMonitorFailed");
+        m_connectionManager->addMessageObserver(m_voiceTurnMonitor);
+        m_dialogUXStateAggregator->addObserver(m_voiceTurnMonitor);
+        AudioChannelTrace::addTransitionListener(m_voiceTurnMonitor);
+
         // Create the speaker manager - Implements the Speaker capability agent and manages Speakers of multiple types.
         // We create the speaker manager with empty speaker list and add them later when registered by the platform
         m_speakerManager = alexaClientSDK::capabilityAgents::speakerManager::SpeakerManager::create(
@@ -946,6 +1158,11 @@ bool AlexaEngineService::preRegister() {
         m_authorizationManager->addAuthObserver(m_clientObserver);
         m_connectionManager->addConnectionStatusObserver(m_clientObserver);
 
+        // Create the connection warmup - Resolves the endpoints and times the connection when the network is back
+        m_connectionWarmup = ConnectionWarmup::create();
+        ThrowIfNull(m_connectionWarmup, "createConnectionWarmupFailed");
+        m_connectionManager->addConnectionStatusObserver(m_connectionWarmup);
+
         // Create the endpoint builder factory
         m_endpointBuilderFactory =
             EndpointBuilderFactory::create(m_deviceInfo, m_contextManager, m_exceptionSender, m_alexaMessageSender);
@@ -993,6 +1210,9 @@ bool AlexaEngineService::setup() {
     try {
         ThrowIfNot(m_configured, "alexaServiceNotConfigured");
 
+        // the requests of a previous engine may have been cancelled when it shut down
+        HttpClientPool::getInstance()->setCancelled(false);
+
         // create the locale handler
         auto localeHandler = alexaClientSDK::capabilityAgents::system::LocaleHandler::create(
             m_exceptionSender,
@@ -1170,10 +1390,62 @@ bool AlexaEngineService::stop() {
     }
 }
 
+bool AlexaEngineService::suspend() {
+    try {
+        // the connection is closed, but the authorization and the capabilities are kept, so the connection is
+        // established again on resume without authorizing and publishing the capabilities again
+        std::unique_lock<std::mutex> lock(m_connectionMutex);
+        m_suspended = true;
+        lock.unlock();
+        m_connectionWarmup->onNetworkDisconnected();
+        ThrowIfNot(disconnect(), "disconnectFailed");
+
+        // the idle pooled connections would not survive the suspend of the device
+        HttpClientPool::getInstance()->clear();
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "suspend").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool AlexaEngineService::resume() {
+    try {
+        std::unique_lock<std::mutex> lock(m_connectionMutex);
+        m_suspended = false;
+        lock.unlock();
+
+        // the connection is enabled right away if the network is still connected and the token is still refreshed
+        if (m_networkStatus == NetworkInfoObserver::NetworkStatus::CONNECTED) {
+            m_connectionWarmup->onNetworkConnected({getAVSGateway(), getLWAEndpoint()});
+        }
+        ThrowIfNot(connect(), "connectFailed");
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "resume").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool AlexaEngineService::prepareShutdown() {
+    // the pooled clients are used by the REST agents of all the services, which would otherwise wait for their
+    // requests and retries while shutting down
+    HttpClientPool::getInstance()->setCancelled(true);
+    return true;
+}
+
 bool AlexaEngineService::shutdown() {
     try {
         m_isShuttingDown = true;
 
+        // export the trace before the channels are stopped by the shutdown
+        if (!m_audioChannelTraceFile.empty() && aace::engine::alexa::AudioChannelTrace::isRecording()) {
+            aace::engine::alexa::AudioChannelTrace::stop();
+            aace::engine::alexa::AudioChannelTrace::exportTrace(m_audioChannelTraceFile);
+        }
+
         if (m_alexaAuthorizationProvider != nullptr) {
             AACE_DEBUG(LX(TAG, "shutdown").m("AuthorizationProvider"));
             m_alexaAuthorizationProvider->shutdown();
@@ -1199,6 +1471,19 @@ bool AlexaEngineService::shutdown() {
             m_connectionManager->removeConnectionStatusObserver(m_alexaClientEngineImpl);
             m_connectionManager->removeConnectionStatusObserver(m_dialogUXStateAggregator);
             m_connectionManager->removeConnectionStatusObserver(m_mediaPlaybackRequestorEngineImpl);
+            m_connectionManager->removeConnectionStatusObserver(m_connectionWarmup);
+            m_connectionManager->removeMessageObserver(m_voiceTurnMonitor);
+        }
+
+        if (m_voiceTurnMonitor != nullptr) {
+            AACE_DEBUG(LX(TAG, "shutdown").m("VoiceTurnMonitor"));
+            AudioChannelTrace::removeTransitionListener(m_voiceTurnMonitor);
+            m_voiceTurnMonitor->shutdown();
+        }
+
+        if (m_connectionWarmup != nullptr) {
+            AACE_DEBUG(LX(TAG, "shutdown").m("ConnectionWarmup"));
+            m_connectionWarmup->shutdown();
         }
 
         if (m_directiveSequencer != nullptr) {
@@ -1214,6 +1499,11 @@ bool AlexaEngineService::shutdown() {
 
         if (m_dialogUXStateAggregator != nullptr) {
             m_dialogUXStateAggregator->removeObserver(m_alexaClientEngineImpl);
+            if (m_voiceActivityTransferObserver != nullptr) {
+                m_dialogUXStateAggregator->removeObserver(m_voiceActivityTransferObserver);
+                m_voiceActivityTransferObserver.reset();
+            }
+            m_dialogUXStateAggregator->removeObserver(m_voiceTurnMonitor);
             m_dialogUXStateAggregator.reset();
         }
 
@@ -1235,6 +1525,11 @@ bool AlexaEngineService::shutdown() {
             m_playbackControllerEngineImpl.reset();
         }
 
+        if (m_localeAssetManager != nullptr) {
+            AACE_DEBUG(LX(TAG, "shutdown").m("LocaleAssetsManager"));
+            m_localeAssetManager->shutdown();
+        }
+
         if (m_speechRecognizerEngineImpl != nullptr) {
             AACE_DEBUG(LX(TAG, "shutdown").m("SpeechRecognizerEngineImpl"));
             m_speechRecognizerEngineImpl->shutdown();
@@ -1451,8 +1746,12 @@ bool AlexaEngineService::shutdown() {
         // shutdown the executor
         m_executor.shutdown();
 
-        // uninitialize the alexa client
-        alexaClientSDK::avsCommon::avs::initialization::AlexaClientSDKInit::uninitialize();
+        // uninitialize the alexa client, unless it was initialized by the Alexa service of another engine
+        if (m_deviceSDKInitialized) {
+            alexaClientSDK::avsCommon::avs::initialization::AlexaClientSDKInit::uninitialize();
+            m_deviceSDKInitialized = false;
+            s_deviceSDKInitialized = false;
+        }
 
         return true;
     } catch (std::exception& ex) {
@@ -1785,6 +2084,9 @@ bool AlexaEngineService::connect() {
 
         std::lock_guard<std::mutex> lock(m_connectionMutex);
 
+        // the network and authorization changes while the engine is suspended are applied on resume
+        ReturnIf(m_suspended, true);
+
         // Only attempt to connect if:
         // 1) the network status is CONNECTED, and 2) the current auth state is REFRESHED
         if (m_networkStatus == NetworkInfoObserver::NetworkStatus::CONNECTED &&
@@ -1841,6 +2143,18 @@ void AlexaEngineService::onCapabilitiesStateChange(
         // set the capabilities configured flag so we don't reconfigure on the
         // next connection attempt
         m_capabilitiesConfigured = true;
+
+        // the capabilities delegate compares the configuration of each endpoint with the configuration it stored
+        // when it was last published, and only publishes the endpoints that changed
+        bool published = !addedOrUpdatedEndpointIds.empty() || !deletedEndpointIds.empty();
+        AACE_INFO(LX(TAG, "onCapabilitiesStateChange")
+                      .d("addedOrUpdated", addedOrUpdatedEndpointIds.size())
+                      .d("deleted", deletedEndpointIds.size()));
+        emitCounterMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX,
+            "onCapabilitiesStateChange",
+            published ? "CapabilitiesPublished" : "CapabilitiesUnchanged",
+            1);
     }
 }
 
@@ -1891,11 +2205,14 @@ void AlexaEngineService::onNetworkInfoChanged(NetworkInfoObserver::NetworkStatus
             if (isRunning()) {
                 // if we are transitioning from any state to CONNECTED then connect to avs
                 if (status == NetworkInfoObserver::NetworkStatus::CONNECTED) {
+                    // resolve the endpoints while the token is refreshed and the connection is established
+                    m_connectionWarmup->onNetworkConnected({getAVSGateway(), getLWAEndpoint()});
                     connect();
                 }
 
                 // else if transitioning from CONNECTED to any other state disconnect the avs connection
                 else if (previousNetworkStatus == NetworkInfoObserver::NetworkStatus::CONNECTED) {
+                    m_connectionWarmup->onNetworkDisconnected();
                     disconnect();
                 }
             }
@@ -1915,6 +2232,11 @@ void AlexaEngineService::onNetworkInterfaceChangeStatusChanged(
 
         ThrowIfNot(m_configured, "alexaServiceNotConfigured");
 
+        // the following playbacks track their buffer underruns for the new network
+        if (m_adaptiveBuffering != nullptr && NetworkInfoObserver::NetworkInterfaceChangeStatus::CHANGE == status) {
+            m_adaptiveBuffering->setNetworkType(networkInterface);
+        }
+
         if (isRunning()) {
             if (NetworkInfoObserver::NetworkInterfaceChangeStatus::BEGIN == status) {
                 // Disable the AVS connection if enabled at the begin of network interface change.
@@ -1929,6 +2251,8 @@ void AlexaEngineService::onNetworkInterfaceChangeStatusChanged(
                 if (currentNetworkInterface != networkInterface) {
                     alexaClientSDK::avsCommon::utils::libcurlUtils::CurlEasyHandleWrapper::setInterfaceName(
                         networkInterface);
+                    // close the pooled connections bound to the previous interface
+                    HttpClientPool::getInstance()->clear();
                 }
             } else if (NetworkInfoObserver::NetworkInterfaceChangeStatus::COMPLETED == status) {
                 // Enable the AVS connection if it was previously disabled at the begin of
@@ -2020,7 +2344,8 @@ bool AlexaEngineService::registerPlatformInterfaceType(
         std::shared_ptr<alexaClientSDK::speechencoder::EncoderContext> encoderCtx = nullptr;
         if (m_encoderEnabled) {
             if (m_encoderName == "opus") {
-                encoderCtx = std::make_shared<alexaClientSDK::speechencoder::OpusEncoderContext>();
+                encoderCtx = OpusSpeechEncoderContext::create(m_encoderConfig);
+                ThrowIfNull(encoderCtx, "invalidEncoderConfiguration");
             } else {
                 Throw("Unsupported encoder.name");
             }
@@ -2030,8 +2355,25 @@ bool AlexaEngineService::registerPlatformInterfaceType(
         }
 
         // create the wakeword engine using the factory method if provided.
-        auto wakewordEngineAdapter =
+        std::shared_ptr<WakewordEngineAdapter> wakewordEngineAdapter =
             m_wakewordEngineManager->createAdapter(WakewordEngineManager::AdapterType::PRIMARY, m_wakewordEngineName);
+
+        // the locale is changed on a second instance of the primary wake word engine, so it keeps detecting
+        if (wakewordEngineAdapter != nullptr && m_stagedLocaleSwitch) {
+            auto wakewordEngineManager = m_wakewordEngineManager;
+            auto wakewordEngineName = m_wakewordEngineName;
+            auto stagedAdapter = StagedWakewordEngineAdapter::create(
+                wakewordEngineAdapter,
+                [wakewordEngineManager, wakewordEngineName]() {
+                    return wakewordEngineManager->createAdapter(
+                        WakewordEngineManager::AdapterType::PRIMARY, wakewordEngineName);
+                },
+                [wakewordEngineManager](std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream) {
+                    return wakewordEngineManager->findPipeline(stream);
+                });
+            ThrowIfNull(stagedAdapter, "createStagedWakewordEngineAdapterFailed");
+            wakewordEngineAdapter = stagedAdapter;
+        }
         auto initiatorVerifiers = getFactoryType<InitiatorVerifier>();
 
         // get the property engine service interface from the property manager service
@@ -2060,10 +2402,20 @@ bool AlexaEngineService::registerPlatformInterfaceType(
             m_capabilityChangeNotifier,
             speechEncoder,
             wakewordEngineAdapter,
-            initiatorVerifiers);
+            initiatorVerifiers,
+            m_audioBufferConfig,
+            m_voiceActivityGateConfig,
+            m_speculativeWakewordVerification,
+            m_voiceTurnMonitor);
 
         ThrowIfNull(m_speechRecognizerEngineImpl, "createSpeechRecognizerEngineImplFailed");
         m_connectionManager->addConnectionStatusObserver(m_speechRecognizerEngineImpl);
+
+        // the wake word engine is initialized with the active locale, so the other locales are prefetched from now on
+        if (wakewordEngineAdapter != nullptr) {
+            m_localeAssetManager->setWakewordEngineAdapter(
+                wakewordEngineAdapter, propertyManager->getProperty(aace::alexa::property::LOCALE));
+        }
         m_deviceSettingsDelegate->getDeviceSettingsManager()
             ->addObserver<DeviceSettingsDelegate::DeviceSettingsIndex::LOCALE>(shared_from_this());
 
@@ -2099,6 +2451,8 @@ bool AlexaEngineService::registerPlatformInterfaceType(std::shared_ptr<aace::ale
             *m_deviceSettingsDelegate,
             m_metricRecorder);
         ThrowIfNull(m_alertsEngineImpl, "createAlertsEngineImplFailed");
+        m_alertsEngineImpl->setReadAhead(m_audioOutputReadAheadSize);
+        m_alertsEngineImpl->setAdaptiveBuffering(m_adaptiveBuffering);
 
         return true;
     } catch (std::exception& ex) {
@@ -2112,7 +2466,7 @@ bool AlexaEngineService::registerPlatformInterfaceType(std::shared_ptr<aace::ale
         ThrowIfNotNull(m_alexaSpeakerEngineImpl, "platformInterfaceAlreadyRegistered");
 
         // create the alexa speaker engine impl
-        m_alexaSpeakerEngineImpl = AlexaSpeakerEngineImpl::create(alexaSpeaker, m_speakerManager);
+        m_alexaSpeakerEngineImpl = AlexaSpeakerEngineImpl::create(alexaSpeaker, m_speakerManager, m_volumeReportDelay);
         ThrowIfNull(m_alexaSpeakerEngineImpl, "createAlexaSpeakerEngineImplFailed");
 
         return true;
@@ -2146,6 +2500,8 @@ bool AlexaEngineService::registerPlatformInterfaceType(std::shared_ptr<aace::ale
             m_authorizationManager,
             m_metricRecorder);
         ThrowIfNull(m_audioPlayerEngineImpl, "createAudioPlayerEngineImplFailed");
+        m_audioPlayerEngineImpl->setReadAhead(m_audioOutputReadAheadSize);
+        m_audioPlayerEngineImpl->setAdaptiveBuffering(m_adaptiveBuffering);
         m_renderPlayerInfoCardsProviderInterfaces.insert(m_audioPlayerEngineImpl);
 
         // if a template interface has been registered it needs to know about the
@@ -2218,7 +2574,8 @@ bool AlexaEngineService::registerPlatformInterfaceType(
             m_customerDataManager,
             m_exceptionSender,
             m_contextManager,
-            m_connectionManager);
+            m_connectionManager,
+            m_bandLevelReportDelay);
         ThrowIfNull(m_equalizerControllerEngineImpl, "createEqualizerControllerEngineImplFailed");
 
         return true;
@@ -2276,6 +2633,14 @@ bool AlexaEngineService::createExternalMediaPlayerImpl() {
         }
         AACE_VERBOSE(LX(TAG).d("agent", m_externalMediaPlayerAgent));
 
+        // the local storage is needed to restore the authorizations of the discovered players
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage;
+        if (m_restoreDiscoveredPlayerAuthorizations) {
+            localStorage =
+                getContext()->getServiceInterface<aace::engine::storage::LocalStorageInterface>("aace.storage");
+            ThrowIfNull(localStorage, "invalidLocalStorage");
+        }
+
         // create the external media player impl if is null
         m_externalMediaPlayerEngineImpl = aace::engine::alexa::ExternalMediaPlayerEngineImpl::create(
             m_externalMediaPlayerAgent,
@@ -2289,7 +2654,10 @@ bool AlexaEngineService::createExternalMediaPlayerImpl() {
             m_playbackRouterDelegate,
             m_audioPlayerObserverDelegate,
             externalMediaAdapterRegistration,
-            m_duckingEnabled);
+            m_duckingEnabled,
+            m_externalMediaPlayerEventBatchWindow,
+            m_externalMediaPlayerDiscoveryReportWindow,
+            localStorage);
         ThrowIfNull(m_externalMediaPlayerEngineImpl, "createExternalMediaPlayerEngineImplFailed");
 
         // external media player impl needs to observer connection manager connections status
@@ -2379,6 +2747,8 @@ bool AlexaEngineService::registerPlatformInterfaceType(std::shared_ptr<aace::ale
             m_audioFocusManager,
             m_metricRecorder);
         ThrowIfNull(m_notificationsEngineImpl, "createNotificationsEngineImplFailed");
+        m_notificationsEngineImpl->setReadAhead(m_audioOutputReadAheadSize);
+        m_notificationsEngineImpl->setAdaptiveBuffering(m_adaptiveBuffering);
 
         return true;
     } catch (std::exception& ex) {
@@ -2394,7 +2764,11 @@ bool AlexaEngineService::registerPlatformInterfaceType(
 
         // create the playback controller engine implementation
         m_playbackControllerEngineImpl = aace::engine::alexa::PlaybackControllerEngineImpl::create(
-            playbackController, m_defaultEndpointBuilder, m_connectionManager, m_contextManager);
+            playbackController,
+            m_defaultEndpointBuilder,
+            m_connectionManager,
+            m_contextManager,
+            m_buttonCoalescingWindow);
         ThrowIfNull(m_playbackControllerEngineImpl, "createPlaybackControllerEngineImplFailed");
 
         // register playback router with the playback router delegate
@@ -2430,6 +2804,8 @@ bool AlexaEngineService::registerPlatformInterfaceType(
             m_exceptionSender,
             m_metricRecorder);
         ThrowIfNull(m_speechSynthesizerEngineImpl, "createSpeechSynthesizerEngineImplFailed");
+        m_speechSynthesizerEngineImpl->setReadAhead(m_audioOutputReadAheadSize);
+        m_speechSynthesizerEngineImpl->setAdaptiveBuffering(m_adaptiveBuffering);
 
         // add engine interface to shutdown list
         // m_requiresShutdownList.insert( m_speechSynthesizerEngineImpl );
@@ -2452,7 +2828,8 @@ bool AlexaEngineService::registerPlatformInterfaceType(std::shared_ptr<aace::ale
             m_renderPlayerInfoCardsProviderInterfaces,
             m_visualFocusManager,
             m_dialogUXStateAggregator,
-            m_exceptionSender);
+            m_exceptionSender,
+            m_renderPlayerInfoDeltas);
         ThrowIfNull(m_templateRuntimeEngineImpl, "createTemplateRuntimeEngineImplFailed");
 
         return true;
@@ -2485,8 +2862,8 @@ bool AlexaEngineService::registerPlatformInterfaceType(
     try {
         ThrowIfNotNull(m_featureDiscoveryEngineImpl, "platformInterfaceAlreadyRegistered");
 
-        m_featureDiscoveryEngineImpl =
-            aace::engine::alexa::FeatureDiscoveryEngineImpl::create(featureDiscoveryPlatformInterface, getContext());
+        m_featureDiscoveryEngineImpl = aace::engine::alexa::FeatureDiscoveryEngineImpl::create(
+            featureDiscoveryPlatformInterface, getContext(), m_featureDiscoveryCacheTimeToLive);
         ThrowIfNull(m_featureDiscoveryEngineImpl, "createFeatureDiscoveryEngineImplFailed");
 
         featureDiscoveryPlatformInterface->setEngineInterface(m_featureDiscoveryEngineImpl);
@@ -2777,12 +3154,7 @@ alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse HttpPutDelegate::do
     const std::vector<std::string>& headers,
     const std::string& data) {
     try {
-        // Creating the HttpPut on every doPut is by design to ensure that curl in libcurlUtils uses the
-        // latest provided curl options.
-        auto httpPut = alexaClientSDK::avsCommon::utils::libcurlUtils::HttpPut::create();
-        ThrowIfNull(httpPut, "httpPutCreateFailed");
-
-        return httpPut->doPut(url, headers, data);
+        return HttpClientPool::getInstance()->doPut(url, headers, data);
 
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "doPut").d("reason", ex.what()));
@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <vector>
+
 #include <AACE/Engine/Alexa/AlexaSpeakerEngineImpl.h>
 #include "AACE/Engine/Core/EngineMacros.h"
 #include "AACE/Engine/Utils/Metrics/Metrics.h"
@@ -22,6 +24,8 @@ namespace engine {
 namespace alexa {
 
 using namespace aace::engine::utils::metrics;
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+using AvsSpeakerType = alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type;
 
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.alexa.AlexaSpeakerEngineImpl");
@@ -34,21 +38,29 @@ static const std::string METRIC_SPEAKER_SPEAKER_SETTINGS_CHANGED = "SpeakerSetti
 static const std::string METRIC_SPEAKER_LOCAL_SET_VOLUME = "LocalSetVolume";
 static const std::string METRIC_SPEAKER_LOCAL_ADJUST_VOLUME = "LocalAdjustVolume";
 static const std::string METRIC_SPEAKER_LOCAL_SET_MUTE = "LocalSetMute";
+static const std::string METRIC_SPEAKER_VOLUME_REPORTED = "VolumeReported";
+
+const std::chrono::milliseconds AlexaSpeakerEngineImpl::DEFAULT_VOLUME_REPORT_DELAY(300);
 
 AlexaSpeakerEngineImpl::AlexaSpeakerEngineImpl(
-    std::shared_ptr<aace::alexa::AlexaSpeaker> alexaSpeakerPlatformInterface) :
+    std::shared_ptr<aace::alexa::AlexaSpeaker> alexaSpeakerPlatformInterface,
+    std::chrono::milliseconds volumeReportDelay) :
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
-        m_alexaSpeakerPlatformInterface(alexaSpeakerPlatformInterface) {
+        m_alexaSpeakerPlatformInterface(alexaSpeakerPlatformInterface),
+        m_volumeReportDelay(volumeReportDelay),
+        m_executor("AlexaSpeaker") {
 }
 
 std::shared_ptr<AlexaSpeakerEngineImpl> AlexaSpeakerEngineImpl::create(
     std::shared_ptr<aace::alexa::AlexaSpeaker> alexaSpeakerPlatformInterface,
-    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::SpeakerManagerInterface> speakerManager) {
+    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::SpeakerManagerInterface> speakerManager,
+    std::chrono::milliseconds volumeReportDelay) {
     try {
         ThrowIfNull(alexaSpeakerPlatformInterface, "invalidAlexaSpeakerPlatformInterface");
+        ThrowIf(volumeReportDelay < std::chrono::milliseconds::zero(), "invalidVolumeReportDelay");
 
-        auto alexaSpeakerEngineImpl =
-            std::shared_ptr<AlexaSpeakerEngineImpl>(new AlexaSpeakerEngineImpl(alexaSpeakerPlatformInterface));
+        auto alexaSpeakerEngineImpl = std::shared_ptr<AlexaSpeakerEngineImpl>(
+            new AlexaSpeakerEngineImpl(alexaSpeakerPlatformInterface, volumeReportDelay));
 
         ThrowIfNot(alexaSpeakerEngineImpl->initialize(speakerManager), "initializeAlexaSpeakerFailed");
 
@@ -80,8 +92,6 @@ bool AlexaSpeakerEngineImpl::initialize(
 
 alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type AlexaSpeakerEngineImpl::convert(
     SpeakerType type) {
-    using AvsSpeakerType = alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type;
-
     try {
         if (type == SpeakerType::ALEXA_VOLUME) {
             return AvsSpeakerType::AVS_SPEAKER_VOLUME;
@@ -98,8 +108,6 @@ alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type AlexaSpea
 
 AlexaSpeakerEngineImpl::SpeakerType AlexaSpeakerEngineImpl::convert(
     alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type type) {
-    using AvsSpeakerType = alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type;
-
     try {
         if (type == AvsSpeakerType::AVS_SPEAKER_VOLUME) {
             return SpeakerType::ALEXA_VOLUME;
@@ -114,7 +122,68 @@ AlexaSpeakerEngineImpl::SpeakerType AlexaSpeakerEngineImpl::convert(
     }
 }
 
+void AlexaSpeakerEngineImpl::restartReportTimerLocked(AvsSpeakerType type) {
+    auto it = m_reportTimers.find(type);
+    if (it != m_reportTimers.end()) {
+        TimerWheel::getDefault()->cancel(it->second);
+    }
+
+    // the timer runs on the timer thread, which must not wait for the speaker manager
+    std::weak_ptr<AlexaSpeakerEngineImpl> wp = shared_from_this();
+    m_reportTimers[type] = TimerWheel::getDefault()->submitAfter(m_volumeReportDelay, [wp, type]() {
+        if (auto speaker = wp.lock()) {
+            auto raw = speaker.get();
+            speaker->m_executor.post([raw, type]() {
+                {
+                    std::lock_guard<std::mutex> lock(raw->m_mutex);
+                    // the report was sent at shutdown, or by the report of an earlier timer
+                    if (raw->m_shutdown || raw->m_reportTimers.erase(type) == 0) {
+                        return;
+                    }
+                }
+                raw->reportVolume(type);
+            });
+        }
+    });
+}
+
+void AlexaSpeakerEngineImpl::reportVolume(AvsSpeakerType type) {
+    try {
+        auto m_speakerManager_lock = m_speakerManager.lock();
+        ThrowIfNull(m_speakerManager_lock, "invalidSpeakerManager");
+
+        alexaClientSDK::avsCommon::sdkInterfaces::SpeakerInterface::SpeakerSettings settings;
+        ThrowIfNot(m_speakerManager_lock->getSpeakerSettings(type, &settings).get(), "getSpeakerSettingsFailed");
+
+        // the speakers already have the volume, so setting it again only sends the event and notifies the observers
+        std::stringstream speakerType;
+        speakerType << type;
+        emitCounterMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX, "reportVolume", {METRIC_SPEAKER_VOLUME_REPORTED, speakerType.str()});
+        m_speakerManager_lock->setVolume(type, settings.volume, false, Source::LOCAL_API);
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("type", type));
+    }
+}
+
 void AlexaSpeakerEngineImpl::doShutdown() {
+    std::vector<AvsSpeakerType> pendingReports;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+        for (auto& next : m_reportTimers) {
+            TimerWheel::getDefault()->cancel(next.second);
+            pendingReports.push_back(next.first);
+        }
+        m_reportTimers.clear();
+    }
+    m_executor.shutdown();
+
+    // the settled volumes are reported before the speaker manager is shut down
+    for (auto type : pendingReports) {
+        reportVolume(type);
+    }
+
     if (m_alexaSpeakerPlatformInterface != nullptr) {
         m_alexaSpeakerPlatformInterface->setEngineInterface(nullptr);
     }
@@ -135,7 +204,15 @@ void AlexaSpeakerEngineImpl::onLocalSetVolume(SpeakerType type, int8_t volume) {
     emitCounterMetrics(
         METRIC_PROGRAM_NAME_SUFFIX, "onLocalSetVolume", {METRIC_SPEAKER_LOCAL_SET_VOLUME, speakerType.str()});
     if (auto m_speakerManager_lock = m_speakerManager.lock()) {
-        m_speakerManager_lock->setVolume(convert(type), volume);
+        if (m_volumeReportDelay == std::chrono::milliseconds::zero()) {
+            m_speakerManager_lock->setVolume(convert(type), volume);
+            return;
+        }
+        // the volume is applied at once, and reported once it settles
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ReturnIf(m_shutdown);
+        m_speakerManager_lock->setVolume(convert(type), volume, true, Source::LOCAL_API);
+        restartReportTimerLocked(convert(type));
     }
 }
 
@@ -145,7 +222,15 @@ void AlexaSpeakerEngineImpl::onLocalAdjustVolume(SpeakerType type, int8_t delta)
     emitCounterMetrics(
         METRIC_PROGRAM_NAME_SUFFIX, "onLocalAdjustVolume", {METRIC_SPEAKER_LOCAL_ADJUST_VOLUME, speakerType.str()});
     if (auto m_speakerManager_lock = m_speakerManager.lock()) {
-        m_speakerManager_lock->adjustVolume(convert(type), delta);
+        if (m_volumeReportDelay == std::chrono::milliseconds::zero()) {
+            m_speakerManager_lock->adjustVolume(convert(type), delta);
+            return;
+        }
+        // the volume is applied at once, and reported once it settles
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ReturnIf(m_shutdown);
+        m_speakerManager_lock->adjustVolume(convert(type), delta, true, Source::LOCAL_API);
+        restartReportTimerLocked(convert(type));
     }
 }
 
@@ -18,6 +18,8 @@
 #include <AACE/Engine/Utils/Metrics/Metrics.h>
 #include "AACE/Engine/Alexa/ChannelVolumeManager.h"
 
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 namespace aace {
@@ -53,11 +55,15 @@ AudioChannelEngineImpl::AudioChannelEngineImpl(
         m_channelVolumeType(channelVolumeType),
         m_currentId(ERROR),
         m_savedOffset(std::chrono::milliseconds(0)),
+        m_trace(m_name),
         m_muted(false),
         m_volume(DEFAULT_SPEAKER_VOLUME),
         m_pendingEventState(PendingEventState::NONE),
         m_currentMediaState(MediaState::STOPPED),
         m_mediaStateChangeInitiator(MediaStateChangeInitiator::NONE),
+        m_prerollSize(0),
+        m_prerollTimeout(0),
+        m_readAheadSize(0),
         m_mayDuck(false),
         m_duckingState(DuckingStates::NONE) {
 }
@@ -109,6 +115,7 @@ void AudioChannelEngineImpl::doShutdown() {
     if (auto reader = m_attachmentReader.lock()) {
         reader->close();
     }
+    m_prerollExecutor.shutdown();
 
     // reset the media observer reference
     m_callbackExecutor.submit([this] { m_mediaPlayerObservers.clear(); });
@@ -156,15 +163,45 @@ int64_t AudioChannelEngineImpl::getMediaPosition() {
     return m_audioOutputChannel->getPosition();
 }
 
+std::chrono::milliseconds AudioChannelEngineImpl::getPlaybackPosition() {
+    std::chrono::milliseconds position;
+    if (m_positionTracker.getPosition(position)) {
+        return position;
+    }
+    return std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+}
+
 int64_t AudioChannelEngineImpl::getMediaDuration() {
     return m_audioOutputChannel->getDuration();
 }
 
+void AudioChannelEngineImpl::setAttachmentPreroll(size_t size, std::chrono::milliseconds timeout) {
+    m_prerollSize = size;
+    m_prerollTimeout = timeout;
+}
+
+void AudioChannelEngineImpl::setReadAhead(size_t size) {
+    m_readAheadSize = size;
+}
+
+void AudioChannelEngineImpl::setAdaptiveBuffering(std::shared_ptr<AdaptiveBuffering> adaptiveBuffering) {
+    m_adaptiveBuffering = adaptiveBuffering;
+}
+
+void AudioChannelEngineImpl::sendBufferingHint(
+    const std::shared_ptr<aace::engine::audio::AudioOutputChannelInterface>& outputChannel) {
+    if (m_adaptiveBuffering != nullptr) {
+        auto prebuffer = m_adaptiveBuffering->getPrebufferTarget(m_name);
+        AACE_DEBUG(LXT.d("prebuffer", prebuffer.count()));
+        outputChannel->setBufferingHint(prebuffer.count());
+    }
+}
+
 std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface> AudioChannelEngineImpl::
     getChannelVolumeInterface() {
     if (!m_channelVolumeInterface) {
         m_channelVolumeInterface = aace::engine::alexa::ChannelVolumeManager::create(
-            shared_from_this(), m_channelVolumeType, nullptr, shared_from_this());
+            shared_from_this(), m_channelVolumeType, nullptr, shared_from_this(), DuckingMixer::getDefault());
     }
     return m_channelVolumeInterface;
 }
@@ -183,12 +220,32 @@ void AudioChannelEngineImpl::onMediaStateChanged(MediaState state) {
     mediaState << state;
     emitCounterMetrics(
         METRIC_PROGRAM_NAME_SUFFIX, "onMediaStateChanged", {METRIC_AUDIO_OUTPUT_MEDIA_STATE_CHANGED, mediaState.str()});
-    m_executor.submit([this, id, state] { executeMediaStateChanged(id, state); });
+    // the position stops or starts moving when the platform reports it, not when the executor handles it
+    m_positionTracker.setPlaying(state == MediaState::PLAYING);
+    auto reported = AudioChannelTrace::Clock::now();
+    m_trace.recordReport("onMediaStateChanged", mediaState.str(), reported);
+    m_executor.submit([this, id, state, reported] { executeMediaStateChanged(id, state, reported); });
 }
 
-void AudioChannelEngineImpl::executeMediaStateChanged(SourceId id, MediaState state) {
+void AudioChannelEngineImpl::onMediaPositionChanged(int64_t position) {
+    if (position < 0) {
+        AACE_WARN(LXT.d("reason", "invalidPosition").d("position", position));
+        return;
+    }
+    m_positionTracker.update(std::chrono::milliseconds(position));
+}
+
+void AudioChannelEngineImpl::executeMediaStateChanged(
+    SourceId id,
+    MediaState state,
+    AudioChannelTrace::Clock::time_point reported) {
     auto currentMediaState = m_currentMediaState;
     auto pendingEventState = m_pendingEventState;
+    if (AudioChannelTrace::isRecording()) {
+        std::stringstream mediaState;
+        mediaState << state;
+        m_trace.recordHandled("onMediaStateChanged", mediaState.str(), reported);
+    }
     try {
         AACE_VERBOSE(LXT.d("currentState", currentMediaState)
                          .d("newState", state)
@@ -209,10 +266,12 @@ void AudioChannelEngineImpl::executeMediaStateChanged(SourceId id, MediaState st
                 if (pendingEventState == PendingEventState::PLAYBACK_STARTED) {
                     setMediaStateChangeInitiator(MediaStateChangeInitiator::PLAY);
                     executePlaybackStarted(id);
+                    m_trace.recordTransition(AudioChannelTrace::Transition::STARTED, reported);
                     pendingEventState = PendingEventState::NONE;
                 } else if (pendingEventState == PendingEventState::PLAYBACK_RESUMED) {
                     setMediaStateChangeInitiator(MediaStateChangeInitiator::RESUME);
                     executePlaybackResumed(id);
+                    m_trace.recordTransition(AudioChannelTrace::Transition::RESUMED, reported);
                     pendingEventState = PendingEventState::NONE;
                 } else {
                     Throw("unexpectedPendingEventState");
@@ -239,6 +298,7 @@ void AudioChannelEngineImpl::executeMediaStateChanged(SourceId id, MediaState st
                 if (pendingEventState == PendingEventState::PLAYBACK_STOPPED) {
                     setMediaStateChangeInitiator(MediaStateChangeInitiator::STOP);
                     executePlaybackStopped(id);
+                    m_trace.recordTransition(AudioChannelTrace::Transition::STOPPED, reported);
                     pendingEventState = PendingEventState::NONE;
                 } else if (m_pendingEventState == PendingEventState::PLAYBACK_PAUSED) {
                     setMediaStateChangeInitiator(MediaStateChangeInitiator::PAUSE);
@@ -259,6 +319,7 @@ void AudioChannelEngineImpl::executeMediaStateChanged(SourceId id, MediaState st
                 if (pendingEventState == PendingEventState::PLAYBACK_STOPPED) {
                     setMediaStateChangeInitiator(MediaStateChangeInitiator::STOP);
                     executePlaybackStopped(id);
+                    m_trace.recordTransition(AudioChannelTrace::Transition::STOPPED, reported);
                     pendingEventState = PendingEventState::NONE;
                 } else if (pendingEventState == PendingEventState::PLAYBACK_PAUSED) {
                     setMediaStateChangeInitiator(MediaStateChangeInitiator::PAUSE);
@@ -275,6 +336,7 @@ void AudioChannelEngineImpl::executeMediaStateChanged(SourceId id, MediaState st
                 if (pendingEventState == PendingEventState::PLAYBACK_STOPPED) {
                     setMediaStateChangeInitiator(MediaStateChangeInitiator::STOP);
                     executePlaybackStopped(id);
+                    m_trace.recordTransition(AudioChannelTrace::Transition::STOPPED, reported);
                     pendingEventState = PendingEventState::NONE;
                 } else {
                     Throw("unexpectedPendingEventState");
@@ -300,6 +362,7 @@ void AudioChannelEngineImpl::executeMediaStateChanged(SourceId id, MediaState st
             // the buffer underrun event
             else if (pendingEventState == PendingEventState::PLAYBACK_RESUMED) {
                 executePlaybackResumed(id);
+                m_trace.recordTransition(AudioChannelTrace::Transition::RESUMED, reported);
                 executeBufferUnderrun(id);
                 pendingEventState = PendingEventState::NONE;
             }
@@ -334,6 +397,7 @@ void AudioChannelEngineImpl::onMediaError(MediaError error, const std::string& d
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "onMediaError", {METRIC_AUDIO_OUTPUT_MEDIA_ERROR, mediaError.str()});
     AACE_VERBOSE(LXT.d("error", error));
 
+    m_positionTracker.setPlaying(false);
     auto id = m_currentId;
     m_executor.submit([this, id, error, description] {
         executeMediaError(id, error, description);
@@ -343,7 +407,18 @@ void AudioChannelEngineImpl::onMediaError(MediaError error, const std::string& d
 
 void AudioChannelEngineImpl::onAudioFocusEvent(FocusAction action) {
     AACE_VERBOSE(LXT.d("FocusAction", action));
-    m_executor.submit([this, action] {
+    std::string focusAction;
+    auto reported = AudioChannelTrace::Clock::now();
+    if (AudioChannelTrace::isRecording()) {
+        std::stringstream ss;
+        ss << action;
+        focusAction = ss.str();
+        m_trace.recordReport("onAudioFocusEvent", focusAction, reported);
+    }
+    m_executor.submit([this, action, focusAction, reported] {
+        if (!focusAction.empty()) {
+            m_trace.recordHandled("onAudioFocusEvent", focusAction, reported);
+        }
         switch (action) {
             case FocusAction::REPORT_DUCKING_STARTED:
                 execDuckingStarted();
@@ -361,8 +436,11 @@ void AudioChannelEngineImpl::onAudioFocusEvent(FocusAction action) {
 void AudioChannelEngineImpl::executeMediaError(SourceId id, MediaError error, const std::string& description) {
     try {
         ThrowIf(id == ERROR, "invalidSource");
+        if (m_adaptiveBuffering != nullptr) {
+            m_adaptiveBuffering->onPlaybackEnded(m_name);
+        }
 
-        auto offset = std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+        auto offset = getPlaybackPosition();
         m_callbackExecutor.submit([this, id, error, description, offset] {
             for (auto&& observer : m_mediaPlayerObservers) {
                 if (auto observer_lock = observer.lock()) {
@@ -384,8 +462,11 @@ void AudioChannelEngineImpl::executeMediaError(SourceId id, MediaError error, co
 void AudioChannelEngineImpl::executePlaybackStarted(SourceId id) {
     try {
         ThrowIf(id == ERROR, "invalidSource");
+        if (m_adaptiveBuffering != nullptr) {
+            m_adaptiveBuffering->onPlaybackStarted(m_name);
+        }
 
-        auto offset = std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+        auto offset = getPlaybackPosition();
         m_callbackExecutor.submit([this, id, offset] {
             for (auto&& observer : m_mediaPlayerObservers) {
                 if (auto observer_lock = observer.lock()) {
@@ -402,8 +483,11 @@ void AudioChannelEngineImpl::executePlaybackStarted(SourceId id) {
 void AudioChannelEngineImpl::executePlaybackFinished(SourceId id) {
     try {
         ThrowIf(id == ERROR, "invalidSource");
+        if (m_adaptiveBuffering != nullptr) {
+            m_adaptiveBuffering->onPlaybackEnded(m_name);
+        }
 
-        auto offset = std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+        auto offset = getPlaybackPosition();
         m_callbackExecutor.submit([this, id, offset] {
             for (auto&& observer : m_mediaPlayerObservers) {
                 if (auto observer_lock = observer.lock()) {
@@ -425,7 +509,7 @@ void AudioChannelEngineImpl::executePlaybackPaused(SourceId id) {
     try {
         ThrowIf(id == ERROR, "invalidSource");
 
-        auto offset = std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+        auto offset = getPlaybackPosition();
         m_callbackExecutor.submit([this, id, offset] {
             for (auto&& observer : m_mediaPlayerObservers) {
                 if (auto observer_lock = observer.lock()) {
@@ -445,8 +529,11 @@ void AudioChannelEngineImpl::executePlaybackPaused(SourceId id) {
 void AudioChannelEngineImpl::executePlaybackResumed(SourceId id) {
     try {
         ThrowIf(id == ERROR, "invalidSource");
+        if (m_adaptiveBuffering != nullptr) {
+            m_adaptiveBuffering->onPlaybackStarted(m_name);
+        }
 
-        auto offset = std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+        auto offset = getPlaybackPosition();
         m_callbackExecutor.submit([this, id, offset] {
             for (auto&& observer : m_mediaPlayerObservers) {
                 if (auto observer_lock = observer.lock()) {
@@ -463,8 +550,11 @@ void AudioChannelEngineImpl::executePlaybackResumed(SourceId id) {
 void AudioChannelEngineImpl::executePlaybackStopped(SourceId id) {
     try {
         ThrowIf(id == ERROR, "invalidSource");
+        if (m_adaptiveBuffering != nullptr) {
+            m_adaptiveBuffering->onPlaybackEnded(m_name);
+        }
 
-        auto offset = std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+        auto offset = getPlaybackPosition();
         m_callbackExecutor.submit([this, id, offset] {
             for (auto&& observer : m_mediaPlayerObservers) {
                 if (auto observer_lock = observer.lock()) {
@@ -484,8 +574,11 @@ void AudioChannelEngineImpl::executePlaybackStopped(SourceId id) {
 void AudioChannelEngineImpl::executePlaybackError(SourceId id, MediaError error, const std::string& description) {
     try {
         ThrowIf(id == ERROR, "invalidSource");
+        if (m_adaptiveBuffering != nullptr) {
+            m_adaptiveBuffering->onPlaybackEnded(m_name);
+        }
 
-        auto offset = std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+        auto offset = getPlaybackPosition();
         m_callbackExecutor.submit([this, id, error, description, offset] {
             for (auto&& observer : m_mediaPlayerObservers) {
                 if (auto observer_lock = observer.lock()) {
@@ -507,8 +600,11 @@ void AudioChannelEngineImpl::executePlaybackError(SourceId id, MediaError error,
 void AudioChannelEngineImpl::executeBufferUnderrun(SourceId id) {
     try {
         ThrowIf(id == ERROR, "invalidSource");
+        if (m_adaptiveBuffering != nullptr) {
+            m_adaptiveBuffering->onBufferUnderrun(m_name);
+        }
 
-        auto offset = std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+        auto offset = getPlaybackPosition();
         m_callbackExecutor.submit([this, id, offset] {
             for (auto&& observer : m_mediaPlayerObservers) {
                 if (auto observer_lock = observer.lock()) {
@@ -525,8 +621,11 @@ void AudioChannelEngineImpl::executeBufferUnderrun(SourceId id) {
 void AudioChannelEngineImpl::executeBufferRefilled(SourceId id) {
     try {
         ThrowIf(id == ERROR, "invalidSource");
+        if (m_adaptiveBuffering != nullptr) {
+            m_adaptiveBuffering->onBufferRefilled(m_name);
+        }
 
-        auto offset = std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+        auto offset = getPlaybackPosition();
         m_callbackExecutor.submit([this, id, offset] {
             for (auto&& observer : m_mediaPlayerObservers) {
                 if (auto observer_lock = observer.lock()) {
@@ -547,6 +646,7 @@ void AudioChannelEngineImpl::resetSource() {
     m_mediaStateChangeInitiator = MediaStateChangeInitiator::NONE;
     m_url.clear();
     m_savedOffset = std::chrono::milliseconds(0);
+    m_positionTracker.reset();
 }
 
 void AudioChannelEngineImpl::execDuckingStarted() {
@@ -607,6 +707,21 @@ alexaClientSDK::avsCommon::utils::mediaPlayer::MediaPlayerInterface::SourceId Au
         if (outputChannel != nullptr) {
             auto reader = AttachmentReaderAudioStream::create(attachmentReader, format);
             m_attachmentReader = reader;
+            if (reader != nullptr && m_readAheadSize > 0) {
+                // the read ahead buffer is filled while the platform prepares
+                ThrowIfNot(reader->startReadAhead(m_readAheadSize), "startReadAheadFailed");
+            } else if (reader != nullptr && m_prerollSize > 0) {
+                // read ahead while the platform prepares, until the platform reads
+                auto size = m_prerollSize;
+                auto timeout = m_prerollTimeout;
+                auto name = m_name;
+                m_prerollExecutor.submit([reader, size, timeout, name] {
+                    auto count = reader->preroll(size, timeout);
+                    AACE_DEBUG(LX(TAG, "preroll").d("name", name).d("bytes", count));
+                });
+            }
+            sendBufferingHint(outputChannel);
+            AudioChannelTrace::CallScope traceScope(m_trace, AudioChannelTrace::Call::PREPARE);
             ThrowIfNot(outputChannel->prepare(reader, false), "audioOutputChannelPrepareFailed");
         }
     } catch (std::exception& ex) {
@@ -645,6 +760,11 @@ alexaClientSDK::avsCommon::utils::mediaPlayer::MediaPlayerInterface::SourceId Au
         if (outputChannel != nullptr) {
             auto reader = AttachmentReaderAudioStream::create(attachmentReader, format);
             m_attachmentReader = reader;
+            if (reader != nullptr && m_readAheadSize > 0) {
+                ThrowIfNot(reader->startReadAhead(m_readAheadSize), "startReadAheadFailed");
+            }
+            sendBufferingHint(outputChannel);
+            AudioChannelTrace::CallScope traceScope(m_trace, AudioChannelTrace::Call::PREPARE);
             ThrowIfNot(outputChannel->prepare(reader, false), "audioOutputChannelPrepareFailed");
             ThrowIfNot(outputChannel->setPosition(offsetAdjustment.count()), "platformMediaPlayerSetPositionFailed");
         }
@@ -697,9 +817,12 @@ alexaClientSDK::avsCommon::utils::mediaPlayer::MediaPlayerInterface::SourceId Au
         aace::audio::AudioFormat audioStreamFormat(encoding);
 
         if (outputChannel != nullptr) {
+            sendBufferingHint(outputChannel);
+            AudioChannelTrace::CallScope traceScope(m_trace, AudioChannelTrace::Call::PREPARE);
             ThrowIfNot(
                 outputChannel->prepare(
-                    aace::engine::audio::IStreamAudioStream::create(stream, audioStreamFormat), repeat),
+                    aace::engine::audio::IStreamAudioStream::create(stream, audioStreamFormat, m_readAheadSize),
+                    repeat),
                 "audioOutputChannelPrepareFailed");
             if (config.mediaDescription.mixingBehavior == MixingBehavior::BEHAVIOR_DUCK) {
                 m_mayDuck = true;
@@ -748,6 +871,8 @@ alexaClientSDK::avsCommon::utils::mediaPlayer::MediaPlayerInterface::SourceId Au
 
         auto outputChannel = m_audioOutputChannel;
         if (outputChannel != nullptr) {
+            sendBufferingHint(outputChannel);
+            AudioChannelTrace::CallScope traceScope(m_trace, AudioChannelTrace::Call::PREPARE);
             ThrowIfNot(outputChannel->prepare(m_url, repeat), "audioOutputChannelPrepareFailed");
             if (config.mediaDescription.mixingBehavior == MixingBehavior::BEHAVIOR_DUCK) {
                 m_mayDuck = true;
@@ -788,6 +913,7 @@ bool AudioChannelEngineImpl::execPlay(
         // invoke the platform interface play method
         auto outputChannel = m_audioOutputChannel;
         if (outputChannel != nullptr) {
+            AudioChannelTrace::CallScope traceScope(m_trace, AudioChannelTrace::Call::PLAY);
             ThrowIfNot(outputChannel->play(), "platformMediaPlayerPlayFailed");
         }
 
@@ -819,6 +945,7 @@ bool AudioChannelEngineImpl::execStop(
         // invoke the platform interface stop method
         auto outputChannel = m_audioOutputChannel;
         if (outputChannel != nullptr) {
+            AudioChannelTrace::CallScope traceScope(m_trace, AudioChannelTrace::Call::STOP);
             ThrowIfNot(outputChannel->stop(), "platformMediaPlayerStopFailed");
         }
 
@@ -856,6 +983,7 @@ bool AudioChannelEngineImpl::execPause(
         // invoke the platform interface pause method
         auto outputChannel = m_audioOutputChannel;
         if (outputChannel != nullptr) {
+            AudioChannelTrace::CallScope traceScope(m_trace, AudioChannelTrace::Call::PAUSE);
             ThrowIfNot(outputChannel->pause(), "platformMediaPlayerPauseFailed");
         }
 
@@ -900,6 +1028,7 @@ bool AudioChannelEngineImpl::execResume(
         // invoke the platform interface resume method
         auto outputChannel = m_audioOutputChannel;
         if (outputChannel != nullptr) {
+            AudioChannelTrace::CallScope traceScope(m_trace, AudioChannelTrace::Call::RESUME);
             ThrowIfNot(outputChannel->resume(), "platformMediaPlayerResumeFailed");
         }
 
@@ -923,7 +1052,7 @@ std::chrono::milliseconds AudioChannelEngineImpl::execGetOffset(
     try {
         ReturnIf(m_currentId == ERROR || m_currentId != id, m_savedOffset);
 
-        std::chrono::milliseconds offset = std::chrono::milliseconds(m_audioOutputChannel->getPosition());
+        std::chrono::milliseconds offset = getPlaybackPosition();
         ThrowIf(offset.count() < 0, "invalidMediaTime");
 
         return offset;
@@ -955,8 +1084,7 @@ AudioChannelEngineImpl::execGetMediaPlayerState(SourceId id) {
     auto optional =
         alexaClientSDK::avsCommon::utils::Optional<alexaClientSDK::avsCommon::utils::mediaPlayer::MediaPlayerState>();
     if (m_audioOutputChannel != nullptr && m_currentId == id)
-        optional.set(alexaClientSDK::avsCommon::utils::mediaPlayer::MediaPlayerState{
-            std::chrono::milliseconds(m_audioOutputChannel->getPosition())});
+        optional.set(alexaClientSDK::avsCommon::utils::mediaPlayer::MediaPlayerState{getPlaybackPosition()});
     return optional;
 }
 
@@ -1060,7 +1188,10 @@ bool AudioChannelEngineImpl::execStartDucking() {
             // Since volume is ducked by the platfrom, alexa SDK should not duck it again.
             return true;
         }
-        ThrowIfNot(m_audioOutputChannel->startDucking(), "startDucking failed");
+        {
+            AudioChannelTrace::CallScope traceScope(m_trace, AudioChannelTrace::Call::START_DUCKING);
+            ThrowIfNot(m_audioOutputChannel->startDucking(), "startDucking failed");
+        }
         m_duckingState = DuckingStates::DUCKED_BY_ALEXA;
         AACE_VERBOSE(LXT.d("duckingState", m_duckingState));
         return true;
@@ -1081,7 +1212,10 @@ bool AudioChannelEngineImpl::execStopDucking() {
             // Since volume is not ducked by the alexa SDK, it should not un-duck it.
             return true;
         }
-        ThrowIfNot(m_audioOutputChannel->stopDucking(), "stopDucking failed");
+        {
+            AudioChannelTrace::CallScope traceScope(m_trace, AudioChannelTrace::Call::STOP_DUCKING);
+            ThrowIfNot(m_audioOutputChannel->stopDucking(), "stopDucking failed");
+        }
         m_duckingState = DuckingStates::NONE;
         AACE_VERBOSE(LXT.d("duckingState", m_duckingState));
         return true;
@@ -1106,13 +1240,22 @@ static AudioFormat DEFAULT_ATTACHMENT_AUDIO_FORMAT = AudioFormat(
     0,
     0);
 
+/// The size of the reads of the attachment read ahead
+static const size_t PREROLL_CHUNK_SIZE = 4096;
+
+/// The longest wait of a read ahead, so a read of the platform waits for the read ahead no longer
+static const std::chrono::milliseconds PREROLL_READ_TIMEOUT(10);
+
 AttachmentReaderAudioStream::AttachmentReaderAudioStream(
     std::shared_ptr<alexaClientSDK::avsCommon::avs::attachment::AttachmentReader> attachmentReader,
     const AudioFormat& format) :
         m_attachmentReader(attachmentReader),
         m_status(alexaClientSDK::avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK),
         m_closed(false),
-        m_audioFormat(format) {
+        m_audioFormat(format),
+        m_prerollOffset(0),
+        m_attachmentDrained(false),
+        m_reading(false) {
 }
 
 std::shared_ptr<AttachmentReaderAudioStream> AttachmentReaderAudioStream::create(
@@ -1178,9 +1321,44 @@ std::shared_ptr<AttachmentReaderAudioStream> AttachmentReaderAudioStream::create
 }
 
 ssize_t AttachmentReaderAudioStream::read(char* data, const size_t size) {
+    AACE_TRACE_SCOPE("audio", "AudioOutput.read");
+    return timedRead(data, size, std::chrono::milliseconds(100));
+}
+
+ssize_t AttachmentReaderAudioStream::timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) {
     try {
-        ssize_t count =
-            m_attachmentReader->read(static_cast<void*>(data), size, &m_status, std::chrono::milliseconds(100));
+        // stop the read ahead, which doesn't read the attachment once the platform is reading
+        m_reading = true;
+
+        // the read ahead buffer is filled by the filler thread, the read only waits for the buffer
+        if (m_readAhead != nullptr) {
+            auto count = m_readAhead->read(data, size, timeout);
+            if (m_readAhead->isClosed()) {
+                m_closed = true;
+            }
+            return count;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_prerollOffset < m_prerollBuffer.size()) {
+                auto count = std::min(size, m_prerollBuffer.size() - m_prerollOffset);
+                std::memcpy(data, m_prerollBuffer.data() + m_prerollOffset, count);
+                m_prerollOffset += count;
+                if (m_prerollOffset == m_prerollBuffer.size()) {
+                    std::vector<char>().swap(m_prerollBuffer);
+                    m_prerollOffset = 0;
+                    m_closed = m_attachmentDrained;
+                }
+                return static_cast<ssize_t>(count);
+            }
+            if (m_attachmentDrained) {
+                m_closed = true;
+                return 0;
+            }
+        }
+
+        // the attachment reader wakes up as soon as data is written to the attachment
+        ssize_t count = m_attachmentReader->read(static_cast<void*>(data), size, &m_status, timeout);
 
         if (m_status >= alexaClientSDK::avsCommon::avs::attachment::AttachmentReader::ReadStatus::CLOSED) {
             m_closed = true;
@@ -1194,9 +1372,61 @@ ssize_t AttachmentReaderAudioStream::read(char* data, const size_t size) {
     }
 }
 
+size_t AttachmentReaderAudioStream::preroll(size_t size, std::chrono::milliseconds timeout) {
+    try {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::vector<char> chunk(PREROLL_CHUNK_SIZE);
+        while (!m_reading && !m_closed) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                break;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_reading || m_closed || m_attachmentDrained || m_prerollBuffer.size() >= size) {
+                break;
+            }
+            auto wait = std::min(
+                PREROLL_READ_TIMEOUT, std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now));
+            auto count = m_attachmentReader->read(
+                chunk.data(), std::min(chunk.size(), size - m_prerollBuffer.size()), &m_status, wait);
+            m_prerollBuffer.insert(m_prerollBuffer.end(), chunk.begin(), chunk.begin() + count);
+            if (m_status >= alexaClientSDK::avsCommon::avs::attachment::AttachmentReader::ReadStatus::CLOSED) {
+                m_attachmentDrained = true;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_prerollBuffer.size() - m_prerollOffset;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG + ".AttachmentReaderAudioStream").d("reason", ex.what()).d("size", size));
+        return 0;
+    }
+}
+
+bool AttachmentReaderAudioStream::startReadAhead(size_t size) {
+    // each read of the filler holds the lock for a short time, like the preroll, so close() doesn't wait long
+    m_readAhead =
+        aace::engine::audio::ReadAheadBuffer::create(size, [this](char* data, size_t chunkSize, bool& closed) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto count = m_attachmentReader->read(data, chunkSize, &m_status, PREROLL_READ_TIMEOUT);
+            closed = m_status >= alexaClientSDK::avsCommon::avs::attachment::AttachmentReader::ReadStatus::CLOSED;
+            return count;
+        });
+    return m_readAhead != nullptr;
+}
+
 void AttachmentReaderAudioStream::close() {
-    m_attachmentReader->close(alexaClientSDK::avsCommon::avs::attachment::AttachmentReader::ClosePoint::IMMEDIATELY);
-    m_closed = true;
+    // wait for a read ahead, which reads for a short time
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_attachmentReader->close(
+            alexaClientSDK::avsCommon::avs::attachment::AttachmentReader::ClosePoint::IMMEDIATELY);
+        m_closed = true;
+    }
+    if (m_readAhead != nullptr) {
+        m_readAhead->close();
+    }
 }
 
 bool AttachmentReaderAudioStream::isClosed() {
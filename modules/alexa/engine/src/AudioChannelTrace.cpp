@@ -0,0 +1,368 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#include <AACE/Engine/Alexa/AudioChannelTrace.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/JSON/JSON.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.AudioChannelTrace");
+
+/// Program name suffix of the transition latency metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "AudioChannelTrace";
+
+/// The most events kept, the oldest events are dropped first so the trace keeps the last transitions
+static const size_t MAX_EVENTS = 10000;
+
+/// The process id of the events, the trace only has the engine process.
+static const int TRACE_PID = 1;
+
+using Clock = AudioChannelTrace::Clock;
+namespace json = aace::engine::utils::json;
+
+namespace {
+
+struct TraceState {
+    std::mutex mutex;
+    std::atomic<bool> recording{false};
+    Clock::time_point origin;
+    std::deque<AudioChannelTrace::Event> events;
+    size_t droppedEvents = 0;
+    std::vector<std::weak_ptr<AudioChannelTrace::Listener>> listeners;
+    std::vector<std::weak_ptr<AudioChannelTrace::TransitionListener>> transitionListeners;
+    // lets the channels skip the lock while no transition listener is added
+    std::atomic<bool> hasTransitionListeners{false};
+};
+
+TraceState& getState() {
+    // never destroyed, so the channels destroyed during static destruction can still record
+    static TraceState* s_state = new TraceState();
+    return *s_state;
+}
+
+const char* getCallName(AudioChannelTrace::Call call) {
+    switch (call) {
+        case AudioChannelTrace::Call::PREPARE:
+            return "prepare";
+        case AudioChannelTrace::Call::PLAY:
+            return "play";
+        case AudioChannelTrace::Call::PAUSE:
+            return "pause";
+        case AudioChannelTrace::Call::RESUME:
+            return "resume";
+        case AudioChannelTrace::Call::STOP:
+            return "stop";
+        case AudioChannelTrace::Call::START_DUCKING:
+            return "startDucking";
+        case AudioChannelTrace::Call::STOP_DUCKING:
+            return "stopDucking";
+    }
+    return "unknown";
+}
+
+}  // namespace
+
+AudioChannelTrace::CallScope::CallScope(AudioChannelTrace& trace, Call call) :
+        m_trace(trace), m_call(call), m_start(Clock::now()) {
+}
+
+AudioChannelTrace::CallScope::~CallScope() {
+    m_trace.recordCall(m_call, m_start, Clock::now());
+}
+
+AudioChannelTrace::AudioChannelTrace(const std::string& channel) : m_channel(channel) {
+    std::fill(std::begin(m_lastLatency), std::end(m_lastLatency), std::chrono::milliseconds(-1));
+}
+
+void AudioChannelTrace::recordCall(Call call, Clock::time_point start, Clock::time_point end) {
+    switch (call) {
+        case Call::PREPARE:
+            m_prepareTime = start;
+            break;
+        case Call::PAUSE:
+            m_pauseTime = start;
+            break;
+        case Call::STOP:
+            m_stopTime = start;
+            break;
+        default:
+            break;
+    }
+    record(getCallName(call), "", start, end - start);
+    for (auto& listener : getTransitionListeners()) {
+        listener->onChannelCall(m_channel, call, start);
+    }
+}
+
+void AudioChannelTrace::recordReport(const std::string& name, const std::string& detail, Clock::time_point time) {
+    record(name, detail, time, Clock::duration::zero());
+}
+
+void AudioChannelTrace::recordHandled(const std::string& name, const std::string& detail, Clock::time_point reported) {
+    // the duration is the time the report waited in the executor of the channel
+    record("handle." + name, detail, reported, Clock::now() - reported);
+}
+
+void AudioChannelTrace::recordTransition(Transition transition, Clock::time_point reported) {
+    switch (transition) {
+        case Transition::STARTED:
+            emitLatency("PrepareToPlaying", transition, m_prepareTime, reported);
+            m_prepareTime = Clock::time_point();
+            break;
+        case Transition::RESUMED:
+            emitLatency("PauseToResumed", transition, m_pauseTime, reported);
+            m_pauseTime = Clock::time_point();
+            break;
+        case Transition::STOPPED:
+            emitLatency("StopToStopped", transition, m_stopTime, reported);
+            m_stopTime = Clock::time_point();
+            break;
+    }
+    for (auto& listener : getTransitionListeners()) {
+        listener->onChannelTransition(m_channel, transition, reported);
+    }
+}
+
+const std::string& AudioChannelTrace::getChannel() const {
+    return m_channel;
+}
+
+std::chrono::milliseconds AudioChannelTrace::getLastLatency(Transition transition) const {
+    return m_lastLatency[static_cast<int>(transition)];
+}
+
+void AudioChannelTrace::emitLatency(
+    const std::string& key,
+    Transition transition,
+    Clock::time_point from,
+    Clock::time_point to) {
+    // the transition was not started by a call of the channel, such as a pause made by the platform
+    if (from == Clock::time_point() || to < from) {
+        return;
+    }
+    auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(to - from);
+    m_lastLatency[static_cast<int>(transition)] = latency;
+
+    AACE_DEBUG(LX(TAG, "latency").d("channel", m_channel).d(key.c_str(), latency.count()));
+    aace::engine::utils::metrics::emitMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX,
+        "latency",
+        {},
+        {{"Channel", m_channel}},
+        {{key, static_cast<double>(latency.count())}});
+    record(key, "", from, to - from);
+}
+
+void AudioChannelTrace::record(
+    const std::string& name,
+    const std::string& detail,
+    Clock::time_point start,
+    Clock::duration duration) {
+    auto& state = getState();
+    if (!state.recording) {
+        return;
+    }
+
+    Event event{m_channel, name, detail, start, duration};
+    std::vector<std::shared_ptr<Listener>> listeners;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.events.size() >= MAX_EVENTS) {
+            state.events.pop_front();
+            state.droppedEvents++;
+        }
+        state.events.push_back(event);
+
+        for (auto it = state.listeners.begin(); it != state.listeners.end();) {
+            if (auto listener = it->lock()) {
+                listeners.push_back(listener);
+                it++;
+            } else {
+                it = state.listeners.erase(it);
+            }
+        }
+    }
+
+    // the listeners are called without the lock, so they can record or read the trace
+    for (auto& listener : listeners) {
+        listener->onTraceEvent(event);
+    }
+}
+
+void AudioChannelTrace::start() {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.events.clear();
+    state.droppedEvents = 0;
+    state.origin = Clock::now();
+    state.recording = true;
+}
+
+void AudioChannelTrace::stop() {
+    getState().recording = false;
+}
+
+bool AudioChannelTrace::isRecording() {
+    return getState().recording;
+}
+
+void AudioChannelTrace::addListener(std::shared_ptr<Listener> listener) {
+    if (listener == nullptr) {
+        return;
+    }
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.listeners.push_back(listener);
+}
+
+void AudioChannelTrace::removeListener(std::shared_ptr<Listener> listener) {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.listeners.erase(
+        std::remove_if(
+            state.listeners.begin(),
+            state.listeners.end(),
+            [&listener](const std::weak_ptr<Listener>& next) { return next.lock() == listener; }),
+        state.listeners.end());
+}
+
+void AudioChannelTrace::addTransitionListener(std::shared_ptr<TransitionListener> listener) {
+    if (listener == nullptr) {
+        return;
+    }
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.transitionListeners.push_back(listener);
+    state.hasTransitionListeners = true;
+}
+
+void AudioChannelTrace::removeTransitionListener(std::shared_ptr<TransitionListener> listener) {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.transitionListeners.erase(
+        std::remove_if(
+            state.transitionListeners.begin(),
+            state.transitionListeners.end(),
+            [&listener](const std::weak_ptr<TransitionListener>& next) { return next.lock() == listener; }),
+        state.transitionListeners.end());
+    state.hasTransitionListeners = !state.transitionListeners.empty();
+}
+
+std::vector<std::shared_ptr<AudioChannelTrace::TransitionListener>> AudioChannelTrace::getTransitionListeners() {
+    std::vector<std::shared_ptr<TransitionListener>> listeners;
+    auto& state = getState();
+    if (!state.hasTransitionListeners) {
+        return listeners;
+    }
+    // the listeners are called without the lock, so they can add or remove listeners
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (auto it = state.transitionListeners.begin(); it != state.transitionListeners.end();) {
+        if (auto listener = it->lock()) {
+            listeners.push_back(listener);
+            it++;
+        } else {
+            it = state.transitionListeners.erase(it);
+        }
+    }
+    state.hasTransitionListeners = !state.transitionListeners.empty();
+    return listeners;
+}
+
+std::vector<AudioChannelTrace::Event> AudioChannelTrace::getEvents() {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return std::vector<Event>(state.events.begin(), state.events.end());
+}
+
+std::string AudioChannelTrace::toJson() {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    json::Value traceEvents = json::Value::array();
+    traceEvents.push_back(
+        {{"name", "process_name"}, {"ph", "M"}, {"pid", TRACE_PID}, {"args", {{"name", "Auto SDK Audio Channels"}}}});
+
+    // each channel is a track, numbered in the order the channels first record an event
+    std::map<std::string, int> tracks;
+    for (auto& event : state.events) {
+        auto inserted = tracks.emplace(event.channel, static_cast<int>(tracks.size() + 1));
+        if (inserted.second) {
+            traceEvents.push_back(
+                {{"name", "thread_name"},
+                 {"ph", "M"},
+                 {"pid", TRACE_PID},
+                 {"tid", inserted.first->second},
+                 {"args", {{"name", event.channel}}}});
+        }
+
+        // the times of the trace event format are in microseconds, and the events kept may start before the origin
+        auto ts = std::chrono::duration_cast<std::chrono::microseconds>(event.start - state.origin).count();
+        auto dur = std::chrono::duration_cast<std::chrono::microseconds>(event.duration).count();
+        json::Value traceEvent = {{"name", event.name},
+                                  {"cat", "audioChannel"},
+                                  {"ts", ts},
+                                  {"pid", TRACE_PID},
+                                  {"tid", inserted.first->second}};
+        if (event.duration == Clock::duration::zero()) {
+            traceEvent["ph"] = "i";
+            traceEvent["s"] = "t";
+        } else {
+            traceEvent["ph"] = "X";
+            traceEvent["dur"] = dur;
+        }
+        if (!event.detail.empty()) {
+            traceEvent["args"] = {{"detail", event.detail}};
+        }
+        traceEvents.push_back(traceEvent);
+    }
+
+    json::Value trace = {
+        {"traceEvents", traceEvents},
+        {"displayTimeUnit", "ms"},
+        {"otherData", {{"droppedEvents", state.droppedEvents}}}};
+    return trace.dump();
+}
+
+bool AudioChannelTrace::exportTrace(const std::string& path) {
+    try {
+        std::ofstream file(path, std::ios::trunc);
+        ThrowIfNot(file.is_open(), "openFileFailed");
+        file << toJson();
+        file.close();
+        ThrowIf(file.fail(), "writeFileFailed");
+
+        AACE_INFO(LX(TAG, "exportTrace").d("path", path));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "exportTrace").d("reason", ex.what()).d("path", path));
+        return false;
+    }
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
@@ -28,10 +28,19 @@ using namespace alexaClientSDK::avsCommon::sdkInterfaces;
 
 std::shared_ptr<AuthorizationManager> AuthorizationManager::create(
     std::shared_ptr<AuthorizationManagerStorageInterface> storage) {
+    return create(storage, TokenCacheConfiguration());
+}
+
+std::shared_ptr<AuthorizationManager> AuthorizationManager::create(
+    std::shared_ptr<AuthorizationManagerStorageInterface> storage,
+    const TokenCacheConfiguration& tokenCacheConfiguration) {
     try {
         ThrowIfNull(storage, "invalidStorage");
+        ThrowIf(tokenCacheConfiguration.refreshAfter.count() < 0, "invalidRefreshAfter");
+        ThrowIf(tokenCacheConfiguration.maxAge < tokenCacheConfiguration.refreshAfter, "invalidMaxAge");
 
-        auto authorizationManager = std::shared_ptr<AuthorizationManager>(new AuthorizationManager(storage));
+        auto authorizationManager =
+            std::shared_ptr<AuthorizationManager>(new AuthorizationManager(storage, tokenCacheConfiguration));
 
         ThrowIfNot(authorizationManager->initialize(), "initializeFailed");
 
@@ -42,12 +51,17 @@ std::shared_ptr<AuthorizationManager> AuthorizationManager::create(
     }
 }
 
-AuthorizationManager::AuthorizationManager(std::shared_ptr<AuthorizationManagerStorageInterface> storage) :
+AuthorizationManager::AuthorizationManager(
+    std::shared_ptr<AuthorizationManagerStorageInterface> storage,
+    const TokenCacheConfiguration& tokenCacheConfiguration) :
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
         m_activeAdapter{"", ""},
         m_authState{AuthObserverInterface::State::UNINITIALIZED},
         m_authError{AuthObserverInterface::Error::SUCCESS},
-        m_storage(storage) {
+        m_storage(storage),
+        m_tokenCacheConfiguration(tokenCacheConfiguration),
+        m_tokenGeneration{0},
+        m_tokenRefreshPending{false} {
 }
 
 bool AuthorizationManager::initialize() {
@@ -119,6 +133,7 @@ AuthorizationManager::StartAuthorizationResult AuthorizationManager::startAuthor
             } else {
                 // Unlock the activeAdapterLock function of AuthDelegateInterface could get called.
                 activeAdapterLock.unlock();
+                invalidateAuthToken();
                 updateAuthStateAndNotifyAuthObservers(State::UNINITIALIZED, Error::SUCCESS);
                 ThrowIfNot(performLogoutLocked(), "performLogoutLockedFailed");
 
@@ -126,6 +141,8 @@ AuthorizationManager::StartAuthorizationResult AuthorizationManager::startAuthor
                 activeAdapterLock.lock();
                 performDeregisterLocked();
                 m_activeAdapter = {service, "NOT_AUTHORIZED"};
+                // drop the token of the previous adapter fetched since
+                invalidateAuthToken();
                 ThrowIfNot(saveCurrentAdapterStateLocked(), "saveCurrentAdapterStateLockedFailed");
 
                 return StartAuthorizationResult::AUTHORIZE;
@@ -238,6 +255,8 @@ void AuthorizationManager::authStateChanged(const std::string& service, State st
             }
             // Unlock the activeAdapterLock function of AuthDelegateInterface could get called.
             activeAdapterLock.unlock();
+            // the adapter may have a new token, or none, in any new state
+            invalidateAuthToken();
             updateAuthStateAndNotifyAuthObservers(state, reason);
         } else {
             Throw("notActiveService");
@@ -262,6 +281,7 @@ bool AuthorizationManager::logout(const std::string& service) {
         if (m_activeAdapter.first == service) {
             // Unlock the activeAdapterLock function of AuthDelegateInterface could get called.
             activeAdapterLock.unlock();
+            invalidateAuthToken();
             updateAuthStateAndNotifyAuthObservers(State::UNINITIALIZED, Error::SUCCESS);
             ThrowIfNot(performLogoutLocked(), "performLogoutLockedFailed");
 
@@ -269,6 +289,7 @@ bool AuthorizationManager::logout(const std::string& service) {
             activeAdapterLock.lock();
             performDeregisterLocked();
             m_activeAdapter = {"", ""};
+            invalidateAuthToken();
             ThrowIfNot(clearAdapterStateLocked(), "clearAdapterStateFailed");
 
             return true;
@@ -329,25 +350,93 @@ void AuthorizationManager::removeListener(std::shared_ptr<MetricsEmissionListene
 }
 
 std::string AuthorizationManager::getAuthToken() {
+    // The token is read without locking, since it is called for each request sent to AVS.
+    auto cachedToken = std::atomic_load(&m_cachedToken);
+    if (cachedToken != nullptr) {
+        auto age = std::chrono::steady_clock::now() - cachedToken->fetchTime;
+        if (age < m_tokenCacheConfiguration.maxAge) {
+            if (age >= m_tokenCacheConfiguration.refreshAfter) {
+                requestBackgroundTokenRefresh();
+            }
+            return cachedToken->token;
+        }
+    }
+    return fetchAuthToken();
+}
+
+std::string AuthorizationManager::fetchAuthToken() {
+    std::lock_guard<std::mutex> fetchLock(m_tokenFetchMutex);
+
+    // Another fetch may have completed while this one waited for it.
+    auto cachedToken = std::atomic_load(&m_cachedToken);
+    if (cachedToken != nullptr &&
+        std::chrono::steady_clock::now() - cachedToken->fetchTime < m_tokenCacheConfiguration.refreshAfter) {
+        return cachedToken->token;
+    }
+
+    std::string service;
     try {
-        std::lock_guard<std::mutex> lock(m_activeAdapterMutex);
-        ThrowIf(m_activeAdapter.first.empty(), "noActiveAuthorization");
-        // Shutdown may have be called or authorization adapter is not registered
-        ThrowIf(
-            m_serviceAndAuthorizationAdapterMap.find(m_activeAdapter.first) ==
-                m_serviceAndAuthorizationAdapterMap.end(),
-            "adapterNotRegistered");
+        std::shared_ptr<AuthorizationAdapterInterface> adapter;
+        uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(m_activeAdapterMutex);
+            service = m_activeAdapter.first;
+            ThrowIf(service.empty(), "noActiveAuthorization");
+            // Shutdown may have be called or authorization adapter is not registered
+            auto it = m_serviceAndAuthorizationAdapterMap.find(service);
+            ThrowIf(it == m_serviceAndAuthorizationAdapterMap.end(), "adapterNotRegistered");
+            adapter = it->second;
+
+            std::lock_guard<std::mutex> cacheLock(m_tokenCacheMutex);
+            generation = m_tokenGeneration;
+        }
+
+        auto fetchTime = std::chrono::steady_clock::now();
+        auto token = adapter->getAuthToken();
 
-        return m_serviceAndAuthorizationAdapterMap.at(m_activeAdapter.first)->getAuthToken();
+        // An empty token is not cached, so the next call asks the adapter again.
+        if (!token.empty()) {
+            std::lock_guard<std::mutex> cacheLock(m_tokenCacheMutex);
+            if (generation == m_tokenGeneration) {
+                std::atomic_store(
+                    &m_cachedToken, std::make_shared<const CachedToken>(CachedToken{token, fetchTime}));
+            }
+        }
+        return token;
     } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("activeAdapter", m_activeAdapter.first));
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("activeAdapter", service));
         return "";
     }
 }
 
+void AuthorizationManager::requestBackgroundTokenRefresh() {
+    if (m_tokenRefreshPending.exchange(true)) {
+        return;
+    }
+    std::weak_ptr<AuthorizationManager> wp = shared_from_this();
+    m_tokenRefreshExecutor.submit([wp]() {
+        if (auto authorizationManager = wp.lock()) {
+            authorizationManager->fetchAuthToken();
+            authorizationManager->m_tokenRefreshPending = false;
+        }
+    });
+}
+
+void AuthorizationManager::invalidateAuthToken() {
+    std::lock_guard<std::mutex> lock(m_tokenCacheMutex);
+    m_tokenGeneration++;
+    std::atomic_store(&m_cachedToken, std::shared_ptr<const CachedToken>());
+}
+
 void AuthorizationManager::onAuthFailure(const std::string& token) {
     AACE_DEBUG(LX(TAG));
     try {
+        // AVS rejected the token, so it is not used again
+        auto cachedToken = std::atomic_load(&m_cachedToken);
+        if (cachedToken != nullptr && (token.empty() || token == cachedToken->token)) {
+            invalidateAuthToken();
+        }
+
         std::lock_guard<std::mutex> lock(m_activeAdapterMutex);
         ThrowIf(m_activeAdapter.first.empty(), "noActiveAuthorization");
         // Shutdown may have be called or authorization adapter is not registered
@@ -364,6 +453,8 @@ void AuthorizationManager::onAuthFailure(const std::string& token) {
 
 void AuthorizationManager::doShutdown() {
     AACE_DEBUG(LX(TAG));
+    m_tokenRefreshExecutor.shutdown();
+    invalidateAuthToken();
     std::unique_lock<std::mutex> lock(m_callMutex);
     m_registrationManager.reset();
     m_authDelegateObservers.clear();
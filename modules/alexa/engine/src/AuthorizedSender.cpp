@@ -32,6 +32,8 @@ namespace alexa {
 using namespace alexaClientSDK::avsCommon::sdkInterfaces;
 using namespace alexaClientSDK::avsCommon::utils::json::jsonUtils;
 
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
 /// String to identify log entries originating from this file.
 static const std::string TAG("AuthorizedSender");
 
@@ -47,7 +49,19 @@ static const std::string PAYLOAD_KEY = "payload";
 /// The playerId key.
 static const std::string PLAYER_ID_KEY = "playerId";
 
-std::shared_ptr<AuthorizedSender> AuthorizedSender::create(std::shared_ptr<MessageSenderInterface> messageSender) {
+AuthorizedSender::PlayerMessageRequest::PlayerMessageRequest(
+    const std::string& playerId,
+    const std::string& jsonContent) :
+        MessageRequest{jsonContent}, m_playerId{playerId} {
+}
+
+const std::string& AuthorizedSender::PlayerMessageRequest::getPlayerId() const {
+    return m_playerId;
+}
+
+std::shared_ptr<AuthorizedSender> AuthorizedSender::create(
+    std::shared_ptr<MessageSenderInterface> messageSender,
+    std::chrono::milliseconds batchWindow) {
     AACE_VERBOSE(LX(TAG));
 
     if (!messageSender) {
@@ -55,20 +69,39 @@ std::shared_ptr<AuthorizedSender> AuthorizedSender::create(std::shared_ptr<Messa
         return nullptr;
     }
 
-    return std::shared_ptr<AuthorizedSender>(new AuthorizedSender(messageSender));
+    if (batchWindow < std::chrono::milliseconds::zero()) {
+        AACE_ERROR(LX("createFailed").d("reason", "invalidBatchWindow").d("batchWindow", batchWindow.count()));
+        return nullptr;
+    }
+
+    return std::shared_ptr<AuthorizedSender>(new AuthorizedSender(messageSender, batchWindow));
 }
 
-AuthorizedSender::AuthorizedSender(std::shared_ptr<MessageSenderInterface> messageSender) :
-        m_messageSender{messageSender} {
+AuthorizedSender::AuthorizedSender(
+    std::shared_ptr<MessageSenderInterface> messageSender,
+    std::chrono::milliseconds batchWindow) :
+        m_messageSender{messageSender}, m_batchWindow{batchWindow}, m_batchTimer{TimerWheel::INVALID_TIMER} {
 }
 
 AuthorizedSender::~AuthorizedSender() {
+    std::vector<PendingMessage> pendingMessages;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMessagesMutex);
+        if (m_batchTimer != TimerWheel::INVALID_TIMER) {
+            TimerWheel::getDefault()->cancel(m_batchTimer);
+            m_batchTimer = TimerWheel::INVALID_TIMER;
+        }
+        pendingMessages.swap(m_pendingMessages);
+    }
+    for (auto& message : pendingMessages) {
+        message.second->sendCompleted(MessageRequestObserverInterface::Status::CANCELED);
+    }
     m_executor.shutdown();
 }
 
-void AuthorizedSender::sendMessage(std::shared_ptr<alexaClientSDK::avsCommon::avs::MessageRequest> request) {
-    AACE_VERBOSE(LX(TAG));
-
+bool AuthorizedSender::parsePlayerId(
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::MessageRequest> request,
+    std::string& playerId) {
     rapidjson::Document document;
     rapidjson::ParseResult result = document.Parse(request->getJsonContent().c_str());
     if (!result) {
@@ -76,48 +109,90 @@ void AuthorizedSender::sendMessage(std::shared_ptr<alexaClientSDK::avsCommon::av
                        .d("reason", "parseFailed")
                        .d("error", GetParseError_En(result.Code()))
                        .d("offset", result.Offset()));
-        request->sendCompleted(MessageRequestObserverInterface::Status::BAD_REQUEST);
-        return;
+        return false;
     }
 
     rapidjson::Value::ConstMemberIterator event;
     if (!findNode(document, EVENT_KEY, &event)) {
-        request->sendCompleted(MessageRequestObserverInterface::Status::BAD_REQUEST);
-        return;
+        return false;
     }
 
     rapidjson::Value::ConstMemberIterator header;
-
     if (!findNode(event->value, HEADER_KEY, &header)) {
-        request->sendCompleted(MessageRequestObserverInterface::Status::BAD_REQUEST);
-        return;
+        return false;
     }
 
     rapidjson::Value::ConstMemberIterator payload;
     if (!findNode(event->value, PAYLOAD_KEY, &payload)) {
-        request->sendCompleted(MessageRequestObserverInterface::Status::BAD_REQUEST);
-        return;
+        return false;
     }
 
+    return retrieveValue(payload->value, PLAYER_ID_KEY, &playerId);
+}
+
+void AuthorizedSender::sendMessage(std::shared_ptr<alexaClientSDK::avsCommon::avs::MessageRequest> request) {
+    AACE_VERBOSE(LX(TAG));
+
+    // the events built for a player are tagged with its playerId, the other events are parsed to find it
     std::string playerId;
-    if (!retrieveValue(payload->value, PLAYER_ID_KEY, &playerId)) {
+    auto playerRequest = std::dynamic_pointer_cast<PlayerMessageRequest>(request);
+    if (playerRequest) {
+        playerId = playerRequest->getPlayerId();
+    } else if (!parsePlayerId(request, playerId)) {
         request->sendCompleted(MessageRequestObserverInterface::Status::BAD_REQUEST);
         return;
     }
 
-    // Serialize calls to sendMessage to ensure authorizedPlayer updates mid-message sending are handled properly
-    m_executor.submit([this, playerId, request]() {
-        std::lock_guard<std::mutex> lock(m_updatePlayersMutex);
+    if (m_batchWindow == std::chrono::milliseconds::zero()) {
+        // Serialize calls to sendMessage to ensure authorizedPlayer updates mid-message sending are handled properly
+        m_executor.submit([this, playerId, request]() {
+            std::lock_guard<std::mutex> lock(m_updatePlayersMutex);
+            sendAuthorizedMessageLocked(PendingMessage(playerId, request));
+        });
+        return;
+    }
 
-        if (m_authorizedPlayerIds.count(playerId) == 0) {
-            AACE_ERROR(LX("sendMessageFailed").d("reason", "unauthorizedPlayer").d("playerId", playerId));
-            request->sendCompleted(MessageRequestObserverInterface::Status::BAD_REQUEST);
-            return;
+    std::lock_guard<std::mutex> lock(m_pendingMessagesMutex);
+    m_pendingMessages.emplace_back(playerId, request);
+    if (m_batchTimer == TimerWheel::INVALID_TIMER) {
+        std::weak_ptr<AuthorizedSender> wp = shared_from_this();
+        m_batchTimer = TimerWheel::getDefault()->submitAfter(m_batchWindow, [wp]() {
+            if (auto authorizedSender = wp.lock()) {
+                authorizedSender->flushPendingMessages();
+            }
+        });
+    }
+}
+
+void AuthorizedSender::flushPendingMessages() {
+    std::vector<PendingMessage> pendingMessages;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMessagesMutex);
+        m_batchTimer = TimerWheel::INVALID_TIMER;
+        pendingMessages.swap(m_pendingMessages);
+    }
+    if (pendingMessages.empty()) {
+        return;
+    }
+
+    // the batch is sent with the authorized players of a single update
+    m_executor.submit([this, pendingMessages]() {
+        std::lock_guard<std::mutex> lock(m_updatePlayersMutex);
+        for (auto& message : pendingMessages) {
+            sendAuthorizedMessageLocked(message);
         }
-        m_messageSender->sendMessage(request);
     });
 }
 
+void AuthorizedSender::sendAuthorizedMessageLocked(const PendingMessage& message) {
+    if (m_authorizedPlayerIds.count(message.first) == 0) {
+        AACE_ERROR(LX("sendMessageFailed").d("reason", "unauthorizedPlayer").d("playerId", message.first));
+        message.second->sendCompleted(MessageRequestObserverInterface::Status::BAD_REQUEST);
+        return;
+    }
+    m_messageSender->sendMessage(message.second);
+}
+
 void AuthorizedSender::updateAuthorizedPlayers(const std::unordered_set<std::string>& playerIds) {
     AACE_VERBOSE(LX(TAG));
 
@@ -52,14 +52,15 @@ std::shared_ptr<ChannelVolumeManager> ChannelVolumeManager::create(
     std::shared_ptr<SpeakerInterface> speaker,
     ChannelVolumeInterface::Type type,
     VolumeCurveFunction volumeCurve,
-    std::shared_ptr<DuckingInterface> duckingInterface) {
+    std::shared_ptr<DuckingInterface> duckingInterface,
+    std::shared_ptr<DuckingMixer> duckingMixer) {
     if (!speaker) {
         AACE_ERROR(LX(__func__).d("reason", "Null SpeakerInterface").m("createFailed"));
         return nullptr;
     }
 
-    auto channelVolumeManager =
-        std::shared_ptr<ChannelVolumeManager>(new ChannelVolumeManager(speaker, type, volumeCurve, duckingInterface));
+    auto channelVolumeManager = std::shared_ptr<ChannelVolumeManager>(
+        new ChannelVolumeManager(speaker, type, volumeCurve, duckingInterface, duckingMixer));
 
     /// Retrieve initial volume setting from underlying speakers
     SpeakerInterface::SpeakerSettings settings;
@@ -76,13 +77,15 @@ ChannelVolumeManager::ChannelVolumeManager(
     std::shared_ptr<SpeakerInterface> speaker,
     ChannelVolumeInterface::Type type,
     VolumeCurveFunction volumeCurve,
-    std::shared_ptr<DuckingInterface> duckingInterface) :
+    std::shared_ptr<DuckingInterface> duckingInterface,
+    std::shared_ptr<DuckingMixer> duckingMixer) :
         ChannelVolumeInterface{},
         m_speaker{speaker},
         m_isDucked{false},
         m_unduckedVolume{AVS_SET_VOLUME_MIN},
         m_volumeCurveFunction{volumeCurve ? volumeCurve : defaultVolumeAttenuateFunction},
         m_DuckingInterface(duckingInterface),
+        m_duckingMixer(duckingMixer),
         m_type{type} {
 }
 
@@ -106,6 +109,9 @@ bool ChannelVolumeManager::startDucking() {
     if (!m_DuckingInterface) {
         AACE_WARN(LX(__func__).m("Ducking interface is misssing"));
         return false;
+    } else if (m_duckingMixer) {
+        // applied with the changes of the other channels
+        m_duckingMixer->setDucked(m_DuckingInterface, true);
     } else if (!m_DuckingInterface->startDucking()) {
         AACE_WARN(LX(__func__).m("Failed to start ducking"));
         return false;
@@ -127,6 +133,9 @@ bool ChannelVolumeManager::stopDucking() {
     if (!m_DuckingInterface) {
         AACE_WARN(LX(__func__).m("Ducking interface is misssing"));
         return false;
+    } else if (m_duckingMixer) {
+        // restored once the focus has settled, unless the channel is ducked again meanwhile
+        m_duckingMixer->setDucked(m_DuckingInterface, false);
     } else if (!m_DuckingInterface->stopDucking()) {
         return false;
     }
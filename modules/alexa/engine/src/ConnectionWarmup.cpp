@@ -0,0 +1,180 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include <algorithm>
+#include <future>
+
+#include <AACE/Engine/Alexa/ConnectionWarmup.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+using namespace aace::engine::utils::metrics;
+using ConnectionStatusObserverInterface = alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.ConnectionWarmup");
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "ConnectionWarmup";
+
+/// Metric for the time from the network being connected to the AVS connection being connected
+static const std::string METRIC_TIME_TO_READY = "TimeToReady";
+
+/// Metric for the time to resolve the hosts of a warmup
+static const std::string METRIC_RESOLVE_LATENCY = "Resolve.Latency";
+
+/// Metric for a host that could not be resolved
+static const std::string METRIC_RESOLVE_FAILURE = "Resolve.Failure";
+
+std::shared_ptr<ConnectionWarmup> ConnectionWarmup::create(Resolver resolver) {
+    try {
+        ThrowIfNot(resolver, "invalidResolver");
+        return std::shared_ptr<ConnectionWarmup>(new ConnectionWarmup(std::move(resolver)));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+ConnectionWarmup::ConnectionWarmup(Resolver resolver) : m_resolver(std::move(resolver)) {
+}
+
+ConnectionWarmup::~ConnectionWarmup() {
+    shutdown();
+}
+
+void ConnectionWarmup::onNetworkConnected(const std::vector<std::string>& urls) {
+    std::vector<std::string> hosts;
+    for (const auto& url : urls) {
+        auto host = getHost(url);
+        if (!host.empty() && std::find(hosts.begin(), hosts.end(), host) == hosts.end()) {
+            hosts.push_back(host);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_isShutdown) {
+        return;
+    }
+    AACE_DEBUG(LX(TAG).d("hosts", hosts.size()));
+    m_warmingUp = true;
+    auto warmupId = ++m_warmupId;
+    m_networkConnectedTime = std::chrono::steady_clock::now();
+    m_executor.submit([this, hosts, warmupId] { executeResolve(hosts, warmupId); });
+}
+
+void ConnectionWarmup::onNetworkDisconnected() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_warmingUp) {
+        AACE_DEBUG(LX(TAG).m("warmupCancelled"));
+        m_warmingUp = false;
+        m_warmupId++;
+    }
+}
+
+void ConnectionWarmup::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShutdown = true;
+        m_warmingUp = false;
+        m_warmupId++;
+    }
+    m_executor.shutdown();
+}
+
+void ConnectionWarmup::executeResolve(const std::vector<std::string>& hosts, uint64_t warmupId) {
+    {
+        // a warmup queued behind a slow resolution may be cancelled by the time it runs
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (warmupId != m_warmupId) {
+            return;
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<bool>> results;
+    for (const auto& host : hosts) {
+        results.push_back(std::async(std::launch::async, m_resolver, host));
+    }
+    for (size_t index = 0; index < hosts.size(); index++) {
+        if (!results[index].get()) {
+            AACE_WARN(LX(TAG).m("resolveFailed").sensitive("host", hosts[index]));
+            emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "executeResolve", {METRIC_RESOLVE_FAILURE});
+        }
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    AACE_DEBUG(LX(TAG).d("resolveDuration", duration.count()));
+    emitTimerMetrics(METRIC_PROGRAM_NAME_SUFFIX, "executeResolve", METRIC_RESOLVE_LATENCY, duration.count());
+}
+
+std::string ConnectionWarmup::getHost(const std::string& url) {
+    auto start = url.find("://");
+    start = start == std::string::npos ? 0 : start + 3;
+    // skip the user information, if any
+    auto authorityEnd = url.find_first_of("/?#", start);
+    auto at = url.rfind('@', authorityEnd == std::string::npos ? url.size() : authorityEnd);
+    if (at != std::string::npos && at >= start) {
+        start = at + 1;
+    }
+    if (start < url.size() && url[start] == '[') {
+        // an IPv6 literal is already an address
+        return "";
+    }
+    auto end = url.find_first_of(":/?#", start);
+    return url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
+bool ConnectionWarmup::resolveHost(const std::string& host) {
+    struct addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* result = nullptr;
+    auto error = getaddrinfo(host.c_str(), nullptr, &hints, &result);
+    if (result != nullptr) {
+        freeaddrinfo(result);
+    }
+    return error == 0;
+}
+
+void ConnectionWarmup::onConnectionStatusChanged(
+    const ConnectionStatusObserverInterface::Status status,
+    const ConnectionStatusObserverInterface::ChangedReason reason) {
+    if (status != ConnectionStatusObserverInterface::Status::CONNECTED) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_warmingUp) {
+        return;
+    }
+    m_warmingUp = false;
+    auto timeToReady = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_networkConnectedTime);
+    lock.unlock();
+
+    AACE_INFO(LX(TAG).d("timeToReady", timeToReady.count()));
+    emitTimerMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX, "onConnectionStatusChanged", METRIC_TIME_TO_READY, timeToReady.count());
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
@@ -22,10 +22,10 @@
 #include <Settings/SettingEventMetadata.h>
 #include <Settings/SettingEventSender.h>
 #include <Settings/SharedAVSSettingProtocol.h>
-#include <Settings/Storage/SQLiteDeviceSettingStorage.h>
 #include <System/LocaleHandler.h>
 #include <System/TimeZoneHandler.h>
 
+#include "AACE/Engine/Alexa/DeviceSettingsSnapshotStorage.h"
 #include "AACE/Engine/Core/EngineMacros.h"
 
 namespace aace {
@@ -60,8 +60,8 @@ std::unique_ptr<DeviceSettingsDelegate> DeviceSettingsDelegate::createDeviceSett
         return nullptr;
     }
 
-    auto deviceSettingStorage =
-        alexaClientSDK::settings::storage::SQLiteDeviceSettingStorage::create(configurationRoot);
+    // the settings are read from the database at once when it is opened, and each setting is restored from them
+    auto deviceSettingStorage = DeviceSettingsSnapshotStorage::create(configurationRoot);
     if (deviceSettingStorage == nullptr) {
         AACE_ERROR(LX("initializeFailed").d("reason", "unable to create deviceSettingStorage"));
         return nullptr;
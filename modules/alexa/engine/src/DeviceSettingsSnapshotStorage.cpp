@@ -0,0 +1,204 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AACE/Engine/Alexa/DeviceSettingsSnapshotStorage.h"
+
+#include <Settings/SettingStatus.h>
+#include <Settings/Storage/SQLiteDeviceSettingStorage.h>
+#include <SQLiteStorage/SQLiteDatabase.h>
+#include <SQLiteStorage/SQLiteStatement.h>
+
+#include "AACE/Engine/Core/EngineMacros.h"
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+using SettingStatus = alexaClientSDK::settings::SettingStatus;
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.DeviceSettingsSnapshotStorage");
+
+/// The configuration of the device settings database
+static const std::string DEVICE_SETTINGS_CONFIGURATION_ROOT_KEY = "deviceSettings";
+static const std::string DATABASE_FILE_PATH_KEY = "databaseFilePath";
+
+/// The query reading all the settings, from the table of @c SQLiteDeviceSettingStorage
+static const std::string SELECT_ALL_SETTINGS = "SELECT key, value, status FROM deviceSettings;";
+
+std::shared_ptr<DeviceSettingsSnapshotStorage> DeviceSettingsSnapshotStorage::create(
+    const alexaClientSDK::avsCommon::utils::configuration::ConfigurationNode& configurationRoot) {
+    try {
+        std::string databaseFilePath;
+        ThrowIfNot(
+            configurationRoot[DEVICE_SETTINGS_CONFIGURATION_ROOT_KEY].getString(
+                DATABASE_FILE_PATH_KEY, &databaseFilePath),
+            "missingDatabaseFilePath");
+
+        std::shared_ptr<alexaClientSDK::settings::storage::DeviceSettingStorageInterface> storage =
+            alexaClientSDK::settings::storage::SQLiteDeviceSettingStorage::create(configurationRoot);
+        ThrowIfNull(storage, "createDeviceSettingStorageFailed");
+
+        return create(storage, databaseFilePath);
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+std::shared_ptr<DeviceSettingsSnapshotStorage> DeviceSettingsSnapshotStorage::create(
+    std::shared_ptr<alexaClientSDK::settings::storage::DeviceSettingStorageInterface> storage,
+    const std::string& databaseFilePath) {
+    try {
+        ThrowIfNull(storage, "invalidStorage");
+        ThrowIf(databaseFilePath.empty(), "invalidDatabaseFilePath");
+        return std::shared_ptr<DeviceSettingsSnapshotStorage>(
+            new DeviceSettingsSnapshotStorage(storage, databaseFilePath));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+DeviceSettingsSnapshotStorage::DeviceSettingsSnapshotStorage(
+    std::shared_ptr<alexaClientSDK::settings::storage::DeviceSettingStorageInterface> storage,
+    const std::string& databaseFilePath) :
+        m_storage(storage), m_databaseFilePath(databaseFilePath) {
+}
+
+size_t DeviceSettingsSnapshotStorage::getSnapshotSize() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_snapshot.size();
+}
+
+bool DeviceSettingsSnapshotStorage::open() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // the storage creates the database and its table if they don't exist
+    if (!m_storage->open()) {
+        return false;
+    }
+    m_snapshotRead = readSnapshotLocked();
+    if (!m_snapshotRead) {
+        m_snapshot.clear();
+        AACE_WARN(LX(TAG).m("Reading the settings from the database one at a time"));
+    }
+    return true;
+}
+
+bool DeviceSettingsSnapshotStorage::readSnapshotLocked() {
+    try {
+        alexaClientSDK::storage::sqliteStorage::SQLiteDatabase database(m_databaseFilePath);
+        ThrowIfNot(database.open(), "openDatabaseFailed");
+
+        // a single statement reads a consistent snapshot of the table
+        auto statement = database.createStatement(SELECT_ALL_SETTINGS);
+        if (statement == nullptr) {
+            database.close();
+            Throw("createStatementFailed");
+        }
+
+        m_snapshot.clear();
+        bool succeeded = statement->step();
+        while (succeeded && statement->getStepResult() == SQLITE_ROW) {
+            m_snapshot[statement->getColumnText(0)] = std::make_pair(
+                alexaClientSDK::settings::stringToSettingStatus(statement->getColumnText(2)),
+                statement->getColumnText(1));
+            succeeded = statement->step();
+        }
+        statement->finalize();
+        database.close();
+        ThrowIfNot(succeeded, "readSettingsFailed");
+
+        AACE_DEBUG(LX(TAG).d("settings", m_snapshot.size()));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("path", m_databaseFilePath));
+        return false;
+    }
+}
+
+void DeviceSettingsSnapshotStorage::close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_storage->close();
+    m_snapshot.clear();
+    m_snapshotRead = false;
+}
+
+bool DeviceSettingsSnapshotStorage::storeSetting(
+    const std::string& key,
+    const std::string& value,
+    SettingStatus status) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_storage->storeSetting(key, value, status)) {
+        return false;
+    }
+    if (m_snapshotRead) {
+        m_snapshot[key] = std::make_pair(status, value);
+    }
+    return true;
+}
+
+bool DeviceSettingsSnapshotStorage::storeSettings(
+    const std::vector<std::tuple<std::string, std::string, SettingStatus>>& data) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_storage->storeSettings(data)) {
+        return false;
+    }
+    if (m_snapshotRead) {
+        for (auto& next : data) {
+            m_snapshot[std::get<0>(next)] = std::make_pair(std::get<2>(next), std::get<1>(next));
+        }
+    }
+    return true;
+}
+
+DeviceSettingsSnapshotStorage::SettingStatusAndValue DeviceSettingsSnapshotStorage::loadSetting(
+    const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_snapshotRead) {
+        return m_storage->loadSetting(key);
+    }
+    auto it = m_snapshot.find(key);
+    if (it == m_snapshot.end()) {
+        // the setting isn't in the database
+        return std::make_pair(SettingStatus::NOT_AVAILABLE, "");
+    }
+    return it->second;
+}
+
+bool DeviceSettingsSnapshotStorage::deleteSetting(const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_storage->deleteSetting(key)) {
+        return false;
+    }
+    m_snapshot.erase(key);
+    return true;
+}
+
+bool DeviceSettingsSnapshotStorage::updateSettingStatus(const std::string& key, SettingStatus status) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_storage->updateSettingStatus(key, status)) {
+        return false;
+    }
+    auto it = m_snapshot.find(key);
+    if (it != m_snapshot.end()) {
+        it->second.first = status;
+    }
+    return true;
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include "AACE/Engine/Alexa/DuckingMixer.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.DuckingMixer");
+
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+const std::chrono::milliseconds DuckingMixer::DEFAULT_RELEASE_TIME(200);
+
+std::shared_ptr<DuckingMixer> DuckingMixer::create(std::chrono::milliseconds releaseTime) {
+    return std::shared_ptr<DuckingMixer>(new DuckingMixer(std::max(releaseTime, std::chrono::milliseconds::zero())));
+}
+
+std::shared_ptr<DuckingMixer> DuckingMixer::getDefault() {
+    // never destroyed, so the channels destroyed during static destruction can still be restored
+    static std::shared_ptr<DuckingMixer>* s_defaultMixer = new std::shared_ptr<DuckingMixer>(create());
+    return *s_defaultMixer;
+}
+
+DuckingMixer::DuckingMixer(std::chrono::milliseconds releaseTime) :
+        m_releaseTime{releaseTime},
+        m_applyQueued{false},
+        m_releaseTimer{TimerWheel::INVALID_TIMER},
+        m_shutdown{false},
+        m_requestCount{0},
+        m_executor{"DuckingMixer"} {
+}
+
+DuckingMixer::~DuckingMixer() {
+    shutdown();
+}
+
+void DuckingMixer::setDucked(std::shared_ptr<DuckingInterface> channel, bool ducked) {
+    try {
+        ThrowIfNull(channel, "invalidChannel");
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ThrowIf(m_shutdown, "mixerShutdown");
+
+        auto it = std::find_if(m_channels.begin(), m_channels.end(), [&channel](const Channel& next) {
+            return next.key == channel.get();
+        });
+        if (it == m_channels.end()) {
+            m_channels.push_back({channel, channel.get(), false, false});
+            it = m_channels.end() - 1;
+        } else if (it->channel.expired()) {
+            // a new channel at the address of a destroyed one
+            *it = {channel, channel.get(), false, false};
+        }
+        it->target = ducked;
+        m_requestCount++;
+
+        if (it->target == it->applied) {
+            // a restore cancelled by a new ducking, or a repeated request
+            return;
+        }
+        if (ducked) {
+            scheduleApplyLocked();
+        } else {
+            restartReleaseTimerLocked();
+        }
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("ducked", ducked));
+    }
+}
+
+void DuckingMixer::flush() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        cancelReleaseTimerLocked();
+    }
+    auto applied = m_executor.submit([this]() { apply(true); });
+    if (applied.valid()) {
+        applied.wait();
+    }
+}
+
+size_t DuckingMixer::getPendingCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::count_if(m_channels.begin(), m_channels.end(), [](const Channel& next) {
+        return next.target != next.applied && !next.channel.expired();
+    });
+}
+
+void DuckingMixer::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+        cancelReleaseTimerLocked();
+        m_channels.clear();
+    }
+    m_executor.shutdown();
+}
+
+void DuckingMixer::scheduleApplyLocked() {
+    if (!m_applyQueued) {
+        m_applyQueued = m_executor.post([this]() { apply(false); });
+    }
+}
+
+void DuckingMixer::restartReleaseTimerLocked() {
+    cancelReleaseTimerLocked();
+
+    // the timer runs on the timer thread, which must not call the channels
+    std::weak_ptr<DuckingMixer> wp = shared_from_this();
+    m_releaseTimer = TimerWheel::getDefault()->submitAfter(m_releaseTime, [wp]() {
+        if (auto mixer = wp.lock()) {
+            auto raw = mixer.get();
+            mixer->m_executor.post([raw]() { raw->apply(true); });
+        }
+    });
+}
+
+void DuckingMixer::cancelReleaseTimerLocked() {
+    if (m_releaseTimer != TimerWheel::INVALID_TIMER) {
+        TimerWheel::getDefault()->cancel(m_releaseTimer);
+        m_releaseTimer = TimerWheel::INVALID_TIMER;
+    }
+}
+
+void DuckingMixer::apply(bool release) {
+    std::vector<std::pair<std::shared_ptr<DuckingInterface>, bool>> changes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!release) {
+            m_applyQueued = false;
+        }
+        for (auto it = m_channels.begin(); it != m_channels.end();) {
+            auto channel = it->channel.lock();
+            if (channel == nullptr) {
+                it = m_channels.erase(it);
+                continue;
+            }
+            if (it->target != it->applied && (it->target || release)) {
+                changes.emplace_back(channel, it->target);
+                it->applied = it->target;
+            }
+            it++;
+        }
+        if (!changes.empty()) {
+            AACE_DEBUG(LX(TAG).d("changes", changes.size()).d("requests", m_requestCount).d("release", release));
+        }
+        m_requestCount = 0;
+    }
+
+    if (changes.empty()) {
+        return;
+    }
+
+    // duck before restoring, so the channels never play over each other at full volume
+    std::stable_partition(
+        changes.begin(), changes.end(), [](const std::pair<std::shared_ptr<DuckingInterface>, bool>& change) {
+            return change.second;
+        });
+    for (auto& change : changes) {
+        auto ducked = change.second;
+        try {
+            ThrowIfNot(ducked ? change.first->startDucking() : change.first->stopDucking(), "applyFailed");
+            continue;
+        } catch (std::exception& ex) {
+            AACE_ERROR(LX(TAG, "apply").d("reason", ex.what()).d("ducked", ducked));
+        }
+
+        // the channel is applied again with the next change
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_channels.begin(), m_channels.end(), [&change](const Channel& next) {
+            return next.key == change.first.get();
+        });
+        if (it != m_channels.end() && it->applied == ducked) {
+            it->applied = !ducked;
+        }
+    }
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
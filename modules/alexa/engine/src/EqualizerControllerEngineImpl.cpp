@@ -23,6 +23,8 @@ namespace engine {
 namespace alexa {
 
 using namespace aace::engine::utils::metrics;
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+using EqualizerBandLevelMap = alexaClientSDK::acsdkEqualizerInterfaces::EqualizerBandLevelMap;
 
 /// String to identify log entries originating from this file
 static const std::string TAG("aace.alexa.EqualizerControllerEngineImpl");
@@ -39,11 +41,17 @@ static const std::string METRIC_EQUALIZER_CONTROLLER_GET_BAND_LEVELS = "GetBandL
 static const std::string METRIC_EQUALIZER_CONTROLLER_LOCAL_SET_BAND_LEVELS = "LocalSetBandLevels";
 static const std::string METRIC_EQUALIZER_CONTROLLER_LOCAL_ADJUST_BAND_LEVELS = "LocalAdjustBandLevels";
 static const std::string METRIC_EQUALIZER_CONTROLLER_LOCAL_RESET_BANDS = "LocalResetBands";
+static const std::string METRIC_EQUALIZER_CONTROLLER_BAND_LEVELS_REPORTED = "BandLevelsReported";
+
+const std::chrono::milliseconds EqualizerControllerEngineImpl::DEFAULT_BAND_LEVEL_REPORT_DELAY(300);
 
 EqualizerControllerEngineImpl::EqualizerControllerEngineImpl(
-    std::shared_ptr<aace::alexa::EqualizerController> equalizerPlatformInterface) :
+    std::shared_ptr<aace::alexa::EqualizerController> equalizerPlatformInterface,
+    std::chrono::milliseconds bandLevelReportDelay) :
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
-        m_equalizerPlatformInterface(equalizerPlatformInterface) {
+        m_equalizerPlatformInterface(equalizerPlatformInterface),
+        m_bandLevelReportDelay(bandLevelReportDelay),
+        m_executor("EqualizerController") {
 }
 
 bool EqualizerControllerEngineImpl::initialize(
@@ -105,13 +113,15 @@ std::shared_ptr<EqualizerControllerEngineImpl> EqualizerControllerEngineImpl::cr
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface>
         exceptionEncounteredSender,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender) {
+    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
+    std::chrono::milliseconds bandLevelReportDelay) {
     std::shared_ptr<EqualizerControllerEngineImpl> equalizerEngineImpl = nullptr;
 
     try {
         ThrowIfNull(equalizerPlatformInterface, "invalidEqualizerPlatformInterface");
+        ThrowIf(bandLevelReportDelay < std::chrono::milliseconds::zero(), "invalidBandLevelReportDelay");
         equalizerEngineImpl = std::shared_ptr<EqualizerControllerEngineImpl>(
-            new EqualizerControllerEngineImpl(equalizerPlatformInterface));
+            new EqualizerControllerEngineImpl(equalizerPlatformInterface, bandLevelReportDelay));
         ThrowIfNot(
             equalizerEngineImpl->initialize(
                 capabilitiesRegistrar,
@@ -135,7 +145,35 @@ std::shared_ptr<EqualizerControllerEngineImpl> EqualizerControllerEngineImpl::cr
 
 void EqualizerControllerEngineImpl::setEqualizerBandLevels(
     alexaClientSDK::acsdkEqualizerInterfaces::EqualizerBandLevelMap bandLevels) {
-    std::vector<EqualizerBandLevel> newBandLevels = convertBandLevels(bandLevels);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool changed = false;
+    bool reporting = m_reportingThread == std::this_thread::get_id();
+    for (auto& next : bandLevels) {
+        auto controllerIt = m_controllerBandLevels.find(next.first);
+        bool changedByController = controllerIt == m_controllerBandLevels.end() || controllerIt->second != next.second;
+        m_controllerBandLevels[next.first] = next.second;
+        if (m_pendingBandLevels.count(next.first) > 0) {
+            // the local change of the band is newer than the report the controller applies back, or than the
+            // state of another band a directive changes
+            if (reporting || !changedByController) {
+                continue;
+            }
+            // a directive overrides the local change that is not reported yet
+            m_pendingBandLevels.erase(next.first);
+        }
+        auto it = m_bandLevels.find(next.first);
+        if (it == m_bandLevels.end() || it->second != next.second) {
+            m_bandLevels[next.first] = next.second;
+            changed = true;
+        }
+    }
+
+    // the levels reported by the engine are already applied on the platform
+    if (!changed && m_bandLevelReportDelay != std::chrono::milliseconds::zero()) {
+        AACE_DEBUG(LX(TAG, "setEqualizerBandLevels").m("bandLevelsAlreadyApplied"));
+        return;
+    }
+    std::vector<EqualizerBandLevel> newBandLevels = convertBandLevels(m_bandLevels);
     emitCounterMetrics(
         METRIC_PROGRAM_NAME_SUFFIX, "setEqualizerBandLevels", {METRIC_EQUALIZER_CONTROLLER_SET_BAND_LEVELS});
     AACE_VERBOSE(LX(TAG, "setEqualizerBandLevels").d("bandLevels", bandLevelsToString(newBandLevels)));
@@ -165,6 +203,11 @@ EqualizerControllerEngineImpl::loadState() {
     alexaClientSDK::acsdkEqualizerInterfaces::EqualizerState state;
     state.bandLevels = convertAndTruncateBandLevels(bandLevels);
     state.mode = alexaClientSDK::acsdkEqualizerInterfaces::EqualizerMode::NONE;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bandLevels = state.bandLevels;
+        m_controllerBandLevels = state.bandLevels;
+    }
     return alexaClientSDK::avsCommon::utils::error::SuccessResult<
         alexaClientSDK::acsdkEqualizerInterfaces::EqualizerState>::success(state);
 }
@@ -181,7 +224,13 @@ void EqualizerControllerEngineImpl::onLocalSetBandLevels(const std::vector<Equal
     // note: alexaClientSDK::equalizer::EqualizerController::setBandLevels does not truncate to configured min/max
     // range before providing these levels in context, so we do it here
     auto newMap = convertAndTruncateBandLevels(bandLevels);
-    m_equalizerController->setBandLevels(newMap);
+    if (m_bandLevelReportDelay == std::chrono::milliseconds::zero()) {
+        m_equalizerController->setBandLevels(newMap);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ReturnIf(m_shutdown);
+    applyLocalBandLevelsLocked(newMap);
 }
 
 void EqualizerControllerEngineImpl::onLocalAdjustBandLevels(const std::vector<EqualizerBandLevel>& bandAdjustments) {
@@ -190,26 +239,151 @@ void EqualizerControllerEngineImpl::onLocalAdjustBandLevels(const std::vector<Eq
     AACE_VERBOSE(LX(TAG, "onLocalAdjustBandLevels").d("bandAdjustments", bandLevelsToString(bandAdjustments)));
     // Convert band level adjustment map
     // note: alexaClientSDK::equalizer::EqualizerController::adjustBandLevels truncates to configured min/max range
-    m_equalizerController->adjustBandLevels(convertBandLevels(bandAdjustments));
+    if (m_bandLevelReportDelay == std::chrono::milliseconds::zero()) {
+        m_equalizerController->adjustBandLevels(convertBandLevels(bandAdjustments));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ReturnIf(m_shutdown);
+    EqualizerBandLevelMap newMap;
+    for (auto& next : convertBandLevels(bandAdjustments)) {
+        // the adjustments of a band add up until the levels are reported
+        newMap[next.first] = std::min(
+            std::max(getBandLevelLocked(next.first) + next.second, getMinimumBandLevel()), getMaximumBandLevel());
+    }
+    applyLocalBandLevelsLocked(newMap);
 }
 
 void EqualizerControllerEngineImpl::onLocalResetBands(const std::vector<EqualizerBand>& bands) {
     emitCounterMetrics(
         METRIC_PROGRAM_NAME_SUFFIX, "onLocalResetBands", {METRIC_EQUALIZER_CONTROLLER_LOCAL_RESET_BANDS});
     AACE_VERBOSE(LX(TAG, "onLocalResetBands"));
+    std::set<alexaClientSDK::acsdkEqualizerInterfaces::EqualizerBand> resetBands;
     if (bands.size() == 0) {
         // Reset all supported bands
-        m_equalizerController->resetBands(m_configuration->getSupportedBands());
+        resetBands = m_configuration->getSupportedBands();
     } else {
-        std::set<alexaClientSDK::acsdkEqualizerInterfaces::EqualizerBand> resetBands;
         for (auto band : bands) {
             resetBands.insert(convertBand(band));
         }
+    }
+    if (m_bandLevelReportDelay == std::chrono::milliseconds::zero()) {
         m_equalizerController->resetBands(resetBands);
+        return;
     }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ReturnIf(m_shutdown);
+    auto defaultBandLevels = m_configuration->getDefaultState().bandLevels;
+    EqualizerBandLevelMap newMap;
+    for (auto band : resetBands) {
+        auto it = defaultBandLevels.find(band);
+        if (it != defaultBandLevels.end()) {
+            newMap[band] = it->second;
+        }
+    }
+    applyLocalBandLevelsLocked(newMap);
+}
+
+void EqualizerControllerEngineImpl::applyLocalBandLevelsLocked(const EqualizerBandLevelMap& bandLevels) {
+    auto supportedBands = m_configuration->getSupportedBands();
+    bool changed = false;
+    for (auto& next : bandLevels) {
+        if (supportedBands.count(next.first) == 0) {
+            AACE_WARN(
+                LX(TAG, "applyLocalBandLevels").d("reason", "unsupportedBand").d("band", convertBand(next.first)));
+            continue;
+        }
+        // a change to the level the platform already has is still reported, AVS may have another level
+        m_pendingBandLevels[next.first] = next.second;
+        auto it = m_bandLevels.find(next.first);
+        if (it == m_bandLevels.end() || it->second != next.second) {
+            m_bandLevels[next.first] = next.second;
+            changed = true;
+        }
+    }
+    ReturnIf(m_pendingBandLevels.empty());
+
+    // the levels are applied at once, and reported once they settle
+    if (changed) {
+        m_equalizerPlatformInterface->setBandLevels(convertBandLevels(m_bandLevels));
+    }
+    restartReportTimerLocked();
+}
+
+void EqualizerControllerEngineImpl::restartReportTimerLocked() {
+    if (m_reportTimer != TimerWheel::INVALID_TIMER) {
+        TimerWheel::getDefault()->cancel(m_reportTimer);
+    }
+
+    // the timer runs on the timer thread, which must not wait for the equalizer controller
+    std::weak_ptr<EqualizerControllerEngineImpl> wp = shared_from_this();
+    m_reportTimer = TimerWheel::getDefault()->submitAfter(m_bandLevelReportDelay, [wp]() {
+        if (auto equalizer = wp.lock()) {
+            auto raw = equalizer.get();
+            equalizer->m_executor.post([raw]() {
+                {
+                    std::lock_guard<std::mutex> lock(raw->m_mutex);
+                    // the levels were reported at shutdown
+                    if (raw->m_shutdown) {
+                        return;
+                    }
+                    raw->m_reportTimer = TimerWheel::INVALID_TIMER;
+                }
+                raw->reportBandLevels();
+            });
+        }
+    });
+}
+
+void EqualizerControllerEngineImpl::reportBandLevels() {
+    std::lock_guard<std::mutex> reportLock(m_reportMutex);
+    EqualizerBandLevelMap bandLevels;
+    std::shared_ptr<alexaClientSDK::acsdkEqualizer::EqualizerController> equalizerController;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        bandLevels.swap(m_pendingBandLevels);
+        equalizerController = m_equalizerController;
+        if (bandLevels.empty() || equalizerController == nullptr) {
+            return;
+        }
+        m_reportingThread = std::this_thread::get_id();
+    }
+
+    // the platform already has the levels, so the controller only saves them, updates the context and sends the
+    // EqualizerChanged event, and the levels it applies back are dropped by setEqualizerBandLevels()
+    emitCounterMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX, "reportBandLevels", {METRIC_EQUALIZER_CONTROLLER_BAND_LEVELS_REPORTED});
+    AACE_VERBOSE(LX(TAG, "reportBandLevels").d("bandLevels", bandLevelsToString(convertBandLevels(bandLevels))));
+    equalizerController->setBandLevels(bandLevels);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_reportingThread = std::thread::id();
+}
+
+int EqualizerControllerEngineImpl::getBandLevelLocked(alexaClientSDK::acsdkEqualizerInterfaces::EqualizerBand band) {
+    auto it = m_bandLevels.find(band);
+    if (it != m_bandLevels.end()) {
+        return it->second;
+    }
+    auto defaultBandLevels = m_configuration->getDefaultState().bandLevels;
+    auto defaultIt = defaultBandLevels.find(band);
+    return defaultIt != defaultBandLevels.end() ? defaultIt->second : 0;
 }
 
 void EqualizerControllerEngineImpl::doShutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+        if (m_reportTimer != TimerWheel::INVALID_TIMER) {
+            TimerWheel::getDefault()->cancel(m_reportTimer);
+            m_reportTimer = TimerWheel::INVALID_TIMER;
+        }
+    }
+    m_executor.shutdown();
+
+    // the settled levels are reported before the capability agent is shut down
+    reportBandLevels();
+
     if (m_equalizerPlatformInterface != nullptr) {
         m_equalizerPlatformInterface->setEngineInterface(nullptr);
     }
@@ -435,6 +435,7 @@ void ExternalMediaAdapterEngineImpl::onRequestToken(const std::string& localPlay
 
 void ExternalMediaAdapterEngineImpl::onLoginComplete(const std::string& localPlayerId) {
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "onLoginComplete", {METRIC_EXTERNALMEDIAPLAYER_LOGIN_COMPLETE});
+    reportStateChanged();
     try {
         ThrowIfNot(validatePlayer(localPlayerId), "invalidPlayerId");
 
@@ -452,6 +453,7 @@ void ExternalMediaAdapterEngineImpl::onLoginComplete(const std::string& localPla
 
 void ExternalMediaAdapterEngineImpl::onLogoutComplete(const std::string& localPlayerId) {
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "onLogoutComplete", {METRIC_EXTERNALMEDIAPLAYER_LOGOUT_COMPLETE});
+    reportStateChanged();
     try {
         ThrowIfNot(validatePlayer(localPlayerId), "invalidPlayerId");
 
@@ -470,6 +472,7 @@ void ExternalMediaAdapterEngineImpl::onLogoutComplete(const std::string& localPl
 void ExternalMediaAdapterEngineImpl::onPlayerEvent(const std::string& localPlayerId, const std::string& eventName) {
     emitCounterMetrics(
         METRIC_PROGRAM_NAME_SUFFIX, "onPlayerEvent", {METRIC_EXTERNALMEDIAPLAYER_PLAYER_EVENT, eventName});
+    reportStateChanged();
     try {
         ThrowIfNot(validatePlayer(localPlayerId), "invalidPlayerId");
         // player has begun playing, acquire focus
@@ -531,6 +534,7 @@ void ExternalMediaAdapterEngineImpl::onPlayerError(
         METRIC_PROGRAM_NAME_SUFFIX,
         "onPlayerError",
         {METRIC_EXTERNALMEDIAPLAYER_PLAYER_ERROR, errorName, std::to_string(code)});
+    reportStateChanged();
     try {
         ThrowIfNot(validatePlayer(localPlayerId), "invalidPlayerId");
 
@@ -567,6 +571,7 @@ void ExternalMediaAdapterEngineImpl::onPlayerError(
 
 void ExternalMediaAdapterEngineImpl::onSetFocus(const std::string& localPlayerId) {
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "onSetFocus", {METRIC_EXTERNALMEDIAPLAYER_SET_FOCUS});
+    reportStateChanged();
     try {
         ThrowIfNot(setFocus(localPlayerId, true), "setFocusFailed");
     } catch (std::exception& ex) {
@@ -589,6 +594,9 @@ void ExternalMediaAdapterEngineImpl::onRemoveDiscoveredPlayer(const std::string&
 //
 
 void ExternalMediaAdapterEngineImpl::doShutdown() {
+    // no state query may call the platform interface once it is released
+    stopAdapterStateQueries();
+
     if (m_platformMediaAdapter != nullptr) {
         m_platformMediaAdapter->setEngineInterface(nullptr);
         m_platformMediaAdapter.reset();
@@ -17,6 +17,7 @@
 
 #include "AACE/Engine/Alexa/ExternalMediaAdapterHandler.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/Metrics/Metrics.h"
 
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
@@ -32,6 +33,18 @@ static const uint8_t DEFAULT_SPEAKER_VOLUME = 50;
 /// Timeout for setting focus operation.
 static const std::chrono::seconds SET_FOCUS_TIMEOUT{5};
 
+/// The time the players have to return their state, after which their last state is used.
+static const std::chrono::milliseconds GET_ADAPTER_STATE_TIMEOUT{500};
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "ExternalMediaAdapterHandler";
+
+/// Timer metric for the time a player takes to return its state, followed by the local player id
+static const std::string METRIC_GET_ADAPTER_STATE_LATENCY = "GetAdapterStateLatency";
+
+/// Counter metric for a player not returning its state before the deadline
+static const std::string METRIC_GET_ADAPTER_STATE_TIMEOUT = "GetAdapterStateTimeout";
+
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.alexa.ExternalMediaAdapterHandler");
 
@@ -367,6 +380,7 @@ bool ExternalMediaAdapterHandler::adjustSeek(const std::string& playerId, std::c
 std::vector<aace::engine::alexa::AdapterState> ExternalMediaAdapterHandler::getAdapterStates(bool all) {
     try {
         std::vector<aace::engine::alexa::AdapterState> adapterStateList;
+        std::vector<PlayerInfo> playerInfoList;
 
         for (const auto& next : m_playerInfoMap) {
             auto playerInfo = next.second;
@@ -381,11 +395,42 @@ std::vector<aace::engine::alexa::AdapterState> ExternalMediaAdapterHandler::getA
             // default playback state
             state.playbackState.playerId = playerInfo.playerId;
 
-            if (all) {
-                // get the player state from the adapter implementation
-                ThrowIfNot(handleGetAdapterState(playerInfo.localPlayerId, state), "handleGetAdapterStateFailed");
-            }
             adapterStateList.push_back(state);
+            playerInfoList.push_back(playerInfo);
+        }
+
+        if (all) {
+            // the players are queried at once, so a slow player only delays the states until the deadline
+            auto deadline = std::chrono::steady_clock::now() + GET_ADAPTER_STATE_TIMEOUT;
+            std::vector<std::shared_future<std::shared_ptr<AdapterState>>> queries;
+            for (size_t j = 0; j < adapterStateList.size(); j++) {
+                queries.push_back(queryAdapterState(playerInfoList[j].localPlayerId, adapterStateList[j]));
+            }
+
+            for (size_t j = 0; j < adapterStateList.size(); j++) {
+                const auto& playerInfo = playerInfoList[j];
+                if (queries[j].wait_until(deadline) == std::future_status::ready && queries[j].get() != nullptr) {
+                    adapterStateList[j] = *queries[j].get();
+                    continue;
+                }
+
+                // the last state of the player is used, with its current session
+                std::lock_guard<std::mutex> lock(m_stateQueryMutex);
+                auto it = m_lastAdapterStates.find(playerInfo.localPlayerId);
+                AACE_WARN(LX(TAG, "getAdapterStates")
+                              .d("reason", "stateUnavailable")
+                              .d("localPlayerId", playerInfo.localPlayerId)
+                              .d("lastState", it != m_lastAdapterStates.end()));
+                if (it != m_lastAdapterStates.end()) {
+                    auto& state = adapterStateList[j];
+                    auto sessionState = state.sessionState;
+                    state = it->second;
+                    state.sessionState.playerId = sessionState.playerId;
+                    state.sessionState.skillToken = sessionState.skillToken;
+                    state.sessionState.playbackSessionId = sessionState.playbackSessionId;
+                    state.playbackState.playerId = sessionState.playerId;
+                }
+            }
         }
 
         return adapterStateList;
@@ -395,6 +440,80 @@ std::vector<aace::engine::alexa::AdapterState> ExternalMediaAdapterHandler::getA
     }
 }
 
+std::shared_future<std::shared_ptr<AdapterState>> ExternalMediaAdapterHandler::queryAdapterState(
+    const std::string& localPlayerId,
+    const AdapterState& defaultState) {
+    std::lock_guard<std::mutex> lock(m_stateQueryMutex);
+
+    // the pending query of a player that didn't return in time is waited for again
+    auto it = m_pendingStateQueries.find(localPlayerId);
+    if (it != m_pendingStateQueries.end()) {
+        return it->second;
+    }
+
+    auto& executor = m_stateQueryExecutors[localPlayerId];
+    if (executor == nullptr) {
+        executor = std::make_shared<alexaClientSDK::avsCommon::utils::threading::Executor>();
+    }
+
+    std::shared_future<std::shared_ptr<AdapterState>> query = executor->submit(
+        [this, localPlayerId, defaultState]() { return executeQueryAdapterState(localPlayerId, defaultState); });
+
+    // the query removes itself once it completes, which it can't do before the lock is released
+    m_pendingStateQueries[localPlayerId] = query;
+
+    return query;
+}
+
+std::shared_ptr<AdapterState> ExternalMediaAdapterHandler::executeQueryAdapterState(
+    const std::string& localPlayerId,
+    const AdapterState& defaultState) {
+    auto start = std::chrono::steady_clock::now();
+    auto state = std::make_shared<AdapterState>(defaultState);
+    bool succeeded = false;
+    try {
+        succeeded = handleGetAdapterState(localPlayerId, *state);
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "executeQueryAdapterState").d("reason", ex.what()));
+    }
+
+    auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    aace::engine::utils::metrics::emitTimerMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX,
+        "executeQueryAdapterState",
+        METRIC_GET_ADAPTER_STATE_LATENCY + "." + localPlayerId,
+        latency.count());
+    if (latency > GET_ADAPTER_STATE_TIMEOUT) {
+        aace::engine::utils::metrics::emitCounterMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX, "executeQueryAdapterState", {METRIC_GET_ADAPTER_STATE_TIMEOUT});
+    }
+
+    std::lock_guard<std::mutex> lock(m_stateQueryMutex);
+    m_pendingStateQueries.erase(localPlayerId);
+    if (!succeeded) {
+        AACE_ERROR(LX(TAG, "executeQueryAdapterState")
+                       .d("reason", "handleGetAdapterStateFailed")
+                       .d("localPlayerId", localPlayerId));
+        return nullptr;
+    }
+    m_lastAdapterStates[localPlayerId] = *state;
+
+    return state;
+}
+
+void ExternalMediaAdapterHandler::stopAdapterStateQueries() {
+    std::unique_lock<std::mutex> lock(m_stateQueryMutex);
+    auto executors = std::move(m_stateQueryExecutors);
+    m_stateQueryExecutors.clear();
+    m_pendingStateQueries.clear();
+    lock.unlock();
+
+    // the queries lock the mutex, so the executors are shut down without it
+    for (auto& next : executors) {
+        next.second->shutdown();
+    }
+}
+
 std::chrono::milliseconds ExternalMediaAdapterHandler::getOffset(const std::string& playerId) {
     try {
         auto it = m_alexaToLocalPlayerIdMap.find(playerId);
@@ -541,6 +660,7 @@ bool ExternalMediaAdapterHandler::removeDiscoveredPlayer(const std::string& loca
 
         // remove the player info map entry
         m_playerInfoMap.erase(it);
+        reportStateChanged();
 
         auto m_discoveredPlayerSender_lock = m_discoveredPlayerSender.lock();
         ThrowIfNull(m_discoveredPlayerSender_lock, "invalidDiscoveredPlayerSender");
@@ -565,13 +685,22 @@ void ExternalMediaAdapterHandler::reportPlaybackSessionId(
 
         m_playerInfoMap[localPlayerId].playbackSessionId = sessionId;
         AACE_INFO(LX(TAG).d("localPlayerId", localPlayerId).d("sessionId", sessionId));
+        reportStateChanged();
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()).d("localPlayerId", localPlayerId).d("sessionId", sessionId));
     }
 }
 
+void ExternalMediaAdapterHandler::reportStateChanged() {
+    // the focus handler is the external media player, which caches the player states for the context
+    if (auto focusHandler_lock = m_focusHandler.lock()) {
+        focusHandler_lock->onAdapterStateChanged();
+    }
+}
+
 void ExternalMediaAdapterHandler::doShutdown() {
     m_executor.shutdown();
+    stopAdapterStateQueries();
 
     if (!m_discoveredPlayerSender.expired()) {
         m_discoveredPlayerSender.reset();
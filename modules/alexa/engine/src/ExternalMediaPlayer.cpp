@@ -14,11 +14,13 @@
  */
 
 /// @file ExternalMediaPlayer.cpp
+#include <algorithm>
 #include <utility>
 #include <vector>
 
 #include "AACE/Engine/Alexa/ExternalMediaPlayer.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/JSON/ArenaDocument.h"
 
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
@@ -166,6 +168,9 @@ static const char PLAYERS[] = "players";
 /// The const char for the playerInFocus key field in the context.
 static const char PLAYER_IN_FOCUS[] = "playerInFocus";
 
+/// The time after which the cached player states are queried again, in case a player didn't report a change.
+static const std::chrono::seconds STATE_CACHE_MAX_AGE{10};
+
 /// The max relative time in the past that we can  seek to in milliseconds(-12hours in ms).
 static const int64_t MAX_PAST_OFFSET = -86400000;
 
@@ -317,7 +322,8 @@ std::shared_ptr<ExternalMediaPlayer> ExternalMediaPlayer::create(
     std::shared_ptr<ContextManagerInterface> contextManager,
     std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender,
     std::shared_ptr<PlaybackRouterInterface> playbackRouter,
-    std::shared_ptr<aace::engine::alexa::ExternalMediaAdapterRegistrationInterface> externalMediaAdapterRegistration) {
+    std::shared_ptr<aace::engine::alexa::ExternalMediaAdapterRegistrationInterface> externalMediaAdapterRegistration,
+    std::chrono::milliseconds eventBatchWindow) {
     if (nullptr == speakerManager) {
         AACE_ERROR(LX(TAG, "createFailed").d("reason", "nullSpeakerManager"));
         return nullptr;
@@ -358,7 +364,7 @@ std::shared_ptr<ExternalMediaPlayer> ExternalMediaPlayer::create(
         playbackRouter,
         externalMediaAdapterRegistration));
 
-    if (!externalMediaPlayer->init(mediaPlayers, speakers, adapterCreationMap, focusManager)) {
+    if (!externalMediaPlayer->init(mediaPlayers, speakers, adapterCreationMap, focusManager, eventBatchWindow)) {
         AACE_ERROR(LX(TAG, "createFailed").d("reason", "initFailed"));
         return nullptr;
     }
@@ -425,10 +431,11 @@ bool ExternalMediaPlayer::init(
     const AdapterMediaPlayerMap& mediaPlayers,
     const AdapterSpeakerMap& speakers,
     const AdapterCreationMap& adapterCreationMap,
-    std::shared_ptr<FocusManagerInterface> focusManager) {
+    std::shared_ptr<FocusManagerInterface> focusManager,
+    std::chrono::milliseconds eventBatchWindow) {
     AACE_VERBOSE(LX(TAG));
 
-    m_authorizedSender = AuthorizedSender::create(m_messageSender);
+    m_authorizedSender = AuthorizedSender::create(m_messageSender, eventBatchWindow);
     if (!m_authorizedSender) {
         AACE_ERROR(LX(TAG, "initFailed").d("reason", "createAuthorizedSenderFailed"));
         return false;
@@ -462,6 +469,7 @@ void ExternalMediaPlayer::addAdapterHandler(
         if (!m_adapterHandlers.insert(adapterHandler).second) {
             AACE_ERROR(LX(TAG, "addAdapterHandlerInExecutor").m("Duplicate adapter handler."));
         }
+        invalidateAdapterStates();
     });
 }
 
@@ -477,9 +485,14 @@ void ExternalMediaPlayer::removeAdapterHandler(
         if (m_adapterHandlers.erase(adapterHandler) == 0) {
             AACE_WARN(LX(TAG, "removeAdapterHandlerInExecutor").m("Nonexistent adapter handler."));
         }
+        invalidateAdapterStates();
     });
 }
 
+void ExternalMediaPlayer::invalidateAdapterStates() {
+    m_adapterStatesDirty = true;
+}
+
 // adapter handler specific code
 void ExternalMediaPlayer::executeOnFocusChanged(aace::engine::alexa::FocusState newFocus, MixingBehavior behavior) {
     AACE_DEBUG(LX(TAG)
@@ -749,6 +762,7 @@ bool ExternalMediaPlayer::parseDirectivePayload(std::shared_ptr<DirectiveInfo> i
 }
 
 void ExternalMediaPlayer::handleDirective(std::shared_ptr<DirectiveInfo> info) {
+    AACE_TRACE_SCOPE("directive", "ExternalMediaPlayer.handleDirective");
     if (!info) {
         AACE_ERROR(LX(TAG, "handleDirectiveFailed").d("reason", "nullDirectiveInfo"));
         return;
@@ -808,7 +822,8 @@ std::shared_ptr<ExternalMediaAdapterInterface> ExternalMediaPlayer::preprocessDi
 void ExternalMediaPlayer::handleAuthorizeDiscoveredPlayers(std::shared_ptr<DirectiveInfo> info, RequestType request) {
     AACE_VERBOSE(LX(TAG));
 
-    rapidjson::Document payload;
+    aace::engine::utils::json::ArenaDocument arenaDocument;
+    auto& payload = arenaDocument.get();
 
     // A map of playerId to skillToken
     std::unordered_map<std::string, std::string> authorizedForJson;
@@ -998,7 +1013,8 @@ void ExternalMediaPlayer::sendAuthorizationCompleteEvent(
 }
 
 void ExternalMediaPlayer::handleLogin(std::shared_ptr<DirectiveInfo> info, RequestType request) {
-    rapidjson::Document payload;
+    aace::engine::utils::json::ArenaDocument arenaDocument;
+    auto& payload = arenaDocument.get();
 
     auto adapter = preprocessDirective(info, &payload);
 
@@ -1053,7 +1069,8 @@ void ExternalMediaPlayer::handleLogin(std::shared_ptr<DirectiveInfo> info, Reque
 }
 
 void ExternalMediaPlayer::handleLogout(std::shared_ptr<DirectiveInfo> info, RequestType request) {
-    rapidjson::Document payload;
+    aace::engine::utils::json::ArenaDocument arenaDocument;
+    auto& payload = arenaDocument.get();
 
     auto adapter = preprocessDirective(info, &payload);
 
@@ -1081,7 +1098,8 @@ void ExternalMediaPlayer::handleLogout(std::shared_ptr<DirectiveInfo> info, Requ
 }
 
 void ExternalMediaPlayer::handlePlay(std::shared_ptr<DirectiveInfo> info, RequestType request) {
-    rapidjson::Document payload;
+    aace::engine::utils::json::ArenaDocument arenaDocument;
+    auto& payload = arenaDocument.get();
 
     auto adapter = preprocessDirective(info, &payload);
 
@@ -1198,7 +1216,8 @@ void ExternalMediaPlayer::handlePlay(std::shared_ptr<DirectiveInfo> info, Reques
 }
 
 void ExternalMediaPlayer::handleSeek(std::shared_ptr<DirectiveInfo> info, RequestType request) {
-    rapidjson::Document payload;
+    aace::engine::utils::json::ArenaDocument arenaDocument;
+    auto& payload = arenaDocument.get();
 
     auto adapter = preprocessDirective(info, &payload);
 
@@ -1231,7 +1250,8 @@ void ExternalMediaPlayer::handleSeek(std::shared_ptr<DirectiveInfo> info, Reques
 }
 
 void ExternalMediaPlayer::handleAdjustSeek(std::shared_ptr<DirectiveInfo> info, RequestType request) {
-    rapidjson::Document payload;
+    aace::engine::utils::json::ArenaDocument arenaDocument;
+    auto& payload = arenaDocument.get();
 
     auto adapter = preprocessDirective(info, &payload);
 
@@ -1273,7 +1293,8 @@ void ExternalMediaPlayer::handleAdjustSeek(std::shared_ptr<DirectiveInfo> info,
 }
 
 void ExternalMediaPlayer::handlePlayControl(std::shared_ptr<DirectiveInfo> info, RequestType request) {
-    rapidjson::Document payload;
+    aace::engine::utils::json::ArenaDocument arenaDocument;
+    auto& payload = arenaDocument.get();
     auto adapter = preprocessDirective(info, &payload);
 
     std::string playerId;
@@ -1358,6 +1379,7 @@ void ExternalMediaPlayer::setPlayerInFocus(const std::string& playerInFocus, boo
             m_playerInFocus = playerInFocus;
         }
         m_playerInFocusConditionVariable.notify_all();
+        invalidateAdapterStates();
 
         m_adapterHandlerInFocus = nullptr;
 
@@ -1462,6 +1484,7 @@ void ExternalMediaPlayer::setPlayerInFocus(const std::string& playerInFocus) {
         m_playbackRouter->setHandler(shared_from_this());
         m_adapterHandlerInFocus = adapterHandlerInFocus;
         m_adapterInFocus = adapterInFocus;
+        invalidateAdapterStates();
     }
 }
 
@@ -1614,6 +1637,9 @@ void ExternalMediaPlayer::setHaltInitiatorRequestHelper(RequestType request) {
 // #endif
 
 void ExternalMediaPlayer::setHandlingCompleted(std::shared_ptr<DirectiveInfo> info) {
+    // the directive was passed to the players, which may have changed their state
+    invalidateAdapterStates();
+
     if (info && info->result) {
         info->result->setCompleted();
     }
@@ -1644,16 +1670,33 @@ void ExternalMediaPlayer::executeProvideState(
     std::string state;
 
     // adapter handler specific code
-    std::vector<aace::engine::alexa::AdapterState> adapterStates;
-    for (auto adapterHandler : m_adapterHandlers) {
-        auto handlerAdapterStates = adapterHandler->getAdapterStates();
-        adapterStates.insert(adapterStates.end(), handlerAdapterStates.begin(), handlerAdapterStates.end());
+    refreshAdapterStates();
+
+    // the states of the adapters are not cached, so the context is built again when there are adapters
+    bool hasAdapters;
+    {
+        std::lock_guard<std::mutex> lock{m_adaptersMutex};
+        hasAdapters = !m_adapters.empty();
     }
 
     if (stateProviderName == SESSION_STATE) {
-        state = provideSessionState(adapterStates);
+        if (m_cachedSessionState.empty() || hasAdapters) {
+            m_cachedSessionState = provideSessionState(m_cachedAdapterStates);
+        }
+        state = m_cachedSessionState;
     } else if (stateProviderName == PLAYBACK_STATE) {
-        state = providePlaybackState(adapterStates);
+        if (m_renderPlayerInfoCardsPending) {
+            m_renderPlayerInfoCardsPending = false;
+            notifyRenderPlayerInfoCardsObservers();
+        }
+        if (m_cachedAdapterStatesPlaying || hasAdapters) {
+            state = providePlaybackState(getCurrentAdapterStates());
+        } else {
+            if (m_cachedPlaybackState.empty()) {
+                m_cachedPlaybackState = providePlaybackState(m_cachedAdapterStates);
+            }
+            state = m_cachedPlaybackState;
+        }
     } else {
         AACE_ERROR(LX(TAG, "executeProvideState").d("reason", "unknownStateProviderName"));
         return;
@@ -1670,6 +1713,49 @@ void ExternalMediaPlayer::executeProvideState(
     }
 }
 
+bool ExternalMediaPlayer::refreshAdapterStates() {
+    auto now = std::chrono::steady_clock::now();
+
+    // the flag is cleared before the states are queried, so a change reported meanwhile is not lost
+    if (!m_adapterStatesDirty.exchange(false) && now - m_cachedAdapterStatesTime < STATE_CACHE_MAX_AGE) {
+        return false;
+    }
+
+    m_cachedAdapterStates.clear();
+    for (auto adapterHandler : m_adapterHandlers) {
+        auto handlerAdapterStates = adapterHandler->getAdapterStates();
+        m_cachedAdapterStates.insert(
+            m_cachedAdapterStates.end(), handlerAdapterStates.begin(), handlerAdapterStates.end());
+    }
+    m_cachedAdapterStatesTime = now;
+    m_cachedAdapterStatesPlaying = std::any_of(
+        m_cachedAdapterStates.begin(), m_cachedAdapterStates.end(), [](const AdapterState& adapterState) {
+            return adapterState.playbackState.state == aace::engine::alexa::PLAYING;
+        });
+
+    m_cachedSessionState.clear();
+    m_cachedPlaybackState.clear();
+    m_renderPlayerInfoCardsPending = true;
+
+    return true;
+}
+
+std::vector<aace::engine::alexa::AdapterState> ExternalMediaPlayer::getCurrentAdapterStates() {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_cachedAdapterStatesTime);
+    auto adapterStates = m_cachedAdapterStates;
+    for (auto& adapterState : adapterStates) {
+        auto& playbackState = adapterState.playbackState;
+        if (playbackState.state == aace::engine::alexa::PLAYING) {
+            playbackState.trackOffset += elapsed;
+            if (playbackState.duration.count() > 0) {
+                playbackState.trackOffset = std::min(playbackState.trackOffset, playbackState.duration);
+            }
+        }
+    }
+    return adapterStates;
+}
+
 // adapter handler specific code
 std::string ExternalMediaPlayer::provideSessionState(std::vector<aace::engine::alexa::AdapterState> adapterStates) {
     rapidjson::Document state(rapidjson::kObjectType);
@@ -1743,8 +1829,9 @@ std::string ExternalMediaPlayer::providePlaybackState(std::vector<aace::engine::
         if (!adapter) {
             continue;
         }
-        auto playbackState = adapter->getState().playbackState;
-        auto sessionState = adapter->getState().sessionState;
+        auto adapterState = adapter->getState();
+        const auto& playbackState = adapterState.playbackState;
+        const auto& sessionState = adapterState.sessionState;
         rapidjson::Value playerJson = buildPlaybackState(sessionState.playerId, playbackState, stateAlloc);
         players.PushBack(playerJson, stateAlloc);
         ObservablePlaybackStateProperties update{
@@ -1752,8 +1839,6 @@ std::string ExternalMediaPlayer::providePlaybackState(std::vector<aace::engine::
         notifyObservers(sessionState.playerId, &update);
     }
 
-    notifyRenderPlayerInfoCardsObservers();
-
     // Fill the default player state.
     bool defaultPlayerExists = false;
     rapidjson::Value playerJson;
@@ -1931,8 +2016,7 @@ void ExternalMediaPlayer::notifyRenderPlayerInfoCardsObservers() {
     if (m_adapterHandlerInFocus) {
         bool found = false;
         aace::engine::alexa::AdapterState adapterState;
-        auto adapterStates = m_adapterHandlerInFocus->getAdapterStates();
-        for (auto state : adapterStates) {
+        for (const auto& state : m_cachedAdapterStates) {
             if (state.sessionState.playerId == m_playerInFocus) {
                 adapterState = state;
                 found = true;
@@ -13,6 +13,10 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+#include <cstdio>
+#include <future>
+
 #include <AVSCommon/AVS/EventBuilder.h>
 #include <AVSCommon/Utils/UUIDGeneration/UUIDGeneration.h>
 
@@ -31,6 +35,7 @@ namespace engine {
 namespace alexa {
 
 using namespace aace::engine::utils::metrics;
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
 
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.alexa.ExternalMediaPlayerEngineImpl");
@@ -46,6 +51,61 @@ static const std::string METRIC_PROGRAM_NAME_SUFFIX = "ExternalMediaPlayerEngine
 /// Counter metric for GlobalPreset Platform API
 static const std::string METRIC_GLOBAL_PRESET_GLOBAL_PRESET = "GlobalPreset";
 
+/// Counter metric for the discovered players whose saved authorizations were restored
+static const std::string METRIC_RESTORED_AUTHORIZATIONS = "RestoredDiscoveredPlayerAuthorizations";
+
+/// Table of the authorizations of the discovered players
+static const std::string EXTERNAL_MEDIA_PLAYER_TABLE = "aace.alexa.externalMediaPlayer";
+
+/// Key of the hash of the discovered players whose authorizations are saved. It is written after the
+/// authorizations, so the saved authorizations are only restored for the players they were received for.
+static const std::string DISCOVERED_PLAYERS_HASH_KEY = "discoveredPlayersHash";
+
+/// Key of the authorizations of the discovered players
+static const std::string AUTHORIZED_PLAYERS_KEY = "authorizedPlayers";
+
+/// FNV-1a 64 bit offset basis
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+/// FNV-1a 64 bit prime
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/// Returns a hash of the discovery metadata of the players reported by an agent, which is stable across Engine runs.
+static std::string hashDiscoveredPlayers(
+    const std::string& agent,
+    const std::unordered_map<std::string, aace::alexa::ExternalMediaAdapter::DiscoveredPlayerInfo>& players) {
+    std::vector<std::string> localPlayerIds;
+    for (auto& next : players) {
+        localPlayerIds.push_back(next.first);
+    }
+    std::sort(localPlayerIds.begin(), localPlayerIds.end());
+
+    // std::hash is not guaranteed to be the same across Engine builds, so the persisted hash uses FNV-1a
+    uint64_t value = FNV_OFFSET_BASIS;
+    auto add = [&value](const std::string& field) {
+        for (auto c : field) {
+            value ^= static_cast<uint8_t>(c);
+            value *= FNV_PRIME;
+        }
+        // separate the fields, so their boundaries are part of the hash
+        value ^= 0xff;
+        value *= FNV_PRIME;
+    };
+    add(agent);
+    for (auto& localPlayerId : localPlayerIds) {
+        auto& info = players.at(localPlayerId);
+        add(info.localPlayerId);
+        add(info.spiVersion);
+        add(info.validationMethod);
+        for (auto& validationData : info.validationData) {
+            add(validationData);
+        }
+    }
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return std::string(buffer);
+}
+
 ExternalMediaPlayerEngineImpl::ExternalMediaPlayerEngineImpl(const std::string& agent) :
         ExternalMediaAdapterHandlerInterface(agent), m_agent(agent) {
 }
@@ -61,7 +121,10 @@ bool ExternalMediaPlayerEngineImpl::initialize(
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::PlaybackRouterInterface> playbackRouter,
     std::shared_ptr<aace::engine::alexa::AudioPlayerObserverDelegate> audioPlayerObserverDelegate,
-    std::shared_ptr<aace::engine::alexa::ExternalMediaAdapterRegistrationInterface> externalMediaAdapterRegistration) {
+    std::shared_ptr<aace::engine::alexa::ExternalMediaAdapterRegistrationInterface> externalMediaAdapterRegistration,
+    std::chrono::milliseconds eventBatchWindow,
+    std::chrono::milliseconds discoveryReportWindow,
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage) {
     try {
         AACE_VERBOSE(LX(TAG));
 
@@ -81,7 +144,8 @@ bool ExternalMediaPlayerEngineImpl::initialize(
             contextManager,
             exceptionSender,
             playbackRouter,
-            externalMediaAdapterRegistration);
+            externalMediaAdapterRegistration,
+            eventBatchWindow);
         ThrowIfNull(m_externalMediaPlayerCapabilityAgent, "couldNotCreateCapabilityAgent");
 
         // delegate AudioPlayerObserverInterface
@@ -97,6 +161,8 @@ bool ExternalMediaPlayerEngineImpl::initialize(
 
         m_messageSender = messageSender;
         m_speakerManager = speakerManager;
+        m_discoveryReportWindow = discoveryReportWindow;
+        m_localStorage = localStorage;
 
         return true;
     } catch (std::exception& ex) {
@@ -118,7 +184,10 @@ std::shared_ptr<ExternalMediaPlayerEngineImpl> ExternalMediaPlayerEngineImpl::cr
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::PlaybackRouterInterface> playbackRouter,
     std::shared_ptr<aace::engine::alexa::AudioPlayerObserverDelegate> audioPlayerObserverDelegate,
     std::shared_ptr<aace::engine::alexa::ExternalMediaAdapterRegistrationInterface> externalMediaAdapterRegistration,
-    bool duckingEnabled) {
+    bool duckingEnabled,
+    std::chrono::milliseconds eventBatchWindow,
+    std::chrono::milliseconds discoveryReportWindow,
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage) {
     std::shared_ptr<ExternalMediaPlayerEngineImpl> externalMediaPlayerEngineImpl = nullptr;
 
     try {
@@ -139,7 +208,10 @@ std::shared_ptr<ExternalMediaPlayerEngineImpl> ExternalMediaPlayerEngineImpl::cr
                 exceptionSender,
                 playbackRouter,
                 audioPlayerObserverDelegate,
-                externalMediaAdapterRegistration),
+                externalMediaAdapterRegistration,
+                eventBatchWindow,
+                discoveryReportWindow,
+                localStorage),
             "initializeExternalMediaPlayerEngineImplFailed");
 
         return externalMediaPlayerEngineImpl;
@@ -260,43 +332,10 @@ std::vector<aace::engine::alexa::PlayerInfo> ExternalMediaPlayerEngineImpl::auth
     const std::vector<aace::engine::alexa::PlayerInfo>& authorizedPlayerList) {
     AACE_VERBOSE(LX(TAG));
     try {
-        std::vector<aace::engine::alexa::PlayerInfo> acknowledgedPlayerList;
         std::unique_lock<std::mutex> lock(m_playersMutex);
-        for (unsigned int j = 0; j < authorizedPlayerList.size(); j++) {
-            try {
-                aace::engine::alexa::PlayerInfo acknowledgedPlayerInfo = authorizedPlayerList[j];
-
-                if (m_pendingDiscoveredPlayerMap.find(acknowledgedPlayerInfo.localPlayerId) !=
-                    m_pendingDiscoveredPlayerMap.end()) {
-                    // Player has been acknowledged by cloud or local skill. Safe to exclude from future
-                    // ReportDiscoveredPlayers events
-                    AACE_VERBOSE(
-                        LX(TAG).d("removingPlayerFromPendingDiscoveryList", acknowledgedPlayerInfo.localPlayerId));
-                    m_pendingDiscoveredPlayerMap.erase(acknowledgedPlayerInfo.localPlayerId);
-                }
-                // add the player info to the authorized player list
-                acknowledgedPlayerList.push_back(acknowledgedPlayerInfo);
-
-                // add the player info to the authorized player map
-                m_authorizationStateMap[acknowledgedPlayerInfo.localPlayerId] = acknowledgedPlayerInfo;
-            } catch (std::exception& ex) {
-                AACE_ERROR(LX(TAG).d("reason", ex.what()));
-            }
-        }
-
-        // call the platform media adapter authorization method
-        if (acknowledgedPlayerList.empty() == false) {
-            for (auto& nextAdapter : m_externalMediaAdapterList) {
-                auto acknowledgedPlayers = nextAdapter->authorizeDiscoveredPlayers(acknowledgedPlayerList);
+        auto acknowledgedPlayerList = applyAuthorizationsLocked(authorizedPlayerList);
+        saveAuthorizationsLocked();
 
-                // add the authorized players to the media adapter player id map
-                for (auto& nextPlayerInfo : acknowledgedPlayers) {
-                    if (nextPlayerInfo.authorized) {
-                        m_externalMediaAdapterMap[nextPlayerInfo.playerId] = nextAdapter;
-                    }
-                }
-            }
-        }
         // send the authorization complete event
         auto event = createAuthorizationCompleteEventLocked();
         auto request = std::make_shared<alexaClientSDK::avsCommon::avs::MessageRequest>(event);
@@ -464,12 +503,20 @@ std::vector<aace::engine::alexa::AdapterState> ExternalMediaPlayerEngineImpl::ge
 
         // iterate through the media adapter list and add all of the adapter states
         // for the players that the adapter handles...
-        for (auto next : m_externalMediaAdapterList) {
-            auto adapterStates = next->getAdapterStates(all);
-            adapterStateList.insert(adapterStateList.end(), adapterStates.begin(), adapterStates.end());
-        }
+        auto adapters = m_externalMediaAdapterList;
         if (m_defaultExternalMediaAdapter != nullptr) {
-            auto adapterStates = m_defaultExternalMediaAdapter->getAdapterStates(all);
+            adapters.push_back(m_defaultExternalMediaAdapter);
+        }
+
+        // the adapters are queried concurrently, each waiting for its players until its deadline, unless only the
+        // default states are needed
+        auto policy = all ? std::launch::async : std::launch::deferred;
+        std::vector<std::future<std::vector<aace::engine::alexa::AdapterState>>> queries;
+        for (auto& next : adapters) {
+            queries.push_back(std::async(policy, [next, all]() { return next->getAdapterStates(all); }));
+        }
+        for (auto& next : queries) {
+            auto adapterStates = next.get();
             adapterStateList.insert(adapterStateList.end(), adapterStates.begin(), adapterStates.end());
         }
 
@@ -496,6 +543,47 @@ std::chrono::milliseconds ExternalMediaPlayerEngineImpl::getOffset(const std::st
     }
 }
 
+std::vector<aace::engine::alexa::PlayerInfo> ExternalMediaPlayerEngineImpl::applyAuthorizationsLocked(
+    const std::vector<aace::engine::alexa::PlayerInfo>& authorizedPlayerList) {
+    std::vector<aace::engine::alexa::PlayerInfo> acknowledgedPlayerList;
+    for (unsigned int j = 0; j < authorizedPlayerList.size(); j++) {
+        try {
+            aace::engine::alexa::PlayerInfo acknowledgedPlayerInfo = authorizedPlayerList[j];
+
+            if (m_pendingDiscoveredPlayerMap.find(acknowledgedPlayerInfo.localPlayerId) !=
+                m_pendingDiscoveredPlayerMap.end()) {
+                // Player has been acknowledged by cloud or local skill. Safe to exclude from future
+                // ReportDiscoveredPlayers events
+                AACE_VERBOSE(
+                    LX(TAG).d("removingPlayerFromPendingDiscoveryList", acknowledgedPlayerInfo.localPlayerId));
+                m_pendingDiscoveredPlayerMap.erase(acknowledgedPlayerInfo.localPlayerId);
+            }
+            // add the player info to the authorized player list
+            acknowledgedPlayerList.push_back(acknowledgedPlayerInfo);
+
+            // add the player info to the authorized player map
+            m_authorizationStateMap[acknowledgedPlayerInfo.localPlayerId] = acknowledgedPlayerInfo;
+        } catch (std::exception& ex) {
+            AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        }
+    }
+
+    // call the platform media adapter authorization method
+    if (acknowledgedPlayerList.empty() == false) {
+        for (auto& nextAdapter : m_externalMediaAdapterList) {
+            auto acknowledgedPlayers = nextAdapter->authorizeDiscoveredPlayers(acknowledgedPlayerList);
+
+            // add the authorized players to the media adapter player id map
+            for (auto& nextPlayerInfo : acknowledgedPlayers) {
+                if (nextPlayerInfo.authorized) {
+                    m_externalMediaAdapterMap[nextPlayerInfo.playerId] = nextAdapter;
+                }
+            }
+        }
+    }
+    return acknowledgedPlayerList;
+}
+
 std::string ExternalMediaPlayerEngineImpl::createReportDiscoveredPlayersEventLocked(
     const DiscoveredPlayerMap& discoveredPlayers) {
     try {
@@ -641,8 +729,18 @@ void ExternalMediaPlayerEngineImpl::reportDiscoveredPlayers(
                 }
             }
 
-            // send the pending discovered players if possible
-            sendDiscoveredPlayersIfReadyLocked(m_pendingDiscoveredPlayerMap);
+            if (m_discoveryReportWindow == std::chrono::milliseconds::zero()) {
+                // send the pending discovered players if possible
+                sendDiscoveredPlayersIfReadyLocked(m_pendingDiscoveredPlayerMap);
+            } else if (m_discoveryReportTimer == TimerWheel::INVALID_TIMER) {
+                // the players discovered until the end of the window are reported together
+                std::weak_ptr<ExternalMediaPlayerEngineImpl> wp = shared_from_this();
+                m_discoveryReportTimer = TimerWheel::getDefault()->submitAfter(m_discoveryReportWindow, [wp]() {
+                    if (auto engineImpl = wp.lock()) {
+                        engineImpl->flushDiscoveredPlayers();
+                    }
+                });
+            }
 
         } catch (std::exception& ex) {
             AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -650,6 +748,19 @@ void ExternalMediaPlayerEngineImpl::reportDiscoveredPlayers(
     });
 }
 
+void ExternalMediaPlayerEngineImpl::flushDiscoveredPlayers() {
+    m_executor.submit([this]() {
+        try {
+            AACE_VERBOSE(LX(TAG, "flushDiscoveredPlayersExec"));
+            std::lock_guard<std::mutex> lock(m_playersMutex);
+            m_discoveryReportTimer = TimerWheel::INVALID_TIMER;
+            sendDiscoveredPlayersIfReadyLocked(m_pendingDiscoveredPlayerMap);
+        } catch (std::exception& ex) {
+            AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        }
+    });
+}
+
 void ExternalMediaPlayerEngineImpl::removeDiscoveredPlayer(const std::string& localPlayerId) {
     AACE_VERBOSE(LX(TAG).d("removingPlayerId", localPlayerId));
     // if the player is removed while in focus, drop focus
@@ -676,6 +787,10 @@ void ExternalMediaPlayerEngineImpl::sendDiscoveredPlayersIfReadyLocked(const Dis
         auto connectionStatus = m_connectionStatus;
         lock.unlock();
         if (connectionStatus == Status::CONNECTED && discoveredPlayers.empty() == false) {
+            if (restoreAuthorizationsLocked(discoveredPlayers)) {
+                return;
+            }
+
             auto event = createReportDiscoveredPlayersEventLocked(discoveredPlayers);
             auto request = std::make_shared<alexaClientSDK::avsCommon::avs::MessageRequest>(event);
 
@@ -693,6 +808,80 @@ void ExternalMediaPlayerEngineImpl::sendDiscoveredPlayersIfReadyLocked(const Dis
     }
 }
 
+bool ExternalMediaPlayerEngineImpl::restoreAuthorizationsLocked(const DiscoveredPlayerMap& discoveredPlayers) {
+    try {
+        if (m_localStorage == nullptr || m_authorizationsRestoreAttempted) {
+            return false;
+        }
+        // the following reports, such as when the connection switches to another Alexa engine, are always sent
+        m_authorizationsRestoreAttempted = true;
+
+        auto hash = m_localStorage->get(EXTERNAL_MEDIA_PLAYER_TABLE, DISCOVERED_PLAYERS_HASH_KEY, "");
+        if (hash.empty() || hash != hashDiscoveredPlayers(m_agent, discoveredPlayers)) {
+            AACE_DEBUG(LX(TAG).m("discoveredPlayersChanged"));
+            return false;
+        }
+
+        auto authorizedPlayers =
+            aace::engine::utils::json::toJson(m_localStorage->get(EXTERNAL_MEDIA_PLAYER_TABLE, AUTHORIZED_PLAYERS_KEY));
+        ThrowIfNot(authorizedPlayers.is_array(), "invalidAuthorizedPlayers");
+
+        std::vector<aace::engine::alexa::PlayerInfo> authorizedPlayerList;
+        for (auto& next : authorizedPlayers) {
+            aace::engine::alexa::PlayerInfo info(
+                aace::engine::utils::json::get(next, "/localPlayerId", ""),
+                aace::engine::utils::json::get(next, "/spiVersion", ""),
+                aace::engine::utils::json::get(next, "/authorized", false));
+            info.playerId = aace::engine::utils::json::get(next, "/playerId", "");
+            info.skillToken = aace::engine::utils::json::get(next, "/skillToken", "");
+            info.playbackSessionId = aace::engine::utils::json::get(next, "/playbackSessionId", "");
+            ThrowIf(discoveredPlayers.find(info.localPlayerId) == discoveredPlayers.end(), "unknownAuthorizedPlayer");
+            authorizedPlayerList.push_back(info);
+        }
+        ThrowIf(authorizedPlayerList.size() != discoveredPlayers.size(), "missingAuthorizedPlayers");
+
+        applyAuthorizationsLocked(authorizedPlayerList);
+        AACE_INFO(LX(TAG).m("restoredDiscoveredPlayerAuthorizations").d("players", authorizedPlayerList.size()));
+        emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "restoreAuthorizations", {METRIC_RESTORED_AUTHORIZATIONS});
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+void ExternalMediaPlayerEngineImpl::saveAuthorizationsLocked() {
+    try {
+        // the authorizations are saved once every reported player is acknowledged
+        if (m_localStorage == nullptr || !m_pendingDiscoveredPlayerMap.empty() || m_allDiscoveredPlayersMap.empty()) {
+            return;
+        }
+
+        aace::engine::utils::json::Value authorizedPlayers = aace::engine::utils::json::Value::array();
+        for (auto& next : m_allDiscoveredPlayersMap) {
+            auto it = m_authorizationStateMap.find(next.first);
+            ThrowIf(it == m_authorizationStateMap.end(), "missingAuthorization");
+            auto& info = it->second;
+            authorizedPlayers.push_back(aace::engine::utils::json::Value(
+                {{"localPlayerId", info.localPlayerId},
+                 {"spiVersion", info.spiVersion},
+                 {"playerId", info.playerId},
+                 {"skillToken", info.skillToken},
+                 {"playbackSessionId", info.playbackSessionId},
+                 {"authorized", info.authorized}}));
+        }
+
+        ThrowIfNot(
+            m_localStorage->putBatch(
+                EXTERNAL_MEDIA_PLAYER_TABLE,
+                {{AUTHORIZED_PLAYERS_KEY, aace::engine::utils::json::toString(authorizedPlayers, false)},
+                 {DISCOVERED_PLAYERS_HASH_KEY, hashDiscoveredPlayers(m_agent, m_allDiscoveredPlayersMap)}}),
+            "saveAuthorizationsFailed");
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    }
+}
+
 std::string ExternalMediaPlayerEngineImpl::getLocalPlayerIdForSource(aace::alexa::LocalMediaSource::Source source) {
     try {
         switch (source) {
@@ -781,6 +970,15 @@ void ExternalMediaPlayerEngineImpl::setDefaultPlayerFocus() {
     }
 }
 
+void ExternalMediaPlayerEngineImpl::onAdapterStateChanged() {
+    try {
+        ThrowIfNull(m_externalMediaPlayerCapabilityAgent, "ExternalMediaPlayer is null");
+        m_externalMediaPlayerCapabilityAgent->invalidateAdapterStates();
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    }
+}
+
 void ExternalMediaPlayerEngineImpl::onConnectionStatusChanged(const Status status, const ChangedReason reason) {
     // no-op
 }
@@ -826,6 +1024,14 @@ void ExternalMediaPlayerEngineImpl::doShutdown() {
     m_executor.waitForSubmittedTasks();
     m_executor.shutdown();
 
+    {
+        std::lock_guard<std::mutex> lock(m_playersMutex);
+        if (m_discoveryReportTimer != TimerWheel::INVALID_TIMER) {
+            TimerWheel::getDefault()->cancel(m_discoveryReportTimer);
+            m_discoveryReportTimer = TimerWheel::INVALID_TIMER;
+        }
+    }
+
     m_registeredLocalMediaSources.clear();
     m_globalPresetHandler.reset();
 
@@ -51,6 +51,11 @@ static const std::string REQUEST_VERSION_TAG_PREFIX = "AUTO_SDK_";
 static const std::string REQUEST_VERSION_TAG_SEPARATOR = "_";
 static const int REQUEST_LIMIT_DEFAULT = 1;
 
+/// The table of the cached responses in the local storage
+static const std::string CACHE_TABLE = "aace.alexa.featureDiscovery";
+static const std::string CACHE_BODY = "body";
+static const std::string CACHE_TIME = "time";
+
 // Supported domains
 static const std::string DOMAIN_GETTING_STARTED = "GETTING_STARTED";
 static const std::string DOMAIN_TALENTS = "TALENTS";
@@ -74,11 +79,13 @@ static const std::string EVENT_THINGS_TO_TRY = "THINGS_TO_TRY";
 
 std::shared_ptr<FeatureDiscoveryEngineImpl> FeatureDiscoveryEngineImpl::create(
     std::shared_ptr<aace::alexa::FeatureDiscovery> platformInterface,
-    std::shared_ptr<aace::engine::core::EngineContext> engineContext) {
+    std::shared_ptr<aace::engine::core::EngineContext> engineContext,
+    std::chrono::seconds cacheTimeToLive) {
     try {
         ThrowIfNull(platformInterface, "nullPlatformInterface");
-        auto featureDiscoveryEngineImpl =
-            std::shared_ptr<FeatureDiscoveryEngineImpl>(new FeatureDiscoveryEngineImpl(platformInterface));
+        ThrowIf(cacheTimeToLive.count() < 0, "invalidCacheTimeToLive");
+        auto featureDiscoveryEngineImpl = std::shared_ptr<FeatureDiscoveryEngineImpl>(
+            new FeatureDiscoveryEngineImpl(platformInterface, cacheTimeToLive));
         ThrowIfNull(featureDiscoveryEngineImpl, "featureDiscoveryEngineImplIsNull");
         ThrowIfNot(
             featureDiscoveryEngineImpl->initialize(engineContext), "failedToInitializeFeatureDiscoveryEngineImpl");
@@ -90,8 +97,11 @@ std::shared_ptr<FeatureDiscoveryEngineImpl> FeatureDiscoveryEngineImpl::create(
 }
 
 FeatureDiscoveryEngineImpl::FeatureDiscoveryEngineImpl(
-    std::shared_ptr<aace::alexa::FeatureDiscovery> platformInterface) :
-        alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG), m_platformInterface(platformInterface) {
+    std::shared_ptr<aace::alexa::FeatureDiscovery> platformInterface,
+    std::chrono::seconds cacheTimeToLive) :
+        alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
+        m_platformInterface(platformInterface),
+        m_cacheTimeToLive(cacheTimeToLive) {
 }
 
 bool FeatureDiscoveryEngineImpl::initialize(std::shared_ptr<aace::engine::core::EngineContext> engineContext) {
@@ -117,6 +127,19 @@ bool FeatureDiscoveryEngineImpl::initialize(std::shared_ptr<aace::engine::core::
         m_featureDiscoveryRESTAgent = FeatureDiscoveryRESTAgent::create(authDelegate, alexaEndpoints);
         ThrowIfNull(m_featureDiscoveryRESTAgent, "nullFeatureDiscoveryRESTAgent");
 
+        // the requests wait for the network, and for the voice interaction to end
+        m_backgroundTransferScheduler =
+            engineContext->getServiceInterface<aace::engine::network::BackgroundTransferScheduler>("aace.network");
+
+        // the cached responses persist across restarts, so the features show before the network is up
+        if (m_cacheTimeToLive.count() > 0) {
+            m_localStorage =
+                engineContext->getServiceInterface<aace::engine::storage::LocalStorageInterface>("aace.storage");
+            if (m_localStorage == nullptr) {
+                AACE_WARN(LX(TAG).m("nullLocalStorageInterface").m("cachingInMemoryOnly"));
+            }
+        }
+
         // initialize the software version tag
         aace::engine::core::Version engineVersion = aace::engine::core::version::getEngineVersion();
         m_tag = REQUEST_VERSION_TAG_PREFIX + std::to_string(engineVersion.major_version()) +
@@ -157,6 +180,20 @@ bool FeatureDiscoveryEngineImpl::onGetFeatures(const std::string& requestId, con
         emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "onGetFeatures", {METRIC_FEATURES_RECEIVED_FAILURE});
         return false;
     }
+    if (m_backgroundTransferScheduler != nullptr) {
+        std::weak_ptr<FeatureDiscoveryEngineImpl> wp = shared_from_this();
+        auto submitted = m_backgroundTransferScheduler->submit(
+            "FeatureDiscovery." + requestId,
+            aace::engine::network::BackgroundTransferScheduler::Priority::INTERACTIVE,
+            [wp, requestId, discoveryRequests]() {
+                if (auto featureDiscoveryEngineImpl = wp.lock()) {
+                    featureDiscoveryEngineImpl->executeOnGetFeatures(requestId, discoveryRequests);
+                }
+            });
+        if (submitted) {
+            return true;
+        }
+    }
     executeOnGetFeatures(requestId, discoveryRequests);
     return true;
 }
@@ -196,9 +233,7 @@ void FeatureDiscoveryEngineImpl::executeOnGetFeatures(
 
                 auto queryString =
                     m_featureDiscoveryRESTAgent->createUrlFromParameters(domain, eventType, limit, m_tag);
-                auto response = m_featureDiscoveryRESTAgent->getHTTPResponseFromCloud(queryString, selectedLocale);
-                auto discoveredFeatures =
-                    m_featureDiscoveryRESTAgent->getFeaturesFromHTTPResponse(response, selectedLocale);
+                auto discoveredFeatures = getFeatures(queryString, selectedLocale);
                 ThrowIf(discoveredFeatures.empty(), "discoveredFeaturesEmpty");
 
                 auto featuresArray = json::array();
@@ -231,6 +266,106 @@ void FeatureDiscoveryEngineImpl::executeOnGetFeatures(
     });
 }
 
+std::vector<FeatureDiscoveryRESTAgent::LocalizedFeature> FeatureDiscoveryEngineImpl::getFeatures(
+    const std::string& url,
+    const std::string& locale) {
+    if (m_cacheTimeToLive.count() == 0) {
+        auto response = m_featureDiscoveryRESTAgent->getHTTPResponseFromCloud(url, locale);
+        return m_featureDiscoveryRESTAgent->getFeaturesFromHTTPResponse(response, locale);
+    }
+
+    // the URL has the domain, the event type, the limit and the version tag of the request
+    std::string key = locale + " " + url;
+    auto it = m_cache.find(key);
+    if (it == m_cache.end() && m_localStorage != nullptr && m_localStorage->containsKey(CACHE_TABLE, key)) {
+        try {
+            auto cached = json::parse(m_localStorage->get(CACHE_TABLE, key));
+            CachedResponse cachedResponse;
+            cachedResponse.body = cached.at(CACHE_BODY).get<std::string>();
+            cachedResponse.time = std::chrono::system_clock::time_point(
+                std::chrono::milliseconds(cached.at(CACHE_TIME).get<int64_t>()));
+            it = m_cache.emplace(key, std::move(cachedResponse)).first;
+        } catch (std::exception& ex) {
+            AACE_WARN(LX(TAG).d("reason", ex.what()).m("removingInvalidCachedResponse"));
+            m_localStorage->removeKey(CACHE_TABLE, key);
+        }
+    }
+    if (it == m_cache.end()) {
+        return requestFeatures(key, url, locale);
+    }
+
+    FeatureDiscoveryRESTAgent::HTTPResponse response;
+    response.code = HTTPResponseCode::SUCCESS_OK;
+    response.body = it->second.body;
+    auto features = m_featureDiscoveryRESTAgent->getFeaturesFromHTTPResponse(response, locale);
+    if (features.empty()) {
+        m_cache.erase(it);
+        return requestFeatures(key, url, locale);
+    }
+
+    // a response from the future is stale, the clock was set back since it was received
+    auto age = std::chrono::system_clock::now() - it->second.time;
+    if ((age < std::chrono::system_clock::duration::zero() || age >= m_cacheTimeToLive) &&
+        m_revalidating.insert(key).second) {
+        AACE_DEBUG(LX(TAG).m("revalidatingCachedResponse").d("url", url).d("locale", locale));
+        std::weak_ptr<FeatureDiscoveryEngineImpl> wp = shared_from_this();
+        auto revalidate = [wp, key, url, locale]() {
+            if (auto featureDiscoveryEngineImpl = wp.lock()) {
+                featureDiscoveryEngineImpl->m_executor.submit([wp, key, url, locale]() {
+                    if (auto featureDiscoveryEngineImpl = wp.lock()) {
+                        featureDiscoveryEngineImpl->executeRevalidate(key, url, locale);
+                    }
+                });
+            }
+        };
+        // nobody waits for the revalidation, so it yields to the interactive transfers
+        if (m_backgroundTransferScheduler == nullptr ||
+            !m_backgroundTransferScheduler->submit(
+                "FeatureDiscovery.revalidate." + key,
+                aace::engine::network::BackgroundTransferScheduler::Priority::BACKGROUND,
+                revalidate)) {
+            revalidate();
+        }
+    }
+    return features;
+}
+
+void FeatureDiscoveryEngineImpl::executeRevalidate(
+    const std::string& key,
+    const std::string& url,
+    const std::string& locale) {
+    m_revalidating.erase(key);
+    requestFeatures(key, url, locale);
+}
+
+std::vector<FeatureDiscoveryRESTAgent::LocalizedFeature> FeatureDiscoveryEngineImpl::requestFeatures(
+    const std::string& key,
+    const std::string& url,
+    const std::string& locale) {
+    auto response = m_featureDiscoveryRESTAgent->getHTTPResponseFromCloud(url, locale);
+    auto features = m_featureDiscoveryRESTAgent->getFeaturesFromHTTPResponse(response, locale);
+    if (features.empty()) {
+        // a failed request keeps the previous response, if any, until the next revalidation
+        return features;
+    }
+
+    CachedResponse cachedResponse;
+    cachedResponse.body = response.body;
+    cachedResponse.time = std::chrono::system_clock::now();
+    if (m_localStorage != nullptr) {
+        json cached = {{CACHE_BODY, cachedResponse.body},
+                       {CACHE_TIME,
+                        std::chrono::duration_cast<std::chrono::milliseconds>(
+                            cachedResponse.time.time_since_epoch())
+                            .count()}};
+        if (!m_localStorage->put(CACHE_TABLE, key, cached.dump())) {
+            AACE_WARN(LX(TAG).m("putCachedResponseFailed"));
+        }
+    }
+    m_cache[key] = std::move(cachedResponse);
+    return features;
+}
+
 void FeatureDiscoveryEngineImpl::doShutdown() {
     m_executor.waitForSubmittedTasks();
     m_executor.shutdown();
@@ -16,6 +16,7 @@
 #include <AACE/Engine/Core/EngineMacros.h>
 #include <AACE/Alexa/AlexaEngineInterfaces.h>
 #include <AACE/Engine/Alexa/FeatureDiscoveryRESTAgent.h>
+#include <AACE/Engine/Alexa/HttpClientPool.h>
 #include <nlohmann/json.hpp>
 
 namespace aace {
@@ -143,12 +144,7 @@ FeatureDiscoveryRESTAgent::HTTPResponse FeatureDiscoveryRESTAgent::doGet(
     const std::string& url,
     const std::vector<std::string>& headers) {
     try {
-        // Creating the HttpGet on every doGet is by design to ensure that curl in libcurlUtils uses the
-        // latest provided curl options.
-        auto httpGet = alexaClientSDK::avsCommon::utils::libcurlUtils::HttpGet::create();
-        ThrowIfNull(httpGet, "nullHttpGet");
-
-        return httpGet->doGet(url, headers, DEFAULT_HTTP_TIMEOUT);
+        return HttpClientPool::getInstance()->doGet(url, headers, DEFAULT_HTTP_TIMEOUT);
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return FeatureDiscoveryRESTAgent::HTTPResponse();
@@ -0,0 +1,368 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cctype>
+
+#include <zlib.h>
+
+#include <AACE/Engine/Alexa/HttpClientPool.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.HttpClientPool");
+
+/// The most idle clients kept for each HTTP method, the clients above it are closed when their request completes.
+static const size_t MAX_IDLE_CLIENTS = 4;
+
+/// The size of the chunks a compressed response is inflated into
+static const size_t INFLATE_CHUNK_SIZE = 16384;
+
+/// The header accepting the compressed responses
+static const std::string ACCEPT_ENCODING_HEADER = "Accept-Encoding: gzip, deflate";
+
+/// The prefix of the header naming the encoding of a body, in lowercase
+static const std::string CONTENT_ENCODING_PREFIX = "content-encoding:";
+
+const size_t HttpClientPool::MIN_COMPRESSED_BODY_SIZE = 256;
+
+const size_t HttpClientPool::REQUEST_THREAD_COUNT = 4;
+
+using namespace alexaClientSDK::avsCommon::utils::libcurlUtils;
+
+/// Returns @c true if one of the headers names the encoding of the body.
+static bool hasContentEncoding(const std::vector<std::string>& headers) {
+    auto matchesPrefix = [](const std::string& header) {
+        return header.size() >= CONTENT_ENCODING_PREFIX.size() &&
+               std::equal(
+                   CONTENT_ENCODING_PREFIX.begin(), CONTENT_ENCODING_PREFIX.end(), header.begin(), [](char a, char b) {
+                       return a == std::tolower(static_cast<unsigned char>(b));
+                   });
+    };
+    return std::any_of(headers.begin(), headers.end(), matchesPrefix);
+}
+
+/// Returns @c true if a body starts with a gzip or zlib header.
+static bool isCompressed(const std::string& data) {
+    if (data.size() < 2) {
+        return false;
+    }
+    auto first = static_cast<unsigned char>(data[0]);
+    auto second = static_cast<unsigned char>(data[1]);
+    // the gzip magic number, or the deflate method of a zlib header with its check bits
+    return (first == 0x1f && second == 0x8b) || ((first & 0x0f) == Z_DEFLATED && ((first << 8) | second) % 31 == 0);
+}
+
+std::shared_ptr<HttpClientPool> HttpClientPool::getInstance() {
+    static std::shared_ptr<HttpClientPool> s_instance(new HttpClientPool());
+    return s_instance;
+}
+
+template <typename Client>
+std::pair<std::unique_ptr<Client>, uint64_t> HttpClientPool::Clients<Client>::acquire() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto generation = m_generation;
+    if (!m_idle.empty()) {
+        auto client = std::move(m_idle.back());
+        m_idle.pop_back();
+        return std::make_pair(std::move(client), generation);
+    }
+    // create the client outside of the lock, curl_easy_init is not free
+    lock.unlock();
+    return std::make_pair(Client::create(), generation);
+}
+
+template <typename Client>
+void HttpClientPool::Clients<Client>::release(std::unique_ptr<Client> client, uint64_t generation) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (generation == m_generation && m_idle.size() < MAX_IDLE_CLIENTS) {
+        m_idle.push_back(std::move(client));
+    }
+}
+
+template <typename Client>
+void HttpClientPool::Clients<Client>::clear() {
+    std::vector<std::unique_ptr<Client>> idle;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_generation++;
+        idle.swap(m_idle);
+    }
+}
+
+template <typename Client>
+size_t HttpClientPool::Clients<Client>::size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_idle.size();
+}
+
+template <typename Client, typename Send>
+HttpClientPool::HTTPResponse HttpClientPool::perform(
+    Clients<Client>& clients,
+    const std::string& event,
+    Send request) {
+    if (m_cancelled) {
+        AACE_WARN(LX(TAG, event).d("reason", "requestCancelled"));
+        return HTTPResponse();
+    }
+    try {
+        auto acquired = clients.acquire();
+        ThrowIfNull(acquired.first, "createClientFailed");
+
+        auto response = request(*acquired.first);
+        clients.release(std::move(acquired.first), acquired.second);
+        return response;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, event).d("reason", ex.what()));
+        return HTTPResponse();
+    }
+}
+
+template <typename Client, typename Send>
+HttpClientPool::HTTPResponse HttpClientPool::performEncoded(
+    Clients<Client>& clients,
+    const std::string& event,
+    const std::vector<std::string>& headers,
+    const std::string& data,
+    ContentEncoding encoding,
+    Send request) {
+    if (encoding == ContentEncoding::IDENTITY) {
+        return perform(clients, event, [&](Client& client) { return request(client, headers, data); });
+    }
+
+    auto encodedHeaders = headers;
+    encodedHeaders.push_back(ACCEPT_ENCODING_HEADER);
+    std::string compressed;
+    if (data.size() >= MIN_COMPRESSED_BODY_SIZE && !hasContentEncoding(headers) &&
+        compressBody(data, encoding, compressed)) {
+        encodedHeaders.push_back(
+            encoding == ContentEncoding::GZIP ? "Content-Encoding: gzip" : "Content-Encoding: deflate");
+    }
+    auto& body = compressed.empty() ? data : compressed;
+
+    auto response =
+        perform(clients, event, [&](Client& client) { return request(client, encodedHeaders, body); });
+    // the response headers are not returned by the clients, so the compressed response is recognized from its body
+    std::string inflated;
+    if (isCompressed(response.body) && inflateBody(response.body, inflated)) {
+        response.body = std::move(inflated);
+    }
+    return response;
+}
+
+HttpClientPool::HTTPResponse HttpClientPool::doPost(
+    const std::string& url,
+    const std::vector<std::string>& headerLines,
+    const std::string& data,
+    std::chrono::seconds timeout,
+    ContentEncoding encoding) {
+    return performEncoded(
+        m_postClients,
+        "doPost",
+        headerLines,
+        data,
+        encoding,
+        [&](HttpPost& client, const std::vector<std::string>& headers, const std::string& body) {
+            return client.doPost(url, headers, body, timeout);
+        });
+}
+
+HttpClientPool::HTTPResponse HttpClientPool::doPost(
+    const std::string& url,
+    const std::vector<std::string>& headerLines,
+    const std::vector<std::pair<std::string, std::string>>& data,
+    std::chrono::seconds timeout) {
+    return perform(m_postClients, "doPost", [&](HttpPost& client) {
+        return client.doPost(url, headerLines, data, timeout);
+    });
+}
+
+HttpClientPool::HTTPResponse HttpClientPool::doGet(
+    const std::string& url,
+    const std::vector<std::string>& headers,
+    std::chrono::seconds timeout) {
+    return perform(m_getClients, "doGet", [&](HttpGet& client) { return client.doGet(url, headers, timeout); });
+}
+
+HttpClientPool::HTTPResponse HttpClientPool::doDelete(
+    const std::string& url,
+    const std::vector<std::string>& headers,
+    std::chrono::seconds timeout) {
+    return perform(
+        m_deleteClients, "doDelete", [&](HttpDelete& client) { return client.doDelete(url, headers, timeout); });
+}
+
+HttpClientPool::HTTPResponse HttpClientPool::doPut(
+    const std::string& url,
+    const std::vector<std::string>& headers,
+    const std::string& data,
+    ContentEncoding encoding) {
+    return performEncoded(
+        m_putClients,
+        "doPut",
+        headers,
+        data,
+        encoding,
+        [&](HttpPut& client, const std::vector<std::string>& encodedHeaders, const std::string& body) {
+            return client.doPut(url, encodedHeaders, body);
+        });
+}
+
+bool HttpClientPool::submit(Request request, ResponseCallback callback) {
+    try {
+        ThrowIfNot(request, "invalidRequest");
+        ThrowIfNot(callback, "invalidCallback");
+
+        std::shared_ptr<aace::engine::utils::threading::ThreadPool> requestThreads;
+        {
+            std::lock_guard<std::mutex> lock(m_requestThreadsMutex);
+            if (m_requestThreads == nullptr) {
+                m_requestThreads =
+                    aace::engine::utils::threading::ThreadPool::create(REQUEST_THREAD_COUNT, "HttpClientPool");
+                ThrowIfNull(m_requestThreads, "createRequestThreadsFailed");
+            }
+            requestThreads = m_requestThreads;
+        }
+
+        // the pool is process wide, and outlives the requests
+        auto posted = requestThreads->post([this, request, callback]() {
+            HTTPResponse response;
+            try {
+                response = request(*this);
+            } catch (std::exception& ex) {
+                AACE_ERROR(LX(TAG, "submit").d("reason", ex.what()));
+            }
+            callback(response);
+        });
+        ThrowIfNot(posted, "postFailed");
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool HttpClientPool::doPostAsync(
+    const std::string& url,
+    const std::vector<std::string>& headerLines,
+    const std::vector<std::pair<std::string, std::string>>& data,
+    std::chrono::seconds timeout,
+    ResponseCallback callback) {
+    return submit(
+        [url, headerLines, data, timeout](HttpClientPool& pool) {
+            return pool.doPost(url, headerLines, data, timeout);
+        },
+        std::move(callback));
+}
+
+bool HttpClientPool::doGetAsync(
+    const std::string& url,
+    const std::vector<std::string>& headers,
+    std::chrono::seconds timeout,
+    ResponseCallback callback) {
+    return submit(
+        [url, headers, timeout](HttpClientPool& pool) { return pool.doGet(url, headers, timeout); },
+        std::move(callback));
+}
+
+void HttpClientPool::clear() {
+    AACE_DEBUG(LX(TAG).d("idleClients", getIdleClientCount()));
+    m_postClients.clear();
+    m_getClients.clear();
+    m_deleteClients.clear();
+    m_putClients.clear();
+}
+
+size_t HttpClientPool::getIdleClientCount() {
+    return m_postClients.size() + m_getClients.size() + m_deleteClients.size() + m_putClients.size();
+}
+
+void HttpClientPool::setCancelled(bool cancelled) {
+    AACE_INFO(LX(TAG).d("cancelled", cancelled));
+    m_cancelled = cancelled;
+}
+
+bool HttpClientPool::isCancelled() const {
+    return m_cancelled;
+}
+
+bool HttpClientPool::compressBody(const std::string& data, ContentEncoding encoding, std::string& compressed) {
+    z_stream zstr{};
+    try {
+        ThrowIf(encoding == ContentEncoding::IDENTITY, "invalidEncoding");
+        // the gzip format is selected by adding 16 to the window bits
+        auto windowBits = encoding == ContentEncoding::GZIP ? MAX_WBITS + 16 : MAX_WBITS;
+        auto ret =
+            deflateInit2(&zstr, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+        ThrowIfNot(ret == Z_OK, "deflateInitFailed");
+
+        // the bound of a gzip stream doesn't count its longer header and trailer
+        std::string output(deflateBound(&zstr, data.size()) + 12, '\0');
+        zstr.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        zstr.avail_in = data.size();
+        zstr.next_out = reinterpret_cast<Bytef*>(&output[0]);
+        zstr.avail_out = output.size();
+        ret = deflate(&zstr, Z_FINISH);
+        ThrowIfNot(ret == Z_STREAM_END, "deflateFailed");
+
+        output.resize(zstr.total_out);
+        deflateEnd(&zstr);
+        compressed = std::move(output);
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("size", data.size()));
+        deflateEnd(&zstr);
+        return false;
+    }
+}
+
+bool HttpClientPool::inflateBody(const std::string& data, std::string& inflated) {
+    z_stream zstr{};
+    try {
+        // the gzip and zlib formats are detected from the header by adding 32 to the window bits
+        auto ret = inflateInit2(&zstr, MAX_WBITS + 32);
+        ThrowIfNot(ret == Z_OK, "inflateInitFailed");
+
+        std::string output;
+        std::unique_ptr<char[]> chunk(new char[INFLATE_CHUNK_SIZE]);
+        zstr.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        zstr.avail_in = data.size();
+        do {
+            zstr.next_out = reinterpret_cast<Bytef*>(chunk.get());
+            zstr.avail_out = INFLATE_CHUNK_SIZE;
+            ret = ::inflate(&zstr, Z_NO_FLUSH);
+            ThrowIf(ret != Z_OK && ret != Z_STREAM_END, "inflateFailed");
+            output.append(chunk.get(), INFLATE_CHUNK_SIZE - zstr.avail_out);
+            // a truncated body stops making progress before the end of the stream
+            ThrowIf(ret == Z_OK && zstr.avail_in == 0 && zstr.avail_out != 0, "truncatedBody");
+        } while (ret != Z_STREAM_END);
+
+        inflateEnd(&zstr);
+        inflated = std::move(output);
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("size", data.size()));
+        inflateEnd(&zstr);
+        return false;
+    }
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
@@ -31,6 +31,16 @@ bool InitiatorVerifier::shouldBlock(const std::string& wakeword, const std::chro
     return false;
 }
 
+bool InitiatorVerifier::shouldBlock(
+    const std::string& wakeword,
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+    alexaClientSDK::avsCommon::avs::AudioInputStream::Index beginIndex,
+    alexaClientSDK::avsCommon::avs::AudioInputStream::Index endIndex,
+    const std::chrono::milliseconds& timeout) {
+    // Verifiers that don't look at the audio only verify the wakeword
+    return shouldBlock(wakeword, timeout);
+}
+
 bool InitiatorVerifier::shouldBlock(const alexaClientSDK::capabilityAgents::aip::Initiator& initiator) {
     // Should not block by default if this function is not implemented
     return false;
@@ -35,6 +35,9 @@ static const std::string TAG("aace.alexa.LocalMediaSourceEngineImpl");
 
 static const std::string CONTENT_SELECTOR_SEPARATOR = ":";
 
+/// The age of the converted state after which a state query also refreshes it, for the changes without events
+static const std::chrono::seconds STATE_MAX_AGE{10};
+
 static const std::string DEFAULT_PLAYERCOOKIE_PAYLOAD = R"(
     {
         "cookieVersion": "1.0",
@@ -212,6 +215,7 @@ bool LocalMediaSourceEngineImpl::handlePlay(
             m_platformLocalMediaSource->play(contentSelector, selectionPayload) ||
                 m_platformLocalMediaSource->play(contentSelector, selectionPayload, playbackSessionId),
             "platformMediaAdapterPlayFailed");
+        scheduleStateRefresh();
         // set focus on successful play
         ThrowIfNot(setFocus(m_localPlayerId, true), "setFocusFailed");
         return true;
@@ -235,6 +239,7 @@ bool LocalMediaSourceEngineImpl::handlePlayControl(
         AACE_VERBOSE(LX(TAG));
 
         ThrowIfNot(m_platformLocalMediaSource->playControl(playControlType), "platformMediaAdapterPlayControlFailed");
+        scheduleStateRefresh();
         // set focus on successful RESUME control
         if (playControlType == aace::alexa::ExternalMediaAdapter::PlayControlType::RESUME)
             ThrowIfNot(setFocus(m_localPlayerId, true), "setFocusFailed");
@@ -262,6 +267,7 @@ bool LocalMediaSourceEngineImpl::handleSeek(const std::string& localPlayerId, st
         AACE_VERBOSE(LX(TAG).d("localPlayerId", localPlayerId));
 
         ThrowIfNot(m_platformLocalMediaSource->seek(offset), "platformMediaAdapterSeekFailed");
+        scheduleStateRefresh();
 
         return true;
     } catch (std::exception& ex) {
@@ -278,6 +284,7 @@ bool LocalMediaSourceEngineImpl::handleAdjustSeek(
         AACE_VERBOSE(LX(TAG).d("localPlayerId", localPlayerId));
 
         ThrowIfNot(m_platformLocalMediaSource->adjustSeek(deltaOffset), "platformMediaAdapterAdjustSeekFailed");
+        scheduleStateRefresh();
 
         return true;
     } catch (std::exception& ex) {
@@ -290,138 +297,40 @@ bool LocalMediaSourceEngineImpl::handleGetAdapterState(
     const std::string& localPlayerId,
     aace::engine::alexa::AdapterState& state) {
     try {
-        auto platformState = m_platformLocalMediaSource->getState();
-        auto platformSource = m_platformLocalMediaSource->getSource();
+        std::unique_lock<std::mutex> lock(m_stateMutex);
+        if (!m_stateValid) {
+            lock.unlock();
+
+            // the platform is queried until the first refresh completes
+            ThrowIfNull(m_platformLocalMediaSource, "invalidPlatformLocalMediaSource");
+            auto platformState = m_platformLocalMediaSource->getState();
+            convertState(platformState, m_platformLocalMediaSource->getSource(), state);
+            scheduleStateRefresh();
+            return true;
+        }
 
-        // session state
-        if (platformState.sessionState.spiVersion.empty() == false) {
-            state.sessionState.spiVersion = platformState.sessionState.spiVersion;
+        // the session of the player is kept from the default state
+        auto sessionState = state.sessionState;
+        state = m_state;
+        state.sessionState.skillToken = sessionState.skillToken;
+        state.sessionState.playbackSessionId = sessionState.playbackSessionId;
+        if (state.sessionState.spiVersion.empty()) {
+            state.sessionState.spiVersion = sessionState.spiVersion;
         }
-        state.sessionState.playerId = getPlayerId(platformSource);
-        state.sessionState.endpointId = platformState.sessionState.endpointId;
-        state.sessionState.loggedIn = platformState.sessionState.loggedIn;
-        state.sessionState.userName = platformState.sessionState.userName;
-        state.sessionState.isGuest = platformState.sessionState.isGuest;
-        state.sessionState.launched = platformState.sessionState.launched;
-        state.sessionState.active = platformState.sessionState.active;
-        state.sessionState.accessToken = platformState.sessionState.accessToken;
-        state.sessionState.tokenRefreshInterval = platformState.sessionState.tokenRefreshInterval;
-
-        // construct playercookie payload
-        rapidjson::Document document;
-        document.Parse<0>(DEFAULT_PLAYERCOOKIE_PAYLOAD.c_str());
-        rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
-        for (auto next : platformState.sessionState.supportedContentSelectors) {
-            switch (next) {
-                case aace::alexa::LocalMediaSource::ContentSelector::FREQUENCY:
-                    document["capabilities"].AddMember("playFrequency", "1.0", allocator);
-                    break;
-                case aace::alexa::LocalMediaSource::ContentSelector::CHANNEL:
-                    document["capabilities"].AddMember("playChannel", "1.0", allocator);
-                    break;
-                case aace::alexa::LocalMediaSource::ContentSelector::PRESET:
-                    document["capabilities"].AddMember("playPreset", "1.0", allocator);
-                    break;
+
+        // the offset of a playing source advances from the refresh
+        auto age = std::chrono::steady_clock::now() - m_stateTime;
+        if (state.playbackState.state == aace::engine::alexa::PLAYING) {
+            state.playbackState.trackOffset += std::chrono::duration_cast<std::chrono::milliseconds>(age);
+            auto duration = state.playbackState.duration;
+            if (duration > std::chrono::milliseconds::zero() && state.playbackState.trackOffset > duration) {
+                state.playbackState.trackOffset = duration;
             }
         }
+        lock.unlock();
 
-        // add dynamic pluggable capability clearlist payload
-        document["capabilities"].AddMember("enableIsLaunched", "1.0", allocator);
-
-        rapidjson::StringBuffer strbuf;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(strbuf);
-        document.Accept(writer);
-        state.sessionState.playerCookie = strbuf.GetString();
-
-        // playback state
-        state.playbackState.playerId = getPlayerId(platformSource);
-        state.playbackState.state = platformState.playbackState.state;
-        state.playbackState.trackOffset = platformState.playbackState.trackOffset;
-        state.playbackState.shuffleEnabled = platformState.playbackState.shuffleEnabled;
-        state.playbackState.repeatEnabled = platformState.playbackState.repeatEnabled;
-        state.playbackState.repeatOneEnabled = platformState.playbackState.repeatOneEnabled;
-        state.playbackState.favorites =
-            static_cast<aace::engine::alexa::Favorites>(platformState.playbackState.favorites);
-        state.playbackState.type = platformState.playbackState.type;
-        state.playbackState.playbackSource = platformState.playbackState.playbackSource;
-        state.playbackState.playbackSourceId = platformState.playbackState.playbackSourceId;
-        state.playbackState.trackName = platformState.playbackState.trackName;
-        state.playbackState.trackId = platformState.playbackState.trackId;
-        state.playbackState.trackNumber = platformState.playbackState.trackNumber;
-        state.playbackState.artistName = platformState.playbackState.artistName;
-        state.playbackState.artistId = platformState.playbackState.artistId;
-        state.playbackState.albumName = platformState.playbackState.albumName;
-        state.playbackState.albumId = platformState.playbackState.albumId;
-        state.playbackState.tinyURL = platformState.playbackState.tinyURL;
-        state.playbackState.smallURL = platformState.playbackState.smallURL;
-        state.playbackState.mediumURL = platformState.playbackState.mediumURL;
-        state.playbackState.largeURL = platformState.playbackState.largeURL;
-        state.playbackState.coverId = platformState.playbackState.coverId;
-        state.playbackState.mediaProvider = platformState.playbackState.mediaProvider;
-        state.playbackState.mediaType =
-            static_cast<aace::engine::alexa::MediaType>(platformState.playbackState.mediaType);
-        state.playbackState.duration = platformState.playbackState.duration;
-
-        // convert AAC SupportedPlaybackOperation to AVS SupportedPlaybackOperation
-        using avsSupportedPlaybackOperation = aace::engine::alexa::SupportedPlaybackOperation;
-
-        for (auto nextOp : platformState.playbackState.supportedOperations) {
-            switch (nextOp) {
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::PLAY:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::PLAY);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::PAUSE:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::PAUSE);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::STOP:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::STOP);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::NEXT:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::NEXT);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::PREVIOUS:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::PREVIOUS);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::START_OVER:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::START_OVER);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::FAST_FORWARD:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::FAST_FORWARD);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::REWIND:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::REWIND);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::ENABLE_REPEAT:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::ENABLE_REPEAT);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::ENABLE_REPEAT_ONE:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::ENABLE_REPEAT_ONE);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::DISABLE_REPEAT:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::DISABLE_REPEAT);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::ENABLE_SHUFFLE:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::ENABLE_SHUFFLE);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::DISABLE_SHUFFLE:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::DISABLE_SHUFFLE);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::FAVORITE:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::FAVORITE);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::UNFAVORITE:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::UNFAVORITE);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::SEEK:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::SEEK);
-                    break;
-                case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::ADJUST_SEEK:
-                    state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::ADJUST_SEEK);
-                    break;
-                default:
-                    AACE_VERBOSE(LX(TAG).m("Unexpected SupportedPlaybackOperation"));
-                    break;
-            }
+        if (age >= STATE_MAX_AGE) {
+            scheduleStateRefresh();
         }
 
         return true;
@@ -431,6 +340,177 @@ bool LocalMediaSourceEngineImpl::handleGetAdapterState(
     }
 }
 
+void LocalMediaSourceEngineImpl::scheduleStateRefresh() {
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    if (!m_stateRefreshQueued) {
+        m_stateRefreshQueued = true;
+        m_stateExecutor.submit([this]() { refreshState(); });
+    }
+}
+
+void LocalMediaSourceEngineImpl::refreshState() {
+    try {
+        {
+            // an event during the refresh queues another refresh
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            m_stateRefreshQueued = false;
+        }
+        ThrowIfNull(m_platformLocalMediaSource, "invalidPlatformLocalMediaSource");
+
+        auto start = std::chrono::steady_clock::now();
+        auto platformState = m_platformLocalMediaSource->getState();
+        aace::engine::alexa::AdapterState state;
+        convertState(platformState, m_platformLocalMediaSource->getSource(), state);
+        {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            m_state = state;
+            m_stateTime = start;
+            m_stateValid = true;
+        }
+
+        // the external media player queries the refreshed state
+        reportStateChanged();
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "refreshState").d("reason", ex.what()));
+    }
+}
+
+void LocalMediaSourceEngineImpl::convertState(
+    const aace::alexa::LocalMediaSource::LocalMediaSourceState& platformState,
+    Source platformSource,
+    aace::engine::alexa::AdapterState& state) {
+    // session state
+    if (platformState.sessionState.spiVersion.empty() == false) {
+        state.sessionState.spiVersion = platformState.sessionState.spiVersion;
+    }
+    state.sessionState.playerId = getPlayerId(platformSource);
+    state.sessionState.endpointId = platformState.sessionState.endpointId;
+    state.sessionState.loggedIn = platformState.sessionState.loggedIn;
+    state.sessionState.userName = platformState.sessionState.userName;
+    state.sessionState.isGuest = platformState.sessionState.isGuest;
+    state.sessionState.launched = platformState.sessionState.launched;
+    state.sessionState.active = platformState.sessionState.active;
+    state.sessionState.accessToken = platformState.sessionState.accessToken;
+    state.sessionState.tokenRefreshInterval = platformState.sessionState.tokenRefreshInterval;
+
+    // construct playercookie payload
+    rapidjson::Document document;
+    document.Parse<0>(DEFAULT_PLAYERCOOKIE_PAYLOAD.c_str());
+    rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
+    for (auto next : platformState.sessionState.supportedContentSelectors) {
+        switch (next) {
+            case aace::alexa::LocalMediaSource::ContentSelector::FREQUENCY:
+                document["capabilities"].AddMember("playFrequency", "1.0", allocator);
+                break;
+            case aace::alexa::LocalMediaSource::ContentSelector::CHANNEL:
+                document["capabilities"].AddMember("playChannel", "1.0", allocator);
+                break;
+            case aace::alexa::LocalMediaSource::ContentSelector::PRESET:
+                document["capabilities"].AddMember("playPreset", "1.0", allocator);
+                break;
+        }
+    }
+
+    // add dynamic pluggable capability clearlist payload
+    document["capabilities"].AddMember("enableIsLaunched", "1.0", allocator);
+
+    rapidjson::StringBuffer strbuf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(strbuf);
+    document.Accept(writer);
+    state.sessionState.playerCookie = strbuf.GetString();
+
+    // playback state
+    state.playbackState.playerId = getPlayerId(platformSource);
+    state.playbackState.state = platformState.playbackState.state;
+    state.playbackState.trackOffset = platformState.playbackState.trackOffset;
+    state.playbackState.shuffleEnabled = platformState.playbackState.shuffleEnabled;
+    state.playbackState.repeatEnabled = platformState.playbackState.repeatEnabled;
+    state.playbackState.repeatOneEnabled = platformState.playbackState.repeatOneEnabled;
+    state.playbackState.favorites =
+        static_cast<aace::engine::alexa::Favorites>(platformState.playbackState.favorites);
+    state.playbackState.type = platformState.playbackState.type;
+    state.playbackState.playbackSource = platformState.playbackState.playbackSource;
+    state.playbackState.playbackSourceId = platformState.playbackState.playbackSourceId;
+    state.playbackState.trackName = platformState.playbackState.trackName;
+    state.playbackState.trackId = platformState.playbackState.trackId;
+    state.playbackState.trackNumber = platformState.playbackState.trackNumber;
+    state.playbackState.artistName = platformState.playbackState.artistName;
+    state.playbackState.artistId = platformState.playbackState.artistId;
+    state.playbackState.albumName = platformState.playbackState.albumName;
+    state.playbackState.albumId = platformState.playbackState.albumId;
+    state.playbackState.tinyURL = platformState.playbackState.tinyURL;
+    state.playbackState.smallURL = platformState.playbackState.smallURL;
+    state.playbackState.mediumURL = platformState.playbackState.mediumURL;
+    state.playbackState.largeURL = platformState.playbackState.largeURL;
+    state.playbackState.coverId = platformState.playbackState.coverId;
+    state.playbackState.mediaProvider = platformState.playbackState.mediaProvider;
+    state.playbackState.mediaType =
+        static_cast<aace::engine::alexa::MediaType>(platformState.playbackState.mediaType);
+    state.playbackState.duration = platformState.playbackState.duration;
+
+    // convert AAC SupportedPlaybackOperation to AVS SupportedPlaybackOperation
+    using avsSupportedPlaybackOperation = aace::engine::alexa::SupportedPlaybackOperation;
+
+    for (auto nextOp : platformState.playbackState.supportedOperations) {
+        switch (nextOp) {
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::PLAY:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::PLAY);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::PAUSE:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::PAUSE);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::STOP:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::STOP);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::NEXT:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::NEXT);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::PREVIOUS:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::PREVIOUS);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::START_OVER:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::START_OVER);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::FAST_FORWARD:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::FAST_FORWARD);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::REWIND:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::REWIND);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::ENABLE_REPEAT:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::ENABLE_REPEAT);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::ENABLE_REPEAT_ONE:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::ENABLE_REPEAT_ONE);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::DISABLE_REPEAT:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::DISABLE_REPEAT);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::ENABLE_SHUFFLE:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::ENABLE_SHUFFLE);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::DISABLE_SHUFFLE:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::DISABLE_SHUFFLE);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::FAVORITE:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::FAVORITE);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::UNFAVORITE:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::UNFAVORITE);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::SEEK:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::SEEK);
+                break;
+            case aace::alexa::ExternalMediaAdapter::SupportedPlaybackOperation::ADJUST_SEEK:
+                state.playbackState.supportedOperations.insert(avsSupportedPlaybackOperation::ADJUST_SEEK);
+                break;
+            default:
+                AACE_VERBOSE(LX(TAG).m("Unexpected SupportedPlaybackOperation"));
+                break;
+        }
+    }
+}
+
 std::chrono::milliseconds LocalMediaSourceEngineImpl::handleGetOffset(const std::string& localPlayerId) {
     return std::chrono::milliseconds::zero();
 }
@@ -513,6 +593,8 @@ bool LocalMediaSourceEngineImpl::handleSetMute(bool mute) {
 void LocalMediaSourceEngineImpl::onPlayerEvent(const std::string& eventName, const std::string& sessionId) {
     emitCounterMetrics(
         METRIC_PROGRAM_NAME_SUFFIX, "onPlayerEvent", {METRIC_LOCAL_MEDIA_SOURCE_PLAYER_EVENT, eventName});
+    // the state change is reported once the state is refreshed
+    scheduleStateRefresh();
     AACE_VERBOSE(LX(TAG).d("eventName", eventName));
     if (m_localPlayerId.empty()) {
         if (eventName == "PlaybackSessionStarted") {
@@ -565,6 +647,7 @@ void LocalMediaSourceEngineImpl::onPlayerError(
         METRIC_PROGRAM_NAME_SUFFIX,
         "onPlayerError",
         {METRIC_LOCAL_MEDIA_SOURCE_PLAYER_ERROR, errorName, std::to_string(code)});
+    scheduleStateRefresh();
     try {
         AACE_VERBOSE(LX(TAG).d("errorName", errorName).d("code", code).d("description", description).d("fatal", fatal));
 
@@ -603,6 +686,7 @@ void LocalMediaSourceEngineImpl::onPlayerError(
 
 void LocalMediaSourceEngineImpl::onSetFocus(bool focusAcquire) {
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "onSetFocus", {METRIC_LOCAL_MEDIA_SOURCE_SET_FOCUS});
+    reportStateChanged();
     try {
         ThrowIfNot(setFocus(m_localPlayerId, focusAcquire), "setFocusFailed");
     } catch (std::exception& ex) {
@@ -624,6 +708,10 @@ void LocalMediaSourceEngineImpl::setDefaultPlayerFocus() {
 void LocalMediaSourceEngineImpl::doShutdown() {
     AACE_VERBOSE(LX(TAG));
 
+    // no state query or refresh may call the platform interface once it is released
+    stopAdapterStateQueries();
+    m_stateExecutor.shutdown();
+
     if (m_platformLocalMediaSource != nullptr) {
         m_platformLocalMediaSource->setEngineInterface(nullptr);
         m_platformLocalMediaSource.reset();
@@ -56,16 +56,95 @@ std::shared_ptr<LocaleAssetsManager> LocaleAssetsManager::create(bool enableWake
 }
 
 bool LocaleAssetsManager::changeAssets(const Locales& locales, const WakeWords& wakeWords) {
-    // Changing assets is not currently supported, however this needs to return true for AVS Device SDK
-    //  to function correctly, as it will always call this during the initialization sequence.
     AACE_VERBOSE(LX(__func__)
                      .d("Locale", alexaClientSDK::settings::toSettingString<Locales>(locales).second)
                      .d("WakeWords", alexaClientSDK::settings::toSettingString<WakeWords>(wakeWords).second));
-    return true;
+    try {
+        // this needs to return true without a wake word engine for AVS Device SDK to function correctly, as it will
+        // always call this during the initialization sequence
+        // the locales are given to the wake word engine the way it was initialized with them, separated by '/'
+        Locale locale;
+        for (const auto& next : locales) {
+            locale += (locale.empty() ? "" : "/") + next;
+        }
+
+        std::shared_ptr<WakewordEngineAdapter> wakewordEngineAdapter;
+        {
+            std::lock_guard<std::mutex> lock(m_wakewordMutex);
+            if (m_wakewordEngineAdapter == nullptr || locale.empty() || locale == m_activeLocale) {
+                return true;
+            }
+            wakewordEngineAdapter = m_wakewordEngineAdapter;
+        }
+        m_changeCancelled = false;
+
+        // the change goes ahead of the queued prefetches, so it waits for the prefetch being loaded at most
+        auto result = m_executor.submitToFront([this, wakewordEngineAdapter, locale]() {
+            return executeChangeLocale(wakewordEngineAdapter, locale);
+        });
+        ThrowIfNot(result.valid(), "submitChangeFailed");
+        return result.get();
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "changeAssets").d("reason", ex.what()));
+        return false;
+    }
 }
 
 void LocaleAssetsManager::cancelOngoingChange() {
-    // No work is done by changeAssets.
+    // a model already loading is not interrupted, but it does not replace the active model
+    m_changeCancelled = true;
+}
+
+bool LocaleAssetsManager::executeChangeLocale(
+    std::shared_ptr<WakewordEngineAdapter> wakewordEngineAdapter,
+    const Locale& locale) {
+    try {
+        ThrowIf(m_changeCancelled, "changeCancelled");
+        ThrowIfNot(wakewordEngineAdapter->changeLocale(locale), "wakewordChangeLocaleFailed");
+        std::lock_guard<std::mutex> lock(m_wakewordMutex);
+        m_activeLocale = locale;
+        AACE_INFO(LX(TAG, "executeChangeLocale").d("locale", locale));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "executeChangeLocale").d("reason", ex.what()).d("locale", locale));
+        return false;
+    }
+}
+
+void LocaleAssetsManager::executePrefetchLocale(
+    std::shared_ptr<WakewordEngineAdapter> wakewordEngineAdapter,
+    const Locale& locale) {
+    {
+        std::lock_guard<std::mutex> lock(m_wakewordMutex);
+        if (m_activeLocale.find(locale) != std::string::npos) {
+            return;
+        }
+    }
+    if (!wakewordEngineAdapter->prefetchLocale(locale)) {
+        AACE_WARN(LX(TAG, "executePrefetchLocale").d("reason", "wakewordPrefetchLocaleFailed").d("locale", locale));
+    }
+}
+
+void LocaleAssetsManager::setWakewordEngineAdapter(
+    std::shared_ptr<WakewordEngineAdapter> wakewordEngineAdapter,
+    const Locale& activeLocale) {
+    {
+        std::lock_guard<std::mutex> lock(m_wakewordMutex);
+        m_wakewordEngineAdapter = wakewordEngineAdapter;
+        m_activeLocale = activeLocale;
+    }
+    if (wakewordEngineAdapter == nullptr) {
+        return;
+    }
+
+    // each locale is prefetched in its own task, so a locale change does not wait for all of them
+    for (const auto& locale : m_supportedLocales) {
+        if (activeLocale.find(locale) == std::string::npos) {
+            m_executor.submit([this, wakewordEngineAdapter, locale]() {
+                executePrefetchLocale(wakewordEngineAdapter, locale);
+            });
+        }
+    }
 }
 
 bool LocaleAssetsManager::initialize(bool enableWakeWord) {
@@ -201,10 +280,15 @@ void LocaleAssetsManager::onConfigurationChanged(
 }
 
 LocaleAssetsManager::LocaleAssetsManager() :
-        RequiresShutdown{"LocaleAssetsManager"}, m_defaultLocale{DEFAULT_LOCALE_VALUE} {
+        RequiresShutdown{"LocaleAssetsManager"}, m_defaultLocale{DEFAULT_LOCALE_VALUE}, m_changeCancelled{false} {
 }
 
 void LocaleAssetsManager::doShutdown() {
+    m_executor.shutdown();
+    {
+        std::lock_guard<std::mutex> lock{m_wakewordMutex};
+        m_wakewordEngineAdapter.reset();
+    }
     {
         std::lock_guard<std::mutex> lock{m_observersMutex};
         m_observers.clear();
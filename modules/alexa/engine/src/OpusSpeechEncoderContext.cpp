@@ -0,0 +1,216 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <opus/opus.h>
+
+#include <AACE/Engine/Alexa/OpusSpeechEncoderContext.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+using AudioFormat = alexaClientSDK::avsCommon::utils::AudioFormat;
+using ThreadPolicy = aace::engine::utils::threading::ThreadPolicy;
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.OpusSpeechEncoderContext");
+
+/// The sample rate and the channels of the speech recognizer audio
+static constexpr int SAMPLE_RATE_HZ = 16000;
+static constexpr int CHANNELS = 1;
+
+/// The duration of a frame, which is the frame duration expected by Alexa
+static constexpr int FRAME_DURATION_MS = 20;
+
+/// The number of samples of a frame
+static constexpr size_t FRAME_SAMPLES = SAMPLE_RATE_HZ / 1000 * FRAME_DURATION_MS;
+
+/// The name of the format of the audio attachment
+static const std::string AVS_FORMAT_NAME = "OPUS";
+
+/// The limits of the configuration
+static constexpr int MIN_BITRATE = 6000;
+static constexpr int MAX_BITRATE = 128000;
+static constexpr int MAX_COMPLEXITY = 10;
+
+constexpr const char* OpusSpeechEncoderContext::THREAD_NAME;
+
+OpusSpeechEncoderContext::OpusSpeechEncoderContext(const Config& config) : m_config(config) {
+    m_outputFormat.encoding = AudioFormat::Encoding::OPUS;
+    m_outputFormat.layout = AudioFormat::Layout::INTERLEAVED;
+    m_outputFormat.endianness = AudioFormat::Endianness::LITTLE;
+    m_outputFormat.sampleRateHz = SAMPLE_RATE_HZ;
+    m_outputFormat.sampleSizeInBits = 16;
+    m_outputFormat.numChannels = CHANNELS;
+    m_outputFormat.dataSigned = false;
+}
+
+OpusSpeechEncoderContext::~OpusSpeechEncoderContext() {
+    if (m_encoder != nullptr) {
+        opus_encoder_destroy(m_encoder);
+    }
+}
+
+std::shared_ptr<OpusSpeechEncoderContext> OpusSpeechEncoderContext::create() {
+    return create(Config());
+}
+
+std::shared_ptr<OpusSpeechEncoderContext> OpusSpeechEncoderContext::create(const Config& config) {
+    try {
+        // a constant bitrate frame of 20 ms has a whole number of bytes
+        ThrowIf(
+            config.bitrate < MIN_BITRATE || config.bitrate > MAX_BITRATE ||
+                config.bitrate % (8000 / FRAME_DURATION_MS) != 0,
+            "invalidBitrate");
+        ThrowIf(config.complexity < 0 || config.complexity > MAX_COMPLEXITY, "invalidComplexity");
+        ThrowIf(config.nice < -20 || config.nice > 19, "invalidNice");
+
+        AACE_INFO(LX(TAG).d("bitrate", config.bitrate).d("complexity", config.complexity).d("nice", config.nice));
+        return std::shared_ptr<OpusSpeechEncoderContext>(new OpusSpeechEncoderContext(config));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG)
+                       .d("reason", ex.what())
+                       .d("bitrate", config.bitrate)
+                       .d("complexity", config.complexity)
+                       .d("nice", config.nice));
+        return nullptr;
+    }
+}
+
+bool OpusSpeechEncoderContext::init(AudioFormat inputFormat) {
+    try {
+        ThrowIfNot(inputFormat.encoding == AudioFormat::Encoding::LPCM, "unsupportedEncoding");
+        ThrowIfNot(inputFormat.sampleSizeInBits == 16, "unsupportedSampleSize");
+        ThrowIfNot(inputFormat.sampleRateHz == SAMPLE_RATE_HZ, "unsupportedSampleRate");
+        ThrowIfNot(inputFormat.numChannels == CHANNELS, "unsupportedChannels");
+        ThrowIfNot(inputFormat.endianness == AudioFormat::Endianness::LITTLE, "unsupportedEndianness");
+        m_inputFormat = inputFormat;
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+size_t OpusSpeechEncoderContext::getInputFrameSize() {
+    return FRAME_SAMPLES;
+}
+
+size_t OpusSpeechEncoderContext::getOutputFrameSize() {
+    return static_cast<size_t>(m_config.bitrate / 8 * FRAME_DURATION_MS / 1000);
+}
+
+bool OpusSpeechEncoderContext::requiresFullyRead() {
+    return true;
+}
+
+AudioFormat OpusSpeechEncoderContext::getAudioFormat() {
+    return m_outputFormat;
+}
+
+std::string OpusSpeechEncoderContext::getAVSFormatName() {
+    return AVS_FORMAT_NAME;
+}
+
+bool OpusSpeechEncoderContext::start() {
+    try {
+        // the encoding session starts on the encoder thread
+        registerEncoderThread();
+
+        if (m_encoder != nullptr) {
+            opus_encoder_destroy(m_encoder);
+            m_encoder = nullptr;
+        }
+        int error = OPUS_OK;
+        m_encoder = opus_encoder_create(SAMPLE_RATE_HZ, CHANNELS, OPUS_APPLICATION_VOIP, &error);
+        ThrowIf(error != OPUS_OK || m_encoder == nullptr, opus_strerror(error));
+
+        // Alexa expects frames of a constant size
+        ThrowIf(opus_encoder_ctl(m_encoder, OPUS_SET_VBR(0)) != OPUS_OK, "setVbrFailed");
+        ThrowIf(opus_encoder_ctl(m_encoder, OPUS_SET_BITRATE(m_config.bitrate)) != OPUS_OK, "setBitrateFailed");
+        ThrowIf(
+            opus_encoder_ctl(m_encoder, OPUS_SET_COMPLEXITY(m_config.complexity)) != OPUS_OK, "setComplexityFailed");
+        ThrowIf(opus_encoder_ctl(m_encoder, OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE)) != OPUS_OK, "setSignalFailed");
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        if (m_encoder != nullptr) {
+            opus_encoder_destroy(m_encoder);
+            m_encoder = nullptr;
+        }
+        return false;
+    }
+}
+
+ssize_t OpusSpeechEncoderContext::processSamples(void* samples, size_t nWords, uint8_t* buffer) {
+    try {
+        ThrowIfNull(m_encoder, "encoderNotStarted");
+        ThrowIf(nWords != FRAME_SAMPLES, "invalidFrameSize");
+
+        auto size = opus_encode(
+            m_encoder,
+            static_cast<const opus_int16*>(samples),
+            static_cast<int>(nWords),
+            buffer,
+            static_cast<opus_int32>(getOutputFrameSize()));
+        ThrowIf(size < 0, opus_strerror(size));
+
+        return size;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("nWords", nWords));
+        return -1;
+    }
+}
+
+void OpusSpeechEncoderContext::close() {
+    if (m_encoder != nullptr) {
+        opus_encoder_destroy(m_encoder);
+        m_encoder = nullptr;
+    }
+    // the encoding session ends on the encoder thread
+    if (m_threadRegistered) {
+        ThreadPolicy::unregisterCurrentThread();
+        m_threadRegistered = false;
+    }
+}
+
+void OpusSpeechEncoderContext::registerEncoderThread() {
+    ReturnIf(m_threadRegistered);
+#if defined(__linux__)
+    // a thread policy registered after the nice value replaces it
+    auto tid = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, m_config.nice) != 0) {
+        AACE_WARN(LX(TAG).d("reason", "setNiceFailed").d("nice", m_config.nice).d("error", std::strerror(errno)));
+    }
+#endif
+    ThreadPolicy::registerCurrentThread(THREAD_NAME);
+    m_threadRegistered = true;
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
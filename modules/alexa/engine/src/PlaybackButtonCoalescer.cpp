@@ -0,0 +1,153 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstdlib>
+
+#include <AACE/Engine/Alexa/PlaybackButtonCoalescer.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.PlaybackButtonCoalescer");
+
+const std::chrono::milliseconds PlaybackButtonCoalescer::DEFAULT_WINDOW(300);
+
+std::shared_ptr<PlaybackButtonCoalescer> PlaybackButtonCoalescer::create(
+    Handler handler,
+    std::chrono::milliseconds window) {
+    try {
+        ThrowIfNot(handler, "invalidHandler");
+        ThrowIf(window < std::chrono::milliseconds::zero(), "invalidWindow");
+
+        return std::shared_ptr<PlaybackButtonCoalescer>(new PlaybackButtonCoalescer(handler, window));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("window", window.count()));
+        return nullptr;
+    }
+}
+
+PlaybackButtonCoalescer::PlaybackButtonCoalescer(Handler handler, std::chrono::milliseconds window) :
+        m_handler{handler},
+        m_window{window},
+        m_windowOpen{false},
+        m_pendingSkips{0},
+        m_windowTimer{TimerWheel::INVALID_TIMER},
+        m_windowGeneration{0},
+        m_shutdown{false},
+        m_pressCount{0},
+        m_executor{"PlaybackButtonCoalescer"} {
+}
+
+PlaybackButtonCoalescer::~PlaybackButtonCoalescer() {
+    shutdown();
+}
+
+void PlaybackButtonCoalescer::buttonPressed(PlaybackButton button) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ReturnIf(m_shutdown);
+
+    if (button != PlaybackButton::NEXT && button != PlaybackButton::PREVIOUS) {
+        // the pending skips are requested before the button, in the order of the presses
+        flushLocked();
+        m_handler(button);
+    } else if (m_window == std::chrono::milliseconds::zero()) {
+        m_handler(button);
+    } else if (!m_windowOpen) {
+        // the first skip is requested at once, so a single press waits for nothing
+        m_handler(button);
+        m_windowOpen = true;
+        restartWindowTimerLocked();
+    } else {
+        m_pendingSkips += button == PlaybackButton::NEXT ? 1 : -1;
+        m_pressCount++;
+        restartWindowTimerLocked();
+    }
+}
+
+void PlaybackButtonCoalescer::flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ReturnIf(m_shutdown);
+    flushLocked();
+}
+
+int PlaybackButtonCoalescer::getPendingSkips() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pendingSkips;
+}
+
+void PlaybackButtonCoalescer::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+        if (m_windowTimer != TimerWheel::INVALID_TIMER) {
+            TimerWheel::getDefault()->cancel(m_windowTimer);
+            m_windowTimer = TimerWheel::INVALID_TIMER;
+        }
+        m_windowOpen = false;
+        m_pendingSkips = 0;
+    }
+    m_executor.shutdown();
+}
+
+void PlaybackButtonCoalescer::restartWindowTimerLocked() {
+    if (m_windowTimer != TimerWheel::INVALID_TIMER) {
+        TimerWheel::getDefault()->cancel(m_windowTimer);
+    }
+    auto generation = ++m_windowGeneration;
+
+    // the timer runs on the timer thread, which must not call the handler
+    std::weak_ptr<PlaybackButtonCoalescer> wp = shared_from_this();
+    m_windowTimer = TimerWheel::getDefault()->submitAfter(m_window, [wp, generation]() {
+        if (auto coalescer = wp.lock()) {
+            auto raw = coalescer.get();
+            coalescer->m_executor.post([raw, generation]() {
+                std::lock_guard<std::mutex> lock(raw->m_mutex);
+                if (!raw->m_shutdown && raw->m_windowGeneration == generation) {
+                    raw->m_windowTimer = TimerWheel::INVALID_TIMER;
+                    raw->flushLocked();
+                }
+            });
+        }
+    });
+}
+
+void PlaybackButtonCoalescer::flushLocked() {
+    if (m_windowTimer != TimerWheel::INVALID_TIMER) {
+        TimerWheel::getDefault()->cancel(m_windowTimer);
+        m_windowTimer = TimerWheel::INVALID_TIMER;
+    }
+    // a timer that expired before the cancel is ignored
+    m_windowGeneration++;
+
+    if (m_pressCount > 0) {
+        AACE_DEBUG(LX(TAG).d("presses", m_pressCount).d("skips", m_pendingSkips));
+    }
+    auto button = m_pendingSkips > 0 ? PlaybackButton::NEXT : PlaybackButton::PREVIOUS;
+    for (int i = std::abs(m_pendingSkips); i > 0; i--) {
+        m_handler(button);
+    }
+    m_windowOpen = false;
+    m_pendingSkips = 0;
+    m_pressCount = 0;
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
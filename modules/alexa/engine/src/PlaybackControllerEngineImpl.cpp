@@ -44,8 +44,14 @@ bool PlaybackControllerEngineImpl::initialize(
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::endpoints::EndpointCapabilitiesRegistrarInterface>
         capabilitiesRegistrar,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
-    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager) {
+    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
+    std::chrono::milliseconds buttonCoalescingWindow) {
     try {
+        // the coalescer calls the playback router, so it is shut down first
+        m_buttonCoalescer = PlaybackButtonCoalescer::create(
+            [this](PlaybackButton button) { sendButton(button); }, buttonCoalescingWindow);
+        ThrowIfNull(m_buttonCoalescer, "couldNotCreateButtonCoalescer");
+
         m_playbackControllerCapabilityAgent =
             alexaClientSDK::capabilityAgents::playbackController::PlaybackController::create(
                 contextManager, messageSender);
@@ -70,7 +76,8 @@ std::shared_ptr<PlaybackControllerEngineImpl> PlaybackControllerEngineImpl::crea
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::endpoints::EndpointCapabilitiesRegistrarInterface>
         capabilitiesRegistrar,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
-    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager) {
+    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
+    std::chrono::milliseconds buttonCoalescingWindow) {
     std::shared_ptr<PlaybackControllerEngineImpl> playbackControllerEngineImpl = nullptr;
 
     try {
@@ -83,7 +90,8 @@ std::shared_ptr<PlaybackControllerEngineImpl> PlaybackControllerEngineImpl::crea
             new PlaybackControllerEngineImpl(playbackControllerPlatformInterface));
 
         ThrowIfNot(
-            playbackControllerEngineImpl->initialize(capabilitiesRegistrar, messageSender, contextManager),
+            playbackControllerEngineImpl->initialize(
+                capabilitiesRegistrar, messageSender, contextManager, buttonCoalescingWindow),
             "initializePlaybackControllerEngineImplFailed");
 
         // set the platform engine interface reference
@@ -100,6 +108,10 @@ std::shared_ptr<PlaybackControllerEngineImpl> PlaybackControllerEngineImpl::crea
 }
 
 void PlaybackControllerEngineImpl::doShutdown() {
+    if (m_buttonCoalescer != nullptr) {
+        m_buttonCoalescer->shutdown();
+    }
+
     if (m_playbackRouter != nullptr) {
         m_playbackRouter->shutdown();
     }
@@ -120,6 +132,10 @@ void PlaybackControllerEngineImpl::onButtonPressed(PlaybackButton button) {
     ss << static_cast<alexaClientSDK::avsCommon::avs::PlaybackButton>(button);
     emitCounterMetrics(
         METRIC_PROGRAM_NAME_SUFFIX, "onButtonPressed", {METRIC_PLAYBACK_CONTROLLER_BUTTON_PRESSED, ss.str()});
+    m_buttonCoalescer->buttonPressed(button);
+}
+
+void PlaybackControllerEngineImpl::sendButton(PlaybackButton button) {
     if (button == PlaybackButton::PAUSE) {
         AACE_DEBUG(LX(TAG).m("Using local stop for PAUSE button press"));
         // PlaybackOperation::STOP_PLAYBACK is used rather than PlaybackOperation::PAUSE_PLAYBACK so that AudioPlayer CA
@@ -138,6 +154,8 @@ void PlaybackControllerEngineImpl::onTogglePressed(PlaybackToggle toggle, bool a
     ss << static_cast<alexaClientSDK::avsCommon::avs::PlaybackToggle>(toggle);
     emitCounterMetrics(
         METRIC_PROGRAM_NAME_SUFFIX, "onTogglePressed", {METRIC_PLAYBACK_CONTROLLER_TOGGLE_PRESSED, ss.str()});
+    // the pending skips are requested before the toggle, in the order of the presses
+    m_buttonCoalescer->flush();
     m_playbackRouter->togglePressed(static_cast<alexaClientSDK::avsCommon::avs::PlaybackToggle>(toggle), action);
 }
 
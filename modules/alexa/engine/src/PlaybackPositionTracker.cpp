@@ -0,0 +1,72 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/Alexa/PlaybackPositionTracker.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+constexpr std::chrono::milliseconds PlaybackPositionTracker::DEFAULT_MAX_AGE;
+
+PlaybackPositionTracker::PlaybackPositionTracker(std::chrono::milliseconds maxAge) : m_maxAge(maxAge) {
+}
+
+void PlaybackPositionTracker::update(std::chrono::milliseconds position, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_known = true;
+    m_position = position;
+    m_positionTime = now;
+    m_updateTime = now;
+}
+
+void PlaybackPositionTracker::setPlaying(bool playing, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (playing == m_playing) {
+        return;
+    }
+
+    // the position reached so far is kept, and interpolated from now on if the media plays
+    m_position = interpolate(now);
+    m_positionTime = now;
+    m_playing = playing;
+}
+
+bool PlaybackPositionTracker::getPosition(std::chrono::milliseconds& position, Clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_known || (m_playing && now - m_updateTime > m_maxAge)) {
+        return false;
+    }
+
+    position = interpolate(now);
+    return true;
+}
+
+void PlaybackPositionTracker::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_known = false;
+    m_position = std::chrono::milliseconds(0);
+}
+
+std::chrono::milliseconds PlaybackPositionTracker::interpolate(Clock::time_point now) const {
+    if (!m_playing || now < m_positionTime) {
+        return m_position;
+    }
+    return m_position + std::chrono::duration_cast<std::chrono::milliseconds>(now - m_positionTime);
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
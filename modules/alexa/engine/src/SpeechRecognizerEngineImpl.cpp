@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <climits>
 #include <exception>
 
@@ -22,6 +23,7 @@
 #include "AACE/Engine/Alexa/WakewordObserverInterface.h"
 #include "AACE/Engine/Core/EngineMacros.h"
 #include "AACE/Alexa/AlexaProperties.h"
+#include "AACE/Engine/Utils/Memory/MemoryPressure.h"
 #include "AACE/Engine/Utils/Metrics/Metrics.h"
 
 namespace aace {
@@ -30,11 +32,14 @@ namespace alexa {
 
 using namespace aace::engine::utils::metrics;
 
-/// The maximum number of readers of the stream.
-static const size_t MAX_READERS = 10;
+/// The amount of audio data to keep in the ring buffer, by default.
+static const std::chrono::seconds DEFAULT_AUDIO_BUFFER_DURATION = std::chrono::seconds(15);
 
-/// The amount of audio data to keep in the ring buffer.
-static const std::chrono::seconds AMOUNT_OF_AUDIO_DATA_IN_BUFFER = std::chrono::seconds(15);
+/// The maximum number of readers of the stream, by default.
+static const size_t DEFAULT_AUDIO_BUFFER_MAX_READERS = 10;
+
+/// The least amount of audio data the ring buffer is reduced to under memory pressure.
+static const std::chrono::milliseconds MIN_PRESSURE_AUDIO_BUFFER_DURATION = std::chrono::seconds(5);
 
 /// The amount of time for wake-word verification
 static const std::chrono::milliseconds VERIFICATION_TIMEOUT = std::chrono::milliseconds(500);
@@ -121,12 +126,24 @@ static void computeStartOfSpeechTimestamp(
                           .count()));
 }
 
+SpeechRecognizerEngineImpl::AudioBufferConfig::AudioBufferConfig() :
+        duration(DEFAULT_AUDIO_BUFFER_DURATION), maxReaders(DEFAULT_AUDIO_BUFFER_MAX_READERS) {
+}
+
 SpeechRecognizerEngineImpl::SpeechRecognizerEngineImpl(
     std::shared_ptr<aace::alexa::SpeechRecognizer> speechRecognizerPlatformInterface,
-    const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat) :
+    const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat,
+    const AudioBufferConfig& audioBufferConfig,
+    const aace::engine::audio::VoiceActivityGate::Config& voiceActivityGateConfig,
+    bool speculativeWakewordVerification,
+    std::shared_ptr<VoiceTurnMonitor> voiceTurnMonitor) :
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
         m_speechRecognizerPlatformInterface(speechRecognizerPlatformInterface),
         m_audioFormat(audioFormat),
+        m_audioBufferConfig(audioBufferConfig),
+        m_voiceActivityGateConfig(voiceActivityGateConfig),
+        m_speculativeWakewordVerification(speculativeWakewordVerification),
+        m_voiceTurnMonitor(std::move(voiceTurnMonitor)),
         m_wordSize(audioFormat.sampleSizeInBits / CHAR_BIT),
         m_state(alexaClientSDK::avsCommon::sdkInterfaces::AudioInputProcessorObserverInterface::State::IDLE) {
 }
@@ -250,7 +267,11 @@ std::shared_ptr<SpeechRecognizerEngineImpl> SpeechRecognizerEngineImpl::create(
     std::shared_ptr<alexaClientSDK::avsCommon::avs::CapabilityChangeNotifierInterface> capabilityChangeNotifier,
     std::shared_ptr<alexaClientSDK::speechencoder::SpeechEncoder> speechEncoder,
     std::shared_ptr<aace::engine::alexa::WakewordEngineAdapter> wakewordEngineAdapter,
-    const std::vector<std::shared_ptr<aace::engine::alexa::InitiatorVerifier>>& initiatorVerifiers) {
+    const std::vector<std::shared_ptr<aace::engine::alexa::InitiatorVerifier>>& initiatorVerifiers,
+    const AudioBufferConfig& audioBufferConfig,
+    const aace::engine::audio::VoiceActivityGate::Config& voiceActivityGateConfig,
+    bool speculativeWakewordVerification,
+    std::shared_ptr<VoiceTurnMonitor> voiceTurnMonitor) {
     std::shared_ptr<SpeechRecognizerEngineImpl> speechRecognizerEngineImpl = nullptr;
 
     try {
@@ -268,9 +289,17 @@ std::shared_ptr<SpeechRecognizerEngineImpl> SpeechRecognizerEngineImpl::create(
         ThrowIfNull(systemSoundPlayer, "invalidSystemSoundPlayer");
         ThrowIfNull(metricRecorder, "invalidMetricsRecorder");
         ThrowIfNull(capabilityChangeNotifier, "invalidCapabilityChangeNotifier");
+        ThrowIf(audioBufferConfig.duration.count() <= 0, "invalidAudioBufferDuration");
+        ThrowIf(audioBufferConfig.maxReaders == 0, "invalidAudioBufferMaxReaders");
 
         speechRecognizerEngineImpl = std::shared_ptr<SpeechRecognizerEngineImpl>(
-            new SpeechRecognizerEngineImpl(speechRecognizerPlatformInterface, audioFormat));
+            new SpeechRecognizerEngineImpl(
+                speechRecognizerPlatformInterface,
+                audioFormat,
+                audioBufferConfig,
+                voiceActivityGateConfig,
+                speculativeWakewordVerification,
+                voiceTurnMonitor));
 
         ThrowIfNot(
             speechRecognizerEngineImpl->initialize(
@@ -339,20 +368,47 @@ void SpeechRecognizerEngineImpl::doShutdown() {
 
 bool SpeechRecognizerEngineImpl::initializeAudioInputStream() {
     try {
+        // the stream can't be resized once the readers are attached, so a buffer created while the memory is low
+        // keeps less audio, down to the least the wakeword and the speech before it take
+        using aace::engine::utils::memory::MemoryPressure;
+        using aace::engine::utils::memory::MemoryPressureLevel;
+        auto level = MemoryPressure::getLevelFor(MemoryPressure::Priority::BUFFER, MemoryPressure::getLevel());
+        auto duration = m_audioBufferConfig.duration;
+        if (level != MemoryPressureLevel::NORMAL) {
+            auto reduced = level == MemoryPressureLevel::CRITICAL ? duration / 4 : duration / 2;
+            duration = std::min(duration, std::max(reduced, MIN_PRESSURE_AUDIO_BUFFER_DURATION));
+        }
+
+        auto words = static_cast<size_t>(m_audioFormat.sampleRateHz * duration.count() / 1000);
         size_t size = alexaClientSDK::avsCommon::avs::AudioInputStream::calculateBufferSize(
-            m_audioFormat.sampleRateHz * AMOUNT_OF_AUDIO_DATA_IN_BUFFER.count(), m_wordSize, MAX_READERS);
+            words, m_wordSize, m_audioBufferConfig.maxReaders);
         auto buffer = std::make_shared<alexaClientSDK::avsCommon::avs::AudioInputStream::Buffer>(size);
         ThrowIfNull(buffer, "couldNotCreateAudioInputBuffer");
 
         // create the audio input stream
-        m_audioInputStream = alexaClientSDK::avsCommon::avs::AudioInputStream::create(buffer, m_wordSize, MAX_READERS);
+        m_audioInputStream = alexaClientSDK::avsCommon::avs::AudioInputStream::create(
+            buffer, m_wordSize, m_audioBufferConfig.maxReaders);
         ThrowIfNull(m_audioInputStream, "couldNotCreateAudioInputStream");
 
+        // report the memory the buffer takes, which is resident for the lifetime of the engine
+        AACE_INFO(LX(TAG, "initializeAudioInputStream")
+                      .d("bufferSize", size)
+                      .d("duration", duration.count())
+                      .d("configuredDuration", m_audioBufferConfig.duration.count())
+                      .d("memoryPressure", level)
+                      .d("maxReaders", m_audioBufferConfig.maxReaders));
+
         // create the audio input writer
         m_audioInputWriter = m_audioInputStream->createWriter(
             alexaClientSDK::avsCommon::avs::AudioInputStream::Writer::Policy::NONBLOCKABLE);
         ThrowIfNull(m_audioInputWriter, "couldNotCreateAudioInputWriter");
 
+        if (m_voiceActivityGateConfig.enabled) {
+            m_voiceActivityGate =
+                aace::engine::audio::VoiceActivityGate::create(m_audioFormat.sampleRateHz, m_voiceActivityGateConfig);
+            ThrowIfNull(m_voiceActivityGate, "couldNotCreateVoiceActivityGate");
+        }
+
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "initializeAudioInputStream").d("reason", ex.what()));
@@ -362,6 +418,10 @@ bool SpeechRecognizerEngineImpl::initializeAudioInputStream() {
     }
 }
 
+std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> SpeechRecognizerEngineImpl::getAudioInputStream() {
+    return m_audioInputStream;
+}
+
 bool SpeechRecognizerEngineImpl::waitForExpectingAudioState(bool expectingAudio, const std::chrono::seconds duration) {
     std::unique_lock<std::mutex> lock(m_expectingAudioMutex);
 
@@ -550,7 +610,16 @@ ssize_t SpeechRecognizerEngineImpl::write(const int16_t* data, const size_t size
         ThrowIfNot(waitForExpectingAudioState(true), "audioNotExpected");
         ThrowIfNull(m_audioInputWriter, "nullAudioInputWriter");
 
-        ssize_t result = m_audioInputWriter->write(data, size);
+        ssize_t result;
+        if (m_voiceActivityGate != nullptr) {
+            // the audio of a capture is always written, since its silence is needed to detect the end of speech
+            bool bypass = !m_wakewordEnabled || m_state != AudioInputProcessorObserverInterface::State::IDLE;
+            result = m_voiceActivityGate->process(data, size, bypass, [this](const int16_t* samples, size_t count) {
+                return m_audioInputWriter->write(samples, count);
+            });
+        } else {
+            result = m_audioInputWriter->write(data, size);
+        }
         ThrowIf(result < 0, "errorWritingData");
 
         return result;
@@ -577,10 +646,19 @@ void SpeechRecognizerEngineImpl::onKeyWordDetected(
     alexaClientSDK::avsCommon::avs::AudioInputStream::Index endIndex,
     std::shared_ptr<const std::vector<char>> KWDMetadata) {
     if (m_state == AudioInputProcessorObserverInterface::State::IDLE) {
+        // the turn starts at the detection, so its latency includes the verification
+        if (m_voiceTurnMonitor != nullptr) {
+            m_voiceTurnMonitor->onWakewordDetected();
+        }
         m_executor.submit([this, beginIndex, endIndex, keyword] {
-            std::vector<std::shared_ptr<aace::engine::alexa::InitiatorVerifier>>::iterator it;
+            if (m_speculativeWakewordVerification) {
+                startSpeculativeWakewordCapture(beginIndex, endIndex, keyword);
+                return;
+            }
             for (const auto& initiatorVerifier : m_initiatorVerifiers) {
-                if (initiatorVerifier && initiatorVerifier->shouldBlock(keyword, VERIFICATION_TIMEOUT)) {
+                if (initiatorVerifier &&
+                    initiatorVerifier->shouldBlock(
+                        keyword, m_audioInputStream, beginIndex, endIndex, VERIFICATION_TIMEOUT)) {
                     AACE_WARN(LX(TAG, "onKeyWordDetected: Cancelled by Initiator Verifier for wakeword"));
                     return;
                 }
@@ -589,17 +667,49 @@ void SpeechRecognizerEngineImpl::onKeyWordDetected(
                 METRIC_PROGRAM_NAME_SUFFIX, "onKeyWordDetected", {METRIC_SPEECHRECOGNIZER_WAKEWORD_DETECTED});
             // Only notifies platform interface after passing wakeword verifiers,
             // otherwise earcon might still play even if keyword is dropped
-            m_speechRecognizerPlatformInterface->wakewordDetected(keyword);
+            notifyWakewordDetected(keyword);
+
+            onStartCapture(Initiator::WAKEWORD, beginIndex, endIndex, keyword);
+        });
+    }
+}
 
-            // notify observers about the wakeword detected
-            std::lock_guard<std::mutex> lock(m_observerMutex);
+void SpeechRecognizerEngineImpl::startSpeculativeWakewordCapture(
+    alexaClientSDK::avsCommon::avs::AudioInputStream::Index beginIndex,
+    alexaClientSDK::avsCommon::avs::AudioInputStream::Index endIndex,
+    const std::string& keyword) {
+    if (!onStartCapture(Initiator::WAKEWORD, beginIndex, endIndex, keyword)) {
+        return;
+    }
 
-            for (const auto& next : m_observers) {
-                next->wakewordDetected(keyword);
+    // the Recognize event is already streaming while the verifiers wait for their verdict
+    for (const auto& initiatorVerifier : m_initiatorVerifiers) {
+        if (initiatorVerifier &&
+            initiatorVerifier->shouldBlock(keyword, m_audioInputStream, beginIndex, endIndex, VERIFICATION_TIMEOUT)) {
+            AACE_WARN(LX(TAG, "startSpeculativeWakewordCapture: Cancelled by Initiator Verifier for wakeword"));
+            // the capture may have ended by itself during the verification
+            if (m_state != AudioInputProcessorObserverInterface::State::IDLE) {
+                m_audioInputProcessor->resetState();
             }
+            return;
+        }
+    }
 
-            onStartCapture(Initiator::WAKEWORD, beginIndex, endIndex, keyword);
-        });
+    emitCounterMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX,
+        "startSpeculativeWakewordCapture",
+        {METRIC_SPEECHRECOGNIZER_WAKEWORD_DETECTED});
+    notifyWakewordDetected(keyword);
+}
+
+void SpeechRecognizerEngineImpl::notifyWakewordDetected(const std::string& keyword) {
+    m_speechRecognizerPlatformInterface->wakewordDetected(keyword);
+
+    // notify observers about the wakeword detected
+    std::lock_guard<std::mutex> lock(m_observerMutex);
+
+    for (const auto& next : m_observers) {
+        next->wakewordDetected(keyword);
     }
 }
 
@@ -719,6 +829,14 @@ void SpeechRecognizerEngineImpl::onStateChanged(
 
     m_state = state;
 
+    if (m_voiceTurnMonitor != nullptr) {
+        if (state == AudioInputProcessorObserverInterface::State::RECOGNIZING) {
+            m_voiceTurnMonitor->onCaptureStarted();
+        } else if (state == AudioInputProcessorObserverInterface::State::BUSY) {
+            m_voiceTurnMonitor->onEndOfSpeech();
+        }
+    }
+
     // state changed to BUSY means that either the StopCapture directive has been received
     // or the speech recognizer was stopped manually
     if (state == alexaClientSDK::avsCommon::sdkInterfaces::AudioInputProcessorObserverInterface::State::BUSY) {
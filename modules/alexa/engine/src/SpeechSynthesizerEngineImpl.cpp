@@ -23,12 +23,20 @@ namespace alexa {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.alexa.SpeechSynthesizerEngineImpl");
 
+/// The start of the speech read ahead while the platform prepares the channel, a few seconds of MP3 speech
+static const size_t SPEECH_PREROLL_SIZE = 32 * 1024;
+
+/// The longest time the speech is read ahead, when the platform doesn't read it
+static const std::chrono::milliseconds SPEECH_PREROLL_TIMEOUT(1000);
+
 SpeechSynthesizerEngineImpl::SpeechSynthesizerEngineImpl(
     std::shared_ptr<aace::alexa::SpeechSynthesizer> speechSynthesizerPlatformInterface) :
         AudioChannelEngineImpl(
             alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type::AVS_SPEAKER_VOLUME,
             "SpeechSynthesizer"),
         m_speechSynthesizerPlatformInterface(speechSynthesizerPlatformInterface) {
+    // the speech is played as soon as it is prepared, so its first audio must be ready for the platform
+    setAttachmentPreroll(SPEECH_PREROLL_SIZE, SPEECH_PREROLL_TIMEOUT);
 }
 
 bool SpeechSynthesizerEngineImpl::initialize(
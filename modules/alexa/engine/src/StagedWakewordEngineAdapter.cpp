@@ -0,0 +1,280 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include <AACE/Engine/Alexa/StagedWakewordEngineAdapter.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+using namespace aace::engine::utils::metrics;
+using alexaClientSDK::avsCommon::avs::AudioInputStream;
+using alexaClientSDK::avsCommon::sdkInterfaces::KeyWordObserverInterface;
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.StagedWakewordEngineAdapter");
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "StagedWakewordEngineAdapter";
+
+/// Metric for the time during which no instance of the wakeword engine is detecting, in milliseconds
+static const std::string METRIC_LOCALE_SWITCH_DEAF_WINDOW = "LocaleSwitchDeafWindow";
+
+/// Metric for the time spent preparing the new locale on the second instance, in milliseconds
+static const std::string METRIC_LOCALE_SWITCH_PREPARATION = "LocaleSwitchPreparation";
+
+/// Metric for the changes of locale made in place, because the second instance could not be prepared
+static const std::string METRIC_LOCALE_SWITCH_IN_PLACE = "LocaleSwitchInPlace";
+
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+class StagedWakewordEngineAdapter::Router : public KeyWordObserverInterface {
+public:
+    Router(std::weak_ptr<StagedWakewordEngineAdapter> owner, const WakewordEngineAdapter* source) :
+            m_owner(owner), m_source(source) {
+    }
+
+    void onKeyWordDetected(
+        std::shared_ptr<AudioInputStream> stream,
+        std::string keyword,
+        AudioInputStream::Index beginIndex,
+        AudioInputStream::Index endIndex,
+        std::shared_ptr<const std::vector<char>> KWDMetadata) override {
+        auto owner = m_owner.lock();
+        if (owner != nullptr) {
+            owner->onKeyWordDetected(m_source, stream, keyword, beginIndex, endIndex, KWDMetadata);
+        }
+    }
+
+private:
+    std::weak_ptr<StagedWakewordEngineAdapter> m_owner;
+    const WakewordEngineAdapter* m_source;
+};
+
+std::shared_ptr<StagedWakewordEngineAdapter> StagedWakewordEngineAdapter::create(
+    std::shared_ptr<WakewordEngineAdapter> adapter,
+    AdapterFactory adapterFactory,
+    PipelineLookup pipelineLookup) {
+    try {
+        ThrowIfNull(adapter, "invalidAdapter");
+        ThrowIfNot(adapterFactory, "invalidAdapterFactory");
+        return std::shared_ptr<StagedWakewordEngineAdapter>(
+            new StagedWakewordEngineAdapter(adapter, adapterFactory, pipelineLookup));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+StagedWakewordEngineAdapter::StagedWakewordEngineAdapter(
+    std::shared_ptr<WakewordEngineAdapter> adapter,
+    AdapterFactory adapterFactory,
+    PipelineLookup pipelineLookup) :
+        m_adapterFactory(adapterFactory), m_pipelineLookup(pipelineLookup), m_activeAdapter(adapter) {
+}
+
+std::shared_ptr<WakewordEngineAdapter> StagedWakewordEngineAdapter::getActiveAdapter() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_activeAdapter;
+}
+
+bool StagedWakewordEngineAdapter::initialize(
+    const std::string& defaultLocale,
+    std::shared_ptr<AudioInputStream>& audioInputStream,
+    alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat) {
+    try {
+        std::lock_guard<std::mutex> stateLock(m_stateMutex);
+        ThrowIf(m_initialized, "alreadyInitialized");
+        auto adapter = getActiveAdapter();
+        ThrowIfNot(adapter->initialize(defaultLocale, audioInputStream, audioFormat), "initializeFailed");
+
+        auto router = std::make_shared<Router>(shared_from_this(), adapter.get());
+        adapter->addKeyWordObserver(router);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_activeRouter = router;
+        m_audioInputStream = audioInputStream;
+        m_audioFormat = audioFormat;
+        m_initialized = true;
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "initialize").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool StagedWakewordEngineAdapter::enable() {
+    // the state lock is held while the instance is enabled, so the instances are not swapped in the meantime
+    std::lock_guard<std::mutex> stateLock(m_stateMutex);
+    if (!getActiveAdapter()->enable()) {
+        return false;
+    }
+    m_enabled = true;
+    return true;
+}
+
+bool StagedWakewordEngineAdapter::disable() {
+    std::lock_guard<std::mutex> stateLock(m_stateMutex);
+    if (!getActiveAdapter()->disable()) {
+        return false;
+    }
+    m_enabled = false;
+    return true;
+}
+
+bool StagedWakewordEngineAdapter::prefetchLocale(const std::string& locale) {
+    // the instances share the pages of the models they map, so the new instance uses the prefetched assets
+    return getActiveAdapter()->prefetchLocale(locale);
+}
+
+bool StagedWakewordEngineAdapter::changeLocale(const std::string& locale) {
+    std::lock_guard<std::mutex> changeLock(m_changeMutex);
+    if (stageLocale(locale)) {
+        return true;
+    }
+    emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "changeLocale", {METRIC_LOCALE_SWITCH_IN_PLACE});
+    return changeLocaleInPlace(locale);
+}
+
+bool StagedWakewordEngineAdapter::stageLocale(const std::string& locale) {
+    std::shared_ptr<WakewordEngineAdapter> adapter;
+    std::shared_ptr<Router> router;
+    try {
+        std::shared_ptr<AudioInputStream> stream;
+        alexaClientSDK::avsCommon::utils::AudioFormat audioFormat;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ThrowIfNot(m_initialized, "notInitialized");
+            stream = m_audioInputStream;
+            audioFormat = m_audioFormat;
+        }
+
+        // the new locale is loaded on a second instance while the active one keeps detecting
+        auto start = std::chrono::steady_clock::now();
+        adapter = m_adapterFactory();
+        ThrowIfNull(adapter, "createAdapterFailed");
+        ThrowIfNot(adapter->initialize(locale, stream, audioFormat), "initializeAdapterFailed");
+        router = std::make_shared<Router>(shared_from_this(), adapter.get());
+        adapter->addKeyWordObserver(router);
+
+        std::shared_ptr<WakewordEngineAdapter> previousAdapter;
+        std::shared_ptr<Router> previousRouter;
+        bool enabled;
+        Milliseconds preparation, deafWindow;
+        {
+            std::lock_guard<std::mutex> stateLock(m_stateMutex);
+            enabled = m_enabled;
+            ThrowIf(enabled && !adapter->enable(), "enableAdapterFailed");
+            preparation = std::chrono::steady_clock::now() - start;
+
+            // both instances are detecting, and the detections of the new one are dropped until it is active
+            auto swap = [&]() {
+                auto swapStart = std::chrono::steady_clock::now();
+                std::lock_guard<std::mutex> lock(m_mutex);
+                previousAdapter = m_activeAdapter;
+                previousRouter = m_activeRouter;
+                m_activeAdapter = adapter;
+                m_activeRouter = router;
+                deafWindow = std::chrono::steady_clock::now() - swapStart;
+            };
+            auto pipeline = m_pipelineLookup ? m_pipelineLookup(stream) : nullptr;
+            if (pipeline != nullptr) {
+                pipeline->runBetweenBatches(swap);
+            } else {
+                swap();
+            }
+        }
+
+        if (enabled) {
+            previousAdapter->disable();
+        }
+        previousAdapter->removeKeyWordObserver(previousRouter);
+
+        emitTimerMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX, "stageLocale", METRIC_LOCALE_SWITCH_PREPARATION, preparation.count());
+        emitTimerMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX, "stageLocale", METRIC_LOCALE_SWITCH_DEAF_WINDOW, deafWindow.count());
+        AACE_INFO(LX(TAG, "stageLocale")
+                      .d("locale", locale)
+                      .d("preparationMs", preparation.count())
+                      .d("deafWindowMs", deafWindow.count()));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_WARN(LX(TAG, "stageLocale").d("reason", ex.what()).d("locale", locale));
+        if (adapter != nullptr && router != nullptr) {
+            adapter->removeKeyWordObserver(router);
+        }
+        return false;
+    }
+}
+
+bool StagedWakewordEngineAdapter::changeLocaleInPlace(const std::string& locale) {
+    // the active instance may not detect while it loads the new model, so the whole change is the deaf window
+    auto adapter = getActiveAdapter();
+    auto start = std::chrono::steady_clock::now();
+    if (!adapter->changeLocale(locale)) {
+        AACE_ERROR(LX(TAG, "changeLocaleInPlace").d("reason", "changeLocaleFailed").d("locale", locale));
+        return false;
+    }
+    Milliseconds deafWindow = std::chrono::steady_clock::now() - start;
+    emitTimerMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX, "changeLocaleInPlace", METRIC_LOCALE_SWITCH_DEAF_WINDOW, deafWindow.count());
+    AACE_INFO(LX(TAG, "changeLocaleInPlace").d("locale", locale).d("deafWindowMs", deafWindow.count()));
+    return true;
+}
+
+void StagedWakewordEngineAdapter::addKeyWordObserver(std::shared_ptr<KeyWordObserverInterface> keyWordObserver) {
+    if (keyWordObserver == nullptr) {
+        AACE_ERROR(LX(TAG, "addKeyWordObserver").d("reason", "nullObserver"));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_observers.insert(keyWordObserver);
+}
+
+void StagedWakewordEngineAdapter::removeKeyWordObserver(std::shared_ptr<KeyWordObserverInterface> keyWordObserver) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_observers.erase(keyWordObserver);
+}
+
+void StagedWakewordEngineAdapter::onKeyWordDetected(
+    const WakewordEngineAdapter* source,
+    std::shared_ptr<AudioInputStream> stream,
+    const std::string& keyword,
+    AudioInputStream::Index beginIndex,
+    AudioInputStream::Index endIndex,
+    std::shared_ptr<const std::vector<char>> KWDMetadata) {
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> observers;
+    {
+        // the observers are notified without the lock, since an instance may be disabled while it is held
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (source != m_activeAdapter.get()) {
+            AACE_DEBUG(LX(TAG, "onKeyWordDetected").d("reason", "inactiveAdapter").d("keyword", keyword));
+            return;
+        }
+        observers = m_observers;
+    }
+    for (auto& observer : observers) {
+        observer->onKeyWordDetected(stream, keyword, beginIndex, endIndex, KWDMetadata);
+    }
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
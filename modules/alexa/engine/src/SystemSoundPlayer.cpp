@@ -16,6 +16,9 @@
 #include <AACE/Engine/Alexa/SystemSoundPlayer.h>
 #include <AACE/Engine/Core/EngineMacros.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace aace {
 namespace engine {
 namespace alexa {
@@ -23,6 +26,75 @@ namespace alexa {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.alexa.SystemSoundPlayer");
 
+/// The tones loaded when the player is created
+static const alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone TONES[] = {
+    alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone::WAKEWORD_NOTIFICATION,
+    alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone::END_SPEECH};
+
+/// The size of the chunks a tone is read in
+static constexpr size_t READ_CHUNK_SIZE = 4096;
+
+static uint16_t readUint16(const char* data) {
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+static uint32_t readUint32(const char* data) {
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+/**
+ * Decodes a WAV file of 16-bit PCM samples in place, leaving only its samples.
+ *
+ * @return @c true and the format of the samples if @c data is a 16-bit PCM WAV file.
+ */
+static bool decodeWav(std::vector<char>& data, aace::audio::AudioFormat& format) {
+    if (data.size() < 12 || std::memcmp(data.data(), "RIFF", 4) != 0 || std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    uint16_t audioFormat = 0;
+    uint16_t channels = 0;
+    uint32_t sampleRate = 0;
+    uint16_t bitsPerSample = 0;
+    size_t offset = 12;
+    while (offset + 8 <= data.size()) {
+        const char* chunk = data.data() + offset;
+        size_t chunkSize = readUint32(chunk + 4);
+        size_t available = data.size() - offset - 8;
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16 && available >= 16) {
+            audioFormat = readUint16(chunk + 8);
+            channels = readUint16(chunk + 10);
+            sampleRate = readUint32(chunk + 12);
+            bitsPerSample = readUint16(chunk + 22);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            // the PCM format is the only one the audio outputs play as a stream
+            const uint16_t WAVE_FORMAT_PCM = 1;
+            if (audioFormat != WAVE_FORMAT_PCM || bitsPerSample != 16 || channels == 0 || sampleRate == 0) {
+                return false;
+            }
+            chunkSize = std::min(chunkSize, available);
+            data.erase(data.begin(), data.begin() + offset + 8);
+            data.resize(chunkSize - chunkSize % (channels * sizeof(int16_t)));
+            format = aace::audio::AudioFormat(
+                aace::audio::AudioFormat::Encoding::LPCM,
+                aace::audio::AudioFormat::SampleFormat::SIGNED,
+                aace::audio::AudioFormat::Layout::INTERLEAVED,
+                aace::audio::AudioFormat::Endianness::LITTLE,
+                sampleRate,
+                16,
+                static_cast<uint8_t>(channels));
+            return true;
+        }
+        // the chunks are padded to an even size
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    return false;
+}
+
 std::shared_ptr<SystemSoundPlayer> SystemSoundPlayer::create(
     std::shared_ptr<aace::engine::audio::AudioManagerInterface> audioManager,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::audio::SystemSoundAudioFactoryInterface> audioFactory) {
@@ -47,6 +119,12 @@ bool SystemSoundPlayer::initialize(
     try {
         m_audioManager = audioManager;
         m_audioFactory = audioFactory;
+
+        // load the tones ahead of the first play, which can load a tone that fails here again
+        for (auto tone : TONES) {
+            loadTone(tone);
+        }
+
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -75,6 +153,53 @@ std::shared_ptr<aace::engine::audio::AudioOutputChannelInterface> SystemSoundPla
     }
 }
 
+bool SystemSoundPlayer::loadTone(Tone tone) {
+    try {
+        std::shared_ptr<std::istream> stream;
+        alexaClientSDK::avsCommon::utils::MediaType mediaType = alexaClientSDK::avsCommon::utils::MediaType::UNKNOWN;
+        switch (tone) {
+            case Tone::WAKEWORD_NOTIFICATION:
+                std::tie(stream, mediaType) = m_audioFactory->wakeWordNotificationTone()();
+                break;
+            case Tone::END_SPEECH:
+                std::tie(stream, mediaType) = m_audioFactory->endSpeechTone()();
+                break;
+        }
+        ThrowIfNull(stream, "invalidToneStream");
+
+        // read the whole tone
+        auto data = std::make_shared<std::vector<char>>();
+        char buffer[READ_CHUNK_SIZE];
+        while (!stream->eof()) {
+            stream->read(buffer, READ_CHUNK_SIZE);
+            ThrowIf(stream->bad(), "readToneFailed");
+            data->insert(data->end(), buffer, buffer + stream->gcount());
+            // Don't remove. Otherwise the ResourceStream used for Alerts/Timers won't work as expected.
+            stream->tellg();
+        }
+        ThrowIf(data->empty(), "emptyTone");
+
+        aace::audio::AudioFormat format;
+        if (mediaType == alexaClientSDK::avsCommon::utils::MediaType::MPEG) {
+            format = aace::audio::AudioFormat(aace::audio::AudioFormat::Encoding::MP3);
+        } else if (!decodeWav(*data, format)) {
+            // the audio output has to detect the format
+            format = aace::audio::AudioFormat::UNKNOWN;
+        }
+        data->shrink_to_fit();
+
+        AACE_DEBUG(LX(TAG)
+                       .d("tone", static_cast<int>(tone))
+                       .d("size", data->size())
+                       .d("encoding", format.getEncoding()));
+        m_tones[tone] = SystemSound{data, format};
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("tone", static_cast<int>(tone)));
+        return false;
+    }
+}
+
 //
 // aace::audio::AudioOutputEngineInterface
 //
@@ -97,6 +222,9 @@ void SystemSoundPlayer::onMediaError(MediaError error, const std::string& descri
 void SystemSoundPlayer::onAudioFocusEvent(FocusAction action) {
 }
 
+void SystemSoundPlayer::onMediaPositionChanged(int64_t position) {
+}
+
 //
 // alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface
 //
@@ -110,8 +238,13 @@ std::shared_future<bool> SystemSoundPlayer::playTone(Tone tone) {
         auto audioChannel = getAudioChannel();
         ThrowIfNull(audioChannel, "invalidAudioChannel");
 
-        // create the audio stream
-        auto stream = SystemSoundAudioStream::create(m_audioFactory, tone);
+        // play the tone from memory
+        auto it = m_tones.find(tone);
+        if (it == m_tones.end()) {
+            ThrowIfNot(loadTone(tone), "loadToneFailed");
+            it = m_tones.find(tone);
+        }
+        auto stream = SystemSoundAudioStream::create(it->second.data, it->second.format, tone);
         ThrowIfNull(stream, "invalidAudioStream");
 
         // prepare the sound to play
@@ -134,67 +267,38 @@ std::shared_future<bool> SystemSoundPlayer::playTone(Tone tone) {
 //
 
 SystemSoundAudioStream::SystemSoundAudioStream(
-    std::shared_ptr<std::istream> stream,
-    alexaClientSDK::avsCommon::utils::MediaType mediaType,
+    std::shared_ptr<const std::vector<char>> data,
+    aace::audio::AudioFormat format,
     alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone tone) :
-        m_stream(stream), m_tone(tone), m_closed(false) {
+        m_data(std::move(data)), m_offset(0), m_format(format), m_tone(tone) {
 }
 
 std::shared_ptr<SystemSoundAudioStream> SystemSoundAudioStream::create(
-    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::audio::SystemSoundAudioFactoryInterface> audioFactory,
+    std::shared_ptr<const std::vector<char>> data,
+    aace::audio::AudioFormat format,
     alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone tone) {
-    std::shared_ptr<SystemSoundAudioStream> stream;
-
-    std::shared_ptr<std::istream> iStream;
-    alexaClientSDK::avsCommon::utils::MediaType streamFormat = alexaClientSDK::avsCommon::utils::MediaType::UNKNOWN;
-
-    switch (tone) {
-        case alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone::WAKEWORD_NOTIFICATION:
-            std::tie(iStream, streamFormat) = audioFactory->wakeWordNotificationTone()();
-            stream = std::shared_ptr<SystemSoundAudioStream>(new SystemSoundAudioStream(
-                iStream,
-                streamFormat,
-                alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone::WAKEWORD_NOTIFICATION));
-            break;
-
-        case alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone::END_SPEECH:
-            std::tie(iStream, streamFormat) = audioFactory->endSpeechTone()();
-            stream = std::shared_ptr<SystemSoundAudioStream>(new SystemSoundAudioStream(
-                iStream,
-                streamFormat,
-                alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone::END_SPEECH));
-            break;
+    try {
+        ThrowIfNull(data, "invalidData");
+        return std::shared_ptr<SystemSoundAudioStream>(new SystemSoundAudioStream(std::move(data), format, tone));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG + ".SystemSoundAudioStream").d("reason", ex.what()));
+        return nullptr;
     }
-
-    return stream;
 }
 
 ssize_t SystemSoundAudioStream::read(char* data, const size_t size) {
-    try {
-        if (m_stream->eof()) {
-            m_closed = true;
-            return 0;
-        }
-
-        // read the data from the stream
-        m_stream->read(data, size);
-        ThrowIf(m_stream->bad(), "readFailed");
-
-        // get the number of bytes read
-        ssize_t count = m_stream->gcount();
-
-        m_stream->tellg();  // Don't remove. Otherwise the ResourceStream used for Alerts/Timers won't work as expected.
-
-        return count;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG + ".SystemSoundAudioStream").d("reason", ex.what()).d("size", size).d("closed", m_closed));
-        m_closed = true;
-        return 0;
-    }
+    auto count = std::min(size, m_data->size() - m_offset);
+    std::memcpy(data, m_data->data() + m_offset, count);
+    m_offset += count;
+    return count;
 }
 
 bool SystemSoundAudioStream::isClosed() {
-    return m_closed;
+    return m_offset == m_data->size();
+}
+
+aace::audio::AudioFormat SystemSoundAudioStream::getAudioFormat() {
+    return m_format;
 }
 
 std::vector<aace::audio::AudioStreamProperty> SystemSoundAudioStream::getProperties() {
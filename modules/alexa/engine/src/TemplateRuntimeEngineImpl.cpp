@@ -36,6 +36,22 @@ static const std::string METRIC_TEMPLATERUNTIME_RENDER_PLAYER_INFO = "RenderPlay
 static const std::string METRIC_TEMPLATERUNTIME_CLEAR_PLAYER_INFO = "ClearPlayerInfo";
 static const std::string METRIC_TEMPLATERUNTIME_DISPLAY_CARD_CLEARED = "DisplayCardCleared";
 
+/// The field of the player info payload identifying the audio item it describes
+static const std::string PAYLOAD_AUDIO_ITEM_ID = "audioItemId";
+
+// Whether a member of an object, or of its objects, is null, which a merge patch can't express
+static bool hasNullMember(const nlohmann::json& value) {
+    if (!value.is_object()) {
+        return false;
+    }
+    for (const auto& member : value) {
+        if (member.is_null() || hasNullMember(member)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Convert AVS FocusState type to an AACE FocusState type for use in the platform interface.
 static aace::alexa::FocusState convertFocusState(alexaClientSDK::avsCommon::avs::FocusState focusState) {
     switch (focusState) {
@@ -70,9 +86,11 @@ static aace::alexa::PlayerActivity convertPlayerActivity(
 }
 
 TemplateRuntimeEngineImpl::TemplateRuntimeEngineImpl(
-    std::shared_ptr<aace::alexa::TemplateRuntime> templateRuntimePlatformInterface) :
+    std::shared_ptr<aace::alexa::TemplateRuntime> templateRuntimePlatformInterface,
+    bool renderPlayerInfoDeltas) :
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
-        m_templateRuntimePlatformInterface(templateRuntimePlatformInterface) {
+        m_templateRuntimePlatformInterface(templateRuntimePlatformInterface),
+        m_renderPlayerInfoDeltas(renderPlayerInfoDeltas) {
 }
 
 bool TemplateRuntimeEngineImpl::initialize(
@@ -124,7 +142,8 @@ std::shared_ptr<TemplateRuntimeEngineImpl> TemplateRuntimeEngineImpl::create(
         renderPlayerInfoCardsProviderInterfaces,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
     std::shared_ptr<alexaClientSDK::avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
-    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender) {
+    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
+    bool renderPlayerInfoDeltas) {
     std::shared_ptr<TemplateRuntimeEngineImpl> templateRuntimeEngineImpl = nullptr;
 
     try {
@@ -134,8 +153,8 @@ std::shared_ptr<TemplateRuntimeEngineImpl> TemplateRuntimeEngineImpl::create(
         ThrowIfNull(dialogUXStateAggregator, "invalidDialogUXStateAggregator");
         ThrowIfNull(exceptionSender, "invalidExceptionEncounteredSenderInterface");
 
-        templateRuntimeEngineImpl =
-            std::shared_ptr<TemplateRuntimeEngineImpl>(new TemplateRuntimeEngineImpl(templateRuntimePlatformInterface));
+        templateRuntimeEngineImpl = std::shared_ptr<TemplateRuntimeEngineImpl>(
+            new TemplateRuntimeEngineImpl(templateRuntimePlatformInterface, renderPlayerInfoDeltas));
 
         ThrowIfNot(
             templateRuntimeEngineImpl->initialize(
@@ -190,6 +209,32 @@ void TemplateRuntimeEngineImpl::renderPlayerInfoCard(
     alexaClientSDK::avsCommon::avs::FocusState focusState,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MediaPropertiesInterface> mediaProperties) {
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "renderPlayerInfoCard", {METRIC_TEMPLATERUNTIME_RENDER_PLAYER_INFO});
+    if (m_renderPlayerInfoDeltas) {
+        try {
+            auto playerInfo = nlohmann::json::parse(jsonPayload);
+            nlohmann::json patch;
+            auto audioItemId = playerInfo.find(PAYLOAD_AUDIO_ITEM_ID);
+            // the progress and control changes of a track repeat its metadata, which is sent once
+            bool sameAudioItem = audioItemId != playerInfo.end() && audioItemId->is_string() &&
+                                 m_lastPlayerInfo.is_object() && m_lastPlayerInfo.contains(PAYLOAD_AUDIO_ITEM_ID) &&
+                                 m_lastPlayerInfo[PAYLOAD_AUDIO_ITEM_ID] == *audioItemId;
+            if (sameAudioItem && createMergePatch(m_lastPlayerInfo, playerInfo, patch)) {
+                patch[PAYLOAD_AUDIO_ITEM_ID] = *audioItemId;
+                if (m_templateRuntimePlatformInterface->renderPlayerInfoDelta(
+                        patch.dump(),
+                        convertPlayerActivity(audioPlayerInfo.audioPlayerState),
+                        audioPlayerInfo.offset,
+                        convertFocusState(focusState))) {
+                    m_lastPlayerInfo = std::move(playerInfo);
+                    return;
+                }
+            }
+            m_lastPlayerInfo = std::move(playerInfo);
+        } catch (std::exception& ex) {
+            AACE_WARN(LX(TAG, "renderPlayerInfoCard").d("reason", ex.what()).m("renderingFullPlayerInfo"));
+            m_lastPlayerInfo = nullptr;
+        }
+    }
     m_templateRuntimePlatformInterface->renderPlayerInfo(
         jsonPayload,
         convertPlayerActivity(audioPlayerInfo.audioPlayerState),
@@ -197,8 +242,41 @@ void TemplateRuntimeEngineImpl::renderPlayerInfoCard(
         convertFocusState(focusState));
 }
 
+bool TemplateRuntimeEngineImpl::createMergePatch(
+    const nlohmann::json& source,
+    const nlohmann::json& target,
+    nlohmann::json& patch) {
+    if (target.is_null()) {
+        return false;
+    }
+    if (!source.is_object() || !target.is_object()) {
+        // the value replaces the previous one, the members of its objects are merged into an empty object
+        patch = target;
+        return !hasNullMember(target);
+    }
+    patch = nlohmann::json::object();
+    for (auto it = source.begin(); it != source.end(); ++it) {
+        if (!target.contains(it.key())) {
+            patch[it.key()] = nullptr;
+        }
+    }
+    for (auto it = target.begin(); it != target.end(); ++it) {
+        auto sourceValue = source.find(it.key());
+        if (sourceValue != source.end() && *sourceValue == it.value()) {
+            continue;
+        }
+        nlohmann::json valuePatch;
+        if (!createMergePatch(sourceValue != source.end() ? *sourceValue : nlohmann::json(), it.value(), valuePatch)) {
+            return false;
+        }
+        patch[it.key()] = std::move(valuePatch);
+    }
+    return true;
+}
+
 void TemplateRuntimeEngineImpl::clearPlayerInfoCard(const std::string& token) {
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "clearPlayerInfoCard", {METRIC_TEMPLATERUNTIME_CLEAR_PLAYER_INFO});
+    m_lastPlayerInfo = nullptr;
     m_templateRuntimePlatformInterface->clearPlayerInfo();
 }
 
@@ -62,7 +62,7 @@ static const char VEHICLEDATA_ATTRIBUTE_VEHICLE_IDENTIFIER[] = "vehicleIdentifie
 static const char VEHICLEDATA_ATTRIBUTE_RSE_EMBEDDED_FIRETVS[] = "rseEmbeddedFireTvs";
 
 /// Map from a capability attribute string to its corresponding @c VehiclePropertyType
-static std::unordered_map<std::string, VehicleData::VehiclePropertyType> s_attributeToVehiclePropertyMap = {
+static const std::unordered_map<std::string, VehicleData::VehiclePropertyType> s_attributeToVehiclePropertyMap = {
     {VEHICLEDATA_ATTRIBUTE_OS, VehicleData::VehiclePropertyType::OPERATING_SYSTEM},
     {VEHICLEDATA_ATTRIBUTE_ARCH, VehicleData::VehiclePropertyType::HARDWARE_ARCH},
     {VEHICLEDATA_ATTRIBUTE_MIC, VehicleData::VehiclePropertyType::MICROPHONE},
@@ -103,8 +103,11 @@ alexaClientSDK::avsCommon::utils::Optional<std::string> VehicleData::getProperty
     const std::string& attribute,
     const VehiclePropertyMap& vehiclePropertyMap) {
     alexaClientSDK::avsCommon::utils::Optional<std::string> value;
-    auto propertyType = s_attributeToVehiclePropertyMap[attribute];
-    auto it = vehiclePropertyMap.find(propertyType);
+    auto attributeIt = s_attributeToVehiclePropertyMap.find(attribute);
+    if (attributeIt == s_attributeToVehiclePropertyMap.end()) {
+        return value;
+    }
+    auto it = vehiclePropertyMap.find(attributeIt->second);
     if (it != vehiclePropertyMap.end()) {
         value.set(it->second);
     }
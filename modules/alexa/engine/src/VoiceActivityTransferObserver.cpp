@@ -0,0 +1,62 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AACE/Engine/Alexa/VoiceActivityTransferObserver.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.VoiceActivityTransferObserver");
+
+std::shared_ptr<VoiceActivityTransferObserver> VoiceActivityTransferObserver::create(
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler) {
+    try {
+        ThrowIfNull(backgroundTransferScheduler, "invalidBackgroundTransferScheduler");
+        return std::shared_ptr<VoiceActivityTransferObserver>(
+            new VoiceActivityTransferObserver(backgroundTransferScheduler));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+VoiceActivityTransferObserver::VoiceActivityTransferObserver(
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler) :
+        m_backgroundTransferScheduler(backgroundTransferScheduler) {
+}
+
+void VoiceActivityTransferObserver::onDialogUXStateChanged(DialogUXState newState) {
+    if (auto backgroundTransferScheduler = m_backgroundTransferScheduler.lock()) {
+        switch (newState) {
+            case DialogUXState::LISTENING:
+            case DialogUXState::EXPECTING:
+            case DialogUXState::THINKING:
+            case DialogUXState::SPEAKING:
+                backgroundTransferScheduler->setVoiceActive(true);
+                break;
+            case DialogUXState::IDLE:
+            case DialogUXState::FINISHED:
+                backgroundTransferScheduler->setVoiceActive(false);
+                break;
+        }
+    }
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
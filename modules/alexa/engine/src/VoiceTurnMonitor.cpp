@@ -0,0 +1,366 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <utility>
+#include <vector>
+
+#include <AACE/Engine/Alexa/VoiceTurnMonitor.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/JSON/JSON.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+using namespace aace::engine::utils::metrics;
+using DialogUXState = alexaClientSDK::avsCommon::sdkInterfaces::DialogUXStateObserverInterface::DialogUXState;
+using Stage = VoiceTurnMonitor::Stage;
+namespace json = aace::engine::utils::json;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.VoiceTurnMonitor");
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "VoiceTurn";
+
+/// Metric for a turn whose response latency breached the service level objective
+static const std::string METRIC_SLO_BREACHED = "SloBreached";
+
+/// Metric for the response latency of a turn, from the end of speech to the first audio out
+static const std::string METRIC_RESPONSE_LATENCY = "EndOfSpeechToFirstAudioOut";
+
+/// Metric for the time the media took to resume once the dialog ended
+static const std::string METRIC_MEDIA_RESUME_LATENCY = "DialogIdleToMediaResume";
+
+/// The channel of the speech synthesizer, whose audio is the response of the turns
+static const std::string SPEECH_SYNTHESIZER_CHANNEL = "SpeechSynthesizer";
+
+/// The path of the dialog request id in a directive
+static const json::Pointer DIALOG_REQUEST_ID_POINTER = json::pointer("/directive/header/dialogRequestId");
+
+const int VoiceTurnMonitor::STAGE_COUNT;
+const std::chrono::milliseconds VoiceTurnMonitor::DEFAULT_MEDIA_RESUME_TIMEOUT(3000);
+
+namespace {
+
+/// The consecutive stages whose latency is emitted, with the name of their metric
+struct StageLatency {
+    Stage from;
+    Stage to;
+    const char* metric;
+};
+
+const StageLatency STAGE_LATENCIES[] = {
+    {Stage::WAKEWORD, Stage::CAPTURE_STARTED, "WakewordToCaptureStart"},
+    {Stage::CAPTURE_STARTED, Stage::END_OF_SPEECH, "CaptureStartToEndOfSpeech"},
+    {Stage::END_OF_SPEECH, Stage::FIRST_DIRECTIVE, "EndOfSpeechToFirstDirective"},
+    {Stage::FIRST_DIRECTIVE, Stage::TTS_PREPARED, "FirstDirectiveToTtsPrepare"},
+    {Stage::TTS_PREPARED, Stage::FIRST_AUDIO_OUT, "TtsPrepareToFirstAudioOut"}};
+
+const char* getStageName(Stage stage) {
+    switch (stage) {
+        case Stage::WAKEWORD:
+            return "wakeword";
+        case Stage::CAPTURE_STARTED:
+            return "captureStarted";
+        case Stage::END_OF_SPEECH:
+            return "endOfSpeech";
+        case Stage::FIRST_DIRECTIVE:
+            return "firstDirective";
+        case Stage::TTS_PREPARED:
+            return "ttsPrepared";
+        case Stage::FIRST_AUDIO_OUT:
+            return "firstAudioOut";
+        case Stage::MEDIA_RESUMED:
+            return "mediaResumed";
+    }
+    return "unknown";
+}
+
+}  // namespace
+
+VoiceTurnMonitor::Clock::time_point VoiceTurnMonitor::Turn::get(Stage stage) const {
+    return stages[static_cast<int>(stage)];
+}
+
+bool VoiceTurnMonitor::Turn::has(Stage stage) const {
+    return get(stage) != Clock::time_point();
+}
+
+std::chrono::milliseconds VoiceTurnMonitor::Turn::getLatency(Stage from, Stage to) const {
+    if (!has(from) || !has(to) || get(to) < get(from)) {
+        return std::chrono::milliseconds(-1);
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(get(to) - get(from));
+}
+
+std::shared_ptr<VoiceTurnMonitor> VoiceTurnMonitor::create(
+    std::chrono::milliseconds responseLatencySlo,
+    std::chrono::milliseconds mediaResumeTimeout) {
+    try {
+        ThrowIf(responseLatencySlo.count() < 0, "invalidResponseLatencySlo");
+        ThrowIf(mediaResumeTimeout.count() < 0, "invalidMediaResumeTimeout");
+        return std::shared_ptr<VoiceTurnMonitor>(new VoiceTurnMonitor(responseLatencySlo, mediaResumeTimeout));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+VoiceTurnMonitor::VoiceTurnMonitor(
+    std::chrono::milliseconds responseLatencySlo,
+    std::chrono::milliseconds mediaResumeTimeout) :
+        m_responseLatencySlo(responseLatencySlo), m_mediaResumeTimeout(mediaResumeTimeout) {
+}
+
+VoiceTurnMonitor::~VoiceTurnMonitor() {
+    shutdown();
+}
+
+void VoiceTurnMonitor::onWakewordDetected() {
+    auto now = Clock::now();
+    Turn completed;
+    bool hasCompleted = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ReturnIf(m_isShutdown);
+        hasCompleted = startTurn(completed);
+        recordStage(Stage::WAKEWORD, now);
+    }
+    if (hasCompleted) {
+        report(completed);
+    }
+}
+
+void VoiceTurnMonitor::onCaptureStarted() {
+    auto now = Clock::now();
+    Turn completed;
+    bool hasCompleted = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ReturnIf(m_isShutdown);
+        // the capture of a wakeword continues its turn, any other capture starts a turn, such as a tap to talk
+        // or the capture expected by the previous turn
+        if (!m_turnActive || m_turn.has(Stage::CAPTURE_STARTED)) {
+            hasCompleted = startTurn(completed);
+        }
+        recordStage(Stage::CAPTURE_STARTED, now);
+    }
+    if (hasCompleted) {
+        report(completed);
+    }
+}
+
+void VoiceTurnMonitor::onEndOfSpeech() {
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_turnActive && m_turn.has(Stage::CAPTURE_STARTED)) {
+        recordStage(Stage::END_OF_SPEECH, now);
+    }
+}
+
+VoiceTurnMonitor::Turn VoiceTurnMonitor::getLastTurn() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastTurn;
+}
+
+void VoiceTurnMonitor::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShutdown = true;
+        m_turnActive = false;
+    }
+    // the timeout locks the mutex, so the timer is stopped without the lock
+    m_mediaResumeTimer.stop();
+}
+
+void VoiceTurnMonitor::receive(const std::string& contextId, const std::string& message) {
+    auto now = Clock::now();
+    // most directives do not belong to a turn, or arrive once its first directive was received
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_turnActive || !m_turn.has(Stage::CAPTURE_STARTED) || !m_turn.dialogRequestId.empty()) {
+            return;
+        }
+    }
+    if (message.find("\"dialogRequestId\"") == std::string::npos) {
+        return;
+    }
+    auto dialogRequestId = json::get(json::toJson(message), DIALOG_REQUEST_ID_POINTER, "");
+    if (dialogRequestId.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // the directives of the previous turn may still arrive once the next turn started
+    if (m_turnActive && m_turn.dialogRequestId.empty() && dialogRequestId != m_lastTurn.dialogRequestId) {
+        m_turn.dialogRequestId = dialogRequestId;
+        recordStage(Stage::FIRST_DIRECTIVE, now);
+    }
+}
+
+void VoiceTurnMonitor::onDialogUXStateChanged(DialogUXState newState) {
+    uint64_t turnId = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (newState != DialogUXState::IDLE || !m_turnActive || !m_turn.has(Stage::CAPTURE_STARTED) ||
+            m_turn.dialogIdle != Clock::time_point()) {
+            return;
+        }
+        m_turn.dialogIdle = Clock::now();
+        turnId = m_turnId;
+    }
+
+    // the media of the turn resumes once the dialog ends, if any media was playing when the turn started
+    m_mediaResumeTimer.stop();
+    m_mediaResumeTimer.start(m_mediaResumeTimeout, [this, turnId] { executeMediaResumeTimeout(turnId); });
+}
+
+void VoiceTurnMonitor::onChannelCall(const std::string& channel, AudioChannelTrace::Call call, Clock::time_point time) {
+    Turn completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_turnActive) {
+            return;
+        }
+        if (channel == SPEECH_SYNTHESIZER_CHANNEL) {
+            if (call == AudioChannelTrace::Call::PREPARE && m_turn.has(Stage::FIRST_DIRECTIVE)) {
+                recordStage(Stage::TTS_PREPARED, time);
+            }
+            return;
+        }
+        // the media ducked by the turn is restored
+        if (call != AudioChannelTrace::Call::STOP_DUCKING || !m_turn.has(Stage::CAPTURE_STARTED)) {
+            return;
+        }
+        recordStage(Stage::MEDIA_RESUMED, time);
+        completed = completeTurn();
+    }
+    report(completed);
+}
+
+void VoiceTurnMonitor::onChannelTransition(
+    const std::string& channel,
+    AudioChannelTrace::Transition transition,
+    Clock::time_point reported) {
+    Turn completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_turnActive) {
+            return;
+        }
+        if (channel == SPEECH_SYNTHESIZER_CHANNEL) {
+            if (transition == AudioChannelTrace::Transition::STARTED && m_turn.has(Stage::TTS_PREPARED)) {
+                recordStage(Stage::FIRST_AUDIO_OUT, reported);
+            }
+            return;
+        }
+        // the media paused by the turn is resumed
+        if (transition != AudioChannelTrace::Transition::RESUMED || !m_turn.has(Stage::CAPTURE_STARTED)) {
+            return;
+        }
+        recordStage(Stage::MEDIA_RESUMED, reported);
+        completed = completeTurn();
+    }
+    report(completed);
+}
+
+bool VoiceTurnMonitor::startTurn(Turn& completed) {
+    bool hasCompleted = false;
+    // a turn whose capture did not start, such as a wakeword rejected by a verifier, is dropped
+    if (m_turnActive && m_turn.has(Stage::CAPTURE_STARTED)) {
+        completed = completeTurn();
+        hasCompleted = true;
+    }
+    m_turn = Turn();
+    m_turnActive = true;
+    m_turnId++;
+    return hasCompleted;
+}
+
+void VoiceTurnMonitor::recordStage(Stage stage, Clock::time_point time) {
+    auto& stageTime = m_turn.stages[static_cast<int>(stage)];
+    if (stageTime == Clock::time_point()) {
+        stageTime = time;
+    }
+}
+
+VoiceTurnMonitor::Turn VoiceTurnMonitor::completeTurn() {
+    m_turnActive = false;
+    m_lastTurn = m_turn;
+    return m_turn;
+}
+
+void VoiceTurnMonitor::executeMediaResumeTimeout(uint64_t turnId) {
+    Turn completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_turnActive || m_turnId != turnId) {
+            return;
+        }
+        completed = completeTurn();
+    }
+    report(completed);
+}
+
+void VoiceTurnMonitor::report(const Turn& turn) {
+    std::vector<std::pair<std::string, double>> latencies;
+    for (auto& stageLatency : STAGE_LATENCIES) {
+        auto latency = turn.getLatency(stageLatency.from, stageLatency.to);
+        if (latency.count() >= 0) {
+            latencies.emplace_back(stageLatency.metric, static_cast<double>(latency.count()));
+        }
+    }
+    if (turn.has(Stage::MEDIA_RESUMED) && turn.dialogIdle != Clock::time_point() &&
+        turn.dialogIdle <= turn.get(Stage::MEDIA_RESUMED)) {
+        auto latency =
+            std::chrono::duration_cast<std::chrono::milliseconds>(turn.get(Stage::MEDIA_RESUMED) - turn.dialogIdle);
+        latencies.emplace_back(METRIC_MEDIA_RESUME_LATENCY, static_cast<double>(latency.count()));
+    }
+    auto responseLatency = turn.getLatency(Stage::END_OF_SPEECH, Stage::FIRST_AUDIO_OUT);
+    if (responseLatency.count() >= 0) {
+        latencies.emplace_back(METRIC_RESPONSE_LATENCY, static_cast<double>(responseLatency.count()));
+    }
+    bool breached = m_responseLatencySlo.count() > 0 && responseLatency > m_responseLatencySlo;
+
+    AACE_DEBUG(LX(TAG).d("dialogRequestId", turn.dialogRequestId).d("responseLatency", responseLatency.count()));
+    std::vector<std::pair<std::string, int>> counters;
+    if (breached) {
+        counters.emplace_back(METRIC_SLO_BREACHED, 1);
+    }
+    emitMetrics(METRIC_PROGRAM_NAME_SUFFIX, "report", counters, {}, latencies);
+
+    if (breached) {
+        // the breakdown has the time of each stage from the start of the turn
+        auto start = turn.has(Stage::WAKEWORD) ? turn.get(Stage::WAKEWORD) : turn.get(Stage::CAPTURE_STARTED);
+        auto entry = LX(TAG, "sloBreached")
+                         .d("dialogRequestId", turn.dialogRequestId)
+                         .d("responseLatency", responseLatency.count())
+                         .d("slo", m_responseLatencySlo.count());
+        for (int index = 0; index < STAGE_COUNT; index++) {
+            auto stage = static_cast<Stage>(index);
+            if (turn.has(stage)) {
+                auto offset = std::chrono::duration_cast<std::chrono::milliseconds>(turn.get(stage) - start);
+                entry.d(getStageName(stage), offset.count());
+            }
+        }
+        AACE_WARN(entry);
+    }
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
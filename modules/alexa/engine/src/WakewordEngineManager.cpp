@@ -53,6 +53,45 @@ std::shared_ptr<WakewordEngineAdapter> WakewordEngineManager::createAdapter(
     return it->second(type);
 }
 
+std::shared_ptr<WakewordPipeline> WakewordEngineManager::getPipeline(
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+    const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat,
+    const WakewordPipeline::Config& config) {
+    if (stream == nullptr) {
+        AACE_ERROR(LX(TAG, "Invalid stream."));
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_pipelinesMutex);
+    auto it = m_pipelines.find(stream.get());
+    if (it != m_pipelines.end()) {
+        // the pipeline holds the stream, so a live pipeline can't be reading another stream at the same address
+        auto pipeline = it->second.lock();
+        if (pipeline != nullptr) {
+            return pipeline;
+        }
+    }
+
+    // forget the pipelines that are no longer used
+    for (auto next = m_pipelines.begin(); next != m_pipelines.end();) {
+        next = next->second.expired() ? m_pipelines.erase(next) : std::next(next);
+    }
+
+    auto pipeline = WakewordPipeline::create(stream, audioFormat, config);
+    if (pipeline != nullptr) {
+        m_pipelines[stream.get()] = pipeline;
+    }
+
+    return pipeline;
+}
+
+std::shared_ptr<WakewordPipeline> WakewordEngineManager::findPipeline(
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream) {
+    std::lock_guard<std::mutex> lock(m_pipelinesMutex);
+    auto it = m_pipelines.find(stream.get());
+    return it != m_pipelines.end() ? it->second.lock() : nullptr;
+}
+
 }  // namespace alexa
 }  // namespace engine
 }  // namespace aace
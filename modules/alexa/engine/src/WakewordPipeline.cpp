@@ -0,0 +1,235 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include <AACE/Engine/Alexa/WakewordPipeline.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/PCM/PCMUtils.h>
+
+namespace aace {
+namespace engine {
+namespace alexa {
+
+using alexaClientSDK::avsCommon::avs::AudioInputStream;
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.alexa.WakewordPipeline");
+
+/// The time the pipeline waits for audio before checking whether it is shut down.
+static const std::chrono::milliseconds READ_TIMEOUT = std::chrono::milliseconds(100);
+
+/// The duration of a frame, by default.
+static const std::chrono::milliseconds DEFAULT_FRAME_DURATION = std::chrono::milliseconds(10);
+
+/// The number of frames delivered at once, by default.
+static const size_t DEFAULT_FRAMES_PER_BATCH = 5;
+
+/// The level above which a frame has voice activity, by default.
+static const float DEFAULT_VAD_THRESHOLD = -50.0f;
+
+WakewordPipeline::Config::Config() :
+        frameDuration(DEFAULT_FRAME_DURATION),
+        framesPerBatch(DEFAULT_FRAMES_PER_BATCH),
+        vadEnabled(false),
+        vadThreshold(DEFAULT_VAD_THRESHOLD),
+        featureSize(0) {
+}
+
+WakewordPipeline::WakewordPipeline(
+    std::shared_ptr<AudioInputStream> stream,
+    size_t frameSize,
+    const Config& config) :
+        m_stream(stream), m_frameSize(frameSize), m_config(config) {
+    m_batch.frameSize = m_frameSize;
+    m_batch.featureSize = m_config.featureExtractor ? m_config.featureSize : 0;
+    m_batch.samples.reserve(m_frameSize * m_config.framesPerBatch);
+    m_batch.levels.reserve(m_config.framesPerBatch);
+    m_batch.voiceActivity.reserve(m_config.framesPerBatch);
+    m_batch.features.reserve(m_batch.featureSize * m_config.framesPerBatch);
+}
+
+WakewordPipeline::~WakewordPipeline() {
+    shutdown();
+}
+
+std::shared_ptr<WakewordPipeline> WakewordPipeline::create(
+    std::shared_ptr<AudioInputStream> stream,
+    const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat,
+    const Config& config) {
+    try {
+        ThrowIfNull(stream, "invalidStream");
+        ThrowIfNot(
+            audioFormat.encoding == alexaClientSDK::avsCommon::utils::AudioFormat::Encoding::LPCM &&
+                audioFormat.sampleSizeInBits == sizeof(int16_t) * CHAR_BIT && audioFormat.numChannels == 1,
+            "unsupportedAudioFormat");
+        ThrowIf(stream->getWordSize() != sizeof(int16_t), "invalidStreamWordSize");
+        ThrowIf(config.frameDuration.count() <= 0, "invalidFrameDuration");
+        ThrowIf(config.framesPerBatch == 0, "invalidFramesPerBatch");
+        ThrowIf(config.featureExtractor && config.featureSize == 0, "invalidFeatureSize");
+
+        auto frameSize = static_cast<size_t>(audioFormat.sampleRateHz * config.frameDuration.count() / 1000);
+        ThrowIf(frameSize == 0, "invalidFrameSize");
+
+        auto pipeline = std::shared_ptr<WakewordPipeline>(new WakewordPipeline(stream, frameSize, config));
+
+        // the wakeword engines only look at the audio written from now on
+        pipeline->m_reader = stream->createReader(AudioInputStream::Reader::Policy::BLOCKING, true);
+        ThrowIfNull(pipeline->m_reader, "createReaderFailed");
+
+        pipeline->m_running = true;
+        pipeline->m_thread = std::thread(&WakewordPipeline::readLoop, pipeline.get());
+
+        return pipeline;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+bool WakewordPipeline::addConsumer(std::shared_ptr<WakewordFrameConsumer> consumer) {
+    try {
+        ThrowIfNull(consumer, "invalidConsumer");
+
+        std::lock_guard<std::mutex> lock(m_consumersMutex);
+        ThrowIf(
+            std::find(m_consumers.begin(), m_consumers.end(), consumer) != m_consumers.end(), "consumerAlreadyAdded");
+        m_consumers.push_back(consumer);
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "addConsumer").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool WakewordPipeline::removeConsumer(std::shared_ptr<WakewordFrameConsumer> consumer) {
+    try {
+        // the consumers are called with the lock held, so no call is in progress once it is acquired
+        std::lock_guard<std::mutex> lock(m_consumersMutex);
+        auto it = std::find(m_consumers.begin(), m_consumers.end(), consumer);
+        ThrowIf(it == m_consumers.end(), "consumerNotFound");
+        m_consumers.erase(it);
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "removeConsumer").d("reason", ex.what()));
+        return false;
+    }
+}
+
+void WakewordPipeline::runBetweenBatches(const std::function<void()>& task) {
+    // the batches are delivered with the lock held, so no batch is in progress once it is acquired
+    std::lock_guard<std::mutex> lock(m_consumersMutex);
+    task();
+}
+
+std::shared_ptr<AudioInputStream> WakewordPipeline::getStream() const {
+    return m_stream;
+}
+
+void WakewordPipeline::shutdown() {
+    m_running = false;
+    if (m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id()) {
+        m_thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(m_consumersMutex);
+    m_consumers.clear();
+}
+
+void WakewordPipeline::readLoop() {
+    // a whole batch is read at once when it is available
+    std::vector<int16_t> buffer(m_frameSize * m_config.framesPerBatch);
+    size_t buffered = 0;
+
+    while (m_running) {
+        auto result = m_reader->read(buffer.data() + buffered, buffer.size() - buffered, READ_TIMEOUT);
+        if (result == AudioInputStream::Reader::Error::TIMEDOUT) {
+            continue;
+        }
+        if (result == AudioInputStream::Reader::Error::OVERRUN) {
+            // the pipeline fell behind the writer, so it starts again from the new audio
+            AACE_WARN(LX(TAG, "readLoop").d("reason", "overrun"));
+            m_reader->seek(0, AudioInputStream::Reader::Reference::BEFORE_WRITER);
+            buffered = 0;
+            resetBatch();
+            continue;
+        }
+        if (result <= 0) {
+            if (result != AudioInputStream::Reader::Error::CLOSED) {
+                AACE_ERROR(LX(TAG, "readLoop").d("reason", "readFailed").d("error", result));
+            }
+            break;
+        }
+
+        buffered += static_cast<size_t>(result);
+        auto frames = buffered / m_frameSize;
+        auto bufferIndex = m_reader->tell() - buffered;
+        for (size_t j = 0; j < frames; j++) {
+            if (m_batch.frameCount == 0) {
+                m_batch.beginIndex = bufferIndex + j * m_frameSize;
+            }
+            processFrame(buffer.data() + j * m_frameSize);
+        }
+
+        // the partial frame is completed by the next read
+        auto processed = frames * m_frameSize;
+        std::memmove(buffer.data(), buffer.data() + processed, (buffered - processed) * sizeof(int16_t));
+        buffered -= processed;
+    }
+}
+
+void WakewordPipeline::processFrame(const int16_t* frame) {
+    auto level = aace::engine::utils::pcm::levelDbfs(frame, m_frameSize);
+    m_batch.samples.insert(m_batch.samples.end(), frame, frame + m_frameSize);
+    m_batch.levels.push_back(level);
+    m_batch.voiceActivity.push_back(!m_config.vadEnabled || level > m_config.vadThreshold);
+    if (m_batch.featureSize > 0) {
+        auto offset = m_batch.features.size();
+        m_batch.features.resize(offset + m_batch.featureSize);
+        m_config.featureExtractor(frame, m_frameSize, m_batch.features.data() + offset);
+    }
+
+    if (++m_batch.frameCount == m_config.framesPerBatch) {
+        deliverBatch();
+    }
+}
+
+void WakewordPipeline::deliverBatch() {
+    {
+        std::lock_guard<std::mutex> lock(m_consumersMutex);
+        for (auto& consumer : m_consumers) {
+            consumer->onFrames(m_batch);
+        }
+    }
+
+    resetBatch();
+}
+
+void WakewordPipeline::resetBatch() {
+    // the vectors keep their capacity, so the batches are not reallocated
+    m_batch.samples.clear();
+    m_batch.levels.clear();
+    m_batch.voiceActivity.clear();
+    m_batch.features.clear();
+    m_batch.frameCount = 0;
+}
+
+}  // namespace alexa
+}  // namespace engine
+}  // namespace aace
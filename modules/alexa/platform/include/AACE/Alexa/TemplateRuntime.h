@@ -95,6 +95,26 @@ public:
         std::chrono::milliseconds offset,
         FocusState focusState) = 0;
 
+    /**
+     * Provides the changes of the player info metadata for the audio item of the previous @c renderPlayerInfo() or
+     * @c renderPlayerInfoDelta() call, such as a change of the controls, when the Engine is configured to send player
+     * info deltas. The @c patch is a JSON merge patch (RFC 7386) of the previous metadata with the @c audioItemId of
+     * the audio item: a field with a @c null value was removed, and the other fields replace the fields of the
+     * previous metadata.
+     *
+     * @param [in] patch The changes of the player info metadata in structured JSON format
+     * @param [in] audioPlayerState The state of the @c AudioPlayer
+     * @param [in] offset The offset in millisecond of the media that @c AudioPlayer is handling
+     * @param [in] focusState The @c FocusState of the channel used by TemplateRuntime interface
+     * @return @c true if the changes were handled, or @c false, the default, if the platform implementation only
+     *         handles the full metadata, in which case @c renderPlayerInfo() is called with it.
+     */
+    virtual bool renderPlayerInfoDelta(
+        const std::string& patch,
+        PlayerActivity audioPlayerState,
+        std::chrono::milliseconds offset,
+        FocusState focusState);
+
     /**
      * Notifies the platform implementation to dismiss the player info display card
      */
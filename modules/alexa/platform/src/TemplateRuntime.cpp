@@ -20,6 +20,14 @@ namespace alexa {
 
 TemplateRuntime::~TemplateRuntime() = default;  // key function
 
+bool TemplateRuntime::renderPlayerInfoDelta(
+    const std::string& patch,
+    PlayerActivity audioPlayerState,
+    std::chrono::milliseconds offset,
+    FocusState focusState) {
+    return false;
+}
+
 void TemplateRuntime::displayCardCleared() {
     if (auto m_templateRuntimeEngineInterface_lock = m_templateRuntimeEngineInterface.lock()) {
         m_templateRuntimeEngineInterface_lock->onDisplayCardCleared();
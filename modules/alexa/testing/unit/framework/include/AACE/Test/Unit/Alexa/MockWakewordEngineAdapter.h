@@ -33,6 +33,8 @@ public:
             alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat));
     MOCK_METHOD0(enable, bool());
     MOCK_METHOD0(disable, bool());
+    MOCK_METHOD1(prefetchLocale, bool(const std::string& locale));
+    MOCK_METHOD1(changeLocale, bool(const std::string& locale));
     MOCK_METHOD1(
         addKeyWordObserver,
         void(std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::KeyWordObserverInterface> keyWordObserver));
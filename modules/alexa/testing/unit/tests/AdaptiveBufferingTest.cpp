@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/Alexa/AdaptiveBuffering.h>
+
+using aace::engine::alexa::AdaptiveBuffering;
+using std::chrono::milliseconds;
+
+class AdaptiveBufferingTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_config.minPrebuffer = milliseconds(500);
+        m_config.maxPrebuffer = milliseconds(5000);
+        m_config.smoothing = 0.5;
+        m_buffering = AdaptiveBuffering::create(m_config);
+        ASSERT_NE(m_buffering, nullptr);
+        m_now = AdaptiveBuffering::Clock::now();
+    }
+
+    /// Plays a channel with underruns of a duration
+    void play(const std::string& channel, int underruns, milliseconds duration) {
+        m_buffering->onPlaybackStarted(channel, m_now);
+        for (int j = 0; j < underruns; j++) {
+            m_now += milliseconds(1000);
+            m_buffering->onBufferUnderrun(channel, m_now);
+            m_now += duration;
+            m_buffering->onBufferRefilled(channel, m_now);
+        }
+        m_now += milliseconds(1000);
+        m_buffering->onPlaybackEnded(channel, m_now);
+    }
+
+protected:
+    AdaptiveBuffering::Config m_config;
+    std::shared_ptr<AdaptiveBuffering> m_buffering;
+    AdaptiveBuffering::Clock::time_point m_now;
+};
+
+TEST_F(AdaptiveBufferingTest, rejectsInvalidConfiguration) {
+    auto config = m_config;
+    config.maxPrebuffer = milliseconds(100);
+    EXPECT_EQ(AdaptiveBuffering::create(config), nullptr);
+
+    config = m_config;
+    config.smoothing = 0;
+    EXPECT_EQ(AdaptiveBuffering::create(config), nullptr);
+}
+
+TEST_F(AdaptiveBufferingTest, targetFollowsUnderruns) {
+    EXPECT_EQ(m_buffering->getPrebufferTarget("AudioPlayer"), milliseconds(500));
+
+    // a playback without underruns keeps the minimum prebuffer
+    play("AudioPlayer", 0, milliseconds(0));
+    EXPECT_EQ(m_buffering->getPrebufferTarget("AudioPlayer"), milliseconds(500));
+
+    // 2 underruns of 1s, averaged with the previous playback
+    play("AudioPlayer", 2, milliseconds(1000));
+    EXPECT_EQ(m_buffering->getPrebufferTarget("AudioPlayer"), milliseconds(1500));
+
+    // the other channels are not affected
+    EXPECT_EQ(m_buffering->getPrebufferTarget("SpeechSynthesizer"), milliseconds(500));
+
+    // the target is capped, and returns to the minimum when the playbacks no longer stall
+    play("AudioPlayer", 10, milliseconds(3000));
+    EXPECT_EQ(m_buffering->getPrebufferTarget("AudioPlayer"), milliseconds(5000));
+    for (int j = 0; j < 20; j++) {
+        play("AudioPlayer", 0, milliseconds(0));
+    }
+    EXPECT_EQ(m_buffering->getPrebufferTarget("AudioPlayer"), milliseconds(500));
+}
+
+TEST_F(AdaptiveBufferingTest, targetIsTrackedByNetworkType) {
+    m_buffering->setNetworkType("wwan0");
+    play("AudioPlayer", 2, milliseconds(2000));
+    EXPECT_EQ(m_buffering->getPrebufferTarget("AudioPlayer"), milliseconds(2500));
+
+    m_buffering->setNetworkType("wlan0");
+    EXPECT_EQ(m_buffering->getPrebufferTarget("AudioPlayer"), milliseconds(500));
+
+    m_buffering->setNetworkType("wwan0");
+    EXPECT_EQ(m_buffering->getPrebufferTarget("AudioPlayer"), milliseconds(2500));
+}
+
+TEST_F(AdaptiveBufferingTest, underrunRunningAtPlaybackEndIsCounted) {
+    m_buffering->onPlaybackStarted("AudioPlayer", m_now);
+    m_buffering->onBufferUnderrun("AudioPlayer", m_now + milliseconds(1000));
+    // a repeated underrun notification doesn't start another underrun
+    m_buffering->onBufferUnderrun("AudioPlayer", m_now + milliseconds(2000));
+    m_buffering->onPlaybackEnded("AudioPlayer", m_now + milliseconds(3000));
+
+    // 1 underrun of 2s, with a weight of 0.5
+    EXPECT_EQ(m_buffering->getPrebufferTarget("AudioPlayer"), milliseconds(1500));
+}
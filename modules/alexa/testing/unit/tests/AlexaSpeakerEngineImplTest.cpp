@@ -0,0 +1,132 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <AVSCommon/SDKInterfaces/test/MockSpeakerManager.h>
+
+#include <AACE/Engine/Alexa/AlexaSpeakerEngineImpl.h>
+
+using namespace ::testing;
+using AvsSpeakerType = alexaClientSDK::avsCommon::sdkInterfaces::ChannelVolumeInterface::Type;
+using SpeakerSettings = alexaClientSDK::avsCommon::sdkInterfaces::SpeakerInterface::SpeakerSettings;
+using Source = alexaClientSDK::avsCommon::sdkInterfaces::SpeakerManagerObserverInterface::Source;
+
+/// The platform interface, which records the reported changes
+class TestAlexaSpeaker : public aace::alexa::AlexaSpeaker {
+public:
+    MOCK_METHOD4(speakerSettingsChanged, void(SpeakerType type, bool local, int8_t volume, bool mute));
+};
+
+/// Returns a future with a value
+static std::future<bool> makeFuture(bool value) {
+    std::promise<bool> promise;
+    promise.set_value(value);
+    return promise.get_future();
+}
+
+class AlexaSpeakerEngineImplTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_speakerManager = std::make_shared<alexaClientSDK::avsCommon::sdkInterfaces::test::MockSpeakerManager>();
+        m_alexaSpeaker = std::make_shared<TestAlexaSpeaker>();
+
+        ON_CALL(*m_speakerManager, setVolume(_, _, _, _)).WillByDefault(InvokeWithoutArgs([]() {
+            return makeFuture(true);
+        }));
+        ON_CALL(*m_speakerManager, adjustVolume(_, _, _, _)).WillByDefault(InvokeWithoutArgs([]() {
+            return makeFuture(true);
+        }));
+        ON_CALL(*m_speakerManager, getSpeakerSettings(_, _))
+            .WillByDefault(Invoke([](AvsSpeakerType, SpeakerSettings* settings) {
+                settings->volume = 42;
+                settings->mute = false;
+                return makeFuture(true);
+            }));
+    }
+
+    void TearDown() override {
+        if (m_alexaSpeakerEngineImpl != nullptr) {
+            m_alexaSpeakerEngineImpl->shutdown();
+        }
+    }
+
+protected:
+    void createAlexaSpeakerEngineImpl(std::chrono::milliseconds volumeReportDelay) {
+        EXPECT_CALL(*m_speakerManager, addSpeakerManagerObserver(_));
+        EXPECT_CALL(*m_speakerManager, removeSpeakerManagerObserver(_));
+        m_alexaSpeakerEngineImpl = aace::engine::alexa::AlexaSpeakerEngineImpl::create(
+            m_alexaSpeaker, m_speakerManager, volumeReportDelay);
+        ASSERT_NE(m_alexaSpeakerEngineImpl, nullptr);
+    }
+
+    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::test::MockSpeakerManager> m_speakerManager;
+    std::shared_ptr<TestAlexaSpeaker> m_alexaSpeaker;
+    std::shared_ptr<aace::engine::alexa::AlexaSpeakerEngineImpl> m_alexaSpeakerEngineImpl;
+};
+
+TEST_F(AlexaSpeakerEngineImplTest, reportsEachChangeWithoutDelay) {
+    createAlexaSpeakerEngineImpl(std::chrono::milliseconds::zero());
+
+    EXPECT_CALL(*m_speakerManager, setVolume(AvsSpeakerType::AVS_SPEAKER_VOLUME, 30, false, Source::LOCAL_API));
+    EXPECT_CALL(*m_speakerManager, adjustVolume(AvsSpeakerType::AVS_SPEAKER_VOLUME, 5, false, Source::LOCAL_API));
+    m_alexaSpeaker->localSetVolume(aace::alexa::AlexaSpeaker::SpeakerType::ALEXA_VOLUME, 30);
+    m_alexaSpeaker->localAdjustVolume(aace::alexa::AlexaSpeaker::SpeakerType::ALEXA_VOLUME, 5);
+}
+
+TEST_F(AlexaSpeakerEngineImplTest, reportsSettledVolumeOnce) {
+    createAlexaSpeakerEngineImpl(std::chrono::milliseconds(100));
+
+    // each step is applied without notifications
+    EXPECT_CALL(*m_speakerManager, setVolume(AvsSpeakerType::AVS_SPEAKER_VOLUME, 30, true, Source::LOCAL_API));
+    EXPECT_CALL(*m_speakerManager, adjustVolume(AvsSpeakerType::AVS_SPEAKER_VOLUME, 4, true, Source::LOCAL_API))
+        .Times(3);
+    std::promise<void> reported;
+    EXPECT_CALL(*m_speakerManager, setVolume(AvsSpeakerType::AVS_SPEAKER_VOLUME, 42, false, Source::LOCAL_API))
+        .WillOnce(InvokeWithoutArgs([&reported]() {
+            reported.set_value();
+            return makeFuture(true);
+        }));
+
+    m_alexaSpeaker->localSetVolume(aace::alexa::AlexaSpeaker::SpeakerType::ALEXA_VOLUME, 30);
+    for (int i = 0; i < 3; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        m_alexaSpeaker->localAdjustVolume(aace::alexa::AlexaSpeaker::SpeakerType::ALEXA_VOLUME, 4);
+    }
+    EXPECT_EQ(reported.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+}
+
+TEST_F(AlexaSpeakerEngineImplTest, reportsPendingVolumeAtShutdown) {
+    createAlexaSpeakerEngineImpl(std::chrono::seconds(10));
+
+    EXPECT_CALL(*m_speakerManager, setVolume(AvsSpeakerType::AVS_ALERTS_VOLUME, 60, true, Source::LOCAL_API));
+    EXPECT_CALL(*m_speakerManager, setVolume(AvsSpeakerType::AVS_ALERTS_VOLUME, 42, false, Source::LOCAL_API));
+    m_alexaSpeaker->localSetVolume(aace::alexa::AlexaSpeaker::SpeakerType::ALERTS_VOLUME, 60);
+
+    m_alexaSpeakerEngineImpl->shutdown();
+    m_alexaSpeakerEngineImpl.reset();
+}
+
+TEST_F(AlexaSpeakerEngineImplTest, rejectsNegativeDelay) {
+    EXPECT_CALL(*m_speakerManager, addSpeakerManagerObserver(_)).Times(0);
+    EXPECT_EQ(
+        aace::engine::alexa::AlexaSpeakerEngineImpl::create(
+            m_alexaSpeaker, m_speakerManager, std::chrono::milliseconds(-1)),
+        nullptr);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include <AACE/Engine/Alexa/AudioChannelTrace.h>
+#include <AACE/Engine/Utils/JSON/JSON.h>
+
+using aace::engine::alexa::AudioChannelTrace;
+using std::chrono::milliseconds;
+
+namespace json = aace::engine::utils::json;
+
+/// Collects the events of the trace stream
+class TestListener : public AudioChannelTrace::Listener {
+public:
+    void onTraceEvent(const AudioChannelTrace::Event& event) override {
+        events.push_back(event);
+    }
+
+    std::vector<AudioChannelTrace::Event> events;
+};
+
+class AudioChannelTraceTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        AudioChannelTrace::stop();
+    }
+};
+
+TEST_F(AudioChannelTraceTest, measuresTransitionLatencies) {
+    AudioChannelTrace trace("AudioPlayer");
+    auto start = AudioChannelTrace::Clock::now();
+    EXPECT_LT(trace.getLastLatency(AudioChannelTrace::Transition::STARTED).count(), 0);
+
+    trace.recordCall(AudioChannelTrace::Call::PREPARE, start, start + milliseconds(5));
+    trace.recordCall(AudioChannelTrace::Call::PLAY, start + milliseconds(10), start + milliseconds(12));
+    trace.recordTransition(AudioChannelTrace::Transition::STARTED, start + milliseconds(150));
+    EXPECT_EQ(trace.getLastLatency(AudioChannelTrace::Transition::STARTED), milliseconds(150));
+
+    trace.recordCall(AudioChannelTrace::Call::PAUSE, start + milliseconds(1000), start + milliseconds(1001));
+    trace.recordCall(AudioChannelTrace::Call::RESUME, start + milliseconds(4000), start + milliseconds(4001));
+    trace.recordTransition(AudioChannelTrace::Transition::RESUMED, start + milliseconds(4300));
+    EXPECT_EQ(trace.getLastLatency(AudioChannelTrace::Transition::RESUMED), milliseconds(3300));
+
+    trace.recordCall(AudioChannelTrace::Call::STOP, start + milliseconds(5000), start + milliseconds(5002));
+    trace.recordTransition(AudioChannelTrace::Transition::STOPPED, start + milliseconds(5040));
+    EXPECT_EQ(trace.getLastLatency(AudioChannelTrace::Transition::STOPPED), milliseconds(40));
+
+    // a resume without a pause of the channel is not measured
+    trace.recordTransition(AudioChannelTrace::Transition::RESUMED, start + milliseconds(9000));
+    EXPECT_EQ(trace.getLastLatency(AudioChannelTrace::Transition::RESUMED), milliseconds(3300));
+}
+
+TEST_F(AudioChannelTraceTest, recordsOnlyWhileRecording) {
+    AudioChannelTrace trace("SpeechSynthesizer");
+    auto listener = std::make_shared<TestListener>();
+    AudioChannelTrace::addListener(listener);
+
+    auto start = AudioChannelTrace::Clock::now();
+    trace.recordReport("onMediaStateChanged", "PLAYING", start);
+    EXPECT_TRUE(listener->events.empty());
+
+    AudioChannelTrace::start();
+    EXPECT_TRUE(AudioChannelTrace::isRecording());
+    trace.recordCall(AudioChannelTrace::Call::PLAY, start, start + milliseconds(3));
+    trace.recordReport("onMediaStateChanged", "PLAYING", start + milliseconds(20));
+    AudioChannelTrace::stop();
+    trace.recordReport("onMediaStateChanged", "STOPPED", start + milliseconds(40));
+
+    ASSERT_EQ(listener->events.size(), 2u);
+    EXPECT_EQ(listener->events[0].channel, "SpeechSynthesizer");
+    EXPECT_EQ(listener->events[0].name, "play");
+    EXPECT_EQ(listener->events[0].duration, milliseconds(3));
+    EXPECT_EQ(listener->events[1].detail, "PLAYING");
+    EXPECT_EQ(AudioChannelTrace::getEvents().size(), 2u);
+
+    AudioChannelTrace::removeListener(listener);
+    AudioChannelTrace::start();
+    trace.recordReport("onMediaStateChanged", "PLAYING", start);
+    EXPECT_EQ(listener->events.size(), 2u);
+    EXPECT_EQ(AudioChannelTrace::getEvents().size(), 1u);
+}
+
+TEST_F(AudioChannelTraceTest, exportsTrackForEachChannel) {
+    AudioChannelTrace::start();
+    AudioChannelTrace media("AudioPlayer");
+    AudioChannelTrace speech("SpeechSynthesizer");
+    auto start = AudioChannelTrace::Clock::now();
+    media.recordCall(AudioChannelTrace::Call::PAUSE, start, start + milliseconds(2));
+    speech.recordReport("onMediaStateChanged", "PLAYING", start + milliseconds(5));
+    media.recordReport("onMediaStateChanged", "STOPPED", start + milliseconds(6));
+
+    auto trace = json::Value::parse(AudioChannelTrace::toJson());
+    auto& events = trace["traceEvents"];
+    std::map<std::string, int> tracks;
+    size_t durations = 0;
+    size_t instants = 0;
+    for (auto& event : events) {
+        if (event["name"] == "thread_name") {
+            tracks[event["args"]["name"]] = event["tid"];
+        } else if (event["ph"] == "X") {
+            durations++;
+            EXPECT_EQ(event["dur"], 2000);
+        } else if (event["ph"] == "i") {
+            instants++;
+        }
+    }
+    EXPECT_EQ(tracks.size(), 2u);
+    EXPECT_NE(tracks["AudioPlayer"], tracks["SpeechSynthesizer"]);
+    EXPECT_EQ(durations, 1u);
+    EXPECT_EQ(instants, 2u);
+}
@@ -13,6 +13,9 @@
  * permissions and limitations under the License.
  */
 
+#include <chrono>
+#include <thread>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -74,13 +77,26 @@ public:
     }
 
 protected:
-    std::shared_ptr<aace::engine::alexa::AuthorizationManager> createAuthorizationManager() {
+    std::shared_ptr<aace::engine::alexa::AuthorizationManager> createAuthorizationManager(
+        const AuthorizationManager::TokenCacheConfiguration& tokenCacheConfiguration =
+            AuthorizationManager::TokenCacheConfiguration()) {
         auto authorizationManagerStorage = AuthorizationManagerStorage::create(m_miscStorage);
-        auto authorizationManager = AuthorizationManager::create(authorizationManagerStorage);
+        auto authorizationManager = AuthorizationManager::create(authorizationManagerStorage, tokenCacheConfiguration);
         authorizationManager->setRegistrationManager(m_registrationManager);
         return authorizationManager;
     }
 
+    /// Registers and authorizes an adapter for the "test" service
+    void authorize(
+        std::shared_ptr<AuthorizationManager> authorizationManager,
+        std::shared_ptr<AuthorizationAdapterInterface> adapter) {
+        authorizationManager->registerAuthorizationAdapter("test", adapter);
+        auto startAuthorizationResult = authorizationManager->startAuthorization("test");
+        ASSERT_EQ(startAuthorizationResult, AuthorizationManager::StartAuthorizationResult::AUTHORIZE);
+        authorizationManager->authStateChanged(
+            "test", AuthorizationManagerInterface::State::REFRESHED, AuthorizationManagerInterface::Error::SUCCESS);
+    }
+
 protected:
     /// Factory for getting the mocked components
     std::shared_ptr<AlexaMockComponentFactory> m_alexaMockFactory;
@@ -343,3 +359,66 @@ TEST_F(AuthorizationManagerTest, test_verifyRegisteringDuplicatesOverwritesPrevi
     auto logoutResult = authorizationManager->logout("test");
     ASSERT_EQ(logoutResult, true) << "StartAuthorizationResult expected to be true";
 }
+
+TEST_F(AuthorizationManagerTest, test_authTokenIsCachedUntilTheAuthStateChanges) {
+    auto authorizationManager = createAuthorizationManager();
+    ASSERT_NE(authorizationManager, nullptr) << "AuthorizationManager pointer expected to be not null";
+
+    auto adapter = std::make_shared<StrictMock<MockAuthorizationAdapterInterface>>();
+    authorize(authorizationManager, adapter);
+
+    EXPECT_CALL(*adapter, getAuthToken()).WillOnce(Return("TestAuthToken1")).WillOnce(Return("TestAuthToken2"));
+    EXPECT_EQ(authorizationManager->getAuthToken(), "TestAuthToken1") << "Auth token not as expected";
+    EXPECT_EQ(authorizationManager->getAuthToken(), "TestAuthToken1") << "Cached auth token not as expected";
+
+    // The adapter may have a new token once the auth state changes
+    authorizationManager->authStateChanged(
+        "test", AuthorizationManagerInterface::State::REFRESHED, AuthorizationManagerInterface::Error::SUCCESS);
+    EXPECT_EQ(authorizationManager->getAuthToken(), "TestAuthToken2") << "Auth token not as expected";
+
+    EXPECT_CALL(*adapter, deregister()).Times(1);
+    ASSERT_TRUE(authorizationManager->logout("test"));
+}
+
+TEST_F(AuthorizationManagerTest, test_authTokenRejectedIsFetchedAgain) {
+    auto authorizationManager = createAuthorizationManager();
+    ASSERT_NE(authorizationManager, nullptr) << "AuthorizationManager pointer expected to be not null";
+
+    auto adapter = std::make_shared<StrictMock<MockAuthorizationAdapterInterface>>();
+    authorize(authorizationManager, adapter);
+
+    EXPECT_CALL(*adapter, getAuthToken()).WillOnce(Return("TestAuthToken1")).WillOnce(Return("TestAuthToken2"));
+    EXPECT_EQ(authorizationManager->getAuthToken(), "TestAuthToken1") << "Auth token not as expected";
+
+    EXPECT_CALL(*adapter, onAuthFailure("TestAuthToken1")).Times(1);
+    authorizationManager->onAuthFailure("TestAuthToken1");
+    EXPECT_EQ(authorizationManager->getAuthToken(), "TestAuthToken2") << "Auth token not as expected";
+
+    EXPECT_CALL(*adapter, deregister()).Times(1);
+    ASSERT_TRUE(authorizationManager->logout("test"));
+}
+
+TEST_F(AuthorizationManagerTest, test_authTokenIsRefreshedInTheBackground) {
+    AuthorizationManager::TokenCacheConfiguration tokenCacheConfiguration;
+    tokenCacheConfiguration.refreshAfter = std::chrono::milliseconds::zero();
+    tokenCacheConfiguration.maxAge = std::chrono::minutes(1);
+    auto authorizationManager = createAuthorizationManager(tokenCacheConfiguration);
+    ASSERT_NE(authorizationManager, nullptr) << "AuthorizationManager pointer expected to be not null";
+
+    auto adapter = std::make_shared<NiceMock<MockAuthorizationAdapterInterface>>();
+    authorize(authorizationManager, adapter);
+
+    EXPECT_CALL(*adapter, getAuthToken()).WillOnce(Return("TestAuthToken1")).WillRepeatedly(Return("TestAuthToken2"));
+    EXPECT_EQ(authorizationManager->getAuthToken(), "TestAuthToken1") << "Auth token not as expected";
+
+    // The cached token is returned while the next one is fetched in the background
+    EXPECT_EQ(authorizationManager->getAuthToken(), "TestAuthToken1") << "Cached auth token not as expected";
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (authorizationManager->getAuthToken() != "TestAuthToken2" && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(authorizationManager->getAuthToken(), "TestAuthToken2") << "Refreshed auth token not as expected";
+
+    ASSERT_TRUE(authorizationManager->logout("test"));
+    authorizationManager->shutdown();
+}
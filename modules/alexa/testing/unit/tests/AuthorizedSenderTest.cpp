@@ -0,0 +1,122 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/Alexa/AuthorizedSender.h>
+#include <AVSCommon/SDKInterfaces/test/MockMessageSender.h>
+
+using namespace ::testing;
+using aace::engine::alexa::AuthorizedSender;
+using alexaClientSDK::avsCommon::avs::MessageRequest;
+using alexaClientSDK::avsCommon::sdkInterfaces::test::MockMessageSender;
+
+/// The time to wait for the messages to be sent
+static const std::chrono::seconds TIMEOUT(2);
+
+/// Returns the JSON of an event of a player.
+static std::string createEvent(const std::string& playerId, const std::string& eventName) {
+    return R"({"event":{"header":{"namespace":"ExternalMediaPlayer","name":"PlayerEvent"},)"
+           R"("payload":{"playerId":")" +
+           playerId + R"(","eventName":")" + eventName + R"("}}})";
+}
+
+class AuthorizedSenderTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_mockMessageSender = std::make_shared<StrictMock<MockMessageSender>>();
+        ON_CALL(*m_mockMessageSender, sendMessage(_))
+            .WillByDefault(Invoke([this](std::shared_ptr<MessageRequest> request) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_sentMessages.push_back(request->getJsonContent());
+                if (m_sentMessages.size() == m_expectedCount) {
+                    m_sentPromise.set_value();
+                }
+            }));
+    }
+
+    void TearDown() override {
+        m_mockMessageSender.reset();
+    }
+
+protected:
+    /// Returns a future ready once a number of messages are sent to the mock message sender.
+    std::future<void> expectSentMessages(size_t count) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_expectedCount = count;
+        return m_sentPromise.get_future();
+    }
+
+    std::shared_ptr<StrictMock<MockMessageSender>> m_mockMessageSender;
+    std::mutex m_mutex;
+    std::vector<std::string> m_sentMessages;
+    size_t m_expectedCount = 0;
+    std::promise<void> m_sentPromise;
+};
+
+/**
+ * @test createWithInvalidParameters
+ */
+TEST_F(AuthorizedSenderTest, test_createWithInvalidParameters) {
+    EXPECT_EQ(nullptr, AuthorizedSender::create(nullptr));
+    EXPECT_EQ(nullptr, AuthorizedSender::create(m_mockMessageSender, std::chrono::milliseconds(-1)));
+}
+
+/**
+ * @test sendTaggedAndUntaggedMessages
+ */
+TEST_F(AuthorizedSenderTest, test_sendTaggedAndUntaggedMessages) {
+    auto authorizedSender = AuthorizedSender::create(m_mockMessageSender);
+    ASSERT_NE(nullptr, authorizedSender);
+    authorizedSender->updateAuthorizedPlayers({"player1"});
+
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).Times(2);
+    auto sent = expectSentMessages(2);
+    authorizedSender->sendMessage(std::make_shared<MessageRequest>(createEvent("player1", "PlaybackStarted")));
+    // an event tagged with an unauthorized player is not sent
+    authorizedSender->sendMessage(std::make_shared<AuthorizedSender::PlayerMessageRequest>(
+        "player2", createEvent("player2", "PlaybackStarted")));
+    // the tag of an event is not checked against its JSON
+    authorizedSender->sendMessage(std::make_shared<AuthorizedSender::PlayerMessageRequest>("player1", "{}"));
+    ASSERT_EQ(std::future_status::ready, sent.wait_for(TIMEOUT));
+    EXPECT_EQ(std::vector<std::string>({createEvent("player1", "PlaybackStarted"), "{}"}), m_sentMessages);
+}
+
+/**
+ * @test sendMessagesInBatch
+ */
+TEST_F(AuthorizedSenderTest, test_sendMessagesInBatch) {
+    auto authorizedSender = AuthorizedSender::create(m_mockMessageSender, std::chrono::milliseconds(50));
+    ASSERT_NE(nullptr, authorizedSender);
+    authorizedSender->updateAuthorizedPlayers({"player1"});
+
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).Times(3);
+    auto sent = expectSentMessages(3);
+    std::vector<std::string> events;
+    for (auto& eventName : {"PlaybackStarted", "PlaybackPaused", "PlaybackResumed"}) {
+        events.push_back(createEvent("player1", eventName));
+        authorizedSender->sendMessage(
+            std::make_shared<AuthorizedSender::PlayerMessageRequest>("player1", events.back()));
+    }
+    ASSERT_EQ(std::future_status::ready, sent.wait_for(TIMEOUT));
+    EXPECT_EQ(events, m_sentMessages);
+}
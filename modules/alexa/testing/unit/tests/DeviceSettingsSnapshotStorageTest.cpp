@@ -0,0 +1,145 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <Settings/SettingStatus.h>
+#include <SQLiteStorage/SQLiteDatabase.h>
+
+#include <AACE/Engine/Alexa/DeviceSettingsSnapshotStorage.h>
+
+using aace::engine::alexa::DeviceSettingsSnapshotStorage;
+using alexaClientSDK::settings::SettingStatus;
+using alexaClientSDK::settings::storage::DeviceSettingStorageInterface;
+using ::testing::Return;
+
+class MockDeviceSettingStorage : public DeviceSettingStorageInterface {
+public:
+    MOCK_METHOD0(open, bool());
+    MOCK_METHOD0(close, void());
+    MOCK_METHOD3(storeSetting, bool(const std::string&, const std::string&, SettingStatus));
+    MOCK_METHOD1(storeSettings, bool(const std::vector<std::tuple<std::string, std::string, SettingStatus>>&));
+    MOCK_METHOD1(loadSetting, SettingStatusAndValue(const std::string&));
+    MOCK_METHOD1(deleteSetting, bool(const std::string&));
+    MOCK_METHOD2(updateSettingStatus, bool(const std::string&, SettingStatus));
+};
+
+class DeviceSettingsSnapshotStorageTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char path[] = "/tmp/aace-device-settings-XXXXXX";
+        ASSERT_NE(mkdtemp(path), nullptr);
+        m_directory = path;
+        m_databaseFilePath = m_directory + "/deviceSettings.db";
+        m_mockStorage = std::make_shared<::testing::StrictMock<MockDeviceSettingStorage>>();
+    }
+
+    void TearDown() override {
+        unlink(m_databaseFilePath.c_str());
+        rmdir(m_directory.c_str());
+    }
+
+    /// Creates the database of the device settings, with the table of @c SQLiteDeviceSettingStorage
+    void createDatabase(const std::vector<std::string>& rows) {
+        alexaClientSDK::storage::sqliteStorage::SQLiteDatabase database(m_databaseFilePath);
+        ASSERT_TRUE(database.initialize());
+        ASSERT_TRUE(database.performQuery(
+            "CREATE TABLE deviceSettings (key TEXT PRIMARY KEY NOT NULL, value TEXT NOT NULL, status TEXT NOT NULL);"));
+        for (auto& row : rows) {
+            ASSERT_TRUE(database.performQuery("INSERT INTO deviceSettings (key, value, status) VALUES " + row + ";"));
+        }
+        database.close();
+    }
+
+    std::string m_directory;
+    std::string m_databaseFilePath;
+    std::shared_ptr<::testing::StrictMock<MockDeviceSettingStorage>> m_mockStorage;
+};
+
+TEST_F(DeviceSettingsSnapshotStorageTest, rejectsInvalidArguments) {
+    EXPECT_EQ(DeviceSettingsSnapshotStorage::create(nullptr, m_databaseFilePath), nullptr);
+    EXPECT_EQ(DeviceSettingsSnapshotStorage::create(m_mockStorage, ""), nullptr);
+}
+
+TEST_F(DeviceSettingsSnapshotStorageTest, loadsTheSettingsFromTheSnapshot) {
+    createDatabase({"('System.locales', '[\"en-US\"]', 'SYNCHRONIZED')",
+                    "('System.timeZone', '\"America/Vancouver\"', 'LOCAL_CHANGE_IN_PROGRESS')"});
+    auto storage = DeviceSettingsSnapshotStorage::create(m_mockStorage, m_databaseFilePath);
+    ASSERT_NE(storage, nullptr);
+
+    EXPECT_CALL(*m_mockStorage, open()).WillOnce(Return(true));
+    ASSERT_TRUE(storage->open());
+    EXPECT_EQ(storage->getSnapshotSize(), 2u);
+
+    // the settings are not read from the wrapped storage
+    EXPECT_EQ(
+        storage->loadSetting("System.locales"),
+        std::make_pair(SettingStatus::SYNCHRONIZED, std::string("[\"en-US\"]")));
+    EXPECT_EQ(
+        storage->loadSetting("System.timeZone"),
+        std::make_pair(SettingStatus::LOCAL_CHANGE_IN_PROGRESS, std::string("\"America/Vancouver\"")));
+    EXPECT_EQ(storage->loadSetting("unknown"), std::make_pair(SettingStatus::NOT_AVAILABLE, std::string()));
+}
+
+TEST_F(DeviceSettingsSnapshotStorageTest, writesTheChangesThrough) {
+    createDatabase({"('System.timeZone', '\"Etc/GMT\"', 'SYNCHRONIZED')"});
+    auto storage = DeviceSettingsSnapshotStorage::create(m_mockStorage, m_databaseFilePath);
+    ASSERT_NE(storage, nullptr);
+    EXPECT_CALL(*m_mockStorage, open()).WillOnce(Return(true));
+    ASSERT_TRUE(storage->open());
+
+    EXPECT_CALL(*m_mockStorage, storeSetting("System.timeZone", "\"Europe/Paris\"", SettingStatus::SYNCHRONIZED))
+        .WillOnce(Return(true));
+    ASSERT_TRUE(storage->storeSetting("System.timeZone", "\"Europe/Paris\"", SettingStatus::SYNCHRONIZED));
+    EXPECT_EQ(
+        storage->loadSetting("System.timeZone"),
+        std::make_pair(SettingStatus::SYNCHRONIZED, std::string("\"Europe/Paris\"")));
+
+    EXPECT_CALL(*m_mockStorage, updateSettingStatus("System.timeZone", SettingStatus::AVS_CHANGE_IN_PROGRESS))
+        .WillOnce(Return(true));
+    ASSERT_TRUE(storage->updateSettingStatus("System.timeZone", SettingStatus::AVS_CHANGE_IN_PROGRESS));
+    EXPECT_EQ(storage->loadSetting("System.timeZone").first, SettingStatus::AVS_CHANGE_IN_PROGRESS);
+
+    // a change which the database rejects is not applied to the snapshot
+    EXPECT_CALL(*m_mockStorage, deleteSetting("System.timeZone")).WillOnce(Return(false));
+    EXPECT_FALSE(storage->deleteSetting("System.timeZone"));
+    EXPECT_EQ(storage->getSnapshotSize(), 1u);
+
+    EXPECT_CALL(*m_mockStorage, deleteSetting("System.timeZone")).WillOnce(Return(true));
+    ASSERT_TRUE(storage->deleteSetting("System.timeZone"));
+    EXPECT_EQ(storage->loadSetting("System.timeZone"), std::make_pair(SettingStatus::NOT_AVAILABLE, std::string()));
+}
+
+TEST_F(DeviceSettingsSnapshotStorageTest, fallsBackToTheStorageWithoutSnapshot) {
+    // the database doesn't exist, so the snapshot can't be read
+    auto storage = DeviceSettingsSnapshotStorage::create(m_mockStorage, m_databaseFilePath);
+    ASSERT_NE(storage, nullptr);
+    EXPECT_CALL(*m_mockStorage, open()).WillOnce(Return(true));
+    ASSERT_TRUE(storage->open());
+    EXPECT_EQ(storage->getSnapshotSize(), 0u);
+
+    EXPECT_CALL(*m_mockStorage, loadSetting("System.locales"))
+        .WillOnce(Return(std::make_pair(SettingStatus::SYNCHRONIZED, std::string("[\"fr-FR\"]"))));
+    EXPECT_EQ(
+        storage->loadSetting("System.locales"),
+        std::make_pair(SettingStatus::SYNCHRONIZED, std::string("[\"fr-FR\"]")));
+
+    EXPECT_CALL(*m_mockStorage, close());
+    storage->close();
+}
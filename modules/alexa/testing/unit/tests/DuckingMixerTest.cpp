@@ -0,0 +1,151 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Alexa/DuckingMixer.h>
+
+using aace::engine::alexa::DuckingInterface;
+using aace::engine::alexa::DuckingMixer;
+
+/// Records the ducking calls of the channels in one shared log
+class TestChannel : public DuckingInterface {
+public:
+    TestChannel(const std::string& name, std::shared_ptr<std::vector<std::string>> log, std::mutex& mutex) :
+            m_name{name}, m_log{log}, m_mutex(mutex) {
+    }
+
+    bool startDucking() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_log->push_back(m_name + ".duck");
+        return true;
+    }
+
+    bool stopDucking() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_log->push_back(m_name + ".restore");
+        return true;
+    }
+
+private:
+    std::string m_name;
+    std::shared_ptr<std::vector<std::string>> m_log;
+    std::mutex& m_mutex;
+};
+
+class DuckingMixerTest : public ::testing::Test {
+protected:
+    std::shared_ptr<TestChannel> createChannel(const std::string& name) {
+        return std::make_shared<TestChannel>(name, m_log, m_mutex);
+    }
+
+    std::vector<std::string> getLog() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return *m_log;
+    }
+
+    std::mutex m_mutex;
+    std::shared_ptr<std::vector<std::string>> m_log = std::make_shared<std::vector<std::string>>();
+};
+
+TEST_F(DuckingMixerTest, appliesDuckingWithoutWaitingForTheRelease) {
+    auto mixer = DuckingMixer::create(std::chrono::seconds(10));
+    auto media = createChannel("media");
+
+    mixer->setDucked(media, true);
+    for (int j = 0; j < 100 && getLog().empty(); j++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(getLog(), std::vector<std::string>({"media.duck"}));
+    EXPECT_EQ(mixer->getPendingCount(), 0u);
+
+    // the restore waits for the release time
+    mixer->setDucked(media, false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(getLog().size(), 1u);
+    EXPECT_EQ(mixer->getPendingCount(), 1u);
+
+    mixer->flush();
+    EXPECT_EQ(getLog(), std::vector<std::string>({"media.duck", "media.restore"}));
+    EXPECT_EQ(mixer->getPendingCount(), 0u);
+    mixer->shutdown();
+}
+
+TEST_F(DuckingMixerTest, dropsRestoreFollowedByDucking) {
+    auto mixer = DuckingMixer::create(std::chrono::seconds(10));
+    auto media = createChannel("media");
+    mixer->setDucked(media, true);
+    mixer->flush();
+
+    // a prompt following another one keeps the media ducked
+    mixer->setDucked(media, false);
+    mixer->setDucked(media, true);
+    mixer->setDucked(media, false);
+    mixer->setDucked(media, true);
+    mixer->flush();
+    EXPECT_EQ(getLog(), std::vector<std::string>({"media.duck"}));
+    mixer->shutdown();
+}
+
+TEST_F(DuckingMixerTest, restoresAfterTheReleaseTime) {
+    auto mixer = DuckingMixer::create(std::chrono::milliseconds(20));
+    auto media = createChannel("media");
+    mixer->setDucked(media, true);
+    mixer->flush();
+
+    mixer->setDucked(media, false);
+    for (int j = 0; j < 100 && getLog().size() < 2; j++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(getLog(), std::vector<std::string>({"media.duck", "media.restore"}));
+    mixer->shutdown();
+}
+
+TEST_F(DuckingMixerTest, appliesDuckingBeforeRestoresInOneBatch) {
+    auto mixer = DuckingMixer::create(std::chrono::seconds(10));
+    auto media = createChannel("media");
+    auto alerts = createChannel("alerts");
+    mixer->setDucked(media, true);
+    mixer->flush();
+
+    mixer->setDucked(media, false);
+    mixer->setDucked(alerts, true);
+    mixer->flush();
+    EXPECT_EQ(getLog(), std::vector<std::string>({"media.duck", "alerts.duck", "media.restore"}));
+    mixer->shutdown();
+}
+
+TEST_F(DuckingMixerTest, ignoresDestroyedChannelsAndChangesAfterShutdown) {
+    auto mixer = DuckingMixer::create(std::chrono::seconds(10));
+    auto media = createChannel("media");
+    mixer->setDucked(media, true);
+    mixer->flush();
+    mixer->setDucked(media, false);
+    media.reset();
+    mixer->flush();
+    EXPECT_EQ(getLog(), std::vector<std::string>({"media.duck"}));
+
+    mixer->shutdown();
+    auto alerts = createChannel("alerts");
+    mixer->setDucked(alerts, true);
+    mixer->flush();
+    EXPECT_EQ(getLog().size(), 1u);
+    EXPECT_EQ(mixer->getPendingCount(), 0u);
+}
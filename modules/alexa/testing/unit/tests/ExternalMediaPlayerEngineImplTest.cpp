@@ -13,9 +13,12 @@
  * permissions and limitations under the License.
  */
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <istream>
 #include <memory>
+#include <thread>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -27,11 +30,26 @@
 #include "AACE/Test/Unit/Alexa/MockLocalMediaSource.h"
 #include "AACE/Test/Unit/AVS/MockEndpointCapabilitiesRegistrarInterface.h"
 #include "AACE/Test/Unit/AVS/MockPlaybackRouterInterface.h"
+#include "AACE/Test/Unit/Storage/InMemoryLocalStorage.h"
 #include "AACE/Engine/Alexa/ExternalMediaPlayerEngineImpl.h"
+#include "AACE/Engine/Storage/LocalStorageInterface.h"
 
 using namespace aace::test::unit::alexa;
 using namespace aace::test::unit::avs;
 
+using ConnectionStatusObserverInterface = alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface;
+using DiscoveredPlayerInfo = aace::alexa::ExternalMediaAdapter::DiscoveredPlayerInfo;
+using aace::test::unit::storage::InMemoryLocalStorage;
+
+static DiscoveredPlayerInfo createDiscoveredPlayer(const std::string& localPlayerId) {
+    DiscoveredPlayerInfo info;
+    info.localPlayerId = localPlayerId;
+    info.spiVersion = "1.0";
+    info.validationMethod = "SIGNING_CERTIFICATE";
+    info.validationData = {"certificate"};
+    return info;
+}
+
 // The main test
 
 class ExternalMediaPlayerEngineImplTest : public ::testing::Test {
@@ -50,7 +68,59 @@ public:
     }
 
 protected:
+    std::shared_ptr<aace::engine::alexa::ExternalMediaPlayerEngineImpl> createEngineImpl(
+        std::chrono::milliseconds discoveryReportWindow,
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage) {
+        auto mockEndpointCapabilitiesRegistrarInterface =
+            std::make_shared<MockEndpointCapabilitiesRegistrarInterface>();
+        EXPECT_CALL(
+            *mockEndpointCapabilitiesRegistrarInterface,
+            withCapability(
+                testing::Matcher<
+                    const std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::CapabilityConfigurationInterface>&>(
+                    testing::_),
+                testing::_))
+            .WillOnce(testing::ReturnRef(*mockEndpointCapabilitiesRegistrarInterface));
+        return aace::engine::alexa::ExternalMediaPlayerEngineImpl::create(
+            "Test",
+            mockEndpointCapabilitiesRegistrarInterface,
+            m_alexaMockFactory->getSpeakerManagerInterfaceMock(),
+            m_alexaMockFactory->getMessageSenderInterfaceMock(),
+            m_alexaMockFactory->getCertifiedSenderMock(),
+            m_alexaMockFactory->getFocusManagerInterfaceMock(),
+            m_alexaMockFactory->getContextManagerInterfaceMock(),
+            m_alexaMockFactory->getExceptionEncounteredSenderInterfaceMock(),
+            m_alexaMockFactory->getPlaybackRouterMock(),
+            std::make_shared<aace::engine::alexa::AudioPlayerObserverDelegate>(),
+            std::make_shared<MockExternalMediaAdapterRegistrationInterface>(),
+            false,
+            std::chrono::milliseconds::zero(),
+            discoveryReportWindow,
+            localStorage);
+    }
+
+    /// Counts the ReportDiscoveredPlayers events sent with the message sender
+    void countReportDiscoveredPlayersEvents() {
+        EXPECT_CALL(*m_alexaMockFactory->getMessageSenderInterfaceMock(), sendMessage(testing::_))
+            .WillRepeatedly(testing::Invoke(
+                [this](std::shared_ptr<alexaClientSDK::avsCommon::avs::MessageRequest> request) {
+                    if (request->getJsonContent().find("\"ReportDiscoveredPlayers\"") != std::string::npos) {
+                        m_reportEvents++;
+                    }
+                }));
+    }
+
+    static void connect(const std::shared_ptr<aace::engine::alexa::ExternalMediaPlayerEngineImpl>& empEngineImpl) {
+        empEngineImpl->onConnectionStatusChanged(
+            ConnectionStatusObserverInterface::Status::CONNECTED,
+            {ConnectionStatusObserverInterface::EngineConnectionStatus(
+                alexaClientSDK::avsCommon::sdkInterfaces::ENGINE_TYPE_ALEXA_VOICE_SERVICES,
+                ConnectionStatusObserverInterface::ChangedReason::SUCCESS,
+                ConnectionStatusObserverInterface::Status::CONNECTED)});
+    }
+
     std::shared_ptr<AlexaMockComponentFactory> m_alexaMockFactory;
+    std::atomic<int> m_reportEvents{0};
 };
 
 TEST_F(ExternalMediaPlayerEngineImplTest, getAdapterStatesAndShutdown) {
@@ -100,3 +170,114 @@ TEST_F(ExternalMediaPlayerEngineImplTest, getAdapterStatesAndShutdown) {
     empEngineImpl->shutdown();
     t1.join();
 }
+
+TEST_F(ExternalMediaPlayerEngineImplTest, reusesRefreshedLocalMediaSourceState) {
+    auto mockEndpointCapabilitiesRegistrarInterface = std::make_shared<MockEndpointCapabilitiesRegistrarInterface>();
+    EXPECT_CALL(
+        *mockEndpointCapabilitiesRegistrarInterface,
+        withCapability(
+            testing::Matcher<
+                const std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::CapabilityConfigurationInterface>&>(
+                testing::_),
+            testing::_))
+        .WillOnce(testing::ReturnRef(*mockEndpointCapabilitiesRegistrarInterface));
+    auto empEngineImpl = aace::engine::alexa::ExternalMediaPlayerEngineImpl::create(
+        "Test",
+        mockEndpointCapabilitiesRegistrarInterface,
+        m_alexaMockFactory->getSpeakerManagerInterfaceMock(),
+        m_alexaMockFactory->getMessageSenderInterfaceMock(),
+        m_alexaMockFactory->getCertifiedSenderMock(),
+        m_alexaMockFactory->getFocusManagerInterfaceMock(),
+        m_alexaMockFactory->getContextManagerInterfaceMock(),
+        m_alexaMockFactory->getExceptionEncounteredSenderInterfaceMock(),
+        m_alexaMockFactory->getPlaybackRouterMock(),
+        std::make_shared<aace::engine::alexa::AudioPlayerObserverDelegate>(),
+        std::make_shared<MockExternalMediaAdapterRegistrationInterface>(),
+        false);
+    ASSERT_NE(empEngineImpl, nullptr) << "ExternalMediaPlayerEngineImpl pointer expected to be not null!";
+
+    auto mockLMS = std::make_shared<MockLocalMediaSource>(aace::alexa::LocalMediaSource::Source::FM_RADIO);
+    std::atomic<int> getStateCalls{0};
+    EXPECT_CALL(*mockLMS, getState()).WillRepeatedly(testing::InvokeWithoutArgs([&getStateCalls]() {
+        getStateCalls++;
+        return aace::alexa::LocalMediaSource::LocalMediaSourceState();
+    }));
+    empEngineImpl->registerPlatformMediaAdapter(mockLMS);
+
+    // the first query calls the platform, and queues the first refresh
+    empEngineImpl->getAdapterStates(true);
+    for (int i = 0; i < 200 && getStateCalls < 2; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(getStateCalls, 2);
+
+    // the following queries return the refreshed state
+    for (int i = 0; i < 10; i++) {
+        empEngineImpl->getAdapterStates(true);
+    }
+    EXPECT_EQ(getStateCalls, 2);
+
+    empEngineImpl->shutdown();
+}
+
+TEST_F(ExternalMediaPlayerEngineImplTest, coalescesDiscoveredPlayerReports) {
+    countReportDiscoveredPlayersEvents();
+    auto empEngineImpl = createEngineImpl(std::chrono::milliseconds(200), nullptr);
+    ASSERT_NE(empEngineImpl, nullptr) << "ExternalMediaPlayerEngineImpl pointer expected to be not null!";
+    connect(empEngineImpl);
+
+    // the players reported one at a time within the window are reported in a single event
+    for (auto localPlayerId : {"player1", "player2", "player3"}) {
+        empEngineImpl->reportDiscoveredPlayers({createDiscoveredPlayer(localPlayerId)});
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(m_reportEvents, 0);
+    for (int i = 0; i < 100 && m_reportEvents == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(m_reportEvents, 1);
+
+    empEngineImpl->shutdown();
+}
+
+TEST_F(ExternalMediaPlayerEngineImplTest, restoresAuthorizationsOfUnchangedDiscoveredPlayers) {
+    countReportDiscoveredPlayersEvents();
+    auto localStorage = std::make_shared<InMemoryLocalStorage>();
+
+    // the players are reported and authorized in the first Engine run
+    auto empEngineImpl = createEngineImpl(std::chrono::milliseconds::zero(), localStorage);
+    ASSERT_NE(empEngineImpl, nullptr) << "ExternalMediaPlayerEngineImpl pointer expected to be not null!";
+    connect(empEngineImpl);
+    empEngineImpl->reportDiscoveredPlayers({createDiscoveredPlayer("player1"), createDiscoveredPlayer("player2")});
+    for (int i = 0; i < 100 && m_reportEvents == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(m_reportEvents, 1);
+    aace::engine::alexa::PlayerInfo player1("player1", "1.0", true), player2("player2", "1.0", false);
+    player1.playerId = "Player1";
+    player1.skillToken = "skillToken";
+    empEngineImpl->authorizeDiscoveredPlayers({player1, player2});
+    empEngineImpl->shutdown();
+
+    // the same players are not reported again in the next Engine run
+    empEngineImpl = createEngineImpl(std::chrono::milliseconds::zero(), localStorage);
+    ASSERT_NE(empEngineImpl, nullptr) << "ExternalMediaPlayerEngineImpl pointer expected to be not null!";
+    connect(empEngineImpl);
+    empEngineImpl->reportDiscoveredPlayers({createDiscoveredPlayer("player2"), createDiscoveredPlayer("player1")});
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(m_reportEvents, 1);
+    empEngineImpl->shutdown();
+
+    // a changed player set is reported
+    empEngineImpl = createEngineImpl(std::chrono::milliseconds::zero(), localStorage);
+    ASSERT_NE(empEngineImpl, nullptr) << "ExternalMediaPlayerEngineImpl pointer expected to be not null!";
+    connect(empEngineImpl);
+    empEngineImpl->reportDiscoveredPlayers({createDiscoveredPlayer("player1")});
+    for (int i = 0; i < 100 && m_reportEvents == 1; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(m_reportEvents, 2);
+    empEngineImpl->shutdown();
+}
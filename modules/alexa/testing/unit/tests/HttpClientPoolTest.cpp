@@ -0,0 +1,143 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <future>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/Alexa/HttpClientPool.h>
+
+using aace::engine::alexa::HttpClientPool;
+
+/// A URL nothing listens on, so the requests fail without leaving the device
+static const std::string TEST_URL = "http://127.0.0.1:1/test";
+static const std::chrono::seconds TEST_TIMEOUT = std::chrono::seconds(1);
+
+class HttpClientPoolTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_pool = HttpClientPool::getInstance();
+        m_pool->clear();
+    }
+
+    void TearDown() override {
+        m_pool->clear();
+    }
+
+protected:
+    std::shared_ptr<HttpClientPool> m_pool;
+};
+
+TEST_F(HttpClientPoolTest, sharesInstance) {
+    EXPECT_EQ(m_pool, HttpClientPool::getInstance());
+}
+
+TEST_F(HttpClientPoolTest, reusesClients) {
+    auto response = m_pool->doGet(TEST_URL, {}, TEST_TIMEOUT);
+    // the failed request has no response code, and still returns its client to the pool
+    EXPECT_EQ(response.code, 0);
+    EXPECT_EQ(m_pool->getIdleClientCount(), 1u);
+
+    // the next requests of the same method reuse the idle client
+    m_pool->doGet(TEST_URL, {}, TEST_TIMEOUT);
+    m_pool->doGet(TEST_URL, {}, TEST_TIMEOUT);
+    EXPECT_EQ(m_pool->getIdleClientCount(), 1u);
+
+    m_pool->doPost(TEST_URL, {}, std::string("{}"), TEST_TIMEOUT);
+    m_pool->doDelete(TEST_URL, {}, TEST_TIMEOUT);
+    EXPECT_EQ(m_pool->getIdleClientCount(), 3u);
+
+    m_pool->clear();
+    EXPECT_EQ(m_pool->getIdleClientCount(), 0u);
+}
+
+TEST_F(HttpClientPoolTest, boundsIdleClients) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 16; i++) {
+        threads.emplace_back([this]() { m_pool->doGet(TEST_URL, {}, TEST_TIMEOUT); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_GE(m_pool->getIdleClientCount(), 1u);
+    EXPECT_LE(m_pool->getIdleClientCount(), 4u);
+}
+
+TEST_F(HttpClientPoolTest, failsCancelledRequests) {
+    m_pool->setCancelled(true);
+    EXPECT_TRUE(m_pool->isCancelled());
+
+    // a cancelled request doesn't check out a client
+    EXPECT_EQ(m_pool->doGet(TEST_URL, {}, TEST_TIMEOUT).code, 0);
+    EXPECT_EQ(m_pool->doPost(TEST_URL, {}, std::string("{}"), TEST_TIMEOUT).code, 0);
+    EXPECT_EQ(m_pool->getIdleClientCount(), 0u);
+
+    m_pool->setCancelled(false);
+    m_pool->doGet(TEST_URL, {}, TEST_TIMEOUT);
+    EXPECT_EQ(m_pool->getIdleClientCount(), 1u);
+}
+
+TEST_F(HttpClientPoolTest, compressesAndInflatesBodies) {
+    std::string body;
+    for (int j = 0; j < 100; j++) {
+        body += "{\"name\":\"entry" + std::to_string(j) + "\"},";
+    }
+    for (auto encoding : {HttpClientPool::ContentEncoding::GZIP, HttpClientPool::ContentEncoding::DEFLATE}) {
+        std::string compressed;
+        ASSERT_TRUE(HttpClientPool::compressBody(body, encoding, compressed));
+        EXPECT_LT(compressed.size(), body.size());
+
+        std::string inflated;
+        ASSERT_TRUE(HttpClientPool::inflateBody(compressed, inflated));
+        EXPECT_EQ(inflated, body);
+
+        // a truncated body is not inflated
+        EXPECT_FALSE(HttpClientPool::inflateBody(compressed.substr(0, compressed.size() / 2), inflated));
+    }
+    std::string compressed;
+    EXPECT_FALSE(HttpClientPool::compressBody(body, HttpClientPool::ContentEncoding::IDENTITY, compressed));
+    std::string inflated;
+    EXPECT_FALSE(HttpClientPool::inflateBody(body, inflated));
+}
+
+TEST_F(HttpClientPoolTest, sendsEncodedRequests) {
+    std::string body(HttpClientPool::MIN_COMPRESSED_BODY_SIZE * 2, 'a');
+    EXPECT_EQ(m_pool->doPost(TEST_URL, {}, body, TEST_TIMEOUT, HttpClientPool::ContentEncoding::GZIP).code, 0);
+    EXPECT_EQ(m_pool->doPut(TEST_URL, {}, body, HttpClientPool::ContentEncoding::DEFLATE).code, 0);
+    EXPECT_EQ(m_pool->getIdleClientCount(), 2u);
+}
+
+TEST_F(HttpClientPoolTest, sendsAsyncRequests) {
+    std::promise<int> postCode;
+    std::promise<int> getCode;
+    ASSERT_TRUE(m_pool->doPostAsync(
+        TEST_URL, {}, {{"key", "value"}}, TEST_TIMEOUT, [&](const HttpClientPool::HTTPResponse& response) {
+            postCode.set_value(response.code);
+        }));
+    ASSERT_TRUE(m_pool->doGetAsync(TEST_URL, {}, TEST_TIMEOUT, [&](const HttpClientPool::HTTPResponse& response) {
+        getCode.set_value(response.code);
+    }));
+
+    // the failed requests call back with an empty response, on a request thread
+    auto postFuture = postCode.get_future();
+    auto getFuture = getCode.get_future();
+    ASSERT_EQ(postFuture.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_EQ(getFuture.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(postFuture.get(), 0);
+    EXPECT_EQ(getFuture.get(), 0);
+
+    EXPECT_FALSE(m_pool->submit(nullptr, [](const HttpClientPool::HTTPResponse& response) {}));
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
+
+#include <AACE/Engine/Alexa/LocaleAssetsManager.h>
+#include <AACE/Test/Unit/Alexa/AlexaTestHelper.h>
+#include <AACE/Test/Unit/Alexa/MockWakewordEngineAdapter.h>
+
+using namespace aace::test::unit::alexa;
+using aace::engine::alexa::LocaleAssetsManager;
+
+/// How long the tests wait for the prefetches
+static const std::chrono::seconds PREFETCH_TIMEOUT{5};
+
+class LocaleAssetsManagerTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        ASSERT_TRUE(alexaClientSDK::avsCommon::avs::initialization::AlexaClientSDKInit::initialize(
+            {AlexaTestHelper::getAVSConfig()}))
+            << "Initialize AVS Device SDK Failed!";
+        m_wakewordEngineAdapter = std::make_shared<testing::NiceMock<MockWakewordEngineAdapter>>();
+        ON_CALL(*m_wakewordEngineAdapter, prefetchLocale(testing::_))
+            .WillByDefault(testing::Invoke([this](const std::string& locale) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_prefetchedLocales.insert(locale);
+                m_prefetched.notify_all();
+                return true;
+            }));
+        m_localeAssetsManager = LocaleAssetsManager::create(true);
+        ASSERT_NE(m_localeAssetsManager, nullptr);
+    }
+
+    void TearDown() override {
+        if (m_localeAssetsManager != nullptr) {
+            m_localeAssetsManager->shutdown();
+        }
+        alexaClientSDK::avsCommon::avs::initialization::AlexaClientSDKInit::uninitialize();
+    }
+
+protected:
+    /// Waits until a number of locales are prefetched, and returns them
+    std::set<std::string> waitForPrefetchedLocales(size_t count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_prefetched.wait_for(lock, PREFETCH_TIMEOUT, [this, count]() { return m_prefetchedLocales.size() >= count; });
+        return m_prefetchedLocales;
+    }
+
+    std::shared_ptr<testing::NiceMock<MockWakewordEngineAdapter>> m_wakewordEngineAdapter;
+    std::shared_ptr<LocaleAssetsManager> m_localeAssetsManager;
+    std::mutex m_mutex;
+    std::condition_variable m_prefetched;
+    std::set<std::string> m_prefetchedLocales;
+};
+
+TEST_F(LocaleAssetsManagerTest, changeAssetsWithoutWakewordEngine) {
+    EXPECT_TRUE(m_localeAssetsManager->changeAssets({"de-DE"}, {"ALEXA"}));
+}
+
+TEST_F(LocaleAssetsManagerTest, prefetchesTheInactiveLocales) {
+    auto supportedLocales = m_localeAssetsManager->getSupportedLocales();
+    ASSERT_EQ(supportedLocales.size(), 15u);
+    EXPECT_CALL(*m_wakewordEngineAdapter, prefetchLocale("en-CA")).Times(0);
+    EXPECT_CALL(*m_wakewordEngineAdapter, prefetchLocale("fr-CA")).Times(0);
+    m_localeAssetsManager->setWakewordEngineAdapter(m_wakewordEngineAdapter, "en-CA/fr-CA");
+
+    supportedLocales.erase("en-CA");
+    supportedLocales.erase("fr-CA");
+    EXPECT_EQ(waitForPrefetchedLocales(supportedLocales.size()), supportedLocales);
+}
+
+TEST_F(LocaleAssetsManagerTest, changeAssetsChangesTheWakewordLocale) {
+    m_localeAssetsManager->setWakewordEngineAdapter(m_wakewordEngineAdapter, "en-US");
+
+    // the active locale is not changed again
+    EXPECT_CALL(*m_wakewordEngineAdapter, changeLocale(testing::_)).Times(0);
+    EXPECT_TRUE(m_localeAssetsManager->changeAssets({"en-US"}, {"ALEXA"}));
+    testing::Mock::VerifyAndClearExpectations(m_wakewordEngineAdapter.get());
+
+    EXPECT_CALL(*m_wakewordEngineAdapter, changeLocale("en-CA/fr-CA")).WillOnce(testing::Return(true));
+    EXPECT_TRUE(m_localeAssetsManager->changeAssets({"en-CA", "fr-CA"}, {"ALEXA"}));
+    testing::Mock::VerifyAndClearExpectations(m_wakewordEngineAdapter.get());
+
+    EXPECT_CALL(*m_wakewordEngineAdapter, changeLocale(testing::_)).Times(0);
+    EXPECT_TRUE(m_localeAssetsManager->changeAssets({"en-CA", "fr-CA"}, {"ALEXA"}));
+}
+
+TEST_F(LocaleAssetsManagerTest, changeAssetsKeepsTheLocaleOnFailure) {
+    m_localeAssetsManager->setWakewordEngineAdapter(m_wakewordEngineAdapter, "en-US");
+
+    EXPECT_CALL(*m_wakewordEngineAdapter, changeLocale("de-DE"))
+        .WillOnce(testing::Return(false))
+        .WillOnce(testing::Return(true));
+    EXPECT_FALSE(m_localeAssetsManager->changeAssets({"de-DE"}, {"ALEXA"}));
+    EXPECT_TRUE(m_localeAssetsManager->changeAssets({"de-DE"}, {"ALEXA"}));
+}
+
+TEST_F(LocaleAssetsManagerTest, changeAssetsAfterShutdownKeepsTheLocale) {
+    m_localeAssetsManager->setWakewordEngineAdapter(m_wakewordEngineAdapter, "en-US");
+    m_localeAssetsManager->shutdown();
+
+    EXPECT_CALL(*m_wakewordEngineAdapter, changeLocale(testing::_)).Times(0);
+    EXPECT_TRUE(m_localeAssetsManager->changeAssets({"de-DE"}, {"ALEXA"}));
+    m_localeAssetsManager.reset();
+}
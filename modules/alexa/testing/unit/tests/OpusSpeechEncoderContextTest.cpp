@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <AACE/Engine/Alexa/OpusSpeechEncoderContext.h>
+
+using namespace aace::engine::alexa;
+using alexaClientSDK::avsCommon::utils::AudioFormat;
+
+/// Returns the 16 kHz mono LPCM format of the speech recognizer audio
+static AudioFormat createInputFormat() {
+    AudioFormat format;
+    format.encoding = AudioFormat::Encoding::LPCM;
+    format.layout = AudioFormat::Layout::INTERLEAVED;
+    format.endianness = AudioFormat::Endianness::LITTLE;
+    format.sampleRateHz = 16000;
+    format.sampleSizeInBits = 16;
+    format.numChannels = 1;
+    format.dataSigned = true;
+    return format;
+}
+
+TEST(OpusSpeechEncoderContextTest, rejectsInvalidConfiguration) {
+    OpusSpeechEncoderContext::Config config;
+    config.bitrate = 32100;
+    EXPECT_EQ(OpusSpeechEncoderContext::create(config), nullptr);
+
+    config = OpusSpeechEncoderContext::Config();
+    config.complexity = 11;
+    EXPECT_EQ(OpusSpeechEncoderContext::create(config), nullptr);
+
+    config = OpusSpeechEncoderContext::Config();
+    config.nice = 20;
+    EXPECT_EQ(OpusSpeechEncoderContext::create(config), nullptr);
+}
+
+TEST(OpusSpeechEncoderContextTest, rejectsUnsupportedInputFormat) {
+    auto context = OpusSpeechEncoderContext::create();
+    ASSERT_NE(context, nullptr);
+
+    auto format = createInputFormat();
+    format.sampleRateHz = 48000;
+    EXPECT_FALSE(context->init(format));
+    EXPECT_TRUE(context->init(createInputFormat()));
+}
+
+TEST(OpusSpeechEncoderContextTest, encodesConstantSizeFrames) {
+    OpusSpeechEncoderContext::Config config;
+    config.bitrate = 24000;
+    config.complexity = 0;
+    auto context = OpusSpeechEncoderContext::create(config);
+    ASSERT_NE(context, nullptr);
+    ASSERT_TRUE(context->init(createInputFormat()));
+    EXPECT_EQ(context->getAVSFormatName(), "OPUS");
+    EXPECT_EQ(context->getAudioFormat().encoding, AudioFormat::Encoding::OPUS);
+    EXPECT_EQ(context->getInputFrameSize(), 320u);
+    EXPECT_EQ(context->getOutputFrameSize(), 60u);
+
+    std::vector<int16_t> samples(context->getInputFrameSize());
+    std::vector<uint8_t> buffer(context->getOutputFrameSize());
+    EXPECT_LT(context->processSamples(samples.data(), samples.size(), buffer.data()), 0);
+
+    ASSERT_TRUE(context->start());
+    for (int frame = 0; frame < 5; frame++) {
+        for (size_t i = 0; i < samples.size(); i++) {
+            samples[i] = static_cast<int16_t>(8000 * std::sin((frame * samples.size() + i) * 0.1));
+        }
+        EXPECT_EQ(
+            context->processSamples(samples.data(), samples.size(), buffer.data()),
+            static_cast<ssize_t>(context->getOutputFrameSize()));
+    }
+    EXPECT_LT(context->processSamples(samples.data(), samples.size() / 2, buffer.data()), 0);
+    context->close();
+}
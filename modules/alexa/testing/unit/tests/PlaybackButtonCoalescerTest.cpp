@@ -0,0 +1,132 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Alexa/PlaybackButtonCoalescer.h>
+
+using aace::engine::alexa::PlaybackButtonCoalescer;
+using PlaybackButton = PlaybackButtonCoalescer::PlaybackButton;
+
+class PlaybackButtonCoalescerTest : public ::testing::Test {
+protected:
+    std::shared_ptr<PlaybackButtonCoalescer> createCoalescer(std::chrono::milliseconds window) {
+        return PlaybackButtonCoalescer::create(
+            [this](PlaybackButton button) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_buttons.push_back(button);
+            },
+            window);
+    }
+
+    std::vector<PlaybackButton> getButtons() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_buttons;
+    }
+
+    /// Waits for the handler to be called a number of times
+    bool waitForButtons(size_t count) {
+        for (int i = 0; i < 200 && getButtons().size() < count; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return getButtons().size() == count;
+    }
+
+    std::mutex m_mutex;
+    std::vector<PlaybackButton> m_buttons;
+};
+
+TEST_F(PlaybackButtonCoalescerTest, sendsFirstSkipAtOnce) {
+    auto coalescer = createCoalescer(std::chrono::seconds(10));
+    ASSERT_NE(coalescer, nullptr);
+
+    coalescer->buttonPressed(PlaybackButton::NEXT);
+    EXPECT_EQ(getButtons(), std::vector<PlaybackButton>{PlaybackButton::NEXT});
+    EXPECT_EQ(coalescer->getPendingSkips(), 0);
+}
+
+TEST_F(PlaybackButtonCoalescerTest, sendsNetSkipsWhenTheWindowEnds) {
+    auto coalescer = createCoalescer(std::chrono::milliseconds(100));
+    ASSERT_NE(coalescer, nullptr);
+
+    for (int i = 0; i < 5; i++) {
+        coalescer->buttonPressed(PlaybackButton::NEXT);
+    }
+    coalescer->buttonPressed(PlaybackButton::PREVIOUS);
+    EXPECT_EQ(coalescer->getPendingSkips(), 3);
+
+    ASSERT_TRUE(waitForButtons(4));
+    EXPECT_EQ(getButtons(), std::vector<PlaybackButton>(4, PlaybackButton::NEXT));
+    EXPECT_EQ(coalescer->getPendingSkips(), 0);
+
+    // the window ended, so the next skip is sent at once
+    coalescer->buttonPressed(PlaybackButton::PREVIOUS);
+    EXPECT_EQ(getButtons().size(), 5u);
+    EXPECT_EQ(getButtons().back(), PlaybackButton::PREVIOUS);
+}
+
+TEST_F(PlaybackButtonCoalescerTest, dropsSkipsWhichCancelEachOther) {
+    auto coalescer = createCoalescer(std::chrono::seconds(10));
+    ASSERT_NE(coalescer, nullptr);
+
+    coalescer->buttonPressed(PlaybackButton::NEXT);
+    coalescer->buttonPressed(PlaybackButton::NEXT);
+    coalescer->buttonPressed(PlaybackButton::PREVIOUS);
+    coalescer->flush();
+    EXPECT_EQ(getButtons(), std::vector<PlaybackButton>{PlaybackButton::NEXT});
+}
+
+TEST_F(PlaybackButtonCoalescerTest, sendsPendingSkipsBeforeOtherButtons) {
+    auto coalescer = createCoalescer(std::chrono::seconds(10));
+    ASSERT_NE(coalescer, nullptr);
+
+    coalescer->buttonPressed(PlaybackButton::PREVIOUS);
+    coalescer->buttonPressed(PlaybackButton::PREVIOUS);
+    coalescer->buttonPressed(PlaybackButton::PAUSE);
+    EXPECT_EQ(
+        getButtons(),
+        (std::vector<PlaybackButton>{PlaybackButton::PREVIOUS, PlaybackButton::PREVIOUS, PlaybackButton::PAUSE}));
+}
+
+TEST_F(PlaybackButtonCoalescerTest, sendsEachPressWithoutWindow) {
+    auto coalescer = createCoalescer(std::chrono::milliseconds::zero());
+    ASSERT_NE(coalescer, nullptr);
+
+    coalescer->buttonPressed(PlaybackButton::NEXT);
+    coalescer->buttonPressed(PlaybackButton::NEXT);
+    EXPECT_EQ(getButtons(), std::vector<PlaybackButton>(2, PlaybackButton::NEXT));
+}
+
+TEST_F(PlaybackButtonCoalescerTest, dropsPendingSkipsAtShutdown) {
+    auto coalescer = createCoalescer(std::chrono::milliseconds(50));
+    ASSERT_NE(coalescer, nullptr);
+
+    coalescer->buttonPressed(PlaybackButton::NEXT);
+    coalescer->buttonPressed(PlaybackButton::NEXT);
+    coalescer->shutdown();
+    coalescer->buttonPressed(PlaybackButton::PLAY);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_EQ(getButtons(), std::vector<PlaybackButton>{PlaybackButton::NEXT});
+}
+
+TEST_F(PlaybackButtonCoalescerTest, rejectsInvalidArguments) {
+    EXPECT_EQ(PlaybackButtonCoalescer::create(nullptr), nullptr);
+    EXPECT_EQ(createCoalescer(std::chrono::milliseconds(-1)), nullptr);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/Alexa/PlaybackPositionTracker.h>
+
+using aace::engine::alexa::PlaybackPositionTracker;
+using std::chrono::milliseconds;
+
+TEST(PlaybackPositionTrackerTest, interpolatesWhilePlaying) {
+    PlaybackPositionTracker tracker;
+    auto start = PlaybackPositionTracker::Clock::now();
+    milliseconds position;
+    EXPECT_FALSE(tracker.getPosition(position, start));
+
+    // the reported position is frozen until the media plays
+    tracker.update(milliseconds(1000), start);
+    ASSERT_TRUE(tracker.getPosition(position, start + milliseconds(300)));
+    EXPECT_EQ(position, milliseconds(1000));
+
+    tracker.setPlaying(true, start + milliseconds(500));
+    ASSERT_TRUE(tracker.getPosition(position, start + milliseconds(1500)));
+    EXPECT_EQ(position, milliseconds(2000));
+
+    // a new report replaces the interpolated position
+    tracker.update(milliseconds(1900), start + milliseconds(1500));
+    tracker.setPlaying(false, start + milliseconds(1700));
+    ASSERT_TRUE(tracker.getPosition(position, start + milliseconds(9000)));
+    EXPECT_EQ(position, milliseconds(2100));
+
+    tracker.reset();
+    EXPECT_FALSE(tracker.getPosition(position, start + milliseconds(9000)));
+}
+
+TEST(PlaybackPositionTrackerTest, forgetsPositionWithoutReports) {
+    PlaybackPositionTracker tracker(milliseconds(2000));
+    auto start = PlaybackPositionTracker::Clock::now();
+    milliseconds position;
+
+    tracker.update(milliseconds(0), start);
+    tracker.setPlaying(true, start);
+    ASSERT_TRUE(tracker.getPosition(position, start + milliseconds(2000)));
+    EXPECT_EQ(position, milliseconds(2000));
+    EXPECT_FALSE(tracker.getPosition(position, start + milliseconds(2001)));
+
+    tracker.update(milliseconds(2500), start + milliseconds(2500));
+    ASSERT_TRUE(tracker.getPosition(position, start + milliseconds(3000)));
+    EXPECT_EQ(position, milliseconds(3000));
+}
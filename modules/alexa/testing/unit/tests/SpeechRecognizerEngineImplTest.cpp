@@ -115,7 +115,9 @@ protected:
     }
 
     std::shared_ptr<aace::engine::alexa::SpeechRecognizerEngineImpl> createSpeechRecognizerEngineImpl(
-        bool withEncoder = true) {
+        bool withEncoder = true,
+        const aace::engine::alexa::SpeechRecognizerEngineImpl::AudioBufferConfig& audioBufferConfig =
+            aace::engine::alexa::SpeechRecognizerEngineImpl::AudioBufferConfig()) {
         if (m_configured == false) {
             configure();
         }
@@ -141,7 +143,8 @@ protected:
             std::make_shared<avsCommon::avs::CapabilityChangeNotifier>(),
             (withEncoder ? m_alexaMockFactory->getSpeechEncoderMock() : nullptr),
             m_alexaMockFactory->getWakewordEngineAdapterMock(),
-            createInitiatorVerifiers());
+            createInitiatorVerifiers(),
+            audioBufferConfig);
 
         return speechRecognizerEngineImpl;
     }
@@ -180,6 +183,23 @@ TEST_F(SpeechRecognizerEngineImplTest, create) {
     speechRecognizerEngineImpl->shutdown();
 }
 
+TEST_F(SpeechRecognizerEngineImplTest, createWithAudioBufferConfig) {
+    aace::engine::alexa::SpeechRecognizerEngineImpl::AudioBufferConfig audioBufferConfig;
+    audioBufferConfig.duration = std::chrono::milliseconds(2500);
+    audioBufferConfig.maxReaders = 3;
+
+    auto speechRecognizerEngineImpl = createSpeechRecognizerEngineImpl(true, audioBufferConfig);
+    ASSERT_NE(speechRecognizerEngineImpl, nullptr) << "SpeechRecognizerEngineImpl pointer expected to be not null";
+
+    // the stream holds 2.5 seconds of 16 kHz audio, and is shared by at most 3 readers
+    auto stream = speechRecognizerEngineImpl->getAudioInputStream();
+    ASSERT_NE(stream, nullptr);
+    EXPECT_EQ(stream->getDataSize(), 40000u);
+    EXPECT_EQ(stream->getMaxReaders(), 3u);
+
+    speechRecognizerEngineImpl->shutdown();
+}
+
 TEST_F(SpeechRecognizerEngineImplTest, createWithPlatformInterfaceAsNull) {
     EXPECT_CALL(*m_alexaMockFactory->getDirectiveSequencerInterfaceMock(), doShutdown());
 
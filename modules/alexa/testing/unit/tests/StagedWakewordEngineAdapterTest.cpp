@@ -0,0 +1,141 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/Alexa/StagedWakewordEngineAdapter.h>
+#include <AACE/Test/Unit/Alexa/MockWakewordEngineAdapter.h>
+
+using namespace aace::test::unit::alexa;
+using aace::engine::alexa::StagedWakewordEngineAdapter;
+using aace::engine::alexa::WakewordEngineAdapter;
+using alexaClientSDK::avsCommon::avs::AudioInputStream;
+using alexaClientSDK::avsCommon::sdkInterfaces::KeyWordObserverInterface;
+using alexaClientSDK::avsCommon::utils::AudioFormat;
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::SaveArg;
+
+/// An observer keeping the key words it is notified of
+class TestKeyWordObserver : public KeyWordObserverInterface {
+public:
+    void onKeyWordDetected(
+        std::shared_ptr<AudioInputStream> stream,
+        std::string keyword,
+        AudioInputStream::Index beginIndex,
+        AudioInputStream::Index endIndex,
+        std::shared_ptr<const std::vector<char>> KWDMetadata) override {
+        m_detections.push_back(keyword);
+    }
+
+    std::vector<std::string> m_detections;
+};
+
+class StagedWakewordEngineAdapterTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_primary = std::make_shared<NiceMock<MockWakewordEngineAdapter>>();
+        m_secondary = std::make_shared<NiceMock<MockWakewordEngineAdapter>>();
+        m_observer = std::make_shared<TestKeyWordObserver>();
+        ON_CALL(*m_primary, initialize(_, _, _)).WillByDefault(Return(true));
+        ON_CALL(*m_primary, enable()).WillByDefault(Return(true));
+        ON_CALL(*m_primary, disable()).WillByDefault(Return(true));
+        ON_CALL(*m_secondary, initialize(_, _, _)).WillByDefault(Return(true));
+        ON_CALL(*m_secondary, enable()).WillByDefault(Return(true));
+    }
+
+    /// Creates the staged adapter of @c m_primary, initialized and enabled
+    std::shared_ptr<StagedWakewordEngineAdapter> createAdapter(StagedWakewordEngineAdapter::AdapterFactory factory) {
+        auto adapter = StagedWakewordEngineAdapter::create(m_primary, factory);
+        EXPECT_NE(adapter, nullptr);
+        if (adapter == nullptr) {
+            return nullptr;
+        }
+        EXPECT_CALL(*m_primary, addKeyWordObserver(_)).WillOnce(SaveArg<0>(&m_primaryRouter));
+        EXPECT_CALL(*m_primary, initialize("en-US", _, _));
+        EXPECT_TRUE(adapter->initialize("en-US", m_stream, m_audioFormat));
+        EXPECT_TRUE(adapter->enable());
+        adapter->addKeyWordObserver(m_observer);
+        return adapter;
+    }
+
+protected:
+    std::shared_ptr<AudioInputStream> m_stream;
+    AudioFormat m_audioFormat;
+    std::shared_ptr<NiceMock<MockWakewordEngineAdapter>> m_primary;
+    std::shared_ptr<NiceMock<MockWakewordEngineAdapter>> m_secondary;
+    std::shared_ptr<KeyWordObserverInterface> m_primaryRouter;
+    std::shared_ptr<TestKeyWordObserver> m_observer;
+};
+
+TEST_F(StagedWakewordEngineAdapterTest, rejectsInvalidArguments) {
+    EXPECT_EQ(StagedWakewordEngineAdapter::create(nullptr, []() { return nullptr; }), nullptr);
+    EXPECT_EQ(StagedWakewordEngineAdapter::create(m_primary, nullptr), nullptr);
+}
+
+TEST_F(StagedWakewordEngineAdapterTest, changesTheLocaleOnASecondInstance) {
+    auto secondary = m_secondary;
+    auto adapter = createAdapter([secondary]() { return secondary; });
+    ASSERT_NE(adapter, nullptr);
+    ASSERT_NE(m_primaryRouter, nullptr);
+    m_primaryRouter->onKeyWordDetected(m_stream, "ALEXA");
+
+    // the new instance is enabled before the active one is disabled, and the active one is never changed in place
+    std::shared_ptr<KeyWordObserverInterface> secondaryRouter;
+    EXPECT_CALL(*m_primary, changeLocale(_)).Times(0);
+    EXPECT_CALL(*m_secondary, initialize("fr-FR", _, _)).WillOnce(Return(true));
+    EXPECT_CALL(*m_secondary, addKeyWordObserver(_)).WillOnce(SaveArg<0>(&secondaryRouter));
+    EXPECT_CALL(*m_secondary, enable()).WillOnce(Return(true));
+    EXPECT_CALL(*m_primary, disable()).WillOnce(Return(true));
+    EXPECT_CALL(*m_primary, removeKeyWordObserver(m_primaryRouter));
+    ASSERT_TRUE(adapter->changeLocale("fr-FR"));
+    EXPECT_EQ(adapter->getActiveAdapter(), m_secondary);
+    ASSERT_NE(secondaryRouter, nullptr);
+
+    // the detections of the previous instance are dropped
+    m_primaryRouter->onKeyWordDetected(m_stream, "ALEXA");
+    secondaryRouter->onKeyWordDetected(m_stream, "ALEXA");
+    EXPECT_EQ(m_observer->m_detections, (std::vector<std::string>{"ALEXA", "ALEXA"}));
+
+    EXPECT_CALL(*m_secondary, disable()).WillOnce(Return(true));
+    EXPECT_TRUE(adapter->disable());
+}
+
+TEST_F(StagedWakewordEngineAdapterTest, changesTheLocaleInPlaceWithoutSecondInstance) {
+    auto secondary = m_secondary;
+    auto created = false;
+    auto adapter = createAdapter([secondary, &created]() -> std::shared_ptr<WakewordEngineAdapter> {
+        // the first new instance can't be created, and the next one fails to initialize
+        if (!created) {
+            created = true;
+            return nullptr;
+        }
+        return secondary;
+    });
+    ASSERT_NE(adapter, nullptr);
+
+    EXPECT_CALL(*m_primary, changeLocale("fr-FR")).WillOnce(Return(true));
+    EXPECT_TRUE(adapter->changeLocale("fr-FR"));
+    EXPECT_EQ(adapter->getActiveAdapter(), m_primary);
+
+    EXPECT_CALL(*m_secondary, initialize("es-ES", _, _)).WillOnce(Return(false));
+    EXPECT_CALL(*m_secondary, enable()).Times(0);
+    EXPECT_CALL(*m_primary, disable()).Times(0);
+    EXPECT_CALL(*m_primary, changeLocale("es-ES")).WillOnce(Return(false));
+    EXPECT_FALSE(adapter->changeLocale("es-ES"));
+    EXPECT_EQ(adapter->getActiveAdapter(), m_primary);
+}
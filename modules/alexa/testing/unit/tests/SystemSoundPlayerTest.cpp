@@ -0,0 +1,170 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <sstream>
+
+#include <AACE/Engine/Alexa/SystemSoundPlayer.h>
+#include <AACE/Test/Unit/Audio/MockAudioManagerInterface.h>
+#include <AACE/Test/Unit/Audio/MockAudioOutputChannelInterface.h>
+
+using namespace aace::test::unit::audio;
+using aace::engine::alexa::SystemSoundPlayer;
+using Tone = alexaClientSDK::avsCommon::sdkInterfaces::SystemSoundPlayerInterface::Tone;
+using MediaType = alexaClientSDK::avsCommon::utils::MediaType;
+
+/// A tone factory that counts how many times the tones are read
+class TestSystemSoundAudioFactory
+        : public alexaClientSDK::avsCommon::sdkInterfaces::audio::SystemSoundAudioFactoryInterface {
+public:
+    using ToneFactory = std::function<std::pair<std::unique_ptr<std::istream>, const MediaType>()>;
+
+    ToneFactory endSpeechTone() const override {
+        return createTone(m_endSpeechTone, MediaType::MPEG);
+    }
+
+    ToneFactory wakeWordNotificationTone() const override {
+        return createTone(m_wakeWordTone, MediaType::WAV);
+    }
+
+    ToneFactory createTone(const std::string& data, MediaType mediaType) const {
+        auto reads = &m_reads;
+        return [data, mediaType, reads]() {
+            (*reads)++;
+            return std::pair<std::unique_ptr<std::istream>, const MediaType>(
+                std::unique_ptr<std::istream>(new std::istringstream(data)), mediaType);
+        };
+    }
+
+    std::string m_wakeWordTone;
+    std::string m_endSpeechTone;
+    mutable std::atomic<int> m_reads{0};
+};
+
+static void appendUint16(std::string& data, uint16_t value) {
+    data.push_back(static_cast<char>(value & 0xff));
+    data.push_back(static_cast<char>(value >> 8));
+}
+
+static void appendUint32(std::string& data, uint32_t value) {
+    appendUint16(data, static_cast<uint16_t>(value & 0xffff));
+    appendUint16(data, static_cast<uint16_t>(value >> 16));
+}
+
+/// Creates a 16-bit PCM WAV file with an extra chunk before its samples
+static std::string createWav(const std::string& samples, uint32_t sampleRate, uint16_t channels) {
+    std::string data = "RIFF";
+    appendUint32(data, static_cast<uint32_t>(4 + 8 + 16 + 8 + 3 + 1 + 8 + samples.size()));
+    data += "WAVEfmt ";
+    appendUint32(data, 16);
+    appendUint16(data, 1);
+    appendUint16(data, channels);
+    appendUint32(data, sampleRate);
+    appendUint32(data, sampleRate * channels * 2);
+    appendUint16(data, static_cast<uint16_t>(channels * 2));
+    appendUint16(data, 16);
+    data += "LIST";
+    appendUint32(data, 3);
+    data += std::string("abc\0", 4);
+    data += "data";
+    appendUint32(data, static_cast<uint32_t>(samples.size()));
+    return data + samples;
+}
+
+static std::string readAll(const std::shared_ptr<aace::audio::AudioStream>& stream) {
+    std::string result;
+    char buffer[3];
+    while (!stream->isClosed()) {
+        auto count = stream->read(buffer, sizeof(buffer));
+        result.append(buffer, count);
+    }
+    return result;
+}
+
+class SystemSoundPlayerTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_audioManager = std::make_shared<testing::StrictMock<MockAudioManagerInterface>>();
+        m_audioOutputChannel = std::make_shared<testing::NiceMock<MockAudioOutputChannelInterface>>();
+        m_audioFactory = std::make_shared<TestSystemSoundAudioFactory>();
+        m_audioFactory->m_wakeWordTone = createWav(std::string("\x01\x02\x03\x04\x05\x06\x07\x08", 8), 24000, 2);
+        m_audioFactory->m_endSpeechTone = "ID3 not really an mp3";
+
+        ON_CALL(*m_audioOutputChannel, play()).WillByDefault(testing::Return(true));
+    }
+
+protected:
+    std::shared_ptr<testing::StrictMock<MockAudioManagerInterface>> m_audioManager;
+    std::shared_ptr<testing::NiceMock<MockAudioOutputChannelInterface>> m_audioOutputChannel;
+    std::shared_ptr<TestSystemSoundAudioFactory> m_audioFactory;
+};
+
+TEST_F(SystemSoundPlayerTest, playsTonesFromMemory) {
+    auto systemSoundPlayer = SystemSoundPlayer::create(m_audioManager, m_audioFactory);
+    ASSERT_NE(systemSoundPlayer, nullptr);
+    EXPECT_EQ(m_audioFactory->m_reads, 2);
+
+    EXPECT_CALL(*m_audioManager, openAudioOutputChannel("SystemSoundPlayer", testing::_))
+        .WillOnce(testing::Return(m_audioOutputChannel));
+    std::vector<std::shared_ptr<aace::audio::AudioStream>> streams;
+    EXPECT_CALL(*m_audioOutputChannel, prepare(testing::An<std::shared_ptr<aace::audio::AudioStream>>(), false))
+        .Times(3)
+        .WillRepeatedly(testing::DoAll(
+            testing::Invoke([&streams](std::shared_ptr<aace::audio::AudioStream> stream, bool) {
+                streams.push_back(stream);
+            }),
+            testing::Return(true)));
+
+    for (auto tone : {Tone::WAKEWORD_NOTIFICATION, Tone::END_SPEECH, Tone::WAKEWORD_NOTIFICATION}) {
+        auto future = systemSoundPlayer->playTone(tone);
+        systemSoundPlayer->onMediaStateChanged(SystemSoundPlayer::MediaState::STOPPED);
+        EXPECT_TRUE(future.get());
+    }
+
+    // the tones are not read again, and the WAV tone is played as its samples
+    EXPECT_EQ(m_audioFactory->m_reads, 2);
+    ASSERT_EQ(streams.size(), 3u);
+    auto format = streams[0]->getAudioFormat();
+    EXPECT_EQ(format.getEncoding(), aace::audio::AudioFormat::Encoding::LPCM);
+    EXPECT_EQ(format.getSampleRate(), 24000u);
+    EXPECT_EQ(format.getNumChannels(), 2);
+    EXPECT_EQ(readAll(streams[0]), std::string("\x01\x02\x03\x04\x05\x06\x07\x08", 8));
+    EXPECT_EQ(streams[1]->getEncoding(), aace::audio::AudioFormat::Encoding::MP3);
+    EXPECT_EQ(readAll(streams[1]), m_audioFactory->m_endSpeechTone);
+    EXPECT_EQ(readAll(streams[2]), std::string("\x01\x02\x03\x04\x05\x06\x07\x08", 8));
+}
+
+TEST_F(SystemSoundPlayerTest, reloadsToneThatFailedToLoad) {
+    m_audioFactory->m_wakeWordTone.clear();
+    auto systemSoundPlayer = SystemSoundPlayer::create(m_audioManager, m_audioFactory);
+    ASSERT_NE(systemSoundPlayer, nullptr);
+
+    EXPECT_CALL(*m_audioManager, openAudioOutputChannel("SystemSoundPlayer", testing::_))
+        .WillOnce(testing::Return(m_audioOutputChannel));
+    EXPECT_CALL(*m_audioOutputChannel, prepare(testing::An<std::shared_ptr<aace::audio::AudioStream>>(), false))
+        .WillOnce(testing::Return(true));
+
+    EXPECT_FALSE(systemSoundPlayer->playTone(Tone::WAKEWORD_NOTIFICATION).get());
+
+    // a WAV tone that is not PCM is played as it is
+    m_audioFactory->m_wakeWordTone = "RIFF....WAVEnot a fmt chunk";
+    auto future = systemSoundPlayer->playTone(Tone::WAKEWORD_NOTIFICATION);
+    systemSoundPlayer->onMediaStateChanged(SystemSoundPlayer::MediaState::STOPPED);
+    EXPECT_TRUE(future.get());
+    EXPECT_EQ(m_audioFactory->m_reads, 4);
+}
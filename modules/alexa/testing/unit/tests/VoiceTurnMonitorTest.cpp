@@ -0,0 +1,157 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <AACE/Engine/Alexa/VoiceTurnMonitor.h>
+
+using aace::engine::alexa::AudioChannelTrace;
+using aace::engine::alexa::VoiceTurnMonitor;
+using DialogUXState = alexaClientSDK::avsCommon::sdkInterfaces::DialogUXStateObserverInterface::DialogUXState;
+using Stage = VoiceTurnMonitor::Stage;
+using std::chrono::milliseconds;
+
+/// The time to wait for a turn to complete
+static const milliseconds TIMEOUT(2000);
+
+class VoiceTurnMonitorTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_monitor = VoiceTurnMonitor::create(milliseconds(1), milliseconds(50));
+        ASSERT_NE(m_monitor, nullptr);
+    }
+
+    void TearDown() override {
+        AudioChannelTrace::removeTransitionListener(m_monitor);
+        m_monitor->shutdown();
+    }
+
+protected:
+    /// Returns a directive of a dialog request.
+    static std::string directive(const std::string& name, const std::string& dialogRequestId = "") {
+        std::string header = "\"namespace\":\"SpeechSynthesizer\",\"name\":\"" + name + "\",\"messageId\":\"1\"";
+        if (!dialogRequestId.empty()) {
+            header += ",\"dialogRequestId\":\"" + dialogRequestId + "\"";
+        }
+        return "{\"directive\":{\"header\":{" + header + "},\"payload\":{}}}";
+    }
+
+    /// Waits for the turn of a dialog request to complete, and returns it.
+    VoiceTurnMonitor::Turn waitForTurn(const std::string& dialogRequestId) {
+        auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+        while (m_monitor->getLastTurn().dialogRequestId != dialogRequestId &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(milliseconds(5));
+        }
+        return m_monitor->getLastTurn();
+    }
+
+    std::shared_ptr<VoiceTurnMonitor> m_monitor;
+};
+
+TEST_F(VoiceTurnMonitorTest, recordsStagesOfTurn) {
+    AudioChannelTrace::addTransitionListener(m_monitor);
+    AudioChannelTrace speechSynthesizer("SpeechSynthesizer");
+    AudioChannelTrace audioPlayer("AudioPlayer");
+
+    m_monitor->onWakewordDetected();
+    m_monitor->onCaptureStarted();
+    m_monitor->onEndOfSpeech();
+    m_monitor->receive("", directive("StopCapture", "turn-1"));
+    auto now = AudioChannelTrace::Clock::now();
+    speechSynthesizer.recordCall(AudioChannelTrace::Call::PREPARE, now, now);
+    speechSynthesizer.recordTransition(AudioChannelTrace::Transition::STARTED, now + milliseconds(20));
+    m_monitor->onDialogUXStateChanged(DialogUXState::IDLE);
+    audioPlayer.recordTransition(AudioChannelTrace::Transition::RESUMED, now + milliseconds(100));
+
+    auto turn = m_monitor->getLastTurn();
+    EXPECT_EQ(turn.dialogRequestId, "turn-1");
+    for (int index = 0; index < VoiceTurnMonitor::STAGE_COUNT; index++) {
+        EXPECT_TRUE(turn.has(static_cast<Stage>(index))) << index;
+    }
+    EXPECT_EQ(turn.getLatency(Stage::TTS_PREPARED, Stage::FIRST_AUDIO_OUT), milliseconds(20));
+    EXPECT_GE(turn.getLatency(Stage::WAKEWORD, Stage::MEDIA_RESUMED), milliseconds(100));
+}
+
+TEST_F(VoiceTurnMonitorTest, identifiesTurnByFirstDirective) {
+    m_monitor->onCaptureStarted();
+    // the directives without a dialog request do not belong to the turn
+    m_monitor->receive("", directive("SetAlert"));
+    m_monitor->receive("", directive("StopCapture", "turn-1"));
+    m_monitor->receive("", directive("Speak", "turn-other"));
+
+    // a tap to talk starts the next turn, which ignores the late directives of the previous one
+    m_monitor->onCaptureStarted();
+    auto turn = m_monitor->getLastTurn();
+    EXPECT_EQ(turn.dialogRequestId, "turn-1");
+    EXPECT_FALSE(turn.has(Stage::WAKEWORD));
+    EXPECT_FALSE(turn.has(Stage::END_OF_SPEECH));
+
+    m_monitor->receive("", directive("Speak", "turn-1"));
+    m_monitor->receive("", directive("StopCapture", "turn-2"));
+    m_monitor->onDialogUXStateChanged(DialogUXState::IDLE);
+    EXPECT_EQ(waitForTurn("turn-2").dialogRequestId, "turn-2");
+}
+
+TEST_F(VoiceTurnMonitorTest, completesTurnWithoutMediaResume) {
+    m_monitor->onWakewordDetected();
+    m_monitor->onCaptureStarted();
+    m_monitor->onEndOfSpeech();
+    m_monitor->receive("", directive("StopCapture", "turn-1"));
+    auto now = AudioChannelTrace::Clock::now();
+    m_monitor->onChannelCall("SpeechSynthesizer", AudioChannelTrace::Call::PREPARE, now);
+    m_monitor->onChannelTransition("SpeechSynthesizer", AudioChannelTrace::Transition::STARTED, now);
+    // a media started by the turn is not a resume
+    m_monitor->onChannelTransition("AudioPlayer", AudioChannelTrace::Transition::STARTED, now);
+    m_monitor->onDialogUXStateChanged(DialogUXState::IDLE);
+
+    auto turn = waitForTurn("turn-1");
+    EXPECT_EQ(turn.dialogRequestId, "turn-1");
+    EXPECT_TRUE(turn.has(Stage::FIRST_AUDIO_OUT));
+    EXPECT_FALSE(turn.has(Stage::MEDIA_RESUMED));
+}
+
+TEST_F(VoiceTurnMonitorTest, completesTurnWhenMediaStopsDucking) {
+    m_monitor->onCaptureStarted();
+    m_monitor->receive("", directive("StopCapture", "turn-1"));
+    m_monitor->onChannelCall("AudioPlayer", AudioChannelTrace::Call::STOP_DUCKING, AudioChannelTrace::Clock::now());
+
+    auto turn = m_monitor->getLastTurn();
+    EXPECT_EQ(turn.dialogRequestId, "turn-1");
+    EXPECT_TRUE(turn.has(Stage::MEDIA_RESUMED));
+    EXPECT_FALSE(turn.has(Stage::TTS_PREPARED));
+}
+
+TEST_F(VoiceTurnMonitorTest, dropsTurnWithoutCapture) {
+    // a wakeword rejected by a verifier never starts its capture
+    m_monitor->onWakewordDetected();
+    m_monitor->onWakewordDetected();
+    EXPECT_FALSE(m_monitor->getLastTurn().has(Stage::WAKEWORD));
+
+    m_monitor->shutdown();
+    m_monitor->onCaptureStarted();
+    auto now = AudioChannelTrace::Clock::now();
+    m_monitor->onChannelTransition("AudioPlayer", AudioChannelTrace::Transition::RESUMED, now);
+    EXPECT_FALSE(m_monitor->getLastTurn().has(Stage::CAPTURE_STARTED));
+}
+
+TEST_F(VoiceTurnMonitorTest, rejectsInvalidDurations) {
+    EXPECT_EQ(VoiceTurnMonitor::create(milliseconds(-1)), nullptr);
+    EXPECT_EQ(VoiceTurnMonitor::create(milliseconds(0), milliseconds(-1)), nullptr);
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include <AACE/Engine/Alexa/WakewordEngineManager.h>
+#include <AACE/Engine/Alexa/WakewordPipeline.h>
+
+using namespace aace::engine::alexa;
+using alexaClientSDK::avsCommon::avs::AudioInputStream;
+using alexaClientSDK::avsCommon::utils::AudioFormat;
+
+/// The number of samples of a 10 ms frame of 16 kHz audio
+static const size_t FRAME_SIZE = 160;
+
+/// A consumer that keeps a copy of the batches it is delivered
+class TestFrameConsumer : public WakewordFrameConsumer {
+public:
+    void onFrames(const WakewordFrameBatch& batch) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_batches.push_back(batch);
+        m_cv.notify_all();
+    }
+
+    bool waitForBatches(size_t count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_cv.wait_for(lock, std::chrono::seconds(5), [this, count] { return m_batches.size() >= count; });
+    }
+
+    std::vector<WakewordFrameBatch> getBatches() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_batches;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<WakewordFrameBatch> m_batches;
+};
+
+class WakewordPipelineTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_audioFormat.sampleRateHz = 16000;
+        m_audioFormat.sampleSizeInBits = 16;
+        m_audioFormat.numChannels = 1;
+        m_audioFormat.endianness = AudioFormat::Endianness::LITTLE;
+        m_audioFormat.encoding = AudioFormat::Encoding::LPCM;
+        m_audioFormat.layout = AudioFormat::Layout::INTERLEAVED;
+
+        m_stream = createStream();
+        m_writer = m_stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    }
+
+    static std::shared_ptr<AudioInputStream> createStream() {
+        auto size = AudioInputStream::calculateBufferSize(16000, sizeof(int16_t), 2);
+        auto buffer = std::make_shared<AudioInputStream::Buffer>(size);
+        return AudioInputStream::create(buffer, sizeof(int16_t), 2);
+    }
+
+    void writeFrames(size_t count, int16_t amplitude) {
+        std::vector<int16_t> samples(count * FRAME_SIZE);
+        for (size_t j = 0; j < samples.size(); j++) {
+            samples[j] = static_cast<int16_t>(j % 2 == 0 ? amplitude : -amplitude);
+        }
+        ASSERT_EQ(m_writer->write(samples.data(), samples.size()), static_cast<ssize_t>(samples.size()));
+    }
+
+protected:
+    AudioFormat m_audioFormat;
+    std::shared_ptr<AudioInputStream> m_stream;
+    std::unique_ptr<AudioInputStream::Writer> m_writer;
+};
+
+TEST_F(WakewordPipelineTest, deliversBatchesToAllConsumers) {
+    auto pipeline = WakewordPipeline::create(m_stream, m_audioFormat);
+    ASSERT_NE(pipeline, nullptr);
+    auto first = std::make_shared<TestFrameConsumer>();
+    auto second = std::make_shared<TestFrameConsumer>();
+    EXPECT_TRUE(pipeline->addConsumer(first));
+    EXPECT_TRUE(pipeline->addConsumer(second));
+    EXPECT_FALSE(pipeline->addConsumer(second));
+
+    // 10 frames are delivered in 2 batches, in writes that don't end on a frame
+    std::vector<int16_t> samples(10 * FRAME_SIZE);
+    std::iota(samples.begin(), samples.end(), 0);
+    ASSERT_EQ(m_writer->write(samples.data(), 250), 250);
+    ASSERT_EQ(m_writer->write(samples.data() + 250, samples.size() - 250), static_cast<ssize_t>(samples.size() - 250));
+    ASSERT_TRUE(first->waitForBatches(2));
+    ASSERT_TRUE(second->waitForBatches(2));
+
+    for (auto& consumer : {first, second}) {
+        auto batches = consumer->getBatches();
+        ASSERT_EQ(batches.size(), 2u);
+        for (size_t j = 0; j < batches.size(); j++) {
+            EXPECT_EQ(batches[j].beginIndex, j * 5 * FRAME_SIZE);
+            EXPECT_EQ(batches[j].frameSize, FRAME_SIZE);
+            EXPECT_EQ(batches[j].frameCount, 5u);
+            EXPECT_EQ(batches[j].featureSize, 0u);
+            EXPECT_EQ(
+                batches[j].samples,
+                std::vector<int16_t>(samples.begin() + j * 5 * FRAME_SIZE, samples.begin() + (j + 1) * 5 * FRAME_SIZE));
+            EXPECT_EQ(batches[j].voiceActivity, std::vector<bool>(5, true));
+        }
+    }
+
+    // a removed consumer is not called again
+    EXPECT_TRUE(pipeline->removeConsumer(second));
+    EXPECT_FALSE(pipeline->removeConsumer(second));
+    writeFrames(5, 0);
+    ASSERT_TRUE(first->waitForBatches(3));
+    EXPECT_EQ(second->getBatches().size(), 2u);
+    pipeline->shutdown();
+}
+
+TEST_F(WakewordPipelineTest, detectsVoiceActivityAndComputesFeatures) {
+    WakewordPipeline::Config config;
+    config.framesPerBatch = 4;
+    config.vadEnabled = true;
+    config.vadThreshold = -45.0f;
+    config.featureSize = 2;
+    config.featureExtractor = [](const int16_t* frame, size_t frameSize, float* features) {
+        features[0] = frame[0];
+        features[1] = static_cast<float>(frameSize);
+    };
+    auto pipeline = WakewordPipeline::create(m_stream, m_audioFormat, config);
+    ASSERT_NE(pipeline, nullptr);
+    auto consumer = std::make_shared<TestFrameConsumer>();
+    EXPECT_TRUE(pipeline->addConsumer(consumer));
+
+    // -60 dBFS of noise, then -30 dBFS of speech
+    writeFrames(2, 33);
+    writeFrames(2, 1036);
+    ASSERT_TRUE(consumer->waitForBatches(1));
+
+    auto batch = consumer->getBatches()[0];
+    EXPECT_EQ(batch.frameCount, 4u);
+    EXPECT_EQ(batch.voiceActivity, (std::vector<bool>{false, false, true, true}));
+    ASSERT_EQ(batch.levels.size(), 4u);
+    EXPECT_NEAR(batch.levels[0], -60.0f, 0.1f);
+    EXPECT_NEAR(batch.levels[3], -30.0f, 0.1f);
+    EXPECT_EQ(batch.featureSize, 2u);
+    EXPECT_EQ(batch.features, (std::vector<float>{33, 160, 33, 160, 1036, 160, 1036, 160}));
+}
+
+TEST_F(WakewordPipelineTest, rejectsInvalidConfiguration) {
+    WakewordPipeline::Config config;
+    config.framesPerBatch = 0;
+    EXPECT_EQ(WakewordPipeline::create(m_stream, m_audioFormat, config), nullptr);
+
+    config = WakewordPipeline::Config();
+    config.featureExtractor = [](const int16_t* frame, size_t frameSize, float* features) {};
+    EXPECT_EQ(WakewordPipeline::create(m_stream, m_audioFormat, config), nullptr);
+
+    auto stereo = m_audioFormat;
+    stereo.numChannels = 2;
+    EXPECT_EQ(WakewordPipeline::create(m_stream, stereo), nullptr);
+    EXPECT_EQ(WakewordPipeline::create(nullptr, m_audioFormat), nullptr);
+}
+
+TEST_F(WakewordPipelineTest, managerSharesPipelinePerStream) {
+    WakewordEngineManager manager;
+    auto pipeline = manager.getPipeline(m_stream, m_audioFormat);
+    ASSERT_NE(pipeline, nullptr);
+    EXPECT_EQ(manager.getPipeline(m_stream, m_audioFormat), pipeline);
+    EXPECT_EQ(pipeline->getStream(), m_stream);
+
+    auto otherStream = createStream();
+    auto otherPipeline = manager.getPipeline(otherStream, m_audioFormat);
+    ASSERT_NE(otherPipeline, nullptr);
+    EXPECT_NE(otherPipeline, pipeline);
+
+    // a pipeline that is no longer held is created again
+    pipeline.reset();
+    pipeline = manager.getPipeline(m_stream, m_audioFormat);
+    ASSERT_NE(pipeline, nullptr);
+    EXPECT_EQ(manager.getPipeline(nullptr, m_audioFormat), nullptr);
+}
@@ -17,12 +17,14 @@
 #include <AACE/Engine/Core/EngineMacros.h>
 
 #include <AASB/Message/APL/APL/ActivityEvent.h>
+#include <AASB/Message/APL/APL/CachePackageMessage.h>
 #include <AASB/Message/APL/APL/ClearAllExecuteCommandsMessage.h>
 #include <AASB/Message/APL/APL/ClearCardMessage.h>
 #include <AASB/Message/APL/APL/ClearDocumentMessage.h>
 #include <AASB/Message/APL/APL/DataSourceUpdateMessage.h>
 #include <AASB/Message/APL/APL/ExecuteCommandsMessage.h>
 #include <AASB/Message/APL/APL/ExecuteCommandsResultMessage.h>
+#include <AASB/Message/APL/APL/GetCachedPackageMessage.h>
 #include <AASB/Message/APL/APL/InterruptCommandSequenceMessage.h>
 #include <AASB/Message/APL/APL/ProcessActivityEventMessage.h>
 #include <AASB/Message/APL/APL/RenderDocumentMessage.h>
@@ -281,6 +283,44 @@ bool AASBAPL::initialize(std::shared_ptr<aace::engine::messageBroker::MessageBro
                 }
             });
 
+        messageBroker->subscribe(
+            aasb::message::apl::apl::CachePackageMessage::topic(),
+            aasb::message::apl::apl::CachePackageMessage::action(),
+            [wp](const Message& message) {
+                try {
+                    auto sp = wp.lock();
+                    ThrowIfNull(sp, "invalidWeakPtrReference");
+                    aasb::message::apl::apl::CachePackageMessage::Payload payload =
+                        nlohmann::json::parse(message.payload());
+
+                    sp->cachePackage(payload.name, payload.version, payload.content);
+                } catch (std::exception& ex) {
+                    AACE_ERROR(LX(TAG, "CachePackageMessage").d("reason", ex.what()));
+                }
+            });
+
+        messageBroker->subscribe(
+            aasb::message::apl::apl::GetCachedPackageMessage::topic(),
+            aasb::message::apl::apl::GetCachedPackageMessage::action(),
+            [wp](const Message& message) {
+                try {
+                    auto sp = wp.lock();
+                    ThrowIfNull(sp, "invalidWeakPtrReference");
+                    aasb::message::apl::apl::GetCachedPackageMessage::Payload payload =
+                        nlohmann::json::parse(message.payload());
+
+                    auto m_messageBroker_lock = sp->m_messageBroker.lock();
+                    ThrowIfNull(m_messageBroker_lock, "invalidMessageBrokerReference");
+
+                    aasb::message::apl::apl::GetCachedPackageMessageReply getCachedPackageMessageReply;
+                    getCachedPackageMessageReply.header.messageDescription.replyToId = message.messageId();
+                    getCachedPackageMessageReply.payload.content = sp->getCachedPackage(payload.name, payload.version);
+                    m_messageBroker_lock->publish(getCachedPackageMessageReply.toString()).send();
+                } catch (std::exception& ex) {
+                    AACE_ERROR(LX(TAG, "GetCachedPackageMessage").d("reason", ex.what()));
+                }
+            });
+
         return true;
 
     } catch (std::exception& ex) {
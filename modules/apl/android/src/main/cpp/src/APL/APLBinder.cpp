@@ -331,4 +331,40 @@ JNIEXPORT void JNICALL Java_com_amazon_aace_apl_APL_setPlatformProperty(
         AACE_JNI_ERROR(TAG, __func__, ex.what());
     }
 }
+
+JNIEXPORT void JNICALL Java_com_amazon_aace_apl_APL_cachePackage(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong ref,
+    jstring name,
+    jstring version,
+    jstring content) {
+    try {
+        auto aplBinder = APL_BINDER(ref);
+        ThrowIfNull(aplBinder, "invalidAPLBinder");
+
+        aplBinder->getAPL()->cachePackage(
+            JString(name).toStdStr(), JString(version).toStdStr(), JString(content).toStdStr());
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, __func__, ex.what());
+    }
+}
+
+JNIEXPORT jstring JNICALL Java_com_amazon_aace_apl_APL_getCachedPackage(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong ref,
+    jstring name,
+    jstring version) {
+    try {
+        auto aplBinder = APL_BINDER(ref);
+        ThrowIfNull(aplBinder, "invalidAPLBinder");
+
+        return JString(aplBinder->getAPL()->getCachedPackage(JString(name).toStdStr(), JString(version).toStdStr()))
+            .get();
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, __func__, ex.what());
+        return JString().get();
+    }
+}
 }
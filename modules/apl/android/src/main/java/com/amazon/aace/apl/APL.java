@@ -137,7 +137,8 @@ abstract public class APL extends PlatformInterface {
     /**
      * Notifies the platform implementation of APL runtime environment properties that must be updated.
      * The Engine will generate these values based on the @c setAPLProperty() values. The APL runtime
-     * will be affected by these values.
+     * will be affected by these values. The first update contains all the properties, and later
+     * updates contain only the properties whose values changed.
      *
      * @param [in] properties A JSON object in string form containing the APL runtime properties that need
      * to be updated.
@@ -306,6 +307,31 @@ abstract public class APL extends PlatformInterface {
         setPlatformProperty(getNativeRef(), name, value);
     }
 
+    /**
+     * Notifies the Engine of the content of a package imported by a rendered APL document. The Engine caches the
+     * content, so a later render importing the same package can get it with @c getCachedPackage() instead of
+     * fetching it again.
+     *
+     * @param [in] name The name of the package, such as "alexa-layouts".
+     * @param [in] version The version of the package.
+     * @param [in] content The content of the package.
+     */
+    final protected void cachePackage(String name, String version, String content) {
+        cachePackage(getNativeRef(), name, version, content);
+    }
+
+    /**
+     * Gets the content of a package cached with @c cachePackage(). The least recently used packages are evicted
+     * when the cache is full, so the platform implementation must be able to fetch a package that is not cached.
+     *
+     * @param [in] name The name of the package.
+     * @param [in] version The version of the package.
+     * @return The content of the package, or an empty string if the package is not cached.
+     */
+    final protected String getCachedPackage(String name, String version) {
+        return getCachedPackage(getNativeRef(), name, version);
+    }
+
     // NativeRef implementation
     final protected long createNativeRef() {
         return createBinder();
@@ -331,4 +357,6 @@ abstract public class APL extends PlatformInterface {
     private native void sendDocumentState(long nativeRef, String state);
     private native void sendDeviceWindowState(long nativeRef, String state);
     private native void setPlatformProperty(long nativeRef, String name, String value);
+    private native void cachePackage(long nativeRef, String name, String version, String content);
+    private native String getCachedPackage(long nativeRef, String name, String version);
 }
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_APL_APL_CONTENT_CACHE_H
+#define AACE_ENGINE_APL_APL_CONTENT_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace apl {
+
+/**
+ * Keeps the content of the APL documents and packages the renderer imported, so the next render that imports them
+ * starts from the cached content instead of fetching it again.
+ *
+ * The content is addressed by its hash, so a package cached under several names or versions is stored once. The
+ * least recently used content is evicted when the cache would exceed its size.
+ */
+class APLContentCache {
+public:
+    /// The default size of the cache, in bytes
+    static const size_t DEFAULT_MAX_SIZE;
+
+    /**
+     * Creates a content cache.
+     *
+     * @param maxSize The most bytes of content the cache keeps, more than 0.
+     */
+    static std::shared_ptr<APLContentCache> create(size_t maxSize = DEFAULT_MAX_SIZE);
+
+    /**
+     * Adds content to the cache.
+     *
+     * @param content The content.
+     * @return The key of the content, or an empty string if the content is empty or larger than the cache.
+     */
+    std::string put(const std::string& content);
+
+    /**
+     * Gets content from the cache, and marks it as the most recently used.
+     *
+     * @param key The key of the content.
+     * @param [out] content The content.
+     * @return @c true if the content is cached.
+     */
+    bool get(const std::string& key, std::string& content);
+
+    /**
+     * Adds the content of a package to the cache.
+     *
+     * @param name The name of the package.
+     * @param version The version of the package.
+     * @param content The content of the package.
+     * @return @c true if the package is cached.
+     */
+    bool putPackage(const std::string& name, const std::string& version, const std::string& content);
+
+    /**
+     * Gets the content of a package from the cache, and marks it as the most recently used.
+     *
+     * @param name The name of the package.
+     * @param version The version of the package.
+     * @param [out] content The content of the package.
+     * @return @c true if the package is cached.
+     */
+    bool getPackage(const std::string& name, const std::string& version, std::string& content);
+
+    /**
+     * Removes all the content from the cache.
+     */
+    void clear();
+
+    /// The bytes of content in the cache
+    size_t getSize();
+
+    size_t getMaxSize() const;
+
+    /**
+     * Computes the key of content.
+     *
+     * @param content The content.
+     * @return The key, which is the 64-bit FNV-1a hash of the content and its size.
+     */
+    static std::string computeKey(const std::string& content);
+
+private:
+    APLContentCache(size_t maxSize);
+
+    /// Cached content, and the package ids it is cached under
+    struct Entry {
+        std::string key;
+        std::string content;
+        std::vector<std::string> packageIds;
+    };
+
+    /// Adds content to the cache, without locking it
+    std::list<Entry>::iterator putLocked(const std::string& content);
+
+    /// Evicts the least recently used content until @c size more bytes fit in the cache, without locking it
+    void evictLocked(size_t size);
+
+    /// Returns the id of a package
+    static std::string getPackageId(const std::string& name, const std::string& version);
+
+    const size_t m_maxSize;
+
+    /// The bytes of content in the cache
+    size_t m_size;
+
+    /// The cached content, the most recently used first
+    std::list<Entry> m_entries;
+
+    /// A map of key to the cached content
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_entriesByKey;
+
+    /// A map of package id to the key of its content
+    std::unordered_map<std::string, std::string> m_packageKeys;
+
+    /// Serializes the access to the cache
+    std::mutex m_mutex;
+};
+
+}  // namespace apl
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_APL_APL_CONTENT_CACHE_H
@@ -31,6 +31,7 @@
 
 #include "AACE/APL/APL.h"
 #include "AACE/APL/APLEngineInterface.h"
+#include "AACE/Engine/APL/APLContentCache.h"
 #include "AACE/Engine/APL/APLRuntimePropertyGenerator.h"
 
 namespace aace {
@@ -45,7 +46,9 @@ class APLEngineImpl
         , public alexaClientSDK::avsCommon::utils::RequiresShutdown
         , public std::enable_shared_from_this<APLEngineImpl> {
 private:
-    APLEngineImpl(std::shared_ptr<aace::apl::APL> aplPlatformInterface);
+    APLEngineImpl(
+        std::shared_ptr<aace::apl::APL> aplPlatformInterface,
+        std::shared_ptr<APLContentCache> contentCache);
 
     bool initialize(
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::endpoints::EndpointCapabilitiesRegistrarInterface>
@@ -67,7 +70,8 @@ public:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-        std::shared_ptr<alexaClientSDK::avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator);
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
+        std::shared_ptr<APLContentCache> contentCache = nullptr);
 
     // AlexaPresentationObserverInterface
     virtual void renderDocument(const std::string& jsonPayload, const std::string& token, const std::string& windowId)
@@ -103,6 +107,9 @@ public:
     virtual void onSendDocumentState(const std::string& state) override;
     virtual void onSendDeviceWindowState(const std::string& state) override;
     virtual void onSetPlatformProperty(const std::string& name, const std::string& value) override;
+    virtual void onCachePackage(const std::string& name, const std::string& version, const std::string& content)
+        override;
+    virtual std::string onGetCachedPackage(const std::string& name, const std::string& version) override;
 
     // FocusManagerObserverInterface
     virtual void onFocusChanged(const std::string& channelName, alexaClientSDK::avsCommon::avs::FocusState newFocus)
@@ -138,6 +145,9 @@ private:
     /// APL Runtime Property Generator
     APLRuntimePropertyGenerator m_aplRuntimePropertyGenerator;
 
+    /// The cache of the packages imported by the rendered documents
+    std::shared_ptr<APLContentCache> m_contentCache;
+
     /// Stop dialog channel
     bool m_stopDialog;
 };
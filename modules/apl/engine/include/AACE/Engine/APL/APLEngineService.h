@@ -37,6 +37,7 @@ public:
     virtual ~APLEngineService() = default;
 
 protected:
+    bool configureFromJson(const aace::engine::utils::json::Value& configuration) override;
     bool start() override;
     bool stop() override;
     bool shutdown() override;
@@ -54,6 +55,9 @@ private:
 
 private:
     std::shared_ptr<aace::engine::apl::APLEngineImpl> m_aplEngineImpl;
+
+    /// The size of the package cache, in bytes
+    size_t m_packageCacheMaxSize = APLContentCache::DEFAULT_MAX_SIZE;
 };
 
 }  // namespace apl
@@ -16,6 +16,7 @@
 #ifndef AACE_ENGINE_APL_APL_RUNTIME_PROPERTY_GENERATOR_H
 #define AACE_ENGINE_APL_APL_RUNTIME_PROPERTY_GENERATOR_H
 
+#include <string>
 #include <unordered_map>
 
 namespace aace {
@@ -26,16 +27,52 @@ namespace apl {
  * This class handles translating vehicle properties such as driving state
  * and UI contrast (day/night) into APL runtime properties. The APL runtime
  * properties are used to affect how the APL experience is rendered. 
+ *
+ * The runtime properties are regenerated only when a platform property
+ * changes, and the serialized properties are cached until then.
  */
 class APLRuntimePropertyGenerator {
 public:
     APLRuntimePropertyGenerator();
 
-    void handleProperty(const std::string& name, const std::string& value);
+    /**
+     * Sets the value of a platform property.
+     *
+     * @return @c true if the value of the property changed
+     */
+    bool handleProperty(const std::string& name, const std::string& value);
+
+    /**
+     * Returns all the APL runtime properties as a JSON object in string form.
+     */
     std::string getAPLRuntimeProperties();
 
+    /**
+     * Returns the APL runtime properties that changed since the last call,
+     * or all of them on the first call, as a JSON object in string form.
+     *
+     * @return The changed properties, or an empty string if none changed
+     */
+    std::string getChangedAPLRuntimeProperties();
+
 private:
+    /// Regenerates the APL runtime properties from the platform properties, if one changed
+    void generateAPLRuntimeProperties();
+
+    /// The platform properties, by name
     std::unordered_map<std::string, std::string> m_platformProperties;
+
+    /// The APL runtime properties, by name
+    std::unordered_map<std::string, std::string> m_aplRuntimeProperties;
+
+    /// The APL runtime properties returned by the last @c getChangedAPLRuntimeProperties() call
+    std::unordered_map<std::string, std::string> m_reportedAPLRuntimeProperties;
+
+    /// The serialized APL runtime properties
+    std::string m_serializedAPLRuntimeProperties;
+
+    /// Whether a platform property changed since the APL runtime properties were generated
+    bool m_stale;
 };
 
 }  // namespace apl
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+#include <AACE/Engine/Core/EngineMacros.h>
+
+#include "AACE/Engine/APL/APLContentCache.h"
+
+namespace aace {
+namespace engine {
+namespace apl {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.apl.APLContentCache");
+
+/// FNV-1a 64-bit offset basis
+static const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+
+/// FNV-1a 64-bit prime
+static const uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+const size_t APLContentCache::DEFAULT_MAX_SIZE = 4 * 1024 * 1024;
+
+std::shared_ptr<APLContentCache> APLContentCache::create(size_t maxSize) {
+    try {
+        ThrowIf(maxSize == 0, "invalidMaxSize");
+        return std::shared_ptr<APLContentCache>(new APLContentCache(maxSize));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("maxSize", maxSize).d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+APLContentCache::APLContentCache(size_t maxSize) : m_maxSize(maxSize), m_size(0) {
+}
+
+std::string APLContentCache::put(const std::string& content) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = putLocked(content);
+    return it != m_entries.end() ? it->key : "";
+}
+
+bool APLContentCache::get(const std::string& key, std::string& content) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entriesByKey.find(key);
+    if (it == m_entriesByKey.end()) {
+        return false;
+    }
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    content = it->second->content;
+    return true;
+}
+
+bool APLContentCache::putPackage(const std::string& name, const std::string& version, const std::string& content) {
+    try {
+        ThrowIf(name.empty(), "invalidName");
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto packageId = getPackageId(name, version);
+
+        // the package is cached again only if its content changed
+        auto packageKey = m_packageKeys.find(packageId);
+        if (packageKey != m_packageKeys.end()) {
+            auto entry = m_entriesByKey.find(packageKey->second);
+            if (entry != m_entriesByKey.end() && entry->second->content == content) {
+                m_entries.splice(m_entries.begin(), m_entries, entry->second);
+                return true;
+            }
+            if (entry != m_entriesByKey.end()) {
+                auto& packageIds = entry->second->packageIds;
+                packageIds.erase(std::remove(packageIds.begin(), packageIds.end(), packageId), packageIds.end());
+            }
+            m_packageKeys.erase(packageKey);
+        }
+
+        auto it = putLocked(content);
+        ThrowIf(it == m_entries.end(), "contentNotCached");
+        it->packageIds.push_back(packageId);
+        m_packageKeys[packageId] = it->key;
+        return true;
+    } catch (std::exception& ex) {
+        AACE_WARN(LX(TAG, "putPackage").d("name", name).d("version", version).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool APLContentCache::getPackage(const std::string& name, const std::string& version, std::string& content) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto packageKey = m_packageKeys.find(getPackageId(name, version));
+    if (packageKey == m_packageKeys.end()) {
+        return false;
+    }
+    auto& entry = m_entriesByKey.at(packageKey->second);
+    m_entries.splice(m_entries.begin(), m_entries, entry);
+    content = entry->content;
+    return true;
+}
+
+void APLContentCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_entriesByKey.clear();
+    m_packageKeys.clear();
+    m_size = 0;
+}
+
+size_t APLContentCache::getSize() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+size_t APLContentCache::getMaxSize() const {
+    return m_maxSize;
+}
+
+std::string APLContentCache::computeKey(const std::string& content) {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= FNV_PRIME;
+    }
+    char key[40];
+    std::snprintf(
+        key,
+        sizeof(key),
+        "%016llx-%llx",
+        static_cast<unsigned long long>(hash),
+        static_cast<unsigned long long>(content.size()));
+    return key;
+}
+
+std::list<APLContentCache::Entry>::iterator APLContentCache::putLocked(const std::string& content) {
+    if (content.empty() || content.size() > m_maxSize) {
+        AACE_WARN(LX(TAG, "put").d("reason", "invalidContentSize").d("size", content.size()));
+        return m_entries.end();
+    }
+
+    auto key = computeKey(content);
+    auto it = m_entriesByKey.find(key);
+    if (it != m_entriesByKey.end()) {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second;
+    }
+
+    evictLocked(content.size());
+    m_entries.push_front({key, content, {}});
+    m_entriesByKey[key] = m_entries.begin();
+    m_size += content.size();
+    return m_entries.begin();
+}
+
+void APLContentCache::evictLocked(size_t size) {
+    while (!m_entries.empty() && m_size + size > m_maxSize) {
+        auto& entry = m_entries.back();
+        AACE_DEBUG(LX(TAG, "evict").d("key", entry.key).d("packageCount", entry.packageIds.size()));
+        for (const auto& packageId : entry.packageIds) {
+            m_packageKeys.erase(packageId);
+        }
+        m_size -= entry.content.size();
+        m_entriesByKey.erase(entry.key);
+        m_entries.pop_back();
+    }
+}
+
+std::string APLContentCache::getPackageId(const std::string& name, const std::string& version) {
+    return name + "@" + version;
+}
+
+}  // namespace apl
+}  // namespace engine
+}  // namespace aace
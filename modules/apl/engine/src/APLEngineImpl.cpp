@@ -51,8 +51,13 @@ static const std::string METRIC_APL_RENDER_DOCUMENT_RESULT = "RenderDocumentResu
 static const std::string METRIC_APL_EXECUTE_COMMANDS_RESULT = "ExecuteCommandsResult";
 static const std::string METRIC_APL_PROCESS_ACTIVITY_EVENT = "ProcessActivityEvent";
 
-APLEngineImpl::APLEngineImpl(std::shared_ptr<aace::apl::APL> aplPlatformInterface) :
-        avsCommon::utils::RequiresShutdown(TAG), m_aplPlatformInterface(aplPlatformInterface), m_stopDialog(false) {
+APLEngineImpl::APLEngineImpl(
+    std::shared_ptr<aace::apl::APL> aplPlatformInterface,
+    std::shared_ptr<APLContentCache> contentCache) :
+        avsCommon::utils::RequiresShutdown(TAG),
+        m_aplPlatformInterface(aplPlatformInterface),
+        m_contentCache(contentCache),
+        m_stopDialog(false) {
 }
 
 bool APLEngineImpl::initialize(
@@ -110,13 +115,19 @@ std::shared_ptr<APLEngineImpl> APLEngineImpl::create(
     std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
     std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-    std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator) {
+    std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
+    std::shared_ptr<APLContentCache> contentCache) {
     AACE_DEBUG(LX(TAG));
     try {
         ThrowIfNull(aplPlatformInterface, "invalidAPLPlatformInterface");
 
+        if (contentCache == nullptr) {
+            contentCache = APLContentCache::create();
+            ThrowIfNull(contentCache, "createContentCacheFailed");
+        }
+
         std::shared_ptr<APLEngineImpl> aplEngineImpl =
-            std::shared_ptr<APLEngineImpl>(new APLEngineImpl(aplPlatformInterface));
+            std::shared_ptr<APLEngineImpl>(new APLEngineImpl(aplPlatformInterface, contentCache));
         ThrowIfNot(
             aplEngineImpl->initialize(
                 capabilitiesRegistrar,
@@ -340,13 +351,30 @@ void APLEngineImpl::onSendDeviceWindowState(const std::string& state) {
 void APLEngineImpl::onSetPlatformProperty(const std::string& name, const std::string& value) {
     AACE_INFO(LX(TAG).d("name", name).d("value", value));
     m_executor.submit([this, name, value]() {
-        m_aplRuntimePropertyGenerator.handleProperty(name, value);
-        executeUpdateRuntimeProperties();
+        if (m_aplRuntimePropertyGenerator.handleProperty(name, value)) {
+            executeUpdateRuntimeProperties();
+        }
     });
 }
 
+void APLEngineImpl::onCachePackage(const std::string& name, const std::string& version, const std::string& content) {
+    AACE_DEBUG(LX(TAG).d("name", name).d("version", version).d("size", content.size()));
+    m_contentCache->putPackage(name, version, content);
+}
+
+std::string APLEngineImpl::onGetCachedPackage(const std::string& name, const std::string& version) {
+    std::string content;
+    bool cached = m_contentCache->getPackage(name, version, content);
+    AACE_DEBUG(LX(TAG).d("name", name).d("version", version).d("cached", cached));
+    return content;
+}
+
 void APLEngineImpl::executeUpdateRuntimeProperties() {
-    auto properties = m_aplRuntimePropertyGenerator.getAPLRuntimeProperties();
+    // only the runtime properties that changed are sent, so the renderer is not updated for nothing
+    auto properties = m_aplRuntimePropertyGenerator.getChangedAPLRuntimeProperties();
+    if (properties.empty()) {
+        return;
+    }
     m_aplPlatformInterface->updateAPLRuntimeProperties(properties);
     AACE_INFO(LX(TAG).d("aplRuntimeProperties", properties));
 }
@@ -27,6 +27,12 @@ namespace apl {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.apl.APLEngineService");
 
+/// The configuration key of the package cache
+static const std::string CONFIG_KEY_PACKAGE_CACHE("packageCache");
+
+/// The configuration key of the size of the package cache
+static const std::string CONFIG_KEY_PACKAGE_CACHE_MAX_SIZE("maxSize");
+
 // register the service
 REGISTER_SERVICE(APLEngineService);
 
@@ -34,6 +40,24 @@ APLEngineService::APLEngineService(const aace::engine::core::ServiceDescription&
         aace::engine::core::EngineService(description) {
 }
 
+bool APLEngineService::configureFromJson(const aace::engine::utils::json::Value& configuration) {
+    try {
+        auto packageCache = configuration.find(CONFIG_KEY_PACKAGE_CACHE);
+        if (packageCache != configuration.end() && packageCache->is_object()) {
+            auto maxSize = packageCache->find(CONFIG_KEY_PACKAGE_CACHE_MAX_SIZE);
+            if (maxSize != packageCache->end()) {
+                ThrowIfNot(maxSize->is_number_unsigned() && *maxSize > 0, "invalidPackageCacheMaxSize");
+                m_packageCacheMaxSize = *maxSize;
+            }
+            AACE_DEBUG(LX(TAG).d("packageCacheMaxSize", m_packageCacheMaxSize));
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool APLEngineService::start() {
     return true;
 }
@@ -91,6 +115,9 @@ bool APLEngineService::registerPlatformInterfaceType(std::shared_ptr<aace::apl::
         auto dialogUXStateAggregator = alexaComponents->getDialogUXStateAggregator();
         ThrowIfNull(dialogUXStateAggregator, "dialogUXStateAggregatorInvalid");
 
+        auto contentCache = APLContentCache::create(m_packageCacheMaxSize);
+        ThrowIfNull(contentCache, "createContentCacheFailed");
+
         m_aplEngineImpl = aace::engine::apl::APLEngineImpl::create(
             apl,
             defaultCapabilitiesRegistrar,
@@ -99,7 +126,8 @@ bool APLEngineService::registerPlatformInterfaceType(std::shared_ptr<aace::apl::
             exceptionSender,
             messageSender,
             contextManager,
-            dialogUXStateAggregator);
+            dialogUXStateAggregator,
+            contentCache);
         ThrowIfNull(m_aplEngineImpl, "createAPLEngineImplFailed");
 
         return true;
@@ -48,17 +48,50 @@ static const std::string DARK("dark");
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.apl.APLRuntimePropertyGenerator");
 
-APLRuntimePropertyGenerator::APLRuntimePropertyGenerator() {
+APLRuntimePropertyGenerator::APLRuntimePropertyGenerator() : m_stale(true) {
     m_platformProperties[DRIVING_STATE] = MOVING;
     m_platformProperties[UI_MODE] = DAY;
     m_platformProperties[THEME_ID] = "";
 }
 
-void APLRuntimePropertyGenerator::handleProperty(const std::string& name, const std::string& value) {
+bool APLRuntimePropertyGenerator::handleProperty(const std::string& name, const std::string& value) {
+    auto it = m_platformProperties.find(name);
+    if (it != m_platformProperties.end() && it->second == value) {
+        return false;
+    }
     m_platformProperties[name] = value;
+    m_stale = true;
+    return true;
 }
 
 std::string APLRuntimePropertyGenerator::getAPLRuntimeProperties() {
+    generateAPLRuntimeProperties();
+    return m_serializedAPLRuntimeProperties;
+}
+
+std::string APLRuntimePropertyGenerator::getChangedAPLRuntimeProperties() {
+    generateAPLRuntimeProperties();
+
+    json::Value properties = json::Value::object();
+    for (const auto& property : m_aplRuntimeProperties) {
+        auto it = m_reportedAPLRuntimeProperties.find(property.first);
+        if (it == m_reportedAPLRuntimeProperties.end() || it->second != property.second) {
+            properties[property.first] = property.second;
+        }
+    }
+    if (properties.empty()) {
+        return "";
+    }
+    m_reportedAPLRuntimeProperties = m_aplRuntimeProperties;
+
+    return properties.size() == m_aplRuntimeProperties.size() ? m_serializedAPLRuntimeProperties : properties.dump();
+}
+
+void APLRuntimePropertyGenerator::generateAPLRuntimeProperties() {
+    if (!m_stale) {
+        return;
+    }
+
     json::Value properties;
 
     std::string drivingState = m_platformProperties.at(DRIVING_STATE);
@@ -67,7 +100,7 @@ std::string APLRuntimePropertyGenerator::getAPLRuntimeProperties() {
     std::string video = drivingState == PARKED ? ENABLED : DISABLED;
 
     // To keep the API flexible warn on unknown values only
-    if (drivingState != PARKED || drivingState != MOVING) {
+    if (drivingState != PARKED && drivingState != MOVING) {
         AACE_WARN(LX(TAG).d("drivingStateUnknownValue", drivingState));
     }
 
@@ -77,11 +110,16 @@ std::string APLRuntimePropertyGenerator::getAPLRuntimeProperties() {
     }
 
     // Create properties for the APL runtime
+    m_aplRuntimeProperties[APL_DRIVING_STATE] = drivingState;
+    m_aplRuntimeProperties[APL_THEME] = theme;
+    m_aplRuntimeProperties[APL_VIDEO] = video;
+
     properties[APL_DRIVING_STATE] = drivingState;
     properties[APL_THEME] = theme;
     properties[APL_VIDEO] = video;
 
-    return properties.dump();
+    m_serializedAPLRuntimeProperties = properties.dump();
+    m_stale = false;
 }
 
 }  // namespace apl
@@ -105,7 +105,8 @@ public:
     /**
      * Notifies the platform implementation of APL runtime environment properties that must be updated.
      * The Engine will generate these values based on the @c setAPLProperty() values. The APL runtime
-     * will be affected by these values.
+     * will be affected by these values. The first update contains all the properties, and later
+     * updates contain only the properties whose values changed.
      *
      * @param [in] properties A JSON object in string form containing the APL runtime properties that need
      * to be updated.
@@ -255,6 +256,27 @@ public:
      */
     void setPlatformProperty(const std::string& name, const std::string& value);
 
+    /**
+     * Notifies the Engine of the content of a package imported by a rendered APL document. The Engine caches the
+     * content, so a later render importing the same package can get it with @c getCachedPackage() instead of
+     * fetching it again.
+     *
+     * @param [in] name The name of the package, such as "alexa-layouts".
+     * @param [in] version The version of the package.
+     * @param [in] content The content of the package.
+     */
+    void cachePackage(const std::string& name, const std::string& version, const std::string& content);
+
+    /**
+     * Gets the content of a package cached with @c cachePackage(). The least recently used packages are evicted
+     * when the cache is full, so the platform implementation must be able to fetch a package that is not cached.
+     *
+     * @param [in] name The name of the package.
+     * @param [in] version The version of the package.
+     * @return The content of the package, or an empty string if the package is not cached.
+     */
+    std::string getCachedPackage(const std::string& name, const std::string& version);
+
     /**
      * @internal
      * Sets the Engine interface delegate.
@@ -56,6 +56,8 @@ public:
     virtual void onSendDocumentState(const std::string& state) = 0;
     virtual void onSendDeviceWindowState(const std::string& state) = 0;
     virtual void onSetPlatformProperty(const std::string& name, const std::string& value) = 0;
+    virtual void onCachePackage(const std::string& name, const std::string& version, const std::string& content) = 0;
+    virtual std::string onGetCachedPackage(const std::string& name, const std::string& version) = 0;
 };
 
 }  // namespace apl
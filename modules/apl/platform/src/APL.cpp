@@ -102,5 +102,18 @@ void APL::setPlatformProperty(const std::string& name, const std::string& value)
     }
 }
 
+void APL::cachePackage(const std::string& name, const std::string& version, const std::string& content) {
+    if (m_aplEngineInterface != nullptr) {
+        m_aplEngineInterface->onCachePackage(name, version, content);
+    }
+}
+
+std::string APL::getCachedPackage(const std::string& name, const std::string& version) {
+    if (m_aplEngineInterface != nullptr) {
+        return m_aplEngineInterface->onGetCachedPackage(name, version);
+    }
+    return "";
+}
+
 }  // namespace apl
 }  // namespace aace
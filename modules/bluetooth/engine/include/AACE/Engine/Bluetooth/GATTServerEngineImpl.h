@@ -18,10 +18,12 @@
 
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include <AACE/Bluetooth/GATTServer.h>
 #include <AACE/Bluetooth/BluetoothEngineInterfaces.h>
+#include <nlohmann/json.hpp>
 
 #include "GATTService.h"
 #include "GATTServerInterface.h"
@@ -39,6 +41,15 @@ private:
 
     std::string createServiceConfiguration();
 
+    /// Builds the index of the services again, after the service list changed
+    void updateServiceIndex();
+
+    /// Returns the service with an id, or @c nullptr if no service has this id
+    std::shared_ptr<aace::engine::bluetooth::GATTService> findService(const std::string& serviceId);
+
+    /// Returns the id of a service in the form of the index keys, in upper case
+    static std::string normalizeId(const std::string& id);
+
 public:
     static std::shared_ptr<GATTServerEngineImpl> create(
         const std::shared_ptr<aace::bluetooth::GATTServer>& gattServerPlatformInterface);
@@ -54,6 +65,9 @@ public:
         const std::string& serviceId,
         const std::string& characteristicId,
         aace::bluetooth::ByteArrayPtr data) override;
+    bool setCharacteristicValues(
+        const std::string& serviceId,
+        std::vector<aace::bluetooth::GATTServer::CharacteristicValue> values) override;
 
     // aace::bluetooth::GATTServerEngineInterface
     void onConnectionStateChanged(const std::string& device, ConnectionState state) override;
@@ -74,6 +88,17 @@ public:
 private:
     std::shared_ptr<aace::bluetooth::GATTServer> m_gattServerPlatformInterface;
     std::vector<std::weak_ptr<aace::engine::bluetooth::GATTService>> m_serviceList;
+
+    /// The configuration of each service of m_serviceList, in the same order, read when the service is added
+    nlohmann::json m_serviceConfigurations;
+
+    /// The configuration the server starts with, built again only after a service is added or removed
+    std::string m_configuration;
+
+    /// The services of m_serviceList by normalized id. The requests are resolved on the thread of the platform
+    /// with one lookup in the current index, which is replaced as a whole when the service list changes.
+    using ServiceIndex = std::unordered_map<std::string, std::weak_ptr<aace::engine::bluetooth::GATTService>>;
+    std::shared_ptr<const ServiceIndex> m_serviceIndex;
 };
 
 }  // namespace bluetooth
@@ -19,8 +19,10 @@
 #include <string>
 #include <memory>
 #include <istream>
+#include <vector>
 
 #include <AACE/Bluetooth/ByteArray.h>
+#include <AACE/Bluetooth/GATTServer.h>
 
 namespace aace {
 namespace engine {
@@ -34,6 +36,10 @@ public:
         const std::string& serviceId,
         const std::string& characteristicId,
         aace::bluetooth::ByteArrayPtr data) = 0;
+
+    virtual bool setCharacteristicValues(
+        const std::string& serviceId,
+        std::vector<aace::bluetooth::GATTServer::CharacteristicValue> values) = 0;
 };
 
 }  // namespace bluetooth
@@ -39,6 +39,9 @@ public:
 
     bool setCharacteristicValue(const std::string& characteristicId, aace::bluetooth::ByteArrayPtr data);
 
+    /// Sets the values of several characteristics at once, such as when a companion app syncs many values.
+    bool setCharacteristicValues(std::vector<aace::bluetooth::GATTServer::CharacteristicValue> values);
+
     virtual std::string getConfiguration() = 0;
 
     virtual void connected(const std::string& device);
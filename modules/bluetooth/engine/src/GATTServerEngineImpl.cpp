@@ -14,9 +14,10 @@
  */
 
 #include <AACE/Engine/Bluetooth/GATTServerEngineImpl.h>
-#include <AACE/Engine/Utils/UUID/UUID.h>
 #include <AACE/Engine/Core/EngineMacros.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
 #include <utility>
 
 namespace aace {
@@ -27,7 +28,9 @@ namespace bluetooth {
 static const char* TAG("aace.bluetooth.GATTServerEngineImpl");
 
 GATTServerEngineImpl::GATTServerEngineImpl(std::shared_ptr<aace::bluetooth::GATTServer> gattServerPlatformInterface) :
-        m_gattServerPlatformInterface(std::move(gattServerPlatformInterface)) {
+        m_gattServerPlatformInterface(std::move(gattServerPlatformInterface)),
+        m_serviceConfigurations(nlohmann::json::array()),
+        m_serviceIndex(std::make_shared<const ServiceIndex>()) {
 }
 
 std::shared_ptr<GATTServerEngineImpl> GATTServerEngineImpl::create(
@@ -51,31 +54,56 @@ std::shared_ptr<GATTServerEngineImpl> GATTServerEngineImpl::create(
 
 std::string GATTServerEngineImpl::createServiceConfiguration() {
     try {
-        nlohmann::json configuration;
-
-        configuration["services"] = nlohmann::json::array();
-
-        // iterate through the service list and create the configuration json...
         for (auto& it : m_serviceList) {
-            if (auto serviceList_lock = it.lock()) {
-                nlohmann::json service;
-
-                service["id"] = serviceList_lock->getId();
-                service["configuration"] = nlohmann::json::parse(serviceList_lock->getConfiguration());
+            ThrowIf(it.expired(), "invalidServiceReference");
+        }
 
-                configuration["services"].push_back(service);
-            } else {
-                Throw("invalidServiceReference");
-            }
+        // the configuration of the services is only serialized again after the service list changed
+        if (m_configuration.empty()) {
+            nlohmann::json configuration;
+            configuration["services"] = m_serviceConfigurations;
+            m_configuration = configuration.dump(3);
         }
 
-        return configuration.dump(3);
+        return m_configuration;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return std::string();
     }
 }
 
+void GATTServerEngineImpl::updateServiceIndex() {
+    auto index = std::make_shared<ServiceIndex>();
+    for (auto& it : m_serviceList) {
+        if (auto service = it.lock()) {
+            // the first service with an id answers its requests, like when the list was searched in order
+            index->emplace(normalizeId(service->getId()), it);
+        }
+    }
+    std::atomic_store(&m_serviceIndex, std::shared_ptr<const ServiceIndex>(index));
+}
+
+std::shared_ptr<aace::engine::bluetooth::GATTService> GATTServerEngineImpl::findService(const std::string& serviceId) {
+    auto index = std::atomic_load(&m_serviceIndex);
+    auto it = index->find(normalizeId(serviceId));
+    if (it == index->end()) {
+        return nullptr;
+    }
+    auto service = it->second.lock();
+    if (service == nullptr) {
+        AACE_ERROR(LX(TAG).d("reason", "invalidServiceReference"));
+    }
+    return service;
+}
+
+std::string GATTServerEngineImpl::normalizeId(const std::string& id) {
+    std::string normalized(id);
+    std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](unsigned char c) -> char {
+        return static_cast<char>(std::toupper(c));
+    });
+    return normalized;
+}
+
 bool GATTServerEngineImpl::start() {
     try {
         ThrowIf(m_serviceList.empty(), "emptyServiceList");
@@ -115,9 +143,16 @@ bool GATTServerEngineImpl::restart() {
 bool GATTServerEngineImpl::addService(const std::shared_ptr<aace::engine::bluetooth::GATTService>& service) {
     try {
         ThrowIfNull(service, "invalidService");
+        nlohmann::json serviceConfiguration;
+        serviceConfiguration["id"] = service->getId();
+        serviceConfiguration["configuration"] = nlohmann::json::parse(service->getConfiguration());
+
         // TODO: we need to synchronize access to the list if there is any module
         // calling this method after engine initialization.
         m_serviceList.push_back(service);
+        m_serviceConfigurations.push_back(std::move(serviceConfiguration));
+        m_configuration.clear();
+        updateServiceIndex();
 
         // set the service's server interface
         service->setServerInterface(shared_from_this());
@@ -134,13 +169,16 @@ bool GATTServerEngineImpl::removeService(aace::engine::bluetooth::GATTService* s
         ThrowIfNull(service, "invalidService");
         // TODO: we need to synchronize access to the list if there is any module
         // calling this method after engine initialization.
-        for (auto it = m_serviceList.begin(); it != m_serviceList.end();) {
-            if (it->lock().get() == service) {
-                it = m_serviceList.erase(it);
+        for (size_t index = 0; index < m_serviceList.size();) {
+            if (m_serviceList[index].lock().get() == service) {
+                m_serviceList.erase(m_serviceList.begin() + index);
+                m_serviceConfigurations.erase(index);
+                m_configuration.clear();
             } else {
-                ++it;
+                ++index;
             }
         }
+        updateServiceIndex();
 
         // Restart after removing the service
         return restart();
@@ -166,6 +204,21 @@ bool GATTServerEngineImpl::setCharacteristicValue(
     }
 }
 
+bool GATTServerEngineImpl::setCharacteristicValues(
+    const std::string& serviceId,
+    std::vector<aace::bluetooth::GATTServer::CharacteristicValue> values) {
+    try {
+        AACE_DEBUG(LX(TAG).d("serviceId", serviceId).d("count", values.size()));
+        if (values.empty()) {
+            return true;
+        }
+        return m_gattServerPlatformInterface->setCharacteristicValues(serviceId, std::move(values));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
 //
 // aace::bluetooth::GATTServerEngineInterface
 //
@@ -195,17 +248,10 @@ bool GATTServerEngineImpl::onRequestCharacteristic(
     const std::string& characteristicId,
     aace::bluetooth::ByteArrayPtr data) {
     try {
-        for (auto& it : m_serviceList) {
-            if (auto m_service_lock = it.lock()) {
-                AACE_DEBUG(LX(TAG).d("service", m_service_lock->getId()));
-                if (aace::engine::utils::uuid::compare(m_service_lock->getId(), serviceId)) {
-                    return m_service_lock->requestCharacteristic(device, requestId, characteristicId, std::move(data));
-                }
-            } else {
-                AACE_ERROR(LX(TAG).d("reason", "invalidServiceReference"));
-            }
+        AACE_DEBUG(LX(TAG).d("service", serviceId).d("characteristic", characteristicId));
+        if (auto service = findService(serviceId)) {
+            return service->requestCharacteristic(device, requestId, characteristicId, std::move(data));
         }
-
         return false;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -221,17 +267,9 @@ bool GATTServerEngineImpl::onRequestDescriptor(
     const std::string& descriptorId,
     aace::bluetooth::ByteArrayPtr data) {
     try {
-        for (auto& it : m_serviceList) {
-            if (auto m_service_lock = it.lock()) {
-                if (aace::engine::utils::uuid::compare(m_service_lock->getId(), serviceId)) {
-                    return m_service_lock->requestDescriptor(
-                        device, requestId, characteristicId, descriptorId, std::move(data));
-                }
-            } else {
-                AACE_ERROR(LX(TAG).d("reason", "invalidServiceReference"));
-            }
+        if (auto service = findService(serviceId)) {
+            return service->requestDescriptor(device, requestId, characteristicId, descriptorId, std::move(data));
         }
-
         return false;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
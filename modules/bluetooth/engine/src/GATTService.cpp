@@ -50,6 +50,20 @@ bool GATTService::setCharacteristicValue(const std::string& characteristicId, aa
     }
 }
 
+bool GATTService::setCharacteristicValues(std::vector<aace::bluetooth::GATTServer::CharacteristicValue> values) {
+    try {
+        if (auto serverInterface_lock = m_serverInterface.lock()) {
+            ThrowIfNot(serverInterface_lock->setCharacteristicValues(getId(), std::move(values)), "notifyServerFailed");
+            return true;
+        } else {
+            Throw("invalidServerInterfaceReference");
+        }
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
 void GATTService::connected(const std::string& device) {
 }
 
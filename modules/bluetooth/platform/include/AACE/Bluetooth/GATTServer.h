@@ -16,6 +16,10 @@
 #ifndef AACE_BLUETOOTH_GATT_SERVER_H
 #define AACE_BLUETOOTH_GATT_SERVER_H
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "BluetoothEngineInterfaces.h"
 
 namespace aace {
@@ -37,6 +41,17 @@ public:
         const std::string& characteristicId,
         ByteArrayPtr data) = 0;
 
+    /// The id of a characteristic and its new value
+    using CharacteristicValue = std::pair<std::string, ByteArrayPtr>;
+
+    /**
+     * Sets the values of several characteristics of a service at once. The platform implementation can override it
+     * to update the characteristics in one operation, by default each value is set with @c setCharacteristicValue.
+     *
+     * @return @c false if any of the values could not be set.
+     */
+    virtual bool setCharacteristicValues(const std::string& serviceId, std::vector<CharacteristicValue> values);
+
     void connectionStateChanged(const std::string& device, ConnectionState state);
     bool requestCharacteristic(
         const std::string& device,
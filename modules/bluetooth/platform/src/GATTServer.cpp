@@ -24,6 +24,15 @@ void GATTServer::setEngineInterface(const std::shared_ptr<GATTServerEngineInterf
     m_gattServerEngineInterface = gattServerEngineInterface;
 }
 
+bool GATTServer::setCharacteristicValues(const std::string& serviceId, std::vector<CharacteristicValue> values) {
+    bool success = true;
+    for (auto& value : values) {
+        // a failed value doesn't keep the next values from being set
+        success = setCharacteristicValue(serviceId, value.first, std::move(value.second)) && success;
+    }
+    return success;
+}
+
 void GATTServer::connectionStateChanged(const std::string& device, ConnectionState state) {
     if (auto m_gattServerEngineInterface_lock = m_gattServerEngineInterface.lock()) {
         m_gattServerEngineInterface_lock->onConnectionStateChanged(device, state);
@@ -35,9 +35,12 @@ private:
     AASBCarControl(uint32_t asyncReplyTimeout);
 
     bool initialize(std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker);
-    void addReplyMessagePromise(const std::string& messageId, std::shared_ptr<CarControlPromise> promise);
+    bool addReplyMessagePromise(const std::string& messageId, std::shared_ptr<CarControlPromise> promise);
     void removeReplyMessagePromise(const std::string& messageId);
-    bool waitForAsyncReply(const std::string& messageId);
+    bool publishAndWaitForAsyncReply(
+        std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
+        const std::string& messageId,
+        const std::string& message);
     std::shared_ptr<CarControlPromise> getReplyMessagePromise(const std::string& messageId);
 
 public:
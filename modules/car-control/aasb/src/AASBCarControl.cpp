@@ -135,10 +135,7 @@ bool AASBCarControl::turnPowerControllerOn(const std::string& endpointId) {
         message.payload.endpointId = endpointId;
         message.payload.turnOn = true;
 
-        m_messageBroker_lock->publish(message.toString()).send();
-
-        std::string messageId = message.header.id;
-        return waitForAsyncReply(messageId);
+        return publishAndWaitForAsyncReply(m_messageBroker_lock, message.header.id, message.toString());
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return false;
@@ -157,10 +154,7 @@ bool AASBCarControl::turnPowerControllerOff(const std::string& endpointId) {
         message.payload.endpointId = endpointId;
         message.payload.turnOn = false;
 
-        m_messageBroker_lock->publish(message.toString()).send();
-
-        std::string messageId = message.header.id;
-        return waitForAsyncReply(messageId);
+        return publishAndWaitForAsyncReply(m_messageBroker_lock, message.header.id, message.toString());
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return false;
@@ -188,10 +182,7 @@ bool AASBCarControl::turnToggleControllerOn(const std::string& endpointId, const
         message.payload.instanceId = controllerId;
         message.payload.turnOn = true;
 
-        m_messageBroker_lock->publish(message.toString()).send();
-
-        std::string messageId = message.header.id;
-        return waitForAsyncReply(messageId);
+        return publishAndWaitForAsyncReply(m_messageBroker_lock, message.header.id, message.toString());
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return false;
@@ -211,10 +202,7 @@ bool AASBCarControl::turnToggleControllerOff(const std::string& endpointId, cons
         message.payload.controllerId = controllerId;
         message.payload.instanceId = controllerId;
 
-        m_messageBroker_lock->publish(message.toString()).send();
-
-        std::string messageId = message.header.id;
-        return waitForAsyncReply(messageId);
+        return publishAndWaitForAsyncReply(m_messageBroker_lock, message.header.id, message.toString());
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return false;
@@ -245,10 +233,7 @@ bool AASBCarControl::setRangeControllerValue(
         message.payload.instanceId = controllerId;
         message.payload.value = value;
 
-        m_messageBroker_lock->publish(message.toString()).send();
-
-        std::string messageId = message.header.id;
-        return waitForAsyncReply(messageId);
+        return publishAndWaitForAsyncReply(m_messageBroker_lock, message.header.id, message.toString());
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return false;
@@ -272,10 +257,7 @@ bool AASBCarControl::adjustRangeControllerValue(
         message.payload.instanceId = controllerId;
         message.payload.delta = delta;
 
-        m_messageBroker_lock->publish(message.toString()).send();
-
-        std::string messageId = message.header.id;
-        return waitForAsyncReply(messageId);
+        return publishAndWaitForAsyncReply(m_messageBroker_lock, message.header.id, message.toString());
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return false;
@@ -309,10 +291,7 @@ bool AASBCarControl::setModeControllerValue(
         message.payload.instanceId = controllerId;
         message.payload.value = value;
 
-        m_messageBroker_lock->publish(message.toString()).send();
-
-        std::string messageId = message.header.id;
-        return waitForAsyncReply(messageId);
+        return publishAndWaitForAsyncReply(m_messageBroker_lock, message.header.id, message.toString());
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return false;
@@ -336,10 +315,7 @@ bool AASBCarControl::adjustModeControllerValue(
         message.payload.instanceId = controllerId;
         message.payload.delta = delta;
 
-        m_messageBroker_lock->publish(message.toString()).send();
-
-        std::string messageId = message.header.id;
-        return waitForAsyncReply(messageId);
+        return publishAndWaitForAsyncReply(m_messageBroker_lock, message.header.id, message.toString());
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return false;
@@ -353,7 +329,10 @@ bool AASBCarControl::getModeControllerValue(
     return true;
 }
 
-bool AASBCarControl::waitForAsyncReply(const std::string& messageId) {
+bool AASBCarControl::publishAndWaitForAsyncReply(
+    std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
+    const std::string& messageId,
+    const std::string& message) {
     // create the promise for the car control reply message to fulfill
     std::shared_ptr<CarControlPromise> promise = std::make_shared<CarControlPromise>();
 
@@ -362,7 +341,10 @@ bool AASBCarControl::waitForAsyncReply(const std::string& messageId) {
 
     bool success = false;
     try {
-        addReplyMessagePromise(messageId, promise);
+        // add the promise before the message is published, so a reply published as soon as the
+        // application handles the message is never missed
+        ThrowIfNot(addReplyMessagePromise(messageId, promise), "addReplyMessagePromiseFailed");
+        messageBroker->publish(message).send();
         ThrowIfNot(
             future.wait_for(std::chrono::milliseconds(m_replyMessageTimeout)) == std::future_status::ready,
             "replyMessageTimeout:id=" + messageId);
@@ -376,7 +358,7 @@ bool AASBCarControl::waitForAsyncReply(const std::string& messageId) {
     return success;
 }
 
-void AASBCarControl::addReplyMessagePromise(const std::string& messageId, std::shared_ptr<CarControlPromise> promise) {
+bool AASBCarControl::addReplyMessagePromise(const std::string& messageId, std::shared_ptr<CarControlPromise> promise) {
     try {
         std::lock_guard<std::mutex> lock(m_promise_map_access_mutex);
 
@@ -384,8 +366,10 @@ void AASBCarControl::addReplyMessagePromise(const std::string& messageId, std::s
 
         // add the promise to the promise map
         m_promiseMap[messageId] = promise;
+        return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "addReplyMessagePromise").d("reason", ex.what()));
+        return false;
     }
 }
 
@@ -16,10 +16,10 @@
 #ifndef AACE_ENGINE_CAR_CONTROL_ASSET_STORE_H
 #define AACE_ENGINE_CAR_CONTROL_ASSET_STORE_H
 
+#include <cstdint>
 #include <istream>
 #include <string>
 #include <unordered_map>
-#include <utility>
 #include <vector>
 
 namespace aace {
@@ -31,11 +31,53 @@ namespace carControl {
  * locale pairs associated with each asset definition in the file.
  * Friendly name / locale pairs of assets may be retrieved by asset ID when
  * constructing a discovery message with assets expanded to text.
+ *
+ * The friendly names of all assets are stored back to back in a single text
+ * buffer, and each locale is stored once, so the full multi-locale catalog
+ * costs a few allocations rather than two strings per friendly name.
  */
 class AssetStore {
+private:
+    /// A friendly name of an asset: its text in the text buffer and the index of its locale
+    struct FriendlyName {
+        uint32_t offset;
+        uint32_t length;
+        uint32_t locale;
+    };
+
+    /// The range of the friendly names of an asset
+    struct Range {
+        uint32_t first;
+        uint32_t count;
+    };
+
 public:
-    /// Alias for readability. Pair of friendly name literal text to its locale
-    using NameLocalePair = std::pair<std::string, std::string>;
+    /**
+     * A view of the friendly name / locale pairs of an asset. The view is
+     * valid until the AssetStore is modified.
+     */
+    class FriendlyNames {
+    public:
+        /// The number of friendly name / locale pairs
+        size_t size() const;
+
+        /// Whether the asset has no friendly names
+        bool empty() const;
+
+        /// The friendly name literal text of the pair at @c index
+        std::string getName(size_t index) const;
+
+        /// The locale of the pair at @c index
+        const std::string& getLocale(size_t index) const;
+
+    private:
+        friend class AssetStore;
+
+        FriendlyNames(const AssetStore* store, Range range);
+
+        const AssetStore* m_store;
+        Range m_range;
+    };
 
     /// Destructor
     ~AssetStore();
@@ -46,29 +88,61 @@ public:
      * assets JSON in the expected schema.
      *
      * @param path The path of the assets file to ingest
-     * @return @c true if the assets were ingested successfully; @c false if 
+     * @return @c true if the assets were ingested successfully; @c false if
      * there was an issue such as malformed or missing values
      */
     bool addAssets(const std::string& path);
 
     /**
-     * Get the literal friendly names and locales associated with the given 
+     * Get the literal friendly names and locales associated with the given
      * asset ID.
      *
      * @param The ID of the asset
-     * @return A list of pairs of friendly name and locale strings for the asset
+     * @return The friendly name and locale pairs for the asset, which are
+     * empty if the asset is not in the AssetStore
      */
-    const std::vector<NameLocalePair>& getFriendlyNames(const std::string& assetId) const;
+    FriendlyNames getFriendlyNames(const std::string& assetId) const;
 
     /**
      * Clear the contents of the AssetStore
      */
     void clear();
 
+    /**
+     * Compute the key identifying the contents of the given asset files, so a cache of the assets ingested from them
+     * can be reused until one of the files changes.
+     *
+     * @param paths The paths of the asset files, in the order they are ingested
+     * @return The key, or an empty string if a file could not be read
+     */
+    static std::string computeCacheKey(const std::vector<std::string>& paths);
+
+    /**
+     * Write the contents of the AssetStore to a compact binary cache file.
+     *
+     * @param path The path of the cache file
+     * @param key The key identifying the asset files the contents were ingested from
+     * @return @c true if the cache file was written
+     */
+    bool saveCache(const std::string& path, const std::string& key) const;
+
+    /**
+     * Populate the AssetStore from a cache file written by @c saveCache(), replacing its contents.
+     *
+     * @param path The path of the cache file
+     * @param key The key identifying the current asset files
+     * @return @c true if the cache file was read; @c false if it is missing, was written for a different key, or is
+     * corrupt, in which case the AssetStore is left empty
+     */
+    bool loadCache(const std::string& path, const std::string& key);
+
 private:
+    /// Parses an assets JSON stream into the AssetStore without building its document
+    class Parser;
+
     /**
      * Ingest the assets from the istream and populate the AssetStore with the
-     * friendly name text / locale pairs. The contents of the stream must 
+     * friendly name text / locale pairs. The contents of the stream must
      * contain the assets JSON in the expected schema.
      *
      * @param stream The istream containing the assets to ingest
@@ -77,18 +151,30 @@ private:
      */
     bool addAssets(std::istream& stream);
 
+    /// Return the index of @c locale in @c m_locales, adding it if needed
+    uint32_t internLocale(const std::string& locale);
+
+    /// Append @c text to the text buffer and return its offset
+    uint32_t appendText(const std::string& text);
+
     /**
-     * A map of asset ID to a list of friendly name text / locale pairs used to
-     * describe the asset. It contains an entry for all assets ingested by the
+     * A map of asset ID to the range of @c m_friendlyNames used to describe
+     * the asset. It contains an entry for all assets ingested by the
      * AssetStore.
      */
-    std::unordered_map<std::string, std::vector<NameLocalePair>> m_assets;
+    std::unordered_map<std::string, Range> m_assets;
 
-    /**
-     * An empty list to be returned from @c getFriendlyNames() if the specified ID
-     * isn't present in the AssetStore
-     */
-    std::vector<NameLocalePair> m_empty;
+    /// The friendly names of all the assets, each asset's names contiguous
+    std::vector<FriendlyName> m_friendlyNames;
+
+    /// The text of all the friendly names, back to back
+    std::string m_text;
+
+    /// The distinct locales of the friendly names
+    std::vector<std::string> m_locales;
+
+    /// A map of locale to its index in @c m_locales
+    std::unordered_map<std::string, uint32_t> m_localeIndices;
 };
 
 }  // namespace carControl
@@ -46,16 +46,19 @@ public:
 
     /**
      * Get the ID of the endpoint controlled by this controller
+     *
+     * @note The ID is returned by reference since it is passed to the platform interface for every directive and
+     * state report.
      */
-    std::string getEndpointId();
+    const std::string& getEndpointId() const;
     /**
      * Get the ID of this controller
      */
-    virtual std::string getId();
+    virtual const std::string& getId() const;
     /**
      * Get the interface type name this controller
      */
-    std::string getInterface();
+    const std::string& getInterface() const;
 
     /**
      * Create the internal representation of the endpoint using the @c EndpointBuilder
@@ -19,6 +19,7 @@
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <unordered_map>
+#include <vector>
 
 #include "AACE/CarControl/CarControl.h"
 #include "AACE/Engine/CarControl/AssetStore.h"
@@ -61,7 +62,7 @@ public:
 
 protected:
     bool initialize() override;
-    bool configure(std::shared_ptr<std::istream> configuration) override;
+    bool configureFromJson(const aace::engine::utils::json::Value& configuration) override;
     bool setup() override;
     bool shutdown() override;
     /// @}
@@ -91,8 +92,8 @@ private:
     /// The AssetStore used to store friendly name / locale pairs for the assets describing all endpoints
     aace::engine::carControl::AssetStore m_assetStore;
 
-    /// A map of endpoint IDs to the corresponding @c Endpoint object for all configured endpoints
-    std::unordered_map<std::string, std::shared_ptr<aace::engine::carControl::Endpoint>> m_endpoints;
+    /// The @c Endpoint objects for all configured endpoints, in configuration order
+    std::vector<std::shared_ptr<aace::engine::carControl::Endpoint>> m_endpoints;
 
     /// Whether the @c CarControlLocalService is available
     bool m_isLocalServiceAvailable = false;
@@ -19,6 +19,8 @@
 #include <AVSCommon/SDKInterfaces/Endpoints/EndpointRegistrationManagerInterface.h>
 
 #include <nlohmann/json.hpp>
+#include <unordered_set>
+#include <vector>
 
 #include "AACE/CarControl/CarControl.h"
 #include "AACE/Engine/Alexa/EndpointBuilderFactory.h"
@@ -92,7 +94,7 @@ public:
     /**
      * Get the configured endpoint ID for this endpoint.
      */
-    std::string getId();
+    const std::string& getId() const;
 
     /**
      * Get the endpoint ID sent in discovery for this endpoint.
@@ -100,7 +102,7 @@ public:
      *       ID, product ID, DSN, and configured endpoint ID.
      * @note This ID is not initialized until @c build().
      */
-    std::string getDiscoveryId();
+    const std::string& getDiscoveryId() const;
 
     /**
      * Constructs the AVS SDK representation of the endpoint for registration with the endpoint registration manager,
@@ -144,8 +146,11 @@ private:
     /// A list of all asset IDs used to identify this endpoint's friendly names
     std::vector<std::string> m_assetIds;
 
-    /// A map of controllers belonging to this endpoint keyed by controller id
-    std::unordered_map<std::string, std::shared_ptr<CapabilityController>> m_controllers;
+    /// The controllers belonging to this endpoint, in configuration order
+    std::vector<std::shared_ptr<CapabilityController>> m_controllers;
+
+    /// The IDs of the controllers belonging to this endpoint, used to reject duplicate controllers at configuration
+    std::unordered_set<std::string> m_controllerIds;
 };
 
 }  // namespace carControl
@@ -49,12 +49,12 @@ public:
 
     /// @c CapabilityController methods
     /// @{
-    std::string getId() override;
+    const std::string& getId() const override;
     /// @}
     /*
      * Get the name of this capability controller instance
      */
-    std::string getInstance();
+    const std::string& getInstance() const;
 
     /**
      * Utility function to create a @c CapabilityResources from a 'capabilityResources' node of a capability definition JSON
@@ -78,6 +78,8 @@ public:
 private:
     /// The name of this capability controller instance
     std::string m_instance;
+    /// The ID of this controller, "<interface>#<instance>", built once at construction
+    std::string m_id;
     /// A list of all asset IDs used for the friendly names that describe this controller
     std::vector<std::string> m_assetIds;
 };
@@ -16,7 +16,9 @@
 #include <AACE/Engine/CarControl/AssetStore.h>
 #include <AACE/Engine/Core/EngineMacros.h>
 
-#include <sstream>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 
 // JSON for Modern C++
 #include <nlohmann/json.hpp>
@@ -29,6 +31,298 @@ namespace carControl {
 /// String to identify log entries originating from this file.
 static const std::string TAG("aace.carControl.AssetStore");
 
+/// Identifies the cache file format. Bump the version whenever the layout changes. The cache is written in host byte
+/// order since it is only read back by the device that wrote it.
+static const std::string CACHE_MAGIC = "AACEASC2";
+
+/// FNV-1a 64 bit offset basis
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+/// FNV-1a 64 bit prime
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/// The largest string or count accepted from a cache file, to fail fast on a corrupt file
+static const uint32_t CACHE_MAX_SIZE = 16 * 1024 * 1024;
+
+/// Write a length-prefixed string to the cache
+static void writeString(std::ostream& stream, const std::string& value) {
+    uint32_t size = static_cast<uint32_t>(value.size());
+    stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    stream.write(value.data(), size);
+}
+
+/// Write a count to the cache
+static void writeCount(std::ostream& stream, size_t count) {
+    uint32_t value = static_cast<uint32_t>(count);
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/// Read a count from the cache
+static uint32_t readCount(std::istream& stream) {
+    uint32_t value = 0;
+    ThrowIfNot(stream.read(reinterpret_cast<char*>(&value), sizeof(value)), "truncatedCache");
+    ThrowIf(value > CACHE_MAX_SIZE, "corruptCache");
+    return value;
+}
+
+/// Read a length-prefixed string from the cache
+static std::string readString(std::istream& stream) {
+    std::string value(readCount(stream), '\0');
+    if (!value.empty()) {
+        ThrowIfNot(stream.read(&value[0], value.size()), "truncatedCache");
+    }
+    return value;
+}
+
+/// Read @c size bytes from the cache
+static void readBytes(std::istream& stream, void* data, size_t size) {
+    if (size > 0) {
+        ThrowIfNot(stream.read(static_cast<char*>(data), size), "truncatedCache");
+    }
+}
+
+//
+// AssetStore::FriendlyNames
+//
+
+AssetStore::FriendlyNames::FriendlyNames(const AssetStore* store, Range range) : m_store(store), m_range(range) {
+}
+
+size_t AssetStore::FriendlyNames::size() const {
+    return m_range.count;
+}
+
+bool AssetStore::FriendlyNames::empty() const {
+    return m_range.count == 0;
+}
+
+std::string AssetStore::FriendlyNames::getName(size_t index) const {
+    auto& name = m_store->m_friendlyNames.at(m_range.first + index);
+    return m_store->m_text.substr(name.offset, name.length);
+}
+
+const std::string& AssetStore::FriendlyNames::getLocale(size_t index) const {
+    return m_store->m_locales.at(m_store->m_friendlyNames.at(m_range.first + index).locale);
+}
+
+//
+// AssetStore::Parser
+//
+
+/**
+ * Handles the SAX events of an assets JSON document, adding each asset to the
+ * AssetStore as soon as its object ends:
+ * @code
+ * {
+ *     "assets": [
+ *         {
+ *             "assetId": "...",
+ *             "values": [
+ *                 {"locales": ["..."], "defaultValue": "...", "synonyms": ["..."]}
+ *             ]
+ *         }
+ *     ]
+ * }
+ * @endcode
+ */
+class AssetStore::Parser : public json::json_sax_t {
+public:
+    Parser(AssetStore& store) : m_store(store) {
+    }
+
+    /// The reason the document was rejected
+    const std::string& getError() const {
+        return m_error;
+    }
+
+    /// @name @c json_sax_t functions
+    /// @{
+    bool null() override {
+        // a null "synonyms" is the same as no synonyms
+        return scalar(!m_context.empty() && m_context.back() == Context::VALUE && m_key == "synonyms");
+    }
+    bool boolean(bool) override {
+        return scalar(false);
+    }
+    bool number_integer(number_integer_t) override {
+        return scalar(false);
+    }
+    bool number_unsigned(number_unsigned_t) override {
+        return scalar(false);
+    }
+    bool number_float(number_float_t, const string_t&) override {
+        return scalar(false);
+    }
+    bool binary(binary_t&) override {
+        return scalar(false);
+    }
+    bool string(string_t& value) override {
+        switch (m_context.empty() ? Context::SKIP : m_context.back()) {
+            case Context::ASSET:
+                if (m_key == "assetId") {
+                    m_assetId = value;
+                    m_hasAssetId = true;
+                    return true;
+                }
+                return scalar(false);
+            case Context::VALUE:
+                if (m_key == "defaultValue") {
+                    m_defaultValue = {m_store.appendText(value), static_cast<uint32_t>(value.size())};
+                    m_hasDefaultValue = true;
+                    return true;
+                }
+                return scalar(false);
+            case Context::LOCALES:
+                m_locales.push_back(m_store.internLocale(value));
+                return true;
+            case Context::SYNONYMS:
+                m_synonyms.push_back({m_store.appendText(value), static_cast<uint32_t>(value.size())});
+                return true;
+            default:
+                return scalar(false);
+        }
+    }
+    bool start_object(std::size_t) override {
+        Context parent = m_context.empty() ? Context::NONE : m_context.back();
+        if (parent == Context::NONE) {
+            m_context.push_back(Context::ROOT);
+        } else if (parent == Context::ASSETS) {
+            m_context.push_back(Context::ASSET);
+            m_hasAssetId = false;
+            m_assetFirst = static_cast<uint32_t>(m_store.m_friendlyNames.size());
+            m_assetTextStart = static_cast<uint32_t>(m_store.m_text.size());
+        } else if (parent == Context::VALUES) {
+            m_context.push_back(Context::VALUE);
+            m_hasDefaultValue = false;
+            m_hasLocales = false;
+            m_locales.clear();
+            m_synonyms.clear();
+        } else if (isKnownKey(parent)) {
+            return fail("unexpectedObject");
+        } else {
+            m_context.push_back(Context::SKIP);
+        }
+        return true;
+    }
+    bool key(string_t& value) override {
+        m_key = value;
+        return true;
+    }
+    bool end_object() override {
+        Context context = m_context.back();
+        m_context.pop_back();
+        if (context == Context::ROOT) {
+            return m_hasAssets || fail("missingAssets");
+        } else if (context == Context::VALUE) {
+            if (!m_hasDefaultValue || !m_hasLocales) {
+                return fail(m_hasLocales ? "missingDefaultValue" : "missingLocales");
+            }
+            // for every locale, add the defaultValue and each synonym to the names of this asset
+            for (auto locale : m_locales) {
+                m_store.m_friendlyNames.push_back({m_defaultValue.first, m_defaultValue.second, locale});
+                for (auto& synonym : m_synonyms) {
+                    m_store.m_friendlyNames.push_back({synonym.first, synonym.second, locale});
+                }
+            }
+        } else if (context == Context::ASSET) {
+            if (!m_hasAssetId) {
+                return fail("missingAssetId");
+            }
+            uint32_t count = static_cast<uint32_t>(m_store.m_friendlyNames.size()) - m_assetFirst;
+            if (count == 0) {
+                return fail("noAssetFriendlyNameFor " + m_assetId);
+            }
+            if (!m_store.m_assets.emplace(m_assetId, Range{m_assetFirst, count}).second) {
+                // the first definition of an asset wins, so drop the names of this one
+                m_store.m_friendlyNames.resize(m_assetFirst);
+                m_store.m_text.resize(m_assetTextStart);
+            }
+        }
+        return true;
+    }
+    bool start_array(std::size_t) override {
+        Context parent = m_context.empty() ? Context::NONE : m_context.back();
+        if (parent == Context::ROOT && m_key == "assets") {
+            m_context.push_back(Context::ASSETS);
+            m_hasAssets = true;
+        } else if (parent == Context::ASSET && m_key == "values") {
+            m_context.push_back(Context::VALUES);
+        } else if (parent == Context::VALUE && m_key == "locales") {
+            m_context.push_back(Context::LOCALES);
+            m_hasLocales = true;
+        } else if (parent == Context::VALUE && m_key == "synonyms") {
+            m_context.push_back(Context::SYNONYMS);
+        } else if (parent == Context::NONE || parent == Context::ASSETS || parent == Context::VALUES ||
+                   parent == Context::LOCALES || parent == Context::SYNONYMS || isKnownKey(parent)) {
+            return fail("unexpectedArray");
+        } else {
+            m_context.push_back(Context::SKIP);
+        }
+        return true;
+    }
+    bool end_array() override {
+        m_context.pop_back();
+        return true;
+    }
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        return fail(ex.what());
+    }
+    /// @}
+
+private:
+    /// The JSON value being parsed
+    enum class Context { NONE, ROOT, ASSETS, ASSET, VALUES, VALUE, LOCALES, SYNONYMS, SKIP };
+
+    /// Whether the current key of an object of the @c parent context must hold a string or an array
+    bool isKnownKey(Context parent) const {
+        return (parent == Context::ROOT && m_key == "assets") ||
+               (parent == Context::ASSET && (m_key == "assetId" || m_key == "values")) ||
+               (parent == Context::VALUE && (m_key == "defaultValue" || m_key == "locales" || m_key == "synonyms"));
+    }
+
+    /// Handle a non-string scalar, which is only accepted where it is ignored
+    bool scalar(bool accepted) {
+        if (m_context.empty()) {
+            return fail("expectedObject");
+        }
+        Context context = m_context.back();
+        if (accepted || context == Context::SKIP ||
+            ((context == Context::ROOT || context == Context::ASSET || context == Context::VALUE) &&
+             !isKnownKey(context))) {
+            return true;
+        }
+        return fail("unexpectedValueType");
+    }
+
+    bool fail(const std::string& reason) {
+        m_error = reason;
+        return false;
+    }
+
+    AssetStore& m_store;
+    std::vector<Context> m_context;
+    std::string m_key;
+    std::string m_error;
+    bool m_hasAssets = false;
+
+    /// The asset being parsed
+    std::string m_assetId;
+    bool m_hasAssetId = false;
+    uint32_t m_assetFirst = 0;
+    uint32_t m_assetTextStart = 0;
+
+    /// The value of the asset being parsed, with the offset and length of its text
+    std::pair<uint32_t, uint32_t> m_defaultValue;
+    bool m_hasDefaultValue = false;
+    std::vector<uint32_t> m_locales;
+    bool m_hasLocales = false;
+    std::vector<std::pair<uint32_t, uint32_t>> m_synonyms;
+};
+
+//
+// AssetStore
+//
+
 AssetStore::~AssetStore() {
     clear();
 }
@@ -46,32 +340,9 @@ bool AssetStore::addAssets(const std::string& path) {
 bool AssetStore::addAssets(std::istream& stream) {
     try {
         if (stream.good()) {
-            json j = json::parse(stream);
-            json assetArray = j.at("assets");
-            for (auto& assetItem : assetArray.items()) {
-                // For each asset, add an entry to the asset map
-                // 'names' will hold all synonyms for all locales for all values
-                std::vector<NameLocalePair> names;
-                auto assetObject = assetItem.value();
-                std::string assetId = assetObject["assetId"];
-                json valuesArray = assetObject["values"];
-                for (auto& valueItem : valuesArray.items()) {
-                    json valueObject = valueItem.value();
-                    std::string defaultValue = valueObject["defaultValue"];
-                    json synonyms = valueObject["synonyms"];
-                    std::vector<std::string> locales = valueObject.at("locales");
-                    // For every locale, add the defaultValue and each synonym
-                    // to the list of names for this assetId
-                    for (auto locale = locales.begin(); locale != locales.end(); ++locale) {
-                        names.push_back({defaultValue, *locale});
-                        for (auto& synonym : synonyms.items()) {
-                            names.push_back({synonym.value(), *locale});
-                        }
-                    }
-                }
-                ThrowIf(names.empty(), "noAssetFriendlyNameFor " + assetId);
-                m_assets.emplace(assetId, names);
-            }
+            // parse the document as it is read rather than building the whole document first
+            Parser parser(*this);
+            ThrowIfNot(json::sax_parse(stream, &parser), parser.getError());
             return true;
         }
         return false;
@@ -82,20 +353,151 @@ bool AssetStore::addAssets(std::istream& stream) {
     }
 }
 
-const std::vector<AssetStore::NameLocalePair>& AssetStore::getFriendlyNames(const std::string& assetId) const {
+uint32_t AssetStore::internLocale(const std::string& locale) {
+    auto result = m_localeIndices.emplace(locale, static_cast<uint32_t>(m_locales.size()));
+    if (result.second) {
+        m_locales.push_back(locale);
+    }
+    return result.first->second;
+}
+
+uint32_t AssetStore::appendText(const std::string& text) {
+    ThrowIf(m_text.size() + text.size() > UINT32_MAX, "assetsTooLarge");
+    auto offset = static_cast<uint32_t>(m_text.size());
+    m_text.append(text);
+    return offset;
+}
+
+AssetStore::FriendlyNames AssetStore::getFriendlyNames(const std::string& assetId) const {
     auto iter = m_assets.find(assetId);
-    if (iter != m_assets.end()) {
-        return iter->second;
-    } else {
-        return m_empty;
+    return FriendlyNames(this, iter != m_assets.end() ? iter->second : Range{0, 0});
+}
+
+std::string AssetStore::computeCacheKey(const std::vector<std::string>& paths) {
+    try {
+        // the key covers the order and contents of every file, so reordering or editing any file invalidates it
+        uint64_t value = FNV_OFFSET_BASIS;
+        auto hash = [&value](const char* data, size_t size) {
+            for (size_t index = 0; index < size; index++) {
+                value ^= static_cast<uint8_t>(data[index]);
+                value *= FNV_PRIME;
+            }
+        };
+        char buffer[64 * 1024];
+        for (auto& path : paths) {
+            std::ifstream ifs(path, std::ios::binary);
+            ThrowIfNot(ifs.good(), "openAssetsFileFailed");
+            while (ifs) {
+                ifs.read(buffer, sizeof(buffer));
+                hash(buffer, static_cast<size_t>(ifs.gcount()));
+            }
+            ThrowIfNot(ifs.eof(), "readAssetsFileFailed");
+            // separate the files so moving bytes between them changes the key
+            hash(path.c_str(), path.size() + 1);
+        }
+        char key[17];
+        snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(value));
+        return std::string(key);
+    } catch (std::exception& ex) {
+        AACE_WARN(LX(TAG).d("reason", ex.what()));
+        return "";
     }
 }
 
-void AssetStore::clear() {
-    for (auto value : m_assets) {
-        value.second.clear();
+bool AssetStore::saveCache(const std::string& path, const std::string& key) const {
+    try {
+        ThrowIf(key.empty(), "invalidCacheKey");
+        // write a temporary file first so a reader never observes a partially written cache
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+            ThrowIfNot(ofs.good(), "openCacheFailed");
+            ofs.write(CACHE_MAGIC.data(), CACHE_MAGIC.size());
+            writeString(ofs, key);
+            writeCount(ofs, m_locales.size());
+            for (auto& locale : m_locales) {
+                writeString(ofs, locale);
+            }
+            writeString(ofs, m_text);
+            writeCount(ofs, m_friendlyNames.size());
+            ofs.write(
+                reinterpret_cast<const char*>(m_friendlyNames.data()), m_friendlyNames.size() * sizeof(FriendlyName));
+            writeCount(ofs, m_assets.size());
+            for (auto& asset : m_assets) {
+                writeString(ofs, asset.first);
+                ofs.write(reinterpret_cast<const char*>(&asset.second), sizeof(Range));
+            }
+            ofs.flush();
+            ThrowIfNot(ofs.good(), "writeCacheFailed");
+        }
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            std::remove(tempPath.c_str());
+            Throw("renameCacheFailed");
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_WARN(LX(TAG).sensitive("path", path).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool AssetStore::loadCache(const std::string& path, const std::string& key) {
+    try {
+        clear();
+        ThrowIf(key.empty(), "invalidCacheKey");
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs.good()) {
+            return false;
+        }
+        std::string magic(CACHE_MAGIC.size(), '\0');
+        ThrowIfNot(ifs.read(&magic[0], magic.size()) && magic == CACHE_MAGIC, "unexpectedCacheFormat");
+        if (readString(ifs) != key) {
+            AACE_DEBUG(LX(TAG).m("assetsChangedSinceCacheWasWritten"));
+            return false;
+        }
+
+        uint32_t localeCount = readCount(ifs);
+        m_locales.reserve(localeCount);
+        for (uint32_t index = 0; index < localeCount; index++) {
+            m_locales.push_back(readString(ifs));
+            m_localeIndices.emplace(m_locales.back(), index);
+        }
+        m_text = readString(ifs);
+        m_friendlyNames.resize(readCount(ifs));
+        readBytes(ifs, m_friendlyNames.data(), m_friendlyNames.size() * sizeof(FriendlyName));
+        for (auto& name : m_friendlyNames) {
+            ThrowIf(
+                name.locale >= m_locales.size() || name.offset > m_text.size() ||
+                    name.length > m_text.size() - name.offset,
+                "corruptCache");
+        }
+        uint32_t assetCount = readCount(ifs);
+        m_assets.reserve(assetCount);
+        for (uint32_t index = 0; index < assetCount; index++) {
+            std::string assetId = readString(ifs);
+            Range range;
+            readBytes(ifs, &range, sizeof(range));
+            ThrowIf(
+                range.first > m_friendlyNames.size() || range.count > m_friendlyNames.size() - range.first,
+                "corruptCache");
+            m_assets.emplace(std::move(assetId), range);
+        }
+        ThrowIfNot(ifs.peek() == std::char_traits<char>::eof(), "unexpectedCacheTrailer");
+        return true;
+    } catch (std::exception& ex) {
+        AACE_WARN(LX(TAG).sensitive("path", path).d("reason", ex.what()));
+        clear();
+        return false;
     }
-    m_assets.clear();
+}
+
+void AssetStore::clear() {
+    // swap with empty containers to release their memory, which clear() alone keeps
+    std::unordered_map<std::string, Range>().swap(m_assets);
+    std::vector<FriendlyName>().swap(m_friendlyNames);
+    std::string().swap(m_text);
+    std::vector<std::string>().swap(m_locales);
+    std::unordered_map<std::string, uint32_t>().swap(m_localeIndices);
 }
 
 }  // namespace carControl
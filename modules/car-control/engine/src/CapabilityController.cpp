@@ -26,15 +26,15 @@ CapabilityController::CapabilityController(const std::string& endpointId, const
 CapabilityController::~CapabilityController() {
 }
 
-std::string CapabilityController::getEndpointId() {
+const std::string& CapabilityController::getEndpointId() const {
     return m_endpointId;
 }
 
-std::string CapabilityController::getId() {
+const std::string& CapabilityController::getId() const {
     return getInterface();
 }
 
-std::string CapabilityController::getInterface() {
+const std::string& CapabilityController::getInterface() const {
     return m_interface;
 }
 
@@ -18,6 +18,7 @@
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "AACE/Alexa/AlexaProperties.h"
 #include "AACE/Engine/Alexa/AlexaComponentInterface.h"
@@ -51,6 +52,8 @@ static const std::string CONFIG_KEY_ASSETS = "assets";
 static const std::string CONFIG_KEY_DEFAULT_ASSETS_PATH = "defaultAssetsPath";
 /// The key for the 'customAssetsPath' node of configuration
 static const std::string CONFIG_KEY_CUSTOM_ASSETS_PATH = "customAssetsPath";
+/// The key for the 'cachePath' node of configuration
+static const std::string CONFIG_KEY_ASSETS_CACHE_PATH = "cachePath";
 
 // The endpoint ID of the internal endpoint created for zones
 static const std::string INTERNAL_ENDPOINT_ID = "_AutoSDKInternalRoot";
@@ -79,13 +82,13 @@ bool CarControlEngineService::initialize() {
     }
 }
 
-bool CarControlEngineService::configure(std::shared_ptr<std::istream> configuration) {
+bool CarControlEngineService::configureFromJson(const aace::engine::utils::json::Value& configuration) {
     try {
         AACE_DEBUG(LX(TAG).d("isLocalServiceAvailable", isLocalServiceAvailable()));
         ThrowIf(m_configured, "carControlEngineServiceAlreadyConfigured");
 
-        json jconfiguration;
-        jconfiguration = json::parse(*configuration);
+        // the zones are translated in a copy of the configuration view
+        json jconfiguration = configuration;
 
         // Ingest assets from the file path(s) specified in configuration. Store custom assets in an @c AssetStore to
         // facilitate retrieval of friendly name/locale pairs for asset expansion during @c Endpoint construction.
@@ -94,19 +97,44 @@ bool CarControlEngineService::configure(std::shared_ptr<std::istream> configurat
 
         if (jconfiguration.contains(CONFIG_KEY_ASSETS) && jconfiguration[CONFIG_KEY_ASSETS].is_object()) {
             auto& assets = jconfiguration.at(CONFIG_KEY_ASSETS);
+            std::string defaultAssetsPath;
+            std::string customAssetsPath;
+            std::vector<std::string> assetsPaths;
             if (assets.contains(CONFIG_KEY_DEFAULT_ASSETS_PATH) && assets[CONFIG_KEY_DEFAULT_ASSETS_PATH].is_string()) {
-                std::string path = assets.at(CONFIG_KEY_DEFAULT_ASSETS_PATH);
+                defaultAssetsPath = assets.at(CONFIG_KEY_DEFAULT_ASSETS_PATH);
                 AACE_WARN(LX(TAG)
                               .m("addingDefaultAssetsFromPath")
-                              .sensitive("path", path)
+                              .sensitive("path", defaultAssetsPath)
                               .m("Assets in file override cloud definitions for matching IDs!"));
-                ThrowIfNot(m_assetStore.addAssets(path), "addDefaultAssetsFromPathFailed");
+                assetsPaths.push_back(defaultAssetsPath);
             }
-
             if (assets.contains(CONFIG_KEY_CUSTOM_ASSETS_PATH) && assets[CONFIG_KEY_CUSTOM_ASSETS_PATH].is_string()) {
-                std::string path = assets.at(CONFIG_KEY_CUSTOM_ASSETS_PATH);
-                AACE_DEBUG(LX(TAG).m("addingCustomAssetsFromPath").sensitive("path", path));
-                ThrowIfNot(m_assetStore.addAssets(path), "addCustomAssetsFromPathFailed");
+                customAssetsPath = assets.at(CONFIG_KEY_CUSTOM_ASSETS_PATH);
+                AACE_DEBUG(LX(TAG).m("addingCustomAssetsFromPath").sensitive("path", customAssetsPath));
+                assetsPaths.push_back(customAssetsPath);
+            }
+
+            // Reuse the assets ingested on a previous boot when the asset files did not change since
+            std::string cachePath;
+            std::string cacheKey;
+            if (!assetsPaths.empty() && assets.contains(CONFIG_KEY_ASSETS_CACHE_PATH) &&
+                assets[CONFIG_KEY_ASSETS_CACHE_PATH].is_string()) {
+                cachePath = assets.at(CONFIG_KEY_ASSETS_CACHE_PATH);
+                cacheKey = AssetStore::computeCacheKey(assetsPaths);
+            }
+            if (!cacheKey.empty() && m_assetStore.loadCache(cachePath, cacheKey)) {
+                AACE_DEBUG(LX(TAG).m("addedAssetsFromCache").sensitive("path", cachePath));
+            } else {
+                if (!defaultAssetsPath.empty()) {
+                    ThrowIfNot(m_assetStore.addAssets(defaultAssetsPath), "addDefaultAssetsFromPathFailed");
+                }
+                if (!customAssetsPath.empty()) {
+                    ThrowIfNot(m_assetStore.addAssets(customAssetsPath), "addCustomAssetsFromPathFailed");
+                }
+                // A cache that cannot be written only costs parsing the asset files again on the next boot
+                if (!cacheKey.empty()) {
+                    m_assetStore.saveCache(cachePath, cacheKey);
+                }
             }
         }
 
@@ -115,20 +143,28 @@ bool CarControlEngineService::configure(std::shared_ptr<std::istream> configurat
 
         // Construct an object representation of each endpoint in configuration
         if (jconfiguration.contains(CONFIG_KEY_ENDPOINTS) && jconfiguration.at(CONFIG_KEY_ENDPOINTS).is_array()) {
-            for (auto& item : jconfiguration.at(CONFIG_KEY_ENDPOINTS).items()) {
+            auto& endpoints = jconfiguration.at(CONFIG_KEY_ENDPOINTS);
+            std::unordered_set<std::string> endpointIds;
+            m_endpoints.reserve(endpoints.size());
+            for (auto& item : endpoints.items()) {
                 if (item.value().at("endpointId") == INTERNAL_ENDPOINT_ID) continue;
                 auto endpoint = Endpoint::create(item.value(), m_assetStore);
                 ThrowIfNull(endpoint, "createEndpointFailed");
-                ThrowIfNot(m_endpoints.insert({endpoint->getId(), endpoint}).second, "insertEndpointFailed");
+                ThrowIfNot(endpointIds.insert(endpoint->getId()).second, "insertEndpointFailed");
+                m_endpoints.push_back(endpoint);
             }
         }
 
-        // Write the configuration to storage for retrieval by the car control local service
+        // Write the configuration to storage for retrieval by the car control local service. Reading the stored
+        // configuration back is cheaper than committing an unchanged configuration again on every boot.
         auto localStorage =
             getContext()->getServiceInterface<aace::engine::storage::LocalStorageInterface>(AACE_STORAGE_SERVICE_KEY);
         ThrowIfNull(localStorage, "invalidLocalStorage");
         std::string s = jconfiguration.dump();
-        localStorage->put(CAR_CONTROL_CONFIG_TABLE, CAR_CONTROL_CONFIG_KEY, s);
+        if (!localStorage->containsKey(CAR_CONTROL_CONFIG_TABLE, CAR_CONTROL_CONFIG_KEY) ||
+            localStorage->get(CAR_CONTROL_CONFIG_TABLE, CAR_CONTROL_CONFIG_KEY) != s) {
+            localStorage->put(CAR_CONTROL_CONFIG_TABLE, CAR_CONTROL_CONFIG_KEY, s);
+        }
 
         m_configured = true;
         return true;
@@ -165,16 +201,17 @@ bool CarControlEngineService::setup() {
 
             // Get the IDs for each endpoint used in discovery. Used for translation for ZoneDefinitions
             std::unordered_map<std::string, std::string> endpointIdMappings;
+            endpointIdMappings.reserve(m_endpoints.size());
 
             for (auto& endpoint : m_endpoints) {
-                endpoint.second->build(
+                endpoint->build(
                     m_carControlEngineImpl,
                     endpointBuilderFactory,
                     endpointRegistrationManager,
                     m_assetStore,
                     manufacturerName,
                     description);
-                endpointIdMappings.insert({endpoint.second->getId(), endpoint.second->getDiscoveryId()});
+                endpointIdMappings.insert({endpoint->getId(), endpoint->getDiscoveryId()});
             }
 
             // Add ZoneDefinitions capability to a dummy endpoint
@@ -128,8 +128,11 @@ std::shared_ptr<Endpoint> Endpoint::create(const json& endpointConfig, const Ass
 }
 
 bool Endpoint::addController(const std::string& id, std::shared_ptr<CapabilityController> controller) {
-    auto result = m_controllers.emplace(controller->getId(), controller);
-    return result.second;
+    if (!m_controllerIds.insert(id).second) {
+        return false;
+    }
+    m_controllers.push_back(controller);
+    return true;
 }
 
 Endpoint::Endpoint(const std::string endpointId, const std::vector<std::string>& assetIds) :
@@ -139,13 +142,14 @@ Endpoint::Endpoint(const std::string endpointId, const std::vector<std::string>&
 Endpoint::~Endpoint() {
     m_assetIds.clear();
     m_controllers.clear();
+    m_controllerIds.clear();
 }
 
-std::string Endpoint::getId() {
+const std::string& Endpoint::getId() const {
     return m_endpointId;
 }
 
-std::string Endpoint::getDiscoveryId() {
+const std::string& Endpoint::getDiscoveryId() const {
     return m_discoveryEndpointId;
 }
 
@@ -165,13 +169,13 @@ bool Endpoint::build(
         alexaClientSDK::avsCommon::avs::EndpointResources endpointResources;
         for (auto asset = m_assetIds.begin(); asset != m_assetIds.end(); ++asset) {
             // Expand assets present in the AssetStore. Use the asset ID for assets that are absent
-            const std::vector<AssetStore::NameLocalePair>& names = assetStore.getFriendlyNames(*asset);
+            auto names = assetStore.getFriendlyNames(*asset);
             if (names.empty()) {
                 endpointResources.addFriendlyNameWithAssetId(*asset);
             } else {
                 AACE_DEBUG(LX(TAG).m("expanding asset to text").d("assetID", *asset));
-                for (auto name = names.begin(); name != names.end(); ++name) {
-                    endpointResources.addFriendlyNameWithText(name->first, name->second);
+                for (size_t index = 0; index < names.size(); index++) {
+                    endpointResources.addFriendlyNameWithText(names.getName(index), names.getLocale(index));
                 }
             }
         }
@@ -183,8 +187,7 @@ bool Endpoint::build(
         endpointBuilder->withDerivedEndpointId(getId());
         endpointBuilder->withDisplayCategory({DISPLAY_CATEGORY});
 
-        for (auto& item : m_controllers) {
-            auto controller = item.second;
+        for (auto& controller : m_controllers) {
             controller->build(carControlServiceInterface, endpointBuilder);
         }
         auto endpoint = endpointBuilder->build();
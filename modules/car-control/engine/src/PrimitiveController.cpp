@@ -29,16 +29,16 @@ PrimitiveController::PrimitiveController(
     const std::string& endpointId,
     const std::string& interface,
     const std::string& instance) :
-        CapabilityController(endpointId, interface), m_instance(instance) {
+        CapabilityController(endpointId, interface), m_instance(instance), m_id(interface + "#" + instance) {
 }
 
 PrimitiveController::~PrimitiveController() {
 }
 
-std::string PrimitiveController::getId() {
-    return getInterface() + "#" + getInstance();
+const std::string& PrimitiveController::getId() const {
+    return m_id;
 }
-std::string PrimitiveController::getInstance() {
+const std::string& PrimitiveController::getInstance() const {
     return m_instance;
 }
 
@@ -57,13 +57,13 @@ alexaClientSDK::avsCommon::utils::Optional<CapabilityResources> PrimitiveControl
             auto& value = item.value().at("value");
             std::string assetId = value.at("assetId");
             // Expand assets present in the AssetStore. Use the asset ID for assets that are absent
-            const std::vector<AssetStore::NameLocalePair>& names = assetStore.getFriendlyNames(assetId);
+            auto names = assetStore.getFriendlyNames(assetId);
             if (names.empty()) {
                 capabilityResources.addFriendlyNameWithAssetId(assetId);
             } else {
                 AACE_DEBUG(LX(TAG).m("expandingAssetToText").d("assetID", assetId));
-                for (auto name = names.begin(); name != names.end(); ++name) {
-                    capabilityResources.addFriendlyNameWithText(name->first, name->second);
+                for (size_t index = 0; index < names.size(); index++) {
+                    capabilityResources.addFriendlyNameWithText(names.getName(index), names.getLocale(index));
                 }
             }
         }
@@ -87,18 +87,18 @@ std::shared_ptr<ZoneDefinitions> ZoneDefinitions::create(
                 } else {
                     ThrowIfNot(type == "asset", "invalidFriendlyNameType");
                     std::string assetId = friendlyName["value"]["assetId"];
-                    const std::vector<AssetStore::NameLocalePair>& names = assetStore.getFriendlyNames(assetId);
+                    auto names = assetStore.getFriendlyNames(assetId);
                     if (names.empty()) {
                         translatedNames.push_back(friendlyName);
                     } else {
                         // Expand asset to text if the asset is in the AssetStore
-                        for (auto& name : names) {
+                        for (size_t index = 0; index < names.size(); index++) {
                             // clang-format off
                             json translatedName = {
                                 {"@type", "text"},
                                 {"value", {
-                                    {"text", name.first},
-                                    {"locale", name.second},
+                                    {"text", names.getName(index)},
+                                    {"locale", names.getLocale(index)},
                                 }}
                             };
                             // clang-format on
@@ -0,0 +1,771 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * Load generator for the car control engine.
+ *
+ * For every configuration size, a synthetic "aace.carControl" configuration is generated with the endpoints spread
+ * across the zones, each endpoint with a power, toggle, range and mode controller. The benchmark measures:
+ *
+ * - setup: the endpoints and their controllers created from the configuration, and the zone definitions translated,
+ *   like @c CarControlEngineService does at configuration, with the memory used by the configured endpoints;
+ * - controller: a storm of TurnOn, SetToggleState, SetRangeValue, AdjustRangeValue, SetMode and AdjustMode
+ *   directives dispatched to the controllers, the path of the directives from the cloud;
+ * - local: the same storm invoked on the @c CarControlServiceInterface, the path of the car control local service.
+ *
+ * The directives target random endpoints, from the given number of threads, and the latency is measured per
+ * directive. The platform interface records the values, so the benchmark measures the cost of the Engine.
+ *
+ * Usage: CarControlBenchmark [--endpoints <count>] [--zones <count>] [--directives <count>] [--threads <count>]
+ *                            [--assets <file>]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#include <AVSCommon/SDKInterfaces/Endpoints/EndpointBuilderInterface.h>
+#include <nlohmann/json.hpp>
+
+#include <AACE/CarControl/CarControl.h>
+#include <AACE/Engine/CarControl/AssetStore.h>
+#include <AACE/Engine/CarControl/CarControlEngineImpl.h>
+#include <AACE/Engine/CarControl/Endpoint.h>
+#include <AACE/Engine/CarControl/ModeController.h>
+#include <AACE/Engine/CarControl/PowerController.h>
+#include <AACE/Engine/CarControl/RangeController.h>
+#include <AACE/Engine/CarControl/ToggleController.h>
+#include <AACE/Engine/CarControl/ZoneDefinitions.h>
+#include <AACE/Engine/Utils/Memory/MemoryAccounting.h>
+
+using aace::engine::carControl::AssetStore;
+using aace::engine::carControl::CarControlServiceInterface;
+using aace::engine::utils::memory::MemoryAccounting;
+using alexaClientSDK::avsCommon::avs::AlexaResponseType;
+using alexaClientSDK::avsCommon::sdkInterfaces::AlexaStateChangeCauseType;
+using Clock = std::chrono::steady_clock;
+using json = nlohmann::json;
+
+namespace sdkInterfaces = alexaClientSDK::avsCommon::sdkInterfaces;
+
+/// Benchmark options parsed from the command line
+struct BenchmarkOptions {
+    std::vector<size_t> endpoints = {50, 200, 800};
+    size_t zones = 8;
+    size_t directives = 20000;
+    size_t threads = 1;
+    std::string assetsPath;
+};
+
+/// Measurements collected for the directives of a type
+struct DirectiveResult {
+    std::string name;
+    size_t directives = 0;
+    size_t failures = 0;
+    std::vector<Clock::duration> latencies;
+};
+
+/// The interface of the capabilities, the namespace of their directives
+static const std::string POWER_CONTROLLER = "Alexa.PowerController";
+static const std::string TOGGLE_CONTROLLER = "Alexa.ToggleController";
+static const std::string RANGE_CONTROLLER = "Alexa.RangeController";
+static const std::string MODE_CONTROLLER = "Alexa.ModeController";
+
+/// The instances of the primitive controllers of each endpoint
+static const std::string TOGGLE_INSTANCE = "heater";
+static const std::string RANGE_INSTANCE = "fanspeed";
+static const std::string MODE_INSTANCE = "position";
+
+/// The modes of the mode controllers
+static const std::vector<std::string> MODES = {"ONE", "TWO", "THREE", "FOUR"};
+
+/// The asset IDs of the friendly names, from the default assets
+static const std::vector<std::string> DEVICE_NAMES = {"Alexa.Automotive.DeviceName.Fan",
+                                                      "Alexa.Automotive.DeviceName.Heater",
+                                                      "Alexa.Automotive.DeviceName.Light",
+                                                      "Alexa.Automotive.DeviceName.Seat",
+                                                      "Alexa.Automotive.DeviceName.Vent",
+                                                      "Alexa.Automotive.DeviceName.Window"};
+static const std::vector<std::string> ZONE_NAMES = {"Alexa.Automotive.Location.Driver",
+                                                    "Alexa.Automotive.Location.Passenger",
+                                                    "Alexa.Automotive.Location.Front",
+                                                    "Alexa.Automotive.Location.Rear",
+                                                    "Alexa.Automotive.Location.FrontLeft",
+                                                    "Alexa.Automotive.Location.FrontRight",
+                                                    "Alexa.Automotive.Location.RearLeft",
+                                                    "Alexa.Automotive.Location.RearRight"};
+
+/// The endpoint ID of the internal endpoint of the zones, which the engine service skips
+static const std::string INTERNAL_ENDPOINT_ID = "_AutoSDKInternalRoot";
+
+/// The cause of the directives
+static const AlexaStateChangeCauseType CAUSE = AlexaStateChangeCauseType::VOICE_INTERACTION;
+
+/**
+ * Platform interface recording the state of the controllers, so the directives succeed. The state is shared by the
+ * threads of the storm, like the vehicle state of a platform implementation.
+ */
+class BenchmarkCarControl : public aace::carControl::CarControl {
+public:
+    bool turnPowerControllerOn(const std::string& endpointId) override {
+        return setValue(endpointId, 1);
+    }
+    bool turnPowerControllerOff(const std::string& endpointId) override {
+        return setValue(endpointId, 0);
+    }
+    bool isPowerControllerOn(const std::string& endpointId, bool& isOn) override {
+        isOn = getValue(endpointId) != 0;
+        return true;
+    }
+    bool turnToggleControllerOn(const std::string& endpointId, const std::string& controllerId) override {
+        return setValue(endpointId + "#" + controllerId, 1);
+    }
+    bool turnToggleControllerOff(const std::string& endpointId, const std::string& controllerId) override {
+        return setValue(endpointId + "#" + controllerId, 0);
+    }
+    bool isToggleControllerOn(const std::string& endpointId, const std::string& controllerId, bool& isOn) override {
+        isOn = getValue(endpointId + "#" + controllerId) != 0;
+        return true;
+    }
+    bool setRangeControllerValue(const std::string& endpointId, const std::string& controllerId, double value)
+        override {
+        return setValue(endpointId + "#" + controllerId, value);
+    }
+    bool adjustRangeControllerValue(const std::string& endpointId, const std::string& controllerId, double delta)
+        override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& value = m_values[endpointId + "#" + controllerId];
+        value = std::min(std::max(value + delta, 0.0), 10.0);
+        return true;
+    }
+    bool getRangeControllerValue(const std::string& endpointId, const std::string& controllerId, double& value)
+        override {
+        value = getValue(endpointId + "#" + controllerId);
+        return true;
+    }
+    bool setModeControllerValue(
+        const std::string& endpointId,
+        const std::string& controllerId,
+        const std::string& value) override {
+        auto it = std::find(MODES.begin(), MODES.end(), value);
+        return it != MODES.end() && setValue(endpointId + "#" + controllerId, it - MODES.begin());
+    }
+    bool adjustModeControllerValue(const std::string& endpointId, const std::string& controllerId, int delta)
+        override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& value = m_values[endpointId + "#" + controllerId];
+        value = std::min<double>(std::max<double>(value + delta, 0), MODES.size() - 1);
+        return true;
+    }
+    bool getModeControllerValue(const std::string& endpointId, const std::string& controllerId, std::string& value)
+        override {
+        value = MODES[static_cast<size_t>(getValue(endpointId + "#" + controllerId))];
+        return true;
+    }
+
+private:
+    bool setValue(const std::string& key, double value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_values[key] = value;
+        return true;
+    }
+    double getValue(const std::string& key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_values.find(key);
+        return it != m_values.end() ? it->second : 0;
+    }
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, double> m_values;
+};
+
+/// The controllers of an endpoint, as the capability agents of the AVS Device SDK see them
+struct BenchmarkEndpoint {
+    std::string endpointId;
+    std::shared_ptr<sdkInterfaces::powerController::PowerControllerInterface> powerController;
+    std::shared_ptr<sdkInterfaces::toggleController::ToggleControllerInterface> toggleController;
+    std::shared_ptr<sdkInterfaces::rangeController::RangeControllerInterface> rangeController;
+    std::shared_ptr<sdkInterfaces::modeController::ModeControllerInterface> modeController;
+};
+
+/**
+ * Endpoint builder keeping the controllers added to the endpoint, which the capability agents would dispatch the
+ * directives to. The endpoint isn't built, since it would only be registered with the endpoint registration manager.
+ */
+class BenchmarkEndpointBuilder : public sdkInterfaces::endpoints::EndpointBuilderInterface {
+public:
+    explicit BenchmarkEndpointBuilder(BenchmarkEndpoint& endpoint) : m_endpoint(endpoint) {
+    }
+
+    EndpointBuilderInterface& withDerivedEndpointId(const std::string& suffix) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withEndpointId(const sdkInterfaces::endpoints::EndpointIdentifier& endpointId) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withFriendlyName(const std::string& friendlyName) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withDescription(const std::string& description) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withManufacturerName(const std::string& manufacturerName) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withDisplayCategory(const std::vector<std::string>& displayCategories) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withAdditionalAttributes(
+        const std::string& manufacturer,
+        const std::string& model,
+        const std::string& serialNumber,
+        const std::string& firmwareVersion,
+        const std::string& softwareVersion,
+        const std::string& customIdentifier) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withConnections(
+        const std::vector<std::map<std::string, std::string>>& connections) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withCookies(const std::map<std::string, std::string>& cookies) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withPowerController(
+        std::shared_ptr<sdkInterfaces::powerController::PowerControllerInterface> powerController,
+        bool isProactivelyReported,
+        bool isRetrievable) override {
+        m_endpoint.powerController = powerController;
+        return *this;
+    }
+    EndpointBuilderInterface& withToggleController(
+        std::shared_ptr<sdkInterfaces::toggleController::ToggleControllerInterface> toggleController,
+        const std::string& instance,
+        const sdkInterfaces::toggleController::ToggleControllerAttributes& toggleControllerAttributes,
+        bool isProactivelyReported,
+        bool isRetrievable,
+        bool isNonControllable) override {
+        m_endpoint.toggleController = toggleController;
+        return *this;
+    }
+    EndpointBuilderInterface& withModeController(
+        std::shared_ptr<sdkInterfaces::modeController::ModeControllerInterface> modeController,
+        const std::string& instance,
+        const sdkInterfaces::modeController::ModeControllerAttributes& modeControllerAttributes,
+        bool isProactivelyReported,
+        bool isRetrievable,
+        bool isNonControllable) override {
+        m_endpoint.modeController = modeController;
+        return *this;
+    }
+    EndpointBuilderInterface& withRangeController(
+        std::shared_ptr<sdkInterfaces::rangeController::RangeControllerInterface> rangeController,
+        const std::string& instance,
+        const sdkInterfaces::rangeController::RangeControllerAttributes& rangeControllerAttributes,
+        bool isProactivelyReported,
+        bool isRetrievable,
+        bool isNonControllable) override {
+        m_endpoint.rangeController = rangeController;
+        return *this;
+    }
+    EndpointBuilderInterface& withEndpointResources(
+        const alexaClientSDK::avsCommon::avs::EndpointResources& endpointResources) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withCapability(
+        const alexaClientSDK::avsCommon::avs::CapabilityConfiguration& configuration,
+        std::shared_ptr<sdkInterfaces::DirectiveHandlerInterface> directiveHandler) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withCapability(
+        const std::shared_ptr<sdkInterfaces::CapabilityConfigurationInterface>& configurationInterface,
+        std::shared_ptr<sdkInterfaces::DirectiveHandlerInterface> directiveHandler) override {
+        return *this;
+    }
+    EndpointBuilderInterface& withCapabilityConfiguration(
+        const std::shared_ptr<sdkInterfaces::CapabilityConfigurationInterface>& configurationInterface) override {
+        return *this;
+    }
+    std::unique_ptr<sdkInterfaces::endpoints::EndpointInterface> build() override {
+        return nullptr;
+    }
+
+private:
+    BenchmarkEndpoint& m_endpoint;
+};
+
+static json createFriendlyNames(const std::vector<std::string>& assetIds) {
+    json friendlyNames = json::array();
+    for (auto& assetId : assetIds) {
+        friendlyNames.push_back({{"@type", "asset"}, {"value", {{"assetId", assetId}}}});
+    }
+    return {{"friendlyNames", friendlyNames}};
+}
+
+static json createPrimitiveCapability(const std::string& interface, const std::string& instance, const json& names) {
+    return {{"type", "AlexaInterface"},
+            {"interface", interface},
+            {"version", "3"},
+            {"instance", instance},
+            {"capabilityResources", names},
+            {"properties", {{"proactivelyReported", false}, {"retrievable", false}}}};
+}
+
+static json createEndpointConfig(const std::string& endpointId, size_t index) {
+    auto& deviceName = DEVICE_NAMES[index % DEVICE_NAMES.size()];
+
+    json power = {{"type", "AlexaInterface"},
+                  {"interface", POWER_CONTROLLER},
+                  {"version", "3"},
+                  {"properties", {{"proactivelyReported", false}, {"retrievable", false}}}};
+
+    auto toggle = createPrimitiveCapability(
+        TOGGLE_CONTROLLER, TOGGLE_INSTANCE, createFriendlyNames({"Alexa.Automotive.DeviceName.Heater"}));
+
+    auto range = createPrimitiveCapability(
+        RANGE_CONTROLLER, RANGE_INSTANCE, createFriendlyNames({"Alexa.Automotive.Setting.FanSpeed"}));
+    range["configuration"] = {
+        {"supportedRange", {{"minimumValue", 0}, {"maximumValue", 10}, {"precision", 1}}},
+        {"presets",
+         {{{"rangeValue", 1}, {"presetResources", createFriendlyNames({"Alexa.Automotive.Value.Minimum"})}},
+          {{"rangeValue", 10}, {"presetResources", createFriendlyNames({"Alexa.Automotive.Value.Maximum"})}}}}};
+    range["semantics"] = {
+        {"actionMappings",
+         {{{"@type", "ActionsToDirective"},
+           {"actions", {"Alexa.Actions.Raise"}},
+           {"directive", {{"name", "AdjustRangeValue"}, {"payload", {{"rangeValueDelta", 1}}}}}},
+          {{"@type", "ActionsToDirective"},
+           {"actions", {"Alexa.Actions.Lower"}},
+           {"directive", {{"name", "AdjustRangeValue"}, {"payload", {{"rangeValueDelta", -1}}}}}}}}};
+
+    auto mode = createPrimitiveCapability(
+        MODE_CONTROLLER, MODE_INSTANCE, createFriendlyNames({"Alexa.Automotive.Setting.StoredPosition"}));
+    json supportedModes = json::array();
+    for (size_t i = 0; i < MODES.size(); i++) {
+        supportedModes.push_back(
+            {{"value", MODES[i]},
+             {"modeResources", createFriendlyNames({"Alexa.Automotive.Value.Position" + std::to_string(i + 1)})}});
+    }
+    mode["configuration"] = {{"ordered", true}, {"supportedModes", supportedModes}};
+
+    return {{"endpointId", endpointId},
+            {"endpointResources", createFriendlyNames({deviceName})},
+            {"capabilities", {power, toggle, range, mode}}};
+}
+
+/// Creates a configuration of the given number of endpoints, in the format of the translated zones
+static json createConfiguration(size_t endpointCount, size_t zoneCount) {
+    json endpoints = json::array();
+    std::vector<json> members(zoneCount, json::array());
+    for (size_t i = 0; i < endpointCount; i++) {
+        auto zone = i % zoneCount;
+        auto endpointId = "zone" + std::to_string(zone) + ".endpoint" + std::to_string(i);
+        endpoints.push_back(createEndpointConfig(endpointId, i / zoneCount));
+        members[zone].push_back({{"endpointId", endpointId}});
+    }
+
+    json zones = json::array();
+    for (size_t zone = 0; zone < zoneCount; zone++) {
+        if (members[zone].empty()) {
+            continue;
+        }
+        zones.push_back(
+            {{"zoneId", "zone" + std::to_string(zone)},
+             {"zoneResources", createFriendlyNames({ZONE_NAMES[zone % ZONE_NAMES.size()]})},
+             {"members", members[zone]}});
+    }
+    json zoneDefinitions = {{"type", "AlexaInterface"},
+                            {"interface", "Alexa.Automotive.ZoneDefinitions"},
+                            {"version", "1.0"},
+                            {"configuration", {{"zones", zones}, {"defaultZoneId", "zone0"}}}};
+    endpoints.push_back(
+        {{"endpointId", INTERNAL_ENDPOINT_ID},
+         {"endpointResources", createFriendlyNames({INTERNAL_ENDPOINT_ID})},
+         {"capabilities", {zoneDefinitions}}});
+
+    return {{"endpoints", endpoints}};
+}
+
+/// Returns the resident memory of the process in bytes, or zero if it can't be read
+static int64_t getResidentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    int64_t size = 0, resident = 0;
+    if (!(statm >> size >> resident)) {
+        return 0;
+    }
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+/// The module the memory of the configured endpoints is accounted to
+static const std::string MEMORY_MODULE = "CarControlBenchmark";
+
+/// Returns the live bytes of the benchmark module, or the resident memory if memory accounting is not enabled
+static int64_t getUsedBytes() {
+    if (!MemoryAccounting::isEnabled()) {
+        return getResidentBytes();
+    }
+    for (auto& next : MemoryAccounting::getSnapshots()) {
+        if (next.module == MEMORY_MODULE) {
+            return next.liveBytes;
+        }
+    }
+    return 0;
+}
+
+/// Creates the endpoints of the configuration with their controllers, and the zone definitions, like the engine service
+static bool configure(
+    const json& configuration,
+    const AssetStore& assetStore,
+    std::vector<std::shared_ptr<aace::engine::carControl::Endpoint>>& endpoints) {
+    std::unordered_map<std::string, std::string> endpointIdMappings;
+    json zoneDefinitions;
+    for (auto& endpointConfig : configuration.at("endpoints")) {
+        if (endpointConfig.at("endpointId") == INTERNAL_ENDPOINT_ID) {
+            zoneDefinitions = endpointConfig.at("capabilities").at(0);
+            continue;
+        }
+        auto endpoint = aace::engine::carControl::Endpoint::create(endpointConfig, assetStore);
+        if (endpoint == nullptr) {
+            return false;
+        }
+        endpoints.push_back(endpoint);
+        endpointIdMappings.insert({endpoint->getId(), endpoint->getId()});
+    }
+    return aace::engine::carControl::ZoneDefinitions::create(zoneDefinitions, assetStore, endpointIdMappings) !=
+           nullptr;
+}
+
+/**
+ * Creates and builds the controllers of the configuration, which the directives are dispatched to. The endpoints
+ * keep their controllers, so the same controllers are created again for the storms.
+ */
+static bool buildControllers(
+    const json& configuration,
+    const AssetStore& assetStore,
+    std::shared_ptr<CarControlServiceInterface> service,
+    std::vector<BenchmarkEndpoint>& controllers) {
+    for (auto& endpointConfig : configuration.at("endpoints")) {
+        if (endpointConfig.at("endpointId") == INTERNAL_ENDPOINT_ID) {
+            continue;
+        }
+        BenchmarkEndpoint next;
+        next.endpointId = endpointConfig.at("endpointId");
+        std::unique_ptr<sdkInterfaces::endpoints::EndpointBuilderInterface> builder(
+            new BenchmarkEndpointBuilder(next));
+        for (auto& capability : endpointConfig.at("capabilities")) {
+            std::string interface = capability.at("interface");
+            std::shared_ptr<aace::engine::carControl::CapabilityController> controller;
+            if (interface == POWER_CONTROLLER) {
+                controller = aace::engine::carControl::PowerController::create(next.endpointId, interface);
+            } else if (interface == TOGGLE_CONTROLLER) {
+                controller = aace::engine::carControl::ToggleController::create(
+                    capability, next.endpointId, interface, assetStore);
+            } else if (interface == RANGE_CONTROLLER) {
+                controller = aace::engine::carControl::RangeController::create(
+                    capability, next.endpointId, interface, assetStore);
+            } else if (interface == MODE_CONTROLLER) {
+                controller = aace::engine::carControl::ModeController::create(
+                    capability, next.endpointId, interface, assetStore);
+            }
+            if (controller == nullptr) {
+                return false;
+            }
+            controller->build(service, builder);
+        }
+        controllers.push_back(next);
+    }
+    return true;
+}
+
+/// A directive of the storm, which returns @c true if it succeeded
+using Directive = std::function<bool(const BenchmarkEndpoint&, size_t)>;
+
+static std::vector<std::pair<std::string, Directive>> createControllerDirectives() {
+    return {
+        {"TurnOn",
+         [](const BenchmarkEndpoint& endpoint, size_t n) {
+             return endpoint.powerController->setPowerState(n % 2 == 0, CAUSE).first == AlexaResponseType::SUCCESS;
+         }},
+        {"SetToggleState",
+         [](const BenchmarkEndpoint& endpoint, size_t n) {
+             return endpoint.toggleController->setToggleState(n % 2 == 0, CAUSE).first == AlexaResponseType::SUCCESS;
+         }},
+        {"SetRangeValue",
+         [](const BenchmarkEndpoint& endpoint, size_t n) {
+             return endpoint.rangeController->setRangeValue(n % 11, CAUSE).first == AlexaResponseType::SUCCESS;
+         }},
+        {"AdjustRangeValue",
+         [](const BenchmarkEndpoint& endpoint, size_t n) {
+             return endpoint.rangeController->adjustRangeValue(n % 2 == 0 ? 1 : -1, CAUSE).first ==
+                    AlexaResponseType::SUCCESS;
+         }},
+        {"SetMode",
+         [](const BenchmarkEndpoint& endpoint, size_t n) {
+             return endpoint.modeController->setMode(MODES[n % MODES.size()], CAUSE).first ==
+                    AlexaResponseType::SUCCESS;
+         }},
+        {"AdjustMode",
+         [](const BenchmarkEndpoint& endpoint, size_t n) {
+             return endpoint.modeController->adjustMode(n % 2 == 0 ? 1 : -1, CAUSE).first ==
+                    AlexaResponseType::SUCCESS;
+         }},
+    };
+}
+
+static std::vector<std::pair<std::string, Directive>> createLocalDirectives(
+    std::shared_ptr<CarControlServiceInterface> service) {
+    return {
+        {"TurnOn",
+         [service](const BenchmarkEndpoint& endpoint, size_t n) {
+             return n % 2 == 0 ? service->turnPowerControllerOn(endpoint.endpointId)
+                               : service->turnPowerControllerOff(endpoint.endpointId);
+         }},
+        {"SetToggleState",
+         [service](const BenchmarkEndpoint& endpoint, size_t n) {
+             return n % 2 == 0 ? service->turnToggleControllerOn(endpoint.endpointId, TOGGLE_INSTANCE)
+                               : service->turnToggleControllerOff(endpoint.endpointId, TOGGLE_INSTANCE);
+         }},
+        {"SetRangeValue",
+         [service](const BenchmarkEndpoint& endpoint, size_t n) {
+             return service->setRangeControllerValue(endpoint.endpointId, RANGE_INSTANCE, n % 11);
+         }},
+        {"AdjustRangeValue",
+         [service](const BenchmarkEndpoint& endpoint, size_t n) {
+             return service->adjustRangeControllerValue(endpoint.endpointId, RANGE_INSTANCE, n % 2 == 0 ? 1 : -1);
+         }},
+        {"SetMode",
+         [service](const BenchmarkEndpoint& endpoint, size_t n) {
+             return service->setModeControllerValue(endpoint.endpointId, MODE_INSTANCE, MODES[n % MODES.size()]);
+         }},
+        {"AdjustMode",
+         [service](const BenchmarkEndpoint& endpoint, size_t n) {
+             return service->adjustModeControllerValue(endpoint.endpointId, MODE_INSTANCE, n % 2 == 0 ? 1 : -1);
+         }},
+    };
+}
+
+/// Dispatches a storm of random directives to random endpoints, and returns the result of each type of directive
+static std::vector<DirectiveResult> runStorm(
+    const std::vector<std::pair<std::string, Directive>>& directives,
+    const std::vector<BenchmarkEndpoint>& endpoints,
+    const BenchmarkOptions& options,
+    Clock::duration& elapsed) {
+    std::vector<std::vector<DirectiveResult>> threadResults(options.threads);
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (size_t t = 0; t < options.threads; t++) {
+        workers.emplace_back([&, t]() {
+            auto& results = threadResults[t];
+            results.resize(directives.size());
+            std::mt19937 random(static_cast<uint32_t>(t + 1));
+            auto count = options.directives / options.threads + (t < options.directives % options.threads ? 1 : 0);
+            for (size_t i = 0; i < count; i++) {
+                auto type = random() % directives.size();
+                auto& endpoint = endpoints[random() % endpoints.size()];
+                auto directiveStart = Clock::now();
+                auto succeeded = directives[type].second(endpoint, i);
+                results[type].latencies.push_back(Clock::now() - directiveStart);
+                results[type].directives++;
+                results[type].failures += succeeded ? 0 : 1;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    elapsed = Clock::now() - start;
+
+    std::vector<DirectiveResult> results(directives.size());
+    for (size_t type = 0; type < directives.size(); type++) {
+        results[type].name = directives[type].first;
+        for (auto& next : threadResults) {
+            results[type].directives += next[type].directives;
+            results[type].failures += next[type].failures;
+            results[type].latencies.insert(
+                results[type].latencies.end(), next[type].latencies.begin(), next[type].latencies.end());
+        }
+    }
+    return results;
+}
+
+static double toMicroseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+static Clock::duration percentile(const std::vector<Clock::duration>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return Clock::duration::zero();
+    }
+    auto index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+/// Prints the results of a storm, and returns the number of failed directives
+static size_t printResults(
+    const std::string& path,
+    size_t endpointCount,
+    std::vector<DirectiveResult>& results,
+    Clock::duration elapsed) {
+    size_t directives = 0, failures = 0;
+    std::vector<Clock::duration> all;
+    for (auto& result : results) {
+        std::sort(result.latencies.begin(), result.latencies.end());
+        std::printf(
+            "%-10s %9zu %-16s %10zu %12.1f %12.1f %12.1f\n",
+            path.c_str(),
+            endpointCount,
+            result.name.c_str(),
+            result.directives,
+            toMicroseconds(percentile(result.latencies, 0.50)),
+            toMicroseconds(percentile(result.latencies, 0.99)),
+            toMicroseconds(percentile(result.latencies, 0.999)));
+        directives += result.directives;
+        failures += result.failures;
+        all.insert(all.end(), result.latencies.begin(), result.latencies.end());
+    }
+    std::sort(all.begin(), all.end());
+    auto seconds = std::chrono::duration<double>(elapsed).count();
+    std::printf(
+        "%-10s %9zu %-16s %10zu %12.1f %12.1f %12.1f  %.0f directives/sec\n",
+        path.c_str(),
+        endpointCount,
+        "all",
+        directives,
+        toMicroseconds(percentile(all, 0.50)),
+        toMicroseconds(percentile(all, 0.99)),
+        toMicroseconds(percentile(all, 0.999)),
+        seconds > 0 ? directives / seconds : 0);
+    if (failures > 0) {
+        std::cerr << path << " (" << endpointCount << " endpoints): " << failures << " directives failed" << std::endl;
+    }
+    return failures;
+}
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string text = argv[++i];
+        auto value = std::strtoul(text.c_str(), nullptr, 10);
+        if (arg == "--endpoints" && value > 0) {
+            options.endpoints = {value};
+        } else if (arg == "--zones" && value > 0) {
+            options.zones = value;
+        } else if (arg == "--directives" && value > 0) {
+            options.directives = value;
+        } else if (arg == "--threads" && value > 0) {
+            options.threads = value;
+        } else if (arg == "--assets" && !text.empty()) {
+            options.assetsPath = text;
+        } else {
+            std::cerr << "invalid argument: " << arg << " " << text << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--endpoints <count>] [--zones <count>] [--directives <count>] [--threads <count>]"
+                  << " [--assets <file>]" << std::endl;
+        return 1;
+    }
+
+    // the friendly names are expanded from the assets, like the default assets of the engine service
+    AssetStore assetStore;
+    if (!options.assetsPath.empty() && !assetStore.addAssets(options.assetsPath)) {
+        std::cerr << "unable to read the assets: " << options.assetsPath << std::endl;
+        return 1;
+    }
+
+    std::printf(
+        "zones: %zu, directives: %zu, threads: %zu, assets: %s, memory: %s\n\n",
+        options.zones,
+        options.directives,
+        options.threads,
+        options.assetsPath.empty() ? "none" : options.assetsPath.c_str(),
+        MemoryAccounting::isEnabled() ? "live bytes" : "resident memory");
+
+    size_t failures = 0;
+    for (auto endpointCount : options.endpoints) {
+        auto configuration = createConfiguration(endpointCount, options.zones);
+        auto platformInterface = std::make_shared<BenchmarkCarControl>();
+        auto engineImpl = aace::engine::carControl::CarControlEngineImpl::create(platformInterface);
+
+        std::vector<std::shared_ptr<aace::engine::carControl::Endpoint>> endpoints;
+        endpoints.reserve(endpointCount);
+        auto usedBefore = getUsedBytes();
+        auto start = Clock::now();
+        bool configured;
+        {
+            MemoryAccounting::Scope scope(MEMORY_MODULE);
+            configured = configure(configuration, assetStore, endpoints);
+        }
+        auto setupTime = Clock::now() - start;
+        auto usedBytes = getUsedBytes() - usedBefore;
+
+        std::vector<BenchmarkEndpoint> controllers;
+        controllers.reserve(endpointCount);
+        if (!configured || !buildControllers(configuration, assetStore, engineImpl, controllers)) {
+            std::cerr << "setup failed: " << endpointCount << " endpoints" << std::endl;
+            return 1;
+        }
+        std::printf(
+            "setup: %zu endpoints in %.1f ms, %.1f KB (%.0f bytes per endpoint)\n",
+            endpoints.size(),
+            std::chrono::duration<double, std::milli>(setupTime).count(),
+            usedBytes / 1024.0,
+            static_cast<double>(usedBytes) / endpoints.size());
+
+        std::printf(
+            "%-10s %9s %-16s %10s %12s %12s %12s\n",
+            "path",
+            "endpoints",
+            "directive",
+            "count",
+            "p50 (us)",
+            "p99 (us)",
+            "p999 (us)");
+        Clock::duration elapsed;
+        auto results = runStorm(createControllerDirectives(), controllers, options, elapsed);
+        failures += printResults("controller", endpointCount, results, elapsed);
+        results = runStorm(createLocalDirectives(engineImpl), controllers, options, elapsed);
+        failures += printResults("local", endpointCount, results, elapsed);
+        std::printf("\n");
+
+        engineImpl->shutdown();
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -17,11 +17,9 @@
 #define AACE_ENGINE_CBL_CBL_AUTHORIZATION_PROVIDER_H
 
 #include <chrono>
-#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <thread>
 #include <atomic>
 
 #include <AVSCommon/SDKInterfaces/AuthObserverInterface.h>
@@ -36,6 +34,7 @@
 #include <AACE/Engine/Network/NetworkObservableInterface.h>
 #include <AACE/Engine/PropertyManager/PropertyListenerInterface.h>
 #include <AACE/Engine/PropertyManager/PropertyManagerServiceInterface.h>
+#include <AACE/Engine/Utils/Threading/AsyncFlow.h>
 #include <AACE/Engine/Utils/Threading/Executor.h>
 
 #include "CBLConfigurationInterface.h"
@@ -61,7 +60,9 @@ private:
         std::shared_ptr<aace::engine::alexa::AuthorizationManagerInterface> authorizationManagerInterface,
         std::shared_ptr<CBLConfigurationInterface> configuration,
         bool enableUserProfile,
-        std::shared_ptr<CBLLegacyEventNotificationInterface> legacyEventNotifier);
+        std::shared_ptr<CBLLegacyEventNotificationInterface> legacyEventNotifier,
+        bool enableCodePairPrefetch,
+        bool enablePersistentAccessToken);
 
     /**
      * Initializes the object.
@@ -78,7 +79,9 @@ public:
         std::shared_ptr<aace::engine::network::NetworkObservableInterface> networkObserver,
         std::shared_ptr<aace::engine::propertyManager::PropertyManagerServiceInterface> propertyManager,
         bool enableUserProfile = false,
-        std::shared_ptr<CBLLegacyEventNotificationInterface> legacyEventNotifier = nullptr);
+        std::shared_ptr<CBLLegacyEventNotificationInterface> legacyEventNotifier = nullptr,
+        bool enableCodePairPrefetch = false,
+        bool enablePersistentAccessToken = false);
 
     /// @name AuthorizationProvider
     /// @{
@@ -110,6 +113,12 @@ public:
      */
     void startAuthorizationLegacy(const std::string& data, bool explicitStart);
 
+    /**
+     * Requests a code pair in the background when the application has no refresh token, so the code pair is ready
+     * when the user starts the authorization. Does nothing unless the code pair prefetch is enabled.
+     */
+    void prefetchCodePair();
+
     // aace::engine::network::NetworkInfoObserver
     void onNetworkInfoChanged(NetworkInfoObserver::NetworkStatus status, int wifiSignalStrength) override;
     void onNetworkInterfaceChangeStatusChanged(
@@ -128,10 +137,34 @@ private:
 
     enum class FlowState { STARTING, REQUESTING_CODE_PAIR, REQUESTING_TOKEN, REFRESHING_TOKEN, STOPPING };
 
-    void stopAuthFlowThread(bool resetData, bool notifyAuthStateChange = true);
+    /// A code pair received from @c LWA
+    struct CodePair {
+        std::string userCode;
+        std::string deviceCode;
+        std::string verificationUri;
+        std::chrono::steady_clock::time_point expirationTime;
+    };
 
-    void handleAuthorizationFlow();
-    void handleRequestingUserProfile();
+    /// The requests the authorization flow waits for the response of
+    enum class FlowRequest { NONE, CODE_PAIR, TOKEN, USER_PROFILE, REFRESH };
+
+    // Alias for readability
+    using Next = aace::engine::utils::threading::AsyncFlow::Next;
+
+    void stopAuthorizationFlow(bool resetData, bool notifyAuthStateChange = true);
+
+    /// Runs a step of the authorization flow, in the handler of the flow state.
+    Next runAuthorizationFlow();
+
+    /**
+     * Moves the authorization flow to a state, whose handler runs next from its start.
+     *
+     * @param state The flow state.
+     * @return The next step of the flow.
+     */
+    Next enterFlowState(FlowState state);
+
+    void handleUserProfileResponse(const alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse& response);
 
     alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse doPost(
         const std::string& url,
@@ -143,10 +176,48 @@ private:
         const std::string& url,
         const std::vector<std::string>& headers);
 
+    /**
+     * Sends a request of the authorization flow on a request thread of the HTTP client pool, so the flow holds no
+     * thread while it waits for the response. The flow is woken up when the response is received.
+     *
+     * @param request The request.
+     * @param send The method sending the request.
+     */
+    void sendFlowRequest(
+        FlowRequest request,
+        alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse (CBLAuthorizationProvider::*send)());
+
+    /**
+     * Keeps the response of a request of the authorization flow, and wakes up the flow, unless the flow or the
+     * request it waits for changed since the request was sent.
+     */
+    void receiveFlowResponse(
+        std::shared_ptr<aace::engine::utils::threading::AsyncFlow> flow,
+        FlowRequest request,
+        const alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse& response);
+
+    /**
+     * Takes the response of a request of the authorization flow.
+     *
+     * @param request The request.
+     * @param[out] response The response.
+     * @return @c true if the response of the request was received.
+     */
+    bool takeFlowResponse(
+        FlowRequest request,
+        alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse* response);
+
+    /// Returns whether the authorization flow waits for the response of a request.
+    bool isWaitingForFlowResponse();
+
+    /// Wakes up the authorization flow. @c m_mutex must be held.
+    void wakeAuthorizationFlowLocked();
+
     FlowState handleStarting();
-    FlowState handleRequestingCodePair();
-    FlowState handleRequestingToken();
-    FlowState handleRefreshingToken();
+    Next handleRequestingCodePair();
+    Next handleRequestingToken();
+    Next handleRefreshingToken();
+    Next receiveRefreshResponse(const alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse& response);
     FlowState handleStopping();
 
     alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse requestCodePair();
@@ -157,6 +228,48 @@ private:
     alexaClientSDK::avsCommon::sdkInterfaces::AuthObserverInterface::Error receiveCodePairResponse(
         const alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse& response);
 
+    alexaClientSDK::avsCommon::sdkInterfaces::AuthObserverInterface::Error parseCodePairResponse(
+        const alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse& response,
+        CodePair* codePair);
+
+    /**
+     * Makes the code pair the one the token requests use, and notifies the application of the code pair.
+     *
+     * @param codePair The code pair.
+     * @return @c SUCCESS if the application was notified.
+     */
+    alexaClientSDK::avsCommon::sdkInterfaces::AuthObserverInterface::Error useCodePair(const CodePair& codePair);
+
+    /**
+     * Takes the prefetched code pair.
+     *
+     * @param[out] codePair The prefetched code pair.
+     * @return @c true if a prefetched code pair was taken, which doesn't expire soon.
+     */
+    bool takePrefetchedCodePair(CodePair* codePair);
+
+    /// Returns whether the prefetch executor is requesting a code pair.
+    bool isCodePairPrefetchInProgress();
+
+    /// Requests the prefetched code pair, on the prefetch executor.
+    void handlePrefetchingCodePair();
+
+    /**
+     * Restores the access token persisted by the application, when it is still valid.
+     *
+     * @return @c true if the access token was restored.
+     */
+    bool restoreAccessToken();
+
+    /**
+     * Persists the access token with the application, with its expiration time.
+     *
+     * @param accessToken The access token.
+     * @param expiresIn The time the access token expires in.
+     */
+    void persistAccessToken(const std::string& accessToken, std::chrono::seconds expiresIn);
+    void clearPersistedAccessToken();
+
     alexaClientSDK::avsCommon::sdkInterfaces::AuthObserverInterface::Error receiveTokenResponse(
         const alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse& response,
         bool expiresImmediately);
@@ -171,11 +284,26 @@ private:
 
     bool isStopping();
 
+    /**
+     * Returns whether the network is available, as last reported by the network info provider. The authorization
+     * flow is woken up when the network is connected again.
+     */
+    bool isNetworkAvailable();
+
     std::shared_ptr<CBLConfigurationInterface> m_configuration;
 
     bool m_isStopping;
     bool m_authFailureReported;
     bool m_networkWakeup;
+
+    /// Whether the network is available, as last reported by the network info provider
+    bool m_networkAvailable;
+
+    /// Whether the refresh thread is waiting for a token refresh response
+    bool m_refreshInProgress;
+
+    /// Whether a refresh is due once the network is available again
+    bool m_refreshOnNetworkAvailable;
     bool m_explicitAuthorizationRequest;
 
     /// Represents the call to `CBL::start()` to start the authorization
@@ -189,18 +317,45 @@ private:
     std::string m_deviceCode;
     std::string m_userCode;
 
-    std::thread m_authorizationFlowThread;
+    /// The authorization flow, which runs its steps on the shared thread pool and holds no thread while it waits
+    std::shared_ptr<aace::engine::utils::threading::AsyncFlow> m_authorizationFlow;
+
     std::chrono::steady_clock::time_point m_codePairExpirationTime;
     std::chrono::steady_clock::time_point m_tokenExpirationTime;
     std::chrono::steady_clock::time_point m_timeToRefresh;
     std::chrono::steady_clock::time_point m_requestTime;
 
-    std::condition_variable m_wake;
     int m_retryCount;
     bool m_newRefreshToken;
-    std::atomic<bool> m_threadActive;
+    std::atomic<bool> m_flowActive;
 
     FlowState m_flowState;
+
+    /// Whether the handler of the flow state ran its first step
+    bool m_flowStateEntered;
+
+    /// The time the code pair requests of the flow state time out
+    std::chrono::steady_clock::time_point m_codePairRequestTimeout;
+
+    /// Whether the flow state checked the prefetched code pair
+    bool m_prefetchedCodePairChecked;
+
+    /// The interval between the token requests, and the time the flow state sends its next request
+    std::chrono::seconds m_tokenRequestInterval;
+    std::chrono::steady_clock::time_point m_nextRequestTime;
+
+    /// Whether the refresh waits for its next action time, whether the token was about to expire, and the time
+    bool m_refreshWaiting;
+    bool m_refreshAboutToExpire;
+    std::chrono::steady_clock::time_point m_refreshActionTime;
+
+    /// Whether the refresh in progress is the first one of a new refresh token
+    bool m_refreshWithNewRefreshToken;
+
+    /// The request the flow waits for, and its response once received, guarded by @c m_mutex
+    FlowRequest m_flowRequest;
+    bool m_flowResponseReceived;
+    alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse m_flowResponse;
     std::string m_stateChangeReason;
     bool m_enableUserProfile;
     std::string m_scope;
@@ -227,6 +382,21 @@ private:
 
     /// Reference to the @c NetworkObservableInterface to register the observer
     std::shared_ptr<aace::engine::network::NetworkObservableInterface> m_networkObserver;
+
+    /// Whether a code pair is prefetched when the application has no refresh token
+    bool m_enableCodePairPrefetch;
+
+    /// Whether the access token is persisted with the application, to be used again after a restart
+    bool m_enablePersistentAccessToken;
+
+    /// Whether the prefetch executor is requesting a code pair
+    bool m_codePairPrefetchInProgress;
+
+    /// The prefetched code pair, with an empty device code if there is none
+    CodePair m_prefetchedCodePair;
+
+    /// The worker thread requesting the prefetched code pair, so the requests don't delay the notifications
+    aace::engine::utils::threading::Executor m_prefetchExecutor;
 };
 
 }  // namespace cbl
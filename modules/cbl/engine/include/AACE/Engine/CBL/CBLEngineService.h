@@ -70,6 +70,8 @@ private:
     std::chrono::seconds m_codePairRequestTimeout;
     std::string m_endpoint;
     bool m_enableUserProfile;
+    bool m_enableCodePairPrefetch;
+    bool m_enablePersistentAccessToken;
     std::shared_ptr<CBLAuthorizationProvider> m_cblAuthorizationProvider;
 };
 
@@ -33,6 +33,7 @@
 #include <AVSCommon/Utils/RetryTimer.h>
 
 #include <AACE/Alexa/AlexaProperties.h>
+#include <AACE/Engine/Alexa/HttpClientPool.h>
 #include "AACE/Engine/CBL/CBLAuthorizationProvider.h"
 #include "AACE/Engine/Core/EngineMacros.h"
 #include <AACE/Engine/Utils/Metrics/Metrics.h>
@@ -44,6 +45,7 @@ namespace cbl {
 using namespace aace::engine::authorization;
 using namespace aace::engine::alexa;
 using namespace aace::engine::utils::metrics;
+using aace::engine::utils::threading::AsyncFlow;
 using namespace alexaClientSDK::avsCommon::sdkInterfaces;
 using namespace alexaClientSDK::avsCommon::utils::libcurlUtils;
 using namespace rapidjson;
@@ -133,6 +135,15 @@ static const std::chrono::seconds MAX_TOKEN_REQUEST_INTERVAL = std::chrono::seco
 /// Scale factor to apply to interval between token poll requests when a 'slow_down' response is received.
 static const int TOKEN_REQUEST_SLOW_DOWN_FACTOR = 2;
 
+/// Most random time to refresh a token earlier than its refresh head start, so refreshes don't all happen at once.
+static const std::chrono::seconds MAX_TOKEN_REFRESH_JITTER = std::chrono::seconds(60);
+
+/// Fraction of the token lifetime the refresh jitter is bounded to, for the tokens with a short lifetime.
+static const int TOKEN_REFRESH_JITTER_LIFETIME_DIVISOR = 10;
+
+/// Time to wait before trying a refresh again while the network is disconnected, if it doesn't come back sooner.
+static const std::chrono::minutes OFFLINE_TOKEN_REFRESH_INTERVAL = std::chrono::minutes(5);
+
 /// Endpoint to request user profile
 static const std::string USER_PROFILE_DEFAULT_ENDPOINT = "https://api.amazon.com/user/profile";
 
@@ -163,6 +174,21 @@ static const std::string AUTHORIZATION_JSON_DATA_REFRESH_TOKEN_KEY = "refreshTok
 /// Key for the refresh token used in set/get authorization data
 static const std::string AUTHORIZATION_DATA_REFRESH_TOKEN_KEY = "refreshToken";
 
+/// JSON key for the persisted access token
+static const std::string AUTHORIZATION_JSON_DATA_ACCESS_TOKEN_KEY = "accessToken";
+
+/// JSON key for the expiration time of the persisted access token, in seconds since the epoch
+static const std::string AUTHORIZATION_JSON_DATA_EXPIRES_AT_KEY = "expiresAt";
+
+/// Key for the persisted access token used in set/get authorization data
+static const std::string AUTHORIZATION_DATA_ACCESS_TOKEN_KEY = "accessToken";
+
+/// Least remaining lifetime of a prefetched code pair for the authorization to use it.
+static const std::chrono::minutes MIN_PREFETCHED_CODE_PAIR_LIFETIME = std::chrono::minutes(2);
+
+/// Least remaining lifetime of a persisted access token for the authorization to use it after a restart.
+static const std::chrono::minutes MIN_PERSISTED_ACCESS_TOKEN_LIFETIME = std::chrono::minutes(1);
+
 /// Authorization request type user profile
 static const std::string AUTHORIZATION_REQUEST_TYPE_USER_PROFILE = "user-profile";
 
@@ -181,6 +207,12 @@ static const std::string METRIC_CODEPAIRREQUEST_FAILED = "CodePairRequestFailed"
 /// Metric for successful code pair request
 static const std::string METRIC_CODEPAIRREQUEST_SUCCESS = "CodePairRequestSuccess";
 
+/// Metric for a code pair prefetched before the authorization started
+static const std::string METRIC_CODEPAIR_PREFETCHED = "CodePairPrefetched";
+
+/// Metric for a persisted access token used after a restart
+static const std::string METRIC_ACCESSTOKEN_RESTORED = "AccessTokenRestored";
+
 /// Metric for expired code pair
 static const std::string METRIC_CODEPAIR_EXPIRED = "CodePairExpired";
 
@@ -261,6 +293,28 @@ static std::chrono::steady_clock::time_point calculateTimeToRetry(int retryCount
     return std::chrono::steady_clock::now() + RETRY_TIMER.calculateTimeToRetry(retryCount);
 }
 
+/**
+ * Calculates the time to refresh a token, ahead of its expiry by the refresh head start and by a random jitter.
+ *
+ * @param expirationTime The time the token expires.
+ * @param lifetime The lifetime of the token.
+ * @param headStart The time to refresh the token before it expires.
+ * @return The time to refresh the token.
+ */
+static std::chrono::steady_clock::time_point calculateTimeToRefresh(
+    std::chrono::steady_clock::time_point expirationTime,
+    std::chrono::seconds lifetime,
+    std::chrono::seconds headStart) {
+    auto maxJitter = std::min(MAX_TOKEN_REFRESH_JITTER, lifetime / TOKEN_REFRESH_JITTER_LIFETIME_DIVISOR);
+    if (maxJitter <= std::chrono::seconds::zero()) {
+        return expirationTime - headStart;
+    }
+    std::random_device device;
+    std::mt19937 generator(device());
+    std::uniform_int_distribution<std::chrono::seconds::rep> distribution(0, maxJitter.count());
+    return expirationTime - headStart - std::chrono::seconds(distribution(generator));
+}
+
 /**
  * Map an HTTP status code to an @c AuthObserverInterface::Error value.
  *
@@ -344,7 +398,9 @@ std::shared_ptr<CBLAuthorizationProvider> CBLAuthorizationProvider::create(
     std::shared_ptr<aace::engine::network::NetworkObservableInterface> networkObserver,
     std::shared_ptr<aace::engine::propertyManager::PropertyManagerServiceInterface> propertyManager,
     bool enableUserProfile,
-    std::shared_ptr<CBLLegacyEventNotificationInterface> legacyEventNotifier) {
+    std::shared_ptr<CBLLegacyEventNotificationInterface> legacyEventNotifier,
+    bool enableCodePairPrefetch,
+    bool enablePersistentAccessToken) {
     AACE_DEBUG(LX(TAG));
     try {
         ThrowIf(service.empty(), "invalidService");
@@ -353,7 +409,13 @@ std::shared_ptr<CBLAuthorizationProvider> CBLAuthorizationProvider::create(
         ThrowIfNull(propertyManager, "nullPropertyManagerServiceInterface");
 
         auto cblAuthorizationProvider = std::shared_ptr<CBLAuthorizationProvider>(new CBLAuthorizationProvider(
-            service, authorizationManagerInterface, configuration, enableUserProfile, legacyEventNotifier));
+            service,
+            authorizationManagerInterface,
+            configuration,
+            enableUserProfile,
+            legacyEventNotifier,
+            enableCodePairPrefetch,
+            enablePersistentAccessToken));
         ThrowIfNull(cblAuthorizationProvider, "createFailed");
 
         ThrowIfNot(cblAuthorizationProvider->initialize(propertyManager, networkObserver), "initializeFailed");
@@ -370,12 +432,17 @@ CBLAuthorizationProvider::CBLAuthorizationProvider(
     std::shared_ptr<AuthorizationManagerInterface> authorizationManagerInterface,
     std::shared_ptr<CBLConfigurationInterface> configuration,
     bool enableUserProfile,
-    std::shared_ptr<CBLLegacyEventNotificationInterface> legacyEventNotifier) :
+    std::shared_ptr<CBLLegacyEventNotificationInterface> legacyEventNotifier,
+    bool enableCodePairPrefetch,
+    bool enablePersistentAccessToken) :
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
         m_configuration{configuration},
         m_isStopping{false},
         m_authFailureReported{false},
         m_networkWakeup{true},
+        m_networkAvailable{true},
+        m_refreshInProgress{false},
+        m_refreshOnNetworkAvailable{false},
         m_explicitAuthorizationRequest{false},
         m_legacyCBLExplicitStart{false},
         m_authState{AuthObserverInterface::State::UNINITIALIZED},
@@ -383,13 +450,26 @@ CBLAuthorizationProvider::CBLAuthorizationProvider(
         m_tokenExpirationTime{std::chrono::time_point<std::chrono::steady_clock>::max()},
         m_retryCount{0},
         m_newRefreshToken{false},
-        m_threadActive{false},
+        m_flowActive{false},
+        m_flowState{FlowState::STARTING},
+        m_flowStateEntered{false},
+        m_prefetchedCodePairChecked{false},
+        m_tokenRequestInterval{MIN_TOKEN_REQUEST_INTERVAL},
+        m_refreshWaiting{false},
+        m_refreshAboutToExpire{false},
+        m_refreshWithNewRefreshToken{false},
+        m_flowRequest{FlowRequest::NONE},
+        m_flowResponseReceived{false},
         m_stateChangeReason{AUTHORIZATION_ERROR_REASON_SUCCESS},
         m_enableUserProfile{enableUserProfile},
         m_service(service),
         m_currentAuthState(AuthorizationProviderListenerInterface::AuthorizationState::UNAUTHORIZED),
         m_authorizationManager(authorizationManagerInterface),
-        m_legacyEventNotifier(legacyEventNotifier) {
+        m_legacyEventNotifier(legacyEventNotifier),
+        m_enableCodePairPrefetch(enableCodePairPrefetch),
+        m_enablePersistentAccessToken(enablePersistentAccessToken),
+        m_codePairPrefetchInProgress(false),
+        m_prefetchExecutor("CBLCodePairPrefetch") {
 }
 
 bool CBLAuthorizationProvider::initialize(
@@ -427,14 +507,16 @@ void CBLAuthorizationProvider::doShutdown() {
     m_executor.waitForSubmittedTasks();
     m_executor.shutdown();
 
-    // Stop and wait for the thread to finish
+    // Stop the flow, and wait for its running step to return
+    std::shared_ptr<AsyncFlow> authorizationFlow;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_isStopping = true;
-        m_wake.notify_one();
+        authorizationFlow = m_authorizationFlow;
     }
-    if (m_authorizationFlowThread.joinable()) {
-        m_authorizationFlowThread.join();
+    m_prefetchExecutor.shutdown();
+    if (authorizationFlow != nullptr) {
+        authorizationFlow->cancel();
     }
     if (m_configuration) {
         m_configuration.reset();
@@ -452,6 +534,75 @@ void CBLAuthorizationProvider::startAuthorizationLegacy(const std::string& data,
     startAuthorization(data);
 }
 
+void CBLAuthorizationProvider::prefetchCodePair() {
+    AACE_DEBUG(LX(TAG).d("enabled", m_enableCodePairPrefetch));
+    ReturnIfNot(m_enableCodePairPrefetch);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ReturnIf(m_codePairPrefetchInProgress);
+        m_codePairPrefetchInProgress = true;
+    }
+    m_prefetchExecutor.submit([this]() {
+        handlePrefetchingCodePair();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_codePairPrefetchInProgress = false;
+        wakeAuthorizationFlowLocked();
+    });
+}
+
+void CBLAuthorizationProvider::handlePrefetchingCodePair() {
+    try {
+        {
+            // An authorization in progress requests its own code pair
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_currentAuthState != AuthorizationProviderListenerInterface::AuthorizationState::UNAUTHORIZED) {
+                AACE_DEBUG(LX(TAG).m("prefetchSkipped").d("currentAuthState", m_currentAuthState));
+                return;
+            }
+            ThrowIfNot(m_networkAvailable, "networkNotAvailable");
+        }
+
+        // The application keeps the refresh token of the previous authorization, which is refreshed instead
+        auto listener = getAuthorizationProviderListener();
+        ThrowIfNull(listener, "invalidListenerReference");
+        auto data = listener->onGetAuthorizationData(m_service, AUTHORIZATION_DATA_REFRESH_TOKEN_KEY);
+        if (!data.empty()) {
+            auto refreshTokenJson = json::parse(data);
+            if (refreshTokenJson.contains(AUTHORIZATION_JSON_DATA_REFRESH_TOKEN_KEY) &&
+                refreshTokenJson[AUTHORIZATION_JSON_DATA_REFRESH_TOKEN_KEY].is_string() &&
+                !refreshTokenJson[AUTHORIZATION_JSON_DATA_REFRESH_TOKEN_KEY].get<std::string>().empty()) {
+                AACE_DEBUG(LX(TAG).m("refreshTokenAvailable"));
+                return;
+            }
+        }
+
+        CodePair codePair;
+        auto result = parseCodePairResponse(requestCodePair(), &codePair);
+        ThrowIfNot(result == AuthObserverInterface::Error::SUCCESS, "requestCodePairFailed");
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_prefetchedCodePair = codePair;
+        AACE_DEBUG(LX(TAG).m("codePairPrefetched"));
+    } catch (std::exception& ex) {
+        AACE_WARN(LX(TAG).d("reason", ex.what()));
+    }
+}
+
+bool CBLAuthorizationProvider::takePrefetchedCodePair(CodePair* codePair) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_prefetchedCodePair.deviceCode.empty()) {
+        return false;
+    }
+    *codePair = m_prefetchedCodePair;
+    m_prefetchedCodePair = CodePair();
+    return std::chrono::steady_clock::now() + MIN_PREFETCHED_CODE_PAIR_LIFETIME < codePair->expirationTime;
+}
+
+bool CBLAuthorizationProvider::isCodePairPrefetchInProgress() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_codePairPrefetchInProgress;
+}
+
 bool CBLAuthorizationProvider::startAuthorization(const std::string& data) {
     AACE_DEBUG(LX(TAG));
     try {
@@ -505,13 +656,22 @@ bool CBLAuthorizationProvider::startAuthorization(const std::string& data) {
             return true;
         }
 
-        if (m_threadActive == false) {
+        if (m_flowActive == false) {
+            // The previous flow is done, and the response of its last request is dropped
+            std::weak_ptr<CBLAuthorizationProvider> wp = shared_from_this();
+            auto authorizationFlow = AsyncFlow::create("CBLAuthorization", [wp]() {
+                auto provider = wp.lock();
+                return provider != nullptr ? provider->runAuthorizationFlow() : Next::done();
+            });
+            ThrowIfNull(authorizationFlow, "createAuthorizationFlowFailed");
             m_isStopping = false;
-            if (m_authorizationFlowThread.joinable()) {
-                m_authorizationFlowThread.join();
-            }
-            m_threadActive = true;
-            m_authorizationFlowThread = std::thread(&CBLAuthorizationProvider::handleAuthorizationFlow, this);
+            m_flowState = FlowState::STARTING;
+            m_flowStateEntered = false;
+            m_flowRequest = FlowRequest::NONE;
+            m_flowResponseReceived = false;
+            m_authorizationFlow = authorizationFlow;
+            ThrowIfNot(m_authorizationFlow->start(), "startAuthorizationFlowFailed");
+            m_flowActive = true;
         }
         return true;
     } catch (std::exception& ex) {
@@ -527,7 +687,7 @@ bool CBLAuthorizationProvider::cancelAuthorization() {
             m_currentAuthState == AuthorizationProviderListenerInterface::AuthorizationState::UNAUTHORIZED,
             "notSupportedWhenUnauthorized");
 
-        stopAuthFlowThread(false);
+        stopAuthorizationFlow(false);
 
         std::lock_guard<std::mutex> lock(m_mutex);
         if (m_currentAuthState == AuthorizationProviderListenerInterface::AuthorizationState::AUTHORIZING) {
@@ -557,7 +717,7 @@ bool CBLAuthorizationProvider::logout() {
         ThrowIf(
             m_currentAuthState == AuthorizationProviderListenerInterface::AuthorizationState::AUTHORIZING,
             "notAllowedDuringAuthorizing");
-        stopAuthFlowThread(false);
+        stopAuthorizationFlow(false);
         m_executor.submit([this]() {
             try {
                 AACE_DEBUG(LX(TAG, "logoutInsideExecutor"));
@@ -581,31 +741,36 @@ bool CBLAuthorizationProvider::logout() {
     }
 }
 
-void CBLAuthorizationProvider::handleAuthorizationFlow() {
-    AACE_DEBUG(LX(TAG));
-    m_flowState = FlowState::STARTING;
-    while (!isStopping()) {
-        auto nextFlowState = FlowState::STOPPING;
-        switch (m_flowState) {
-            case FlowState::STARTING:
-                nextFlowState = handleStarting();
-                break;
-            case FlowState::REQUESTING_CODE_PAIR:
-                nextFlowState = handleRequestingCodePair();
-                break;
-            case FlowState::REQUESTING_TOKEN:
-                nextFlowState = handleRequestingToken();
-                break;
-            case FlowState::REFRESHING_TOKEN:
-                nextFlowState = handleRefreshingToken();
-                break;
-            case FlowState::STOPPING:
-                nextFlowState = handleStopping();
-                break;
-        }
-        m_flowState = nextFlowState;
+AsyncFlow::Next CBLAuthorizationProvider::runAuthorizationFlow() {
+    if (isStopping()) {
+        m_flowActive = false;
+        return Next::done();
     }
-    m_threadActive = false;
+    switch (m_flowState) {
+        case FlowState::STARTING:
+            return enterFlowState(handleStarting());
+        case FlowState::REQUESTING_CODE_PAIR:
+            return handleRequestingCodePair();
+        case FlowState::REQUESTING_TOKEN:
+            return handleRequestingToken();
+        case FlowState::REFRESHING_TOKEN:
+            return handleRefreshingToken();
+        case FlowState::STOPPING:
+            return enterFlowState(handleStopping());
+    }
+    return enterFlowState(FlowState::STOPPING);
+}
+
+AsyncFlow::Next CBLAuthorizationProvider::enterFlowState(FlowState state) {
+    m_flowState = state;
+    m_flowStateEntered = false;
+    {
+        // A state waits for the responses of its own requests only
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_flowRequest = FlowRequest::NONE;
+        m_flowResponseReceived = false;
+    }
+    return Next::now();
 }
 
 alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse CBLAuthorizationProvider::doPost(
@@ -614,12 +779,7 @@ alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse CBLAuthorizationPro
     const std::vector<std::pair<std::string, std::string>>& data,
     std::chrono::seconds timeout) {
     try {
-        // Creating the HttpPost on every doPost is by design to ensure that curl in libcurlUtils uses the
-        // latest provided curl options.
-        auto httpPost = HttpPost::create();
-        ThrowIfNull(httpPost, "nullHttpPost");
-
-        return httpPost->doPost(url, headerLines, data, timeout);
+        return HttpClientPool::getInstance()->doPost(url, headerLines, data, timeout);
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse();
@@ -630,18 +790,77 @@ alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse CBLAuthorizationPro
     const std::string& url,
     const std::vector<std::string>& headers) {
     try {
-        // Creating the HttpGet on every doGet is by design to ensure that curl in libcurlUtils uses the
-        // latest provided curl options.
-        auto httpGet = alexaClientSDK::avsCommon::utils::libcurlUtils::HttpGet::create();
-        ThrowIfNull(httpGet, "nullHttpGet");
-
-        return httpGet->doGet(url, headers, m_configuration->getRequestTimeout());
+        return HttpClientPool::getInstance()->doGet(url, headers, m_configuration->getRequestTimeout());
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse();
     }
 }
 
+void CBLAuthorizationProvider::sendFlowRequest(FlowRequest request, HTTPResponse (CBLAuthorizationProvider::*send)()) {
+    std::shared_ptr<AsyncFlow> authorizationFlow;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_flowRequest = request;
+        m_flowResponseReceived = false;
+        authorizationFlow = m_authorizationFlow;
+    }
+
+    // The request threads go on with the request after the provider is released, so they hold it weakly
+    std::weak_ptr<CBLAuthorizationProvider> wp = shared_from_this();
+    auto submitted = HttpClientPool::getInstance()->submit(
+        [wp, send](HttpClientPool&) {
+            auto provider = wp.lock();
+            return provider != nullptr ? ((*provider).*send)() : HTTPResponse();
+        },
+        [wp, authorizationFlow, request](const HTTPResponse& response) {
+            if (auto provider = wp.lock()) {
+                provider->receiveFlowResponse(authorizationFlow, request, response);
+            }
+        });
+    if (!submitted) {
+        // A request that is not sent fails like one that could not connect
+        receiveFlowResponse(authorizationFlow, request, HTTPResponse());
+    }
+}
+
+void CBLAuthorizationProvider::receiveFlowResponse(
+    std::shared_ptr<AsyncFlow> flow,
+    FlowRequest request,
+    const HTTPResponse& response) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (flow != m_authorizationFlow || request != m_flowRequest) {
+        AACE_DEBUG(LX(TAG).m("staleResponseDropped"));
+        return;
+    }
+    m_flowResponse = response;
+    m_flowResponseReceived = true;
+    flow->wake();
+}
+
+bool CBLAuthorizationProvider::takeFlowResponse(FlowRequest request, HTTPResponse* response) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_flowRequest != request || !m_flowResponseReceived) {
+        return false;
+    }
+    *response = m_flowResponse;
+    m_flowResponse = HTTPResponse();
+    m_flowRequest = FlowRequest::NONE;
+    m_flowResponseReceived = false;
+    return true;
+}
+
+bool CBLAuthorizationProvider::isWaitingForFlowResponse() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_flowRequest != FlowRequest::NONE;
+}
+
+void CBLAuthorizationProvider::wakeAuthorizationFlowLocked() {
+    if (m_authorizationFlow != nullptr) {
+        m_authorizationFlow->wake();
+    }
+}
+
 CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleStarting() {
     try {
         AACE_DEBUG(LX(TAG));
@@ -677,6 +896,12 @@ CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleStarting() {
             return FlowState::REQUESTING_CODE_PAIR;
         }
 
+        // The access token of the previous run authorizes the requests while it is refreshed
+        if (m_enablePersistentAccessToken && restoreAccessToken()) {
+            emitUniqueCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "handleStarting", METRIC_ACCESSTOKEN_RESTORED, 1);
+            setAuthState(AuthObserverInterface::State::REFRESHED);
+        }
+
         return FlowState::REFRESHING_TOKEN;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -684,27 +909,42 @@ CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleStarting() {
     }
 }  // namespace cbl
 
-CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleRequestingCodePair() {
+AsyncFlow::Next CBLAuthorizationProvider::handleRequestingCodePair() {
     try {
-        AACE_DEBUG(LX(TAG));
-        if (m_legacyEventNotifier) {
-            m_legacyEventNotifier->cblStateChanged(
-                CBLLegacyEventNotificationInterface::CBLState::REQUESTING_CODE_PAIR,
-                CBLLegacyEventNotificationInterface::CBLStateChangedReason::SUCCESS);
+        if (!m_flowStateEntered) {
+            m_flowStateEntered = true;
+            AACE_DEBUG(LX(TAG));
+            if (m_legacyEventNotifier) {
+                m_legacyEventNotifier->cblStateChanged(
+                    CBLLegacyEventNotificationInterface::CBLState::REQUESTING_CODE_PAIR,
+                    CBLLegacyEventNotificationInterface::CBLStateChangedReason::SUCCESS);
+            }
+
+            m_retryCount = 0;
+            m_codePairRequestTimeout = std::chrono::steady_clock::now() + m_configuration->getCodePairRequestTimeout();
+            m_nextRequestTime = std::chrono::steady_clock::time_point::min();
+            m_prefetchedCodePairChecked = false;
         }
 
-        m_retryCount = 0;
-        std::chrono::steady_clock::time_point codePairRequestTimeout =
-            std::chrono::steady_clock::now() + m_configuration->getCodePairRequestTimeout();
-        while (!isStopping()) {
-            if (std::chrono::steady_clock::now() >= codePairRequestTimeout) {
+        if (!m_prefetchedCodePairChecked) {
+            // The prefetch in progress wakes up the flow when it completes
+            if (isCodePairPrefetchInProgress() && std::chrono::steady_clock::now() < m_codePairRequestTimeout) {
+                return Next::at(m_codePairRequestTimeout);
+            }
+            m_prefetchedCodePairChecked = true;
+
+            CodePair prefetchedCodePair;
+            if (takePrefetchedCodePair(&prefetchedCodePair) &&
+                useCodePair(prefetchedCodePair) == AuthObserverInterface::Error::SUCCESS) {
                 emitUniqueCounterMetrics(
-                    METRIC_PROGRAM_NAME_SUFFIX, "handleRequestingCodePair", METRIC_CODEPAIRREQUEST_TIMEOUT, 1);
-                m_stateChangeReason = AUTHORIZATION_ERROR_REASON_TIMEOUT;
-                return FlowState::STOPPING;
+                    METRIC_PROGRAM_NAME_SUFFIX, "handleRequestingCodePair", METRIC_CODEPAIR_PREFETCHED, 1);
+                return enterFlowState(FlowState::REQUESTING_TOKEN);
             }
+        }
 
-            auto result = receiveCodePairResponse(requestCodePair());
+        HTTPResponse response;
+        if (takeFlowResponse(FlowRequest::CODE_PAIR, &response)) {
+            auto result = receiveCodePairResponse(response);
             std::stringstream codePairResult;
             codePairResult << result;
             if (result == AuthObserverInterface::Error::SUCCESS) {
@@ -718,7 +958,7 @@ CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleRequestingCo
             }
             switch (result) {
                 case AuthObserverInterface::Error::SUCCESS:
-                    return FlowState::REQUESTING_TOKEN;
+                    return enterFlowState(FlowState::REQUESTING_TOKEN);
                 case AuthObserverInterface::Error::UNKNOWN_ERROR:
                 case AuthObserverInterface::Error::AUTHORIZATION_FAILED:
                 case AuthObserverInterface::Error::SERVER_ERROR:
@@ -735,42 +975,62 @@ CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleRequestingCo
                 case AuthObserverInterface::Error::INVALID_CBL_CLIENT_ID: {
                     setAuthState(AuthObserverInterface::State::UNRECOVERABLE_ERROR);
                     m_stateChangeReason = AUTHORIZATION_ERROR_REASON_UNKNOWN_ERROR;
-                    return FlowState::STOPPING;
+                    return enterFlowState(FlowState::STOPPING);
                 }
             }
+            m_nextRequestTime = calculateTimeToRetry(m_retryCount++);
+        }
+        if (isWaitingForFlowResponse()) {
+            return Next::suspend();
+        }
 
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_wake.wait_until(lock, calculateTimeToRetry(m_retryCount++), [this] { return m_isStopping; });
+        auto now = std::chrono::steady_clock::now();
+        if (now >= m_codePairRequestTimeout) {
+            emitUniqueCounterMetrics(
+                METRIC_PROGRAM_NAME_SUFFIX, "handleRequestingCodePair", METRIC_CODEPAIRREQUEST_TIMEOUT, 1);
+            m_stateChangeReason = AUTHORIZATION_ERROR_REASON_TIMEOUT;
+            return enterFlowState(FlowState::STOPPING);
         }
 
-        m_stateChangeReason = AUTHORIZATION_ERROR_REASON_SUCCESS;
-        return FlowState::STOPPING;
+        // The flow may be woken up for another reason before the retry is due
+        if (now < m_nextRequestTime) {
+            return Next::at(m_nextRequestTime);
+        }
+        if (!isNetworkAvailable()) {
+            return Next::at(m_codePairRequestTimeout);
+        }
+
+        sendFlowRequest(FlowRequest::CODE_PAIR, &CBLAuthorizationProvider::requestCodePair);
+        return Next::suspend();
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return FlowState::STOPPING;
+        return enterFlowState(FlowState::STOPPING);
     }
 }
 
-CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleRequestingToken() {
+AsyncFlow::Next CBLAuthorizationProvider::handleRequestingToken() {
     try {
-        AACE_DEBUG(LX(TAG));
-        if (m_legacyEventNotifier) {
-            m_legacyEventNotifier->cblStateChanged(
-                CBLLegacyEventNotificationInterface::CBLState::REQUESTING_TOKEN,
-                CBLLegacyEventNotificationInterface::CBLStateChangedReason::NONE);
+        if (!m_flowStateEntered) {
+            m_flowStateEntered = true;
+            AACE_DEBUG(LX(TAG));
+            if (m_legacyEventNotifier) {
+                m_legacyEventNotifier->cblStateChanged(
+                    CBLLegacyEventNotificationInterface::CBLState::REQUESTING_TOKEN,
+                    CBLLegacyEventNotificationInterface::CBLStateChangedReason::NONE);
+            }
+
+            m_tokenRequestInterval = MIN_TOKEN_REQUEST_INTERVAL;
+            m_nextRequestTime = std::chrono::steady_clock::time_point::min();
         }
 
-        auto interval = MIN_TOKEN_REQUEST_INTERVAL;
-        while (!isStopping()) {
-            // If the code pair expired, stop
-            if (std::chrono::steady_clock::now() >= m_codePairExpirationTime) {
-                emitUniqueCounterMetrics(
-                    METRIC_PROGRAM_NAME_SUFFIX, "handleRequestingToken", METRIC_CODEPAIR_EXPIRED, 1);
-                m_stateChangeReason = AUTHORIZATION_ERROR_REASON_CODE_PAIR_EXPIRED;
-                return FlowState::STOPPING;
-            }
+        HTTPResponse response;
+        if (takeFlowResponse(FlowRequest::USER_PROFILE, &response)) {
+            handleUserProfileResponse(response);
+            return enterFlowState(FlowState::REFRESHING_TOKEN);
+        }
 
-            auto result = receiveTokenResponse(requestToken(), true);
+        if (takeFlowResponse(FlowRequest::TOKEN, &response)) {
+            auto result = receiveTokenResponse(response, true);
             std::stringstream requestTokenResult;
             requestTokenResult << result;
             if (result == AuthObserverInterface::Error::SUCCESS) {
@@ -784,19 +1044,22 @@ CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleRequestingTo
             }
             switch (result) {
                 case AuthObserverInterface::Error::SUCCESS:
-                    if (m_enableUserProfile) {
-                        handleRequestingUserProfile();
-                    }
                     m_newRefreshToken = true;
                     m_explicitAuthorizationRequest = false;  // Reset since we got successful in getting token
-                    return FlowState::REFRESHING_TOKEN;
+                    if (m_enableUserProfile) {
+                        // The refresh starts once the user profile is received
+                        sendFlowRequest(FlowRequest::USER_PROFILE, &CBLAuthorizationProvider::requestUserProfile);
+                        return Next::suspend();
+                    }
+                    return enterFlowState(FlowState::REFRESHING_TOKEN);
                 case AuthObserverInterface::Error::UNKNOWN_ERROR:
                 case AuthObserverInterface::Error::AUTHORIZATION_FAILED:
                 case AuthObserverInterface::Error::SERVER_ERROR:
                 case AuthObserverInterface::Error::AUTHORIZATION_PENDING:
                     break;
                 case AuthObserverInterface::Error::SLOW_DOWN:
-                    interval = std::min(interval * TOKEN_REQUEST_SLOW_DOWN_FACTOR, MAX_TOKEN_REQUEST_INTERVAL);
+                    m_tokenRequestInterval =
+                        std::min(m_tokenRequestInterval * TOKEN_REQUEST_SLOW_DOWN_FACTOR, MAX_TOKEN_REQUEST_INTERVAL);
                     break;
                 case AuthObserverInterface::Error::AUTHORIZATION_EXPIRED:
                     if (m_explicitAuthorizationRequest) {
@@ -804,14 +1067,14 @@ CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleRequestingTo
                         // explicit start of CBL authorization.
                         m_explicitAuthorizationRequest =
                             false;  // Don't loop continuously in code pair requesting state
-                        return FlowState::REQUESTING_CODE_PAIR;
+                        return enterFlowState(FlowState::REQUESTING_CODE_PAIR);
                     } else {
                         setAuthState(AuthObserverInterface::State::UNRECOVERABLE_ERROR);
                         m_stateChangeReason = AUTHORIZATION_ERROR_REASON_AUTHORIZATION_EXPIRED;
-                        return FlowState::STOPPING;
+                        return enterFlowState(FlowState::STOPPING);
                     }
                 case AuthObserverInterface::Error::INVALID_CODE_PAIR:
-                    return FlowState::REQUESTING_CODE_PAIR;
+                    return enterFlowState(FlowState::REQUESTING_CODE_PAIR);
                 case AuthObserverInterface::Error::UNAUTHORIZED_CLIENT:
                 case AuthObserverInterface::Error::INVALID_REQUEST:
                 case AuthObserverInterface::Error::INVALID_VALUE:
@@ -820,145 +1083,198 @@ CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleRequestingTo
                 case AuthObserverInterface::Error::INVALID_CBL_CLIENT_ID: {
                     setAuthState(AuthObserverInterface::State::UNRECOVERABLE_ERROR);
                     m_stateChangeReason = AUTHORIZATION_ERROR_REASON_UNKNOWN_ERROR;
-                    return FlowState::STOPPING;
+                    return enterFlowState(FlowState::STOPPING);
                 }
             }
+            m_nextRequestTime = std::chrono::steady_clock::now() + m_tokenRequestInterval;
+        }
+        if (isWaitingForFlowResponse()) {
+            return Next::suspend();
+        }
 
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_wake.wait_for(lock, interval, [this] { return m_isStopping; });
+        // If the code pair expired, stop
+        auto now = std::chrono::steady_clock::now();
+        if (now >= m_codePairExpirationTime) {
+            emitUniqueCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "handleRequestingToken", METRIC_CODEPAIR_EXPIRED, 1);
+            m_stateChangeReason = AUTHORIZATION_ERROR_REASON_CODE_PAIR_EXPIRED;
+            return enterFlowState(FlowState::STOPPING);
         }
 
-        m_stateChangeReason = AUTHORIZATION_ERROR_REASON_SUCCESS;
-        return FlowState::STOPPING;
+        if (now < m_nextRequestTime) {
+            return Next::at(m_nextRequestTime);
+        }
+        if (!isNetworkAvailable()) {
+            return Next::at(m_codePairExpirationTime);
+        }
+
+        sendFlowRequest(FlowRequest::TOKEN, &CBLAuthorizationProvider::requestToken);
+        return Next::suspend();
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return FlowState::STOPPING;
+        return enterFlowState(FlowState::STOPPING);
     }
 }
 
-CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleRefreshingToken() {
+AsyncFlow::Next CBLAuthorizationProvider::handleRefreshingToken() {
     try {
-        AACE_DEBUG(LX(TAG));
-        if (m_legacyEventNotifier) {
-            m_legacyEventNotifier->cblStateChanged(
-                CBLLegacyEventNotificationInterface::CBLState::REFRESHING_TOKEN,
-                CBLLegacyEventNotificationInterface::CBLStateChangedReason::NONE);
-        }
+        if (!m_flowStateEntered) {
+            m_flowStateEntered = true;
+            AACE_DEBUG(LX(TAG));
+            if (m_legacyEventNotifier) {
+                m_legacyEventNotifier->cblStateChanged(
+                    CBLLegacyEventNotificationInterface::CBLState::REFRESHING_TOKEN,
+                    CBLLegacyEventNotificationInterface::CBLStateChangedReason::NONE);
+            }
 
-        m_retryCount = 0;
-        while (!isStopping()) {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            bool isAboutToExpire =
-                (AuthObserverInterface::State::REFRESHED == m_authState && m_tokenExpirationTime < m_timeToRefresh);
+            m_retryCount = 0;
+            m_refreshWaiting = false;
+        }
 
-            auto nextActionTime = (isAboutToExpire ? m_tokenExpirationTime : m_timeToRefresh);
+        HTTPResponse response;
+        if (takeFlowResponse(FlowRequest::REFRESH, &response)) {
+            return receiveRefreshResponse(response);
+        }
+        if (isWaitingForFlowResponse()) {
+            return Next::suspend();
+        }
 
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_refreshWaiting) {
+            m_refreshAboutToExpire =
+                (AuthObserverInterface::State::REFRESHED == m_authState && m_tokenExpirationTime < m_timeToRefresh);
+            m_refreshActionTime = (m_refreshAboutToExpire ? m_tokenExpirationTime : m_timeToRefresh);
             m_networkWakeup = false;
-            m_wake.wait_until(
-                lock, nextActionTime, [this] { return m_authFailureReported || m_isStopping || m_networkWakeup; });
+            m_refreshWaiting = true;
+        }
 
-            if (m_networkWakeup) {
-                m_networkWakeup = false;
-            }
+        // The flow may be woken up for another reason before the action time
+        if (!(m_authFailureReported || m_isStopping || m_networkWakeup) &&
+            std::chrono::steady_clock::now() < m_refreshActionTime) {
+            return Next::at(m_refreshActionTime);
+        }
+        m_refreshWaiting = false;
 
-            if (m_isStopping) {
-                break;
-            }
+        // The network wakes the refresh only when a refresh is due, see onNetworkInfoChanged()
+        bool networkWakeup = m_networkWakeup;
+        m_networkWakeup = false;
 
-            auto nextState = m_authState;
-            if (isAboutToExpire && !m_authFailureReported) {
-                m_accessToken.clear();
-                lock.unlock();
-                nextState = AuthObserverInterface::State::EXPIRED;
-            } else {
-                m_authFailureReported = false;
-                isAboutToExpire = false;
-                bool newRefreshToken = m_newRefreshToken;
-                m_newRefreshToken = false;
-                lock.unlock();
+        if (m_isStopping) {
+            lock.unlock();
+            m_stateChangeReason = AUTHORIZATION_ERROR_REASON_SUCCESS;
+            return enterFlowState(FlowState::STOPPING);
+        }
 
-                auto listener = getAuthorizationProviderListener();
-                ThrowIfNull(listener, "invalidListenerReference");
+        if (m_refreshAboutToExpire && !m_authFailureReported && !networkWakeup) {
+            m_accessToken.clear();
+            lock.unlock();
+            setAuthState(AuthObserverInterface::State::EXPIRED);
+            return Next::now();
+        } else if (!m_networkAvailable) {
+            // A refresh would fail while the network is disconnected, so refresh as soon as it is connected
+            // again instead of retrying. The token still expires on time in the meantime.
+            AACE_DEBUG(LX(TAG).m("refreshDeferredUntilNetworkAvailable"));
+            m_authFailureReported = false;
+            m_refreshOnNetworkAvailable = true;
+            m_timeToRefresh = std::chrono::steady_clock::now() + OFFLINE_TOKEN_REFRESH_INTERVAL;
+            return Next::now();
+        }
 
-                auto data = listener->onGetAuthorizationData(m_service, AUTHORIZATION_DATA_REFRESH_TOKEN_KEY);
-                ThrowIf(data.empty(), "invalidAuthorizationData");
+        m_authFailureReported = false;
+        m_refreshWithNewRefreshToken = m_newRefreshToken;
+        m_newRefreshToken = false;
+        lock.unlock();
 
-                auto refreshTokenJson = json::parse(data);
-                if (refreshTokenJson.contains(AUTHORIZATION_JSON_DATA_REFRESH_TOKEN_KEY) &&
-                    refreshTokenJson[AUTHORIZATION_JSON_DATA_REFRESH_TOKEN_KEY].is_string()) {
-                    m_refreshToken = refreshTokenJson[AUTHORIZATION_JSON_DATA_REFRESH_TOKEN_KEY];
-                } else {
-                    Throw("invalidRefreshToken");
-                }
+        auto listener = getAuthorizationProviderListener();
+        ThrowIfNull(listener, "invalidListenerReference");
 
-                auto result = receiveTokenResponse(requestRefresh(), false);
-                m_refreshToken.clear();
-                std::stringstream refreshTokenResult;
-                refreshTokenResult << result;
-                if (result == AuthObserverInterface::Error::SUCCESS) {
-                    emitUniqueCounterMetrics(
-                        METRIC_PROGRAM_NAME_SUFFIX, "handleRefreshingToken", METRIC_REQUESTTOKEN_SUCCESS, 1);
-                } else {
-                    emitUniqueCounterMetrics(
-                        METRIC_PROGRAM_NAME_SUFFIX,
-                        "handleRefreshingToken",
-                        {METRIC_REQUESTTOKEN_FAILED, refreshTokenResult.str()});
-                }
-                switch (result) {
-                    case AuthObserverInterface::Error::SUCCESS:
-                        m_retryCount = 0;
-                        nextState = AuthObserverInterface::State::REFRESHED;
-                        break;
-                    case AuthObserverInterface::Error::UNKNOWN_ERROR:
-                    case AuthObserverInterface::Error::SERVER_ERROR:
-                    case AuthObserverInterface::Error::AUTHORIZATION_FAILED:
-                    case AuthObserverInterface::Error::AUTHORIZATION_PENDING:
-                    case AuthObserverInterface::Error::SLOW_DOWN:
-                        m_timeToRefresh = calculateTimeToRetry(m_retryCount++);
-                        break;
-                    case AuthObserverInterface::Error::INVALID_CODE_PAIR:
-                        clearRefreshToken();
-                        return FlowState::REQUESTING_CODE_PAIR;
-                    case AuthObserverInterface::Error::AUTHORIZATION_EXPIRED:
-                        clearRefreshToken();
-                        if (m_explicitAuthorizationRequest) {
-                            // Fall back to requesting code pair state if the application provides an invalid refresh token during
-                            // explicit start of CBL authorization.
-                            m_explicitAuthorizationRequest = false;  // Not to loop continuously
-                            return FlowState::REQUESTING_CODE_PAIR;
-                        } else {
-                            setAuthState(AuthObserverInterface::State::UNRECOVERABLE_ERROR);
-                            m_stateChangeReason = AUTHORIZATION_ERROR_REASON_AUTHORIZATION_EXPIRED;
-                            return FlowState::STOPPING;
-                        }
-                    case AuthObserverInterface::Error::INVALID_REQUEST:
-                        if (newRefreshToken) {
-                            setAuthError(AuthObserverInterface::Error::INVALID_CBL_CLIENT_ID);
-                        }
-                    // Falls through
-                    case AuthObserverInterface::Error::UNAUTHORIZED_CLIENT:
-                    case AuthObserverInterface::Error::INVALID_VALUE:
-                    case AuthObserverInterface::Error::UNSUPPORTED_GRANT_TYPE:
-                    case AuthObserverInterface::Error::INTERNAL_ERROR:
-                    case AuthObserverInterface::Error::INVALID_CBL_CLIENT_ID: {
-                        clearRefreshToken();
-                        setAuthState(AuthObserverInterface::State::UNRECOVERABLE_ERROR);
-                        m_stateChangeReason = AUTHORIZATION_ERROR_REASON_UNKNOWN_ERROR;
-                        return FlowState::STOPPING;
-                    }
-                }
-            }
-            setAuthState(nextState);
+        auto data = listener->onGetAuthorizationData(m_service, AUTHORIZATION_DATA_REFRESH_TOKEN_KEY);
+        ThrowIf(data.empty(), "invalidAuthorizationData");
+
+        auto refreshTokenJson = json::parse(data);
+        if (refreshTokenJson.contains(AUTHORIZATION_JSON_DATA_REFRESH_TOKEN_KEY) &&
+            refreshTokenJson[AUTHORIZATION_JSON_DATA_REFRESH_TOKEN_KEY].is_string()) {
+            m_refreshToken = refreshTokenJson[AUTHORIZATION_JSON_DATA_REFRESH_TOKEN_KEY];
+        } else {
+            Throw("invalidRefreshToken");
         }
 
-        m_stateChangeReason = AUTHORIZATION_ERROR_REASON_SUCCESS;
-        return FlowState::STOPPING;
+        {
+            std::lock_guard<std::mutex> refreshLock(m_mutex);
+            m_refreshInProgress = true;
+        }
+        sendFlowRequest(FlowRequest::REFRESH, &CBLAuthorizationProvider::requestRefresh);
+        return Next::suspend();
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return FlowState::STOPPING;
+        return enterFlowState(FlowState::STOPPING);
     }
 }
 
+AsyncFlow::Next CBLAuthorizationProvider::receiveRefreshResponse(const HTTPResponse& response) {
+    auto result = receiveTokenResponse(response, false);
+    m_refreshToken.clear();
+    {
+        // The auth failures reported during the refresh were for the token it replaces
+        std::lock_guard<std::mutex> refreshLock(m_mutex);
+        m_refreshInProgress = false;
+        m_refreshOnNetworkAvailable = (result != AuthObserverInterface::Error::SUCCESS);
+    }
+    std::stringstream refreshTokenResult;
+    refreshTokenResult << result;
+    if (result == AuthObserverInterface::Error::SUCCESS) {
+        emitUniqueCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "handleRefreshingToken", METRIC_REQUESTTOKEN_SUCCESS, 1);
+    } else {
+        emitUniqueCounterMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX,
+            "handleRefreshingToken",
+            {METRIC_REQUESTTOKEN_FAILED, refreshTokenResult.str()});
+    }
+    switch (result) {
+        case AuthObserverInterface::Error::SUCCESS:
+            m_retryCount = 0;
+            setAuthState(AuthObserverInterface::State::REFRESHED);
+            break;
+        case AuthObserverInterface::Error::UNKNOWN_ERROR:
+        case AuthObserverInterface::Error::SERVER_ERROR:
+        case AuthObserverInterface::Error::AUTHORIZATION_FAILED:
+        case AuthObserverInterface::Error::AUTHORIZATION_PENDING:
+        case AuthObserverInterface::Error::SLOW_DOWN:
+            m_timeToRefresh = calculateTimeToRetry(m_retryCount++);
+            break;
+        case AuthObserverInterface::Error::INVALID_CODE_PAIR:
+            clearRefreshToken();
+            return enterFlowState(FlowState::REQUESTING_CODE_PAIR);
+        case AuthObserverInterface::Error::AUTHORIZATION_EXPIRED:
+            clearRefreshToken();
+            if (m_explicitAuthorizationRequest) {
+                // Fall back to requesting code pair state if the application provides an invalid refresh token during
+                // explicit start of CBL authorization.
+                m_explicitAuthorizationRequest = false;  // Not to loop continuously
+                return enterFlowState(FlowState::REQUESTING_CODE_PAIR);
+            } else {
+                setAuthState(AuthObserverInterface::State::UNRECOVERABLE_ERROR);
+                m_stateChangeReason = AUTHORIZATION_ERROR_REASON_AUTHORIZATION_EXPIRED;
+                return enterFlowState(FlowState::STOPPING);
+            }
+        case AuthObserverInterface::Error::INVALID_REQUEST:
+            if (m_refreshWithNewRefreshToken) {
+                setAuthError(AuthObserverInterface::Error::INVALID_CBL_CLIENT_ID);
+            }
+        // Falls through
+        case AuthObserverInterface::Error::UNAUTHORIZED_CLIENT:
+        case AuthObserverInterface::Error::INVALID_VALUE:
+        case AuthObserverInterface::Error::UNSUPPORTED_GRANT_TYPE:
+        case AuthObserverInterface::Error::INTERNAL_ERROR:
+        case AuthObserverInterface::Error::INVALID_CBL_CLIENT_ID: {
+            clearRefreshToken();
+            setAuthState(AuthObserverInterface::State::UNRECOVERABLE_ERROR);
+            m_stateChangeReason = AUTHORIZATION_ERROR_REASON_UNKNOWN_ERROR;
+            return enterFlowState(FlowState::STOPPING);
+        }
+    }
+    return Next::now();
+}
+
 CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleStopping() {
     AACE_DEBUG(LX(TAG));
     if (m_legacyEventNotifier) {
@@ -1001,11 +1317,9 @@ CBLAuthorizationProvider::FlowState CBLAuthorizationProvider::handleStopping() {
     return FlowState::STOPPING;
 }
 
-void CBLAuthorizationProvider::handleRequestingUserProfile() {
+void CBLAuthorizationProvider::handleUserProfileResponse(const HTTPResponse& response) {
     try {
         AACE_DEBUG(LX(TAG));
-
-        auto response = requestUserProfile();
         ThrowIfNot(response.code == HTTPResponseCode::SUCCESS_OK, "Error making request");
 
         std::string name;
@@ -1116,32 +1430,42 @@ alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPResponse CBLAuthorizationPro
 }
 
 AuthObserverInterface::Error CBLAuthorizationProvider::receiveCodePairResponse(const HTTPResponse& response) {
+    CodePair codePair;
+    auto result = parseCodePairResponse(response, &codePair);
+    setAuthError(result);
+
+    if (result != AuthObserverInterface::Error::SUCCESS) {
+        AACE_DEBUG(LX(TAG).d("result", result));
+        return result;
+    }
+    return useCodePair(codePair);
+}
+
+AuthObserverInterface::Error CBLAuthorizationProvider::parseCodePairResponse(
+    const HTTPResponse& response,
+    CodePair* codePair) {
     try {
         AACE_DEBUG(LX(TAG).d("code", response.code).sensitive("body", response.body));
 
         Document document;
         auto result = parseLWAResponse(response, &document);
-        setAuthError(result);
-
         if (result != AuthObserverInterface::Error::SUCCESS) {
-            AACE_DEBUG(LX(TAG).d("result", result));
             return result;
         }
 
         auto it = document.FindMember(JSON_KEY_USER_CODE);
         if (it != document.MemberEnd() && it->value.IsString()) {
-            m_userCode = it->value.GetString();
+            codePair->userCode = it->value.GetString();
         }
 
         it = document.FindMember(JSON_KEY_DEVICE_CODE);
         if (it != document.MemberEnd() && it->value.IsString()) {
-            m_deviceCode = it->value.GetString();
+            codePair->deviceCode = it->value.GetString();
         }
 
-        std::string verificationUri;
         it = document.FindMember(JSON_KEY_VERIFICATION_URI);
         if (it != document.MemberEnd() && it->value.IsString()) {
-            verificationUri = it->value.GetString();
+            codePair->verificationUri = it->value.GetString();
         }
 
         int64_t expiresInSeconds = 0;
@@ -1156,24 +1480,38 @@ AuthObserverInterface::Error CBLAuthorizationProvider::receiveCodePairResponse(c
             intervalSeconds = it->value.GetUint64();
         }
 
-        if (m_userCode.empty() || m_deviceCode.empty() || verificationUri.empty() || 0 == expiresInSeconds) {
+        if (codePair->userCode.empty() || codePair->deviceCode.empty() || codePair->verificationUri.empty() ||
+            0 == expiresInSeconds) {
             AACE_ERROR(LX(TAG)
                            .d("reason", "missing or InvalidResponseProperty")
-                           .d("user_code", m_userCode)
-                           .sensitive("device_code", m_deviceCode)
-                           .d("verification_uri", verificationUri)
+                           .d("user_code", codePair->userCode)
+                           .sensitive("device_code", codePair->deviceCode)
+                           .d("verification_uri", codePair->verificationUri)
                            .d("expiresIn", expiresInSeconds)
                            .d("interval", intervalSeconds));
             return AuthObserverInterface::Error::UNKNOWN_ERROR;
         }
 
-        m_codePairExpirationTime = std::chrono::steady_clock::now() + std::chrono::seconds(expiresInSeconds);
+        codePair->expirationTime = std::chrono::steady_clock::now() + std::chrono::seconds(expiresInSeconds);
+
+        return result;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return AuthObserverInterface::Error::UNKNOWN_ERROR;
+    }
+}
+
+AuthObserverInterface::Error CBLAuthorizationProvider::useCodePair(const CodePair& codePair) {
+    try {
+        m_userCode = codePair.userCode;
+        m_deviceCode = codePair.deviceCode;
+        m_codePairExpirationTime = codePair.expirationTime;
 
         if (m_legacyEventNotifier) {
             m_legacyEventNotifier->cblStateChanged(
                 CBLLegacyEventNotificationInterface::CBLState::CODE_PAIR_RECEIVED,
                 CBLLegacyEventNotificationInterface::CBLStateChangedReason::SUCCESS,
-                verificationUri,
+                codePair.verificationUri,
                 m_userCode);
         }
 
@@ -1182,7 +1520,7 @@ AuthObserverInterface::Error CBLAuthorizationProvider::receiveCodePairResponse(c
             {"type", AUTHORIZATION_REQUEST_TYPE_CBL_CODE},
             {"payload", {
                 {"code", m_userCode},
-                {"url", verificationUri}
+                {"url", codePair.verificationUri}
             }}
         };
         // clang-format on
@@ -1191,7 +1529,7 @@ AuthObserverInterface::Error CBLAuthorizationProvider::receiveCodePairResponse(c
         ThrowIfNull(listener, "invalidListenerReference");
         listener->onEventReceived(m_service, requestJson.dump());
 
-        return result;
+        return AuthObserverInterface::Error::SUCCESS;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return AuthObserverInterface::Error::UNKNOWN_ERROR;
@@ -1252,8 +1590,17 @@ AuthObserverInterface::Error CBLAuthorizationProvider::receiveTokenResponse(
         }
 
         setRefreshToken(refreshToken);
+        if (m_enablePersistentAccessToken && !expiresImmediately) {
+            persistAccessToken(
+                accessToken,
+                std::chrono::duration_cast<std::chrono::seconds>(
+                    m_requestTime + std::chrono::seconds(expiresInSeconds) - std::chrono::steady_clock::now()));
+        }
         m_tokenExpirationTime = m_requestTime + std::chrono::seconds(expiresInSeconds);
-        m_timeToRefresh = m_tokenExpirationTime - m_configuration->getAccessTokenRefreshHeadStart();
+        m_timeToRefresh = calculateTimeToRefresh(
+            m_tokenExpirationTime,
+            std::chrono::seconds(expiresInSeconds),
+            m_configuration->getAccessTokenRefreshHeadStart());
         {
             std::lock_guard<std::mutex> lock(m_mutex);
             m_accessToken = accessToken;
@@ -1266,18 +1613,23 @@ AuthObserverInterface::Error CBLAuthorizationProvider::receiveTokenResponse(
     }
 }
 
-void CBLAuthorizationProvider::stopAuthFlowThread(bool resetData, bool notifyAuthStateChange) {
+void CBLAuthorizationProvider::stopAuthorizationFlow(bool resetData, bool notifyAuthStateChange) {
     try {
         AACE_DEBUG(LX(TAG).d("resetData", resetData).d("notifyAuthStateChange", notifyAuthStateChange));
 
         handleStopping();
 
-        m_wake.notify_one();
-        if (m_authorizationFlowThread.joinable()) {
-            m_authorizationFlowThread.join();
+        // No step runs after the cancel, which waits for the running step to return
+        std::shared_ptr<AsyncFlow> authorizationFlow;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            authorizationFlow = m_authorizationFlow;
+        }
+        if (authorizationFlow != nullptr) {
+            authorizationFlow->cancel();
         }
 
-        m_threadActive = false;
+        m_flowActive = false;
         if (resetData) {
             m_accessToken.clear();
             clearRefreshToken();
@@ -1346,6 +1698,71 @@ void CBLAuthorizationProvider::clearRefreshToken() {
     auto listener = getAuthorizationProviderListener();
     ThrowIfNull(listener, "invalidListenerReference");
     listener->onSetAuthorizationData(m_service, AUTHORIZATION_DATA_REFRESH_TOKEN_KEY, "");
+    if (m_enablePersistentAccessToken) {
+        clearPersistedAccessToken();
+    }
+}
+
+bool CBLAuthorizationProvider::restoreAccessToken() {
+    try {
+        auto listener = getAuthorizationProviderListener();
+        ThrowIfNull(listener, "invalidListenerReference");
+        auto data = listener->onGetAuthorizationData(m_service, AUTHORIZATION_DATA_ACCESS_TOKEN_KEY);
+        if (data.empty()) {
+            return false;
+        }
+
+        auto accessTokenJson = json::parse(data);
+        ThrowIfNot(
+            accessTokenJson.contains(AUTHORIZATION_JSON_DATA_ACCESS_TOKEN_KEY) &&
+                accessTokenJson[AUTHORIZATION_JSON_DATA_ACCESS_TOKEN_KEY].is_string() &&
+                accessTokenJson.contains(AUTHORIZATION_JSON_DATA_EXPIRES_AT_KEY) &&
+                accessTokenJson[AUTHORIZATION_JSON_DATA_EXPIRES_AT_KEY].is_number_integer(),
+            "invalidAccessTokenData");
+        std::string accessToken = accessTokenJson[AUTHORIZATION_JSON_DATA_ACCESS_TOKEN_KEY];
+        ThrowIf(accessToken.empty(), "emptyAccessToken");
+
+        // The steady clock restarts with the device, so the expiration time is persisted with the system clock
+        auto expiresAt = std::chrono::system_clock::time_point(
+            std::chrono::seconds(accessTokenJson[AUTHORIZATION_JSON_DATA_EXPIRES_AT_KEY].get<int64_t>()));
+        auto expiresIn = std::chrono::duration_cast<std::chrono::seconds>(expiresAt - std::chrono::system_clock::now());
+        if (expiresIn < MIN_PERSISTED_ACCESS_TOKEN_LIFETIME) {
+            AACE_DEBUG(LX(TAG).m("persistedAccessTokenExpired").d("expiresIn", expiresIn.count()));
+            return false;
+        }
+
+        // The restored token is refreshed now, in case it was revoked or the system clock is wrong. The requests use
+        // it in the meantime, and report an auth failure if it is rejected.
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_accessToken = accessToken;
+        m_tokenExpirationTime = now + expiresIn;
+        m_timeToRefresh = now;
+        AACE_DEBUG(LX(TAG).m("accessTokenRestored").d("expiresIn", expiresIn.count()));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+void CBLAuthorizationProvider::persistAccessToken(const std::string& accessToken, std::chrono::seconds expiresIn) {
+    AACE_DEBUG(LX(TAG));
+    auto listener = getAuthorizationProviderListener();
+    ThrowIfNull(listener, "invalidListenerReference");
+    auto expiresAt = std::chrono::system_clock::now() + expiresIn;
+    json accessTokenJson;
+    accessTokenJson[AUTHORIZATION_JSON_DATA_ACCESS_TOKEN_KEY] = accessToken;
+    accessTokenJson[AUTHORIZATION_JSON_DATA_EXPIRES_AT_KEY] =
+        std::chrono::duration_cast<std::chrono::seconds>(expiresAt.time_since_epoch()).count();
+    listener->onSetAuthorizationData(m_service, AUTHORIZATION_DATA_ACCESS_TOKEN_KEY, accessTokenJson.dump());
+}
+
+void CBLAuthorizationProvider::clearPersistedAccessToken() {
+    AACE_DEBUG(LX(TAG));
+    auto listener = getAuthorizationProviderListener();
+    ThrowIfNull(listener, "invalidListenerReference");
+    listener->onSetAuthorizationData(m_service, AUTHORIZATION_DATA_ACCESS_TOKEN_KEY, "");
 }
 
 bool CBLAuthorizationProvider::isStopping() {
@@ -1353,6 +1770,14 @@ bool CBLAuthorizationProvider::isStopping() {
     return m_isStopping;
 }
 
+bool CBLAuthorizationProvider::isNetworkAvailable() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_networkAvailable) {
+        AACE_DEBUG(LX(TAG).m("waitingForNetwork"));
+    }
+    return m_networkAvailable;
+}
+
 bool CBLAuthorizationProvider::sendEvent(const std::string& payload) {
     AACE_DEBUG(LX(TAG));
     // no-op
@@ -1364,7 +1789,7 @@ void CBLAuthorizationProvider::deregister() {
 
     // notifyAuthStateChange = false because we don't need to notify auth state
     // change back to AuthorizationManager.
-    stopAuthFlowThread(true, false);
+    stopAuthorizationFlow(true, false);
 
     auto listener = getAuthorizationProviderListener();
     ThrowIfNull(listener, "invalidListenerReference");
@@ -1392,9 +1817,14 @@ void CBLAuthorizationProvider::onAuthFailure(const std::string& token) {
     AACE_DEBUG(LX(TAG));
     try {
         std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_refreshInProgress) {
+            // The refresh in progress replaces the token, so the listeners reporting it don't need another one
+            AACE_DEBUG(LX(TAG).m("refreshInProgress"));
+            return;
+        }
         if (token.empty() || token == m_accessToken) {
             m_authFailureReported = true;
-            m_wake.notify_one();
+            wakeAuthorizationFlowLocked();
         }
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -1404,17 +1834,23 @@ void CBLAuthorizationProvider::onAuthFailure(const std::string& token) {
 
 void CBLAuthorizationProvider::onNetworkInfoChanged(NetworkInfoObserver::NetworkStatus status, int wifiSignalStrength) {
     AACE_DEBUG(LX(TAG, "onNetworkInfoChanged").d("m_networkStatus", status));
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (status == NetworkInfoObserver::NetworkStatus::CONNECTED) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_networkWakeup = true;
-        m_wake.notify_all();
+        m_networkAvailable = true;
+        // A token refreshed on schedule is still valid, so only a failed or deferred refresh is retried now
+        if (m_refreshOnNetworkAvailable) {
+            m_networkWakeup = true;
+        }
+        wakeAuthorizationFlowLocked();
+    } else if (status == NetworkInfoObserver::NetworkStatus::DISCONNECTED) {
+        m_networkAvailable = false;
     }
 }
 
 void CBLAuthorizationProvider::onNetworkInterfaceChangeStatusChanged(
     const std::string& networkInterface,
     NetworkInterfaceChangeStatus status) {
-    // No action required as we don't create and persist network connection using AVS LibCurlUtils.
+    // No action required, the alexa service closes the pooled connections of the previous network interface.
 }
 
 void CBLAuthorizationProvider::propertyChanged(const std::string& name, const std::string& newValue) {
@@ -49,7 +49,9 @@ REGISTER_SERVICE(CBLEngineService);
 CBLEngineService::CBLEngineService(const aace::engine::core::ServiceDescription& description) :
         aace::engine::core::EngineService(description),
         m_codePairRequestTimeout(DEFAULT_REQUEST_TIMEOUT),
-        m_enableUserProfile(false) {
+        m_enableUserProfile(false),
+        m_enableCodePairPrefetch(false),
+        m_enablePersistentAccessToken(false) {
 }
 
 bool CBLEngineService::configure(std::shared_ptr<std::istream> configuration) {
@@ -67,6 +69,15 @@ bool CBLEngineService::configure(std::shared_ptr<std::istream> configuration) {
             m_enableUserProfile = cblConfigRoot["enableUserProfile"].GetBool();
         }
 
+        if (cblConfigRoot.HasMember("enableCodePairPrefetch") && cblConfigRoot["enableCodePairPrefetch"].IsBool()) {
+            m_enableCodePairPrefetch = cblConfigRoot["enableCodePairPrefetch"].GetBool();
+        }
+
+        if (cblConfigRoot.HasMember("enablePersistentAccessToken") &&
+            cblConfigRoot["enablePersistentAccessToken"].IsBool()) {
+            m_enablePersistentAccessToken = cblConfigRoot["enablePersistentAccessToken"].GetBool();
+        }
+
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "configure").d("reason", ex.what()));
@@ -112,7 +123,10 @@ bool CBLEngineService::setup() {
                 configuration,
                 networkObserver,
                 propertyManager,
-                m_enableUserProfile);
+                m_enableUserProfile,
+                nullptr,
+                m_enableCodePairPrefetch,
+                m_enablePersistentAccessToken);
             authorizationService->registerProvider(m_cblAuthorizationProvider, SERVICE_NAME);
         }
 
@@ -127,6 +141,9 @@ bool CBLEngineService::engineStarted() {
     if (m_cblEngineImpl != nullptr) {
         m_cblEngineImpl->enable();
     }
+    if (m_cblAuthorizationProvider != nullptr) {
+        m_cblAuthorizationProvider->prefetchCodePair();
+    }
     return true;
 }
 
@@ -78,7 +78,10 @@ public:
         removeListener,
         void(const std::string& name, std::shared_ptr<engine::propertyManager::PropertyListenerInterface> listener));
     MOCK_METHOD3(setProperty, bool(const std::string&, const std::string&, const bool&));
+    MOCK_METHOD2(setProperties, bool(const std::unordered_map<std::string, std::string>&, const bool&));
     MOCK_METHOD1(getProperty, std::string(const std::string& name));
+    MOCK_METHOD1(getPropertyHandle, PropertyHandle(const std::string& name));
+    MOCK_METHOD1(getPropertyValue, std::string(PropertyHandle handle));
 };
 
 /**
@@ -477,6 +480,89 @@ TEST_F(CBLAuthorizationProviderTest, testLogoutWhileNotAuthorized) {
     cblAuthorizationProvider->shutdown();
 }
 
+TEST_F(CBLAuthorizationProviderTest, restoresPersistedAccessToken) {
+    alexaClientSDK::avsCommon::utils::WaitEvent waitEvent;
+    EXPECT_CALL(*m_mockAuthorizationManager, registerAuthorizationAdapter("TEST_ME", ::testing::_)).Times(1);
+    EXPECT_CALL(*m_mockPropertyManagerServiceInterface, getProperty("aace.alexa.setting.locale"))
+        .WillOnce(::testing::Return("en-US"));
+    EXPECT_CALL(*m_mockPropertyManagerServiceInterface, addListener(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(true));
+    auto cblAuthorizationProvider = aace::engine::cbl::CBLAuthorizationProvider::create(
+        "TEST_ME",
+        m_mockAuthorizationManager,
+        m_configuration,
+        m_mockNetworkObservableInterface,
+        m_mockPropertyManagerServiceInterface,
+        false,
+        nullptr,
+        false,
+        true);
+    ASSERT_NE(cblAuthorizationProvider, nullptr) << "CBLAuthorizationProvider pointer expected to be not null!";
+    cblAuthorizationProvider->setListener(m_mockAuthorizationProviderListener);
+
+    auto expiresAt = std::chrono::duration_cast<std::chrono::seconds>(
+        (std::chrono::system_clock::now() + std::chrono::hours(1)).time_since_epoch());
+    std::string accessTokenData =
+        "{\"accessToken\":\"ACCESS_TOKEN\",\"expiresAt\":" + std::to_string(expiresAt.count()) + "}";
+
+    // The persisted access token authorizes before the refresh, which fails without a token endpoint
+    EXPECT_CALL(*m_mockAuthorizationManager, startAuthorization("TEST_ME")).Times(1);
+    EXPECT_CALL(
+        *m_mockAuthorizationProviderListener,
+        onAuthorizationStateChanged("TEST_ME", AuthorizationProviderListenerInterface::AuthorizationState::AUTHORIZING))
+        .Times(1);
+    EXPECT_CALL(*m_mockAuthorizationProviderListener, onGetAuthorizationData("TEST_ME", "accessToken"))
+        .WillOnce(Return(accessTokenData));
+    EXPECT_CALL(*m_mockAuthorizationProviderListener, onGetAuthorizationData("TEST_ME", "refreshToken"))
+        .WillRepeatedly(Return("{\"refreshToken\":\"REFRESH_TOKEN\"}"));
+    EXPECT_CALL(
+        *m_mockAuthorizationManager,
+        authStateChanged("TEST_ME", AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::SUCCESS))
+        .Times(1);
+    EXPECT_CALL(
+        *m_mockAuthorizationProviderListener,
+        onAuthorizationStateChanged("TEST_ME", AuthorizationProviderListenerInterface::AuthorizationState::AUTHORIZED))
+        .WillOnce(testing::InvokeWithoutArgs([&waitEvent]() -> void { waitEvent.wakeUp(); }));
+
+    EXPECT_TRUE(cblAuthorizationProvider->startAuthorization("{\"refreshToken\":\"REFRESH_TOKEN\"}"));
+    EXPECT_TRUE(waitEvent.wait(TIMEOUT));
+    EXPECT_EQ(cblAuthorizationProvider->getAuthToken(), "ACCESS_TOKEN");
+
+    cblAuthorizationProvider->shutdown();
+}
+
+TEST_F(CBLAuthorizationProviderTest, skipsCodePairPrefetchWithRefreshToken) {
+    alexaClientSDK::avsCommon::utils::WaitEvent waitEvent;
+    EXPECT_CALL(*m_mockAuthorizationManager, registerAuthorizationAdapter("TEST_ME", ::testing::_)).Times(1);
+    EXPECT_CALL(*m_mockPropertyManagerServiceInterface, getProperty("aace.alexa.setting.locale"))
+        .WillOnce(::testing::Return("en-US"));
+    EXPECT_CALL(*m_mockPropertyManagerServiceInterface, addListener(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(true));
+    auto cblAuthorizationProvider = aace::engine::cbl::CBLAuthorizationProvider::create(
+        "TEST_ME",
+        m_mockAuthorizationManager,
+        m_configuration,
+        m_mockNetworkObservableInterface,
+        m_mockPropertyManagerServiceInterface,
+        false,
+        nullptr,
+        true,
+        false);
+    ASSERT_NE(cblAuthorizationProvider, nullptr) << "CBLAuthorizationProvider pointer expected to be not null!";
+    cblAuthorizationProvider->setListener(m_mockAuthorizationProviderListener);
+
+    // The strict listener fails the test if a code pair is received
+    EXPECT_CALL(*m_mockAuthorizationProviderListener, onGetAuthorizationData("TEST_ME", "refreshToken"))
+        .WillOnce(testing::InvokeWithoutArgs([&waitEvent]() -> std::string {
+            waitEvent.wakeUp();
+            return "{\"refreshToken\":\"REFRESH_TOKEN\"}";
+        }));
+    cblAuthorizationProvider->prefetchCodePair();
+    EXPECT_TRUE(waitEvent.wait(TIMEOUT));
+
+    cblAuthorizationProvider->shutdown();
+}
+
 }  // namespace unit
 }  // namespace test
 }  // namespace aace
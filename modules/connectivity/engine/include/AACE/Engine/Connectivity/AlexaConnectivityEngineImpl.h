@@ -16,9 +16,11 @@
 #ifndef AACE_ENGINE_CONNECTIVITY_CONNECTIVITY_ENGINE_IMPL_H
 #define AACE_ENGINE_CONNECTIVITY_CONNECTIVITY_ENGINE_IMPL_H
 
+#include <chrono>
 #include <mutex>
 #include <utility>
 
+#include <AVSCommon/SDKInterfaces/AVSConnectionManagerInterface.h>
 #include <AVSCommon/SDKInterfaces/ContextManagerInterface.h>
 #include <AVSCommon/SDKInterfaces/Endpoints/EndpointCapabilitiesRegistrarInterface.h>
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
@@ -26,11 +28,15 @@
 #include <AVSCommon/Utils/Threading/Executor.h>
 #include <nlohmann/json.hpp>
 
+#include <AACE/Engine/Network/BackgroundTransferScheduler.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+
 #include "AACE/Connectivity/AlexaConnectivity.h"
 #include "AACE/Connectivity/AlexaConnectivityEngineInterface.h"
 #include "AACE/Engine/Connectivity/AlexaConnectivityInterface.h"
 #include "AACE/Engine/Connectivity/AlexaConnectivityListenerInterface.h"
 #include "AACE/Engine/Connectivity/ConnectivityCapabilityAgent.h"
+#include "AACE/Engine/Connectivity/ConnectivityEventQueue.h"
 
 namespace aace {
 namespace engine {
@@ -50,7 +56,9 @@ private:
      * Constructor.
      */
     AlexaConnectivityEngineImpl(
-        std::shared_ptr<aace::connectivity::AlexaConnectivity> alexaConnectivityPlatformInterface);
+        std::shared_ptr<aace::connectivity::AlexaConnectivity> alexaConnectivityPlatformInterface,
+        std::chrono::milliseconds stateChangeInterval,
+        std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler);
 
     /**
      * Initialize the @c AlexaConnectivityEngineImpl and @c ConnectivityCapabilityAgent.
@@ -60,12 +68,27 @@ private:
             capabilitiesRegistrar,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-        const std::string& vehicleIdentifier);
+        const std::string& vehicleIdentifier,
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::AVSConnectionManagerInterface> connectionManager);
 
 public:
+    /// The default shortest time between two connectivity state changes processed by the Engine.
+    static const std::chrono::milliseconds DEFAULT_STATE_CHANGE_INTERVAL;
+
     /**
      * Factory method for creating instance of @c AlexaConnectivityEngineImpl
      * which handles instantiation of @c ConnectivityCapabilityAgent.
+     *
+     * A connectivity state change notified within @c stateChangeInterval of the previous one processed is deferred
+     * until the interval has elapsed, and the changes of a burst, such as a cellular handover, are processed once.
+     * Zero processes each change when it is notified.
+     *
+     * The @c backgroundTransferScheduler, if provided, is told the link is metered while the data plan is paid or
+     * a trial, so the background transfers of the Engine are deferred.
+     *
+     * The connectivity events are sent by a @c ConnectivityEventQueue, which coalesces the pending events of each
+     * type and retries them. The @c connectionManager, if provided, tells the queue when AVS is connected, so the
+     * events are held while it is disconnected and flushed together when it reconnects.
      */
     static std::shared_ptr<AlexaConnectivityEngineImpl> create(
         std::shared_ptr<aace::connectivity::AlexaConnectivity> alexaConnectivityPlatformInterface,
@@ -73,7 +96,11 @@ public:
             capabilitiesRegistrar,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-        const std::string& vehicleIdentifier);
+        const std::string& vehicleIdentifier,
+        std::chrono::milliseconds stateChangeInterval = DEFAULT_STATE_CHANGE_INTERVAL,
+        std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler = nullptr,
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::AVSConnectionManagerInterface> connectionManager =
+            nullptr);
 
     /// @name AlexaConnectivityEngineInterface Function
     /// @{
@@ -128,11 +155,37 @@ private:
     /**
      * Get the connectivity state JSON payload from the platform implementation on initialization
      * or after a call to @c connectivityStateChange. If the payload is empty, the current state is retained.
+     * Only the elements that differ from the previous payload are parsed.
      *
      * Note: This method is called by @c initialize and @c onConnectivityStateChange.
      */
     bool updateConnectivityState();
 
+    /**
+     * Update the connectivity state and report the properties that changed.
+     */
+    bool processConnectivityStateChange();
+
+    /**
+     * Process the connectivity state change deferred by @c onConnectivityStateChange. Runs on the executor.
+     */
+    void executeDeferredStateChange();
+
+    /**
+     * Send the connectivity event of a type, and wait for the result. Runs on the thread of the event queue.
+     */
+    bool sendConnectivityEvent(const std::string& type);
+
+    /**
+     * Notify the platform implementation of the result of a connectivity event.
+     */
+    void onConnectivityEventResult(const std::string& token, bool success);
+
+    /**
+     * Tell the background transfer scheduler whether the link is metered by the current data plan.
+     */
+    void updateMeteredLink();
+
     /// Auto SDK Alexa Connectivity platform interface handler instance.
     std::shared_ptr<aace::connectivity::AlexaConnectivity> m_alexaConnectivityPlatformInterface;
 
@@ -151,6 +204,29 @@ private:
     AlexaConnectivityInterface::ManagedProvider m_managedProvider;
     AlexaConnectivityInterface::Terms m_terms;
 
+    /// The last connectivity state payload parsed successfully, and its document.
+    std::string m_connectivityStatePayload;
+    nlohmann::json m_connectivityStateDocument;
+
+    /// Serializes the processing of the connectivity state changes.
+    std::mutex m_stateChangeMutex;
+
+    /// The shortest time between two connectivity state changes processed.
+    const std::chrono::milliseconds m_stateChangeInterval;
+
+    /// The throttling of the connectivity state changes, protected by @c m_throttleMutex.
+    std::mutex m_throttleMutex;
+    std::chrono::steady_clock::time_point m_lastStateChange;
+    bool m_stateChangeProcessed;
+    aace::engine::utils::threading::TimerWheel::TimerId m_stateChangeTimer;
+
+    /// Told whether the link is metered by the data plan, null if not available.
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> m_backgroundTransferScheduler;
+
+    /// The queue of the connectivity events, and the connection manager notifying it.
+    std::shared_ptr<ConnectivityEventQueue> m_eventQueue;
+    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::AVSConnectionManagerInterface> m_connectionManager;
+
     /// This is the worker thread for the @c AlexaConnectivityEngineImpl.
     alexaClientSDK::avsCommon::utils::threading::Executor m_executor;
 };
@@ -35,6 +35,7 @@ public:
     virtual ~ConnectivityEngineService() = default;
 
 protected:
+    bool configureFromJson(const aace::engine::utils::json::Value& configuration) override;
     bool shutdown() override;
     bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) override;
 
@@ -50,6 +51,9 @@ private:
 
     /// Engine implementation object references.
     std::shared_ptr<aace::engine::connectivity::AlexaConnectivityEngineImpl> m_alexaConnectivityEngineImpl;
+
+    /// The shortest time between two connectivity state changes processed.
+    std::chrono::milliseconds m_stateChangeInterval = AlexaConnectivityEngineImpl::DEFAULT_STATE_CHANGE_INTERVAL;
 };
 
 }  // namespace connectivity
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_CONNECTIVITY_CONNECTIVITY_EVENT_QUEUE_H
+#define AACE_ENGINE_CONNECTIVITY_CONNECTIVITY_EVENT_QUEUE_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <AVSCommon/SDKInterfaces/ConnectionStatusObserverInterface.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+
+namespace aace {
+namespace engine {
+namespace connectivity {
+
+/**
+ * The queue of the connectivity events sent on behalf of the platform, which coalesces the events and their retries
+ * while the connection is flapping.
+ *
+ * Only the latest pending event of each type is kept: an event queued while an event of the same type is pending
+ * replaces it, and the result of the event sent is notified for the tokens of both. The events that fail are retried
+ * together after a single backoff shared by the queue, which doubles after each failed attempt. While AVS is not
+ * connected, the events are held, and they are all sent as soon as the connection comes back.
+ */
+class ConnectivityEventQueue
+        : public alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface
+        , public std::enable_shared_from_this<ConnectivityEventQueue> {
+public:
+    /// Sends the event of a type, and returns whether it was sent successfully. Called on the thread of the queue.
+    using EventSender = std::function<bool(const std::string& type)>;
+
+    /// Notified of the result of an event, for each non-empty token it was queued with.
+    using ResultCallback = std::function<void(const std::string& token, bool success)>;
+
+    /// The default time before the first retry.
+    static const std::chrono::milliseconds DEFAULT_INITIAL_BACKOFF;
+
+    /// The default longest time between two retries.
+    static const std::chrono::milliseconds DEFAULT_MAX_BACKOFF;
+
+    /// The default number of times an event is sent while connected before it fails.
+    static const unsigned int DEFAULT_MAX_ATTEMPTS;
+
+    /**
+     * Creates a queue. The queue assumes AVS is connected until it is notified otherwise.
+     *
+     * @param sender The function sending the events.
+     * @param resultCallback The function notified of the results.
+     * @param initialBackoff The time before the first retry.
+     * @param maxBackoff The longest time between two retries.
+     * @param maxAttempts The number of times an event is sent while connected before it fails.
+     * @returns The queue, or @c nullptr if an argument is invalid.
+     */
+    static std::shared_ptr<ConnectivityEventQueue> create(
+        EventSender sender,
+        ResultCallback resultCallback,
+        std::chrono::milliseconds initialBackoff = DEFAULT_INITIAL_BACKOFF,
+        std::chrono::milliseconds maxBackoff = DEFAULT_MAX_BACKOFF,
+        unsigned int maxAttempts = DEFAULT_MAX_ATTEMPTS);
+
+    /**
+     * Queues an event, replacing the pending event of the same type.
+     *
+     * @param type The type of the event.
+     * @param token The token notified with the result, or empty if none.
+     */
+    void enqueue(const std::string& type, const std::string& token);
+
+    /// Returns the number of events pending.
+    size_t getPendingCount();
+
+    /// Stops sending the events. The pending events are dropped without a result.
+    void shutdown();
+
+    /// @name ConnectionStatusObserverInterface Functions
+    /// @{
+    void onConnectionStatusChanged(
+        const alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status status,
+        const alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::ChangedReason reason)
+        override;
+    void onConnectionStatusChanged(
+        const alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status status,
+        const std::vector<
+            alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::EngineConnectionStatus>&
+            engineStatuses) override;
+    /// @}
+
+private:
+    /// A pending event.
+    struct PendingEvent {
+        /// The tokens of the events coalesced into this one.
+        std::vector<std::string> tokens;
+        /// The number of times the event was sent.
+        unsigned int attempts = 0;
+    };
+
+    ConnectivityEventQueue(
+        EventSender sender,
+        ResultCallback resultCallback,
+        std::chrono::milliseconds initialBackoff,
+        std::chrono::milliseconds maxBackoff,
+        unsigned int maxAttempts);
+
+    /// Updates the connection state, and flushes the events when AVS is connected again.
+    void setConnected(bool connected);
+
+    /// Submits a flush to the executor, unless a flush or retry is already scheduled.
+    void scheduleFlushLocked();
+
+    /// Sends all the pending events. Runs on the executor.
+    void executeFlush();
+
+    EventSender m_sender;
+    ResultCallback m_resultCallback;
+    const std::chrono::milliseconds m_initialBackoff;
+    const std::chrono::milliseconds m_maxBackoff;
+    const unsigned int m_maxAttempts;
+
+    /// The state of the queue, protected by @c m_mutex.
+    std::mutex m_mutex;
+    std::map<std::string, PendingEvent> m_pendingEvents;
+    bool m_connected = true;
+    bool m_flushScheduled = false;
+    bool m_shutdown = false;
+    std::chrono::milliseconds m_backoff;
+    aace::engine::utils::threading::TimerWheel::TimerId m_retryTimer;
+
+    /// The thread sending the events.
+    alexaClientSDK::avsCommon::utils::threading::Executor m_executor;
+};
+
+}  // namespace connectivity
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_CONNECTIVITY_CONNECTIVITY_EVENT_QUEUE_H
@@ -41,11 +41,22 @@ static const std::string METRIC_CONNECTIVITY_GET_IDENTIFIER = "GetIdentifier";
 static const std::string METRIC_CONNECTIVITY_CONNECTIVITY_STATE_CHANGE = "ConnectivityStateChange";
 static const std::string METRIC_CONNECTIVITY_SEND_CONNECTIVITY_EVENT = "SendConnectivityEvent";
 static const std::string METRIC_CONNECTIVITY_SEND_CONNECTIVITY_EVENT_FAILED = "SendConnectivityEventFailed";
+static const std::string METRIC_CONNECTIVITY_CONNECTIVITY_STATE_CHANGE_DEFERRED = "ConnectivityStateChangeDeferred";
+
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+const std::chrono::milliseconds AlexaConnectivityEngineImpl::DEFAULT_STATE_CHANGE_INTERVAL = std::chrono::seconds(1);
 
 AlexaConnectivityEngineImpl::AlexaConnectivityEngineImpl(
-    std::shared_ptr<aace::connectivity::AlexaConnectivity> alexaConnectivityPlatformInterface) :
+    std::shared_ptr<aace::connectivity::AlexaConnectivity> alexaConnectivityPlatformInterface,
+    std::chrono::milliseconds stateChangeInterval,
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler) :
         alexaClientSDK::avsCommon::utils::RequiresShutdown{TAG},
-        m_alexaConnectivityPlatformInterface{alexaConnectivityPlatformInterface} {
+        m_alexaConnectivityPlatformInterface{alexaConnectivityPlatformInterface},
+        m_stateChangeInterval{stateChangeInterval},
+        m_stateChangeProcessed{false},
+        m_stateChangeTimer{TimerWheel::INVALID_TIMER},
+        m_backgroundTransferScheduler{backgroundTransferScheduler} {
 }
 
 bool AlexaConnectivityEngineImpl::initialize(
@@ -53,11 +64,13 @@ bool AlexaConnectivityEngineImpl::initialize(
         capabilitiesRegistrar,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-    const std::string& vehicleIdentifier) {
+    const std::string& vehicleIdentifier,
+    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::AVSConnectionManagerInterface> connectionManager) {
     AACE_INFO(LX(TAG));
     try {
         // Initialize the connectivity state.
         ThrowIfNot(updateConnectivityState(), "updateConnectivityStateFailed");
+        updateMeteredLink();
 
         // Save the vehicle identifier before creating instance of capability agent.
         // Note: vehicle identifier is NOT the vehicle identification number (VIN).
@@ -69,6 +82,24 @@ bool AlexaConnectivityEngineImpl::initialize(
         ThrowIfNull(m_connectivityCapabilityAgent, "createConnectivityCapabilityAgentFailed");
         capabilitiesRegistrar->withCapabilityConfiguration(m_connectivityCapabilityAgent);
 
+        // the results of the events are notified on the thread of the queue
+        std::weak_ptr<AlexaConnectivityEngineImpl> wp = shared_from_this();
+        m_eventQueue = ConnectivityEventQueue::create(
+            [wp](const std::string& type) {
+                auto sp = wp.lock();
+                return sp != nullptr && sp->sendConnectivityEvent(type);
+            },
+            [wp](const std::string& token, bool success) {
+                if (auto sp = wp.lock()) {
+                    sp->onConnectivityEventResult(token, success);
+                }
+            });
+        ThrowIfNull(m_eventQueue, "createConnectivityEventQueueFailed");
+        if (connectionManager != nullptr) {
+            m_connectionManager = connectionManager;
+            m_connectionManager->addConnectionStatusObserver(m_eventQueue);
+        }
+
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -82,19 +113,24 @@ std::shared_ptr<AlexaConnectivityEngineImpl> AlexaConnectivityEngineImpl::create
         capabilitiesRegistrar,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-    const std::string& vehicleIdentifier) {
+    const std::string& vehicleIdentifier,
+    std::chrono::milliseconds stateChangeInterval,
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler,
+    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::AVSConnectionManagerInterface> connectionManager) {
     AACE_INFO(LX(TAG));
     try {
         ThrowIfNull(alexaConnectivityPlatformInterface, "invalidPlatformInterface");
         ThrowIfNull(capabilitiesRegistrar, "invalidCapabilitiesRegistrar");
         ThrowIfNull(contextManager, "invalidContextManager");
+        ThrowIf(stateChangeInterval.count() < 0, "invalidStateChangeInterval");
 
         auto alexaConnectivityEngineImpl = std::shared_ptr<AlexaConnectivityEngineImpl>(
-            new AlexaConnectivityEngineImpl(alexaConnectivityPlatformInterface));
+            new AlexaConnectivityEngineImpl(
+                alexaConnectivityPlatformInterface, stateChangeInterval, backgroundTransferScheduler));
 
         ThrowIfNot(
             alexaConnectivityEngineImpl->initialize(
-                capabilitiesRegistrar, messageSender, contextManager, vehicleIdentifier),
+                capabilitiesRegistrar, messageSender, contextManager, vehicleIdentifier, connectionManager),
             "initializeAlexaConnectivityEngineImplFailed");
 
         // Set the platform engine interface reference.
@@ -109,9 +145,55 @@ std::shared_ptr<AlexaConnectivityEngineImpl> AlexaConnectivityEngineImpl::create
 
 bool AlexaConnectivityEngineImpl::onConnectivityStateChange() {
     AACE_INFO(LX(TAG));
+    emitCounterMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX, "onConnectivityStateChange", METRIC_CONNECTIVITY_CONNECTIVITY_STATE_CHANGE, 1);
+    {
+        std::lock_guard<std::mutex> guard{m_throttleMutex};
+        auto now = std::chrono::steady_clock::now();
+        if (m_stateChangeInterval.count() > 0 && m_stateChangeProcessed &&
+            now - m_lastStateChange < m_stateChangeInterval) {
+            // Defer the change within a burst, a single deferred change gets the latest state
+            if (m_stateChangeTimer == TimerWheel::INVALID_TIMER) {
+                emitCounterMetrics(
+                    METRIC_PROGRAM_NAME_SUFFIX,
+                    "onConnectivityStateChange",
+                    METRIC_CONNECTIVITY_CONNECTIVITY_STATE_CHANGE_DEFERRED,
+                    1);
+                std::weak_ptr<AlexaConnectivityEngineImpl> wp = shared_from_this();
+                m_stateChangeTimer =
+                    TimerWheel::getDefault()->submitAfter(m_lastStateChange + m_stateChangeInterval - now, [wp]() {
+                        if (auto sp = wp.lock()) {
+                            sp->m_executor.submit([wp]() {
+                                if (auto sp = wp.lock()) {
+                                    sp->executeDeferredStateChange();
+                                }
+                            });
+                        }
+                    });
+            }
+            AACE_DEBUG(LX(TAG).m("connectivityStateChangeDeferred"));
+            return true;
+        }
+        m_lastStateChange = now;
+        m_stateChangeProcessed = true;
+    }
+    return processConnectivityStateChange();
+}
+
+void AlexaConnectivityEngineImpl::executeDeferredStateChange() {
+    AACE_INFO(LX(TAG));
+    {
+        std::lock_guard<std::mutex> guard{m_throttleMutex};
+        m_stateChangeTimer = TimerWheel::INVALID_TIMER;
+        m_lastStateChange = std::chrono::steady_clock::now();
+    }
+    processConnectivityStateChange();
+}
+
+bool AlexaConnectivityEngineImpl::processConnectivityStateChange() {
     try {
-        emitCounterMetrics(
-            METRIC_PROGRAM_NAME_SUFFIX, "onConnectivityStateChange", METRIC_CONNECTIVITY_CONNECTIVITY_STATE_CHANGE, 1);
+        std::lock_guard<std::mutex> stateChangeGuard{m_stateChangeMutex};
+
         // Save the old values.
         auto oldDataPlan = getDataPlan();
         auto oldDataPlansAvailable = DataPlansAvailable(getDataPlansAvailable());
@@ -139,6 +221,9 @@ bool AlexaConnectivityEngineImpl::onConnectivityStateChange() {
         if ((newDataPlan != oldDataPlan) && (newDataPlan.type != DataPlanType::UNKNOWN)) {
             m_connectivityCapabilityAgent->onDataPlanStateChanged(DataPlanState(newDataPlan, timeOfSample), cause);
         }
+        if (newDataPlan != oldDataPlan) {
+            updateMeteredLink();
+        }
         if ((newDataPlansAvailable != oldDataPlansAvailable) && (!newDataPlansAvailable.empty())) {
             m_connectivityCapabilityAgent->onDataPlansAvailableStateChanged(
                 DataPlansAvailableState(newDataPlansAvailable, timeOfSample), cause);
@@ -176,42 +261,62 @@ void AlexaConnectivityEngineImpl::onSendConnectivityEvent(const std::string& eve
             eventJson = nlohmann::json::parse(event);
             ThrowIf(!eventJson.contains("type") || !eventJson["type"].is_string(), "invalidEvent");
 
-            auto type = eventJson["type"];
-            ConnectivityCapabilityAgent::InitiateDataPlanSubscriptionType planType;
-            if (type == ACTIVATE_TRIAL_KEY) {
-                planType = ConnectivityCapabilityAgent::InitiateDataPlanSubscriptionType::TRIAL;
-            } else if (type == ACTIVATE_PAID_PLAN_KEY) {
-                planType = ConnectivityCapabilityAgent::InitiateDataPlanSubscriptionType::PAID;
-            } else {
-                Throw("invalidEventType");
-            }
-            auto resultFuture = m_connectivityCapabilityAgent->initiateDataPlanSubscription(planType);
-            resultFuture.wait();
-
-            auto result = resultFuture.get();
-
-            ThrowIf(!result, "initiateDataPlanSubscriptionFailed");
+            std::string type = eventJson["type"];
+            ThrowIf(type != ACTIVATE_TRIAL_KEY && type != ACTIVATE_PAID_PLAN_KEY, "invalidEventType");
 
-            if (!token.empty()) {
-                // Notify only when token is not empty
-                m_alexaConnectivityPlatformInterface->connectivityEventResponse(token, StatusCode::SUCCESS);
-            }
+            // the event is sent by the queue, which coalesces it with the pending event of the same type
+            m_eventQueue->enqueue(type, token);
         } catch (std::exception& ex) {
             AACE_ERROR(LX(TAG, "onSendConnectivityEventExecutor").d("reason", ex.what()));
-
-            if (!token.empty()) {
-                // Notify only when token is not empty
-                m_alexaConnectivityPlatformInterface->connectivityEventResponse(token, StatusCode::FAIL);
-            }
-            emitCounterMetrics(
-                METRIC_PROGRAM_NAME_SUFFIX,
-                "onSendConnectivityEvent",
-                METRIC_CONNECTIVITY_SEND_CONNECTIVITY_EVENT_FAILED,
-                1);
+            onConnectivityEventResult(token, false);
         }
     });
 }
 
+bool AlexaConnectivityEngineImpl::sendConnectivityEvent(const std::string& type) {
+    try {
+        ConnectivityCapabilityAgent::InitiateDataPlanSubscriptionType planType;
+        if (type == ACTIVATE_TRIAL_KEY) {
+            planType = ConnectivityCapabilityAgent::InitiateDataPlanSubscriptionType::TRIAL;
+        } else if (type == ACTIVATE_PAID_PLAN_KEY) {
+            planType = ConnectivityCapabilityAgent::InitiateDataPlanSubscriptionType::PAID;
+        } else {
+            Throw("invalidEventType");
+        }
+        auto resultFuture = m_connectivityCapabilityAgent->initiateDataPlanSubscription(planType);
+        resultFuture.wait();
+
+        ThrowIf(!resultFuture.get(), "initiateDataPlanSubscriptionFailed");
+        return true;
+    } catch (std::exception& ex) {
+        AACE_WARN(LX(TAG).d("reason", ex.what()).d("type", type));
+        return false;
+    }
+}
+
+void AlexaConnectivityEngineImpl::onConnectivityEventResult(const std::string& token, bool success) {
+    if (!success) {
+        emitCounterMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX,
+            "onSendConnectivityEvent",
+            METRIC_CONNECTIVITY_SEND_CONNECTIVITY_EVENT_FAILED,
+            1);
+    }
+    if (!token.empty() && m_alexaConnectivityPlatformInterface != nullptr) {
+        // Notify only when token is not empty
+        m_alexaConnectivityPlatformInterface->connectivityEventResponse(
+            token, success ? StatusCode::SUCCESS : StatusCode::FAIL);
+    }
+}
+
+void AlexaConnectivityEngineImpl::updateMeteredLink() {
+    if (m_backgroundTransferScheduler != nullptr) {
+        // the sponsored data plan doesn't charge the Alexa traffic, and an unknown plan isn't assumed to be metered
+        auto type = getDataPlan().type;
+        m_backgroundTransferScheduler->setMetered(type == DataPlanType::PAID || type == DataPlanType::TRIAL);
+    }
+}
+
 AlexaConnectivityInterface::DataPlan AlexaConnectivityEngineImpl::getDataPlan() const {
     std::lock_guard<std::mutex> guard{m_mutex};
     return m_dataPlan;
@@ -258,7 +363,23 @@ AlexaConnectivityInterface::Terms AlexaConnectivityEngineImpl::getTerms() const
 
 void AlexaConnectivityEngineImpl::doShutdown() {
     AACE_INFO(LX(TAG));
+    {
+        std::lock_guard<std::mutex> guard{m_throttleMutex};
+        if (m_stateChangeTimer != TimerWheel::INVALID_TIMER) {
+            TimerWheel::getDefault()->cancel(m_stateChangeTimer);
+            m_stateChangeTimer = TimerWheel::INVALID_TIMER;
+        }
+    }
     m_executor.shutdown();
+    if (m_eventQueue != nullptr) {
+        if (m_connectionManager != nullptr) {
+            m_connectionManager->removeConnectionStatusObserver(m_eventQueue);
+            m_connectionManager.reset();
+        }
+        // the event being sent is completed first, since it uses the capability agent
+        m_eventQueue->shutdown();
+        m_eventQueue.reset();
+    }
     if (m_connectivityCapabilityAgent != nullptr) {
         m_connectivityCapabilityAgent->shutdown();
         m_connectivityCapabilityAgent.reset();
@@ -391,25 +512,46 @@ bool AlexaConnectivityEngineImpl::updateConnectivityState() {
         // Get the connectivity state from the platform implementation.
         // If the payload is empty, then skip and retain the current state.
         auto payload = m_alexaConnectivityPlatformInterface->getConnectivityState();
-        if (!payload.empty()) {
+        if (!payload.empty() && payload != m_connectivityStatePayload) {
             nlohmann::json document;
             document = nlohmann::json::parse(payload);
 
+            // Only the elements that differ from the previous state are parsed again.
+            auto unchanged = [this, &document](const std::string& key) {
+                auto current = document.find(key);
+                auto previous = m_connectivityStateDocument.find(key);
+                if (current == document.end() || previous == m_connectivityStateDocument.end()) {
+                    return current == document.end() && previous == m_connectivityStateDocument.end();
+                }
+                return *current == *previous;
+            };
+            auto previouslyParsed = !m_connectivityStatePayload.empty();
+
             // Connectivity properties.
-            ManagedProvider managedProvider = parseManagedProvider(document);  // always required
+            ManagedProvider managedProvider = previouslyParsed && unchanged(MANAGEDPROVIDER_KEY)
+                                                  ? m_managedProvider
+                                                  : parseManagedProvider(document);  // always required
             ThrowIf(managedProvider.type == ManagedProviderType::UNKNOWN, "managedProviderElementNotFound");
             auto managed = managedProvider.type == ManagedProviderType::MANAGED;
 
             // InternetDataPlan properties.
-            DataPlan dataPlan = parseDataPlan(document);  // required when managed is true
+            DataPlan dataPlan = previouslyParsed && unchanged(DATAPLAN_KEY)
+                                    ? m_dataPlan
+                                    : parseDataPlan(document);  // required when managed is true
             ThrowIf(managed && dataPlan.type == DataPlanType::UNKNOWN, "dataPlanElementNotFound");
-            DataPlansAvailable dataPlansAvailable = parseDataPlansAvailable(document);
-            Terms terms = parseTerms(document);
+            DataPlansAvailable dataPlansAvailable = previouslyParsed && unchanged(DATAPLANSAVAILABLE_KEY)
+                                                        ? m_dataPlansAvailable
+                                                        : parseDataPlansAvailable(document);
+            Terms terms = previouslyParsed && unchanged(TERMSSTATUS_KEY) && unchanged(TERMSVERSION_KEY)
+                              ? m_terms
+                              : parseTerms(document);
 
             m_dataPlan = std::move(dataPlan);
             m_dataPlansAvailable.swap(dataPlansAvailable);
             m_managedProvider = std::move(managedProvider);
             m_terms = std::move(terms);
+            m_connectivityStatePayload = std::move(payload);
+            m_connectivityStateDocument = std::move(document);
         }
 
         return true;
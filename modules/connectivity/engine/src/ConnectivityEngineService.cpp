@@ -14,6 +14,7 @@
  */
 
 #include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Network/BackgroundTransferScheduler.h>
 #include <AACE/Engine/Vehicle/VehiclePropertyInterface.h>
 #include <nlohmann/json.hpp>
 
@@ -30,10 +31,28 @@ static const std::string TAG("aace.connectivity.ConnectivityEngineService");
 /// Register the service.
 REGISTER_SERVICE(ConnectivityEngineService);
 
+/// Configuration keys.
+static const std::string CONFIG_KEY_STATE_CHANGE_INTERVAL = "stateChangeIntervalInMilliseconds";
+
 ConnectivityEngineService::ConnectivityEngineService(const aace::engine::core::ServiceDescription& description) :
         aace::engine::core::EngineService{description} {
 }
 
+bool ConnectivityEngineService::configureFromJson(const aace::engine::utils::json::Value& configuration) {
+    try {
+        auto stateChangeInterval = configuration.find(CONFIG_KEY_STATE_CHANGE_INTERVAL);
+        if (stateChangeInterval != configuration.end()) {
+            ThrowIfNot(stateChangeInterval->is_number_unsigned(), "invalidStateChangeInterval");
+            m_stateChangeInterval = std::chrono::milliseconds(stateChangeInterval->get<uint64_t>());
+        }
+        AACE_DEBUG(LX(TAG).d("stateChangeIntervalInMilliseconds", m_stateChangeInterval.count()));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool ConnectivityEngineService::shutdown() {
     AACE_INFO(LX(TAG));
     if (m_alexaConnectivityEngineImpl != nullptr) {
@@ -73,14 +92,28 @@ bool ConnectivityEngineService::registerPlatformInterfaceType(
         auto contextManager = alexaComponents->getContextManager();
         ThrowIfNull(contextManager, "contextManagerInvalid");
 
+        auto connectionManager = alexaComponents->getConnectionManager();
+        ThrowIfNull(connectionManager, "connectionManagerInvalid");
+
         auto vehicleProperties =
             getContext()->getServiceInterface<aace::engine::vehicle::VehiclePropertyInterface>("aace.vehicle");
         ThrowIfNull(vehicleProperties, "vehiclePropertiesInvalid");
         auto vehicleIdentifier =
             vehicleProperties->getVehicleProperty(vehicle::VehiclePropertyType::VEHICLE_IDENTIFIER);
 
+        // the background transfers of the Engine are deferred while the data plan is metered
+        auto backgroundTransferScheduler =
+            getContext()->getServiceInterface<aace::engine::network::BackgroundTransferScheduler>("aace.network");
+
         m_alexaConnectivityEngineImpl = aace::engine::connectivity::AlexaConnectivityEngineImpl::create(
-            alexaConnectivity, defaultCapabilitiesRegistrar, messageSender, contextManager, vehicleIdentifier);
+            alexaConnectivity,
+            defaultCapabilitiesRegistrar,
+            messageSender,
+            contextManager,
+            vehicleIdentifier,
+            m_stateChangeInterval,
+            backgroundTransferScheduler,
+            connectionManager);
         ThrowIfNull(m_alexaConnectivityEngineImpl, "createAlexaConnectivityEngineImplFailed");
 
         return true;
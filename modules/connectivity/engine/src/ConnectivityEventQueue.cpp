@@ -0,0 +1,239 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+
+#include "AACE/Engine/Connectivity/ConnectivityEventQueue.h"
+
+namespace aace {
+namespace engine {
+namespace connectivity {
+
+using namespace aace::engine::utils::metrics;
+using ConnectionStatusObserverInterface = alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface;
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("aace.connectivity.ConnectivityEventQueue");
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "ConnectivityEventQueue";
+
+/// Counter metrics for the connectivity events
+static const std::string METRIC_CONNECTIVITY_EVENT_COALESCED = "ConnectivityEventCoalesced";
+static const std::string METRIC_CONNECTIVITY_EVENT_RETRIED = "ConnectivityEventRetried";
+
+const std::chrono::milliseconds ConnectivityEventQueue::DEFAULT_INITIAL_BACKOFF = std::chrono::seconds(1);
+const std::chrono::milliseconds ConnectivityEventQueue::DEFAULT_MAX_BACKOFF = std::chrono::seconds(30);
+const unsigned int ConnectivityEventQueue::DEFAULT_MAX_ATTEMPTS = 5;
+
+std::shared_ptr<ConnectivityEventQueue> ConnectivityEventQueue::create(
+    EventSender sender,
+    ResultCallback resultCallback,
+    std::chrono::milliseconds initialBackoff,
+    std::chrono::milliseconds maxBackoff,
+    unsigned int maxAttempts) {
+    try {
+        ThrowIfNot(sender, "invalidSender");
+        ThrowIfNot(resultCallback, "invalidResultCallback");
+        ThrowIf(initialBackoff.count() <= 0 || maxBackoff < initialBackoff, "invalidBackoff");
+        ThrowIf(maxAttempts == 0, "invalidMaxAttempts");
+        return std::shared_ptr<ConnectivityEventQueue>(
+            new ConnectivityEventQueue(sender, resultCallback, initialBackoff, maxBackoff, maxAttempts));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+ConnectivityEventQueue::ConnectivityEventQueue(
+    EventSender sender,
+    ResultCallback resultCallback,
+    std::chrono::milliseconds initialBackoff,
+    std::chrono::milliseconds maxBackoff,
+    unsigned int maxAttempts) :
+        m_sender{sender},
+        m_resultCallback{resultCallback},
+        m_initialBackoff{initialBackoff},
+        m_maxBackoff{maxBackoff},
+        m_maxAttempts{maxAttempts},
+        m_backoff{initialBackoff},
+        m_retryTimer{TimerWheel::INVALID_TIMER} {
+}
+
+void ConnectivityEventQueue::enqueue(const std::string& type, const std::string& token) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_shutdown) {
+        AACE_WARN(LX(TAG).d("reason", "queueShutdown").d("type", type));
+        return;
+    }
+    auto it = m_pendingEvents.find(type);
+    if (it != m_pendingEvents.end()) {
+        // the pending event is replaced, and its result is notified for both tokens
+        emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "enqueue", METRIC_CONNECTIVITY_EVENT_COALESCED, 1);
+        it->second.tokens.push_back(token);
+        it->second.attempts = 0;
+        AACE_DEBUG(LX(TAG).m("eventCoalesced").d("type", type).d("tokens", it->second.tokens.size()));
+        return;
+    }
+    m_pendingEvents[type].tokens.push_back(token);
+    scheduleFlushLocked();
+}
+
+size_t ConnectivityEventQueue::getPendingCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pendingEvents.size();
+}
+
+void ConnectivityEventQueue::shutdown() {
+    AACE_INFO(LX(TAG));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+        if (m_retryTimer != TimerWheel::INVALID_TIMER) {
+            TimerWheel::getDefault()->cancel(m_retryTimer);
+            m_retryTimer = TimerWheel::INVALID_TIMER;
+        }
+        if (!m_pendingEvents.empty()) {
+            AACE_WARN(LX(TAG).m("pendingEventsDropped").d("count", m_pendingEvents.size()));
+            m_pendingEvents.clear();
+        }
+    }
+    m_executor.shutdown();
+}
+
+void ConnectivityEventQueue::onConnectionStatusChanged(
+    const ConnectionStatusObserverInterface::Status status,
+    const ConnectionStatusObserverInterface::ChangedReason reason) {
+    setConnected(status == ConnectionStatusObserverInterface::Status::CONNECTED);
+}
+
+void ConnectivityEventQueue::onConnectionStatusChanged(
+    const ConnectionStatusObserverInterface::Status status,
+    const std::vector<ConnectionStatusObserverInterface::EngineConnectionStatus>& engineStatuses) {
+    setConnected(status == ConnectionStatusObserverInterface::Status::CONNECTED);
+}
+
+void ConnectivityEventQueue::setConnected(bool connected) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (connected == m_connected) {
+        return;
+    }
+    AACE_DEBUG(LX(TAG).d("connected", connected).d("pendingEvents", m_pendingEvents.size()));
+    m_connected = connected;
+
+    // the events are held while disconnected, and sent together without a backoff when the connection comes back
+    if (m_retryTimer != TimerWheel::INVALID_TIMER) {
+        TimerWheel::getDefault()->cancel(m_retryTimer);
+        m_retryTimer = TimerWheel::INVALID_TIMER;
+    }
+    if (connected) {
+        m_backoff = m_initialBackoff;
+        if (!m_pendingEvents.empty()) {
+            scheduleFlushLocked();
+        }
+    }
+}
+
+void ConnectivityEventQueue::scheduleFlushLocked() {
+    // the events queued during a backoff wait for the retry, and the events queued while disconnected are held
+    if (m_flushScheduled || m_retryTimer != TimerWheel::INVALID_TIMER || !m_connected || m_shutdown) {
+        return;
+    }
+    m_flushScheduled = true;
+    std::weak_ptr<ConnectivityEventQueue> wp = shared_from_this();
+    m_executor.submit([wp]() {
+        if (auto sp = wp.lock()) {
+            sp->executeFlush();
+        }
+    });
+}
+
+void ConnectivityEventQueue::executeFlush() {
+    std::map<std::string, PendingEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_flushScheduled = false;
+        if (m_shutdown || !m_connected) {
+            return;
+        }
+        events.swap(m_pendingEvents);
+    }
+
+    std::vector<std::pair<std::string, bool>> results;
+    bool retry = false;
+    for (auto& next : events) {
+        auto& type = next.first;
+        auto& event = next.second;
+        auto success = m_sender(type);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_shutdown) {
+            return;
+        }
+        // an attempt made while AVS is disconnected doesn't count, since the event is held until it reconnects
+        if (success || (m_connected && ++event.attempts >= m_maxAttempts)) {
+            for (auto& token : event.tokens) {
+                results.emplace_back(token, success);
+            }
+            continue;
+        }
+        retry = true;
+        auto it = m_pendingEvents.find(type);
+        if (it != m_pendingEvents.end()) {
+            // an event of the same type was queued during the attempt, it is sent for both
+            it->second.tokens.insert(it->second.tokens.begin(), event.tokens.begin(), event.tokens.end());
+        } else {
+            m_pendingEvents[type] = event;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!retry) {
+            m_backoff = m_initialBackoff;
+        } else if (m_connected && !m_shutdown) {
+            // a single retry of all the events that failed, after the backoff shared by the queue
+            emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "executeFlush", METRIC_CONNECTIVITY_EVENT_RETRIED, 1);
+            AACE_DEBUG(LX(TAG).m("retryScheduled").d("backoffMs", m_backoff.count()));
+            std::weak_ptr<ConnectivityEventQueue> wp = shared_from_this();
+            m_retryTimer = TimerWheel::getDefault()->submitAfter(m_backoff, [wp]() {
+                if (auto sp = wp.lock()) {
+                    std::lock_guard<std::mutex> lock(sp->m_mutex);
+                    sp->m_retryTimer = TimerWheel::INVALID_TIMER;
+                    sp->scheduleFlushLocked();
+                }
+            });
+            m_backoff = std::min(m_backoff * 2, m_maxBackoff);
+        }
+        if (!m_pendingEvents.empty()) {
+            // the events queued during the flush, which are not waiting for the retry
+            scheduleFlushLocked();
+        }
+    }
+
+    for (auto& result : results) {
+        if (!result.first.empty()) {
+            m_resultCallback(result.first, result.second);
+        }
+    }
+}
+
+}  // namespace connectivity
+}  // namespace engine
+}  // namespace aace
@@ -131,7 +131,9 @@ protected:
     }
 
     std::shared_ptr<aace::engine::connectivity::AlexaConnectivityEngineImpl> createAlexaConnectivityEngineImpl(
-        std::shared_ptr<StrictMock<MockAlexaConnectivity>> mockConnectivityHandler) {
+        std::shared_ptr<StrictMock<MockAlexaConnectivity>> mockConnectivityHandler,
+        std::chrono::milliseconds stateChangeInterval =
+            aace::engine::connectivity::AlexaConnectivityEngineImpl::DEFAULT_STATE_CHANGE_INTERVAL) {
         if (m_configured == false) {
             configure();
         }
@@ -141,7 +143,8 @@ protected:
             m_mockEndpointBuilder,
             m_mockMessageSender,
             m_mockContextManager,
-            m_mockVehicleIdentifier);
+            m_mockVehicleIdentifier,
+            stateChangeInterval);
 
         return alexaConnectivityEngineImpl;
     }
@@ -433,6 +436,53 @@ TEST_F(AlexaConnectivityEngineImplTest, sendConnectivityEventWithValidJSON) {
     alexaConnectivityEngineImpl->shutdown();
 }
 
+/**
+ * @test connectivityStateChangeBurstIsThrottled
+ */
+TEST_F(AlexaConnectivityEngineImplTest, connectivityStateChangeBurstIsThrottled) {
+    // clang-format off
+    const std::string& trialValue = nlohmann::json({
+        {"managedProvider",{
+            {"type","MANAGED"},
+            {"id","AMAZON"}
+        }},
+        {"dataPlan",{
+            {"type","TRIAL"}
+        }}
+    }).dump();
+    const std::string& paidValue = nlohmann::json({
+        {"managedProvider",{
+            {"type","MANAGED"},
+            {"id","AMAZON"}
+        }},
+        {"dataPlan",{
+            {"type","PAID"}
+        }}
+    }).dump();
+    // clang-format on
+
+    alexaClientSDK::avsCommon::utils::WaitEvent waitEvent;
+    EXPECT_CALL(*m_mockConnectivityHandler, getConnectivityState())
+        .Times(3)
+        .WillOnce(Return(std::string()))  // initial connectivity state
+        .WillOnce(Return(trialValue))
+        .WillOnce(
+            testing::DoAll(testing::InvokeWithoutArgs([&waitEvent]() { waitEvent.wakeUp(); }), Return(paidValue)));
+    EXPECT_CALL(*m_mockConnectivityHandler, getIdentifier()).WillOnce(Return(std::string()));
+
+    auto alexaConnectivityEngineImpl =
+        createAlexaConnectivityEngineImpl(m_mockConnectivityHandler, std::chrono::milliseconds(200));
+    ASSERT_NE(alexaConnectivityEngineImpl, nullptr) << "AlexaConnectivityEngineImpl pointer expected to be not null!";
+
+    // The first change is processed, the burst that follows is processed once when the interval has elapsed
+    ASSERT_TRUE(m_mockConnectivityHandler->connectivityStateChange());
+    ASSERT_TRUE(m_mockConnectivityHandler->connectivityStateChange());
+    ASSERT_TRUE(m_mockConnectivityHandler->connectivityStateChange());
+    ASSERT_TRUE(waitEvent.wait(TIMEOUT)) << "Deferred connectivity state change expected!";
+
+    alexaConnectivityEngineImpl->shutdown();
+}
+
 /**
  * @test connectivityStateChange/<number>
  */
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/Connectivity/ConnectivityEventQueue.h>
+
+namespace aace {
+namespace test {
+namespace unit {
+namespace connectivity {
+
+using aace::engine::connectivity::ConnectivityEventQueue;
+using Status = alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status;
+using ChangedReason = alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::ChangedReason;
+
+/// Plenty of timeout to wait for async task to run
+static const std::chrono::seconds TIMEOUT(2);
+
+/// A short backoff, so the retries run within the test
+static const std::chrono::milliseconds BACKOFF(20);
+
+class ConnectivityEventQueueTest : public ::testing::Test {
+public:
+    void TearDown() override {
+        if (m_queue != nullptr) {
+            m_queue->shutdown();
+        }
+    }
+
+protected:
+    /// Creates a queue whose sender fails the first @c failures attempts of each type
+    void createQueue(unsigned int failures, unsigned int maxAttempts = ConnectivityEventQueue::DEFAULT_MAX_ATTEMPTS) {
+        m_queue = ConnectivityEventQueue::create(
+            [this, failures](const std::string& type) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return ++m_attempts[type] > failures;
+            },
+            [this](const std::string& token, bool success) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_results[token] = success;
+                m_cv.notify_all();
+            },
+            BACKOFF,
+            BACKOFF * 4,
+            maxAttempts);
+        ASSERT_NE(m_queue, nullptr);
+    }
+
+    bool waitForResults(size_t count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_cv.wait_for(lock, TIMEOUT, [this, count] { return m_results.size() >= count; });
+    }
+
+    unsigned int getAttempts(const std::string& type) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_attempts[type];
+    }
+
+    std::shared_ptr<ConnectivityEventQueue> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::map<std::string, unsigned int> m_attempts;
+    std::map<std::string, bool> m_results;
+};
+
+/**
+ * @test rejectsInvalidArguments
+ */
+TEST_F(ConnectivityEventQueueTest, rejectsInvalidArguments) {
+    auto sender = [](const std::string& type) { return true; };
+    auto resultCallback = [](const std::string& token, bool success) {};
+    EXPECT_EQ(ConnectivityEventQueue::create(nullptr, resultCallback), nullptr);
+    EXPECT_EQ(ConnectivityEventQueue::create(sender, nullptr), nullptr);
+    EXPECT_EQ(ConnectivityEventQueue::create(sender, resultCallback, std::chrono::milliseconds(0)), nullptr);
+    EXPECT_EQ(
+        ConnectivityEventQueue::create(sender, resultCallback, std::chrono::seconds(2), std::chrono::seconds(1)),
+        nullptr);
+    EXPECT_EQ(ConnectivityEventQueue::create(sender, resultCallback, BACKOFF, BACKOFF, 0), nullptr);
+}
+
+/**
+ * @test coalescesEventsWhileDisconnected
+ */
+TEST_F(ConnectivityEventQueueTest, coalescesEventsWhileDisconnected) {
+    createQueue(0);
+    m_queue->onConnectionStatusChanged(Status::PENDING, ChangedReason::SERVER_SIDE_DISCONNECT);
+
+    m_queue->enqueue("ACTIVATE_TRIAL", "token1");
+    m_queue->enqueue("ACTIVATE_TRIAL", "token2");
+    m_queue->enqueue("ACTIVATE_PAID_PLAN", "token3");
+    EXPECT_EQ(m_queue->getPendingCount(), 2u);
+    EXPECT_EQ(getAttempts("ACTIVATE_TRIAL"), 0u);
+
+    // the events are sent once each when the connection comes back, and both tokens get the result
+    m_queue->onConnectionStatusChanged(Status::CONNECTED, ChangedReason::SUCCESS);
+    ASSERT_TRUE(waitForResults(3));
+    EXPECT_EQ(getAttempts("ACTIVATE_TRIAL"), 1u);
+    EXPECT_EQ(getAttempts("ACTIVATE_PAID_PLAN"), 1u);
+    EXPECT_EQ(m_results, (std::map<std::string, bool>{{"token1", true}, {"token2", true}, {"token3", true}}));
+    EXPECT_EQ(m_queue->getPendingCount(), 0u);
+}
+
+/**
+ * @test retriesFailedEvents
+ */
+TEST_F(ConnectivityEventQueueTest, retriesFailedEvents) {
+    createQueue(2);
+    m_queue->enqueue("ACTIVATE_TRIAL", "token1");
+    m_queue->enqueue("ACTIVATE_PAID_PLAN", "");
+    ASSERT_TRUE(waitForResults(1));
+    EXPECT_EQ(m_results, (std::map<std::string, bool>{{"token1", true}}));
+    EXPECT_EQ(getAttempts("ACTIVATE_TRIAL"), 3u);
+}
+
+/**
+ * @test failsAfterMaxAttempts
+ */
+TEST_F(ConnectivityEventQueueTest, failsAfterMaxAttempts) {
+    createQueue(10, 2);
+    m_queue->enqueue("ACTIVATE_TRIAL", "token1");
+    ASSERT_TRUE(waitForResults(1));
+    EXPECT_EQ(m_results, (std::map<std::string, bool>{{"token1", false}}));
+    EXPECT_EQ(getAttempts("ACTIVATE_TRIAL"), 2u);
+}
+
+/**
+ * @test dropsEventsAfterShutdown
+ */
+TEST_F(ConnectivityEventQueueTest, dropsEventsAfterShutdown) {
+    createQueue(0);
+    m_queue->onConnectionStatusChanged(Status::DISCONNECTED, ChangedReason::ACL_CLIENT_REQUEST);
+    m_queue->enqueue("ACTIVATE_TRIAL", "token1");
+    m_queue->shutdown();
+    EXPECT_EQ(m_queue->getPendingCount(), 0u);
+
+    m_queue->enqueue("ACTIVATE_TRIAL", "token2");
+    m_queue->onConnectionStatusChanged(Status::CONNECTED, ChangedReason::SUCCESS);
+    EXPECT_FALSE(waitForResults(1));
+    EXPECT_EQ(getAttempts("ACTIVATE_TRIAL"), 0u);
+}
+
+}  // namespace connectivity
+}  // namespace unit
+}  // namespace test
+}  // namespace aace
@@ -40,6 +40,12 @@ public:
 
 private:
     bool postRegister() override;
+    bool configureMessageInterface(const std::string& name, bool enabled, std::istream& configuration) override;
+
+private:
+    // reuse the stream handler and stream id of each channel for subsequent streams
+    bool m_pooledInputStreams = false;
+    bool m_pooledOutputStreams = false;
 };
 
 }  // namespace audio
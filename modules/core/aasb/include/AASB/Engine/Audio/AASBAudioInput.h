@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <fstream>
+#include <vector>
 
 namespace aasb {
 namespace engine {
@@ -36,7 +37,7 @@ public:
     using AudioInputType = aace::audio::AudioInputProvider::AudioInputType;
 
 private:
-    AASBAudioInput(const std::string& name, AudioInputType type);
+    AASBAudioInput(const std::string& name, AudioInputType type, bool pooledStreams);
 
     bool initialize(
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
@@ -45,11 +46,18 @@ private:
 public:
     virtual ~AASBAudioInput() = default;
 
+    /**
+     * Creates an audio input channel.
+     *
+     * @param pooledStreams if @c true, the channel registers one stream handler with the stream
+     *     manager and requests every audio input with the same stream id
+     */
     static std::shared_ptr<AASBAudioInput> create(
         const std::string& name,
         AudioInputType type,
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager);
+        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+        bool pooledStreams = false);
 
     // aace::audio::AudioInput
     bool startAudioInput() override;
@@ -61,11 +69,15 @@ public:
 private:
     const std::string m_name;
     const AudioInputType m_type;
+    const bool m_pooledStreams;
 
     bool m_expectAudio = false;
 
     std::string m_currentStreamId;
 
+    // stream id of the stream handler registered in pooled mode
+    std::string m_pooledStreamId;
+
     std::weak_ptr<aace::engine::messageBroker::MessageBrokerInterface> m_messageBroker;
     std::weak_ptr<aace::engine::messageBroker::StreamManagerInterface> m_streamManager;
 
@@ -85,6 +97,8 @@ private:
 
     private:
         std::shared_ptr<AASBAudioInput> m_audioInput;
+        // the samples of a write that are not aligned to 16 bits, copied before they are written
+        std::vector<int16_t> m_alignedSamples;
     };
 };
 
@@ -35,14 +35,22 @@ private:
 
     bool initialize(
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager);
+        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+        bool pooledStreams);
 
 public:
     virtual ~AASBAudioInputProvider() = default;
 
+    /**
+     * Creates the audio input provider.
+     *
+     * @param pooledStreams if @c true, the channels opened by the provider reuse a pooled stream
+     *     handler and stream id for each stream instead of creating a new one
+     */
     static std::shared_ptr<AASBAudioInputProvider> create(
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager);
+        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+        bool pooledStreams = false);
 
     // aace::audio::AudioInputProvider
     std::shared_ptr<aace::audio::AudioInput> openChannel(const std::string& name, AudioInputType type) override;
@@ -50,6 +58,8 @@ public:
 private:
     std::weak_ptr<aace::engine::messageBroker::MessageBrokerInterface> m_messageBroker;
     std::weak_ptr<aace::engine::messageBroker::StreamManagerInterface> m_streamManager;
+
+    bool m_pooledStreams = false;
 };
 
 }  // namespace audio
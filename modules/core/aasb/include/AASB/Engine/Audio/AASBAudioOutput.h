@@ -32,20 +32,31 @@ class AASBAudioOutput
         : public aace::audio::AudioOutput
         , public std::enable_shared_from_this<AASBAudioOutput> {
 private:
-    AASBAudioOutput(const std::string& name, const aace::audio::AudioOutputProvider::AudioOutputType& type);
+    AASBAudioOutput(
+        const std::string& name,
+        const aace::audio::AudioOutputProvider::AudioOutputType& type,
+        bool pooledStreams);
 
     bool initialize(
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
         std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager);
 
 public:
-    virtual ~AASBAudioOutput() = default;
-
+    virtual ~AASBAudioOutput();
+
+    /**
+     * Creates an audio output channel.
+     *
+     * @param pooledStreams if @c true, every stream prepared on the channel is read through the
+     *     same stream handler and stream id, which stays registered with the stream manager
+     *     between prepares instead of being recreated for each stream
+     */
     static std::shared_ptr<AASBAudioOutput> create(
         const std::string& name,
         const aace::audio::AudioOutputProvider::AudioOutputType& type,
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager);
+        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+        bool pooledStreams = false);
 
     // aace::audio::AudioOutput
     bool prepare(std::shared_ptr<aace::audio::AudioStream> stream, bool repeating) override;
@@ -67,6 +78,7 @@ public:
 private:
     const std::string m_name;
     const aace::audio::AudioOutputProvider::AudioOutputType m_type;
+    const bool m_pooledStreams;
 
     std::string m_currentToken;
 
@@ -83,8 +95,12 @@ private:
     public:
         AudioOutputStreamHandler(std::shared_ptr<aace::audio::AudioStream> stream);
 
+        // replaces the stream read by a pooled handler
+        void setStream(std::shared_ptr<aace::audio::AudioStream> stream);
+
         // aace::core::MessageStream
         ssize_t read(char* data, const size_t size) override;
+        ssize_t timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) override;
         ssize_t write(const char* data, const size_t size) override;
         bool isClosed() override;
         MessageStream::Mode getMode() override;
@@ -92,6 +108,11 @@ private:
     private:
         std::shared_ptr<aace::audio::AudioStream> m_stream;
     };
+
+private:
+    // stream handler and stream id reused by each prepare in pooled mode
+    std::shared_ptr<AudioOutputStreamHandler> m_pooledHandler;
+    std::string m_pooledStreamId;
 };
 
 }  // namespace audio
@@ -32,14 +32,22 @@ private:
 
     bool initialize(
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager);
+        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+        bool pooledStreams);
 
 public:
     virtual ~AASBAudioOutputProvider() = default;
 
+    /**
+     * Creates the audio output provider.
+     *
+     * @param pooledStreams if @c true, the channels opened by the provider reuse a pooled stream
+     *     handler and stream id for each stream instead of creating a new one
+     */
     static std::shared_ptr<AASBAudioOutputProvider> create(
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager);
+        std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+        bool pooledStreams = false);
 
     // aace::audio::AudioOutputProvider
     std::shared_ptr<aace::audio::AudioOutput> openChannel(const std::string& name, AudioOutputType type) override;
@@ -47,6 +55,8 @@ public:
 private:
     std::weak_ptr<aace::engine::messageBroker::MessageBrokerInterface> m_messageBroker;
     std::weak_ptr<aace::engine::messageBroker::StreamManagerInterface> m_streamManager;
+
+    bool m_pooledStreams = false;
 };
 
 }  // namespace audio
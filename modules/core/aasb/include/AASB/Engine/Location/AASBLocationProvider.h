@@ -18,6 +18,7 @@
 
 #include <AACE/Location/LocationProvider.h>
 #include <AACE/Engine/MessageBroker/MessageBrokerInterface.h>
+#include <AASB/Message/Location/LocationProvider/Location.h>
 
 namespace aasb {
 namespace engine {
@@ -31,6 +32,9 @@ private:
 
     bool initialize(std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker);
 
+    // converts the location of a message, whose undefined values are negative
+    static aace::location::Location toLocation(const aasb::message::location::locationProvider::Location& location);
+
 public:
     static std::shared_ptr<AASBLocationProvider> create(
         std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker);
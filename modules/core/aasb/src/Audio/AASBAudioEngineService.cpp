@@ -19,6 +19,8 @@
 
 #include <AACE/Engine/Core/EngineMacros.h>
 
+#include <nlohmann/json.hpp>
+
 namespace aasb {
 namespace engine {
 namespace audio {
@@ -39,6 +41,35 @@ AASBAudioEngineService::AASBAudioEngineService(const aace::engine::core::Service
             {"AudioInputProvider", "AudioOutputProvider"}) {
 }
 
+bool AASBAudioEngineService::configureMessageInterface(
+    const std::string& name,
+    bool enabled,
+    std::istream& configuration) {
+    try {
+        // call inherited configure method
+        ThrowIfNot(
+            MessageHandlerEngineService::configureMessageInterface(name, enabled, configuration),
+            "configureMessageInterfaceFailed");
+
+        auto root = nlohmann::json::parse(configuration);
+        auto pooledStreams = root["/pooledStreams"_json_pointer];
+
+        if (pooledStreams != nullptr) {
+            ThrowIfNot(pooledStreams.is_boolean(), "invalidPooledStreamsConfiguration");
+            if (name == "AudioInputProvider") {
+                m_pooledInputStreams = pooledStreams.get<bool>();
+            } else if (name == "AudioOutputProvider") {
+                m_pooledOutputStreams = pooledStreams.get<bool>();
+            }
+        }
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("name", name));
+        return false;
+    }
+}
+
 bool AASBAudioEngineService::postRegister() {
     try {
         auto aasbServiceInterface =
@@ -49,7 +80,9 @@ bool AASBAudioEngineService::postRegister() {
         // AudioInputProvider
         if (isInterfaceEnabled("AudioInputProvider")) {
             auto inputProvider = AASBAudioInputProvider::create(
-                aasbServiceInterface->getMessageBroker(), aasbServiceInterface->getStreamManager());
+                aasbServiceInterface->getMessageBroker(),
+                aasbServiceInterface->getStreamManager(),
+                m_pooledInputStreams);
             ThrowIfNull(inputProvider, "createAASBAudioInputProviderFailed");
             getContext()->registerPlatformInterface(inputProvider);
         }
@@ -57,7 +90,9 @@ bool AASBAudioEngineService::postRegister() {
         // AudioOutputProvider
         if (isInterfaceEnabled("AudioOutputProvider")) {
             auto outputProvider = AASBAudioOutputProvider::create(
-                aasbServiceInterface->getMessageBroker(), aasbServiceInterface->getStreamManager());
+                aasbServiceInterface->getMessageBroker(),
+                aasbServiceInterface->getStreamManager(),
+                m_pooledOutputStreams);
             ThrowIfNull(outputProvider, "createAudioSocketOutputProviderFailed");
             getContext()->registerPlatformInterface(outputProvider);
         }
@@ -20,6 +20,7 @@
 #include <AASB/Message/Audio/AudioInput/StartAudioInputMessage.h>
 #include <AASB/Message/Audio/AudioInput/StopAudioInputMessage.h>
 
+#include <cstring>
 #include <functional>
 
 namespace aasb {
@@ -29,19 +30,21 @@ namespace audio {
 // String to identify log entries originating from this file.
 static const std::string TAG("aasb.audio.AASBAudioInput");
 
-AASBAudioInput::AASBAudioInput(const std::string& name, AudioInputType type) : m_name(name), m_type(type) {
+AASBAudioInput::AASBAudioInput(const std::string& name, AudioInputType type, bool pooledStreams) :
+        m_name(name), m_type(type), m_pooledStreams(pooledStreams) {
 }
 
 std::shared_ptr<AASBAudioInput> AASBAudioInput::create(
     const std::string& name,
     AudioInputType type,
     std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager) {
+    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+    bool pooledStreams) {
     try {
         ThrowIfNull(messageBroker, "invalidMessageBroker");
         ThrowIfNull(streamManager, "invalidstreamManager");
 
-        auto audioInput = std::shared_ptr<AASBAudioInput>(new AASBAudioInput(name, type));
+        auto audioInput = std::shared_ptr<AASBAudioInput>(new AASBAudioInput(name, type, pooledStreams));
         ThrowIfNot(audioInput->initialize(messageBroker, streamManager), "initializeAudioInputFailed");
 
         return audioInput;
@@ -80,12 +83,24 @@ bool AASBAudioInput::startAudioInput() {
         auto m_streamManager_lock = m_streamManager.lock();
         ThrowIfNull(m_streamManager_lock, "invalidstreamManagerReference");
 
-        // generate the stream uuid
-        auto streamId = aace::engine::utils::uuid::generateUUID();
+        std::string streamId;
+
+        if (m_pooledStreams && !m_pooledStreamId.empty()) {
+            // the registered stream handler reopens when audio is expected again
+            streamId = m_pooledStreamId;
+        } else {
+            // generate the stream uuid
+            streamId = aace::engine::utils::uuid::generateUUID();
+
+            // create the stream handler, which is kept registered in pooled mode until the
+            // stream manager is shut down
+            auto handler = std::make_shared<AudioInputStreamHandler>(shared_from_this());
+            m_streamManager_lock->registerStreamHandler(streamId, handler, m_pooledStreams);
 
-        // create the stream handler
-        auto handler = std::make_shared<AudioInputStreamHandler>(shared_from_this());
-        m_streamManager_lock->registerStreamHandler(streamId, handler);
+            if (m_pooledStreams) {
+                m_pooledStreamId = streamId;
+            }
+        }
 
         m_expectAudio = true;
         m_currentStreamId = streamId;
@@ -146,7 +161,14 @@ ssize_t AASBAudioInput::AudioInputStreamHandler::read(char* data, const size_t s
 }
 
 ssize_t AASBAudioInput::AudioInputStreamHandler::write(const char* data, const size_t size) {
-    return m_audioInput->write((int16_t*)data, size / 2) * 2;
+    auto count = size / sizeof(int16_t);
+    // the vectorized audio conversions require the samples to be aligned
+    if (reinterpret_cast<uintptr_t>(data) % alignof(int16_t) != 0) {
+        m_alignedSamples.resize(count);
+        std::memcpy(m_alignedSamples.data(), data, count * sizeof(int16_t));
+        return m_audioInput->write(m_alignedSamples.data(), count) * 2;
+    }
+    return m_audioInput->write(reinterpret_cast<const int16_t*>(data), count) * 2;
 }
 
 bool AASBAudioInput::AudioInputStreamHandler::isClosed() {
@@ -25,13 +25,16 @@ static const std::string TAG("aasb.audio.AASBAudioInputProvider");
 
 std::shared_ptr<AASBAudioInputProvider> AASBAudioInputProvider::create(
     std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager) {
+    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+    bool pooledStreams) {
     try {
         ThrowIfNull(messageBroker, "invalidMessageBroker");
         ThrowIfNull(streamManager, "invalidstreamManager");
 
         auto audioInputProvider = std::shared_ptr<AASBAudioInputProvider>(new AASBAudioInputProvider());
-        ThrowIfNot(audioInputProvider->initialize(messageBroker, streamManager), "initializeAudioInputProviderFailed");
+        ThrowIfNot(
+            audioInputProvider->initialize(messageBroker, streamManager, pooledStreams),
+            "initializeAudioInputProviderFailed");
 
         return audioInputProvider;
     } catch (std::exception& ex) {
@@ -42,10 +45,12 @@ std::shared_ptr<AASBAudioInputProvider> AASBAudioInputProvider::create(
 
 bool AASBAudioInputProvider::initialize(
     std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager) {
+    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+    bool pooledStreams) {
     try {
         m_messageBroker = messageBroker;
         m_streamManager = streamManager;
+        m_pooledStreams = pooledStreams;
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -67,7 +72,8 @@ std::shared_ptr<aace::audio::AudioInput> AASBAudioInputProvider::openChannel(
         auto m_streamManager_lock = m_streamManager.lock();
         ThrowIfNull(m_streamManager_lock, "invalidstreamManagerReference");
 
-        auto audioInput = AASBAudioInput::create(name, type, m_messageBroker_lock, m_streamManager_lock);
+        auto audioInput =
+            AASBAudioInput::create(name, type, m_messageBroker_lock, m_streamManager_lock, m_pooledStreams);
         ThrowIfNull(audioInput, "createAudioInputFailed");
 
         return audioInput;
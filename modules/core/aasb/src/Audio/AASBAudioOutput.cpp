@@ -26,6 +26,7 @@
 #include <AASB/Message/Audio/AudioOutput/MayDuckMessage.h>
 #include <AASB/Message/Audio/AudioOutput/MediaError.h>
 #include <AASB/Message/Audio/AudioOutput/MediaErrorMessage.h>
+#include <AASB/Message/Audio/AudioOutput/MediaPositionChangedMessage.h>
 #include <AASB/Message/Audio/AudioOutput/MediaState.h>
 #include <AASB/Message/Audio/AudioOutput/MediaStateChangedMessage.h>
 #include <AASB/Message/Audio/AudioOutput/MutedState.h>
@@ -55,20 +56,30 @@ using Message = aace::engine::messageBroker::Message;
 
 AASBAudioOutput::AASBAudioOutput(
     const std::string& name,
-    const aace::audio::AudioOutputProvider::AudioOutputType& type) :
-        m_name(name), m_type(type) {
+    const aace::audio::AudioOutputProvider::AudioOutputType& type,
+    bool pooledStreams) :
+        m_name(name), m_type(type), m_pooledStreams(pooledStreams) {
+}
+
+AASBAudioOutput::~AASBAudioOutput() {
+    if (m_pooledHandler != nullptr) {
+        if (auto m_streamManager_lock = m_streamManager.lock()) {
+            m_streamManager_lock->unregisterStreamHandler(m_pooledStreamId);
+        }
+    }
 }
 
 std::shared_ptr<AASBAudioOutput> AASBAudioOutput::create(
     const std::string& name,
     const aace::audio::AudioOutputProvider::AudioOutputType& type,
     std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager) {
+    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+    bool pooledStreams) {
     try {
         ThrowIfNull(messageBroker, "invalidMessageBroker");
         ThrowIfNull(streamManager, "invalidstreamManager");
 
-        auto audioOutput = std::shared_ptr<AASBAudioOutput>(new AASBAudioOutput(name, type));
+        auto audioOutput = std::shared_ptr<AASBAudioOutput>(new AASBAudioOutput(name, type, pooledStreams));
         ThrowIfNot(audioOutput->initialize(messageBroker, streamManager), "initializeAudioOutputFailed");
 
         return audioOutput;
@@ -152,6 +163,26 @@ bool AASBAudioOutput::initialize(
                 }
             });
 
+        //
+        // AudioOutput:MediaPositionChanged
+        //
+        messageBroker->subscribe(
+            aasb::message::audio::audioOutput::MediaPositionChangedMessage::topic(),
+            aasb::message::audio::audioOutput::MediaPositionChangedMessage::action(),
+            [wp](const Message& message) {
+                try {
+                    auto sp = wp.lock();
+                    ThrowIfNull(sp, "invalidWeakPtrReference");
+                    aasb::message::audio::audioOutput::MediaPositionChangedMessage::Payload payload =
+                        nlohmann::json::parse(message.payload());
+                    if (payload.channel == sp->m_name) {
+                        sp->mediaPositionChanged(payload.position);
+                    }
+                } catch (std::exception& ex) {
+                    AACE_ERROR(LX(TAG, "MediaPositionChangedMessage").d("reason", ex.what()));
+                }
+            });
+
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -173,16 +204,33 @@ bool AASBAudioOutput::prepare(std::shared_ptr<aace::audio::AudioStream> stream,
         auto m_streamManager_lock = m_streamManager.lock();
         ThrowIfNull(m_streamManager_lock, "invalidstreamManagerReference");
 
-        // generate a unique stream id
-        auto streamId = aace::engine::utils::uuid::generateUUID();
+        std::string streamId;
+
+        if (m_pooledStreams && m_pooledHandler != nullptr) {
+            // reuse the registered stream handler and its stream id
+            m_pooledHandler->setStream(stream);
+            streamId = m_pooledStreamId;
+            m_handler = m_pooledHandler;
+        } else {
+            // generate a unique stream id
+            streamId = aace::engine::utils::uuid::generateUUID();
+
+            // create the stream handler, which is kept registered in pooled mode
+            auto handler = std::make_shared<AudioOutputStreamHandler>(stream);
+            ThrowIfNot(
+                m_streamManager_lock->registerStreamHandler(streamId, handler, m_pooledStreams),
+                "registerStreamHandlerFailed");
+
+            if (m_pooledStreams) {
+                m_pooledHandler = handler;
+                m_pooledStreamId = streamId;
+            }
+            m_handler = handler;
+        }
 
         // generate a unique token id
         m_currentToken = aace::engine::utils::uuid::generateUUID();
 
-        // create the stream handler
-        m_handler = std::make_shared<AudioOutputStreamHandler>(stream);
-        ThrowIfNot(m_streamManager_lock->registerStreamHandler(streamId, m_handler), "registerStreamHandlerFailed");
-
         aasb::message::audio::audioOutput::PrepareStreamMessage message;
         message.payload.channel = m_name;
         message.payload.audioType = static_cast<aasb::message::audio::audioOutput::AudioOutputAudioType>(m_type);
@@ -514,9 +562,20 @@ AASBAudioOutput::AudioOutputStreamHandler::AudioOutputStreamHandler(std::shared_
         m_stream(stream) {
 }
 
+void AASBAudioOutput::AudioOutputStreamHandler::setStream(std::shared_ptr<aace::audio::AudioStream> stream) {
+    std::atomic_store(&m_stream, stream);
+}
+
 // aace::core::MessageStream
 ssize_t AASBAudioOutput::AudioOutputStreamHandler::read(char* data, const size_t size) {
-    return m_stream->read(data, size);
+    return std::atomic_load(&m_stream)->read(data, size);
+}
+
+ssize_t AASBAudioOutput::AudioOutputStreamHandler::timedRead(
+    char* data,
+    const size_t size,
+    std::chrono::milliseconds timeout) {
+    return std::atomic_load(&m_stream)->timedRead(data, size, timeout);
 }
 
 ssize_t AASBAudioOutput::AudioOutputStreamHandler::write(const char* data, const size_t size) {
@@ -525,7 +584,7 @@ ssize_t AASBAudioOutput::AudioOutputStreamHandler::write(const char* data, const
 }
 
 bool AASBAudioOutput::AudioOutputStreamHandler::isClosed() {
-    return m_stream->isClosed();
+    return std::atomic_load(&m_stream)->isClosed();
 }
 
 aace::core::MessageStream::Mode AASBAudioOutput::AudioOutputStreamHandler::getMode() {
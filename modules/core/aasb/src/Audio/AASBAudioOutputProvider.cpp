@@ -25,14 +25,16 @@ static const std::string TAG("aasb.audio.AASBAudioOutputProvider");
 
 std::shared_ptr<AASBAudioOutputProvider> AASBAudioOutputProvider::create(
     std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager) {
+    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+    bool pooledStreams) {
     try {
         ThrowIfNull(messageBroker, "invalidMessageBroker");
         ThrowIfNull(streamManager, "invalidstreamManager");
 
         auto audioOutputProvider = std::shared_ptr<AASBAudioOutputProvider>(new AASBAudioOutputProvider());
         ThrowIfNot(
-            audioOutputProvider->initialize(messageBroker, streamManager), "initializeAudioOutputProviderFailed");
+            audioOutputProvider->initialize(messageBroker, streamManager, pooledStreams),
+            "initializeAudioOutputProviderFailed");
 
         return audioOutputProvider;
     } catch (std::exception& ex) {
@@ -43,10 +45,12 @@ std::shared_ptr<AASBAudioOutputProvider> AASBAudioOutputProvider::create(
 
 bool AASBAudioOutputProvider::initialize(
     std::shared_ptr<aace::engine::messageBroker::MessageBrokerInterface> messageBroker,
-    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager) {
+    std::shared_ptr<aace::engine::messageBroker::StreamManagerInterface> streamManager,
+    bool pooledStreams) {
     try {
         m_messageBroker = messageBroker;
         m_streamManager = streamManager;
+        m_pooledStreams = pooledStreams;
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -68,7 +72,8 @@ std::shared_ptr<aace::audio::AudioOutput> AASBAudioOutputProvider::openChannel(
         auto m_streamManager_lock = m_streamManager.lock();
         ThrowIfNull(m_streamManager_lock, "invalidstreamManagerReference");
 
-        auto audioOutput = AASBAudioOutput::create(name, type, m_messageBroker_lock, m_streamManager_lock);
+        auto audioOutput =
+            AASBAudioOutput::create(name, type, m_messageBroker_lock, m_streamManager_lock, m_pooledStreams);
         ThrowIfNull(audioOutput, "createAudioOutputFailed");
 
         return audioOutput;
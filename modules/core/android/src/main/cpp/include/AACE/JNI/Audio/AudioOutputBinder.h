@@ -29,7 +29,11 @@ namespace audio {
 
 class AudioOutputHandler : public aace::audio::AudioOutput {
 public:
-    AudioOutputHandler(jobject obj);
+    /**
+     * @param stateBuffer The direct buffer the Java audio output publishes its playback state to, which the polled
+     * methods read instead of calling Java once it is published.
+     */
+    AudioOutputHandler(jobject obj, jobject stateBuffer);
 
     // aace::audio::AudioOutput
     bool prepare(std::shared_ptr<aace::audio::AudioStream> stream, bool repeating) override;
@@ -49,7 +53,19 @@ public:
     bool mutedStateChanged(MutedState state) override;
 
 private:
+    /// Reads a value of the published playback state, or returns @c false if the state was not published.
+    bool readPlaybackState(size_t offset, int64_t& value);
+
     JObject m_obj;
+
+    // the playback state, kept alive by the global reference of its buffer
+    JObject m_stateBuffer;
+    const char* m_state = nullptr;
+
+    // the methods polled by the Engine while the audio plays, resolved once
+    JMethod m_getPositionMethod;
+    JMethod m_getDurationMethod;
+    JMethod m_getNumBytesBufferedMethod;
 };
 
 //
@@ -58,7 +74,7 @@ private:
 
 class AudioOutputBinder {
 public:
-    AudioOutputBinder(jobject obj);
+    AudioOutputBinder(jobject obj, jobject stateBuffer);
 
     std::shared_ptr<AudioOutputHandler> getAudioOutputHandler() {
         return m_audioOutputHandler;
@@ -35,6 +35,25 @@ private:
     std::shared_ptr<aace::core::Engine> m_engine;
 };
 
+//
+// JMemoryPressureLevel
+//
+
+class JMemoryPressureLevelConfig : public EnumConfiguration<aace::core::Engine::MemoryPressureLevel> {
+public:
+    using T = aace::core::Engine::MemoryPressureLevel;
+
+    const char* getClassName() override {
+        return "com/amazon/aace/core/Engine$MemoryPressureLevel";
+    }
+
+    std::vector<std::pair<T, std::string>> getConfiguration() override {
+        return {{T::NORMAL, "NORMAL"}, {T::MODERATE, "MODERATE"}, {T::LOW, "LOW"}, {T::CRITICAL, "CRITICAL"}};
+    }
+};
+
+using JMemoryPressureLevel = JEnum<aace::core::Engine::MemoryPressureLevel, JMemoryPressureLevelConfig>;
+
 }  // namespace core
 }  // namespace jni
 }  // namespace aace
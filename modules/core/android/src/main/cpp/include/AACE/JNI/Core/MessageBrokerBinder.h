@@ -16,7 +16,9 @@
 #ifndef AACE_JNI_CORE_MESSAGE_BROKER_BINDER_H
 #define AACE_JNI_CORE_MESSAGE_BROKER_BINDER_H
 
+#include <chrono>
 #include <memory>
+#include <vector>
 #include <AACE/Core/MessageBroker.h>
 #include "NativeLib.h"
 
@@ -27,6 +29,7 @@ namespace core {
 class MessageBrokerBinder {
 public:
     MessageBrokerBinder(std::shared_ptr<aace::core::MessageBroker> messageBroker);
+    ~MessageBrokerBinder();
 
     std::shared_ptr<aace::core::MessageBroker> getMessageBroker() {
         return m_messageBroker.lock();
@@ -34,12 +37,28 @@ public:
 
     void subscribe(jobject handler, const std::string& topic, const std::string& action);
 
+    /**
+     * Subscribes a batch handler to the messages of a topic and action. The messages are accumulated for up to
+     * @c maxBatchDelay, or until the batch reaches @c maxBatchSize bytes, and cross the JNI boundary together as one
+     * direct buffer, where each message is its length as a 32 bit little endian integer followed by its UTF-8 bytes.
+     */
+    void subscribe(
+        jobject batchHandler,
+        const std::string& topic,
+        const std::string& action,
+        std::chrono::milliseconds maxBatchDelay,
+        size_t maxBatchSize);
+
 private:
-    void invokeCallbackMethod(std::shared_ptr<JObject> handler, const std::string& message);
+    /// Accumulates the messages of a batched subscription, and delivers them from its own thread
+    class MessageBatch;
+
+    void invokeCallbackMethod(std::shared_ptr<JObject> handler, JMethod method, const std::string& message);
 
 private:
     std::weak_ptr<aace::core::MessageBroker> m_messageBroker;
     std::vector<std::shared_ptr<JObject>> m_subscriptionHandlers;
+    std::vector<std::shared_ptr<MessageBatch>> m_messageBatches;
 };
 
 }  // namespace core
@@ -27,6 +27,7 @@
 #include <AACE/JNI/Native/JavaField.h>
 #include <AACE/JNI/Native/JavaEnum.h>
 #include <AACE/JNI/Native/JavaArray.h>
+#include <AACE/JNI/Native/JavaByteBuffer.h>
 #include <AACE/JNI/Native/NativeMacros.h>
 
 using ThreadContext = aace::jni::native::ThreadContext;
@@ -44,6 +45,7 @@ using JObjectArray = aace::jni::native::JavaObjectArray;
 using JByteArray = aace::jni::native::JavaArray<jbyteArray, jbyte>;
 using JLongArray = aace::jni::native::JavaArray<jlongArray, jlong>;
 using JIntArray = aace::jni::native::JavaArray<jintArray, jint>;
+using JByteBuffer = aace::jni::native::JavaByteBuffer;
 
 template <class T, class C>
 using JEnum = aace::jni::native::JavaEnum<T, C>;
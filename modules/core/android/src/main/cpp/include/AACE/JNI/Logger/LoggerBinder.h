@@ -20,6 +20,7 @@
 #include <AACE/JNI/Core/PlatformInterfaceBinder.h>
 
 #include <chrono>
+#include <vector>
 
 namespace aace {
 namespace jni {
@@ -39,6 +40,7 @@ public:
         std::chrono::system_clock::time_point time,
         const std::string& source,
         const std::string& message) override;
+    bool logEvents(const std::vector<LogEvent>& events) override;
 
 private:
     JObject m_obj;
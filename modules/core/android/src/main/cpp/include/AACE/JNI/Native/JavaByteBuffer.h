@@ -0,0 +1,56 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_JNI_NATIVE_JAVA_BYTE_BUFFER_H
+#define AACE_JNI_NATIVE_JAVA_BYTE_BUFFER_H
+
+#include <jni.h>
+
+namespace aace {
+namespace jni {
+namespace native {
+
+/**
+ * Gives access to the memory of a direct @c java.nio.ByteBuffer, without copying it.
+ *
+ * Unlike the other wrappers, a JavaByteBuffer only keeps the local reference of the buffer, and uses the
+ * environment of the native method it is created in, so it adds no JNI calls beyond resolving the buffer address.
+ */
+class JavaByteBuffer {
+public:
+    JavaByteBuffer(JNIEnv* env, jobject buffer);
+
+    /// Whether the buffer is a direct buffer
+    bool isValid();
+
+    /// The capacity of the buffer, in bytes
+    jlong capacity();
+
+    /**
+     * Returns the memory of the buffer at @c offset, or @c nullptr if the buffer is not a direct buffer or
+     * @c size bytes at @c offset are out of its range.
+     */
+    char* ptr(jlong offset, jlong size);
+
+private:
+    char* m_address;
+    jlong m_capacity;
+};
+
+}  // namespace native
+}  // namespace jni
+}  // namespace aace
+
+#endif  // AACE_JNI_NATIVE_JAVA_BYTE_BUFFER_H
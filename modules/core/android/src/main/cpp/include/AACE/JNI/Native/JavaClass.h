@@ -62,6 +62,9 @@ private:
     std::unordered_map<std::string, JavaMethodPtr> m_methodMap;
     std::unordered_map<std::string, JavaFieldPtr> m_fieldMap;
 
+    // the classes are shared by the threads calling into Java, so their method and field maps are locked
+    std::mutex m_memberMutex;
+
     // global class registry
     static std::unordered_map<std::string, std::shared_ptr<JavaClass>> s_javaClassRegistry;
     static GlobalRef<jobject> s_classLoaderObjectRef;
@@ -39,6 +39,16 @@ public:
     std::string toStdStr();
     const char* toCStr();
 
+    /**
+     * Creates a local reference to a Java byte array of the UTF-8 bytes of a string, which the caller deletes. Unlike
+     * a Java string, the bytes are copied once, without a global reference or the modified UTF-8 conversion, so it
+     * suits large messages decoded by Java with @c StandardCharsets.UTF_8.
+     */
+    static jbyteArray newUtf8Bytes(JNIEnv* env, const std::string& str);
+
+    /// Returns the string of the UTF-8 bytes of a Java byte array, copied once.
+    static std::string fromUtf8Bytes(JNIEnv* env, jbyteArray bytes);
+
 private:
     GlobalRef<jstring> m_ref;
     const char* m_cstr;
@@ -22,6 +22,10 @@ namespace aace {
 namespace jni {
 namespace native {
 
+/**
+ * Gives the JNI environment of the calling thread. A thread that isn't attached to the Java VM, such as an Engine
+ * thread calling a platform interface, is attached by its first ThreadContext and stays attached until it exits.
+ */
 class ThreadContext {
 public:
     ThreadContext();
@@ -33,7 +37,6 @@ public:
 
 private:
     JNIEnv* m_env;
-    bool m_detatch;
 };
 
 }  // namespace native
@@ -104,4 +104,28 @@ JNIEXPORT jlong JNICALL Java_com_amazon_aace_audio_AudioInput_write(
         return 0;
     }
 }
+
+JNIEXPORT jlong JNICALL Java_com_amazon_aace_audio_AudioInput_writeBuffer(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong ref,
+    jobject buffer,
+    jlong offset,
+    jlong size) {
+    try {
+        auto audioInputBinder = AUDIO_INPUT_BINDER(ref);
+        ThrowIfNull(audioInputBinder, "invalidAudioInputBinder");
+
+        // the samples are written from the memory of the direct buffer, without a copy
+        auto data = JByteBuffer(env, buffer).ptr(offset, size);
+        ThrowIfNull(data, "invalidBuffer");
+
+        jint count = audioInputBinder->getAudioInputHandler()->write(reinterpret_cast<int16_t*>(data), size / 2);
+
+        return count * 2;
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "Java_com_amazon_aace_audio_AudioInput_writeBuffer", ex.what());
+        return 0;
+    }
+}
 }
@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <cstdint>
+
 #include <AACE/JNI/Audio/AudioOutputBinder.h>
 #include <AACE/JNI/Audio/AudioStreamBinder.h>
 #include <AACE/JNI/Core/NativeLib.h>
@@ -20,6 +22,16 @@
 // String to identify log entries originating from this file.
 static const char TAG[] = "aace.jni.audio.AudioOutputBinder";
 
+// The playback state published by the Java audio output, as native-order 64-bit values
+static const size_t STATE_SEQUENCE = 0;
+static const size_t STATE_POSITION = 8;
+static const size_t STATE_DURATION = 16;
+static const size_t STATE_NUM_BYTES_BUFFERED = 24;
+static const size_t STATE_SIZE = 32;
+
+// The reads of a state that is being written before the methods are called instead
+static const int STATE_READ_ATTEMPTS = 4;
+
 namespace aace {
 namespace jni {
 namespace audio {
@@ -28,15 +40,38 @@ namespace audio {
 // AudioOutputBinder
 //
 
-AudioOutputBinder::AudioOutputBinder(jobject obj) {
-    m_audioOutputHandler = std::make_shared<AudioOutputHandler>(obj);
+AudioOutputBinder::AudioOutputBinder(jobject obj, jobject stateBuffer) {
+    m_audioOutputHandler = std::make_shared<AudioOutputHandler>(obj, stateBuffer);
 }
 
 //
 // AudioOutputHandler
 //
 
-AudioOutputHandler::AudioOutputHandler(jobject obj) : m_obj(obj, "com/amazon/aace/audio/AudioOutput") {
+AudioOutputHandler::AudioOutputHandler(jobject obj, jobject stateBuffer) :
+        m_obj(obj, "com/amazon/aace/audio/AudioOutput") {
+    try_with_context {
+        // without the state, the polled methods are called
+        if (stateBuffer != nullptr) {
+            auto state = JByteBuffer(env, stateBuffer).ptr(0, STATE_SIZE);
+            if (state != nullptr && reinterpret_cast<uintptr_t>(state) % sizeof(int64_t) == 0) {
+                m_stateBuffer = JObject(stateBuffer, "java/nio/ByteBuffer");
+                m_state = state;
+            } else {
+                AACE_JNI_ERROR(TAG, "AudioOutputHandler", "invalidStateBuffer");
+            }
+        }
+
+        m_getPositionMethod = m_obj.getMethod("getPosition", "()J");
+        ThrowIfNull(m_getPositionMethod, "invalidGetPositionMethod");
+        m_getDurationMethod = m_obj.getMethod("getDuration", "()J");
+        ThrowIfNull(m_getDurationMethod, "invalidGetDurationMethod");
+        m_getNumBytesBufferedMethod = m_obj.getMethod("getNumBytesBuffered", "()J");
+        ThrowIfNull(m_getNumBytesBufferedMethod, "invalidGetNumBytesBufferedMethod");
+    }
+    catch_with_ex {
+        AACE_JNI_ERROR(TAG, "AudioOutputHandler", ex.what());
+    }
 }
 
 bool AudioOutputHandler::prepare(std::shared_ptr<aace::audio::AudioStream> stream, bool repeating) {
@@ -158,10 +193,38 @@ bool AudioOutputHandler::stopDucking() {
     }
 }
 
+bool AudioOutputHandler::readPlaybackState(size_t offset, int64_t& value) {
+    if (m_state == nullptr) {
+        return false;
+    }
+    auto sequence = reinterpret_cast<const int64_t*>(m_state + STATE_SEQUENCE);
+    for (int attempt = 0; attempt < STATE_READ_ATTEMPTS; attempt++) {
+        // a sequence of 0 was never published, and an odd sequence is being written
+        auto before = __atomic_load_n(sequence, __ATOMIC_ACQUIRE);
+        if (before == 0) {
+            return false;
+        }
+        if (before % 2 != 0) {
+            continue;
+        }
+        value = __atomic_load_n(reinterpret_cast<const int64_t*>(m_state + offset), __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(sequence, __ATOMIC_RELAXED) == before) {
+            return true;
+        }
+    }
+    return false;
+}
+
 int64_t AudioOutputHandler::getPosition() {
+    int64_t position;
+    if (readPlaybackState(STATE_POSITION, position)) {
+        return position;
+    }
     try_with_context {
+        ThrowIfNull(m_getPositionMethod, "invalidGetPositionMethod");
         jlong result;
-        ThrowIfNot(m_obj.invoke("getPosition", "()J", &result), "invokeMethodFailed");
+        ThrowIfNot(m_obj.invoke(m_getPositionMethod, &result), "invokeMethodFailed");
         return result;
     }
     catch_with_ex {
@@ -183,9 +246,14 @@ bool AudioOutputHandler::setPosition(int64_t position) {
 }
 
 int64_t AudioOutputHandler::getDuration() {
+    int64_t duration;
+    if (readPlaybackState(STATE_DURATION, duration)) {
+        return duration;
+    }
     try_with_context {
+        ThrowIfNull(m_getDurationMethod, "invalidGetDurationMethod");
         jlong result;
-        ThrowIfNot(m_obj.invoke("getDuration", "()J", &result), "invokeMethodFailed");
+        ThrowIfNot(m_obj.invoke(m_getDurationMethod, &result), "invokeMethodFailed");
         return result;
     }
     catch_with_ex {
@@ -195,9 +263,14 @@ int64_t AudioOutputHandler::getDuration() {
 }
 
 int64_t AudioOutputHandler::getNumBytesBuffered() {
+    int64_t numBytesBuffered;
+    if (readPlaybackState(STATE_NUM_BYTES_BUFFERED, numBytesBuffered)) {
+        return numBytesBuffered;
+    }
     try_with_context {
+        ThrowIfNull(m_getNumBytesBufferedMethod, "invalidGetNumBytesBufferedMethod");
         jlong result;
-        ThrowIfNot(m_obj.invoke("getNumBytesBuffered", "()J", &result), "invokeMethodFailed");
+        ThrowIfNot(m_obj.invoke(m_getNumBytesBufferedMethod, &result), "invokeMethodFailed");
         return result;
     }
     catch_with_ex {
@@ -243,8 +316,9 @@ bool AudioOutputHandler::mutedStateChanged(MutedState state) {
 #define AUDIO_OUTPUT_BINDER(ref) reinterpret_cast<aace::jni::audio::AudioOutputBinder*>(ref)
 
 extern "C" {
-JNIEXPORT jlong JNICALL Java_com_amazon_aace_audio_AudioOutput_createBinder(JNIEnv* env, jobject obj) {
-    return reinterpret_cast<long>(new aace::jni::audio::AudioOutputBinder(obj));
+JNIEXPORT jlong JNICALL
+Java_com_amazon_aace_audio_AudioOutput_createBinder(JNIEnv* env, jobject obj, jobject stateBuffer) {
+    return reinterpret_cast<long>(new aace::jni::audio::AudioOutputBinder(obj, stateBuffer));
 }
 
 JNIEXPORT void JNICALL
@@ -78,6 +78,28 @@ JNIEXPORT jint JNICALL Java_com_amazon_aace_audio_AudioStream_read(
     }
 }
 
+JNIEXPORT jint JNICALL Java_com_amazon_aace_audio_AudioStream_readBuffer(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong ref,
+    jobject buffer,
+    jlong offset,
+    jlong size) {
+    try {
+        auto audioStreamBinder = AUDIO_STREAM_BINDER(ref);
+        ThrowIfNull(audioStreamBinder, "invalidAudioStreamBinder");
+
+        // the audio is read into the memory of the direct buffer, without a copy
+        auto data = JByteBuffer(env, buffer).ptr(offset, size);
+        ThrowIfNull(data, "invalidBuffer");
+
+        return static_cast<jint>(audioStreamBinder->getAudioStream()->read(data, size));
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "Java_com_amazon_aace_audio_AudioStream_readBuffer", ex.what());
+        return 0;
+    }
+}
+
 JNIEXPORT jobject JNICALL
 Java_com_amazon_aace_audio_AudioStream_getEncoding(JNIEnv* env, jobject /* this */, jlong ref) {
     try {
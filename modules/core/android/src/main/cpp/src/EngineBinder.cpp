@@ -119,6 +119,54 @@ JNIEXPORT jboolean JNICALL Java_com_amazon_aace_core_Engine_stop(JNIEnv* env, jo
     }
 }
 
+JNIEXPORT jboolean JNICALL Java_com_amazon_aace_core_Engine_suspend(JNIEnv* env, jobject /* this */, jlong ref) {
+    try {
+        auto engineBinder = ENGINE_BINDER(ref);
+        ThrowIfNull(engineBinder, "invalidEngineBinder");
+
+        ThrowIfNot(engineBinder->getEngine()->suspend(), "engineSuspendFailed");
+
+        return true;
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "Java_com_amazon_aace_core_Engine_suspend", ex.what());
+        return false;
+    }
+}
+
+JNIEXPORT jboolean JNICALL Java_com_amazon_aace_core_Engine_resume(JNIEnv* env, jobject /* this */, jlong ref) {
+    try {
+        auto engineBinder = ENGINE_BINDER(ref);
+        ThrowIfNull(engineBinder, "invalidEngineBinder");
+
+        ThrowIfNot(engineBinder->getEngine()->resume(), "engineResumeFailed");
+
+        return true;
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "Java_com_amazon_aace_core_Engine_resume", ex.what());
+        return false;
+    }
+}
+
+JNIEXPORT jboolean JNICALL Java_com_amazon_aace_core_Engine_reportMemoryPressure(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong ref,
+    jobject level) {
+    try {
+        auto engineBinder = ENGINE_BINDER(ref);
+        ThrowIfNull(engineBinder, "invalidEngineBinder");
+
+        aace::core::Engine::MemoryPressureLevel levelType;
+        ThrowIfNot(aace::jni::core::JMemoryPressureLevel::checkType(level, &levelType), "invalidMemoryPressureLevel");
+        ThrowIfNot(engineBinder->getEngine()->reportMemoryPressure(levelType), "reportMemoryPressureFailed");
+
+        return true;
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "Java_com_amazon_aace_core_Engine_reportMemoryPressure", ex.what());
+        return false;
+    }
+}
+
 JNIEXPORT jboolean JNICALL Java_com_amazon_aace_core_Engine_registerPlatformInterface(
     JNIEnv* env,
     jobject /* this */,
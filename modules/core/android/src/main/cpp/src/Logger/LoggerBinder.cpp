@@ -73,6 +73,76 @@ bool LoggerHandler::logEvent(
     }
 }
 
+bool LoggerHandler::logEvents(const std::vector<LogEvent>& events) {
+    try_with_context {
+        // the batch is delivered with a single call into the Java logger
+        auto size = static_cast<jsize>(events.size());
+        JObjectArray levels(size, "com/amazon/aace/logger/Logger$Level");
+        JLongArray times(size);
+        std::vector<jlong> timeValues(events.size());
+
+        // the system classes are not found with the application class loader
+        jclass stringClass = env->FindClass("java/lang/String");
+        ThrowIfJavaEx(env, "findStringClassFailed");
+        jobjectArray sourcesArr = env->NewObjectArray(size, stringClass, nullptr);
+        env->DeleteLocalRef(stringClass);
+        ThrowIfJavaEx(env, "newStringArrayFailed");
+        JObjectArray sources(sourcesArr);
+        env->DeleteLocalRef(sourcesArr);
+
+        jclass byteArrayClass = env->FindClass("[B");
+        ThrowIfJavaEx(env, "findByteArrayClassFailed");
+        jobjectArray messagesArr = env->NewObjectArray(size, byteArrayClass, nullptr);
+        env->DeleteLocalRef(byteArrayClass);
+        ThrowIfJavaEx(env, "newByteArrayArrayFailed");
+        JObjectArray messages(messagesArr);
+        env->DeleteLocalRef(messagesArr);
+
+        for (jsize j = 0; j < size; j++) {
+            const auto& event = events[j];
+            jobject levelObj;
+            ThrowIfNot(JLogLevel::checkType(event.level, &levelObj), "invalidLogLevelType");
+            ThrowIfNot(levels.setAt(j, levelObj), "setLevelFailed");
+
+            auto time = std::chrono::duration_cast<std::chrono::milliseconds>(event.time.time_since_epoch());
+            timeValues[j] = static_cast<jlong>(time.count());
+
+            jstring jsource = JString(event.source).get();
+            ThrowIfNot(sources.setAt(j, jsource), "setSourceFailed");
+            env->DeleteLocalRef(jsource);
+
+            JByteArray arr(event.message.size());
+            if (!event.message.empty()) {
+                ThrowIfNot(
+                    arr.copyTo(0, event.message.size(), (jbyte*)event.message.c_str()), "copyToArrayFailed");
+            }
+            ThrowIfNot(messages.setAt(j, arr.get()), "setMessageFailed");
+        }
+        if (size > 0) {
+            env->SetLongArrayRegion(times.get(), 0, size, timeValues.data());
+            ThrowIfJavaEx(env, "setTimesFailed");
+        }
+
+        jboolean jresult;
+        ThrowIfNot(
+            m_obj.invoke(
+                "logEvents",
+                "([Lcom/amazon/aace/logger/Logger$Level;[J[Ljava/lang/String;[[B)Z",
+                &jresult,
+                levels.get(),
+                times.get(),
+                sources.get(),
+                messages.get()),
+            "invokeFailed");
+
+        return static_cast<bool>(jresult);
+    }
+    catch_with_ex {
+        AACE_JNI_ERROR(TAG, "logEvents", ex.what());
+        return false;
+    }
+}
+
 }  // namespace logger
 }  // namespace jni
 }  // namespace aace
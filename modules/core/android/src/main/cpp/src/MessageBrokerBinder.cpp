@@ -13,6 +13,10 @@
  * permissions and limitations under the License.
  */
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <AACE/JNI/Core/MessageBrokerBinder.h>
 #include <AACE/JNI/Core/MessageStreamBinder.h>
 
@@ -23,20 +27,142 @@ namespace aace {
 namespace jni {
 namespace core {
 
+//
+// MessageBatch
+//
+
+class MessageBrokerBinder::MessageBatch {
+public:
+    MessageBatch(
+        std::shared_ptr<JObject> handler,
+        JMethod method,
+        std::chrono::milliseconds maxBatchDelay,
+        size_t maxBatchSize) :
+            m_handler(handler),
+            m_method(method),
+            m_maxBatchDelay(maxBatchDelay),
+            m_maxBatchSize(maxBatchSize),
+            m_stopped(false) {
+        m_thread = std::thread(&MessageBatch::run, this);
+    }
+
+    ~MessageBatch() {
+        stop();
+    }
+
+    void add(const std::string& message) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopped) {
+            return;
+        }
+        bool first = m_batch.empty();
+        if (first) {
+            m_deadline = std::chrono::steady_clock::now() + m_maxBatchDelay;
+        }
+
+        // frame the message with its length, little endian whatever the host
+        uint32_t size = static_cast<uint32_t>(message.size());
+        for (int shift = 0; shift < 32; shift += 8) {
+            m_batch.push_back(static_cast<char>((size >> shift) & 0xff));
+        }
+        m_batch.append(message);
+
+        if (first || m_batch.size() >= m_maxBatchSize) {
+            m_trigger.notify_one();
+        }
+    }
+
+    // delivers the pending messages, and stops the delivery thread
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_trigger.notify_one();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_trigger.wait(lock, [this] { return m_stopped || !m_batch.empty(); });
+            if (m_batch.empty()) {
+                break;
+            }
+            m_trigger.wait_until(
+                lock, m_deadline, [this] { return m_stopped || m_batch.size() >= m_maxBatchSize; });
+
+            // the delivered buffer becomes the next batch, so the batches reuse their allocations
+            m_delivering.clear();
+            m_delivering.swap(m_batch);
+            lock.unlock();
+            deliver();
+            lock.lock();
+        }
+    }
+
+    void deliver() {
+        try_with_context {
+            // the buffer wraps the batch without a copy, and is only valid during the call
+            jobject buffer = env->NewDirectByteBuffer(&m_delivering[0], static_cast<jlong>(m_delivering.size()));
+            ThrowIfNull(buffer, "createBatchBufferFailed");
+            bool delivered = m_handler->invoke<void>(m_method, nullptr, buffer);
+            env->DeleteLocalRef(buffer);
+            ThrowIfNot(delivered, "invokeMethodFailed");
+        }
+        catch_with_ex {
+            AACE_JNI_ERROR(TAG, "deliver", ex.what());
+        }
+    }
+
+    std::shared_ptr<JObject> m_handler;
+    JMethod m_method;
+    const std::chrono::milliseconds m_maxBatchDelay;
+    const size_t m_maxBatchSize;
+
+    std::mutex m_mutex;
+    std::condition_variable m_trigger;
+    std::string m_batch;
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_stopped;
+
+    // only used by the delivery thread
+    std::string m_delivering;
+    std::thread m_thread;
+};
+
+//
+// MessageBrokerBinder
+//
+
 MessageBrokerBinder::MessageBrokerBinder(std::shared_ptr<aace::core::MessageBroker> messageBroker) :
         m_messageBroker(messageBroker) {
 }
 
+MessageBrokerBinder::~MessageBrokerBinder() {
+    for (auto& messageBatch : m_messageBatches) {
+        messageBatch->stop();
+    }
+}
+
 void MessageBrokerBinder::subscribe(jobject handler, const std::string& topic, const std::string& action) {
     try_with_context {
         // create a JObject ptr to manage the callback interface reference
         auto handler_ptr =
-            std::shared_ptr<JObject>(new JObject(handler, "com/amazon/aace/core/MessageBroker$MessageHandler"));
+            std::shared_ptr<JObject>(new JObject(handler, "com/amazon/aace/core/MessageBroker$Utf8Handler"));
+        // resolve the callback method once, rather than on every message
+        auto method = handler_ptr->getMethod("messageReceived", "([B)V");
+        ThrowIfNull(method, "invalidMessageReceivedMethod");
         // add the handler to a subscription handler list so we can manager the reference
         m_subscriptionHandlers.push_back(handler_ptr);
 
         getMessageBroker()->subscribe(
-            [this, handler_ptr](const std::string& message) { invokeCallbackMethod(handler_ptr, message); },
+            [this, handler_ptr, method](const std::string& message) {
+                invokeCallbackMethod(handler_ptr, method, message);
+            },
             topic,
             action);
     }
@@ -45,9 +171,41 @@ void MessageBrokerBinder::subscribe(jobject handler, const std::string& topic, c
     }
 }
 
-void MessageBrokerBinder::invokeCallbackMethod(std::shared_ptr<JObject> handler, const std::string& message) {
+void MessageBrokerBinder::subscribe(
+    jobject batchHandler,
+    const std::string& topic,
+    const std::string& action,
+    std::chrono::milliseconds maxBatchDelay,
+    size_t maxBatchSize) {
+    try_with_context {
+        auto handler_ptr =
+            std::shared_ptr<JObject>(new JObject(batchHandler, "com/amazon/aace/core/MessageBroker$BatchHandler"));
+        auto method = handler_ptr->getMethod("messagesReceived", "(Ljava/nio/ByteBuffer;)V");
+        ThrowIfNull(method, "invalidMessagesReceivedMethod");
+
+        auto messageBatch = std::make_shared<MessageBatch>(handler_ptr, method, maxBatchDelay, maxBatchSize);
+        m_messageBatches.push_back(messageBatch);
+
+        // the broker keeps the batch alive, and a batch stopped with the binder drops the late messages
+        getMessageBroker()->subscribe(
+            [messageBatch](const std::string& message) { messageBatch->add(message); }, topic, action);
+    }
+    catch_with_ex {
+        AACE_JNI_ERROR(TAG, "subscribe", ex.what());
+    }
+}
+
+void MessageBrokerBinder::invokeCallbackMethod(
+    std::shared_ptr<JObject> handler,
+    JMethod method,
+    const std::string& message) {
     try_with_context {
-        handler->invoke<void>("messageReceived", "(Ljava/lang/String;)V", nullptr, JString(message).get());
+        // the message is passed as its UTF-8 bytes, which Java decodes
+        jbyteArray bytes = JString::newUtf8Bytes(env, message);
+        ThrowIfNull(bytes, "createMessageBytesFailed");
+        bool delivered = handler->invoke<void>(method, nullptr, bytes);
+        env->DeleteLocalRef(bytes);
+        ThrowIfNot(delivered, "invokeMethodFailed");
     }
     catch_with_ex {
         AACE_JNI_ERROR(TAG, "invokeCallbackMethod", ex.what());
@@ -88,8 +246,33 @@ JNIEXPORT void JNICALL Java_com_amazon_aace_core_MessageBroker_subscribe(
     }
 }
 
+JNIEXPORT void JNICALL Java_com_amazon_aace_core_MessageBroker_subscribeBatched(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong ref,
+    jobject batchHandler,
+    jstring topic,
+    jstring action,
+    jint maxBatchDelayMs,
+    jint maxBatchSize) {
+    try {
+        auto messageBrokerBinder = MESSAGE_BROKER_BINDER(ref);
+        ThrowIfNull(messageBrokerBinder, "invalidMessageBrokerBinder");
+        ThrowIf(maxBatchDelayMs < 0, "invalidMaxBatchDelay");
+        ThrowIf(maxBatchSize < 0, "invalidMaxBatchSize");
+        messageBrokerBinder->subscribe(
+            batchHandler,
+            JString(topic).toStdStr(),
+            JString(action).toStdStr(),
+            std::chrono::milliseconds(maxBatchDelayMs),
+            static_cast<size_t>(maxBatchSize));
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "Java_com_amazon_aace_core_MessageBroker_subscribeBatched", ex.what());
+    }
+}
+
 JNIEXPORT void JNICALL
-Java_com_amazon_aace_core_MessageBroker_publish(JNIEnv* env, jobject /* this */, jlong ref, jstring message) {
+Java_com_amazon_aace_core_MessageBroker_publish(JNIEnv* env, jobject /* this */, jlong ref, jbyteArray message) {
     try {
         auto messageBrokerBinder = MESSAGE_BROKER_BINDER(ref);
         ThrowIfNull(messageBrokerBinder, "invalidMessageBrokerBinder");
@@ -97,7 +280,7 @@ Java_com_amazon_aace_core_MessageBroker_publish(JNIEnv* env, jobject /* this */,
         auto messageBroker = messageBrokerBinder->getMessageBroker();
         ThrowIfNull(messageBroker, "invalidMessageBroker");
 
-        messageBroker->publish(JString(message).toStdStr());
+        messageBroker->publish(JString::fromUtf8Bytes(env, message));
     } catch (const std::exception& ex) {
         AACE_JNI_ERROR(TAG, "Java_com_amazon_aace_core_MessageBroker_publish", ex.what());
     }
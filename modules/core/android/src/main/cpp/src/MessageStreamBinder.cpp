@@ -99,6 +99,50 @@ JNIEXPORT jint JNICALL Java_com_amazon_aace_core_MessageStream_write(
     }
 }
 
+JNIEXPORT jint JNICALL Java_com_amazon_aace_core_MessageStream_readBuffer(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong ref,
+    jobject buffer,
+    jlong offset,
+    jlong size) {
+    try {
+        auto messageStreamBinder = Message_STREAM_BINDER(ref);
+        ThrowIfNull(messageStreamBinder, "invalidMessageStreamBinder");
+
+        // the data is read into the memory of the direct buffer, without a copy
+        auto data = JByteBuffer(env, buffer).ptr(offset, size);
+        ThrowIfNull(data, "invalidBuffer");
+
+        return static_cast<jint>(messageStreamBinder->getMessageStream()->read(data, size));
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "Java_com_amazon_aace_core_MessageStream_readBuffer", ex.what());
+        return 0;
+    }
+}
+
+JNIEXPORT jint JNICALL Java_com_amazon_aace_core_MessageStream_writeBuffer(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong ref,
+    jobject buffer,
+    jlong offset,
+    jlong size) {
+    try {
+        auto messageStreamBinder = Message_STREAM_BINDER(ref);
+        ThrowIfNull(messageStreamBinder, "invalidMessageStreamBinder");
+
+        // the data is written from the memory of the direct buffer, without a copy
+        auto data = JByteBuffer(env, buffer).ptr(offset, size);
+        ThrowIfNull(data, "invalidBuffer");
+
+        return static_cast<jint>(messageStreamBinder->getMessageStream()->write(data, size));
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "Java_com_amazon_aace_core_MessageStream_writeBuffer", ex.what());
+        return 0;
+    }
+}
+
 JNIEXPORT jobject JNICALL Java_com_amazon_aace_core_MessageStream_getMode(JNIEnv* env, jobject /* this */, jlong ref) {
     try {
         auto messageStreamBinder = Message_STREAM_BINDER(ref);
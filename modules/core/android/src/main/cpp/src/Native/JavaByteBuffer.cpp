@@ -0,0 +1,65 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/JNI/Native/JavaByteBuffer.h>
+#include <AACE/JNI/Native/NativeMacros.h>
+
+// String to identify log entries originating from this file.
+static const char TAG[] = "aace.jni.native.JavaByteBuffer";
+
+namespace aace {
+namespace jni {
+namespace native {
+
+JavaByteBuffer::JavaByteBuffer(JNIEnv* env, jobject buffer) : m_address(nullptr), m_capacity(0) {
+    try {
+        ThrowIfNull(env, "invalidJavaEnv");
+        ThrowIfNull(buffer, "invalidBuffer");
+
+        // both calls return null and -1 for a buffer that is not direct, without raising a Java exception
+        m_address = static_cast<char*>(env->GetDirectBufferAddress(buffer));
+        ThrowIfNull(m_address, "notDirectBuffer");
+        m_capacity = env->GetDirectBufferCapacity(buffer);
+        ThrowIf(m_capacity < 0, "invalidBufferCapacity");
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "JavaByteBuffer", ex.what());
+        m_address = nullptr;
+        m_capacity = 0;
+    }
+}
+
+bool JavaByteBuffer::isValid() {
+    return m_address != nullptr;
+}
+
+jlong JavaByteBuffer::capacity() {
+    return m_capacity;
+}
+
+char* JavaByteBuffer::ptr(jlong offset, jlong size) {
+    try {
+        ThrowIfNull(m_address, "invalidBuffer");
+        ThrowIf(offset < 0 || size < 0 || size > m_capacity - offset, "rangeOutOfBuffer");
+
+        return m_address + offset;
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "ptr", ex.what());
+        return nullptr;
+    }
+}
+
+}  // namespace native
+}  // namespace jni
+}  // namespace aace
@@ -106,6 +106,7 @@ std::shared_ptr<JavaClass> JavaClass::find(const char* name) {
 
 JavaMethodPtr JavaClass::getStaticMethod(const char* name, const char* signature) {
     try_with_context {
+        std::lock_guard<std::mutex> lock(m_memberMutex);
         std::string key = "static_" + std::string(name) + signature;
         auto it = m_methodMap.find(key);
 
@@ -130,6 +131,7 @@ JavaMethodPtr JavaClass::getStaticMethod(const char* name, const char* signature
 
 JavaMethodPtr JavaClass::getMethod(const char* name, const char* signature) {
     try_with_context {
+        std::lock_guard<std::mutex> lock(m_memberMutex);
         std::string key = std::string(name) + signature;
         auto it = m_methodMap.find(key);
 
@@ -154,6 +156,7 @@ JavaMethodPtr JavaClass::getMethod(const char* name, const char* signature) {
 
 JavaFieldPtr JavaClass::getStaticField(const char* name, const char* signature) {
     try_with_context {
+        std::lock_guard<std::mutex> lock(m_memberMutex);
         std::string key = "static_" + std::string(name) + signature;
         auto it = m_fieldMap.find(key);
 
@@ -178,6 +181,7 @@ JavaFieldPtr JavaClass::getStaticField(const char* name, const char* signature)
 
 JavaFieldPtr JavaClass::getField(const char* name, const char* signature) {
     try_with_context {
+        std::lock_guard<std::mutex> lock(m_memberMutex);
         std::string key = std::string(name) + signature;
         auto it = m_fieldMap.find(key);
 
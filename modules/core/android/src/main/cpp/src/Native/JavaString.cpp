@@ -117,6 +117,45 @@ const char* JavaString::toCStr() {
     return m_cstr;
 }
 
+jbyteArray JavaString::newUtf8Bytes(JNIEnv* env, const std::string& str) {
+    try {
+        ThrowIfNull(env, "invalidJavaEnv");
+        auto size = static_cast<jsize>(str.size());
+        jbyteArray bytes = env->NewByteArray(size);
+        ThrowIfJavaEx(env, "newByteArrayFailed");
+        ThrowIfNull(bytes, "newByteArrayFailed");
+        env->SetByteArrayRegion(bytes, 0, size, reinterpret_cast<const jbyte*>(str.data()));
+        if (env->ExceptionCheck()) {
+            env->DeleteLocalRef(bytes);
+            ThrowIfJavaEx(env, "setByteArrayRegionFailed");
+        }
+        return bytes;
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "newUtf8Bytes", ex.what());
+        return nullptr;
+    }
+}
+
+std::string JavaString::fromUtf8Bytes(JNIEnv* env, jbyteArray bytes) {
+    try {
+        ThrowIfNull(env, "invalidJavaEnv");
+        ReturnIf(bytes == nullptr, std::string());
+        auto size = env->GetArrayLength(bytes);
+        ThrowIfJavaEx(env, "getArrayLengthFailed");
+
+        // the bytes are copied into the string, which is not reallocated
+        std::string str(static_cast<size_t>(size), '\0');
+        if (size > 0) {
+            env->GetByteArrayRegion(bytes, 0, size, reinterpret_cast<jbyte*>(&str[0]));
+            ThrowIfJavaEx(env, "getByteArrayRegionFailed");
+        }
+        return str;
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, "fromUtf8Bytes", ex.what());
+        return std::string();
+    }
+}
+
 }  // namespace native
 }  // namespace jni
 }  // namespace aace
@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <pthread.h>
+
 #include <AACE/JNI/Native/ThreadContext.h>
 #include <AACE/JNI/Native/JavaClass.h>
 #include <AACE/JNI/Native/NativeMacros.h>
@@ -24,25 +26,37 @@ static const char TAG[] = "aace.jni.native.ThreadContext";
 JavaVM* g_javaVM = nullptr;
 static bool g_initializeClassLoaderAttempted = false;
 
+// the threads attached by a ThreadContext are detached when they exit, by the destructor of this key
+static pthread_key_t g_attachedThreadKey;
+static pthread_once_t g_attachedThreadKeyOnce = PTHREAD_ONCE_INIT;
+
+static void detachAttachedThread(void* /* env */) {
+    if (g_javaVM != nullptr) {
+        g_javaVM->DetachCurrentThread();
+    }
+}
+
+static void createAttachedThreadKey() {
+    pthread_key_create(&g_attachedThreadKey, detachAttachedThread);
+}
+
 namespace aace {
 namespace jni {
 namespace native {
 
-ThreadContext::ThreadContext() : m_env(nullptr), m_detatch(false) {
-    if (g_javaVM != nullptr) {
-        m_detatch = g_javaVM->GetEnv((void**)&m_env, JNI_VERSION_1_6) == JNI_EDETACHED;
-
-        if (m_detatch) {
-            g_javaVM->AttachCurrentThread(&m_env, nullptr);
+ThreadContext::ThreadContext() : m_env(nullptr) {
+    if (g_javaVM != nullptr && g_javaVM->GetEnv((void**)&m_env, JNI_VERSION_1_6) == JNI_EDETACHED) {
+        // an engine thread stays attached until it exits, rather than attaching and detaching on every callback
+        if (g_javaVM->AttachCurrentThread(&m_env, nullptr) == JNI_OK) {
+            pthread_once(&g_attachedThreadKeyOnce, createAttachedThreadKey);
+            pthread_setspecific(g_attachedThreadKey, m_env);
+        } else {
+            m_env = nullptr;
         }
     }
 }
 
-ThreadContext::~ThreadContext() {
-    if (g_javaVM != nullptr && m_env != nullptr && m_detatch) {
-        g_javaVM->DetachCurrentThread();
-    }
-}
+ThreadContext::~ThreadContext() = default;
 
 JNIEnv* ThreadContext::getEnv() {
     return m_env;
@@ -17,6 +17,8 @@ package com.amazon.aace.audio;
 
 import com.amazon.aace.core.NativeRef;
 
+import java.nio.ByteBuffer;
+
 abstract public class AudioInput extends NativeRef {
     public boolean startAudioInput() {
         return false;
@@ -38,6 +40,24 @@ abstract public class AudioInput extends NativeRef {
         return write(getNativeRef(), data, offset, size);
     }
 
+    /**
+     * Writes the 16-bit audio samples between the position and the limit of a direct @c ByteBuffer, without copying
+     * them through a Java array, and advances the position past the bytes written.
+     *
+     * @param buffer The direct buffer of the audio samples
+     * @return The number of bytes written
+     */
+    final public long write(ByteBuffer buffer) {
+        if (!buffer.isDirect()) {
+            throw new IllegalArgumentException("The buffer must be a direct ByteBuffer");
+        }
+        long count = writeBuffer(getNativeRef(), buffer, buffer.position(), buffer.remaining());
+        if (count > 0) {
+            buffer.position(buffer.position() + (int) count);
+        }
+        return count;
+    }
+
     protected long createNativeRef() {
         return createBinder();
     }
@@ -50,4 +70,5 @@ abstract public class AudioInput extends NativeRef {
     private native long createBinder();
     private native void disposeBinder(long nativeRef);
     private native long write(long nativeObject, byte[] data, long offset, long size);
+    private native long writeBuffer(long nativeObject, ByteBuffer buffer, long offset, long size);
 }
@@ -17,6 +17,9 @@ package com.amazon.aace.audio;
 
 import com.amazon.aace.core.NativeRef;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
 /**
  * AudioOutput should be extended to play audio data provided by the Engine.
  *
@@ -31,6 +34,10 @@ import com.amazon.aace.core.NativeRef;
  * When the media player resumes playback after a buffer underrun, the platform implementation should call
  * @c mediaStateChanged() with @c MediaState.PLAYING.
  *
+ * The Engine polls @c getPosition(), @c getDuration(), and @c getNumBytesBuffered() while the audio plays. A platform
+ * implementation can instead publish these values with @c updatePlaybackState() as they change, which the Engine
+ * then reads from memory shared with the native code, without a call into Java for each query.
+ *
  * @note The @c AudioOutput platform implementation should be able to support the
  * audio formats recommended by AVS for a familiar Alexa experience:
  * https://developer.amazon.com/docs/alexa-voice-service/recommended-media-support.html
@@ -309,6 +316,27 @@ abstract public class AudioOutput extends NativeRef {
         return true;
     }
 
+    /**
+     * Publishes the playback state of the platform media player to the Engine. Once it is called, the Engine reads
+     * the most recent published state instead of calling @c getPosition(), @c getDuration(), and
+     * @c getNumBytesBuffered(), so it should be called whenever the state changes, and periodically while the audio
+     * plays, such as every 100 milliseconds.
+     *
+     * @param  position The playback position in milliseconds, or @c TIME_UNKNOWN
+     * @param  duration The duration of the current audio source in milliseconds, or @c TIME_UNKNOWN
+     * @param  numBytesBuffered The number of bytes of the audio data buffered, or 0 if it's unknown
+     */
+    protected synchronized void updatePlaybackState(long position, long duration, long numBytesBuffered) {
+        // the sequence is odd while the state is written, so the Engine retries a read that overlaps the write
+        mStateBuffer.putLong(STATE_SEQUENCE, ++mStateSequence);
+        orderStateWrites();
+        mStateBuffer.putLong(STATE_POSITION, position);
+        mStateBuffer.putLong(STATE_DURATION, duration);
+        mStateBuffer.putLong(STATE_NUM_BYTES_BUFFERED, numBytesBuffered);
+        orderStateWrites();
+        mStateBuffer.putLong(STATE_SEQUENCE, ++mStateSequence);
+    }
+
     /**
      * Returns the current playback position of the platform media player.
      * If the audio source is not playing, the most recent position played
@@ -415,7 +443,18 @@ abstract public class AudioOutput extends NativeRef {
     }
 
     protected long createNativeRef() {
-        return createBinder();
+        return createBinder(mStateBuffer);
+    }
+
+    /**
+     * @internal
+     * A volatile write followed by a volatile read, which the writes to the state buffer are not reordered across.
+     */
+    private void orderStateWrites() {
+        mStateFence = mStateSequence;
+        if (mStateFence != mStateSequence) {
+            throw new IllegalStateException("invalidStateFence");
+        }
     }
 
     protected void disposeNativeRef(long nativeRef) {
@@ -423,7 +462,7 @@ abstract public class AudioOutput extends NativeRef {
     }
 
     // Native Engine JNI methods
-    private native long createBinder();
+    private native long createBinder(ByteBuffer stateBuffer);
     private native void disposeBinder(long nativeRef);
     private native void mediaError(long nativeObject, MediaError type, String error);
     private native void mediaStateChanged(long nativeObject, MediaState state);
@@ -441,4 +480,15 @@ abstract public class AudioOutput extends NativeRef {
     }
 
     private MediaStateListener mMediaStateListener;
+
+    // The playback state shared with the native code, as native-order longs
+    private static final int STATE_SEQUENCE = 0;
+    private static final int STATE_POSITION = 8;
+    private static final int STATE_DURATION = 16;
+    private static final int STATE_NUM_BYTES_BUFFERED = 24;
+    private static final int STATE_SIZE = 32;
+
+    private final ByteBuffer mStateBuffer = ByteBuffer.allocateDirect(STATE_SIZE).order(ByteOrder.nativeOrder());
+    private long mStateSequence = 0;
+    private volatile long mStateFence = 0;
 }
@@ -17,6 +17,8 @@ package com.amazon.aace.audio;
 
 import com.amazon.aace.core.NativeRef;
 
+import java.nio.ByteBuffer;
+
 final public class AudioStream extends NativeRef {
     /**
      * Describes the playback state of the platform media player
@@ -118,6 +120,25 @@ final public class AudioStream extends NativeRef {
         return read(getNativeRef(), data, offset, size);
     }
 
+    /**
+     * Reads audio data from the @c AudioStream into a direct @c ByteBuffer, without copying it through a Java array.
+     * The data is copied at the position of the buffer, up to its limit, and the position is advanced past it.
+     *
+     * @param  buffer The direct buffer where audio data should be copied
+     * @return The number of bytes read, 0 if the end of stream is reached or data is not currently available,
+     * or -1 if an error occurred
+     */
+    final public int read(ByteBuffer buffer) {
+        if (!buffer.isDirect()) {
+            throw new IllegalArgumentException("The buffer must be a direct ByteBuffer");
+        }
+        int count = readBuffer(getNativeRef(), buffer, buffer.position(), buffer.remaining());
+        if (count > 0) {
+            buffer.position(buffer.position() + count);
+        }
+        return count;
+    }
+
     /**
      * @return @c true if the @c AudioStream is closed and no more data is available to read.
      */
@@ -157,6 +178,7 @@ final public class AudioStream extends NativeRef {
     // Native Engine JNI methods
     private native void disposeBinder(long nativeRef);
     private native int read(long nativeObject, byte[] data, long offset, long size);
+    private native int readBuffer(long nativeObject, ByteBuffer buffer, long offset, long size);
     private native boolean isClosed(long nativeObject);
     private native Encoding getEncoding(long nativeObject);
     private native AudioFormat getAudioFormat(long nativeObject);
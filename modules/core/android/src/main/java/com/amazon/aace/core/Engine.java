@@ -15,6 +15,7 @@
 
 package com.amazon.aace.core;
 
+import android.content.ComponentCallbacks2;
 import android.content.Context;
 import android.util.Log;
 
@@ -37,6 +38,51 @@ final public class Engine extends NativeRef {
 
     private Engine() {}
 
+    /**
+     * The memory pressure levels, in increasing severity
+     */
+    public enum MemoryPressureLevel {
+        /**
+         * The memory is not under pressure, the Engine caches and buffers grow back to their configured sizes
+         * @hideinitializer
+         */
+        NORMAL("NORMAL"),
+        /**
+         * The system is getting low on memory, the Engine trims its caches
+         * @hideinitializer
+         */
+        MODERATE("MODERATE"),
+        /**
+         * The system is low on memory, the Engine drops its caches and shrinks its buffers
+         * @hideinitializer
+         */
+        LOW("LOW"),
+        /**
+         * The process is about to be killed, the Engine releases all the memory it can do without
+         * @hideinitializer
+         */
+        CRITICAL("CRITICAL");
+
+        /**
+         * @internal
+         */
+        private String m_name;
+
+        /**
+         * @internal
+         */
+        private MemoryPressureLevel(String name) {
+            m_name = name;
+        }
+
+        /**
+         * @internal
+         */
+        public String toString() {
+            return m_name;
+        }
+    }
+
     /**
      * Creates a new instance of an Engine object.
      */
@@ -84,6 +130,71 @@ final public class Engine extends NativeRef {
         return stop(getNativeRef());
     }
 
+    /**
+     * Suspends the running Engine, such as when the device enters suspend-to-RAM or a short ignition cycle.
+     * The Engine services close their network connections and keep their state, so @c resume() restores them
+     * much faster than @c start() after @c stop().
+     *
+     * @return @c true if the Engine was suspended, else @c false
+     *
+     * @sa resume()
+     */
+    public final boolean suspend() {
+        return suspend(getNativeRef());
+    }
+
+    /**
+     * Resumes the suspended Engine, and reconnects to AVS
+     *
+     * @return @c true if the Engine was resumed, else @c false
+     *
+     * @sa suspend()
+     */
+    public final boolean resume() {
+        return resume(getNativeRef());
+    }
+
+    /**
+     * Reports the memory pressure of the system, so the Engine caches and buffers shrink in priority order
+     * instead of the process being killed. The level applies until another level is reported.
+     *
+     * @param  level The memory pressure level
+     *
+     * @return @c true if the level was reported, else @c false
+     *
+     * @sa onTrimMemory()
+     */
+    public final boolean reportMemoryPressure(MemoryPressureLevel level) {
+        return reportMemoryPressure(getNativeRef(), level);
+    }
+
+    /**
+     * Reports the memory pressure of an @c android.content.ComponentCallbacks2.onTrimMemory() call. The levels
+     * the system reports when the UI is hidden are not memory pressure, and are ignored.
+     *
+     * @param  level The trim memory level passed to @c onTrimMemory()
+     *
+     * @return @c true if the level was reported or ignored, else @c false
+     */
+    public final boolean onTrimMemory(int level) {
+        if (level >= ComponentCallbacks2.TRIM_MEMORY_COMPLETE) {
+            return reportMemoryPressure(MemoryPressureLevel.CRITICAL);
+        } else if (level >= ComponentCallbacks2.TRIM_MEMORY_MODERATE) {
+            return reportMemoryPressure(MemoryPressureLevel.LOW);
+        } else if (level >= ComponentCallbacks2.TRIM_MEMORY_BACKGROUND) {
+            return reportMemoryPressure(MemoryPressureLevel.MODERATE);
+        } else if (level >= ComponentCallbacks2.TRIM_MEMORY_UI_HIDDEN) {
+            return true;
+        } else if (level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_CRITICAL) {
+            return reportMemoryPressure(MemoryPressureLevel.CRITICAL);
+        } else if (level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW) {
+            return reportMemoryPressure(MemoryPressureLevel.LOW);
+        } else if (level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_MODERATE) {
+            return reportMemoryPressure(MemoryPressureLevel.MODERATE);
+        }
+        return reportMemoryPressure(MemoryPressureLevel.NORMAL);
+    }
+
     /**
      * Registers a @c PlatformInterface instance with the Engine
      * The platform implementation must register each interface required by the application.
@@ -157,6 +268,9 @@ final public class Engine extends NativeRef {
     private native boolean configure(long nativeRef, long[] configurationRefList);
     private native boolean start(long nativeRef);
     private native boolean stop(long nativeRef);
+    private native boolean suspend(long nativeRef);
+    private native boolean resume(long nativeRef);
+    private native boolean reportMemoryPressure(long nativeRef, MemoryPressureLevel level);
     private native boolean registerPlatformInterface(long nativeRef, long platformInterfaceRef);
     private native boolean setNativeEnv(long nativeRef, String name, String value);
     private native MessageBroker getMessageBroker(long nativeRef);
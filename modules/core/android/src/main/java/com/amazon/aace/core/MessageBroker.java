@@ -17,23 +17,70 @@ package com.amazon.aace.core;
 
 import com.amazon.aace.core.NativeRef;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
 import java.util.function.Function;
 
 final public class MessageBroker extends NativeRef {
     public interface MessageHandler { public void messageReceived(String message); }
 
     public final void subscribe(MessageHandler handler, String topic, String action) {
-        subscribe(getNativeRef(), handler, topic, action);
+        subscribe(getNativeRef(), new Utf8Handler(handler), topic, action);
+    }
+
+    /**
+     * Subscribes a handler to messages delivered in batches, for topics with many messages per second. The Engine
+     * accumulates the messages for up to {@code maxBatchDelayMs}, or until they reach {@code maxBatchSize} bytes,
+     * and delivers them with a single JNI call from its own thread. The handler receives the messages in order.
+     */
+    public final void subscribe(
+            MessageHandler handler, String topic, String action, int maxBatchDelayMs, int maxBatchSize) {
+        subscribeBatched(getNativeRef(), new BatchHandler(handler), topic, action, maxBatchDelayMs, maxBatchSize);
     }
 
     public final void publish(String message) {
-        publish(getNativeRef(), message);
+        // the message is passed as its UTF-8 bytes, rather than converted by JNI to modified UTF-8
+        publish(getNativeRef(), message.getBytes(StandardCharsets.UTF_8));
     }
 
     public final MessageStream openStream(String streamId, MessageStream.Mode mode) {
         return openStream(getNativeRef(), streamId, mode);
     }
 
+    // Decodes the UTF-8 bytes of the messages delivered by the Engine
+    private static final class Utf8Handler {
+        private final MessageHandler m_handler;
+
+        Utf8Handler(MessageHandler handler) {
+            m_handler = handler;
+        }
+
+        // called by the Engine
+        void messageReceived(byte[] message) {
+            m_handler.messageReceived(new String(message, StandardCharsets.UTF_8));
+        }
+    }
+
+    // Splits the batches delivered by the Engine, each message framed by its little endian 32 bit length
+    private static final class BatchHandler {
+        private final MessageHandler m_handler;
+
+        BatchHandler(MessageHandler handler) {
+            m_handler = handler;
+        }
+
+        // called by the Engine, the buffer is only valid during the call
+        void messagesReceived(ByteBuffer batch) {
+            batch.order(ByteOrder.LITTLE_ENDIAN);
+            while (batch.remaining() >= 4) {
+                byte[] message = new byte[batch.getInt()];
+                batch.get(message);
+                m_handler.messageReceived(new String(message, StandardCharsets.UTF_8));
+            }
+        }
+    }
+
     // NativeRef implementation
     protected long createNativeRef() {
         return 0;
@@ -45,8 +92,10 @@ final public class MessageBroker extends NativeRef {
 
     // Native Engine JNI methods
     private native void disposeBinder(long nativeRef);
-    private native void subscribe(long nativeRef, MessageHandler handler, String topic, String action);
-    private native void publish(long nativeRef, String message);
+    private native void subscribe(long nativeRef, Utf8Handler handler, String topic, String action);
+    private native void subscribeBatched(long nativeRef, BatchHandler handler, String topic, String action,
+            int maxBatchDelayMs, int maxBatchSize);
+    private native void publish(long nativeRef, byte[] message);
     private native MessageStream openStream(long nativeRef, String streamId, MessageStream.Mode mode);
 }
 
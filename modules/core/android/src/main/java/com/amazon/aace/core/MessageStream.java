@@ -17,6 +17,8 @@ package com.amazon.aace.core;
 
 import com.amazon.aace.core.NativeRef;
 
+import java.nio.ByteBuffer;
+
 public class MessageStream extends NativeRef {
     /// An enumeration representing the stream operation mode.
     public enum Mode {
@@ -78,6 +80,25 @@ public class MessageStream extends NativeRef {
         return read(getNativeRef(), data, offset, size);
     }
 
+    /**
+     * Reads data from the @c MessageStream into a direct @c ByteBuffer, without copying it through a Java array.
+     * The data is copied at the position of the buffer, up to its limit, and the position is advanced past it.
+     *
+     * @param  buffer The direct buffer where data should be copied
+     * @return The number of bytes read, 0 if the end of stream is reached or data is not currently available,
+     * or -1 if an error occurred
+     */
+    final public int read(ByteBuffer buffer) {
+        if (!buffer.isDirect()) {
+            throw new IllegalArgumentException("The buffer must be a direct ByteBuffer");
+        }
+        int count = readBuffer(getNativeRef(), buffer, buffer.position(), buffer.remaining());
+        if (count > 0) {
+            buffer.position(buffer.position() + count);
+        }
+        return count;
+    }
+
     /**
      * Writes data to the @c MessageStream.
      *
@@ -102,6 +123,26 @@ public class MessageStream extends NativeRef {
         return write(getNativeRef(), data, offset, size);
     }
 
+    /**
+     * Writes data from a direct @c ByteBuffer to the @c MessageStream, without copying it through a Java array.
+     * The data between the position and the limit of the buffer is written, and the position is advanced past the
+     * bytes written.
+     *
+     * @param buffer The direct buffer of the data to be written to the stream
+     * @return The number of bytes successfully written to the stream or a negative error code
+     * if data could not be written
+     */
+    final public int write(ByteBuffer buffer) {
+        if (!buffer.isDirect()) {
+            throw new IllegalArgumentException("The buffer must be a direct ByteBuffer");
+        }
+        int count = writeBuffer(getNativeRef(), buffer, buffer.position(), buffer.remaining());
+        if (count > 0) {
+            buffer.position(buffer.position() + count);
+        }
+        return count;
+    }
+
     /**
      * @return @c true if the @c MessageStream is closed and no more data is available to read.
      */
@@ -129,6 +170,8 @@ public class MessageStream extends NativeRef {
     private native void disposeBinder(long nativeRef);
     private native int read(long nativeObject, byte[] data, long offset, long size);
     private native int write(long nativeObject, byte[] data, long offset, long size);
+    private native int readBuffer(long nativeObject, ByteBuffer buffer, long offset, long size);
+    private native int writeBuffer(long nativeObject, ByteBuffer buffer, long offset, long size);
     private native boolean isClosed(long nativeObject);
     private native Mode getMode(long nativeObject);
 }
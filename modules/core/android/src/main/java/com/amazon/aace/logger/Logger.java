@@ -111,6 +111,29 @@ abstract public class Logger extends PlatformInterface {
         return logEvent(level, time, source, new String(message, StandardCharsets.UTF_8));
     }
 
+    /**
+     * Notifies the platform implementation of a batch of log events from the AAC SDK logger, in the order
+     * they were logged, when batched delivery is enabled in the Engine configuration. The arrays have one
+     * element for each log event. The default implementation calls @c logEvent() for each event.
+     *
+     * @param  levels The log levels
+     *
+     * @param  times The timestamps of the logged messages
+     *
+     * @param  sources The sources of the log messages
+     *
+     * @param  messages The log messages
+     *
+     * @return @c true if the platform implementation successfully handled the log events, else @c false
+     */
+    public boolean logEvents(Level[] levels, long[] times, String[] sources, byte[][] messages) {
+        boolean result = true;
+        for (int i = 0; i < levels.length; i++) {
+            result = logEvent(levels[i], times[i], sources[i], messages[i]) && result;
+        }
+        return result;
+    }
+
     /**
      * Notifies the Engine to use the AAC SDK logger to log a message originating on the platform.
      * The log event will be received by the platform with a call to @c logEvent() from the Engine.
@@ -97,4 +97,34 @@ endif()
 
 if(AAC_EMIT_THREAD_MONIKER_LOGS)
     add_definitions(-DAAC_EMIT_THREAD_MONIKER_LOGS)
-endif()
\ No newline at end of file
+endif()
+
+if(AAC_LOG_COMPRESSION)
+    add_definitions(-DAAC_LOG_COMPRESSION)
+endif()
+
+# Account the heap memory to the Engine modules allocating it (On|Off).
+#
+#   -DAAC_MEMORY_ACCOUNTING=On
+#
+# Defaults to Off. If enabled, the global operator new and delete are replaced by the Engine.
+
+if(AAC_MEMORY_ACCOUNTING)
+    add_definitions(-DAAC_MEMORY_ACCOUNTING)
+endif()
+
+# Select how the message broker scans the header of a message parsed lazily (OnDemand|Sax).
+#
+#   -DAAC_JSON_HEADER_SCANNER=OnDemand
+#   -DAAC_JSON_HEADER_SCANNER=Sax
+#
+# Defaults to OnDemand, which reads the header fields with the on-demand JSON reader of the Engine. Sax scans the
+# header with the SAX parser of nlohmann::json.
+
+set(AAC_JSON_HEADER_SCANNER "OnDemand" CACHE STRING "Set the JSON header scanner of the message broker")
+string(TOUPPER "${AAC_JSON_HEADER_SCANNER}" AAC_JSON_HEADER_SCANNER_UPPER)
+if(AAC_JSON_HEADER_SCANNER_UPPER STREQUAL "SAX")
+    add_definitions(-DAAC_JSON_HEADER_SCANNER_SAX)
+elseif(NOT AAC_JSON_HEADER_SCANNER_UPPER MATCHES "^(ONDEMAND)?$")
+    message(FATAL_ERROR "Unknown JSON header scanner: ${AAC_JSON_HEADER_SCANNER}")
+endif()
@@ -30,6 +30,9 @@ class AutoSdkModulePkg(ConanFile):
         "default_logger_sink": ["Default","Console","Syslog"],
         "with_colored_logs": [True, False],
         "with_thread_moniker_logs": [True, False],
+        "with_log_compression": [True, False],
+        "with_memory_accounting": [True, False],
+        "json_header_scanner": ["OnDemand", "Sax"],
     }
     module_default_options = {
         "default_logger_enabled": True,
@@ -37,12 +40,26 @@ class AutoSdkModulePkg(ConanFile):
         "default_logger_sink": "Default",
         "with_colored_logs": True,
         "with_thread_moniker_logs": True,
+        "with_log_compression": False,
+        "with_memory_accounting": False,
+        "json_header_scanner": "OnDemand",
         "sqlite3:build_executable": False,
     }
 
     def configure(self):
         super(AutoSdkModulePkg,self).configure()
 
+    def requirements(self):
+        super(AutoSdkModulePkg,self).requirements()
+        # zlib compresses the rotated files of the file log sink and the spooled metrics batches
+        if self.options.with_log_compression:
+            self.requires("zlib/1.2.12")
+
+    @property
+    def _required_system_libs(self):
+        # shm_open() is provided by librt, and dladdr() by libdl on Linux
+        return ["rt", "dl"] if self.settings.os == "Linux" else []
+
     def get_cmake_definitions(self):
         cmake_defs = super(AutoSdkModulePkg,self).get_cmake_definitions()
 
@@ -55,6 +72,11 @@ class AutoSdkModulePkg(ConanFile):
             cmake_defs["AAC_EMIT_COLOR_LOGS"] = "On"
         if self.options.with_thread_moniker_logs:
             cmake_defs["AAC_EMIT_THREAD_MONIKER_LOGS"] = "On"
+        if self.options.with_log_compression:
+            cmake_defs["AAC_LOG_COMPRESSION"] = "On"
+        if self.options.with_memory_accounting:
+            cmake_defs["AAC_MEMORY_ACCOUNTING"] = "On"
+        cmake_defs["AAC_JSON_HEADER_SCANNER"] = self.options.json_header_scanner
 
         return cmake_defs
 
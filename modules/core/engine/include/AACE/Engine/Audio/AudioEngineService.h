@@ -16,6 +16,9 @@
 #ifndef AACE_ENGINE_AUDIO_AUDIO_ENGINE_SERVICE_H
 #define AACE_ENGINE_AUDIO_AUDIO_ENGINE_SERVICE_H
 
+#include <mutex>
+#include <vector>
+
 #include <AACE/Engine/Core/EngineService.h>
 #include <AACE/Audio/AudioInputProvider.h>
 #include <AACE/Audio/AudioOutputProvider.h>
@@ -48,10 +51,14 @@ public:
     std::shared_ptr<AudioOutputChannelInterface> openAudioOutputChannel(
         const std::string& name,
         AudioOutputType audioOutputType) override;
+    bool isAudioOutputPlaying() override;
+    void addAudioInputProcessor(AudioInputProcessorFactory factory) override;
 
 protected:
     bool initialize() override;
+    bool configure(std::shared_ptr<std::istream> configuration) override;
     bool shutdown() override;
+    bool engineStarted() override;
     bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) override;
 
 private:
@@ -68,6 +75,23 @@ private:
 private:
     std::shared_ptr<AudioInputProviderEngineImpl> m_audioInputProvideEngineImpl;
     std::shared_ptr<AudioOutputProviderEngineImpl> m_audioOutputProvideEngineImpl;
+
+    // the audio input fan-out configuration
+    AudioInputEngineImpl::FanOut m_audioInputFanOut = AudioInputEngineImpl::FanOut::DIRECT;
+    size_t m_audioInputBufferSize = AudioInputEngineImpl::DEFAULT_BUFFER_SIZE;
+    AudioInputEngineImpl::InputFormat m_audioInputFormat;
+
+    // the warm standby of the audio inputs
+    AudioInputEngineImpl::Standby m_audioInputStandby;
+    std::vector<AudioInputType> m_audioInputStandbyTypes;
+
+    // the audio input processing configuration
+    std::mutex m_processorMutex;
+    std::vector<AudioInputProcessorFactory> m_audioInputProcessorFactories;
+    std::shared_ptr<AudioReferenceTap> m_referenceTap;
+
+    // the audio output channels pre-warmed when the Engine starts
+    std::vector<std::pair<std::string, AudioOutputType>> m_prewarmedOutputChannels;
 };
 
 }  // namespace audio
@@ -16,25 +16,131 @@
 #ifndef AACE_ENGINE_AUDIO_AUDIO_INPUT_ENGINE_IMPL_H
 #define AACE_ENGINE_AUDIO_AUDIO_INPUT_ENGINE_IMPL_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include <AACE/Audio/AudioInput.h>
+#include <AACE/Engine/MessageBroker/RingBufferMessageStream.h>
+#include <AACE/Engine/Utils/PCM/PCMUtils.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
 #include "AudioInputChannelInterface.h"
+#include "AudioInputProcessor.h"
+#include "AudioReferenceTap.h"
 
 namespace aace {
 namespace engine {
 namespace audio {
 
+/**
+ * Delivers the audio written by the platform @c AudioInput to the channels started on it.
+ *
+ * With the @c DIRECT fan-out, @c write() calls the callback of every channel on the calling thread.
+ * With the @c BUFFERED fan-out, @c write() copies the audio to a single-producer, single-consumer
+ * ring buffer per channel, and each channel calls its callback on its own thread, named
+ * "AudioInput.<name>.<channel id>", so a slow channel does not delay the platform capture thread or
+ * the other channels. The audio that does not fit in the buffer of a channel is dropped for that
+ * channel. In this mode, @c write() must not be called by several threads at the same time.
+ *
+ * The channels receive 16 kHz mono audio. Audio written in another @c InputFormat, such as the
+ * interleaved channels of a microphone array at 48 kHz, is mixed down and resampled with a polyphase filter. With
+ * the @c DIRECT fan-out, @c write() converts it. With the @c BUFFERED fan-out, @c write() only copies it to the
+ * buffer of a converter thread, named "AudioInput.<name>.convert", which converts it and copies it to the channel
+ * buffers, so the platform capture thread does no more than a copy. A frame split between two writes is carried
+ * over to the next write.
+ *
+ * The processors of the input, such as an echo canceller, process the written audio in order before it is mixed
+ * down and resampled, in a working copy of the audio. With a reference tap, each block they process carries the
+ * audio the outputs played while it was captured.
+ *
+ * With a warm @c Standby, the platform input stays started for the hold time after the last channel stops, and the
+ * audio written meanwhile is kept in a pre-roll ring of the latest audio. A channel started during the hold time
+ * starts without waiting for the platform to start its input, and receives the pre-roll before the written audio.
+ */
 class AudioInputEngineImpl
         : public aace::audio::AudioInputEngineInterface
-        , public AudioInputChannelInterface {
+        , public AudioInputChannelInterface
+        , public std::enable_shared_from_this<AudioInputEngineImpl> {
+public:
+    /// How the audio written by the platform is delivered to the channels
+    enum class FanOut {
+        /// The callbacks are called by the writing thread
+        DIRECT,
+        /// The audio is buffered for each channel, and the callbacks are called by a thread per channel
+        BUFFERED
+    };
+
+    /// The default size in bytes of the buffer of a channel with the @c BUFFERED fan-out
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+    /// The sample rate of the audio delivered to the channels
+    static constexpr uint32_t CHANNEL_SAMPLE_RATE = 16000;
+
+    /// The format of the audio written by the platform
+    struct InputFormat {
+        InputFormat(uint32_t sampleRate = CHANNEL_SAMPLE_RATE, uint32_t channels = 1) :
+                sampleRate(sampleRate), channels(channels) {
+        }
+
+        uint32_t sampleRate;
+        /// The number of interleaved channels of a frame
+        uint32_t channels;
+    };
+
+    /// The warm standby of the platform input
+    struct Standby {
+        Standby(
+            std::chrono::milliseconds holdTime = std::chrono::milliseconds(0),
+            std::chrono::milliseconds preRoll = std::chrono::milliseconds(0)) :
+                holdTime(holdTime), preRoll(preRoll) {
+        }
+
+        /// How long the platform input stays started after the last channel stops, or 0 to stop it at once
+        std::chrono::milliseconds holdTime;
+        /// The duration of the latest audio of the hold time delivered to the channel started in standby
+        std::chrono::milliseconds preRoll;
+    };
+
 private:
-    AudioInputEngineImpl(std::shared_ptr<aace::audio::AudioInput> platformAudioInput);
+    AudioInputEngineImpl(
+        std::shared_ptr<aace::audio::AudioInput> platformAudioInput,
+        const std::string& name,
+        FanOut fanOut,
+        size_t bufferSize,
+        const InputFormat& inputFormat,
+        const std::vector<std::shared_ptr<AudioInputProcessor>>& processors,
+        std::shared_ptr<AudioReferenceTap> referenceTap,
+        const Standby& standby);
 
 public:
-    static std::shared_ptr<AudioInputEngineImpl> create(std::shared_ptr<aace::audio::AudioInput> platformAudioInput);
+    /**
+     * Creates the engine interface of a platform audio input.
+     *
+     * @param platformAudioInput The platform audio input.
+     * @param name The name of the audio input, used to name the channel threads.
+     * @param fanOut How the audio is delivered to the channels.
+     * @param bufferSize The size in bytes of the buffer of each channel with the @c BUFFERED fan-out.
+     * @param inputFormat The format of the audio written by the platform.
+     * @param processors The processors of the written audio, in order.
+     * @param referenceTap The tap of the audio outputs the reference of the processors is read from, or
+     * @c nullptr if the processors have no reference.
+     * @param standby The warm standby of the platform input, which is disabled by default.
+     */
+    static std::shared_ptr<AudioInputEngineImpl> create(
+        std::shared_ptr<aace::audio::AudioInput> platformAudioInput,
+        const std::string& name = "",
+        FanOut fanOut = FanOut::DIRECT,
+        size_t bufferSize = DEFAULT_BUFFER_SIZE,
+        const InputFormat& inputFormat = InputFormat(),
+        const std::vector<std::shared_ptr<AudioInputProcessor>>& processors = {},
+        std::shared_ptr<AudioReferenceTap> referenceTap = nullptr,
+        const Standby& standby = Standby());
 
     // AudioInputChannelInterface
     ChannelId start(AudioWriteCallback callback) override;
@@ -45,14 +151,104 @@ public:
     ssize_t write(const int16_t* data, const size_t size) override;
 
 private:
+    /// A started channel
+    struct Channel {
+        ChannelId id = INVALID_CHANNEL;
+        AudioWriteCallback callback;
+
+        // the buffered fan-out state, written by the platform thread and read by the channel thread
+        std::shared_ptr<aace::engine::messageBroker::RingBufferMessageStream> buffer;
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        std::atomic<bool> waiting{false};
+        std::atomic<bool> stopped{false};
+        // set by the platform thread while the audio is dropped
+        bool overrun = false;
+        uint64_t droppedSamples = 0;
+    };
+
+    using ChannelList = std::vector<std::shared_ptr<Channel>>;
+
     ChannelId getNextChannelId();
 
+    /**
+     * Copies the audio to the buffer of a channel, and wakes up the channel thread.
+     *
+     * @param frameSize The number of samples of a frame, of which only whole frames are copied.
+     */
+    void push(Channel& channel, const int16_t* data, size_t size, size_t frameSize = 1);
+
+    /// Converts the audio of the converter thread and copies it to the channel buffers.
+    void convertAndPush(const int16_t* data, size_t size);
+
+    /// Calls the callback of a channel with the buffered audio until the channel is stopped.
+    static void drain(std::shared_ptr<Channel> channel, std::string threadName);
+
+    /// Stops the thread of a channel. The callback is not called after this returns.
+    static void stopChannel(Channel& channel);
+
+    /**
+     * Converts the written audio to the format of the channels, in buffers written only by the converting thread.
+     *
+     * @param data The written samples, replaced by the converted samples.
+     * @param size The number of written samples, replaced by the number of converted samples.
+     */
+    void convert(const int16_t*& data, size_t& size);
+
+    /// Publishes the channel list read by @c write() with the @c BUFFERED fan-out. @c m_callbackMutex must be held.
+    void publishChannelsLocked();
+
+    /// Keeps the whole frames of the written audio in the pre-roll ring. @c m_callbackMutex must be held.
+    void writePreRollLocked(const int16_t* data, size_t size);
+
+    /// Returns the audio of the pre-roll ring in order, and empties it. @c m_callbackMutex must be held.
+    std::vector<int16_t> takePreRollLocked();
+
+    /// Stops the platform input once the hold time of the standby has elapsed, unless a channel was started.
+    void endStandby(uint64_t generation);
+
 private:
     std::shared_ptr<aace::audio::AudioInput> m_platformAudioInput;
-    std::unordered_map<ChannelId, AudioWriteCallback> m_callbackMap;
+    const std::string m_name;
+    const FanOut m_fanOut;
+    const size_t m_bufferSize;
+    const InputFormat m_inputFormat;
+    const std::vector<std::shared_ptr<AudioInputProcessor>> m_processors;
+    const std::shared_ptr<AudioReferenceTap> m_referenceTap;
+    const bool m_convert;
+    const Standby m_standby;
+    std::unordered_map<ChannelId, std::shared_ptr<Channel>> m_channelMap;
+
+    // set while the platform input is started without channels, and the timer ending the standby, which is
+    // identified by the generation, guarded by m_mutex
+    std::atomic<bool> m_inStandby{false};
+    aace::engine::utils::threading::TimerWheel::TimerId m_standbyTimer =
+        aace::engine::utils::threading::TimerWheel::INVALID_TIMER;
+    uint64_t m_standbyGeneration = 0;
+
+    // the ring of the latest frames written in standby, in the input format, guarded by m_callbackMutex
+    std::vector<int16_t> m_preRoll;
+    size_t m_preRollStart = 0;
+    size_t m_preRollSize = 0;
+
+    // snapshot of the channels read without locking by write(), with std::atomic_load()
+    std::shared_ptr<const ChannelList> m_channels;
+
+    // the converter of the buffered fan-out, while a channel is started, read by write() with std::atomic_load()
+    std::shared_ptr<Channel> m_converter;
 
     ChannelId m_nextChannelId = 1;
 
+    // the conversion state of the written audio
+    std::unique_ptr<aace::engine::utils::pcm::PolyphaseResampler> m_resampler;
+    std::atomic<bool> m_resetConversion{false};
+    // the samples of a frame split between two writes
+    std::vector<int16_t> m_carry;
+    std::vector<int16_t> m_mixBuffer;
+    std::vector<int16_t> m_referenceBuffer;
+    std::vector<int16_t> m_resampleBuffer;
+
     std::mutex m_mutex;          // to serialize operations of AudioInputChannelInterface
     std::mutex m_callbackMutex;  // to guard against potential race conditions caused by callback from another thread
 };
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_AUDIO_AUDIO_INPUT_PROCESSOR_H
+#define AACE_ENGINE_AUDIO_AUDIO_INPUT_PROCESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <AACE/Audio/AudioInputProvider.h>
+
+namespace aace {
+namespace engine {
+namespace audio {
+
+/// A block of audio written by the platform, which the processors of the audio input process in place.
+struct AudioInputBlock {
+    /// The interleaved samples of the frames.
+    int16_t* samples;
+    /// The number of frames.
+    size_t frames;
+    /// The number of channels of a frame, which a processor mixing the channels down reduces.
+    uint32_t channels;
+    /// The sample rate of the audio.
+    uint32_t sampleRate;
+    /**
+     * The mono audio played by the audio outputs while the block was captured, @c frames samples at the
+     * sample rate of the block, such as the reference signal of an echo canceller. It is @c nullptr if the
+     * audio of the outputs is not tapped.
+     */
+    const int16_t* reference;
+};
+
+/**
+ * A stage of the processing of an audio input, such as an echo canceller, a noise suppressor or a beamformer.
+ *
+ * The processors of an audio input are called in order by the thread writing the audio, before the audio is mixed
+ * down to mono, resampled and delivered to the channels of the input. They process the same buffer in place, so a
+ * processor must not keep the samples of a block after it returns, and should not block.
+ */
+class AudioInputProcessor {
+public:
+    virtual ~AudioInputProcessor() = default;
+
+    /// Starts a new stream, when the platform starts the audio input.
+    virtual void reset() {
+    }
+
+    /**
+     * Processes a block of audio in place. A processor that mixes the channels down, such as a beamformer, writes
+     * the frames of its output channels at the start of the samples, and sets the channels of the block.
+     */
+    virtual void process(AudioInputBlock& block) = 0;
+};
+
+/**
+ * Creates the processor of an audio input of a type, for the audio written in a format. It returns @c nullptr if
+ * the input is not processed.
+ */
+using AudioInputProcessorFactory = std::function<std::shared_ptr<AudioInputProcessor>(
+    aace::audio::AudioInputProvider::AudioInputType type,
+    uint32_t sampleRate,
+    uint32_t channels)>;
+
+}  // namespace audio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_AUDIO_AUDIO_INPUT_PROCESSOR_H
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_AUDIO_AUDIO_INPUT_PROCESSORS_H
+#define AACE_ENGINE_AUDIO_AUDIO_INPUT_PROCESSORS_H
+
+#include <memory>
+#include <vector>
+
+#include "AudioInputProcessor.h"
+
+namespace aace {
+namespace engine {
+namespace audio {
+
+/// Removes the DC offset and the low frequency noise of each channel, such as the hum of the power supply.
+class HighPassFilterProcessor : public AudioInputProcessor {
+public:
+    /// The cutoff frequency in Hz, by default
+    static constexpr float DEFAULT_CUTOFF = 100.0f;
+
+    /**
+     * Creates a filter for the audio of a sample rate.
+     *
+     * @return The filter, or @c nullptr if the cutoff frequency is not under half the sample rate.
+     */
+    static std::shared_ptr<HighPassFilterProcessor> create(uint32_t sampleRate, float cutoff = DEFAULT_CUTOFF);
+
+    // AudioInputProcessor
+    void reset() override;
+    void process(AudioInputBlock& block) override;
+
+private:
+    HighPassFilterProcessor(float coefficient);
+
+    const float m_coefficient;
+    // the last input and output of each channel
+    std::vector<float> m_state;
+};
+
+/**
+ * Adjusts the gain of the audio so its level approaches a target level. The gain is lowered at once when the
+ * audio gets louder, so loud speech is not clipped, and it is raised gradually. The gain is held while the audio
+ * is under the noise gate, so the noise of the pauses is not amplified.
+ */
+class AutomaticGainControlProcessor : public AudioInputProcessor {
+public:
+    struct Config {
+        Config(float targetLevel = -20.0f, float maxGain = 18.0f, float noiseGate = -60.0f, float gainRate = 12.0f) :
+                targetLevel(targetLevel), maxGain(maxGain), noiseGate(noiseGate), gainRate(gainRate) {
+        }
+
+        /// The level in dBFS the gain brings the audio to
+        float targetLevel;
+        /// The largest gain in dB, and the largest attenuation
+        float maxGain;
+        /// The level in dBFS under which the gain is held
+        float noiseGate;
+        /// The largest increase of the gain in dB per second
+        float gainRate;
+    };
+
+    /**
+     * Creates a gain control for the audio of a sample rate.
+     *
+     * @return The gain control, or @c nullptr if the configuration is invalid.
+     */
+    static std::shared_ptr<AutomaticGainControlProcessor> create(uint32_t sampleRate, const Config& config = Config());
+
+    /// Returns the gain in dB applied to the last block.
+    float getGain() const;
+
+    // AudioInputProcessor
+    void reset() override;
+    void process(AudioInputBlock& block) override;
+
+private:
+    AutomaticGainControlProcessor(uint32_t sampleRate, const Config& config);
+
+    const uint32_t m_sampleRate;
+    const Config m_config;
+    float m_gain = 0.0f;
+};
+
+/// Mixes the channels of the audio down to mono, such as after the processors of the channels of a microphone array.
+class DownmixProcessor : public AudioInputProcessor {
+public:
+    static std::shared_ptr<DownmixProcessor> create();
+
+    // AudioInputProcessor
+    void process(AudioInputBlock& block) override;
+
+private:
+    DownmixProcessor() = default;
+};
+
+}  // namespace audio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_AUDIO_AUDIO_INPUT_PROCESSORS_H
@@ -19,10 +19,14 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include <AACE/Audio/AudioInputProvider.h>
 
 #include "AudioInputChannelInterface.h"
+#include "AudioInputEngineImpl.h"
+#include "AudioInputProcessor.h"
+#include "AudioReferenceTap.h"
 
 namespace aace {
 namespace engine {
@@ -30,11 +34,42 @@ namespace audio {
 
 class AudioInputProviderEngineImpl {
 private:
-    AudioInputProviderEngineImpl(std::shared_ptr<aace::audio::AudioInputProvider> platformAudioInputProviderInterface);
+    AudioInputProviderEngineImpl(
+        std::shared_ptr<aace::audio::AudioInputProvider> platformAudioInputProviderInterface,
+        AudioInputEngineImpl::FanOut fanOut,
+        size_t bufferSize,
+        const AudioInputEngineImpl::InputFormat& inputFormat,
+        const std::vector<AudioInputProcessorFactory>& processorFactories,
+        std::shared_ptr<AudioReferenceTap> referenceTap,
+        const AudioInputEngineImpl::Standby& standby,
+        const std::vector<aace::audio::AudioInputProvider::AudioInputType>& standbyInputTypes);
 
 public:
+    /**
+     * Creates the engine interface of the platform audio input provider.
+     *
+     * @param platformAudioInputProviderInterface The platform audio input provider.
+     * @param fanOut How the audio of each audio input is delivered to its channels.
+     * @param bufferSize The size in bytes of the buffer of each channel with the buffered fan-out.
+     * @param inputFormat The format of the audio written by the platform audio inputs.
+     * @param processorFactories The factories of the processors of each audio input, in order.
+     * @param referenceTap The tap of the audio outputs the processors read their reference from, or @c nullptr.
+     * @param standby The warm standby of the audio inputs of the standby input types.
+     * @param standbyInputTypes The types of the audio inputs kept in warm standby.
+     */
     static std::shared_ptr<AudioInputProviderEngineImpl> create(
-        std::shared_ptr<aace::audio::AudioInputProvider> platformAudioInputProviderInterface);
+        std::shared_ptr<aace::audio::AudioInputProvider> platformAudioInputProviderInterface,
+        AudioInputEngineImpl::FanOut fanOut = AudioInputEngineImpl::FanOut::DIRECT,
+        size_t bufferSize = AudioInputEngineImpl::DEFAULT_BUFFER_SIZE,
+        const AudioInputEngineImpl::InputFormat& inputFormat = AudioInputEngineImpl::InputFormat(),
+        const std::vector<AudioInputProcessorFactory>& processorFactories = {},
+        std::shared_ptr<AudioReferenceTap> referenceTap = nullptr,
+        const AudioInputEngineImpl::Standby& standby = AudioInputEngineImpl::Standby(),
+        const std::vector<aace::audio::AudioInputProvider::AudioInputType>& standbyInputTypes = {});
+
+    /// Adds the factory of a processor following the others, for the audio inputs opened after this returns.
+    void addProcessorFactory(AudioInputProcessorFactory factory);
+
     std::shared_ptr<AudioInputChannelInterface> openChannel(
         const std::string& name,
         aace::audio::AudioInputProvider::AudioInputType audioInputType);
@@ -45,6 +80,14 @@ private:
     std::unordered_map<std::shared_ptr<aace::audio::AudioInput>, std::shared_ptr<AudioInputChannelInterface>>
         m_audioInputMap;
 
+    const AudioInputEngineImpl::FanOut m_fanOut;
+    const size_t m_bufferSize;
+    const AudioInputEngineImpl::InputFormat m_inputFormat;
+    std::vector<AudioInputProcessorFactory> m_processorFactories;
+    const std::shared_ptr<AudioReferenceTap> m_referenceTap;
+    const AudioInputEngineImpl::Standby m_standby;
+    const std::vector<aace::audio::AudioInputProvider::AudioInputType> m_standbyInputTypes;
+
     std::mutex m_mutex;
 };
 
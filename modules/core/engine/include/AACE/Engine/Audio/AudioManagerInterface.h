@@ -19,6 +19,7 @@
 #include <AACE/Audio/AudioInputProvider.h>
 #include <AACE/Audio/AudioOutputProvider.h>
 #include "AudioInputChannelInterface.h"
+#include "AudioInputProcessor.h"
 #include "AudioOutputChannelInterface.h"
 
 namespace aace {
@@ -38,6 +39,15 @@ public:
     virtual std::shared_ptr<AudioOutputChannelInterface> openAudioOutputChannel(
         const std::string& name,
         AudioOutputType audioOutputType) = 0;
+
+    /// Returns @c true if the playback of an audio output channel is in progress.
+    virtual bool isAudioOutputPlaying() = 0;
+
+    /**
+     * Adds the factory of a processor of the audio inputs, such as an echo canceller, following the processors of
+     * the configuration. The processors are created for the audio inputs opened after this returns.
+     */
+    virtual void addAudioInputProcessor(AudioInputProcessorFactory factory) = 0;
 };
 
 }  // namespace audio
@@ -41,6 +41,7 @@ public:
     virtual bool setPosition(int64_t position) = 0;
     virtual int64_t getDuration() = 0;
     virtual int64_t getNumBytesBuffered() = 0;
+    virtual void setBufferingHint(int64_t prebufferDuration) = 0;
     virtual bool volumeChanged(float volume) = 0;
     virtual bool mutedStateChanged(MutedState state) = 0;
     virtual void setEngineInterface(
@@ -16,10 +16,13 @@
 #ifndef AACE_ENGINE_AUDIO_AUDIO_OUTPUT_CHANNEL_ENGINE_IMPL_H
 #define AACE_ENGINE_AUDIO_AUDIO_OUTPUT_CHANNEL_ENGINE_IMPL_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include <AACE/Audio/AudioOutput.h>
 #include "AudioOutputChannelInterface.h"
+#include "AudioReferenceTap.h"
 
 namespace aace {
 namespace engine {
@@ -29,10 +32,21 @@ class AudioOutputEngineImpl
         : public AudioOutputChannelInterface
         , public aace::audio::AudioOutputEngineInterface {
 public:
-    static std::shared_ptr<AudioOutputEngineImpl> create(std::shared_ptr<aace::audio::AudioOutput> platformAudioOutput);
+    /**
+     * Creates the engine interface of a platform audio output.
+     *
+     * @param platformAudioOutput The platform audio output.
+     * @param referenceTap The tap the 16-bit PCM streams played by the output are written to, as the reference of
+     * the audio input processors, or @c nullptr.
+     */
+    static std::shared_ptr<AudioOutputEngineImpl> create(
+        std::shared_ptr<aace::audio::AudioOutput> platformAudioOutput,
+        std::shared_ptr<AudioReferenceTap> referenceTap = nullptr);
 
 private:
-    AudioOutputEngineImpl(std::shared_ptr<aace::audio::AudioOutput> platformAudioOutput);
+    AudioOutputEngineImpl(
+        std::shared_ptr<aace::audio::AudioOutput> platformAudioOutput,
+        std::shared_ptr<AudioReferenceTap> referenceTap);
 
 public:
     // AudioOutputChannelInterface
@@ -49,6 +63,7 @@ public:
     bool setPosition(int64_t position) override;
     int64_t getDuration() override;
     int64_t getNumBytesBuffered() override;
+    void setBufferingHint(int64_t prebufferDuration) override;
     bool volumeChanged(float volume) override;
     bool mutedStateChanged(MutedState state) override;
     void setEngineInterface(
@@ -58,9 +73,22 @@ public:
     void onMediaStateChanged(MediaState state) override;
     void onMediaError(MediaError error, const std::string& description = "") override;
     void onAudioFocusEvent(FocusAction action) override;
+    void onMediaPositionChanged(int64_t position) override;
+
+    /// Returns @c true from the time the platform reports the playback started until it reports it stopped.
+    bool isPlaying();
 
 private:
+    std::shared_ptr<aace::audio::AudioOutputEngineInterface> getEngineInterface();
+
     std::shared_ptr<aace::audio::AudioOutput> m_platformAudioOutput;
+    std::shared_ptr<AudioReferenceTap> m_referenceTap;
+
+    /// The interface the events of the platform are forwarded to.
+    std::mutex m_mutex;
+    std::weak_ptr<aace::audio::AudioOutputEngineInterface> m_engineInterface;
+
+    std::atomic<bool> m_playing{false};
 };
 
 }  // namespace audio
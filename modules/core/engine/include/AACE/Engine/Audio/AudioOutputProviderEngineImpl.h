@@ -17,10 +17,14 @@
 #define AACE_ENGINE_AUDIO_AUDIO_OUTPUT_PROVIDER_ENGINE_IMPL_H
 
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 
 #include <AACE/Audio/AudioOutputProvider.h>
 #include "AudioOutputChannelInterface.h"
+#include "AudioOutputEngineImpl.h"
+#include "AudioReferenceTap.h"
 
 namespace aace {
 namespace engine {
@@ -28,22 +32,55 @@ namespace audio {
 
 class AudioOutputProviderEngineImpl {
 public:
+    /**
+     * Creates the engine interface of the platform audio output provider.
+     *
+     * @param platformAudioOutputProviderInterface The platform audio output provider.
+     * @param referenceTap The tap the audio of the outputs is written to, or @c nullptr.
+     */
     static std::shared_ptr<AudioOutputProviderEngineImpl> create(
-        std::shared_ptr<aace::audio::AudioOutputProvider> platformAudioOutputProviderInterface);
+        std::shared_ptr<aace::audio::AudioOutputProvider> platformAudioOutputProviderInterface,
+        std::shared_ptr<AudioReferenceTap> referenceTap = nullptr);
 
     std::shared_ptr<AudioOutputChannelInterface> openChannel(
         const std::string& name,
         aace::audio::AudioOutputProvider::AudioOutputType audioOutputType);
     bool doShutdown();
 
+    /**
+     * Pre-warms the platform channel of a name and type. The channel the components opened with the name and type
+     * is pre-warmed, and otherwise the channel is opened and pre-warmed, and handed to the first component that
+     * opens it.
+     *
+     * @return @c false if the channel couldn't be opened
+     */
+    bool prewarmChannel(const std::string& name, aace::audio::AudioOutputProvider::AudioOutputType audioOutputType);
+
+    /// Returns @c true if the playback of a channel is in progress.
+    bool isPlaying();
+
 private:
     AudioOutputProviderEngineImpl(
-        std::shared_ptr<aace::audio::AudioOutputProvider> platformAudioOutputProviderInterface);
-    std::unordered_map<std::shared_ptr<aace::audio::AudioOutput>, std::shared_ptr<AudioOutputChannelInterface>>
+        std::shared_ptr<aace::audio::AudioOutputProvider> platformAudioOutputProviderInterface,
+        std::shared_ptr<AudioReferenceTap> referenceTap);
+
+    /// Protects the channels.
+    std::mutex m_mutex;
+    std::unordered_map<std::shared_ptr<aace::audio::AudioOutput>, std::shared_ptr<AudioOutputEngineImpl>>
         m_audioOutputMap;
 
+    // the last channel opened with each name, which is not claimed until a component opens it if it was opened to be
+    // pre-warmed
+    struct NamedChannel {
+        aace::audio::AudioOutputProvider::AudioOutputType type;
+        std::shared_ptr<aace::audio::AudioOutput> platformAudioOutput;
+        bool claimed;
+    };
+    std::unordered_map<std::string, NamedChannel> m_namedChannels;
+
 private:
     std::shared_ptr<aace::audio::AudioOutputProvider> m_platformAudioOutputProviderInterface;
+    std::shared_ptr<AudioReferenceTap> m_referenceTap;
 };
 
 }  // namespace audio
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_AUDIO_AUDIO_REFERENCE_TAP_H
+#define AACE_ENGINE_AUDIO_AUDIO_REFERENCE_TAP_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <AACE/Engine/Utils/PCM/PCMUtils.h>
+
+namespace aace {
+namespace engine {
+namespace audio {
+
+/**
+ * Mixes the audio read from the streams of the audio outputs into a timeline of mono audio, which the audio
+ * inputs read the reference signal of their processors from, such as the reference of an echo canceller.
+ *
+ * The audio of a stream is placed on the timeline from the time it is first read, and follows on from there. When
+ * a stream is read slower than it plays, it starts again at the current time. The timeline is the audio read by
+ * the outputs rather than the audio played, so it is ahead of the playback by the buffering of the outputs, which
+ * a processor aligning the reference with the captured echo must account for.
+ */
+class AudioReferenceTap : public std::enable_shared_from_this<AudioReferenceTap> {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// The duration of the timeline, by default
+    static constexpr std::chrono::milliseconds DEFAULT_DURATION{2000};
+
+    /// The audio of a stream, written to the timeline by the thread reading the stream.
+    class Source {
+    public:
+        /**
+         * Writes the next bytes read from the stream, of interleaved 16-bit samples.
+         *
+         * @param now The time the bytes were read.
+         */
+        void write(const char* data, size_t size, Clock::time_point now = Clock::now());
+
+    private:
+        friend class AudioReferenceTap;
+
+        Source(std::shared_ptr<AudioReferenceTap> tap, uint32_t sampleRate, uint32_t channels);
+
+        std::shared_ptr<AudioReferenceTap> m_tap;
+        const uint32_t m_channels;
+        std::unique_ptr<aace::engine::utils::pcm::Resampler> m_resampler;
+
+        // the bytes of a frame split between two reads
+        std::vector<char> m_partial;
+        std::vector<int16_t> m_mixBuffer;
+        std::vector<int16_t> m_resampleBuffer;
+
+        // the position on the timeline of the next sample, or -1 before the first write
+        int64_t m_position = -1;
+    };
+
+    /**
+     * Creates a timeline of the audio of a sample rate.
+     *
+     * @param sampleRate The sample rate of the reference read by the inputs.
+     * @param duration The duration of the timeline, half of which can be written ahead of the time.
+     * @return The timeline, or @c nullptr if the arguments are invalid.
+     */
+    static std::shared_ptr<AudioReferenceTap> create(
+        uint32_t sampleRate,
+        std::chrono::milliseconds duration = DEFAULT_DURATION);
+
+    /**
+     * Creates the source of a stream of 16-bit samples.
+     *
+     * @return The source, or @c nullptr if the format is not supported.
+     */
+    std::shared_ptr<Source> createSource(uint32_t sampleRate, uint32_t channels);
+
+    /**
+     * Reads the reference ending at a time, with silence where no stream was playing.
+     *
+     * @param output The buffer of @c count samples.
+     * @param count The number of samples, of the audio captured until @c now.
+     * @param now The time the audio was captured.
+     */
+    void read(int16_t* output, size_t count, Clock::time_point now = Clock::now());
+
+    uint32_t getSampleRate() const;
+
+private:
+    AudioReferenceTap(uint32_t sampleRate, size_t size, Clock::time_point origin);
+
+    /// Returns the position on the timeline of a time.
+    int64_t toPosition(Clock::time_point time) const;
+
+    /// Mixes samples into the timeline from a position, and returns the position following them.
+    int64_t mix(int64_t position, const int16_t* samples, size_t count, Clock::time_point now);
+
+    const uint32_t m_sampleRate;
+    const Clock::time_point m_origin;
+
+    std::mutex m_mutex;
+    std::vector<int16_t> m_timeline;
+    // the position following the last sample written, before which the timeline holds its audio
+    int64_t m_end = 0;
+};
+
+}  // namespace audio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_AUDIO_AUDIO_REFERENCE_TAP_H
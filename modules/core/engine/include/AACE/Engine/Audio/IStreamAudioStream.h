@@ -16,26 +16,46 @@
 #ifndef AACE_ENGINE_AUDIO_ISTREAM_AUDIO_STREAM_H
 #define AACE_ENGINE_AUDIO_ISTREAM_AUDIO_STREAM_H
 
+#include <chrono>
 #include <memory>
 #include <istream>
 
 #include <AACE/Audio/AudioStream.h>
 
+#include "ReadAheadBuffer.h"
+
 namespace aace {
 namespace engine {
 namespace audio {
 
+/**
+ * An @c AudioStream reading a @c std::istream.
+ *
+ * By default each read of the platform reads the stream. With a read ahead size, a filler thread reads the
+ * stream into a ring buffer of that size, and the reads of the platform are served from the buffer, so they
+ * don't wait for the file I/O of the stream.
+ */
 class IStreamAudioStream : public aace::audio::AudioStream {
 private:
     IStreamAudioStream(std::shared_ptr<std::istream> stream, const AudioFormat& audioFormat);
 
 public:
+    /**
+     * Creates an audio stream.
+     *
+     * @param stream The stream to read.
+     * @param audioFormat The format of the audio of the stream.
+     * @param readAheadSize The size of the read ahead buffer in bytes, or 0 to read the stream on each read.
+     * @returns The audio stream, or @c nullptr if the read ahead buffer can't be created.
+     */
     static std::shared_ptr<IStreamAudioStream> create(
         std::shared_ptr<std::istream> stream,
-        const AudioFormat& audioFormat = aace::audio::AudioFormat::UNKNOWN);
+        const AudioFormat& audioFormat = aace::audio::AudioFormat::UNKNOWN,
+        size_t readAheadSize = 0);
 
     // aace::audio::AudioStream
     ssize_t read(char* data, const size_t size) override;
+    ssize_t timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) override;
     bool isClosed() override;
     AudioFormat getAudioFormat() override;
 
@@ -43,6 +63,9 @@ private:
     std::shared_ptr<std::istream> m_stream;
     AudioFormat m_audioFormat;
     bool m_closed;
+
+    /// The read ahead buffer, which reads the stream if it is enabled.
+    std::unique_ptr<ReadAheadBuffer> m_readAhead;
 };
 
 }  // namespace audio
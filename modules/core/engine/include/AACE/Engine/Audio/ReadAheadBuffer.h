@@ -0,0 +1,111 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_AUDIO_READ_AHEAD_BUFFER_H
+#define AACE_ENGINE_AUDIO_READ_AHEAD_BUFFER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <AACE/Engine/Utils/Threading/Executor.h>
+
+namespace aace {
+namespace engine {
+namespace audio {
+
+/**
+ * A ring buffer read ahead of the reader of an audio source.
+ *
+ * A filler thread reads the source into the free space of the buffer, in chunks of up to a quarter of the
+ * buffer, and waits while the buffer is full. The reader, such as the audio thread of the platform, only
+ * copies from the buffer, and waits for the filler when the buffer is empty, so its reads never block on the
+ * I/O of the source.
+ */
+class ReadAheadBuffer {
+public:
+    /**
+     * Reads the source, which is only called by the filler thread.
+     *
+     * @param data The buffer the data is copied to.
+     * @param size The size of the buffer.
+     * @param closed Set to @c true when the source has no more data.
+     * @returns The number of bytes read.
+     */
+    using Source = std::function<size_t(char* data, size_t size, bool& closed)>;
+
+    /**
+     * Creates a read ahead buffer, and starts reading the source.
+     *
+     * @param capacity The size of the buffer in bytes.
+     * @param source The source to read.
+     * @returns The buffer, or @c nullptr if the capacity is 0 or the source is empty.
+     */
+    static std::unique_ptr<ReadAheadBuffer> create(size_t capacity, Source source);
+
+    /// Stops the filler, after the running read of the source has returned.
+    ~ReadAheadBuffer();
+
+    /**
+     * Reads the buffered data, waiting for the filler while the buffer is empty.
+     *
+     * @param data The buffer the data is copied to.
+     * @param size The size of the buffer.
+     * @param timeout The longest time to wait for data.
+     * @returns The number of bytes read, 0 if no data was read before the timeout or the source is drained.
+     */
+    ssize_t read(char* data, size_t size, std::chrono::milliseconds timeout);
+
+    /// Returns @c true once the source has no more data and the buffer has been read, or after @c close().
+    bool isClosed();
+
+    /// Stops the filler, and discards the buffered data. The source must stop blocking for the call to return.
+    void close();
+
+    /// Returns the number of bytes buffered.
+    size_t size();
+
+private:
+    ReadAheadBuffer(size_t capacity, Source source);
+
+    /// Reads the source until it is closed, on the filler thread.
+    void fill();
+
+    Source m_source;
+    std::vector<char> m_buffer;
+
+    /// Protects the positions and the state, and signals the reader and the filler.
+    std::mutex m_mutex;
+    std::condition_variable m_dataAvailable;
+    std::condition_variable m_spaceAvailable;
+    size_t m_readPosition = 0;
+    size_t m_size = 0;
+    bool m_drained = false;
+    bool m_closed = false;
+
+    /// The filler thread. The executor must be declared last to be destructed first.
+    aace::engine::utils::threading::Executor m_executor;
+};
+
+}  // namespace audio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_AUDIO_READ_AHEAD_BUFFER_H
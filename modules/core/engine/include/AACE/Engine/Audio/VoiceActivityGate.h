@@ -0,0 +1,116 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_AUDIO_VOICE_ACTIVITY_GATE_H
+#define AACE_ENGINE_AUDIO_VOICE_ACTIVITY_GATE_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace aace {
+namespace engine {
+namespace audio {
+
+/**
+ * Holds back the audio written to a wakeword stream while it is silent.
+ *
+ * The gate measures the level of each 10 ms block of audio. The gate opens when a block is above the threshold,
+ * and closes when the audio stays under the threshold for the hangover time. While the gate is closed, the audio
+ * is kept in a pre-roll buffer instead of being written, so the readers of the stream, such as the wakeword
+ * engines, block on the stream rather than processing silence. When the gate opens, the pre-roll is written
+ * before the audio that opened it, so the start of a wakeword isn't clipped.
+ *
+ * The gate is not thread safe: @c process() is called by the thread writing the audio.
+ */
+class VoiceActivityGate {
+public:
+    /// The level in dBFS above which audio is voice, by default
+    static constexpr float DEFAULT_THRESHOLD = -50.0f;
+
+    /// The audio written when the gate opens, by default
+    static constexpr std::chrono::milliseconds DEFAULT_PRE_ROLL{500};
+
+    /// The silence after which the gate closes, by default
+    static constexpr std::chrono::milliseconds DEFAULT_HANGOVER{1000};
+
+    struct Config {
+        Config(
+            bool enabled = false,
+            float threshold = DEFAULT_THRESHOLD,
+            std::chrono::milliseconds preRoll = DEFAULT_PRE_ROLL,
+            std::chrono::milliseconds hangover = DEFAULT_HANGOVER) :
+                enabled(enabled), threshold(threshold), preRoll(preRoll), hangover(hangover) {
+        }
+
+        bool enabled;
+        float threshold;
+        std::chrono::milliseconds preRoll;
+        std::chrono::milliseconds hangover;
+    };
+
+    /// Writes samples to the stream, and returns the number of samples written, or a negative value on error
+    using Writer = std::function<ssize_t(const int16_t* data, size_t size)>;
+
+    /**
+     * Creates a gate for 16-bit mono audio.
+     *
+     * @return The gate, or @c nullptr if the configuration is invalid.
+     */
+    static std::unique_ptr<VoiceActivityGate> create(uint32_t sampleRate, const Config& config);
+
+    /**
+     * Processes the next samples of the audio, and writes the samples passing the gate with @c writer.
+     *
+     * @param data The samples.
+     * @param size The number of samples.
+     * @param bypass Whether all the samples are written, such as while the speech of a capture is streamed. The
+     * gate is open at the end of a bypass, and closes after the hangover time of silence.
+     * @param writer The function writing the samples to the stream.
+     * @return @c size, or -1 if @c writer failed.
+     */
+    ssize_t process(const int16_t* data, size_t size, bool bypass, const Writer& writer);
+
+    /// Returns @c true if the gate is open.
+    bool isOpen() const;
+
+private:
+    VoiceActivityGate(size_t blockSize, size_t preRollSize, size_t hangoverSize, float threshold);
+
+    bool openGate(const Writer& writer, bool writePreRoll);
+    void addToPreRoll(const int16_t* data, size_t size);
+
+    const size_t m_blockSize;
+    const size_t m_hangoverSize;
+    const float m_threshold;
+
+    // the pre-roll ring buffer, of the last samples held back
+    std::vector<int16_t> m_preRoll;
+    size_t m_preRollStart = 0;
+    size_t m_preRollCount = 0;
+
+    bool m_open = false;
+    size_t m_silentSamples = 0;
+};
+
+}  // namespace audio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_AUDIO_VOICE_ACTIVITY_GATE_H
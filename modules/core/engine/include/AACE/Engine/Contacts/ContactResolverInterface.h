@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_CONTACTS_CONTACT_RESOLVER_INTERFACE_H
+#define AACE_ENGINE_CONTACTS_CONTACT_RESOLVER_INTERFACE_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace contacts {
+
+/**
+ * Resolves a spoken or typed name against the contacts of the connected devices, on the device. The services that
+ * call or message contacts, such as phone control and messaging, get it with
+ * @c getServiceInterface<ContactResolverInterface>("aace.addressBook"), and can disambiguate a name before the cloud
+ * has the contacts.
+ */
+class ContactResolverInterface {
+public:
+    /// How a contact matched the name
+    enum class MatchType {
+        /// Every word of the name is a word of the contact name
+        EXACT,
+        /// Every word of the name starts a word of the contact name
+        PREFIX,
+        /// Some word of the name only sounds like a word of the contact name
+        PHONETIC
+    };
+
+    /// A contact matching a name
+    struct Match {
+        /// The address book source of the contact
+        std::string addressBookSourceId;
+        /// The id of the contact in its address book
+        std::string entryId;
+        /// The name of the contact
+        std::string name;
+        /// The phone numbers of the contact
+        std::vector<std::string> phoneNumbers;
+        MatchType matchType;
+    };
+
+    virtual ~ContactResolverInterface() = default;
+
+    /**
+     * Resolves a name against the contacts.
+     *
+     * @param name The name, such as "john" or "jon smith".
+     * @param maxMatches The largest number of matches returned.
+     * @return The contacts matching the name, the best matches first.
+     */
+    virtual std::vector<Match> resolve(const std::string& name, size_t maxMatches) = 0;
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const ContactResolverInterface::MatchType& matchType) {
+    switch (matchType) {
+        case ContactResolverInterface::MatchType::EXACT:
+            stream << "EXACT";
+            break;
+        case ContactResolverInterface::MatchType::PREFIX:
+            stream << "PREFIX";
+            break;
+        case ContactResolverInterface::MatchType::PHONETIC:
+            stream << "PHONETIC";
+            break;
+    }
+    return stream;
+}
+
+}  // namespace contacts
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_CONTACTS_CONTACT_RESOLVER_INTERFACE_H
@@ -16,16 +16,23 @@
 #ifndef AACE_ENGINE_CORE_ENGINE_IMPL_H
 #define AACE_ENGINE_CORE_ENGINE_IMPL_H
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include <AACE/Core/Engine.h>
 #include <AACE/Core/MessageBroker.h>
 #include <AACE/Logger/Logger.h>
 #include <AACE/Engine/PropertyManager/PropertyManagerServiceInterface.h>
 #include <AACE/Engine/MessageBroker/MessageBrokerServiceInterface.h>
+#include <AACE/Engine/Utils/JSON/JSON.h>
 #include "EngineServiceManager.h"
+#include "EngineServiceScheduler.h"
 #include "ServiceDescription.h"
 
 namespace aace {
@@ -53,12 +60,16 @@ public:
         std::initializer_list<std::shared_ptr<aace::core::PlatformInterface>> platformInterfaceList) override;
     bool start() override;
     bool stop() override;
+    bool suspend() override;
+    bool resume() override;
+    bool reportMemoryPressure(MemoryPressureLevel level) override;
     bool shutdown() override;
 
     std::shared_ptr<aace::core::MessageBroker> getMessageBroker() override;
 
     // MessageBroker implementation
     void publish(const std::string& message) override;
+    void publishBatch(const std::vector<std::string>& messages, bool coalesce = false) override;
     void subscribe(MessageHandler handler, const std::string& topic = "", const std::string& action = "") override;
     std::shared_ptr<aace::core::MessageStream> openStream(
         const std::string& streamId,
@@ -72,8 +83,31 @@ protected:
     std::shared_ptr<EngineServiceContext> getService(const std::string& type) override;
 
 private:
+    /// When a service is started, in the order of precedence of the dependencies
+    enum class StartPolicy {
+        /// Started by @c start(), before the engine is running
+        EAGER,
+        /// Started in the background once the engine is running
+        DEFERRED,
+        /// Started when another component first gets the service, once the engine is running
+        ON_FIRST_USE
+    };
+
     bool initialize();
     bool checkServices();
+    bool createServiceScheduler(bool parallel, size_t threadCount);
+    bool createShutdownScheduler(bool parallel, size_t threadCount);
+    EngineServiceScheduler::Handler createShutdownHandler(std::function<bool(std::shared_ptr<EngineService>)> handler);
+    bool stop(std::chrono::steady_clock::time_point deadline);
+    void abandonServices(const std::vector<std::string>& types);
+    bool isConfigurationCached(
+        const std::vector<std::shared_ptr<aace::core::config::EngineConfiguration>>& configurationList);
+    bool resolveStartPolicies(std::unordered_map<std::string, StartPolicy> policies);
+    StartPolicy getStartPolicy(const std::string& type);
+    bool startService(std::shared_ptr<EngineService> service);
+    void startDeferredServices();
+    void finishBootTrace();
+    bool configureTrace(const aace::engine::utils::json::Value& traceConfig);
 
     std::shared_ptr<EngineService> getServiceFromPropertyKey(const std::string& key);
     bool registerProperties();
@@ -83,11 +117,42 @@ private:
     std::vector<std::shared_ptr<EngineService>> m_orderedServiceList;
     std::weak_ptr<aace::engine::messageBroker::MessageBrokerServiceInterface> m_messageBrokerService;
 
+    // the merged configuration, and the configuration objects it was parsed from
+    std::shared_ptr<const aace::engine::utils::json::Value> m_configuration;
+    std::vector<std::weak_ptr<aace::core::config::EngineConfiguration>> m_configurationSources;
+
+    // dispatches the configure, setup and start events to the services
+    std::unique_ptr<EngineServiceScheduler> m_serviceScheduler;
+
+    // dispatches the stop and shutdown events to the services, in the reverse order of the dependencies if parallel
+    std::unique_ptr<EngineServiceScheduler> m_shutdownScheduler;
+    bool m_reversedShutdown = false;
+
+    // the time the stop and shutdown of the services take at most, or zero if they are not bounded
+    std::chrono::milliseconds m_shutdownTimeout{0};
+
+    // the services that are not started eagerly, and the thread starting the deferred services
+    std::unordered_map<std::string, StartPolicy> m_startPolicies;
+    std::recursive_mutex m_serviceStartMutex;
+    std::thread m_deferredStartThread;
+    std::atomic<bool> m_stoppingServices{false};
+
+    // the file the boot trace is written to, or empty if it is not written
+    std::string m_bootTraceFile;
+
+    // whether the engine started the boot trace and the engine trace, which are shared by the engines of the process
+    bool m_bootTraceOwner = false;
+    bool m_traceOwner = false;
+
+    // the file the engine trace is written to when the engine shuts down, or empty if it is not written
+    std::string m_traceFile;
+
     // engine flags
     bool m_running = false;
     bool m_initialized = false;
     bool m_configured = false;
     bool m_setup = false;
+    bool m_suspended = false;
 };
 
 }  // namespace core
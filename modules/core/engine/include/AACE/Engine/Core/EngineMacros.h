@@ -83,12 +83,29 @@
 // logging
 #define AACE_LOGGER (aace::engine::logger::EngineLogger::getInstance())
 #define AACE_LOG_LEVEL aace::engine::logger::EngineLogger::Level
-#define AACE_LOG(level, entry)          \
-    do {                                \
-        AACE_LOGGER->log(level, entry); \
+
+// the entry is only built if a sink or observer accepts the level
+#define AACE_LOG(level, entry)                                           \
+    do {                                                                 \
+        if (aace::engine::logger::EngineLogger::isLevelEnabled(level)) { \
+            AACE_LOGGER->log(level, entry);                              \
+        }                                                                \
+    } while (false)
+
+// compiled out log statement, the entry is still type checked
+#define AACE_LOG_DISABLED(level, entry)     \
+    do {                                    \
+        if (false) {                        \
+            AACE_LOGGER->log(level, entry); \
+        }                                   \
     } while (false)
 
-#ifdef AACE_DEBUG_LOG_ENABLED
+// levels below the compile-time threshold are compiled out (0=VERBOSE, 1=INFO, 3=WARN, 4=ERROR)
+#ifndef AAC_LOG_LEVEL_THRESHOLD
+#define AAC_LOG_LEVEL_THRESHOLD 0
+#endif
+
+#if defined(AACE_DEBUG_LOG_ENABLED) && AAC_LOG_LEVEL_THRESHOLD <= 0
 #define AACE_DEBUG(entry) AACE_LOG(AACE_LOG_LEVEL::VERBOSE, entry)
 #define AACE_VERBOSE(entry) AACE_LOG(AACE_LOG_LEVEL::VERBOSE, entry)
 #else  // AACE_DEBUG_LOG_ENABLED
@@ -102,10 +119,29 @@
 #define AACE_METRIC(entry)
 #endif  // AAC_LATENCY_LOGS_ENABLED
 
+#if AAC_LOG_LEVEL_THRESHOLD <= 1
 #define AACE_INFO(entry) AACE_LOG(AACE_LOG_LEVEL::INFO, entry)
+#else
+#define AACE_INFO(entry) AACE_LOG_DISABLED(AACE_LOG_LEVEL::INFO, entry)
+#endif
+
+#if AAC_LOG_LEVEL_THRESHOLD <= 3
 #define AACE_WARN(entry) AACE_LOG(AACE_LOG_LEVEL::WARN, entry)
+#else
+#define AACE_WARN(entry) AACE_LOG_DISABLED(AACE_LOG_LEVEL::WARN, entry)
+#endif
+
+#if AAC_LOG_LEVEL_THRESHOLD <= 4
 #define AACE_ERROR(entry) AACE_LOG(AACE_LOG_LEVEL::ERROR, entry)
-#define AACE_CRITICAL(entry) AACE_LOG(AACE_LOG_LEVEL::CRITICAL, entry)
+#else
+#define AACE_ERROR(entry) AACE_LOG_DISABLED(AACE_LOG_LEVEL::ERROR, entry)
+#endif
+
+// critical entries are always logged, since they may abort after emission
+#define AACE_CRITICAL(entry)                               \
+    do {                                                   \
+        AACE_LOGGER->log(AACE_LOG_LEVEL::CRITICAL, entry); \
+    } while (false)
 
 // creates a log event for the aace logger
 #define LX(...) macro_dispatcher(LX, __VA_ARGS__)(__VA_ARGS__)
@@ -117,4 +153,39 @@
 #define AACE_NOT_REACHED AACE_CRITICAL(DX.m("notReached").d("line", __LINE__).abortAfterEmission())
 #define AACE_NOT_IMPLEMENTED AACE_CRITICAL(DX.m("notImplemented").d("line", __LINE__).abortAfterEmission())
 
+// trace points, compiled out unless the engine is built with the trace points enabled
+#ifdef AAC_TRACE_ENABLED
+#include "AACE/Engine/Utils/Trace/EngineTrace.h"
+
+#define AACE_TRACE_CONCAT(a, b) AACE_TRACE_CONCAT_(a, b)
+#define AACE_TRACE_CONCAT_(a, b) a##b
+
+#define AACE_TRACE_BEGIN(category, name)                                    \
+    do {                                                                    \
+        if (aace::engine::utils::trace::EngineTrace::isRecording()) {       \
+            aace::engine::utils::trace::EngineTrace::begin(category, name); \
+        }                                                                   \
+    } while (false)
+#define AACE_TRACE_END(category)                                      \
+    do {                                                              \
+        if (aace::engine::utils::trace::EngineTrace::isRecording()) { \
+            aace::engine::utils::trace::EngineTrace::end(category);   \
+        }                                                             \
+    } while (false)
+#define AACE_TRACE_COUNTER(category, name, value)                                    \
+    do {                                                                             \
+        if (aace::engine::utils::trace::EngineTrace::isRecording()) {                \
+            aace::engine::utils::trace::EngineTrace::counter(category, name, value); \
+        }                                                                            \
+    } while (false)
+// records an event from the trace point to the end of the enclosing scope
+#define AACE_TRACE_SCOPE(category, name) \
+    aace::engine::utils::trace::EngineTrace::Scope AACE_TRACE_CONCAT(aaceTraceScope, __LINE__)(category, name)
+#else  // AAC_TRACE_ENABLED
+#define AACE_TRACE_BEGIN(category, name)
+#define AACE_TRACE_END(category)
+#define AACE_TRACE_COUNTER(category, name, value)
+#define AACE_TRACE_SCOPE(category, name)
+#endif  // AAC_TRACE_ENABLED
+
 #endif  // AACE_ENGINE_CORE_ENGINE_EXCEPTIONS_H
@@ -28,6 +28,7 @@
 #include <iostream>
 
 #include "AACE/Engine/Core/ServiceDescription.h"
+#include "AACE/Engine/Utils/JSON/JSON.h"
 #include "AACE/Core/PlatformInterface.h"
 
 namespace aace {
@@ -83,11 +84,21 @@ protected:
     virtual bool initialize();
     virtual bool configure();
     virtual bool configure(std::shared_ptr<std::istream> configuration);
+    // configures the service with its object of the parsed engine configuration, which is only valid during the call;
+    // the default implementation serializes the object for configure(std::shared_ptr<std::istream>)
+    virtual bool configureFromJson(const aace::engine::utils::json::Value& configuration);
     virtual bool preRegister();
     virtual bool postRegister();
     virtual bool setup();
     virtual bool start();
     virtual bool stop();
+    // suspends the running service while the device sleeps, without releasing its state; the service closes its
+    // network connections and pauses its periodic work, and resume() restores them without setting up the service
+    virtual bool suspend();
+    virtual bool resume();
+    // called before any service stops when the engine shuts down with a deadline; the service cancels the operations
+    // that would delay its stop and shutdown, such as network requests and retries, and must not block
+    virtual bool prepareShutdown();
     virtual bool shutdown();
     virtual bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface);
     virtual bool engineStarted();
@@ -135,12 +146,15 @@ protected:
 
 private:
     bool handleInitializeEngineEvent(std::shared_ptr<aace::engine::core::EngineContext> context);
-    bool handleConfigureEngineEvent(std::shared_ptr<std::istream> configuration);
+    bool handleConfigureEngineEvent(const aace::engine::utils::json::Value* configuration);
     bool handlePreRegisterEngineEvent();
     bool handlePostRegisterEngineEvent();
     bool handleSetupEngineEvent();
     bool handleStartEngineEvent();
     bool handleStopEngineEvent();
+    bool handleSuspendEngineEvent();
+    bool handleResumeEngineEvent();
+    bool handlePrepareShutdownEngineEvent();
     bool handleShutdownEngineEvent();
     bool handleRegisterPlatformInterfaceEngineEvent(std::shared_ptr<aace::core::PlatformInterface> platformInterface);
     bool handleEngineStartedEngineEvent();
@@ -153,6 +167,7 @@ private:
 
     bool m_initialized;
     bool m_running;
+    bool m_suspended = false;
 
     // service factory map
     std::unordered_map<std::string, std::unordered_map<std::string, ServiceFactory>> m_serviceFactoryMap;
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_CORE_ENGINE_SERVICE_SCHEDULER_H
+#define AACE_ENGINE_CORE_ENGINE_SERVICE_SCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace core {
+
+/**
+ * Dispatches an engine event, such as configure or start, to each engine service in the order of their dependencies.
+ *
+ * In serial mode the services handle the event one after the other, in the order of the service list. In parallel
+ * mode a service handles the event on a worker thread as soon as all the services it depends on have handled it, so
+ * the services that don't depend on each other handle it concurrently. In both modes the event is not dispatched to
+ * the services that have not started handling it once a service fails, and the time each service took is logged
+ * and recorded in the boot trace.
+ *
+ * An event can be dispatched with a deadline, such as the shutdown in the power down budget of the device. The event
+ * is then not dispatched to the services that have not started handling it by the deadline. In parallel mode @c run()
+ * also returns at the deadline without waiting for the services still handling the event, which complete on their
+ * worker thread in the background. The scheduler doesn't refer to the handler once it returns, and the workers keep
+ * their own copy of it, so the handler must not refer to the state of its caller.
+ */
+class EngineServiceScheduler {
+public:
+    /// A service of the schedule
+    struct Service {
+        /// The type of the service, from its @c ServiceDescription
+        std::string type;
+        /// The indices in the service list of the services it depends on
+        std::vector<size_t> dependencies;
+    };
+
+    /// The time a service took to handle an event
+    struct Timing {
+        std::string type;
+        std::chrono::microseconds duration;
+        bool success;
+    };
+
+    /// Handles the event for the service at @c index of the service list, and returns @c false on failure
+    using Handler = std::function<bool(size_t index)>;
+
+    /**
+     * Creates a scheduler.
+     *
+     * @param services The services, in an order where each service is after all the services it depends on.
+     * @param threadCount The number of worker threads of the parallel mode, or 0 for the serial mode.
+     * @return The scheduler, or @c nullptr if a service depends on a service that is not before it.
+     */
+    static std::unique_ptr<EngineServiceScheduler> create(std::vector<Service> services, size_t threadCount = 0);
+
+    /**
+     * Dispatches an event to all the services, and returns when they have handled it.
+     *
+     * @param event The name of the event, for the timing report.
+     * @param handler The function handling the event for a service.
+     * @return @c true if all the services handled the event.
+     */
+    bool run(const std::string& event, const Handler& handler);
+
+    /**
+     * Dispatches an event to all the services, and returns when they have handled it or at the deadline.
+     *
+     * @param event The name of the event, for the timing report.
+     * @param handler The function handling the event for a service.
+     * @param deadline The time to stop dispatching the event.
+     * @return @c true if all the services handled the event by the deadline.
+     */
+    bool run(const std::string& event, const Handler& handler, std::chrono::steady_clock::time_point deadline);
+
+    /// Returns the times of the services that handled the last event, in the order they completed.
+    std::vector<Timing> getTimings() const;
+
+    /// Returns the services that were still handling the last event at its deadline, or had not started handling it.
+    std::vector<std::string> getTimedOut() const;
+
+    /// Returns @c true if the services handle the events concurrently.
+    bool isParallel() const;
+
+private:
+    /// The state of a parallel run, shared with the workers
+    struct ParallelRun;
+
+    EngineServiceScheduler(std::vector<Service> services, size_t threadCount);
+
+    bool runSerial(const std::string& event, const Handler& handler, std::chrono::steady_clock::time_point deadline);
+    bool runParallel(
+        const std::string& event,
+        const Handler& handler,
+        std::chrono::steady_clock::time_point deadline);
+    static void schedule(const std::shared_ptr<ParallelRun>& run, size_t index);
+    static bool invoke(
+        const std::string& event,
+        const Handler& handler,
+        size_t index,
+        const std::string& type,
+        Timing& timing);
+    void report(const std::string& event, std::chrono::microseconds elapsed) const;
+
+    const std::vector<Service> m_services;
+
+    /// The indices of the services depending on each service
+    std::vector<std::vector<size_t>> m_dependents;
+
+    const size_t m_threadCount;
+
+    std::vector<Timing> m_timings;
+    std::vector<std::string> m_timedOut;
+};
+
+}  // namespace core
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_CORE_ENGINE_SERVICE_SCHEDULER_H
@@ -16,10 +16,17 @@
 #ifndef AACE_ENGINE_DEVICEUSAGE_DEVICEUSAGEENGINEIMPL_H_
 #define AACE_ENGINE_DEVICEUSAGE_DEVICEUSAGEENGINEIMPL_H_
 
+#include <chrono>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
 
 #include "AACE/DeviceUsage/DeviceUsage.h"
 #include "AACE/DeviceUsage/DeviceUsageEngineInterfaces.h"
+#include "AACE/Engine/Utils/Threading/TimerWheel.h"
 
 namespace aace {
 namespace engine {
@@ -28,31 +35,78 @@ namespace deviceUsage {
 class DeviceUsageEngineImpl
         : public aace::deviceUsage::DeviceUsageEngineInterface
         , public std::enable_shared_from_this<DeviceUsageEngineImpl> {
+public:
+    /// The fields of a network data usage report used by the metrics
+    struct NetworkDataUsage {
+        int64_t startTimeStamp = 0;
+        int64_t endTimeStamp = 0;
+        std::string networkInterfaceType;
+        std::string dataPlanType;
+        int64_t rxBytes = 0;
+        int64_t txBytes = 0;
+    };
+
 private:
     /**
      * Constructor.
      */
-    DeviceUsageEngineImpl(std::shared_ptr<aace::deviceUsage::DeviceUsage> deviceUsagePlatformInterface);
+    DeviceUsageEngineImpl(
+        std::shared_ptr<aace::deviceUsage::DeviceUsage> deviceUsagePlatformInterface,
+        std::chrono::milliseconds aggregationPeriod);
 
 public:
     /**
      * Factory method for creating instance of @c DeviceUsageEngineImpl
+     *
+     * @param deviceUsagePlatformInterface The DeviceUsage platform interface
+     * @param aggregationPeriod The period the reported usage is summed over before its metrics are emitted, per
+     *        network interface and data plan. A period of @c 0, the default, emits the metrics of each report.
+     * @param timerWheel The timer wheel running the periodic flush, or @c nullptr for the default timer wheel.
      */
     static std::shared_ptr<DeviceUsageEngineImpl> create(
-        std::shared_ptr<aace::deviceUsage::DeviceUsage> deviceUsagePlatformInterface);
+        std::shared_ptr<aace::deviceUsage::DeviceUsage> deviceUsagePlatformInterface,
+        std::chrono::milliseconds aggregationPeriod = std::chrono::milliseconds::zero(),
+        std::shared_ptr<aace::engine::utils::threading::TimerWheel> timerWheel = nullptr);
+
+    /**
+     * Extracts the fields used by the metrics from a network data usage report. The report is parsed as a stream of
+     * events, so the values of the other fields are skipped without being built.
+     *
+     * @param [in] usage The network data usage JSON reported by the platform
+     * @param [out] dataUsage The extracted fields
+     * @throw std::exception if the JSON is invalid or a required field is missing or invalid
+     */
+    static void parseNetworkDataUsage(const std::string& usage, NetworkDataUsage& dataUsage);
 
-    virtual ~DeviceUsageEngineImpl() = default;
+    virtual ~DeviceUsageEngineImpl();
 
     /// @name DeviceUsageEngineInterface Functions
     /// @{
     void onReportNetworkDataUsage(const std::string& usage) override;
     /// @}
 
+    /// Emits the metrics of the usage aggregated since the last flush.
+    void flush();
+
     void doShutdown();
 
 private:
+    /// Emits the metrics of a usage, a single report or an aggregate.
+    static void emitMetrics(const NetworkDataUsage& dataUsage);
+
     /// Auto SDK DeviceUsage platform interface handler instance.
     std::shared_ptr<aace::deviceUsage::DeviceUsage> m_deviceUsagePlatformInterface;
+
+    /// The period the usage is aggregated over, or @c 0 to emit the metrics of each report
+    std::chrono::milliseconds m_aggregationPeriod;
+
+    /// The usage reported since the last flush, keyed by network interface type and data plan type
+    std::map<std::pair<std::string, std::string>, NetworkDataUsage> m_aggregatedUsage;
+    std::mutex m_mutex;
+
+    /// The timer wheel running the periodic flush, and the timer of the flush
+    std::shared_ptr<aace::engine::utils::threading::TimerWheel> m_timerWheel;
+    aace::engine::utils::threading::TimerWheel::TimerId m_flushTimer;
 };
 
 }  // namespace deviceUsage
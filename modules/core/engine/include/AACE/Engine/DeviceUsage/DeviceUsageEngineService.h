@@ -19,6 +19,7 @@
 #include "AACE/Engine/Core/EngineService.h"
 #include "AACE/DeviceUsage/DeviceUsage.h"
 #include "AACE/Engine/DeviceUsage/DeviceUsageEngineImpl.h"
+#include "AACE/Engine/Utils/JSON/JSON.h"
 
 namespace aace {
 namespace engine {
@@ -36,6 +37,7 @@ public:
 
 protected:
     bool initialize() override;
+    bool configureFromJson(const aace::engine::utils::json::Value& configuration) override;
     bool shutdown() override;
     bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) override;
 
@@ -51,6 +53,9 @@ private:
 
     /// Engine implementation object references.
     std::shared_ptr<aace::engine::deviceUsage::DeviceUsageEngineImpl> m_deviceUsageEngineImpl;
+
+    /// The period the reported network data usage is aggregated over, or zero to emit the metrics of each report
+    std::chrono::milliseconds m_aggregationPeriod = std::chrono::milliseconds::zero();
 };
 
 }  // namespace deviceUsage
@@ -34,6 +34,7 @@ public:
     virtual ~LocationEngineService() = default;
 
 protected:
+    bool configureFromJson(const aace::engine::utils::json::Value& configuration) override;
     bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) override;
     bool shutdown() override;
 
@@ -49,6 +50,9 @@ private:
 
 private:
     std::shared_ptr<aace::engine::location::LocationProviderEngineImpl> m_locationProviderEngineImpl;
+
+    // the maximum age of the cached location, or zero to query the platform for each location request
+    std::chrono::milliseconds m_locationCacheMaxAge = std::chrono::milliseconds::zero();
 };
 
 }  // namespace location
@@ -16,6 +16,7 @@
 #ifndef AACE_ENGINE_LOCATION_LOCATION_PROVIDER_ENGINE_IMPL_H
 #define AACE_ENGINE_LOCATION_LOCATION_PROVIDER_ENGINE_IMPL_H
 
+#include <chrono>
 #include <unordered_set>
 #include <mutex>
 #include <memory>
@@ -33,11 +34,22 @@ class LocationProviderEngineImpl
         : public aace::location::LocationProviderEngineInterface
         , public LocationServiceInterface {
 private:
-    LocationProviderEngineImpl(std::shared_ptr<aace::location::LocationProvider> platfromInterface);
+    LocationProviderEngineImpl(
+        std::shared_ptr<aace::location::LocationProvider> platfromInterface,
+        std::chrono::milliseconds maxAge);
 
 public:
+    /**
+     * Creates the location provider engine implementation.
+     *
+     * @param platformInterface The platform location provider
+     * @param maxAge The maximum age of a cached location, pushed by the platform with @c locationChanged() or
+     *        returned by the last @c getLocation() of the platform, to answer a location request without calling
+     *        the platform. Zero disables the cache, so each request calls the platform.
+     */
     static std::shared_ptr<LocationProviderEngineImpl> create(
-        std::shared_ptr<aace::location::LocationProvider> platformInterface);
+        std::shared_ptr<aace::location::LocationProvider> platformInterface,
+        std::chrono::milliseconds maxAge = std::chrono::milliseconds::zero());
     virtual ~LocationProviderEngineImpl() = default;
 
     // aace::engine::location::LocationServiceInterface
@@ -47,13 +59,23 @@ public:
 
     // LocationProviderEngineInterface
     virtual void onLocationServiceAccessChanged(LocationServiceAccess access) override;
+    void onLocationChanged(const aace::location::Location& location) override;
 
     void shutdown();
 
 private:
+    /// Returns @c true if the cached location is not older than the maximum age, the lock must be held.
+    bool isCachedLocationFresh();
+
     std::unordered_set<std::shared_ptr<LocationServiceObserverInterface>> m_observers;
     std::shared_ptr<aace::location::LocationProvider> m_locationProviderPlatformInterface;
     std::mutex m_mutex;
+
+    // The latest location, with the time and the accuracy of its fix
+    std::chrono::milliseconds m_maxAge;
+    bool m_hasCachedLocation = false;
+    aace::location::Location m_cachedLocation;
+    std::mutex m_cacheMutex;
 };
 
 }  // namespace location
@@ -19,14 +19,19 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <regex>
+#include <thread>
 
 #include "AACE/Logger/LoggerEngineInterfaces.h"
 #include "Sinks/Sink.h"
 #include "LogEntry.h"
 #include "LogEventObserver.h"
+#include "LogQueue.h"
+#include "LogRateLimiter.h"
 
 namespace aace {
 namespace engine {
@@ -39,9 +44,46 @@ public:
     // EngineLogger::Level alias
     using Level = aace::logger::LoggerEngineInterface::Level;
 
+    /**
+     * Describes how an asynchronous logger handles a log entry when the queue is full.
+     */
+    enum class OverflowPolicy {
+        /**
+         * Drop @c VERBOSE, @c INFO and @c METRIC entries once the queue is three quarters full,
+         * keeping the remaining space for warnings. Entries are dropped when the queue is full.
+         */
+        DROP_VERBOSE,
+
+        /**
+         * Drop any entry when the queue is full.
+         */
+        DROP,
+
+        /**
+         * Block the logging thread until there is space in the queue.
+         */
+        BLOCK
+    };
+
+    /// Default number of entries queued by an asynchronous logger
+    static const size_t DEFAULT_ASYNC_QUEUE_SIZE = 4096;
+
 private:
     EngineLogger();
 
+    /**
+     * Emits a log entry on the calling thread, or queues it for the writer thread if the
+     * logger is asynchronous. @c ERROR and @c CRITICAL entries are always emitted on the
+     * calling thread after the queued entries, and the sinks are flushed.
+     */
+    void submit(
+        const std::string& source,
+        const std::string& tag,
+        Level level,
+        std::chrono::system_clock::time_point time,
+        const char* threadMoniker,
+        const char* text);
+
     /**
      * Emit a log entry.
      * NOTE: This method must be thread-safe.
@@ -61,7 +103,7 @@ private:
         const char* text);
 
 public:
-    virtual ~EngineLogger() = default;
+    virtual ~EngineLogger();
 
     void addObserver(std::shared_ptr<aace::engine::logger::LogEventObserver> observer);
     void removeObserver(std::shared_ptr<aace::engine::logger::LogEventObserver> observer);
@@ -75,7 +117,77 @@ public:
         const std::string& threadMoniker,
         const std::string& text);
 
+    /**
+     * Waits until the entries queued by an asynchronous logger have been emitted, and flushes
+     * the sinks.
+     */
+    void flush();
+
+    /**
+     * Waits until the queued entries have been emitted, and asks the sinks to write out the
+     * entries they keep in memory.
+     *
+     * @return The number of sinks that wrote out entries
+     */
+    size_t dump();
+
+    /// Returns the number of entries dropped because the asynchronous queue was full
+    uint64_t getDroppedEntries() const;
+
+    /// Returns the number of entries suppressed by the rate limiter
+    uint64_t getSuppressedEntries() const;
+
+    /**
+     * Returns @c false if no sink rule or observer accepts entries of the specified level. The
+     * check is a single atomic load, so the logging macros call it before building the entry.
+     */
+    static bool isLevelEnabled(Level level) {
+        return static_cast<int>(level) >= s_minimumLevel.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Recomputes the minimum level accepted by the sinks and observers. Must be called after
+     * adding rules to a sink that is already added to the logger.
+     */
+    void updateMinimumLevel();
+
 private:
+    /**
+     * Emits the log entries on a writer thread instead of the logging thread. The writer thread
+     * is replaced if the logger is already asynchronous.
+     *
+     * @param queueSize the number of entries that can be queued for the writer thread
+     * @param policy how to handle entries logged when the queue is full
+     */
+    bool enableAsync(size_t queueSize, OverflowPolicy policy);
+
+    /// Emits the queued entries and stops the writer thread
+    void disableAsync();
+
+    /**
+     * Limits the rate of the entries of each tag and level before they are queued or emitted, and logs a
+     * @c suppressedLogEntries warning for each tag and level with suppressed entries once every summary interval.
+     *
+     * @param rateLimiter the rate limiter, or @c nullptr to stop limiting the entries
+     */
+    void setRateLimiter(std::shared_ptr<LogRateLimiter> rateLimiter);
+
+    // logs the summary of the suppressed entries, if it is due
+    void reportSuppressed(LogRateLimiter& rateLimiter, LogRateLimiter::Clock::time_point now);
+
+    void updateMinimumLevelLocked();
+    void updateTargetsLocked();
+    void stopWriterThread();
+    void wakeWriterThread();
+    void waitForQueuedEntries();
+    void flushSinks();
+
+    // writer thread loop
+    void drain(std::shared_ptr<LogQueue> queue);
+
+    // emits the entries in the queue, returns the number of entries
+    size_t emitQueued(LogQueue& queue);
+
     bool addSink(std::shared_ptr<aace::engine::logger::sink::Sink> sink, bool replace = true);
     bool removeSink(const std::string& id);
     std::shared_ptr<aace::engine::logger::sink::Sink> getSink(const std::string& id);
@@ -84,13 +196,51 @@ private:
     friend class LoggerEngineService;
 
 private:
+    /// Immutable copy of the sinks and observers, read by the logging threads without locking
+    struct Targets {
+        std::vector<std::shared_ptr<aace::engine::logger::sink::Sink>> sinks;
+        std::vector<std::shared_ptr<LogEventObserver>> observers;
+    };
+
     std::unordered_set<std::shared_ptr<LogEventObserver>> m_observers;
 
     // sink map
     std::unordered_map<std::string, std::shared_ptr<aace::engine::logger::sink::Sink>> m_sinkMap;
 
-    // log mutex
+    // guards the sink map and observer set, and the replacement of the targets
     std::mutex m_mutex;
+
+    // targets of the emitted entries, replaced when a sink or observer is added or removed
+    std::shared_ptr<const Targets> m_targets;
+
+    // serializes the calls to the observers
+    std::mutex m_observerMutex;
+
+    // minimum level accepted by any sink or observer
+    static std::atomic<int> s_minimumLevel;
+
+    // rate limiter of the entries, or null if the entries are not limited
+    std::shared_ptr<LogRateLimiter> m_rateLimiter;
+
+    // asynchronous queue, or null if entries are emitted on the logging thread
+    std::shared_ptr<LogQueue> m_queue;
+    std::atomic<OverflowPolicy> m_overflowPolicy{OverflowPolicy::DROP_VERBOSE};
+    std::mutex m_asyncMutex;
+    std::thread m_writerThread;
+
+    // writer thread wakeup
+    std::mutex m_writerMutex;
+    std::condition_variable m_writerCondition;
+    std::atomic<bool> m_writerWaiting{false};
+    std::atomic<bool> m_writerStopped{false};
+
+    // queued and emitted entry counts used to flush the queue
+    std::atomic<uint64_t> m_queuedEntries{0};
+    std::atomic<uint64_t> m_emittedEntries{0};
+    std::atomic<uint64_t> m_droppedEntries{0};
+    uint64_t m_reportedDroppedEntries = 0;
+    std::mutex m_flushMutex;
+    std::condition_variable m_flushCondition;
 };
 
 }  // namespace logger
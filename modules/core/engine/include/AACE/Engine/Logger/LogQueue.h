@@ -0,0 +1,96 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_LOGGER_LOG_QUEUE_H
+#define AACE_ENGINE_LOGGER_LOG_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "AACE/Logger/LoggerEngineInterfaces.h"
+
+namespace aace {
+namespace engine {
+namespace logger {
+
+/**
+ * Bounded multiple-producer, single-consumer queue of log records.
+ *
+ * Producers claim a slot with a compare-and-swap on the enqueue position, and each slot carries a
+ * sequence number that tells the producers and the consumer whether it is free or filled, so
+ * neither side takes a lock. A push fails instead of waiting when the queue is full.
+ */
+class LogQueue {
+public:
+    using Level = aace::logger::LoggerEngineInterface::Level;
+
+    /// Log entry copied into the queue by the logging thread
+    struct Record {
+        std::string source;
+        std::string tag;
+        Level level;
+        std::chrono::system_clock::time_point time;
+        std::string threadMoniker;
+        std::string text;
+    };
+
+    /**
+     * Creates a queue.
+     *
+     * @param capacity the maximum number of queued records, rounded up to a power of two
+     */
+    explicit LogQueue(size_t capacity);
+
+    /**
+     * Adds a record to the queue, may be called from any thread.
+     *
+     * @return @c false if the queue is full
+     */
+    bool push(Record&& record);
+
+    /**
+     * Removes the oldest record from the queue, may only be called from the consumer thread.
+     *
+     * @return @c false if the queue is empty
+     */
+    bool pop(Record& record);
+
+    /// Returns the approximate number of queued records
+    size_t size() const;
+
+    /// Returns the maximum number of queued records
+    size_t capacity() const;
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+
+    // the positions increase monotonically and are masked to index the cells
+    alignas(64) std::atomic<size_t> m_enqueuePosition;
+    alignas(64) std::atomic<size_t> m_dequeuePosition;
+};
+
+}  // namespace logger
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_LOGGER_LOG_QUEUE_H
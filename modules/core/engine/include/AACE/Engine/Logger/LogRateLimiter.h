@@ -0,0 +1,143 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_LOGGER_LOG_RATE_LIMITER_H
+#define AACE_ENGINE_LOGGER_LOG_RATE_LIMITER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AACE/Logger/LoggerEngineInterfaces.h"
+
+namespace aace {
+namespace engine {
+namespace logger {
+
+/**
+ * Limits the rate of the log entries of each tag and level with a token bucket, so a path that logs in a loop
+ * doesn't flood the sinks.
+ *
+ * Each tag and level has a bucket of @c burst tokens, refilled at @c rate tokens per second. An entry takes a
+ * token, and is suppressed when the bucket is empty. The suppressed entries are counted, and the counts are
+ * returned by @c takeSummary() once every @c summaryInterval. @c CRITICAL entries are never suppressed.
+ */
+class LogRateLimiter {
+public:
+    using Level = aace::logger::LoggerEngineInterface::Level;
+    using Clock = std::chrono::steady_clock;
+
+    /// The limit of the entries of a tag and level
+    struct Limit {
+        /// The number of entries per second
+        double rate;
+        /// The number of entries logged at once before the rate applies
+        double burst;
+    };
+
+    /// The number of entries of a tag and level suppressed since the previous summary
+    struct Suppressed {
+        std::string tag;
+        Level level;
+        uint64_t count;
+    };
+
+    /// Default number of entries per second of each tag and level
+    static constexpr double DEFAULT_RATE = 50;
+
+    /// Default number of entries of each tag and level logged at once
+    static constexpr double DEFAULT_BURST = 200;
+
+    /// Default time between two summaries of the suppressed entries
+    static constexpr std::chrono::milliseconds DEFAULT_SUMMARY_INTERVAL = std::chrono::milliseconds(10000);
+
+    /**
+     * Creates a rate limiter.
+     *
+     * @param defaultLimit The limit of the tags without a limit of their own
+     * @param summaryInterval The minimum time between two summaries of the suppressed entries
+     * @return @c nullptr if the limit or the interval is not valid
+     */
+    static std::shared_ptr<LogRateLimiter> create(
+        Limit defaultLimit = {DEFAULT_RATE, DEFAULT_BURST},
+        std::chrono::milliseconds summaryInterval = DEFAULT_SUMMARY_INTERVAL);
+
+    /**
+     * Sets the limit of the entries of a tag, of all the levels or of a single level. The limits are applied in
+     * the order they are set, so the limit of a level is set after the limit of all the levels of the tag.
+     *
+     * @return @c false if the limit is not valid
+     */
+    bool setLimit(const std::string& tag, Limit limit);
+    bool setLimit(const std::string& tag, Level level, Limit limit);
+
+    /**
+     * Takes a token for an entry, may be called from any thread.
+     *
+     * @return @c false if the entry must be suppressed
+     */
+    bool allow(const std::string& tag, Level level, Clock::time_point now = Clock::now());
+
+    /**
+     * Returns the entries suppressed since the previous summary, if the summary interval elapsed since then.
+     * The check is a single atomic load when the summary is not due.
+     */
+    std::vector<Suppressed> takeSummary(Clock::time_point now = Clock::now());
+
+    /// Returns the number of entries suppressed since the limiter was created
+    uint64_t getSuppressedEntries() const;
+
+private:
+    LogRateLimiter(Limit defaultLimit, std::chrono::milliseconds summaryInterval);
+
+    static bool isValid(const Limit& limit);
+
+    struct Bucket {
+        Limit limit;
+        double tokens = 0;
+        Clock::time_point refilled;
+        uint64_t suppressed = 0;
+        bool used = false;
+    };
+
+    static const size_t LEVEL_COUNT = static_cast<size_t>(Level::CRITICAL) + 1;
+
+    /// The buckets of a tag, indexed by level
+    using Buckets = std::array<Bucket, LEVEL_COUNT>;
+
+private:
+    const Limit m_defaultLimit;
+    const std::chrono::milliseconds m_summaryInterval;
+
+    // the limits of the tags, indexed by level, and the buckets of the tags that logged entries
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::array<Limit, LEVEL_COUNT>> m_limits;
+    std::unordered_map<std::string, Buckets> m_buckets;
+
+    // the time of the next summary, in ticks of the steady clock
+    std::atomic<Clock::rep> m_nextSummary;
+    std::atomic<uint64_t> m_suppressedEntries{0};
+};
+
+}  // namespace logger
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_LOGGER_LOG_RATE_LIMITER_H
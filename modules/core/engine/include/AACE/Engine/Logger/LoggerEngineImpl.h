@@ -19,8 +19,11 @@
 #include <chrono>
 #include <memory>
 #include <mutex>
+#include <vector>
 
-#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/SerialExecutor.h>
+#include <AACE/Engine/Utils/Memory/MemoryPressure.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
 #include <AACE/Logger/Logger.h>
 
 #include "EngineLogger.h"
@@ -33,16 +36,51 @@ namespace logger {
 
 class LoggerEngineImpl
         : public aace::logger::LoggerEngineInterface
-        , public LogEventObserver {
+        , public LogEventObserver
+        , public aace::engine::utils::memory::MemoryPressureObserverInterface
+        , public std::enable_shared_from_this<LoggerEngineImpl> {
 public:
-    virtual ~LoggerEngineImpl() = default;
+    /// The default number of buffered log events that are delivered at once
+    static constexpr size_t DEFAULT_BATCH_MAX_EVENTS = 64;
+
+    /// The default maximum time a log event is buffered
+    static constexpr std::chrono::milliseconds DEFAULT_BATCH_MAX_DELAY = std::chrono::milliseconds(250);
+
+    /**
+     * The batched delivery of the log events to the platform logger. The log events are buffered, and
+     * delivered with a single @c Logger::logEvents() call when @c maxEvents are buffered, when the oldest
+     * event has been buffered for @c maxDelay, or when an @c ERROR or @c CRITICAL event is logged. The events
+     * are delivered one at a time while the memory pressure is @c LOW or above.
+     */
+    struct BatchConfig {
+        bool enabled = false;
+        size_t maxEvents = DEFAULT_BATCH_MAX_EVENTS;
+        std::chrono::milliseconds maxDelay = DEFAULT_BATCH_MAX_DELAY;
+    };
+
+    virtual ~LoggerEngineImpl();
 
     static std::shared_ptr<LoggerEngineImpl> create(
         std::shared_ptr<aace::logger::Logger> platformLoggerInterface,
         std::shared_ptr<aace::engine::logger::EngineLogger> logger);
 
+    static std::shared_ptr<LoggerEngineImpl> create(
+        std::shared_ptr<aace::logger::Logger> platformLoggerInterface,
+        std::shared_ptr<aace::engine::logger::EngineLogger> logger,
+        const BatchConfig& batchConfig);
+
+    /**
+     * Delivers the buffered log events to the platform logger.
+     *
+     * @return @c true if the platform logger handled the log events, else @c false
+     */
+    bool flush();
+
 private:
-    LoggerEngineImpl(std::shared_ptr<aace::logger::Logger> platformLoggerInterface);
+    LoggerEngineImpl(std::shared_ptr<aace::logger::Logger> platformLoggerInterface, const BatchConfig& batchConfig);
+
+    bool flushLocked();
+    void scheduleFlushLocked();
 
 public:
     // LogEventObserver
@@ -54,12 +92,25 @@ public:
 
     // LoggerEngineInterface
     virtual void log(aace::logger::Logger::Level level, const std::string& tag, const std::string& message) override;
+    virtual void onDumpLogs() override;
+
+    // MemoryPressureObserverInterface
+    void onMemoryPressure(aace::engine::utils::memory::MemoryPressureLevel level) override;
 
 private:
     std::shared_ptr<aace::logger::Logger> m_platformLoggerInterface;
+    const BatchConfig m_batchConfig;
+
+    // the buffered log events, the mutex is held while a batch is delivered to keep the events in order
+    std::mutex m_batchMutex;
+    std::vector<aace::logger::Logger::LogEvent> m_batch;
+    bool m_batchSuspended = false;
+    std::shared_ptr<aace::engine::utils::threading::TimerWheel> m_timerWheel;
+    aace::engine::utils::threading::TimerWheel::TimerId m_flushTimer =
+        aace::engine::utils::threading::TimerWheel::INVALID_TIMER;
 
     // executor
-    aace::engine::utils::threading::Executor m_executor;
+    aace::engine::utils::threading::SerialExecutor m_executor;
 };
 
 }  // namespace logger
@@ -65,6 +65,10 @@ private:
 
 private:
     std::shared_ptr<aace::engine::logger::LoggerEngineImpl> m_loggerEngineImpl;
+    aace::engine::logger::LoggerEngineImpl::BatchConfig m_batchConfig;
+
+    // whether the engine uses the asynchronous writer of the engine logger, shared by the engines of the process
+    bool m_asyncEnabled = false;
 };
 
 }  // namespace logger
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_LOGGER_SINK_BINARY_SINK_H
+#define AACE_ENGINE_LOGGER_SINK_BINARY_SINK_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "Sink.h"
+
+namespace aace {
+namespace engine {
+namespace logger {
+namespace sink {
+
+/**
+ * Sink that writes log entries as compact binary records to a memory-mapped file.
+ *
+ * Entries are not formatted as text. Each record holds the timestamp, level, and the source,
+ * thread moniker, tag, event and metadata keys as IDs of strings that are written to the file
+ * once. The metadata values and message are copied as they were logged, so the
+ * @c aac-tool-log-decoder tool reproduces the text written by the file sink.
+ *
+ * The file <prefix>.blog is created with @c maxSize bytes and mapped into memory, so a record
+ * is a copy into the mapping, and the records survive a crash of the process. When the file is
+ * full it is truncated to its used size and rotated to <prefix>.blog.1 ... <prefix>.blog.<maxFiles>.
+ * An existing file is rotated when the sink is created.
+ *
+ * File layout, all integers are little endian:
+ * @code
+ * header:  "AACBLOG\0", uint32 version, uint32 header size, uint64 size of the records, uint64 reserved
+ * string:  uint8 0x01, varint id, varint length, bytes
+ * entry:   uint8 0x02, int64 time in microseconds since epoch or 0, uint8 level, varint source id,
+ *          varint thread moniker id, uint8 section count
+ *          1 section:   varint length, text bytes
+ *          2 or more:   varint tag id, varint event id
+ *          3 or more:   varint pair count, each pair: varint key id, uint8 has value, [varint length, value bytes]
+ *          4 sections:  varint length, message bytes
+ * @endcode
+ */
+class BinarySink : public Sink {
+private:
+    explicit BinarySink(const std::string& id);
+
+public:
+    ~BinarySink();
+
+    static std::shared_ptr<BinarySink> create(
+        const std::string& id,
+        const std::string& path,
+        const std::string& prefix = "aace",
+        uint32_t maxSize = 5242880,
+        uint32_t maxFiles = 3);
+
+    /// Returns the number of entries that were too large to fit in an empty log file
+    uint64_t getDroppedEntries();
+
+private:
+    void log(
+        Level level,
+        std::chrono::system_clock::time_point time,
+        const char* source,
+        const char* threadMoniker,
+        const char* text) override;
+    void flush() override;
+
+    bool openLog();
+    void closeLog();
+    bool rotateLog();
+
+    void encode(
+        Level level,
+        std::chrono::system_clock::time_point time,
+        const char* source,
+        const char* threadMoniker,
+        const char* text);
+    uint32_t intern(const char* data, size_t size);
+
+private:
+    bool m_enabled = false;
+
+    std::string m_path;
+    std::string m_prefix;
+    uint32_t m_maxSize;
+    uint8_t m_maxFiles;
+
+    std::string m_filename;
+    int m_fd = -1;
+    char* m_data = nullptr;
+    uint64_t m_size = 0;
+    uint64_t m_droppedEntries = 0;
+
+    // strings written to the current file, and the scratch buffers reused to encode an entry
+    std::unordered_map<std::string, uint32_t> m_strings;
+    std::string m_stringKey;
+    std::string m_definitions;
+    std::string m_record;
+    std::string m_pairs;
+
+    std::mutex m_mutex;
+};
+
+}  // namespace sink
+}  // namespace logger
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_LOGGER_SINK_BINARY_SINK_H
@@ -41,6 +41,7 @@ private:
 
 private:
     std::unique_ptr<aace::engine::logger::LogFormatter> m_formatter;
+    std::mutex m_mutex;
 };
 
 }  // namespace sink
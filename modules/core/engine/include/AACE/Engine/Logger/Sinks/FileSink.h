@@ -16,6 +16,10 @@
 #ifndef AACE_ENGINE_LOGGER_SINK_FILE_SINK_H
 #define AACE_ENGINE_LOGGER_SINK_FILE_SINK_H
 
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
 #include <AACE/Engine/Logger/LogFormatter.h>
 #include "Sink.h"
 
@@ -24,18 +28,39 @@ namespace engine {
 namespace logger {
 namespace sink {
 
+/**
+ * Sink that writes log entries to a file, and rotates the file when it reaches its maximum size.
+ *
+ * Log entries are collected in a write-behind buffer, which is written to the file when it reaches
+ * @c bufferSize bytes, when the sink is flushed, and every @c flushInterval by the sink's background
+ * thread. A @c bufferSize of @c 0 writes each entry as it is logged. When @c sync is enabled, each
+ * buffer write is followed by @c fdatasync() so the entries survive a power loss.
+ *
+ * Rotating the log only renames the current file and opens a new one on the logging thread. The
+ * background thread then shifts the numbered log files, and compresses the rotated file with gzip
+ * if compression is enabled and the engine is built with log compression support.
+ */
 class FileSink : public Sink {
 private:
     explicit FileSink(const std::string& id);
 
 public:
+    ~FileSink();
+
     static std::shared_ptr<FileSink> create(
         const std::string& id,
         const std::string& path,
         const std::string& prefix = "aace",
         uint32_t maxSize = 5242880,
         uint32_t maxFiles = 3,
-        bool append = true);
+        bool append = true,
+        uint32_t bufferSize = 0,
+        std::chrono::milliseconds flushInterval = std::chrono::milliseconds(1000),
+        bool sync = false,
+        bool compress = false);
+
+    /// Returns @c true if the engine is built with support for compressing rotated log files
+    static bool isCompressionSupported();
 
 private:
     void log(
@@ -46,7 +71,13 @@ private:
         const char* text) override;
     void flush() override;
 
-    bool rotateLog();
+    bool openLog(bool append);
+    bool writeBufferLocked(bool sync);
+    bool rotateLogLocked();
+    void processRotation(const std::string& filename);
+    void run();
+
+    std::string getRotatedFilename(int index) const;
 
 private:
     bool m_enabled = false;
@@ -56,10 +87,26 @@ private:
     uint32_t m_maxSize;
     uint8_t m_maxFiles;
     bool m_append;
+    uint32_t m_bufferSize = 0;
+    std::chrono::milliseconds m_flushInterval;
+    bool m_sync = false;
+    bool m_compress = false;
 
     std::string m_filename;
-    std::shared_ptr<std::ofstream> m_stream;
+    int m_fd = -1;
+    uint64_t m_fileSize = 0;
+    std::string m_buffer;
+    bool m_syncPending = false;
     std::unique_ptr<aace::engine::logger::LogFormatter> m_formatter;
+
+    // rotated files waiting to be shifted and compressed by the background thread
+    std::deque<std::string> m_pendingRotations;
+    uint64_t m_rotationCount = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeTrigger;
+    bool m_shutdown = false;
+    std::thread m_thread;
 };
 
 }  // namespace sink
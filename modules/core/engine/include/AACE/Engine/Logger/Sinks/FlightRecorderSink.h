@@ -0,0 +1,156 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_LOGGER_SINK_FLIGHT_RECORDER_SINK_H
+#define AACE_ENGINE_LOGGER_SINK_FLIGHT_RECORDER_SINK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <AACE/Engine/Utils/Memory/MemoryPressure.h>
+
+#include "Sink.h"
+
+namespace aace {
+namespace engine {
+namespace logger {
+namespace sink {
+
+/**
+ * Sink that keeps the latest log entries in memory, and writes them to a file only when something goes wrong.
+ *
+ * The entries accepted by the sink rules, typically all the @c VERBOSE entries, are encoded into a ring buffer of
+ * @c maxSize bytes, and the oldest entries are overwritten when the ring is full. The entries are not formatted, so
+ * logging an entry is a copy into the ring. The ring is dumped to a file and cleared:
+ * - when an @c ERROR or @c CRITICAL entry is logged, at most once every few seconds,
+ * - when @c dump() is called, which the platform requests with @c Logger::dumpLogs(),
+ * - when the process crashes with @c SIGSEGV, @c SIGBUS, @c SIGFPE, @c SIGILL or @c SIGABRT, if @c dumpOnCrash
+ *   is set. The crash dump is written without locking or allocating memory, so it is best effort.
+ *
+ * The dumps are written to <prefix>.dump.blog, which is rotated to <prefix>.dump.blog.1 ...
+ * <prefix>.dump.blog.<maxDumps - 1>, and the crash dump to <prefix>.crash.blog. The entries are kept in the
+ * layout of the @c BinarySink files, with the source and thread moniker strings of each entry defined before it,
+ * so a dump is decoded with the @c aac-tool-log-decoder tool like a binary log file.
+ *
+ * The ring shrinks under memory pressure, to a quarter of @c maxSize at the @c LOW level and to
+ * @c MIN_PRESSURE_SIZE at the @c CRITICAL level, keeping the latest entries, and grows back once the pressure is
+ * relieved.
+ */
+class FlightRecorderSink
+        : public Sink
+        , public aace::engine::utils::memory::MemoryPressureObserverInterface {
+private:
+    explicit FlightRecorderSink(const std::string& id);
+
+public:
+    /// The size of the ring at the @c CRITICAL memory pressure level, unless @c maxSize is smaller
+    static const uint32_t MIN_PRESSURE_SIZE = 65536;
+
+    ~FlightRecorderSink();
+
+    static std::shared_ptr<FlightRecorderSink> create(
+        const std::string& id,
+        const std::string& path,
+        const std::string& prefix = "aace",
+        uint32_t maxSize = 4194304,
+        uint32_t maxDumps = 3,
+        bool dumpOnCrash = true);
+
+    /// Writes the entries in the ring to a new dump file, and clears the ring. Returns @c false if the ring is empty.
+    bool dump() override;
+
+    /// Returns the number of bytes of entries in the ring
+    uint64_t getRecordedSize();
+
+    /// Returns the number of dump files written
+    uint64_t getDumpCount();
+
+    /// Returns the size of the ring in bytes, which is smaller than @c maxSize under memory pressure
+    uint64_t getCapacity();
+
+    /// @name MemoryPressureObserverInterface
+    /// @{
+    void onMemoryPressure(aace::engine::utils::memory::MemoryPressureLevel level) override;
+    /// @}
+
+private:
+    void log(
+        Level level,
+        std::chrono::system_clock::time_point time,
+        const char* source,
+        const char* threadMoniker,
+        const char* text) override;
+
+    void encode(
+        Level level,
+        std::chrono::system_clock::time_point time,
+        const char* source,
+        const char* threadMoniker,
+        const char* text);
+    bool dumpLocked();
+
+    /// Replaces the ring with a ring of @c capacity bytes, keeping the latest records that fit.
+    void resizeLocked(uint64_t capacity);
+    bool rotateDumps();
+    void installCrashHandler();
+    void uninstallCrashHandler();
+
+    /// Writes the ring to @c fd, with a file header. Only calls async-signal-safe functions.
+    bool writeRing(int fd);
+
+    static void onCrashSignal(int signal);
+
+private:
+    std::string m_path;
+    std::string m_prefix;
+    uint32_t m_maxSize = 0;
+    uint32_t m_maxDumps;
+    bool m_dumpOnCrash = false;
+
+    std::string m_dumpFilename;
+    std::string m_crashFilename;
+
+    // the ring, and the offsets of its oldest and next bytes, which only grow until the ring is resized
+    std::unique_ptr<char[]> m_ring;
+    uint64_t m_capacity = 0;
+    std::atomic<uint64_t> m_head{0};
+    std::atomic<uint64_t> m_tail{0};
+
+    // the size of each record in the ring, the oldest first
+    std::deque<uint32_t> m_recordSizes;
+
+    // the scratch buffer reused to encode an entry
+    std::string m_record;
+
+    std::chrono::steady_clock::time_point m_lastErrorDump;
+    uint64_t m_dumpCount = 0;
+
+    std::mutex m_mutex;
+
+    /// The sink dumped by the crash handler
+    static std::atomic<FlightRecorderSink*> s_crashSink;
+};
+
+}  // namespace sink
+}  // namespace logger
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_LOGGER_SINK_FLIGHT_RECORDER_SINK_H
@@ -23,6 +23,7 @@
 #include <mutex>
 #include <fstream>
 #include <regex>
+#include <unordered_map>
 
 #include "AACE/Logger/LoggerEngineInterfaces.h"
 
@@ -43,6 +44,10 @@ protected:
 public:
     virtual ~Sink() = default;
 
+    /**
+     * Writes a log entry accepted by the sink rules. Entries logged by different threads are
+     * written concurrently, so implementations must synchronize their output.
+     */
     virtual void log(
         Level level,
         std::chrono::system_clock::time_point time,
@@ -51,8 +56,18 @@ public:
         const char* text) = 0;
     virtual void flush();
 
+    /**
+     * Writes out the log entries the sink keeps in memory, for the sinks that only write them on demand.
+     *
+     * @return @c false if the sink doesn't keep entries in memory, or they could not be written
+     */
+    virtual bool dump();
+
     std::string getId();
 
+    /// Returns the lowest level accepted by the sink rules, or @c CRITICAL if the sink has no rules
+    Level getMinimumLevel();
+
     bool addRule(std::shared_ptr<Rule> rule, bool replace = true);
     bool addRule(
         Level level,
@@ -75,9 +90,26 @@ public:
         const char* threadMoniker,
         const char* text);
 
+private:
+    /// Rules that apply to the entries with the same source and tag
+    struct RuleSet {
+        // whether a rule without message pattern matches, and the lowest level of these rules
+        bool matchAll = false;
+        Level level = Level::CRITICAL;
+        // the rules that also match the message text, in the order they were added
+        std::vector<std::shared_ptr<Rule>> messageRules;
+    };
+
+    const RuleSet& getRuleSetLocked(const std::string& source, const std::string& tag);
+
 private:
     std::string m_id;
     std::vector<std::shared_ptr<Rule>> m_rules;
+
+    // rule sets compiled on the first entry of each source and tag, cleared when a rule is added
+    std::unordered_map<std::string, RuleSet> m_ruleCache;
+    std::string m_ruleCacheKey;
+    std::mutex m_mutex;
 };
 
 //
@@ -106,8 +138,17 @@ public:
         const std::string& message);
 
     bool equals(const Rule& rule);
+    Level getLevel() const;
     bool match(Level level, const std::string& source, const std::string& tag, const char* text);
 
+    /// Returns @c true if the rule's source and tag patterns match
+    bool matchSource(const std::string& source, const std::string& tag);
+
+    /// Returns @c true if the rule's level and message pattern match
+    bool matchMessage(Level level, const char* text);
+
+    bool hasMessagePattern() const;
+
 private:
     Sink::Level m_level;
     std::string m_source;
@@ -16,6 +16,11 @@
 #ifndef AACE_ENGINE_LOGGER_SINK_SYSLOG_SINK_H
 #define AACE_ENGINE_LOGGER_SINK_SYSLOG_SINK_H
 
+#include <condition_variable>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <AACE/Engine/Logger/LogFormatter.h>
 #include "Sink.h"
 
@@ -24,15 +29,36 @@ namespace engine {
 namespace logger {
 namespace sink {
 
+/**
+ * Sink that writes log entries to the system log.
+ *
+ * By default, each entry is written with a @c syslog() call. When @c batchSize is not @c 0, the sink
+ * writes the entries directly to the datagram socket of the system log daemon, such as @c /dev/log
+ * for rsyslog or the syslog socket of journald: the entries are formatted as syslog messages and
+ * collected in a batch, which is written with a single @c sendmmsg() call when it holds @c batchSize
+ * entries, when an @c ERROR or @c CRITICAL entry is logged, when the sink is flushed, and every
+ * @c flushInterval by the sink's background thread. With the asynchronous logger, the batches are
+ * filled by the writer thread. If the socket can't be opened or written, the sink falls back to
+ * @c syslog().
+ */
 class SyslogSink : public Sink {
 private:
     explicit SyslogSink(const std::string& id);
 
 public:
+    /// The default socket of the system log daemon
+    static const std::string DEFAULT_SOCKET_PATH;
+
     ~SyslogSink() override;
 
     static std::shared_ptr<SyslogSink> create(const std::string& id);
 
+    static std::shared_ptr<SyslogSink> create(
+        const std::string& id,
+        uint32_t batchSize,
+        std::chrono::milliseconds flushInterval = std::chrono::milliseconds(1000),
+        const std::string& socketPath = DEFAULT_SOCKET_PATH);
+
 private:
     void log(
         Level level,
@@ -40,9 +66,38 @@ private:
         const char* source,
         const char* threadMoniker,
         const char* text) override;
+    void flush() override;
+
+    /// Connects to the syslog socket, and returns whether the socket is connected
+    bool openSocketLocked();
+
+    /// Writes the batch to the syslog socket, or with @c syslog() if the socket can't be written
+    bool sendBatchLocked();
+
+    /// Writes the batch every @c m_flushInterval until the sink is destroyed
+    void run();
 
 private:
     std::unique_ptr<aace::engine::logger::LogFormatter> m_formatter;
+
+    uint32_t m_batchSize = 0;
+    std::chrono::milliseconds m_flushInterval;
+    std::string m_socketPath;
+    std::string m_header;
+    int m_socket = -1;
+
+    /// A syslog message, with its priority and the offset of its text for the fallback to @c syslog()
+    struct Message {
+        int priority;
+        std::string datagram;
+        size_t textOffset;
+    };
+    std::vector<Message> m_batch;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeTrigger;
+    bool m_shutdown = false;
+    std::thread m_thread;
 };
 
 }  // namespace sink
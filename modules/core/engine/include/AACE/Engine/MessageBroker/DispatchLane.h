@@ -0,0 +1,274 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_MESSAGE_BROKER_DISPATCH_LANE_H
+#define AACE_ENGINE_MESSAGE_BROKER_DISPATCH_LANE_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/UniqueTask.h>
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+/**
+ * A serial dispatch lane of the message broker. Without priority classes or a queue size, the
+ * lane runs its tasks in the order they are posted. With priority classes, each task is queued in
+ * the class of its message topic, and the lane always runs the next task of the highest class,
+ * except that a task of a lower class is run once the higher classes have been run
+ * @c starvationLimit times while it was waiting. With a queue size, a task posted while the queue
+ * is full is handled by the overflow policy of its topic. The tasks of a topic are always run in
+ * the order they are posted.
+ */
+class DispatchLane {
+public:
+    /// The priority class of the messages of a topic
+    enum class Priority { HIGH, NORMAL, LOW };
+
+    /// The number of priority classes
+    static constexpr size_t PRIORITY_COUNT = 3;
+
+    /// The priority class of each topic, the topics which aren't in the map are @c NORMAL
+    using PriorityMap = std::unordered_map<std::string, Priority>;
+
+    /// What the lane does with a task posted while its queue is full
+    enum class OverflowPolicy {
+        /// Drops the new task
+        REJECT,
+        /// Drops the oldest waiting task of the same topic, or the new task if there is none
+        DROP_OLDEST,
+        /// Drops the waiting task with the same key, or the new task if there is none
+        COALESCE
+    };
+
+    /// The overflow policy of each topic, or "*" for the topics without their own policy, which are @c REJECT otherwise
+    using OverflowPolicyMap = std::unordered_map<std::string, OverflowPolicy>;
+
+    /// The default starvation limit
+    static constexpr size_t DEFAULT_STARVATION_LIMIT = 8;
+
+    /// The scheduling configuration shared by the lanes of the message broker
+    struct Config {
+        /// The priority classes of the topics, the lane runs the tasks in the order they are posted if empty
+        PriorityMap priorities;
+        /// The most tasks of higher classes run while a task of a lower class is waiting
+        size_t starvationLimit = DEFAULT_STARVATION_LIMIT;
+        /// The overflow policies of the topics, only used by a lane with a queue size
+        OverflowPolicyMap overflowPolicies;
+    };
+
+    /// The queue metrics of a lane
+    struct Metrics {
+        /// The number of tasks waiting to be run
+        size_t queueDepth = 0;
+        /// The most tasks that were waiting to be run
+        size_t maxQueueDepth = 0;
+        /// The tasks dropped because the queue was full
+        uint64_t rejected = 0;
+        /// The waiting tasks dropped by the @c DROP_OLDEST policy for a newer task
+        uint64_t dropped = 0;
+        /// The waiting tasks dropped by the @c COALESCE policy for a newer task
+        uint64_t coalesced = 0;
+    };
+
+    /**
+     * Constructs a dispatch lane.
+     *
+     * @param name The name of the lane executor.
+     * @param config The scheduling configuration, or @c nullptr to run the tasks in the order they
+     *        are posted.
+     * @param queueSize The most tasks waiting to be run, or @c 0 for an unbounded queue.
+     */
+    DispatchLane(const std::string& name, std::shared_ptr<const Config> config = nullptr, size_t queueSize = 0);
+
+    /// Returns the priority class of a topic.
+    Priority getPriority(const std::string& topic) const;
+
+    /// Returns the overflow policy of a topic.
+    OverflowPolicy getOverflowPolicy(const std::string& topic) const;
+
+    /**
+     * Posts a task for a message, without a future for its result. If the queue is full, the
+     * overflow policy of the topic decides which task is dropped.
+     *
+     * @param topic The topic of the message the task dispatches.
+     * @param key The key of the messages coalesced with the message, such as its topic and action,
+     *        or empty if the task must not be dropped for a newer task.
+     * @param task A callable type representing a task.
+     * @returns @c false if the lane is shutdown or the task is dropped because the queue is full.
+     */
+    template <typename Task>
+    bool post(const std::string& topic, const std::string& key, Task&& task);
+
+    /**
+     * Posts a task completing a request of a topic, such as its reply handler. The task is
+     * queued even if the queue is full, since the request is already waiting for it.
+     *
+     * @param topic The topic of the request.
+     * @param task A callable type representing a task.
+     * @returns @c false if the lane is shutdown, in which case the task is dropped.
+     */
+    template <typename Task>
+    bool postCompletion(const std::string& topic, Task&& task);
+
+    /**
+     * Submits a task for a message topic. The future must be checked for validity before waiting
+     * on it. The task is never dropped for a newer task.
+     *
+     * @param topic The topic of the message the task dispatches.
+     * @param task A callable type representing a task.
+     * @returns A @c std::future for the return value of the task, which is invalid if the lane is
+     *          shutdown or the queue is full.
+     */
+    template <typename Task>
+    auto submit(const std::string& topic, Task task) -> std::future<decltype(task())>;
+
+    /// Returns @c true if the queue of the lane has a size.
+    bool isBounded() const;
+
+    /// Waits for the previously posted tasks to complete.
+    void waitForSubmittedTasks();
+
+    /// Drops the tasks which are waiting, and refuses the tasks posted after.
+    void shutdown();
+
+    /// Returns the number of tasks waiting to be run.
+    size_t queueSize();
+
+    /// Returns the queue metrics of the lane.
+    Metrics getMetrics();
+
+private:
+    using UniqueTask = aace::engine::utils::threading::UniqueTask;
+
+    /// A task waiting in its priority class
+    struct Entry {
+        std::string topic;
+        std::string key;
+        UniqueTask task;
+    };
+
+    /**
+     * Queues a task in its priority class, and posts the executor task which runs the next task.
+     *
+     * @param bounded Whether the task is handled by the overflow policy of its topic if the queue is full.
+     */
+    bool enqueue(const std::string& topic, const std::string& key, UniqueTask task, bool bounded);
+
+    /// Runs the next task by priority, called once for each queued task.
+    void dispatchNext();
+
+    /// Emits the tasks dropped since the last report, at most once per report interval.
+    void reportOverflow(std::unique_lock<std::mutex>& lock);
+
+    const std::string m_name;
+
+    /// The scheduling configuration, or @c nullptr if the lane posts the tasks to its executor
+    const std::shared_ptr<const Config> m_config;
+    const size_t m_queueSize;
+
+    /// The waiting tasks of each priority class
+    std::mutex m_mutex;
+    std::deque<Entry> m_queues[PRIORITY_COUNT];
+    size_t m_waiting = 0;
+
+    /// The tasks of higher classes run while each class has a task waiting
+    size_t m_passed[PRIORITY_COUNT] = {};
+
+    /// The queue metrics, and the metrics of the last overflow report
+    Metrics m_metrics;
+    Metrics m_reported;
+    std::chrono::steady_clock::time_point m_lastReport;
+
+    /// The executor must be declared last to be destructed first.
+    aace::engine::utils::threading::Executor m_executor;
+};
+
+template <typename Task>
+bool DispatchLane::post(const std::string& topic, const std::string& key, Task&& task) {
+    if (m_config == nullptr) {
+        return m_executor.post(std::forward<Task>(task));
+    }
+    return enqueue(topic, key, UniqueTask(std::forward<Task>(task)), true);
+}
+
+template <typename Task>
+bool DispatchLane::postCompletion(const std::string& topic, Task&& task) {
+    if (m_config == nullptr) {
+        return m_executor.post(std::forward<Task>(task));
+    }
+    return enqueue(topic, std::string(), UniqueTask(std::forward<Task>(task)), false);
+}
+
+template <typename Task>
+auto DispatchLane::submit(const std::string& topic, Task task) -> std::future<decltype(task())> {
+    if (m_config == nullptr) {
+        return m_executor.submit(task);
+    }
+
+    using Result = decltype(task());
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(task);
+    auto future = packaged->get_future();
+    if (!enqueue(topic, std::string(), [packaged]() { (*packaged)(); }, true)) {
+        return std::future<Result>();
+    }
+    return future;
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const DispatchLane::Priority& priority) {
+    switch (priority) {
+        case DispatchLane::Priority::HIGH:
+            stream << "HIGH";
+            break;
+        case DispatchLane::Priority::NORMAL:
+            stream << "NORMAL";
+            break;
+        case DispatchLane::Priority::LOW:
+            stream << "LOW";
+            break;
+    }
+    return stream;
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const DispatchLane::OverflowPolicy& policy) {
+    switch (policy) {
+        case DispatchLane::OverflowPolicy::REJECT:
+            stream << "REJECT";
+            break;
+        case DispatchLane::OverflowPolicy::DROP_OLDEST:
+            stream << "DROP_OLDEST";
+            break;
+        case DispatchLane::OverflowPolicy::COALESCE:
+            stream << "COALESCE";
+            break;
+    }
+    return stream;
+}
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_MESSAGE_BROKER_DISPATCH_LANE_H
@@ -16,8 +16,13 @@
 #ifndef AACE_ENGINE_MESSAGE_BROKER_MESSAGE_H
 #define AACE_ENGINE_MESSAGE_BROKER_MESSAGE_H
 
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <typeinfo>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
@@ -25,6 +30,17 @@ namespace aace {
 namespace engine {
 namespace messageBroker {
 
+/**
+ * An immutable message published through the message broker.
+ *
+ * The message text and its parsed header are held in a reference counted envelope that is shared
+ * by all copies of the message, so a message can be passed between executors and handlers by
+ * value without copying the message.
+ *
+ * A message can also be created from a generated AASB message object with @c fromObject(). The
+ * object is passed to the subscribers as is, and read with @c as(), and the message is only
+ * serialized when a subscriber reads its text or payload, such as the platform or the log.
+ */
 class Message {
 private:
     Message();
@@ -34,7 +50,50 @@ public:
 
     enum class MessageType { PUBLISH, REPLY };
 
-    Message(const std::string& msg, Direction direction);
+    /**
+     * Describes how much of the message is parsed when it is constructed.
+     *
+     * @c FULL parses and validates the entire message up front. @c LAZY only scans the message
+     * header, and defers parsing the rest of the message until the payload or serialized message
+     * is requested. A message with a malformed payload is still valid in @c LAZY mode, but has an
+     * empty payload.
+     */
+    enum class ParseMode { FULL, LAZY };
+
+    /**
+     * Describes how messages are serialized by @c str() and @c payload().
+     *
+     * @c PRETTY re-serializes messages with indentation. @c COMPACT serializes messages without
+     * whitespace, and returns the original message text from @c str(), so messages forwarded
+     * unchanged are not re-serialized.
+     */
+    enum class SerializationFormat { PRETTY, COMPACT };
+
+    Message(const std::string& msg, Direction direction, ParseMode mode = ParseMode::FULL);
+    Message(std::string&& msg, Direction direction, ParseMode mode = ParseMode::FULL);
+
+    /**
+     * Creates a message from a generated AASB message object, without serializing it.
+     *
+     * @param object the message object, which must not be modified once it is published
+     * @param direction the direction of the message
+     */
+    template <typename T>
+    static Message fromObject(std::shared_ptr<const T> object, Direction direction);
+
+    /**
+     * Returns the message as a generated AASB message object. A message created from a @c T
+     * object returns the object itself, and any other message is converted from its parsed
+     * document, which is shared by all the subscribers of the message.
+     *
+     * @throw std::exception if the message is not a valid @c T message
+     */
+    template <typename T>
+    std::shared_ptr<const T> as() const;
+
+    // sets the serialization format used for all messages
+    static void setSerializationFormat(SerializationFormat format);
+    static SerializationFormat getSerializationFormat();
 
     bool valid() const;
 
@@ -52,26 +111,104 @@ public:
 
     // payload
     std::string payload() const;
+    const nlohmann::json& payloadJson() const;
 
     // serialize
     std::string str() const;
+    std::string str(SerializationFormat format) const;
+
+    // the original message text
+    const std::string& raw() const;
+
+    // the message encoded as CBOR, from its parsed document rather than its text
+    std::vector<uint8_t> binary() const;
 
     // symbolic constants
     static const Message INVALID;
 
 private:
-    nlohmann::json m_message;
+    // message text and parsed header, shared by copies of the message so it is parsed at most once
+    struct Envelope {
+        std::string raw;
+        std::once_flag parsed;
+        nlohmann::json json;
+        // the object of a message created with fromObject(), serialized on first use
+        std::shared_ptr<const void> object;
+        const std::type_info* objectType = nullptr;
+        std::function<nlohmann::json()> toJson;
+        std::once_flag serialized;
+        MessageType messageType = MessageType::PUBLISH;
+        std::string messageId;
+        std::string topic;
+        std::string action;
+        std::string replyTo;
+    };
+
+    template <typename T>
+    static auto replyToId(const T& object, int) -> decltype(object.header.messageDescription.replyToId) {
+        return object.header.messageDescription.replyToId;
+    }
+    template <typename T>
+    static std::string replyToId(const T&, long) {
+        return std::string();
+    }
+
+    // the header fields read by the scan of the header
+    struct HeaderFields {
+        std::string id;
+        std::string messageType;
+        std::string topic;
+        std::string action;
+        std::string replyTo;
+    };
+
+    void parse(ParseMode mode);
+    static void parseHeader(Envelope& envelope);
+    static void scanHeader(Envelope& envelope);
+    static void readHeader(const std::string& text, HeaderFields& fields);
+    const nlohmann::json& document() const;
+    static int indent(SerializationFormat format);
+
+private:
+    std::shared_ptr<Envelope> m_envelope;
+    bool m_valid = false;
     Direction m_direction;
-    MessageType m_messageType;
-    std::string m_messageId;
-    std::string m_topic;
-    std::string m_action;
-    std::string m_replyTo;
-    std::string m_payload;
 };
 
+template <typename T>
+Message Message::fromObject(std::shared_ptr<const T> object, Direction direction) {
+    Message message;
+    message.m_direction = direction;
+    if (object == nullptr) {
+        return message;
+    }
+
+    auto& envelope = *message.m_envelope;
+    envelope.messageId = object->header.id;
+    envelope.messageType = T::messageType() == "Reply" ? MessageType::REPLY : MessageType::PUBLISH;
+    envelope.topic = T::topic();
+    envelope.action = T::action();
+    envelope.replyTo = replyToId(*object, 0);
+    envelope.object = object;
+    envelope.objectType = &typeid(T);
+    envelope.toJson = [object]() { return nlohmann::json(*object); };
+
+    message.m_valid = !envelope.messageId.empty() &&
+                      (envelope.messageType == MessageType::PUBLISH || !envelope.replyTo.empty());
+    return message;
+}
+
+template <typename T>
+std::shared_ptr<const T> Message::as() const {
+    if (m_envelope->objectType != nullptr && *m_envelope->objectType == typeid(T)) {
+        return std::static_pointer_cast<const T>(m_envelope->object);
+    }
+    return std::make_shared<const T>(document().get<T>());
+}
+
 inline std::ostream& operator<<(std::ostream& stream, const Message& message) {
-    stream << message.str();
+    // messages are always pretty printed in logs
+    stream << message.str(Message::SerializationFormat::PRETTY);
     return stream;
 }
 
@@ -16,10 +16,14 @@
 #ifndef AACE_ENGINE_MESSAGE_BROKER_MESSAGE_ENGINE_SERVICE_H
 #define AACE_ENGINE_MESSAGE_BROKER_MESSAGE_ENGINE_SERVICE_H
 
+#include <thread>
+
 #include <AACE/Engine/Core/EngineService.h>
 
 #include "MessageBrokerServiceInterface.h"
 #include "MessageBrokerImpl.h"
+#include "MessageTrafficRecorder.h"
+#include "MessageTrafficReplayer.h"
 #include "StreamManagerImpl.h"
 
 namespace aace {
@@ -46,6 +50,7 @@ public:
     aace::engine::core::Version getCurrentVersion() override;
     bool getAutoEnableInterfaces() override;
     uint16_t getDefaultMessageTimeout() override;
+    PlatformDeliveryConfig getPlatformDeliveryConfig() override;
 
 protected:
     bool initialize() override;
@@ -53,13 +58,26 @@ protected:
     bool configure() override;
     bool configure(std::shared_ptr<std::istream> configuration) override;
     bool setup() override;
-    // bool start() override;
-    // bool stop() override;
+    bool start() override;
+    bool stop() override;
 
 private:
+    /// Stops the replay of a recording, and waits for the replay thread
+    void stopReplay();
+
     std::shared_ptr<MessageBrokerImpl> m_messageBroker;
     std::shared_ptr<StreamManagerImpl> m_streamManager;
 
+    // records the broker traffic, if configured
+    std::shared_ptr<MessageTrafficRecorder> m_trafficRecorder;
+
+    // replays a recording when the Engine is started, if configured
+    std::string m_replayFile;
+    double m_replaySpeed = 1.0;
+    std::string m_replayReportFile;
+    std::unique_ptr<MessageTrafficReplayer> m_trafficReplayer;
+    std::thread m_replayThread;
+
     // Current message version from build infro
     aace::engine::core::Version m_currentVersion;
     // Message version from engine config file
@@ -68,6 +86,7 @@ private:
     // config
     bool m_autoEnableInterfaces;
     uint16_t m_defaultMessageTimeout;
+    PlatformDeliveryConfig m_platformDeliveryConfig;
 };
 
 }  // namespace messageBroker
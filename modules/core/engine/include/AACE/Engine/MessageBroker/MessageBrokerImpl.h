@@ -18,13 +18,19 @@
 
 #include "MessageBrokerInterface.h"
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 #include <queue>
 
-#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
 
+#include "DispatchLane.h"
+#include "MessageBrokerMetrics.h"
+#include "MessageTrafficRecorder.h"
 #include "PublishMessage.h"
+#include "ReplyLatencyTracker.h"
+#include "SubscriberRoutingIndex.h"
 
 namespace aace {
 namespace engine {
@@ -34,79 +40,296 @@ class MessageBrokerImpl
         : public MessageBrokerInterface
         , public std::enable_shared_from_this<MessageBrokerImpl> {
 private:
-    using SyncPromiseType = std::promise<std::string>;
+    using TimerWheel = aace::engine::utils::threading::TimerWheel;
 
-    MessageBrokerImpl() = default;
+    // a published message waiting for its reply
+    struct PendingReply {
+        // called with the reply message
+        std::function<void(const Message& reply)> replyHandler;
+        // called if the request fails or times out, only used by asynchronous requests
+        std::function<void()> errorHandler;
+        // the dispatch lane the handlers are invoked on, or nullptr to invoke the reply handler
+        // on the thread publishing the reply
+        std::shared_ptr<DispatchLane> executor;
+        // the topic of the request, which sets the priority class of its handlers
+        std::string topic;
+        // the action of the request, and when it was published, for the reply latency
+        std::string action;
+        std::chrono::steady_clock::time_point published;
+        // the reply timeout of an asynchronous request
+        std::atomic<TimerWheel::TimerId> timeoutTimer{TimerWheel::INVALID_TIMER};
+    };
 
-    static std::string getMessageType(
-        Message::Direction direction,
-        const std::string& topic = "*",
-        const std::string& action = "*");
+    // how the incoming messages with a topic and action are coalesced
+    struct CoalescingPolicy {
+        std::chrono::milliseconds minInterval;
+        std::string partition;
+    };
 
-    void publishAsync(const PublishMessage& pm, aace::engine::utils::threading::Executor& executor);
-    Message publishSync(const PublishMessage& pm, aace::engine::utils::threading::Executor& executor);
-    void reply(const PublishMessage& pm);
+    // the latest incoming message of a coalesced topic, action and partition
+    struct CoalescedMessage {
+        Message latest = Message::INVALID;
+        // the message is waiting on its dispatch lane or for the end of the interval
+        bool pending = false;
+        std::chrono::steady_clock::time_point lastDispatch;
+    };
+
+    // serial dispatch lanes for each message direction, messages are assigned a lane by topic
+    struct DispatchLanes {
+        std::vector<std::shared_ptr<DispatchLane>> incoming;
+        std::vector<std::shared_ptr<DispatchLane>> outgoing;
+        // the priority classes and overflow policies shared by the lanes
+        std::shared_ptr<const DispatchLane::Config> config;
+        // the most messages waiting on each lane, or 0 for unbounded lanes
+        size_t incomingQueueSize = 0;
+        size_t outgoingQueueSize = 0;
+    };
+
+    MessageBrokerImpl();
+
+    static std::shared_ptr<DispatchLanes> createDispatchLanes(
+        size_t count,
+        std::shared_ptr<const DispatchLane::Config> config = nullptr,
+        size_t incomingQueueSize = 0,
+        size_t outgoingQueueSize = 0);
+    void replaceDispatchLanes(std::shared_ptr<DispatchLanes> lanes);
+    static void shutdownDispatchLanes(const std::shared_ptr<DispatchLanes>& lanes);
 
     /**
-     * Notifies subscribers of the specified type about a message.
-     *
-     * @param type a string containing message direction, topic, and action, e.g. "OUTGOING:LocationProvider:*"
-     * @param message the message to notify about
+     * Returns the dispatch lane for the specified message. All messages with the same direction
+     * and topic are dispatched on the same lane, in the order they are published.
+     */
+    std::shared_ptr<DispatchLane> getDispatchLane(const Message& message);
+
+    /// Counts a message being enqueued on a dispatch lane, and starts a metrics sample for it
+    MessageBrokerMetrics::Sample startMetricsSample(DispatchLane& executor);
+
+    /// Returns the handler sending a publish message, for both the text and object messages
+    PublishMessage::InvokeHandler createInvokeHandler();
+
+    void publishAsync(const Message& message, DispatchLane& executor);
+
+    /// Returns the reply timeout of a request, which is adapted to the topic unless the publisher set it
+    std::chrono::milliseconds getReplyTimeout(const PublishMessage& pm);
+
+    /**
+     * Publishes an incoming message under its coalescing policy. The message replaces the
+     * pending message with the same key, or is dispatched once the policy interval has elapsed.
      *
-     * @return the number of subscribers notified
+     * @return @c false if no coalescing policy applies to the message
+     */
+    bool publishCoalesced(const Message& message);
+    void postCoalesced(const std::string& key);
+    void dispatchCoalesced(const std::string& key, const MessageBrokerMetrics::Sample& sample);
+    Message publishSync(const PublishMessage& pm, DispatchLane& executor);
+
+    /**
+     * Publishes a message and returns without waiting for the reply. The success handler of
+     * the publish message is invoked with the reply, or the error handler is invoked if there
+     * are no subscribers or the reply isn't received before the message timeout.
      */
-    size_t notifySubscribers(const std::string& type, const Message& message);
+    void publishRequest(const PublishMessage& pm, std::shared_ptr<DispatchLane> executor);
+    void reply(const Message& message);
 
     /**
      * Notifies all subscribers interested in the specified message.
      *
      * @param message the message to notify about
+     * @param sample the metrics sample started when the message was enqueued
      *
      * @return the number of subscriber notified
      */
-    size_t notifySubscribers(const Message& message);
+    size_t notifySubscribers(const Message& message, const MessageBrokerMetrics::Sample& sample);
 
-    void addSyncMessagePromise(const std::string& messageId, std::shared_ptr<SyncPromiseType> promise);
-    void removeSyncMessagePromise(const std::string& messageId);
-    std::shared_ptr<SyncPromiseType> getSyncMessagePromise(const std::string& messageId);
+    bool addPendingReply(const std::string& messageId, std::shared_ptr<PendingReply> pending);
+    std::shared_ptr<PendingReply> takePendingReply(const std::string& messageId);
+    static void failPendingReply(std::shared_ptr<PendingReply> pending);
+
+    void scheduleReplyTimeout(
+        const std::string& messageId,
+        std::shared_ptr<PendingReply> pending,
+        std::chrono::milliseconds timeout);
+    void cancelReplyTimeout(const std::shared_ptr<PendingReply>& pending);
 
 public:
     static std::shared_ptr<MessageBrokerImpl> create();
 
-    virtual ~MessageBrokerImpl() = default;
+    virtual ~MessageBrokerImpl();
 
     void shutdown();
 
     void setMessageTimeout(const std::chrono::milliseconds& value);
 
+    /**
+     * Sets the number of serial dispatch lanes used for each message direction. Messages are
+     * assigned to a lane by hashing their topic, so ordering is preserved within a topic, while
+     * a blocking message only delays the messages of topics sharing its lane. The default is a
+     * single lane per direction. The lane count should be set before the engine is started.
+     *
+     * @param count the number of lanes per direction, which must be greater than zero
+     */
+    void setDispatchLaneCount(size_t count);
+
+    /**
+     * Sets the priority classes of the message topics, so the messages of user-perceived actions,
+     * such as the speech recognizer, are not delayed by bulk messages sharing their dispatch lane,
+     * such as address book uploads. Each lane dispatches the waiting message of the highest class
+     * first, except that a message of a lower class is dispatched once @c starvationLimit messages
+     * of higher classes have been dispatched while it was waiting. The messages of a topic are still
+     * dispatched in the order they are published. The topics without a class are @c NORMAL, and
+     * without any class the lanes dispatch the messages in the order they are published. The
+     * priority classes should be set before the engine is started.
+     *
+     * @param priorities the priority class of each topic
+     * @param starvationLimit the most messages of higher classes dispatched while a message of a
+     *        lower class is waiting, which must be greater than zero
+     */
+    void setTopicPriorities(
+        const DispatchLane::PriorityMap& priorities,
+        size_t starvationLimit = DispatchLane::DEFAULT_STARVATION_LIMIT);
+
+    /**
+     * Sets the most messages waiting on each dispatch lane of a message direction, so a flood of
+     * messages or a stalled subscriber doesn't queue messages without limit. A message published
+     * while its lane is full is handled by the overflow policy of its topic: @c REJECT drops the
+     * message, @c DROP_OLDEST drops the oldest waiting message of the topic instead, and
+     * @c COALESCE drops the waiting message with the same topic and action instead. The waiting
+     * messages expecting a reply are never dropped for a newer message, and the replies to
+     * asynchronous requests are queued even if the lane is full. The default is unbounded lanes.
+     * The queue sizes should be set before the engine is started.
+     *
+     * @param incomingQueueSize the most incoming messages waiting on each lane, or @c 0 for no limit
+     * @param outgoingQueueSize the most outgoing messages waiting on each lane, or @c 0 for no limit
+     * @param overflowPolicies the overflow policy of each topic, or "*" for the topics without their
+     *        own policy, which are @c REJECT otherwise
+     */
+    void setDispatchQueueSize(
+        size_t incomingQueueSize,
+        size_t outgoingQueueSize,
+        const DispatchLane::OverflowPolicyMap& overflowPolicies = {});
+
+    /**
+     * Sets how often dispatch metrics are sampled. One of every @c interval published messages
+     * records its dispatch lane queue depth, enqueue to dispatch latency and handler execution
+     * time. The default is @c 0, which disables sampling.
+     *
+     * @param interval the sampling interval, or @c 0 to disable sampling
+     */
+    void setMetricsSampleInterval(uint32_t interval);
+    uint32_t getMetricsSampleInterval() const;
+
+    /**
+     * Sets how the incoming messages with a topic and action are coalesced, for the state
+     * updates the platform publishes faster than the Engine needs them. While a message waits to
+     * be dispatched, a newer message with the same topic, action and partition replaces it, and
+     * at most one of these messages is dispatched every @c minInterval, so the subscribers
+     * only receive the latest state. The replaced messages are dropped before their payload is
+     * parsed, unless the policy has a partition. Only messages published without waiting for a
+     * reply are coalesced.
+     *
+     * @param topic the message topic
+     * @param action the message action, or "*" for all the actions of the topic
+     * @param minInterval the shortest time between two dispatched messages, or zero to only drop
+     *        the messages replaced while waiting on their dispatch lane
+     * @param partition a JSON pointer to the payload value of the messages coalesced separately,
+     *        such as "/channel", or empty to coalesce all the messages of the topic and action
+     */
+    void setCoalescingPolicy(
+        const std::string& topic,
+        const std::string& action,
+        std::chrono::milliseconds minInterval,
+        const std::string& partition = "");
+
+    /**
+     * Returns the aggregated per-topic dispatch metrics, and the current queue depth and
+     * dropped messages of each dispatch lane.
+     */
+    MessageBrokerMetrics::Snapshot getMetricsSnapshot();
+
+    /// Clears the aggregated per-topic dispatch metrics.
+    void resetMetrics();
+
+    /**
+     * Sets how the reply timeouts of the requests are adapted to the latency of the replies of
+     * each topic and action, so slow topics don't time out and fast topics fail early. The timeout
+     * set on a published message is always kept. The adaptive timeouts should be set before the
+     * engine is started.
+     */
+    void setAdaptiveTimeouts(const ReplyLatencyTracker::Config& config);
+
+    /// Returns the reply latency, replies, timeouts and adaptive timeout of each topic and action.
+    std::vector<ReplyLatencyTracker::TopicStats> getReplyLatencySnapshot() const;
+
+    /**
+     * Sets the recorder of the published messages, which records each message when it is
+     * published, before it is coalesced or dropped by its dispatch lane.
+     *
+     * @param recorder the recorder, or @c nullptr to stop recording
+     */
+    void setTrafficRecorder(std::shared_ptr<MessageTrafficRecorder> recorder);
+
+    /**
+     * Waits for the messages published before the call to be dispatched, including the outgoing
+     * messages the subscribers of the incoming messages publish while they are dispatched.
+     */
+    void waitForDispatchedMessages();
+
     // MessageBrokerInterface
-    void subscribe(
+    SubscriptionId subscribe(
         const std::string& topic,
         MessageHandler handler,
         Message::Direction direction = Message::Direction::INCOMING) override;
-    void subscribe(
+    SubscriptionId subscribe(
         const std::string& topic,
         const std::string& action,
         MessageHandler handler,
         Message::Direction direction = Message::Direction::INCOMING) override;
+    bool unsubscribe(SubscriptionId id) override;
     PublishMessage publish(const std::string& message, Message::Direction direction = Message::Direction::OUTGOING)
         override;
+    PublishMessage publish(const Message& message) override;
+    using MessageBrokerInterface::publish;
+    size_t publishBatch(
+        const std::vector<std::string>& messages,
+        Message::Direction direction = Message::Direction::OUTGOING,
+        bool coalesce = false) override;
 
 private:
-    bool m_isShutdown = false;
+    std::atomic<bool> m_isShutdown{false};
+    std::mutex m_shutdown_mutex;
 
-    // executor for deferred asynchronous message sending
-    aace::engine::utils::threading::Executor m_incomingMessageExecutor;
-    aace::engine::utils::threading::Executor m_outgoingMessageExecutor;
+    // executors for deferred message sending, replaced by setDispatchLaneCount().
+    // The lanes must only be accessed with std::atomic_load() and std::atomic_store().
+    std::shared_ptr<DispatchLanes> m_dispatchLanes;
 
-    // map of subscribers
-    std::unordered_map<std::string, std::vector<MessageHandler>> m_subscriberMap;
+    // precompiled index of subscribers, replaced copy-on-write by subscribe() and unsubscribe().
+    // The index must only be accessed with std::atomic_load() and std::atomic_store(), so
+    // dispatching messages never waits for a subscriber change.
+    std::shared_ptr<const SubscriberRoutingIndex> m_subscriberIndex = std::make_shared<SubscriberRoutingIndex>();
 
-    // mutex and map for handling synchronous messages
+    // serializes subscriber index updates
     std::mutex m_pub_sub_mutex;
-    std::mutex m_promise_map_access_mutex;
-    std::mutex m_wait_for_sync_response_mutex;
-    std::unordered_map<std::string, std::shared_ptr<SyncPromiseType>> m_syncMessagePromiseMap;
+
+    // mutex and map of messages waiting for a reply
+    std::mutex m_pending_reply_mutex;
+    std::unordered_map<std::string, std::shared_ptr<PendingReply>> m_pendingReplyMap;
+
+    // runs the reply timeouts of asynchronous requests
+    std::shared_ptr<TimerWheel> m_timerWheel;
+
+    // coalescing policies by "topic:action", and the coalesced messages by key
+    std::mutex m_coalescing_mutex;
+    std::unordered_map<std::string, CoalescingPolicy> m_coalescingPolicies;
+    std::unordered_map<std::string, CoalescedMessage> m_coalescedMessages;
+
+    // sampled dispatch metrics
+    MessageBrokerMetrics m_metrics;
+
+    // the reply latency and adaptive reply timeout of each topic and action
+    ReplyLatencyTracker m_replyLatency;
+
+    // records the published messages, only accessed with std::atomic_load() and std::atomic_store()
+    std::shared_ptr<MessageTrafficRecorder> m_trafficRecorder;
 
     // message time out
     std::chrono::milliseconds m_timeout = std::chrono::milliseconds(500);
@@ -21,6 +21,8 @@
 #include <iostream>
 #include <functional>
 #include <chrono>
+#include <cstdint>
+#include <vector>
 
 #include "PublishMessage.h"
 
@@ -32,18 +34,54 @@ class MessageBrokerInterface {
 public:
     using MessageHandler = std::function<void(const Message& message)>;
 
-    virtual void subscribe(
+    // identifies a subscribed message handler; zero is never a valid subscription id
+    using SubscriptionId = uint64_t;
+
+    virtual SubscriptionId subscribe(
         const std::string& topic,
         MessageHandler handler,
         Message::Direction direction = Message::Direction::INCOMING) = 0;
-    virtual void subscribe(
+    virtual SubscriptionId subscribe(
         const std::string& topic,
         const std::string& action,
         MessageHandler handler,
         Message::Direction direction = Message::Direction::INCOMING) = 0;
+    virtual bool unsubscribe(SubscriptionId id) = 0;
     virtual PublishMessage publish(
         const std::string& message,
         Message::Direction direction = Message::Direction::OUTGOING) = 0;
+
+    /**
+     * Publishes a message created in-process, such as a message created from a generated AASB
+     * message object with @c Message::fromObject(). The subscribers in the Engine read the object
+     * with @c Message::as() without parsing it, and the message is only serialized if a
+     * subscriber reads its text, such as the platform.
+     */
+    virtual PublishMessage publish(const Message& message) = 0;
+
+    /**
+     * Publishes a generated AASB message object without serializing it.
+     *
+     * @param object the message object, which must not be modified once it is published
+     */
+    template <typename T>
+    PublishMessage publish(std::shared_ptr<T> object, Message::Direction direction = Message::Direction::OUTGOING) {
+        return publish(Message::fromObject(std::shared_ptr<const T>(object), direction));
+    }
+
+    /**
+     * Publishes a batch of messages without waiting for replies. The messages are dispatched
+     * in order, with one dispatch task for the messages sharing a dispatch lane. If @c coalesce
+     * is @c true, only the last of the published messages with the same topic and action in the
+     * batch is dispatched, which is intended for state updates where only the latest value is
+     * meaningful. Reply messages are never coalesced.
+     *
+     * @return the number of messages dispatched, after invalid and coalesced messages are dropped
+     */
+    virtual size_t publishBatch(
+        const std::vector<std::string>& messages,
+        Message::Direction direction = Message::Direction::OUTGOING,
+        bool coalesce = false) = 0;
 };
 
 }  // namespace messageBroker
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_MESSAGE_BROKER_MESSAGE_BROKER_METRICS_H
+#define AACE_ENGINE_MESSAGE_BROKER_MESSAGE_BROKER_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "DispatchLane.h"
+#include "Message.h"
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+/**
+ * Sampled dispatch metrics of the message broker.
+ *
+ * One of every @c sampleInterval published messages is sampled. A sampled message records the
+ * depth of its dispatch lane when it is enqueued, the latency from enqueue to dispatch, and the
+ * time and thread CPU time spent in its subscriber handlers. Each sample is aggregated per direction, topic and action,
+ * and emitted as a metric event. Messages that aren't sampled only increment an atomic counter, and
+ * nothing is recorded while sampling is disabled.
+ */
+class MessageBrokerMetrics {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Upper bounds of the latency histogram buckets, the last bucket counts all larger values
+    static constexpr std::array<uint32_t, 12> HISTOGRAM_BUCKET_BOUNDS_US = {
+        {50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 1000000}};
+
+    /// Latency histogram in microseconds
+    struct Histogram {
+        std::array<uint64_t, HISTOGRAM_BUCKET_BOUNDS_US.size() + 1> buckets{};
+        uint64_t count = 0;
+        uint64_t totalUs = 0;
+        uint64_t maxUs = 0;
+
+        void add(Clock::duration duration);
+    };
+
+    /// Aggregated samples of the messages published with the same direction, topic and action
+    struct TopicMetrics {
+        Message::Direction direction;
+        std::string topic;
+        std::string action;
+        uint64_t samples = 0;
+        size_t maxQueueDepth = 0;
+        Histogram dispatchLatency;
+        Histogram handlerTime;
+        Histogram handlerCpuTime;
+    };
+
+    /// Point in time copy of the metrics
+    struct Snapshot {
+        uint32_t sampleInterval = 0;
+        uint64_t publishedMessages = 0;
+        std::vector<TopicMetrics> topics;
+        // current queue depth of each dispatch lane, filled in by the message broker
+        std::vector<size_t> incomingQueueDepth;
+        std::vector<size_t> outgoingQueueDepth;
+        // the queue occupancy and dropped messages of each dispatch lane, filled in by the message broker
+        std::vector<DispatchLane::Metrics> incomingLanes;
+        std::vector<DispatchLane::Metrics> outgoingLanes;
+    };
+
+    /// Sampling state captured when a message is enqueued and carried to its dispatch
+    struct Sample {
+        bool sampled = false;
+        Clock::time_point enqueued;
+        size_t queueDepth = 0;
+    };
+
+    /**
+     * Sets the sampling interval. One of every @c interval published messages is sampled, and
+     * @c 0 disables sampling, which is the default.
+     */
+    void setSampleInterval(uint32_t interval);
+    uint32_t getSampleInterval() const;
+
+    /**
+     * Counts a published message and returns whether it is sampled.
+     *
+     * @param queueDepth the number of tasks queued on the message's dispatch lane, only
+     *     evaluated if the message is sampled
+     */
+    template <typename QueueDepth>
+    Sample startSample(QueueDepth queueDepth);
+
+    /**
+     * Records a sampled message after its subscribers have been notified, and emits the sample.
+     *
+     * @param message the dispatched message
+     * @param sample the sample returned by @c startSample()
+     * @param dispatched the time the message was dequeued from its dispatch lane
+     * @param completed the time the last subscriber handler returned
+     * @param cpuTime the CPU time of the dispatching thread spent in the subscriber handlers
+     */
+    void record(
+        const Message& message,
+        const Sample& sample,
+        Clock::time_point dispatched,
+        Clock::time_point completed,
+        Clock::duration cpuTime = Clock::duration::zero());
+
+    /// Returns the CPU time consumed by the calling thread, or zero if it isn't available
+    static Clock::duration threadCpuTime();
+
+    /// Returns a copy of the aggregated metrics
+    Snapshot getSnapshot() const;
+
+    /// Clears the aggregated metrics
+    void reset();
+
+private:
+    using TopicKey = std::tuple<Message::Direction, std::string, std::string>;
+
+    std::atomic<uint32_t> m_sampleInterval{0};
+    std::atomic<uint64_t> m_publishedMessages{0};
+
+    mutable std::mutex m_mutex;
+    std::map<TopicKey, TopicMetrics> m_topics;
+};
+
+template <typename QueueDepth>
+MessageBrokerMetrics::Sample MessageBrokerMetrics::startSample(QueueDepth queueDepth) {
+    Sample sample;
+    auto interval = m_sampleInterval.load(std::memory_order_relaxed);
+    if (interval != 0 && m_publishedMessages.fetch_add(1, std::memory_order_relaxed) % interval == 0) {
+        sample.sampled = true;
+        sample.queueDepth = queueDepth();
+        sample.enqueued = Clock::now();
+    }
+    return sample;
+}
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_MESSAGE_BROKER_MESSAGE_BROKER_METRICS_H
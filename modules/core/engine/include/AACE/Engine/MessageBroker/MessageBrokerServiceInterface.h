@@ -17,6 +17,8 @@
 #define AACE_ENGINE_MESSAGE_BROKER_MESSAGE_SERVICE_INTERFACE_H
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <AACE/Engine/Core/ServiceDescription.h>
 
 #include "MessageBrokerInterface.h"
@@ -27,6 +29,26 @@ namespace engine {
 namespace messageBroker {
 
 class MessageBrokerServiceInterface {
+public:
+    /// What the delivery of the outgoing messages to the platform does with a message when its queue is full
+    enum class OverflowPolicy {
+        // wait for the platform to take a message from the queue
+        BLOCK,
+        // drop the oldest queued message of the same topic, or the message if none is queued
+        DROP_OLDEST,
+        // drop the message
+        DROP_NEWEST
+    };
+
+    /// The configuration of the delivery of the outgoing messages to the platform
+    struct PlatformDeliveryConfig {
+        /// The most messages queued for the platform, or 0 to deliver them on the dispatching thread
+        size_t queueSize = 1024;
+
+        /// The overflow policies by topic, the policy of "*" applies to the other topics
+        std::unordered_map<std::string, OverflowPolicy> overflowPolicies;
+    };
+
 public:
     virtual ~MessageBrokerServiceInterface();
 
@@ -37,6 +59,7 @@ public:
     virtual aace::engine::core::Version getCurrentVersion() = 0;
     virtual bool getAutoEnableInterfaces() = 0;
     virtual uint16_t getDefaultMessageTimeout() = 0;
+    virtual PlatformDeliveryConfig getPlatformDeliveryConfig() = 0;
 };
 
 }  // namespace messageBroker
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_MESSAGE_BROKER_MESSAGE_TRAFFIC_RECORDER_H
+#define AACE_ENGINE_MESSAGE_BROKER_MESSAGE_TRAFFIC_RECORDER_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <AACE/Core/MessageStream.h>
+
+#include "Message.h"
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+/**
+ * Records the messages published to the message broker, and optionally the data of the message
+ * streams, to a file which can be replayed with @c MessageTrafficReplayer.
+ *
+ * The file starts with the 8 byte magic "AACTRF01", followed by the records. Each record is a
+ * little endian header of the record type (1 byte), the time since the recording started in
+ * microseconds (8 bytes), the stream id length (2 bytes) and the data length (4 bytes), followed
+ * by the stream id and the data. The data of a message record is the compact serialization of the
+ * message, and the stream id is empty.
+ */
+class MessageTrafficRecorder : public std::enable_shared_from_this<MessageTrafficRecorder> {
+public:
+    /// The type of a record
+    enum class RecordType : uint8_t {
+        /// A message published by the platform to the Engine
+        INCOMING_MESSAGE = 1,
+        /// A message published by the Engine to the platform
+        OUTGOING_MESSAGE = 2,
+        /// The data written to a stream
+        STREAM_WRITE = 3,
+        /// The data read from a stream
+        STREAM_READ = 4
+    };
+
+    /// A record of the file
+    struct Record {
+        RecordType type;
+        std::chrono::microseconds timestamp;
+        std::string streamId;
+        std::string data;
+    };
+
+    /// Reads the records of a recording in the order they were recorded
+    class Reader {
+    public:
+        /**
+         * Opens a recording.
+         *
+         * @param path The path of the recording.
+         * @returns The reader, or @c nullptr if the file can't be opened or isn't a recording.
+         */
+        static std::unique_ptr<Reader> open(const std::string& path);
+
+        /**
+         * Reads the next record.
+         *
+         * @param [out] record The record.
+         * @returns @c false at the end of the recording, or if the last record is truncated.
+         */
+        bool next(Record& record);
+
+    private:
+        Reader() = default;
+
+        std::ifstream m_file;
+    };
+
+    /**
+     * Creates a recorder writing to a file, which is replaced if it exists.
+     *
+     * @param path The path of the recording.
+     * @param recordStreams Whether the data of the streams is recorded, which can be large.
+     * @returns The recorder, or @c nullptr if the file can't be created.
+     */
+    static std::shared_ptr<MessageTrafficRecorder> create(const std::string& path, bool recordStreams = false);
+
+    ~MessageTrafficRecorder();
+
+    /// Records a published message, with the direction of the message.
+    void recordMessage(const Message& message);
+
+    /// Records the data written to or read from a stream.
+    void recordStream(RecordType type, const std::string& streamId, const char* data, size_t size);
+
+    /// Returns @c true if the data of the streams is recorded.
+    bool recordsStreams() const;
+
+    /**
+     * Returns a stream which records the data read from and written to @c stream, or @c stream
+     * itself if the data of the streams isn't recorded.
+     */
+    std::shared_ptr<aace::core::MessageStream> wrapStream(
+        const std::string& streamId,
+        std::shared_ptr<aace::core::MessageStream> stream);
+
+    /// Writes the buffered records, and stops recording.
+    void close();
+
+private:
+    MessageTrafficRecorder(bool recordStreams);
+
+    void writeRecord(RecordType type, const std::string& streamId, const char* data, size_t size);
+
+    const bool m_recordStreams;
+    const std::chrono::steady_clock::time_point m_start;
+
+    std::mutex m_mutex;
+    std::ofstream m_file;
+};
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_MESSAGE_BROKER_MESSAGE_TRAFFIC_RECORDER_H
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_MESSAGE_BROKER_MESSAGE_TRAFFIC_REPLAYER_H
+#define AACE_ENGINE_MESSAGE_BROKER_MESSAGE_TRAFFIC_REPLAYER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "MessageBrokerImpl.h"
+#include "MessageTrafficRecorder.h"
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+/**
+ * Replays a recording of @c MessageTrafficRecorder into the message broker, so the dispatch cost of
+ * a session can be measured deterministically on an Engine without a platform.
+ *
+ * The incoming messages of the recording are published to the broker at their recorded times,
+ * scaled by the replay speed. The outgoing messages and the stream data aren't replayed, since the
+ * Engine publishes its own outgoing messages, and the streams of the recording are created by the
+ * messages which request them. While replaying, each published message is sampled, and the report
+ * aggregates the dispatch latency, handler time and handler CPU time of each topic and action,
+ * including the outgoing messages the Engine publishes in response.
+ */
+class MessageTrafficReplayer {
+public:
+    /// The result of a replay
+    struct Report {
+        /// The incoming messages published to the broker
+        uint64_t replayedMessages = 0;
+        /// The records which aren't replayed, such as the outgoing messages and the stream data
+        uint64_t skippedRecords = 0;
+        /// The time from the first to the last replayed message of the recording
+        std::chrono::microseconds recordedDuration{0};
+        /// The time from the first replayed message to the dispatch of the last message
+        std::chrono::microseconds replayDuration{0};
+        /// The CPU time of the process while replaying
+        std::chrono::microseconds processCpuTime{0};
+        /// The broker metrics of the replay, every message is sampled
+        MessageBrokerMetrics::Snapshot metrics;
+    };
+
+    /**
+     * Creates a replayer.
+     *
+     * @param broker The message broker the messages are published to.
+     * @param path The path of the recording.
+     * @param speed The factor the recorded times are divided by, such as @c 2 to replay twice as
+     *        fast, or @c 0 to publish the messages without waiting.
+     * @returns The replayer, or @c nullptr if the recording can't be opened or the speed is negative.
+     */
+    static std::unique_ptr<MessageTrafficReplayer> create(
+        std::shared_ptr<MessageBrokerImpl> broker,
+        const std::string& path,
+        double speed = 1.0);
+
+    /**
+     * Replays the recording, and waits for the replayed messages to be dispatched. A replayer can
+     * only replay its recording once.
+     *
+     * @returns @c false if the replay was stopped, or the recording was already replayed.
+     */
+    bool replay();
+
+    /// Stops a replay in progress, which returns without publishing the remaining messages.
+    void stop();
+
+    /// Returns the report of the last replay.
+    Report getReport() const;
+
+    /**
+     * Writes the report of the last replay as a JSON document.
+     *
+     * @param path The path of the report, which is replaced if it exists.
+     * @returns @c false if the report can't be written.
+     */
+    bool writeReport(const std::string& path) const;
+
+private:
+    MessageTrafficReplayer(
+        std::shared_ptr<MessageBrokerImpl> broker,
+        std::unique_ptr<MessageTrafficRecorder::Reader> reader,
+        const std::string& path,
+        double speed);
+
+    /// Waits until @c deadline, and returns @c false if the replay is stopped first.
+    bool waitUntil(std::chrono::steady_clock::time_point deadline);
+
+    std::shared_ptr<MessageBrokerImpl> m_broker;
+    std::unique_ptr<MessageTrafficRecorder::Reader> m_reader;
+    const std::string m_path;
+    const double m_speed;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_stopped;
+    bool m_stop = false;
+    Report m_report;
+};
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_MESSAGE_BROKER_MESSAGE_TRAFFIC_REPLAYER_H
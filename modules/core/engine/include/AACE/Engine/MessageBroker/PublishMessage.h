@@ -39,29 +39,49 @@ public:
         const std::string& message,
         std::chrono::milliseconds timeout,
         InvokeHandler invokeHandler);
+    PublishMessage(const Message& message, std::chrono::milliseconds timeout, InvokeHandler invokeHandler);
     PublishMessage(const PublishMessage& pm);
 
+    /**
+     * Sets the reply timeout of the message, which is kept even if the message broker adapts
+     * the timeouts of the topic to the latency of its replies.
+     */
     PublishMessage& timeout(std::chrono::milliseconds duration);
+
+    /**
+     * Sets the handlers for the reply to the message. If either handler is set, @c send()
+     * publishes the message as an asynchronous request: it returns without waiting for the
+     * reply, and the success handler is invoked with the reply when it is received. The error
+     * handler is invoked if there are no subscribers for the message, or the reply isn't
+     * received before the message timeout.
+     */
     PublishMessage& success(SuccessHandler handler);
     PublishMessage& error(ErrorHandler handler);
 
+    // publishes the message without blocking
     void send();
+
+    // publishes the message and blocks the calling thread until the reply is received
     Message get();
 
     // accessor methods
     Message::Direction direction() const;
     std::string msg() const;
     std::chrono::milliseconds timeout() const;
+    // whether the timeout was set with timeout(), rather than defaulted by the message broker
+    bool hasTimeout() const;
     SuccessHandler successHandler() const;
     ErrorHandler errorHandler() const;
 
-    Message message() const;
+    const Message& message() const;
     bool valid() const;
 
 protected:
     Message::Direction m_direction;
-    std::string m_message;
+    // the message is parsed lazily once, and shared with every copy of the publish message
+    Message m_message;
     std::chrono::milliseconds m_timeout;
+    bool m_hasTimeout = false;
     InvokeHandler m_invokeHandler;
     SuccessHandler m_successHandler;
     ErrorHandler m_errorHandler;
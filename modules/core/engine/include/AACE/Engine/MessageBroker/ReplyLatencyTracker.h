@@ -0,0 +1,143 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_MESSAGE_BROKER_REPLY_LATENCY_TRACKER_H
+#define AACE_ENGINE_MESSAGE_BROKER_REPLY_LATENCY_TRACKER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+/**
+ * Tracks the latency of the replies to the requests published with each topic and action, and derives the reply
+ * timeout of the requests from it when adaptive timeouts are enabled.
+ *
+ * The timeout of a topic and action is a multiple of the 99th percentile of its last replies, between the shortest
+ * and longest timeout of the topic. A request that times out is counted as a reply taking its timeout, so the
+ * timeout of a topic whose replies keep timing out grows up to its longest timeout. Until enough replies are
+ * observed, the requests use the default timeout of the message broker. The replies and timeouts are counted while
+ * adaptive timeouts are disabled, and the statistics are emitted as a metric each time the timeout is updated.
+ */
+class ReplyLatencyTracker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// The number of the last replies of a topic and action the percentile is computed from
+    static constexpr size_t WINDOW_SIZE = 128;
+
+    /// The number of replies between two updates of the timeout of a topic and action
+    static constexpr uint32_t UPDATE_INTERVAL = 16;
+
+    /// The shortest and longest reply timeouts of a topic
+    struct Limits {
+        Limits(
+            std::chrono::milliseconds minTimeout = std::chrono::milliseconds(100),
+            std::chrono::milliseconds maxTimeout = std::chrono::milliseconds(5000)) :
+                minTimeout(minTimeout), maxTimeout(maxTimeout) {
+        }
+
+        std::chrono::milliseconds minTimeout;
+        std::chrono::milliseconds maxTimeout;
+    };
+
+    struct Config {
+        bool enabled = false;
+        /// The timeout is this multiple of the 99th percentile of the reply latency
+        double multiplier = 2.0;
+        /// The number of replies observed before the timeout adapts
+        uint32_t minSamples = 32;
+        /// The limits of the topics without their own limits
+        Limits limits;
+        /// The limits of topics, by "topic" or "topic:action"
+        std::unordered_map<std::string, Limits> topicLimits;
+    };
+
+    /// The statistics of the replies to the requests with a topic and action
+    struct TopicStats {
+        std::string topic;
+        std::string action;
+        uint64_t replies = 0;
+        uint64_t timeouts = 0;
+        /// The exponentially weighted moving average of the reply latency
+        double averageLatencyMs = 0;
+        double p99LatencyMs = 0;
+        /// The adaptive timeout, or zero until enough replies are observed
+        std::chrono::milliseconds timeout{0};
+    };
+
+    /// Sets the configuration, and clears the statistics.
+    void setConfig(const Config& config);
+
+    /**
+     * Returns the reply timeout of a request.
+     *
+     * @param defaultTimeout The timeout used until enough replies are observed, or if adaptive timeouts are
+     *        disabled.
+     */
+    std::chrono::milliseconds getTimeout(
+        const std::string& topic,
+        const std::string& action,
+        std::chrono::milliseconds defaultTimeout);
+
+    /// Records the reply to a request, received @c latency after it was published.
+    void recordReply(const std::string& topic, const std::string& action, Clock::duration latency);
+
+    /// Records a request that timed out without a reply.
+    void recordTimeout(const std::string& topic, const std::string& action, std::chrono::milliseconds timeout);
+
+    /// Returns a copy of the statistics of each topic and action.
+    std::vector<TopicStats> getSnapshot() const;
+
+    /// Clears the statistics.
+    void reset();
+
+private:
+    struct TopicState {
+        TopicStats stats;
+        Limits limits;
+        // the last latencies in microseconds, of which @c count are valid
+        std::array<uint32_t, WINDOW_SIZE> latencies{};
+        size_t next = 0;
+        size_t count = 0;
+        uint32_t sinceUpdate = 0;
+        // the replies and timeouts since the statistics were last emitted
+        uint32_t newReplies = 0;
+        uint32_t newTimeouts = 0;
+    };
+
+    TopicState& getState(const std::string& topic, const std::string& action);
+
+    /// Adds a latency to the window of a topic.
+    void addLatency(TopicState& state, Clock::duration latency);
+    void updateTimeout(TopicState& state);
+
+    mutable std::mutex m_mutex;
+    Config m_config;
+    std::unordered_map<std::string, TopicState> m_topics;
+};
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_MESSAGE_BROKER_REPLY_LATENCY_TRACKER_H
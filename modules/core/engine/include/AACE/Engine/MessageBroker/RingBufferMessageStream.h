@@ -0,0 +1,152 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_MESSAGE_BROKER_RING_BUFFER_MESSAGE_STREAM_H
+#define AACE_ENGINE_MESSAGE_BROKER_RING_BUFFER_MESSAGE_STREAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <AACE/Core/MessageStream.h>
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+/**
+ * Single-producer, single-consumer ring buffer @c MessageStream.
+ *
+ * One thread writes to the stream and one thread reads from it, without locking. In addition
+ * to the copying @c read() and @c write() calls, the stream exposes its buffer directly: the
+ * producer acquires a writable region, fills it and commits it, and the consumer acquires a
+ * readable region, processes it in place and commits it.
+ *
+ * The ring buffer can be backed by a named POSIX shared memory object, so a process that opens
+ * the same name with @c openShared() can be the producer or the consumer. The control block at
+ * the start of the shared memory only contains lock-free atomics and fixed-size fields.
+ */
+class RingBufferMessageStream : public aace::core::MessageStream {
+public:
+    /// Contiguous region of the ring buffer
+    struct Region {
+        char* data = nullptr;
+        size_t size = 0;
+    };
+
+    /**
+     * Creates a ring buffer stream backed by private memory of the current process.
+     *
+     * @param capacity the buffer size in bytes, rounded up to a power of two
+     * @param mode the stream mode reported to the stream consumer
+     */
+    static std::shared_ptr<RingBufferMessageStream> create(size_t capacity, Mode mode = Mode::READ_WRITE);
+
+    /**
+     * Creates a ring buffer stream backed by a new named shared memory object. The object is
+     * unlinked when the stream is destroyed.
+     *
+     * @param name the shared memory object name, starting with '/'
+     * @param capacity the buffer size in bytes, rounded up to a power of two
+     * @param mode the stream mode reported to the stream consumer
+     *
+     * @return the stream, or @c nullptr if the shared memory object could not be created
+     */
+    static std::shared_ptr<RingBufferMessageStream> createShared(
+        const std::string& name,
+        size_t capacity,
+        Mode mode = Mode::READ_WRITE);
+
+    /**
+     * Opens a ring buffer stream created by @c createShared(), typically in another process.
+     *
+     * @return the stream, or @c nullptr if the shared memory object could not be opened
+     */
+    static std::shared_ptr<RingBufferMessageStream> openShared(const std::string& name, Mode mode = Mode::READ_WRITE);
+
+    ~RingBufferMessageStream();
+
+    /**
+     * Returns the largest contiguous writable region, up to @c maxSize bytes. The region is
+     * empty if the buffer is full or the stream is closed. Only the producer may call this.
+     */
+    Region acquireWriteRegion(size_t maxSize = SIZE_MAX);
+
+    /// Makes the first @c size bytes of the acquired write region available to the consumer
+    void commitWriteRegion(size_t size);
+
+    /**
+     * Returns the largest contiguous readable region, up to @c maxSize bytes. The region is
+     * empty if no data is available. Only the consumer may call this.
+     */
+    Region acquireReadRegion(size_t maxSize = SIZE_MAX);
+
+    /// Releases the first @c size bytes of the acquired read region back to the producer
+    void commitReadRegion(size_t size);
+
+    /// Closes the stream. The consumer can read the remaining data before @c isClosed() returns @c true.
+    void close();
+
+    /// Returns the number of bytes available to read
+    size_t available() const;
+
+    /// Returns the buffer size in bytes
+    size_t capacity() const;
+
+    // aace::core::MessageStream
+    ssize_t read(char* data, const size_t size) override;
+    ssize_t write(const char* data, const size_t size) override;
+    bool isClosed() override;
+    Mode getMode() override;
+
+private:
+    // control block shared by the producer and the consumer, followed by the buffer
+    struct ControlBlock {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+        // the indexes increase monotonically and are masked to index the buffer
+        alignas(64) std::atomic<uint64_t> writeIndex;
+        alignas(64) std::atomic<uint64_t> readIndex;
+        std::atomic<uint32_t> closed;
+    };
+
+    RingBufferMessageStream(
+        ControlBlock* control,
+        size_t mappedSize,
+        const std::string& sharedName,
+        bool owner,
+        Mode mode);
+
+    static void initialize(ControlBlock* control, size_t capacity);
+    static size_t roundUpCapacity(size_t capacity);
+
+    char* buffer() const;
+
+private:
+    ControlBlock* m_control;
+    size_t m_mappedSize;
+    std::string m_sharedName;
+    bool m_owner;
+    Mode m_mode;
+    uint64_t m_mask;
+};
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_MESSAGE_BROKER_RING_BUFFER_MESSAGE_STREAM_H
@@ -21,6 +21,8 @@
 
 #include <AACE/Core/MessageStream.h>
 
+#include "MessageTrafficRecorder.h"
+#include "RingBufferMessageStream.h"
 #include "StreamManagerInterface.h"
 
 namespace aace {
@@ -40,14 +42,51 @@ public:
 
     void shutdown();
 
+    /**
+     * Creates a ring buffer stream and registers it with the specified stream id. If
+     * @c sharedMemoryName is not empty, the ring buffer is backed by a shared memory object with
+     * that name, so a client in another process can read or write the stream without copying
+     * the data through the message broker.
+     *
+     * @param streamId the id of the stream
+     * @param capacity the ring buffer size in bytes
+     * @param mode the stream mode
+     * @param sharedMemoryName the shared memory object name, or empty for a process private buffer
+     *
+     * @return the registered stream, or @c nullptr if the stream could not be created or registered
+     */
+    std::shared_ptr<RingBufferMessageStream> createRingBufferStream(
+        const std::string& streamId,
+        size_t capacity,
+        aace::core::MessageStream::Mode mode,
+        const std::string& sharedMemoryName = "");
+
+    /**
+     * Sets the recorder of the stream data. If the recorder records streams, each requested
+     * stream records the data read from and written to it.
+     *
+     * @param recorder the recorder, or @c nullptr to stop recording
+     */
+    void setTrafficRecorder(std::shared_ptr<MessageTrafficRecorder> recorder);
+
     // aace::engine::messageBroker::StreamManagerInterface
-    bool registerStreamHandler(const std::string& streamId, std::shared_ptr<aace::core::MessageStream> stream) override;
+    bool registerStreamHandler(
+        const std::string& streamId,
+        std::shared_ptr<aace::core::MessageStream> stream,
+        bool persistent = false) override;
     std::shared_ptr<aace::core::MessageStream> requestStreamHandler(
         const std::string& streamId,
         aace::core::MessageStream::Mode mode) override;
+    bool unregisterStreamHandler(const std::string& streamId) override;
 
 private:
-    std::unordered_map<std::string, std::shared_ptr<aace::core::MessageStream>> m_streamMap;
+    struct StreamEntry {
+        std::shared_ptr<aace::core::MessageStream> stream;
+        bool persistent;
+    };
+
+    std::unordered_map<std::string, StreamEntry> m_streamMap;
+    std::shared_ptr<MessageTrafficRecorder> m_trafficRecorder;
     std::mutex m_mutex;
 };
 
@@ -27,13 +27,22 @@ namespace messageBroker {
 
 class StreamManagerInterface {
 public:
+    /**
+     * Registers a stream handler with the specified stream id. A stream handler is removed when it
+     * is requested, unless it is registered as @c persistent, which allows a pooled stream to be
+     * opened again with the same stream id until it is unregistered.
+     */
     virtual bool registerStreamHandler(
         const std::string& streamId,
-        std::shared_ptr<aace::core::MessageStream> stream) = 0;
+        std::shared_ptr<aace::core::MessageStream> stream,
+        bool persistent = false) = 0;
 
     virtual std::shared_ptr<aace::core::MessageStream> requestStreamHandler(
         const std::string& streamId,
         aace::core::MessageStream::Mode mode) = 0;
+
+    /// Removes a registered stream handler, returns @c false if the stream id is not registered
+    virtual bool unregisterStreamHandler(const std::string& streamId) = 0;
 };
 
 }  // namespace messageBroker
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_MESSAGE_BROKER_SUBSCRIBER_ROUTING_INDEX_H
+#define AACE_ENGINE_MESSAGE_BROKER_SUBSCRIBER_ROUTING_INDEX_H
+
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "MessageBrokerInterface.h"
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+/**
+ * Precompiled index of message subscribers.
+ *
+ * Topic and action names are interned when a handler subscribes, and the handlers for every
+ * (direction, topic, action) route are resolved ahead of time, including the "topic:*" and "*:*"
+ * wildcard subscribers. Looking up the handlers for a message is a topic lookup followed by an
+ * action lookup, and returns an immutable handler snapshot that can be invoked without copying.
+ *
+ * The index is not thread safe. The message broker treats each published index as an immutable
+ * snapshot: writers copy the current index, modify the copy, and atomically replace it, so readers
+ * never need to lock.
+ */
+class SubscriberRoutingIndex {
+public:
+    using MessageHandler = MessageBrokerInterface::MessageHandler;
+    using SubscriptionId = MessageBrokerInterface::SubscriptionId;
+    using HandlerList = std::vector<MessageHandler>;
+    using HandlerListPtr = std::shared_ptr<const HandlerList>;
+
+    SubscriberRoutingIndex();
+
+    /**
+     * Adds a message handler to the index and recompiles the affected routes.
+     *
+     * @param direction the message direction
+     * @param topic the message topic, or "*" to receive all topics
+     * @param action the message action, or "*" to receive all actions for the topic
+     * @param handler the handler to add
+     *
+     * @return the id of the new subscription
+     */
+    SubscriptionId addHandler(
+        Message::Direction direction,
+        const std::string& topic,
+        const std::string& action,
+        MessageHandler handler);
+
+    /**
+     * Removes a message handler from the index and recompiles the affected routes.
+     *
+     * @param id the subscription id returned by @c addHandler()
+     *
+     * @return @c true if the subscription was found and removed
+     */
+    bool removeHandler(SubscriptionId id);
+
+    /**
+     * Returns the handlers for all three wildcard levels of the specified route, in notification
+     * order: "topic:action" handlers first, then "topic:*", then "*:*".
+     *
+     * @return an immutable handler snapshot, never @c nullptr
+     */
+    HandlerListPtr getHandlers(Message::Direction direction, const std::string& topic, const std::string& action)
+        const;
+
+private:
+    using InternId = size_t;
+
+    struct Subscription {
+        SubscriptionId id;
+        MessageHandler handler;
+    };
+    using SubscriptionList = std::vector<Subscription>;
+
+    struct Route {
+        size_t direction;
+        bool wildcardTopic;
+        InternId topicId;
+        InternId actionId;
+    };
+
+    // interned id reserved for the "*" wildcard
+    static constexpr InternId WILDCARD_ID = 0;
+
+    struct TopicEntry {
+        // interned action names for this topic
+        std::unordered_map<std::string, InternId> actionIds;
+        // subscribed handlers indexed by [direction][actionId]
+        std::array<std::vector<SubscriptionList>, 2> subscribers;
+        // resolved handler snapshots indexed by [direction][actionId]
+        std::array<std::vector<HandlerListPtr>, 2> routes;
+    };
+
+    static size_t directionIndex(Message::Direction direction);
+    static bool isWildcard(const std::string& name);
+
+    TopicEntry& internTopic(const std::string& topic);
+    InternId internAction(TopicEntry& entry, const std::string& action);
+
+    void compileRoutes(size_t direction, TopicEntry& entry);
+    void compileWildcardRoutes(size_t direction);
+
+private:
+    std::unordered_map<std::string, InternId> m_topicIds;
+    std::vector<TopicEntry> m_topics;
+
+    // subscribers and resolved routes for messages that don't match a subscribed topic
+    std::array<SubscriptionList, 2> m_wildcardSubscribers;
+    std::array<HandlerListPtr, 2> m_wildcardRoutes;
+
+    // the route of each subscription, used to remove it
+    std::unordered_map<SubscriptionId, Route> m_routes;
+    SubscriptionId m_nextSubscriptionId = 1;
+};
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_MESSAGE_BROKER_SUBSCRIBER_ROUTING_INDEX_H
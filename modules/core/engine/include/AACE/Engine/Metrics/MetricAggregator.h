@@ -0,0 +1,170 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_METRICS_METRIC_AGGREGATOR_H
+#define AACE_ENGINE_METRICS_METRIC_AGGREGATOR_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+
+namespace aace {
+namespace engine {
+namespace metrics {
+
+/**
+ * Aggregates the counter and timer datapoints of the non-buffered, non-unique metrics, and records them as one
+ * metric per program and source when it is flushed.
+ *
+ * Each emitting thread adds its datapoints to its own shard, so emitting a datapoint doesn't contend with the
+ * other threads or allocate once its key has been seen. The counters of a key are summed, and the values of a timer
+ * are counted in a log-linear histogram with 8 buckets per power of two, which keeps the recorded values within
+ * 7% of the emitted values. On flush the shards are merged, and each counter is recorded with its sum and each
+ * timer bucket with its value, both with the number of samples they aggregate as the datapoint sample count.
+ *
+ * Aggregation is disabled until a flush interval is set, and the datapoints are then recorded as they are emitted.
+ */
+class MetricAggregator : public std::enable_shared_from_this<MetricAggregator> {
+public:
+    /// An aggregated counter
+    struct Counter {
+        std::string name;
+        int64_t sum;
+        uint32_t sampleCount;
+    };
+
+    /// A bucket of an aggregated timer
+    struct Timer {
+        std::string name;
+        double value;
+        uint32_t sampleCount;
+    };
+
+    /// The aggregated datapoints of a program and source
+    struct Metric {
+        std::string program;
+        std::string source;
+        std::vector<Counter> counters;
+        std::vector<Timer> timers;
+    };
+
+    /**
+     * Creates a metric aggregator.
+     *
+     * @param timerWheel The timer wheel running the periodic flush, or @c nullptr for the default timer wheel.
+     */
+    static std::shared_ptr<MetricAggregator> create(
+        std::shared_ptr<aace::engine::utils::threading::TimerWheel> timerWheel = nullptr);
+
+    /// Returns the process wide aggregator used by the metric emit helpers.
+    static std::shared_ptr<MetricAggregator> getDefault();
+
+    ~MetricAggregator();
+
+    /**
+     * Sets the interval the aggregated datapoints are flushed at. An interval of @c 0, the default, flushes the
+     * aggregated datapoints and disables aggregation.
+     */
+    void setFlushInterval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds getFlushInterval();
+
+    /// Returns whether the datapoints are aggregated.
+    bool isEnabled() const;
+
+    /**
+     * Adds the value of a counter.
+     *
+     * @return @c false if aggregation is disabled, in which case the caller records the datapoint.
+     */
+    bool addCounter(const std::string& program, const std::string& source, const std::string& name, int value);
+
+    /**
+     * Adds the value of a timer, in milliseconds.
+     *
+     * @return @c false if aggregation is disabled, in which case the caller records the datapoint.
+     */
+    bool addTimer(const std::string& program, const std::string& source, const std::string& name, double value);
+
+    /// Merges the shards and returns the aggregated datapoints, which are cleared.
+    std::vector<Metric> collect();
+
+    /// Records the aggregated datapoints as metric events, and clears them.
+    void flush();
+
+    /// Returns the histogram bucket of a timer value, in milliseconds.
+    static uint32_t getTimerBucket(double value);
+
+    /// Returns the value recorded for a histogram bucket, the middle of its range.
+    static double getTimerBucketValue(uint32_t bucket);
+
+private:
+    /// The number of shards, the emitting threads are spread over them
+    static const size_t SHARD_COUNT = 16;
+
+    /// The number of histogram buckets per power of two, as a power of two
+    static const int SUB_BUCKET_BITS = 3;
+
+    struct CounterValue {
+        int64_t sum = 0;
+        uint32_t sampleCount = 0;
+    };
+
+    /// The sample count of each non-empty bucket of a timer
+    using Histogram = std::map<uint32_t, uint32_t>;
+
+    /// The datapoints added by the threads of a shard, keyed by program, source and name
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, CounterValue> counters;
+        std::unordered_map<std::string, Histogram> timers;
+    };
+
+    MetricAggregator(std::shared_ptr<aace::engine::utils::threading::TimerWheel> timerWheel);
+
+    /// Returns the shard of the calling thread.
+    Shard& getShard();
+
+    /// Sets the key of a datapoint in the key buffer of the calling thread, and returns it.
+    static const std::string& makeKey(const std::string& program, const std::string& source, const std::string& name);
+
+    /// Splits a key into the program and source, and the name.
+    static bool splitKey(const std::string& key, std::string& programAndSource, std::string& name);
+
+    std::shared_ptr<aace::engine::utils::threading::TimerWheel> m_timerWheel;
+
+    std::array<Shard, SHARD_COUNT> m_shards;
+
+    std::atomic<bool> m_enabled;
+
+    /// Serializes the flush interval changes and the flushes.
+    std::mutex m_flushMutex;
+    std::chrono::milliseconds m_flushInterval;
+    aace::engine::utils::threading::TimerWheel::TimerId m_flushTimer;
+};
+
+}  // namespace metrics
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_METRICS_METRIC_AGGREGATOR_H
@@ -16,6 +16,7 @@
 #ifndef AACE_ENGINE_METRICS_METRIC_EVENT_H
 #define AACE_ENGINE_METRICS_METRIC_EVENT_H
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
@@ -105,6 +106,15 @@ public:
      */
     void addTimer(const std::string& name, double value);
 
+    /**
+     * Add timer data aggregating several samples to the metric event.
+     *
+     * @param name The name describing the datapoint being captured.
+     * @param value The time in milliseconds.
+     * @param sampleCount The number of samples that took @c value.
+     */
+    void addTimer(const std::string& name, double value, uint32_t sampleCount);
+
     /**
      * Add string data to the metric event. 
      *
@@ -121,6 +131,15 @@ public:
      */
     void addCounter(const std::string& name, int value);
 
+    /**
+     * Add counter data aggregating several samples to the metric event.
+     *
+     * @param name The name describing the datapoint being captured.
+     * @param value The sum of the samples.
+     * @param sampleCount The number of samples summed in @c value.
+     */
+    void addCounter(const std::string& name, int value, uint32_t sampleCount);
+
     /**
      * Print the metric event data via logger in a standardized metric format.
      */
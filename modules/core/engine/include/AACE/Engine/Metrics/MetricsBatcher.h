@@ -0,0 +1,194 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_METRICS_METRICS_BATCHER_H
+#define AACE_ENGINE_METRICS_METRICS_BATCHER_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <AACE/Engine/Network/BackgroundTransferScheduler.h>
+#include <AACE/Engine/Network/NetworkInfoObserver.h>
+#include <AACE/Engine/Storage/LocalStorageInterface.h>
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+#include <AACE/Metrics/MetricsUploader.h>
+
+namespace aace {
+namespace engine {
+namespace metrics {
+
+/**
+ * Groups the metrics recorded by the Engine in batches, and hands them to the @c MetricsUploader platform interface
+ * one batch at a time from its own thread.
+ *
+ * A batch is sent when it has @c maxBatchSize metrics, or @c maxBatchDelay after its first metric. While the network
+ * is disconnected, the batches are spooled to the local storage, compressed when the Engine is built with log
+ * compression, and the oldest batches are dropped beyond @c maxSpooledBatches. Once the network is connected again,
+ * the spooled batches are sent oldest first, one every @c drainInterval, so the platform is not flooded with the
+ * metrics of a long drive without coverage. With a background transfer scheduler, each spooled batch is also deferred
+ * on a weak wifi signal, a metered link or during a voice interaction.
+ */
+class MetricsBatcher
+        : public aace::engine::network::NetworkInfoObserver
+        , public std::enable_shared_from_this<MetricsBatcher> {
+public:
+    /// A metric, with the arguments of @c MetricsUploader::record()
+    struct Metric {
+        std::vector<aace::metrics::MetricsUploader::Datapoint> datapoints;
+        std::unordered_map<std::string, std::string> metadata;
+        bool buffer;
+        bool unique;
+    };
+
+    struct Configuration {
+        /// The most metrics of a batch
+        size_t maxBatchSize = 20;
+        /// The longest time a metric waits in a batch before it is sent
+        std::chrono::milliseconds maxBatchDelay = std::chrono::seconds(10);
+        /// The most batches kept in the local storage while the network is disconnected
+        size_t maxSpooledBatches = 100;
+        /// The time between the spooled batches sent once the network is connected
+        std::chrono::milliseconds drainInterval = std::chrono::seconds(1);
+    };
+
+    /// The local storage table of the spooled batches
+    static const std::string SPOOL_TABLE;
+
+    /**
+     * Creates a metrics batcher.
+     *
+     * @param metricsUploader The platform interface the batches are sent to.
+     * @param configuration The limits of the batches and the spool.
+     * @param timerWheel The timer wheel scheduling the batches, or @c nullptr for the default timer wheel.
+     */
+    static std::shared_ptr<MetricsBatcher> create(
+        std::shared_ptr<aace::metrics::MetricsUploader> metricsUploader,
+        const Configuration& configuration,
+        std::shared_ptr<aace::engine::utils::threading::TimerWheel> timerWheel = nullptr);
+
+    ~MetricsBatcher();
+
+    /**
+     * Adds a metric to the current batch. This is called by the metrics log sink, so it doesn't log.
+     *
+     * @param metric The metric.
+     */
+    void add(Metric metric);
+
+    /**
+     * Sets the local storage the batches are spooled to while the network is disconnected, and sends the batches
+     * spooled by the previous Engine if the network is connected.
+     *
+     * @param localStorage The local storage, or @c nullptr to keep the batches in memory.
+     * @param networkStatus The current network status.
+     */
+    void setLocalStorage(
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage,
+        NetworkStatus networkStatus = NetworkStatus::CONNECTED);
+
+    /**
+     * Sets the scheduler the spooled batches are sent through.
+     *
+     * @param backgroundTransferScheduler The scheduler, or @c nullptr to send the spooled batches at the drain
+     * interval only.
+     */
+    void setBackgroundTransferScheduler(
+        std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler);
+
+    /// Sends or spools the current batch, and waits for the batches being sent.
+    void flush();
+
+    /// Spools or sends the current batch, and stops sending batches.
+    void shutdown();
+
+    /// Returns the number of spooled batches.
+    size_t getSpooledBatchCount();
+
+    /// Serializes a batch.
+    static std::string serialize(const std::vector<Metric>& batch);
+
+    /// Deserializes a batch serialized by @c serialize().
+    static bool deserialize(const std::string& data, std::vector<Metric>& batch);
+
+    // aace::engine::network::NetworkInfoObserver
+    void onNetworkInfoChanged(NetworkStatus status, int wifiSignalStrength) override;
+    void onNetworkInterfaceChangeStatusChanged(
+        const std::string& networkInterface,
+        NetworkInterfaceChangeStatus status) override;
+
+private:
+    MetricsBatcher(
+        std::shared_ptr<aace::metrics::MetricsUploader> metricsUploader,
+        const Configuration& configuration,
+        std::shared_ptr<aace::engine::utils::threading::TimerWheel> timerWheel);
+
+    /// Takes the current batch. @c m_mutex must be held.
+    std::vector<Metric> takeBatchLocked();
+
+    /// Sends a batch, or spools it if the network is disconnected. Runs on the executor.
+    void executeSendBatch(std::vector<Metric> batch);
+
+    /// Sends the metrics of a batch to the platform interface. Runs on the executor.
+    void executeRecord(const std::vector<Metric>& batch);
+
+    /// Adds a batch to the spool, dropping the oldest batches beyond the limit. Runs on the executor.
+    void executeSpool(const std::vector<Metric>& batch);
+
+    /// Sends the oldest spooled batch, and schedules the next one. Runs on the executor.
+    void executeDrain();
+
+    /// Schedules the next spooled batch to be sent after the drain interval. Runs on the executor.
+    void scheduleDrain(std::chrono::milliseconds delay);
+
+    /// Posts the drain of the next spooled batch, through the background transfer scheduler if it is set.
+    void postDrain();
+
+    /// Returns the local storage key of a spooled batch.
+    static std::string toSpoolKey(uint64_t sequence);
+
+    std::shared_ptr<aace::metrics::MetricsUploader> m_metricsUploader;
+    const Configuration m_configuration;
+    std::shared_ptr<aace::engine::utils::threading::TimerWheel> m_timerWheel;
+
+    /// The current batch, protected by @c m_mutex
+    std::mutex m_mutex;
+    std::vector<Metric> m_batch;
+    aace::engine::utils::threading::TimerWheel::TimerId m_batchTimer;
+    bool m_shutdown;
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> m_backgroundTransferScheduler;
+
+    /// The state of the spool, only used on the executor
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> m_localStorage;
+    std::vector<std::vector<Metric>> m_memorySpool;
+    std::vector<uint64_t> m_spooledSequences;
+    uint64_t m_nextSequence;
+    bool m_connected;
+    aace::engine::utils::threading::TimerWheel::TimerId m_drainTimer;
+
+    /// Sends the batches to the platform interface one at a time
+    aace::engine::utils::threading::Executor m_executor;
+};
+
+}  // namespace metrics
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_METRICS_METRICS_BATCHER_H
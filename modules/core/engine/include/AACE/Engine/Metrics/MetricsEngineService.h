@@ -18,6 +18,9 @@
 
 #include "AACE/Engine/Core/EngineService.h"
 #include "AACE/Engine/Logger/LoggerEngineService.h"
+#include "AACE/Engine/Utils/JSON/JSON.h"
+#include "AACE/Engine/Network/NetworkObservableInterface.h"
+#include "MetricsBatcher.h"
 #include "MetricsUploaderEngineImpl.h"
 
 namespace aace {
@@ -35,7 +38,9 @@ public:
     virtual ~MetricsEngineService() = default;
 
 protected:
+    bool configureFromJson(const aace::engine::utils::json::Value& configuration) override;
     bool shutdown() override;
+    bool postRegister() override;
 
     bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) override;
 
@@ -51,6 +56,11 @@ private:
 
 private:
     std::shared_ptr<aace::engine::metrics::MetricsUploaderEngineImpl> m_metricsUploaderEngineImpl;
+
+    /// The batching configuration, or @c nullptr if the metrics are not batched
+    std::unique_ptr<MetricsBatcher::Configuration> m_batchingConfiguration;
+    std::shared_ptr<MetricsBatcher> m_metricsBatcher;
+    std::shared_ptr<aace::engine::network::NetworkObservableInterface> m_networkObservable;
 };
 
 }  // namespace metrics
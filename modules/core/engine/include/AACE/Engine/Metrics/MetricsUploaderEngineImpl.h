@@ -19,6 +19,7 @@
 #include "AACE/Engine/Logger/Sinks/Sink.h"
 #include "AACE/Engine/Logger/LoggerServiceInterface.h"
 #include "AACE/Metrics/MetricsUploader.h"
+#include "MetricsBatcher.h"
 
 namespace aace {
 namespace engine {
@@ -40,11 +41,21 @@ public:
     static const std::string UNIQUE;
     static const std::string BUFFER;
 
+    /**
+     * Creates the metrics uploader log sink.
+     *
+     * @param platformMetricsUploaderInterface The platform interface the metrics are recorded with.
+     * @param metricsBatcher The batcher the metrics are handed to, or @c nullptr to record each metric as it is
+     * logged.
+     */
     static std::shared_ptr<MetricsUploaderEngineImpl> create(
-        std::shared_ptr<aace::metrics::MetricsUploader> platformMetricsUploaderInterface);
+        std::shared_ptr<aace::metrics::MetricsUploader> platformMetricsUploaderInterface,
+        std::shared_ptr<MetricsBatcher> metricsBatcher = nullptr);
 
 private:
-    MetricsUploaderEngineImpl(std::shared_ptr<aace::metrics::MetricsUploader> platformMetricsUploaderInterface);
+    MetricsUploaderEngineImpl(
+        std::shared_ptr<aace::metrics::MetricsUploader> platformMetricsUploaderInterface,
+        std::shared_ptr<MetricsBatcher> metricsBatcher);
 
     bool initialize();
 
@@ -58,6 +69,8 @@ private:
 
 private:
     std::shared_ptr<aace::metrics::MetricsUploader> m_platformMetricsUploaderInterface;
+    std::shared_ptr<MetricsBatcher> m_metricsBatcher;
+    std::mutex m_mutex;
 };
 
 }  // namespace metrics
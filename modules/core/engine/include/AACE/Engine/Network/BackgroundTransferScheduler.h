@@ -0,0 +1,172 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_NETWORK_BACKGROUND_TRANSFER_SCHEDULER_H
+#define AACE_ENGINE_NETWORK_BACKGROUND_TRANSFER_SCHEDULER_H
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <AACE/Engine/Network/NetworkInfoObserver.h>
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+
+namespace aace {
+namespace engine {
+namespace network {
+
+/**
+ * Schedules the network transfers of the Engine that don't have to run as soon as they are triggered, such as the
+ * address book and metrics uploads, so the voice traffic keeps the bandwidth and metered links are spared.
+ *
+ * The transfers run one at a time from the scheduler's thread, at least @c minInterval apart, while the network is
+ * connected and no voice interaction is active. A background transfer is also deferred while the wifi signal is
+ * weaker than @c minWifiSignalStrength or the link is metered, for at most @c maxDeferral. A transfer submitted
+ * while another transfer of the same name is pending replaces it, so repeated triggers are batched in one transfer.
+ */
+class BackgroundTransferScheduler
+        : public NetworkInfoObserver
+        , public std::enable_shared_from_this<BackgroundTransferScheduler> {
+public:
+    enum class Priority {
+        /// A transfer someone waits for, only deferred while a voice interaction is active
+        INTERACTIVE,
+        /// A transfer nobody waits for, also deferred on a weak wifi signal or a metered link
+        BACKGROUND
+    };
+
+    struct Configuration {
+        /// The weakest wifi signal, in dBm, background transfers run on without deferral
+        int minWifiSignalStrength = -80;
+        /// The longest time a background transfer is deferred on a weak wifi signal or a metered link
+        std::chrono::milliseconds maxDeferral = std::chrono::minutes(15);
+        /// The shortest time between the start of two transfers
+        std::chrono::milliseconds minInterval = std::chrono::seconds(1);
+    };
+
+    using Transfer = std::function<void()>;
+
+    /**
+     * Creates a background transfer scheduler.
+     *
+     * @param configuration The deferral limits of the transfers.
+     * @param timerWheel The timer wheel scheduling the deferred transfers, or @c nullptr for the default timer wheel.
+     */
+    static std::shared_ptr<BackgroundTransferScheduler> create(
+        const Configuration& configuration,
+        std::shared_ptr<aace::engine::utils::threading::TimerWheel> timerWheel = nullptr);
+
+    ~BackgroundTransferScheduler();
+
+    /**
+     * Submits a transfer, which runs on the scheduler's thread once the network conditions allow it.
+     *
+     * @param name The name of the transfer, a pending transfer of the same name is replaced.
+     * @param priority The priority of the transfer.
+     * @param transfer The function making the transfer.
+     * @return @c true if the transfer was submitted, or @c false if the scheduler is shutdown.
+     */
+    bool submit(const std::string& name, Priority priority, Transfer transfer);
+
+    /**
+     * Sets whether the link is metered, such as a paid or trial data plan.
+     *
+     * @param metered @c true if the link is metered.
+     */
+    void setMetered(bool metered);
+
+    /**
+     * Sets whether a voice interaction is active, from the start of the listening to the end of the speech.
+     *
+     * @param active @c true if a voice interaction is active.
+     */
+    void setVoiceActive(bool active);
+
+    /// Returns the number of transfers waiting to run.
+    size_t getPendingTransferCount();
+
+    /// Drops the pending transfers, and waits for the transfer running.
+    void shutdown();
+
+    // aace::engine::network::NetworkInfoObserver
+    void onNetworkInfoChanged(NetworkStatus status, int wifiSignalStrength) override;
+    void onNetworkInterfaceChangeStatusChanged(
+        const std::string& networkInterface,
+        NetworkInterfaceChangeStatus status) override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// A transfer waiting to run
+    struct PendingTransfer {
+        std::string name;
+        Priority priority;
+        Transfer transfer;
+        Clock::time_point submitTime;
+    };
+
+    BackgroundTransferScheduler(
+        const Configuration& configuration,
+        std::shared_ptr<aace::engine::utils::threading::TimerWheel> timerWheel);
+
+    /// Returns the time a pending transfer is allowed to run at. @c m_mutex must be held.
+    Clock::time_point getAllowedTimeLocked(const PendingTransfer& pendingTransfer) const;
+
+    /// Runs the next transfer allowed now, or waits for the time it is allowed. @c m_mutex must be held.
+    void scheduleLocked();
+
+    /// Runs the next transfer allowed, and schedules the following one. Runs on the executor.
+    void executeTransfer();
+
+    const Configuration m_configuration;
+    std::shared_ptr<aace::engine::utils::threading::TimerWheel> m_timerWheel;
+
+    /// The pending transfers and the network conditions, protected by @c m_mutex
+    std::mutex m_mutex;
+    std::deque<PendingTransfer> m_pendingTransfers;
+    bool m_connected;
+    bool m_weakSignal;
+    bool m_metered;
+    bool m_voiceActive;
+    bool m_transferPosted;
+    bool m_shutdown;
+    Clock::time_point m_lastTransferTime;
+    aace::engine::utils::threading::TimerWheel::TimerId m_timer;
+
+    /// Runs the transfers one at a time
+    aace::engine::utils::threading::Executor m_executor;
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const BackgroundTransferScheduler::Priority& priority) {
+    switch (priority) {
+        case BackgroundTransferScheduler::Priority::INTERACTIVE:
+            stream << "INTERACTIVE";
+            break;
+        case BackgroundTransferScheduler::Priority::BACKGROUND:
+            stream << "BACKGROUND";
+            break;
+    }
+    return stream;
+}
+
+}  // namespace network
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_NETWORK_BACKGROUND_TRANSFER_SCHEDULER_H
@@ -21,6 +21,7 @@
 #include "AACE/Engine/PropertyManager/PropertyManagerEngineService.h"
 #include "AACE/Network/NetworkInfoProvider.h"
 
+#include "BackgroundTransferScheduler.h"
 #include "NetworkInfoProviderEngineImpl.h"
 
 namespace aace {
@@ -50,6 +51,10 @@ public:
 
 protected:
     bool initialize() override;
+    bool configure() override;
+    bool configureFromJson(const aace::engine::utils::json::Value& configuration) override;
+    bool postRegister() override;
+    bool shutdown() override;
     bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) override;
 
 private:
@@ -62,10 +67,12 @@ private:
 
     bool registerPlatformInterfaceType(std::shared_ptr<aace::network::NetworkInfoProvider> networkInfoProvider);
     bool registerProperties();
+    bool createBackgroundTransferScheduler(const BackgroundTransferScheduler::Configuration& configuration);
 
 private:
     std::shared_ptr<NetworkInfoProviderEngineImpl> m_networkInfoProviderEngineImpl;
     std::shared_ptr<aace::network::NetworkInfoProvider> m_networkInfoProvider;
+    std::shared_ptr<BackgroundTransferScheduler> m_backgroundTransferScheduler;
 };
 
 }  // namespace network
@@ -59,18 +59,29 @@ public:
     using Setter = std::function<bool(const std::string&, bool&, bool&, const SetterCallback&)>;
 
     PropertyDescription() = default;
-    PropertyDescription(const std::string& name, Setter setter, Getter getter);
+
+    /**
+     * @param [in] name The name of the property
+     * @param [in] setter The function setting the property, or @c nullptr if the property is read only
+     * @param [in] getter The function getting the property
+     * @param [in] cacheable @c true if the value of the property only changes through its setter or through
+     *        @c PropertyManagerServiceInterface::updatePropertyValue(), so the Property Manager may return the
+     *        value it cached instead of calling the getter
+     */
+    PropertyDescription(const std::string& name, Setter setter, Getter getter, bool cacheable = false);
     PropertyDescription(const PropertyDescription& other);
     PropertyDescription& operator=(const PropertyDescription& other) = default;
 
     Getter getter() const;
     Setter setter() const;
     std::string getPropertyName() const;
+    bool isCacheable() const;
 
 private:
     Setter m_setter;
     Getter m_getter;
     std::string m_name;
+    bool m_cacheable = false;
 };
 
 }  // namespace propertyManager
@@ -16,6 +16,9 @@
 #ifndef AACE_ENGINE_PROPERTY_MANAGER_PROPERTY_LISTENER_INTERFACE_H
 #define AACE_ENGINE_PROPERTY_MANAGER_PROPERTY_LISTENER_INTERFACE_H
 
+#include <string>
+#include <unordered_map>
+
 namespace aace {
 namespace engine {
 namespace propertyManager {
@@ -41,6 +44,22 @@ public:
      * @param [in] newValue The new value of the property
      */
     virtual void propertyChanged(const std::string& name, const std::string& newValue) = 0;
+
+    /**
+     * Notifies the listener once about the values of the properties it listens to
+     * that changed together, after all the values set with
+     * aace::engine::propertyManager::PropertyManagerServiceInterface::setProperties()
+     * were applied. A listener that reacts to several properties overrides this
+     * method to react once. By default, propertyChanged() is called for each
+     * property.
+     *
+     * @param [in] changes The new value of each property that changed
+     */
+    virtual void propertiesChanged(const std::unordered_map<std::string, std::string>& changes) {
+        for (auto& next : changes) {
+            propertyChanged(next.first, next.second);
+        }
+    }
 };
 
 }  // namespace propertyManager
@@ -43,6 +43,7 @@ public:
 
     // PropertyManagerEngineInterface
     virtual bool onSetProperty(const std::string& name, const std::string& value) override;
+    virtual bool onSetProperties(const std::unordered_map<std::string, std::string>& values) override;
     virtual std::string onGetProperty(const std::string& name) override;
 
     /**
@@ -22,6 +22,7 @@
 #include "PropertyDescription.h"
 #include "PropertyManagerEngineImpl.h"
 #include "PropertyManagerServiceInterface.h"
+#include "PropertyRegistry.h"
 
 namespace aace {
 namespace engine {
@@ -46,7 +47,12 @@ public:
     virtual bool addListener(const std::string& name, std::shared_ptr<PropertyListenerInterface> listener) override;
     virtual void removeListener(const std::string& name, std::shared_ptr<PropertyListenerInterface> listener) override;
     virtual bool setProperty(const std::string& name, const std::string& value, const bool& fromPlatform) override;
+    virtual bool setProperties(
+        const std::unordered_map<std::string, std::string>& values,
+        const bool& fromPlatform) override;
     virtual std::string getProperty(const std::string& name) override;
+    virtual PropertyHandle getPropertyHandle(const std::string& name) override;
+    virtual std::string getPropertyValue(PropertyHandle handle) override;
 
     // Callback function to notify the PropertyManagerEngineService the result
     // of setProperty() operation.
@@ -75,6 +81,21 @@ private:
     // propertyChanged() on every PropertyListenerInterface.
     void notifyPropertyChangeListeners(const std::string& key, const std::string& propertyValue);
 
+    // Notifies each listener once about the changes of the properties it listens to
+    // by calling propertiesChanged().
+    void notifyPropertyChangeListeners(const std::unordered_map<std::string, std::string>& changes);
+
+    // Runs the setter of a property on the executor, and notifies the platform of
+    // the result unless the setter reports it asynchronously. @c changed is set if
+    // the value changed and the listeners are to be notified.
+    bool applyProperty(
+        PropertyHandle handle,
+        const PropertyDescription::Setter& setter,
+        const std::string& name,
+        const std::string& value,
+        bool fromPlatform,
+        bool& changed);
+
     // Notifies the platform and listeners about a successful set property
     // operation. Expects m_propertyManagerEngineImpl to be not null.
     void handleSetSuccess(
@@ -83,14 +104,22 @@ private:
         const std::string& name,
         const std::string& value);
 
+    // Notifies the platform about a successful set property operation, without
+    // notifying the listeners. Expects m_propertyManagerEngineImpl to be not null.
+    void notifyPlatformOfSuccess(
+        const bool& changed,
+        const bool& fromPlatform,
+        const std::string& name,
+        const std::string& value);
+
     // Notifies the platform about a failed set property operation
     // Expects m_propertyManagerEngineImpl to be not null.
     void handleSetFailed(const bool& fromPlatform, const std::string& name, const std::string& value);
 
 private:
-    // Map to store property name and the PropertyDescription object
-    // associated with that property.
-    std::unordered_map<std::string, PropertyDescription> m_propertyDescriptionMap;
+    // The registered properties, and the cached values of the cacheable
+    // properties.
+    PropertyRegistry m_propertyRegistry;
 
     // Map to store property name and the set of listeners for that property.
     // The property owner is responsible for adding itself as a listener to the
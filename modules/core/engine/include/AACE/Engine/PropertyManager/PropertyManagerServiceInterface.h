@@ -16,6 +16,11 @@
 #ifndef AACE_ENGINE_PROPERTY_PROPERTY_MANAGER_SERVICE_INTERFACE_H
 #define AACE_ENGINE_PROPERTY_PROPERTY_MANAGER_SERVICE_INTERFACE_H
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 #include "PropertyDescription.h"
 #include "PropertyListenerInterface.h"
 
@@ -30,6 +35,12 @@ namespace propertyManager {
  */
 class PropertyManagerServiceInterface {
 public:
+    /**
+     * Identifies a registered property, so a module reading the property often
+     * does not look its name up on every read. @c 0 never identifies a property.
+     */
+    using PropertyHandle = uint32_t;
+
     virtual ~PropertyManagerServiceInterface() = default;
 
     /**
@@ -100,6 +111,24 @@ public:
      */
     virtual bool setProperty(const std::string& name, const std::string& value, const bool& fromPlatform = false) = 0;
 
+    /**
+     * Sets several property values in the Engine together, such as the
+     * properties the platform changes at boot or on a profile switch. The values
+     * are applied one after the other, without any other property being set in
+     * between, and the listeners are notified once, after all the values are
+     * applied. The result of each property is reported as for setProperty().
+     *
+     * @param [in] values The value of each property, by name.
+     * @param [in] fromPlatform Flag to denote if the call originated from the
+     *        platform, as for setProperty().
+     * @return @c true if the values are being applied, else @c false if a
+     *         property is not registered or is read only, in which case no value
+     *         is applied.
+     */
+    virtual bool setProperties(
+        const std::unordered_map<std::string, std::string>& values,
+        const bool& fromPlatform = false) = 0;
+
     /**
      * Retrieves the setting for the property identified by
      * @c name from the Engine. This can be called by any internal
@@ -113,6 +142,27 @@ public:
      *        property value was not found.
      */
     virtual std::string getProperty(const std::string& name) = 0;
+
+    /**
+     * Retrieves the handle of the property identified by @c name, which
+     * stays valid until the Engine shuts down.
+     *
+     * @param [in] name The name used by the Engine to identify the property.
+     * @return The handle of the property, or @c 0 if the property is not
+     *         registered.
+     */
+    virtual PropertyHandle getPropertyHandle(const std::string& name) = 0;
+
+    /**
+     * Retrieves the setting for the property identified by @c handle. The
+     * value of a cacheable property is returned without calling its owner
+     * once it was read.
+     *
+     * @param [in] handle The handle returned by @c getPropertyHandle().
+     * @return The property value as a string, or an empty string if the
+     *        property value was not found.
+     */
+    virtual std::string getPropertyValue(PropertyHandle handle) = 0;
 };
 
 }  // namespace propertyManager
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_PROPERTY_MANAGER_PROPERTY_REGISTRY_H
+#define AACE_ENGINE_PROPERTY_MANAGER_PROPERTY_REGISTRY_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PropertyDescription.h"
+#include "PropertyManagerServiceInterface.h"
+
+namespace aace {
+namespace engine {
+namespace propertyManager {
+
+/**
+ * Keeps the registered properties in a table indexed by their handle, and
+ * caches the values of the cacheable properties.
+ *
+ * A cached value is read with an atomic load of a shared pointer rather
+ * than under a lock, and is invalidated when the property is set or its
+ * owner reports a change. The properties are registered before they are
+ * read, during the initialization of their owners.
+ */
+class PropertyRegistry {
+public:
+    using PropertyHandle = PropertyManagerServiceInterface::PropertyHandle;
+
+    /**
+     * Registers a property.
+     *
+     * @return The handle of the property, or @c 0 if its name is empty or
+     *         already registered.
+     */
+    PropertyHandle add(const PropertyDescription& propertyDescription);
+
+    /**
+     * @return The handle of the property named @c name, or @c 0 if the
+     *         property is not registered.
+     */
+    PropertyHandle getHandle(const std::string& name) const;
+
+    /**
+     * @return The description of the property, or @c nullptr if @c handle
+     *         does not identify a property.
+     */
+    const PropertyDescription* getDescription(PropertyHandle handle) const;
+
+    /**
+     * Gets the value of a property, from the cache if the property is
+     * cacheable and its value was cached.
+     *
+     * @param [in] handle The handle of the property.
+     * @param [in] cache @c true if the value read from the owner of a
+     *        cacheable property may be cached.
+     * @throw std::exception if @c handle does not identify a property, or
+     *        the property has no getter.
+     */
+    std::string getValue(PropertyHandle handle, bool cache);
+
+    /**
+     * Invalidates the cached value of a property, so the next read gets it
+     * from the owner of the property.
+     */
+    void invalidate(PropertyHandle handle);
+
+    /**
+     * Removes all the properties.
+     */
+    void clear();
+
+private:
+    /// The cached value of a property
+    struct CachedValue {
+        bool valid;
+        std::string value;
+    };
+
+    /// A registered property
+    struct Property {
+        PropertyDescription description;
+
+        /// Accessed with the atomic shared pointer functions only
+        std::shared_ptr<const CachedValue> cachedValue;
+    };
+
+    /// The registered properties; the property with handle @c h is at index @c h - 1
+    std::vector<std::unique_ptr<Property>> m_properties;
+
+    /// A map of property name to handle
+    std::unordered_map<std::string, PropertyHandle> m_handles;
+};
+
+}  // namespace propertyManager
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_PROPERTY_MANAGER_PROPERTY_REGISTRY_H
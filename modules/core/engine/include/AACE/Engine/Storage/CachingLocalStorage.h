@@ -0,0 +1,154 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_STORAGE_CACHING_LOCAL_STORAGE_H
+#define AACE_ENGINE_STORAGE_CACHING_LOCAL_STORAGE_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <AACE/Engine/Utils/Memory/MemoryPressure.h>
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+
+#include "LocalStorageInterface.h"
+
+namespace aace {
+namespace engine {
+namespace storage {
+
+/**
+ * A @c LocalStorageInterface that caches another storage in memory.
+ *
+ * A table is read from the storage the first time it is used, and then served from memory. Changes
+ * are applied to the cache immediately, and written to the storage in a single transaction once the
+ * flush delay has elapsed after the first unwritten change, so a burst of writes is committed at
+ * once. The changes are written when @c flush() is called, and when the cache is destructed.
+ *
+ * While a transaction started with @c begin() is in progress, changes are written through to the
+ * storage, and a cancelled transaction clears the cache.
+ *
+ * Under memory pressure the tables without unwritten changes are dropped from the cache, and read again when they
+ * are used. From the @c LOW level the changes are written right away, so their tables are dropped too.
+ */
+class CachingLocalStorage
+        : public LocalStorageInterface
+        , public aace::engine::utils::memory::MemoryPressureObserverInterface
+        , public std::enable_shared_from_this<CachingLocalStorage> {
+public:
+    /**
+     * Creates a cache in front of a storage.
+     *
+     * @param storage The storage to cache.
+     * @param flushDelay The time to wait after a change before writing the changes to the storage.
+     */
+    static std::shared_ptr<CachingLocalStorage> create(
+        std::shared_ptr<LocalStorageInterface> storage,
+        std::chrono::milliseconds flushDelay);
+
+    virtual ~CachingLocalStorage();
+
+    /**
+     * Writes the changes to the storage, and returns after they are committed.
+     *
+     * @returns @c false if the changes could not be written, in which case they are kept to be written again.
+     */
+    bool flush();
+
+public:
+    bool put(const std::string& table, const std::string& key, const std::string& value) override;
+    std::string get(const std::string& table, const std::string& key) override;
+    std::string get(const std::string& table, const std::string& key, const std::string& defaultValue) override;
+    bool removeKey(const std::string& table, const std::string& key) override;
+    bool removeTable(const std::string& table) override;
+    bool containsKey(const std::string& table, const std::string& key) override;
+    bool containsTable(const std::string& table) override;
+    std::vector<std::string> keys(const std::string& table) override;
+    std::vector<KeyValuePair> list(const std::string& table) override;
+    bool begin() override;
+    bool commit() override;
+    bool cancel() override;
+    bool putBatch(const std::string& table, const std::vector<KeyValuePair>& values) override;
+    std::vector<KeyValuePair> getBatch(const std::string& table, const std::vector<std::string>& keys) override;
+    bool forEach(const std::string& table, ForEachCallback callback) override;
+
+    /// @name MemoryPressureObserverInterface
+    /// @{
+    void onMemoryPressure(aace::engine::utils::memory::MemoryPressureLevel level) override;
+    /// @}
+
+private:
+    /// The cached contents and the unwritten changes of a table
+    struct Table {
+        bool exists = false;
+        std::unordered_map<std::string, std::string> values;
+        // the table is removed from the storage before the dirty keys are written
+        bool removed = false;
+        std::unordered_set<std::string> dirtyKeys;
+        // the changes taken from the table are being written, so the table must be kept until they are committed
+        bool flushing = false;
+    };
+
+    CachingLocalStorage(std::shared_ptr<LocalStorageInterface> storage, std::chrono::milliseconds flushDelay);
+
+    /// Returns the cached table, reading it from the storage if it isn't cached. @c m_mutex must be held.
+    Table& getTableLocked(const std::string& table);
+
+    /// Returns @c true if there are unwritten changes. @c m_mutex must be held.
+    bool hasChangesLocked() const;
+
+    /**
+     * Drops the tables without unwritten changes from the cache, unless a transaction is in progress. The tables
+     * whose changes are being written are kept. @c m_mutex must be held.
+     *
+     * @return The number of tables dropped.
+     */
+    size_t trimLocked();
+
+    /// Schedules the writing of the changes after the flush delay. @c m_mutex must be held.
+    void scheduleFlushLocked();
+
+    /// The storage that is cached.
+    std::shared_ptr<LocalStorageInterface> m_storage;
+
+    const std::chrono::milliseconds m_flushDelay;
+
+    /// Protects the cache.
+    std::mutex m_mutex;
+    std::unordered_map<std::string, Table> m_tables;
+    bool m_transactionInProgress = false;
+    bool m_shutdown = false;
+    aace::engine::utils::memory::MemoryPressureLevel m_memoryPressureLevel =
+        aace::engine::utils::memory::MemoryPressureLevel::NORMAL;
+    aace::engine::utils::threading::TimerWheel::TimerId m_flushTimer =
+        aace::engine::utils::threading::TimerWheel::INVALID_TIMER;
+
+    /// Serializes the writes to the storage.
+    std::mutex m_flushMutex;
+
+    /// The thread writing the changes. The executor must be declared last to be destructed first.
+    aace::engine::utils::threading::Executor m_executor;
+};
+
+}  // namespace storage
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_STORAGE_CACHING_LOCAL_STORAGE_H
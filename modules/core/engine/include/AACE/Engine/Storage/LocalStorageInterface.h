@@ -16,6 +16,7 @@
 #ifndef AACE_ENGINE_STORAGE_INTERFACE_LOCAL_STORAGE_INTERFACE_H
 #define AACE_ENGINE_STORAGE_INTERFACE_LOCAL_STORAGE_INTERFACE_H
 
+#include <functional>
 #include <vector>
 #include <memory>
 #include <string>
@@ -28,6 +29,9 @@ class LocalStorageInterface {
 public:
     using KeyValuePair = std::pair<std::string, std::string>;
 
+    /// Called for each key of a table by @c forEach(), returns @c false to stop the iteration
+    using ForEachCallback = std::function<bool(const std::string& key, const std::string& value)>;
+
     virtual ~LocalStorageInterface();
 
 public:
@@ -43,6 +47,35 @@ public:
     virtual bool begin() = 0;
     virtual bool commit() = 0;
     virtual bool cancel() = 0;
+
+    /**
+     * Puts the values of many keys of a table. The default implementation puts the values one at a time,
+     * an implementation may put them at once.
+     *
+     * @param table The table, which is created if it doesn't exist.
+     * @param values The keys and their values.
+     * @returns @c false if a value could not be put.
+     */
+    virtual bool putBatch(const std::string& table, const std::vector<KeyValuePair>& values);
+
+    /**
+     * Gets the values of many keys of a table.
+     *
+     * @param table The table.
+     * @param keys The keys to get.
+     * @returns The keys that exist and their values, in the order of @c keys.
+     */
+    virtual std::vector<KeyValuePair> getBatch(const std::string& table, const std::vector<std::string>& keys);
+
+    /**
+     * Calls a callback for each key of a table, without copying the table. The default implementation
+     * iterates over a copy of the table.
+     *
+     * @param table The table.
+     * @param callback The callback, which returns @c false to stop the iteration.
+     * @returns @c false if the table doesn't exist or could not be read.
+     */
+    virtual bool forEach(const std::string& table, ForEachCallback callback);
 };
 
 }  // namespace storage
@@ -16,8 +16,14 @@
 #ifndef AACE_ENGINE_STORAGE_SQLITE_STORAGE_H
 #define AACE_ENGINE_STORAGE_SQLITE_STORAGE_H
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <functional>
 
@@ -29,23 +35,105 @@ namespace aace {
 namespace engine {
 namespace storage {
 
+/**
+ * A @c LocalStorageInterface storing each table in a table of an SQLite database.
+ *
+ * The statements of each table and operation are prepared once and reused. The database is opened in
+ * write-ahead log journaling mode by default, so a write appends to the log file instead of rewriting
+ * the database pages, and the @c synchronous setting controls how often the log is synced to storage.
+ *
+ * A new database is created with incremental vacuum, so @c runMaintenance() can return its free pages
+ * to the file system a few at a time.
+ */
 class SQLiteStorage : public LocalStorageInterface {
 public:
-    static std::shared_ptr<SQLiteStorage> create(const std::string& path);
+    /// The state of the database file after a maintenance, and the work done by the maintenance
+    struct MaintenanceReport {
+        /// The size of a page in bytes
+        int64_t pageSize = 0;
+        /// The number of pages of the database file
+        int64_t pageCount = 0;
+        /// The number of unused pages of the database file
+        int64_t freePageCount = 0;
+        /// The number of free pages returned to the file system
+        int64_t vacuumedPageCount = 0;
+        /// Whether the write-ahead log was written to the database and truncated
+        bool checkpointed = false;
+        /// Whether the statistics of the query planner were updated
+        bool analyzed = false;
+        /// Whether the budget ran out before the maintenance was completed
+        bool budgetExceeded = false;
+    };
+
+    /**
+     * Opens or creates a database.
+     *
+     * @param path The path of the database file.
+     * @param journalMode The SQLite journal mode, such as "wal" or "delete".
+     * @param synchronous The SQLite synchronous setting, "off", "normal", "full" or "extra".
+     * @returns The storage, or @c nullptr if the database can't be opened or a setting is invalid.
+     */
+    static std::shared_ptr<SQLiteStorage> create(
+        const std::string& path,
+        const std::string& journalMode = "wal",
+        const std::string& synchronous = "full");
 
     virtual ~SQLiteStorage();
 
+    /**
+     * Runs an incremental vacuum of the free pages, checkpoints the write-ahead log, and updates the statistics
+     * of the query planner, until the budget runs out. Each step of the maintenance holds the storage lock, so the
+     * other operations of the storage wait for a step at most. The maintenance isn't run while a transaction is
+     * in progress.
+     *
+     * @param budget The time the maintenance can take, the running step is always completed.
+     * @param report Returns the state of the database file and the work done.
+     * @returns @c false if the maintenance failed.
+     */
+    bool runMaintenance(std::chrono::milliseconds budget, MaintenanceReport& report);
+
+    /**
+     * Returns the number of rows changed since the database was opened, which only changes when the storage
+     * is written.
+     */
+    int64_t getChangeCount();
+
 private:
+    /// The operations with a prepared statement per table
+    enum Operation { GET, PUT, CONTAINS, REMOVE, KEYS, LIST, OPERATION_COUNT };
+
+    /// Resets a prepared statement when it goes out of scope, so it can be reused.
+    class StatementReset {
+    public:
+        StatementReset(sqlite3_stmt* statement);
+        ~StatementReset();
+
+    private:
+        sqlite3_stmt* m_statement;
+    };
+
     SQLiteStorage(const std::string& path);
 
-    bool initialize();
+    bool initialize(const std::string& journalMode, const std::string& synchronous);
 
     std::string createStatement(const char* stmt, ...);
 
+    /// Returns the prepared statement of an operation on a table. @c m_mutex must be held.
+    sqlite3_stmt* getStatementLocked(const std::string& table, Operation operation);
+
+    /// Finalizes the prepared statements of a table. @c m_mutex must be held.
+    void finalizeStatementsLocked(const std::string& table);
+
     bool checkTable(const std::string& table, bool create = false);
     bool checkKey(const std::string& table, const std::string& key);
     bool query(const std::string& sql, int (*cb)(void*, int, char**, char**) = nullptr, void* data = nullptr);
 
+    /// Runs a statement returning an integer, such as a pragma.
+    bool queryInteger(const std::string& sql, int64_t& value);
+
+    /// Reads the page size, the page count, and the free page count. @c m_mutex must be held.
+    bool readFileStatsLocked(MaintenanceReport& report);
+
 public:
     bool put(const std::string& table, const std::string& key, const std::string& value) override;
     std::string get(const std::string& table, const std::string& key) override;
@@ -59,11 +147,25 @@ public:
     bool begin() override;
     bool commit() override;
     bool cancel() override;
+    bool putBatch(const std::string& table, const std::vector<KeyValuePair>& values) override;
+    std::vector<KeyValuePair> getBatch(const std::string& table, const std::vector<std::string>& keys) override;
+    bool forEach(const std::string& table, ForEachCallback callback) override;
 
 private:
     std::string m_path;
-    sqlite3* m_db;
+    sqlite3* m_db = nullptr;
     bool m_transactionInProgress = false;
+    bool m_walMode = false;
+
+    /// Serializes the use of the connection and of the prepared statements.
+    std::recursive_mutex m_mutex;
+
+    /// The prepared statements of each table, created when they are first used.
+    std::unordered_map<std::string, std::array<sqlite3_stmt*, OPERATION_COUNT>> m_statements;
+    sqlite3_stmt* m_checkTableStatement = nullptr;
+
+    /// The tables known to exist.
+    std::unordered_set<std::string> m_tables;
 };
 
 }  // namespace storage
@@ -16,8 +16,11 @@
 #ifndef AACE_ENGINE_STORAGE_STORAGE_ENGINE_SERVICE_H
 #define AACE_ENGINE_STORAGE_STORAGE_ENGINE_SERVICE_H
 
+#include "AACE/Engine/Audio/AudioManagerInterface.h"
 #include "AACE/Engine/Core/EngineService.h"
+#include "CachingLocalStorage.h"
 #include "LocalStorageInterface.h"
+#include "StorageMaintenance.h"
 
 namespace aace {
 namespace engine {
@@ -35,9 +38,20 @@ public:
 
 protected:
     bool configure(std::shared_ptr<std::istream> configuration) override;
+    bool start() override;
+    bool stop() override;
+    bool suspend() override;
+    bool resume() override;
+    bool shutdown() override;
 
 private:
+    /// Returns @c true while the engine is active, and the maintenance must be deferred.
+    bool isActive();
+
     std::shared_ptr<LocalStorageInterface> m_localStorage;
+    std::shared_ptr<CachingLocalStorage> m_cachingLocalStorage;
+    std::shared_ptr<StorageMaintenance> m_maintenance;
+    std::weak_ptr<aace::engine::audio::AudioManagerInterface> m_audioManager;
 };
 
 }  // namespace storage
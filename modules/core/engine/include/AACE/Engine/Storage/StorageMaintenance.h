@@ -0,0 +1,115 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_STORAGE_STORAGE_MAINTENANCE_H
+#define AACE_ENGINE_STORAGE_STORAGE_MAINTENANCE_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+
+#include "SQLiteStorage.h"
+
+namespace aace {
+namespace engine {
+namespace storage {
+
+/**
+ * StorageMaintenance runs the maintenance of an @c SQLiteStorage periodically, when the engine is idle.
+ *
+ * Once the interval has elapsed, the maintenance waits for the idle delay to pass without a write to the
+ * storage and without activity reported by the activity check, and then runs within its time budget. The
+ * size and the fragmentation of the database file are emitted as metrics after each maintenance.
+ */
+class StorageMaintenance : public std::enable_shared_from_this<StorageMaintenance> {
+public:
+    /// The maintenance configuration
+    struct Config {
+        /// The time between two maintenances
+        std::chrono::milliseconds interval = std::chrono::hours(1);
+        /// The time without activity before a maintenance runs
+        std::chrono::milliseconds idleDelay = std::chrono::minutes(1);
+        /// The time a maintenance can take
+        std::chrono::milliseconds budget = std::chrono::milliseconds(200);
+    };
+
+    /// Returns @c true while the engine is active, such as during a dialog or a playback
+    using ActivityCheck = std::function<bool()>;
+
+    /**
+     * Creates the maintenance of a storage, which runs once it is started.
+     *
+     * @param storage The storage to maintain.
+     * @param config The maintenance configuration.
+     * @param activityCheck Returns @c true while the maintenance must be deferred, can be empty.
+     * @returns The maintenance, or @c nullptr if the configuration is invalid.
+     */
+    static std::shared_ptr<StorageMaintenance> create(
+        std::shared_ptr<SQLiteStorage> storage,
+        const Config& config,
+        ActivityCheck activityCheck);
+
+    /// Stops the maintenance, after the running maintenance has returned.
+    ~StorageMaintenance();
+
+    /// Schedules the first maintenance after the interval.
+    void start();
+
+    /// Cancels the scheduled maintenance.
+    void stop();
+
+    /// Stops the maintenance, and waits for the running maintenance to return.
+    void shutdown();
+
+private:
+    StorageMaintenance(std::shared_ptr<SQLiteStorage> storage, const Config& config, ActivityCheck activityCheck);
+
+    /// Schedules a check of the activity after a delay. @c m_mutex must be held.
+    void scheduleLocked(std::chrono::milliseconds delay, bool intervalElapsed);
+
+    /// Runs the maintenance if the engine has been idle since the last check, or checks again after the idle delay.
+    void check(bool intervalElapsed);
+
+    /// Emits the metrics of a maintenance.
+    void emitMetrics(const SQLiteStorage::MaintenanceReport& report, std::chrono::milliseconds duration);
+
+    std::shared_ptr<SQLiteStorage> m_storage;
+    const Config m_config;
+    ActivityCheck m_activityCheck;
+
+    /// Protects the timer and the state.
+    std::mutex m_mutex;
+    bool m_started = false;
+    bool m_shutdown = false;
+    aace::engine::utils::threading::TimerWheel::TimerId m_timer =
+        aace::engine::utils::threading::TimerWheel::INVALID_TIMER;
+
+    /// The change count of the storage at the last check.
+    int64_t m_changeCount = 0;
+
+    /// The thread running the maintenance. The executor must be declared last to be destructed first.
+    aace::engine::utils::threading::Executor m_executor;
+};
+
+}  // namespace storage
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_STORAGE_STORAGE_MAINTENANCE_H
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_THREADING_THREADING_ENGINE_SERVICE_H
+#define AACE_ENGINE_THREADING_THREADING_ENGINE_SERVICE_H
+
+#include "AACE/Engine/Core/EngineService.h"
+#include "AACE/Engine/Utils/JSON/JSON.h"
+
+namespace aace {
+namespace engine {
+namespace threading {
+
+/**
+ * Configures the engine threading utilities with the "aace.threading" configuration.
+ */
+class ThreadingEngineService : public aace::engine::core::EngineService {
+public:
+    DESCRIBE("aace.threading", VERSION("1.0"))
+
+private:
+    ThreadingEngineService(const aace::engine::core::ServiceDescription& description);
+
+public:
+    virtual ~ThreadingEngineService() = default;
+
+protected:
+    bool configureFromJson(const aace::engine::utils::json::Value& configuration) override;
+    bool shutdown() override;
+
+private:
+    /// Sets the @c ThreadPolicy of an entry of the "threads" configuration.
+    bool configureThread(const aace::engine::utils::json::Value& config);
+};
+
+}  // namespace threading
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_THREADING_THREADING_ENGINE_SERVICE_H
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_JSON_ARENA_DOCUMENT_H_
+#define AACE_ENGINE_UTILS_JSON_ARENA_DOCUMENT_H_
+
+#include <cstddef>
+
+#include <rapidjson/document.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace json {
+
+/**
+ * A rapidjson document allocated from an arena of the calling thread, for the payloads that are parsed while a
+ * directive is handled and discarded with it. Each thread keeps one block of memory for its documents, and the arena
+ * is reset when the document is destroyed, so parsing a payload usually allocates nothing and leaves no fragments
+ * behind. Larger payloads grow the arena with chunks that are freed at the reset.
+ *
+ * A document created while another document of the same thread is alive uses its own allocator, like a
+ * @c rapidjson::Document. The document must be destroyed on the thread that created it, and its values must not
+ * outlive it.
+ */
+class ArenaDocument {
+public:
+    ArenaDocument();
+    ArenaDocument(const ArenaDocument&) = delete;
+    ArenaDocument& operator=(const ArenaDocument&) = delete;
+
+    /// Returns the document.
+    rapidjson::Document& get() {
+        return m_document;
+    }
+
+    /// Returns whether the document is allocated from the arena of the thread.
+    bool isArenaAllocated() const {
+        return m_lease.arena() != nullptr;
+    }
+
+    /// Returns the size of the block each thread keeps for its documents.
+    static size_t getBlockSize();
+
+private:
+    /// The arena of a thread
+    struct Arena;
+
+    /// Holds the arena of the thread while the document uses it, and resets it afterwards
+    class Lease {
+    public:
+        Lease();
+        ~Lease();
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        /// Returns the allocator of the arena, or @c nullptr if the arena is used by another document.
+        rapidjson::MemoryPoolAllocator<>* allocator() const;
+
+        Arena* arena() const {
+            return m_arena;
+        }
+
+    private:
+        Arena* m_arena;
+    };
+
+    // the lease is declared first, so the document is destroyed before the arena is reset
+    Lease m_lease;
+    rapidjson::Document m_document;
+};
+
+}  // namespace json
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_JSON_ARENA_DOCUMENT_H_
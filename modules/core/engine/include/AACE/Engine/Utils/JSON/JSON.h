@@ -31,40 +31,65 @@ namespace json {
 
 using Value = nlohmann::json;
 using Type = nlohmann::json::value_t;
+using Pointer = nlohmann::json::json_pointer;
 
 // nlohmann
 
+/**
+ * Returns the JSON pointer of a path, whose leading '/' may be omitted. The functions taking a path cache the pointers
+ * of the paths they were called with, and the functions taking a @c Pointer let a caller parse a path once, such as
+ * with a @c static @c const @c Pointer of the paths it reads for every directive.
+ */
+Pointer pointer(const std::string& path);
+
 Value toJson(const std::string& str);
 Value toJson(std::shared_ptr<std::istream> stream);
 Value toJson(std::istream& stream);
 std::string toString(const Value& root, bool prettyPrint = true);
 std::shared_ptr<std::stringstream> toStream(const Value& root, bool prettyPrint = true);
 bool merge(Value& into, const Value& from);
+/// Merges @c from into @c into, moving the values rather than copying them. @c from is left with null values.
+bool merge(Value& into, Value&& from);
 
 bool has(const Value& root, const std::string& path, Type type = Type::null);
+bool has(const Value& root, const Pointer& ptr, Type type = Type::null);
 bool isType(const Value& value, Type type);
 
 Value get(const Value& root, const std::string& path, Type type = Type::null);
+Value get(const Value& root, const Pointer& ptr, Type type = Type::null);
 bool set(Value& root, const std::string& path, Value value);
+bool set(Value& root, const Pointer& ptr, Value value);
 bool push(Value& arr, Value value);
 
 std::string get(const Value& root, const std::string& path, const std::string& defaultValue);
+std::string get(const Value& root, const Pointer& ptr, const std::string& defaultValue);
 bool set(Value& root, const std::string& path, const std::string& value);
+bool set(Value& root, const Pointer& ptr, const std::string& value);
 
 std::string get(const Value& root, const std::string& path, const char* defaultValue);
+std::string get(const Value& root, const Pointer& ptr, const char* defaultValue);
 bool set(Value& root, const std::string& path, const char* value);
+bool set(Value& root, const Pointer& ptr, const char* value);
 
 bool get(const Value& root, const std::string& path, bool defaultValue);
+bool get(const Value& root, const Pointer& ptr, bool defaultValue);
 bool set(Value& root, const std::string& path, bool value);
+bool set(Value& root, const Pointer& ptr, bool value);
 
 uint64_t get(const Value& root, const std::string& path, uint64_t defaultValue);
+uint64_t get(const Value& root, const Pointer& ptr, uint64_t defaultValue);
 bool set(Value& root, const std::string& path, uint64_t value);
+bool set(Value& root, const Pointer& ptr, uint64_t value);
 
 int64_t get(const Value& root, const std::string& path, int64_t defaultValue);
+int64_t get(const Value& root, const Pointer& ptr, int64_t defaultValue);
 bool set(Value& root, const std::string& path, int64_t value);
+bool set(Value& root, const Pointer& ptr, int64_t value);
 
 double get(const Value& root, const std::string& path, double defaultValue);
+double get(const Value& root, const Pointer& ptr, double defaultValue);
 bool set(Value& root, const std::string& path, double value);
+bool set(Value& root, const Pointer& ptr, double value);
 
 // rapidjson (deprecated)
 bool merge(
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_JSON_ON_DEMAND_READER_H_
+#define AACE_ENGINE_UTILS_JSON_ON_DEMAND_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace json {
+
+/**
+ * A forward-only cursor over a JSON text, which reads the values it is asked for without building a document.
+ *
+ * The reader enters objects and iterates their fields, decodes the strings that are read, and skips any other
+ * value by scanning for the end of its brackets, so reading a few fields of a large message costs a scan of the
+ * text and no allocation. The value of a field that is not read or entered is skipped by the next call to
+ * @c nextField(). Skipped values are only checked for balanced brackets and terminated strings, so the reader is
+ * meant for reading the known fields of a text that is parsed in full later, such as the header of a message.
+ *
+ * Once the text is found malformed, the reader fails: every call returns @c false, and @c error() describes the
+ * problem. The reader doesn't copy the text, which must outlive it.
+ */
+class OnDemandReader {
+public:
+    OnDemandReader(const char* data, size_t size);
+    explicit OnDemandReader(const char* text);
+    explicit OnDemandReader(const std::string& text);
+    explicit OnDemandReader(std::string&& text) = delete;
+
+    /// The maximum number of objects entered at once
+    static const size_t MAX_DEPTH = 64;
+
+    /**
+     * Enters the object at the cursor. The reader fails if @c MAX_DEPTH objects are already entered.
+     *
+     * @return @c false if the value at the cursor is not an object, and the value is not consumed
+     */
+    bool enterObject();
+
+    /**
+     * Moves to the next field of the innermost entered object, skipping the value of the previous field if it was
+     * not read, and reads its key.
+     *
+     * @param [out] key The key of the field
+     * @return @c false at the end of the object, which is left, or if the reader failed
+     */
+    bool nextField(std::string& key);
+
+    /**
+     * Reads the string at the cursor.
+     *
+     * @param [out] value The decoded string
+     * @return @c false if the value at the cursor is not a string, and the value is not consumed
+     */
+    bool readString(std::string& value);
+
+    /// Skips the value at the cursor.
+    bool skipValue();
+
+    /// Returns whether the text was found malformed.
+    bool failed() const {
+        return !m_error.empty();
+    }
+
+    /// Returns the reason the reader failed, or an empty string.
+    const std::string& error() const {
+        return m_error;
+    }
+
+    /// Returns the offset of the cursor in the text.
+    size_t offset() const {
+        return static_cast<size_t>(m_pos - m_begin);
+    }
+
+private:
+    // returns the next character that isn't whitespace without consuming it, or 0 at the end of the text
+    char peek();
+    bool fail(const char* reason);
+    bool skipString();
+    bool decodeString(std::string& value);
+    bool decodeEscape(std::string& value);
+    bool skipContainer();
+    bool skipLiteral();
+
+    const char* m_begin;
+    const char* m_pos;
+    const char* m_end;
+
+    // the number of entered objects, and a bit for each of them set until its first field is read
+    size_t m_depth = 0;
+    uint64_t m_first = 0;
+
+    // whether the value of the last field read by nextField() is still at the cursor
+    bool m_pendingValue = false;
+
+    std::string m_error;
+};
+
+}  // namespace json
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_JSON_ON_DEMAND_READER_H_
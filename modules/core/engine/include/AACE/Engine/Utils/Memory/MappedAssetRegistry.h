@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_MEMORY_MAPPED_ASSET_REGISTRY_H_
+#define AACE_ENGINE_UTILS_MEMORY_MAPPED_ASSET_REGISTRY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace memory {
+
+/// A read-only view of a file mapped in memory, unmapped when the last reference is released
+class MappedAsset {
+public:
+    ~MappedAsset();
+
+    MappedAsset(const MappedAsset&) = delete;
+    MappedAsset& operator=(const MappedAsset&) = delete;
+
+    /// Returns the contents of the file, or @c nullptr if the file is empty.
+    const uint8_t* data() const;
+
+    /// Returns the size of the file in bytes.
+    size_t size() const;
+
+    /// Returns the path the file was opened with.
+    const std::string& getPath() const;
+
+    /// Asks the system to read the pages of the file ahead of their use, such as before a locale change.
+    void willNeed() const;
+
+private:
+    friend class MappedAssetRegistry;
+
+    MappedAsset(const std::string& path, void* address, size_t size);
+
+    const std::string m_path;
+    void* const m_address;
+    const size_t m_size;
+};
+
+/**
+ * Maps the asset files of the Engine in memory, such as the wake word and locale models, so their readers share
+ * the pages of the system file cache instead of each reading the files into its own heap buffer.
+ *
+ * The pages of a mapped file are only read when they are accessed, they are shared by the processes mapping the
+ * same file, and the system can drop them under memory pressure since they are backed by the file. The registry
+ * keeps the assets that are in use, so the readers opening the same file in the process, such as the primary and
+ * the secondary wake word adapters or the adapters of several Engines, share one view. A file which is replaced
+ * after it was mapped is mapped again by the next @c open(), while the readers of the previous view keep it.
+ *
+ * The assets must not be modified in place while they are mapped, replace them by renaming a new file instead.
+ */
+class MappedAssetRegistry {
+public:
+    /// The assets currently in use
+    struct Stats {
+        /// The number of mapped files
+        size_t assets = 0;
+        /// The size of the mapped files in bytes
+        uint64_t mappedBytes = 0;
+    };
+
+    /**
+     * Returns the view of a file, mapping it if it is not in use.
+     *
+     * @param path The path of the file.
+     * @return The view of the file, or @c nullptr if the file could not be opened or mapped.
+     */
+    static std::shared_ptr<const MappedAsset> open(const std::string& path);
+
+    /// Returns the assets currently in use.
+    static Stats getStats();
+};
+
+}  // namespace memory
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_MEMORY_MAPPED_ASSET_REGISTRY_H_
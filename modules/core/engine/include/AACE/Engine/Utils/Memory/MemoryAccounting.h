@@ -0,0 +1,147 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_MEMORY_MEMORY_ACCOUNTING_H_
+#define AACE_ENGINE_UTILS_MEMORY_MEMORY_ACCOUNTING_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace memory {
+
+/**
+ * Accounts the heap memory of the Engine to the modules allocating it, such as the Engine services.
+ *
+ * An allocation is accounted to the current module of the allocating thread. The current module is set by a
+ * @c Scope, which the Engine enters for each service event, and by the named threads, whose module is the first
+ * component of their name, such as "Logger" for the "Logger.writer" thread. A task queued on an executor runs in
+ * the module that was current when it was queued, or else in the module of the executor, named after the first
+ * component of the executor name.
+ *
+ * The global @c operator @c new and @c operator @c delete are only replaced when the Engine is built with
+ * @c AAC_MEMORY_ACCOUNTING, since accounting each allocation costs a few atomic operations and a header before each
+ * block. In other builds @c isEnabled() returns @c false, and the scopes and the snapshots cost nearly nothing.
+ */
+class MemoryAccounting {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// The module of the allocations made outside of any module
+    static const uint32_t UNTAGGED = 0;
+
+    /// The maximum number of modules, the modules registered beyond are accounted as @c UNTAGGED
+    static const size_t MAX_MODULES = 64;
+
+    /// Point in time copy of the counters of a module
+    struct Snapshot {
+        std::string module;
+        /// The bytes allocated and not freed yet
+        int64_t liveBytes = 0;
+        /// The highest value of the live bytes
+        int64_t peakBytes = 0;
+        uint64_t allocations = 0;
+        uint64_t deallocations = 0;
+        /// The bytes allocated since the start, including the freed bytes
+        uint64_t allocatedBytes = 0;
+        /// The time of the snapshot, to compute the allocation rate between two snapshots
+        Clock::time_point time;
+    };
+
+    /// Accounts the allocations of the current thread to a module, from its construction to its destruction
+    class Scope {
+    public:
+        /// @param module The name of the module, such as the type of the service.
+        explicit Scope(const std::string& module);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const uint32_t m_previous;
+    };
+
+    /// Returns @c true if the Engine is built with @c AAC_MEMORY_ACCOUNTING.
+    static bool isEnabled();
+
+    /**
+     * Returns the id of a module, registering it the first time. Registering does not allocate memory.
+     *
+     * @param module The name of the module, truncated to 47 characters.
+     * @return The id of the module, or @c UNTAGGED if the name is empty or @c MAX_MODULES are registered.
+     */
+    static uint32_t registerModule(const std::string& module);
+
+    /// Returns the current module of the calling thread.
+    static uint32_t getCurrentModule();
+
+    /// Sets the current module of the calling thread, prefer a @c Scope.
+    static void setCurrentModule(uint32_t module);
+
+    /**
+     * Sets the module of the calling thread, which is current outside of the scopes and tasks that run on it.
+     *
+     * @param name The name of the thread, its first component is the name of the module, or an empty name to
+     *     account the thread as @c UNTAGGED.
+     */
+    static void setThreadModule(const std::string& name);
+
+    /// Returns the module of the calling thread.
+    static uint32_t getThreadModule();
+
+    /// Returns the module of the thread or executor name, the first component of the name.
+    static uint32_t registerNamedModule(const std::string& name);
+
+    /// Records an allocation of a module.
+    static void recordAllocation(uint32_t module, size_t size);
+
+    /// Records the release of an allocation of a module.
+    static void recordDeallocation(uint32_t module, size_t size);
+
+    /// Returns the counters of the registered modules, @c UNTAGGED first.
+    static std::vector<Snapshot> getSnapshots();
+
+    /**
+     * Returns the allocations per second of a module between two of its snapshots.
+     *
+     * @param previous The earlier snapshot.
+     * @param current The later snapshot.
+     */
+    static double getAllocationRate(const Snapshot& previous, const Snapshot& current);
+
+    /**
+     * Sets the interval of the memory report, which logs the counters of the modules with allocations, and emits
+     * them as metrics. An interval of @c 0, the default, disables the report. The report is only scheduled when
+     * accounting is enabled.
+     */
+    static void setReportInterval(std::chrono::seconds interval);
+    static std::chrono::seconds getReportInterval();
+
+    /// Logs the counters of the modules and emits them as metrics.
+    static void report();
+};
+
+}  // namespace memory
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_MEMORY_MEMORY_ACCOUNTING_H_
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_MEMORY_MEMORY_PRESSURE_H_
+#define AACE_ENGINE_UTILS_MEMORY_MEMORY_PRESSURE_H_
+
+#include <memory>
+#include <ostream>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace memory {
+
+/// The memory pressure levels, in increasing severity
+enum class MemoryPressureLevel {
+    /// The memory is not under pressure, the caches and buffers grow back to their configured sizes
+    NORMAL,
+    /// The system is getting low on memory, the caches are trimmed
+    MODERATE,
+    /// The system is low on memory, the caches are dropped and the buffers shrink
+    LOW,
+    /// The process is about to be killed, everything that can be released is released
+    CRITICAL
+};
+
+/// A cache or a buffer of the Engine that shrinks under memory pressure
+class MemoryPressureObserverInterface {
+public:
+    virtual ~MemoryPressureObserverInterface() = default;
+
+    /**
+     * Notifies the observer of the memory pressure level for its priority, which is @c NORMAL while the level is
+     * below the one the priority shrinks from. The observer is notified of each change, on the thread reporting
+     * the level, so it releases its memory right away and must not block.
+     *
+     * @param level The memory pressure level.
+     */
+    virtual void onMemoryPressure(MemoryPressureLevel level) = 0;
+};
+
+/**
+ * Broadcasts the memory pressure level reported by the platform, such as from the Android @c onTrimMemory(), to
+ * the caches and buffers of the Engines of the process, so they shrink before the process is killed.
+ *
+ * The observers shrink in the order of their priority: the caches, which are rebuilt on demand, from the
+ * @c MODERATE level; the buffers, which cost latency or logs, from the @c LOW level; and the essential buffers, which
+ * cost functionality, at the @c CRITICAL level only. They are notified in that order, and each observer is notified
+ * again with the @c NORMAL level once the level drops below its own, so it grows back. The observers are held
+ * weakly, so they are removed when they are released.
+ */
+class MemoryPressure {
+public:
+    /// The order the observers shrink in
+    enum class Priority {
+        /// A cache of data that is fetched or computed again on demand, shrinks from the @c MODERATE level
+        CACHE,
+        /// A buffer that smooths the work of the Engine, shrinks from the @c LOW level
+        BUFFER,
+        /// A buffer the Engine can't work well without, shrinks at the @c CRITICAL level only
+        ESSENTIAL
+    };
+
+    /**
+     * Adds an observer, which is notified right away if the current level is one its priority shrinks at.
+     *
+     * @param observer The observer.
+     * @param priority The priority of the observer.
+     */
+    static void addObserver(std::shared_ptr<MemoryPressureObserverInterface> observer, Priority priority);
+
+    /// Removes an observer.
+    static void removeObserver(std::shared_ptr<MemoryPressureObserverInterface> observer);
+
+    /**
+     * Reports the memory pressure level, and notifies the observers whose level changes, in priority order.
+     *
+     * @param level The memory pressure level.
+     */
+    static void report(MemoryPressureLevel level);
+
+    /// Returns the memory pressure level last reported.
+    static MemoryPressureLevel getLevel();
+
+    /**
+     * Returns the level an observer of a priority is notified of for a memory pressure level.
+     *
+     * @param priority The priority of the observer.
+     * @param level The memory pressure level.
+     * @return The level, or @c NORMAL if the priority doesn't shrink at the level.
+     */
+    static MemoryPressureLevel getLevelFor(Priority priority, MemoryPressureLevel level);
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const MemoryPressureLevel& level) {
+    switch (level) {
+        case MemoryPressureLevel::NORMAL:
+            stream << "NORMAL";
+            break;
+        case MemoryPressureLevel::MODERATE:
+            stream << "MODERATE";
+            break;
+        case MemoryPressureLevel::LOW:
+            stream << "LOW";
+            break;
+        case MemoryPressureLevel::CRITICAL:
+            stream << "CRITICAL";
+            break;
+    }
+    return stream;
+}
+
+}  // namespace memory
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_MEMORY_MEMORY_PRESSURE_H_
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_PCM_PCM_UTILS_H_
+#define AACE_ENGINE_UTILS_PCM_PCM_UTILS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace pcm {
+
+/// Returns @c true if the conversions are vectorized with SSE2 or NEON instructions in this build.
+bool isVectorized();
+
+/**
+ * Converts 16-bit samples to floating point samples from -1 to 1.
+ */
+void int16ToFloat(const int16_t* input, float* output, size_t count);
+
+/**
+ * Converts floating point samples from -1 to 1 to 16-bit samples, rounding to the nearest value and
+ * clamping the samples out of range.
+ */
+void floatToInt16(const float* input, int16_t* output, size_t count);
+
+/**
+ * Multiplies 16-bit samples by a gain in place, clamping the samples out of range.
+ */
+void applyGain(int16_t* samples, size_t count, float gain);
+
+/**
+ * Multiplies floating point samples by a gain in place.
+ */
+void applyGain(float* samples, size_t count, float gain);
+
+/**
+ * Mixes interleaved frames of 16-bit samples down to one channel by averaging the channels of each frame.
+ * The output can be the input.
+ *
+ * @param input The interleaved samples, @c frames * @c channels samples.
+ * @param output The mono samples, @c frames samples.
+ * @param frames The number of frames.
+ * @param channels The number of channels of a frame.
+ */
+void downmixToMono(const int16_t* input, int16_t* output, size_t frames, size_t channels);
+
+/**
+ * Filters interleaved frames of 16-bit samples in place with a first-order high-pass filter per channel,
+ * y[n] = coefficient * (y[n-1] + x[n] - x[n-1]), clamping the samples out of range. The channels of a frame are
+ * filtered 4 at a time, since each sample depends on the previous sample of its channel.
+ *
+ * @param samples The interleaved samples, @c frames * @c channels samples.
+ * @param frames The number of frames.
+ * @param channels The number of channels of a frame.
+ * @param coefficient The coefficient of the filter, from @c highPassCoefficient().
+ * @param state The last input of each channel followed by the last output of each channel, @c 2 * @c channels
+ * values kept between the calls, and set to 0 to start a new stream.
+ */
+void highPassFilter(int16_t* samples, size_t frames, size_t channels, float coefficient, float* state);
+
+/// Returns the coefficient of @c highPassFilter() for a cutoff frequency in Hz.
+float highPassCoefficient(float cutoff, uint32_t sampleRate);
+
+/// The level returned by @c levelDbfs() for silence.
+static const float SILENCE_DBFS = -100.0f;
+
+/**
+ * Returns the RMS level of 16-bit samples in decibels relative to full scale, from @c SILENCE_DBFS to 0.
+ */
+float levelDbfs(const int16_t* samples, size_t count);
+
+/**
+ * Converts the sample rate of a stream of mono 16-bit samples.
+ *
+ * A rate that is a multiple of the output rate, such as 48 kHz to 16 kHz, is decimated by averaging
+ * the samples of each output period. Other rates are linearly interpolated. The position in the
+ * stream is kept between the calls to @c process().
+ */
+class Resampler {
+public:
+    Resampler(uint32_t inputRate, uint32_t outputRate);
+
+    /**
+     * Converts the next samples of the stream, and appends the converted samples to @c output.
+     *
+     * @returns The number of samples appended.
+     */
+    size_t process(const int16_t* input, size_t count, std::vector<int16_t>& output);
+
+    /// Starts a new stream.
+    void reset();
+
+    uint32_t getInputRate() const;
+    uint32_t getOutputRate() const;
+
+private:
+    const uint32_t m_inputRate;
+    const uint32_t m_outputRate;
+    // the number of input samples averaged per output sample, or 0 to interpolate
+    const uint32_t m_decimation;
+    const double m_step;
+
+    // the accumulated samples of the output period in progress, when decimating
+    int32_t m_sum = 0;
+    uint32_t m_summed = 0;
+
+    // the position of the next output sample relative to the next input sample, when interpolating
+    double m_position = 0;
+    int16_t m_last = 0;
+};
+
+/**
+ * Converts the sample rate of a stream of mono 16-bit samples with a polyphase windowed-sinc filter, which
+ * attenuates the frequencies above the Nyquist frequency of the lower rate rather than folding them back into the
+ * output like @c Resampler. The ratio of the rates is reduced to L/M, and each output sample is the dot product of
+ * the last input samples with one of the L phases of the filter, with SSE2 or NEON instructions when they are
+ * supported. The output is delayed by half the taps of a phase.
+ */
+class PolyphaseResampler {
+public:
+    /// The zero crossings of the filter on each side of its center, at the lower rate, by default
+    static constexpr uint32_t DEFAULT_ZERO_CROSSINGS = 16;
+
+    /// The largest number of phases, L, of the reduced ratio of the rates
+    static constexpr uint32_t MAX_PHASES = 1024;
+
+    /**
+     * Creates a resampler.
+     *
+     * @param zeroCrossings The zero crossings of the filter on each side of its center, at the lower rate. The
+     * transition band of the filter narrows as they increase, and so does the cost of each output sample.
+     * @return The resampler, or @c nullptr if an argument is 0 or the reduced ratio has more than @c MAX_PHASES
+     * phases.
+     */
+    static std::unique_ptr<PolyphaseResampler> create(
+        uint32_t inputRate,
+        uint32_t outputRate,
+        uint32_t zeroCrossings = DEFAULT_ZERO_CROSSINGS);
+
+    /**
+     * Converts the next samples of the stream, and appends the converted samples to @c output.
+     *
+     * @returns The number of samples appended.
+     */
+    size_t process(const int16_t* input, size_t count, std::vector<int16_t>& output);
+
+    /// Starts a new stream.
+    void reset();
+
+    uint32_t getInputRate() const;
+    uint32_t getOutputRate() const;
+
+    /// Returns the taps of each phase of the filter, a multiple of 8.
+    size_t getTaps() const;
+
+private:
+    PolyphaseResampler(uint32_t inputRate, uint32_t outputRate, uint32_t up, uint32_t down, size_t taps);
+
+    const uint32_t m_inputRate;
+    const uint32_t m_outputRate;
+    const uint32_t m_up;
+    const uint32_t m_down;
+    const size_t m_taps;
+
+    // the phases of the filter, in Q14, each in the order of the input samples it multiplies
+    std::vector<int16_t> m_coefficients;
+
+    // the last taps - 1 input samples, followed by the samples of the call in progress
+    std::vector<int16_t> m_history;
+
+    // the position of the next output sample in the upsampled stream, from the first input sample of the next call
+    uint64_t m_position = 0;
+};
+
+}  // namespace pcm
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_PCM_PCM_UTILS_H_
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_THREADING_ASYNC_FLOW_H_
+#define AACE_ENGINE_UTILS_THREADING_ASYNC_FLOW_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "ThreadPool.h"
+#include "TimerWheel.h"
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+/**
+ * An AsyncFlow runs a long multi-step flow, such as an authorization or a sync, on a @c ThreadPool without holding
+ * a thread while the flow waits.
+ *
+ * The flow is a step function that is called again and again, one call at a time, and returns how the flow goes on:
+ * right away, at a point in time, when it is woken up, or not at all. Between two steps the flow is suspended and
+ * holds no thread: a deadline is a @c TimerWheel timer, and an asynchronous operation, such as an HTTP request, wakes
+ * the flow up with @c wake() when it completes. The state of the flow is kept by the owner of the step, like the
+ * state of a hand-written state machine, and a step must not block for long since it holds a worker of the pool.
+ *
+ * @c wake() is the condition variable of the flow: it runs the next step early if the flow is suspended, and if a
+ * step is running, the step that follows runs right away whatever the running step returns. So a step can check its
+ * condition and suspend without missing a wake up, and it must check its condition again after a wake up, which may
+ * be for another reason.
+ */
+class AsyncFlow : public std::enable_shared_from_this<AsyncFlow> {
+public:
+    using Clock = TimerWheel::Clock;
+
+    /// How the flow goes on after a step
+    class Next {
+    public:
+        /// Runs the next step right away.
+        static Next now();
+
+        /// Runs the next step at a point in time, or when the flow is woken up before.
+        static Next at(Clock::time_point deadline);
+
+        /// Runs the next step after a delay, or when the flow is woken up before.
+        static Next after(Clock::duration delay);
+
+        /// Runs the next step when the flow is woken up.
+        static Next suspend();
+
+        /// Ends the flow.
+        static Next done();
+
+    private:
+        enum class Type { NOW, AT, SUSPEND, DONE };
+
+        Next(Type type, Clock::time_point deadline = Clock::time_point());
+
+        Type m_type;
+        Clock::time_point m_deadline;
+
+        friend class AsyncFlow;
+    };
+
+    /// A step of the flow. A step that throws ends the flow.
+    using Step = std::function<Next()>;
+
+    /**
+     * Creates a flow, which starts with @c start().
+     *
+     * @param name The name of the flow in the logs.
+     * @param step The step function of the flow.
+     * @param threadPool The thread pool to run the steps on.
+     * @param timerWheel The timer wheel for the deadlines of the steps.
+     *
+     * The running step or timer holds the flow, so a pool or a wheel other than the default one is shutdown
+     * before its last reference is released, or the flow could be the one to release it on its own thread.
+     */
+    static std::shared_ptr<AsyncFlow> create(
+        const std::string& name,
+        Step step,
+        std::shared_ptr<ThreadPool> threadPool = ThreadPool::getDefault(),
+        std::shared_ptr<TimerWheel> timerWheel = TimerWheel::getDefault());
+
+    /**
+     * Destructs the flow, which is cancelled. A running step keeps the flow alive until it returns, so the owner
+     * of the flow must keep it until it is done or cancelled.
+     */
+    ~AsyncFlow();
+
+    /**
+     * Runs the first step.
+     *
+     * @return @c false if the flow was already started or cancelled, or the thread pool is shutdown.
+     */
+    bool start();
+
+    /**
+     * Wakes up the flow: the next step runs now if the flow is suspended, or right after the running step.
+     */
+    void wake();
+
+    /**
+     * Ends the flow: no step runs after the call, and the call waits for the running step to return, unless it is
+     * made from the step.
+     */
+    void cancel();
+
+    /**
+     * Waits for the flow to end, which a step doesn't wait for.
+     *
+     * @param timeout The time to wait.
+     * @return @c true if the flow ended.
+     */
+    bool waitForCompletion(std::chrono::milliseconds timeout);
+
+    /// Returns whether the flow ended.
+    bool isDone();
+
+    /// Returns whether the caller is the running step of the flow.
+    bool isRunningStep();
+
+private:
+    enum class State {
+        /// The flow is not started
+        IDLE,
+        /// The next step is posted to the pool
+        SCHEDULED,
+        /// A step is running
+        RUNNING,
+        /// The flow is suspended, until its timer expires or it is woken up
+        SUSPENDED,
+        /// The flow ended
+        DONE
+    };
+
+    AsyncFlow(
+        const std::string& name,
+        Step step,
+        std::shared_ptr<ThreadPool> threadPool,
+        std::shared_ptr<TimerWheel> timerWheel);
+
+    /// Posts the next step to the pool. @c m_mutex must be held.
+    void scheduleLocked();
+
+    /// Ends the flow. @c m_mutex must be held.
+    void finishLocked();
+
+    /// Runs a step, and suspends or schedules the flow for the next one.
+    void run();
+
+    /// Runs the next step for the timer of a suspension, unless the flow was resumed since.
+    void resume(uint64_t suspension);
+
+    const std::string m_name;
+    Step m_step;
+    std::shared_ptr<ThreadPool> m_threadPool;
+    std::shared_ptr<TimerWheel> m_timerWheel;
+
+    State m_state = State::IDLE;
+
+    /// Whether the flow was woken up while a step was running
+    bool m_wakePending = false;
+
+    /// The timer of the suspension, and the number of the suspension, which tells a stale timer apart
+    TimerWheel::TimerId m_timer = TimerWheel::INVALID_TIMER;
+    uint64_t m_suspension = 0;
+
+    /// The thread of the running step
+    std::thread::id m_runningThread;
+
+    /// Protects the state, and tells the waiters a step returned or the flow ended
+    std::mutex m_mutex;
+    std::condition_variable m_stateChanged;
+};
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_THREADING_ASYNC_FLOW_H_
@@ -17,6 +17,7 @@
 #define AACE_ENGINE_UTILS_THREADING_EXECUTOR_H_
 
 #include <future>
+#include <string>
 #include <utility>
 
 #include "TaskThread.h"
@@ -37,6 +38,14 @@ public:
      */
     Executor();
 
+    /**
+     * Constructs a named Executor, which records @c ExecutorStats, and whose thread gets the
+     * @c ThreadPolicy of the name.
+     *
+     * @param name The name of the executor.
+     */
+    explicit Executor(const std::string& name);
+
     /**
      * Destructs an Executor.
      */
@@ -65,6 +74,26 @@ public:
     template <typename Task, typename... Args>
     auto submitToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))>;
 
+    /**
+     * Submits a callable type (function, lambda expression, bind expression, or another function object) to be executed
+     * on an Executor thread, without a future for its result. The callable is not copied, and small callables are
+     * queued without allocating memory, so prefer this to @c submit() when the result isn't needed.
+     *
+     * @param task A callable type representing a task.
+     * @returns @c false if the executor is shutdown, in which case the task is dropped.
+     */
+    template <typename Task>
+    bool post(Task&& task);
+
+    /**
+     * Submits a callable type to the front of the internal queue, without a future for its result.
+     *
+     * @param task A callable type representing a task.
+     * @returns @c false if the executor is shutdown, in which case the task is dropped.
+     */
+    template <typename Task>
+    bool postToFront(Task&& task);
+
     /**
      * Wait for any previously submitted tasks to complete.
      */
@@ -76,6 +105,12 @@ public:
     /// Returns whether or not the executor is shutdown.
     bool isShutdown();
 
+    /// Returns the number of submitted tasks waiting to be executed.
+    size_t queueSize();
+
+    /// Returns the statistics of the executor, or @c nullptr if it isn't named.
+    std::shared_ptr<ExecutorStats> getStats();
+
 private:
     /// The queue of tasks to execute.
     std::shared_ptr<TaskQueue> m_taskQueue;
@@ -94,6 +129,16 @@ auto Executor::submitToFront(Task task, Args&&... args) -> std::future<decltype(
     return m_taskQueue->pushToFront(task, std::forward<Args>(args)...);
 }
 
+template <typename Task>
+bool Executor::post(Task&& task) {
+    return m_taskQueue->post(std::forward<Task>(task));
+}
+
+template <typename Task>
+bool Executor::postToFront(Task&& task) {
+    return m_taskQueue->postToFront(std::forward<Task>(task));
+}
+
 }  // namespace threading
 }  // namespace utils
 }  // namespace engine
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_THREADING_EXECUTOR_STATS_H_
+#define AACE_ENGINE_UTILS_THREADING_EXECUTOR_STATS_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+/**
+ * Statistics of a named executor.
+ *
+ * A named @c Executor or @c SerialExecutor records the depth of its queue, the time each task waits
+ * in the queue, and the time each task runs. The statistics of all the named executors can be read
+ * with @c getSnapshots().
+ *
+ * When a slow task threshold is set, a watchdog checks the running tasks of the named executors,
+ * and logs a warning for each task running longer than the threshold, with the call site that
+ * submitted it.
+ */
+class ExecutorStats {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Upper bounds of the histogram buckets, the last bucket counts all larger values
+    static constexpr std::array<uint32_t, 12> HISTOGRAM_BUCKET_BOUNDS_US = {
+        {50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 1000000}};
+
+    /// Duration histogram in microseconds
+    struct Histogram {
+        std::array<uint64_t, HISTOGRAM_BUCKET_BOUNDS_US.size() + 1> buckets{};
+        uint64_t count = 0;
+        uint64_t totalUs = 0;
+        uint64_t maxUs = 0;
+
+        void add(Clock::duration duration);
+    };
+
+    /// Point in time copy of the statistics of an executor
+    struct Snapshot {
+        std::string name;
+        size_t queueDepth = 0;
+        size_t maxQueueDepth = 0;
+        uint64_t completedTasks = 0;
+        Histogram waitTime;
+        Histogram runTime;
+        // the task running when the snapshot was taken
+        bool running = false;
+        Clock::duration runningFor = Clock::duration::zero();
+        std::string runningCallSite;
+    };
+
+    /**
+     * Creates the statistics of an executor.
+     *
+     * @param name The name of the executor, reported in the snapshots and the slow task warnings.
+     */
+    static std::shared_ptr<ExecutorStats> create(const std::string& name);
+
+    ~ExecutorStats();
+
+    /// Returns the name of the executor.
+    const std::string& getName() const;
+
+    /// Returns a copy of the statistics.
+    Snapshot getSnapshot() const;
+
+    /// Clears the histograms, the completed task count and the maximum queue depth.
+    void reset();
+
+    /// Returns the statistics of all the named executors.
+    static std::vector<Snapshot> getSnapshots();
+
+    /**
+     * Sets the run time after which a task is reported as slow. A duration of @c 0, the default,
+     * disables the watchdog.
+     */
+    static void setSlowTaskThreshold(std::chrono::milliseconds threshold);
+    static std::chrono::milliseconds getSlowTaskThreshold();
+
+    /// Returns a printable description of a call site, with its module and symbol if they are known.
+    static std::string describeCallSite(const void* callSite);
+
+    /**
+     * Records a queued task.
+     *
+     * @param queueDepth The number of queued tasks, including the new task.
+     */
+    void taskQueued(size_t queueDepth);
+
+    /**
+     * Records a task taken from the queue to run.
+     *
+     * @param queued The time the task was queued.
+     * @param callSite The code address that submitted the task.
+     * @param queueDepth The number of tasks left in the queue.
+     */
+    void taskStarted(Clock::time_point queued, const void* callSite, size_t queueDepth);
+
+    /// Records the completion of the running task.
+    void taskCompleted();
+
+private:
+    ExecutorStats(const std::string& name);
+
+    /// Logs the tasks running longer than the slow task threshold.
+    static void checkSlowTasks();
+
+    const std::string m_name;
+
+    mutable std::mutex m_mutex;
+    size_t m_queueDepth = 0;
+    size_t m_maxQueueDepth = 0;
+    uint64_t m_completedTasks = 0;
+    Histogram m_waitTime;
+    Histogram m_runTime;
+
+    /// The running task.
+    bool m_running = false;
+    Clock::time_point m_runStart;
+    const void* m_runCallSite = nullptr;
+    bool m_slowTaskReported = false;
+};
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_THREADING_EXECUTOR_STATS_H_
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_THREADING_SERIAL_EXECUTOR_H_
+#define AACE_ENGINE_UTILS_THREADING_SERIAL_EXECUTOR_H_
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "TaskQueue.h"
+#include "ThreadPool.h"
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+/**
+ * A SerialExecutor runs callable types asynchronously on a @c ThreadPool, one at a time and in the
+ * order they are submitted, like an @c Executor. It doesn't own a thread, so many components can
+ * share the threads of the pool.
+ *
+ * The tasks of a SerialExecutor should not block for long, since they hold a worker of the pool.
+ */
+class SerialExecutor {
+public:
+    /**
+     * Constructs a SerialExecutor.
+     *
+     * @param threadPool The thread pool to run the tasks on.
+     */
+    SerialExecutor(std::shared_ptr<ThreadPool> threadPool = ThreadPool::getDefault());
+
+    /**
+     * Constructs a named SerialExecutor, which records @c ExecutorStats.
+     *
+     * @param name The name of the executor.
+     * @param threadPool The thread pool to run the tasks on.
+     */
+    SerialExecutor(const std::string& name, std::shared_ptr<ThreadPool> threadPool = ThreadPool::getDefault());
+
+    /**
+     * Destructs a SerialExecutor, after the running task has finished.
+     */
+    ~SerialExecutor();
+
+    /**
+     * Submits a callable type (function, lambda expression, bind expression, or another function object) to be executed
+     * after the previously submitted tasks. The future must be checked for validity before waiting on it.
+     *
+     * @param task A callable type representing a task.
+     * @param args The arguments to call the task with.
+     * @returns A @c std::future for the return value of the task.
+     */
+    template <typename Task, typename... Args>
+    auto submit(Task task, Args&&... args) -> std::future<decltype(task(args...))>;
+
+    /**
+     * Submits a callable type (function, lambda expression, bind expression, or another function object) to be executed
+     * before the previously submitted tasks that have not started. The future must be checked for validity before
+     * waiting on it.
+     *
+     * @param task A callable type representing a task.
+     * @param args The arguments to call the task with.
+     * @returns A @c std::future for the return value of the task.
+     */
+    template <typename Task, typename... Args>
+    auto submitToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))>;
+
+    /**
+     * Submits a callable type (function, lambda expression, bind expression, or another function object) to be executed
+     * after the previously submitted tasks, without a future for its result. The callable is not copied, and small callables are
+     * queued without allocating memory, so prefer this to @c submit() when the result isn't needed.
+     *
+     * @param task A callable type representing a task.
+     * @returns @c false if the executor is shutdown, in which case the task is dropped.
+     */
+    template <typename Task>
+    bool post(Task&& task);
+
+    /**
+     * Submits a callable type to the front of the internal queue, without a future for its result.
+     *
+     * @param task A callable type representing a task.
+     * @returns @c false if the executor is shutdown, in which case the task is dropped.
+     */
+    template <typename Task>
+    bool postToFront(Task&& task);
+
+    /**
+     * Wait for any previously submitted tasks to complete.
+     */
+    void waitForSubmittedTasks();
+
+    /// Clears the executor of outstanding tasks and refuses any additional tasks to be submitted.
+    void shutdown();
+
+    /// Returns whether or not the executor is shutdown.
+    bool isShutdown();
+
+    /// Returns the number of submitted tasks waiting to be executed.
+    size_t queueSize();
+
+    /// Returns the statistics of the executor, or @c nullptr if it isn't named.
+    std::shared_ptr<ExecutorStats> getStats();
+
+private:
+    /// State shared with the pool tasks that run the submitted tasks.
+    struct State {
+        std::shared_ptr<ThreadPool> threadPool;
+        std::shared_ptr<TaskQueue> taskQueue;
+        /// Whether a pool task is queued or running to run the submitted tasks.
+        std::atomic<bool> scheduled{false};
+        /// Held while the submitted tasks run.
+        std::mutex runMutex;
+        std::atomic<std::thread::id> runningThread;
+    };
+
+    /// Queues a pool task to run the submitted tasks, unless one is already queued or running.
+    static void schedule(const std::shared_ptr<State>& state);
+
+    /// Runs submitted tasks on a pool worker.
+    static void run(std::weak_ptr<State> weakState);
+
+    std::shared_ptr<State> m_state;
+};
+
+template <typename Task, typename... Args>
+auto SerialExecutor::submit(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
+    auto future = m_state->taskQueue->push(task, std::forward<Args>(args)...);
+    schedule(m_state);
+    return future;
+}
+
+template <typename Task, typename... Args>
+auto SerialExecutor::submitToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
+    auto future = m_state->taskQueue->pushToFront(task, std::forward<Args>(args)...);
+    schedule(m_state);
+    return future;
+}
+
+template <typename Task>
+bool SerialExecutor::post(Task&& task) {
+    if (!m_state->taskQueue->post(std::forward<Task>(task))) {
+        return false;
+    }
+    schedule(m_state);
+    return true;
+}
+
+template <typename Task>
+bool SerialExecutor::postToFront(Task&& task) {
+    if (!m_state->taskQueue->postToFront(std::forward<Task>(task))) {
+        return false;
+    }
+    schedule(m_state);
+    return true;
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_THREADING_SERIAL_EXECUTOR_H_
@@ -17,14 +17,17 @@
 #define AACE_ENGINE_UTILS_THREADING_TASK_QUEUE_H_
 
 #include <atomic>
+#include <cstdint>
 #include <condition_variable>
-#include <deque>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <utility>
 
+#include "ExecutorStats.h"
+#include "UniqueTask.h"
+
 namespace aace {
 namespace engine {
 namespace utils {
@@ -32,13 +35,49 @@ namespace threading {
 
 /**
  * A TaskQueue contains a queue of tasks to run
+ *
+ * The queued tasks are held in nodes taken from a pool owned by the queue, and the nodes are
+ * returned to the pool when the tasks are popped, so a task posted with @c post() doesn't
+ * allocate memory once the pool has grown to the usual depth of the queue.
+ *
+ * A TaskQueue created with @c ExecutorStats records the queued tasks, and the tasks taken to run,
+ * which must be followed by a call to @c taskCompleted() when the task returns.
+ *
+ * A task runs in the @c MemoryAccounting module that was current when it was queued, or else in the module of
+ * the queue, named after its statistics, until @c taskCompleted() restores the module of the thread.
  */
 class TaskQueue {
 public:
     /**
      * Constructs an empty TaskQueue.
+     *
+     * @param stats The statistics to record the tasks in, or @c nullptr to not record them.
+     */
+    TaskQueue(std::shared_ptr<ExecutorStats> stats = nullptr);
+
+    /**
+     * Destructs a TaskQueue, and the tasks it contains.
+     */
+    ~TaskQueue();
+
+    /**
+     * Pushes a task on the back of the queue without a future to access its result. The task is not copied, and
+     * small tasks are queued without allocating memory.
+     *
+     * @param task A task to push to the back of the queue.
+     * @returns @c false if the queue is shutdown, in which case the task is dropped.
      */
-    TaskQueue();
+    template <typename Task>
+    bool post(Task&& task);
+
+    /**
+     * Pushes a task on the front of the queue without a future to access its result.
+     *
+     * @param task A task to push to the front of the queue.
+     * @returns @c false if the queue is shutdown, in which case the task is dropped.
+     */
+    template <typename Task>
+    bool postToFront(Task&& task);
 
     /**
      * Pushes a task on the back of the queue. If the queue is shutdown, the task will be dropped, and an invalid
@@ -68,9 +107,24 @@ public:
      * Returns and removes the task at the front of the queue. If there are no tasks, this call will block until there
      * is one. A @c nullptr will be returned if there are no more tasks expected.
      *
-     * @returns A task which the caller assumes ownership of, or @c nullptr if the TaskQueue expects no more tasks.
+     * @returns A task which the caller assumes ownership of, or an empty task if the TaskQueue expects no more tasks.
+     */
+    UniqueTask pop();
+
+    /**
+     * Returns and removes the task at the front of the queue without blocking.
+     *
+     * @returns A task which the caller assumes ownership of, or an empty task if the queue is empty.
+     */
+    UniqueTask tryPop();
+
+    /**
+     * Records the completion of the last task returned by @c pop() or @c tryPop(), if the queue has statistics.
      */
-    std::unique_ptr<std::function<void()>> pop();
+    void taskCompleted();
+
+    /// Returns the statistics of the queue, or @c nullptr if it doesn't record them.
+    std::shared_ptr<ExecutorStats> getStats() const;
 
     /**
      * Clears the queue of outstanding tasks and refuses any additional tasks to be pushed onto the queue.
@@ -86,9 +140,24 @@ public:
      */
     bool isShutdown();
 
+    /**
+     * Returns the number of tasks waiting in the queue.
+     *
+     * @returns The number of queued tasks.
+     */
+    size_t size();
+
 private:
-    /// The queue type to use for holding tasks.
-    using Queue = std::deque<std::unique_ptr<std::function<void()>>>;
+    /// A queued task, linked to the next task in the queue or the next free node.
+    struct Node {
+        UniqueTask task;
+        Node* next = nullptr;
+        // only set if the queue has statistics
+        ExecutorStats::Clock::time_point queued;
+        const void* callSite = nullptr;
+        // the memory accounting module to run the task in
+        uint32_t module = 0;
+    };
 
     /**
      * Pushes a task on the the queue. If the queue is shutdown, the task will be dropped, and an invalid
@@ -103,19 +172,64 @@ private:
     template <typename Task, typename... Args>
     auto pushTo(bool front, Task task, Args&&... args) -> std::future<decltype(task(args...))>;
 
-    /// The queue of tasks
-    Queue m_queue;
+    /**
+     * Adds a task to the queue, unless it is shutdown.
+     *
+     * @param front If @c true, push to the front of the queue, else push to the back.
+     * @param task The task to queue.
+     * @returns Whether the task was queued.
+     */
+    bool enqueue(bool front, UniqueTask&& task);
+
+    /**
+     * Removes the task at the front of the queue, which must not be empty. @c m_queueMutex must be held.
+     *
+     * @param run Whether the task is taken to run, rather than dropped.
+     */
+    UniqueTask dequeueLocked(bool run);
+
+    /// Returns a node to the pool, or frees it if the pool is full. @c m_queueMutex must be held.
+    void releaseNodeLocked(Node* node);
+
+    /// The first and last queued tasks
+    Node* m_head;
+    Node* m_tail;
+
+    /// The number of queued tasks
+    size_t m_size;
+
+    /// The statistics of the queue, or @c nullptr
+    const std::shared_ptr<ExecutorStats> m_stats;
+
+    /// The memory accounting module of the tasks queued outside of any module
+    const uint32_t m_module;
+
+    /// The pool of free nodes
+    Node* m_freeNodes;
+    size_t m_freeNodeCount;
 
     /// A condition variable to wait for new tasks to be placed on the queue.
     std::condition_variable m_queueChanged;
 
-    /// A mutex to protect access to the tasks in m_queue.
+    /// A mutex to protect access to the queued tasks and the free nodes.
     std::mutex m_queueMutex;
 
     /// A flag for whether or not the queue is expecting more tasks.
     std::atomic_bool m_shutdown;
 };
 
+template <typename Task>
+bool TaskQueue::post(Task&& task) {
+    bool front = true;
+    return enqueue(!front, UniqueTask(std::forward<Task>(task)));
+}
+
+template <typename Task>
+bool TaskQueue::postToFront(Task&& task) {
+    bool front = true;
+    return enqueue(front, UniqueTask(std::forward<Task>(task)));
+}
+
 template <typename Task, typename... Args>
 auto TaskQueue::push(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
     bool front = true;
@@ -200,17 +314,11 @@ auto TaskQueue::pushTo(bool front, Task task, Args&&... args) -> std::future<dec
     // Release our local reference to packaged task so that the only remaining reference is inside the lambda.
     packaged_task.reset();
 
-    {
-        std::lock_guard<std::mutex> queueLock{m_queueMutex};
-        if (!m_shutdown) {
-            m_queue.emplace(front ? m_queue.begin() : m_queue.end(), new std::function<void()>(translated_task));
-        } else {
-            using FutureType = decltype(task(args...));
-            return std::future<FutureType>();
-        }
+    if (!enqueue(front, UniqueTask(std::move(translated_task)))) {
+        using FutureType = decltype(task(args...));
+        return std::future<FutureType>();
     }
 
-    m_queueChanged.notify_all();
     return cleanupFuture;
 }
 
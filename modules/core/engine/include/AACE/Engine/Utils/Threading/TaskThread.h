@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
 #include <thread>
 
 #include "TaskQueue.h"
@@ -36,8 +37,9 @@ public:
      * Constructs a TaskThread to read from the given TaskQueue. This does not start the thread.
      *
      * @params taskQueue A TaskQueue to take tasks from to execute.
+     * @params name The name the thread is registered with in @c ThreadPolicy, or empty if the thread isn't named.
      */
-    TaskThread(std::shared_ptr<TaskQueue> taskQueue);
+    TaskThread(std::shared_ptr<TaskQueue> taskQueue, const std::string& name = "");
 
     /**
      * Destructs the TaskThread.
@@ -65,6 +67,9 @@ private:
     /// A weak pointer to the TaskQueue, if the task queue is no longer accessible, there is no reason to execute tasks.
     std::weak_ptr<TaskQueue> m_taskQueue;
 
+    /// The name of the thread.
+    const std::string m_name;
+
     /// A flag to message the task thread to stop executing.
     std::atomic_bool m_shutdown;
 
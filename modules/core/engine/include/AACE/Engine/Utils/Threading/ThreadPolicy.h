@@ -0,0 +1,124 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_THREADING_THREAD_POLICY_H_
+#define AACE_ENGINE_UTILS_THREADING_THREAD_POLICY_H_
+
+#include <string>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+/**
+ * ThreadPolicy assigns the CPU affinity and the scheduling of the named engine threads.
+ *
+ * A named thread registers itself while it runs, and gets the policy whose pattern matches its
+ * name. A pattern is either a thread name, or a prefix followed by @c '*', and the exact name is
+ * preferred to the longest matching prefix. A policy set while a matching thread is running is
+ * applied to the thread immediately.
+ *
+ * Policies are only applied on Linux, including Android. The real-time scheduling classes
+ * usually need the @c CAP_SYS_NICE capability, a policy that can't be applied is logged.
+ */
+class ThreadPolicy {
+public:
+    /// The scheduling class of a thread
+    enum class Scheduling {
+        // the scheduling class is not changed
+        DEFAULT,
+        // SCHED_OTHER, the time sharing class
+        OTHER,
+        // SCHED_FIFO, the first in first out real-time class
+        FIFO,
+        // SCHED_RR, the round robin real-time class
+        RR
+    };
+
+    struct Policy {
+        /// The CPUs the thread may run on, or empty to leave the affinity unchanged
+        std::vector<int> cpus;
+
+        /// The scheduling class, and the priority of the real-time classes, from 1 to 99
+        Scheduling scheduling = Scheduling::DEFAULT;
+        int priority = 0;
+
+        /// The nice value of the time sharing class, from -20 to 19, if @c hasNice is set
+        bool hasNice = false;
+        int nice = 0;
+    };
+
+    /**
+     * Registers a named thread for its lifetime, and accounts its memory to the @c MemoryAccounting module named
+     * after the first component of its name.
+     */
+    class ScopedThread {
+    public:
+        explicit ScopedThread(const std::string& name);
+        ~ScopedThread();
+
+        ScopedThread(const ScopedThread&) = delete;
+        ScopedThread& operator=(const ScopedThread&) = delete;
+    };
+
+    /**
+     * Sets the policy of the threads matching a pattern, replacing the policy previously set for the
+     * pattern, and applies it to the matching registered threads.
+     *
+     * @param pattern A thread name, or a thread name prefix followed by @c '*'.
+     * @param policy The policy of the matching threads.
+     */
+    static void setPolicy(const std::string& pattern, const Policy& policy);
+
+    /**
+     * Removes the policies. The threads running with a policy keep it until they exit.
+     */
+    static void clearPolicies();
+
+    /**
+     * Registers the calling thread, and applies its policy.
+     *
+     * @param name The name of the thread.
+     */
+    static void registerCurrentThread(const std::string& name);
+
+    /**
+     * Unregisters the calling thread.
+     */
+    static void unregisterCurrentThread();
+
+    /**
+     * Parses the name of a scheduling class, "default", "other", "fifo" or "rr", ignoring case.
+     *
+     * @param name The name of the scheduling class.
+     * @param scheduling The parsed scheduling class.
+     * @returns @c false if the name is unknown.
+     */
+    static bool parseScheduling(const std::string& name, Scheduling& scheduling);
+
+    /**
+     * Returns @c true if a thread name matches a pattern.
+     */
+    static bool matches(const std::string& pattern, const std::string& name);
+};
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_THREADING_THREAD_POLICY_H_
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_THREADING_THREAD_POOL_H_
+#define AACE_ENGINE_UTILS_THREADING_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "UniqueTask.h"
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+/**
+ * A ThreadPool runs tasks on a fixed number of worker threads.
+ *
+ * Each worker has its own task queue. A task posted from a worker thread is queued on that
+ * worker, and other tasks are queued on a shared queue. An idle worker runs the tasks of its own
+ * queue, then the shared queue, and then steals tasks from the other workers, so the workers stay
+ * busy without contending on a single queue.
+ *
+ * Tasks run in no particular order. Use a @c SerialExecutor to run a component's tasks in order
+ * on the pool.
+ */
+class ThreadPool {
+public:
+    using Task = UniqueTask;
+
+    /**
+     * Creates a thread pool.
+     *
+     * @param threadCount The number of worker threads, must be greater than 0.
+     * @param name The prefix of the @c ThreadPolicy names of the workers, or empty if the workers aren't named.
+     */
+    static std::shared_ptr<ThreadPool> create(size_t threadCount, const std::string& name = "");
+
+    /**
+     * Returns the thread pool shared by the engine components, with one worker thread per CPU core
+     * and at least two.
+     */
+    static std::shared_ptr<ThreadPool> getDefault();
+
+    /**
+     * Destructs the ThreadPool, after the workers have finished their current tasks.
+     */
+    ~ThreadPool();
+
+    /**
+     * Queues a task to run on a worker thread.
+     *
+     * @param task The task to run.
+     * @returns @c false if the pool is shutdown, in which case the task is dropped.
+     */
+    bool post(Task task);
+
+    /// Drops the queued tasks, and waits for the workers to finish their current tasks.
+    void shutdown();
+
+    /// Returns the number of worker threads.
+    size_t getThreadCount() const;
+
+    /// Returns @c true if called from one of the pool's worker threads.
+    bool isWorkerThread() const;
+
+private:
+    /// Task queue of a worker thread
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    /**
+     * @param threadCount The number of worker threads.
+     * @param name The prefix of the @c ThreadPolicy names of the workers, or empty if the workers aren't named.
+     */
+    ThreadPool(size_t threadCount, const std::string& name = "");
+
+    /// Runs tasks until the pool is shutdown.
+    void run(size_t index);
+
+    /// Takes the next task for a worker, returns @c false if there is none.
+    bool takeTask(size_t index, Task& task);
+
+    const std::string m_name;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    /// Tasks posted from outside the pool.
+    std::deque<Task> m_tasks;
+
+    /// Protects m_tasks, and is used to wait for tasks.
+    std::mutex m_mutex;
+    std::condition_variable m_taskAvailable;
+
+    /// The number of queued tasks in all queues.
+    std::atomic<size_t> m_pendingTasks{0};
+
+    /// The number of workers waiting for a task.
+    std::atomic<size_t> m_idleWorkers{0};
+
+    std::atomic<bool> m_shutdown{false};
+};
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_THREADING_THREAD_POOL_H_
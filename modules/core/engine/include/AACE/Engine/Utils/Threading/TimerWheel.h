@@ -0,0 +1,210 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_THREADING_TIMER_WHEEL_H_
+#define AACE_ENGINE_UTILS_THREADING_TIMER_WHEEL_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "UniqueTask.h"
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+/**
+ * A TimerWheel runs delayed and periodic tasks on a single timer thread.
+ *
+ * Time is divided into ticks, and each timer is kept in a slot of a hierarchical timer wheel: timers
+ * expiring within 64 ticks are in the slots of the first level, one slot per tick, and later timers
+ * are in the coarser levels, and move down a level each time the level below has turned once. A timer
+ * is added or cancelled in constant time, and the timer thread only wakes up for the ticks with
+ * expiring timers, or to move timers down a level.
+ *
+ * Timers expire on the first tick at or after their deadline, so they are late by up to one tick. The
+ * tasks run on the timer thread, and must not block: a task with more work to do should submit it to
+ * an @c Executor.
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Identifies a submitted timer, @c INVALID_TIMER is never returned for a submitted timer
+    using TimerId = uint64_t;
+    static const TimerId INVALID_TIMER = 0;
+
+    /**
+     * Creates a timer wheel and starts its timer thread.
+     *
+     * @param tick The resolution of the timers.
+     */
+    static std::shared_ptr<TimerWheel> create(std::chrono::milliseconds tick = std::chrono::milliseconds(10));
+
+    /**
+     * Returns the timer wheel shared by the engine components, with a 10 ms resolution.
+     */
+    static std::shared_ptr<TimerWheel> getDefault();
+
+    /**
+     * Destructs the TimerWheel, after the running task has finished. The pending timers are cancelled.
+     */
+    ~TimerWheel();
+
+    /**
+     * Runs a task once the delay has elapsed.
+     *
+     * @param delay The time to wait before running the task.
+     * @param task The task to run.
+     * @returns The id of the timer, or @c INVALID_TIMER if the wheel is shutdown.
+     */
+    TimerId submitAfter(Clock::duration delay, UniqueTask task);
+
+    /**
+     * Runs a task at a point in time.
+     *
+     * @param deadline The time to run the task at, the task runs on the next tick if the deadline has passed.
+     * @param task The task to run.
+     * @returns The id of the timer, or @c INVALID_TIMER if the wheel is shutdown.
+     */
+    TimerId submitAt(Clock::time_point deadline, UniqueTask task);
+
+    /**
+     * Runs a task periodically until the timer is cancelled. A run that is late doesn't delay the
+     * following runs, but the runs that were missed are skipped.
+     *
+     * @param period The time between two runs of the task, at least one tick.
+     * @param task The task to run.
+     * @param initialDelay The time to wait before the first run, or a negative duration to wait one period.
+     * @returns The id of the timer, or @c INVALID_TIMER if the wheel is shutdown.
+     */
+    TimerId submitPeriodic(
+        Clock::duration period,
+        UniqueTask task,
+        Clock::duration initialDelay = Clock::duration(-1));
+
+    /**
+     * Cancels a timer. If the task of the timer is running, the call doesn't wait for it to return, but a
+     * periodic task doesn't run again.
+     *
+     * @param id The id of the timer.
+     * @returns @c true if the timer was pending, and @c false if it has already expired or been cancelled.
+     */
+    bool cancel(TimerId id);
+
+    /// Cancels the pending timers, and stops the timer thread after the running task has finished.
+    void shutdown();
+
+    /// Returns the number of pending timers, including the timers whose task is running.
+    size_t size();
+
+private:
+    /// The number of slots in a level, as a power of two
+    static const int SLOT_BITS = 6;
+    static const size_t SLOT_COUNT = size_t(1) << SLOT_BITS;
+    static const uint64_t SLOT_MASK = SLOT_COUNT - 1;
+
+    /// The number of levels of the wheel
+    static const int LEVEL_COUNT = 4;
+
+    /// A pending timer, linked to the other timers of its slot.
+    struct Timer {
+        TimerId id;
+        uint64_t expiry;
+        uint64_t period;
+        UniqueTask task;
+        bool cancelled = false;
+        int level = 0;
+        Timer* previous = nullptr;
+        Timer* next = nullptr;
+        Timer** slot = nullptr;
+    };
+
+    /**
+     * @param tick The resolution of the timers.
+     * @param name The @c ThreadPolicy name of the timer thread, or empty if the thread isn't named.
+     */
+    TimerWheel(std::chrono::milliseconds tick, const std::string& name = "");
+
+    /// Returns the first tick at or after a point in time.
+    uint64_t toTick(Clock::time_point time) const;
+
+    /// Adds a timer. @c m_mutex must be held.
+    TimerId addTimerLocked(uint64_t expiry, uint64_t period, UniqueTask&& task);
+
+    /// Links a timer to the slot for its expiry. @c m_mutex must be held.
+    void insertLocked(Timer* timer);
+
+    /// Unlinks a timer from its slot. @c m_mutex must be held.
+    void unlinkLocked(Timer* timer);
+
+    /// Moves the timers of a slot to the slots for their expiry. @c m_mutex must be held.
+    void cascadeLocked(int level, size_t index);
+
+    /// Moves the timers down for the current tick, and takes its expired timers. @c m_mutex must be held.
+    void processTickLocked(std::vector<Timer*>& expired);
+
+    /// Returns the next tick the timer thread has to wake up for. @c m_mutex must be held.
+    uint64_t nextWakeupTickLocked() const;
+
+    /// Runs the expired timers until the wheel is shutdown.
+    void run();
+
+    /// The duration of a tick and the time of tick 0.
+    const Clock::duration m_tick;
+    const Clock::time_point m_start;
+
+    /// The name of the timer thread.
+    const std::string m_name;
+
+    /// The last tick processed by the timer thread.
+    uint64_t m_currentTick;
+
+    /// The slots of each level, each slot is the first timer of a list.
+    std::array<std::array<Timer*, SLOT_COUNT>, LEVEL_COUNT> m_wheel{};
+
+    /// The number of timers in the slots of each level.
+    std::array<size_t, LEVEL_COUNT> m_levelCounts{};
+
+    /// The pending timers and the timers being run.
+    std::unordered_map<TimerId, std::unique_ptr<Timer>> m_timers;
+
+    TimerId m_nextId;
+
+    /// Protects the timers, and is used to wake up the timer thread.
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+
+    std::atomic<bool> m_shutdown;
+
+    std::thread m_thread;
+};
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_THREADING_TIMER_WHEEL_H_
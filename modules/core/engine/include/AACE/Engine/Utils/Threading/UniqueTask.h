@@ -0,0 +1,207 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_THREADING_UNIQUE_TASK_H_
+#define AACE_ENGINE_UTILS_THREADING_UNIQUE_TASK_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+/**
+ * A UniqueTask is a move-only callable with no arguments and no return value.
+ *
+ * Unlike @c std::function, the callable doesn't have to be copyable, and callables of up to
+ * @c INLINE_SIZE bytes, such as lambdas capturing a few shared pointers, are stored inside the
+ * UniqueTask without a heap allocation. Larger callables are moved to the heap.
+ */
+class UniqueTask {
+public:
+    /// The largest callable stored without a heap allocation
+    static constexpr size_t INLINE_SIZE = 64;
+
+    /**
+     * Constructs an empty UniqueTask.
+     */
+    UniqueTask() = default;
+
+    /**
+     * Constructs a UniqueTask from a callable type.
+     *
+     * @param callable A callable type representing a task.
+     */
+    template <
+        typename Callable,
+        typename = typename std::enable_if<
+            !std::is_same<typename std::decay<Callable>::type, UniqueTask>::value>::type>
+    UniqueTask(Callable&& callable);
+
+    UniqueTask(UniqueTask&& other) noexcept;
+    UniqueTask& operator=(UniqueTask&& other) noexcept;
+
+    UniqueTask(const UniqueTask&) = delete;
+    UniqueTask& operator=(const UniqueTask&) = delete;
+
+    ~UniqueTask();
+
+    /// Calls the task, which must not be empty.
+    void operator()();
+
+    /// Returns @c true if the task is not empty.
+    explicit operator bool() const;
+
+    /// Destroys the callable, leaving the task empty.
+    void reset();
+
+private:
+    /// Operations on the stored callable of a given type
+    struct Operations {
+        void (*invoke)(void* storage);
+        void (*move)(void* from, void* to);
+        void (*destroy)(void* storage);
+    };
+
+    template <typename Callable>
+    struct InlineOperations {
+        static void invoke(void* storage) {
+            (*static_cast<Callable*>(storage))();
+        }
+        static void move(void* from, void* to) {
+            new (to) Callable(std::move(*static_cast<Callable*>(from)));
+            static_cast<Callable*>(from)->~Callable();
+        }
+        static void destroy(void* storage) {
+            static_cast<Callable*>(storage)->~Callable();
+        }
+        static const Operations operations;
+    };
+
+    template <typename Callable>
+    struct HeapOperations {
+        static void invoke(void* storage) {
+            (**static_cast<Callable**>(storage))();
+        }
+        static void move(void* from, void* to) {
+            *static_cast<Callable**>(to) = *static_cast<Callable**>(from);
+        }
+        static void destroy(void* storage) {
+            delete *static_cast<Callable**>(storage);
+        }
+        static const Operations operations;
+    };
+
+    /// Whether a callable type is stored inline, it must not throw when moved between tasks
+    template <typename Callable>
+    struct IsInline
+            : std::integral_constant<
+                  bool,
+                  sizeof(Callable) <= INLINE_SIZE && alignof(Callable) <= alignof(std::max_align_t) &&
+                      std::is_nothrow_move_constructible<Callable>::value> {};
+
+    template <typename Callable>
+    void store(Callable&& callable, std::true_type isInline);
+
+    template <typename Callable>
+    void store(Callable&& callable, std::false_type isInline);
+
+    /// The operations of the stored callable, or @c nullptr if the task is empty.
+    const Operations* m_operations = nullptr;
+
+    /// The callable if it is stored inline, or a pointer to it.
+    typename std::aligned_storage<INLINE_SIZE, alignof(std::max_align_t)>::type m_storage;
+};
+
+template <typename Callable>
+const UniqueTask::Operations UniqueTask::InlineOperations<Callable>::operations = {
+    &UniqueTask::InlineOperations<Callable>::invoke,
+    &UniqueTask::InlineOperations<Callable>::move,
+    &UniqueTask::InlineOperations<Callable>::destroy};
+
+template <typename Callable>
+const UniqueTask::Operations UniqueTask::HeapOperations<Callable>::operations = {
+    &UniqueTask::HeapOperations<Callable>::invoke,
+    &UniqueTask::HeapOperations<Callable>::move,
+    &UniqueTask::HeapOperations<Callable>::destroy};
+
+template <typename Callable, typename>
+UniqueTask::UniqueTask(Callable&& callable) {
+    using Type = typename std::decay<Callable>::type;
+    store(std::forward<Callable>(callable), IsInline<Type>());
+}
+
+template <typename Callable>
+void UniqueTask::store(Callable&& callable, std::true_type) {
+    using Type = typename std::decay<Callable>::type;
+    new (&m_storage) Type(std::forward<Callable>(callable));
+    m_operations = &InlineOperations<Type>::operations;
+}
+
+template <typename Callable>
+void UniqueTask::store(Callable&& callable, std::false_type) {
+    using Type = typename std::decay<Callable>::type;
+    *reinterpret_cast<Type**>(&m_storage) = new Type(std::forward<Callable>(callable));
+    m_operations = &HeapOperations<Type>::operations;
+}
+
+inline UniqueTask::UniqueTask(UniqueTask&& other) noexcept : m_operations{other.m_operations} {
+    if (m_operations != nullptr) {
+        m_operations->move(&other.m_storage, &m_storage);
+        other.m_operations = nullptr;
+    }
+}
+
+inline UniqueTask& UniqueTask::operator=(UniqueTask&& other) noexcept {
+    if (this != &other) {
+        reset();
+        if (other.m_operations != nullptr) {
+            other.m_operations->move(&other.m_storage, &m_storage);
+            m_operations = other.m_operations;
+            other.m_operations = nullptr;
+        }
+    }
+    return *this;
+}
+
+inline UniqueTask::~UniqueTask() {
+    reset();
+}
+
+inline void UniqueTask::operator()() {
+    m_operations->invoke(&m_storage);
+}
+
+inline UniqueTask::operator bool() const {
+    return m_operations != nullptr;
+}
+
+inline void UniqueTask::reset() {
+    if (m_operations != nullptr) {
+        m_operations->destroy(&m_storage);
+        m_operations = nullptr;
+    }
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_THREADING_UNIQUE_TASK_H_
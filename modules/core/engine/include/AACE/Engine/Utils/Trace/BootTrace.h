@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_TRACE_BOOT_TRACE_H_
+#define AACE_ENGINE_UTILS_TRACE_BOOT_TRACE_H_
+
+#include <chrono>
+#include <string>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace trace {
+
+/**
+ * Records the time spent in the steps of the engine startup, such as the configuration of each service.
+ *
+ * The trace records from @c start() until @c stop(), and is exported in the Chrome trace event format, which the
+ * Chrome tracing tool and the Perfetto UI display as a timeline with a track for each thread. While the trace is
+ * not recording, a @c Scope costs an atomic load.
+ */
+class BootTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Records the time from its construction to its destruction as a trace event
+    class Scope {
+    public:
+        /**
+         * @param name The name of the event, such as the type of the service.
+         * @param category The category of the event, such as the engine event the service handles.
+         */
+        Scope(const std::string& name, const std::string& category);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const std::string m_name;
+        const std::string m_category;
+        const bool m_recording;
+        const Clock::time_point m_start;
+    };
+
+    /// Clears the recorded events, and starts recording.
+    static void start();
+
+    /// Stops recording, and keeps the recorded events until the next @c start().
+    static void stop();
+
+    /// Returns @c true while the trace is recording.
+    static bool isRecording();
+
+    /**
+     * Records an event, if the trace is recording.
+     *
+     * @param name The name of the event.
+     * @param category The category of the event.
+     * @param start The start time of the event.
+     * @param end The end time of the event.
+     */
+    static void record(
+        const std::string& name,
+        const std::string& category,
+        Clock::time_point start,
+        Clock::time_point end);
+
+    /// Returns the recorded events as a Chrome trace event JSON document.
+    static std::string toJson();
+
+    /**
+     * Writes the recorded events to a file, as a Chrome trace event JSON document.
+     *
+     * @param path The path of the file.
+     * @return @c false if the file could not be written.
+     */
+    static bool exportTrace(const std::string& path);
+};
+
+}  // namespace trace
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_TRACE_BOOT_TRACE_H_
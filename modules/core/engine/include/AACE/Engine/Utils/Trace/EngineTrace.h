@@ -0,0 +1,152 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_UTILS_TRACE_ENGINE_TRACE_H_
+#define AACE_ENGINE_UTILS_TRACE_ENGINE_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace trace {
+
+/**
+ * Records the trace points of the engine threads as a timeline, such as the dispatch of the messages and the
+ * handling of the directives of a voice turn.
+ *
+ * The trace points are recorded with the @c AACE_TRACE_BEGIN, @c AACE_TRACE_END, @c AACE_TRACE_COUNTER and
+ * @c AACE_TRACE_SCOPE macros of @c EngineMacros.h, which are compiled out unless the engine is built with
+ * @c AAC_TRACE_ENABLED. Each thread records its events in its own buffer without a lock, and the events of a
+ * thread whose buffer is full are dropped. The buffered events are exported in the Chrome trace event format,
+ * which the Perfetto UI and the Chrome tracing tool display with a track for each thread. On Linux, the events
+ * can be written to the ftrace marker instead, so they appear in a system trace with the kernel events.
+ *
+ * While the trace is not recording, a trace point costs an atomic load.
+ */
+class EngineTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Where the events are recorded
+    enum class Output {
+        // the buffers of the threads, exported with toJson() or exportTrace()
+        BUFFER,
+        // the Linux ftrace marker
+        FTRACE
+    };
+
+    /// The default number of events each thread buffers
+    static const size_t DEFAULT_EVENTS_PER_THREAD = 4096;
+
+    /// The longest event name, longer names are truncated
+    static const size_t MAX_NAME_LENGTH = 47;
+
+    /// Records a begin event when constructed and the matching end event when destroyed
+    class Scope {
+    public:
+        /**
+         * @param category The category of the event, a string literal.
+         * @param name The name of the event.
+         */
+        Scope(const char* category, const char* name);
+        Scope(const char* category, const std::string& name);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_category;
+        bool m_recording;
+    };
+
+    /**
+     * Clears the recorded events, and starts recording.
+     *
+     * @param eventsPerThread The number of events each thread buffers.
+     * @param output Where the events are recorded.
+     * @return @c false if the parameters are invalid, or the ftrace marker could not be opened.
+     */
+    static bool start(size_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD, Output output = Output::BUFFER);
+
+    /// Stops recording, and keeps the buffered events until the next @c start().
+    static void stop();
+
+    /// Returns @c true while the trace is recording.
+    static bool isRecording() {
+        return s_recording.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Records the beginning of an event on the calling thread.
+     *
+     * @param category The category of the event, a string literal which must outlive the trace.
+     * @param name The name of the event.
+     */
+    static void begin(const char* category, const char* name);
+    static void begin(const char* category, const std::string& name);
+
+    /**
+     * Records the end of the last event begun on the calling thread.
+     *
+     * @param category The category of the event, a string literal which must outlive the trace.
+     */
+    static void end(const char* category);
+
+    /**
+     * Records the value of a counter, such as the depth of a queue.
+     *
+     * @param category The category of the counter, a string literal which must outlive the trace.
+     * @param name The name of the counter.
+     * @param value The value of the counter.
+     */
+    static void counter(const char* category, const char* name, int64_t value);
+
+    /**
+     * Names the track of the calling thread in the exported trace.
+     *
+     * @param name The name of the thread.
+     */
+    static void setCurrentThreadName(const std::string& name);
+
+    /// Returns the buffered events as a Chrome trace event JSON document.
+    static std::string toJson();
+
+    /**
+     * Writes the buffered events to a file, as a Chrome trace event JSON document.
+     *
+     * @param path The path of the file.
+     * @return @c false if the file could not be written.
+     */
+    static bool exportTrace(const std::string& path);
+
+private:
+    /// Records an event of the calling thread.
+    static void record(char phase, const char* category, const char* name, size_t nameLength, int64_t value);
+
+    /// Whether the trace is recording, checked by each trace point
+    static std::atomic<bool> s_recording;
+};
+
+}  // namespace trace
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_UTILS_TRACE_ENGINE_TRACE_H_
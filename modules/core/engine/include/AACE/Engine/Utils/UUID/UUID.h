@@ -30,6 +30,8 @@ namespace uuid {
  * variant 1.
  * @see https://tools.ietf.org/html/rfc4122.
  *
+ * Each thread draws from its own random number generator, so concurrent callers don't contend on a lock.
+ *
  * @return A uuid as a string.
  */
 const std::string generateUUID();
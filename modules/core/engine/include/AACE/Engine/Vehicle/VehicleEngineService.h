@@ -17,6 +17,8 @@
 #define AACE_ENGINE_VEHICLE_VEHICLE_ENGINE_SERVICE_H
 
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "AACE/Engine/Core/EngineService.h"
 #include "AACE/Engine/Metrics/MetricEvent.h"
@@ -104,6 +106,12 @@ protected:
     std::string getPropertyAttributeForMetric(VehiclePropertyType property);
     std::shared_ptr<aace::engine::metrics::MetricEvent> generateVehiclePropertiesMetric();
 
+    /**
+     * Builds the metric data points of the configured vehicle properties, with the names required for metrics and the
+     * values sanitized of the metric delimiters, so each metric recorded reuses them.
+     */
+    void buildMetricDataPoints();
+
 private:
     bool registerProperties();
 
@@ -111,6 +119,9 @@ private:
     std::unordered_map<VehiclePropertyType, std::string, EnumHash> m_vehiclePropertyMap;
     std::string m_operatingCountry;
 
+    /// The metric data points of the vehicle properties, built at configuration
+    std::vector<std::pair<std::string, std::string>> m_metricDataPoints;
+
     /// Record full metric flag
     bool m_recordFull;
 
@@ -13,21 +13,132 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+#include <sstream>
 #include <typeinfo>
 
 #include <AACE/Engine/Audio/AudioEngineService.h>
+#include <AACE/Engine/Audio/AudioInputProcessors.h>
 #include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/JSON/JSON.h>
 
 namespace aace {
 namespace engine {
 namespace audio {
 
+namespace json = aace::engine::utils::json;
+
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.audio.AudioEngineService");
 
 // register the service
 REGISTER_SERVICE(AudioEngineService)
 
+/// The audio input types processed by default, which capture speech
+static const std::vector<AudioManagerInterface::AudioInputType> DEFAULT_PROCESSED_INPUT_TYPES = {
+    AudioManagerInterface::AudioInputType::VOICE,
+    AudioManagerInterface::AudioInputType::COMMUNICATION};
+
+/// The audio input types kept in warm standby by default, which capture the speech to recognize
+static const std::vector<AudioManagerInterface::AudioInputType> DEFAULT_STANDBY_INPUT_TYPES = {
+    AudioManagerInterface::AudioInputType::VOICE};
+
+/// The duration of the pre-roll of the warm standby by default
+static const uint64_t DEFAULT_STANDBY_PRE_ROLL_MS = 200;
+
+static const std::vector<AudioManagerInterface::AudioInputType> ALL_INPUT_TYPES = {
+    AudioManagerInterface::AudioInputType::VOICE,
+    AudioManagerInterface::AudioInputType::COMMUNICATION,
+    AudioManagerInterface::AudioInputType::LOOPBACK};
+
+static const std::vector<AudioManagerInterface::AudioOutputType> ALL_OUTPUT_TYPES = {
+    AudioManagerInterface::AudioOutputType::TTS,
+    AudioManagerInterface::AudioOutputType::MUSIC,
+    AudioManagerInterface::AudioOutputType::NOTIFICATION,
+    AudioManagerInterface::AudioOutputType::ALARM,
+    AudioManagerInterface::AudioOutputType::EARCON,
+    AudioManagerInterface::AudioOutputType::COMMUNICATION,
+    AudioManagerInterface::AudioOutputType::RINGTONE};
+
+/// The audio output channels pre-warmed by default, which play the dialog, the alerts, and the earcons
+static const std::vector<std::pair<std::string, AudioManagerInterface::AudioOutputType>>
+    DEFAULT_PREWARMED_OUTPUT_CHANNELS = {
+        {"SpeechSynthesizer", AudioManagerInterface::AudioOutputType::TTS},
+        {"Alerts", AudioManagerInterface::AudioOutputType::ALARM},
+        {"SystemSoundPlayer", AudioManagerInterface::AudioOutputType::EARCON}};
+
+static float getNumber(const json::Value& config, const std::string& path, float defaultValue) {
+    auto value = json::get(config, path);
+    ReturnIf(value == nullptr, defaultValue);
+    ThrowIfNot(value.is_number(), "invalidNumber");
+    return value.get<float>();
+}
+
+static std::vector<AudioManagerInterface::AudioInputType> getInputTypes(
+    const json::Value& config,
+    const std::vector<AudioManagerInterface::AudioInputType>& defaultTypes = DEFAULT_PROCESSED_INPUT_TYPES) {
+    auto typesConfig = json::get(config, "/inputTypes", json::Type::array);
+    ReturnIf(typesConfig == nullptr, defaultTypes);
+    std::vector<AudioManagerInterface::AudioInputType> types;
+    for (size_t j = 0; j < typesConfig.size(); j++) {
+        ThrowIfNot(typesConfig[j].is_string(), "invalidInputType");
+        auto name = typesConfig[j].get<std::string>();
+        auto size = types.size();
+        for (auto type : ALL_INPUT_TYPES) {
+            std::stringstream typeName;
+            typeName << type;
+            if (typeName.str() == name) {
+                types.push_back(type);
+            }
+        }
+        ThrowIf(types.size() == size, "invalidInputType");
+    }
+    return types;
+}
+
+static AudioManagerInterface::AudioOutputType getOutputType(const std::string& name) {
+    for (auto type : ALL_OUTPUT_TYPES) {
+        std::stringstream typeName;
+        typeName << type;
+        if (typeName.str() == name) {
+            return type;
+        }
+    }
+    Throw("invalidOutputType:" + name);
+}
+
+/// Returns the factory of a processor of the configuration, which processes the inputs of its types.
+static AudioInputProcessorFactory createProcessorFactory(const json::Value& config) {
+    ThrowIfNot(config.is_object(), "invalidProcessor");
+    auto name = json::get(config, "/type", "");
+    auto types = getInputTypes(config);
+    std::function<std::shared_ptr<AudioInputProcessor>(uint32_t)> create;
+    if (name == "highPass") {
+        auto cutoff = getNumber(config, "/cutoff", HighPassFilterProcessor::DEFAULT_CUTOFF);
+        create = [cutoff](uint32_t sampleRate) { return HighPassFilterProcessor::create(sampleRate, cutoff); };
+    } else if (name == "agc") {
+        AutomaticGainControlProcessor::Config agcConfig;
+        agcConfig.targetLevel = getNumber(config, "/targetLevel", agcConfig.targetLevel);
+        agcConfig.maxGain = getNumber(config, "/maxGain", agcConfig.maxGain);
+        agcConfig.noiseGate = getNumber(config, "/noiseGate", agcConfig.noiseGate);
+        agcConfig.gainRate = getNumber(config, "/gainRate", agcConfig.gainRate);
+        ThrowIfNull(
+            AutomaticGainControlProcessor::create(AudioInputEngineImpl::CHANNEL_SAMPLE_RATE, agcConfig),
+            "invalidAgcConfig");
+        create = [agcConfig](uint32_t sampleRate) {
+            return AutomaticGainControlProcessor::create(sampleRate, agcConfig);
+        };
+    } else if (name == "downmix") {
+        create = [](uint32_t) { return DownmixProcessor::create(); };
+    } else {
+        Throw("invalidProcessorType:" + name);
+    }
+
+    return [types, create](AudioManagerInterface::AudioInputType type, uint32_t sampleRate, uint32_t) {
+        return std::find(types.begin(), types.end(), type) != types.end() ? create(sampleRate) : nullptr;
+    };
+}
+
 AudioEngineService::AudioEngineService(const aace::engine::core::ServiceDescription& description) :
         aace::engine::core::EngineService(description) {
 }
@@ -45,6 +156,86 @@ bool AudioEngineService::initialize() {
     }
 }
 
+bool AudioEngineService::configure(std::shared_ptr<std::istream> configuration) {
+    try {
+        auto root = json::toJson(configuration);
+        ThrowIfNull(root, "parseConfigurationFailed");
+
+        // deliver the audio input to each channel on its own thread
+        auto fanOutConfig = json::get(root, "/audioInput/fanOut", json::Type::object);
+        if (fanOutConfig != nullptr && json::get(fanOutConfig, "/buffered", false)) {
+            auto bufferSize =
+                json::get(fanOutConfig, "/bufferSize", (uint64_t)AudioInputEngineImpl::DEFAULT_BUFFER_SIZE);
+            ThrowIf(bufferSize < sizeof(int16_t), "invalidBufferSize");
+            m_audioInputFanOut = AudioInputEngineImpl::FanOut::BUFFERED;
+            m_audioInputBufferSize = bufferSize;
+        }
+
+        // the format of the audio written by the platform, converted to 16 kHz mono
+        auto formatConfig = json::get(root, "/audioInput/format", json::Type::object);
+        if (formatConfig != nullptr) {
+            auto sampleRate =
+                json::get(formatConfig, "/sampleRate", (uint64_t)AudioInputEngineImpl::CHANNEL_SAMPLE_RATE);
+            auto channels = json::get(formatConfig, "/channels", (uint64_t)1);
+            ThrowIf(sampleRate == 0 || sampleRate > UINT32_MAX, "invalidSampleRate");
+            ThrowIf(channels == 0 || channels > UINT32_MAX, "invalidChannels");
+            m_audioInputFormat.sampleRate = static_cast<uint32_t>(sampleRate);
+            m_audioInputFormat.channels = static_cast<uint32_t>(channels);
+        }
+
+        // the platform inputs kept started after their last channel stops, and the pre-roll of their next channel
+        auto standbyConfig = json::get(root, "/audioInput/standby", json::Type::object);
+        if (standbyConfig != nullptr) {
+            auto holdTime = json::get(standbyConfig, "/holdTime", (uint64_t)0);
+            auto preRoll = json::get(standbyConfig, "/preRoll", DEFAULT_STANDBY_PRE_ROLL_MS);
+            ThrowIf(holdTime > INT32_MAX || preRoll > INT32_MAX, "invalidStandby");
+            m_audioInputStandby = AudioInputEngineImpl::Standby(
+                std::chrono::milliseconds(holdTime), std::chrono::milliseconds(preRoll));
+            m_audioInputStandbyTypes = getInputTypes(standbyConfig, DEFAULT_STANDBY_INPUT_TYPES);
+        }
+
+        // the processors of the written audio, and the reference of the audio outputs they read
+        auto processingConfig = json::get(root, "/audioInput/processing", json::Type::object);
+        if (processingConfig != nullptr) {
+            std::vector<AudioInputProcessorFactory> factories;
+            auto processorsConfig = json::get(processingConfig, "/processors", json::Type::array);
+            for (size_t j = 0; processorsConfig != nullptr && j < processorsConfig.size(); j++) {
+                factories.push_back(createProcessorFactory(processorsConfig[j]));
+            }
+            if (json::get(processingConfig, "/reference", false)) {
+                m_referenceTap = AudioReferenceTap::create(m_audioInputFormat.sampleRate);
+                ThrowIfNull(m_referenceTap, "createReferenceTapFailed");
+            }
+            std::lock_guard<std::mutex> lock(m_processorMutex);
+            factories.insert(
+                factories.end(), m_audioInputProcessorFactories.begin(), m_audioInputProcessorFactories.end());
+            m_audioInputProcessorFactories = std::move(factories);
+        }
+
+        // the audio output channels opened and primed when the Engine starts
+        auto prewarmConfig = json::get(root, "/audioOutput/prewarm", json::Type::object);
+        if (prewarmConfig != nullptr && json::get(prewarmConfig, "/enabled", false)) {
+            auto channelsConfig = json::get(prewarmConfig, "/channels", json::Type::array);
+            if (channelsConfig == nullptr) {
+                m_prewarmedOutputChannels = DEFAULT_PREWARMED_OUTPUT_CHANNELS;
+            } else {
+                m_prewarmedOutputChannels.clear();
+                for (size_t j = 0; j < channelsConfig.size(); j++) {
+                    auto name = json::get(channelsConfig[j], "/name", "");
+                    auto type = getOutputType(json::get(channelsConfig[j], "/type", ""));
+                    ThrowIf(name.empty(), "invalidChannelName");
+                    m_prewarmedOutputChannels.emplace_back(name, type);
+                }
+            }
+        }
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "configure").d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool AudioEngineService::registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) {
     try {
         ReturnIf(registerPlatformInterfaceType<aace::audio::AudioInputProvider>(platformInterface), true);
@@ -60,7 +251,16 @@ bool AudioEngineService::registerPlatformInterfaceType(
     std::shared_ptr<aace::audio::AudioInputProvider> audioInputProvider) {
     try {
         ThrowIfNotNull(m_audioInputProvideEngineImpl, "platformInterfaceAlreadyRegistered");
-        m_audioInputProvideEngineImpl = AudioInputProviderEngineImpl::create(audioInputProvider);
+        std::lock_guard<std::mutex> lock(m_processorMutex);
+        m_audioInputProvideEngineImpl = AudioInputProviderEngineImpl::create(
+            audioInputProvider,
+            m_audioInputFanOut,
+            m_audioInputBufferSize,
+            m_audioInputFormat,
+            m_audioInputProcessorFactories,
+            m_referenceTap,
+            m_audioInputStandby,
+            m_audioInputStandbyTypes);
 
         return true;
     } catch (std::exception& ex) {
@@ -73,7 +273,7 @@ bool AudioEngineService::registerPlatformInterfaceType(
     std::shared_ptr<aace::audio::AudioOutputProvider> audioOutputProvider) {
     try {
         ThrowIfNotNull(m_audioOutputProvideEngineImpl, "platformInterfaceAlreadyRegistered");
-        m_audioOutputProvideEngineImpl = AudioOutputProviderEngineImpl::create(audioOutputProvider);
+        m_audioOutputProvideEngineImpl = AudioOutputProviderEngineImpl::create(audioOutputProvider, m_referenceTap);
 
         return true;
     } catch (std::exception& ex) {
@@ -120,6 +320,35 @@ std::shared_ptr<AudioOutputChannelInterface> AudioEngineService::openAudioOutput
     }
 }
 
+bool AudioEngineService::isAudioOutputPlaying() {
+    auto audioOutputProvider = m_audioOutputProvideEngineImpl;
+    return audioOutputProvider != nullptr && audioOutputProvider->isPlaying();
+}
+
+void AudioEngineService::addAudioInputProcessor(AudioInputProcessorFactory factory) {
+    try {
+        ThrowIfNull(factory, "invalidFactory");
+        std::lock_guard<std::mutex> lock(m_processorMutex);
+        m_audioInputProcessorFactories.push_back(factory);
+        if (m_audioInputProvideEngineImpl != nullptr) {
+            m_audioInputProvideEngineImpl->addProcessorFactory(factory);
+        }
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "addAudioInputProcessor").d("reason", ex.what()));
+    }
+}
+
+bool AudioEngineService::engineStarted() {
+    // the components opened their channels when the Engine was set up
+    auto audioOutputProvider = m_audioOutputProvideEngineImpl;
+    if (audioOutputProvider != nullptr) {
+        for (auto& next : m_prewarmedOutputChannels) {
+            audioOutputProvider->prewarmChannel(next.first, next.second);
+        }
+    }
+    return true;
+}
+
 bool AudioEngineService::shutdown() {
     if (m_audioInputProvideEngineImpl != nullptr) {
         m_audioInputProvideEngineImpl->doShutdown();
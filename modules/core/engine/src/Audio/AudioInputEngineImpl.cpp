@@ -13,9 +13,13 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+
 #include <AACE/Engine/Audio/AudioInputEngineImpl.h>
 #include <AACE/Engine/Core/EngineMacros.h>
 #include <AACE/Engine/Utils/Metrics/Metrics.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+#include <AACE/Engine/Utils/Threading/ThreadPool.h>
 
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.audio.AudioInputEngineImpl");
@@ -33,17 +37,69 @@ namespace engine {
 namespace audio {
 
 using namespace aace::engine::utils::metrics;
+using aace::engine::messageBroker::RingBufferMessageStream;
+using aace::engine::utils::threading::ThreadPool;
+using aace::engine::utils::threading::TimerWheel;
+
+constexpr size_t AudioInputEngineImpl::DEFAULT_BUFFER_SIZE;
+constexpr uint32_t AudioInputEngineImpl::CHANNEL_SAMPLE_RATE;
 
-AudioInputEngineImpl::AudioInputEngineImpl(std::shared_ptr<aace::audio::AudioInput> platformAudioInput) :
-        m_platformAudioInput(platformAudioInput) {
+AudioInputEngineImpl::AudioInputEngineImpl(
+    std::shared_ptr<aace::audio::AudioInput> platformAudioInput,
+    const std::string& name,
+    FanOut fanOut,
+    size_t bufferSize,
+    const InputFormat& inputFormat,
+    const std::vector<std::shared_ptr<AudioInputProcessor>>& processors,
+    std::shared_ptr<AudioReferenceTap> referenceTap,
+    const Standby& standby) :
+        m_platformAudioInput(platformAudioInput),
+        m_name(name),
+        m_fanOut(fanOut),
+        m_bufferSize(bufferSize),
+        m_inputFormat(inputFormat),
+        m_processors(processors),
+        m_referenceTap(referenceTap),
+        m_convert(
+            inputFormat.channels != 1 || inputFormat.sampleRate != CHANNEL_SAMPLE_RATE || !processors.empty()),
+        m_standby(standby),
+        m_channels(std::make_shared<ChannelList>()) {
+    if (inputFormat.sampleRate != CHANNEL_SAMPLE_RATE) {
+        m_resampler =
+            aace::engine::utils::pcm::PolyphaseResampler::create(inputFormat.sampleRate, CHANNEL_SAMPLE_RATE);
+    }
+    if (standby.holdTime.count() > 0) {
+        auto frames = static_cast<uint64_t>(standby.preRoll.count()) * inputFormat.sampleRate / 1000;
+        m_preRoll.resize(static_cast<size_t>(frames * inputFormat.channels));
+    }
 }
 
 std::shared_ptr<AudioInputEngineImpl> AudioInputEngineImpl::create(
-    std::shared_ptr<aace::audio::AudioInput> platformAudioInput) {
+    std::shared_ptr<aace::audio::AudioInput> platformAudioInput,
+    const std::string& name,
+    FanOut fanOut,
+    size_t bufferSize,
+    const InputFormat& inputFormat,
+    const std::vector<std::shared_ptr<AudioInputProcessor>>& processors,
+    std::shared_ptr<AudioReferenceTap> referenceTap,
+    const Standby& standby) {
     try {
         ThrowIfNull(platformAudioInput, "invalidAudioInputPlatformInterface");
+        ThrowIf(fanOut == FanOut::BUFFERED && bufferSize < sizeof(int16_t), "invalidBufferSize");
+        ThrowIf(inputFormat.sampleRate == 0 || inputFormat.channels == 0, "invalidInputFormat");
+        for (auto& next : processors) {
+            ThrowIfNull(next, "invalidProcessor");
+        }
+        ThrowIf(
+            referenceTap != nullptr && referenceTap->getSampleRate() != inputFormat.sampleRate,
+            "invalidReferenceSampleRate");
+        ThrowIf(standby.holdTime.count() < 0 || standby.preRoll.count() < 0, "invalidStandby");
 
-        auto audioInputEngineImpl = std::shared_ptr<AudioInputEngineImpl>(new AudioInputEngineImpl(platformAudioInput));
+        auto audioInputEngineImpl = std::shared_ptr<AudioInputEngineImpl>(new AudioInputEngineImpl(
+            platformAudioInput, name, fanOut, bufferSize, inputFormat, processors, referenceTap, standby));
+        ThrowIf(
+            inputFormat.sampleRate != CHANNEL_SAMPLE_RATE && audioInputEngineImpl->m_resampler == nullptr,
+            "unsupportedSampleRate");
 
         // set the platform engine interface reference
         platformAudioInput->setEngineInterface(audioInputEngineImpl);
@@ -65,22 +121,82 @@ AudioInputChannelInterface::ChannelId AudioInputEngineImpl::start(AudioWriteCall
         std::lock_guard<std::mutex> clientLock(m_mutex);
         std::unique_lock<std::mutex> callbackLock(m_callbackMutex);
 
-        // call the platform startAudioInput() if there are no observers
-        if (m_callbackMap.empty()) {
-            // Release the lock temporarily so that audio data callback can acquire it and prevent deadlock
-            callbackLock.unlock();
-            emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "start", {METRIC_AUDIO_INPUT_START_AUDIO_INPUT});
-            ThrowIfNot(m_platformAudioInput->startAudioInput(), "startPlatformAudioInputFailed");
-            callbackLock.lock();
+        // call the platform startAudioInput() if there are no observers, unless the input is in standby
+        std::shared_ptr<Channel> converter;
+        std::vector<int16_t> preRoll;
+        if (m_channelMap.empty()) {
+            if (m_inStandby) {
+                TimerWheel::getDefault()->cancel(m_standbyTimer);
+                m_standbyTimer = TimerWheel::INVALID_TIMER;
+                preRoll = takePreRollLocked();
+                AACE_DEBUG(LX(TAG, "start").m("startedInStandby").d("name", m_name).d("preRoll", preRoll.size()));
+            } else {
+                // Release the lock temporarily so that audio data callback can acquire it and prevent deadlock
+                callbackLock.unlock();
+                emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "start", {METRIC_AUDIO_INPUT_START_AUDIO_INPUT});
+                ThrowIfNot(m_platformAudioInput->startAudioInput(), "startPlatformAudioInputFailed");
+                callbackLock.lock();
+            }
+
+            // the platform starts a new stream, or the pre-roll is only the latest audio of the standby, so the
+            // next conversion resets the conversion state
+            m_resetConversion = true;
+
+            // the converter buffers the written audio at the input rate, for as long as a channel buffers it
+            if (m_fanOut == FanOut::BUFFERED && m_convert) {
+                converter = std::make_shared<Channel>();
+                converter->callback = [this](const int16_t* data, size_t size) { convertAndPush(data, size); };
+                auto size = static_cast<uint64_t>(m_bufferSize) * m_inputFormat.sampleRate * m_inputFormat.channels /
+                            CHANNEL_SAMPLE_RATE;
+                converter->buffer = RingBufferMessageStream::create(static_cast<size_t>(size));
+                ThrowIfNull(converter->buffer, "createConverterBufferFailed");
+            }
+        }
+
+        auto channel = std::make_shared<Channel>();
+        channel->id = getNextChannelId();
+        channel->callback = callback;
+
+        // the buffered channel is written to by write() once its thread is running
+        if (m_fanOut == FanOut::BUFFERED) {
+            channel->buffer = RingBufferMessageStream::create(m_bufferSize);
+            ThrowIfNull(channel->buffer, "createBufferFailed");
+            channel->thread =
+                std::thread(drain, channel, "AudioInput." + m_name + "." + std::to_string(channel->id));
         }
 
-        // get the next channel id
-        auto id = getNextChannelId();
+        // the pre-roll precedes the written audio, so it is copied before write() sees the channel or the converter
+        if (!preRoll.empty()) {
+            if (converter != nullptr) {
+                push(*converter, preRoll.data(), preRoll.size(), m_inputFormat.channels);
+            } else if (m_fanOut == FanOut::BUFFERED) {
+                push(*channel, preRoll.data(), preRoll.size());
+            } else {
+                const int16_t* samples = preRoll.data();
+                auto count = preRoll.size();
+                if (m_convert) {
+                    convert(samples, count);
+                }
+                if (count > 0) {
+                    callback(samples, count);
+                }
+            }
+        }
 
-        // add the callback to the channel callback map
-        m_callbackMap[id] = callback;
+        // add the channel to the channel map
+        m_channelMap[channel->id] = channel;
+        if (m_fanOut == FanOut::BUFFERED) {
+            publishChannelsLocked();
+        }
 
-        return id;
+        // the converter delivers its audio to the published channels
+        if (converter != nullptr) {
+            converter->thread = std::thread(drain, converter, "AudioInput." + m_name + ".convert");
+            std::atomic_store(&m_converter, converter);
+        }
+        m_inStandby = false;
+
+        return channel->id;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "start").d("reason", ex.what()));
         return INVALID_CHANNEL;
@@ -92,12 +208,50 @@ void AudioInputEngineImpl::stop(ChannelId id) {
         std::lock_guard<std::mutex> clientLock(m_mutex);
         std::unique_lock<std::mutex> callbackLock(m_callbackMutex);
 
-        auto it = m_callbackMap.find(id);
-        ThrowIf(it == m_callbackMap.end(), "invalidChannelId");
-        m_callbackMap.erase(it);
-        bool shouldStopAudioInput = m_callbackMap.empty();
+        auto it = m_channelMap.find(id);
+        ThrowIf(it == m_channelMap.end(), "invalidChannelId");
+        auto channel = it->second;
+        m_channelMap.erase(it);
+        bool shouldStopAudioInput = m_channelMap.empty();
+        std::shared_ptr<Channel> converter;
+        if (m_fanOut == FanOut::BUFFERED) {
+            publishChannelsLocked();
+            if (shouldStopAudioInput) {
+                converter = std::atomic_exchange(&m_converter, std::shared_ptr<Channel>());
+            }
+        }
+
+        // the platform input stays started for the hold time, and write() keeps the latest audio meanwhile
+        bool enterStandby = shouldStopAudioInput && m_standby.holdTime.count() > 0;
+        if (enterStandby) {
+            m_preRollStart = m_preRollSize = 0;
+            m_inStandby = true;
+        }
         callbackLock.unlock();
 
+        // the buffered audio that was not delivered yet is discarded
+        if (channel->thread.joinable()) {
+            stopChannel(*channel);
+        }
+        if (converter != nullptr && converter->thread.joinable()) {
+            stopChannel(*converter);
+        }
+
+        if (enterStandby) {
+            auto generation = ++m_standbyGeneration;
+            std::weak_ptr<AudioInputEngineImpl> wp = shared_from_this();
+            m_standbyTimer = TimerWheel::getDefault()->submitAfter(m_standby.holdTime, [wp, generation]() {
+                // the timer tasks must not block, so the platform input is stopped on a pool thread
+                ThreadPool::getDefault()->post([wp, generation]() {
+                    if (auto self = wp.lock()) {
+                        self->endStandby(generation);
+                    }
+                });
+            });
+            AACE_DEBUG(LX(TAG, "stop").m("standbyStarted").d("name", m_name).d("holdTime", m_standby.holdTime.count()));
+            return;
+        }
+
         // call the platform stopAudioInput() if the channel is the only channel
         // requesting audio from the audio provider
         if (shouldStopAudioInput) {
@@ -111,18 +265,285 @@ void AudioInputEngineImpl::stop(ChannelId id) {
 
 void AudioInputEngineImpl::doShutdown() {
     std::lock_guard<std::mutex> clientLock(m_mutex);
-    std::lock_guard<std::mutex> callbackLock(m_callbackMutex);
+    std::unique_lock<std::mutex> callbackLock(m_callbackMutex);
     m_platformAudioInput->setEngineInterface(nullptr);
+
+    // stop the channel threads, which don't receive audio anymore
+    if (m_fanOut == FanOut::BUFFERED) {
+        auto channelMap = std::move(m_channelMap);
+        m_channelMap.clear();
+        publishChannelsLocked();
+        auto converter = std::atomic_exchange(&m_converter, std::shared_ptr<Channel>());
+        callbackLock.unlock();
+        for (auto& next : channelMap) {
+            if (next.second->thread.joinable()) {
+                stopChannel(*next.second);
+            }
+        }
+        if (converter != nullptr && converter->thread.joinable()) {
+            stopChannel(*converter);
+        }
+    }
+
+    // the platform input started only for the standby is stopped
+    if (callbackLock.owns_lock()) {
+        callbackLock.unlock();
+    }
+    if (m_inStandby.exchange(false)) {
+        TimerWheel::getDefault()->cancel(m_standbyTimer);
+        m_standbyTimer = TimerWheel::INVALID_TIMER;
+        m_platformAudioInput->stopAudioInput();
+    }
+}
+
+void AudioInputEngineImpl::endStandby(uint64_t generation) {
+    try {
+        std::lock_guard<std::mutex> clientLock(m_mutex);
+        ReturnIf(!m_inStandby || generation != m_standbyGeneration);
+        {
+            std::lock_guard<std::mutex> callbackLock(m_callbackMutex);
+            m_inStandby = false;
+            m_preRollStart = m_preRollSize = 0;
+        }
+        m_standbyTimer = TimerWheel::INVALID_TIMER;
+        AACE_DEBUG(LX(TAG, "endStandby").d("name", m_name));
+        emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "stop", {METRIC_AUDIO_INPUT_STOP_AUDIO_INPUT});
+        ThrowIfNot(m_platformAudioInput->stopAudioInput(), "stopPlatformAudioInputFailed");
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "endStandby").d("reason", ex.what()));
+    }
+}
+
+void AudioInputEngineImpl::writePreRollLocked(const int16_t* data, size_t size) {
+    auto capacity = m_preRoll.size();
+    size -= size % m_inputFormat.channels;
+    ReturnIf(capacity == 0 || size == 0);
+
+    // only the latest audio that fits is kept, the older audio is overwritten
+    if (size >= capacity) {
+        std::copy(data + size - capacity, data + size, m_preRoll.begin());
+        m_preRollStart = 0;
+        m_preRollSize = capacity;
+        return;
+    }
+    auto end = (m_preRollStart + m_preRollSize) % capacity;
+    auto first = std::min(size, capacity - end);
+    std::copy(data, data + first, m_preRoll.begin() + end);
+    std::copy(data + first, data + size, m_preRoll.begin());
+    auto overwritten = m_preRollSize + size > capacity ? m_preRollSize + size - capacity : 0;
+    m_preRollStart = (m_preRollStart + overwritten) % capacity;
+    m_preRollSize += size - overwritten;
+}
+
+std::vector<int16_t> AudioInputEngineImpl::takePreRollLocked() {
+    std::vector<int16_t> preRoll;
+    preRoll.reserve(m_preRollSize);
+    auto capacity = m_preRoll.size();
+    for (size_t j = 0; j < m_preRollSize; j++) {
+        preRoll.push_back(m_preRoll[(m_preRollStart + j) % capacity]);
+    }
+    m_preRollStart = m_preRollSize = 0;
+    return preRoll;
+}
+
+void AudioInputEngineImpl::convert(const int16_t*& data, size_t& size) {
+    auto channels = m_inputFormat.channels;
+    bool reset = m_resetConversion.exchange(false);
+    if (reset) {
+        m_carry.clear();
+    }
+
+    // an incomplete frame at the end of the write is completed by the next write
+    bool copied = false;
+    if (!m_carry.empty()) {
+        m_carry.insert(m_carry.end(), data, data + size);
+        m_mixBuffer.swap(m_carry);
+        m_carry.clear();
+        data = m_mixBuffer.data();
+        size = m_mixBuffer.size();
+        copied = true;
+    }
+    auto frames = size / channels;
+    if (frames * channels < size) {
+        m_carry.assign(data + frames * channels, data + size);
+    }
+
+    if (!m_processors.empty()) {
+        // the processors process a copy of the audio in place, which the following steps convert in place
+        if (!copied) {
+            m_mixBuffer.assign(data, data + frames * channels);
+            data = m_mixBuffer.data();
+        }
+        AudioInputBlock block = {m_mixBuffer.data(), frames, channels, m_inputFormat.sampleRate, nullptr};
+        if (m_referenceTap != nullptr) {
+            m_referenceBuffer.resize(frames);
+            m_referenceTap->read(m_referenceBuffer.data(), frames);
+            block.reference = m_referenceBuffer.data();
+        }
+        for (auto& next : m_processors) {
+            if (reset) {
+                next->reset();
+            }
+            next->process(block);
+            ThrowIf(block.channels == 0 || block.channels > channels, "invalidProcessedChannels");
+        }
+        channels = block.channels;
+    }
+    if (channels > 1) {
+        if (data != m_mixBuffer.data()) {
+            m_mixBuffer.resize(frames);
+        }
+        aace::engine::utils::pcm::downmixToMono(data, m_mixBuffer.data(), frames, channels);
+        data = m_mixBuffer.data();
+    }
+    if (m_resampler != nullptr) {
+        if (reset) {
+            m_resampler->reset();
+        }
+        m_resampleBuffer.clear();
+        m_resampler->process(data, frames, m_resampleBuffer);
+        data = m_resampleBuffer.data();
+        frames = m_resampleBuffer.size();
+    }
+    size = frames;
+}
+
+void AudioInputEngineImpl::publishChannelsLocked() {
+    auto channels = std::make_shared<ChannelList>();
+    channels->reserve(m_channelMap.size());
+    for (auto& next : m_channelMap) {
+        channels->push_back(next.second);
+    }
+    std::atomic_store(&m_channels, std::shared_ptr<const ChannelList>(std::move(channels)));
+}
+
+void AudioInputEngineImpl::push(Channel& channel, const int16_t* data, size_t size, size_t frameSize) {
+    ReturnIf(size == 0);
+    auto bytes = size * sizeof(int16_t);
+    auto writeBytes = bytes;
+    if (frameSize > 1) {
+        // a frame that does not fit is dropped whole, so the buffer holds whole frames
+        auto frameBytes = frameSize * sizeof(int16_t);
+        auto space = channel.buffer->capacity() - channel.buffer->available();
+        writeBytes = std::min(bytes, space / frameBytes * frameBytes);
+    }
+    auto written = writeBytes > 0 ? channel.buffer->write(reinterpret_cast<const char*>(data), writeBytes) : 0;
+    if (written < 0 || static_cast<size_t>(written) < bytes) {
+        // the channel thread is not keeping up, so the audio that does not fit is dropped
+        auto dropped = (bytes - static_cast<size_t>(std::max<ssize_t>(written, 0))) / sizeof(int16_t);
+        if (!channel.overrun) {
+            AACE_WARN(LX(TAG, "push").d("reason", "bufferOverrun").d("channel", channel.id).d("name", m_name));
+            channel.overrun = true;
+        }
+        channel.droppedSamples += dropped;
+    } else if (channel.overrun) {
+        AACE_WARN(LX(TAG, "push")
+                      .m("bufferOverrunEnded")
+                      .d("channel", channel.id)
+                      .d("name", m_name)
+                      .d("droppedSamples", channel.droppedSamples));
+        channel.overrun = false;
+        channel.droppedSamples = 0;
+    }
+
+    // the channel thread sets waiting before it checks the buffer, so either it sees the audio or it is woken up
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (channel.waiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(channel.mutex);
+        channel.wakeUp.notify_one();
+    }
+}
+
+void AudioInputEngineImpl::convertAndPush(const int16_t* data, size_t size) {
+    convert(data, size);
+    auto channels = std::atomic_load(&m_channels);
+    for (auto& next : *channels) {
+        push(*next, data, size);
+    }
+}
+
+void AudioInputEngineImpl::drain(std::shared_ptr<Channel> channel, std::string threadName) {
+    aace::engine::utils::threading::ThreadPolicy::ScopedThread scopedThread(threadName);
+    auto& buffer = *channel->buffer;
+    while (!channel->stopped.load()) {
+        auto region = buffer.acquireReadRegion();
+        auto samples = region.size / sizeof(int16_t);
+        if (samples > 0) {
+            try {
+                channel->callback(reinterpret_cast<const int16_t*>(region.data), samples);
+            } catch (std::exception& ex) {
+                AACE_ERROR(LX(TAG, "drain").d("reason", ex.what()).d("channel", channel->id));
+            }
+            buffer.commitReadRegion(samples * sizeof(int16_t));
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(channel->mutex);
+        channel->waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        channel->wakeUp.wait(
+            lock, [&] { return channel->stopped.load() || buffer.available() >= sizeof(int16_t); });
+        channel->waiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+void AudioInputEngineImpl::stopChannel(Channel& channel) {
+    {
+        std::lock_guard<std::mutex> lock(channel.mutex);
+        channel.stopped = true;
+    }
+    channel.wakeUp.notify_one();
+
+    // a callback stopping its own channel returns to the thread, which exits
+    if (channel.thread.get_id() == std::this_thread::get_id()) {
+        channel.thread.detach();
+    } else {
+        channel.thread.join();
+    }
 }
 
 // AudioInputChannelEngineInterface
 ssize_t AudioInputEngineImpl::write(const int16_t* data, const size_t size) {
+    AACE_TRACE_SCOPE("audio", "AudioInput.write");
     try {
+        auto samples = data;
+        auto count = size;
+
+        // the audio written in standby is only kept for the pre-roll
+        if (m_inStandby.load()) {
+            std::lock_guard<std::mutex> callbackLock(m_callbackMutex);
+            if (m_inStandby.load()) {
+                writePreRollLocked(samples, count);
+                return size;
+            }
+        }
+
+        // copy the audio to the channel buffers, or the converter buffer, without waiting for the channels
+        if (m_fanOut == FanOut::BUFFERED) {
+            if (m_convert) {
+                // an incomplete frame at the end of the write is dropped
+                auto converter = std::atomic_load(&m_converter);
+                if (converter != nullptr) {
+                    push(*converter, samples, count - count % m_inputFormat.channels, m_inputFormat.channels);
+                }
+                return size;
+            }
+            auto channels = std::atomic_load(&m_channels);
+            for (auto& next : *channels) {
+                push(*next, samples, count);
+            }
+            return size;
+        }
+
         std::lock_guard<std::mutex> callbackLock(m_callbackMutex);
+        if (m_convert && !m_channelMap.empty()) {
+            convert(samples, count);
+            ReturnIf(count == 0, size);
+        }
 
         // execute the register callbacks
-        for (auto& next : m_callbackMap) {
-            next.second(data, size);
+        for (auto& next : m_channelMap) {
+            next.second->callback(samples, count);
         }
 
         // always return a successful write even if some of the callbacks failed to write all
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <AACE/Engine/Audio/AudioInputProcessors.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/PCM/PCMUtils.h>
+
+namespace aace {
+namespace engine {
+namespace audio {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.audio.AudioInputProcessors");
+
+namespace pcm = aace::engine::utils::pcm;
+
+constexpr float HighPassFilterProcessor::DEFAULT_CUTOFF;
+
+//
+// HighPassFilterProcessor
+//
+
+HighPassFilterProcessor::HighPassFilterProcessor(float coefficient) : m_coefficient(coefficient) {
+}
+
+std::shared_ptr<HighPassFilterProcessor> HighPassFilterProcessor::create(uint32_t sampleRate, float cutoff) {
+    try {
+        ThrowIf(sampleRate == 0, "invalidSampleRate");
+        ThrowIf(!(cutoff > 0.0f && cutoff < sampleRate / 2.0f), "invalidCutoff");
+        return std::shared_ptr<HighPassFilterProcessor>(
+            new HighPassFilterProcessor(pcm::highPassCoefficient(cutoff, sampleRate)));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()).d("cutoff", cutoff));
+        return nullptr;
+    }
+}
+
+void HighPassFilterProcessor::reset() {
+    std::fill(m_state.begin(), m_state.end(), 0.0f);
+}
+
+void HighPassFilterProcessor::process(AudioInputBlock& block) {
+    // a processor before this one may have changed the channels
+    if (m_state.size() != block.channels * 2) {
+        m_state.assign(block.channels * 2, 0.0f);
+    }
+    pcm::highPassFilter(block.samples, block.frames, block.channels, m_coefficient, m_state.data());
+}
+
+//
+// AutomaticGainControlProcessor
+//
+
+AutomaticGainControlProcessor::AutomaticGainControlProcessor(uint32_t sampleRate, const Config& config) :
+        m_sampleRate(sampleRate), m_config(config) {
+}
+
+std::shared_ptr<AutomaticGainControlProcessor> AutomaticGainControlProcessor::create(
+    uint32_t sampleRate,
+    const Config& config) {
+    try {
+        ThrowIf(sampleRate == 0, "invalidSampleRate");
+        ThrowIf(config.targetLevel > 0.0f, "invalidTargetLevel");
+        ThrowIf(config.maxGain < 0.0f, "invalidMaxGain");
+        ThrowIf(config.gainRate <= 0.0f, "invalidGainRate");
+        return std::shared_ptr<AutomaticGainControlProcessor>(new AutomaticGainControlProcessor(sampleRate, config));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+float AutomaticGainControlProcessor::getGain() const {
+    return m_gain;
+}
+
+void AutomaticGainControlProcessor::reset() {
+    m_gain = 0.0f;
+}
+
+void AutomaticGainControlProcessor::process(AudioInputBlock& block) {
+    auto count = block.frames * block.channels;
+    ReturnIf(count == 0);
+
+    auto level = pcm::levelDbfs(block.samples, count);
+    if (level > m_config.noiseGate) {
+        auto target = std::min(std::max(m_config.targetLevel - level, -m_config.maxGain), m_config.maxGain);
+        if (target < m_gain) {
+            m_gain = target;
+        } else {
+            auto increase = m_config.gainRate * block.frames / m_sampleRate;
+            m_gain = std::min(target, m_gain + increase);
+        }
+    }
+    if (m_gain != 0.0f) {
+        pcm::applyGain(block.samples, count, std::pow(10.0f, m_gain / 20.0f));
+    }
+}
+
+//
+// DownmixProcessor
+//
+
+std::shared_ptr<DownmixProcessor> DownmixProcessor::create() {
+    return std::shared_ptr<DownmixProcessor>(new DownmixProcessor());
+}
+
+void DownmixProcessor::process(AudioInputBlock& block) {
+    ReturnIf(block.channels <= 1);
+    pcm::downmixToMono(block.samples, block.samples, block.frames, block.channels);
+    block.channels = 1;
+}
+
+}  // namespace audio
+}  // namespace engine
+}  // namespace aace
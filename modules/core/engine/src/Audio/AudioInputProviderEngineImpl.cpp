@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+
 #include <AACE/Engine/Audio/AudioInputProviderEngineImpl.h>
 #include <AACE/Engine/Audio/AudioInputEngineImpl.h>
 #include <AACE/Engine/Core/EngineMacros.h>
@@ -34,22 +36,55 @@ namespace audio {
 using namespace aace::engine::utils::metrics;
 
 AudioInputProviderEngineImpl::AudioInputProviderEngineImpl(
-    std::shared_ptr<aace::audio::AudioInputProvider> platformAudioInputProviderInterface) :
-        m_platformAudioInputProviderInterface(platformAudioInputProviderInterface) {
+    std::shared_ptr<aace::audio::AudioInputProvider> platformAudioInputProviderInterface,
+    AudioInputEngineImpl::FanOut fanOut,
+    size_t bufferSize,
+    const AudioInputEngineImpl::InputFormat& inputFormat,
+    const std::vector<AudioInputProcessorFactory>& processorFactories,
+    std::shared_ptr<AudioReferenceTap> referenceTap,
+    const AudioInputEngineImpl::Standby& standby,
+    const std::vector<aace::audio::AudioInputProvider::AudioInputType>& standbyInputTypes) :
+        m_platformAudioInputProviderInterface(platformAudioInputProviderInterface),
+        m_fanOut(fanOut),
+        m_bufferSize(bufferSize),
+        m_inputFormat(inputFormat),
+        m_processorFactories(processorFactories),
+        m_referenceTap(referenceTap),
+        m_standby(standby),
+        m_standbyInputTypes(standbyInputTypes) {
 }
 
 std::shared_ptr<AudioInputProviderEngineImpl> AudioInputProviderEngineImpl::create(
-    std::shared_ptr<aace::audio::AudioInputProvider> platformAudioInputProviderInterface) {
+    std::shared_ptr<aace::audio::AudioInputProvider> platformAudioInputProviderInterface,
+    AudioInputEngineImpl::FanOut fanOut,
+    size_t bufferSize,
+    const AudioInputEngineImpl::InputFormat& inputFormat,
+    const std::vector<AudioInputProcessorFactory>& processorFactories,
+    std::shared_ptr<AudioReferenceTap> referenceTap,
+    const AudioInputEngineImpl::Standby& standby,
+    const std::vector<aace::audio::AudioInputProvider::AudioInputType>& standbyInputTypes) {
     try {
         ThrowIfNull(platformAudioInputProviderInterface, "invalidAudioInputProviderPlatformInterface");
-        return std::shared_ptr<AudioInputProviderEngineImpl>(
-            new AudioInputProviderEngineImpl(platformAudioInputProviderInterface));
+        return std::shared_ptr<AudioInputProviderEngineImpl>(new AudioInputProviderEngineImpl(
+            platformAudioInputProviderInterface,
+            fanOut,
+            bufferSize,
+            inputFormat,
+            processorFactories,
+            referenceTap,
+            standby,
+            standbyInputTypes));
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
         return nullptr;
     }
 }
 
+void AudioInputProviderEngineImpl::addProcessorFactory(AudioInputProcessorFactory factory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_processorFactories.push_back(std::move(factory));
+}
+
 std::shared_ptr<AudioInputChannelInterface> AudioInputProviderEngineImpl::openChannel(
     const std::string& name,
     aace::audio::AudioInputProvider::AudioInputType audioInputType) {
@@ -65,8 +100,28 @@ std::shared_ptr<AudioInputChannelInterface> AudioInputProviderEngineImpl::openCh
         auto it = m_audioInputMap.find(platformAudioInput);
         ReturnIf(it != m_audioInputMap.end(), it->second);
 
+        // each audio input has its own processors, which keep the state of its audio
+        std::vector<std::shared_ptr<AudioInputProcessor>> processors;
+        for (auto& next : m_processorFactories) {
+            auto processor = next(audioInputType, m_inputFormat.sampleRate, m_inputFormat.channels);
+            if (processor != nullptr) {
+                processors.push_back(processor);
+            }
+        }
+
         // create audio input channel engine impl
-        auto audioInputChannel = AudioInputEngineImpl::create(platformAudioInput);
+        auto audioInputChannel = AudioInputEngineImpl::create(
+            platformAudioInput,
+            name,
+            m_fanOut,
+            m_bufferSize,
+            m_inputFormat,
+            processors,
+            processors.empty() ? nullptr : m_referenceTap,
+            std::find(m_standbyInputTypes.begin(), m_standbyInputTypes.end(), audioInputType) !=
+                    m_standbyInputTypes.end()
+                ? m_standby
+                : AudioInputEngineImpl::Standby());
         ThrowIfNull(audioInputChannel, "invalidAudioInputChannel");
 
         // add the audio input channel to the map
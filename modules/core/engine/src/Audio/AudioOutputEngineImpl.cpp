@@ -46,17 +46,69 @@ namespace audio {
 
 using namespace aace::engine::utils::metrics;
 
-AudioOutputEngineImpl::AudioOutputEngineImpl(std::shared_ptr<aace::audio::AudioOutput> platformAudioOutput) :
-        m_platformAudioOutput(platformAudioOutput) {
+/// A stream writing the audio read by the platform to the reference tap.
+class ReferenceTapAudioStream : public aace::audio::AudioStream {
+public:
+    ReferenceTapAudioStream(
+        std::shared_ptr<aace::audio::AudioStream> stream,
+        std::shared_ptr<AudioReferenceTap::Source> source) :
+            m_stream(stream), m_source(source) {
+    }
+
+    ssize_t read(char* data, const size_t size) override {
+        return tap(data, m_stream->read(data, size));
+    }
+
+    ssize_t timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) override {
+        return tap(data, m_stream->timedRead(data, size, timeout));
+    }
+
+    bool isClosed() override {
+        return m_stream->isClosed();
+    }
+
+    Encoding getEncoding() override {
+        return m_stream->getEncoding();
+    }
+
+    AudioFormat getAudioFormat() override {
+        return m_stream->getAudioFormat();
+    }
+
+    MediaType getMediaType() override {
+        return m_stream->getMediaType();
+    }
+
+    std::vector<aace::audio::AudioStreamProperty> getProperties() override {
+        return m_stream->getProperties();
+    }
+
+private:
+    ssize_t tap(const char* data, ssize_t count) {
+        if (count > 0) {
+            m_source->write(data, static_cast<size_t>(count));
+        }
+        return count;
+    }
+
+    std::shared_ptr<aace::audio::AudioStream> m_stream;
+    std::shared_ptr<AudioReferenceTap::Source> m_source;
+};
+
+AudioOutputEngineImpl::AudioOutputEngineImpl(
+    std::shared_ptr<aace::audio::AudioOutput> platformAudioOutput,
+    std::shared_ptr<AudioReferenceTap> referenceTap) :
+        m_platformAudioOutput(platformAudioOutput), m_referenceTap(referenceTap) {
 }
 
 std::shared_ptr<AudioOutputEngineImpl> AudioOutputEngineImpl::create(
-    std::shared_ptr<aace::audio::AudioOutput> platformAudioOutput) {
+    std::shared_ptr<aace::audio::AudioOutput> platformAudioOutput,
+    std::shared_ptr<AudioReferenceTap> referenceTap) {
     try {
         ThrowIfNull(platformAudioOutput, "invalidAudioOutputPlatformInterface");
 
         auto audioOutputEngineImpl =
-            std::shared_ptr<AudioOutputEngineImpl>(new AudioOutputEngineImpl(platformAudioOutput));
+            std::shared_ptr<AudioOutputEngineImpl>(new AudioOutputEngineImpl(platformAudioOutput, referenceTap));
 
         // set the platform engine interface reference
         platformAudioOutput->setEngineInterface(audioOutputEngineImpl);
@@ -75,6 +127,18 @@ std::shared_ptr<AudioOutputEngineImpl> AudioOutputEngineImpl::create(
 bool AudioOutputEngineImpl::prepare(std::shared_ptr<aace::audio::AudioStream> stream, bool repeating) {
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "prepare", {METRIC_AUDIOOUTPUT_PREPARE_STREAM});
     try {
+        // the reference is the 16-bit PCM the platform reads, since the encoded streams are decoded by the platform
+        if (m_referenceTap != nullptr && stream != nullptr) {
+            auto format = stream->getAudioFormat();
+            if (format.getEncoding() == aace::audio::AudioFormat::Encoding::LPCM &&
+                format.getSampleFormat() == aace::audio::AudioFormat::SampleFormat::SIGNED &&
+                format.getSampleSize() == 16 && format.getEndianness() != aace::audio::AudioFormat::Endianness::BIG) {
+                auto source = m_referenceTap->createSource(format.getSampleRate(), format.getNumChannels());
+                if (source != nullptr) {
+                    stream = std::make_shared<ReferenceTapAudioStream>(stream, source);
+                }
+            }
+        }
         return m_platformAudioOutput->prepare(stream, repeating);
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -196,6 +260,14 @@ int64_t AudioOutputEngineImpl::getNumBytesBuffered() {
     }
 }
 
+void AudioOutputEngineImpl::setBufferingHint(int64_t prebufferDuration) {
+    try {
+        m_platformAudioOutput->setBufferingHint(prebufferDuration);
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    }
+}
+
 bool AudioOutputEngineImpl::volumeChanged(float volume) {
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "volumeChanged", {METRIC_AUDIOOUTPUT_VOLUME_CHANGED});
     try {
@@ -221,7 +293,19 @@ bool AudioOutputEngineImpl::mutedStateChanged(MutedState state) {
 
 void AudioOutputEngineImpl::setEngineInterface(
     std::shared_ptr<aace::audio::AudioOutputEngineInterface> audioOutputEngineInterface) {
-    m_platformAudioOutput->setEngineInterface(audioOutputEngineInterface);
+    // the platform keeps reporting to this channel, which forwards the events to the engine interface, so the
+    // playback state of the channel is known
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_engineInterface = audioOutputEngineInterface;
+}
+
+bool AudioOutputEngineImpl::isPlaying() {
+    return m_playing;
+}
+
+std::shared_ptr<aace::audio::AudioOutputEngineInterface> AudioOutputEngineImpl::getEngineInterface() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_engineInterface.lock();
 }
 
 //
@@ -229,6 +313,11 @@ void AudioOutputEngineImpl::setEngineInterface(
 //
 
 void AudioOutputEngineImpl::onMediaStateChanged(MediaState state) {
+    m_playing = state != MediaState::STOPPED;
+    if (auto engineInterface = getEngineInterface()) {
+        engineInterface->onMediaStateChanged(state);
+        return;
+    }
     std::stringstream mediaState;
     mediaState << state;
     emitCounterMetrics(
@@ -241,6 +330,12 @@ void AudioOutputEngineImpl::onMediaStateChanged(MediaState state) {
 }
 
 void AudioOutputEngineImpl::onMediaError(MediaError error, const std::string& description) {
+    // the playback stops on an error
+    m_playing = false;
+    if (auto engineInterface = getEngineInterface()) {
+        engineInterface->onMediaError(error, description);
+        return;
+    }
     std::stringstream mediaError;
     mediaError << error;
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "onMediaError", {METRIC_AUDIOOUTPUT_MEDIA_ERROR, mediaError.str()});
@@ -252,6 +347,10 @@ void AudioOutputEngineImpl::onMediaError(MediaError error, const std::string& de
 }
 
 void AudioOutputEngineImpl::onAudioFocusEvent(FocusAction action) {
+    if (auto engineInterface = getEngineInterface()) {
+        engineInterface->onAudioFocusEvent(action);
+        return;
+    }
     std::stringstream focusAction;
     focusAction << action;
     emitCounterMetrics(
@@ -263,6 +362,18 @@ void AudioOutputEngineImpl::onAudioFocusEvent(FocusAction action) {
     }
 }
 
+void AudioOutputEngineImpl::onMediaPositionChanged(int64_t position) {
+    if (auto engineInterface = getEngineInterface()) {
+        engineInterface->onMediaPositionChanged(position);
+        return;
+    }
+    try {
+        Throw("unhandledMethod");
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    }
+}
+
 }  // namespace audio
 }  // namespace engine
 }  // namespace aace
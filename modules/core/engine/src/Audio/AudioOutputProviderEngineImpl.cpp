@@ -36,16 +36,18 @@ namespace audio {
 using namespace aace::engine::utils::metrics;
 
 AudioOutputProviderEngineImpl::AudioOutputProviderEngineImpl(
-    std::shared_ptr<aace::audio::AudioOutputProvider> platformAudioOutputProviderInterface) :
-        m_platformAudioOutputProviderInterface(platformAudioOutputProviderInterface) {
+    std::shared_ptr<aace::audio::AudioOutputProvider> platformAudioOutputProviderInterface,
+    std::shared_ptr<AudioReferenceTap> referenceTap) :
+        m_platformAudioOutputProviderInterface(platformAudioOutputProviderInterface), m_referenceTap(referenceTap) {
 }
 
 std::shared_ptr<AudioOutputProviderEngineImpl> AudioOutputProviderEngineImpl::create(
-    std::shared_ptr<aace::audio::AudioOutputProvider> platformAudioOutputProviderInterface) {
+    std::shared_ptr<aace::audio::AudioOutputProvider> platformAudioOutputProviderInterface,
+    std::shared_ptr<AudioReferenceTap> referenceTap) {
     try {
         ThrowIfNull(platformAudioOutputProviderInterface, "invalidAudioOutputProviderPlatformInterface");
         return std::shared_ptr<AudioOutputProviderEngineImpl>(
-            new AudioOutputProviderEngineImpl(platformAudioOutputProviderInterface));
+            new AudioOutputProviderEngineImpl(platformAudioOutputProviderInterface, referenceTap));
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
         return nullptr;
@@ -56,6 +58,17 @@ std::shared_ptr<AudioOutputChannelInterface> AudioOutputProviderEngineImpl::open
     const std::string& name,
     aace::audio::AudioOutputProvider::AudioOutputType audioOutputType) {
     try {
+        // hand out the pre-warmed channel of the name and type
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_namedChannels.find(name);
+            if (it != m_namedChannels.end() && !it->second.claimed && it->second.type == audioOutputType) {
+                it->second.claimed = true;
+                AACE_DEBUG(LX(TAG, "openChannel").m("prewarmedChannelOpened").d("name", name));
+                return m_audioOutputMap[it->second.platformAudioOutput];
+            }
+        }
+
         std::stringstream type;
         type << audioOutputType;
         emitCounterMetrics(
@@ -65,9 +78,11 @@ std::shared_ptr<AudioOutputChannelInterface> AudioOutputProviderEngineImpl::open
         ThrowIfNull(platformAudioOutput, "invalidPlatformAudioOutput");
 
         // create audio input channel engine impl
-        auto audioOutputChannel = AudioOutputEngineImpl::create(platformAudioOutput);
+        auto audioOutputChannel = AudioOutputEngineImpl::create(platformAudioOutput, m_referenceTap);
         ThrowIfNull(audioOutputChannel, "invalidAudioOutputChannel");
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_audioOutputMap[platformAudioOutput] = audioOutputChannel;
+        m_namedChannels[name] = {audioOutputType, platformAudioOutput, true};
 
         return audioOutputChannel;
     } catch (std::exception& ex) {
@@ -76,14 +91,59 @@ std::shared_ptr<AudioOutputChannelInterface> AudioOutputProviderEngineImpl::open
     }
 }
 
+bool AudioOutputProviderEngineImpl::prewarmChannel(
+    const std::string& name,
+    aace::audio::AudioOutputProvider::AudioOutputType audioOutputType) {
+    try {
+        std::shared_ptr<aace::audio::AudioOutput> platformAudioOutput;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_namedChannels.find(name);
+            if (it != m_namedChannels.end() && it->second.type == audioOutputType) {
+                platformAudioOutput = it->second.platformAudioOutput;
+            }
+        }
+
+        // open the channel no component opened yet, which the first component opening it takes
+        if (platformAudioOutput == nullptr) {
+            platformAudioOutput = m_platformAudioOutputProviderInterface->openChannel(name, audioOutputType);
+            ThrowIfNull(platformAudioOutput, "invalidPlatformAudioOutput");
+            auto audioOutputChannel = AudioOutputEngineImpl::create(platformAudioOutput, m_referenceTap);
+            ThrowIfNull(audioOutputChannel, "invalidAudioOutputChannel");
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_audioOutputMap[platformAudioOutput] = audioOutputChannel;
+            m_namedChannels[name] = {audioOutputType, platformAudioOutput, false};
+        }
+
+        AACE_INFO(LX(TAG).d("name", name).d("type", audioOutputType));
+        platformAudioOutput->prewarm();
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("name", name).d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool AudioOutputProviderEngineImpl::doShutdown() {
+    std::lock_guard<std::mutex> lock(m_mutex);
     for (auto const& audioOutput : m_audioOutputMap) {
         audioOutput.first->setEngineInterface(nullptr);
     }
     m_audioOutputMap.clear();
+    m_namedChannels.clear();
     return true;
 }
 
+bool AudioOutputProviderEngineImpl::isPlaying() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto const& audioOutput : m_audioOutputMap) {
+        if (audioOutput.second->isPlaying()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 }  // namespace audio
 }  // namespace engine
 }  // namespace aace
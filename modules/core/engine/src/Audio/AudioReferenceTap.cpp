@@ -0,0 +1,148 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <AACE/Engine/Audio/AudioReferenceTap.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace audio {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.audio.AudioReferenceTap");
+
+namespace pcm = aace::engine::utils::pcm;
+
+constexpr std::chrono::milliseconds AudioReferenceTap::DEFAULT_DURATION;
+
+//
+// AudioReferenceTap::Source
+//
+
+AudioReferenceTap::Source::Source(std::shared_ptr<AudioReferenceTap> tap, uint32_t sampleRate, uint32_t channels) :
+        m_tap(tap), m_channels(channels) {
+    if (sampleRate != tap->getSampleRate()) {
+        m_resampler.reset(new pcm::Resampler(sampleRate, tap->getSampleRate()));
+    }
+}
+
+void AudioReferenceTap::Source::write(const char* data, size_t size, Clock::time_point now) {
+    // the samples are copied, since the bytes read from a stream are not aligned
+    auto frameSize = m_channels * sizeof(int16_t);
+    auto total = m_partial.size() + size;
+    auto frames = total / frameSize;
+    m_mixBuffer.resize(frames * m_channels);
+    auto samples = reinterpret_cast<char*>(m_mixBuffer.data());
+    auto remaining = total - frames * frameSize;
+    if (frames == 0) {
+        m_partial.insert(m_partial.end(), data, data + size);
+        return;
+    }
+    std::copy(m_partial.begin(), m_partial.end(), samples);
+    std::memcpy(samples + m_partial.size(), data, size - remaining);
+    m_partial.assign(data + size - remaining, data + size);
+
+    pcm::downmixToMono(m_mixBuffer.data(), m_mixBuffer.data(), frames, m_channels);
+    const int16_t* mono = m_mixBuffer.data();
+    if (m_resampler != nullptr) {
+        m_resampleBuffer.clear();
+        frames = m_resampler->process(mono, frames, m_resampleBuffer);
+        mono = m_resampleBuffer.data();
+    }
+    m_position = m_tap->mix(m_position, mono, frames, now);
+}
+
+//
+// AudioReferenceTap
+//
+
+AudioReferenceTap::AudioReferenceTap(uint32_t sampleRate, size_t size, Clock::time_point origin) :
+        m_sampleRate(sampleRate), m_origin(origin), m_timeline(size) {
+}
+
+std::shared_ptr<AudioReferenceTap> AudioReferenceTap::create(uint32_t sampleRate, std::chrono::milliseconds duration) {
+    try {
+        ThrowIf(sampleRate == 0, "invalidSampleRate");
+        ThrowIf(duration.count() <= 0, "invalidDuration");
+        auto size = static_cast<size_t>(static_cast<uint64_t>(sampleRate) * duration.count() / 1000);
+        ThrowIf(size < 2, "invalidDuration");
+        return std::shared_ptr<AudioReferenceTap>(new AudioReferenceTap(sampleRate, size, Clock::now()));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+std::shared_ptr<AudioReferenceTap::Source> AudioReferenceTap::createSource(uint32_t sampleRate, uint32_t channels) {
+    try {
+        ThrowIf(sampleRate == 0, "invalidSampleRate");
+        ThrowIf(channels == 0, "invalidChannels");
+        return std::shared_ptr<Source>(new Source(shared_from_this(), sampleRate, channels));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "createSource").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+uint32_t AudioReferenceTap::getSampleRate() const {
+    return m_sampleRate;
+}
+
+int64_t AudioReferenceTap::toPosition(Clock::time_point time) const {
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(time - m_origin).count();
+    return elapsed * m_sampleRate / 1000000;
+}
+
+int64_t AudioReferenceTap::mix(int64_t position, const int16_t* samples, size_t count, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto size = static_cast<int64_t>(m_timeline.size());
+    auto current = toPosition(now);
+
+    // a stream read too late starts again at the current time, and the samples too far ahead are dropped
+    auto start = std::max(position, current);
+    auto end = std::min(start + static_cast<int64_t>(count), current + size / 2);
+
+    // the time between the end of the timeline and the samples was silent
+    for (auto next = std::max(m_end, start - size); next < start; next++) {
+        m_timeline[next % size] = 0;
+    }
+    m_end = std::max(m_end, start);
+
+    for (auto next = start; next < end; next++) {
+        auto& sample = m_timeline[next % size];
+        int32_t mixed = samples[next - start] + (next < m_end ? sample : 0);
+        sample = static_cast<int16_t>(std::min<int32_t>(std::max<int32_t>(mixed, INT16_MIN), INT16_MAX));
+    }
+    m_end = std::max(m_end, end);
+    return start + static_cast<int64_t>(count);
+}
+
+void AudioReferenceTap::read(int16_t* output, size_t count, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto size = static_cast<int64_t>(m_timeline.size());
+    auto start = toPosition(now) - static_cast<int64_t>(count);
+    for (size_t j = 0; j < count; j++) {
+        auto position = start + static_cast<int64_t>(j);
+        bool written = position >= 0 && position < m_end && position >= m_end - size;
+        output[j] = written ? m_timeline[position % size] : 0;
+    }
+}
+
+}  // namespace audio
+}  // namespace engine
+}  // namespace aace
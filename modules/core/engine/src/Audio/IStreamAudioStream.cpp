@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <stdexcept>
+
 #include <AACE/Engine/Audio/IStreamAudioStream.h>
 #include <AACE/Engine/Core/EngineMacros.h>
 
@@ -23,6 +25,24 @@ namespace audio {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.audio.IStreamAudioStream");
 
+/// The longest wait of a read for the read ahead buffer
+static const std::chrono::milliseconds READ_AHEAD_TIMEOUT(100);
+
+/// Reads a stream, and returns the number of bytes read.
+static size_t readStream(std::istream& stream, char* data, size_t size) {
+    stream.read(data, size);
+    if (stream.bad()) {
+        throw std::runtime_error("readFailed");
+    }
+
+    // get the number of bytes read
+    auto count = static_cast<size_t>(stream.gcount());
+
+    stream.tellg();  // Don't remove otherwise the ReseourceStream used for Alerts/Timers won't work as expected.
+
+    return count;
+}
+
 IStreamAudioStream::IStreamAudioStream(
     std::shared_ptr<std::istream> stream,
     const aace::audio::AudioFormat& audioFormat) :
@@ -31,11 +51,33 @@ IStreamAudioStream::IStreamAudioStream(
 
 std::shared_ptr<IStreamAudioStream> IStreamAudioStream::create(
     std::shared_ptr<std::istream> stream,
-    const aace::audio::AudioFormat& audioFormat) {
-    return std::shared_ptr<IStreamAudioStream>(new IStreamAudioStream(stream, audioFormat));
+    const aace::audio::AudioFormat& audioFormat,
+    size_t readAheadSize) {
+    try {
+        ThrowIfNull(stream, "invalidStream");
+        auto audioStream = std::shared_ptr<IStreamAudioStream>(new IStreamAudioStream(stream, audioFormat));
+
+        if (readAheadSize > 0) {
+            audioStream->m_readAhead =
+                ReadAheadBuffer::create(readAheadSize, [stream](char* data, size_t size, bool& closed) {
+                    auto count = readStream(*stream, data, size);
+                    closed = !stream->good();
+                    return count;
+                });
+            ThrowIfNull(audioStream->m_readAhead, "createReadAheadBufferFailed");
+        }
+
+        return audioStream;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()).d("readAheadSize", readAheadSize));
+        return nullptr;
+    }
 }
 
 ssize_t IStreamAudioStream::read(char* data, const size_t size) {
+    if (m_readAhead != nullptr) {
+        return timedRead(data, size, READ_AHEAD_TIMEOUT);
+    }
     try {
         if (m_stream->eof()) {
             m_closed = true;
@@ -43,15 +85,7 @@ ssize_t IStreamAudioStream::read(char* data, const size_t size) {
         }
 
         // read the data from the stream
-        m_stream->read(data, size);
-        ThrowIf(m_stream->bad(), "readFailed");
-
-        // get the number of bytes read
-        ssize_t count = m_stream->gcount();
-
-        m_stream->tellg();  // Don't remove otherwise the ReseourceStream used for Alerts/Timers won't work as expected.
-
-        return count;
+        return static_cast<ssize_t>(readStream(*m_stream, data, size));
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG + ".IStreamAudioStream").d("reason", ex.what()).d("size", size));
         m_closed = true;
@@ -59,6 +93,19 @@ ssize_t IStreamAudioStream::read(char* data, const size_t size) {
     }
 }
 
+ssize_t IStreamAudioStream::timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) {
+    if (m_readAhead == nullptr) {
+        return aace::audio::AudioStream::timedRead(data, size, timeout);
+    }
+
+    // the buffer is filled by the filler thread, the read only waits for the buffer
+    auto count = m_readAhead->read(data, size, timeout);
+    if (m_readAhead->isClosed()) {
+        m_closed = true;
+    }
+    return count;
+}
+
 bool IStreamAudioStream::isClosed() {
     return m_closed;
 }
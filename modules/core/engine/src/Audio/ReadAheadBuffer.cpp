@@ -0,0 +1,143 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <AACE/Engine/Audio/ReadAheadBuffer.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace audio {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.audio.ReadAheadBuffer");
+
+/// The smallest read of the source, so a nearly full buffer isn't filled a few bytes at a time
+static const size_t MIN_CHUNK_SIZE = 256;
+
+std::unique_ptr<ReadAheadBuffer> ReadAheadBuffer::create(size_t capacity, Source source) {
+    try {
+        ThrowIf(capacity == 0, "invalidCapacity");
+        ThrowIfNot(source, "invalidSource");
+
+        std::unique_ptr<ReadAheadBuffer> buffer(new ReadAheadBuffer(capacity, std::move(source)));
+        auto raw = buffer.get();
+        ThrowIfNot(buffer->m_executor.post([raw]() { raw->fill(); }), "startFillerFailed");
+
+        return buffer;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()).d("capacity", capacity));
+        return nullptr;
+    }
+}
+
+ReadAheadBuffer::ReadAheadBuffer(size_t capacity, Source source) :
+        m_source(std::move(source)), m_buffer(capacity), m_executor("AudioOutput.readAhead") {
+}
+
+ReadAheadBuffer::~ReadAheadBuffer() {
+    close();
+}
+
+void ReadAheadBuffer::fill() {
+    auto capacity = m_buffer.size();
+    auto chunkSize = std::max(std::min(MIN_CHUNK_SIZE, capacity), capacity / 4);
+    while (true) {
+        size_t writePosition;
+        size_t count;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_spaceAvailable.wait(
+                lock, [this, capacity, chunkSize]() { return m_closed || capacity - m_size >= chunkSize; });
+            if (m_closed) {
+                return;
+            }
+            // the free space after the write position, which the reader doesn't access
+            writePosition = (m_readPosition + m_size) % capacity;
+            count = std::min(std::min(chunkSize, capacity - m_size), capacity - writePosition);
+        }
+
+        bool sourceClosed = false;
+        size_t read = 0;
+        try {
+            read = std::min(m_source(m_buffer.data() + writePosition, count, sourceClosed), count);
+        } catch (std::exception& ex) {
+            AACE_ERROR(LX(TAG, "fill").d("reason", ex.what()));
+            sourceClosed = true;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed) {
+            return;
+        }
+        m_size += read;
+        if (sourceClosed) {
+            m_drained = true;
+        }
+        m_dataAvailable.notify_all();
+        if (m_drained) {
+            return;
+        }
+    }
+}
+
+ssize_t ReadAheadBuffer::read(char* data, size_t size, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_dataAvailable.wait_for(lock, timeout, [this]() { return m_size > 0 || m_drained || m_closed; });
+    if (m_closed) {
+        return 0;
+    }
+
+    // the buffered data wraps around the end of the buffer at most once
+    auto capacity = m_buffer.size();
+    auto count = std::min(size, m_size);
+    auto first = std::min(count, capacity - m_readPosition);
+    std::memcpy(data, m_buffer.data() + m_readPosition, first);
+    std::memcpy(data + first, m_buffer.data(), count - first);
+    m_readPosition = (m_readPosition + count) % capacity;
+    m_size -= count;
+    if (count > 0) {
+        m_spaceAvailable.notify_one();
+    }
+
+    return static_cast<ssize_t>(count);
+}
+
+bool ReadAheadBuffer::isClosed() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_closed || (m_drained && m_size == 0);
+}
+
+void ReadAheadBuffer::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_size = 0;
+    }
+    m_spaceAvailable.notify_all();
+    m_dataAvailable.notify_all();
+    m_executor.shutdown();
+}
+
+size_t ReadAheadBuffer::size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+}  // namespace audio
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AACE/Engine/Audio/VoiceActivityGate.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/PCM/PCMUtils.h>
+
+namespace aace {
+namespace engine {
+namespace audio {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.audio.VoiceActivityGate");
+
+/// The duration of the blocks of audio the level is measured for
+static const std::chrono::milliseconds BLOCK_DURATION = std::chrono::milliseconds(10);
+
+constexpr float VoiceActivityGate::DEFAULT_THRESHOLD;
+constexpr std::chrono::milliseconds VoiceActivityGate::DEFAULT_PRE_ROLL;
+constexpr std::chrono::milliseconds VoiceActivityGate::DEFAULT_HANGOVER;
+
+static size_t toSamples(uint32_t sampleRate, std::chrono::milliseconds duration) {
+    return static_cast<size_t>(static_cast<uint64_t>(sampleRate) * duration.count() / 1000);
+}
+
+VoiceActivityGate::VoiceActivityGate(size_t blockSize, size_t preRollSize, size_t hangoverSize, float threshold) :
+        m_blockSize(blockSize), m_hangoverSize(hangoverSize), m_threshold(threshold), m_preRoll(preRollSize) {
+}
+
+std::unique_ptr<VoiceActivityGate> VoiceActivityGate::create(uint32_t sampleRate, const Config& config) {
+    try {
+        ThrowIf(sampleRate == 0, "invalidSampleRate");
+        ThrowIf(config.preRoll.count() < 0, "invalidPreRoll");
+        ThrowIf(config.hangover.count() < 0, "invalidHangover");
+
+        auto blockSize = toSamples(sampleRate, BLOCK_DURATION);
+        ThrowIf(blockSize == 0, "invalidSampleRate");
+
+        return std::unique_ptr<VoiceActivityGate>(new VoiceActivityGate(
+            blockSize,
+            toSamples(sampleRate, config.preRoll),
+            toSamples(sampleRate, config.hangover),
+            config.threshold));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+ssize_t VoiceActivityGate::process(const int16_t* data, size_t size, bool bypass, const Writer& writer) {
+    for (size_t offset = 0; offset < size; offset += m_blockSize) {
+        auto block = data + offset;
+        auto count = std::min(m_blockSize, size - offset);
+
+        if (bypass) {
+            // the audio held back before the bypass isn't part of the audio streamed during it
+            if (!m_open && !openGate(writer, false)) {
+                return -1;
+            }
+            m_silentSamples = 0;
+        } else if (aace::engine::utils::pcm::levelDbfs(block, count) > m_threshold) {
+            if (!m_open && !openGate(writer, true)) {
+                return -1;
+            }
+            m_silentSamples = 0;
+        } else if (m_open) {
+            m_silentSamples += count;
+            if (m_silentSamples > m_hangoverSize) {
+                AACE_VERBOSE(LX(TAG).m("closed"));
+                m_open = false;
+            }
+        }
+
+        if (m_open) {
+            if (writer(block, count) < 0) {
+                return -1;
+            }
+        } else {
+            addToPreRoll(block, count);
+        }
+    }
+
+    return static_cast<ssize_t>(size);
+}
+
+bool VoiceActivityGate::isOpen() const {
+    return m_open;
+}
+
+bool VoiceActivityGate::openGate(const Writer& writer, bool writePreRoll) {
+    AACE_VERBOSE(LX(TAG).m("opened").d("preRoll", writePreRoll ? m_preRollCount : 0));
+    m_open = true;
+
+    // the pre-roll is written from its oldest sample, in the two parts of the ring buffer
+    auto count = m_preRollCount;
+    auto start = m_preRollStart;
+    m_preRollCount = 0;
+    m_preRollStart = 0;
+    if (!writePreRoll || count == 0) {
+        return true;
+    }
+    auto first = std::min(count, m_preRoll.size() - start);
+    if (writer(m_preRoll.data() + start, first) < 0) {
+        return false;
+    }
+    if (count > first && writer(m_preRoll.data(), count - first) < 0) {
+        return false;
+    }
+    return true;
+}
+
+void VoiceActivityGate::addToPreRoll(const int16_t* data, size_t size) {
+    auto capacity = m_preRoll.size();
+    if (capacity == 0) {
+        return;
+    }
+
+    // only the last samples fit when there are more than the capacity
+    if (size > capacity) {
+        data += size - capacity;
+        size = capacity;
+    }
+    for (size_t j = 0; j < size; j++) {
+        m_preRoll[(m_preRollStart + m_preRollCount) % capacity] = data[j];
+        if (m_preRollCount < capacity) {
+            m_preRollCount++;
+        } else {
+            m_preRollStart = (m_preRollStart + 1) % capacity;
+        }
+    }
+}
+
+}  // namespace audio
+}  // namespace engine
+}  // namespace aace
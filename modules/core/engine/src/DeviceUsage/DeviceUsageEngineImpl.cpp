@@ -18,6 +18,9 @@
 
 #include "AACE/Engine/DeviceUsage/DeviceUsageEngineImpl.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <nlohmann/json.hpp>
 
 namespace aace {
@@ -30,19 +33,232 @@ using namespace aace::engine::utils::metrics;
 /// String to identify log entries originating from this file.
 static const std::string TAG("aace.deviceUsage.DeviceUsageEngineImpl");
 
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+namespace {
+
+/**
+ * Extracts the fields of a network data usage report from the events of the parser. Only the values of the top
+ * level fields and of the fields of @c bytesUsage are kept, a field that is repeated keeps its last value, and a field
+ * with a value of the wrong type is reset to missing.
+ */
+class NetworkDataUsageExtractor : public json::json_sax_t {
+public:
+    NetworkDataUsageExtractor(DeviceUsageEngineImpl::NetworkDataUsage& dataUsage) : m_dataUsage(dataUsage) {
+    }
+
+    bool null() override {
+        return setOther();
+    }
+
+    bool boolean(bool) override {
+        return setOther();
+    }
+
+    bool number_integer(number_integer_t value) override {
+        return setNumber(value);
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        return setNumber(static_cast<int64_t>(value));
+    }
+
+    bool number_float(number_float_t value, const string_t&) override {
+        return setNumber(static_cast<int64_t>(value));
+    }
+
+    bool string(string_t& value) override {
+        if (isTopLevel()) {
+            if (m_key == "networkInterfaceType") {
+                m_dataUsage.networkInterfaceType = std::move(value);
+                hasNetworkInterfaceType = true;
+                return true;
+            } else if (m_key == "dataPlanType") {
+                m_dataUsage.dataPlanType = std::move(value);
+                return true;
+            }
+        }
+        return setOther();
+    }
+
+    bool binary(binary_t&) override {
+        return setOther();
+    }
+
+    bool start_object(std::size_t) override {
+        if (m_depth == 0) {
+            m_topLevelObject = true;
+        } else if (isTopLevel() && m_key == "bytesUsage") {
+            m_inBytesUsage = true;
+            hasBytesUsage = true;
+            hasRxBytes = false;
+            hasTxBytes = false;
+            bytesUsageEmpty = true;
+        } else {
+            setOther();
+        }
+        m_depth++;
+        return true;
+    }
+
+    bool end_object() override {
+        m_depth--;
+        if (m_depth == 1) {
+            m_inBytesUsage = false;
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        setOther();
+        m_depth++;
+        return true;
+    }
+
+    bool end_array() override {
+        m_depth--;
+        return true;
+    }
+
+    bool key(string_t& value) override {
+        if (isTopLevel()) {
+            topLevelEmpty = false;
+        } else if (m_depth == 2 && m_inBytesUsage) {
+            bytesUsageEmpty = false;
+        }
+        m_key = std::move(value);
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        AACE_ERROR(LX(TAG, "parseError").d("reason", ex.what()));
+        return false;
+    }
+
+    bool topLevelEmpty = true;
+    bool hasStartTimeStamp = false;
+    bool hasEndTimeStamp = false;
+    bool hasNetworkInterfaceType = false;
+    bool hasBytesUsage = false;
+    bool bytesUsageEmpty = true;
+    bool hasRxBytes = false;
+    bool hasTxBytes = false;
+
+private:
+    /// Whether the value is a field of the top level object
+    bool isTopLevel() const {
+        return m_depth == 1 && m_topLevelObject;
+    }
+
+    /// Whether the value is a field of the @c bytesUsage object
+    bool isBytesUsage() const {
+        return m_depth == 2 && m_inBytesUsage;
+    }
+
+    bool setNumber(int64_t value) {
+        if (isTopLevel()) {
+            if (m_key == "startTimeStamp") {
+                m_dataUsage.startTimeStamp = value;
+                hasStartTimeStamp = true;
+                return true;
+            } else if (m_key == "endTimeStamp") {
+                m_dataUsage.endTimeStamp = value;
+                hasEndTimeStamp = true;
+                return true;
+            }
+        } else if (isBytesUsage()) {
+            if (m_key == "rxBytes") {
+                m_dataUsage.rxBytes = value;
+                hasRxBytes = true;
+            } else if (m_key == "txBytes") {
+                m_dataUsage.txBytes = value;
+                hasTxBytes = true;
+            }
+            return true;
+        }
+        return setOther();
+    }
+
+    /// Resets the field of a value that is not of the type of the field
+    bool setOther() {
+        if (isTopLevel()) {
+            if (m_key == "startTimeStamp") {
+                hasStartTimeStamp = false;
+            } else if (m_key == "endTimeStamp") {
+                hasEndTimeStamp = false;
+            } else if (m_key == "networkInterfaceType") {
+                hasNetworkInterfaceType = false;
+            } else if (m_key == "dataPlanType") {
+                m_dataUsage.dataPlanType.clear();
+            } else if (m_key == "bytesUsage") {
+                hasBytesUsage = false;
+            }
+        } else if (isBytesUsage()) {
+            if (m_key == "rxBytes") {
+                hasRxBytes = false;
+            } else if (m_key == "txBytes") {
+                hasTxBytes = false;
+            }
+        }
+        return true;
+    }
+
+    DeviceUsageEngineImpl::NetworkDataUsage& m_dataUsage;
+    std::string m_key;
+    int m_depth = 0;
+    bool m_topLevelObject = false;
+    bool m_inBytesUsage = false;
+};
+
+/// Clamps a byte count to the range of a counter datapoint
+int toCounter(int64_t value) {
+    return static_cast<int>(std::max<int64_t>(
+        std::min<int64_t>(value, std::numeric_limits<int>::max()), std::numeric_limits<int>::min()));
+}
+
+}  // namespace
+
 DeviceUsageEngineImpl::DeviceUsageEngineImpl(
-    std::shared_ptr<aace::deviceUsage::DeviceUsage> deviceUsagePlatformInterface) :
-        m_deviceUsagePlatformInterface{deviceUsagePlatformInterface} {
+    std::shared_ptr<aace::deviceUsage::DeviceUsage> deviceUsagePlatformInterface,
+    std::chrono::milliseconds aggregationPeriod) :
+        m_deviceUsagePlatformInterface{deviceUsagePlatformInterface},
+        m_aggregationPeriod{aggregationPeriod},
+        m_flushTimer{TimerWheel::INVALID_TIMER} {
+}
+
+DeviceUsageEngineImpl::~DeviceUsageEngineImpl() {
+    if (m_flushTimer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(m_flushTimer);
+    }
 }
 
 std::shared_ptr<DeviceUsageEngineImpl> DeviceUsageEngineImpl::create(
-    std::shared_ptr<aace::deviceUsage::DeviceUsage> deviceUsagePlatformInterface) {
-    AACE_INFO(LX(TAG));
+    std::shared_ptr<aace::deviceUsage::DeviceUsage> deviceUsagePlatformInterface,
+    std::chrono::milliseconds aggregationPeriod,
+    std::shared_ptr<TimerWheel> timerWheel) {
+    AACE_INFO(LX(TAG).d("aggregationPeriod", aggregationPeriod.count()));
     try {
         ThrowIfNull(deviceUsagePlatformInterface, "invalidPlatformInterface");
+        ThrowIf(aggregationPeriod.count() < 0, "invalidAggregationPeriod");
 
-        auto deviceUsageEngineImpl =
-            std::shared_ptr<DeviceUsageEngineImpl>(new DeviceUsageEngineImpl(deviceUsagePlatformInterface));
+        auto deviceUsageEngineImpl = std::shared_ptr<DeviceUsageEngineImpl>(
+            new DeviceUsageEngineImpl(deviceUsagePlatformInterface, aggregationPeriod));
+
+        // the aggregated usage is flushed periodically, whether or not the platform reports more usage
+        if (aggregationPeriod.count() > 0) {
+            if (timerWheel == nullptr) {
+                timerWheel = TimerWheel::getDefault();
+            }
+            ThrowIfNull(timerWheel, "invalidTimerWheel");
+            std::weak_ptr<DeviceUsageEngineImpl> wp = deviceUsageEngineImpl;
+            deviceUsageEngineImpl->m_timerWheel = timerWheel;
+            deviceUsageEngineImpl->m_flushTimer = timerWheel->submitPeriodic(aggregationPeriod, [wp]() {
+                if (auto deviceUsageEngineImpl = wp.lock()) {
+                    deviceUsageEngineImpl->flush();
+                }
+            });
+            ThrowIf(deviceUsageEngineImpl->m_flushTimer == TimerWheel::INVALID_TIMER, "submitFlushTimerFailed");
+        }
 
         // Set the platform engine interface reference.
         deviceUsagePlatformInterface->setEngineInterface(deviceUsageEngineImpl);
@@ -54,76 +270,103 @@ std::shared_ptr<DeviceUsageEngineImpl> DeviceUsageEngineImpl::create(
     }
 }
 
+void DeviceUsageEngineImpl::parseNetworkDataUsage(const std::string& usage, NetworkDataUsage& dataUsage) {
+    NetworkDataUsageExtractor extractor(dataUsage);
+    ThrowIfNot(json::sax_parse(usage, &extractor), "invalidJSON");
+
+    ThrowIf(extractor.topLevelEmpty, "emptyJSON");
+    ThrowIfNot(extractor.hasStartTimeStamp, "startTimeStampInvalid");
+    ThrowIfNot(extractor.hasEndTimeStamp, "endTimeStampInvalid");
+    ThrowIfNot(extractor.hasBytesUsage, "missingBytesUsage");
+    ThrowIf(extractor.bytesUsageEmpty, "emptyBytesUsage");
+    ThrowIfNot(extractor.hasRxBytes, "rxBytesInvalid");
+    ThrowIfNot(extractor.hasTxBytes, "txBytesInvalid");
+    ThrowIfNot(extractor.hasNetworkInterfaceType, "networkInterfaceTypeInvalid");
+}
+
 void DeviceUsageEngineImpl::onReportNetworkDataUsage(const std::string& usage) {
     AACE_INFO(LX(TAG));
     try {
-        json dataUsage = json::parse(usage);
-
-        ThrowIf(dataUsage.empty(), "emptyJSON");
-
-        ThrowIfNot(
-            (dataUsage.contains("startTimeStamp") && dataUsage["startTimeStamp"].is_number()), "startTimeStampInvalid");
-        ThrowIfNot(
-            (dataUsage.contains("endTimeStamp") && dataUsage["endTimeStamp"].is_number()), "endTimeStampInvalid");
-
-        long startTimeStamp = dataUsage["startTimeStamp"];
-        long endTimeStamp = dataUsage["endTimeStamp"];
-
-        ThrowIfNot(dataUsage.contains("bytesUsage"), "missingBytesUsage");
-
-        auto bytesUsage = dataUsage["bytesUsage"];
-        ThrowIf(bytesUsage.empty(), "emptyBytesUsage");
-
-        ThrowIfNot((bytesUsage.contains("rxBytes") && bytesUsage["rxBytes"].is_number()), "rxBytesInvalid");
-        ThrowIfNot((bytesUsage.contains("txBytes") && bytesUsage["txBytes"].is_number()), "txBytesInvalid");
-
-        long receivedBytes = bytesUsage["rxBytes"];
-        long transmittedBytes = bytesUsage["txBytes"];
-        long totalBytes = receivedBytes + transmittedBytes;
+        NetworkDataUsage dataUsage;
+        parseNetworkDataUsage(usage, dataUsage);
 
         AACE_DEBUG(LX(TAG)
                        .m("Bytes usage is : ")
-                       .d("rxBytes", receivedBytes)
-                       .d("txBytes", transmittedBytes)
-                       .d("totalBytes", totalBytes));
-
-        auto networkInterfaceType = dataUsage["networkInterfaceType"];
-        ThrowIf(networkInterfaceType.empty(), "emptynetworkInterfaceType");
+                       .d("rxBytes", dataUsage.rxBytes)
+                       .d("txBytes", dataUsage.txBytes)
+                       .d("totalBytes", dataUsage.rxBytes + dataUsage.txBytes));
 
-        if (receivedBytes == 0 && transmittedBytes == 0 && totalBytes == 0) {
+        if (dataUsage.rxBytes == 0 && dataUsage.txBytes == 0) {
             AACE_DEBUG(LX(TAG).m("Not recording device usage since consumption is zero"));
-        } else {
-            std::string dataPlanType = "";
-
-            if (dataUsage.contains("dataPlanType") && dataUsage["dataPlanType"].is_string() &&
-                !dataUsage["dataPlanType"].empty()) {
-                dataPlanType = dataUsage["dataPlanType"];
-            }
+            return;
+        }
 
-            if (dataPlanType.empty()) {
-                emitBufferedMetrics(
-                    "DeviceUsageEngineImpl",
-                    "onReportNetworkDataUsage",
-                    {{"rxBytes", receivedBytes}, {"txBytes", transmittedBytes}, {"totalBytes", totalBytes}},
-                    {{"networkInterfaceType", networkInterfaceType}},
-                    {{"startTimeStamp", startTimeStamp}, {"endTimeStamp", endTimeStamp}});
-            } else {
-                emitBufferedMetrics(
-                    "DeviceUsageEngineImpl",
-                    "onReportNetworkDataUsage",
-                    {{"rxBytes", receivedBytes}, {"txBytes", transmittedBytes}, {"totalBytes", totalBytes}},
-                    {{"networkInterfaceType", networkInterfaceType}, {"dataPlanType", dataPlanType}},
-                    {{"startTimeStamp", startTimeStamp}, {"endTimeStamp", endTimeStamp}});
-            }
+        if (m_aggregationPeriod.count() == 0) {
+            emitMetrics(dataUsage);
+            return;
         }
 
+        // the usage of a network interface and data plan is summed over the reports until the next flush
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto key = std::make_pair(dataUsage.networkInterfaceType, dataUsage.dataPlanType);
+        auto it = m_aggregatedUsage.find(key);
+        if (it == m_aggregatedUsage.end()) {
+            m_aggregatedUsage.emplace(std::move(key), std::move(dataUsage));
+        } else {
+            auto& aggregate = it->second;
+            aggregate.startTimeStamp = std::min(aggregate.startTimeStamp, dataUsage.startTimeStamp);
+            aggregate.endTimeStamp = std::max(aggregate.endTimeStamp, dataUsage.endTimeStamp);
+            aggregate.rxBytes += dataUsage.rxBytes;
+            aggregate.txBytes += dataUsage.txBytes;
+        }
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
     }
 }
 
+void DeviceUsageEngineImpl::flush() {
+    std::map<std::pair<std::string, std::string>, NetworkDataUsage> aggregatedUsage;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(aggregatedUsage, m_aggregatedUsage);
+    }
+    for (const auto& it : aggregatedUsage) {
+        emitMetrics(it.second);
+    }
+}
+
+void DeviceUsageEngineImpl::emitMetrics(const NetworkDataUsage& dataUsage) {
+    auto receivedBytes = toCounter(dataUsage.rxBytes);
+    auto transmittedBytes = toCounter(dataUsage.txBytes);
+    auto totalBytes = toCounter(dataUsage.rxBytes + dataUsage.txBytes);
+    auto startTimeStamp = static_cast<double>(dataUsage.startTimeStamp);
+    auto endTimeStamp = static_cast<double>(dataUsage.endTimeStamp);
+
+    if (dataUsage.dataPlanType.empty()) {
+        emitBufferedMetrics(
+            "DeviceUsageEngineImpl",
+            "onReportNetworkDataUsage",
+            {{"rxBytes", receivedBytes}, {"txBytes", transmittedBytes}, {"totalBytes", totalBytes}},
+            {{"networkInterfaceType", dataUsage.networkInterfaceType}},
+            {{"startTimeStamp", startTimeStamp}, {"endTimeStamp", endTimeStamp}});
+    } else {
+        emitBufferedMetrics(
+            "DeviceUsageEngineImpl",
+            "onReportNetworkDataUsage",
+            {{"rxBytes", receivedBytes}, {"txBytes", transmittedBytes}, {"totalBytes", totalBytes}},
+            {{"networkInterfaceType", dataUsage.networkInterfaceType}, {"dataPlanType", dataUsage.dataPlanType}},
+            {{"startTimeStamp", startTimeStamp}, {"endTimeStamp", endTimeStamp}});
+    }
+}
+
 void DeviceUsageEngineImpl::doShutdown() {
     AACE_INFO(LX(TAG));
+    if (m_flushTimer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(m_flushTimer);
+        m_flushTimer = TimerWheel::INVALID_TIMER;
+    }
+    // the usage aggregated since the last flush is not lost
+    flush();
     if (m_deviceUsagePlatformInterface != nullptr) {
         m_deviceUsagePlatformInterface->setEngineInterface(nullptr);
         m_deviceUsagePlatformInterface.reset();
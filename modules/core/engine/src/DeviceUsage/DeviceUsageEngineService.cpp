@@ -16,6 +16,7 @@
 #include <AACE/Engine/Core/EngineMacros.h>
 
 #include "AACE/Engine/DeviceUsage/DeviceUsageEngineService.h"
+#include "AACE/Engine/Utils/JSON/JSON.h"
 
 namespace aace {
 namespace engine {
@@ -27,6 +28,8 @@ static const std::string TAG("aace.deviceUsage.DeviceUsageEngineService");
 /// Register the service.
 REGISTER_SERVICE(DeviceUsageEngineService);
 
+namespace json = aace::engine::utils::json;
+
 DeviceUsageEngineService::DeviceUsageEngineService(const aace::engine::core::ServiceDescription& description) :
         aace::engine::core::EngineService{description} {
 }
@@ -40,6 +43,22 @@ bool DeviceUsageEngineService::initialize() {
     }
 }
 
+bool DeviceUsageEngineService::configureFromJson(const json::Value& root) {
+    try {
+        auto networkDataUsage = json::get(root, "/networkDataUsage", json::Type::object);
+        if (networkDataUsage != nullptr) {
+            auto period = json::get(
+                networkDataUsage, "/aggregationPeriodInMilliseconds", (int64_t)m_aggregationPeriod.count());
+            ThrowIf(period < 0, "invalidAggregationPeriodInMilliseconds");
+            m_aggregationPeriod = std::chrono::milliseconds(period);
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "configureFromJson").d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool DeviceUsageEngineService::shutdown() {
     AACE_INFO(LX(TAG));
     if (m_deviceUsageEngineImpl != nullptr) {
@@ -67,7 +86,7 @@ bool DeviceUsageEngineService::registerPlatformInterfaceType(
         ThrowIfNotNull(m_deviceUsageEngineImpl, "platformInterfaceAlreadyRegistered");
 
         m_deviceUsageEngineImpl =
-            aace::engine::deviceUsage::DeviceUsageEngineImpl::create(deviceUsagePlatformInterface);
+            aace::engine::deviceUsage::DeviceUsageEngineImpl::create(deviceUsagePlatformInterface, m_aggregationPeriod);
         ThrowIfNull(m_deviceUsageEngineImpl, "createDeviceUsageEngineImplFailed");
 
         return true;
@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <chrono>
 #include <unordered_map>
 #include <forward_list>
 #ifndef NO_SIGPIPE
@@ -25,6 +26,9 @@
 #include "AACE/Engine/Core/EngineVersion.h"
 #include "AACE/Engine/Core/CoreMetrics.h"
 #include "AACE/Engine/Utils/JSON/JSON.h"
+#include "AACE/Engine/Utils/Memory/MemoryPressure.h"
+#include "AACE/Engine/Utils/Trace/BootTrace.h"
+#include "AACE/Engine/Utils/Trace/EngineTrace.h"
 #include "AACE/Core/CoreProperties.h"
 
 // default Engine constructor
@@ -39,9 +43,15 @@ namespace core {
 // json namespace alias
 namespace json = aace::engine::utils::json;
 
+using BootTrace = aace::engine::utils::trace::BootTrace;
+using EngineTrace = aace::engine::utils::trace::EngineTrace;
+
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.core.EngineImpl");
 
+/// The number of threads configuring, setting up and starting the services in parallel, by default.
+static const size_t STARTUP_THREAD_COUNT = 4;
+
 std::shared_ptr<EngineImpl> EngineImpl::create() {
     try {
         auto engine = std::shared_ptr<EngineImpl>(new EngineImpl());
@@ -65,6 +75,14 @@ EngineImpl::~EngineImpl() {
 
 bool EngineImpl::initialize() {
     try {
+        // the boot trace records the engine startup until the engine is running, unless another engine of the
+        // process is recording it
+        if (BootTrace::isRecording() == false) {
+            BootTrace::start();
+            m_bootTraceOwner = true;
+        }
+        BootTrace::Scope traceScope("initialize", "engine");
+
         AACE_INFO(LX(TAG).d("engineVersion", aace::engine::core::version::getEngineVersion()));
 #ifndef NO_SIGPIPE
         AACE_VERBOSE(LX(TAG).d("signal", "SIGPIPE").d("value", "SIG_IGN"));
@@ -76,6 +94,7 @@ bool EngineImpl::initialize() {
 
         // iterate through registered engine services and call initialize() for each module
         for (auto next : m_orderedServiceList) {
+            BootTrace::Scope serviceTraceScope(next->getDescription().getType(), "initialize");
             ThrowIfNot(next->handleInitializeEngineEvent(shared_from_this()), "handleInitializeEngineEventFailed");
         }
 
@@ -104,7 +123,7 @@ bool EngineImpl::registerProperties() {
         ThrowIfNull(propertyManager, "nullPropertyManagerServiceInterface");
 
         propertyManager->registerProperty(aace::engine::propertyManager::PropertyDescription(
-            aace::core::property::VERSION, nullptr, std::bind(&EngineImpl::getProperty_version, this)));
+            aace::core::property::VERSION, nullptr, std::bind(&EngineImpl::getProperty_version, this), true));
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -119,27 +138,77 @@ bool EngineImpl::shutdown() {
             return true;
         }
 
+        // the stop and the shutdown of the services end at the deadline, if the shutdown time is bounded
+        auto deadline = std::chrono::steady_clock::time_point::max();
+        if (m_shutdownTimeout > std::chrono::milliseconds::zero()) {
+            deadline = std::chrono::steady_clock::now() + m_shutdownTimeout;
+
+            // the services cancel their network requests first, so no service waits for a response to shut down
+            for (auto next : m_orderedServiceList) {
+                if (next->handlePrepareShutdownEngineEvent() == false) {
+                    AACE_ERROR(LX(TAG)
+                                   .d("reason", "handlePrepareShutdownEngineEventFailed")
+                                   .d("service", next->getDescription().getType()));
+                }
+            }
+        }
+
         // engine must be stopped before shutdown, but continue with shutdown if failed...
-        if (stop() == false) {
+        if (stop(deadline) == false) {
             AACE_ERROR(LX(TAG).d("reason", "stopEngineFailed"));
         }
 
         AACE_DEBUG(LX(TAG).m("EngineShutdown"));
 
-        // iterate through registered engine services and call shutdown() for each module
-        for (auto next : m_orderedServiceList) {
-            AACE_DEBUG(LX(TAG).m(next->getDescription().getType()));
-
-            // if shutting down the service failed throw an error but continue with
-            // shutting down remaining services
-            if (next->handleShutdownEngineEvent() == false) {
+        if (m_shutdownScheduler != nullptr) {
+            // a service that failed to shut down doesn't prevent the other services from shutting down
+            bool completed = m_shutdownScheduler->run(
+                "shutdown", createShutdownHandler([](std::shared_ptr<EngineService> service) {
+                    if (service->handleShutdownEngineEvent() == false) {
+                        AACE_ERROR(LX(TAG)
+                                       .d("reason", "handleShutdownEngineEventFailed")
+                                       .d("service", service->getDescription().getType()));
+                    }
+                    return true;
+                }),
+                deadline);
+            if (completed == false) {
                 AACE_ERROR(LX(TAG)
-                               .d("reason", "handleShutdownEngineEventFailed")
-                               .d("service", next->getDescription().getType()));
+                               .d("reason", "shutdownDeadlineExceeded")
+                               .d("timeoutMs", m_shutdownTimeout.count())
+                               .d("services", m_shutdownScheduler->getTimedOut().size()));
+                abandonServices(m_shutdownScheduler->getTimedOut());
+            }
+        } else {
+            // iterate through registered engine services and call shutdown() for each module
+            for (auto next : m_orderedServiceList) {
+                AACE_DEBUG(LX(TAG).m(next->getDescription().getType()));
+
+                // if shutting down the service failed throw an error but continue with
+                // shutting down remaining services
+                if (next->handleShutdownEngineEvent() == false) {
+                    AACE_ERROR(LX(TAG)
+                                   .d("reason", "handleShutdownEngineEventFailed")
+                                   .d("service", next->getDescription().getType()));
+                }
+            }
+        }
+
+        // the trace covers the shutdown of the services
+        if (m_traceOwner && EngineTrace::isRecording()) {
+            EngineTrace::stop();
+            if (!m_traceFile.empty()) {
+                EngineTrace::exportTrace(m_traceFile);
             }
         }
+        m_traceOwner = false;
 
         // reset the engine state
+        m_serviceScheduler.reset();
+        m_shutdownScheduler.reset();
+        m_startPolicies.clear();
+        m_configuration.reset();
+        m_configurationSources.clear();
         m_orderedServiceList.clear();
         m_registeredServiceMap.clear();
         m_initialized = false;
@@ -176,32 +245,86 @@ bool EngineImpl::configure(std::vector<std::shared_ptr<aace::core::config::Engin
         ThrowIf(m_configured, "engineAlreadyConfigured");
         ThrowIf(configurationList.empty(), "invalidConfigurationList");
 
-        // create the merged configuration data
-        json::Value mergedConfiguration = {};
+        BootTrace::Scope traceScope("configure", "engine");
 
-        // iterate through configuration objects and get streams for sdk initialization and
-        // merge all configuration stream together before calling service config methods
-        for (auto nextStream : configurationList) {
-            ThrowIfNull(nextStream, "invalidConfigurationStream");
+        // the configuration is parsed and merged once, unless it is configured again with other objects
+        if (isConfigurationCached(configurationList) == false) {
+            auto mergedConfiguration = std::make_shared<json::Value>(json::Value::object());
 
-            // parse the next configuration stream
-            auto nextConfig = json::toJson(nextStream->getStream());
+            // iterate through configuration objects and get streams for sdk initialization and
+            // merge all configuration stream together before calling service config methods
+            for (auto nextStream : configurationList) {
+                ThrowIfNull(nextStream, "invalidConfigurationStream");
+                BootTrace::Scope streamTraceScope("mergeConfiguration", "engine");
 
-            // merge the document with the main configuration
-            ThrowIfNot(json::isType(nextConfig, json::Type::object), "invalidConfigurationStream");
-            ThrowIfNot(aace::engine::utils::json::merge(mergedConfiguration, nextConfig), "mergeConfigurationFailed");
+                // parse the next configuration stream
+                auto nextConfig = json::toJson(nextStream->getStream());
+
+                // merge the document with the main configuration
+                ThrowIfNot(json::isType(nextConfig, json::Type::object), "invalidConfigurationStream");
+                ThrowIfNot(json::merge(*mergedConfiguration, std::move(nextConfig)), "mergeConfigurationFailed");
+            }
+
+            m_configuration = mergedConfiguration;
+            m_configurationSources.assign(configurationList.begin(), configurationList.end());
         }
+        const json::Value& mergedConfiguration = *m_configuration;
+
+        // the services that don't depend on each other are configured, setup and started concurrently if enabled
+        auto threadingConfig = json::get(mergedConfiguration, "aace.threading", json::Type::object);
+        ThrowIfNot(
+            createServiceScheduler(
+                json::get(threadingConfig, "/parallelStartup", false),
+                json::get(threadingConfig, "/startupThreadCount", (uint64_t)STARTUP_THREAD_COUNT)),
+            "createServiceSchedulerFailed");
+
+        // the services that don't depend on each other are stopped and shut down concurrently if enabled
+        ThrowIfNot(
+            createShutdownScheduler(
+                json::get(threadingConfig, "/parallelShutdown", false),
+                json::get(threadingConfig, "/shutdownThreadCount", (uint64_t)STARTUP_THREAD_COUNT)),
+            "createShutdownSchedulerFailed");
+        m_shutdownTimeout =
+            std::chrono::milliseconds(json::get(threadingConfig, "/shutdownTimeoutInMilliseconds", (uint64_t)0));
+
+        // the services that are not needed to get the engine ready are started once it is running
+        std::unordered_map<std::string, StartPolicy> startPolicies;
+        auto startPolicyConfig = json::get(threadingConfig, "/serviceStartPolicies", json::Type::object);
+        if (startPolicyConfig != nullptr) {
+            for (auto& next : startPolicyConfig.items()) {
+                auto value = next.value().is_string() ? next.value().get<std::string>() : "";
+                if (value == "eager") {
+                    startPolicies[next.key()] = StartPolicy::EAGER;
+                } else if (value == "deferred") {
+                    startPolicies[next.key()] = StartPolicy::DEFERRED;
+                } else if (value == "onFirstUse") {
+                    startPolicies[next.key()] = StartPolicy::ON_FIRST_USE;
+                } else {
+                    Throw("invalidStartPolicy:" + next.key());
+                }
+            }
+        }
+        ThrowIfNot(resolveStartPolicies(startPolicies), "resolveStartPoliciesFailed");
+
+        // the boot trace is written once the engine is running, and the deferred services have started
+        m_bootTraceFile = json::get(threadingConfig, "/bootTraceFile", "");
+
+        // the engine trace records the trace points until the engine shuts down
+        ThrowIfNot(configureTrace(json::get(threadingConfig, "/trace", json::Type::object)), "configureTraceFailed");
 
         // iterate through registered engine services and call configure() for each module
         if (mergedConfiguration.is_null() == false) {
-            for (auto nextService : m_orderedServiceList) {
-                auto serviceConfig =
-                    json::get(mergedConfiguration, nextService->getDescription().getType(), json::Type::object);
-                ThrowIfNot(
-                    nextService->handleConfigureEngineEvent(
-                        serviceConfig != nullptr ? json::toStream(serviceConfig) : nullptr),
-                    "Service failed to configure: " + nextService->getDescription().getType());
-            }
+            ThrowIfNot(
+                m_serviceScheduler->run(
+                    "configure",
+                    [this, &mergedConfiguration](size_t index) {
+                        // each service gets a view of its object of the configuration, which is not copied
+                        auto nextService = m_orderedServiceList[index];
+                        auto it = mergedConfiguration.find(nextService->getDescription().getType());
+                        return nextService->handleConfigureEngineEvent(
+                            it != mergedConfiguration.end() && it->is_object() ? &(*it) : nullptr);
+                    }),
+                "handleConfigureEngineEventFailed");
         } else {
             AACE_ERROR(LX(TAG).m("nullMergedConfiguration"));
         }
@@ -210,6 +333,7 @@ bool EngineImpl::configure(std::vector<std::shared_ptr<aace::core::config::Engin
 
         // iterate through registered engine modules and call handlePreRegisterEngineEvent() for each module
         for (auto next : m_orderedServiceList) {
+            BootTrace::Scope serviceTraceScope(next->getDescription().getType(), "preRegister");
             ThrowIfNot(next->handlePreRegisterEngineEvent(), "handlePreRegisterEngineEvent");
         }
 
@@ -220,6 +344,19 @@ bool EngineImpl::configure(std::vector<std::shared_ptr<aace::core::config::Engin
     }
 }
 
+bool EngineImpl::isConfigurationCached(
+    const std::vector<std::shared_ptr<aace::core::config::EngineConfiguration>>& configurationList) {
+    if (m_configuration == nullptr || m_configurationSources.size() != configurationList.size()) {
+        return false;
+    }
+    for (size_t j = 0; j < configurationList.size(); j++) {
+        if (configurationList[j] == nullptr || m_configurationSources[j].lock() != configurationList[j]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool EngineImpl::checkServices() {
     try {
         std::unordered_map<std::string, std::shared_ptr<ServiceFactory>> registeredServiceFactoryMap;
@@ -327,10 +464,240 @@ bool EngineImpl::checkServices() {
     }
 }
 
+bool EngineImpl::createServiceScheduler(bool parallel, size_t threadCount) {
+    try {
+        std::unordered_map<std::string, size_t> serviceIndexMap;
+        std::vector<EngineServiceScheduler::Service> services;
+
+        // the service list is ordered so each service is after the services it depends on
+        for (auto next : m_orderedServiceList) {
+            auto& desc = next->getDescription();
+            EngineServiceScheduler::Service service{desc.getType(), {}};
+            for (auto& dependency : desc.getDependencies()) {
+                auto it = serviceIndexMap.find(dependency.getType());
+                ThrowIf(it == serviceIndexMap.end(), "unresolvedDependency:" + dependency.getType());
+                service.dependencies.push_back(it->second);
+            }
+            serviceIndexMap[desc.getType()] = services.size();
+            services.push_back(service);
+        }
+
+        ThrowIf(parallel && threadCount == 0, "invalidStartupThreadCount");
+        m_serviceScheduler = EngineServiceScheduler::create(services, parallel ? threadCount : 0);
+        ThrowIfNull(m_serviceScheduler, "createServiceSchedulerFailed");
+        AACE_INFO(LX(TAG).d("parallelStartup", parallel).d("startupThreadCount", threadCount));
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool EngineImpl::createShutdownScheduler(bool parallel, size_t threadCount) {
+    try {
+        std::unordered_map<std::string, size_t> serviceIndexMap;
+        std::vector<EngineServiceScheduler::Service> services;
+
+        for (auto next : m_orderedServiceList) {
+            auto& desc = next->getDescription();
+            EngineServiceScheduler::Service service{desc.getType(), {}};
+            for (auto& dependency : desc.getDependencies()) {
+                auto it = serviceIndexMap.find(dependency.getType());
+                ThrowIf(it == serviceIndexMap.end(), "unresolvedDependency:" + dependency.getType());
+                service.dependencies.push_back(it->second);
+            }
+            serviceIndexMap[desc.getType()] = services.size();
+            services.push_back(service);
+        }
+
+        // in parallel a service shuts down once the services depending on it have shut down, so the schedule is the
+        // reversed list, where each service depends on its dependents
+        if (parallel) {
+            ThrowIf(threadCount == 0, "invalidShutdownThreadCount");
+            auto count = services.size();
+            std::vector<EngineServiceScheduler::Service> reversed(count);
+            for (size_t j = 0; j < count; j++) {
+                reversed[count - 1 - j].type = services[j].type;
+                for (auto dependency : services[j].dependencies) {
+                    reversed[count - 1 - dependency].dependencies.push_back(count - 1 - j);
+                }
+            }
+            services = std::move(reversed);
+        }
+
+        m_shutdownScheduler = EngineServiceScheduler::create(services, parallel ? threadCount : 0);
+        ThrowIfNull(m_shutdownScheduler, "createShutdownSchedulerFailed");
+        m_reversedShutdown = parallel;
+        AACE_INFO(LX(TAG).d("parallelShutdown", parallel).d("shutdownThreadCount", threadCount));
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+EngineServiceScheduler::Handler EngineImpl::createShutdownHandler(
+    std::function<bool(std::shared_ptr<EngineService>)> handler) {
+    // the handler keeps its own list of the services, since it may still run after the deadline, in the background
+    auto services = m_orderedServiceList;
+    bool reversed = m_reversedShutdown;
+    return [services, reversed, handler](size_t index) {
+        return handler(services[reversed ? services.size() - 1 - index : index]);
+    };
+}
+
+void EngineImpl::abandonServices(const std::vector<std::string>& types) {
+    // the services that didn't shut down by the deadline are never released, since destroying a service that is
+    // still running, or was not shut down, could block or abort the process that is about to exit
+    static auto* s_abandonedServices = new std::vector<std::shared_ptr<EngineService>>();
+    static std::mutex s_abandonedServicesMutex;
+    std::lock_guard<std::mutex> lock(s_abandonedServicesMutex);
+    for (auto& type : types) {
+        auto it = m_registeredServiceMap.find(type);
+        if (it != m_registeredServiceMap.end()) {
+            AACE_WARN(LX(TAG).d("reason", "serviceAbandoned").d("service", type));
+            s_abandonedServices->push_back(it->second);
+        }
+    }
+}
+
+bool EngineImpl::resolveStartPolicies(std::unordered_map<std::string, StartPolicy> policies) {
+    try {
+        for (auto& next : policies) {
+            ThrowIf(
+                m_registeredServiceMap.find(next.first) == m_registeredServiceMap.end(),
+                "invalidService:" + next.first);
+        }
+
+        // a service is started no later than the services depending on it, so the policies are propagated from the
+        // end of the ordered service list to the dependencies
+        for (auto it = m_orderedServiceList.rbegin(); it != m_orderedServiceList.rend(); it++) {
+            auto& desc = (*it)->getDescription();
+            auto policy = policies.count(desc.getType()) > 0 ? policies[desc.getType()] : StartPolicy::EAGER;
+            for (auto& dependency : desc.getDependencies()) {
+                auto dependencyPolicy = policies.find(dependency.getType());
+                if (dependencyPolicy != policies.end() && dependencyPolicy->second > policy) {
+                    AACE_INFO(LX(TAG)
+                                  .m("Starting service earlier for its dependent service")
+                                  .d("service", dependency.getType())
+                                  .d("dependent", desc.getType()));
+                    dependencyPolicy->second = policy;
+                }
+            }
+        }
+
+        m_startPolicies.clear();
+        for (auto& next : policies) {
+            if (next.second != StartPolicy::EAGER) {
+                AACE_INFO(LX(TAG)
+                              .d("service", next.first)
+                              .d("startPolicy", next.second == StartPolicy::DEFERRED ? "deferred" : "onFirstUse"));
+                m_startPolicies[next.first] = next.second;
+            }
+        }
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+EngineImpl::StartPolicy EngineImpl::getStartPolicy(const std::string& type) {
+    auto it = m_startPolicies.find(type);
+    return it != m_startPolicies.end() ? it->second : StartPolicy::EAGER;
+}
+
+bool EngineImpl::startService(std::shared_ptr<EngineService> service) {
+    try {
+        ReturnIf(m_stoppingServices, true);
+        std::lock_guard<std::recursive_mutex> lock(m_serviceStartMutex);
+        ReturnIf(m_running == false || m_stoppingServices || service->isRunning(), true);
+
+        // the dependencies that are not running yet are started first
+        auto& desc = service->getDescription();
+        for (auto& dependency : desc.getDependencies()) {
+            auto it = m_registeredServiceMap.find(dependency.getType());
+            ThrowIf(it == m_registeredServiceMap.end(), "unresolvedDependency:" + dependency.getType());
+            ThrowIfNot(startService(it->second), "startDependencyFailed:" + dependency.getType());
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        BootTrace::Scope traceScope(desc.getType(), "deferredStart");
+        ThrowIfNot(service->handleStartEngineEvent(), "handleStartEngineEventFailed");
+        ThrowIfNot(service->handleEngineStartedEngineEvent(), "handleEngineStartedEngineEventFailed");
+
+        // a service started while the engine is suspended is suspended with the other services
+        if (m_suspended) {
+            ThrowIfNot(service->handleSuspendEngineEvent(), "handleSuspendEngineEventFailed");
+        }
+        AACE_INFO(LX(TAG)
+                      .m("Service started")
+                      .d("service", desc.getType())
+                      .d("durationUs",
+                         std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+                             .count()));
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("service", service->getDescription().getType()));
+        return false;
+    }
+}
+
+void EngineImpl::startDeferredServices() {
+    for (auto next : m_orderedServiceList) {
+        if (m_stoppingServices) {
+            break;
+        }
+        if (getStartPolicy(next->getDescription().getType()) == StartPolicy::DEFERRED && startService(next) == false) {
+            AACE_ERROR(
+                LX(TAG).d("reason", "startDeferredServiceFailed").d("service", next->getDescription().getType()));
+        }
+    }
+
+    finishBootTrace();
+}
+
+bool EngineImpl::configureTrace(const json::Value& traceConfig) {
+    try {
+        if (traceConfig.empty() || EngineTrace::isRecording()) {
+            return true;
+        }
+#ifndef AAC_TRACE_ENABLED
+        AACE_WARN(LX(TAG).m("tracePointsNotEnabled"));
+#endif
+        auto eventsPerThread =
+            json::get(traceConfig, "/eventsPerThread", static_cast<uint64_t>(EngineTrace::DEFAULT_EVENTS_PER_THREAD));
+        auto output = json::get(traceConfig, "/ftrace", false) ? EngineTrace::Output::FTRACE
+                                                                : EngineTrace::Output::BUFFER;
+        ThrowIfNot(EngineTrace::start(static_cast<size_t>(eventsPerThread), output), "startTraceFailed");
+        m_traceOwner = true;
+        m_traceFile = output == EngineTrace::Output::BUFFER ? json::get(traceConfig, "/file", "") : "";
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+void EngineImpl::finishBootTrace() {
+    if (m_bootTraceOwner && BootTrace::isRecording()) {
+        m_bootTraceOwner = false;
+        BootTrace::stop();
+        if (!m_bootTraceFile.empty()) {
+            BootTrace::exportTrace(m_bootTraceFile);
+        }
+    }
+}
+
 bool EngineImpl::start() {
     try {
         AACE_DEBUG(LX(TAG).m("EngineStart"));
         CORE_METRIC(LX(TAG), aace::engine::core::CoreMetrics::Location::ENGINE_START_BEGIN);
+        auto traceStart = BootTrace::Clock::now();
 
         ThrowIf(m_running, "engineAlreadyRunning");
         ThrowIfNot(m_initialized, "engineNotInitialized");
@@ -340,41 +707,75 @@ bool EngineImpl::start() {
         if (m_setup == false) {
             // iterate through registered engine modules and call handlePostRegisterEngineEvent() for each module
             for (auto next : m_orderedServiceList) {
+                BootTrace::Scope serviceTraceScope(next->getDescription().getType(), "postRegister");
                 ThrowIfNot(next->handlePostRegisterEngineEvent(), "handlePostRegisterEngineEvent");
             }
 
             // iterate through registered engine modules and call handleSetupEngineEvent() for each module
-            for (auto next : m_orderedServiceList) {
-                ThrowIfNot(next->handleSetupEngineEvent(), "handleSetupEngineEventFailed");
-            }
+            ThrowIfNot(
+                m_serviceScheduler->run(
+                    "setup", [this](size_t index) { return m_orderedServiceList[index]->handleSetupEngineEvent(); }),
+                "handleSetupEngineEventFailed");
 
             // set the engine setup flag to true
             m_setup = true;
         }
 
         // iterate through registered engine modules and call handleStartEngineEvent() for each module
-        for (auto next : m_orderedServiceList) {
-            ThrowIfNot(next->handleStartEngineEvent(), "handleStartEngineEventFailed");
-        }
+        // the services that are not started eagerly are started once the engine is running
+        ThrowIfNot(
+            m_serviceScheduler->run(
+                "start",
+                [this](size_t index) {
+                    auto next = m_orderedServiceList[index];
+                    return getStartPolicy(next->getDescription().getType()) != StartPolicy::EAGER ||
+                           next->handleStartEngineEvent();
+                }),
+            "handleStartEngineEventFailed");
 
         // iterate through registered engine services and call handleEngineStartedEngineEvent() for each service
         for (auto next : m_orderedServiceList) {
-            ThrowIfNot(next->handleEngineStartedEngineEvent(), "handleEngineStartedEngineEventFailed");
+            if (next->isRunning()) {
+                BootTrace::Scope serviceTraceScope(next->getDescription().getType(), "engineStarted");
+                ThrowIfNot(next->handleEngineStartedEngineEvent(), "handleEngineStartedEngineEventFailed");
+            }
         }
 
         // set the engine running flag to true
-        m_running = true;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_serviceStartMutex);
+            m_stoppingServices = false;
+            m_running = true;
+        }
+
+        BootTrace::record("start", "engine", traceStart, BootTrace::Clock::now());
+
+        // start the deferred services in the background
+        for (auto& next : m_startPolicies) {
+            if (next.second == StartPolicy::DEFERRED) {
+                m_deferredStartThread = std::thread(&EngineImpl::startDeferredServices, this);
+                break;
+            }
+        }
+        if (m_deferredStartThread.joinable() == false) {
+            finishBootTrace();
+        }
 
         CORE_METRIC(LX(TAG), aace::engine::core::CoreMetrics::Location::ENGINE_START_END);
         return true;
     } catch (std::exception& ex) {
         CORE_METRIC(LX(TAG), aace::engine::core::CoreMetrics::Location::ENGINE_START_EXCEPTION);
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        finishBootTrace();
         return false;
     }
 }
 
 bool EngineImpl::stop() {
+    return stop(std::chrono::steady_clock::time_point::max());
+}
+
+bool EngineImpl::stop(std::chrono::steady_clock::time_point deadline) {
     try {
         AACE_DEBUG(LX(TAG).m("EngineStop"));
         CORE_METRIC(LX(TAG), aace::engine::core::CoreMetrics::Location::ENGINE_STOP_BEGIN);
@@ -384,19 +785,40 @@ bool EngineImpl::stop() {
             return true;
         }
 
-        // iterate through registered engine modules and call stop() for each module
+        // no service is started once the services that are starting have started
+        m_stoppingServices = true;
+        if (m_deferredStartThread.joinable()) {
+            m_deferredStartThread.join();
+        }
+        std::unique_lock<std::recursive_mutex> lock(m_serviceStartMutex);
+        m_running = false;
+        m_suspended = false;
+        lock.unlock();
+
+        // only the services that were started are stopped
+        std::vector<std::shared_ptr<EngineService>> startedServiceList;
         for (auto next : m_orderedServiceList) {
-            ThrowIfNot(next->handleStopEngineEvent(), "handleStopEngineEventFailed");
+            if (next->isRunning()) {
+                startedServiceList.push_back(next);
+            }
         }
 
+        // stop each started service, in parallel with the services that don't depend on it if enabled
+        ThrowIfNull(m_shutdownScheduler, "invalidShutdownScheduler");
+        ThrowIfNot(
+            m_shutdownScheduler->run(
+                "stop",
+                createShutdownHandler([](std::shared_ptr<EngineService> service) {
+                    return service->isRunning() == false || service->handleStopEngineEvent();
+                }),
+                deadline),
+            "handleStopEngineEventFailed");
+
         // iterate through registered engine services and call engineStopped() for each service
-        for (auto next : m_orderedServiceList) {
+        for (auto next : startedServiceList) {
             ThrowIfNot(next->handleEngineStoppedEngineEvent(), "handleEngineStoppedEngineEventFailed");
         }
 
-        // set the engine running and configured flag to false - the engine must be reconfigured before starting again
-        m_running = false;
-
         CORE_METRIC(LX(TAG), aace::engine::core::CoreMetrics::Location::ENGINE_STOP_END);
         return true;
     } catch (std::exception& ex) {
@@ -406,9 +828,113 @@ bool EngineImpl::stop() {
     }
 }
 
+bool EngineImpl::suspend() {
+    try {
+        AACE_DEBUG(LX(TAG).m("EngineSuspend"));
+
+        // no service is started while the services are suspending
+        std::lock_guard<std::recursive_mutex> lock(m_serviceStartMutex);
+        ThrowIfNot(m_running, "engineNotRunning");
+
+        if (m_suspended) {
+            AACE_WARN(LX(TAG).m("Attempting to suspend engine that is suspended - doing nothing."));
+            return true;
+        }
+
+        // the engine is suspended even if a service failed to suspend, so resume() resumes the suspended services
+        m_suspended = true;
+
+        // suspend each started service before the services it depends on, the services keep their state
+        auto start = std::chrono::steady_clock::now();
+        for (auto it = m_orderedServiceList.rbegin(); it != m_orderedServiceList.rend(); it++) {
+            ThrowIfNot((*it)->handleSuspendEngineEvent(), "handleSuspendEngineEventFailed");
+        }
+        AACE_INFO(LX(TAG)
+                      .m("Engine suspended")
+                      .d("durationUs",
+                         std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+                             .count()));
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool EngineImpl::resume() {
+    try {
+        AACE_DEBUG(LX(TAG).m("EngineResume"));
+
+        std::lock_guard<std::recursive_mutex> lock(m_serviceStartMutex);
+        ThrowIfNot(m_running, "engineNotRunning");
+
+        if (m_suspended == false) {
+            AACE_WARN(LX(TAG).m("Attempting to resume engine that is not suspended - doing nothing."));
+            return true;
+        }
+
+        // resume each suspended service after the services it depends on; the engine stays suspended if a service
+        // failed to resume, so resume() can be called again
+        auto start = std::chrono::steady_clock::now();
+        for (auto next : m_orderedServiceList) {
+            ThrowIfNot(next->handleResumeEngineEvent(), "handleResumeEngineEventFailed");
+        }
+        m_suspended = false;
+        AACE_INFO(LX(TAG)
+                      .m("Engine resumed")
+                      .d("durationUs",
+                         std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+                             .count()));
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool EngineImpl::reportMemoryPressure(MemoryPressureLevel level) {
+    try {
+        using aace::engine::utils::memory::MemoryPressure;
+        using aace::engine::utils::memory::MemoryPressureLevel;
+
+        // the level is shared by the engines of the process, like the caches and buffers it trims
+        switch (level) {
+            case Engine::MemoryPressureLevel::NORMAL:
+                MemoryPressure::report(MemoryPressureLevel::NORMAL);
+                break;
+            case Engine::MemoryPressureLevel::MODERATE:
+                MemoryPressure::report(MemoryPressureLevel::MODERATE);
+                break;
+            case Engine::MemoryPressureLevel::LOW:
+                MemoryPressure::report(MemoryPressureLevel::LOW);
+                break;
+            case Engine::MemoryPressureLevel::CRITICAL:
+                MemoryPressure::report(MemoryPressureLevel::CRITICAL);
+                break;
+            default:
+                Throw("invalidMemoryPressureLevel");
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
 std::shared_ptr<EngineServiceContext> EngineImpl::getService(const std::string& type) {
     auto it = m_registeredServiceMap.find(type);
-    return it != m_registeredServiceMap.end() ? std::make_shared<EngineServiceContext>(it->second) : nullptr;
+    if (it == m_registeredServiceMap.end()) {
+        return nullptr;
+    }
+
+    // the service is started the first time it is used while the engine is running
+    if (getStartPolicy(type) == StartPolicy::ON_FIRST_USE && startService(it->second) == false) {
+        AACE_ERROR(LX(TAG).d("reason", "startServiceOnFirstUseFailed").d("service", type));
+    }
+
+    return std::make_shared<EngineServiceContext>(it->second);
 }
 
 std::shared_ptr<EngineService> EngineImpl::getServiceFromPropertyKey(const std::string& key) {
@@ -483,6 +1009,18 @@ void EngineImpl::publish(const std::string& message) {
     }
 }
 
+void EngineImpl::publishBatch(const std::vector<std::string>& messages, bool coalesce) {
+    try {
+        auto messageBrokerService = m_messageBrokerService.lock();
+        ThrowIfNull(messageBrokerService, "invalidMessageBrokerService");
+        auto messageBroker = messageBrokerService->getMessageBroker();
+        ThrowIfNull(messageBroker, "invalidMessageBroker");
+        messageBroker->publishBatch(messages, aace::engine::messageBroker::Message::Direction::INCOMING, coalesce);
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    }
+}
+
 void EngineImpl::subscribe(MessageHandler handler, const std::string& topic, const std::string& action) {
     try {
         auto messageBrokerService = m_messageBrokerService.lock();
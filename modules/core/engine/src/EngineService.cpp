@@ -15,6 +15,7 @@
 
 #include "AACE/Engine/Core/EngineService.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/Memory/MemoryAccounting.h"
 
 namespace aace {
 namespace engine {
@@ -23,6 +24,8 @@ namespace core {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.core.EngineService");
 
+using MemoryAccounting = aace::engine::utils::memory::MemoryAccounting;
+
 EngineService::EngineService(const ServiceDescription& description) :
         m_description(description), m_initialized(false), m_running(false) {
 }
@@ -42,6 +45,7 @@ EngineService::~EngineService() {
 }
 
 bool EngineService::handleInitializeEngineEvent(std::shared_ptr<aace::engine::core::EngineContext> context) {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     try {
         ThrowIf(m_initialized, "serviceAlreadyInitialized");
 
@@ -62,10 +66,12 @@ bool EngineService::handleInitializeEngineEvent(std::shared_ptr<aace::engine::co
     }
 }
 
-bool EngineService::handleConfigureEngineEvent(std::shared_ptr<std::istream> configuration) {
+bool EngineService::handleConfigureEngineEvent(const aace::engine::utils::json::Value* configuration) {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     try {
         ThrowIfNot(m_initialized, "serviceNotInitialized");
-        ThrowIfNot(configuration != nullptr ? configure(configuration) : configure(), "configureServiceFailed");
+        ThrowIfNot(
+            configuration != nullptr ? configureFromJson(*configuration) : configure(), "configureServiceFailed");
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "handleConfigureEngineEvent").d("reason", ex.what()));
@@ -73,7 +79,21 @@ bool EngineService::handleConfigureEngineEvent(std::shared_ptr<std::istream> con
     }
 }
 
+bool EngineService::handlePrepareShutdownEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
+    try {
+        ReturnIf(m_initialized == false, true);
+        ThrowIfNot(prepareShutdown(), "prepareShutdownFailed");
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "handlePrepareShutdownEngineEvent").d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool EngineService::handleShutdownEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     try {
         if (m_initialized == false) {
             AACE_WARN(LX(TAG, "handleShutdownEngineEvent")
@@ -102,6 +122,7 @@ bool EngineService::handleShutdownEngineEvent() {
 }
 
 bool EngineService::handlePreRegisterEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     try {
         ThrowIfNot(m_initialized, "serviceNotInitialized");
         ThrowIfNot(preRegister(), "preRegisterFailed");
@@ -114,6 +135,7 @@ bool EngineService::handlePreRegisterEngineEvent() {
 }
 
 bool EngineService::handlePostRegisterEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     try {
         ThrowIfNot(m_initialized, "serviceNotInitialized");
         ThrowIfNot(postRegister(), "postRegisterFailed");
@@ -126,6 +148,7 @@ bool EngineService::handlePostRegisterEngineEvent() {
 }
 
 bool EngineService::handleSetupEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     try {
         ThrowIfNot(m_initialized, "serviceNotInitialized");
         ThrowIfNot(setup(), "setupServiceFailed");
@@ -138,6 +161,7 @@ bool EngineService::handleSetupEngineEvent() {
 }
 
 bool EngineService::handleStartEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     try {
         ThrowIfNot(m_initialized, "serviceNotInitialized");
         ThrowIf(m_running, "serviceAlreadyRunning");
@@ -154,6 +178,7 @@ bool EngineService::handleStartEngineEvent() {
 }
 
 bool EngineService::handleEngineStartedEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     try {
         ThrowIfNot(m_initialized, "serviceNotInitialized");
         ThrowIfNot(engineStarted(), "engineStartedServiceFailed");
@@ -166,6 +191,7 @@ bool EngineService::handleEngineStartedEngineEvent() {
 }
 
 bool EngineService::handleStopEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     try {
         ThrowIfNot(m_initialized, "serviceNotInitialized");
 
@@ -177,8 +203,9 @@ bool EngineService::handleStopEngineEvent() {
 
         ThrowIfNot(stop(), "stopServiceFailed");
 
-        // set the service running and initialized flags to false
+        // set the service running and initialized flags to false, a suspended service is not resumed once stopped
         m_running = false;
+        m_suspended = false;
 
         return true;
     } catch (std::exception& ex) {
@@ -187,7 +214,40 @@ bool EngineService::handleStopEngineEvent() {
     }
 }
 
+bool EngineService::handleSuspendEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
+    try {
+        ThrowIfNot(m_initialized, "serviceNotInitialized");
+        ReturnIf(m_running == false || m_suspended, true);
+        ThrowIfNot(suspend(), "suspendServiceFailed");
+
+        m_suspended = true;
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "handleSuspendEngineEvent").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool EngineService::handleResumeEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
+    try {
+        ThrowIfNot(m_initialized, "serviceNotInitialized");
+        ReturnIf(m_suspended == false, true);
+        ThrowIfNot(resume(), "resumeServiceFailed");
+
+        m_suspended = false;
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "handleResumeEngineEvent").d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool EngineService::handleEngineStoppedEngineEvent() {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     try {
         ThrowIfNot(m_initialized, "serviceNotInitialized");
         ThrowIfNot(engineStopped(), "engineStoppedServiceFailed");
@@ -201,6 +261,7 @@ bool EngineService::handleEngineStoppedEngineEvent() {
 
 bool EngineService::handleRegisterPlatformInterfaceEngineEvent(
     std::shared_ptr<aace::core::PlatformInterface> platformInterface) {
+    MemoryAccounting::Scope memoryScope(getDescription().getType());
     return registerPlatformInterface(platformInterface);
 }
 
@@ -220,6 +281,10 @@ bool EngineService::configure(std::shared_ptr<std::istream> configuration) {
     return true;
 }
 
+bool EngineService::configureFromJson(const aace::engine::utils::json::Value& configuration) {
+    return configure(aace::engine::utils::json::toStream(configuration, false));
+}
+
 bool EngineService::preRegister() {
     return true;
 }
@@ -240,6 +305,18 @@ bool EngineService::stop() {
     return true;
 }
 
+bool EngineService::suspend() {
+    return true;
+}
+
+bool EngineService::resume() {
+    return true;
+}
+
+bool EngineService::prepareShutdown() {
+    return true;
+}
+
 bool EngineService::shutdown() {
     return true;
 }
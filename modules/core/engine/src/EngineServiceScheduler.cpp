@@ -0,0 +1,303 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+#include "AACE/Engine/Core/EngineServiceScheduler.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/Threading/ThreadPool.h"
+#include "AACE/Engine/Utils/Trace/BootTrace.h"
+
+namespace aace {
+namespace engine {
+namespace core {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.core.EngineServiceScheduler");
+
+using ThreadPool = aace::engine::utils::threading::ThreadPool;
+
+std::unique_ptr<EngineServiceScheduler> EngineServiceScheduler::create(
+    std::vector<Service> services,
+    size_t threadCount) {
+    try {
+        for (size_t j = 0; j < services.size(); j++) {
+            for (auto dependency : services[j].dependencies) {
+                ThrowIf(dependency >= j, "invalidDependency:" + services[j].type);
+            }
+        }
+
+        return std::unique_ptr<EngineServiceScheduler>(new EngineServiceScheduler(std::move(services), threadCount));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+EngineServiceScheduler::EngineServiceScheduler(std::vector<Service> services, size_t threadCount) :
+        m_services(std::move(services)), m_dependents(m_services.size()), m_threadCount(threadCount) {
+    for (size_t j = 0; j < m_services.size(); j++) {
+        for (auto dependency : m_services[j].dependencies) {
+            m_dependents[dependency].push_back(j);
+        }
+    }
+}
+
+struct EngineServiceScheduler::ParallelRun {
+    ParallelRun(
+        const std::string& event,
+        const Handler& handler,
+        const std::vector<Service>& services,
+        const std::vector<std::vector<size_t>>& dependents) :
+            event(event),
+            handler(handler),
+            services(services),
+            dependents(dependents),
+            pendingDependencies(services.size()),
+            active(services.size(), false) {
+    }
+
+    // the event, the handler, and the services are copied, since the run may outlive the scheduler
+    const std::string event;
+    const Handler handler;
+    const std::vector<Service> services;
+    const std::vector<std::vector<size_t>> dependents;
+
+    // the pool is released by the last task of a run that timed out
+    std::shared_ptr<ThreadPool> pool;
+
+    // the state of the schedule, protected by the mutex
+    std::mutex mutex;
+    std::condition_variable completed;
+    std::vector<size_t> pendingDependencies;
+    std::vector<bool> active;
+    size_t running = 0;
+    size_t succeeded = 0;
+    bool failed = false;
+    bool timedOut = false;
+    std::vector<Timing> timings;
+};
+
+bool EngineServiceScheduler::run(const std::string& event, const Handler& handler) {
+    return run(event, handler, std::chrono::steady_clock::time_point::max());
+}
+
+bool EngineServiceScheduler::run(
+    const std::string& event,
+    const Handler& handler,
+    std::chrono::steady_clock::time_point deadline) {
+    auto start = std::chrono::steady_clock::now();
+    m_timings.clear();
+    m_timedOut.clear();
+
+    // with a single worker the services would run in the order of the list anyway, so they run on this thread
+    bool success = isParallel() ? runParallel(event, handler, deadline) : runSerial(event, handler, deadline);
+
+    report(event, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+    return success;
+}
+
+std::vector<EngineServiceScheduler::Timing> EngineServiceScheduler::getTimings() const {
+    return m_timings;
+}
+
+std::vector<std::string> EngineServiceScheduler::getTimedOut() const {
+    return m_timedOut;
+}
+
+bool EngineServiceScheduler::isParallel() const {
+    return m_threadCount > 1 && m_services.size() > 1;
+}
+
+bool EngineServiceScheduler::runSerial(
+    const std::string& event,
+    const Handler& handler,
+    std::chrono::steady_clock::time_point deadline) {
+    for (size_t j = 0; j < m_services.size(); j++) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            for (size_t k = j; k < m_services.size(); k++) {
+                m_timedOut.push_back(m_services[k].type);
+            }
+            return false;
+        }
+        Timing timing;
+        bool success = invoke(event, handler, j, m_services[j].type, timing);
+        m_timings.push_back(timing);
+        if (!success) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EngineServiceScheduler::runParallel(
+    const std::string& event,
+    const Handler& handler,
+    std::chrono::steady_clock::time_point deadline) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+        for (auto& service : m_services) {
+            m_timedOut.push_back(service.type);
+        }
+        return false;
+    }
+
+    auto run = std::make_shared<ParallelRun>(event, handler, m_services, m_dependents);
+    run->pool = ThreadPool::create(std::min(m_threadCount, m_services.size()));
+    if (run->pool == nullptr) {
+        AACE_WARN(LX(TAG, "runParallel").d("reason", "createThreadPoolFailed").m("Running the services serially"));
+        return runSerial(event, handler, deadline);
+    }
+
+    for (size_t j = 0; j < m_services.size(); j++) {
+        run->pendingDependencies[j] = m_services[j].dependencies.size();
+    }
+
+    std::unique_lock<std::mutex> lock(run->mutex);
+    for (size_t j = 0; j < m_services.size(); j++) {
+        if (run->pendingDependencies[j] == 0) {
+            schedule(run, j);
+        }
+    }
+    bool completed = run->completed.wait_until(lock, deadline, [&run]() { return run->running == 0; });
+    m_timings = run->timings;
+
+    if (!completed) {
+        // the services still running complete in the background, and the others are not started
+        run->timedOut = true;
+        run->failed = true;
+        for (size_t j = 0; j < m_services.size(); j++) {
+            if (run->active[j] || run->pendingDependencies[j] > 0) {
+                m_timedOut.push_back(m_services[j].type);
+            }
+        }
+        return false;
+    }
+    lock.unlock();
+
+    // the workers may still be returning from the last task, which refers to the state of the schedule
+    run->pool->shutdown();
+
+    return !run->failed && run->succeeded == m_services.size();
+}
+
+void EngineServiceScheduler::schedule(const std::shared_ptr<ParallelRun>& run, size_t index) {
+    // posts the task handling the event for a service, with the lock held
+    run->running++;
+    run->active[index] = true;
+    bool posted = run->pool->post([run, index]() {
+        {
+            // a service queued before the deadline is not started after it
+            std::lock_guard<std::mutex> lock(run->mutex);
+            if (run->timedOut) {
+                run->running--;
+                return;
+            }
+        }
+
+        Timing timing;
+        bool success = invoke(run->event, run->handler, index, run->services[index].type, timing);
+
+        std::lock_guard<std::mutex> lock(run->mutex);
+        run->timings.push_back(timing);
+        run->active[index] = false;
+        if (success) {
+            run->succeeded++;
+            if (!run->failed) {
+                for (auto dependent : run->dependents[index]) {
+                    if (--run->pendingDependencies[dependent] == 0) {
+                        schedule(run, dependent);
+                    }
+                }
+            }
+        } else {
+            run->failed = true;
+        }
+        if (run->timedOut) {
+            AACE_WARN(LX(TAG, "schedule")
+                          .d("reason", "completedAfterDeadline")
+                          .d("event", run->event)
+                          .d("service", timing.type)
+                          .d("durationUs", timing.duration.count()));
+        }
+        run->running--;
+        run->completed.notify_all();
+    });
+    if (!posted) {
+        AACE_ERROR(LX(TAG, "schedule").d("reason", "postFailed").d("service", run->services[index].type));
+        run->running--;
+        run->active[index] = false;
+        run->failed = true;
+    }
+}
+
+bool EngineServiceScheduler::invoke(
+    const std::string& event,
+    const Handler& handler,
+    size_t index,
+    const std::string& type,
+    Timing& timing) {
+    auto start = std::chrono::steady_clock::now();
+    bool success = false;
+    try {
+        aace::engine::utils::trace::BootTrace::Scope scope(type, event);
+        success = handler(index);
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "invoke").d("reason", ex.what()).d("service", type));
+    }
+
+    timing.type = type;
+    timing.duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    timing.success = success;
+    if (!success) {
+        AACE_ERROR(LX(TAG, "invoke").d("reason", "serviceFailed").d("service", timing.type));
+    }
+    return success;
+}
+
+void EngineServiceScheduler::report(const std::string& event, std::chrono::microseconds elapsed) const {
+    std::chrono::microseconds total{0};
+    const Timing* slowest = nullptr;
+    for (auto& timing : m_timings) {
+        AACE_DEBUG(LX(TAG, "report")
+                       .d("event", event)
+                       .d("service", timing.type)
+                       .d("durationUs", timing.duration.count())
+                       .d("success", timing.success));
+        total += timing.duration;
+        if (slowest == nullptr || timing.duration > slowest->duration) {
+            slowest = &timing;
+        }
+    }
+
+    AACE_INFO(LX(TAG, "report")
+                  .d("event", event)
+                  .d("parallel", isParallel())
+                  .d("services", m_timings.size())
+                  .d("elapsedUs", elapsed.count())
+                  .d("totalUs", total.count())
+                  .d("slowest", slowest != nullptr ? slowest->type : "")
+                  .d("slowestUs", slowest != nullptr ? slowest->duration.count() : 0));
+
+    for (auto& type : m_timedOut) {
+        AACE_WARN(LX(TAG, "report").d("reason", "deadlineExceeded").d("event", event).d("service", type));
+    }
+}
+
+}  // namespace core
+}  // namespace engine
+}  // namespace aace
@@ -17,6 +17,7 @@
 
 #include "AACE/Engine/Location/LocationEngineService.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/JSON/JSON.h"
 
 namespace aace {
 namespace engine {
@@ -28,10 +29,27 @@ static const std::string TAG("aace.location.LocationEngineService");
 // register the service
 REGISTER_SERVICE(LocationEngineService)
 
+namespace json = aace::engine::utils::json;
+
 LocationEngineService::LocationEngineService(const aace::engine::core::ServiceDescription& description) :
         aace::engine::core::EngineService(description) {
 }
 
+bool LocationEngineService::configureFromJson(const json::Value& root) {
+    try {
+        auto locationCache = json::get(root, "/locationCache", json::Type::object);
+        if (locationCache != nullptr) {
+            auto maxAge = json::get(locationCache, "/maxAgeInMilliseconds", (int64_t)m_locationCacheMaxAge.count());
+            ThrowIf(maxAge < 0, "invalidMaxAgeInMilliseconds");
+            m_locationCacheMaxAge = std::chrono::milliseconds(maxAge);
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "configureFromJson").d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool LocationEngineService::registerPlatformInterface(
     std::shared_ptr<aace::core::PlatformInterface> platformInterface) {
     try {
@@ -48,7 +66,8 @@ bool LocationEngineService::registerPlatformInterfaceType(
     try {
         ThrowIfNotNull(m_locationProviderEngineImpl, "platformInterfaceAlreadyRegistered");
 
-        m_locationProviderEngineImpl = LocationProviderEngineImpl::create(locationProviderPlatformInterface);
+        m_locationProviderEngineImpl =
+            LocationProviderEngineImpl::create(locationProviderPlatformInterface, m_locationCacheMaxAge);
         ThrowIfNull(m_locationProviderEngineImpl, "createLocationProviderEngineImplFailed");
 
         ThrowIfNot(
@@ -24,11 +24,13 @@ namespace location {
 static const std::string TAG("aace.core.LocationProviderEngineImpl");
 
 std::shared_ptr<LocationProviderEngineImpl> LocationProviderEngineImpl::create(
-    std::shared_ptr<aace::location::LocationProvider> platformInterface) {
+    std::shared_ptr<aace::location::LocationProvider> platformInterface,
+    std::chrono::milliseconds maxAge) {
     try {
         ThrowIfNull(platformInterface, "locationProviderPlatformInterfaceIsNull");
+        ThrowIf(maxAge.count() < 0, "invalidMaxAge");
         auto locationProviderEngineImpl =
-            std::shared_ptr<LocationProviderEngineImpl>(new LocationProviderEngineImpl(platformInterface));
+            std::shared_ptr<LocationProviderEngineImpl>(new LocationProviderEngineImpl(platformInterface, maxAge));
         return locationProviderEngineImpl;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -37,8 +39,9 @@ std::shared_ptr<LocationProviderEngineImpl> LocationProviderEngineImpl::create(
 }
 
 LocationProviderEngineImpl::LocationProviderEngineImpl(
-    std::shared_ptr<aace::location::LocationProvider> platformInterface) :
-        m_locationProviderPlatformInterface(platformInterface) {
+    std::shared_ptr<aace::location::LocationProvider> platformInterface,
+    std::chrono::milliseconds maxAge) :
+        m_locationProviderPlatformInterface(platformInterface), m_maxAge(maxAge) {
 }
 
 void LocationProviderEngineImpl::addObserver(std::shared_ptr<LocationServiceObserverInterface> observer) {
@@ -60,6 +63,12 @@ void LocationProviderEngineImpl::removeObserver(std::shared_ptr<LocationServiceO
 }
 
 void LocationProviderEngineImpl::onLocationServiceAccessChanged(LocationServiceAccess access) {
+    if (access == LocationServiceAccess::DISABLED) {
+        // the last fix is not the location of the device anymore
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        m_hasCachedLocation = false;
+    }
+
     std::lock_guard<std::mutex> lock(m_mutex);
 
     for (const auto& next : m_observers) {
@@ -67,9 +76,39 @@ void LocationProviderEngineImpl::onLocationServiceAccessChanged(LocationServiceA
     }
 }
 
+void LocationProviderEngineImpl::onLocationChanged(const aace::location::Location& location) {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cachedLocation = location;
+    m_hasCachedLocation = true;
+}
+
+bool LocationProviderEngineImpl::isCachedLocationFresh() {
+    if (!m_hasCachedLocation || m_maxAge == std::chrono::milliseconds::zero()) {
+        return false;
+    }
+    // a fix timestamped in the future by a clock change is not trusted longer than the max age either
+    auto age = std::chrono::system_clock::now() - m_cachedLocation.getTime();
+    return age <= m_maxAge && age >= -m_maxAge;
+}
+
 aace::location::Location LocationProviderEngineImpl::getLocation() {
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        if (isCachedLocationFresh()) {
+            return m_cachedLocation;
+        }
+    }
     if (m_locationProviderPlatformInterface != nullptr) {
-        return m_locationProviderPlatformInterface->getLocation();
+        auto location = m_locationProviderPlatformInterface->getLocation();
+        if (m_maxAge > std::chrono::milliseconds::zero()) {
+            // keep a location pushed while the platform was queried if it is the latest fix
+            std::lock_guard<std::mutex> lock(m_cacheMutex);
+            if (!m_hasCachedLocation || m_cachedLocation.getTime() <= location.getTime()) {
+                m_cachedLocation = location;
+                m_hasCachedLocation = true;
+            }
+        }
+        return location;
     } else {
         AACE_WARN(LX(TAG).m("locationQueriedAfterShutdown"));
         return aace::location::Location();
@@ -80,6 +119,8 @@ void LocationProviderEngineImpl::shutdown() {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_observers.clear();
     m_locationProviderPlatformInterface.reset();
+    std::lock_guard<std::mutex> cacheLock(m_cacheMutex);
+    m_hasCachedLocation = false;
 }
 
 }  // namespace location
@@ -13,12 +13,15 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
 
 #include "AACE/Engine/Logger/EngineLogger.h"
 #include "AACE/Engine/Logger/LogFormatter.h"
 #include "AACE/Engine/Logger/ThreadMoniker.h"
+#include "AACE/Engine/Utils/Threading/ThreadPolicy.h"
 #ifdef AAC_DEFAULT_LOGGER_SINK_CONSOLE
 #include "AACE/Engine/Logger/Sinks/ConsoleSink.h"
 #endif
@@ -30,6 +33,20 @@ namespace aace {
 namespace engine {
 namespace logger {
 
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.logger.EngineLogger");
+
+// Interval the writer thread waits for new entries before checking the queue again
+static const std::chrono::milliseconds WRITER_WAIT_TIMEOUT(100);
+
+// Set on the writer thread, which emits the entries logged by the sinks on the same thread
+static thread_local bool s_writerThread = false;
+
+const size_t EngineLogger::DEFAULT_ASYNC_QUEUE_SIZE;
+
+// every level is enabled until the logger has been created
+std::atomic<int> EngineLogger::s_minimumLevel{static_cast<int>(Level::VERBOSE)};
+
 std::shared_ptr<EngineLogger> EngineLogger::getInstance() {
     static std::shared_ptr<EngineLogger> s_instance(new EngineLogger());
     return s_instance;
@@ -99,18 +116,51 @@ EngineLogger::EngineLogger() {
 #endif  // AAC_DEFAULT_LOGGER_ENABLED
 }
 
+EngineLogger::~EngineLogger() {
+    disableAsync();
+}
+
 void EngineLogger::addObserver(std::shared_ptr<aace::engine::logger::LogEventObserver> observer) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_observers.insert(observer);
+    updateTargetsLocked();
+    updateMinimumLevelLocked();
 }
 
 void EngineLogger::removeObserver(std::shared_ptr<aace::engine::logger::LogEventObserver> observer) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_observers.erase(observer);
+    updateTargetsLocked();
+    updateMinimumLevelLocked();
+}
+
+void EngineLogger::updateTargetsLocked() {
+    auto targets = std::make_shared<Targets>();
+    for (auto& next : m_sinkMap) {
+        targets->sinks.push_back(next.second);
+    }
+    targets->observers.assign(m_observers.begin(), m_observers.end());
+    std::atomic_store(&m_targets, std::shared_ptr<const Targets>(targets));
+}
+
+void EngineLogger::updateMinimumLevel() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    updateMinimumLevelLocked();
+}
+
+void EngineLogger::updateMinimumLevelLocked() {
+    // observers don't filter the entries they receive
+    auto level = m_observers.empty() ? Level::CRITICAL : Level::VERBOSE;
+
+    for (auto& next : m_sinkMap) {
+        level = std::min(level, next.second->getMinimumLevel());
+    }
+
+    s_minimumLevel.store(static_cast<int>(level), std::memory_order_relaxed);
 }
 
 void EngineLogger::log(Level level, const LogEntry& entry) {
-    emit(
+    submit(
         "AAC",
         entry.tag(),
         level,
@@ -120,13 +170,14 @@ void EngineLogger::log(Level level, const LogEntry& entry) {
 #ifndef NDEBUG
     // Abort the execution for DEBUG build
     if (entry.shouldAbortAfterEmission()) {
+        flush();
         std::abort();
     }
 #endif
 }
 
 void EngineLogger::log(const std::string& source, Level level, const LogEntry& entry) {
-    emit(
+    submit(
         source,
         entry.tag(),
         level,
@@ -136,6 +187,7 @@ void EngineLogger::log(const std::string& source, Level level, const LogEntry& e
 #ifndef NDEBUG
     // Abort the execution for DEBUG build
     if (entry.shouldAbortAfterEmission()) {
+        flush();
         std::abort();
     }
 #endif
@@ -148,7 +200,239 @@ void EngineLogger::log(
     std::chrono::system_clock::time_point time,
     const std::string& threadMoniker,
     const std::string& text) {
-    emit(source, tag, level, time, threadMoniker.c_str(), text.c_str());
+    submit(source, tag, level, time, threadMoniker.c_str(), text.c_str());
+}
+
+void EngineLogger::submit(
+    const std::string& source,
+    const std::string& tag,
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* threadMoniker,
+    const char* text) {
+    // the summaries of the limiter are not limited
+    auto rateLimiter = std::atomic_load(&m_rateLimiter);
+    if (rateLimiter != nullptr && tag != TAG) {
+        auto now = LogRateLimiter::Clock::now();
+        if (!rateLimiter->allow(tag, level, now)) {
+            return;
+        }
+        reportSuppressed(*rateLimiter, now);
+    }
+
+    auto queue = std::atomic_load(&m_queue);
+
+    if (queue == nullptr || s_writerThread) {
+        emit(source, tag, level, time, threadMoniker, text);
+        return;
+    }
+
+    // emit errors after the queued entries that led up to them, and make sure they reach the
+    // sinks before the logging thread continues, in case the process is about to terminate
+    if (level >= Level::ERROR) {
+        waitForQueuedEntries();
+        emit(source, tag, level, time, threadMoniker, text);
+        flushSinks();
+        return;
+    }
+
+    auto policy = m_overflowPolicy.load(std::memory_order_relaxed);
+    if (policy == OverflowPolicy::DROP_VERBOSE && level < Level::WARN &&
+        queue->size() >= queue->capacity() / 4 * 3) {
+        m_droppedEntries.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    LogQueue::Record record{source, tag, level, time, threadMoniker, text};
+    while (!queue->push(std::move(record))) {
+        if (policy != OverflowPolicy::BLOCK) {
+            m_droppedEntries.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        wakeWriterThread();
+        std::this_thread::yield();
+    }
+
+    m_queuedEntries.fetch_add(1);
+    wakeWriterThread();
+}
+
+void EngineLogger::flush() {
+    if (!s_writerThread) {
+        waitForQueuedEntries();
+    }
+    flushSinks();
+}
+
+size_t EngineLogger::dump() {
+    if (!s_writerThread) {
+        waitForQueuedEntries();
+    }
+    size_t count = 0;
+    auto targets = std::atomic_load(&m_targets);
+    if (targets != nullptr) {
+        for (auto& next : targets->sinks) {
+            if (next->dump()) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+uint64_t EngineLogger::getDroppedEntries() const {
+    return m_droppedEntries.load();
+}
+
+uint64_t EngineLogger::getSuppressedEntries() const {
+    auto rateLimiter = std::atomic_load(&m_rateLimiter);
+    return rateLimiter != nullptr ? rateLimiter->getSuppressedEntries() : 0;
+}
+
+void EngineLogger::setRateLimiter(std::shared_ptr<LogRateLimiter> rateLimiter) {
+    std::atomic_store(&m_rateLimiter, rateLimiter);
+}
+
+void EngineLogger::reportSuppressed(LogRateLimiter& rateLimiter, LogRateLimiter::Clock::time_point now) {
+    for (auto& next : rateLimiter.takeSummary(now)) {
+        LogEntry entry(TAG, "suppressedLogEntries");
+        entry.d("tag", next.tag).d("level", next.level).d("count", next.count);
+        submit(
+            "AAC",
+            entry.tag(),
+            Level::WARN,
+            std::chrono::system_clock::now(),
+            ThreadMoniker::getThisThreadMoniker(),
+            entry.c_str());
+    }
+}
+
+bool EngineLogger::enableAsync(size_t queueSize, OverflowPolicy policy) {
+    if (queueSize == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    stopWriterThread();
+
+    auto queue = std::make_shared<LogQueue>(queueSize);
+    m_overflowPolicy = policy;
+    m_writerStopped = false;
+    m_writerThread = std::thread(&EngineLogger::drain, this, queue);
+    std::atomic_store(&m_queue, queue);
+
+    return true;
+}
+
+void EngineLogger::disableAsync() {
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    stopWriterThread();
+}
+
+void EngineLogger::stopWriterThread() {
+    auto queue = std::atomic_exchange(&m_queue, std::shared_ptr<LogQueue>());
+    if (!m_writerThread.joinable()) {
+        return;
+    }
+
+    m_writerStopped = true;
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_writerCondition.notify_one();
+    }
+    m_writerThread.join();
+
+    // emit the entries queued while the writer thread was stopping
+    emitQueued(*queue);
+
+    std::lock_guard<std::mutex> lock(m_flushMutex);
+    m_flushCondition.notify_all();
+}
+
+void EngineLogger::wakeWriterThread() {
+    // pairs with the fence in drain() so either the writer sees the entry or we see it waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_writerCondition.notify_one();
+    }
+}
+
+void EngineLogger::waitForQueuedEntries() {
+    auto queue = std::atomic_load(&m_queue);
+    if (queue == nullptr) {
+        return;
+    }
+
+    auto queued = m_queuedEntries.load();
+    wakeWriterThread();
+
+    // stop waiting if the writer thread is replaced or stopped
+    std::unique_lock<std::mutex> lock(m_flushMutex);
+    m_flushCondition.wait(lock, [this, &queue, queued]() {
+        return m_emittedEntries.load() >= queued || std::atomic_load(&m_queue) != queue;
+    });
+}
+
+void EngineLogger::flushSinks() {
+    auto targets = std::atomic_load(&m_targets);
+    if (targets != nullptr) {
+        for (auto& next : targets->sinks) {
+            next->flush();
+        }
+    }
+}
+
+void EngineLogger::drain(std::shared_ptr<LogQueue> queue) {
+    s_writerThread = true;
+    aace::engine::utils::threading::ThreadPolicy::ScopedThread scopedThread("Logger.writer");
+
+    while (true) {
+        if (emitQueued(*queue) > 0) {
+            std::lock_guard<std::mutex> lock(m_flushMutex);
+            m_flushCondition.notify_all();
+            continue;
+        }
+
+        if (m_writerStopped) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        m_writerWaiting = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_writerCondition.wait_for(
+            lock, WRITER_WAIT_TIMEOUT, [this, &queue]() { return queue->size() > 0 || m_writerStopped; });
+        m_writerWaiting = false;
+    }
+}
+
+size_t EngineLogger::emitQueued(LogQueue& queue) {
+    size_t count = 0;
+    LogQueue::Record record;
+
+    while (queue.pop(record)) {
+        emit(record.source, record.tag, record.level, record.time, record.threadMoniker.c_str(), record.text.c_str());
+        m_emittedEntries.fetch_add(1);
+        count++;
+    }
+
+    // report the entries dropped since the last report
+    auto dropped = m_droppedEntries.load();
+    if (dropped > m_reportedDroppedEntries) {
+        LogEntry entry(TAG, "droppedLogEntries");
+        entry.d("count", dropped - m_reportedDroppedEntries);
+        emit(
+            "AAC",
+            entry.tag(),
+            Level::WARN,
+            std::chrono::system_clock::now(),
+            ThreadMoniker::getThisThreadMoniker(),
+            entry.c_str());
+        m_reportedDroppedEntries = dropped;
+    }
+
+    return count;
 }
 
 void EngineLogger::emit(
@@ -158,17 +442,25 @@ void EngineLogger::emit(
     std::chrono::system_clock::time_point time,
     const char* threadMoniker,
     const char* text) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    // the sinks synchronize their own output, so concurrent entries only contend in the sinks
+    // they are logged to
+    auto targets = std::atomic_load(&m_targets);
+    if (targets == nullptr) {
+        return;
+    }
 
     // iterate through each register sink and emit the log entry
-    for (auto it = m_sinkMap.begin(); it != m_sinkMap.end(); it++) {
-        it->second->emit(source, tag, level, time, threadMoniker, text);
+    for (auto& next : targets->sinks) {
+        next->emit(source, tag, level, time, threadMoniker, text);
     }
 
     // iterate through all of the log event observers and log the message
-    // to each observer in the list
-    for (auto next : m_observers) {
-        next->onLogEvent(level, time, source.c_str(), text);
+    // to each observer in the list, observers are called one entry at a time
+    if (!targets->observers.empty()) {
+        std::lock_guard<std::mutex> lock(m_observerMutex);
+        for (auto& next : targets->observers) {
+            next->onLogEvent(level, time, source.c_str(), text);
+        }
     }
 }
 
@@ -176,6 +468,8 @@ bool EngineLogger::addSink(std::shared_ptr<aace::engine::logger::sink::Sink> sin
     std::lock_guard<std::mutex> lock(m_mutex);
     if (replace || m_sinkMap.find(sink->getId()) == m_sinkMap.end()) {
         m_sinkMap[sink->getId()] = sink;
+        updateTargetsLocked();
+        updateMinimumLevelLocked();
         return true;
     } else {
         return false;
@@ -193,6 +487,8 @@ bool EngineLogger::removeSink(const std::string& id) {
 
     if (it != m_sinkMap.end()) {
         m_sinkMap.erase(it);
+        updateTargetsLocked();
+        updateMinimumLevelLocked();
     }
 
     return true;
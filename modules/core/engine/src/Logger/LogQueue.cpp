@@ -0,0 +1,93 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AACE/Engine/Logger/LogQueue.h"
+
+namespace aace {
+namespace engine {
+namespace logger {
+
+LogQueue::LogQueue(size_t capacity) : m_enqueuePosition(0), m_dequeuePosition(0) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    m_cells.reset(new Cell[size]);
+    m_mask = size - 1;
+
+    // a cell is free for the producer claiming the position equal to its sequence
+    for (size_t j = 0; j < size; j++) {
+        m_cells[j].sequence.store(j, std::memory_order_relaxed);
+    }
+}
+
+bool LogQueue::push(Record&& record) {
+    Cell* cell;
+    auto position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+    while (true) {
+        cell = &m_cells[position & m_mask];
+        auto sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        if (diff == 0) {
+            if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // the cell still holds the record from the previous lap
+            return false;
+        } else {
+            position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->record = std::move(record);
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool LogQueue::pop(Record& record) {
+    auto position = m_dequeuePosition.load(std::memory_order_relaxed);
+    auto cell = &m_cells[position & m_mask];
+
+    if (cell->sequence.load(std::memory_order_acquire) != position + 1) {
+        return false;
+    }
+
+    record = std::move(cell->record);
+
+    // free the cell for the producer of the next lap
+    cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+    m_dequeuePosition.store(position + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+size_t LogQueue::size() const {
+    auto dequeuePosition = m_dequeuePosition.load(std::memory_order_relaxed);
+    auto enqueuePosition = m_enqueuePosition.load(std::memory_order_relaxed);
+    return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+}
+
+size_t LogQueue::capacity() const {
+    return m_mask + 1;
+}
+
+}  // namespace logger
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "AACE/Engine/Logger/LogRateLimiter.h"
+
+namespace aace {
+namespace engine {
+namespace logger {
+
+constexpr double LogRateLimiter::DEFAULT_RATE;
+constexpr double LogRateLimiter::DEFAULT_BURST;
+constexpr std::chrono::milliseconds LogRateLimiter::DEFAULT_SUMMARY_INTERVAL;
+const size_t LogRateLimiter::LEVEL_COUNT;
+
+std::shared_ptr<LogRateLimiter> LogRateLimiter::create(Limit defaultLimit, std::chrono::milliseconds summaryInterval) {
+    // the limiter can't log its own errors, since the entries would be checked by the limiter
+    if (!isValid(defaultLimit) || summaryInterval.count() <= 0) {
+        return nullptr;
+    }
+    return std::shared_ptr<LogRateLimiter>(new LogRateLimiter(defaultLimit, summaryInterval));
+}
+
+LogRateLimiter::LogRateLimiter(Limit defaultLimit, std::chrono::milliseconds summaryInterval) :
+        m_defaultLimit(defaultLimit),
+        m_summaryInterval(summaryInterval),
+        m_nextSummary((Clock::now() + summaryInterval).time_since_epoch().count()) {
+}
+
+bool LogRateLimiter::isValid(const Limit& limit) {
+    return limit.rate > 0 && limit.burst >= 1;
+}
+
+bool LogRateLimiter::setLimit(const std::string& tag, Limit limit) {
+    if (!isValid(limit)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& limits = m_limits[tag];
+    limits.fill(limit);
+
+    // the buckets of the tag take the new limit on the next entry
+    auto it = m_buckets.find(tag);
+    if (it != m_buckets.end()) {
+        for (auto& next : it->second) {
+            next.limit = limit;
+        }
+    }
+    return true;
+}
+
+bool LogRateLimiter::setLimit(const std::string& tag, Level level, Limit limit) {
+    if (!isValid(limit)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_limits.find(tag);
+    if (it == m_limits.end()) {
+        it = m_limits.emplace(tag, std::array<Limit, LEVEL_COUNT>()).first;
+        it->second.fill(m_defaultLimit);
+    }
+    it->second[static_cast<size_t>(level)] = limit;
+
+    auto bucket = m_buckets.find(tag);
+    if (bucket != m_buckets.end()) {
+        bucket->second[static_cast<size_t>(level)].limit = limit;
+    }
+    return true;
+}
+
+bool LogRateLimiter::allow(const std::string& tag, Level level, Clock::time_point now) {
+    if (level >= Level::CRITICAL) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_buckets.find(tag);
+    if (it == m_buckets.end()) {
+        it = m_buckets.emplace(tag, Buckets()).first;
+    }
+    auto& bucket = it->second[static_cast<size_t>(level)];
+
+    // the bucket is full when the tag logs its first entry of the level
+    if (!bucket.used) {
+        auto limits = m_limits.find(tag);
+        bucket.limit = limits != m_limits.end() ? limits->second[static_cast<size_t>(level)] : m_defaultLimit;
+        bucket.tokens = bucket.limit.burst;
+        bucket.refilled = now;
+        bucket.used = true;
+    } else if (now > bucket.refilled) {
+        auto elapsed = std::chrono::duration<double>(now - bucket.refilled).count();
+        bucket.tokens = std::min(bucket.limit.burst, bucket.tokens + elapsed * bucket.limit.rate);
+        bucket.refilled = now;
+    }
+
+    if (bucket.tokens >= 1) {
+        bucket.tokens -= 1;
+        return true;
+    }
+    bucket.suppressed++;
+    m_suppressedEntries.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+std::vector<LogRateLimiter::Suppressed> LogRateLimiter::takeSummary(Clock::time_point now) {
+    std::vector<Suppressed> summary;
+
+    // only one thread takes the summary when it is due
+    auto nextSummary = m_nextSummary.load(std::memory_order_relaxed);
+    if (now.time_since_epoch().count() < nextSummary ||
+        !m_nextSummary.compare_exchange_strong(nextSummary, (now + m_summaryInterval).time_since_epoch().count())) {
+        return summary;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& next : m_buckets) {
+        for (size_t j = 0; j < LEVEL_COUNT; j++) {
+            auto& bucket = next.second[j];
+            if (bucket.suppressed > 0) {
+                summary.push_back({next.first, static_cast<Level>(j), bucket.suppressed});
+                bucket.suppressed = 0;
+            }
+        }
+    }
+    return summary;
+}
+
+uint64_t LogRateLimiter::getSuppressedEntries() const {
+    return m_suppressedEntries.load(std::memory_order_relaxed);
+}
+
+}  // namespace logger
+}  // namespace engine
+}  // namespace aace
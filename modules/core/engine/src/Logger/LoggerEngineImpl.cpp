@@ -24,21 +24,55 @@ namespace aace {
 namespace engine {
 namespace logger {
 
-LoggerEngineImpl::LoggerEngineImpl(std::shared_ptr<aace::logger::Logger> platformLoggerInterface) :
-        m_platformLoggerInterface(platformLoggerInterface) {
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+constexpr size_t LoggerEngineImpl::DEFAULT_BATCH_MAX_EVENTS;
+constexpr std::chrono::milliseconds LoggerEngineImpl::DEFAULT_BATCH_MAX_DELAY;
+
+LoggerEngineImpl::LoggerEngineImpl(
+    std::shared_ptr<aace::logger::Logger> platformLoggerInterface,
+    const BatchConfig& batchConfig) :
+        m_platformLoggerInterface(platformLoggerInterface), m_batchConfig(batchConfig) {
+    // the timer wheel isn't created while a log event is delivered
+    if (m_batchConfig.enabled) {
+        m_timerWheel = TimerWheel::getDefault();
+    }
+}
+
+LoggerEngineImpl::~LoggerEngineImpl() {
+    if (m_flushTimer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(m_flushTimer);
+    }
 }
 
 std::shared_ptr<LoggerEngineImpl> LoggerEngineImpl::create(
     std::shared_ptr<aace::logger::Logger> platformLoggerInterface,
     std::shared_ptr<aace::engine::logger::EngineLogger> logger) {
+    return create(platformLoggerInterface, logger, BatchConfig());
+}
+
+std::shared_ptr<LoggerEngineImpl> LoggerEngineImpl::create(
+    std::shared_ptr<aace::logger::Logger> platformLoggerInterface,
+    std::shared_ptr<aace::engine::logger::EngineLogger> logger,
+    const BatchConfig& batchConfig) {
     try {
-        auto loggerEngineImpl = std::shared_ptr<LoggerEngineImpl>(new LoggerEngineImpl(platformLoggerInterface));
+        ThrowIfNull(platformLoggerInterface, "invalidPlatformLoggerInterface");
+        ThrowIf(batchConfig.enabled && batchConfig.maxEvents == 0, "invalidBatchMaxEvents");
+        ThrowIf(batchConfig.enabled && batchConfig.maxDelay.count() <= 0, "invalidBatchMaxDelay");
+
+        auto loggerEngineImpl =
+            std::shared_ptr<LoggerEngineImpl>(new LoggerEngineImpl(platformLoggerInterface, batchConfig));
 
         ThrowIfNull(loggerEngineImpl, "createLoggerEngineImplFailed");
 
         // add ourself as an observer to the logger
         logger->addObserver(loggerEngineImpl);
 
+        if (batchConfig.enabled) {
+            aace::engine::utils::memory::MemoryPressure::addObserver(
+                loggerEngineImpl, aace::engine::utils::memory::MemoryPressure::Priority::BUFFER);
+        }
+
         // set the platform engine interface reference
         platformLoggerInterface->setEngineInterface(loggerEngineImpl);
 
@@ -54,15 +88,79 @@ bool LoggerEngineImpl::onLogEvent(
     std::chrono::system_clock::time_point time,
     const char* source,
     const char* text) {
-    return m_platformLoggerInterface != nullptr && m_platformLoggerInterface->logEvent(level, time, source, text);
+    ReturnIf(m_platformLoggerInterface == nullptr, false);
+    if (!m_batchConfig.enabled) {
+        return m_platformLoggerInterface->logEvent(level, time, source, text);
+    }
+
+    std::lock_guard<std::mutex> lock(m_batchMutex);
+    if (m_batchSuspended) {
+        return m_platformLoggerInterface->logEvent(level, time, source, text);
+    }
+    m_batch.push_back({level, time, source, text});
+
+    // errors are delivered at once, so they reach the platform if the process terminates
+    if (m_batch.size() >= m_batchConfig.maxEvents || level >= LogEventObserver::Level::ERROR) {
+        return flushLocked();
+    }
+    scheduleFlushLocked();
+    return true;
+}
+
+bool LoggerEngineImpl::flush() {
+    std::lock_guard<std::mutex> lock(m_batchMutex);
+    return flushLocked();
+}
+
+bool LoggerEngineImpl::flushLocked() {
+    if (m_flushTimer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(m_flushTimer);
+        m_flushTimer = TimerWheel::INVALID_TIMER;
+    }
+    ReturnIf(m_batch.empty(), true);
+
+    std::vector<aace::logger::Logger::LogEvent> batch;
+    batch.reserve(m_batchConfig.maxEvents);
+    std::swap(batch, m_batch);
+    return m_platformLoggerInterface->logEvents(batch);
+}
+
+void LoggerEngineImpl::scheduleFlushLocked() {
+    ReturnIf(m_flushTimer != TimerWheel::INVALID_TIMER);
+
+    // the batch is delivered on the executor, the timer thread must not block
+    std::weak_ptr<LoggerEngineImpl> wp = shared_from_this();
+    m_flushTimer = m_timerWheel->submitAfter(m_batchConfig.maxDelay, [wp]() {
+        if (auto loggerEngineImpl = wp.lock()) {
+            auto raw = loggerEngineImpl.get();
+            loggerEngineImpl->m_executor.post([raw]() { raw->flush(); });
+        }
+    });
+}
+
+void LoggerEngineImpl::onMemoryPressure(aace::engine::utils::memory::MemoryPressureLevel level) {
+    std::lock_guard<std::mutex> lock(m_batchMutex);
+    m_batchSuspended = level != aace::engine::utils::memory::MemoryPressureLevel::NORMAL;
+    if (m_batchSuspended) {
+        // deliver the buffered events, and release the buffer until the pressure is relieved
+        flushLocked();
+        std::vector<aace::logger::Logger::LogEvent>().swap(m_batch);
+    }
 }
 
 void LoggerEngineImpl::log(aace::logger::Logger::Level level, const std::string& tag, const std::string& message) {
-    m_executor.submit([level, tag, message] {
+    m_executor.post([level, tag, message] {
         aace::engine::logger::EngineLogger::getInstance()->log("CLI", level, LX(tag, message));
     });
 }
 
+void LoggerEngineImpl::onDumpLogs() {
+    m_executor.post([] {
+        auto count = aace::engine::logger::EngineLogger::getInstance()->dump();
+        AACE_INFO(LX(TAG, "onDumpLogs").d("sinks", count));
+    });
+}
+
 }  // namespace logger
 }  // namespace engine
 }  // namespace aace
@@ -16,11 +16,16 @@
 #include <typeinfo>
 #include <algorithm>
 #include <iostream>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "AACE/Engine/Logger/LoggerEngineService.h"
 #include "AACE/Engine/Logger/Sinks/Sink.h"
+#include "AACE/Engine/Logger/Sinks/BinarySink.h"
 #include "AACE/Engine/Logger/Sinks/ConsoleSink.h"
 #include "AACE/Engine/Logger/Sinks/FileSink.h"
+#include "AACE/Engine/Logger/Sinks/FlightRecorderSink.h"
 #include "AACE/Engine/Logger/Sinks/SyslogSink.h"
 #include "AACE/Engine/Utils/JSON/JSON.h"
 #include "AACE/Engine/Utils/String/StringUtils.h"
@@ -39,6 +44,32 @@ static const std::string TAG("aace.logger.LoggerEngineService");
 // register the service
 REGISTER_SERVICE(LoggerEngineService);
 
+// the number of engines using the asynchronous writer, which is stopped when the last of them shuts down
+static std::mutex s_asyncMutex;
+static size_t s_asyncEngineCount = 0;
+
+static bool toLevel(const std::string& name, EngineLogger::Level& level) {
+    static const std::vector<std::pair<std::string, EngineLogger::Level>> levels = {
+        {"VERBOSE", EngineLogger::Level::VERBOSE},
+        {"INFO", EngineLogger::Level::INFO},
+        {"METRIC", EngineLogger::Level::METRIC},
+        {"WARN", EngineLogger::Level::WARN},
+        {"ERROR", EngineLogger::Level::ERROR}};
+    for (auto& next : levels) {
+        if (aace::engine::utils::string::equal(name, next.first, false)) {
+            level = next.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+static LogRateLimiter::Limit createLimit(const json::Value& config, const LogRateLimiter::Limit& defaultLimit) {
+    auto rate = json::get(config, "/rate", (uint64_t)defaultLimit.rate);
+    auto burst = json::get(config, "/burst", (uint64_t)defaultLimit.burst);
+    return {static_cast<double>(rate), static_cast<double>(burst)};
+}
+
 LoggerEngineService::LoggerEngineService(const aace::engine::core::ServiceDescription& description) :
         aace::engine::core::EngineService(description) {
 }
@@ -81,6 +112,85 @@ bool LoggerEngineService::configure(std::shared_ptr<std::istream> configuration)
             }
         }
 
+        auto asyncConfig = json::get(root, "/async", json::Type::object);
+        if (asyncConfig != nullptr && json::get(asyncConfig, "/enabled", false)) {
+            auto queueSize = json::get(asyncConfig, "/queueSize", (uint64_t)EngineLogger::DEFAULT_ASYNC_QUEUE_SIZE);
+            std::string policyName = json::get(asyncConfig, "/overflowPolicy", "DROP_VERBOSE");
+
+            EngineLogger::OverflowPolicy policy;
+            if (aace::engine::utils::string::equal(policyName, "DROP_VERBOSE", false)) {
+                policy = EngineLogger::OverflowPolicy::DROP_VERBOSE;
+            } else if (aace::engine::utils::string::equal(policyName, "DROP", false)) {
+                policy = EngineLogger::OverflowPolicy::DROP;
+            } else if (aace::engine::utils::string::equal(policyName, "BLOCK", false)) {
+                policy = EngineLogger::OverflowPolicy::BLOCK;
+            } else {
+                Throw("invalidOverflowPolicy");
+            }
+
+            // the engines of the process share the writer started by the first engine
+            std::lock_guard<std::mutex> lock(s_asyncMutex);
+            if (m_asyncEnabled == false) {
+                if (s_asyncEngineCount == 0) {
+                    ThrowIfNot(
+                        EngineLogger::getInstance()->enableAsync(static_cast<size_t>(queueSize), policy),
+                        "enableAsyncLoggerFailed");
+                } else {
+                    AACE_INFO(LX(TAG).m("Using the asynchronous logger of another engine"));
+                }
+                s_asyncEngineCount++;
+                m_asyncEnabled = true;
+            }
+        }
+
+        auto rateLimitConfig = json::get(root, "/rateLimit", json::Type::object);
+        if (rateLimitConfig != nullptr) {
+            std::shared_ptr<LogRateLimiter> rateLimiter;
+            if (json::get(rateLimitConfig, "/enabled", false)) {
+                auto defaultLimit = createLimit(
+                    rateLimitConfig, {LogRateLimiter::DEFAULT_RATE, LogRateLimiter::DEFAULT_BURST});
+                auto summaryInterval = json::get(
+                    rateLimitConfig,
+                    "/summaryInterval",
+                    (uint64_t)LogRateLimiter::DEFAULT_SUMMARY_INTERVAL.count());
+                rateLimiter = LogRateLimiter::create(defaultLimit, std::chrono::milliseconds(summaryInterval));
+                ThrowIfNull(rateLimiter, "invalidRateLimit");
+
+                // the limits of the tags, in the order they are configured
+                auto limitConfigList = json::get(rateLimitConfig, "/limits", json::Type::array);
+                if (limitConfigList != nullptr) {
+                    for (std::size_t j = 0; j < limitConfigList.size(); j++) {
+                        auto next = limitConfigList[j];
+                        auto tag = json::get(next, "/tag", json::Type::string);
+                        ThrowIfNull(tag, "invalidOrMissingRateLimitTag");
+                        auto limit = createLimit(next, defaultLimit);
+                        std::string levelName = json::get(next, "/level", "");
+                        if (levelName.empty()) {
+                            ThrowIfNot(rateLimiter->setLimit(tag, limit), "invalidRateLimit");
+                        } else {
+                            EngineLogger::Level level;
+                            ThrowIfNot(toLevel(levelName, level), "invalidRateLimitLevel");
+                            ThrowIfNot(rateLimiter->setLimit(tag, level, limit), "invalidRateLimit");
+                        }
+                    }
+                }
+            }
+            EngineLogger::getInstance()->setRateLimiter(rateLimiter);
+        }
+
+        auto batchConfig = json::get(root, "/platformLogger/batch", json::Type::object);
+        if (batchConfig != nullptr) {
+            m_batchConfig.enabled = json::get(batchConfig, "/enabled", false);
+            auto maxEvents =
+                json::get(batchConfig, "/maxEvents", (uint64_t)LoggerEngineImpl::DEFAULT_BATCH_MAX_EVENTS);
+            ThrowIf(maxEvents == 0, "invalidBatchMaxEvents");
+            m_batchConfig.maxEvents = static_cast<size_t>(maxEvents);
+            auto maxDelay =
+                json::get(batchConfig, "/maxDelay", (uint64_t)LoggerEngineImpl::DEFAULT_BATCH_MAX_DELAY.count());
+            ThrowIf(maxDelay == 0, "invalidBatchMaxDelay");
+            m_batchConfig.maxDelay = std::chrono::milliseconds(maxDelay);
+        }
+
         auto rulesConfigList = json::get(root, "/rules", json::Type::array);
         if (rulesConfigList != nullptr) {
             for (std::size_t j = 0; j < rulesConfigList.size(); j++) {
@@ -99,6 +209,9 @@ bool LoggerEngineService::configure(std::shared_ptr<std::istream> configuration)
             }
         }
 
+        // the rules may have been added to existing sinks
+        EngineLogger::getInstance()->updateMinimumLevel();
+
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "configure").d("reason", ex.what()));
@@ -121,7 +234,13 @@ std::shared_ptr<aace::engine::logger::sink::Sink> LoggerEngineService::createSin
         if (aace::engine::utils::string::equal(type, "aace.logger.sink.console", false)) {
             sink = aace::engine::logger::sink::ConsoleSink::create(id);
         } else if (aace::engine::utils::string::equal(type, "aace.logger.sink.syslog", false)) {
-            sink = aace::engine::logger::sink::SyslogSink::create(id);
+            uint32_t batchSize = json::get(config, "/config/batchSize", (uint64_t)0);
+            uint32_t flushInterval = json::get(config, "/config/flushInterval", (uint64_t)1000);
+            std::string socketPath = json::get(
+                config, "/config/socketPath", aace::engine::logger::sink::SyslogSink::DEFAULT_SOCKET_PATH);
+
+            sink = aace::engine::logger::sink::SyslogSink::create(
+                id, batchSize, std::chrono::milliseconds(flushInterval), socketPath);
         } else if (aace::engine::utils::string::equal(type, "aace.logger.sink.file", false)) {
             auto path = json::get(config, "/config/path", json::Type::string);
             ThrowIfNull(path, "invalidOrMissingConfigPath");
@@ -130,8 +249,42 @@ std::shared_ptr<aace::engine::logger::sink::Sink> LoggerEngineService::createSin
             uint32_t maxSize = json::get(config, "/config/maxSize", (uint64_t)1048576);
             uint32_t maxFiles = json::get(config, "/config/maxFiles", (uint64_t)3);
             bool append = json::get(config, "/config/append", true);
+            uint32_t bufferSize = json::get(config, "/config/bufferSize", (uint64_t)0);
+            uint32_t flushInterval = json::get(config, "/config/flushInterval", (uint64_t)1000);
+            bool sync = json::get(config, "/config/sync", false);
+            bool compress = json::get(config, "/config/compress", false);
+
+            sink = aace::engine::logger::sink::FileSink::create(
+                id,
+                path,
+                prefix,
+                maxSize,
+                maxFiles,
+                append,
+                bufferSize,
+                std::chrono::milliseconds(flushInterval),
+                sync,
+                compress);
+        } else if (aace::engine::utils::string::equal(type, "aace.logger.sink.binary", false)) {
+            auto path = json::get(config, "/config/path", json::Type::string);
+            ThrowIfNull(path, "invalidOrMissingConfigPath");
 
-            sink = aace::engine::logger::sink::FileSink::create(id, path, prefix, maxSize, maxFiles, append);
+            std::string prefix = json::get(config, "/config/prefix", "aace");
+            uint32_t maxSize = json::get(config, "/config/maxSize", (uint64_t)1048576);
+            uint32_t maxFiles = json::get(config, "/config/maxFiles", (uint64_t)3);
+
+            sink = aace::engine::logger::sink::BinarySink::create(id, path, prefix, maxSize, maxFiles);
+        } else if (aace::engine::utils::string::equal(type, "aace.logger.sink.flightRecorder", false)) {
+            auto path = json::get(config, "/config/path", json::Type::string);
+            ThrowIfNull(path, "invalidOrMissingConfigPath");
+
+            std::string prefix = json::get(config, "/config/prefix", "aace");
+            uint32_t maxSize = json::get(config, "/config/maxSize", (uint64_t)4194304);
+            uint32_t maxDumps = json::get(config, "/config/maxDumps", (uint64_t)3);
+            bool dumpOnCrash = json::get(config, "/config/dumpOnCrash", true);
+
+            sink = aace::engine::logger::sink::FlightRecorderSink::create(
+                id, path, prefix, maxSize, maxDumps, dumpOnCrash);
         } else {
             Throw("invalidSinkType");
         }
@@ -186,7 +339,8 @@ bool LoggerEngineService::registerPlatformInterfaceType(std::shared_ptr<aace::lo
 
         // create the logger engine implementation
         m_logger = logger;
-        m_loggerEngineImpl = aace::engine::logger::LoggerEngineImpl::create(logger, EngineLogger::getInstance());
+        m_loggerEngineImpl = aace::engine::logger::LoggerEngineImpl::create(
+            logger, EngineLogger::getInstance(), m_batchConfig);
         ThrowIfNull(m_loggerEngineImpl, "createLoggerEngineImplFailed");
 
         return true;
@@ -197,6 +351,15 @@ bool LoggerEngineService::registerPlatformInterfaceType(std::shared_ptr<aace::lo
 }
 
 bool LoggerEngineService::shutdown() {
+    // emit the queued log entries and stop the writer thread, unless another engine still uses it
+    if (m_asyncEnabled) {
+        std::lock_guard<std::mutex> lock(s_asyncMutex);
+        if (--s_asyncEngineCount == 0) {
+            EngineLogger::getInstance()->disableAsync();
+        }
+        m_asyncEnabled = false;
+    }
+
     if (m_logger != nullptr) {
         m_logger->setEngineInterface(nullptr);
         m_logger.reset();
@@ -204,6 +367,8 @@ bool LoggerEngineService::shutdown() {
     }
     if (m_loggerEngineImpl != nullptr) {
         EngineLogger::getInstance()->removeObserver(m_loggerEngineImpl);
+        // deliver the buffered log events, no event is buffered once the observer is removed
+        m_loggerEngineImpl->flush();
         m_loggerEngineImpl.reset();
         m_loggerEngineImpl = nullptr;
     }
@@ -0,0 +1,366 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "AACE/Engine/Logger/Sinks/BinarySink.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+
+namespace aace {
+namespace engine {
+namespace logger {
+namespace sink {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.logger.sink.BinarySink");
+
+/// Identifies a binary log file
+static const char BINARY_LOG_MAGIC[8] = {'A', 'A', 'C', 'B', 'L', 'O', 'G', '\0'};
+
+/// Version of the binary log layout
+static const uint32_t BINARY_LOG_VERSION = 1;
+
+/// Size of the file header
+static const size_t HEADER_SIZE = 32;
+
+/// Offset of the size of the records in the file header
+static const size_t HEADER_RECORDS_SIZE_OFFSET = 16;
+
+/// Record types
+static const uint8_t RECORD_STRING = 0x01;
+static const uint8_t RECORD_ENTRY = 0x02;
+
+/// Maximum number of strings defined in a file, the string IDs are reassigned when it is exceeded
+static const size_t MAX_STRINGS = 65536;
+
+/// Separators of the sections and metadata of the text of a @c LogEntry
+static const char SECTION_SEPARATOR = ':';
+static const char PAIR_SEPARATOR = ',';
+static const char KEY_VALUE_SEPARATOR = '=';
+static const char METADATA_ESCAPE = '\\';
+
+static void storeLittleEndian(char* data, uint64_t value, size_t size) {
+    for (size_t j = 0; j < size; j++) {
+        data[j] = static_cast<char>((value >> (8 * j)) & 0xff);
+    }
+}
+
+static void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static void appendBytes(std::string& out, const char* data, size_t size) {
+    appendVarint(out, size);
+    out.append(data, size);
+}
+
+static bool exists(const std::string& filename) {
+    struct stat info;
+    return stat(filename.c_str(), &info) == 0 && (info.st_mode & S_IFDIR) == 0;
+}
+
+// returns the first separator that isn't escaped in the metadata section, or the end of the text
+static const char* findUnescaped(const char* begin, const char* end, char separator) {
+    for (auto pos = begin; pos < end; pos++) {
+        if (*pos == METADATA_ESCAPE && pos + 1 < end) {
+            pos++;
+        } else if (*pos == separator || *pos == SECTION_SEPARATOR) {
+            return pos;
+        }
+    }
+    return end;
+}
+
+BinarySink::BinarySink(const std::string& id) : Sink(id) {
+}
+
+BinarySink::~BinarySink() {
+    closeLog();
+}
+
+std::shared_ptr<BinarySink> BinarySink::create(
+    const std::string& id,
+    const std::string& path,
+    const std::string& prefix,
+    uint32_t maxSize,
+    uint32_t maxFiles) {
+    try {
+        struct stat info;
+
+        // check to make sure the path is valid
+        ThrowIf(stat(path.c_str(), &info) != 0, "invalidPath");
+        ThrowIf((info.st_mode & S_IFDIR) == 0, "invalidPath");
+        ThrowIf(maxSize <= HEADER_SIZE, "invalidMaxSize");
+
+        // create the binary sink
+        auto sink = std::shared_ptr<BinarySink>(new BinarySink(id));
+
+        sink->m_path = path;
+        sink->m_prefix = prefix;
+        sink->m_maxSize = maxSize;
+        sink->m_maxFiles = maxFiles;
+
+        // append path separator if necessary
+        if (sink->m_path[sink->m_path.length() - 1] != '/') {
+            sink->m_path += '/';
+        }
+
+        // create the main log filename
+        sink->m_filename = sink->m_path + sink->m_prefix + ".blog";
+
+        // keep the log of the previous session, and create the log file
+        ThrowIfNot(sink->rotateLog(), "rotateLogFailed");
+
+        // enable the sink
+        sink->m_enabled = true;
+
+        return sink;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+uint64_t BinarySink::getDroppedEntries() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_droppedEntries;
+}
+
+bool BinarySink::openLog() {
+    m_fd = ::open(m_filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+        return false;
+    }
+
+    if (ftruncate(m_fd, static_cast<off_t>(m_maxSize)) != 0) {
+        return false;
+    }
+
+    auto memory = mmap(nullptr, m_maxSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<char*>(memory);
+    std::memcpy(m_data, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+    storeLittleEndian(m_data + 8, BINARY_LOG_VERSION, 4);
+    storeLittleEndian(m_data + 12, HEADER_SIZE, 4);
+    storeLittleEndian(m_data + HEADER_RECORDS_SIZE_OFFSET, 0, 8);
+    storeLittleEndian(m_data + 24, 0, 8);
+    m_size = HEADER_SIZE;
+
+    // the strings are defined again in each file
+    m_strings.clear();
+
+    return true;
+}
+
+void BinarySink::closeLog() {
+    if (m_data != nullptr) {
+        munmap(m_data, m_maxSize);
+        m_data = nullptr;
+    }
+    if (m_fd >= 0) {
+        // release the unused space of the file
+        if (ftruncate(m_fd, static_cast<off_t>(m_size)) != 0) {
+            m_size = m_maxSize;
+        }
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool BinarySink::rotateLog() {
+    try {
+        closeLog();
+
+        for (int j = m_maxFiles; j > 0; j--) {
+            std::string src = j > 1 ? m_filename + '.' + std::to_string(j - 1) : m_filename;
+            std::string target = m_filename + '.' + std::to_string(j);
+
+            // remove the target file if it exists
+            if (exists(target)) {
+                ThrowIf(std::remove(target.c_str()) != 0, "rotateLogFailed");
+            }
+
+            if (exists(src)) {
+                ThrowIf(std::rename(src.c_str(), target.c_str()) != 0, "rotateLogFailed");
+            }
+        }
+
+        ThrowIfNot(openLog(), "openLogFailed");
+
+        return true;
+    } catch (std::exception&) {
+        // the caller disables the sink and logs the error
+        return false;
+    }
+}
+
+void BinarySink::log(
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* source,
+    const char* threadMoniker,
+    const char* text) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_enabled) {
+        try {
+            encode(level, time, source, threadMoniker, text);
+
+            // rotate the log if the record doesn't fit, and encode it again with the strings
+            // it uses defined in the new file
+            if (m_size + m_definitions.size() + m_record.size() > m_maxSize) {
+                ThrowIfNot(rotateLog(), "rotateLogFailed");
+                encode(level, time, source, threadMoniker, text);
+                if (m_size + m_definitions.size() + m_record.size() > m_maxSize) {
+                    m_droppedEntries++;
+                    return;
+                }
+            }
+
+            // copy the records to the mapped file, and then publish their size in the header
+            std::memcpy(m_data + m_size, m_definitions.data(), m_definitions.size());
+            m_size += m_definitions.size();
+            std::memcpy(m_data + m_size, m_record.data(), m_record.size());
+            m_size += m_record.size();
+            storeLittleEndian(m_data + HEADER_RECORDS_SIZE_OFFSET, m_size - HEADER_SIZE, 8);
+        } catch (std::exception& ex) {
+            // disable the sink so that the error message doesn't cause the logger to
+            // get caught in an infinite loop.. ok if another sink handles the event!
+            m_enabled = false;
+            lock.unlock();
+
+            // log the error
+            AACE_ERROR(LX(TAG, "log").d("reason", ex.what()));
+        }
+    }
+}
+
+void BinarySink::flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_data != nullptr) {
+        msync(m_data, static_cast<size_t>(m_size), MS_ASYNC);
+    }
+}
+
+void BinarySink::encode(
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* source,
+    const char* threadMoniker,
+    const char* text) {
+    m_definitions.clear();
+    m_record.clear();
+    if (m_strings.size() >= MAX_STRINGS) {
+        m_strings.clear();
+    }
+
+    // split the text of the log entry at its section separators: tag:event:metadata:message
+    auto end = text + std::strlen(text);
+    auto tagEnd = std::strchr(text, SECTION_SEPARATOR);
+    auto eventEnd = tagEnd != nullptr ? std::strchr(tagEnd + 1, SECTION_SEPARATOR) : nullptr;
+    auto metadataEnd = eventEnd != nullptr ? findUnescaped(eventEnd + 1, end, SECTION_SEPARATOR) : nullptr;
+    uint8_t sections = tagEnd == nullptr ? 1 : eventEnd == nullptr ? 2 : metadataEnd == end ? 3 : 4;
+
+    auto timestamp = time.time_since_epoch().count() > 0
+                         ? std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count()
+                         : 0;
+    char timestampData[8];
+    storeLittleEndian(timestampData, static_cast<uint64_t>(timestamp), sizeof(timestampData));
+
+    m_record.push_back(static_cast<char>(RECORD_ENTRY));
+    m_record.append(timestampData, sizeof(timestampData));
+    m_record.push_back(static_cast<char>(level));
+    appendVarint(m_record, intern(source, std::strlen(source)));
+    appendVarint(m_record, intern(threadMoniker, std::strlen(threadMoniker)));
+    m_record.push_back(static_cast<char>(sections));
+
+    if (sections == 1) {
+        appendBytes(m_record, text, end - text);
+        return;
+    }
+
+    appendVarint(m_record, intern(text, tagEnd - text));
+    auto eventBegin = tagEnd + 1;
+    appendVarint(m_record, intern(eventBegin, (eventEnd != nullptr ? eventEnd : end) - eventBegin));
+
+    if (sections >= 3) {
+        // split the metadata into key/value pairs at the separators that aren't escaped
+        m_pairs.clear();
+        uint64_t pairCount = 0;
+        auto pos = eventEnd + 1;
+        while (pos < metadataEnd) {
+            auto pairEnd = findUnescaped(pos, metadataEnd, PAIR_SEPARATOR);
+            auto keyEnd = findUnescaped(pos, pairEnd, KEY_VALUE_SEPARATOR);
+            appendVarint(m_pairs, intern(pos, keyEnd - pos));
+            if (keyEnd < pairEnd) {
+                m_pairs.push_back(1);
+                appendBytes(m_pairs, keyEnd + 1, pairEnd - keyEnd - 1);
+            } else {
+                m_pairs.push_back(0);
+            }
+            pairCount++;
+
+            // a trailing separator is followed by an empty pair
+            if (pairEnd + 1 == metadataEnd) {
+                appendVarint(m_pairs, intern(metadataEnd, 0));
+                m_pairs.push_back(0);
+                pairCount++;
+            }
+            pos = pairEnd + 1;
+        }
+
+        appendVarint(m_record, pairCount);
+        m_record.append(m_pairs);
+    }
+
+    if (sections == 4) {
+        appendBytes(m_record, metadataEnd + 1, end - metadataEnd - 1);
+    }
+}
+
+uint32_t BinarySink::intern(const char* data, size_t size) {
+    m_stringKey.assign(data, size);
+    auto it = m_strings.find(m_stringKey);
+    if (it != m_strings.end()) {
+        return it->second;
+    }
+
+    auto id = static_cast<uint32_t>(m_strings.size());
+    m_strings.emplace(m_stringKey, id);
+
+    m_definitions.push_back(static_cast<char>(RECORD_STRING));
+    appendVarint(m_definitions, id);
+    appendBytes(m_definitions, data, size);
+
+    return id;
+}
+
+}  // namespace sink
+}  // namespace logger
+}  // namespace engine
+}  // namespace aace
@@ -47,7 +47,9 @@ void ConsoleSink::log(
     const char* source,
     const char* threadMoniker,
     const char* text) {
-    std::cout << m_formatter->format(level, time, source, threadMoniker, text) << std::endl;
+    auto log = m_formatter->format(level, time, source, threadMoniker, text);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::cout << log << std::endl;
 }
 
 }  // namespace sink
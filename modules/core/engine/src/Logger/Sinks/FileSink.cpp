@@ -13,13 +13,17 @@
  * permissions and limitations under the License.
  */
 
-#include <iostream>
-#include <sstream>
-#include <iomanip>
-#include <ctime>
+#include <cerrno>
+#include <cstdio>
 
+#include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef AAC_LOG_COMPRESSION
+#include <zlib.h>
+#endif
 
 #include "AACE/Engine/Logger/Sinks/FileSink.h"
 #include "AACE/Engine/Logger/LogFormatter.h"
@@ -33,17 +37,66 @@ namespace sink {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.logger.sink.FileSink");
 
+/// Size of the chunks copied from a rotated log file to its compressed file
+static constexpr size_t COMPRESSION_CHUNK_SIZE = 65536;
+
+static bool exists(const std::string& filename) {
+    struct stat info;
+    return stat(filename.c_str(), &info) == 0 && (info.st_mode & S_IFDIR) == 0;
+}
+
+static bool writeFully(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        auto result = ::write(fd, data, size);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += result;
+        size -= static_cast<size_t>(result);
+    }
+    return true;
+}
+
+static bool syncData(int fd) {
+#ifdef __APPLE__
+    return fsync(fd) == 0;
+#else
+    return fdatasync(fd) == 0;
+#endif
+}
+
 FileSink::FileSink(const std::string& id) : Sink(id) {
     m_formatter = aace::engine::logger::LogFormatter::createPlainText();
 }
 
+FileSink::~FileSink() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_wakeTrigger.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
 std::shared_ptr<FileSink> FileSink::create(
     const std::string& id,
     const std::string& path,
     const std::string& prefix,
     uint32_t maxSize,
     uint32_t maxFiles,
-    bool append) {
+    bool append,
+    uint32_t bufferSize,
+    std::chrono::milliseconds flushInterval,
+    bool sync,
+    bool compress) {
     try {
         struct stat info;
 
@@ -51,6 +104,11 @@ std::shared_ptr<FileSink> FileSink::create(
         ThrowIf(stat(path.c_str(), &info) != 0, "invalidPath");
         ThrowIf((info.st_mode & S_IFDIR) == 0, "invalidPath");
 
+        if (compress && !isCompressionSupported()) {
+            AACE_WARN(LX(TAG, "create").d("reason", "compressionNotSupported"));
+            compress = false;
+        }
+
         // create the file sink
         auto sink = std::shared_ptr<FileSink>(new FileSink(id));
 
@@ -59,6 +117,10 @@ std::shared_ptr<FileSink> FileSink::create(
         sink->m_maxSize = maxSize;
         sink->m_maxFiles = maxFiles;
         sink->m_append = append;
+        sink->m_bufferSize = bufferSize;
+        sink->m_flushInterval = flushInterval;
+        sink->m_sync = sync;
+        sink->m_compress = compress;
 
         // append path separator if necessary
         if (sink->m_path[sink->m_path.length() - 1] != '/') {
@@ -68,13 +130,13 @@ std::shared_ptr<FileSink> FileSink::create(
         // create the main log filename
         sink->m_filename = sink->m_path + sink->m_prefix + ".log";
 
-        // create the log file stream
-        sink->m_stream =
-            std::make_shared<std::ofstream>(sink->m_filename, append ? std::ios::out : std::ios::out | std::ios::trunc);
-        ThrowIfNot(sink->m_stream->is_open(), "openStreamFailed");
+        // open the log file and reserve the write-behind buffer
+        ThrowIfNot(sink->openLog(append), "openLogFailed");
+        sink->m_buffer.reserve(bufferSize);
 
-        // enable the sink
+        // enable the sink and start the thread that flushes the buffer and rotates the log files
         sink->m_enabled = true;
+        sink->m_thread = std::thread(&FileSink::run, sink.get());
 
         return sink;
     } catch (std::exception& ex) {
@@ -83,27 +145,57 @@ std::shared_ptr<FileSink> FileSink::create(
     }
 }
 
+bool FileSink::isCompressionSupported() {
+#ifdef AAC_LOG_COMPRESSION
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FileSink::openLog(bool append) {
+    m_fd = ::open(m_filename.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC), 0644);
+    if (m_fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    m_fileSize = fstat(m_fd, &info) == 0 ? static_cast<uint64_t>(info.st_size) : 0;
+
+    return true;
+}
+
 void FileSink::log(
     Level level,
     std::chrono::system_clock::time_point time,
     const char* source,
     const char* threadMoniker,
     const char* text) {
+    std::unique_lock<std::mutex> lock(m_mutex);
     if (m_enabled) {
         try {
             std::string log = m_formatter->format(level, time, source, threadMoniker, text);
 
             // check if the log file needs to be rotated
-            if ((long)m_stream->tellp() + log.length() + 1 > m_maxSize) {
-                ThrowIfNot(rotateLog(), "rotateLogFailed");
+            if (m_fileSize + m_buffer.length() + log.length() + 1 > m_maxSize) {
+                ThrowIfNot(rotateLogLocked(), "rotateLogFailed");
             }
 
-            // log the event to file stream
-            *m_stream << log << std::endl;
+            // add the event to the buffer, and write the buffer once it is full
+            m_buffer.append(log);
+            m_buffer.push_back('\n');
+            // the data is synced to storage by the background thread
+            if (m_buffer.length() >= m_bufferSize) {
+                ThrowIfNot(writeBufferLocked(false), "writeLogFailed");
+                if (m_syncPending) {
+                    m_wakeTrigger.notify_all();
+                }
+            }
         } catch (std::exception& ex) {
             // disable the sink so that the error message doesn't cause the logger to
             // get caught in an infinite loop.. ok if another sink handles the event!
             m_enabled = false;
+            lock.unlock();
 
             // log the error
             AACE_ERROR(LX(TAG, "log").d("reason", ex.what()));
@@ -112,46 +204,164 @@ void FileSink::log(
 }
 
 void FileSink::flush() {
-    m_stream->flush();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_enabled && !writeBufferLocked(m_sync)) {
+        m_enabled = false;
+        lock.unlock();
+        AACE_ERROR(LX(TAG, "flush").d("reason", "writeLogFailed"));
+    }
 }
 
-bool exists(const std::string& filename) {
-    struct stat info;
-    return stat(filename.c_str(), &info) == 0 && (info.st_mode & S_IFDIR) == 0;
+bool FileSink::writeBufferLocked(bool sync) {
+    bool success = true;
+    if (!m_buffer.empty()) {
+        success = writeFully(m_fd, m_buffer.data(), m_buffer.length());
+        m_fileSize += m_buffer.length();
+        m_buffer.clear();
+        m_syncPending = m_sync;
+    }
+
+    if (success && sync && m_syncPending) {
+        m_syncPending = false;
+        success = syncData(m_fd);
+    }
+
+    return success;
+}
+
+std::string FileSink::getRotatedFilename(int index) const {
+    return m_filename + '.' + std::to_string(index) + (m_compress ? ".gz" : "");
+}
+
+bool FileSink::rotateLogLocked() {
+    try {
+        // write the buffered entries before the current log file is rotated
+        ThrowIfNot(writeBufferLocked(false), "writeLogFailed");
+        m_syncPending = false;
+        ::close(m_fd);
+        m_fd = -1;
+
+        // move the current log file out of the way, the background thread gives it its numbered name
+        std::string pending = m_filename + ".rotating." + std::to_string(m_rotationCount++);
+        ThrowIf(std::rename(m_filename.c_str(), pending.c_str()) != 0, "rotateLogFailed");
+        m_pendingRotations.push_back(pending);
+        m_wakeTrigger.notify_all();
+
+        ThrowIfNot(openLog(false), "openLogFailed");
+
+        return true;
+    } catch (std::exception&) {
+        // the caller disables the sink and logs the error after releasing the lock
+        return false;
+    }
 }
 
-bool FileSink::rotateLog() {
+void FileSink::processRotation(const std::string& filename) {
     try {
-        // close the current log stream
-        m_stream->close();
+        // sync the last entries written to the rotated file
+        if (m_sync) {
+            int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+            ThrowIf(fd < 0, "openLogFailed");
+            bool success = syncData(fd);
+            ::close(fd);
+            ThrowIfNot(success, "syncLogFailed");
+        }
 
+        // discard the oldest log file, and shift the others up by one
         for (int j = m_maxFiles; j > 0; j--) {
-            std::string src = j > 1 ? m_filename + '.' + std::to_string(j - 1) : m_filename;
-            std::string target = m_filename + '.' + std::to_string(j);
+            std::string target = getRotatedFilename(j);
 
             // remove the target file if it exists
             if (exists(target)) {
-                ThrowIf(std::remove(target.c_str()) != 0, "rotateLogFailed");
+                ThrowIf(std::remove(target.c_str()) != 0, "removeLogFailed");
             }
 
-            if (exists(src)) {
-                ThrowIf(std::rename(src.c_str(), target.c_str()) != 0, "rotateLogFailed");
+            std::string src = j > 1 ? getRotatedFilename(j - 1) : "";
+            if (!src.empty() && exists(src)) {
+                ThrowIf(std::rename(src.c_str(), target.c_str()) != 0, "renameLogFailed");
             }
         }
 
-        m_stream = std::make_shared<std::ofstream>(m_filename, std::ios::out | std::ios::trunc);
-        ThrowIfNot(m_stream->is_open(), "openStreamFailed");
+        if (m_maxFiles == 0) {
+            ThrowIf(std::remove(filename.c_str()) != 0, "removeLogFailed");
+        } else if (m_compress) {
+#ifdef AAC_LOG_COMPRESSION
+            std::string target = getRotatedFilename(1);
+            int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+            ThrowIf(fd < 0, "openLogFailed");
+            gzFile file = gzopen(target.c_str(), "wb");
+            if (file == nullptr) {
+                ::close(fd);
+                Throw("openCompressedLogFailed");
+            }
 
-        return true;
+            std::unique_ptr<char[]> chunk(new char[COMPRESSION_CHUNK_SIZE]);
+            bool success = true;
+            ssize_t size;
+            while (success && (size = ::read(fd, chunk.get(), COMPRESSION_CHUNK_SIZE)) > 0) {
+                success = gzwrite(file, chunk.get(), static_cast<unsigned>(size)) == size;
+            }
+            success = gzclose(file) == Z_OK && success && size == 0;
+            ::close(fd);
+
+            ThrowIfNot(success, "compressLogFailed");
+            ThrowIf(std::remove(filename.c_str()) != 0, "removeLogFailed");
+#endif
+        } else {
+            ThrowIf(std::rename(filename.c_str(), getRotatedFilename(1).c_str()) != 0, "renameLogFailed");
+        }
     } catch (std::exception& ex) {
-        // disable the sink so that the error message doesn't cause the logger to
-        // get caught in an infinite loop.. ok if another sink handles the event!
-        m_enabled = false;
+        AACE_ERROR(LX(TAG, "processRotation").d("reason", ex.what()).d("filename", filename));
+    }
+}
 
-        // log the error
-        AACE_ERROR(LX(TAG, "rotateLog").d("reason", ex.what()));
+void FileSink::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        auto wake = [this]() { return m_shutdown || m_syncPending || !m_pendingRotations.empty(); };
+        if (m_flushInterval.count() > 0) {
+            m_wakeTrigger.wait_for(lock, m_flushInterval, wake);
+        } else {
+            m_wakeTrigger.wait(lock, wake);
+        }
 
-        return false;
+        // write the entries that have been buffered for longer than the flush interval
+        bool success = !m_enabled || writeBufferLocked(false);
+
+        // sync a duplicate of the log file descriptor, so the logging threads aren't blocked while
+        // the data is written to storage, even if the log is rotated in the meantime
+        if (m_syncPending) {
+            m_syncPending = false;
+            if (success && m_enabled) {
+                int fd = dup(m_fd);
+                lock.unlock();
+                success = fd >= 0 && syncData(fd);
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+                lock.lock();
+            }
+        }
+
+        // shift and compress the rotated log files without blocking the logging threads
+        while (!m_pendingRotations.empty()) {
+            auto filename = m_pendingRotations.front();
+            m_pendingRotations.pop_front();
+            lock.unlock();
+            processRotation(filename);
+            lock.lock();
+        }
+
+        if (!success) {
+            m_enabled = false;
+            lock.unlock();
+            AACE_ERROR(LX(TAG, "run").d("reason", "writeLogFailed"));
+            lock.lock();
+        }
+
+        if (m_shutdown && m_pendingRotations.empty()) {
+            break;
+        }
     }
 }
 
@@ -0,0 +1,427 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "AACE/Engine/Logger/Sinks/FlightRecorderSink.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+
+namespace aace {
+namespace engine {
+namespace logger {
+namespace sink {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.logger.sink.FlightRecorderSink");
+
+/// Identifies a binary log file, the dumps are decoded like the files of the binary sink
+static const char BINARY_LOG_MAGIC[8] = {'A', 'A', 'C', 'B', 'L', 'O', 'G', '\0'};
+
+/// Version of the binary log layout
+static const uint32_t BINARY_LOG_VERSION = 1;
+
+/// Size of the file header
+static const size_t HEADER_SIZE = 32;
+
+/// Record types
+static const uint8_t RECORD_STRING = 0x01;
+static const uint8_t RECORD_ENTRY = 0x02;
+
+/// IDs of the source and thread moniker strings, defined again before each entry so each record stands alone
+static const uint8_t SOURCE_STRING_ID = 0;
+static const uint8_t THREAD_MONIKER_STRING_ID = 1;
+
+/// The shortest time between two dumps triggered by errors, so a burst of errors doesn't rotate away the first dump
+static const std::chrono::seconds MIN_ERROR_DUMP_INTERVAL = std::chrono::seconds(10);
+
+/// The signals of a crash, which dump the ring before the previous handler handles them
+static const int CRASH_SIGNALS[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+static const size_t CRASH_SIGNAL_COUNT = sizeof(CRASH_SIGNALS) / sizeof(CRASH_SIGNALS[0]);
+
+/// The handlers of the crash signals before the crash handler was installed
+static struct sigaction s_previousActions[CRASH_SIGNAL_COUNT];
+
+std::atomic<FlightRecorderSink*> FlightRecorderSink::s_crashSink{nullptr};
+
+const uint32_t FlightRecorderSink::MIN_PRESSURE_SIZE;
+
+static void storeLittleEndian(char* data, uint64_t value, size_t size) {
+    for (size_t j = 0; j < size; j++) {
+        data[j] = static_cast<char>((value >> (8 * j)) & 0xff);
+    }
+}
+
+static void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static void appendBytes(std::string& out, const char* data, size_t size) {
+    appendVarint(out, size);
+    out.append(data, size);
+}
+
+static bool exists(const std::string& filename) {
+    struct stat info;
+    return stat(filename.c_str(), &info) == 0 && (info.st_mode & S_IFDIR) == 0;
+}
+
+// writes all the bytes, retrying the partial and interrupted writes, and is safe to call from a signal handler
+static bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        auto written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+FlightRecorderSink::FlightRecorderSink(const std::string& id) : Sink(id) {
+}
+
+FlightRecorderSink::~FlightRecorderSink() {
+    uninstallCrashHandler();
+}
+
+std::shared_ptr<FlightRecorderSink> FlightRecorderSink::create(
+    const std::string& id,
+    const std::string& path,
+    const std::string& prefix,
+    uint32_t maxSize,
+    uint32_t maxDumps,
+    bool dumpOnCrash) {
+    try {
+        struct stat info;
+
+        // check to make sure the path is valid
+        ThrowIf(stat(path.c_str(), &info) != 0, "invalidPath");
+        ThrowIf((info.st_mode & S_IFDIR) == 0, "invalidPath");
+        ThrowIf(maxSize == 0, "invalidMaxSize");
+        ThrowIf(maxDumps == 0, "invalidMaxDumps");
+
+        // create the flight recorder sink
+        auto sink = std::shared_ptr<FlightRecorderSink>(new FlightRecorderSink(id));
+
+        sink->m_path = path;
+        sink->m_prefix = prefix;
+        sink->m_maxDumps = maxDumps;
+        sink->m_maxSize = maxSize;
+        sink->m_capacity = maxSize;
+        sink->m_ring.reset(new char[maxSize]);
+        sink->m_lastErrorDump = std::chrono::steady_clock::now() - MIN_ERROR_DUMP_INTERVAL;
+
+        // append path separator if necessary
+        if (sink->m_path[sink->m_path.length() - 1] != '/') {
+            sink->m_path += '/';
+        }
+
+        // the filenames are built now, so the crash handler doesn't allocate memory
+        sink->m_dumpFilename = sink->m_path + sink->m_prefix + ".dump.blog";
+        sink->m_crashFilename = sink->m_path + sink->m_prefix + ".crash.blog";
+
+        if (dumpOnCrash) {
+            sink->installCrashHandler();
+        }
+
+        // the verbose entries are the first logs to go when the process is short of memory
+        aace::engine::utils::memory::MemoryPressure::addObserver(
+            sink, aace::engine::utils::memory::MemoryPressure::Priority::BUFFER);
+
+        return sink;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+uint64_t FlightRecorderSink::getRecordedSize() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tail - m_head;
+}
+
+uint64_t FlightRecorderSink::getDumpCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dumpCount;
+}
+
+uint64_t FlightRecorderSink::getCapacity() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+void FlightRecorderSink::onMemoryPressure(aace::engine::utils::memory::MemoryPressureLevel level) {
+    using aace::engine::utils::memory::MemoryPressureLevel;
+
+    uint64_t capacity = m_maxSize;
+    if (level == MemoryPressureLevel::CRITICAL) {
+        capacity = std::min<uint64_t>(m_maxSize, MIN_PRESSURE_SIZE);
+    } else if (level >= MemoryPressureLevel::LOW) {
+        capacity = std::max<uint64_t>(std::min<uint64_t>(m_maxSize, MIN_PRESSURE_SIZE), m_maxSize / 4);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (capacity == m_capacity) {
+        return;
+    }
+    auto previousCapacity = m_capacity;
+    resizeLocked(capacity);
+    lock.unlock();
+    AACE_INFO(LX(TAG, "onMemoryPressure").d("level", level).d("previousSize", previousCapacity).d("size", capacity));
+}
+
+void FlightRecorderSink::resizeLocked(uint64_t capacity) {
+    // drop the oldest records that don't fit in the new ring
+    auto head = m_head.load();
+    auto tail = m_tail.load();
+    while (tail - head > capacity) {
+        head += m_recordSizes.front();
+        m_recordSizes.pop_front();
+    }
+
+    // the records are copied to the start of the new ring, both rings are allocated only while they are copied
+    std::unique_ptr<char[]> ring(new char[capacity]);
+    auto size = tail - head;
+    auto offset = head % m_capacity;
+    auto first = std::min<uint64_t>(size, m_capacity - offset);
+    std::memcpy(ring.get(), m_ring.get() + offset, first);
+    std::memcpy(ring.get() + first, m_ring.get(), size - first);
+
+    // the crash handler doesn't dump the ring while it is replaced
+    FlightRecorderSink* expected = this;
+    auto crashSink = s_crashSink.compare_exchange_strong(expected, nullptr);
+    m_ring = std::move(ring);
+    m_capacity = capacity;
+    m_head.store(0);
+    m_tail.store(size);
+    if (crashSink) {
+        s_crashSink.store(this);
+    }
+}
+
+void FlightRecorderSink::log(
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* source,
+    const char* threadMoniker,
+    const char* text) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    encode(level, time, source, threadMoniker, text);
+
+    // an entry larger than the ring is not recorded
+    auto size = m_record.size();
+    if (size <= m_capacity) {
+        // overwrite the oldest records until the entry fits
+        while (m_tail - m_head + size > m_capacity) {
+            m_head += m_recordSizes.front();
+            m_recordSizes.pop_front();
+        }
+
+        // copy the entry to the ring, in two parts if it wraps around the end of the ring
+        auto offset = m_tail % m_capacity;
+        auto first = std::min<uint64_t>(size, m_capacity - offset);
+        std::memcpy(m_ring.get() + offset, m_record.data(), first);
+        std::memcpy(m_ring.get(), m_record.data() + first, size - first);
+        m_tail += size;
+        m_recordSizes.push_back(static_cast<uint32_t>(size));
+    }
+
+    if (level >= Level::ERROR) {
+        auto now = std::chrono::steady_clock::now();
+        if (now - m_lastErrorDump >= MIN_ERROR_DUMP_INTERVAL) {
+            m_lastErrorDump = now;
+            if (!dumpLocked()) {
+                // log the error once the lock is released, this error doesn't dump again since the dump interval
+                // is not elapsed
+                lock.unlock();
+                AACE_ERROR(LX(TAG, "log").d("reason", "dumpFailed").d("errno", errno));
+            }
+        }
+    }
+}
+
+bool FlightRecorderSink::dump() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_tail == m_head) {
+        // nothing was logged since the previous dump
+        return false;
+    }
+    auto size = m_tail - m_head;
+    if (!dumpLocked()) {
+        lock.unlock();
+        AACE_ERROR(LX(TAG, "dump").d("reason", "dumpFailed").d("errno", errno));
+        return false;
+    }
+    lock.unlock();
+    AACE_INFO(LX(TAG, "dump").d("size", size));
+    return true;
+}
+
+bool FlightRecorderSink::dumpLocked() {
+    if (!rotateDumps()) {
+        return false;
+    }
+    auto fd = ::open(m_dumpFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    auto success = writeRing(fd);
+    success = ::close(fd) == 0 && success;
+    if (success) {
+        // the next dump only has the entries logged after this one
+        m_head.store(m_tail.load());
+        m_recordSizes.clear();
+        m_dumpCount++;
+    }
+    return success;
+}
+
+bool FlightRecorderSink::rotateDumps() {
+    for (int j = m_maxDumps - 1; j > 0; j--) {
+        std::string src = j > 1 ? m_dumpFilename + '.' + std::to_string(j - 1) : m_dumpFilename;
+        std::string target = m_dumpFilename + '.' + std::to_string(j);
+
+        // remove the target file if it exists
+        if (exists(target) && std::remove(target.c_str()) != 0) {
+            return false;
+        }
+        if (exists(src) && std::rename(src.c_str(), target.c_str()) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FlightRecorderSink::writeRing(int fd) {
+    auto head = m_head.load(std::memory_order_relaxed);
+    auto tail = m_tail.load(std::memory_order_relaxed);
+
+    char header[HEADER_SIZE];
+    std::memcpy(header, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+    storeLittleEndian(header + 8, BINARY_LOG_VERSION, 4);
+    storeLittleEndian(header + 12, HEADER_SIZE, 4);
+    storeLittleEndian(header + 16, tail - head, 8);
+    storeLittleEndian(header + 24, 0, 8);
+    if (!writeAll(fd, header, sizeof(header))) {
+        return false;
+    }
+
+    // the records from the oldest byte to the end of the ring, and then from the start of the ring
+    auto offset = head % m_capacity;
+    auto first = std::min<uint64_t>(tail - head, m_capacity - offset);
+    return writeAll(fd, m_ring.get() + offset, first) && writeAll(fd, m_ring.get(), tail - head - first);
+}
+
+void FlightRecorderSink::encode(
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* source,
+    const char* threadMoniker,
+    const char* text) {
+    m_record.clear();
+
+    m_record.push_back(static_cast<char>(RECORD_STRING));
+    appendVarint(m_record, SOURCE_STRING_ID);
+    appendBytes(m_record, source, std::strlen(source));
+    m_record.push_back(static_cast<char>(RECORD_STRING));
+    appendVarint(m_record, THREAD_MONIKER_STRING_ID);
+    appendBytes(m_record, threadMoniker, std::strlen(threadMoniker));
+
+    auto timestamp = time.time_since_epoch().count() > 0
+                         ? std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count()
+                         : 0;
+    char timestampData[8];
+    storeLittleEndian(timestampData, static_cast<uint64_t>(timestamp), sizeof(timestampData));
+
+    // the text is kept as a single section, parsing its metadata would cost more than the copy saves
+    m_record.push_back(static_cast<char>(RECORD_ENTRY));
+    m_record.append(timestampData, sizeof(timestampData));
+    m_record.push_back(static_cast<char>(level));
+    appendVarint(m_record, SOURCE_STRING_ID);
+    appendVarint(m_record, THREAD_MONIKER_STRING_ID);
+    m_record.push_back(1);
+    appendBytes(m_record, text, std::strlen(text));
+}
+
+void FlightRecorderSink::installCrashHandler() {
+    FlightRecorderSink* expected = nullptr;
+    if (!s_crashSink.compare_exchange_strong(expected, this)) {
+        AACE_WARN(LX(TAG, "installCrashHandler").d("reason", "crashHandlerAlreadyInstalled").d("id", getId()));
+        return;
+    }
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = &FlightRecorderSink::onCrashSignal;
+    sigemptyset(&action.sa_mask);
+    for (size_t j = 0; j < CRASH_SIGNAL_COUNT; j++) {
+        sigaction(CRASH_SIGNALS[j], &action, &s_previousActions[j]);
+    }
+    m_dumpOnCrash = true;
+}
+
+void FlightRecorderSink::uninstallCrashHandler() {
+    if (!m_dumpOnCrash) {
+        return;
+    }
+    FlightRecorderSink* expected = this;
+    if (s_crashSink.compare_exchange_strong(expected, nullptr)) {
+        for (size_t j = 0; j < CRASH_SIGNAL_COUNT; j++) {
+            sigaction(CRASH_SIGNALS[j], &s_previousActions[j], nullptr);
+        }
+    }
+    m_dumpOnCrash = false;
+}
+
+void FlightRecorderSink::onCrashSignal(int signal) {
+    // only the first crash signal dumps the ring
+    auto sink = s_crashSink.exchange(nullptr);
+    if (sink != nullptr) {
+        auto fd = ::open(sink->m_crashFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd >= 0) {
+            sink->writeRing(fd);
+            ::close(fd);
+        }
+    }
+
+    // restore the previous handler, and raise the signal again for it to handle the crash
+    for (size_t j = 0; j < CRASH_SIGNAL_COUNT; j++) {
+        if (CRASH_SIGNALS[j] == signal) {
+            sigaction(signal, &s_previousActions[j], nullptr);
+        }
+    }
+    raise(signal);
+}
+
+}  // namespace sink
+}  // namespace logger
+}  // namespace engine
+}  // namespace aace
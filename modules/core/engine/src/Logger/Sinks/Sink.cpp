@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
@@ -27,10 +28,14 @@ namespace sink {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.logger.sink.Sink");
 
+/// Maximum number of cached rule sets, the cache is cleared when it is exceeded
+static const size_t MAX_RULE_CACHE_SIZE = 4096;
+
 Sink::Sink(std::string id) : m_id(std::move(id)) {
 }
 
 bool Sink::addRule(std::shared_ptr<Rule> rule, bool replace) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     for (auto it = m_rules.begin(); it != m_rules.end(); it++) {
         if ((*it)->equals(*rule)) {
             ReturnIfNot(replace, false);
@@ -40,6 +45,7 @@ bool Sink::addRule(std::shared_ptr<Rule> rule, bool replace) {
     }
 
     m_rules.push_back(rule);
+    m_ruleCache.clear();
 
     return true;
 }
@@ -69,21 +75,71 @@ void Sink::emit(
     std::chrono::system_clock::time_point time,
     const char* threadMoniker,
     const char* text) {
+    bool matched = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& ruleSet = getRuleSetLocked(source, tag);
+        matched = ruleSet.matchAll && level >= ruleSet.level;
+        for (auto it = ruleSet.messageRules.begin(); !matched && it != ruleSet.messageRules.end(); it++) {
+            matched = (*it)->matchMessage(level, text);
+        }
+    }
+
+    if (matched) {
+        log(level, time, source.c_str(), threadMoniker, text);
+    }
+}
+
+const Sink::RuleSet& Sink::getRuleSetLocked(const std::string& source, const std::string& tag) {
+    // reuse the key buffer so a cache hit doesn't allocate
+    m_ruleCacheKey.assign(source);
+    m_ruleCacheKey.push_back('\0');
+    m_ruleCacheKey.append(tag);
+
+    auto it = m_ruleCache.find(m_ruleCacheKey);
+    if (it != m_ruleCache.end()) {
+        return it->second;
+    }
+
+    if (m_ruleCache.size() >= MAX_RULE_CACHE_SIZE) {
+        m_ruleCache.clear();
+    }
+
+    RuleSet ruleSet;
     for (const auto& next : m_rules) {
-        if (next->match(level, source, tag, text)) {
-            log(level, time, source.c_str(), threadMoniker, text);
-            break;
+        if (next->matchSource(source, tag)) {
+            if (!next->hasMessagePattern()) {
+                ruleSet.level = ruleSet.matchAll ? std::min(ruleSet.level, next->getLevel()) : next->getLevel();
+                ruleSet.matchAll = true;
+            } else {
+                ruleSet.messageRules.push_back(next);
+            }
         }
     }
+
+    return m_ruleCache.emplace(m_ruleCacheKey, std::move(ruleSet)).first->second;
 }
 
 void Sink::flush() {
 }
 
+bool Sink::dump() {
+    return false;
+}
+
 std::string Sink::getId() {
     return m_id;
 }
 
+Sink::Level Sink::getMinimumLevel() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto level = Level::CRITICAL;
+    for (const auto& next : m_rules) {
+        level = std::min(level, next->getLevel());
+    }
+    return level;
+}
+
 //
 // Rule
 //
@@ -139,10 +195,25 @@ bool Rule::equals(const Rule& rule) {
     return m_source == rule.m_source && m_tag == rule.m_tag && m_message == rule.m_message;
 }
 
+Rule::Level Rule::getLevel() const {
+    return m_level;
+}
+
 bool Rule::match(Level level, const std::string& source, const std::string& tag, const char* text) {
-    return level >= m_level && (m_source.empty() || std::regex_match(source, m_sourceRegex)) &&
-           (m_tag.empty() || std::regex_match(tag, m_tagRegex)) &&
-           (m_message.empty() || std::regex_match(text, m_messageRegex));
+    return level >= m_level && matchSource(source, tag) && matchMessage(level, text);
+}
+
+bool Rule::matchSource(const std::string& source, const std::string& tag) {
+    return (m_source.empty() || std::regex_match(source, m_sourceRegex)) &&
+           (m_tag.empty() || std::regex_match(tag, m_tagRegex));
+}
+
+bool Rule::matchMessage(Level level, const char* text) {
+    return level >= m_level && (m_message.empty() || std::regex_match(text, m_messageRegex));
+}
+
+bool Rule::hasMessagePattern() const {
+    return !m_message.empty();
 }
 
 }  // namespace sink
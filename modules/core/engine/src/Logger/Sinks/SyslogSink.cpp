@@ -15,7 +15,13 @@
 
 #ifndef NO_SYSLOG
 #include <syslog.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 #endif
+#include <cerrno>
+#include <cstring>
+#include <ctime>
 #include <iostream>
 
 #include <AACE/Engine/Logger/Sinks/SyslogSink.h>
@@ -27,6 +33,42 @@ namespace engine {
 namespace logger {
 namespace sink {
 
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.logger.sink.SyslogSink");
+
+const std::string SyslogSink::DEFAULT_SOCKET_PATH = "/dev/log";
+
+#ifndef NO_SYSLOG
+static int toSyslogLevel(Sink::Level level) {
+    switch (level) {
+        case Sink::Level::VERBOSE:
+            return LOG_DEBUG;
+        case Sink::Level::INFO:
+            return LOG_INFO;
+        case Sink::Level::WARN:
+            return LOG_WARNING;
+        case Sink::Level::ERROR:
+            return LOG_ERR;
+        case Sink::Level::CRITICAL:
+            return LOG_CRIT;
+        case Sink::Level::METRIC:
+            return LOG_INFO;
+        default:
+            AACE_NOT_REACHED;
+            return LOG_ERR;
+    }
+}
+
+/// Returns the ident of the messages, which is the program name like with @c openlog(nullptr, ...)
+static std::string getIdent() {
+#ifdef __GLIBC__
+    return program_invocation_short_name;
+#else
+    return "aace";
+#endif
+}
+#endif
+
 SyslogSink::SyslogSink(const std::string& id) : Sink(id) {
 #ifndef NO_SYSLOG
     openlog(nullptr, 0, LOG_USER);
@@ -38,7 +80,22 @@ SyslogSink::SyslogSink(const std::string& id) : Sink(id) {
 }
 
 SyslogSink::~SyslogSink() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_wakeTrigger.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
 #ifndef NO_SYSLOG
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_batch.empty()) {
+        sendBatchLocked();
+    }
+    if (m_socket >= 0) {
+        ::close(m_socket);
+    }
     closelog();
 #endif
 }
@@ -47,6 +104,42 @@ std::shared_ptr<SyslogSink> SyslogSink::create(const std::string& id) {
     return std::shared_ptr<SyslogSink>(new SyslogSink(id));
 }
 
+std::shared_ptr<SyslogSink> SyslogSink::create(
+    const std::string& id,
+    uint32_t batchSize,
+    std::chrono::milliseconds flushInterval,
+    const std::string& socketPath) {
+    try {
+        auto sink = std::shared_ptr<SyslogSink>(new SyslogSink(id));
+        ReturnIf(batchSize == 0, sink);
+#ifndef NO_SYSLOG
+        sockaddr_un address;
+        ThrowIf(socketPath.empty() || socketPath.size() >= sizeof(address.sun_path), "invalidSocketPath");
+
+        sink->m_batchSize = batchSize;
+        sink->m_flushInterval = flushInterval;
+        sink->m_socketPath = socketPath;
+        sink->m_header = getIdent() + "[" + std::to_string(getpid()) + "]: ";
+        sink->m_batch.reserve(batchSize);
+
+        // the messages are written with syslog() until the socket can be opened
+        std::lock_guard<std::mutex> lock(sink->m_mutex);
+        if (!sink->openSocketLocked()) {
+            AACE_WARN(LX(TAG, "create").d("reason", "openSocketFailed").d("socketPath", socketPath));
+        }
+
+        // start the thread that sends the batch every flush interval
+        if (flushInterval.count() > 0) {
+            sink->m_thread = std::thread(&SyslogSink::run, sink.get());
+        }
+#endif
+        return sink;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
 void SyslogSink::log(
     Level level,
     std::chrono::system_clock::time_point time,
@@ -54,45 +147,136 @@ void SyslogSink::log(
     const char* threadMoniker,
     const char* text) {
 #ifndef NO_SYSLOG
-    int syslogLevel = LOG_ERR;
+    int syslogLevel = toSyslogLevel(level);
+    auto message = m_formatter->format(level, std::chrono::system_clock::time_point(), source, threadMoniker, text);
 
-    switch (level) {
-        case Level::VERBOSE:
-            syslogLevel = LOG_DEBUG;
-            break;
+    if (m_batchSize == 0) {
+        syslog(syslogLevel, "%s", message.c_str());
+        return;
+    }
 
-        case Level::INFO:
-            syslogLevel = LOG_INFO;
-            break;
+    // format the message like syslog(): <priority>timestamp ident[pid]: text
+    int priority = LOG_USER | syslogLevel;
+    char timestamp[32];
+    auto seconds = std::chrono::system_clock::to_time_t(time);
+    struct tm local;
+    localtime_r(&seconds, &local);
+    auto length = std::strftime(timestamp, sizeof(timestamp), "%b %e %H:%M:%S ", &local);
 
-        case Level::WARN:
-            syslogLevel = LOG_WARNING;
-            break;
+    Message next;
+    next.priority = priority;
+    next.datagram.reserve(8 + length + m_header.size() + message.size());
+    next.datagram.append("<").append(std::to_string(priority)).append(">");
+    next.datagram.append(timestamp, length).append(m_header);
+    next.textOffset = next.datagram.size();
+    next.datagram.append(message);
 
-        case Level::ERROR:
-            syslogLevel = LOG_ERR;
-            break;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_batch.push_back(std::move(next));
 
-        case Level::CRITICAL:
-            syslogLevel = LOG_CRIT;
-            break;
+    // errors are written at once, in case the process is about to terminate
+    if (m_batch.size() >= m_batchSize || level >= Level::ERROR) {
+        sendBatchLocked();
+    }
+#endif
+}
 
-        case Level::METRIC:
-            syslogLevel = LOG_INFO;
-            break;
+void SyslogSink::flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_batch.empty()) {
+        sendBatchLocked();
+    }
+}
 
-        default:
-            syslogLevel = LOG_ERR;
-            AACE_NOT_REACHED;
+bool SyslogSink::openSocketLocked() {
+#ifndef NO_SYSLOG
+    if (m_socket >= 0) {
+        ::close(m_socket);
+        m_socket = -1;
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    ReturnIf(fd < 0, false);
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, m_socketPath.c_str(), sizeof(address.sun_path) - 1);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return false;
     }
 
-    syslog(
-        syslogLevel,
-        "%s",
-        m_formatter->format(level, std::chrono::system_clock::time_point(), source, threadMoniker, text).c_str());
+    m_socket = fd;
+    return true;
+#else
+    return false;
 #endif
 }
 
+bool SyslogSink::sendBatchLocked() {
+#ifndef NO_SYSLOG
+    size_t sent = 0;
+    bool reopened = false;
+
+    while (sent < m_batch.size() && (m_socket >= 0 || (!reopened && openSocketLocked()))) {
+#ifdef __linux__
+        // a single system call writes the batch
+        size_t count = m_batch.size() - sent;
+        std::vector<iovec> iov(count);
+        std::vector<mmsghdr> messages(count);
+        for (size_t j = 0; j < count; j++) {
+            auto& datagram = m_batch[sent + j].datagram;
+            iov[j].iov_base = const_cast<char*>(datagram.data());
+            iov[j].iov_len = datagram.size();
+            messages[j].msg_hdr.msg_iov = &iov[j];
+            messages[j].msg_hdr.msg_iovlen = 1;
+        }
+        int result = ::sendmmsg(m_socket, messages.data(), static_cast<unsigned int>(count), 0);
+#else
+        auto& datagram = m_batch[sent].datagram;
+        int result = ::send(m_socket, datagram.data(), datagram.size(), 0) < 0 ? -1 : 1;
+#endif
+        if (result > 0) {
+            sent += static_cast<size_t>(result);
+        } else if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (!reopened) {
+            // the daemon may have been restarted, reconnect once
+            reopened = true;
+            ::close(m_socket);
+            m_socket = -1;
+        } else {
+            break;
+        }
+    }
+
+    // the messages which could not be written to the socket are written with syslog()
+    bool success = sent == m_batch.size();
+    for (size_t j = sent; j < m_batch.size(); j++) {
+        auto& message = m_batch[j];
+        syslog(message.priority, "%s", message.datagram.c_str() + message.textOffset);
+    }
+    m_batch.clear();
+    return success;
+#else
+    m_batch.clear();
+    return false;
+#endif
+}
+
+void SyslogSink::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_shutdown) {
+        m_wakeTrigger.wait_for(lock, m_flushInterval, [this]() { return m_shutdown; });
+
+        // send the messages that have been batched for longer than the flush interval
+        if (!m_batch.empty()) {
+            sendBatchLocked();
+        }
+    }
+}
+
 }  // namespace sink
 }  // namespace logger
 }  // namespace engine
@@ -14,9 +14,7 @@
  */
 
 #include <atomic>
-#include <cstring>
-#include <iomanip>
-#include <sstream>
+#include <cstdio>
 
 #include "AACE/Engine/Logger/ThreadMoniker.h"
 
@@ -30,10 +28,7 @@ thread_local ThreadMoniker ThreadMoniker::m_threadMoniker;
 static std::atomic<int> g_nextThreadMoniker(1);
 
 ThreadMoniker::ThreadMoniker() : m_moniker{} {
-    std::ostringstream stream;
-    stream << std::setw(3) << std::hex << std::right << g_nextThreadMoniker++;
-    auto moniker = stream.str();
-    std::strncpy(m_moniker, moniker.c_str(), sizeof(m_moniker) - 1);
+    std::snprintf(m_moniker, sizeof(m_moniker), "%3x", static_cast<unsigned>(g_nextThreadMoniker++));
 }
 
 const char* ThreadMoniker::getThisThreadMoniker() {
@@ -0,0 +1,231 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/MessageBroker/DispatchLane.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+using namespace aace::engine::utils::metrics;
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.messageBroker.DispatchLane");
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "MessageBroker";
+
+/// Metric datapoints of a queue overflow
+static const std::string METRIC_LANE = "Lane";
+static const std::string METRIC_QUEUE_DEPTH = "QueueDepth";
+static const std::string METRIC_MAX_QUEUE_DEPTH = "MaxQueueDepth";
+static const std::string METRIC_REJECTED = "Rejected";
+static const std::string METRIC_DROPPED = "Dropped";
+static const std::string METRIC_COALESCED = "Coalesced";
+
+/// The shortest time between two overflow reports of a lane
+static const std::chrono::seconds OVERFLOW_REPORT_INTERVAL(1);
+
+constexpr size_t DispatchLane::PRIORITY_COUNT;
+constexpr size_t DispatchLane::DEFAULT_STARVATION_LIMIT;
+
+DispatchLane::DispatchLane(const std::string& name, std::shared_ptr<const Config> config, size_t queueSize) :
+        m_name(name),
+        m_config(config != nullptr && (!config->priorities.empty() || queueSize > 0) ? config : nullptr),
+        m_queueSize(queueSize),
+        m_executor(name) {
+}
+
+DispatchLane::Priority DispatchLane::getPriority(const std::string& topic) const {
+    if (m_config == nullptr) {
+        return Priority::NORMAL;
+    }
+    auto it = m_config->priorities.find(topic);
+    return it != m_config->priorities.end() ? it->second : Priority::NORMAL;
+}
+
+DispatchLane::OverflowPolicy DispatchLane::getOverflowPolicy(const std::string& topic) const {
+    if (m_config == nullptr) {
+        return OverflowPolicy::REJECT;
+    }
+    auto& policies = m_config->overflowPolicies;
+    auto it = policies.find(topic);
+    if (it == policies.end()) {
+        it = policies.find("*");
+    }
+    return it != policies.end() ? it->second : OverflowPolicy::REJECT;
+}
+
+bool DispatchLane::isBounded() const {
+    return m_queueSize > 0;
+}
+
+bool DispatchLane::enqueue(const std::string& topic, const std::string& key, UniqueTask task, bool bounded) {
+    // the dropped task is destroyed after the lock is released
+    UniqueTask dropped;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto& queue = m_queues[static_cast<size_t>(getPriority(topic))];
+
+    if (bounded && m_queueSize > 0 && m_waiting >= m_queueSize) {
+        // the tasks of a topic share a priority class, so only its queue has tasks to drop
+        auto policy = getOverflowPolicy(topic);
+        auto victim = queue.end();
+        if (policy == OverflowPolicy::DROP_OLDEST) {
+            victim = std::find_if(
+                queue.begin(), queue.end(), [&topic](const Entry& e) { return !e.key.empty() && e.topic == topic; });
+        } else if (policy == OverflowPolicy::COALESCE && !key.empty()) {
+            victim = std::find_if(queue.begin(), queue.end(), [&key](const Entry& e) { return e.key == key; });
+        }
+
+        if (victim == queue.end()) {
+            m_metrics.rejected++;
+            dropped = std::move(task);
+            reportOverflow(lock);
+            return false;
+        }
+
+        // the newer task is queued after the other tasks of its topic, and reuses the executor
+        // task of the dropped task
+        if (policy == OverflowPolicy::COALESCE) {
+            m_metrics.coalesced++;
+        } else {
+            m_metrics.dropped++;
+        }
+        dropped = std::move(victim->task);
+        queue.erase(victim);
+        queue.push_back({topic, key, std::move(task)});
+        reportOverflow(lock);
+        return true;
+    }
+
+    queue.push_back({topic, key, std::move(task)});
+
+    // each executor task runs the next task by priority, rather than the task it was posted for
+    if (!m_executor.post([this]() { dispatchNext(); })) {
+        dropped = std::move(queue.back().task);
+        queue.pop_back();
+        return false;
+    }
+    m_waiting++;
+    m_metrics.maxQueueDepth = std::max(m_metrics.maxQueueDepth, m_waiting);
+    return true;
+}
+
+void DispatchLane::dispatchNext() {
+    UniqueTask task;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // a starved class from the lowest, or else the highest class with a waiting task
+        auto starvationLimit = std::max<size_t>(m_config->starvationLimit, 1);
+        size_t next = PRIORITY_COUNT;
+        for (size_t index = PRIORITY_COUNT; index-- > 0 && next == PRIORITY_COUNT;) {
+            if (!m_queues[index].empty() && m_passed[index] >= starvationLimit) {
+                next = index;
+            }
+        }
+        for (size_t index = 0; index < PRIORITY_COUNT && next == PRIORITY_COUNT; index++) {
+            if (!m_queues[index].empty()) {
+                next = index;
+            }
+        }
+        if (next == PRIORITY_COUNT) {
+            return;
+        }
+
+        task = std::move(m_queues[next].front().task);
+        m_queues[next].pop_front();
+        m_waiting--;
+        m_passed[next] = 0;
+        for (size_t index = next + 1; index < PRIORITY_COUNT; index++) {
+            if (!m_queues[index].empty()) {
+                m_passed[index]++;
+            }
+        }
+    }
+    task();
+}
+
+void DispatchLane::reportOverflow(std::unique_lock<std::mutex>& lock) {
+    auto now = std::chrono::steady_clock::now();
+    if (m_lastReport != std::chrono::steady_clock::time_point() && now - m_lastReport < OVERFLOW_REPORT_INTERVAL) {
+        return;
+    }
+    m_lastReport = now;
+
+    auto metrics = m_metrics;
+    metrics.queueDepth = m_waiting;
+    auto rejected = static_cast<int>(metrics.rejected - m_reported.rejected);
+    auto dropped = static_cast<int>(metrics.dropped - m_reported.dropped);
+    auto coalesced = static_cast<int>(metrics.coalesced - m_reported.coalesced);
+    m_reported = metrics;
+    lock.unlock();
+
+    AACE_WARN(LX(TAG)
+                  .m("dispatchQueueFull")
+                  .d("lane", m_name)
+                  .d("queueDepth", metrics.queueDepth)
+                  .d("rejected", rejected)
+                  .d("dropped", dropped)
+                  .d("coalesced", coalesced));
+    emitMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX,
+        "dispatchQueueOverflow",
+        {{METRIC_QUEUE_DEPTH, static_cast<int>(metrics.queueDepth)},
+         {METRIC_MAX_QUEUE_DEPTH, static_cast<int>(metrics.maxQueueDepth)},
+         {METRIC_REJECTED, rejected},
+         {METRIC_DROPPED, dropped},
+         {METRIC_COALESCED, coalesced}},
+        {{METRIC_LANE, m_name}},
+        {});
+}
+
+void DispatchLane::waitForSubmittedTasks() {
+    m_executor.waitForSubmittedTasks();
+}
+
+void DispatchLane::shutdown() {
+    m_executor.shutdown();
+
+    // the waiting tasks are destroyed, which breaks the promises of the submitted tasks
+    std::deque<Entry> dropped[PRIORITY_COUNT];
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t index = 0; index < PRIORITY_COUNT; index++) {
+            std::swap(dropped[index], m_queues[index]);
+        }
+        m_waiting = 0;
+    }
+}
+
+size_t DispatchLane::queueSize() {
+    return m_executor.queueSize();
+}
+
+DispatchLane::Metrics DispatchLane::getMetrics() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto metrics = m_metrics;
+    metrics.queueDepth = m_config != nullptr ? m_waiting : m_executor.queueSize();
+    return metrics;
+}
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
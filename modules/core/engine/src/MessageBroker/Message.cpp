@@ -16,8 +16,11 @@
 #include <AACE/Engine/MessageBroker/Message.h>
 #include <AACE/Engine/Core/EngineMacros.h>
 #include <AACE/Engine/Utils/UUID/UUID.h>
+#include <AACE/Engine/Utils/JSON/OnDemandReader.h>
 #include <AACE/Engine/Utils/String/StringUtils.h>
 
+#include <atomic>
+
 namespace aace {
 namespace engine {
 namespace messageBroker {
@@ -28,96 +31,338 @@ static const std::string TAG("aace.messageBroker.Message");
 // symbolic constants
 const Message Message::INVALID = Message();
 
-Message::Message() : m_direction(Direction::OUTGOING) {
+// serialization format used for all messages
+static std::atomic<Message::SerializationFormat> s_serializationFormat{Message::SerializationFormat::PRETTY};
+
+#ifdef AAC_JSON_HEADER_SCANNER_SAX
+/**
+ * SAX handler that extracts the message header fields without building a document for the
+ * message. The scan stops as soon as the header object has been read.
+ */
+class HeaderScanner : public nlohmann::json_sax<nlohmann::json> {
+public:
+    bool null() override {
+        return true;
+    }
+    bool boolean(bool val) override {
+        return true;
+    }
+    bool number_integer(number_integer_t val) override {
+        return true;
+    }
+    bool number_unsigned(number_unsigned_t val) override {
+        return true;
+    }
+    bool number_float(number_float_t val, const string_t& s) override {
+        return true;
+    }
+    bool binary(binary_t& val) override {
+        return true;
+    }
+
+    bool string(string_t& val) override {
+        if (inHeader()) {
+            if (m_key == "id") {
+                id = std::move(val);
+            } else if (m_key == "messageType") {
+                messageType = std::move(val);
+            }
+        } else if (inMessageDescription()) {
+            if (m_key == "topic") {
+                topic = std::move(val);
+            } else if (m_key == "action") {
+                action = std::move(val);
+            } else if (m_key == "replyToId") {
+                replyTo = std::move(val);
+            }
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t elements) override {
+        m_path.push_back(m_key);
+        m_key.clear();
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        m_key = val;
+        return true;
+    }
+
+    bool end_object() override {
+        auto closed = m_path.back();
+        m_path.pop_back();
+        m_key.clear();
+
+        // stop scanning once the top level header object is complete
+        if (m_path.size() == 1 && closed == "header") {
+            headerComplete = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t elements) override {
+        m_path.push_back(m_key);
+        m_key.clear();
+        return true;
+    }
+
+    bool end_array() override {
+        m_path.pop_back();
+        m_key.clear();
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string& lastToken, const nlohmann::detail::exception& ex)
+        override {
+        error = ex.what();
+        return false;
+    }
+
+private:
+    bool inHeader() const {
+        return m_path.size() == 2 && m_path[1] == "header";
+    }
+
+    bool inMessageDescription() const {
+        return m_path.size() == 3 && m_path[1] == "header" && m_path[2] == "messageDescription";
+    }
+
+public:
+    bool headerComplete = false;
+    std::string error;
+
+    std::string id;
+    std::string messageType;
+    std::string topic;
+    std::string action;
+    std::string replyTo;
+
+private:
+    std::vector<std::string> m_path;
+    std::string m_key;
+};
+#endif  // AAC_JSON_HEADER_SCANNER_SAX
+
+Message::Message() : m_envelope(std::make_shared<Envelope>()), m_direction(Direction::OUTGOING) {
+}
+
+Message::Message(const std::string& msg, Direction direction, ParseMode mode) :
+        m_envelope(std::make_shared<Envelope>()), m_direction(direction) {
+    m_envelope->raw = msg;
+    parse(mode);
+}
+
+Message::Message(std::string&& msg, Direction direction, ParseMode mode) :
+        m_envelope(std::make_shared<Envelope>()), m_direction(direction) {
+    m_envelope->raw = std::move(msg);
+    parse(mode);
 }
 
-Message::Message(const std::string& msg, Direction direction) {
+void Message::parse(ParseMode mode) {
     try {
-        m_message = nlohmann::json::parse(msg);
-        ThrowIf(m_message.is_null(), "invalidMessage");
+        if (mode == ParseMode::LAZY) {
+            scanHeader(*m_envelope);
+        } else {
+            auto& envelope = *m_envelope;
+            std::call_once(envelope.parsed, [&envelope]() { envelope.json = nlohmann::json::parse(envelope.raw); });
+            parseHeader(envelope);
+        }
+        m_valid = true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("msg", m_envelope->raw));
+    }
+}
 
-        auto messageType = m_message["/header/messageType"_json_pointer];
-        ThrowIfNull(messageType, "missingMessageType");
+void Message::setSerializationFormat(SerializationFormat format) {
+    s_serializationFormat = format;
+}
+
+Message::SerializationFormat Message::getSerializationFormat() {
+    return s_serializationFormat;
+}
 
-        auto messageId = m_message["/header/id"_json_pointer];
-        ThrowIfNull(messageId, "missingMessageId");
+int Message::indent(SerializationFormat format) {
+    return format == SerializationFormat::PRETTY ? 3 : -1;
+}
 
-        m_messageId = messageId;
+void Message::parseHeader(Envelope& envelope) {
+    auto& message = envelope.json;
+    ThrowIfNot(message.is_object(), "invalidMessage");
 
-        if (aace::engine::utils::string::equal(messageType.get<std::string>(), "publish", false)) {
-            m_messageType = MessageType::PUBLISH;
+    auto messageType = message.value("/header/messageType"_json_pointer, nlohmann::json());
+    ThrowIfNull(messageType, "missingMessageType");
 
-            auto topic = m_message["/header/messageDescription/topic"_json_pointer];
-            ThrowIfNull(topic, "missingMessageTopic");
+    auto messageId = message.value("/header/id"_json_pointer, nlohmann::json());
+    ThrowIfNull(messageId, "missingMessageId");
 
-            auto action = m_message["/header/messageDescription/action"_json_pointer];
-            ThrowIfNull(action, "missingMessageAction");
+    envelope.messageId = messageId;
 
-            m_topic = topic;
-            m_action = action;
-        } else if (aace::engine::utils::string::equal(messageType.get<std::string>(), "reply", false)) {
-            m_messageType = MessageType::REPLY;
+    if (aace::engine::utils::string::equal(messageType.get<std::string>(), "publish", false)) {
+        envelope.messageType = MessageType::PUBLISH;
+    } else if (aace::engine::utils::string::equal(messageType.get<std::string>(), "reply", false)) {
+        envelope.messageType = MessageType::REPLY;
 
-            auto replyTo = m_message["/header/messageDescription/replyToId"_json_pointer];
-            ThrowIfNull(replyTo, "missingReplyTo");
+        auto replyTo = message.value("/header/messageDescription/replyToId"_json_pointer, nlohmann::json());
+        ThrowIfNull(replyTo, "missingReplyTo");
 
-            auto topic = m_message["/header/messageDescription/topic"_json_pointer];
-            ThrowIfNull(topic, "missingMessageTopic");
+        envelope.replyTo = replyTo;
+    } else {
+        Throw("invalidMessageType");
+    }
 
-            auto action = m_message["/header/messageDescription/action"_json_pointer];
-            ThrowIfNull(action, "missingMessageAction");
+    auto topic = message.value("/header/messageDescription/topic"_json_pointer, nlohmann::json());
+    ThrowIfNull(topic, "missingMessageTopic");
 
-            m_replyTo = replyTo;
-            m_topic = topic;
-            m_action = action;
-        } else {
-            Throw("invalidMessageType");
+    auto action = message.value("/header/messageDescription/action"_json_pointer, nlohmann::json());
+    ThrowIfNull(action, "missingMessageAction");
+
+    envelope.topic = topic;
+    envelope.action = action;
+}
+
+void Message::readHeader(const std::string& text, HeaderFields& fields) {
+    aace::engine::utils::json::OnDemandReader reader(text);
+    ThrowIfNot(reader.enterObject(), "invalidMessage");
+
+    // read the header fields, and stop at the end of the header object without reading the payload
+    bool headerComplete = false;
+    std::string key;
+    while (!headerComplete && reader.nextField(key)) {
+        if (key != "header" || !reader.enterObject()) {
+            continue;
+        }
+        while (reader.nextField(key)) {
+            if (key == "id") {
+                reader.readString(fields.id);
+            } else if (key == "messageType") {
+                reader.readString(fields.messageType);
+            } else if (key == "messageDescription" && reader.enterObject()) {
+                while (reader.nextField(key)) {
+                    if (key == "topic") {
+                        reader.readString(fields.topic);
+                    } else if (key == "action") {
+                        reader.readString(fields.action);
+                    } else if (key == "replyToId") {
+                        reader.readString(fields.replyTo);
+                    }
+                }
+            }
         }
+        headerComplete = !reader.failed();
+    }
 
-        m_direction = direction;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("msg", msg));
-        m_message = nullptr;
+    ThrowIf(reader.failed(), reader.error());
+    ThrowIfNot(headerComplete, "missingHeader");
+}
+
+void Message::scanHeader(Envelope& envelope) {
+#ifdef AAC_JSON_HEADER_SCANNER_SAX
+    HeaderScanner scanner;
+    nlohmann::json::sax_parse(envelope.raw, &scanner);
+
+    ThrowIfNot(scanner.error.empty(), scanner.error);
+    ThrowIfNot(scanner.headerComplete, "missingHeader");
+#else
+    HeaderFields scanner;
+    readHeader(envelope.raw, scanner);
+#endif
+    ThrowIf(scanner.messageType.empty(), "missingMessageType");
+    ThrowIf(scanner.id.empty(), "missingMessageId");
+
+    envelope.messageId = std::move(scanner.id);
+
+    if (aace::engine::utils::string::equal(scanner.messageType, "publish", false)) {
+        envelope.messageType = MessageType::PUBLISH;
+    } else if (aace::engine::utils::string::equal(scanner.messageType, "reply", false)) {
+        envelope.messageType = MessageType::REPLY;
+        ThrowIf(scanner.replyTo.empty(), "missingReplyTo");
+        envelope.replyTo = std::move(scanner.replyTo);
+    } else {
+        Throw("invalidMessageType");
+    }
+
+    ThrowIf(scanner.topic.empty(), "missingMessageTopic");
+    ThrowIf(scanner.action.empty(), "missingMessageAction");
+
+    envelope.topic = std::move(scanner.topic);
+    envelope.action = std::move(scanner.action);
+}
+
+const nlohmann::json& Message::document() const {
+    static const nlohmann::json s_null;
+
+    if (!m_valid) {
+        return s_null;
     }
+
+    auto& envelope = *m_envelope;
+    std::call_once(envelope.parsed, [&envelope]() {
+        try {
+            // a message created from an object is converted without serializing it
+            envelope.json = envelope.toJson ? envelope.toJson() : nlohmann::json::parse(envelope.raw);
+        } catch (std::exception& ex) {
+            AACE_ERROR(LX(TAG, "document").d("reason", ex.what()).d("messageId", envelope.messageId));
+        }
+    });
+
+    return envelope.json;
 }
 
 bool Message::valid() const {
-    return !m_message.is_null();
+    return m_valid;
 }
 
 const std::string& Message::messageId() const {
-    return m_messageId;
+    return m_envelope->messageId;
 }
 
 Message::MessageType Message::messageType() const {
-    return m_messageType;
+    return m_envelope->messageType;
 }
 
 const std::string& Message::topic() const {
-    return m_topic;
+    return m_envelope->topic;
 }
 
 const std::string& Message::action() const {
-    return m_action;
+    return m_envelope->action;
 }
 
 const std::string& Message::replyTo() const {
-    return m_replyTo;
+    return m_envelope->replyTo;
 }
 
 std::string Message::payload() const {
     try {
-        auto payloadIt = m_message.find("payload");
-        ThrowIf(payloadIt == m_message.end(), "missingPayloadInMessage");
-        ThrowIfNot(payloadIt->is_object(), "invalidPayloadType");
+        auto& payload = payloadJson();
+        if (payload.is_null()) {
+            return std::string();
+        }
+        ThrowIfNot(payload.is_object(), "invalidPayloadType");
 
-        return payloadIt->get<nlohmann::json>().dump(3);
+        return payload.dump(indent(s_serializationFormat));
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return std::string();
     }
 }
 
+const nlohmann::json& Message::payloadJson() const {
+    static const nlohmann::json s_null;
+
+    auto& message = document();
+    auto payloadIt = message.find("payload");
+    if (payloadIt == message.end()) {
+        AACE_ERROR(LX(TAG).d("reason", "missingPayloadInMessage"));
+        return s_null;
+    }
+
+    return *payloadIt;
+}
+
 Message::Direction Message::direction() const {
     return m_direction;
 }
@@ -127,7 +372,30 @@ Message::Direction Message::replyDirection() const {
 }
 
 std::string Message::str() const {
-    return m_message.dump(3);
+    return str(s_serializationFormat);
+}
+
+std::string Message::str(SerializationFormat format) const {
+    if (format == SerializationFormat::COMPACT && m_valid) {
+        // the message is immutable, so the original message text can be forwarded as is
+        return raw();
+    }
+    return document().dump(indent(format));
+}
+
+const std::string& Message::raw() const {
+    auto& envelope = *m_envelope;
+    if (envelope.toJson) {
+        std::call_once(envelope.serialized, [this, &envelope]() { envelope.raw = document().dump(); });
+    }
+    return envelope.raw;
+}
+
+std::vector<uint8_t> Message::binary() const {
+    if (!m_valid) {
+        return {};
+    }
+    return nlohmann::json::to_cbor(document());
 }
 
 }  // namespace messageBroker
@@ -21,6 +21,7 @@
 
 #include <AACE/Engine/MessageBroker/MessageBrokerEngineService.h>
 #include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/String/StringUtils.h>
 
 namespace aace {
 namespace engine {
@@ -62,7 +63,14 @@ bool MessageBrokerEngineService::initialize() {
 
 bool MessageBrokerEngineService::shutdown() {
     try {
+        stopReplay();
         m_messageBroker->shutdown();
+        m_streamManager->shutdown();
+        if (m_trafficRecorder != nullptr) {
+            m_messageBroker->setTrafficRecorder(nullptr);
+            m_trafficRecorder->close();
+            m_trafficRecorder.reset();
+        }
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -74,6 +82,8 @@ bool MessageBrokerEngineService::configure() {
     try {
         m_configuredVersion = m_currentVersion;
         m_autoEnableInterfaces = true;
+        m_platformDeliveryConfig = PlatformDeliveryConfig();
+        Message::setSerializationFormat(Message::SerializationFormat::PRETTY);
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -107,6 +117,214 @@ bool MessageBrokerEngineService::configure(std::shared_ptr<std::istream> configu
         // set the configured message broker message timeout
         m_messageBroker->setMessageTimeout(std::chrono::milliseconds(m_defaultMessageTimeout));
 
+        // set the number of dispatch lanes per message direction
+        auto dispatchLanes = root["/dispatchLanes"_json_pointer];
+        if (dispatchLanes != nullptr) {
+            ThrowIfNot(
+                dispatchLanes.is_number_unsigned() && dispatchLanes.get<uint16_t>() > 0, "invalidConfiguration");
+            m_messageBroker->setDispatchLaneCount(dispatchLanes.get<uint16_t>());
+        }
+
+        // set the dispatch metrics sampling interval
+        auto metricsSampleInterval = root["/metricsSampleInterval"_json_pointer];
+        if (metricsSampleInterval != nullptr) {
+            ThrowIfNot(metricsSampleInterval.is_number_unsigned(), "invalidConfiguration");
+            m_messageBroker->setMetricsSampleInterval(metricsSampleInterval.get<uint32_t>());
+        }
+
+        // adapt the reply timeouts to the reply latency of each topic and action
+        auto adaptiveTimeouts = root["/adaptiveTimeouts"_json_pointer];
+        if (adaptiveTimeouts != nullptr) {
+            ThrowIfNot(adaptiveTimeouts.is_object(), "invalidConfiguration");
+            ReplyLatencyTracker::Config config;
+            config.enabled = adaptiveTimeouts.value("enabled", true);
+            config.multiplier = adaptiveTimeouts.value("multiplier", config.multiplier);
+            config.minSamples = adaptiveTimeouts.value("minSamples", config.minSamples);
+            auto readLimits = [](const nlohmann::json& json, ReplyLatencyTracker::Limits limits) {
+                auto minTimeout = json.value("minTimeout", static_cast<int64_t>(limits.minTimeout.count()));
+                auto maxTimeout = json.value("maxTimeout", static_cast<int64_t>(limits.maxTimeout.count()));
+                ThrowIf(minTimeout <= 0 || maxTimeout < minTimeout, "invalidAdaptiveTimeoutLimits");
+                return ReplyLatencyTracker::Limits(
+                    std::chrono::milliseconds(minTimeout), std::chrono::milliseconds(maxTimeout));
+            };
+            config.limits = readLimits(adaptiveTimeouts, config.limits);
+            ThrowIfNot(config.multiplier > 0 && config.minSamples > 0, "invalidAdaptiveTimeouts");
+            auto topics = adaptiveTimeouts["/topics"_json_pointer];
+            if (topics != nullptr) {
+                ThrowIfNot(topics.is_array(), "invalidConfiguration");
+                for (auto& next : topics) {
+                    ThrowIfNot(next.is_object(), "invalidAdaptiveTimeoutLimits");
+                    auto topic = next.value("topic", std::string());
+                    auto action = next.value("action", std::string());
+                    ThrowIf(topic.empty(), "invalidAdaptiveTimeoutLimits");
+                    config.topicLimits[action.empty() ? topic : topic + ":" + action] =
+                        readLimits(next, config.limits);
+                }
+            }
+            m_messageBroker->setAdaptiveTimeouts(config);
+        }
+
+        // set the coalescing policies of the incoming state messages
+        auto coalescing = root["/coalescing"_json_pointer];
+        if (coalescing != nullptr) {
+            ThrowIfNot(coalescing.is_array(), "invalidConfiguration");
+            for (auto& next : coalescing) {
+                ThrowIfNot(next.is_object(), "invalidCoalescingPolicy");
+                auto topic = next.value("topic", std::string());
+                auto action = next.value("action", std::string("*"));
+                auto minInterval = next.value("minInterval", 0);
+                ThrowIf(topic.empty() || minInterval < 0, "invalidCoalescingPolicy");
+                m_messageBroker->setCoalescingPolicy(
+                    topic, action, std::chrono::milliseconds(minInterval), next.value("partition", std::string()));
+            }
+        }
+
+        // set the priority classes of the message topics
+        auto priorities = root["/priorities"_json_pointer];
+        if (priorities != nullptr) {
+            ThrowIfNot(priorities.is_object(), "invalidConfiguration");
+            DispatchLane::PriorityMap priorityMap;
+            auto topics = priorities["/topics"_json_pointer];
+            if (topics != nullptr) {
+                ThrowIfNot(topics.is_array(), "invalidConfiguration");
+                for (auto& next : topics) {
+                    ThrowIfNot(next.is_object(), "invalidTopicPriority");
+                    auto topic = next.value("topic", std::string());
+                    auto priority = next.value("priority", std::string());
+                    ThrowIf(topic.empty(), "invalidTopicPriority");
+                    if (aace::engine::utils::string::equal(priority, "HIGH", false)) {
+                        priorityMap[topic] = DispatchLane::Priority::HIGH;
+                    } else if (aace::engine::utils::string::equal(priority, "NORMAL", false)) {
+                        priorityMap[topic] = DispatchLane::Priority::NORMAL;
+                    } else if (aace::engine::utils::string::equal(priority, "LOW", false)) {
+                        priorityMap[topic] = DispatchLane::Priority::LOW;
+                    } else {
+                        Throw("invalidTopicPriority");
+                    }
+                }
+            }
+            size_t starvationLimit = DispatchLane::DEFAULT_STARVATION_LIMIT;
+            auto starvation = priorities["/starvationLimit"_json_pointer];
+            if (starvation != nullptr) {
+                ThrowIfNot(
+                    starvation.is_number_unsigned() && starvation.get<uint32_t>() > 0, "invalidStarvationLimit");
+                starvationLimit = starvation.get<uint32_t>();
+            }
+            m_messageBroker->setTopicPriorities(priorityMap, starvationLimit);
+        }
+
+        // set the queue sizes and the overflow policies of the dispatch lanes
+        auto dispatchQueues = root["/dispatchQueues"_json_pointer];
+        if (dispatchQueues != nullptr) {
+            ThrowIfNot(dispatchQueues.is_object(), "invalidConfiguration");
+            size_t incomingQueueSize = 0;
+            size_t outgoingQueueSize = 0;
+            auto incoming = dispatchQueues["/incomingQueueSize"_json_pointer];
+            if (incoming != nullptr) {
+                ThrowIfNot(incoming.is_number_unsigned(), "invalidDispatchQueueSize");
+                incomingQueueSize = incoming.get<size_t>();
+            }
+            auto outgoing = dispatchQueues["/outgoingQueueSize"_json_pointer];
+            if (outgoing != nullptr) {
+                ThrowIfNot(outgoing.is_number_unsigned(), "invalidDispatchQueueSize");
+                outgoingQueueSize = outgoing.get<size_t>();
+            }
+            DispatchLane::OverflowPolicyMap policyMap;
+            auto overflowPolicies = dispatchQueues["/overflowPolicies"_json_pointer];
+            if (overflowPolicies != nullptr) {
+                ThrowIfNot(overflowPolicies.is_array(), "invalidConfiguration");
+                for (auto& next : overflowPolicies) {
+                    ThrowIfNot(next.is_object(), "invalidOverflowPolicy");
+                    auto topic = next.value("topic", std::string());
+                    auto policy = next.value("policy", std::string());
+                    ThrowIf(topic.empty(), "invalidOverflowPolicy");
+                    if (aace::engine::utils::string::equal(policy, "REJECT", false)) {
+                        policyMap[topic] = DispatchLane::OverflowPolicy::REJECT;
+                    } else if (aace::engine::utils::string::equal(policy, "DROP_OLDEST", false)) {
+                        policyMap[topic] = DispatchLane::OverflowPolicy::DROP_OLDEST;
+                    } else if (aace::engine::utils::string::equal(policy, "COALESCE", false)) {
+                        policyMap[topic] = DispatchLane::OverflowPolicy::COALESCE;
+                    } else {
+                        Throw("invalidOverflowPolicy");
+                    }
+                }
+            }
+            m_messageBroker->setDispatchQueueSize(incomingQueueSize, outgoingQueueSize, policyMap);
+        }
+
+        // set the message serialization format
+        auto serializationFormat = root["/serializationFormat"_json_pointer];
+        if (serializationFormat != nullptr) {
+            ThrowIfNot(serializationFormat.is_string(), "invalidConfiguration");
+            auto format = serializationFormat.get<std::string>();
+            if (aace::engine::utils::string::equal(format, "COMPACT", false)) {
+                Message::setSerializationFormat(Message::SerializationFormat::COMPACT);
+            } else if (aace::engine::utils::string::equal(format, "PRETTY", false)) {
+                Message::setSerializationFormat(Message::SerializationFormat::PRETTY);
+            } else {
+                Throw("invalidSerializationFormat");
+            }
+        }
+
+        // set the queue and the overflow policies of the delivery to the platform
+        auto platformDelivery = root["/platformDelivery"_json_pointer];
+        if (platformDelivery != nullptr) {
+            ThrowIfNot(platformDelivery.is_object(), "invalidConfiguration");
+            auto queueSize = platformDelivery["/queueSize"_json_pointer];
+            if (queueSize != nullptr) {
+                ThrowIfNot(queueSize.is_number_unsigned(), "invalidPlatformDeliveryQueueSize");
+                m_platformDeliveryConfig.queueSize = queueSize.get<size_t>();
+            }
+            auto overflowPolicies = platformDelivery["/overflowPolicies"_json_pointer];
+            if (overflowPolicies != nullptr) {
+                ThrowIfNot(overflowPolicies.is_array(), "invalidConfiguration");
+                for (auto& next : overflowPolicies) {
+                    ThrowIfNot(next.is_object(), "invalidOverflowPolicy");
+                    auto topic = next.value("topic", std::string());
+                    auto policy = next.value("policy", std::string());
+                    ThrowIf(topic.empty(), "invalidOverflowPolicy");
+                    if (aace::engine::utils::string::equal(policy, "BLOCK", false)) {
+                        m_platformDeliveryConfig.overflowPolicies[topic] = OverflowPolicy::BLOCK;
+                    } else if (aace::engine::utils::string::equal(policy, "DROP_OLDEST", false)) {
+                        m_platformDeliveryConfig.overflowPolicies[topic] = OverflowPolicy::DROP_OLDEST;
+                    } else if (aace::engine::utils::string::equal(policy, "DROP_NEWEST", false)) {
+                        m_platformDeliveryConfig.overflowPolicies[topic] = OverflowPolicy::DROP_NEWEST;
+                    } else {
+                        Throw("invalidOverflowPolicy");
+                    }
+                }
+            }
+        }
+
+        // record the broker traffic to a file
+        auto trafficRecorder = root["/trafficRecorder"_json_pointer];
+        if (trafficRecorder != nullptr) {
+            ThrowIfNot(trafficRecorder.is_object(), "invalidConfiguration");
+            auto file = trafficRecorder.value("file", std::string());
+            ThrowIf(file.empty(), "invalidTrafficRecorderFile");
+            auto recordStreams = trafficRecorder["/recordStreams"_json_pointer];
+            ThrowIfNot(recordStreams == nullptr || recordStreams.is_boolean(), "invalidConfiguration");
+            m_trafficRecorder =
+                MessageTrafficRecorder::create(file, recordStreams != nullptr && recordStreams.get<bool>());
+            ThrowIfNull(m_trafficRecorder, "createTrafficRecorderFailed");
+            m_messageBroker->setTrafficRecorder(m_trafficRecorder);
+            m_streamManager->setTrafficRecorder(m_trafficRecorder);
+        }
+
+        // replay a recording when the engine is started
+        auto trafficReplay = root["/trafficReplay"_json_pointer];
+        if (trafficReplay != nullptr) {
+            ThrowIfNot(trafficReplay.is_object(), "invalidConfiguration");
+            m_replayFile = trafficReplay.value("file", std::string());
+            ThrowIf(m_replayFile.empty(), "invalidTrafficReplayFile");
+            auto speed = trafficReplay["/speed"_json_pointer];
+            if (speed != nullptr) {
+                ThrowIfNot(speed.is_number() && speed.get<double>() >= 0, "invalidTrafficReplaySpeed");
+                m_replaySpeed = speed.get<double>();
+            }
+            m_replayReportFile = trafficReplay.value("reportFile", std::string());
+        }
+
         auto version = root["/version"_json_pointer];
         if (version != nullptr) {
             ThrowIfNot(version.is_string(), "invalidConfiguration");
@@ -129,6 +347,49 @@ bool MessageBrokerEngineService::setup() {
     }
 }
 
+bool MessageBrokerEngineService::start() {
+    try {
+        ReturnIf(m_replayFile.empty() || m_replayThread.joinable(), true);
+
+        // the recording is replayed once the subscribers of the other services are registered
+        m_trafficReplayer = MessageTrafficReplayer::create(m_messageBroker, m_replayFile, m_replaySpeed);
+        ThrowIfNull(m_trafficReplayer, "createTrafficReplayerFailed");
+        m_replayFile.clear();
+        auto replayer = m_trafficReplayer.get();
+        auto reportFile = m_replayReportFile;
+        m_replayThread = std::thread([replayer, reportFile]() {
+            if (replayer->replay() && !reportFile.empty()) {
+                replayer->writeReport(reportFile);
+            }
+        });
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool MessageBrokerEngineService::stop() {
+    try {
+        stopReplay();
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+void MessageBrokerEngineService::stopReplay() {
+    if (m_trafficReplayer != nullptr) {
+        m_trafficReplayer->stop();
+    }
+    if (m_replayThread.joinable()) {
+        m_replayThread.join();
+    }
+    m_trafficReplayer.reset();
+}
+
 //
 // aace::egnine::message::MessageBrokerServiceInterface
 //
@@ -157,6 +418,10 @@ uint16_t MessageBrokerEngineService::getDefaultMessageTimeout() {
     return m_defaultMessageTimeout;
 }
 
+MessageBrokerServiceInterface::PlatformDeliveryConfig MessageBrokerEngineService::getPlatformDeliveryConfig() {
+    return m_platformDeliveryConfig;
+}
+
 }  // namespace messageBroker
 }  // namespace engine
 }  // namespace aace
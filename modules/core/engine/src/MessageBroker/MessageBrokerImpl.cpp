@@ -16,7 +16,7 @@
 #include <AACE/Engine/MessageBroker/MessageBrokerImpl.h>
 #include <AACE/Engine/Core/EngineMacros.h>
 
-#include <sstream>
+#include <algorithm>
 
 namespace aace {
 namespace engine {
@@ -27,40 +27,216 @@ static const std::string TAG("aace.messageBroker.MessageBrokerImpl");
 
 class MessageImpl;
 
+MessageBrokerImpl::MessageBrokerImpl() :
+        m_dispatchLanes(createDispatchLanes(1)), m_timerWheel(TimerWheel::getDefault()) {
+}
+
 std::shared_ptr<MessageBrokerImpl> MessageBrokerImpl::create() {
     return std::shared_ptr<MessageBrokerImpl>(new MessageBrokerImpl());
 }
 
+MessageBrokerImpl::~MessageBrokerImpl() {
+}
+
 void MessageBrokerImpl::shutdown() {
-    std::lock_guard<std::mutex> lock(m_wait_for_sync_response_mutex);
+    std::lock_guard<std::mutex> lock(m_shutdown_mutex);
     m_isShutdown = true;
-    m_outgoingMessageExecutor.waitForSubmittedTasks();
-    m_incomingMessageExecutor.waitForSubmittedTasks();
+    shutdownDispatchLanes(std::atomic_load(&m_dispatchLanes));
 
-    m_outgoingMessageExecutor.shutdown();
-    m_incomingMessageExecutor.shutdown();
+    // fail the asynchronous requests still waiting for a reply
+    std::unordered_map<std::string, std::shared_ptr<PendingReply>> pendingReplyMap;
+    {
+        std::lock_guard<std::mutex> pendingLock(m_pending_reply_mutex);
+        std::swap(pendingReplyMap, m_pendingReplyMap);
+    }
+    for (auto& next : pendingReplyMap) {
+        cancelReplyTimeout(next.second);
+        if (next.second->executor != nullptr && next.second->errorHandler != nullptr) {
+            next.second->errorHandler();
+        }
+    }
 }
 
 void MessageBrokerImpl::setMessageTimeout(const std::chrono::milliseconds& value) {
     m_timeout = value;
 }
 
-std::string MessageBrokerImpl::getMessageType(
-    Message::Direction direction,
-    const std::string& topic,
-    const std::string& action) {
-    std::stringstream str;
+void MessageBrokerImpl::setDispatchLaneCount(size_t count) {
+    try {
+        ThrowIf(count == 0, "invalidLaneCount");
+        AACE_INFO(LX(TAG).d("count", count));
+
+        std::lock_guard<std::mutex> lock(m_shutdown_mutex);
+        ThrowIf(m_isShutdown, "messageBrokerIsShutdown");
+
+        auto current = std::atomic_load(&m_dispatchLanes);
+        ReturnIf(current->incoming.size() == count);
+        replaceDispatchLanes(createDispatchLanes(
+            count, current->config, current->incomingQueueSize, current->outgoingQueueSize));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("count", count));
+    }
+}
+
+void MessageBrokerImpl::setTopicPriorities(const DispatchLane::PriorityMap& priorities, size_t starvationLimit) {
+    try {
+        ThrowIf(starvationLimit == 0, "invalidStarvationLimit");
+        AACE_INFO(LX(TAG).d("topics", priorities.size()).d("starvationLimit", starvationLimit));
+
+        std::lock_guard<std::mutex> lock(m_shutdown_mutex);
+        ThrowIf(m_isShutdown, "messageBrokerIsShutdown");
+
+        auto current = std::atomic_load(&m_dispatchLanes);
+        auto config = std::make_shared<DispatchLane::Config>(*current->config);
+        config->priorities = priorities;
+        config->starvationLimit = starvationLimit;
+        replaceDispatchLanes(createDispatchLanes(
+            current->incoming.size(), config, current->incomingQueueSize, current->outgoingQueueSize));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    }
+}
+
+void MessageBrokerImpl::setDispatchQueueSize(
+    size_t incomingQueueSize,
+    size_t outgoingQueueSize,
+    const DispatchLane::OverflowPolicyMap& overflowPolicies) {
+    try {
+        AACE_INFO(LX(TAG)
+                      .d("incomingQueueSize", incomingQueueSize)
+                      .d("outgoingQueueSize", outgoingQueueSize)
+                      .d("overflowPolicies", overflowPolicies.size()));
+        for (auto& next : overflowPolicies) {
+            ThrowIf(next.first.empty(), "invalidOverflowPolicyTopic");
+            AACE_DEBUG(LX(TAG).d("topic", next.first).d("overflowPolicy", next.second));
+        }
+
+        std::lock_guard<std::mutex> lock(m_shutdown_mutex);
+        ThrowIf(m_isShutdown, "messageBrokerIsShutdown");
+
+        auto current = std::atomic_load(&m_dispatchLanes);
+        auto config = std::make_shared<DispatchLane::Config>(*current->config);
+        config->overflowPolicies = overflowPolicies;
+        replaceDispatchLanes(
+            createDispatchLanes(current->incoming.size(), config, incomingQueueSize, outgoingQueueSize));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    }
+}
+
+void MessageBrokerImpl::replaceDispatchLanes(std::shared_ptr<DispatchLanes> lanes) {
+    // publish the new lanes, then finish the messages already queued on the previous lanes
+    auto current = std::atomic_load(&m_dispatchLanes);
+    std::atomic_store(&m_dispatchLanes, lanes);
+    shutdownDispatchLanes(current);
+}
+
+std::shared_ptr<MessageBrokerImpl::DispatchLanes> MessageBrokerImpl::createDispatchLanes(
+    size_t count,
+    std::shared_ptr<const DispatchLane::Config> config,
+    size_t incomingQueueSize,
+    size_t outgoingQueueSize) {
+    auto lanes = std::make_shared<DispatchLanes>();
+    lanes->config = config != nullptr ? config : std::make_shared<const DispatchLane::Config>();
+    lanes->incomingQueueSize = incomingQueueSize;
+    lanes->outgoingQueueSize = outgoingQueueSize;
+    for (size_t i = 0; i < count; i++) {
+        lanes->incoming.push_back(std::make_shared<DispatchLane>(
+            "MessageBroker.incoming." + std::to_string(i), lanes->config, incomingQueueSize));
+        lanes->outgoing.push_back(std::make_shared<DispatchLane>(
+            "MessageBroker.outgoing." + std::to_string(i), lanes->config, outgoingQueueSize));
+    }
+    return lanes;
+}
+
+void MessageBrokerImpl::shutdownDispatchLanes(const std::shared_ptr<DispatchLanes>& lanes) {
+    for (auto& next : lanes->outgoing) {
+        next->waitForSubmittedTasks();
+    }
+    for (auto& next : lanes->incoming) {
+        next->waitForSubmittedTasks();
+    }
+    for (auto& next : lanes->outgoing) {
+        next->shutdown();
+    }
+    for (auto& next : lanes->incoming) {
+        next->shutdown();
+    }
+}
 
-    str << direction << ":" << (topic.empty() ? "*" : topic) << ":" << (action.empty() ? "*" : action);
+std::shared_ptr<DispatchLane> MessageBrokerImpl::getDispatchLane(const Message& message) {
+    auto lanes = std::atomic_load(&m_dispatchLanes);
+    auto& executors = message.direction() == Message::Direction::INCOMING ? lanes->incoming : lanes->outgoing;
 
-    return str.str();
+    return executors.size() == 1 ? executors.front()
+                                 : executors[std::hash<std::string>()(message.topic()) % executors.size()];
 }
 
-void MessageBrokerImpl::subscribe(const std::string& topic, MessageHandler handler, Message::Direction direction) {
-    subscribe(topic, "*", handler, direction);
+void MessageBrokerImpl::setMetricsSampleInterval(uint32_t interval) {
+    AACE_INFO(LX(TAG).d("interval", interval));
+    m_metrics.setSampleInterval(interval);
 }
 
-void MessageBrokerImpl::subscribe(
+uint32_t MessageBrokerImpl::getMetricsSampleInterval() const {
+    return m_metrics.getSampleInterval();
+}
+
+MessageBrokerMetrics::Snapshot MessageBrokerImpl::getMetricsSnapshot() {
+    auto snapshot = m_metrics.getSnapshot();
+
+    auto lanes = std::atomic_load(&m_dispatchLanes);
+    for (auto& next : lanes->incoming) {
+        snapshot.incomingQueueDepth.push_back(next->queueSize());
+        snapshot.incomingLanes.push_back(next->getMetrics());
+    }
+    for (auto& next : lanes->outgoing) {
+        snapshot.outgoingQueueDepth.push_back(next->queueSize());
+        snapshot.outgoingLanes.push_back(next->getMetrics());
+    }
+
+    return snapshot;
+}
+
+void MessageBrokerImpl::resetMetrics() {
+    m_metrics.reset();
+    m_replyLatency.reset();
+}
+
+void MessageBrokerImpl::setTrafficRecorder(std::shared_ptr<MessageTrafficRecorder> recorder) {
+    AACE_INFO(LX(TAG).d("recording", recorder != nullptr));
+    std::atomic_store(&m_trafficRecorder, recorder);
+}
+
+void MessageBrokerImpl::waitForDispatchedMessages() {
+    auto lanes = std::atomic_load(&m_dispatchLanes);
+    for (auto& next : lanes->incoming) {
+        next->waitForSubmittedTasks();
+    }
+    for (auto& next : lanes->outgoing) {
+        next->waitForSubmittedTasks();
+    }
+}
+
+void MessageBrokerImpl::setAdaptiveTimeouts(const ReplyLatencyTracker::Config& config) {
+    m_replyLatency.setConfig(config);
+}
+
+std::vector<ReplyLatencyTracker::TopicStats> MessageBrokerImpl::getReplyLatencySnapshot() const {
+    return m_replyLatency.getSnapshot();
+}
+
+MessageBrokerMetrics::Sample MessageBrokerImpl::startMetricsSample(DispatchLane& executor) {
+    return m_metrics.startSample([&executor]() { return executor.queueSize(); });
+}
+
+MessageBrokerImpl::SubscriptionId MessageBrokerImpl::subscribe(
+    const std::string& topic,
+    MessageHandler handler,
+    Message::Direction direction) {
+    return subscribe(topic, "*", handler, direction);
+}
+
+MessageBrokerImpl::SubscriptionId MessageBrokerImpl::subscribe(
     const std::string& topic,
     const std::string& action,
     MessageHandler handler,
@@ -69,50 +245,78 @@ void MessageBrokerImpl::subscribe(
         AACE_DEBUG(LX(TAG).d("direction", direction).d("topic", topic).d("action", action));
 
         std::lock_guard<std::mutex> lock(m_pub_sub_mutex);
-        std::string type = getMessageType(direction, topic, action);
 
-        auto it = m_subscriberMap.find(type);
-        if (it != m_subscriberMap.end()) {
-            it->second.push_back(handler);
-        } else {
-            m_subscriberMap[type] = {handler};
-        }
+        // update a copy of the index and publish it, readers keep using their current snapshot
+        auto index = std::make_shared<SubscriberRoutingIndex>(*std::atomic_load(&m_subscriberIndex));
+        auto id = index->addHandler(direction, topic, action, handler);
+        std::atomic_store(&m_subscriberIndex, std::shared_ptr<const SubscriberRoutingIndex>(index));
+
+        return id;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return 0;
+    }
+}
+
+bool MessageBrokerImpl::unsubscribe(SubscriptionId id) {
+    try {
+        AACE_DEBUG(LX(TAG).d("id", id));
+
+        std::lock_guard<std::mutex> lock(m_pub_sub_mutex);
+
+        auto index = std::make_shared<SubscriberRoutingIndex>(*std::atomic_load(&m_subscriberIndex));
+        ThrowIfNot(index->removeHandler(id), "invalidSubscriptionId");
+        std::atomic_store(&m_subscriberIndex, std::shared_ptr<const SubscriberRoutingIndex>(index));
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("id", id));
+        return false;
     }
 }
 
 PublishMessage MessageBrokerImpl::publish(const std::string& message, Message::Direction direction) {
+    return PublishMessage(direction, message, m_timeout, createInvokeHandler());
+}
+
+PublishMessage MessageBrokerImpl::publish(const Message& message) {
+    return PublishMessage(message, m_timeout, createInvokeHandler());
+}
+
+PublishMessage::InvokeHandler MessageBrokerImpl::createInvokeHandler() {
     // create a wp reference
     std::weak_ptr<MessageBrokerImpl> wp = shared_from_this();
 
-    return PublishMessage(direction, message, m_timeout, [wp](const PublishMessage& pm, bool sync) {
+    return [wp](const PublishMessage& pm, bool sync) {
         try {
             auto sp = wp.lock();
             ThrowIfNull(sp, "invalidWeakPtrReference");
 
-            // get an instance of the Message defined by the PublishMessage object
-            auto msg = pm.message();
+            // get the Message defined by the PublishMessage object
+            auto& msg = pm.message();
+            if (auto recorder = std::atomic_load(&sp->m_trafficRecorder)) {
+                recorder->recordMessage(msg);
+            }
 
             // handle publish message type
             if (msg.messageType() == Message::MessageType::PUBLISH) {
+                auto executor = sp->getDispatchLane(msg);
                 if (sync) {
-                    return sp->publishSync(
-                        pm,
-                        pm.direction() == Message::Direction::INCOMING ? sp->m_incomingMessageExecutor
-                                                                       : sp->m_outgoingMessageExecutor);
+                    return sp->publishSync(pm, *executor);
+                } else if (pm.successHandler() != nullptr || pm.errorHandler() != nullptr) {
+                    sp->publishRequest(pm, executor);
+                    return Message::INVALID;
                 } else {
-                    sp->publishAsync(
-                        pm,
-                        pm.direction() == Message::Direction::INCOMING ? sp->m_incomingMessageExecutor
-                                                                       : sp->m_outgoingMessageExecutor);
+                    if (!sp->publishCoalesced(msg)) {
+                        sp->publishAsync(msg, *executor);
+                    }
                     return Message::INVALID;
                 }
             }
 
             // handle reply message type
             else if (msg.messageType() == Message::MessageType::REPLY) {
-                sp->reply(pm);
+                sp->reply(msg);
                 return Message::INVALID;
             } else {
                 Throw("invalidMessageType");
@@ -121,182 +325,480 @@ PublishMessage MessageBrokerImpl::publish(const std::string& message, Message::D
             AACE_ERROR(LX(TAG).d("reason", ex.what()));
             return Message::INVALID;
         }
-    });
+    };
 }
 
-void MessageBrokerImpl::publishAsync(const PublishMessage& pm, aace::engine::utils::threading::Executor& executor) {
-    AACE_DEBUG(LX(TAG).sensitive("message", pm.msg()));
+size_t MessageBrokerImpl::publishBatch(
+    const std::vector<std::string>& messages,
+    Message::Direction direction,
+    bool coalesce) {
+    try {
+        AACE_DEBUG(LX(TAG).d("direction", direction).d("count", messages.size()).d("coalesce", coalesce));
+        ThrowIf(m_isShutdown, "messageBrokerIsShutdown");
+
+        auto recorder = std::atomic_load(&m_trafficRecorder);
+        std::vector<Message> published;
+        published.reserve(messages.size());
+        for (auto& next : messages) {
+            Message message(next, direction, Message::ParseMode::LAZY);
+            if (!message.valid()) {
+                AACE_ERROR(LX(TAG).d("reason", "invalidMessage").sensitive("message", next));
+                continue;
+            }
+            if (recorder != nullptr) {
+                recorder->recordMessage(message);
+            }
+            // replies are delivered to their pending request, or published on their own lane
+            if (message.messageType() == Message::MessageType::REPLY) {
+                reply(message);
+                continue;
+            }
+            published.push_back(std::move(message));
+        }
 
-    // capture the message
-    auto message = pm.message();
+        // keep the last message for each topic and action, at the position of the last message
+        if (coalesce && published.size() > 1) {
+            std::unordered_map<std::string, size_t> latest;
+            for (size_t i = 0; i < published.size(); i++) {
+                latest[published[i].topic() + ":" + published[i].action()] = i;
+            }
+            if (latest.size() < published.size()) {
+                std::vector<Message> coalesced;
+                coalesced.reserve(latest.size());
+                for (size_t i = 0; i < published.size(); i++) {
+                    if (latest[published[i].topic() + ":" + published[i].action()] == i) {
+                        coalesced.push_back(std::move(published[i]));
+                    }
+                }
+                published.swap(coalesced);
+            }
+        }
+
+        // group the messages by dispatch lane and priority class, keeping their published order
+        // within each group
+        using SampledMessages = std::vector<std::pair<Message, MessageBrokerMetrics::Sample>>;
+        struct LaneBatch {
+            std::shared_ptr<DispatchLane> executor;
+            DispatchLane::Priority priority;
+            SampledMessages messages;
+        };
+        std::vector<LaneBatch> batches;
+        for (auto& next : published) {
+            auto executor = getDispatchLane(next);
+            // a bounded lane counts and drops the messages one by one
+            if (executor->isBounded()) {
+                publishAsync(next, *executor);
+                continue;
+            }
+            auto priority = executor->getPriority(next.topic());
+            auto batch = std::find_if(batches.begin(), batches.end(), [&executor, priority](const LaneBatch& b) {
+                return b.executor == executor && b.priority == priority;
+            });
+            if (batch == batches.end()) {
+                batches.push_back({executor, priority, SampledMessages()});
+                batch = batches.end() - 1;
+            }
+            batch->messages.emplace_back(next, startMetricsSample(*executor));
+        }
+
+        std::weak_ptr<MessageBrokerImpl> wp = shared_from_this();
+        for (auto& next : batches) {
+            auto batch = std::make_shared<SampledMessages>(std::move(next.messages));
+            // the messages of the batch share the priority class of the first message topic
+            next.executor->post(batch->front().first.topic(), std::string(), [wp, batch]() {
+                if (auto sp = wp.lock()) {
+                    for (auto& message : *batch) {
+                        sp->notifySubscribers(message.first, message.second);
+                    }
+                } else {
+                    AACE_ERROR(LX(TAG).d("reason", "invalidWeakPtrReference"));
+                }
+            });
+        }
+
+        return published.size();
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return 0;
+    }
+}
+
+std::chrono::milliseconds MessageBrokerImpl::getReplyTimeout(const PublishMessage& pm) {
+    if (pm.hasTimeout()) {
+        return pm.timeout();
+    }
+    auto& message = pm.message();
+    return m_replyLatency.getTimeout(message.topic(), message.action(), pm.timeout());
+}
+
+void MessageBrokerImpl::publishAsync(const Message& msg, DispatchLane& executor) {
+    AACE_DEBUG(LX(TAG).sensitive("message", msg.raw()));
+
+    // capture the message, which shares the message envelope instead of copying it
+    auto message = msg;
 
     // capture weak ptr reference in callback
     std::weak_ptr<MessageBrokerImpl> wp = shared_from_this();
+    auto sample = startMetricsSample(executor);
 
-    // We publish asynchronous messages on the executor thread so that all messages
-    // are sequenced in the order which they are published... This has the effect of
-    // blocking asynchronous messages if there is a synchronous message that is
-    // currently blocking the message queue.
+    // We publish asynchronous messages on the executor thread of the message's dispatch
+    // lane so that all messages with the same topic are sequenced in the order which they
+    // are published... This has the effect of blocking asynchronous messages if there is
+    // a synchronous message that is currently blocking the same lane.
     //
-    // This is intentional behavior, but we may want to support a different, or
-    // additional asynchronous message behavior.
-    executor.submit([wp, message]() {
+    // This is intentional behavior. Configuring more dispatch lanes limits the messages
+    // delayed by a blocking message to the topics sharing its lane.
+    //
+    // A bounded lane coalesces the waiting messages with the same topic and action.
+    auto key = executor.isBounded() ? message.topic() + ":" + message.action() : std::string();
+    auto posted = executor.post(message.topic(), key, [wp, message, sample]() {
         if (auto sp = wp.lock()) {
-            sp->notifySubscribers(message);
+            sp->notifySubscribers(message, sample);
         } else {
             AACE_ERROR(LX(TAG).d("reason", "invalidWeakPtrReference"));
         }
     });
+    if (!posted && !m_isShutdown) {
+        AACE_ERROR(LX(TAG).d("reason", "dispatchQueueFull").d("topic", message.topic()).d("action", message.action()));
+    }
+}
+
+void MessageBrokerImpl::setCoalescingPolicy(
+    const std::string& topic,
+    const std::string& action,
+    std::chrono::milliseconds minInterval,
+    const std::string& partition) {
+    try {
+        ThrowIf(topic.empty() || action.empty(), "invalidTopicOrAction");
+        ThrowIf(minInterval.count() < 0, "invalidMinInterval");
+        if (!partition.empty()) {
+            // validate the partition pointer, which throws if it is malformed
+            nlohmann::json::json_pointer pointer(partition);
+        }
+        AACE_INFO(LX(TAG).d("topic", topic).d("action", action).d("minInterval", minInterval.count()));
+
+        std::lock_guard<std::mutex> lock(m_coalescing_mutex);
+        m_coalescingPolicies[topic + ":" + action] = {minInterval, partition};
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("topic", topic).d("action", action));
+    }
 }
 
-Message MessageBrokerImpl::publishSync(const PublishMessage& pm, aace::engine::utils::threading::Executor& executor) {
+bool MessageBrokerImpl::publishCoalesced(const Message& message) {
+    ReturnIf(message.direction() != Message::Direction::INCOMING, false);
+
+    CoalescingPolicy policy;
+    std::string key = message.topic() + ":" + message.action();
+    {
+        std::lock_guard<std::mutex> lock(m_coalescing_mutex);
+        ReturnIf(m_coalescingPolicies.empty(), false);
+        auto it = m_coalescingPolicies.find(key);
+        if (it == m_coalescingPolicies.end()) {
+            it = m_coalescingPolicies.find(message.topic() + ":*");
+        }
+        ReturnIf(it == m_coalescingPolicies.end(), false);
+        policy = it->second;
+    }
+
+    // only a partitioned policy parses the payload, outside of the lock
+    if (!policy.partition.empty()) {
+        nlohmann::json::json_pointer pointer(policy.partition);
+        auto& payload = message.payloadJson();
+        key += ":" + (payload.is_object() && payload.contains(pointer) ? payload.at(pointer).dump() : std::string());
+    }
+
+    std::chrono::steady_clock::duration delay;
+    {
+        std::lock_guard<std::mutex> lock(m_coalescing_mutex);
+        auto& coalesced = m_coalescedMessages[key];
+        coalesced.latest = message;
+        if (coalesced.pending) {
+            AACE_VERBOSE(LX(TAG).m("coalesced").d("key", key));
+            return true;
+        }
+        coalesced.pending = true;
+        delay = coalesced.lastDispatch + policy.minInterval - std::chrono::steady_clock::now();
+    }
+
+    if (delay.count() > 0) {
+        std::weak_ptr<MessageBrokerImpl> wp = shared_from_this();
+        m_timerWheel->submitAfter(std::chrono::duration_cast<std::chrono::milliseconds>(delay), [wp, key]() {
+            if (auto sp = wp.lock()) {
+                sp->postCoalesced(key);
+            }
+        });
+    } else {
+        postCoalesced(key);
+    }
+
+    return true;
+}
+
+void MessageBrokerImpl::postCoalesced(const std::string& key) {
+    Message message = Message::INVALID;
+    {
+        std::lock_guard<std::mutex> lock(m_coalescing_mutex);
+        message = m_coalescedMessages[key].latest;
+    }
+
+    // the coalesced message is dispatched on the lane of its topic, after the messages already queued
+    auto executor = getDispatchLane(message);
+    auto sample = startMetricsSample(*executor);
+    std::weak_ptr<MessageBrokerImpl> wp = shared_from_this();
+    // the coalesced message is never dropped for a newer message, since it is the latest state
+    auto posted = executor->post(message.topic(), std::string(), [wp, key, sample]() {
+        if (auto sp = wp.lock()) {
+            sp->dispatchCoalesced(key, sample);
+        } else {
+            AACE_ERROR(LX(TAG).d("reason", "invalidWeakPtrReference"));
+        }
+    });
+    if (!posted) {
+        // the next message with the key is dispatched without waiting for this one
+        AACE_ERROR(LX(TAG).d("reason", m_isShutdown ? "messageBrokerIsShutdown" : "dispatchQueueFull").d("key", key));
+        std::lock_guard<std::mutex> lock(m_coalescing_mutex);
+        auto& coalesced = m_coalescedMessages[key];
+        coalesced.latest = Message::INVALID;
+        coalesced.pending = false;
+    }
+}
+
+void MessageBrokerImpl::dispatchCoalesced(const std::string& key, const MessageBrokerMetrics::Sample& sample) {
+    Message message = Message::INVALID;
+    {
+        std::lock_guard<std::mutex> lock(m_coalescing_mutex);
+        auto& coalesced = m_coalescedMessages[key];
+        message = coalesced.latest;
+        coalesced.latest = Message::INVALID;
+        coalesced.pending = false;
+        coalesced.lastDispatch = std::chrono::steady_clock::now();
+    }
+    notifySubscribers(message, sample);
+}
+
+Message MessageBrokerImpl::publishSync(const PublishMessage& pm, DispatchLane& executor) {
     AACE_DEBUG(LX(TAG).sensitive("message", pm.msg()));
-    std::lock_guard<std::mutex> lock(m_wait_for_sync_response_mutex);
     if (m_isShutdown) {
         AACE_WARN(LX(TAG).m("Discarding message since MessageBroker is shutdown."));
         return Message::INVALID;
     }
 
     // capture the message and timeout
-    auto message = pm.message();
-    auto timeout = pm.timeout();
+    auto& message = pm.message();
+    auto timeout = getReplyTimeout(pm);
+    bool timedOut = false;
 
-    auto reply = executor.submit([this, &message, timeout]() -> std::string {
-        try {
-            // create the promise for the reply message to fulfill
-            std::shared_ptr<SyncPromiseType> promise = std::make_shared<SyncPromiseType>();
+    try {
+        // create the promise for the reply message to fulfill, and a future to receive the
+        // promised reply message when it is received
+        auto promise = std::make_shared<std::promise<Message>>();
+        auto future = promise->get_future();
+
+        auto pending = std::make_shared<PendingReply>();
+        pending->replyHandler = [promise](const Message& reply) { promise->set_value(reply); };
+        pending->topic = message.topic();
+        pending->action = message.action();
+        pending->published = std::chrono::steady_clock::now();
+
+        // add the pending reply before the subscribers are notified, so a reply published
+        // by a subscriber is never missed
+        ThrowIfNot(addPendingReply(message.messageId(), pending), "messageIdAlreadyExists");
+
+        // the calling thread waits for the reply, so the dispatch lane is free to deliver
+        // other messages, including other synchronous messages
+        std::weak_ptr<MessageBrokerImpl> wp = shared_from_this();
+        auto sample = startMetricsSample(executor);
+        auto notified = executor.submit(message.topic(), [wp, message, sample]() -> size_t {
+            auto sp = wp.lock();
+            return sp != nullptr ? sp->notifySubscribers(message, sample) : 0;
+        });
+        ThrowIfNot(notified.valid(), m_isShutdown ? "messageBrokerIsShutdown" : "dispatchQueueFull");
+
+        // don't wait if there is no subscriber
+        ThrowIf(notified.get() == 0, "noSubscribers");
 
-            // create a future to receive the promised reply message when it is received
-            auto future = promise->get_future();
+        // wait for the future
+        timedOut = future.wait_for(timeout) != std::future_status::ready;
+        ThrowIf(timedOut, "syncMessageTimeout");
 
-            // add the promise to the message sync map
-            addSyncMessagePromise(message.messageId(), promise);
+        return future.get();
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG)
+                       .d("reason", ex.what())
+                       .d("topic", message.topic())
+                       .d("action", message.action())
+                       .sensitive("message", message.str()));
+        // the reply was recorded if it was received after the timeout
+        if (takePendingReply(message.messageId()) != nullptr && timedOut) {
+            m_replyLatency.recordTimeout(message.topic(), message.action(), timeout);
+        }
+        return Message::INVALID;
+    }
+}
+
+void MessageBrokerImpl::publishRequest(const PublishMessage& pm, std::shared_ptr<DispatchLane> executor) {
+    AACE_DEBUG(LX(TAG).sensitive("message", pm.msg()));
 
-            size_t numSubscribersNotified = notifySubscribers(message);
+    auto message = pm.message();
+    auto pending = std::make_shared<PendingReply>();
+    pending->replyHandler = pm.successHandler();
+    pending->errorHandler = pm.errorHandler();
+    pending->executor = executor;
+    pending->topic = message.topic();
+    pending->action = message.action();
+    pending->published = std::chrono::steady_clock::now();
 
-            // don't wait if there is no subscriber
-            ThrowIf(numSubscribersNotified == 0, "noSubscribers");
+    if (m_isShutdown) {
+        AACE_WARN(LX(TAG).m("Discarding message since MessageBroker is shutdown."));
+        failPendingReply(pending);
+        return;
+    }
 
-            // wait for the future
-            ThrowIfNot(future.wait_for(timeout) == std::future_status::ready, "syncMessageTimeout");
+    if (!addPendingReply(message.messageId(), pending)) {
+        AACE_ERROR(LX(TAG).d("reason", "messageIdAlreadyExists").d("topic", message.topic()));
+        failPendingReply(pending);
+        return;
+    }
+    scheduleReplyTimeout(message.messageId(), pending, getReplyTimeout(pm));
 
-            removeSyncMessagePromise(message.messageId());
-            return future.get();
-        } catch (std::exception& ex) {
-            AACE_ERROR(LX(TAG)
-                           .d("reason", ex.what())
-                           .d("topic", message.topic())
-                           .d("action", message.action())
-                           .sensitive("message", message.str()));
-            removeSyncMessagePromise(message.messageId());
-
-            throw;  // Rethrows the currently handled exception.
+    std::weak_ptr<MessageBrokerImpl> wp = shared_from_this();
+    auto sample = startMetricsSample(*executor);
+    // a request is never dropped for a newer message, since its handlers wait for the reply
+    auto posted = executor->post(message.topic(), std::string(), [wp, message, sample]() {
+        if (auto sp = wp.lock()) {
+            // don't wait for a reply if there is no subscriber
+            if (sp->notifySubscribers(message, sample) == 0) {
+                AACE_ERROR(LX(TAG).d("reason", "noSubscribers").d("topic", message.topic()));
+                sp->failPendingReply(sp->takePendingReply(message.messageId()));
+            }
+        } else {
+            AACE_ERROR(LX(TAG).d("reason", "invalidWeakPtrReference"));
         }
     });
-
-    try {
-        return Message(reply.get(), message.replyDirection());
-    } catch (std::exception& ex) {
-        return Message::INVALID;
+    if (!posted) {
+        AACE_ERROR(LX(TAG)
+                       .d("reason", m_isShutdown ? "messageBrokerIsShutdown" : "dispatchQueueFull")
+                       .d("topic", message.topic()));
+        auto failed = takePendingReply(message.messageId());
+        cancelReplyTimeout(failed);
+        failPendingReply(failed);
     }
 }
 
-void MessageBrokerImpl::reply(const PublishMessage& pm) {
+void MessageBrokerImpl::reply(const Message& message) {
     try {
-        auto message = pm.message();
         AACE_VERBOSE(LX(TAG).sensitive("message", message));
 
-        auto promise = getSyncMessagePromise(message.replyTo());
+        auto pending = takePendingReply(message.replyTo());
+        cancelReplyTimeout(pending);
+        if (pending != nullptr) {
+            m_replyLatency.recordReply(
+                pending->topic, pending->action, std::chrono::steady_clock::now() - pending->published);
+        }
 
-        if (promise == nullptr) {
+        if (pending == nullptr) {
             AACE_VERBOSE(
                 LX(TAG).m("Publishing reply message because no promise is registered").sensitive("message", message));
-            publishAsync(
-                pm,
-                pm.direction() == Message::Direction::INCOMING ? m_incomingMessageExecutor : m_outgoingMessageExecutor);
+            publishAsync(message, *getDispatchLane(message));
+        } else if (pending->executor != nullptr) {
+            // deliver the reply to an asynchronous request on the request's dispatch lane
+            auto replyHandler = pending->replyHandler;
+            if (replyHandler != nullptr) {
+                auto reply = message;
+                pending->executor->postCompletion(pending->topic, [replyHandler, reply]() { replyHandler(reply); });
+            }
         } else {
-            promise->set_value(message.str());
+            pending->replyHandler(message);
         }
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
     }
 }
 
-size_t MessageBrokerImpl::notifySubscribers(const std::string& type, const Message& message) {
-    AACE_DEBUG(LX(TAG).d("type", type).sensitive("message", message));
-
-    std::vector<MessageHandler> handlers;
-    {
-        std::lock_guard<std::mutex> pub_sub_lock(m_pub_sub_mutex);
-        auto it = m_subscriberMap.find(type);
-        if (it != m_subscriberMap.end()) {
-            handlers = it->second;
-        }
-    }
-    for (auto& next : handlers) {
+size_t MessageBrokerImpl::notifySubscribers(const Message& message, const MessageBrokerMetrics::Sample& sample) {
+    AACE_TRACE_SCOPE("messageBroker", message.topic());
+    AACE_DEBUG(LX(TAG)
+                   .d("direction", message.direction())
+                   .d("topic", message.topic())
+                   .d("action", message.action())
+                   .sensitive("message", message));
+
+    // get the compiled handlers for the topic:action, topic:* and *:* subscribers
+    auto handlers =
+        std::atomic_load(&m_subscriberIndex)->getHandlers(message.direction(), message.topic(), message.action());
+    auto dispatched = sample.sampled ? MessageBrokerMetrics::Clock::now() : MessageBrokerMetrics::Clock::time_point();
+    auto cpuTime = sample.sampled ? MessageBrokerMetrics::threadCpuTime() : MessageBrokerMetrics::Clock::duration();
+    for (auto& next : *handlers) {
         next(message);
     }
-    return handlers.size();
+    if (sample.sampled) {
+        cpuTime = MessageBrokerMetrics::threadCpuTime() - cpuTime;
+        m_metrics.record(message, sample, dispatched, MessageBrokerMetrics::Clock::now(), cpuTime);
+    }
+    return handlers->size();
 }
 
-size_t MessageBrokerImpl::notifySubscribers(const Message& message) {
-    size_t numSubscribersNotified = 0;
-
-    // notify the subscribers that are interested in this specific message (topic:action)
-    numSubscribersNotified +=
-        notifySubscribers(getMessageType(message.direction(), message.topic(), message.action()), message);
-
-    // notify the subscribers that are interested in all actions for this topic (topic:*)
-    numSubscribersNotified += notifySubscribers(getMessageType(message.direction(), message.topic()), message);
-
-    // notify the subscribers that are interested in all topics and actions (*:*)
-    numSubscribersNotified += notifySubscribers(getMessageType(message.direction()), message);
+bool MessageBrokerImpl::addPendingReply(const std::string& messageId, std::shared_ptr<PendingReply> pending) {
+    std::lock_guard<std::mutex> lock(m_pending_reply_mutex);
 
-    return numSubscribersNotified;
+    // add the pending reply to the pending reply map
+    return m_pendingReplyMap.emplace(messageId, pending).second;
 }
 
-void MessageBrokerImpl::addSyncMessagePromise(const std::string& messageId, std::shared_ptr<SyncPromiseType> promise) {
-    try {
-        std::lock_guard<std::mutex> lock(m_promise_map_access_mutex);
-
-        ThrowIf(m_syncMessagePromiseMap.find(messageId) != m_syncMessagePromiseMap.end(), "messageIdAlreadyExists");
+std::shared_ptr<MessageBrokerImpl::PendingReply> MessageBrokerImpl::takePendingReply(const std::string& messageId) {
+    std::lock_guard<std::mutex> lock(m_pending_reply_mutex);
 
-        // add the promise to the promise map
-        m_syncMessagePromiseMap[messageId] = promise;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    auto it = m_pendingReplyMap.find(messageId);
+    if (it == m_pendingReplyMap.end()) {
+        return nullptr;
     }
-}
 
-void MessageBrokerImpl::removeSyncMessagePromise(const std::string& messageId) {
-    try {
-        std::lock_guard<std::mutex> lock(m_promise_map_access_mutex);
+    // remove the pending reply, so only one of the reply or the timeout completes the request
+    auto pending = it->second;
+    m_pendingReplyMap.erase(it);
 
-        auto it = m_syncMessagePromiseMap.find(messageId);
-        ThrowIf(it == m_syncMessagePromiseMap.end(), "messageIdDoesNotExist");
+    return pending;
+}
 
-        // remove the promise from the promise map
-        m_syncMessagePromiseMap.erase(messageId);
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+void MessageBrokerImpl::failPendingReply(std::shared_ptr<PendingReply> pending) {
+    if (pending == nullptr || pending->errorHandler == nullptr) {
+        return;
+    }
+
+    auto errorHandler = pending->errorHandler;
+    if (pending->executor == nullptr || !pending->executor->postCompletion(pending->topic, errorHandler)) {
+        errorHandler();
     }
 }
 
-std::shared_ptr<MessageBrokerImpl::SyncPromiseType> MessageBrokerImpl::getSyncMessagePromise(
-    const std::string& messageId) {
-    try {
-        std::lock_guard<std::mutex> lock(m_promise_map_access_mutex);
+void MessageBrokerImpl::scheduleReplyTimeout(
+    const std::string& messageId,
+    std::shared_ptr<PendingReply> pending,
+    std::chrono::milliseconds timeout) {
+    std::weak_ptr<MessageBrokerImpl> wp = shared_from_this();
+    auto timer = m_timerWheel->submitAfter(timeout, [wp, messageId, timeout]() {
+        // the request has already completed if the pending reply was taken by the reply
+        if (auto sp = wp.lock()) {
+            if (auto pending = sp->takePendingReply(messageId)) {
+                AACE_ERROR(LX(TAG).d("reason", "syncMessageTimeout").d("messageId", messageId));
+                sp->m_replyLatency.recordTimeout(pending->topic, pending->action, timeout);
+                failPendingReply(pending);
+            }
+        }
+    });
 
-        auto it = m_syncMessagePromiseMap.find(messageId);
-        ThrowIf(it == m_syncMessagePromiseMap.end(), "messageIdDoesNotExist");
+    // a reply received before the timer is stored leaves the timer to expire without a pending reply
+    pending->timeoutTimer = timer;
+}
 
-        return it->second;
-    } catch (std::exception& ex) {
-        for (auto& next : m_syncMessagePromiseMap) {
-            AACE_ERROR(LX(TAG).d("id", next.first));
-        }
+void MessageBrokerImpl::cancelReplyTimeout(const std::shared_ptr<PendingReply>& pending) {
+    if (pending == nullptr) {
+        return;
+    }
 
-        return nullptr;
+    auto timer = pending->timeoutTimer.exchange(TimerWheel::INVALID_TIMER);
+    if (timer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(timer);
     }
 }
 
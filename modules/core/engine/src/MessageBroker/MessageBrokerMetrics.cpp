@@ -0,0 +1,140 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <time.h>
+
+#include <AACE/Engine/MessageBroker/MessageBrokerMetrics.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+using namespace aace::engine::utils::metrics;
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "MessageBroker";
+
+/// Metric datapoints of a sampled message
+static const std::string METRIC_MESSAGE_TOPIC = "Topic";
+static const std::string METRIC_MESSAGE_ACTION = "Action";
+static const std::string METRIC_MESSAGE_DIRECTION = "Direction";
+static const std::string METRIC_QUEUE_DEPTH = "QueueDepth";
+static const std::string METRIC_DISPATCH_LATENCY = "DispatchLatency";
+static const std::string METRIC_HANDLER_TIME = "HandlerTime";
+static const std::string METRIC_HANDLER_CPU_TIME = "HandlerCpuTime";
+
+constexpr std::array<uint32_t, 12> MessageBrokerMetrics::HISTOGRAM_BUCKET_BOUNDS_US;
+
+void MessageBrokerMetrics::Histogram::add(Clock::duration duration) {
+    auto us = static_cast<uint64_t>(std::max<int64_t>(
+        0, std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+
+    auto bucket = std::upper_bound(HISTOGRAM_BUCKET_BOUNDS_US.begin(), HISTOGRAM_BUCKET_BOUNDS_US.end(), us) -
+                  HISTOGRAM_BUCKET_BOUNDS_US.begin();
+    buckets[bucket]++;
+    count++;
+    totalUs += us;
+    maxUs = std::max(maxUs, us);
+}
+
+void MessageBrokerMetrics::setSampleInterval(uint32_t interval) {
+    m_sampleInterval = interval;
+}
+
+uint32_t MessageBrokerMetrics::getSampleInterval() const {
+    return m_sampleInterval;
+}
+
+void MessageBrokerMetrics::record(
+    const Message& message,
+    const Sample& sample,
+    Clock::time_point dispatched,
+    Clock::time_point completed,
+    Clock::duration cpuTime) {
+    if (!sample.sampled) {
+        return;
+    }
+
+    auto dispatchLatency = dispatched - sample.enqueued;
+    auto handlerTime = completed - dispatched;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto key = std::make_tuple(message.direction(), message.topic(), message.action());
+        auto it = m_topics.find(key);
+        if (it == m_topics.end()) {
+            it = m_topics.emplace(key, TopicMetrics()).first;
+            it->second.direction = message.direction();
+            it->second.topic = message.topic();
+            it->second.action = message.action();
+        }
+
+        auto& metrics = it->second;
+        metrics.samples++;
+        metrics.maxQueueDepth = std::max(metrics.maxQueueDepth, sample.queueDepth);
+        metrics.dispatchLatency.add(dispatchLatency);
+        metrics.handlerTime.add(handlerTime);
+        metrics.handlerCpuTime.add(cpuTime);
+    }
+
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    emitMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX,
+        "notifySubscribers",
+        {{METRIC_QUEUE_DEPTH, static_cast<int>(sample.queueDepth)}},
+        {{METRIC_MESSAGE_DIRECTION, message.direction() == Message::Direction::INCOMING ? "INCOMING" : "OUTGOING"},
+         {METRIC_MESSAGE_TOPIC, message.topic()},
+         {METRIC_MESSAGE_ACTION, message.action()}},
+        {{METRIC_DISPATCH_LATENCY, Milliseconds(dispatchLatency).count()},
+         {METRIC_HANDLER_TIME, Milliseconds(handlerTime).count()},
+         {METRIC_HANDLER_CPU_TIME, Milliseconds(cpuTime).count()}});
+}
+
+MessageBrokerMetrics::Clock::duration MessageBrokerMetrics::threadCpuTime() {
+    struct timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+        return Clock::duration::zero();
+    }
+    return std::chrono::duration_cast<Clock::duration>(
+        std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec));
+}
+
+MessageBrokerMetrics::Snapshot MessageBrokerMetrics::getSnapshot() const {
+    Snapshot snapshot;
+    snapshot.sampleInterval = m_sampleInterval;
+    snapshot.publishedMessages = m_publishedMessages;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    snapshot.topics.reserve(m_topics.size());
+    for (auto& next : m_topics) {
+        snapshot.topics.push_back(next.second);
+    }
+
+    return snapshot;
+}
+
+void MessageBrokerMetrics::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_topics.clear();
+    m_publishedMessages = 0;
+}
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
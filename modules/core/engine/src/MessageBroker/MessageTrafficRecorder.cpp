@@ -0,0 +1,229 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstring>
+#include <limits>
+
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/MessageBroker/MessageTrafficRecorder.h>
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.messageBroker.MessageTrafficRecorder");
+
+/// The magic at the start of a recording
+static const char FILE_MAGIC[] = "AACTRF01";
+static const size_t FILE_MAGIC_SIZE = sizeof(FILE_MAGIC) - 1;
+
+/// The size of the record header
+static const size_t RECORD_HEADER_SIZE = 15;
+
+namespace {
+
+void putLittleEndian(char* buffer, uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+}
+
+uint64_t getLittleEndian(const char* buffer, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(buffer[i])) << (8 * i);
+    }
+    return value;
+}
+
+/// A stream recording the data read from and written to another stream
+class RecordingMessageStream : public aace::core::MessageStream {
+public:
+    RecordingMessageStream(
+        const std::string& streamId,
+        std::shared_ptr<aace::core::MessageStream> stream,
+        std::weak_ptr<MessageTrafficRecorder> recorder) :
+            m_streamId(streamId), m_stream(stream), m_recorder(recorder) {
+    }
+
+    ssize_t read(char* data, const size_t size) override {
+        return record(MessageTrafficRecorder::RecordType::STREAM_READ, data, m_stream->read(data, size));
+    }
+
+    ssize_t timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) override {
+        return record(
+            MessageTrafficRecorder::RecordType::STREAM_READ, data, m_stream->timedRead(data, size, timeout));
+    }
+
+    ssize_t write(const char* data, const size_t size) override {
+        return record(MessageTrafficRecorder::RecordType::STREAM_WRITE, data, m_stream->write(data, size));
+    }
+
+    bool isClosed() override {
+        return m_stream->isClosed();
+    }
+
+    MessageStream::Mode getMode() override {
+        return m_stream->getMode();
+    }
+
+private:
+    ssize_t record(MessageTrafficRecorder::RecordType type, const char* data, ssize_t size) {
+        if (size > 0) {
+            if (auto recorder = m_recorder.lock()) {
+                recorder->recordStream(type, m_streamId, data, static_cast<size_t>(size));
+            }
+        }
+        return size;
+    }
+
+    const std::string m_streamId;
+    std::shared_ptr<aace::core::MessageStream> m_stream;
+    std::weak_ptr<MessageTrafficRecorder> m_recorder;
+};
+
+}  // namespace
+
+std::unique_ptr<MessageTrafficRecorder::Reader> MessageTrafficRecorder::Reader::open(const std::string& path) {
+    try {
+        std::unique_ptr<Reader> reader(new Reader());
+        reader->m_file.open(path, std::ios::in | std::ios::binary);
+        ThrowIfNot(reader->m_file.is_open(), "openFileFailed");
+
+        char magic[FILE_MAGIC_SIZE];
+        reader->m_file.read(magic, FILE_MAGIC_SIZE);
+        ThrowIf(
+            reader->m_file.gcount() != static_cast<std::streamsize>(FILE_MAGIC_SIZE) ||
+                std::memcmp(magic, FILE_MAGIC, FILE_MAGIC_SIZE) != 0,
+            "invalidRecording");
+
+        return reader;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("path", path));
+        return nullptr;
+    }
+}
+
+bool MessageTrafficRecorder::Reader::next(Record& record) {
+    char header[RECORD_HEADER_SIZE];
+    m_file.read(header, RECORD_HEADER_SIZE);
+    if (m_file.gcount() == 0) {
+        return false;
+    }
+    if (m_file.gcount() != static_cast<std::streamsize>(RECORD_HEADER_SIZE)) {
+        AACE_WARN(LX(TAG).d("reason", "truncatedRecord"));
+        return false;
+    }
+
+    record.type = static_cast<RecordType>(header[0]);
+    record.timestamp = std::chrono::microseconds(getLittleEndian(header + 1, 8));
+    record.streamId.resize(getLittleEndian(header + 9, 2));
+    record.data.resize(getLittleEndian(header + 11, 4));
+    m_file.read(&record.streamId[0], record.streamId.size());
+    m_file.read(&record.data[0], record.data.size());
+    if (!m_file) {
+        AACE_WARN(LX(TAG).d("reason", "truncatedRecord"));
+        return false;
+    }
+    return true;
+}
+
+MessageTrafficRecorder::MessageTrafficRecorder(bool recordStreams) :
+        m_recordStreams(recordStreams), m_start(std::chrono::steady_clock::now()) {
+}
+
+MessageTrafficRecorder::~MessageTrafficRecorder() {
+    close();
+}
+
+std::shared_ptr<MessageTrafficRecorder> MessageTrafficRecorder::create(const std::string& path, bool recordStreams) {
+    try {
+        std::shared_ptr<MessageTrafficRecorder> recorder(new MessageTrafficRecorder(recordStreams));
+        recorder->m_file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        ThrowIfNot(recorder->m_file.is_open(), "openFileFailed");
+        recorder->m_file.write(FILE_MAGIC, FILE_MAGIC_SIZE);
+        ThrowIfNot(recorder->m_file.good(), "writeFileFailed");
+
+        AACE_INFO(LX(TAG).m("recording").d("path", path).d("recordStreams", recordStreams));
+        return recorder;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("path", path));
+        return nullptr;
+    }
+}
+
+void MessageTrafficRecorder::recordMessage(const Message& message) {
+    auto type = message.direction() == Message::Direction::INCOMING ? RecordType::INCOMING_MESSAGE
+                                                                     : RecordType::OUTGOING_MESSAGE;
+    auto data = message.str(Message::SerializationFormat::COMPACT);
+    writeRecord(type, std::string(), data.data(), data.size());
+}
+
+void MessageTrafficRecorder::recordStream(RecordType type, const std::string& streamId, const char* data, size_t size) {
+    if (m_recordStreams) {
+        writeRecord(type, streamId, data, size);
+    }
+}
+
+bool MessageTrafficRecorder::recordsStreams() const {
+    return m_recordStreams;
+}
+
+std::shared_ptr<aace::core::MessageStream> MessageTrafficRecorder::wrapStream(
+    const std::string& streamId,
+    std::shared_ptr<aace::core::MessageStream> stream) {
+    if (!m_recordStreams || stream == nullptr) {
+        return stream;
+    }
+    // the stream only keeps a weak reference, so it doesn't keep a closed recording open
+    std::weak_ptr<MessageTrafficRecorder> recorder = shared_from_this();
+    return std::make_shared<RecordingMessageStream>(streamId, stream, recorder);
+}
+
+void MessageTrafficRecorder::close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+}
+
+void MessageTrafficRecorder::writeRecord(RecordType type, const std::string& streamId, const char* data, size_t size) {
+    if (streamId.size() > std::numeric_limits<uint16_t>::max() || size > std::numeric_limits<uint32_t>::max()) {
+        AACE_WARN(LX(TAG).d("reason", "recordTooLarge").d("size", size));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file.is_open()) {
+        return;
+    }
+
+    // the timestamp is taken under the lock, so the records are in time order
+    auto timestamp =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+    char header[RECORD_HEADER_SIZE];
+    header[0] = static_cast<char>(type);
+    putLittleEndian(header + 1, static_cast<uint64_t>(timestamp), 8);
+    putLittleEndian(header + 9, streamId.size(), 2);
+    putLittleEndian(header + 11, size, 4);
+    m_file.write(header, RECORD_HEADER_SIZE);
+    m_file.write(streamId.data(), streamId.size());
+    m_file.write(data, size);
+}
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
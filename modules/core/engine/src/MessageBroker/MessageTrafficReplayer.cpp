@@ -0,0 +1,234 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <fstream>
+
+#include <sys/resource.h>
+
+#include <nlohmann/json.hpp>
+
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/MessageBroker/MessageTrafficReplayer.h>
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.messageBroker.MessageTrafficReplayer");
+
+namespace {
+
+std::chrono::microseconds processCpuTime() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return std::chrono::microseconds::zero();
+    }
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+/// Returns the upper bound of the histogram bucket containing the percentile, or the maximum for the last bucket
+uint64_t percentileUs(const MessageBrokerMetrics::Histogram& histogram, double percentile) {
+    auto rank = static_cast<uint64_t>(percentile * histogram.count);
+    uint64_t count = 0;
+    for (size_t i = 0; i < MessageBrokerMetrics::HISTOGRAM_BUCKET_BOUNDS_US.size(); i++) {
+        count += histogram.buckets[i];
+        if (count > rank) {
+            return std::min<uint64_t>(MessageBrokerMetrics::HISTOGRAM_BUCKET_BOUNDS_US[i], histogram.maxUs);
+        }
+    }
+    return histogram.maxUs;
+}
+
+nlohmann::json toJson(const MessageBrokerMetrics::Histogram& histogram) {
+    return {{"count", histogram.count},
+            {"totalUs", histogram.totalUs},
+            {"meanUs", histogram.count > 0 ? histogram.totalUs / histogram.count : 0},
+            {"p50Us", percentileUs(histogram, 0.5)},
+            {"p95Us", percentileUs(histogram, 0.95)},
+            {"maxUs", histogram.maxUs}};
+}
+
+nlohmann::json toJson(const std::vector<DispatchLane::Metrics>& lanes) {
+    auto json = nlohmann::json::array();
+    for (auto& next : lanes) {
+        json.push_back(
+            {{"maxQueueDepth", next.maxQueueDepth},
+             {"rejected", next.rejected},
+             {"dropped", next.dropped},
+             {"coalesced", next.coalesced}});
+    }
+    return json;
+}
+
+}  // namespace
+
+MessageTrafficReplayer::MessageTrafficReplayer(
+    std::shared_ptr<MessageBrokerImpl> broker,
+    std::unique_ptr<MessageTrafficRecorder::Reader> reader,
+    const std::string& path,
+    double speed) :
+        m_broker(broker), m_reader(std::move(reader)), m_path(path), m_speed(speed) {
+}
+
+std::unique_ptr<MessageTrafficReplayer> MessageTrafficReplayer::create(
+    std::shared_ptr<MessageBrokerImpl> broker,
+    const std::string& path,
+    double speed) {
+    try {
+        ThrowIfNull(broker, "invalidMessageBroker");
+        ThrowIf(speed < 0, "invalidSpeed");
+        auto reader = MessageTrafficRecorder::Reader::open(path);
+        ThrowIfNull(reader, "openRecordingFailed");
+
+        return std::unique_ptr<MessageTrafficReplayer>(
+            new MessageTrafficReplayer(broker, std::move(reader), path, speed));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("path", path));
+        return nullptr;
+    }
+}
+
+bool MessageTrafficReplayer::replay() {
+    try {
+        ThrowIfNull(m_reader, "alreadyReplayed");
+        auto reader = std::move(m_reader);
+        AACE_INFO(LX(TAG).m("replaying").d("path", m_path).d("speed", m_speed));
+
+        // sample every message of the replay
+        auto sampleInterval = m_broker->getMetricsSampleInterval();
+        m_broker->resetMetrics();
+        m_broker->setMetricsSampleInterval(1);
+
+        Report report;
+        auto startCpuTime = processCpuTime();
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::microseconds first{-1};
+        bool completed = true;
+
+        MessageTrafficRecorder::Record record;
+        while (reader->next(record)) {
+            if (record.type != MessageTrafficRecorder::RecordType::INCOMING_MESSAGE) {
+                report.skippedRecords++;
+                continue;
+            }
+            if (first.count() < 0) {
+                first = record.timestamp;
+            }
+            report.recordedDuration = record.timestamp - first;
+
+            if (m_speed > 0) {
+                auto offset = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double, std::micro>(report.recordedDuration.count() / m_speed));
+                if (!waitUntil(start + offset)) {
+                    completed = false;
+                    break;
+                }
+            } else if (!waitUntil(start)) {
+                completed = false;
+                break;
+            }
+
+            m_broker->publish(record.data, Message::Direction::INCOMING).send();
+            report.replayedMessages++;
+        }
+
+        m_broker->waitForDispatchedMessages();
+        report.replayDuration =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        report.processCpuTime = processCpuTime() - startCpuTime;
+        report.metrics = m_broker->getMetricsSnapshot();
+        m_broker->setMetricsSampleInterval(sampleInterval);
+
+        AACE_INFO(LX(TAG)
+                      .m(completed ? "replayed" : "stopped")
+                      .d("messages", report.replayedMessages)
+                      .d("skipped", report.skippedRecords)
+                      .d("replayDurationUs", report.replayDuration.count())
+                      .d("cpuTimeUs", report.processCpuTime.count()));
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_report = report;
+        return completed;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("path", m_path));
+        return false;
+    }
+}
+
+bool MessageTrafficReplayer::waitUntil(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return !m_stopped.wait_until(lock, deadline, [this]() { return m_stop; });
+}
+
+void MessageTrafficReplayer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_stopped.notify_all();
+}
+
+MessageTrafficReplayer::Report MessageTrafficReplayer::getReport() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_report;
+}
+
+bool MessageTrafficReplayer::writeReport(const std::string& path) const {
+    try {
+        auto report = getReport();
+
+        auto topics = nlohmann::json::array();
+        for (auto& next : report.metrics.topics) {
+            topics.push_back(
+                {{"direction", next.direction == Message::Direction::INCOMING ? "INCOMING" : "OUTGOING"},
+                 {"topic", next.topic},
+                 {"action", next.action},
+                 {"messages", next.samples},
+                 {"maxQueueDepth", next.maxQueueDepth},
+                 {"dispatchLatency", toJson(next.dispatchLatency)},
+                 {"handlerTime", toJson(next.handlerTime)},
+                 {"handlerCpuTime", toJson(next.handlerCpuTime)}});
+        }
+        nlohmann::json json = {
+            {"recording", m_path},
+            {"speed", m_speed},
+            {"replayedMessages", report.replayedMessages},
+            {"skippedRecords", report.skippedRecords},
+            {"recordedDurationUs", report.recordedDuration.count()},
+            {"replayDurationUs", report.replayDuration.count()},
+            {"processCpuTimeUs", report.processCpuTime.count()},
+            {"topics", topics},
+            {"incomingLanes", toJson(report.metrics.incomingLanes)},
+            {"outgoingLanes", toJson(report.metrics.outgoingLanes)}};
+
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        ThrowIfNot(file.is_open(), "openFileFailed");
+        file << json.dump(2) << std::endl;
+        ThrowIfNot(file.good(), "writeFileFailed");
+
+        AACE_INFO(LX(TAG).m("reportWritten").d("path", path));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("path", path));
+        return false;
+    }
+}
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
@@ -29,20 +29,35 @@ PublishMessage::PublishMessage(
     const std::string& message,
     std::chrono::milliseconds timeout,
     InvokeHandler invokeHandler) :
-        m_direction(direction), m_message(message), m_timeout(timeout), m_invokeHandler(invokeHandler) {
+        m_direction(direction),
+        m_message(message, direction, Message::ParseMode::LAZY),
+        m_timeout(timeout),
+        m_invokeHandler(invokeHandler) {
 }
 
-PublishMessage::PublishMessage(const PublishMessage& pm) {
-    m_direction = pm.m_direction;
-    m_message = pm.m_message;
-    m_timeout = pm.m_timeout;
-    m_successHandler = pm.m_successHandler;
-    m_errorHandler = pm.m_errorHandler;
-    m_invokeHandler = pm.m_invokeHandler;
+PublishMessage::PublishMessage(
+    const Message& message,
+    std::chrono::milliseconds timeout,
+    InvokeHandler invokeHandler) :
+        m_direction(message.direction()),
+        m_message(message),
+        m_timeout(timeout),
+        m_invokeHandler(invokeHandler) {
+}
+
+PublishMessage::PublishMessage(const PublishMessage& pm) :
+        m_direction(pm.m_direction),
+        m_message(pm.m_message),
+        m_timeout(pm.m_timeout),
+        m_hasTimeout(pm.m_hasTimeout),
+        m_invokeHandler(pm.m_invokeHandler),
+        m_successHandler(pm.m_successHandler),
+        m_errorHandler(pm.m_errorHandler) {
 }
 
 PublishMessage& PublishMessage::timeout(std::chrono::milliseconds value) {
     m_timeout = value;
+    m_hasTimeout = true;
     return *this;
 }
 
@@ -82,7 +97,7 @@ Message PublishMessage::get() {
 }
 
 std::string PublishMessage::msg() const {
-    return m_message;
+    return m_message.raw();
 }
 
 Message::Direction PublishMessage::direction() const {
@@ -93,6 +108,10 @@ std::chrono::milliseconds PublishMessage::timeout() const {
     return m_timeout;
 }
 
+bool PublishMessage::hasTimeout() const {
+    return m_hasTimeout;
+}
+
 PublishMessage::SuccessHandler PublishMessage::successHandler() const {
     return m_successHandler;
 }
@@ -101,12 +120,13 @@ PublishMessage::ErrorHandler PublishMessage::errorHandler() const {
     return m_errorHandler;
 }
 
-Message PublishMessage::message() const {
-    return Message(m_message, m_direction);
+const Message& PublishMessage::message() const {
+    return m_message;
 }
 
 bool PublishMessage::valid() const {
-    return m_invokeHandler != nullptr && m_message.empty() == false;
+    // a message created from an object is valid without serializing it
+    return m_invokeHandler != nullptr && (m_message.valid() || m_message.raw().empty() == false);
 }
 
 }  // namespace messageBroker
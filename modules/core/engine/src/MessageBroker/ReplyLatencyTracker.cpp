@@ -0,0 +1,184 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <AACE/Engine/MessageBroker/ReplyLatencyTracker.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+using namespace aace::engine::utils::metrics;
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "MessageBroker";
+
+/// Metric datapoints of the reply statistics
+static const std::string METRIC_MESSAGE_TOPIC = "Topic";
+static const std::string METRIC_MESSAGE_ACTION = "Action";
+static const std::string METRIC_REPLIES = "Replies";
+static const std::string METRIC_TIMEOUTS = "Timeouts";
+static const std::string METRIC_AVERAGE_LATENCY = "AverageReplyLatency";
+static const std::string METRIC_P99_LATENCY = "P99ReplyLatency";
+static const std::string METRIC_REPLY_TIMEOUT = "ReplyTimeout";
+
+/// The weight of a reply in the moving average of the latency
+static constexpr double LATENCY_AVERAGE_WEIGHT = 0.125;
+
+constexpr size_t ReplyLatencyTracker::WINDOW_SIZE;
+constexpr uint32_t ReplyLatencyTracker::UPDATE_INTERVAL;
+
+static void emitStats(const ReplyLatencyTracker::TopicStats& stats, uint32_t replies, uint32_t timeouts) {
+    emitMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX,
+        "updateReplyTimeout",
+        {{METRIC_REPLIES, static_cast<int>(replies)}, {METRIC_TIMEOUTS, static_cast<int>(timeouts)}},
+        {{METRIC_MESSAGE_TOPIC, stats.topic}, {METRIC_MESSAGE_ACTION, stats.action}},
+        {{METRIC_AVERAGE_LATENCY, stats.averageLatencyMs},
+         {METRIC_P99_LATENCY, stats.p99LatencyMs},
+         {METRIC_REPLY_TIMEOUT, static_cast<double>(stats.timeout.count())}});
+}
+
+void ReplyLatencyTracker::setConfig(const Config& config) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_config = config;
+    m_config.minSamples = std::min<uint32_t>(std::max<uint32_t>(config.minSamples, 1), WINDOW_SIZE);
+    m_topics.clear();
+}
+
+std::chrono::milliseconds ReplyLatencyTracker::getTimeout(
+    const std::string& topic,
+    const std::string& action,
+    std::chrono::milliseconds defaultTimeout) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_config.enabled) {
+        return defaultTimeout;
+    }
+    auto it = m_topics.find(topic + ":" + action);
+    if (it == m_topics.end() || it->second.stats.timeout.count() == 0) {
+        return defaultTimeout;
+    }
+    return it->second.stats.timeout;
+}
+
+void ReplyLatencyTracker::recordReply(const std::string& topic, const std::string& action, Clock::duration latency) {
+    TopicStats stats;
+    uint32_t replies = 0, timeouts = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& state = getState(topic, action);
+        auto latencyMs = std::chrono::duration<double, std::milli>(latency).count();
+        auto& average = state.stats.averageLatencyMs;
+        average = state.stats.replies == 0 ? latencyMs : average + LATENCY_AVERAGE_WEIGHT * (latencyMs - average);
+        state.stats.replies++;
+        state.newReplies++;
+        addLatency(state, latency);
+        if (++state.sinceUpdate < UPDATE_INTERVAL && state.count != m_config.minSamples) {
+            return;
+        }
+        updateTimeout(state);
+        stats = state.stats;
+        std::swap(replies, state.newReplies);
+        std::swap(timeouts, state.newTimeouts);
+    }
+    emitStats(stats, replies, timeouts);
+}
+
+void ReplyLatencyTracker::recordTimeout(
+    const std::string& topic,
+    const std::string& action,
+    std::chrono::milliseconds timeout) {
+    TopicStats stats;
+    uint32_t replies = 0, timeouts = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& state = getState(topic, action);
+        state.stats.timeouts++;
+        state.newTimeouts++;
+        // the reply would have taken at least the timeout, and the timeout is raised at once
+        addLatency(state, timeout);
+        updateTimeout(state);
+        stats = state.stats;
+        std::swap(replies, state.newReplies);
+        std::swap(timeouts, state.newTimeouts);
+    }
+    emitStats(stats, replies, timeouts);
+}
+
+std::vector<ReplyLatencyTracker::TopicStats> ReplyLatencyTracker::getSnapshot() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<TopicStats> snapshot;
+    snapshot.reserve(m_topics.size());
+    for (auto& next : m_topics) {
+        snapshot.push_back(next.second.stats);
+    }
+    return snapshot;
+}
+
+void ReplyLatencyTracker::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_topics.clear();
+}
+
+ReplyLatencyTracker::TopicState& ReplyLatencyTracker::getState(const std::string& topic, const std::string& action) {
+    auto key = topic + ":" + action;
+    auto it = m_topics.find(key);
+    if (it != m_topics.end()) {
+        return it->second;
+    }
+
+    auto& state = m_topics[key];
+    state.stats.topic = topic;
+    state.stats.action = action;
+    auto limits = m_config.topicLimits.find(key);
+    if (limits == m_config.topicLimits.end()) {
+        limits = m_config.topicLimits.find(topic);
+    }
+    state.limits = limits != m_config.topicLimits.end() ? limits->second : m_config.limits;
+    return state;
+}
+
+void ReplyLatencyTracker::addLatency(TopicState& state, Clock::duration latency) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    state.latencies[state.next] =
+        static_cast<uint32_t>(std::min<int64_t>(std::max<int64_t>(us, 0), std::numeric_limits<uint32_t>::max()));
+    state.next = (state.next + 1) % WINDOW_SIZE;
+    state.count = std::min(state.count + 1, WINDOW_SIZE);
+}
+
+void ReplyLatencyTracker::updateTimeout(TopicState& state) {
+    state.sinceUpdate = 0;
+
+    std::array<uint32_t, WINDOW_SIZE> sorted;
+    auto end = std::copy(state.latencies.begin(), state.latencies.begin() + state.count, sorted.begin());
+    auto p99 = sorted.begin() + static_cast<size_t>(std::ceil(state.count * 0.99)) - 1;
+    std::nth_element(sorted.begin(), p99, end);
+    state.stats.p99LatencyMs = *p99 / 1000.0;
+
+    if (state.count < m_config.minSamples) {
+        return;
+    }
+    auto timeout = std::chrono::milliseconds(
+        static_cast<int64_t>(std::ceil(state.stats.p99LatencyMs * m_config.multiplier)));
+    state.stats.timeout = std::min(std::max(timeout, state.limits.minTimeout), state.limits.maxTimeout);
+}
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,298 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/MessageBroker/RingBufferMessageStream.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.messageBroker.RingBufferMessageStream");
+
+/// Identifies an initialized ring buffer control block
+static const uint32_t RING_BUFFER_MAGIC = 0x41524246;
+
+/// Version of the control block layout
+static const uint32_t RING_BUFFER_VERSION = 1;
+
+/// Largest supported buffer size
+static const size_t MAX_CAPACITY = size_t(1) << 30;
+
+RingBufferMessageStream::RingBufferMessageStream(
+    ControlBlock* control,
+    size_t mappedSize,
+    const std::string& sharedName,
+    bool owner,
+    Mode mode) :
+        m_control(control),
+        m_mappedSize(mappedSize),
+        m_sharedName(sharedName),
+        m_owner(owner),
+        m_mode(mode),
+        m_mask(control->capacity - 1) {
+}
+
+RingBufferMessageStream::~RingBufferMessageStream() {
+    munmap(m_control, m_mappedSize);
+#ifndef __ANDROID__
+    if (m_owner && !m_sharedName.empty()) {
+        shm_unlink(m_sharedName.c_str());
+    }
+#endif
+}
+
+size_t RingBufferMessageStream::roundUpCapacity(size_t capacity) {
+    size_t result = 1;
+    while (result < capacity) {
+        result <<= 1;
+    }
+    return result;
+}
+
+void RingBufferMessageStream::initialize(ControlBlock* control, size_t capacity) {
+    new (control) ControlBlock();
+    control->capacity = capacity;
+    control->writeIndex = 0;
+    control->readIndex = 0;
+    control->closed = 0;
+    control->version = RING_BUFFER_VERSION;
+
+    // publish the magic last so a process opening the buffer never sees a partial control block
+    std::atomic_thread_fence(std::memory_order_release);
+    control->magic = RING_BUFFER_MAGIC;
+}
+
+std::shared_ptr<RingBufferMessageStream> RingBufferMessageStream::create(size_t capacity, Mode mode) {
+    try {
+        ThrowIf(capacity == 0 || capacity > MAX_CAPACITY, "invalidCapacity");
+        capacity = roundUpCapacity(capacity);
+
+        auto mappedSize = sizeof(ControlBlock) + capacity;
+        auto memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        ThrowIf(memory == MAP_FAILED, "mapMemoryFailed");
+
+        auto control = static_cast<ControlBlock*>(memory);
+        initialize(control, capacity);
+
+        return std::shared_ptr<RingBufferMessageStream>(
+            new RingBufferMessageStream(control, mappedSize, "", true, mode));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("capacity", capacity));
+        return nullptr;
+    }
+}
+
+std::shared_ptr<RingBufferMessageStream> RingBufferMessageStream::createShared(
+    const std::string& name,
+    size_t capacity,
+    Mode mode) {
+#ifdef __ANDROID__
+    AACE_ERROR(LX(TAG).d("reason", "sharedMemoryNotSupported").d("name", name));
+    return nullptr;
+#else
+    int fd = -1;
+    try {
+        ThrowIf(name.empty() || name[0] != '/', "invalidName");
+        ThrowIf(capacity == 0 || capacity > MAX_CAPACITY, "invalidCapacity");
+        capacity = roundUpCapacity(capacity);
+
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+        ThrowIf(fd < 0, "createSharedMemoryFailed");
+
+        auto mappedSize = sizeof(ControlBlock) + capacity;
+        ThrowIf(ftruncate(fd, static_cast<off_t>(mappedSize)) != 0, "resizeSharedMemoryFailed");
+
+        auto memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ThrowIf(memory == MAP_FAILED, "mapMemoryFailed");
+        ::close(fd);
+        fd = -1;
+
+        auto control = static_cast<ControlBlock*>(memory);
+        initialize(control, capacity);
+
+        return std::shared_ptr<RingBufferMessageStream>(
+            new RingBufferMessageStream(control, mappedSize, name, true, mode));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("name", name).d("capacity", capacity));
+        if (fd >= 0) {
+            ::close(fd);
+            shm_unlink(name.c_str());
+        }
+        return nullptr;
+    }
+#endif
+}
+
+std::shared_ptr<RingBufferMessageStream> RingBufferMessageStream::openShared(const std::string& name, Mode mode) {
+#ifdef __ANDROID__
+    AACE_ERROR(LX(TAG).d("reason", "sharedMemoryNotSupported").d("name", name));
+    return nullptr;
+#else
+    int fd = -1;
+    void* memory = MAP_FAILED;
+    size_t mappedSize = 0;
+    try {
+        fd = shm_open(name.c_str(), O_RDWR, 0);
+        ThrowIf(fd < 0, "openSharedMemoryFailed");
+
+        struct stat info;
+        ThrowIf(fstat(fd, &info) != 0, "statSharedMemoryFailed");
+        mappedSize = static_cast<size_t>(info.st_size);
+        ThrowIf(mappedSize <= sizeof(ControlBlock), "invalidSharedMemorySize");
+
+        memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ThrowIf(memory == MAP_FAILED, "mapMemoryFailed");
+        ::close(fd);
+        fd = -1;
+
+        auto control = static_cast<ControlBlock*>(memory);
+        ThrowIf(control->magic != RING_BUFFER_MAGIC, "invalidControlBlock");
+        std::atomic_thread_fence(std::memory_order_acquire);
+        ThrowIf(control->version != RING_BUFFER_VERSION, "unsupportedVersion");
+        ThrowIf(sizeof(ControlBlock) + control->capacity != mappedSize, "invalidCapacity");
+
+        return std::shared_ptr<RingBufferMessageStream>(
+            new RingBufferMessageStream(control, mappedSize, name, false, mode));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("name", name));
+        if (memory != MAP_FAILED) {
+            munmap(memory, mappedSize);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return nullptr;
+    }
+#endif
+}
+
+char* RingBufferMessageStream::buffer() const {
+    return reinterpret_cast<char*>(m_control) + sizeof(ControlBlock);
+}
+
+RingBufferMessageStream::Region RingBufferMessageStream::acquireWriteRegion(size_t maxSize) {
+    Region region;
+    if (m_control->closed.load(std::memory_order_acquire) != 0) {
+        return region;
+    }
+
+    auto writeIndex = m_control->writeIndex.load(std::memory_order_relaxed);
+    auto readIndex = m_control->readIndex.load(std::memory_order_acquire);
+    auto free = m_control->capacity - (writeIndex - readIndex);
+    auto offset = writeIndex & m_mask;
+
+    region.data = buffer() + offset;
+    region.size = static_cast<size_t>(std::min<uint64_t>({free, m_control->capacity - offset, maxSize}));
+    return region;
+}
+
+void RingBufferMessageStream::commitWriteRegion(size_t size) {
+    auto writeIndex = m_control->writeIndex.load(std::memory_order_relaxed);
+    m_control->writeIndex.store(writeIndex + size, std::memory_order_release);
+}
+
+RingBufferMessageStream::Region RingBufferMessageStream::acquireReadRegion(size_t maxSize) {
+    Region region;
+    auto readIndex = m_control->readIndex.load(std::memory_order_relaxed);
+    auto writeIndex = m_control->writeIndex.load(std::memory_order_acquire);
+    auto offset = readIndex & m_mask;
+
+    region.data = buffer() + offset;
+    region.size =
+        static_cast<size_t>(std::min<uint64_t>({writeIndex - readIndex, m_control->capacity - offset, maxSize}));
+    return region;
+}
+
+void RingBufferMessageStream::commitReadRegion(size_t size) {
+    auto readIndex = m_control->readIndex.load(std::memory_order_relaxed);
+    m_control->readIndex.store(readIndex + size, std::memory_order_release);
+}
+
+void RingBufferMessageStream::close() {
+    m_control->closed.store(1, std::memory_order_release);
+}
+
+size_t RingBufferMessageStream::available() const {
+    return static_cast<size_t>(
+        m_control->writeIndex.load(std::memory_order_acquire) - m_control->readIndex.load(std::memory_order_acquire));
+}
+
+size_t RingBufferMessageStream::capacity() const {
+    return static_cast<size_t>(m_control->capacity);
+}
+
+//
+// aace::core::MessageStream
+//
+
+ssize_t RingBufferMessageStream::read(char* data, const size_t size) {
+    size_t total = 0;
+
+    // the available data wraps around the end of the buffer at most once
+    for (int i = 0; i < 2 && total < size; i++) {
+        auto region = acquireReadRegion(size - total);
+        if (region.size == 0) {
+            break;
+        }
+        std::memcpy(data + total, region.data, region.size);
+        commitReadRegion(region.size);
+        total += region.size;
+    }
+
+    return static_cast<ssize_t>(total);
+}
+
+ssize_t RingBufferMessageStream::write(const char* data, const size_t size) {
+    if (m_control->closed.load(std::memory_order_acquire) != 0) {
+        AACE_ERROR(LX(TAG).d("reason", "streamClosed"));
+        return -1;
+    }
+
+    size_t total = 0;
+    for (int i = 0; i < 2 && total < size; i++) {
+        auto region = acquireWriteRegion(size - total);
+        if (region.size == 0) {
+            break;
+        }
+        std::memcpy(region.data, data + total, region.size);
+        commitWriteRegion(region.size);
+        total += region.size;
+    }
+
+    return static_cast<ssize_t>(total);
+}
+
+bool RingBufferMessageStream::isClosed() {
+    return m_control->closed.load(std::memory_order_acquire) != 0 && available() == 0;
+}
+
+aace::core::MessageStream::Mode RingBufferMessageStream::getMode() {
+    return m_mode;
+}
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
@@ -30,6 +30,30 @@ std::shared_ptr<StreamManagerImpl> StreamManagerImpl::create() {
 }
 
 void StreamManagerImpl::shutdown() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // release the persistent stream handlers, which may reference their owners
+    m_streamMap.clear();
+    m_trafficRecorder.reset();
+}
+
+std::shared_ptr<RingBufferMessageStream> StreamManagerImpl::createRingBufferStream(
+    const std::string& streamId,
+    size_t capacity,
+    aace::core::MessageStream::Mode mode,
+    const std::string& sharedMemoryName) {
+    try {
+        auto stream = sharedMemoryName.empty()
+                          ? RingBufferMessageStream::create(capacity, mode)
+                          : RingBufferMessageStream::createShared(sharedMemoryName, capacity, mode);
+        ThrowIfNull(stream, "createRingBufferStreamFailed");
+        ThrowIfNot(registerStreamHandler(streamId, stream), "registerStreamHandlerFailed");
+
+        return stream;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("streamId", streamId));
+        return nullptr;
+    }
 }
 
 //
@@ -38,13 +62,14 @@ void StreamManagerImpl::shutdown() {
 
 bool StreamManagerImpl::registerStreamHandler(
     const std::string& streamId,
-    std::shared_ptr<aace::core::MessageStream> stream) {
+    std::shared_ptr<aace::core::MessageStream> stream,
+    bool persistent) {
     try {
         std::lock_guard<std::mutex> lock(m_mutex);
 
         ThrowIf(m_streamMap.find(streamId) != m_streamMap.end(), "streamAlreadyRegistered");
 
-        m_streamMap[streamId] = stream;
+        m_streamMap[streamId] = {stream, persistent};
 
         return true;
     } catch (std::exception& ex) {
@@ -53,6 +78,11 @@ bool StreamManagerImpl::registerStreamHandler(
     }
 }
 
+void StreamManagerImpl::setTrafficRecorder(std::shared_ptr<MessageTrafficRecorder> recorder) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_trafficRecorder = recorder;
+}
+
 std::shared_ptr<aace::core::MessageStream> StreamManagerImpl::requestStreamHandler(
     const std::string& streamId,
     aace::core::MessageStream::Mode mode) {
@@ -62,23 +92,41 @@ std::shared_ptr<aace::core::MessageStream> StreamManagerImpl::requestStreamHandl
         auto it = m_streamMap.find(streamId);
         ThrowIf(it == m_streamMap.end(), "invalidStream");
 
-        auto stream = it->second;
+        auto stream = it->second.stream;
 
         // check that the stream mode is valid
         ThrowIfNot(
             stream->getMode() == aace::core::MessageStream::Mode::READ_WRITE || stream->getMode() == mode,
             "invalidStreamMode");
 
-        // remove the stream from the map
-        m_streamMap.erase(it);
+        // remove the stream from the map, unless it is reused for subsequent requests
+        if (!it->second.persistent) {
+            m_streamMap.erase(it);
+        }
 
-        return stream;
+        return m_trafficRecorder != nullptr ? m_trafficRecorder->wrapStream(streamId, stream) : stream;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return nullptr;
     }
 }
 
+bool StreamManagerImpl::unregisterStreamHandler(const std::string& streamId) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_streamMap.find(streamId);
+        ThrowIf(it == m_streamMap.end(), "invalidStream");
+
+        m_streamMap.erase(it);
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("streamId", streamId));
+        return false;
+    }
+}
+
 }  // namespace messageBroker
 }  // namespace engine
 }  // namespace aace
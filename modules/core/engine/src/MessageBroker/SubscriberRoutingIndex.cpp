@@ -0,0 +1,204 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/MessageBroker/SubscriberRoutingIndex.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace messageBroker {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.messageBroker.SubscriberRoutingIndex");
+
+constexpr SubscriberRoutingIndex::InternId SubscriberRoutingIndex::WILDCARD_ID;
+
+SubscriberRoutingIndex::SubscriberRoutingIndex() {
+    for (auto& next : m_wildcardRoutes) {
+        next = std::make_shared<const HandlerList>();
+    }
+}
+
+size_t SubscriberRoutingIndex::directionIndex(Message::Direction direction) {
+    return direction == Message::Direction::INCOMING ? 0 : 1;
+}
+
+bool SubscriberRoutingIndex::isWildcard(const std::string& name) {
+    return name.empty() || name == "*";
+}
+
+SubscriberRoutingIndex::TopicEntry& SubscriberRoutingIndex::internTopic(const std::string& topic) {
+    auto it = m_topicIds.find(topic);
+    if (it != m_topicIds.end()) {
+        return m_topics[it->second];
+    }
+
+    m_topicIds[topic] = m_topics.size();
+    m_topics.emplace_back();
+
+    // every topic entry reserves the first action slot for its "topic:*" route
+    auto& entry = m_topics.back();
+    for (size_t direction = 0; direction < entry.subscribers.size(); direction++) {
+        entry.subscribers[direction].emplace_back();
+        entry.routes[direction].emplace_back();
+        compileRoutes(direction, entry);
+    }
+
+    return entry;
+}
+
+SubscriberRoutingIndex::InternId SubscriberRoutingIndex::internAction(TopicEntry& entry, const std::string& action) {
+    if (isWildcard(action)) {
+        return WILDCARD_ID;
+    }
+
+    auto it = entry.actionIds.find(action);
+    if (it != entry.actionIds.end()) {
+        return it->second;
+    }
+
+    InternId id = entry.subscribers[0].size();
+    entry.actionIds[action] = id;
+
+    // the new action slot routes to the "topic:*" and "*:*" handlers in both directions, including the one
+    // the action is not subscribed in
+    for (size_t direction = 0; direction < entry.subscribers.size(); direction++) {
+        entry.subscribers[direction].emplace_back();
+        entry.routes[direction].emplace_back();
+        compileRoutes(direction, entry);
+    }
+
+    return id;
+}
+
+void SubscriberRoutingIndex::compileRoutes(size_t direction, TopicEntry& entry) {
+    auto& subscribers = entry.subscribers[direction];
+    auto& routes = entry.routes[direction];
+    auto& wildcard = m_wildcardSubscribers[direction];
+
+    for (InternId id = 0; id < subscribers.size(); id++) {
+        auto handlers = std::make_shared<HandlerList>();
+        handlers->reserve(
+            subscribers[id].size() + (id != WILDCARD_ID ? subscribers[WILDCARD_ID].size() : 0) + wildcard.size());
+
+        // "topic:action" handlers are notified first, followed by "topic:*" and "*:*"
+        for (auto& next : subscribers[id]) {
+            handlers->push_back(next.handler);
+        }
+        if (id != WILDCARD_ID) {
+            for (auto& next : subscribers[WILDCARD_ID]) {
+                handlers->push_back(next.handler);
+            }
+        }
+        for (auto& next : wildcard) {
+            handlers->push_back(next.handler);
+        }
+
+        routes[id] = handlers;
+    }
+}
+
+void SubscriberRoutingIndex::compileWildcardRoutes(size_t direction) {
+    auto handlers = std::make_shared<HandlerList>();
+    handlers->reserve(m_wildcardSubscribers[direction].size());
+    for (auto& next : m_wildcardSubscribers[direction]) {
+        handlers->push_back(next.handler);
+    }
+    m_wildcardRoutes[direction] = handlers;
+
+    // the "*:*" handlers are part of every compiled route in this direction
+    for (auto& next : m_topics) {
+        compileRoutes(direction, next);
+    }
+}
+
+SubscriberRoutingIndex::SubscriptionId SubscriberRoutingIndex::addHandler(
+    Message::Direction direction,
+    const std::string& topic,
+    const std::string& action,
+    MessageHandler handler) {
+    auto index = directionIndex(direction);
+    auto id = m_nextSubscriptionId++;
+
+    if (isWildcard(topic)) {
+        if (!isWildcard(action)) {
+            AACE_WARN(LX(TAG).m("Ignoring action for wildcard topic subscription").d("action", action));
+        }
+
+        m_wildcardSubscribers[index].push_back({id, handler});
+        m_routes[id] = {index, true, WILDCARD_ID, WILDCARD_ID};
+
+        compileWildcardRoutes(index);
+    } else {
+        auto& entry = internTopic(topic);
+        auto actionId = internAction(entry, action);
+
+        entry.subscribers[index][actionId].push_back({id, handler});
+        m_routes[id] = {index, false, m_topicIds[topic], actionId};
+
+        compileRoutes(index, entry);
+    }
+
+    return id;
+}
+
+bool SubscriberRoutingIndex::removeHandler(SubscriptionId id) {
+    auto it = m_routes.find(id);
+    if (it == m_routes.end()) {
+        return false;
+    }
+
+    auto route = it->second;
+    m_routes.erase(it);
+
+    // topic and action names stay interned so existing ids remain stable
+    auto& subscribers = route.wildcardTopic ? m_wildcardSubscribers[route.direction]
+                                            : m_topics[route.topicId].subscribers[route.direction][route.actionId];
+    for (auto next = subscribers.begin(); next != subscribers.end(); next++) {
+        if (next->id == id) {
+            subscribers.erase(next);
+            break;
+        }
+    }
+
+    if (route.wildcardTopic) {
+        compileWildcardRoutes(route.direction);
+    } else {
+        compileRoutes(route.direction, m_topics[route.topicId]);
+    }
+
+    return true;
+}
+
+SubscriberRoutingIndex::HandlerListPtr SubscriberRoutingIndex::getHandlers(
+    Message::Direction direction,
+    const std::string& topic,
+    const std::string& action) const {
+    auto index = directionIndex(direction);
+
+    auto topicIt = m_topicIds.find(topic);
+    if (topicIt == m_topicIds.end()) {
+        return m_wildcardRoutes[index];
+    }
+
+    auto& entry = m_topics[topicIt->second];
+    auto actionIt = entry.actionIds.find(action);
+
+    return entry.routes[index][actionIt != entry.actionIds.end() ? actionIt->second : WILDCARD_ID];
+}
+
+}  // namespace messageBroker
+}  // namespace engine
+}  // namespace aace
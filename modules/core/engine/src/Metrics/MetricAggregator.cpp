@@ -0,0 +1,270 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#include "AACE/Engine/Metrics/MetricAggregator.h"
+#include "AACE/Engine/Metrics/MetricEvent.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+
+namespace aace {
+namespace engine {
+namespace metrics {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.metrics.MetricAggregator");
+
+/// Separates the program, source and name of a datapoint key, which the metric log format doesn't allow in them
+static const char KEY_SEPARATOR = ':';
+
+/// The largest timer value, in milliseconds, larger values are counted in its bucket
+static const double MAX_TIMER_VALUE = 1e15;
+
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+std::shared_ptr<MetricAggregator> MetricAggregator::create(std::shared_ptr<TimerWheel> timerWheel) {
+    try {
+        if (timerWheel == nullptr) {
+            timerWheel = TimerWheel::getDefault();
+        }
+        ThrowIfNull(timerWheel, "invalidTimerWheel");
+        return std::shared_ptr<MetricAggregator>(new MetricAggregator(timerWheel));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+std::shared_ptr<MetricAggregator> MetricAggregator::getDefault() {
+    static std::shared_ptr<MetricAggregator> s_defaultAggregator = create();
+    return s_defaultAggregator;
+}
+
+MetricAggregator::MetricAggregator(std::shared_ptr<TimerWheel> timerWheel) :
+        m_timerWheel{timerWheel},
+        m_enabled{false},
+        m_flushInterval{std::chrono::milliseconds::zero()},
+        m_flushTimer{TimerWheel::INVALID_TIMER} {
+}
+
+MetricAggregator::~MetricAggregator() {
+    if (m_flushTimer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(m_flushTimer);
+    }
+}
+
+void MetricAggregator::setFlushInterval(std::chrono::milliseconds interval) {
+    {
+        std::lock_guard<std::mutex> lock(m_flushMutex);
+        if (interval.count() < 0) {
+            interval = std::chrono::milliseconds::zero();
+        }
+        if (interval == m_flushInterval) {
+            return;
+        }
+        if (m_flushTimer != TimerWheel::INVALID_TIMER) {
+            m_timerWheel->cancel(m_flushTimer);
+            m_flushTimer = TimerWheel::INVALID_TIMER;
+        }
+        m_flushInterval = interval;
+        m_enabled = interval.count() > 0;
+        if (m_enabled) {
+            std::weak_ptr<MetricAggregator> wp = shared_from_this();
+            m_flushTimer = m_timerWheel->submitPeriodic(interval, [wp]() {
+                if (auto aggregator = wp.lock()) {
+                    aggregator->flush();
+                }
+            });
+        }
+    }
+    AACE_INFO(LX(TAG).d("flushInterval", interval.count()));
+
+    // the datapoints aggregated with the previous interval are recorded now
+    flush();
+}
+
+std::chrono::milliseconds MetricAggregator::getFlushInterval() {
+    std::lock_guard<std::mutex> lock(m_flushMutex);
+    return m_flushInterval;
+}
+
+bool MetricAggregator::isEnabled() const {
+    return m_enabled;
+}
+
+bool MetricAggregator::addCounter(
+    const std::string& program,
+    const std::string& source,
+    const std::string& name,
+    int value) {
+    if (!m_enabled) {
+        return false;
+    }
+    const auto& key = makeKey(program, source, name);
+    auto& shard = getShard();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& counter = shard.counters[key];
+    counter.sum += value;
+    counter.sampleCount++;
+    return true;
+}
+
+bool MetricAggregator::addTimer(
+    const std::string& program,
+    const std::string& source,
+    const std::string& name,
+    double value) {
+    if (!m_enabled) {
+        return false;
+    }
+    auto bucket = getTimerBucket(value);
+    const auto& key = makeKey(program, source, name);
+    auto& shard = getShard();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.timers[key][bucket]++;
+    return true;
+}
+
+std::vector<MetricAggregator::Metric> MetricAggregator::collect() {
+    // merge the shards by program and source, each shard is only locked while it is taken over
+    std::map<std::string, CounterValue> counters;
+    std::map<std::string, Histogram> timers;
+    for (auto& shard : m_shards) {
+        std::unordered_map<std::string, CounterValue> shardCounters;
+        std::unordered_map<std::string, Histogram> shardTimers;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shardCounters.swap(shard.counters);
+            shardTimers.swap(shard.timers);
+        }
+        for (const auto& it : shardCounters) {
+            auto& counter = counters[it.first];
+            counter.sum += it.second.sum;
+            counter.sampleCount += it.second.sampleCount;
+        }
+        for (const auto& it : shardTimers) {
+            auto& histogram = timers[it.first];
+            for (const auto& bucket : it.second) {
+                histogram[bucket.first] += bucket.second;
+            }
+        }
+    }
+
+    std::map<std::string, Metric> metrics;
+    std::string programAndSource;
+    std::string name;
+    for (const auto& it : counters) {
+        if (splitKey(it.first, programAndSource, name)) {
+            metrics[programAndSource].counters.push_back({name, it.second.sum, it.second.sampleCount});
+        }
+    }
+    for (const auto& it : timers) {
+        if (splitKey(it.first, programAndSource, name)) {
+            auto& metric = metrics[programAndSource];
+            for (const auto& bucket : it.second) {
+                metric.timers.push_back({name, getTimerBucketValue(bucket.first), bucket.second});
+            }
+        }
+    }
+
+    std::vector<Metric> result;
+    result.reserve(metrics.size());
+    for (auto& it : metrics) {
+        auto separator = it.first.find(KEY_SEPARATOR);
+        it.second.program = it.first.substr(0, separator);
+        it.second.source = it.first.substr(separator + 1);
+        result.push_back(std::move(it.second));
+    }
+    return result;
+}
+
+void MetricAggregator::flush() {
+    std::lock_guard<std::mutex> lock(m_flushMutex);
+    for (const auto& metric : collect()) {
+        MetricEvent metricEvent(metric.program, metric.source);
+        for (const auto& counter : metric.counters) {
+            auto sum = std::max<int64_t>(
+                std::numeric_limits<int>::min(), std::min<int64_t>(std::numeric_limits<int>::max(), counter.sum));
+            metricEvent.addCounter(counter.name, static_cast<int>(sum), counter.sampleCount);
+        }
+        for (const auto& timer : metric.timers) {
+            metricEvent.addTimer(timer.name, timer.value, timer.sampleCount);
+        }
+        metricEvent.record();
+    }
+}
+
+uint32_t MetricAggregator::getTimerBucket(double value) {
+    // values below the first power of two with a full set of sub-buckets have a bucket each
+    if (!(value >= 0)) {
+        return 0;
+    }
+    uint64_t rounded = static_cast<uint64_t>(std::llround(std::min(value, MAX_TIMER_VALUE)));
+    const uint64_t subBucketCount = uint64_t(1) << SUB_BUCKET_BITS;
+    if (rounded < subBucketCount) {
+        return static_cast<uint32_t>(rounded);
+    }
+    int msb = 63;
+    while ((rounded >> msb) == 0) {
+        msb--;
+    }
+    int shift = msb - SUB_BUCKET_BITS;
+    uint64_t subBucket = rounded >> shift;
+    return static_cast<uint32_t>((shift + 1) * subBucketCount + (subBucket - subBucketCount));
+}
+
+double MetricAggregator::getTimerBucketValue(uint32_t bucket) {
+    const uint32_t subBucketCount = uint32_t(1) << SUB_BUCKET_BITS;
+    if (bucket < subBucketCount) {
+        return bucket;
+    }
+    int shift = static_cast<int>(bucket / subBucketCount) - 1;
+    double lower = std::ldexp(static_cast<double>(bucket % subBucketCount + subBucketCount), shift);
+    double upper = std::ldexp(static_cast<double>(bucket % subBucketCount + subBucketCount + 1), shift) - 1;
+    return (lower + upper) / 2;
+}
+
+MetricAggregator::Shard& MetricAggregator::getShard() {
+    static thread_local size_t s_shardIndex = std::hash<std::thread::id>()(std::this_thread::get_id()) % SHARD_COUNT;
+    return m_shards[s_shardIndex];
+}
+
+const std::string& MetricAggregator::makeKey(
+    const std::string& program,
+    const std::string& source,
+    const std::string& name) {
+    // the buffer keeps its capacity, so building a key doesn't allocate once the thread has built a longer key
+    static thread_local std::string s_key;
+    s_key.assign(program).append(1, KEY_SEPARATOR).append(source).append(1, KEY_SEPARATOR).append(name);
+    return s_key;
+}
+
+bool MetricAggregator::splitKey(const std::string& key, std::string& programAndSource, std::string& name) {
+    auto first = key.find(KEY_SEPARATOR);
+    auto second = first != std::string::npos ? key.find(KEY_SEPARATOR, first + 1) : std::string::npos;
+    if (second == std::string::npos) {
+        return false;
+    }
+    programAndSource.assign(key, 0, second);
+    name.assign(key, second + 1, std::string::npos);
+    return true;
+}
+
+}  // namespace metrics
+}  // namespace engine
+}  // namespace aace
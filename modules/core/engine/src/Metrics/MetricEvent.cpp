@@ -64,6 +64,10 @@ void MetricEvent::addTimer(const std::string& name, double value) {
     addDataToLog(name, std::to_string(value), MetricDataType::TI, METRIC_NUM_SAMPLES_DEFAULT);
 }
 
+void MetricEvent::addTimer(const std::string& name, double value, uint32_t sampleCount) {
+    addDataToLog(name, std::to_string(value), MetricDataType::TI, std::to_string(sampleCount));
+}
+
 void MetricEvent::addString(const std::string& name, const std::string& value) {
     addDataToLog(name, value, MetricDataType::DV, METRIC_NUM_SAMPLES_DEFAULT);
 }
@@ -72,6 +76,10 @@ void MetricEvent::addCounter(const std::string& name, int value) {
     addDataToLog(name, std::to_string(value), MetricDataType::CT, METRIC_NUM_SAMPLES_DEFAULT);
 }
 
+void MetricEvent::addCounter(const std::string& name, int value, uint32_t sampleCount) {
+    addDataToLog(name, std::to_string(value), MetricDataType::CT, std::to_string(sampleCount));
+}
+
 void MetricEvent::record() {
     std::string priorityStr = priorityToString(m_priority);
     m_metricLog.append(":").append(priorityStr);
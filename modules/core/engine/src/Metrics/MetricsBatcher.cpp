@@ -0,0 +1,427 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+#ifdef AAC_LOG_COMPRESSION
+#include <zlib.h>
+#endif
+
+#include <nlohmann/json.hpp>
+
+#include "AACE/Engine/Metrics/MetricsBatcher.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/Encoding/Base64.h"
+
+namespace aace {
+namespace engine {
+namespace metrics {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.metrics.MetricsBatcher");
+
+const std::string MetricsBatcher::SPOOL_TABLE = "aace.metrics.spool";
+
+/// Prefixes of the spooled batches, compressed and base64 encoded, or plain
+static const char COMPRESSED_PREFIX = 'z';
+static const char PLAIN_PREFIX = 'j';
+
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+using Datapoint = aace::metrics::MetricsUploader::Datapoint;
+using DatapointType = aace::metrics::MetricsUploader::DatapointType;
+
+/// Returns the spooled form of a serialized batch.
+static std::string encode(const std::string& data) {
+#ifdef AAC_LOG_COMPRESSION
+    uLongf size = compressBound(static_cast<uLong>(data.size()));
+    std::string compressed(size, '\0');
+    if (compress2(
+            reinterpret_cast<Bytef*>(&compressed[0]),
+            &size,
+            reinterpret_cast<const Bytef*>(data.data()),
+            static_cast<uLong>(data.size()),
+            Z_BEST_SPEED) == Z_OK) {
+        // the original size is kept to size the buffer of the decompressed batch
+        compressed.resize(size);
+        std::istringstream src(std::to_string(data.size()) + ":" + compressed);
+        std::ostringstream dest;
+        if (aace::engine::utils::encoding::Base64::encode(src, dest)) {
+            return COMPRESSED_PREFIX + dest.str();
+        }
+    }
+#endif
+    return PLAIN_PREFIX + data;
+}
+
+/// Returns the serialized batch of a spooled batch.
+static bool decode(const std::string& encoded, std::string& data) {
+    if (encoded.empty()) {
+        return false;
+    }
+    if (encoded[0] == PLAIN_PREFIX) {
+        data = encoded.substr(1);
+        return true;
+    }
+#ifdef AAC_LOG_COMPRESSION
+    if (encoded[0] == COMPRESSED_PREFIX) {
+        std::istringstream src(encoded.substr(1));
+        std::ostringstream dest;
+        if (!aace::engine::utils::encoding::Base64::decode(src, dest)) {
+            return false;
+        }
+        auto decoded = dest.str();
+        auto separator = decoded.find(':');
+        if (separator == std::string::npos) {
+            return false;
+        }
+        uLongf size = std::stoul(decoded.substr(0, separator));
+        data.assign(size, '\0');
+        return uncompress(
+                   reinterpret_cast<Bytef*>(&data[0]),
+                   &size,
+                   reinterpret_cast<const Bytef*>(decoded.data() + separator + 1),
+                   static_cast<uLong>(decoded.size() - separator - 1)) == Z_OK &&
+               size == data.size();
+    }
+#endif
+    return false;
+}
+
+std::shared_ptr<MetricsBatcher> MetricsBatcher::create(
+    std::shared_ptr<aace::metrics::MetricsUploader> metricsUploader,
+    const Configuration& configuration,
+    std::shared_ptr<TimerWheel> timerWheel) {
+    try {
+        ThrowIfNull(metricsUploader, "invalidMetricsUploader");
+        ThrowIf(configuration.maxBatchSize == 0, "invalidMaxBatchSize");
+        ThrowIf(configuration.maxBatchDelay.count() <= 0, "invalidMaxBatchDelay");
+        ThrowIf(configuration.drainInterval.count() < 0, "invalidDrainInterval");
+        if (timerWheel == nullptr) {
+            timerWheel = TimerWheel::getDefault();
+        }
+        ThrowIfNull(timerWheel, "invalidTimerWheel");
+        return std::shared_ptr<MetricsBatcher>(new MetricsBatcher(metricsUploader, configuration, timerWheel));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+MetricsBatcher::MetricsBatcher(
+    std::shared_ptr<aace::metrics::MetricsUploader> metricsUploader,
+    const Configuration& configuration,
+    std::shared_ptr<TimerWheel> timerWheel) :
+        m_metricsUploader{metricsUploader},
+        m_configuration(configuration),
+        m_timerWheel{timerWheel},
+        m_batchTimer{TimerWheel::INVALID_TIMER},
+        m_shutdown{false},
+        m_nextSequence{0},
+        m_connected{true},
+        m_drainTimer{TimerWheel::INVALID_TIMER},
+        m_executor{"MetricsBatcher"} {
+}
+
+MetricsBatcher::~MetricsBatcher() {
+    m_timerWheel->cancel(m_batchTimer);
+    m_timerWheel->cancel(m_drainTimer);
+}
+
+// ---------------------------------------------------------------------------
+// DO NOT USE AACE_ MACROS TO LOG IN THIS FUNCTION AS IT WILL LEAD TO DEADLOCK
+// ---------------------------------------------------------------------------
+void MetricsBatcher::add(Metric metric) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_shutdown) {
+        return;
+    }
+    m_batch.push_back(std::move(metric));
+    if (m_batch.size() >= m_configuration.maxBatchSize) {
+        auto batch = takeBatchLocked();
+        m_executor.post([this, batch]() { executeSendBatch(batch); });
+    } else if (m_batch.size() == 1) {
+        std::weak_ptr<MetricsBatcher> wp = shared_from_this();
+        m_batchTimer = m_timerWheel->submitAfter(m_configuration.maxBatchDelay, [wp]() {
+            if (auto batcher = wp.lock()) {
+                std::lock_guard<std::mutex> lock(batcher->m_mutex);
+                batcher->m_batchTimer = TimerWheel::INVALID_TIMER;
+                if (!batcher->m_batch.empty()) {
+                    auto batch = batcher->takeBatchLocked();
+                    batcher->m_executor.post([wp, batch]() {
+                        if (auto batcher = wp.lock()) {
+                            batcher->executeSendBatch(batch);
+                        }
+                    });
+                }
+            }
+        });
+    }
+}
+
+std::vector<MetricsBatcher::Metric> MetricsBatcher::takeBatchLocked() {
+    if (m_batchTimer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(m_batchTimer);
+        m_batchTimer = TimerWheel::INVALID_TIMER;
+    }
+    std::vector<Metric> batch;
+    batch.swap(m_batch);
+    return batch;
+}
+
+void MetricsBatcher::setLocalStorage(
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage,
+    NetworkStatus networkStatus) {
+    m_executor.submit([this, localStorage, networkStatus]() {
+        m_localStorage = localStorage;
+        m_connected = networkStatus == NetworkStatus::CONNECTED || networkStatus == NetworkStatus::UNKNOWN;
+        if (m_localStorage != nullptr) {
+            // the batches spooled by the previous Engine, the zero padded keys sort in the order they were spooled
+            auto keys = m_localStorage->keys(SPOOL_TABLE);
+            std::sort(keys.begin(), keys.end());
+            m_spooledSequences.clear();
+            for (const auto& key : keys) {
+                m_spooledSequences.push_back(std::stoull(key));
+            }
+            m_nextSequence = m_spooledSequences.empty() ? 0 : m_spooledSequences.back() + 1;
+
+            // the batches spooled in memory until now are moved to the local storage
+            auto memorySpool = std::move(m_memorySpool);
+            m_memorySpool.clear();
+            for (const auto& batch : memorySpool) {
+                executeSpool(batch);
+            }
+            AACE_INFO(LX(TAG).d("spooledBatchCount", m_spooledSequences.size()));
+        }
+        if (m_connected) {
+            scheduleDrain(std::chrono::milliseconds::zero());
+        }
+    }).wait();
+}
+
+void MetricsBatcher::flush() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_batch.empty()) {
+            auto batch = takeBatchLocked();
+            m_executor.post([this, batch]() { executeSendBatch(batch); });
+        }
+    }
+    m_executor.waitForSubmittedTasks();
+}
+
+void MetricsBatcher::setBackgroundTransferScheduler(
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_backgroundTransferScheduler = backgroundTransferScheduler;
+}
+
+void MetricsBatcher::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    flush();
+    m_executor.submit([this]() {
+        m_timerWheel->cancel(m_drainTimer);
+        m_drainTimer = TimerWheel::INVALID_TIMER;
+    }).wait();
+    m_executor.shutdown();
+}
+
+size_t MetricsBatcher::getSpooledBatchCount() {
+    if (m_executor.isShutdown()) {
+        return 0;
+    }
+    return m_executor.submit([this]() { return m_spooledSequences.size() + m_memorySpool.size(); }).get();
+}
+
+void MetricsBatcher::executeSendBatch(std::vector<Metric> batch) {
+    // the spooled batches are sent first, so the metrics are sent in the order they were recorded
+    if (m_connected && m_spooledSequences.empty() && m_memorySpool.empty()) {
+        executeRecord(batch);
+    } else {
+        executeSpool(batch);
+    }
+}
+
+void MetricsBatcher::executeRecord(const std::vector<Metric>& batch) {
+    for (const auto& metric : batch) {
+        m_metricsUploader->record(metric.datapoints, metric.metadata, metric.buffer, metric.unique);
+    }
+}
+
+void MetricsBatcher::executeSpool(const std::vector<Metric>& batch) {
+    try {
+        if (m_localStorage == nullptr) {
+            m_memorySpool.push_back(batch);
+            if (m_memorySpool.size() > m_configuration.maxSpooledBatches) {
+                m_memorySpool.erase(m_memorySpool.begin());
+                AACE_WARN(LX(TAG).d("reason", "spoolFull"));
+            }
+            return;
+        }
+
+        auto sequence = m_nextSequence++;
+        ThrowIfNot(m_localStorage->put(SPOOL_TABLE, toSpoolKey(sequence), encode(serialize(batch))), "putFailed");
+        m_spooledSequences.push_back(sequence);
+        while (m_spooledSequences.size() > m_configuration.maxSpooledBatches) {
+            m_localStorage->removeKey(SPOOL_TABLE, toSpoolKey(m_spooledSequences.front()));
+            m_spooledSequences.erase(m_spooledSequences.begin());
+            AACE_WARN(LX(TAG).d("reason", "spoolFull"));
+        }
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "executeSpool").d("reason", ex.what()).d("metricCount", batch.size()));
+    }
+}
+
+void MetricsBatcher::executeDrain() {
+    m_drainTimer = TimerWheel::INVALID_TIMER;
+    if (!m_connected) {
+        return;
+    }
+    if (!m_memorySpool.empty()) {
+        executeRecord(m_memorySpool.front());
+        m_memorySpool.erase(m_memorySpool.begin());
+    } else if (!m_spooledSequences.empty() && m_localStorage != nullptr) {
+        auto key = toSpoolKey(m_spooledSequences.front());
+        std::string data;
+        std::vector<Metric> batch;
+        if (decode(m_localStorage->get(SPOOL_TABLE, key), data) && deserialize(data, batch)) {
+            executeRecord(batch);
+        } else {
+            AACE_WARN(LX(TAG).d("reason", "invalidSpooledBatch").d("key", key));
+        }
+        m_localStorage->removeKey(SPOOL_TABLE, key);
+        m_spooledSequences.erase(m_spooledSequences.begin());
+    }
+    if (!m_memorySpool.empty() || !m_spooledSequences.empty()) {
+        scheduleDrain(m_configuration.drainInterval);
+    }
+}
+
+void MetricsBatcher::scheduleDrain(std::chrono::milliseconds delay) {
+    if (m_drainTimer != TimerWheel::INVALID_TIMER || (m_memorySpool.empty() && m_spooledSequences.empty())) {
+        return;
+    }
+    std::weak_ptr<MetricsBatcher> wp = shared_from_this();
+    m_drainTimer = m_timerWheel->submitAfter(delay, [wp]() {
+        if (auto batcher = wp.lock()) {
+            batcher->postDrain();
+        }
+    });
+}
+
+void MetricsBatcher::postDrain() {
+    // the scheduler logs, so it isn't called with m_mutex held
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        backgroundTransferScheduler = m_backgroundTransferScheduler;
+    }
+    std::weak_ptr<MetricsBatcher> wp = shared_from_this();
+    auto drain = [wp]() {
+        if (auto batcher = wp.lock()) {
+            batcher->m_executor.post([wp]() {
+                if (auto batcher = wp.lock()) {
+                    batcher->executeDrain();
+                }
+            });
+        }
+    };
+    if (backgroundTransferScheduler == nullptr ||
+        !backgroundTransferScheduler->submit(
+            "MetricsBatcher.drain", aace::engine::network::BackgroundTransferScheduler::Priority::BACKGROUND, drain)) {
+        drain();
+    }
+}
+
+void MetricsBatcher::onNetworkInfoChanged(NetworkStatus status, int wifiSignalStrength) {
+    m_executor.post([this, status]() {
+        bool connected = status == NetworkStatus::CONNECTED || status == NetworkStatus::UNKNOWN;
+        if (connected == m_connected) {
+            return;
+        }
+        m_connected = connected;
+        AACE_DEBUG(LX(TAG).d("connected", connected).d("spooledBatchCount", m_spooledSequences.size()));
+        if (connected) {
+            scheduleDrain(std::chrono::milliseconds::zero());
+        } else {
+            m_timerWheel->cancel(m_drainTimer);
+            m_drainTimer = TimerWheel::INVALID_TIMER;
+        }
+    });
+}
+
+void MetricsBatcher::onNetworkInterfaceChangeStatusChanged(
+    const std::string& networkInterface,
+    NetworkInterfaceChangeStatus status) {
+}
+
+std::string MetricsBatcher::toSpoolKey(uint64_t sequence) {
+    char key[21];
+    std::snprintf(key, sizeof(key), "%020llu", static_cast<unsigned long long>(sequence));
+    return key;
+}
+
+std::string MetricsBatcher::serialize(const std::vector<Metric>& batch) {
+    // a compact array per metric: datapoints as [type, name, value, count], metadata, buffer and unique flags
+    auto metrics = nlohmann::json::array();
+    for (const auto& metric : batch) {
+        auto datapoints = nlohmann::json::array();
+        for (const auto& datapoint : metric.datapoints) {
+            datapoints.push_back(
+                {static_cast<int>(datapoint.getType()), datapoint.getName(), datapoint.getValue(), datapoint.getCount()});
+        }
+        metrics.push_back({datapoints, metric.metadata, metric.buffer, metric.unique});
+    }
+    return metrics.dump();
+}
+
+bool MetricsBatcher::deserialize(const std::string& data, std::vector<Metric>& batch) {
+    try {
+        batch.clear();
+        auto metrics = nlohmann::json::parse(data);
+        ThrowIfNot(metrics.is_array(), "invalidBatch");
+        for (const auto& item : metrics) {
+            ThrowIfNot(item.is_array() && item.size() == 4 && item[0].is_array(), "invalidMetric");
+            Metric metric;
+            for (const auto& datapoint : item[0]) {
+                ThrowIfNot(datapoint.is_array() && datapoint.size() == 4, "invalidDatapoint");
+                auto type = datapoint[0].get<int>();
+                ThrowIf(type < 0 || type > static_cast<int>(DatapointType::COUNTER), "invalidDatapointType");
+                metric.datapoints.emplace_back(
+                    static_cast<DatapointType>(type),
+                    datapoint[1].get<std::string>(),
+                    datapoint[2].get<std::string>(),
+                    datapoint[3].get<int>());
+            }
+            metric.metadata = item[1].get<std::unordered_map<std::string, std::string>>();
+            metric.buffer = item[2].get<bool>();
+            metric.unique = item[3].get<bool>();
+            batch.push_back(std::move(metric));
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "deserialize").d("reason", ex.what()));
+        batch.clear();
+        return false;
+    }
+}
+
+}  // namespace metrics
+}  // namespace engine
+}  // namespace aace
@@ -22,7 +22,13 @@
 #include <rapidjson/istreamwrapper.h>
 
 #include "AACE/Engine/Metrics/MetricsEngineService.h"
+#include "AACE/Engine/Metrics/MetricAggregator.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Network/BackgroundTransferScheduler.h"
+#include "AACE/Engine/Network/NetworkObservableInterface.h"
+#include "AACE/Engine/Storage/LocalStorageInterface.h"
+#include "AACE/Engine/Utils/JSON/JSON.h"
+#include "AACE/Network/NetworkInfoProvider.h"
 
 namespace aace {
 namespace engine {
@@ -34,11 +40,53 @@ static const std::string TAG("aace.metrics.MetricsEngineService");
 // register the service
 REGISTER_SERVICE(MetricsEngineService);
 
+namespace json = aace::engine::utils::json;
+
 MetricsEngineService::MetricsEngineService(const aace::engine::core::ServiceDescription& description) :
         aace::engine::core::EngineService(description) {
 }
 
+bool MetricsEngineService::configureFromJson(const json::Value& root) {
+    try {
+        // aggregate the counter and timer datapoints, and record them at the flush interval
+        auto flushInterval = json::get(root, "/aggregation/flushInterval", (uint64_t)0);
+        auto aggregator = MetricAggregator::getDefault();
+        ThrowIfNull(aggregator, "invalidMetricAggregator");
+        aggregator->setFlushInterval(std::chrono::milliseconds(flushInterval));
+
+        // send the metrics to the platform in batches, and spool them while the network is disconnected
+        auto batching = json::get(root, "/batching", json::Type::object);
+        if (batching != nullptr) {
+            MetricsBatcher::Configuration configuration;
+            configuration.maxBatchSize = json::get(batching, "/maxBatchSize", (uint64_t)configuration.maxBatchSize);
+            configuration.maxBatchDelay = std::chrono::milliseconds(
+                json::get(batching, "/maxBatchDelay", (uint64_t)configuration.maxBatchDelay.count()));
+            configuration.maxSpooledBatches =
+                json::get(batching, "/maxSpooledBatches", (uint64_t)configuration.maxSpooledBatches);
+            configuration.drainInterval = std::chrono::milliseconds(
+                json::get(batching, "/drainInterval", (uint64_t)configuration.drainInterval.count()));
+            ThrowIf(configuration.maxBatchSize == 0, "invalidMaxBatchSize");
+            ThrowIf(configuration.maxBatchDelay.count() == 0, "invalidMaxBatchDelay");
+            m_batchingConfiguration.reset(new MetricsBatcher::Configuration(configuration));
+        }
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "configureFromJson").d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool MetricsEngineService::shutdown() {
+    // record the aggregated datapoints while the metrics uploader is still a logger sink
+    if (auto aggregator = MetricAggregator::getDefault()) {
+        aggregator->setFlushInterval(std::chrono::milliseconds::zero());
+    }
+
+    if (m_networkObservable != nullptr && m_metricsBatcher != nullptr) {
+        m_networkObservable->removeObserver(m_metricsBatcher);
+    }
+
     if (m_metricsUploaderEngineImpl != nullptr) {
         // get the logger service interface
         auto loggerServiceInterface =
@@ -49,9 +97,43 @@ bool MetricsEngineService::shutdown() {
         loggerServiceInterface->removeSink(m_metricsUploaderEngineImpl->getId());
     }
 
+    // the metrics batched until now are sent, or spooled for the next Engine if the network is disconnected
+    if (m_metricsBatcher != nullptr) {
+        m_metricsBatcher->shutdown();
+    }
+
     return true;
 }
 
+bool MetricsEngineService::postRegister() {
+    try {
+        ReturnIf(m_metricsBatcher == nullptr, true);
+
+        // the local storage and the network provider are registered by now
+        auto localStorage =
+            getContext()->getServiceInterface<aace::engine::storage::LocalStorageInterface>("aace.storage");
+        auto networkProvider = getContext()->getServiceInterface<aace::network::NetworkInfoProvider>("aace.network");
+        auto networkStatus = networkProvider != nullptr ? networkProvider->getNetworkStatus()
+                                                        : aace::network::NetworkInfoProvider::NetworkStatus::CONNECTED;
+        m_metricsBatcher->setLocalStorage(localStorage, networkStatus);
+
+        // the spooled batches are deferred on a weak wifi signal, a metered link or during a voice interaction
+        m_metricsBatcher->setBackgroundTransferScheduler(
+            getContext()->getServiceInterface<aace::engine::network::BackgroundTransferScheduler>("aace.network"));
+
+        m_networkObservable =
+            getContext()->getServiceInterface<aace::engine::network::NetworkObservableInterface>("aace.network");
+        if (m_networkObservable != nullptr) {
+            m_networkObservable->addObserver(m_metricsBatcher);
+        }
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "postRegister").d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool MetricsEngineService::registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) {
     try {
         ReturnIf(registerPlatformInterfaceType<aace::metrics::MetricsUploader>(platformInterface), true);
@@ -72,8 +154,15 @@ bool MetricsEngineService::registerPlatformInterfaceType(
             getContext()->getServiceInterface<aace::engine::logger::LoggerServiceInterface>("aace.logger");
         ThrowIfNull(loggerServiceInterface, "invalidLoggerServiceInterface");
 
+        // create the metrics batcher if batching is configured
+        if (m_batchingConfiguration != nullptr) {
+            m_metricsBatcher = MetricsBatcher::create(metricsUploader, *m_batchingConfiguration);
+            ThrowIfNull(m_metricsBatcher, "createMetricsBatcherFailed");
+        }
+
         // create the metrics uploader engine implementation
-        m_metricsUploaderEngineImpl = aace::engine::metrics::MetricsUploaderEngineImpl::create(metricsUploader);
+        m_metricsUploaderEngineImpl =
+            aace::engine::metrics::MetricsUploaderEngineImpl::create(metricsUploader, m_metricsBatcher);
         ThrowIfNull(m_metricsUploaderEngineImpl, "createMetricsUploaderEngineImplFailed");
 
         // add the uploader service impl to the logger service
@@ -67,16 +67,21 @@ size_t parseHeader(const std::string& metric, std::string& programName, std::str
 }
 
 MetricsUploaderEngineImpl::MetricsUploaderEngineImpl(
-    std::shared_ptr<aace::metrics::MetricsUploader> platformMetricsUploaderInterface) :
-        aace::engine::logger::sink::Sink(TAG), m_platformMetricsUploaderInterface(platformMetricsUploaderInterface) {
+    std::shared_ptr<aace::metrics::MetricsUploader> platformMetricsUploaderInterface,
+    std::shared_ptr<MetricsBatcher> metricsBatcher) :
+        aace::engine::logger::sink::Sink(TAG),
+        m_platformMetricsUploaderInterface(platformMetricsUploaderInterface),
+        m_metricsBatcher(metricsBatcher) {
 }
 
 std::shared_ptr<MetricsUploaderEngineImpl> MetricsUploaderEngineImpl::create(
-    std::shared_ptr<aace::metrics::MetricsUploader> platformMetricsUploaderInterface) {
+    std::shared_ptr<aace::metrics::MetricsUploader> platformMetricsUploaderInterface,
+    std::shared_ptr<MetricsBatcher> metricsBatcher) {
     try {
         ThrowIfNull(platformMetricsUploaderInterface, "invalidMetricsUploaderPlatformInterface");
         std::shared_ptr<MetricsUploaderEngineImpl> metricsUploaderEngineImpl =
-            std::shared_ptr<MetricsUploaderEngineImpl>(new MetricsUploaderEngineImpl(platformMetricsUploaderInterface));
+            std::shared_ptr<MetricsUploaderEngineImpl>(
+                new MetricsUploaderEngineImpl(platformMetricsUploaderInterface, metricsBatcher));
 
         ThrowIfNot(metricsUploaderEngineImpl->initialize(), "inializeMetricsUploaderEngineImplFailed");
 
@@ -196,6 +201,15 @@ void MetricsUploaderEngineImpl::log(
                 //Set datapoints string equal to next datapoint for parsing until all datapoints parsed
                 datapoints = data_match.suffix();
             }
+            // the batcher sends the metric with the other metrics of its batch
+            if (m_metricsBatcher != nullptr) {
+                m_metricsBatcher->add(
+                    {std::move(datapointList), std::move(metadata), bufferType == BUFFER, identityType == UNIQUE});
+                return;
+            }
+
+            // the logger emits entries concurrently, the platform interface records one metric at a time
+            std::lock_guard<std::mutex> lock(m_mutex);
             m_platformMetricsUploaderInterface->record(
                 datapointList, metadata, bufferType == BUFFER, identityType == UNIQUE);
         }
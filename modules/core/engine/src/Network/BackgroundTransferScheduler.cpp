@@ -0,0 +1,236 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "AACE/Engine/Network/BackgroundTransferScheduler.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+
+namespace aace {
+namespace engine {
+namespace network {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.network.BackgroundTransferScheduler");
+
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+std::shared_ptr<BackgroundTransferScheduler> BackgroundTransferScheduler::create(
+    const Configuration& configuration,
+    std::shared_ptr<TimerWheel> timerWheel) {
+    try {
+        ThrowIf(configuration.maxDeferral.count() < 0, "invalidMaxDeferral");
+        ThrowIf(configuration.minInterval.count() < 0, "invalidMinInterval");
+        if (timerWheel == nullptr) {
+            timerWheel = TimerWheel::getDefault();
+        }
+        ThrowIfNull(timerWheel, "invalidTimerWheel");
+        return std::shared_ptr<BackgroundTransferScheduler>(
+            new BackgroundTransferScheduler(configuration, timerWheel));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+BackgroundTransferScheduler::BackgroundTransferScheduler(
+    const Configuration& configuration,
+    std::shared_ptr<TimerWheel> timerWheel) :
+        m_configuration(configuration),
+        m_timerWheel{timerWheel},
+        m_connected{true},
+        m_weakSignal{false},
+        m_metered{false},
+        m_voiceActive{false},
+        m_transferPosted{false},
+        m_shutdown{false},
+        m_lastTransferTime{Clock::time_point::min()},
+        m_timer{TimerWheel::INVALID_TIMER},
+        m_executor{"BackgroundTransfers"} {
+}
+
+BackgroundTransferScheduler::~BackgroundTransferScheduler() {
+    m_timerWheel->cancel(m_timer);
+}
+
+bool BackgroundTransferScheduler::submit(const std::string& name, Priority priority, Transfer transfer) {
+    try {
+        ThrowIfNull(transfer, "invalidTransfer");
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ThrowIf(m_shutdown, "schedulerShutdown");
+
+        auto it = std::find_if(
+            m_pendingTransfers.begin(), m_pendingTransfers.end(), [&name](const PendingTransfer& pendingTransfer) {
+                return pendingTransfer.name == name;
+            });
+        if (it != m_pendingTransfers.end()) {
+            // the pending transfer keeps its submit time, so the repeated triggers don't defer it further
+            AACE_DEBUG(LX(TAG).m("transferReplaced").d("name", name).d("priority", priority));
+            it->transfer = std::move(transfer);
+            it->priority = std::min(it->priority, priority);
+        } else {
+            AACE_DEBUG(LX(TAG).m("transferSubmitted").d("name", name).d("priority", priority));
+            m_pendingTransfers.push_back({name, priority, std::move(transfer), Clock::now()});
+        }
+        scheduleLocked();
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "submit").d("reason", ex.what()).d("name", name));
+        return false;
+    }
+}
+
+void BackgroundTransferScheduler::setMetered(bool metered) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_metered != metered) {
+        AACE_INFO(LX(TAG).d("metered", metered));
+        m_metered = metered;
+        scheduleLocked();
+    }
+}
+
+void BackgroundTransferScheduler::setVoiceActive(bool active) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_voiceActive != active) {
+        AACE_DEBUG(LX(TAG).d("voiceActive", active));
+        m_voiceActive = active;
+        scheduleLocked();
+    }
+}
+
+size_t BackgroundTransferScheduler::getPendingTransferCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pendingTransfers.size();
+}
+
+void BackgroundTransferScheduler::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+        m_timerWheel->cancel(m_timer);
+        m_timer = TimerWheel::INVALID_TIMER;
+        if (!m_pendingTransfers.empty()) {
+            AACE_INFO(LX(TAG).m("droppingPendingTransfers").d("count", m_pendingTransfers.size()));
+            m_pendingTransfers.clear();
+        }
+    }
+    m_executor.shutdown();
+}
+
+void BackgroundTransferScheduler::onNetworkInfoChanged(NetworkStatus status, int wifiSignalStrength) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto connected = status == NetworkStatus::CONNECTED || status == NetworkStatus::UNKNOWN;
+
+    // the signal strength is the RSSI of the wifi connection, a non-negative value is not a wifi signal
+    auto weakSignal = wifiSignalStrength < 0 && wifiSignalStrength < m_configuration.minWifiSignalStrength;
+    if (connected != m_connected || weakSignal != m_weakSignal) {
+        AACE_DEBUG(LX(TAG).d("connected", connected).d("weakSignal", weakSignal));
+        m_connected = connected;
+        m_weakSignal = weakSignal;
+        scheduleLocked();
+    }
+}
+
+void BackgroundTransferScheduler::onNetworkInterfaceChangeStatusChanged(
+    const std::string& networkInterface,
+    NetworkInterfaceChangeStatus status) {
+    // the transfers make their own connections, so the network interface changes don't affect them
+}
+
+BackgroundTransferScheduler::Clock::time_point BackgroundTransferScheduler::getAllowedTimeLocked(
+    const PendingTransfer& pendingTransfer) const {
+    if (pendingTransfer.priority == Priority::BACKGROUND && (m_weakSignal || m_metered)) {
+        return pendingTransfer.submitTime + m_configuration.maxDeferral;
+    }
+    return pendingTransfer.submitTime;
+}
+
+void BackgroundTransferScheduler::scheduleLocked() {
+    if (m_shutdown || m_transferPosted) {
+        return;
+    }
+    if (m_timer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(m_timer);
+        m_timer = TimerWheel::INVALID_TIMER;
+    }
+
+    // the transfers wait for the network to connect, and for the voice interaction to end
+    if (m_pendingTransfers.empty() || !m_connected || m_voiceActive) {
+        return;
+    }
+
+    auto allowedTime = Clock::time_point::max();
+    for (const auto& pendingTransfer : m_pendingTransfers) {
+        allowedTime = std::min(allowedTime, getAllowedTimeLocked(pendingTransfer));
+    }
+    if (m_lastTransferTime != Clock::time_point::min()) {
+        allowedTime = std::max(allowedTime, m_lastTransferTime + m_configuration.minInterval);
+    }
+
+    auto now = Clock::now();
+    std::weak_ptr<BackgroundTransferScheduler> wp = shared_from_this();
+    if (allowedTime <= now) {
+        m_transferPosted = true;
+        m_executor.post([wp]() {
+            if (auto scheduler = wp.lock()) {
+                scheduler->executeTransfer();
+            }
+        });
+    } else {
+        // rounded up, so the timer doesn't expire before the transfer is allowed
+        auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(allowedTime - now) +
+                     std::chrono::milliseconds(1);
+        m_timer = m_timerWheel->submitAfter(delay, [wp]() {
+            if (auto scheduler = wp.lock()) {
+                std::lock_guard<std::mutex> lock(scheduler->m_mutex);
+                scheduler->m_timer = TimerWheel::INVALID_TIMER;
+                scheduler->scheduleLocked();
+            }
+        });
+    }
+}
+
+void BackgroundTransferScheduler::executeTransfer() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto now = Clock::now();
+
+    // the interactive transfers run before the background transfers allowed at the same time
+    auto next = m_pendingTransfers.end();
+    if (!m_shutdown && m_connected && !m_voiceActive) {
+        for (auto it = m_pendingTransfers.begin(); it != m_pendingTransfers.end(); it++) {
+            if (getAllowedTimeLocked(*it) <= now &&
+                (next == m_pendingTransfers.end() || it->priority < next->priority)) {
+                next = it;
+            }
+        }
+    }
+    if (next != m_pendingTransfers.end()) {
+        auto name = next->name;
+        auto transfer = std::move(next->transfer);
+        m_pendingTransfers.erase(next);
+        m_lastTransferTime = now;
+        lock.unlock();
+
+        AACE_DEBUG(LX(TAG).m("runningTransfer").d("name", name));
+        transfer();
+        lock.lock();
+    }
+    m_transferPosted = false;
+    scheduleLocked();
+}
+
+}  // namespace network
+}  // namespace engine
+}  // namespace aace
@@ -17,6 +17,7 @@
 
 #include "AACE/Engine/Network/NetworkEngineService.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/JSON/JSON.h"
 #include "AACE/Engine/Utils/String/StringUtils.h"
 
 #include "AACE/Network/NetworkProperties.h"
@@ -31,6 +32,8 @@ static const std::string TAG("aace.network.NetworkEngineService");
 // register the service
 REGISTER_SERVICE(NetworkEngineService);
 
+namespace json = aace::engine::utils::json;
+
 NetworkEngineService::NetworkEngineService(const aace::engine::core::ServiceDescription& description) :
         aace::engine::core::EngineService(description) {
 }
@@ -45,6 +48,70 @@ bool NetworkEngineService::initialize() {
     }
 }
 
+bool NetworkEngineService::configure() {
+    return createBackgroundTransferScheduler(BackgroundTransferScheduler::Configuration());
+}
+
+bool NetworkEngineService::configureFromJson(const json::Value& root) {
+    try {
+        // defer the background transfers on a weak wifi signal or a metered link, for at most the max deferral
+        BackgroundTransferScheduler::Configuration configuration;
+        auto backgroundTransfers = json::get(root, "/backgroundTransfers", json::Type::object);
+        if (backgroundTransfers != nullptr) {
+            configuration.minWifiSignalStrength = static_cast<int>(json::get(
+                backgroundTransfers, "/minWifiSignalStrength", (int64_t)configuration.minWifiSignalStrength));
+            configuration.maxDeferral = std::chrono::milliseconds(json::get(
+                backgroundTransfers, "/maxDeferralInMilliseconds", (uint64_t)configuration.maxDeferral.count()));
+            configuration.minInterval = std::chrono::milliseconds(json::get(
+                backgroundTransfers, "/minIntervalInMilliseconds", (uint64_t)configuration.minInterval.count()));
+        }
+        ThrowIfNot(createBackgroundTransferScheduler(configuration), "createBackgroundTransferSchedulerFailed");
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "configureFromJson").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool NetworkEngineService::createBackgroundTransferScheduler(
+    const BackgroundTransferScheduler::Configuration& configuration) {
+    try {
+        m_backgroundTransferScheduler = BackgroundTransferScheduler::create(configuration);
+        ThrowIfNull(m_backgroundTransferScheduler, "createBackgroundTransferSchedulerFailed");
+        ThrowIfNot(
+            registerServiceInterface<BackgroundTransferScheduler>(m_backgroundTransferScheduler),
+            "registerBackgroundTransferSchedulerFailed");
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool NetworkEngineService::postRegister() {
+    try {
+        // the transfers are allowed until the network provider reports the network status
+        if (m_networkInfoProvider != nullptr && m_backgroundTransferScheduler != nullptr) {
+            m_backgroundTransferScheduler->onNetworkInfoChanged(
+                m_networkInfoProvider->getNetworkStatus(), m_networkInfoProvider->getWifiSignalStrength());
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "postRegister").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool NetworkEngineService::shutdown() {
+    if (m_backgroundTransferScheduler != nullptr) {
+        if (m_networkInfoProviderEngineImpl != nullptr) {
+            m_networkInfoProviderEngineImpl->removeObserver(m_backgroundTransferScheduler);
+        }
+        m_backgroundTransferScheduler->shutdown();
+    }
+    return true;
+}
+
 bool NetworkEngineService::registerProperties() {
     try {
         // get the property engine service interface from the property manager service
@@ -112,6 +179,11 @@ bool NetworkEngineService::registerPlatformInterfaceType(
         // set the network info provider engine interface reference
         m_networkInfoProvider->setEngineInterface(m_networkInfoProviderEngineImpl);
 
+        // the background transfers follow the network status and the wifi signal strength
+        if (m_backgroundTransferScheduler != nullptr) {
+            m_networkInfoProviderEngineImpl->addObserver(m_backgroundTransferScheduler);
+        }
+
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "registerPlatformInterfaceType<NetworkInfoProvider>").d("reason", ex.what()));
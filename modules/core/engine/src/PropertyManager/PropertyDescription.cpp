@@ -23,8 +23,8 @@ namespace propertyManager {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.core.PropertyDescription");
 
-PropertyDescription::PropertyDescription(const std::string& name, Setter setter, Getter getter) :
-        m_setter(setter), m_getter(getter), m_name(name) {
+PropertyDescription::PropertyDescription(const std::string& name, Setter setter, Getter getter, bool cacheable) :
+        m_setter(setter), m_getter(getter), m_name(name), m_cacheable(cacheable) {
 }
 
 PropertyDescription::PropertyDescription(const PropertyDescription& other) {
@@ -43,6 +43,10 @@ std::string PropertyDescription::getPropertyName() const {
     return m_name;
 }
 
+bool PropertyDescription::isCacheable() const {
+    return m_cacheable;
+}
+
 }  // namespace propertyManager
 }  // namespace engine
 }  // namespace aace
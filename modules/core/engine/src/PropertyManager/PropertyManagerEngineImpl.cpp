@@ -34,6 +34,7 @@ static const std::string METRIC_PROGRAM_NAME_SUFFIX = "PropertyManagerEngineImpl
 
 /// Counter metrics for PropertyManager Platform APIs
 static const std::string METRIC_PROPERTY_MANAGER_SET_PROPERTY = "setProperty";
+static const std::string METRIC_PROPERTY_MANAGER_SET_PROPERTIES = "setProperties";
 static const std::string METRIC_PROPERTY_MANAGER_PROPERTY_STATE_CHANGED = "propertyStateChanged";
 static const std::string METRIC_PROPERTY_MANAGER_GET_PROPERTY = "getProperty";
 static const std::string METRIC_PROPERTY_MANAGER_PROPERTY_CHANGED = "propertyChanged";
@@ -91,6 +92,23 @@ bool PropertyManagerEngineImpl::onSetProperty(const std::string& name, const std
     }
 }
 
+bool PropertyManagerEngineImpl::onSetProperties(const std::unordered_map<std::string, std::string>& values) {
+    try {
+        std::vector<std::string> counters = {METRIC_PROPERTY_MANAGER_SET_PROPERTIES};
+        for (auto& next : values) {
+            counters.push_back(next.first);
+        }
+        emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "onSetProperties", counters);
+        auto m_propertyManagerServiceInterface_lock = m_propertyManagerServiceInterface.lock();
+        ThrowIfNull(m_propertyManagerServiceInterface_lock, "invalidPropertyManagerServiceInterfaceInstance");
+        ThrowIfNot(m_propertyManagerServiceInterface_lock->setProperties(values, true), "setPropertiesFailed");
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
 std::string PropertyManagerEngineImpl::onGetProperty(const std::string& name) {
     try {
         emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "onGetProperty", {METRIC_PROPERTY_MANAGER_GET_PROPERTY, name});
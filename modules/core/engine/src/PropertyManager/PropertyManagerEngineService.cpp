@@ -79,8 +79,8 @@ bool PropertyManagerEngineService::registerProperty(const PropertyDescription& p
     try {
         auto name = propertyDescription.getPropertyName();
         ThrowIf(name.empty(), "invalidPropertyName");
-        ThrowIf(m_propertyDescriptionMap.find(name) != m_propertyDescriptionMap.end(), "propertyAlreadyRegistered");
-        m_propertyDescriptionMap[name] = propertyDescription;
+        ThrowIf(m_propertyRegistry.getHandle(name) != 0, "propertyAlreadyRegistered");
+        ThrowIf(m_propertyRegistry.add(propertyDescription) == 0, "addPropertyFailed");
 
         return true;
     } catch (std::exception& ex) {
@@ -131,41 +131,127 @@ bool PropertyManagerEngineService::setProperty(
             AACE_WARN(LX(TAG).d("reason", "setPropertyCalledWhileEngineNotRunning"));
         }
         ThrowIf(name.empty(), "invalidPropertyName");
-        auto it = m_propertyDescriptionMap.find(name);
-        ThrowIf(it == m_propertyDescriptionMap.end(), "propertyNotFound");
-        ThrowIfNull(it->second.setter(), "readOnlyProperty");
-        auto setterResult = m_executor.submit([this, name, value, it, fromPlatform] {
-            try {
+        auto handle = m_propertyRegistry.getHandle(name);
+        auto propertyDescription = m_propertyRegistry.getDescription(handle);
+        ThrowIfNull(propertyDescription, "propertyNotFound");
+        auto setter = propertyDescription->setter();
+        ThrowIfNull(setter, "readOnlyProperty");
+        auto setterResult = m_executor.submit([this, name, value, handle, setter, fromPlatform] {
+            bool changed = false;
+            auto result = applyProperty(handle, setter, name, value, fromPlatform, changed);
+            if (changed) {
+                notifyPropertyChangeListeners(name, value);
+            }
+            return result;
+        });
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("name", name).sensitive("value", value));
+        return false;
+    }
+}
+
+bool PropertyManagerEngineService::setProperties(
+    const std::unordered_map<std::string, std::string>& values,
+    const bool& fromPlatform) {
+    try {
+        if (isRunning() == false) {
+            AACE_WARN(LX(TAG).d("reason", "setPropertiesCalledWhileEngineNotRunning"));
+        }
+        ThrowIf(values.empty(), "noProperties");
+
+        // every property is checked before any value is applied
+        struct PendingProperty {
+            std::string name;
+            std::string value;
+            PropertyHandle handle;
+            PropertyDescription::Setter setter;
+        };
+        auto properties = std::make_shared<std::vector<PendingProperty>>();
+        properties->reserve(values.size());
+        for (auto& next : values) {
+            ThrowIf(next.first.empty(), "invalidPropertyName");
+            auto handle = m_propertyRegistry.getHandle(next.first);
+            auto propertyDescription = m_propertyRegistry.getDescription(handle);
+            ThrowIfNull(propertyDescription, "propertyNotFound:" + next.first);
+            auto setter = propertyDescription->setter();
+            ThrowIfNull(setter, "readOnlyProperty:" + next.first);
+            properties->push_back({next.first, next.second, handle, setter});
+        }
+
+        // the values are applied by a single task, so no other property is set in between
+        m_executor.submit([this, properties, fromPlatform] {
+            std::unordered_map<std::string, std::string> changes;
+            for (auto& next : *properties) {
                 bool changed = false;
-                bool async = false;
-                auto callback = [fromPlatform, this](
-                                    const std::string& name, const std::string& value, const std::string& state) {
-                    setPropertyResultCallback(name, value, fromPlatform, state);
-                };
-                auto result = it->second.setter()(value, changed, async, callback);
-                ReturnIf(result && async, true);
-                if (m_propertyManagerEngineImpl == nullptr) {
-                    AACE_WARN(
-                        LX(TAG).m("Null propertyManagerEngineImpl. PropertyManager platform interface not registered"));
-                } else {
-                    result ? handleSetSuccess(changed, fromPlatform, name, value)
-                           : handleSetFailed(fromPlatform, name, value);
+                applyProperty(next.handle, next.setter, next.name, next.value, fromPlatform, changed);
+                if (changed) {
+                    changes[next.name] = next.value;
                 }
-
-                return result;
-            } catch (std::exception& ex) {
-                AACE_ERROR(LX(TAG).d("reason", ex.what()));
-                return false;
             }
+            notifyPropertyChangeListeners(changes);
         });
         return true;
     } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("name", name).sensitive("value", value));
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("count", values.size()));
+        return false;
+    }
+}
+
+bool PropertyManagerEngineService::applyProperty(
+    PropertyHandle handle,
+    const PropertyDescription::Setter& setter,
+    const std::string& name,
+    const std::string& value,
+    bool fromPlatform,
+    bool& changed) {
+    try {
+        bool async = false;
+        auto callback = [fromPlatform, this](
+                            const std::string& name, const std::string& value, const std::string& state) {
+            setPropertyResultCallback(name, value, fromPlatform, state);
+        };
+        auto result = setter(value, changed, async, callback);
+        // not every setter reports whether the value changed, so the cached value is dropped whatever the
+        // result of the setter is
+        m_propertyRegistry.invalidate(handle);
+        if (result && async) {
+            // the listeners are notified when the setter reports the result
+            changed = false;
+            return true;
+        }
+        if (m_propertyManagerEngineImpl == nullptr) {
+            AACE_WARN(LX(TAG).m("Null propertyManagerEngineImpl. PropertyManager platform interface not registered"));
+            changed = false;
+        } else if (result) {
+            notifyPlatformOfSuccess(changed, fromPlatform, name, value);
+        } else {
+            handleSetFailed(fromPlatform, name, value);
+            changed = false;
+        }
+
+        return result;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("name", name));
+        changed = false;
         return false;
     }
 }
 
 void PropertyManagerEngineService::handleSetSuccess(
+    const bool& changed,
+    const bool& fromPlatform,
+    const std::string& name,
+    const std::string& value) {
+    notifyPlatformOfSuccess(changed, fromPlatform, name, value);
+    // notify the listeners of the property change irrespective of the initiator of the
+    // setProperty()
+    if (changed) {
+        notifyPropertyChangeListeners(name, value);
+    }
+}
+
+void PropertyManagerEngineService::notifyPlatformOfSuccess(
     const bool& changed,
     const bool& fromPlatform,
     const std::string& name,
@@ -181,9 +267,6 @@ void PropertyManagerEngineService::handleSetSuccess(
         } else {
             m_propertyManagerEngineImpl->handlePropertyChanged(name, value);
         }
-        // notify the listeners of the property change irrespective of the initiator of the
-        // setProperty()
-        notifyPropertyChangeListeners(name, value);
     } else {  // The property value did not change
         // If setProperty() was initiated by the platform, call the
         // propertyStateChanged(name, value, SUCCEEDED)
@@ -212,6 +295,7 @@ void PropertyManagerEngineService::setPropertyResultCallback(
     const bool& fromPlatform,
     const std::string& result) {
     m_executor.submit([this, name, value, fromPlatform, result] {
+        m_propertyRegistry.invalidate(m_propertyRegistry.getHandle(name));
         if (m_propertyManagerEngineImpl == nullptr) {
             AACE_WARN(LX(TAG).m("PropertyManager platform interface not registered"));
         } else {
@@ -227,15 +311,32 @@ std::string PropertyManagerEngineService::getProperty(const std::string& name) {
             AACE_WARN(LX(TAG).d("reason", "getPropertyCalledWhileEngineNotRunning"));
         }
         ThrowIf(name.empty(), "invalidPropertyName");
-        auto it = m_propertyDescriptionMap.find(name);
-        ThrowIf(it == m_propertyDescriptionMap.end(), "propertyNotFound");
-        return it->second.getter()();
+        return m_propertyRegistry.getValue(m_propertyRegistry.getHandle(name), isRunning());
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()).d("name", name));
         return "";
     }
 }
 
+PropertyManagerEngineService::PropertyHandle PropertyManagerEngineService::getPropertyHandle(const std::string& name) {
+    auto handle = m_propertyRegistry.getHandle(name);
+    if (handle == 0) {
+        AACE_ERROR(LX(TAG).d("reason", "propertyNotFound").d("name", name));
+    }
+    return handle;
+}
+
+std::string PropertyManagerEngineService::getPropertyValue(PropertyHandle handle) {
+    try {
+        // the values read while the Engine is not running are not cached, since the owners of the properties may
+        // still be configuring them
+        return m_propertyRegistry.getValue(handle, isRunning());
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("handle", handle));
+        return "";
+    }
+}
+
 void PropertyManagerEngineService::notifyPropertyChangeListeners(
     const std::string& name,
     const std::string& propertyValue) {
@@ -255,15 +356,41 @@ void PropertyManagerEngineService::notifyPropertyChangeListeners(
     }
 }
 
+void PropertyManagerEngineService::notifyPropertyChangeListeners(
+    const std::unordered_map<std::string, std::string>& changes) {
+    // each listener is notified once of the changes of the properties it listens to
+    std::unordered_map<std::shared_ptr<PropertyListenerInterface>, std::unordered_map<std::string, std::string>>
+        listenerChanges;
+    {
+        std::lock_guard<std::mutex> lock(m_listenerMutex);
+        for (auto& next : changes) {
+            auto it = m_propertyListenerMap.find(next.first);
+            if (it != m_propertyListenerMap.end()) {
+                for (auto& listener : it->second) {
+                    listenerChanges[listener].insert(next);
+                }
+            }
+        }
+    }
+    for (auto& next : listenerChanges) {
+        try {
+            next.first->propertiesChanged(next.second);
+        } catch (std::exception& ex) {
+            AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        }
+    }
+}
+
 void PropertyManagerEngineService::updatePropertyValue(const std::string& name, const std::string& newValue) {
     try {
         if (isRunning() == false) {
             AACE_WARN(LX(TAG).d("reason", "setPropertyCalledWhileEngineNotRunning"));
         }
         ThrowIf(name.empty(), "invalidPropertyName");
-        auto it = m_propertyDescriptionMap.find(name);
-        if (it != m_propertyDescriptionMap.end()) {
-            auto propertyValue = it->second.getter()();
+        auto handle = m_propertyRegistry.getHandle(name);
+        if (handle != 0) {
+            m_propertyRegistry.invalidate(handle);
+            auto propertyValue = m_propertyRegistry.getValue(handle, isRunning());
             notifyPropertyChangeListeners(name, propertyValue);
             if (m_propertyManagerEngineImpl != nullptr) {
                 m_propertyManagerEngineImpl->handlePropertyChanged(name, propertyValue);
@@ -281,7 +408,7 @@ bool PropertyManagerEngineService::shutdown() {
     }
     m_executor.shutdown();
     m_propertyListenerMap.clear();
-    m_propertyDescriptionMap.clear();
+    m_propertyRegistry.clear();
     return true;
 }
 
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <atomic>
+
+#include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/PropertyManager/PropertyRegistry.h"
+
+namespace aace {
+namespace engine {
+namespace propertyManager {
+
+PropertyRegistry::PropertyHandle PropertyRegistry::add(const PropertyDescription& propertyDescription) {
+    auto name = propertyDescription.getPropertyName();
+    if (name.empty() || m_handles.find(name) != m_handles.end()) {
+        return 0;
+    }
+    std::unique_ptr<Property> property(new Property());
+    property->description = propertyDescription;
+    property->cachedValue = std::make_shared<const CachedValue>(CachedValue{false, ""});
+    m_properties.push_back(std::move(property));
+
+    auto handle = static_cast<PropertyHandle>(m_properties.size());
+    m_handles[name] = handle;
+    return handle;
+}
+
+PropertyRegistry::PropertyHandle PropertyRegistry::getHandle(const std::string& name) const {
+    auto it = m_handles.find(name);
+    return it != m_handles.end() ? it->second : 0;
+}
+
+const PropertyDescription* PropertyRegistry::getDescription(PropertyHandle handle) const {
+    if (handle == 0 || handle > m_properties.size()) {
+        return nullptr;
+    }
+    return &m_properties[handle - 1]->description;
+}
+
+std::string PropertyRegistry::getValue(PropertyHandle handle, bool cache) {
+    ThrowIf(handle == 0 || handle > m_properties.size(), "propertyNotFound");
+    auto& property = *m_properties[handle - 1];
+    auto getter = property.description.getter();
+    ThrowIfNull(getter, "writeOnlyProperty");
+    if (!property.description.isCacheable()) {
+        return getter();
+    }
+
+    auto cachedValue = std::atomic_load(&property.cachedValue);
+    if (cachedValue->valid) {
+        return cachedValue->value;
+    }
+    auto value = getter();
+    if (cache) {
+        // the value is cached only if the property was not invalidated while the getter ran, since the getter may
+        // have read the value from before the change
+        auto updatedValue = std::make_shared<const CachedValue>(CachedValue{true, value});
+        std::atomic_compare_exchange_strong(&property.cachedValue, &cachedValue, updatedValue);
+    }
+    return value;
+}
+
+void PropertyRegistry::invalidate(PropertyHandle handle) {
+    if (handle == 0 || handle > m_properties.size()) {
+        return;
+    }
+    auto& property = *m_properties[handle - 1];
+    if (property.description.isCacheable()) {
+        // a new invalid value, rather than a shared one, so a read racing with the invalidation fails to cache
+        std::atomic_store(&property.cachedValue, std::make_shared<const CachedValue>(CachedValue{false, ""}));
+    }
+}
+
+void PropertyRegistry::clear() {
+    m_handles.clear();
+    m_properties.clear();
+}
+
+}  // namespace propertyManager
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,493 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AACE/Engine/Storage/CachingLocalStorage.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+
+namespace aace {
+namespace engine {
+namespace storage {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.storage.CachingLocalStorage");
+
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+using MemoryPressure = aace::engine::utils::memory::MemoryPressure;
+using MemoryPressureLevel = aace::engine::utils::memory::MemoryPressureLevel;
+
+/// The unwritten changes of a table, taken from the cache to be written
+struct TableChanges {
+    std::string table;
+    bool removed;
+    std::vector<LocalStorageInterface::KeyValuePair> puts;
+    std::vector<std::string> removes;
+};
+
+std::shared_ptr<CachingLocalStorage> CachingLocalStorage::create(
+    std::shared_ptr<LocalStorageInterface> storage,
+    std::chrono::milliseconds flushDelay) {
+    try {
+        ThrowIfNull(storage, "invalidStorage");
+        ThrowIf(flushDelay.count() < 0, "invalidFlushDelay");
+
+        auto cachingLocalStorage =
+            std::shared_ptr<CachingLocalStorage>(new CachingLocalStorage(storage, flushDelay));
+        MemoryPressure::addObserver(cachingLocalStorage, MemoryPressure::Priority::CACHE);
+
+        return cachingLocalStorage;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+CachingLocalStorage::CachingLocalStorage(
+    std::shared_ptr<LocalStorageInterface> storage,
+    std::chrono::milliseconds flushDelay) :
+        m_storage(storage), m_flushDelay(flushDelay), m_executor("Storage.writer") {
+}
+
+CachingLocalStorage::~CachingLocalStorage() {
+    // stop the scheduled writes, and write the remaining changes
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_executor.shutdown();
+    flush();
+}
+
+CachingLocalStorage::Table& CachingLocalStorage::getTableLocked(const std::string& table) {
+    auto it = m_tables.find(table);
+    if (it == m_tables.end()) {
+        Table cached;
+        cached.exists = m_storage->containsTable(table);
+        if (cached.exists) {
+            for (auto& next : m_storage->list(table)) {
+                cached.values.emplace(std::move(next.first), std::move(next.second));
+            }
+        }
+        it = m_tables.emplace(table, std::move(cached)).first;
+    }
+    return it->second;
+}
+
+bool CachingLocalStorage::hasChangesLocked() const {
+    for (auto& next : m_tables) {
+        if (next.second.removed || !next.second.dirtyKeys.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t CachingLocalStorage::trimLocked() {
+    // the tables read during a transaction may have its uncommitted changes
+    if (m_transactionInProgress) {
+        return 0;
+    }
+
+    size_t dropped = 0;
+    for (auto it = m_tables.begin(); it != m_tables.end();) {
+        if (!it->second.removed && it->second.dirtyKeys.empty() && !it->second.flushing) {
+            it = m_tables.erase(it);
+            dropped++;
+        } else {
+            ++it;
+        }
+    }
+    return dropped;
+}
+
+void CachingLocalStorage::scheduleFlushLocked() {
+    if (m_flushTimer != TimerWheel::INVALID_TIMER || m_shutdown) {
+        return;
+    }
+
+    // the changes are written on the executor, the timer thread must not block
+    std::weak_ptr<CachingLocalStorage> wp = shared_from_this();
+    m_flushTimer = TimerWheel::getDefault()->submitAfter(m_flushDelay, [wp]() {
+        if (auto storage = wp.lock()) {
+            auto raw = storage.get();
+            storage->m_executor.post([raw]() { raw->flush(); });
+        }
+    });
+}
+
+bool CachingLocalStorage::flush() {
+    std::lock_guard<std::mutex> flushLock(m_flushMutex);
+
+    std::vector<TableChanges> changes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_flushTimer != TimerWheel::INVALID_TIMER) {
+            TimerWheel::getDefault()->cancel(m_flushTimer);
+            m_flushTimer = TimerWheel::INVALID_TIMER;
+        }
+
+        // the changes made during a transaction are already written
+        if (m_transactionInProgress) {
+            return true;
+        }
+
+        for (auto& next : m_tables) {
+            auto& table = next.second;
+            if (!table.removed && table.dirtyKeys.empty()) {
+                continue;
+            }
+            TableChanges tableChanges;
+            tableChanges.table = next.first;
+            tableChanges.removed = table.removed;
+            for (auto& key : table.dirtyKeys) {
+                auto it = table.values.find(key);
+                if (it != table.values.end()) {
+                    tableChanges.puts.emplace_back(key, it->second);
+                } else {
+                    tableChanges.removes.push_back(key);
+                }
+            }
+            table.removed = false;
+            table.dirtyKeys.clear();
+            table.flushing = true;
+            changes.push_back(std::move(tableChanges));
+        }
+    }
+
+    if (changes.empty()) {
+        return true;
+    }
+
+    try {
+        ThrowIfNot(m_storage->begin(), "beginFailed");
+        for (auto& next : changes) {
+            // a table or key that was never written to the storage can't be removed from it
+            if (next.removed && m_storage->containsTable(next.table)) {
+                ThrowIfNot(m_storage->removeTable(next.table), "removeTableFailed");
+            }
+            for (auto& key : next.removes) {
+                if (m_storage->containsKey(next.table, key)) {
+                    ThrowIfNot(m_storage->removeKey(next.table, key), "removeKeyFailed");
+                }
+            }
+            for (auto& value : next.puts) {
+                ThrowIfNot(m_storage->put(next.table, value.first, value.second), "putFailed");
+            }
+        }
+        if (!m_storage->commit()) {
+            m_storage->cancel();
+            Throw("commitFailed");
+        }
+
+        // the tables that were written are not kept while the memory is low
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& next : changes) {
+            auto it = m_tables.find(next.table);
+            if (it != m_tables.end()) {
+                it->second.flushing = false;
+            }
+        }
+        if (m_memoryPressureLevel >= MemoryPressureLevel::LOW) {
+            trimLocked();
+        }
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "flush").d("reason", ex.what()));
+
+        // the changes are written again with the next changes, unless they were changed since
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& next : changes) {
+            // the table is read again if the cache was cleared, so the values of the changes are restored
+            auto& table = getTableLocked(next.table);
+            table.flushing = false;
+            if (table.removed) {
+                // the table was removed since, its changes don't have to be written anymore
+                continue;
+            }
+            table.removed = next.removed;
+            for (auto& value : next.puts) {
+                if (table.dirtyKeys.insert(value.first).second) {
+                    table.exists = true;
+                    table.values[value.first] = value.second;
+                }
+            }
+            for (auto& key : next.removes) {
+                if (table.dirtyKeys.insert(key).second) {
+                    table.values.erase(key);
+                }
+            }
+        }
+        if (!m_transactionInProgress) {
+            scheduleFlushLocked();
+        }
+
+        return false;
+    }
+}
+
+void CachingLocalStorage::onMemoryPressure(MemoryPressureLevel level) {
+    size_t dropped = 0;
+    size_t remaining = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_memoryPressureLevel = level;
+        if (level == MemoryPressureLevel::NORMAL) {
+            // the tables are cached again as they are used
+            return;
+        }
+        dropped = trimLocked();
+        remaining = m_tables.size();
+
+        // the changes are written on the executor rather than after the flush delay, the observer must not block
+        if (level >= MemoryPressureLevel::LOW && !m_transactionInProgress && !m_shutdown && hasChangesLocked()) {
+            auto raw = this;
+            m_executor.post([raw]() { raw->flush(); });
+        }
+    }
+    AACE_INFO(LX(TAG, "onMemoryPressure").d("level", level).d("dropped", dropped).d("remaining", remaining));
+}
+
+bool CachingLocalStorage::put(const std::string& table, const std::string& key, const std::string& value) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& cached = getTableLocked(table);
+
+        if (m_transactionInProgress) {
+            ThrowIfNot(m_storage->put(table, key, value), "putFailed");
+        } else {
+            cached.dirtyKeys.insert(key);
+            scheduleFlushLocked();
+        }
+        cached.exists = true;
+        cached.values[key] = value;
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "put").d("reason", ex.what()));
+        return false;
+    }
+}
+
+std::string CachingLocalStorage::get(const std::string& table, const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& cached = getTableLocked(table);
+
+    auto it = cached.values.find(key);
+    return it != cached.values.end() ? it->second : std::string();
+}
+
+std::string CachingLocalStorage::get(
+    const std::string& table,
+    const std::string& key,
+    const std::string& defaultValue) {
+    auto value = get(table, key);
+    return value.empty() ? defaultValue : value;
+}
+
+bool CachingLocalStorage::removeKey(const std::string& table, const std::string& key) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& cached = getTableLocked(table);
+        ThrowIf(cached.values.count(key) == 0, "invalidKey");
+
+        if (m_transactionInProgress) {
+            ThrowIfNot(m_storage->removeKey(table, key), "removeKeyFailed");
+        } else {
+            cached.dirtyKeys.insert(key);
+            scheduleFlushLocked();
+        }
+        cached.values.erase(key);
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "removeKey").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool CachingLocalStorage::removeTable(const std::string& table) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& cached = getTableLocked(table);
+        ThrowIfNot(cached.exists, "invalidTable");
+
+        if (m_transactionInProgress) {
+            ThrowIfNot(m_storage->removeTable(table), "removeTableFailed");
+        } else {
+            // the keys written since the table was last written don't have to be written anymore
+            cached.removed = true;
+            cached.dirtyKeys.clear();
+            scheduleFlushLocked();
+        }
+        cached.exists = false;
+        cached.values.clear();
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "removeTable").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool CachingLocalStorage::containsKey(const std::string& table, const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return getTableLocked(table).values.count(key) > 0;
+}
+
+bool CachingLocalStorage::containsTable(const std::string& table) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return getTableLocked(table).exists;
+}
+
+std::vector<std::string> CachingLocalStorage::keys(const std::string& table) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& cached = getTableLocked(table);
+
+    std::vector<std::string> keys;
+    keys.reserve(cached.values.size());
+    for (auto& next : cached.values) {
+        keys.push_back(next.first);
+    }
+
+    return keys;
+}
+
+std::vector<LocalStorageInterface::KeyValuePair> CachingLocalStorage::list(const std::string& table) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& cached = getTableLocked(table);
+
+    return std::vector<KeyValuePair>(cached.values.begin(), cached.values.end());
+}
+
+bool CachingLocalStorage::begin() {
+    try {
+        // the changes made before the transaction must not be cancelled with it
+        while (true) {
+            ThrowIfNot(flush(), "flushFailed");
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ThrowIf(m_transactionInProgress, "transactionInProgress");
+            if (hasChangesLocked()) {
+                // changes were made while the others were written
+                continue;
+            }
+            ThrowIfNot(m_storage->begin(), "beginTransactionFailed");
+            m_transactionInProgress = true;
+
+            return true;
+        }
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "begin").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool CachingLocalStorage::commit() {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ThrowIfNot(m_transactionInProgress, "transactionNotInProgress");
+        ThrowIfNot(m_storage->commit(), "commitTransactionFailed");
+        m_transactionInProgress = false;
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "commit").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool CachingLocalStorage::cancel() {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ThrowIfNot(m_transactionInProgress, "transactionNotInProgress");
+        ThrowIfNot(m_storage->cancel(), "cancelTransactionFailed");
+        m_transactionInProgress = false;
+
+        // the cache has the cancelled changes, the tables are read again when they are used
+        m_tables.clear();
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "cancel").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool CachingLocalStorage::putBatch(const std::string& table, const std::vector<KeyValuePair>& values) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& cached = getTableLocked(table);
+
+        if (m_transactionInProgress) {
+            ThrowIfNot(m_storage->putBatch(table, values), "putBatchFailed");
+        } else {
+            for (auto& next : values) {
+                cached.dirtyKeys.insert(next.first);
+            }
+            scheduleFlushLocked();
+        }
+        cached.exists = true;
+        for (auto& next : values) {
+            cached.values[next.first] = next.second;
+        }
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "putBatch").d("reason", ex.what()));
+        return false;
+    }
+}
+
+std::vector<LocalStorageInterface::KeyValuePair> CachingLocalStorage::getBatch(
+    const std::string& table,
+    const std::vector<std::string>& keys) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& cached = getTableLocked(table);
+
+    std::vector<KeyValuePair> values;
+    for (auto& next : keys) {
+        auto it = cached.values.find(next);
+        if (it != cached.values.end()) {
+            values.emplace_back(next, it->second);
+        }
+    }
+
+    return values;
+}
+
+bool CachingLocalStorage::forEach(const std::string& table, ForEachCallback callback) {
+    std::vector<KeyValuePair> values;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& cached = getTableLocked(table);
+        if (!cached.exists || callback == nullptr) {
+            return false;
+        }
+        values.assign(cached.values.begin(), cached.values.end());
+    }
+
+    // the callback is called without the lock, so it can use the storage
+    for (auto& next : values) {
+        if (!callback(next.first, next.second)) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace storage
+}  // namespace engine
+}  // namespace aace
@@ -22,6 +22,39 @@ namespace storage {
 LocalStorageInterface::~LocalStorageInterface() {
 }
 
+bool LocalStorageInterface::putBatch(const std::string& table, const std::vector<KeyValuePair>& values) {
+    for (auto& next : values) {
+        if (!put(table, next.first, next.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<LocalStorageInterface::KeyValuePair> LocalStorageInterface::getBatch(
+    const std::string& table,
+    const std::vector<std::string>& keys) {
+    std::vector<KeyValuePair> values;
+    for (auto& next : keys) {
+        if (containsKey(table, next)) {
+            values.emplace_back(next, get(table, next));
+        }
+    }
+    return values;
+}
+
+bool LocalStorageInterface::forEach(const std::string& table, ForEachCallback callback) {
+    if (!containsTable(table)) {
+        return false;
+    }
+    for (auto& next : list(table)) {
+        if (!callback(next.first, next.second)) {
+            break;
+        }
+    }
+    return true;
+}
+
 }  // namespace storage
 }  // namespace engine
 }  // namespace aace
@@ -13,16 +13,17 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 
 #include "AACE/Engine/Storage/SQLiteStorage.h"
 #include "AACE/Engine/Core/EngineMacros.h"
 
-#include <rapidjson/istreamwrapper.h>
-#include <rapidjson/ostreamwrapper.h>
-#include <rapidjson/prettywriter.h>
-#include <rapidjson/error/en.h>
-
 namespace aace {
 namespace engine {
 namespace storage {
@@ -30,6 +31,65 @@ namespace storage {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.storage.SQLiteStorage");
 
+/// The values of the synchronous setting
+static const std::array<const char*, 4> SYNCHRONOUS_VALUES = {{"off", "normal", "full", "extra"}};
+
+/// The values of the journal mode setting
+static const std::array<const char*, 6> JOURNAL_MODE_VALUES = {
+    {"delete", "truncate", "persist", "memory", "wal", "off"}};
+
+/// The value of the auto_vacuum setting of a database with incremental vacuum
+static constexpr int64_t AUTO_VACUUM_INCREMENTAL = 2;
+
+/// The largest database converted to incremental vacuum by the maintenance, with a full vacuum
+static constexpr int64_t MAX_CONVERSION_SIZE = 1024 * 1024;
+
+/// The number of free pages returned to the file system by each step of the incremental vacuum
+static constexpr int VACUUM_STEP_PAGES = 64;
+
+/// Returns a lower case copy of a string.
+static std::string toLower(const std::string& value) {
+    std::string lower(value);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    return lower;
+}
+
+/// Returns a table name quoted as an SQL identifier.
+static std::string quoteTable(const std::string& table) {
+    std::string quoted("\"");
+    for (auto c : table) {
+        quoted.push_back(c);
+        if (c == '"') {
+            quoted.push_back(c);
+        }
+    }
+    quoted.push_back('"');
+    return quoted;
+}
+
+/// Binds a string to a parameter of a statement. The string must outlive the execution of the statement.
+static bool bindText(sqlite3_stmt* statement, int index, const std::string& value) {
+    return sqlite3_bind_text(statement, index, value.c_str(), static_cast<int>(value.size()), SQLITE_STATIC) ==
+           SQLITE_OK;
+}
+
+/// Returns a text column of the current row of a statement.
+static std::string columnText(sqlite3_stmt* statement, int index) {
+    auto text = sqlite3_column_text(statement, index);
+    if (text == nullptr) {
+        return std::string();
+    }
+    return std::string(reinterpret_cast<const char*>(text), sqlite3_column_bytes(statement, index));
+}
+
+SQLiteStorage::StatementReset::StatementReset(sqlite3_stmt* statement) : m_statement(statement) {
+}
+
+SQLiteStorage::StatementReset::~StatementReset() {
+    sqlite3_reset(m_statement);
+    sqlite3_clear_bindings(m_statement);
+}
+
 SQLiteStorage::SQLiteStorage(const std::string& path) : m_path(path) {
 }
 
@@ -39,6 +99,15 @@ SQLiteStorage::~SQLiteStorage() {
         cancel();
     }
 
+    // the prepared statements must be finalized before the database is closed
+    for (auto& next : m_statements) {
+        for (auto statement : next.second) {
+            sqlite3_finalize(statement);
+        }
+    }
+    m_statements.clear();
+    sqlite3_finalize(m_checkTableStatement);
+
     // close the database
     if (m_db != nullptr) {
         if (sqlite3_close(m_db) != SQLITE_OK) {
@@ -47,11 +116,14 @@ SQLiteStorage::~SQLiteStorage() {
     }
 }
 
-std::shared_ptr<SQLiteStorage> SQLiteStorage::create(const std::string& path) {
+std::shared_ptr<SQLiteStorage> SQLiteStorage::create(
+    const std::string& path,
+    const std::string& journalMode,
+    const std::string& synchronous) {
     try {
         auto storage = std::shared_ptr<SQLiteStorage>(new SQLiteStorage(path));
 
-        ThrowIfNot(storage->initialize(), "initializeFailed");
+        ThrowIfNot(storage->initialize(journalMode, synchronous), "initializeFailed");
 
         return storage;
     } catch (std::exception& ex) {
@@ -60,24 +132,58 @@ std::shared_ptr<SQLiteStorage> SQLiteStorage::create(const std::string& path) {
     }
 }
 
-bool SQLiteStorage::initialize() {
+bool SQLiteStorage::initialize(const std::string& journalMode, const std::string& synchronous) {
     try {
+        auto journalModeValue = toLower(journalMode);
+        ThrowIf(
+            std::find(JOURNAL_MODE_VALUES.begin(), JOURNAL_MODE_VALUES.end(), journalModeValue) ==
+                JOURNAL_MODE_VALUES.end(),
+            "invalidJournalMode");
+        auto synchronousValue = toLower(synchronous);
+        ThrowIf(
+            std::find(SYNCHRONOUS_VALUES.begin(), SYNCHRONOUS_VALUES.end(), synchronousValue) ==
+                SYNCHRONOUS_VALUES.end(),
+            "invalidSynchronous");
+
+        // the connection is serialized by m_mutex, so SQLite doesn't have to lock it again
         std::ifstream is(m_path);
 
         if (is.good()) {
             ThrowIf(
-                sqlite3_open_v2(m_path.c_str(), &m_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_FULLMUTEX, nullptr) !=
+                sqlite3_open_v2(m_path.c_str(), &m_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_NOMUTEX, nullptr) !=
                     SQLITE_OK,
                 "openDatabaseFailed");
         } else {
             ThrowIf(
                 sqlite3_open_v2(
-                    m_path.c_str(),
-                    &m_db,
-                    SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX,
-                    nullptr) != SQLITE_OK,
+                    m_path.c_str(), &m_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, nullptr) !=
+                    SQLITE_OK,
                 "createDatabaseFailed");
+
+            // the free pages of a new database can be returned to the file system by the maintenance, the
+            // setting must be changed before the first table is created
+            ThrowIfNot(query("PRAGMA auto_vacuum=INCREMENTAL;"), "setAutoVacuumFailed");
+        }
+
+        // the journal mode is kept in the database, the returned mode is the previous one if it can't be changed
+        std::string mode;
+        ThrowIfNot(
+            query(
+                createStatement("PRAGMA journal_mode=%s;", journalModeValue.c_str()),
+                [](void* data, int argc, char** argv, char** azColName) {
+                    if (argc == 1 && argv[0] != nullptr) {
+                        *((std::string*)data) = argv[0];
+                    }
+                    return SQLITE_OK;
+                },
+                &mode),
+            "setJournalModeFailed");
+        if (toLower(mode) != journalModeValue) {
+            AACE_WARN(LX(TAG, "initialize").d("reason", "journalModeNotSupported").d("journalMode", mode));
         }
+        m_walMode = toLower(mode) == "wal";
+
+        ThrowIfNot(query(createStatement("PRAGMA synchronous=%s;", synchronousValue.c_str())), "setSynchronousFailed");
 
         return true;
     } catch (std::exception& ex) {
@@ -113,30 +219,100 @@ std::string SQLiteStorage::createStatement(const char* stmt, ...) {
     }
 }
 
+sqlite3_stmt* SQLiteStorage::getStatementLocked(const std::string& table, Operation operation) {
+    auto it = m_statements.find(table);
+    if (it == m_statements.end()) {
+        std::array<sqlite3_stmt*, OPERATION_COUNT> statements;
+        statements.fill(nullptr);
+        it = m_statements.emplace(table, statements).first;
+    }
+
+    auto& statement = it->second[operation];
+    if (statement == nullptr) {
+        auto name = quoteTable(table);
+        std::string sql;
+        switch (operation) {
+            case GET:
+                sql = "SELECT value FROM " + name + " WHERE key=?;";
+                break;
+            case PUT:
+                sql = "INSERT OR REPLACE INTO " + name + " (key,value) VALUES (?,?);";
+                break;
+            case CONTAINS:
+                sql = "SELECT 1 FROM " + name + " WHERE key=?;";
+                break;
+            case REMOVE:
+                sql = "DELETE FROM " + name + " WHERE key=?;";
+                break;
+            case KEYS:
+                sql = "SELECT key FROM " + name + ";";
+                break;
+            case LIST:
+                sql = "SELECT key,value FROM " + name + ";";
+                break;
+            case OPERATION_COUNT:
+                return nullptr;
+        }
+        if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &statement, nullptr) != SQLITE_OK) {
+            AACE_ERROR(LX(TAG, "getStatement").d("reason", sqlite3_errmsg(m_db)).sensitive("q", sql));
+            sqlite3_finalize(statement);
+            statement = nullptr;
+        }
+    }
+
+    return statement;
+}
+
+void SQLiteStorage::finalizeStatementsLocked(const std::string& table) {
+    auto it = m_statements.find(table);
+    if (it != m_statements.end()) {
+        for (auto statement : it->second) {
+            sqlite3_finalize(statement);
+        }
+        m_statements.erase(it);
+    }
+}
+
 bool SQLiteStorage::checkTable(const std::string& table, bool create) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
 
-        std::string sql =
-            createStatement("SELECT count(*) FROM sqlite_master WHERE type='table' AND name='%s';", table.c_str());
+        if (m_tables.count(table) > 0) {
+            return true;
+        }
 
-        bool exists = false;
+        if (m_checkTableStatement == nullptr) {
+            ThrowIf(
+                sqlite3_prepare_v2(
+                    m_db,
+                    "SELECT count(*) FROM sqlite_master WHERE type='table' AND name=?;",
+                    -1,
+                    &m_checkTableStatement,
+                    nullptr) != SQLITE_OK,
+                "prepareStatementFailed");
+        }
 
-        query(
-            sql,
-            [](void* data, int argc, char** argv, char** azColName) {
-                *((bool*)data) = argc == 1 && std::atoi(*argv) == 1;
-                return SQLITE_OK;
-            },
-            &exists);
+        bool exists = false;
+        {
+            StatementReset reset(m_checkTableStatement);
+            ThrowIfNot(bindText(m_checkTableStatement, 1, table), "bindFailed");
+            if (sqlite3_step(m_checkTableStatement) == SQLITE_ROW) {
+                exists = sqlite3_column_int(m_checkTableStatement, 0) == 1;
+            }
+        }
 
         if (exists == false && create) {
-            sql = createStatement(
-                "CREATE TABLE '%s' (key STRING PRIMARY KEY NOT NULL,value STRING NOT NULL);", table.c_str());
+            auto sql =
+                "CREATE TABLE " + quoteTable(table) + " (key STRING PRIMARY KEY NOT NULL,value STRING NOT NULL);";
             ThrowIfNot(query(sql) && checkTable(table), "createTableFailed");
             return true;
         }
 
+        if (exists) {
+            m_tables.insert(table);
+        }
+
         return exists;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "checkTable").d("reason", ex.what()));
@@ -146,29 +322,26 @@ bool SQLiteStorage::checkTable(const std::string& table, bool create) {
 
 bool SQLiteStorage::checkKey(const std::string& table, const std::string& key) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
         ReturnIfNot(checkTable(table), false);
 
-        bool exists = false;
+        auto statement = getStatementLocked(table, CONTAINS);
+        ThrowIfNull(statement, "prepareStatementFailed");
 
-        auto sql = createStatement("SELECT value FROM '%s' WHERE key='%s';", table.c_str(), key.c_str());
-        query(
-            sql,
-            [](void* data, int argc, char** argv, char** azColName) {
-                *((bool*)data) = argc == 1;
-                return SQLITE_OK;
-            },
-            &exists);
+        StatementReset reset(statement);
+        ThrowIfNot(bindText(statement, 1, key), "bindFailed");
 
-        return exists;
+        return sqlite3_step(statement) == SQLITE_ROW;
     } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG, "checkTable").d("reason", ex.what()));
+        AACE_ERROR(LX(TAG, "checkKey").d("reason", ex.what()));
         return false;
     }
 }
 
 bool SQLiteStorage::query(const std::string& sql, int (*cb)(void*, int, char**, char**), void* data) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
 
         char* errmsg = nullptr;
@@ -186,22 +359,126 @@ bool SQLiteStorage::query(const std::string& sql, int (*cb)(void*, int, char**,
     }
 }
 
-bool SQLiteStorage::put(const std::string& table, const std::string& key, const std::string& value) {
+bool SQLiteStorage::queryInteger(const std::string& sql, int64_t& value) {
+    return query(
+        sql,
+        [](void* data, int argc, char** argv, char** azColName) {
+            if (argc >= 1 && argv[0] != nullptr) {
+                *static_cast<int64_t*>(data) = std::strtoll(argv[0], nullptr, 10);
+            }
+            return SQLITE_OK;
+        },
+        &value);
+}
+
+bool SQLiteStorage::readFileStatsLocked(MaintenanceReport& report) {
+    return queryInteger("PRAGMA page_size;", report.pageSize) &&
+           queryInteger("PRAGMA page_count;", report.pageCount) &&
+           queryInteger("PRAGMA freelist_count;", report.freePageCount);
+}
+
+int64_t SQLiteStorage::getChangeCount() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return m_db != nullptr ? sqlite3_total_changes(m_db) : 0;
+}
+
+bool SQLiteStorage::runMaintenance(std::chrono::milliseconds budget, MaintenanceReport& report) {
     try {
-        ThrowIfNull(m_db, "invalidDatabase");
-        ThrowIfNot(checkTable(table, true), "invalidTable");
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + budget;
+        report = MaintenanceReport();
+
+        // each step holds the lock, the reads and writes of the engine run between the steps
+        int64_t autoVacuum = 0;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
+            ThrowIfNull(m_db, "invalidDatabase");
+            ThrowIf(m_transactionInProgress, "transactionInProgress");
+            ThrowIfNot(readFileStatsLocked(report), "readFileStatsFailed");
+            ThrowIfNot(queryInteger("PRAGMA auto_vacuum;", autoVacuum), "readAutoVacuumFailed");
+
+            // a database created without incremental vacuum is converted by a full vacuum, which can't be
+            // interrupted, so only a small database is converted
+            if (autoVacuum != AUTO_VACUUM_INCREMENTAL && report.pageCount * report.pageSize <= MAX_CONVERSION_SIZE) {
+                ThrowIfNot(query("PRAGMA auto_vacuum=INCREMENTAL;") && query("VACUUM;"), "convertDatabaseFailed");
+                ThrowIfNot(queryInteger("PRAGMA auto_vacuum;", autoVacuum), "readAutoVacuumFailed");
+                report.vacuumedPageCount = report.freePageCount;
+                AACE_INFO(LX(TAG, "runMaintenance").m("incrementalVacuumEnabled").d("pageCount", report.pageCount));
+            }
+        }
 
-        std::string sql;
+        // return the free pages to the file system, a few pages at a time
+        while (autoVacuum == AUTO_VACUUM_INCREMENTAL) {
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
+            ThrowIf(m_transactionInProgress, "transactionInProgress");
+            ThrowIfNot(queryInteger("PRAGMA freelist_count;", report.freePageCount), "readFreePagesFailed");
+            if (report.freePageCount == 0) {
+                break;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                report.budgetExceeded = true;
+                break;
+            }
+            ThrowIfNot(
+                query(createStatement("PRAGMA incremental_vacuum(%d);", VACUUM_STEP_PAGES)), "incrementalVacuumFailed");
+            report.vacuumedPageCount += std::min<int64_t>(report.freePageCount, VACUUM_STEP_PAGES);
+        }
 
-        if (containsKey(table, key)) {
-            sql = createStatement(
-                "UPDATE '%s' SET value='%s' WHERE key='%s';", table.c_str(), value.c_str(), key.c_str());
+        // the vacuumed pages are written to the log, the checkpoint writes them to the database, and truncates
+        // the database file and the log
+        if (m_walMode && std::chrono::steady_clock::now() < deadline) {
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
+            ThrowIf(m_transactionInProgress, "transactionInProgress");
+            report.checkpointed =
+                sqlite3_wal_checkpoint_v2(m_db, nullptr, SQLITE_CHECKPOINT_TRUNCATE, nullptr, nullptr) == SQLITE_OK;
+            if (!report.checkpointed) {
+                AACE_WARN(LX(TAG, "runMaintenance").d("reason", "checkpointFailed").d("error", sqlite3_errmsg(m_db)));
+            }
+        }
+
+        // analyze the tables whose statistics are missing or out of date
+        if (std::chrono::steady_clock::now() < deadline) {
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
+            ThrowIf(m_transactionInProgress, "transactionInProgress");
+            report.analyzed = query("PRAGMA optimize;");
         } else {
-            sql = createStatement(
-                "INSERT INTO '%s' (key,value) VALUES ('%s','%s');", table.c_str(), key.c_str(), value.c_str());
+            report.budgetExceeded = true;
         }
 
-        ThrowIfNot(query(sql), "executeSqlStatementFailed");
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
+            ThrowIfNot(readFileStatsLocked(report), "readFileStatsFailed");
+        }
+
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        AACE_DEBUG(LX(TAG, "runMaintenance")
+                       .d("pageCount", report.pageCount)
+                       .d("freePageCount", report.freePageCount)
+                       .d("vacuumedPageCount", report.vacuumedPageCount)
+                       .d("checkpointed", report.checkpointed)
+                       .d("analyzed", report.analyzed)
+                       .d("budgetExceeded", report.budgetExceeded)
+                       .d("durationMs", duration.count()));
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "runMaintenance").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool SQLiteStorage::put(const std::string& table, const std::string& key, const std::string& value) {
+    try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        ThrowIfNull(m_db, "invalidDatabase");
+        ThrowIfNot(checkTable(table, true), "invalidTable");
+
+        auto statement = getStatementLocked(table, PUT);
+        ThrowIfNull(statement, "prepareStatementFailed");
+
+        StatementReset reset(statement);
+        ThrowIfNot(bindText(statement, 1, key) && bindText(statement, 2, value), "bindFailed");
+        ThrowIfNot(sqlite3_step(statement) == SQLITE_DONE, "executeSqlStatementFailed");
 
         return true;
     } catch (std::exception& ex) {
@@ -212,21 +489,20 @@ bool SQLiteStorage::put(const std::string& table, const std::string& key, const
 
 std::string SQLiteStorage::get(const std::string& table, const std::string& key) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
         ThrowIfNot(checkTable(table, false), "invalidTable");
 
-        std::string output;
+        auto statement = getStatementLocked(table, GET);
+        ThrowIfNull(statement, "prepareStatementFailed");
 
-        auto sql = createStatement("SELECT value FROM '%s' WHERE key='%s';", table.c_str(), key.c_str());
-        query(
-            sql,
-            [](void* data, int argc, char** argv, char** azColName) {
-                if (argc == 1) {
-                    ((std::string*)data)->append(*argv);
-                }
-                return SQLITE_OK;
-            },
-            &output);
+        StatementReset reset(statement);
+        ThrowIfNot(bindText(statement, 1, key), "bindFailed");
+
+        std::string output;
+        if (sqlite3_step(statement) == SQLITE_ROW) {
+            output = columnText(statement, 0);
+        }
 
         return output;
     } catch (std::exception& ex) {
@@ -242,11 +518,17 @@ std::string SQLiteStorage::get(const std::string& table, const std::string& key,
 
 bool SQLiteStorage::removeKey(const std::string& table, const std::string& key) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
-        ThrowIfNot(containsKey(table, key), "invalidKey");
+        ThrowIfNot(checkTable(table), "invalidKey");
+
+        auto statement = getStatementLocked(table, REMOVE);
+        ThrowIfNull(statement, "prepareStatementFailed");
 
-        auto sql = createStatement("DELETE FROM '%s' WHERE key='%s';", table.c_str(), key.c_str());
-        ThrowIfNot(query(sql), "removeKeyFailed");
+        StatementReset reset(statement);
+        ThrowIfNot(bindText(statement, 1, key), "bindFailed");
+        ThrowIfNot(sqlite3_step(statement) == SQLITE_DONE, "removeKeyFailed");
+        ThrowIf(sqlite3_changes(m_db) == 0, "invalidKey");
 
         return true;
     } catch (std::exception& ex) {
@@ -257,14 +539,17 @@ bool SQLiteStorage::removeKey(const std::string& table, const std::string& key)
 
 bool SQLiteStorage::removeTable(const std::string& table) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
         ThrowIfNot(containsTable(table), "invalidTable");
 
-        auto sql = createStatement("DELETE FROM '%s';", table.c_str());
-        ThrowIfNot(query(sql), "deleteFromTableFailed");
+        // the statements of the table can't be used once it is dropped
+        finalizeStatementsLocked(table);
+        m_tables.erase(table);
 
-        sql = createStatement("DROP TABLE IF EXISTS '%s';", table.c_str());
-        ThrowIfNot(query(sql), "dropTableFailed");
+        auto name = quoteTable(table);
+        ThrowIfNot(query("DELETE FROM " + name + ";"), "deleteFromTableFailed");
+        ThrowIfNot(query("DROP TABLE IF EXISTS " + name + ";"), "dropTableFailed");
 
         return true;
     } catch (std::exception& ex) {
@@ -289,17 +574,17 @@ bool SQLiteStorage::containsTable(const std::string& table) {
 
 std::vector<std::string> SQLiteStorage::keys(const std::string& table) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
         std::vector<std::string> keys;
 
-        auto sql = createStatement("SELECT key FROM '%s';", table.c_str());
-        query(
-            sql,
-            [](void* data, int argc, char** argv, char** azColName) {
-                ((std::vector<std::string>*)data)->push_back(*argv);
-                return SQLITE_OK;
-            },
-            &keys);
+        auto statement = getStatementLocked(table, KEYS);
+        ThrowIfNull(statement, "prepareStatementFailed");
+
+        StatementReset reset(statement);
+        while (sqlite3_step(statement) == SQLITE_ROW) {
+            keys.push_back(columnText(statement, 0));
+        }
 
         return keys;
     } catch (std::exception& ex) {
@@ -310,17 +595,17 @@ std::vector<std::string> SQLiteStorage::keys(const std::string& table) {
 
 std::vector<SQLiteStorage::KeyValuePair> SQLiteStorage::list(const std::string& table) {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
         std::vector<LocalStorageInterface::KeyValuePair> keyValuePairList;
 
-        auto sql = createStatement("SELECT key,value FROM '%s';", table.c_str());
-        query(
-            sql,
-            [](void* data, int argc, char** argv, char** azColName) {
-                ((std::vector<LocalStorageInterface::KeyValuePair>*)data)->push_back({argv[0], argv[1]});
-                return SQLITE_OK;
-            },
-            &keyValuePairList);
+        auto statement = getStatementLocked(table, LIST);
+        ThrowIfNull(statement, "prepareStatementFailed");
+
+        StatementReset reset(statement);
+        while (sqlite3_step(statement) == SQLITE_ROW) {
+            keyValuePairList.push_back({columnText(statement, 0), columnText(statement, 1)});
+        }
 
         return keyValuePairList;
     } catch (std::exception& ex) {
@@ -331,6 +616,7 @@ std::vector<SQLiteStorage::KeyValuePair> SQLiteStorage::list(const std::string&
 
 bool SQLiteStorage::begin() {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
         ThrowIfNot(query("BEGIN TRANSACTION;"), "beginTransactionFailed");
 
@@ -345,6 +631,7 @@ bool SQLiteStorage::begin() {
 
 bool SQLiteStorage::commit() {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
         ThrowIfNot(m_transactionInProgress, "transactionNotInProgress");
         ThrowIfNot(query("COMMIT TRANSACTION;"), "commitTransactionFailed");
@@ -360,12 +647,16 @@ bool SQLiteStorage::commit() {
 
 bool SQLiteStorage::cancel() {
     try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         ThrowIfNull(m_db, "invalidDatabase");
         ThrowIfNot(m_transactionInProgress, "transactionNotInProgress");
         ThrowIfNot(query("ROLLBACK TRANSACTION;"), "cancelTransactionFailed");
 
         m_transactionInProgress = false;
 
+        // a table created or dropped by the transaction is checked again
+        m_tables.clear();
+
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "cancel").d("reason", ex.what()));
@@ -373,6 +664,104 @@ bool SQLiteStorage::cancel() {
     }
 }
 
+bool SQLiteStorage::putBatch(const std::string& table, const std::vector<KeyValuePair>& values) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    bool savepoint = false;
+    try {
+        ThrowIfNull(m_db, "invalidDatabase");
+        ThrowIfNot(checkTable(table, true), "invalidTable");
+
+        auto statement = getStatementLocked(table, PUT);
+        ThrowIfNull(statement, "prepareStatementFailed");
+
+        // a savepoint puts the values at once, and can be nested in a transaction
+        ThrowIfNot(query("SAVEPOINT putBatch;"), "beginSavepointFailed");
+        savepoint = true;
+        for (auto& next : values) {
+            StatementReset reset(statement);
+            ThrowIfNot(bindText(statement, 1, next.first) && bindText(statement, 2, next.second), "bindFailed");
+            ThrowIfNot(sqlite3_step(statement) == SQLITE_DONE, "executeSqlStatementFailed");
+        }
+        ThrowIfNot(query("RELEASE SAVEPOINT putBatch;"), "releaseSavepointFailed");
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "putBatch").d("reason", ex.what()));
+        if (savepoint) {
+            query("ROLLBACK TO SAVEPOINT putBatch;");
+            query("RELEASE SAVEPOINT putBatch;");
+        }
+        return false;
+    }
+}
+
+std::vector<SQLiteStorage::KeyValuePair> SQLiteStorage::getBatch(
+    const std::string& table,
+    const std::vector<std::string>& keys) {
+    try {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        ThrowIfNull(m_db, "invalidDatabase");
+        ThrowIfNot(checkTable(table, false), "invalidTable");
+
+        auto statement = getStatementLocked(table, GET);
+        ThrowIfNull(statement, "prepareStatementFailed");
+
+        std::vector<KeyValuePair> values;
+        for (auto& next : keys) {
+            StatementReset reset(statement);
+            ThrowIfNot(bindText(statement, 1, next), "bindFailed");
+            if (sqlite3_step(statement) == SQLITE_ROW) {
+                values.emplace_back(next, columnText(statement, 0));
+            }
+        }
+
+        return values;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "getBatch").d("reason", ex.what()));
+        return std::vector<KeyValuePair>();
+    }
+}
+
+bool SQLiteStorage::forEach(const std::string& table, ForEachCallback callback) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    sqlite3_stmt* nested = nullptr;
+    try {
+        ThrowIfNull(m_db, "invalidDatabase");
+        ThrowIfNull(callback, "invalidCallback");
+        ThrowIfNot(checkTable(table, false), "invalidTable");
+
+        auto statement = getStatementLocked(table, LIST);
+        ThrowIfNull(statement, "prepareStatementFailed");
+
+        // a callback iterating over the same table gets its own statement
+        if (sqlite3_stmt_busy(statement)) {
+            auto sql = "SELECT key,value FROM " + quoteTable(table) + ";";
+            ThrowIf(sqlite3_prepare_v2(m_db, sql.c_str(), -1, &nested, nullptr) != SQLITE_OK, "prepareStatementFailed");
+            statement = nested;
+        }
+
+        int result;
+        {
+            StatementReset reset(statement);
+            while ((result = sqlite3_step(statement)) == SQLITE_ROW) {
+                if (!callback(columnText(statement, 0), columnText(statement, 1))) {
+                    result = SQLITE_DONE;
+                    break;
+                }
+            }
+        }
+        sqlite3_finalize(nested);
+        nested = nullptr;
+        ThrowIf(result != SQLITE_DONE, "readTableFailed");
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "forEach").d("reason", ex.what()));
+        sqlite3_finalize(nested);
+        return false;
+    }
+}
+
 }  // namespace storage
 }  // namespace engine
 }  // namespace aace
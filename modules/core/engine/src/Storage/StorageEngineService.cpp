@@ -15,9 +15,11 @@
 
 #include <string>
 
+#include "AACE/Engine/Audio/AudioManagerInterface.h"
 #include "AACE/Engine/Core/EngineMacros.h"
 #include "AACE/Engine/Storage/StorageEngineService.h"
 #include "AACE/Engine/Storage/SQLiteStorage.h"
+#include "AACE/Engine/Storage/CachingLocalStorage.h"
 #include "AACE/Engine/Utils/JSON/JSON.h"
 #include "AACE/Engine/Utils/String/StringUtils.h"
 
@@ -33,6 +35,12 @@ static const std::string TAG("aace.storage.StorageEngineService");
 // register the service
 REGISTER_SERVICE(StorageEngineService)
 
+/// The default time to wait after a change before the cache writes the changes
+static const std::chrono::milliseconds DEFAULT_CACHE_FLUSH_DELAY(1000);
+
+/// The default configuration of the maintenance
+static const StorageMaintenance::Config DEFAULT_MAINTENANCE_CONFIG = StorageMaintenance::Config();
+
 StorageEngineService::StorageEngineService(const aace::engine::core::ServiceDescription& description) :
         aace::engine::core::EngineService(description) {
 }
@@ -46,11 +54,38 @@ bool StorageEngineService::configure(std::shared_ptr<std::istream> configuration
         if (localStoragePath != nullptr) {
             std::string type = json::get(root, "/storageType", "sqlite");
             if (aace::engine::utils::string::equal(type, "sqlite", false)) {
-                m_localStorage = SQLiteStorage::create(localStoragePath);
-                ThrowIfNull(m_localStorage, "createLocalStorageFailed");
+                std::string journalMode = json::get(root, "/journalMode", "wal");
+                std::string synchronous = json::get(root, "/synchronous", "full");
+                auto sqliteStorage = SQLiteStorage::create(localStoragePath, journalMode, synchronous);
+                ThrowIfNull(sqliteStorage, "createLocalStorageFailed");
+                m_localStorage = sqliteStorage;
+
+                // compact the database and checkpoint the log while the engine is idle
+                auto maintenanceConfig = json::get(root, "/maintenance", json::Type::object);
+                if (maintenanceConfig != nullptr && json::get(maintenanceConfig, "/enabled", false)) {
+                    StorageMaintenance::Config config;
+                    config.interval = std::chrono::milliseconds(json::get(
+                        maintenanceConfig, "/interval", (uint64_t)DEFAULT_MAINTENANCE_CONFIG.interval.count()));
+                    config.idleDelay = std::chrono::milliseconds(json::get(
+                        maintenanceConfig, "/idleDelay", (uint64_t)DEFAULT_MAINTENANCE_CONFIG.idleDelay.count()));
+                    config.budget = std::chrono::milliseconds(
+                        json::get(maintenanceConfig, "/budget", (uint64_t)DEFAULT_MAINTENANCE_CONFIG.budget.count()));
+                    m_maintenance = StorageMaintenance::create(sqliteStorage, config, [this]() { return isActive(); });
+                    ThrowIfNull(m_maintenance, "createStorageMaintenanceFailed");
+                }
             } else {
                 Throw("invalidStorageType:" + type);
             }
+
+            // serve the reads from memory, and write the changes in batches
+            auto cacheConfig = json::get(root, "/cache", json::Type::object);
+            if (cacheConfig != nullptr && json::get(cacheConfig, "/enabled", false)) {
+                auto flushDelay = json::get(cacheConfig, "/flushDelay", (uint64_t)DEFAULT_CACHE_FLUSH_DELAY.count());
+                m_cachingLocalStorage =
+                    CachingLocalStorage::create(m_localStorage, std::chrono::milliseconds(flushDelay));
+                ThrowIfNull(m_cachingLocalStorage, "createCachingLocalStorageFailed");
+                m_localStorage = m_cachingLocalStorage;
+            }
         }
         // register the local storage interface
         ThrowIfNot(registerServiceInterface<LocalStorageInterface>(m_localStorage), "registerServiceInterfaceFailed");
@@ -62,6 +97,48 @@ bool StorageEngineService::configure(std::shared_ptr<std::istream> configuration
     }
 }
 
+bool StorageEngineService::start() {
+    if (m_maintenance != nullptr) {
+        m_audioManager = getContext()->getServiceInterface<aace::engine::audio::AudioManagerInterface>("aace.audio");
+        m_maintenance->start();
+    }
+    return true;
+}
+
+bool StorageEngineService::stop() {
+    if (m_maintenance != nullptr) {
+        m_maintenance->stop();
+    }
+    return true;
+}
+
+bool StorageEngineService::suspend() {
+    return stop();
+}
+
+bool StorageEngineService::resume() {
+    return start();
+}
+
+bool StorageEngineService::isActive() {
+    // a playback, such as the speech of a dialog or media, defers the maintenance
+    auto audioManager = m_audioManager.lock();
+    return audioManager != nullptr && audioManager->isAudioOutputPlaying();
+}
+
+bool StorageEngineService::shutdown() {
+    if (m_maintenance != nullptr) {
+        m_maintenance->shutdown();
+        m_maintenance.reset();
+    }
+
+    // the engine components don't write to the storage anymore
+    if (m_cachingLocalStorage != nullptr && !m_cachingLocalStorage->flush()) {
+        AACE_ERROR(LX(TAG, "shutdown").d("reason", "flushFailed"));
+    }
+    return true;
+}
+
 }  // namespace storage
 }  // namespace engine
 }  // namespace aace
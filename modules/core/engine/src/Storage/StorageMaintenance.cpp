@@ -0,0 +1,153 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AACE/Engine/Storage/StorageMaintenance.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/Metrics/Metrics.h"
+
+namespace aace {
+namespace engine {
+namespace storage {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.storage.StorageMaintenance");
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "StorageMaintenance";
+
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+std::shared_ptr<StorageMaintenance> StorageMaintenance::create(
+    std::shared_ptr<SQLiteStorage> storage,
+    const Config& config,
+    ActivityCheck activityCheck) {
+    try {
+        ThrowIfNull(storage, "invalidStorage");
+        ThrowIf(config.interval.count() <= 0, "invalidInterval");
+        ThrowIf(config.idleDelay.count() <= 0, "invalidIdleDelay");
+        ThrowIf(config.budget.count() <= 0, "invalidBudget");
+
+        return std::shared_ptr<StorageMaintenance>(new StorageMaintenance(storage, config, activityCheck));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+StorageMaintenance::StorageMaintenance(
+    std::shared_ptr<SQLiteStorage> storage,
+    const Config& config,
+    ActivityCheck activityCheck) :
+        m_storage(storage),
+        m_config(config),
+        m_activityCheck(activityCheck),
+        m_executor("Storage.maintenance") {
+}
+
+StorageMaintenance::~StorageMaintenance() {
+    shutdown();
+}
+
+void StorageMaintenance::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_started || m_shutdown) {
+        return;
+    }
+    m_started = true;
+    scheduleLocked(m_config.interval, true);
+}
+
+void StorageMaintenance::stop() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_started = false;
+    if (m_timer != TimerWheel::INVALID_TIMER) {
+        TimerWheel::getDefault()->cancel(m_timer);
+        m_timer = TimerWheel::INVALID_TIMER;
+    }
+}
+
+void StorageMaintenance::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    stop();
+    m_executor.shutdown();
+}
+
+void StorageMaintenance::scheduleLocked(std::chrono::milliseconds delay, bool intervalElapsed) {
+    // the maintenance runs on the executor, the timer thread must not block
+    std::weak_ptr<StorageMaintenance> wp = shared_from_this();
+    m_timer = TimerWheel::getDefault()->submitAfter(delay, [wp, intervalElapsed]() {
+        if (auto maintenance = wp.lock()) {
+            auto raw = maintenance.get();
+            maintenance->m_executor.post([raw, intervalElapsed]() { raw->check(intervalElapsed); });
+        }
+    });
+}
+
+void StorageMaintenance::check(bool intervalElapsed) {
+    auto changeCount = m_storage->getChangeCount();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_timer = TimerWheel::INVALID_TIMER;
+        if (!m_started || m_shutdown) {
+            return;
+        }
+
+        // the engine must stay idle for the idle delay after the interval has elapsed
+        auto active = !intervalElapsed && m_activityCheck && m_activityCheck();
+        if (intervalElapsed || active || changeCount != m_changeCount) {
+            m_changeCount = changeCount;
+            scheduleLocked(m_config.idleDelay, false);
+            return;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    SQLiteStorage::MaintenanceReport report;
+    if (m_storage->runMaintenance(m_config.budget, report)) {
+        emitMetrics(
+            report, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start));
+    }
+
+    changeCount = m_storage->getChangeCount();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_changeCount = changeCount;
+    if (m_started && !m_shutdown) {
+        scheduleLocked(m_config.interval, true);
+    }
+}
+
+void StorageMaintenance::emitMetrics(
+    const SQLiteStorage::MaintenanceReport& report,
+    std::chrono::milliseconds duration) {
+    // the fragmentation is the share of the database file made of free pages
+    auto sizeKB = report.pageCount * report.pageSize / 1024;
+    auto freePagesPercent = report.pageCount > 0 ? report.freePageCount * 100 / report.pageCount : 0;
+    aace::engine::utils::metrics::emitMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX,
+        "runMaintenance",
+        {{"DatabaseSizeKB", static_cast<int>(sizeKB)},
+         {"FreePagesPercent", static_cast<int>(freePagesPercent)},
+         {"VacuumedKB", static_cast<int>(report.vacuumedPageCount * report.pageSize / 1024)},
+         {"BudgetExceeded", report.budgetExceeded ? 1 : 0}},
+        {},
+        {{"Duration", static_cast<double>(duration.count())}});
+}
+
+}  // namespace storage
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/Threading/ThreadingEngineService.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/JSON/JSON.h>
+#include <AACE/Engine/Utils/Memory/MemoryAccounting.h>
+#include <AACE/Engine/Utils/Threading/ExecutorStats.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+
+namespace aace {
+namespace engine {
+namespace threading {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.threading.ThreadingEngineService");
+
+// register the service
+REGISTER_SERVICE(ThreadingEngineService);
+
+using ExecutorStats = aace::engine::utils::threading::ExecutorStats;
+using MemoryAccounting = aace::engine::utils::memory::MemoryAccounting;
+using ThreadPolicy = aace::engine::utils::threading::ThreadPolicy;
+namespace json = aace::engine::utils::json;
+
+ThreadingEngineService::ThreadingEngineService(const aace::engine::core::ServiceDescription& description) :
+        aace::engine::core::EngineService(description) {
+}
+
+bool ThreadingEngineService::configureFromJson(const json::Value& root) {
+    try {
+
+        // report the tasks of the named executors that run longer than the threshold
+        auto slowTaskThreshold = json::get(root, "/slowTaskThreshold", (uint64_t)0);
+        ExecutorStats::setSlowTaskThreshold(std::chrono::milliseconds(slowTaskThreshold));
+
+        // report the heap memory of the modules, in builds with memory accounting
+        auto memoryReportInterval = json::get(root, "/memoryReportInterval", (uint64_t)0);
+        if (memoryReportInterval > 0 && !MemoryAccounting::isEnabled()) {
+            AACE_WARN(LX(TAG).m("memoryReportIntervalIgnored").d("reason", "memoryAccountingNotEnabled"));
+        }
+        MemoryAccounting::setReportInterval(std::chrono::seconds(memoryReportInterval));
+
+        // assign the named threads to cpus and scheduling classes
+        auto threadConfigList = json::get(root, "/threads", json::Type::array);
+        if (threadConfigList != nullptr) {
+            for (std::size_t j = 0; j < threadConfigList.size(); j++) {
+                ThrowIfNot(configureThread(threadConfigList[j]), "configureThreadFailed");
+            }
+        }
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "configureFromJson").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool ThreadingEngineService::configureThread(const json::Value& config) {
+    try {
+        auto name = json::get(config, "/name", "");
+        ThrowIf(name.empty(), "invalidThreadName");
+
+        ThreadPolicy::Policy policy;
+        auto cpus = json::get(config, "/cpus", json::Type::array);
+        if (cpus != nullptr) {
+            for (std::size_t j = 0; j < cpus.size(); j++) {
+                ThrowIfNot(cpus[j].is_number_unsigned(), "invalidCpu");
+                policy.cpus.push_back(cpus[j].get<int>());
+            }
+        }
+
+        auto scheduling = json::get(config, "/scheduling", "default");
+        ThrowIfNot(ThreadPolicy::parseScheduling(scheduling, policy.scheduling), "invalidScheduling");
+        policy.priority = static_cast<int>(json::get(config, "/priority", (int64_t)0));
+        if (policy.scheduling == ThreadPolicy::Scheduling::FIFO || policy.scheduling == ThreadPolicy::Scheduling::RR) {
+            ThrowIf(policy.priority < 1 || policy.priority > 99, "invalidPriority");
+        }
+
+        if (json::has(config, "/nice")) {
+            policy.hasNice = true;
+            policy.nice = static_cast<int>(json::get(config, "/nice", (int64_t)0));
+            ThrowIf(policy.nice < -20 || policy.nice > 19, "invalidNice");
+        }
+
+        ThreadPolicy::setPolicy(name, policy);
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool ThreadingEngineService::shutdown() {
+    ExecutorStats::setSlowTaskThreshold(std::chrono::milliseconds::zero());
+    MemoryAccounting::setReportInterval(std::chrono::seconds::zero());
+    ThreadPolicy::clearPolicies();
+    return true;
+}
+
+}  // namespace threading
+}  // namespace engine
+}  // namespace aace
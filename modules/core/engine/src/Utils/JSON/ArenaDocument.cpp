@@ -0,0 +1,73 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/Utils/JSON/ArenaDocument.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace json {
+
+/// Size of the block each thread keeps for its documents, which holds the payloads of nearly all directives.
+static const size_t ARENA_BLOCK_SIZE = 32 * 1024;
+
+struct ArenaDocument::Arena {
+    Arena() :
+            // the block is allocated as 64 bit words, since the allocator keeps its chunk header at its start
+            block(new uint64_t[ARENA_BLOCK_SIZE / sizeof(uint64_t)]),
+            allocator(block.get(), ARENA_BLOCK_SIZE),
+            inUse(false) {
+    }
+
+    std::unique_ptr<uint64_t[]> block;
+    rapidjson::MemoryPoolAllocator<> allocator;
+    bool inUse;
+};
+
+size_t ArenaDocument::getBlockSize() {
+    return ARENA_BLOCK_SIZE;
+}
+
+ArenaDocument::ArenaDocument() : m_document(m_lease.allocator()) {
+}
+
+ArenaDocument::Lease::Lease() : m_arena(nullptr) {
+    // the arena is created on the first document of the thread
+    static thread_local Arena s_arena;
+    if (!s_arena.inUse) {
+        s_arena.inUse = true;
+        m_arena = &s_arena;
+    }
+}
+
+ArenaDocument::Lease::~Lease() {
+    if (m_arena != nullptr) {
+        // frees the chunks added for larger payloads, and makes the whole block available again
+        m_arena->allocator.Clear();
+        m_arena->inUse = false;
+    }
+}
+
+rapidjson::MemoryPoolAllocator<>* ArenaDocument::Lease::allocator() const {
+    return m_arena != nullptr ? &m_arena->allocator : nullptr;
+}
+
+}  // namespace json
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
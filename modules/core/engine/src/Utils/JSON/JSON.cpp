@@ -17,8 +17,7 @@
 #include <AACE/Engine/Core/EngineMacros.h>
 
 #include <sstream>
-
-#define JSON_POINTER(p) nlohmann::json::json_pointer(p.empty() == false && p[0] != '/' ? "/" + p : p)
+#include <unordered_map>
 
 // rapidjson (deprecated)
 #include <rapidjson/error/en.h>
@@ -36,8 +35,66 @@ namespace json {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.engine.utils.json.JSON");
 
+/// Largest number of paths whose pointers are cached by each thread.
+static const size_t MAX_CACHED_POINTERS = 256;
+
+/**
+ * Returns the pointer of a path from the cache of the calling thread, parsing it on its first use. The reference is
+ * valid until the next call, since a full cache is cleared.
+ */
+static const Pointer& getCachedPointer(const std::string& path) {
+    static thread_local std::unordered_map<std::string, Pointer> s_pointers;
+    auto it = s_pointers.find(path);
+    if (it != s_pointers.end()) {
+        return it->second;
+    }
+    if (s_pointers.size() >= MAX_CACHED_POINTERS) {
+        s_pointers.clear();
+    }
+    return s_pointers.emplace(path, pointer(path)).first->second;
+}
+
+/**
+ * Returns the value at a pointer if it matches a type check, or @c defaultValue otherwise. The value is read in
+ * place, without copying it.
+ */
+template <typename T, typename IsValid>
+static T getValue(const Value& root, const Pointer& ptr, const T& defaultValue, IsValid isValid) {
+    try {
+        if (root.contains(ptr)) {
+            const auto& value = root.at(ptr);
+            if (isValid(value) == false) {
+                AACE_WARN(LX(TAG).d("reason", "invalidValueType"));
+                return defaultValue;
+            }
+            return value.get<T>();
+        } else {
+            return defaultValue;
+        }
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return defaultValue;
+    }
+}
+
+/// Sets the value at a pointer, creating its parents if they are missing.
+template <typename T>
+static bool setValue(Value& root, const Pointer& ptr, T&& value) {
+    try {
+        root[ptr] = std::forward<T>(value);
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
 // nlohmann
 
+Pointer pointer(const std::string& path) {
+    return Pointer(path.empty() == false && path[0] != '/' ? "/" + path : path);
+}
+
 Value toJson(const std::string& str) {
     try {
         return nlohmann::json::parse(str);
@@ -76,11 +133,12 @@ std::shared_ptr<std::stringstream> toStream(const Value& root, bool prettyPrint)
 bool merge(Value& into, const Value& from) {
     try {
         for (auto& next : from.items()) {
-            auto key = next.key();
+            const auto& key = next.key();
+            auto intoNode = into.find(key);
 
-            if (into.find(key) != into.end()) {
-                ThrowIfNot(next.value().is_object() && into[key].is_object(), "configurationAlreadySpecified:" + key);
-                ThrowIfNot(merge(into[key], next.value()), "mergeChildNodeFailed");
+            if (intoNode != into.end()) {
+                ThrowIfNot(next.value().is_object() && intoNode->is_object(), "configurationAlreadySpecified:" + key);
+                ThrowIfNot(merge(*intoNode, next.value()), "mergeChildNodeFailed");
             } else {
                 into[key] = next.value();
             }
@@ -93,9 +151,39 @@ bool merge(Value& into, const Value& from) {
     }
 }
 
+bool merge(Value& into, Value&& from) {
+    try {
+        // the values not already in the other tree are moved into it, rather than copied
+        for (auto& next : from.items()) {
+            const auto& key = next.key();
+            auto intoNode = into.find(key);
+
+            if (intoNode != into.end()) {
+                ThrowIfNot(next.value().is_object() && intoNode->is_object(), "configurationAlreadySpecified:" + key);
+                ThrowIfNot(merge(*intoNode, std::move(next.value())), "mergeChildNodeFailed");
+            } else {
+                into[key] = std::move(next.value());
+            }
+        }
+
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool has(const Value& root, const std::string& path, Type type) {
+    return has(root, getCachedPointer(path), type);
+}
+
+bool has(const Value& root, const Pointer& ptr, Type type) {
     try {
-        return get(root, path, type) != nullptr;
+        if (root.contains(ptr) == false) {
+            return false;
+        }
+        const auto& value = root.at(ptr);
+        return value.is_null() == false && (type == Type::null || value.type() == type);
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return false;
@@ -107,10 +195,13 @@ bool isType(const Value& value, Type type) {
 }
 
 Value get(const Value& root, const std::string& path, Type type) {
+    return get(root, getCachedPointer(path), type);
+}
+
+Value get(const Value& root, const Pointer& ptr, Type type) {
     try {
-        auto ptr = JSON_POINTER(path);
         if (root.contains(ptr)) {
-            auto value = root.at(ptr);
+            const auto& value = root.at(ptr);
             ThrowIf(type != Type::null && value.type() != type, "invalidType");
             return value;
         } else {
@@ -123,19 +214,17 @@ Value get(const Value& root, const std::string& path, Type type) {
 }
 
 bool set(Value& root, const std::string& path, Value value) {
-    try {
-        root[JSON_POINTER(path)] = value;
-        return true;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return false;
-    }
+    return set(root, getCachedPointer(path), std::move(value));
+}
+
+bool set(Value& root, const Pointer& ptr, Value value) {
+    return setValue(root, ptr, std::move(value));
 }
 
 bool push(Value& arr, Value value) {
     try {
         ThrowIfNot(isType(arr, Type::array), "invalidArrayType");
-        arr.push_back(value);
+        arr.push_back(std::move(value));
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -144,162 +233,99 @@ bool push(Value& arr, Value value) {
 }
 
 std::string get(const Value& root, const std::string& path, const std::string& defaultValue) {
-    try {
-        auto ptr = JSON_POINTER(path);
-        if (root.contains(ptr)) {
-            auto value = root.at(ptr);
-            if (value.is_string() == false) {
-                AACE_WARN(LX(TAG).d("reason", "invalidValueType"));
-                return defaultValue;
-            }
-            return value;
-        } else {
-            return defaultValue;
-        }
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return defaultValue;
-    }
+    return get(root, getCachedPointer(path), defaultValue);
+}
+
+std::string get(const Value& root, const Pointer& ptr, const std::string& defaultValue) {
+    return getValue(root, ptr, defaultValue, [](const Value& value) { return value.is_string(); });
 }
 
 bool set(Value& root, const std::string& path, const std::string& value) {
-    try {
-        root[JSON_POINTER(path)] = value;
-        return true;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return false;
-    }
+    return set(root, getCachedPointer(path), value);
+}
+
+bool set(Value& root, const Pointer& ptr, const std::string& value) {
+    return setValue(root, ptr, value);
 }
 
 std::string get(const Value& root, const std::string& path, const char* defaultValue) {
     return get(root, path, std::string(defaultValue != nullptr ? defaultValue : ""));
 }
 
+std::string get(const Value& root, const Pointer& ptr, const char* defaultValue) {
+    return get(root, ptr, std::string(defaultValue != nullptr ? defaultValue : ""));
+}
+
 bool set(Value& root, const std::string& path, const char* value) {
-    try {
-        root[JSON_POINTER(path)] = value;
-        return true;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return false;
-    }
+    return set(root, getCachedPointer(path), value);
+}
+
+bool set(Value& root, const Pointer& ptr, const char* value) {
+    return setValue(root, ptr, value);
 }
 
 bool get(const Value& root, const std::string& path, bool defaultValue) {
-    try {
-        auto ptr = JSON_POINTER(path);
-        if (root.contains(ptr)) {
-            auto value = root.at(ptr);
-            if (value.is_boolean() == false) {
-                AACE_WARN(LX(TAG).d("reason", "invalidValueType"));
-                return defaultValue;
-            }
-            return value;
-        } else {
-            return defaultValue;
-        }
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return defaultValue;
-    }
+    return get(root, getCachedPointer(path), defaultValue);
+}
+
+bool get(const Value& root, const Pointer& ptr, bool defaultValue) {
+    return getValue(root, ptr, defaultValue, [](const Value& value) { return value.is_boolean(); });
 }
 
 bool set(Value& root, const std::string& path, bool value) {
-    try {
-        root[JSON_POINTER(path)] = value;
-        return true;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return false;
-    }
+    return set(root, getCachedPointer(path), value);
+}
+
+bool set(Value& root, const Pointer& ptr, bool value) {
+    return setValue(root, ptr, value);
 }
 
 uint64_t get(const Value& root, const std::string& path, uint64_t defaultValue) {
-    try {
-        auto ptr = JSON_POINTER(path);
-        if (root.contains(ptr)) {
-            auto value = root.at(ptr);
-            if (value.is_number_unsigned() == false) {
-                AACE_WARN(LX(TAG).d("reason", "invalidValueType"));
-                return defaultValue;
-            }
-            return value;
-        } else {
-            return defaultValue;
-        }
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return defaultValue;
-    }
+    return get(root, getCachedPointer(path), defaultValue);
+}
+
+uint64_t get(const Value& root, const Pointer& ptr, uint64_t defaultValue) {
+    return getValue(root, ptr, defaultValue, [](const Value& value) { return value.is_number_unsigned(); });
 }
 
 bool set(Value& root, const std::string& path, uint64_t value) {
-    try {
-        root[JSON_POINTER(path)] = value;
-        return true;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return false;
-    }
+    return set(root, getCachedPointer(path), value);
+}
+
+bool set(Value& root, const Pointer& ptr, uint64_t value) {
+    return setValue(root, ptr, value);
 }
 
 int64_t get(const Value& root, const std::string& path, int64_t defaultValue) {
-    try {
-        auto ptr = JSON_POINTER(path);
-        if (root.contains(ptr)) {
-            auto value = root.at(ptr);
-            if (value.is_number_integer() == false) {
-                AACE_WARN(LX(TAG).d("reason", "invalidValueType"));
-                return defaultValue;
-            }
-            return value;
-        } else {
-            return defaultValue;
-        }
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return defaultValue;
-    }
+    return get(root, getCachedPointer(path), defaultValue);
+}
+
+int64_t get(const Value& root, const Pointer& ptr, int64_t defaultValue) {
+    return getValue(root, ptr, defaultValue, [](const Value& value) { return value.is_number_integer(); });
 }
 
 bool set(Value& root, const std::string& path, int64_t value) {
-    try {
-        root[JSON_POINTER(path)] = value;
-        return true;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return false;
-    }
+    return set(root, getCachedPointer(path), value);
+}
+
+bool set(Value& root, const Pointer& ptr, int64_t value) {
+    return setValue(root, ptr, value);
 }
 
 double get(const Value& root, const std::string& path, double defaultValue) {
-    try {
-        auto ptr = JSON_POINTER(path);
-        if (root.contains(ptr)) {
-            auto value = root.at(ptr);
-            if (value.is_number_float() == false) {
-                AACE_WARN(LX(TAG).d("reason", "invalidValueType"));
-                return defaultValue;
-            }
-            return value;
-        } else {
-            return defaultValue;
-        }
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return defaultValue;
-    }
+    return get(root, getCachedPointer(path), defaultValue);
+}
+
+double get(const Value& root, const Pointer& ptr, double defaultValue) {
+    return getValue(root, ptr, defaultValue, [](const Value& value) { return value.is_number_float(); });
 }
 
 bool set(Value& root, const std::string& path, double value) {
-    try {
-        root[JSON_POINTER(path)] = value;
-        return true;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return false;
-    }
+    return set(root, getCachedPointer(path), value);
+}
+
+bool set(Value& root, const Pointer& ptr, double value) {
+    return setValue(root, ptr, value);
 }
 
 // rapidjson (deprecated)
@@ -0,0 +1,348 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "AACE/Engine/Utils/JSON/OnDemandReader.h"
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace json {
+
+const size_t OnDemandReader::MAX_DEPTH;
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static bool isNumberCharacter(char c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+static void appendUtf8(std::string& value, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        value.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        value.push_back(static_cast<char>(0xc0 | (codePoint >> 6)));
+        value.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    } else if (codePoint < 0x10000) {
+        value.push_back(static_cast<char>(0xe0 | (codePoint >> 12)));
+        value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+        value.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    } else {
+        value.push_back(static_cast<char>(0xf0 | (codePoint >> 18)));
+        value.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f)));
+        value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+        value.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    }
+}
+
+OnDemandReader::OnDemandReader(const char* data, size_t size) : m_begin(data), m_pos(data), m_end(data + size) {
+}
+
+OnDemandReader::OnDemandReader(const char* text) : OnDemandReader(text, std::strlen(text)) {
+}
+
+OnDemandReader::OnDemandReader(const std::string& text) : OnDemandReader(text.data(), text.size()) {
+}
+
+char OnDemandReader::peek() {
+    while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t')) {
+        m_pos++;
+    }
+    return m_pos < m_end ? *m_pos : 0;
+}
+
+bool OnDemandReader::fail(const char* reason) {
+    if (m_error.empty()) {
+        m_error = std::string(reason) + " at offset " + std::to_string(offset());
+    }
+    return false;
+}
+
+bool OnDemandReader::enterObject() {
+    if (failed() || peek() != '{') {
+        return false;
+    }
+    if (m_depth == MAX_DEPTH) {
+        return fail("maxDepthExceeded");
+    }
+    m_pos++;
+    m_first |= uint64_t(1) << m_depth;
+    m_depth++;
+    m_pendingValue = false;
+    return true;
+}
+
+bool OnDemandReader::nextField(std::string& key) {
+    if (failed() || m_depth == 0) {
+        return false;
+    }
+
+    // skip the value of the previous field if the caller didn't read it
+    if (m_pendingValue && !skipValue()) {
+        return false;
+    }
+
+    auto c = peek();
+    if (c == '}') {
+        m_pos++;
+        m_depth--;
+        return false;
+    }
+    auto first = uint64_t(1) << (m_depth - 1);
+    if ((m_first & first) == 0) {
+        if (c != ',') {
+            return fail("expectedCommaOrEndOfObject");
+        }
+        m_pos++;
+        c = peek();
+    }
+    m_first &= ~first;
+
+    if (c != '"') {
+        return fail("expectedKey");
+    }
+    if (!decodeString(key)) {
+        return false;
+    }
+    if (peek() != ':') {
+        return fail("expectedColon");
+    }
+    m_pos++;
+    m_pendingValue = true;
+    return true;
+}
+
+bool OnDemandReader::readString(std::string& value) {
+    if (failed() || peek() != '"') {
+        return false;
+    }
+    m_pendingValue = false;
+    return decodeString(value);
+}
+
+bool OnDemandReader::skipValue() {
+    if (failed()) {
+        return false;
+    }
+    m_pendingValue = false;
+
+    auto c = peek();
+    switch (c) {
+        case '"':
+            return skipString();
+        case '{':
+        case '[':
+            return skipContainer();
+        case 't':
+        case 'f':
+        case 'n':
+            return skipLiteral();
+        case 0:
+            return fail("unexpectedEnd");
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                while (m_pos < m_end && isNumberCharacter(*m_pos)) {
+                    m_pos++;
+                }
+                return true;
+            }
+            return fail("unexpectedCharacter");
+    }
+}
+
+bool OnDemandReader::skipString() {
+    // the cursor is at the opening quote
+    for (m_pos++; m_pos < m_end; m_pos++) {
+        if (*m_pos == '\\') {
+            if (m_end - m_pos < 2) {
+                break;
+            }
+            m_pos++;
+        } else if (*m_pos == '"') {
+            m_pos++;
+            return true;
+        }
+    }
+    return fail("unterminatedString");
+}
+
+bool OnDemandReader::skipContainer() {
+    // the closing brackets of the nested containers, the innermost last, which only allocates for deep values
+    char inlineClosing[MAX_DEPTH];
+    std::string overflow;
+    size_t depth = 0;
+    auto push = [&](char c) {
+        if (depth < MAX_DEPTH) {
+            inlineClosing[depth] = c;
+        } else {
+            overflow.push_back(c);
+        }
+        depth++;
+    };
+
+    while (m_pos < m_end) {
+        auto c = *m_pos;
+        if (c == '"') {
+            if (!skipString()) {
+                return false;
+            }
+            continue;
+        }
+        if (c == '{') {
+            push('}');
+        } else if (c == '[') {
+            push(']');
+        } else if (c == '}' || c == ']') {
+            if (depth == 0 || (depth <= MAX_DEPTH ? inlineClosing[depth - 1] : overflow.back()) != c) {
+                return fail("unbalancedBrackets");
+            }
+            if (--depth >= MAX_DEPTH) {
+                overflow.pop_back();
+            }
+            if (depth == 0) {
+                m_pos++;
+                return true;
+            }
+        }
+        m_pos++;
+    }
+    return fail("unexpectedEnd");
+}
+
+bool OnDemandReader::skipLiteral() {
+    for (auto literal : {"true", "false", "null"}) {
+        auto size = std::strlen(literal);
+        if (static_cast<size_t>(m_end - m_pos) >= size && std::memcmp(m_pos, literal, size) == 0) {
+            m_pos += size;
+            return true;
+        }
+    }
+    return fail("invalidLiteral");
+}
+
+bool OnDemandReader::decodeString(std::string& value) {
+    value.clear();
+
+    // the cursor is at the opening quote, copy the runs of characters between the escapes
+    m_pos++;
+    while (m_pos < m_end) {
+        auto run = m_pos;
+        while (m_pos < m_end && *m_pos != '"' && *m_pos != '\\') {
+            m_pos++;
+        }
+        value.append(run, m_pos - run);
+        if (m_pos == m_end) {
+            break;
+        }
+        if (*m_pos == '"') {
+            m_pos++;
+            return true;
+        }
+        if (!decodeEscape(value)) {
+            return false;
+        }
+    }
+    return fail("unterminatedString");
+}
+
+bool OnDemandReader::decodeEscape(std::string& value) {
+    // the cursor is at the backslash
+    if (m_end - m_pos < 2) {
+        return fail("unterminatedString");
+    }
+    auto c = m_pos[1];
+    m_pos += 2;
+    switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+            value.push_back(c);
+            return true;
+        case 'b':
+            value.push_back('\b');
+            return true;
+        case 'f':
+            value.push_back('\f');
+            return true;
+        case 'n':
+            value.push_back('\n');
+            return true;
+        case 'r':
+            value.push_back('\r');
+            return true;
+        case 't':
+            value.push_back('\t');
+            return true;
+        case 'u':
+            break;
+        default:
+            return fail("invalidEscape");
+    }
+
+    auto readHex = [this](uint32_t& codeUnit) {
+        if (m_end - m_pos < 4) {
+            return false;
+        }
+        codeUnit = 0;
+        for (int j = 0; j < 4; j++) {
+            auto digit = hexValue(m_pos[j]);
+            if (digit < 0) {
+                return false;
+            }
+            codeUnit = (codeUnit << 4) | static_cast<uint32_t>(digit);
+        }
+        m_pos += 4;
+        return true;
+    };
+
+    uint32_t codePoint;
+    if (!readHex(codePoint)) {
+        return fail("invalidUnicodeEscape");
+    }
+
+    // a surrogate pair is escaped as two code units
+    if (codePoint >= 0xd800 && codePoint <= 0xdbff) {
+        uint32_t low;
+        if (m_end - m_pos < 2 || m_pos[0] != '\\' || m_pos[1] != 'u') {
+            return fail("invalidSurrogatePair");
+        }
+        m_pos += 2;
+        if (!readHex(low) || low < 0xdc00 || low > 0xdfff) {
+            return fail("invalidSurrogatePair");
+        }
+        codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+    } else if (codePoint >= 0xdc00 && codePoint <= 0xdfff) {
+        return fail("invalidSurrogatePair");
+    }
+
+    appendUtf8(value, codePoint);
+    return true;
+}
+
+}  // namespace json
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Memory/MappedAssetRegistry.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace memory {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.utils.memory.MappedAssetRegistry");
+
+namespace {
+
+/// Identifies a version of a file, a replaced file has a new inode or modification time
+using FileKey = std::tuple<dev_t, ino_t, off_t, time_t>;
+
+struct RegistryState {
+    std::mutex mutex;
+    std::map<FileKey, std::weak_ptr<const MappedAsset>> assets;
+};
+
+RegistryState& getState() {
+    static RegistryState s_state;
+    return s_state;
+}
+
+FileKey getFileKey(const struct stat& status) {
+    return FileKey(status.st_dev, status.st_ino, status.st_size, status.st_mtime);
+}
+
+}  // namespace
+
+MappedAsset::MappedAsset(const std::string& path, void* address, size_t size) :
+        m_path(path), m_address(address), m_size(size) {
+}
+
+MappedAsset::~MappedAsset() {
+    if (m_address != nullptr) {
+        ::munmap(m_address, m_size);
+    }
+}
+
+const uint8_t* MappedAsset::data() const {
+    return static_cast<const uint8_t*>(m_address);
+}
+
+size_t MappedAsset::size() const {
+    return m_size;
+}
+
+const std::string& MappedAsset::getPath() const {
+    return m_path;
+}
+
+void MappedAsset::willNeed() const {
+    if (m_address != nullptr && ::madvise(m_address, m_size, MADV_WILLNEED) != 0) {
+        AACE_WARN(LX(TAG).d("reason", strerror(errno)).d("path", m_path));
+    }
+}
+
+std::shared_ptr<const MappedAsset> MappedAssetRegistry::open(const std::string& path) {
+    int fd = -1;
+    try {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        ThrowIf(fd < 0, strerror(errno));
+        struct stat status;
+        ThrowIf(::fstat(fd, &status) != 0, strerror(errno));
+        ThrowIfNot(S_ISREG(status.st_mode), "notRegularFile");
+        auto key = getFileKey(status);
+
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto it = state.assets.find(key);
+        if (it != state.assets.end()) {
+            if (auto asset = it->second.lock()) {
+                ::close(fd);
+                AACE_DEBUG(LX(TAG).m("shared").d("path", path));
+                return asset;
+            }
+        }
+
+        auto size = static_cast<size_t>(status.st_size);
+        void* address = nullptr;
+        if (size > 0) {
+            address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ThrowIf(address == MAP_FAILED, strerror(errno));
+        }
+        // the mapping keeps its own reference to the file
+        ::close(fd);
+        fd = -1;
+
+        std::shared_ptr<const MappedAsset> asset(new MappedAsset(path, address, size));
+        state.assets[key] = asset;
+        // the views released since the last open are dropped
+        for (auto next = state.assets.begin(); next != state.assets.end();) {
+            next = next->second.expired() ? state.assets.erase(next) : std::next(next);
+        }
+        AACE_INFO(LX(TAG).m("mapped").d("path", path).d("size", size));
+        return asset;
+    } catch (std::exception& ex) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("path", path));
+        return nullptr;
+    }
+}
+
+MappedAssetRegistry::Stats MappedAssetRegistry::getStats() {
+    Stats stats;
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (auto& entry : state.assets) {
+        if (auto asset = entry.second.lock()) {
+            stats.assets++;
+            stats.mappedBytes += asset->size();
+        }
+    }
+    return stats;
+}
+
+}  // namespace memory
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
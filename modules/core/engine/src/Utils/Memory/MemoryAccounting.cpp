@@ -0,0 +1,344 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include <AACE/Engine/Utils/Memory/MemoryAccounting.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace memory {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.utils.memory.MemoryAccounting");
+
+/// Program name suffix of the memory report metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "MemoryAccounting";
+
+/// The longest module name, without the terminating null character
+static const size_t MAX_NAME_LENGTH = 47;
+
+const uint32_t MemoryAccounting::UNTAGGED;
+const size_t MemoryAccounting::MAX_MODULES;
+
+using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+namespace {
+
+/// The counters of a module, updated by each allocation without a lock
+struct Counters {
+    std::atomic<int64_t> liveBytes;
+    std::atomic<int64_t> peakBytes;
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> deallocations;
+    std::atomic<uint64_t> allocatedBytes;
+};
+
+}  // namespace
+
+// the counters and the names have static storage without constructors, so they are usable by the allocations made
+// before main() and during static destruction
+static Counters s_counters[MemoryAccounting::MAX_MODULES];
+static char s_names[MemoryAccounting::MAX_MODULES][MAX_NAME_LENGTH + 1] = {"untagged"};
+static std::atomic<uint32_t> s_moduleCount{1};
+static std::mutex s_registerMutex;
+
+/// The current module and the module of the thread, of trivial types so their access doesn't allocate
+static thread_local uint32_t s_currentModule = MemoryAccounting::UNTAGGED;
+static thread_local uint32_t s_threadModule = MemoryAccounting::UNTAGGED;
+
+namespace {
+
+/// The report timer, and the snapshots of the last report to compute the allocation rates
+struct Report {
+    std::mutex mutex;
+    std::chrono::seconds interval{0};
+    TimerWheel::TimerId timer = TimerWheel::INVALID_TIMER;
+    std::vector<MemoryAccounting::Snapshot> previous;
+};
+
+}  // namespace
+
+static Report& report() {
+    // never destroyed, like the registry of the executor statistics
+    static Report* s_report = new Report();
+    return *s_report;
+}
+
+static uint32_t registerModule(const char* name, size_t length) {
+    if (length == 0) {
+        return MemoryAccounting::UNTAGGED;
+    }
+    length = std::min(length, MAX_NAME_LENGTH);
+
+    std::lock_guard<std::mutex> lock(s_registerMutex);
+    auto count = s_moduleCount.load();
+    for (uint32_t j = 0; j < count; j++) {
+        if (std::strlen(s_names[j]) == length && std::strncmp(s_names[j], name, length) == 0) {
+            return j;
+        }
+    }
+    if (count >= MemoryAccounting::MAX_MODULES) {
+        return MemoryAccounting::UNTAGGED;
+    }
+
+    std::memcpy(s_names[count], name, length);
+    s_names[count][length] = '\0';
+    // publish the name before the snapshots can see the module
+    s_moduleCount.store(count + 1);
+    return count;
+}
+
+MemoryAccounting::Scope::Scope(const std::string& module) : m_previous{s_currentModule} {
+    s_currentModule = registerModule(module);
+}
+
+MemoryAccounting::Scope::~Scope() {
+    s_currentModule = m_previous;
+}
+
+bool MemoryAccounting::isEnabled() {
+#if defined(AAC_MEMORY_ACCOUNTING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint32_t MemoryAccounting::registerModule(const std::string& module) {
+    return memory::registerModule(module.c_str(), module.size());
+}
+
+uint32_t MemoryAccounting::registerNamedModule(const std::string& name) {
+    return memory::registerModule(name.c_str(), std::min(name.find('.'), name.size()));
+}
+
+uint32_t MemoryAccounting::getCurrentModule() {
+    return s_currentModule;
+}
+
+void MemoryAccounting::setCurrentModule(uint32_t module) {
+    s_currentModule = module < s_moduleCount.load() ? module : UNTAGGED;
+}
+
+void MemoryAccounting::setThreadModule(const std::string& name) {
+    s_threadModule = s_currentModule = registerNamedModule(name);
+}
+
+uint32_t MemoryAccounting::getThreadModule() {
+    return s_threadModule;
+}
+
+void MemoryAccounting::recordAllocation(uint32_t module, size_t size) {
+    auto& counters = s_counters[module < MAX_MODULES ? module : UNTAGGED];
+    auto bytes = static_cast<int64_t>(size);
+    auto live = counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    auto peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::recordDeallocation(uint32_t module, size_t size) {
+    auto& counters = s_counters[module < MAX_MODULES ? module : UNTAGGED];
+    counters.liveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+    counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<MemoryAccounting::Snapshot> MemoryAccounting::getSnapshots() {
+    auto count = s_moduleCount.load();
+    std::vector<Snapshot> snapshots(count);
+    auto now = Clock::now();
+    for (uint32_t j = 0; j < count; j++) {
+        auto& counters = s_counters[j];
+        auto& snapshot = snapshots[j];
+        snapshot.module = s_names[j];
+        snapshot.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        snapshot.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        snapshot.allocations = counters.allocations.load(std::memory_order_relaxed);
+        snapshot.deallocations = counters.deallocations.load(std::memory_order_relaxed);
+        snapshot.allocatedBytes = counters.allocatedBytes.load(std::memory_order_relaxed);
+        snapshot.time = now;
+    }
+
+    return snapshots;
+}
+
+double MemoryAccounting::getAllocationRate(const Snapshot& previous, const Snapshot& current) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(current.time - previous.time).count();
+    if (elapsed <= 0 || current.allocations < previous.allocations) {
+        return 0;
+    }
+    return (current.allocations - previous.allocations) / elapsed;
+}
+
+void MemoryAccounting::setReportInterval(std::chrono::seconds interval) {
+    auto& state = memory::report();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.interval = std::max(interval, std::chrono::seconds::zero());
+
+    auto timerWheel = TimerWheel::getDefault();
+    if (state.timer != TimerWheel::INVALID_TIMER) {
+        timerWheel->cancel(state.timer);
+        state.timer = TimerWheel::INVALID_TIMER;
+    }
+
+    // without the instrumented allocator there is nothing to report
+    if (state.interval.count() > 0 && isEnabled()) {
+        state.previous = getSnapshots();
+        state.timer = timerWheel->submitPeriodic(state.interval, &MemoryAccounting::report);
+    }
+}
+
+std::chrono::seconds MemoryAccounting::getReportInterval() {
+    auto& state = memory::report();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.interval;
+}
+
+void MemoryAccounting::report() {
+    auto snapshots = getSnapshots();
+    std::vector<Snapshot> previous;
+    {
+        auto& state = memory::report();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        previous.swap(state.previous);
+        state.previous = snapshots;
+    }
+
+    for (size_t j = 0; j < snapshots.size(); j++) {
+        const auto& snapshot = snapshots[j];
+        if (snapshot.allocations == 0) {
+            continue;
+        }
+        // a module registered since the last report has allocated everything in the interval
+        auto rate = j < previous.size() ? getAllocationRate(previous[j], snapshot) : 0.0;
+
+        AACE_INFO(LX(TAG, "report")
+                      .d("module", snapshot.module)
+                      .d("liveBytes", snapshot.liveBytes)
+                      .d("peakBytes", snapshot.peakBytes)
+                      .d("allocations", snapshot.allocations)
+                      .d("allocationsPerSecond", rate));
+        aace::engine::utils::metrics::emitMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX,
+            "report",
+            {{"LiveKB", static_cast<int>(snapshot.liveBytes / 1024)},
+             {"PeakKB", static_cast<int>(snapshot.peakBytes / 1024)},
+             {"AllocationsPerMinute", static_cast<int>(rate * 60)}},
+            {{"Module", snapshot.module}},
+            {});
+    }
+}
+
+}  // namespace memory
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
+
+#if defined(AAC_MEMORY_ACCOUNTING)
+
+using MemoryAccounting = aace::engine::utils::memory::MemoryAccounting;
+
+namespace {
+
+/// Header before each block, keeping the alignment of the block returned by malloc
+struct alignas(std::max_align_t) BlockHeader {
+    size_t size;
+    uint32_t module;
+};
+
+}  // namespace
+
+static void* allocateBlock(size_t size, bool nothrow) {
+    while (true) {
+        auto header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + size));
+        if (header != nullptr) {
+            header->size = size;
+            header->module = MemoryAccounting::getCurrentModule();
+            MemoryAccounting::recordAllocation(header->module, size);
+            return header + 1;
+        }
+        auto handler = std::get_new_handler();
+        if (handler == nullptr) {
+            if (nothrow) {
+                return nullptr;
+            }
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+static void freeBlock(void* block) {
+    if (block == nullptr) {
+        return;
+    }
+    auto header = static_cast<BlockHeader*>(block) - 1;
+    MemoryAccounting::recordDeallocation(header->module, header->size);
+    std::free(header);
+}
+
+void* operator new(size_t size) {
+    return allocateBlock(size, false);
+}
+
+void* operator new[](size_t size) {
+    return allocateBlock(size, false);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocateBlock(size, true);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocateBlock(size, true);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* block) noexcept {
+    freeBlock(block);
+}
+
+void operator delete[](void* block) noexcept {
+    freeBlock(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+    freeBlock(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+    freeBlock(block);
+}
+
+#endif  // AAC_MEMORY_ACCOUNTING
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Memory/MemoryPressure.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace memory {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.utils.memory.MemoryPressure");
+
+namespace {
+
+struct Observer {
+    std::weak_ptr<MemoryPressureObserverInterface> observer;
+    MemoryPressure::Priority priority;
+    /// The level the observer was last notified of
+    MemoryPressureLevel level;
+};
+
+using Notification = std::pair<std::shared_ptr<MemoryPressureObserverInterface>, MemoryPressureLevel>;
+
+struct PressureState {
+    /// Serializes the reports, so the observers are notified of the levels in the order they are reported
+    std::mutex reportMutex;
+    /// Protects the observers and the level, it is not held while notifying the observers
+    std::mutex mutex;
+    /// The observers in priority order, and in the order they were added within a priority
+    std::vector<Observer> observers;
+    MemoryPressureLevel level = MemoryPressureLevel::NORMAL;
+};
+
+PressureState& getState() {
+    static PressureState s_state;
+    return s_state;
+}
+
+void notify(const std::vector<Notification>& notifications) {
+    for (auto& notification : notifications) {
+        try {
+            notification.first->onMemoryPressure(notification.second);
+        } catch (std::exception& ex) {
+            AACE_ERROR(LX(TAG).d("level", notification.second).d("reason", ex.what()));
+        }
+    }
+}
+
+}  // namespace
+
+void MemoryPressure::addObserver(std::shared_ptr<MemoryPressureObserverInterface> observer, Priority priority) {
+    try {
+        ThrowIfNull(observer, "invalidObserver");
+        auto& state = getState();
+        std::lock_guard<std::mutex> reportLock(state.reportMutex);
+
+        MemoryPressureLevel level;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            level = getLevelFor(priority, state.level);
+            auto it = std::upper_bound(
+                state.observers.begin(), state.observers.end(), priority, [](Priority value, const Observer& entry) {
+                    return value < entry.priority;
+                });
+            state.observers.insert(it, Observer{observer, priority, level});
+        }
+        if (level != MemoryPressureLevel::NORMAL) {
+            notify({{observer, level}});
+        }
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    }
+}
+
+void MemoryPressure::removeObserver(std::shared_ptr<MemoryPressureObserverInterface> observer) {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.observers.erase(
+        std::remove_if(
+            state.observers.begin(),
+            state.observers.end(),
+            [&observer](const Observer& entry) {
+                // the observers are not locked, so an observer is never released while the mutex is held
+                return entry.observer.expired() ||
+                       (!entry.observer.owner_before(observer) && !observer.owner_before(entry.observer));
+            }),
+        state.observers.end());
+}
+
+void MemoryPressure::report(MemoryPressureLevel level) {
+    auto& state = getState();
+    std::lock_guard<std::mutex> reportLock(state.reportMutex);
+
+    // the observers locked while the mutex is held are released after it, in case they are released elsewhere
+    std::vector<std::shared_ptr<MemoryPressureObserverInterface>> observers;
+    std::vector<Notification> notifications;
+    MemoryPressureLevel previousLevel;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        previousLevel = state.level;
+        state.level = level;
+        for (auto it = state.observers.begin(); it != state.observers.end();) {
+            auto observer = it->observer.lock();
+            if (observer == nullptr) {
+                it = state.observers.erase(it);
+                continue;
+            }
+            auto observerLevel = getLevelFor(it->priority, level);
+            if (observerLevel != it->level) {
+                it->level = observerLevel;
+                notifications.emplace_back(observer, observerLevel);
+            }
+            observers.push_back(std::move(observer));
+            ++it;
+        }
+    }
+
+    // the entry is logged outside of the lock, since the log sinks observe the memory pressure too
+    AACE_INFO(LX(TAG).d("level", level).d("previousLevel", previousLevel).d("notified", notifications.size()));
+
+    // the observers are notified in priority order, so the caches are released before the buffers shrink
+    notify(notifications);
+}
+
+MemoryPressureLevel MemoryPressure::getLevel() {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.level;
+}
+
+MemoryPressureLevel MemoryPressure::getLevelFor(Priority priority, MemoryPressureLevel level) {
+    MemoryPressureLevel threshold = MemoryPressureLevel::CRITICAL;
+    switch (priority) {
+        case Priority::CACHE:
+            threshold = MemoryPressureLevel::MODERATE;
+            break;
+        case Priority::BUFFER:
+            threshold = MemoryPressureLevel::LOW;
+            break;
+        case Priority::ESSENTIAL:
+            threshold = MemoryPressureLevel::CRITICAL;
+            break;
+    }
+    return level >= threshold ? level : MemoryPressureLevel::NORMAL;
+}
+
+}  // namespace memory
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
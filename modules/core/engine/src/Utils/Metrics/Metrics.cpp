@@ -14,6 +14,7 @@
  */
 
 #include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Metrics/MetricAggregator.h>
 #include <AACE/Engine/Metrics/MetricEvent.h>
 #include <AACE/Engine/Utils/Metrics/Metrics.h>
 
@@ -30,6 +31,18 @@ static const std::string METRIC_PROGRAM_NAME_PREFIX = "AlexaAuto";
 /// Delimiter
 static const std::string DELIMITER = "_";
 
+/// Returns the aggregator of a metric, or @c nullptr if the metric is recorded as it is emitted.
+static std::shared_ptr<MetricAggregator> getAggregator(
+    MetricEvent::MetricBufferType bufferType,
+    MetricEvent::MetricIdentityType identityType) {
+    // buffered and unique metrics are recorded one by one, the aggregator would merge them with the other samples
+    if (bufferType != MetricEvent::MetricBufferType::NB || identityType != MetricEvent::MetricIdentityType::NUNI) {
+        return nullptr;
+    }
+    auto aggregator = MetricAggregator::getDefault();
+    return aggregator != nullptr && aggregator->isEnabled() ? aggregator : nullptr;
+}
+
 void emitCounterMetrics(
     const std::string& metricSuffix,
     const std::string& methodName,
@@ -37,6 +50,11 @@ void emitCounterMetrics(
     const int value,
     MetricEvent::MetricBufferType bufferType,
     MetricEvent::MetricIdentityType identityType) {
+    if (auto aggregator = getAggregator(bufferType, identityType)) {
+        if (aggregator->addCounter(METRIC_PROGRAM_NAME_PREFIX + DELIMITER + metricSuffix, methodName, key, value)) {
+            return;
+        }
+    }
     auto metricEvent = std::shared_ptr<MetricEvent>(
         new MetricEvent(METRIC_PROGRAM_NAME_PREFIX + DELIMITER + metricSuffix, methodName, bufferType, identityType));
     if (metricEvent) {
@@ -51,6 +69,13 @@ void emitCounterMetrics(
     const std::vector<std::string>& datapoints,
     MetricEvent::MetricBufferType bufferType,
     MetricEvent::MetricIdentityType identityType) {
+    if (auto aggregator = getAggregator(bufferType, identityType)) {
+        auto program = METRIC_PROGRAM_NAME_PREFIX + DELIMITER + metricSuffix;
+        for (auto& datapoint : datapoints) {
+            aggregator->addCounter(program, methodName, datapoint, 1);
+        }
+        return;
+    }
     auto metricEvent = std::shared_ptr<MetricEvent>(
         new MetricEvent(METRIC_PROGRAM_NAME_PREFIX + DELIMITER + metricSuffix, methodName, bufferType, identityType));
     if (metricEvent) {
@@ -68,6 +93,11 @@ void emitTimerMetrics(
     const double value,
     MetricEvent::MetricBufferType bufferType,
     MetricEvent::MetricIdentityType identityType) {
+    if (auto aggregator = getAggregator(bufferType, identityType)) {
+        if (aggregator->addTimer(METRIC_PROGRAM_NAME_PREFIX + DELIMITER + metricSuffix, methodName, key, value)) {
+            return;
+        }
+    }
     auto metricEvent = std::shared_ptr<MetricEvent>(
         new MetricEvent(METRIC_PROGRAM_NAME_PREFIX + DELIMITER + metricSuffix, methodName, bufferType, identityType));
     if (metricEvent) {
@@ -84,6 +114,18 @@ void emitMetrics(
     const std::vector<std::pair<std::string, double>>& timerDatapoints,
     MetricEvent::MetricBufferType bufferType,
     MetricEvent::MetricIdentityType identityType) {
+    // string datapoints are not aggregated, so their metric keeps its other datapoints
+    auto aggregator = stringDatapoints.empty() ? getAggregator(bufferType, identityType) : nullptr;
+    if (aggregator != nullptr) {
+        auto program = METRIC_PROGRAM_NAME_PREFIX + DELIMITER + metricSuffix;
+        for (auto& counterDatapoint : counterDatapoints) {
+            aggregator->addCounter(program, methodName, counterDatapoint.first, counterDatapoint.second);
+        }
+        for (auto& timerDatapoint : timerDatapoints) {
+            aggregator->addTimer(program, methodName, timerDatapoint.first, timerDatapoint.second);
+        }
+        return;
+    }
     auto metricEvent = std::shared_ptr<MetricEvent>(
         new MetricEvent(METRIC_PROGRAM_NAME_PREFIX + DELIMITER + metricSuffix, methodName, bufferType, identityType));
     if (metricEvent) {
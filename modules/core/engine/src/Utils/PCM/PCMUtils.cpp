@@ -0,0 +1,543 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/Utils/PCM/PCMUtils.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define AACE_PCM_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AACE_PCM_NEON
+#endif
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace pcm {
+
+static const float INT16_SCALE = 32768.0f;
+static const float INT16_MAX_FLOAT = 32767.0f;
+static const float INT16_MIN_FLOAT = -32768.0f;
+
+// the scalar conversion used for the samples that don't fill a vector
+static inline int16_t toInt16(float value) {
+    return static_cast<int16_t>(std::lrint(std::min(std::max(value, INT16_MIN_FLOAT), INT16_MAX_FLOAT)));
+}
+
+#if defined(AACE_PCM_NEON)
+// converts 4 floats to 32-bit integers, rounding to the nearest value
+static inline int32x4_t roundToInt32(float32x4_t value) {
+#if defined(__aarch64__)
+    return vcvtnq_s32_f32(value);
+#else
+    // ARMv7 only truncates, so the halves are rounded away from zero
+    auto half = vbslq_f32(vcltq_f32(value, vdupq_n_f32(0)), vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f));
+    return vcvtq_s32_f32(vaddq_f32(value, half));
+#endif
+}
+#endif
+
+bool isVectorized() {
+#if defined(AACE_PCM_SSE2) || defined(AACE_PCM_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void int16ToFloat(const int16_t* input, float* output, size_t count) {
+    size_t j = 0;
+#if defined(AACE_PCM_SSE2)
+    const __m128 scale = _mm_set1_ps(1.0f / INT16_SCALE);
+    for (; j + 8 <= count; j += 8) {
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + j));
+        // sign extend each half to 32 bits
+        __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+        __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+        _mm_storeu_ps(output + j, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+        _mm_storeu_ps(output + j + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+    }
+#elif defined(AACE_PCM_NEON)
+    for (; j + 8 <= count; j += 8) {
+        int16x8_t samples = vld1q_s16(input + j);
+        float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples)));
+        float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples)));
+        vst1q_f32(output + j, vmulq_n_f32(low, 1.0f / INT16_SCALE));
+        vst1q_f32(output + j + 4, vmulq_n_f32(high, 1.0f / INT16_SCALE));
+    }
+#endif
+    for (; j < count; j++) {
+        output[j] = input[j] / INT16_SCALE;
+    }
+}
+
+void floatToInt16(const float* input, int16_t* output, size_t count) {
+    size_t j = 0;
+#if defined(AACE_PCM_SSE2)
+    const __m128 scale = _mm_set1_ps(INT16_SCALE);
+    const __m128 minimum = _mm_set1_ps(INT16_MIN_FLOAT);
+    const __m128 maximum = _mm_set1_ps(INT16_MAX_FLOAT);
+    for (; j + 8 <= count; j += 8) {
+        // the values are clamped first, since the out of range conversions all return INT32_MIN
+        __m128 low = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(input + j), scale), minimum), maximum);
+        __m128 high = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(input + j + 4), scale), minimum), maximum);
+        __m128i samples = _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + j), samples);
+    }
+#elif defined(AACE_PCM_NEON)
+    for (; j + 8 <= count; j += 8) {
+        // the conversion and the narrowing saturate
+        int32x4_t low = roundToInt32(vmulq_n_f32(vld1q_f32(input + j), INT16_SCALE));
+        int32x4_t high = roundToInt32(vmulq_n_f32(vld1q_f32(input + j + 4), INT16_SCALE));
+        vst1q_s16(output + j, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+    }
+#endif
+    for (; j < count; j++) {
+        output[j] = toInt16(input[j] * INT16_SCALE);
+    }
+}
+
+void applyGain(int16_t* samples, size_t count, float gain) {
+    size_t j = 0;
+#if defined(AACE_PCM_SSE2)
+    const __m128 factor = _mm_set1_ps(gain);
+    const __m128 minimum = _mm_set1_ps(INT16_MIN_FLOAT);
+    const __m128 maximum = _mm_set1_ps(INT16_MAX_FLOAT);
+    for (; j + 8 <= count; j += 8) {
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + j));
+        __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16));
+        __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16));
+        low = _mm_min_ps(_mm_max_ps(_mm_mul_ps(low, factor), minimum), maximum);
+        high = _mm_min_ps(_mm_max_ps(_mm_mul_ps(high, factor), minimum), maximum);
+        values = _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + j), values);
+    }
+#elif defined(AACE_PCM_NEON)
+    for (; j + 8 <= count; j += 8) {
+        int16x8_t values = vld1q_s16(samples + j);
+        float32x4_t low = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(values))), gain);
+        float32x4_t high = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(values))), gain);
+        vst1q_s16(samples + j, vcombine_s16(vqmovn_s32(roundToInt32(low)), vqmovn_s32(roundToInt32(high))));
+    }
+#endif
+    for (; j < count; j++) {
+        samples[j] = toInt16(samples[j] * gain);
+    }
+}
+
+void applyGain(float* samples, size_t count, float gain) {
+    size_t j = 0;
+#if defined(AACE_PCM_SSE2)
+    const __m128 factor = _mm_set1_ps(gain);
+    for (; j + 4 <= count; j += 4) {
+        _mm_storeu_ps(samples + j, _mm_mul_ps(_mm_loadu_ps(samples + j), factor));
+    }
+#elif defined(AACE_PCM_NEON)
+    for (; j + 4 <= count; j += 4) {
+        vst1q_f32(samples + j, vmulq_n_f32(vld1q_f32(samples + j), gain));
+    }
+#endif
+    for (; j < count; j++) {
+        samples[j] *= gain;
+    }
+}
+
+void downmixToMono(const int16_t* input, int16_t* output, size_t frames, size_t channels) {
+    if (channels == 0) {
+        return;
+    }
+    if (channels == 1) {
+        if (output != input) {
+            std::copy(input, input + frames, output);
+        }
+        return;
+    }
+
+    size_t frame = 0;
+    if (channels == 2) {
+#if defined(AACE_PCM_SSE2)
+        const __m128i ones = _mm_set1_epi16(1);
+        for (; frame + 8 <= frames; frame += 8) {
+            // the sums of the adjacent samples are the sums of the channels of 4 frames
+            __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + frame * 2));
+            __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + frame * 2 + 8));
+            __m128i low = _mm_srai_epi32(_mm_madd_epi16(first, ones), 1);
+            __m128i high = _mm_srai_epi32(_mm_madd_epi16(second, ones), 1);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + frame), _mm_packs_epi32(low, high));
+        }
+#elif defined(AACE_PCM_NEON)
+        for (; frame + 8 <= frames; frame += 8) {
+            // the channels are deinterleaved, and averaged with a halving add
+            int16x8x2_t samples = vld2q_s16(input + frame * 2);
+            vst1q_s16(output + frame, vhaddq_s16(samples.val[0], samples.val[1]));
+        }
+#endif
+        for (; frame < frames; frame++) {
+            output[frame] = static_cast<int16_t>((input[frame * 2] + input[frame * 2 + 1]) >> 1);
+        }
+        return;
+    }
+
+    if (channels == 4) {
+#if defined(AACE_PCM_SSE2)
+        const __m128i ones = _mm_set1_epi16(1);
+        for (; frame + 8 <= frames; frame += 8) {
+            // each vector holds 2 frames, which are summed by pairs of channels, and the pairs are then added
+            __m128i sums[4];
+            for (int j = 0; j < 4; j++) {
+                auto samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + (frame + j * 2) * 4));
+                sums[j] = _mm_shuffle_epi32(_mm_madd_epi16(samples, ones), _MM_SHUFFLE(3, 1, 2, 0));
+            }
+            __m128i low = _mm_add_epi32(_mm_unpacklo_epi64(sums[0], sums[1]), _mm_unpackhi_epi64(sums[0], sums[1]));
+            __m128i high = _mm_add_epi32(_mm_unpacklo_epi64(sums[2], sums[3]), _mm_unpackhi_epi64(sums[2], sums[3]));
+            low = _mm_srai_epi32(low, 2);
+            high = _mm_srai_epi32(high, 2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + frame), _mm_packs_epi32(low, high));
+        }
+#elif defined(AACE_PCM_NEON)
+        for (; frame + 8 <= frames; frame += 8) {
+            // the channels are deinterleaved, and summed in 32 bits
+            int16x8x4_t samples = vld4q_s16(input + frame * 4);
+            int32x4_t low = vaddl_s16(vget_low_s16(samples.val[0]), vget_low_s16(samples.val[1]));
+            low = vaddq_s32(low, vaddl_s16(vget_low_s16(samples.val[2]), vget_low_s16(samples.val[3])));
+            int32x4_t high = vaddl_s16(vget_high_s16(samples.val[0]), vget_high_s16(samples.val[1]));
+            high = vaddq_s32(high, vaddl_s16(vget_high_s16(samples.val[2]), vget_high_s16(samples.val[3])));
+            vst1q_s16(output + frame, vcombine_s16(vshrn_n_s32(low, 2), vshrn_n_s32(high, 2)));
+        }
+#endif
+        for (; frame < frames; frame++) {
+            auto* samples = input + frame * 4;
+            output[frame] = static_cast<int16_t>((samples[0] + samples[1] + samples[2] + samples[3]) >> 2);
+        }
+        return;
+    }
+
+    for (; frame < frames; frame++) {
+        int32_t sum = 0;
+        for (size_t channel = 0; channel < channels; channel++) {
+            sum += input[frame * channels + channel];
+        }
+        output[frame] = static_cast<int16_t>(sum / static_cast<int32_t>(channels));
+    }
+}
+
+void highPassFilter(int16_t* samples, size_t frames, size_t channels, float coefficient, float* state) {
+    float* lastInput = state;
+    float* lastOutput = state + channels;
+#if defined(AACE_PCM_SSE2) || defined(AACE_PCM_NEON)
+    const size_t vectorChannels = channels / 4 * 4;
+#endif
+#if defined(AACE_PCM_SSE2)
+    const __m128 factor = _mm_set1_ps(coefficient);
+#endif
+    for (size_t frame = 0; frame < frames; frame++) {
+        int16_t* frameSamples = samples + frame * channels;
+        size_t channel = 0;
+#if defined(AACE_PCM_SSE2)
+        for (; channel < vectorChannels; channel += 4) {
+            __m128i values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(frameSamples + channel));
+            __m128 input = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16));
+            __m128 delta = _mm_sub_ps(input, _mm_loadu_ps(lastInput + channel));
+            __m128 output = _mm_mul_ps(factor, _mm_add_ps(_mm_loadu_ps(lastOutput + channel), delta));
+            _mm_storeu_ps(lastInput + channel, input);
+            _mm_storeu_ps(lastOutput + channel, output);
+            // the outputs are within the 32-bit range, and the packing saturates them
+            __m128i converted = _mm_cvtps_epi32(output);
+            converted = _mm_packs_epi32(converted, converted);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(frameSamples + channel), converted);
+        }
+#elif defined(AACE_PCM_NEON)
+        for (; channel < vectorChannels; channel += 4) {
+            float32x4_t input = vcvtq_f32_s32(vmovl_s16(vld1_s16(frameSamples + channel)));
+            float32x4_t delta = vsubq_f32(input, vld1q_f32(lastInput + channel));
+            float32x4_t output = vmulq_n_f32(vaddq_f32(vld1q_f32(lastOutput + channel), delta), coefficient);
+            vst1q_f32(lastInput + channel, input);
+            vst1q_f32(lastOutput + channel, output);
+            vst1_s16(frameSamples + channel, vqmovn_s32(roundToInt32(output)));
+        }
+#endif
+        for (; channel < channels; channel++) {
+            float input = frameSamples[channel];
+            float output = coefficient * (lastOutput[channel] + (input - lastInput[channel]));
+            lastInput[channel] = input;
+            lastOutput[channel] = output;
+            frameSamples[channel] = toInt16(output);
+        }
+    }
+}
+
+float highPassCoefficient(float cutoff, uint32_t sampleRate) {
+    // the coefficient of a filter of time constant RC, RC / (RC + 1 / rate)
+    const double pi = 3.14159265358979323846;
+    return static_cast<float>(1.0 / (1.0 + 2.0 * pi * cutoff / sampleRate));
+}
+
+float levelDbfs(const int16_t* samples, size_t count) {
+    uint64_t sum = 0;
+    size_t j = 0;
+#if defined(AACE_PCM_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sums = _mm_setzero_si128();
+    for (; j + 8 <= count; j += 8) {
+        // the sums of the adjacent squares fit in unsigned 32-bit lanes, which are accumulated in 64 bits
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + j));
+        __m128i squares = _mm_madd_epi16(values, values);
+        sums = _mm_add_epi64(sums, _mm_unpacklo_epi32(squares, zero));
+        sums = _mm_add_epi64(sums, _mm_unpackhi_epi32(squares, zero));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sums);
+    sum = lanes[0] + lanes[1];
+#elif defined(AACE_PCM_NEON)
+    int64x2_t sums = vdupq_n_s64(0);
+    for (; j + 8 <= count; j += 8) {
+        int16x8_t values = vld1q_s16(samples + j);
+        sums = vpadalq_s32(sums, vmull_s16(vget_low_s16(values), vget_low_s16(values)));
+        sums = vpadalq_s32(sums, vmull_s16(vget_high_s16(values), vget_high_s16(values)));
+    }
+    sum = static_cast<uint64_t>(vgetq_lane_s64(sums, 0) + vgetq_lane_s64(sums, 1));
+#endif
+    for (; j < count; j++) {
+        sum += static_cast<uint64_t>(static_cast<int32_t>(samples[j]) * samples[j]);
+    }
+
+    if (count == 0 || sum == 0) {
+        return SILENCE_DBFS;
+    }
+    double meanSquare = static_cast<double>(sum) / count / (INT16_SCALE * INT16_SCALE);
+    return std::max(static_cast<float>(10.0 * std::log10(meanSquare)), SILENCE_DBFS);
+}
+
+//
+// Resampler
+//
+
+Resampler::Resampler(uint32_t inputRate, uint32_t outputRate) :
+        m_inputRate(inputRate),
+        m_outputRate(outputRate),
+        m_decimation(outputRate > 0 && inputRate % outputRate == 0 ? inputRate / outputRate : 0),
+        m_step(outputRate > 0 ? static_cast<double>(inputRate) / outputRate : 1) {
+}
+
+size_t Resampler::process(const int16_t* input, size_t count, std::vector<int16_t>& output) {
+    auto initialSize = output.size();
+    if (count == 0) {
+        return 0;
+    }
+
+    // the same rate, or an integer ratio averaged over each output period
+    if (m_decimation == 1) {
+        output.insert(output.end(), input, input + count);
+    } else if (m_decimation > 1) {
+        output.reserve(output.size() + (m_summed + count) / m_decimation);
+        for (size_t j = 0; j < count; j++) {
+            m_sum += input[j];
+            if (++m_summed == m_decimation) {
+                output.push_back(static_cast<int16_t>(m_sum / static_cast<int32_t>(m_decimation)));
+                m_sum = 0;
+                m_summed = 0;
+            }
+        }
+    } else {
+        // the input sample at index -1 is the last sample of the previous call
+        output.reserve(output.size() + static_cast<size_t>((count - m_position) / m_step) + 1);
+        double position = m_position;
+        while (true) {
+            auto index = static_cast<ptrdiff_t>(std::floor(position));
+            if (index + 1 >= static_cast<ptrdiff_t>(count)) {
+                break;
+            }
+            double left = index < 0 ? m_last : input[index];
+            double right = input[index + 1];
+            output.push_back(static_cast<int16_t>(std::lrint(left + (right - left) * (position - index))));
+            position += m_step;
+        }
+        m_position = position - count;
+        m_last = input[count - 1];
+    }
+
+    return output.size() - initialSize;
+}
+
+void Resampler::reset() {
+    m_sum = 0;
+    m_summed = 0;
+    m_position = 0;
+    m_last = 0;
+}
+
+uint32_t Resampler::getInputRate() const {
+    return m_inputRate;
+}
+
+uint32_t Resampler::getOutputRate() const {
+    return m_outputRate;
+}
+
+//
+// PolyphaseResampler
+//
+
+constexpr uint32_t PolyphaseResampler::DEFAULT_ZERO_CROSSINGS;
+constexpr uint32_t PolyphaseResampler::MAX_PHASES;
+
+// the fraction bits of the coefficients, which leave room in the 32-bit sums for the gain of the filter
+static const int COEFFICIENT_BITS = 14;
+
+static uint32_t greatestCommonDivisor(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        auto next = a % b;
+        a = b;
+        b = next;
+    }
+    return a;
+}
+
+// the dot product of a phase with the input samples, a multiple of 8 samples
+static inline int32_t dotProduct(const int16_t* coefficients, const int16_t* samples, size_t count) {
+    size_t j = 0;
+    int32_t sum = 0;
+#if defined(AACE_PCM_SSE2)
+    __m128i sums = _mm_setzero_si128();
+    for (; j + 8 <= count; j += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coefficients + j));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + j));
+        sums = _mm_add_epi32(sums, _mm_madd_epi16(a, b));
+    }
+    sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+    sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+    sum = _mm_cvtsi128_si32(sums);
+#elif defined(AACE_PCM_NEON)
+    int32x4_t sums = vdupq_n_s32(0);
+    for (; j + 8 <= count; j += 8) {
+        int16x8_t a = vld1q_s16(coefficients + j);
+        int16x8_t b = vld1q_s16(samples + j);
+        sums = vmlal_s16(sums, vget_low_s16(a), vget_low_s16(b));
+        sums = vmlal_s16(sums, vget_high_s16(a), vget_high_s16(b));
+    }
+    int32x2_t pairs = vadd_s32(vget_low_s32(sums), vget_high_s32(sums));
+    sum = vget_lane_s32(vpadd_s32(pairs, pairs), 0);
+#endif
+    for (; j < count; j++) {
+        sum += static_cast<int32_t>(coefficients[j]) * samples[j];
+    }
+    return sum;
+}
+
+PolyphaseResampler::PolyphaseResampler(
+    uint32_t inputRate,
+    uint32_t outputRate,
+    uint32_t up,
+    uint32_t down,
+    size_t taps) :
+        m_inputRate(inputRate), m_outputRate(outputRate), m_up(up), m_down(down), m_taps(taps) {
+    // the prototype low-pass filter at the upsampled rate, whose stop band starts at the lower Nyquist frequency
+    const double pi = 3.14159265358979323846;
+    const size_t length = static_cast<size_t>(up) * taps;
+    const double nyquist = 0.5 / std::max(up, down);
+    const double transition = 5.5 / length;
+    const double cutoff = std::max(nyquist - transition / 2, nyquist / 2);
+    const double center = (length - 1) / 2.0;
+    std::vector<double> filter(length);
+    double sum = 0;
+    for (size_t j = 0; j < length; j++) {
+        double x = j - center;
+        double sinc = x == 0 ? 2 * cutoff : std::sin(2 * pi * cutoff * x) / (pi * x);
+        // a Blackman window
+        double angle = 2 * pi * j / (length - 1);
+        double window = 0.42 - 0.5 * std::cos(angle) + 0.08 * std::cos(2 * angle);
+        filter[j] = sinc * window;
+        sum += filter[j];
+    }
+
+    // each phase has a gain of 1, and multiplies the oldest sample first
+    m_coefficients.resize(length);
+    for (size_t phase = 0; phase < up; phase++) {
+        for (size_t tap = 0; tap < taps; tap++) {
+            auto value = filter[phase + (taps - 1 - tap) * up] * up / sum * (1 << COEFFICIENT_BITS);
+            value = std::min(std::max(value, -32768.0), 32767.0);
+            m_coefficients[phase * taps + tap] = static_cast<int16_t>(std::lrint(value));
+        }
+    }
+    reset();
+}
+
+std::unique_ptr<PolyphaseResampler> PolyphaseResampler::create(
+    uint32_t inputRate,
+    uint32_t outputRate,
+    uint32_t zeroCrossings) {
+    if (inputRate == 0 || outputRate == 0 || zeroCrossings == 0) {
+        return nullptr;
+    }
+    auto divisor = greatestCommonDivisor(inputRate, outputRate);
+    auto up = outputRate / divisor;
+    auto down = inputRate / divisor;
+    if (up > MAX_PHASES) {
+        return nullptr;
+    }
+
+    // the zero crossings at the lower rate are further apart at the input rate when downsampling
+    auto taps = static_cast<size_t>(2 * zeroCrossings * (static_cast<uint64_t>(std::max(up, down)) + up - 1) / up);
+    taps = (taps + 7) / 8 * 8;
+    return std::unique_ptr<PolyphaseResampler>(new PolyphaseResampler(inputRate, outputRate, up, down, taps));
+}
+
+size_t PolyphaseResampler::process(const int16_t* input, size_t count, std::vector<int16_t>& output) {
+    auto initialSize = output.size();
+    m_history.insert(m_history.end(), input, input + count);
+
+    // the output sample at the position of input sample k and phase p filters the samples before k, and k
+    auto end = static_cast<uint64_t>(count) * m_up;
+    output.reserve(output.size() + static_cast<size_t>((end - std::min(m_position, end)) / m_down + 1));
+    auto position = m_position;
+    for (; position < end; position += m_down) {
+        auto sample = static_cast<size_t>(position / m_up);
+        auto phase = static_cast<size_t>(position % m_up);
+        auto sum = dotProduct(m_coefficients.data() + phase * m_taps, m_history.data() + sample, m_taps);
+        auto value = (sum + (1 << (COEFFICIENT_BITS - 1))) >> COEFFICIENT_BITS;
+        output.push_back(static_cast<int16_t>(std::min<int32_t>(std::max<int32_t>(value, INT16_MIN), INT16_MAX)));
+    }
+    m_position = position - end;
+
+    // the last taps - 1 samples are kept for the next call
+    m_history.erase(m_history.begin(), m_history.begin() + count);
+    return output.size() - initialSize;
+}
+
+void PolyphaseResampler::reset() {
+    m_history.assign(m_taps - 1, 0);
+    m_position = 0;
+}
+
+uint32_t PolyphaseResampler::getInputRate() const {
+    return m_inputRate;
+}
+
+uint32_t PolyphaseResampler::getOutputRate() const {
+    return m_outputRate;
+}
+
+size_t PolyphaseResampler::getTaps() const {
+    return m_taps;
+}
+
+}  // namespace pcm
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/Utils/Threading/AsyncFlow.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.utils.threading.AsyncFlow");
+
+AsyncFlow::Next::Next(Type type, Clock::time_point deadline) : m_type(type), m_deadline(deadline) {
+}
+
+AsyncFlow::Next AsyncFlow::Next::now() {
+    return Next(Type::NOW);
+}
+
+AsyncFlow::Next AsyncFlow::Next::at(Clock::time_point deadline) {
+    return Next(Type::AT, deadline);
+}
+
+AsyncFlow::Next AsyncFlow::Next::after(Clock::duration delay) {
+    return Next(Type::AT, Clock::now() + delay);
+}
+
+AsyncFlow::Next AsyncFlow::Next::suspend() {
+    return Next(Type::SUSPEND);
+}
+
+AsyncFlow::Next AsyncFlow::Next::done() {
+    return Next(Type::DONE);
+}
+
+std::shared_ptr<AsyncFlow> AsyncFlow::create(
+    const std::string& name,
+    Step step,
+    std::shared_ptr<ThreadPool> threadPool,
+    std::shared_ptr<TimerWheel> timerWheel) {
+    try {
+        ThrowIfNot(step, "invalidStep");
+        ThrowIfNull(threadPool, "invalidThreadPool");
+        ThrowIfNull(timerWheel, "invalidTimerWheel");
+        return std::shared_ptr<AsyncFlow>(new AsyncFlow(name, std::move(step), threadPool, timerWheel));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("name", name).d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+AsyncFlow::AsyncFlow(
+    const std::string& name,
+    Step step,
+    std::shared_ptr<ThreadPool> threadPool,
+    std::shared_ptr<TimerWheel> timerWheel) :
+        m_name(name), m_step(std::move(step)), m_threadPool(threadPool), m_timerWheel(timerWheel) {
+}
+
+AsyncFlow::~AsyncFlow() {
+    // a running step holds the flow, so no step is running, and the step scheduled is dropped
+    if (m_timer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(m_timer);
+    }
+}
+
+bool AsyncFlow::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_state != State::IDLE) {
+        return false;
+    }
+    scheduleLocked();
+    return m_state == State::SCHEDULED;
+}
+
+void AsyncFlow::wake() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_state == State::SUSPENDED) {
+        scheduleLocked();
+    } else if (m_state == State::RUNNING) {
+        m_wakePending = true;
+    }
+}
+
+void AsyncFlow::cancel() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_state == State::RUNNING) {
+        // the step ends the flow when it returns
+        m_state = State::DONE;
+        if (m_runningThread != std::this_thread::get_id()) {
+            m_stateChanged.wait(lock, [this]() { return m_runningThread == std::thread::id(); });
+        }
+    } else if (m_state != State::DONE) {
+        // a scheduled step is dropped when it finds the flow ended
+        finishLocked();
+    }
+}
+
+bool AsyncFlow::waitForCompletion(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_stateChanged.wait_for(
+        lock, timeout, [this]() { return m_state == State::DONE && m_runningThread == std::thread::id(); });
+}
+
+bool AsyncFlow::isDone() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_state == State::DONE;
+}
+
+bool AsyncFlow::isRunningStep() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_runningThread == std::this_thread::get_id();
+}
+
+void AsyncFlow::scheduleLocked() {
+    if (m_timer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(m_timer);
+        m_timer = TimerWheel::INVALID_TIMER;
+    }
+    m_suspension++;
+    m_state = State::SCHEDULED;
+
+    // the flow is owned by its owner, and a flow that is destructed drops its scheduled step
+    std::weak_ptr<AsyncFlow> weakFlow = shared_from_this();
+    if (!m_threadPool->post([weakFlow]() {
+            if (auto flow = weakFlow.lock()) {
+                flow->run();
+            }
+        })) {
+        AACE_ERROR(LX(TAG).d("name", m_name).d("reason", "threadPoolShutdown"));
+        finishLocked();
+    }
+}
+
+void AsyncFlow::finishLocked() {
+    if (m_timer != TimerWheel::INVALID_TIMER) {
+        m_timerWheel->cancel(m_timer);
+        m_timer = TimerWheel::INVALID_TIMER;
+    }
+    m_state = State::DONE;
+    m_stateChanged.notify_all();
+}
+
+void AsyncFlow::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_state != State::SCHEDULED) {
+        return;
+    }
+    m_state = State::RUNNING;
+    m_runningThread = std::this_thread::get_id();
+    m_wakePending = false;
+    lock.unlock();
+
+    auto next = Next::done();
+    try {
+        next = m_step();
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("name", m_name).d("reason", ex.what()));
+    }
+
+    lock.lock();
+    m_runningThread = std::thread::id();
+    if (m_state == State::DONE) {
+        // cancelled while the step was running
+        m_stateChanged.notify_all();
+        return;
+    }
+
+    if (next.m_type == Next::Type::DONE) {
+        finishLocked();
+    } else if (next.m_type == Next::Type::NOW || m_wakePending) {
+        scheduleLocked();
+    } else {
+        m_state = State::SUSPENDED;
+        auto suspension = ++m_suspension;
+        if (next.m_type == Next::Type::AT) {
+            std::weak_ptr<AsyncFlow> weakFlow = shared_from_this();
+            m_timer = m_timerWheel->submitAt(next.m_deadline, [weakFlow, suspension]() {
+                if (auto flow = weakFlow.lock()) {
+                    flow->resume(suspension);
+                }
+            });
+            if (m_timer == TimerWheel::INVALID_TIMER) {
+                AACE_ERROR(LX(TAG).d("name", m_name).d("reason", "timerWheelShutdown"));
+                finishLocked();
+            }
+        }
+    }
+}
+
+void AsyncFlow::resume(uint64_t suspension) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_state == State::SUSPENDED && m_suspension == suspension) {
+        // the timer expired, so it is not cancelled
+        m_timer = TimerWheel::INVALID_TIMER;
+        scheduleLocked();
+    }
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
@@ -26,6 +26,12 @@ Executor::Executor() :
     m_taskThread->start();
 }
 
+Executor::Executor(const std::string& name) :
+        m_taskQueue{std::make_shared<TaskQueue>(ExecutorStats::create(name))},
+        m_taskThread{std::unique_ptr<TaskThread>(new TaskThread(m_taskQueue, name))} {
+    m_taskThread->start();
+}
+
 Executor::~Executor() {
     shutdown();
 }
@@ -47,6 +53,14 @@ bool Executor::isShutdown() {
     return m_taskQueue->isShutdown();
 }
 
+size_t Executor::queueSize() {
+    return m_taskQueue->size();
+}
+
+std::shared_ptr<ExecutorStats> Executor::getStats() {
+    return m_taskQueue->getStats();
+}
+
 }  // namespace threading
 }  // namespace utils
 }  // namespace engine
@@ -0,0 +1,254 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#endif
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+#include <AACE/Engine/Utils/Threading/ExecutorStats.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.utils.threading.ExecutorStats");
+
+/// Shortest interval between two checks of the watchdog
+static const std::chrono::milliseconds MIN_WATCHDOG_INTERVAL(10);
+
+constexpr std::array<uint32_t, 12> ExecutorStats::HISTOGRAM_BUCKET_BOUNDS_US;
+
+namespace {
+
+/// The named executors and the watchdog timer
+struct Registry {
+    std::mutex mutex;
+    std::vector<ExecutorStats*> executors;
+    std::chrono::milliseconds slowTaskThreshold{0};
+    TimerWheel::TimerId watchdogTimer = TimerWheel::INVALID_TIMER;
+};
+
+}  // namespace
+
+static Registry& registry() {
+    // never destroyed, so executors destroyed during static destruction can still unregister
+    static Registry* s_registry = new Registry();
+    return *s_registry;
+}
+
+void ExecutorStats::Histogram::add(Clock::duration duration) {
+    auto us = static_cast<uint64_t>(
+        std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+
+    auto bucket = std::upper_bound(HISTOGRAM_BUCKET_BOUNDS_US.begin(), HISTOGRAM_BUCKET_BOUNDS_US.end(), us) -
+                  HISTOGRAM_BUCKET_BOUNDS_US.begin();
+    buckets[bucket]++;
+    count++;
+    totalUs += us;
+    maxUs = std::max(maxUs, us);
+}
+
+std::shared_ptr<ExecutorStats> ExecutorStats::create(const std::string& name) {
+    return std::shared_ptr<ExecutorStats>(new ExecutorStats(name));
+}
+
+ExecutorStats::ExecutorStats(const std::string& name) : m_name{name} {
+    auto& executors = registry();
+    std::lock_guard<std::mutex> lock(executors.mutex);
+    executors.executors.push_back(this);
+}
+
+ExecutorStats::~ExecutorStats() {
+    auto& executors = registry();
+    std::lock_guard<std::mutex> lock(executors.mutex);
+    executors.executors.erase(
+        std::remove(executors.executors.begin(), executors.executors.end(), this), executors.executors.end());
+}
+
+const std::string& ExecutorStats::getName() const {
+    return m_name;
+}
+
+ExecutorStats::Snapshot ExecutorStats::getSnapshot() const {
+    Snapshot snapshot;
+    snapshot.name = m_name;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    snapshot.queueDepth = m_queueDepth;
+    snapshot.maxQueueDepth = m_maxQueueDepth;
+    snapshot.completedTasks = m_completedTasks;
+    snapshot.waitTime = m_waitTime;
+    snapshot.runTime = m_runTime;
+    snapshot.running = m_running;
+    if (m_running) {
+        snapshot.runningFor = Clock::now() - m_runStart;
+        snapshot.runningCallSite = describeCallSite(m_runCallSite);
+    }
+
+    return snapshot;
+}
+
+void ExecutorStats::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxQueueDepth = m_queueDepth;
+    m_completedTasks = 0;
+    m_waitTime = Histogram();
+    m_runTime = Histogram();
+}
+
+std::vector<ExecutorStats::Snapshot> ExecutorStats::getSnapshots() {
+    std::vector<Snapshot> snapshots;
+
+    auto& executors = registry();
+    std::lock_guard<std::mutex> lock(executors.mutex);
+    snapshots.reserve(executors.executors.size());
+    for (auto next : executors.executors) {
+        snapshots.push_back(next->getSnapshot());
+    }
+
+    return snapshots;
+}
+
+void ExecutorStats::setSlowTaskThreshold(std::chrono::milliseconds threshold) {
+    auto& executors = registry();
+    std::lock_guard<std::mutex> lock(executors.mutex);
+    executors.slowTaskThreshold = std::max(threshold, std::chrono::milliseconds::zero());
+
+    auto timerWheel = TimerWheel::getDefault();
+    if (executors.watchdogTimer != TimerWheel::INVALID_TIMER) {
+        timerWheel->cancel(executors.watchdogTimer);
+        executors.watchdogTimer = TimerWheel::INVALID_TIMER;
+    }
+
+    // check twice per threshold, so a slow task is reported before it has run for 1.5 times the threshold
+    if (executors.slowTaskThreshold.count() > 0) {
+        auto interval = std::max(MIN_WATCHDOG_INTERVAL, executors.slowTaskThreshold / 2);
+        executors.watchdogTimer = timerWheel->submitPeriodic(interval, &ExecutorStats::checkSlowTasks);
+    }
+}
+
+std::chrono::milliseconds ExecutorStats::getSlowTaskThreshold() {
+    auto& executors = registry();
+    std::lock_guard<std::mutex> lock(executors.mutex);
+    return executors.slowTaskThreshold;
+}
+
+std::string ExecutorStats::describeCallSite(const void* callSite) {
+    if (callSite == nullptr) {
+        return "";
+    }
+
+    std::ostringstream description;
+#if !defined(_WIN32)
+    Dl_info info;
+    if (dladdr(callSite, &info) != 0 && info.dli_fname != nullptr) {
+        auto module = std::strrchr(info.dli_fname, '/');
+        description << (module != nullptr ? module + 1 : info.dli_fname) << "+0x" << std::hex
+                    << (static_cast<const char*>(callSite) - static_cast<const char*>(info.dli_fbase));
+        if (info.dli_sname != nullptr) {
+            int status = -1;
+            char* demangled = nullptr;
+#if defined(__GNUC__)
+            demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+#endif
+            description << " (" << (status == 0 ? demangled : info.dli_sname) << ")";
+            std::free(demangled);
+        }
+        return description.str();
+    }
+#endif
+    description << callSite;
+    return description.str();
+}
+
+void ExecutorStats::taskQueued(size_t queueDepth) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queueDepth = queueDepth;
+    m_maxQueueDepth = std::max(m_maxQueueDepth, queueDepth);
+}
+
+void ExecutorStats::taskStarted(Clock::time_point queued, const void* callSite, size_t queueDepth) {
+    auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queueDepth = queueDepth;
+    m_waitTime.add(now - queued);
+    m_running = true;
+    m_runStart = now;
+    m_runCallSite = callSite;
+    m_slowTaskReported = false;
+}
+
+void ExecutorStats::taskCompleted() {
+    auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_running) {
+        return;
+    }
+    m_runTime.add(now - m_runStart);
+    m_completedTasks++;
+    m_running = false;
+    m_runCallSite = nullptr;
+}
+
+void ExecutorStats::checkSlowTasks() {
+    struct SlowTask {
+        std::string name;
+        Clock::duration runningFor;
+        const void* callSite;
+    };
+    std::vector<SlowTask> slowTasks;
+
+    {
+        auto& executors = registry();
+        std::lock_guard<std::mutex> lock(executors.mutex);
+        auto now = Clock::now();
+        for (auto next : executors.executors) {
+            std::lock_guard<std::mutex> executorLock(next->m_mutex);
+            if (next->m_running && !next->m_slowTaskReported &&
+                now - next->m_runStart >= executors.slowTaskThreshold) {
+                // report each slow task once
+                next->m_slowTaskReported = true;
+                slowTasks.push_back({next->m_name, now - next->m_runStart, next->m_runCallSite});
+            }
+        }
+    }
+
+    for (auto& next : slowTasks) {
+        AACE_WARN(LX(TAG)
+                      .d("reason", "slowTask")
+                      .d("executor", next.name)
+                      .d("runningForMs", std::chrono::duration_cast<std::chrono::milliseconds>(next.runningFor).count())
+                      .d("callSite", describeCallSite(next.callSite)));
+    }
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/Utils/Threading/SerialExecutor.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+/// Maximum number of tasks run before the pool worker is handed back, so other executors get a turn
+static const int MAX_TASKS_PER_RUN = 32;
+
+SerialExecutor::SerialExecutor(std::shared_ptr<ThreadPool> threadPool) : m_state{std::make_shared<State>()} {
+    m_state->threadPool = threadPool;
+    m_state->taskQueue = std::make_shared<TaskQueue>();
+}
+
+SerialExecutor::SerialExecutor(const std::string& name, std::shared_ptr<ThreadPool> threadPool) :
+        m_state{std::make_shared<State>()} {
+    m_state->threadPool = threadPool;
+    m_state->taskQueue = std::make_shared<TaskQueue>(ExecutorStats::create(name));
+}
+
+std::shared_ptr<ExecutorStats> SerialExecutor::getStats() {
+    return m_state->taskQueue->getStats();
+}
+
+SerialExecutor::~SerialExecutor() {
+    shutdown();
+}
+
+void SerialExecutor::waitForSubmittedTasks() {
+    std::promise<void> flushedPromise;
+    auto flushedFuture = flushedPromise.get_future();
+    auto task = [&flushedPromise]() { flushedPromise.set_value(); };
+    if (submit(task).valid()) {
+        flushedFuture.get();
+    }
+}
+
+void SerialExecutor::shutdown() {
+    m_state->taskQueue->shutdown();
+
+    // wait for the running task to finish, unless it is shutting down its own executor
+    if (m_state->runningThread.load() != std::this_thread::get_id()) {
+        std::lock_guard<std::mutex> lock(m_state->runMutex);
+    }
+}
+
+bool SerialExecutor::isShutdown() {
+    return m_state->taskQueue->isShutdown();
+}
+
+size_t SerialExecutor::queueSize() {
+    return m_state->taskQueue->size();
+}
+
+void SerialExecutor::schedule(const std::shared_ptr<State>& state) {
+    if (state->scheduled.exchange(true)) {
+        return;
+    }
+
+    std::weak_ptr<State> weakState = state;
+    if (state->threadPool == nullptr || !state->threadPool->post([weakState]() { run(weakState); })) {
+        state->scheduled = false;
+    }
+}
+
+void SerialExecutor::run(std::weak_ptr<State> weakState) {
+    auto state = weakState.lock();
+    if (state == nullptr) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state->runMutex);
+        state->runningThread = std::this_thread::get_id();
+        for (int j = 0; j < MAX_TASKS_PER_RUN; j++) {
+            auto task = state->taskQueue->tryPop();
+            if (!task) {
+                break;
+            }
+            task();
+            state->taskQueue->taskCompleted();
+        }
+        state->runningThread = std::thread::id();
+    }
+
+    // run the remaining tasks, or the tasks submitted while the flag was still set, in a new pool task
+    state->scheduled = false;
+    if (state->taskQueue->size() > 0) {
+        schedule(state);
+    }
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
@@ -14,45 +14,187 @@
  */
 
 #include <AACE/Engine/Utils/Threading/TaskQueue.h>
+#include <AACE/Engine/Utils/Memory/MemoryAccounting.h>
 
 namespace aace {
 namespace engine {
 namespace utils {
 namespace threading {
 
-TaskQueue::TaskQueue() : m_shutdown{false} {
+using MemoryAccounting = aace::engine::utils::memory::MemoryAccounting;
+
+/// The number of nodes allocated when the queue is created
+static const size_t INITIAL_NODE_COUNT = 16;
+
+/// The number of free nodes kept for reuse, the nodes beyond are freed
+static const size_t MAX_FREE_NODE_COUNT = 256;
+
+TaskQueue::TaskQueue(std::shared_ptr<ExecutorStats> stats) :
+        m_head{nullptr},
+        m_tail{nullptr},
+        m_size{0},
+        m_stats{stats},
+        m_module{
+            stats != nullptr ? MemoryAccounting::registerNamedModule(stats->getName()) : MemoryAccounting::UNTAGGED},
+        m_freeNodes{nullptr},
+        m_freeNodeCount{0},
+        m_shutdown{false} {
+    for (size_t j = 0; j < INITIAL_NODE_COUNT; j++) {
+        releaseNodeLocked(new Node());
+    }
+}
+
+TaskQueue::~TaskQueue() {
+    while (m_head != nullptr) {
+        auto next = m_head->next;
+        delete m_head;
+        m_head = next;
+    }
+    while (m_freeNodes != nullptr) {
+        auto next = m_freeNodes->next;
+        delete m_freeNodes;
+        m_freeNodes = next;
+    }
+}
+
+bool TaskQueue::enqueue(bool front, UniqueTask&& task) {
+    // the submitting call site is the caller of the inlined submit or post template
+    const void* callSite = nullptr;
+#if defined(__GNUC__)
+    if (m_stats != nullptr) {
+        callSite = __builtin_return_address(0);
+    }
+#endif
+    auto module = MemoryAccounting::getCurrentModule();
+
+    {
+        std::lock_guard<std::mutex> queueLock{m_queueMutex};
+        if (m_shutdown) {
+            return false;
+        }
+
+        Node* node = m_freeNodes;
+        if (node != nullptr) {
+            m_freeNodes = node->next;
+            m_freeNodeCount--;
+        } else {
+            node = new Node();
+        }
+        node->task = std::move(task);
+        node->next = nullptr;
+        node->module = module != MemoryAccounting::UNTAGGED ? module : m_module;
+        if (m_stats != nullptr) {
+            node->queued = ExecutorStats::Clock::now();
+            node->callSite = callSite;
+        }
+
+        if (m_head == nullptr) {
+            m_head = m_tail = node;
+        } else if (front) {
+            node->next = m_head;
+            m_head = node;
+        } else {
+            m_tail->next = node;
+            m_tail = node;
+        }
+        m_size++;
+
+        if (m_stats != nullptr) {
+            m_stats->taskQueued(m_size);
+        }
+    }
+
+    m_queueChanged.notify_all();
+    return true;
+}
+
+UniqueTask TaskQueue::dequeueLocked(bool run) {
+    auto node = m_head;
+    m_head = node->next;
+    if (m_head == nullptr) {
+        m_tail = nullptr;
+    }
+    m_size--;
+
+    if (run && m_stats != nullptr) {
+        m_stats->taskStarted(node->queued, node->callSite, m_size);
+    }
+    if (run) {
+        MemoryAccounting::setCurrentModule(node->module);
+    }
+
+    auto task = std::move(node->task);
+    releaseNodeLocked(node);
+    return task;
 }
 
-std::unique_ptr<std::function<void()>> TaskQueue::pop() {
+void TaskQueue::releaseNodeLocked(Node* node) {
+    if (m_freeNodeCount >= MAX_FREE_NODE_COUNT) {
+        delete node;
+        return;
+    }
+    node->next = m_freeNodes;
+    m_freeNodes = node;
+    m_freeNodeCount++;
+}
+
+UniqueTask TaskQueue::pop() {
     std::unique_lock<std::mutex> queueLock{m_queueMutex};
 
-    auto shouldNotWait = [this]() { return m_shutdown || !m_queue.empty(); };
+    auto shouldNotWait = [this]() { return m_shutdown || m_head != nullptr; };
 
     if (!shouldNotWait()) {
         m_queueChanged.wait(queueLock, shouldNotWait);
     }
 
-    if (!m_queue.empty()) {
-        auto task = std::move(m_queue.front());
+    if (m_head != nullptr) {
+        return dequeueLocked(true);
+    }
 
-        m_queue.pop_front();
-        return task;
+    return UniqueTask();
+}
+
+UniqueTask TaskQueue::tryPop() {
+    std::lock_guard<std::mutex> queueLock{m_queueMutex};
+    if (m_head == nullptr) {
+        return UniqueTask();
     }
 
-    return nullptr;
+    return dequeueLocked(true);
 }
 
 void TaskQueue::shutdown() {
     std::lock_guard<std::mutex> queueLock{m_queueMutex};
-    m_queue.clear();
+    while (m_head != nullptr) {
+        dequeueLocked(false);
+    }
+    if (m_stats != nullptr) {
+        m_stats->taskQueued(0);
+    }
     m_shutdown = true;
     m_queueChanged.notify_all();
 }
 
+void TaskQueue::taskCompleted() {
+    if (m_stats != nullptr) {
+        m_stats->taskCompleted();
+    }
+    MemoryAccounting::setCurrentModule(MemoryAccounting::getThreadModule());
+}
+
+std::shared_ptr<ExecutorStats> TaskQueue::getStats() const {
+    return m_stats;
+}
+
 bool TaskQueue::isShutdown() {
     return m_shutdown;
 }
 
+size_t TaskQueue::size() {
+    std::lock_guard<std::mutex> queueLock{m_queueMutex};
+    return m_size;
+}
+
 }  // namespace threading
 }  // namespace utils
 }  // namespace engine
@@ -14,13 +14,15 @@
  */
 
 #include <AACE/Engine/Utils/Threading/TaskThread.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
 
 namespace aace {
 namespace engine {
 namespace utils {
 namespace threading {
 
-TaskThread::TaskThread(std::shared_ptr<TaskQueue> taskQueue) : m_taskQueue{taskQueue}, m_shutdown{false} {
+TaskThread::TaskThread(std::shared_ptr<TaskQueue> taskQueue, const std::string& name) :
+        m_taskQueue{taskQueue}, m_name{name}, m_shutdown{false} {
 }
 
 TaskThread::~TaskThread() {
@@ -40,6 +42,11 @@ bool TaskThread::isShutdown() {
 }
 
 void TaskThread::processTasksLoop() {
+    std::unique_ptr<ThreadPolicy::ScopedThread> scopedThread;
+    if (!m_name.empty()) {
+        scopedThread.reset(new ThreadPolicy::ScopedThread(m_name));
+    }
+
     while (!m_shutdown) {
         auto m_actualTaskQueue = m_taskQueue.lock();
 
@@ -47,7 +54,8 @@ void TaskThread::processTasksLoop() {
             auto task = m_actualTaskQueue->pop();
 
             if (task) {
-                task->operator()();
+                task();
+                m_actualTaskQueue->taskCompleted();
             }
         } else {
             // Since we could not get a shared pointer to the the TaskQueue, it must have been destroyed.
@@ -0,0 +1,237 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+#include <AACE/Engine/Utils/Memory/MemoryAccounting.h>
+#include <AACE/Engine/Utils/Trace/EngineTrace.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.utils.threading.ThreadPolicy");
+
+using MemoryAccounting = aace::engine::utils::memory::MemoryAccounting;
+
+namespace {
+
+/// The policies and the registered threads
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::pair<std::string, ThreadPolicy::Policy>> policies;
+    std::unordered_map<long, std::string> threads;
+};
+
+}  // namespace
+
+static Registry& registry() {
+    // never destroyed, so threads exiting during static destruction can still unregister
+    static Registry* s_registry = new Registry();
+    return *s_registry;
+}
+
+/// Returns the kernel id of the calling thread.
+static long currentThreadId() {
+#if defined(__linux__)
+    return static_cast<long>(syscall(SYS_gettid));
+#else
+    return 0;
+#endif
+}
+
+/// Returns the pattern matching a thread name best, or @c nullptr. The registry mutex must be held.
+static const std::pair<std::string, ThreadPolicy::Policy>* findPolicyLocked(
+    Registry& policies,
+    const std::string& name) {
+    const std::pair<std::string, ThreadPolicy::Policy>* best = nullptr;
+    for (auto& next : policies.policies) {
+        if (next.first == name) {
+            return &next;
+        }
+        if (ThreadPolicy::matches(next.first, name) && (best == nullptr || next.first.size() > best->first.size())) {
+            best = &next;
+        }
+    }
+    return best;
+}
+
+/// Applies a policy to a thread, and logs the settings that fail.
+static void applyPolicy(long tid, const std::string& name, const ThreadPolicy::Policy& policy) {
+#if defined(__linux__)
+    if (!policy.cpus.empty()) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (auto cpu : policy.cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        if (sched_setaffinity(static_cast<pid_t>(tid), sizeof(cpus), &cpus) != 0) {
+            AACE_WARN(LX(TAG).d("reason", "setAffinityFailed").d("thread", name).d("error", std::strerror(errno)));
+        }
+    }
+
+    if (policy.scheduling != ThreadPolicy::Scheduling::DEFAULT) {
+        int scheduling = SCHED_OTHER;
+        sched_param param{};
+        if (policy.scheduling == ThreadPolicy::Scheduling::FIFO) {
+            scheduling = SCHED_FIFO;
+            param.sched_priority = policy.priority;
+        } else if (policy.scheduling == ThreadPolicy::Scheduling::RR) {
+            scheduling = SCHED_RR;
+            param.sched_priority = policy.priority;
+        }
+        if (sched_setscheduler(static_cast<pid_t>(tid), scheduling, &param) != 0) {
+            AACE_WARN(LX(TAG)
+                          .d("reason", "setSchedulerFailed")
+                          .d("thread", name)
+                          .d("priority", param.sched_priority)
+                          .d("error", std::strerror(errno)));
+        }
+    }
+
+    if (policy.hasNice) {
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(tid), policy.nice) != 0) {
+            AACE_WARN(LX(TAG)
+                          .d("reason", "setNiceFailed")
+                          .d("thread", name)
+                          .d("nice", policy.nice)
+                          .d("error", std::strerror(errno)));
+        }
+    }
+    AACE_DEBUG(LX(TAG).m("policyApplied").d("thread", name).d("tid", tid));
+#else
+    AACE_WARN(LX(TAG).d("reason", "threadPolicyNotSupported").d("thread", name));
+#endif
+}
+
+ThreadPolicy::ScopedThread::ScopedThread(const std::string& name) {
+    registerCurrentThread(name);
+    MemoryAccounting::setThreadModule(name);
+    aace::engine::utils::trace::EngineTrace::setCurrentThreadName(name);
+}
+
+ThreadPolicy::ScopedThread::~ScopedThread() {
+    MemoryAccounting::setThreadModule("");
+    unregisterCurrentThread();
+}
+
+void ThreadPolicy::setPolicy(const std::string& pattern, const Policy& policy) {
+    std::vector<std::pair<long, std::string>> threads;
+    {
+        auto& policies = registry();
+        std::lock_guard<std::mutex> lock(policies.mutex);
+        auto it = std::find_if(
+            policies.policies.begin(), policies.policies.end(), [&pattern](const std::pair<std::string, Policy>& next) {
+                return next.first == pattern;
+            });
+        if (it != policies.policies.end()) {
+            it->second = policy;
+        } else {
+            policies.policies.emplace_back(pattern, policy);
+        }
+
+        // the running threads whose best match is the new policy
+        for (auto& next : policies.threads) {
+            auto best = findPolicyLocked(policies, next.second);
+            if (best != nullptr && best->first == pattern) {
+                threads.emplace_back(next.first, next.second);
+            }
+        }
+    }
+
+    for (auto& next : threads) {
+        applyPolicy(next.first, next.second, policy);
+    }
+}
+
+void ThreadPolicy::clearPolicies() {
+    auto& policies = registry();
+    std::lock_guard<std::mutex> lock(policies.mutex);
+    policies.policies.clear();
+}
+
+void ThreadPolicy::registerCurrentThread(const std::string& name) {
+    auto tid = currentThreadId();
+    Policy policy;
+    bool found = false;
+    {
+        auto& policies = registry();
+        std::lock_guard<std::mutex> lock(policies.mutex);
+        policies.threads[tid] = name;
+        auto best = findPolicyLocked(policies, name);
+        if (best != nullptr) {
+            policy = best->second;
+            found = true;
+        }
+    }
+
+    if (found) {
+        applyPolicy(tid, name, policy);
+    }
+}
+
+void ThreadPolicy::unregisterCurrentThread() {
+    auto& policies = registry();
+    std::lock_guard<std::mutex> lock(policies.mutex);
+    policies.threads.erase(currentThreadId());
+}
+
+bool ThreadPolicy::parseScheduling(const std::string& name, Scheduling& scheduling) {
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (lower == "default") {
+        scheduling = Scheduling::DEFAULT;
+    } else if (lower == "other") {
+        scheduling = Scheduling::OTHER;
+    } else if (lower == "fifo") {
+        scheduling = Scheduling::FIFO;
+    } else if (lower == "rr") {
+        scheduling = Scheduling::RR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ThreadPolicy::matches(const std::string& pattern, const std::string& name) {
+    if (!pattern.empty() && pattern.back() == '*') {
+        return name.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0;
+    }
+    return pattern == name;
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AACE/Engine/Utils/Threading/ThreadPool.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+/// Minimum number of worker threads of the default thread pool
+static const size_t MIN_DEFAULT_THREAD_COUNT = 2;
+
+/// The pool and worker index of the current thread, if it is a worker thread
+static thread_local const void* s_currentPool = nullptr;
+static thread_local size_t s_currentWorker = 0;
+
+std::shared_ptr<ThreadPool> ThreadPool::create(size_t threadCount, const std::string& name) {
+    if (threadCount == 0) {
+        return nullptr;
+    }
+    return std::shared_ptr<ThreadPool>(new ThreadPool(threadCount, name));
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::getDefault() {
+    static std::shared_ptr<ThreadPool> s_defaultPool(
+        new ThreadPool(std::max<size_t>(MIN_DEFAULT_THREAD_COUNT, std::thread::hardware_concurrency()), "ThreadPool"));
+    return s_defaultPool;
+}
+
+ThreadPool::ThreadPool(size_t threadCount, const std::string& name) : m_name{name} {
+    for (size_t j = 0; j < threadCount; j++) {
+        m_workers.emplace_back(new Worker());
+    }
+    for (size_t j = 0; j < threadCount; j++) {
+        m_workers[j]->thread = std::thread(&ThreadPool::run, this, j);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    shutdown();
+}
+
+bool ThreadPool::post(Task task) {
+    if (m_shutdown) {
+        return false;
+    }
+
+    if (s_currentPool == this) {
+        // keep the task on the posting worker, where the data it uses is likely cached
+        auto& worker = *m_workers[s_currentWorker];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+
+    // pairs with the idle worker count and check in run() so either the worker sees the task or
+    // we see the worker waiting
+    m_pendingTasks.fetch_add(1);
+    if (m_idleWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_taskAvailable.notify_one();
+    }
+
+    return true;
+}
+
+void ThreadPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_shutdown.exchange(true)) {
+            return;
+        }
+        m_taskAvailable.notify_all();
+    }
+
+    for (auto& next : m_workers) {
+        if (next->thread.get_id() == std::this_thread::get_id()) {
+            // a task is shutting down its own pool, and the worker must not use the pool once the task returns
+            next->thread.detach();
+            s_currentPool = nullptr;
+        } else if (next->thread.joinable()) {
+            next->thread.join();
+        }
+    }
+}
+
+size_t ThreadPool::getThreadCount() const {
+    return m_workers.size();
+}
+
+bool ThreadPool::isWorkerThread() const {
+    return s_currentPool == this;
+}
+
+bool ThreadPool::takeTask(size_t index, Task& task) {
+    // newest task of the worker's own queue
+    {
+        auto& worker = *m_workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.tasks.empty()) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // oldest task of the shared queue
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_tasks.empty()) {
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            return true;
+        }
+    }
+
+    // oldest task of another worker
+    for (size_t j = 1; j < m_workers.size(); j++) {
+        auto& victim = *m_workers[(index + j) % m_workers.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (lock.owns_lock() && !victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run(size_t index) {
+    s_currentPool = this;
+    s_currentWorker = index;
+
+    std::unique_ptr<ThreadPolicy::ScopedThread> scopedThread;
+    if (!m_name.empty()) {
+        scopedThread.reset(new ThreadPolicy::ScopedThread(m_name + "." + std::to_string(index)));
+    }
+
+    Task task;
+    while (!m_shutdown) {
+        if (m_pendingTasks.load() > 0) {
+            if (takeTask(index, task)) {
+                m_pendingTasks.fetch_sub(1);
+                task();
+                task.reset();
+                if (s_currentPool != this) {
+                    // the task released the last reference to the pool, which is destroyed
+                    return;
+                }
+            } else {
+                // the task is being taken by another worker, or its queue is locked
+                std::this_thread::yield();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idleWorkers.fetch_add(1);
+        m_taskAvailable.wait(lock, [this]() { return m_pendingTasks.load() > 0 || m_shutdown; });
+        m_idleWorkers.fetch_sub(1);
+    }
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,331 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace threading {
+
+const TimerWheel::TimerId TimerWheel::INVALID_TIMER;
+const int TimerWheel::SLOT_BITS;
+const size_t TimerWheel::SLOT_COUNT;
+const uint64_t TimerWheel::SLOT_MASK;
+const int TimerWheel::LEVEL_COUNT;
+
+/// The tick returned when the timer thread has no timer to wake up for
+static const uint64_t NO_TICK = std::numeric_limits<uint64_t>::max();
+
+std::shared_ptr<TimerWheel> TimerWheel::create(std::chrono::milliseconds tick) {
+    if (tick.count() <= 0) {
+        return nullptr;
+    }
+    return std::shared_ptr<TimerWheel>(new TimerWheel(tick));
+}
+
+std::shared_ptr<TimerWheel> TimerWheel::getDefault() {
+    static std::shared_ptr<TimerWheel> s_defaultTimerWheel(new TimerWheel(std::chrono::milliseconds(10), "TimerWheel"));
+    return s_defaultTimerWheel;
+}
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, const std::string& name) :
+        m_tick{tick},
+        m_start{Clock::now()},
+        m_name{name},
+        m_currentTick{0},
+        m_nextId{INVALID_TIMER + 1},
+        m_shutdown{false} {
+    m_thread = std::thread(&TimerWheel::run, this);
+}
+
+TimerWheel::~TimerWheel() {
+    shutdown();
+}
+
+uint64_t TimerWheel::toTick(Clock::time_point time) const {
+    if (time <= m_start) {
+        return 0;
+    }
+    return static_cast<uint64_t>((time - m_start + m_tick - Clock::duration(1)) / m_tick);
+}
+
+TimerWheel::TimerId TimerWheel::submitAfter(Clock::duration delay, UniqueTask task) {
+    return submitAt(Clock::now() + delay, std::move(task));
+}
+
+TimerWheel::TimerId TimerWheel::submitAt(Clock::time_point deadline, UniqueTask task) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return addTimerLocked(toTick(deadline), 0, std::move(task));
+}
+
+TimerWheel::TimerId TimerWheel::submitPeriodic(Clock::duration period, UniqueTask task, Clock::duration initialDelay) {
+    auto periodTicks = std::max<uint64_t>(1, toTick(m_start + period));
+    auto deadline = Clock::now() + (initialDelay < Clock::duration::zero() ? period : initialDelay);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return addTimerLocked(toTick(deadline), periodTicks, std::move(task));
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    std::unique_ptr<Timer> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_timers.find(id);
+        if (it == m_timers.end()) {
+            return false;
+        }
+
+        auto timer = it->second.get();
+        if (timer->slot == nullptr) {
+            // the task is running, the timer thread removes the timer when it returns
+            bool pending = timer->period != 0 && !timer->cancelled;
+            timer->cancelled = true;
+            return pending;
+        }
+
+        unlinkLocked(timer);
+        cancelled = std::move(it->second);
+        m_timers.erase(it);
+    }
+
+    // the task is destroyed without the lock, in case it holds the last reference to an owner of a timer
+    return true;
+}
+
+void TimerWheel::shutdown() {
+    std::vector<std::unique_ptr<Timer>> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_shutdown.exchange(true)) {
+            return;
+        }
+
+        for (auto it = m_timers.begin(); it != m_timers.end();) {
+            if (it->second->slot != nullptr) {
+                unlinkLocked(it->second.get());
+                cancelled.push_back(std::move(it->second));
+                it = m_timers.erase(it);
+            } else {
+                it->second->cancelled = true;
+                ++it;
+            }
+        }
+        m_wakeup.notify_one();
+    }
+    cancelled.clear();
+
+    if (m_thread.joinable()) {
+        if (m_thread.get_id() == std::this_thread::get_id()) {
+            // a task is shutting down its own timer wheel
+            m_thread.detach();
+        } else {
+            m_thread.join();
+        }
+    }
+}
+
+size_t TimerWheel::size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_timers.size();
+}
+
+TimerWheel::TimerId TimerWheel::addTimerLocked(uint64_t expiry, uint64_t period, UniqueTask&& task) {
+    if (m_shutdown) {
+        return INVALID_TIMER;
+    }
+
+    if (m_timers.empty()) {
+        // the timer thread stops counting ticks while there is no timer
+        m_currentTick = std::max(m_currentTick, static_cast<uint64_t>((Clock::now() - m_start) / m_tick));
+    }
+
+    std::unique_ptr<Timer> timer(new Timer());
+    timer->id = m_nextId++;
+    timer->expiry = std::max(expiry, m_currentTick + 1);
+    timer->period = period;
+    timer->task = std::move(task);
+    insertLocked(timer.get());
+
+    auto id = timer->id;
+    m_timers.emplace(id, std::move(timer));
+
+    // the timer thread may be waiting for a later tick
+    m_wakeup.notify_one();
+    return id;
+}
+
+void TimerWheel::insertLocked(Timer* timer) {
+    // the level is the one whose slots cover the remaining ticks, the timers beyond the last level are
+    // kept in its farthest slot and moved again when the slot is reached
+    uint64_t maxDelta = (uint64_t(1) << (SLOT_BITS * LEVEL_COUNT)) - 1;
+    uint64_t delta = std::min(timer->expiry - m_currentTick, maxDelta);
+    int level = 0;
+    while (level < LEVEL_COUNT - 1 && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+
+    auto index = ((m_currentTick + delta) >> (SLOT_BITS * level)) & SLOT_MASK;
+    auto& slot = m_wheel[level][index];
+    timer->level = level;
+    timer->slot = &slot;
+    timer->previous = nullptr;
+    timer->next = slot;
+    if (slot != nullptr) {
+        slot->previous = timer;
+    }
+    slot = timer;
+    m_levelCounts[level]++;
+}
+
+void TimerWheel::unlinkLocked(Timer* timer) {
+    if (timer->previous != nullptr) {
+        timer->previous->next = timer->next;
+    } else {
+        *timer->slot = timer->next;
+    }
+    if (timer->next != nullptr) {
+        timer->next->previous = timer->previous;
+    }
+    m_levelCounts[timer->level]--;
+    timer->slot = nullptr;
+    timer->previous = nullptr;
+    timer->next = nullptr;
+}
+
+void TimerWheel::cascadeLocked(int level, size_t index) {
+    auto timer = m_wheel[level][index];
+    m_wheel[level][index] = nullptr;
+    while (timer != nullptr) {
+        auto next = timer->next;
+        m_levelCounts[level]--;
+        insertLocked(timer);
+        timer = next;
+    }
+}
+
+void TimerWheel::processTickLocked(std::vector<Timer*>& expired) {
+    // move the timers of the higher levels down when the levels below have turned, highest level first
+    if ((m_currentTick & SLOT_MASK) == 0) {
+        int level = 1;
+        while (level < LEVEL_COUNT - 1 && ((m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK) == 0) {
+            level++;
+        }
+        for (; level > 0; level--) {
+            cascadeLocked(level, (m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK);
+        }
+    }
+
+    auto timer = m_wheel[0][m_currentTick & SLOT_MASK];
+    while (timer != nullptr) {
+        auto next = timer->next;
+        if (timer->expiry <= m_currentTick) {
+            unlinkLocked(timer);
+            expired.push_back(timer);
+        }
+        timer = next;
+    }
+}
+
+uint64_t TimerWheel::nextWakeupTickLocked() const {
+    uint64_t next = NO_TICK;
+    if (m_levelCounts[0] > 0) {
+        for (uint64_t delta = 1; delta < SLOT_COUNT; delta++) {
+            if (m_wheel[0][(m_currentTick + delta) & SLOT_MASK] != nullptr) {
+                next = m_currentTick + delta;
+                break;
+            }
+        }
+    }
+
+    // wake up when the first level turns to move the timers of the higher levels down
+    for (int level = 1; level < LEVEL_COUNT; level++) {
+        if (m_levelCounts[level] > 0) {
+            next = std::min(next, (m_currentTick | SLOT_MASK) + 1);
+            break;
+        }
+    }
+
+    return next;
+}
+
+void TimerWheel::run() {
+    std::unique_ptr<ThreadPolicy::ScopedThread> scopedThread;
+    if (!m_name.empty()) {
+        scopedThread.reset(new ThreadPolicy::ScopedThread(m_name));
+    }
+
+    std::vector<Timer*> expired;
+    std::vector<std::unique_ptr<Timer>> finished;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_shutdown) {
+        // process the ticks that have elapsed, skipping the ticks with nothing to do
+        auto now = Clock::now();
+        auto nowTick = static_cast<uint64_t>((now - m_start) / m_tick);
+        while (m_currentTick < nowTick) {
+            m_currentTick = std::min(nowTick, nextWakeupTickLocked());
+            processTickLocked(expired);
+        }
+
+        if (expired.empty()) {
+            auto next = nextWakeupTickLocked();
+            if (next == NO_TICK) {
+                m_wakeup.wait(lock);
+            } else {
+                m_wakeup.wait_until(lock, m_start + m_tick * next);
+            }
+            continue;
+        }
+
+        // the expired timers stay in the timer map while their tasks run, so they can be cancelled
+        lock.unlock();
+        for (auto timer : expired) {
+            timer->task();
+        }
+        lock.lock();
+
+        for (auto timer : expired) {
+            if (timer->period != 0 && !timer->cancelled) {
+                // skip the runs that were missed
+                timer->expiry += timer->period;
+                if (timer->expiry <= m_currentTick) {
+                    timer->expiry += ((m_currentTick - timer->expiry) / timer->period + 1) * timer->period;
+                }
+                insertLocked(timer);
+            } else {
+                auto it = m_timers.find(timer->id);
+                finished.push_back(std::move(it->second));
+                m_timers.erase(it);
+            }
+        }
+        expired.clear();
+
+        if (!finished.empty()) {
+            lock.unlock();
+            finished.clear();
+            lock.lock();
+        }
+    }
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/JSON/JSON.h>
+#include <AACE/Engine/Utils/Trace/BootTrace.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace trace {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.engine.utils.trace.BootTrace");
+
+/// The most events recorded, so a trace left recording doesn't grow without bound.
+static const size_t MAX_EVENTS = 10000;
+
+/// The process id of the events, the trace only has the engine process.
+static const int TRACE_PID = 1;
+
+namespace {
+
+struct Event {
+    std::string name;
+    std::string category;
+    BootTrace::Clock::time_point start;
+    BootTrace::Clock::time_point end;
+    int tid;
+};
+
+struct TraceState {
+    std::mutex mutex;
+    std::atomic<bool> recording{false};
+    BootTrace::Clock::time_point origin;
+    std::vector<Event> events;
+    size_t droppedEvents = 0;
+    // the events are numbered by thread in the order the threads first record one
+    std::map<std::thread::id, int> threads;
+};
+
+TraceState& getState() {
+    static TraceState s_state;
+    return s_state;
+}
+
+}  // namespace
+
+BootTrace::Scope::Scope(const std::string& name, const std::string& category) :
+        m_name(name), m_category(category), m_recording(isRecording()), m_start(Clock::now()) {
+}
+
+BootTrace::Scope::~Scope() {
+    if (m_recording) {
+        record(m_name, m_category, m_start, Clock::now());
+    }
+}
+
+void BootTrace::start() {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.events.clear();
+    state.threads.clear();
+    state.droppedEvents = 0;
+    state.origin = Clock::now();
+    state.recording = true;
+}
+
+void BootTrace::stop() {
+    getState().recording = false;
+}
+
+bool BootTrace::isRecording() {
+    return getState().recording;
+}
+
+void BootTrace::record(
+    const std::string& name,
+    const std::string& category,
+    Clock::time_point start,
+    Clock::time_point end) {
+    auto& state = getState();
+    if (!state.recording) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.events.size() >= MAX_EVENTS) {
+        state.droppedEvents++;
+        return;
+    }
+    auto it = state.threads.emplace(std::this_thread::get_id(), static_cast<int>(state.threads.size() + 1)).first;
+    state.events.push_back({name, category, start, end, it->second});
+}
+
+std::string BootTrace::toJson() {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    json::Value traceEvents = json::Value::array();
+    traceEvents.push_back(
+        {{"name", "process_name"}, {"ph", "M"}, {"pid", TRACE_PID}, {"args", {{"name", "Auto SDK Engine"}}}});
+    for (auto& event : state.events) {
+        // the times of the trace event format are in microseconds
+        auto ts = std::chrono::duration_cast<std::chrono::microseconds>(event.start - state.origin).count();
+        auto dur = std::chrono::duration_cast<std::chrono::microseconds>(event.end - event.start).count();
+        traceEvents.push_back(
+            {{"name", event.name},
+             {"cat", event.category},
+             {"ph", "X"},
+             {"ts", ts},
+             {"dur", dur},
+             {"pid", TRACE_PID},
+             {"tid", event.tid}});
+    }
+
+    json::Value trace = {
+        {"traceEvents", traceEvents},
+        {"displayTimeUnit", "ms"},
+        {"otherData", {{"droppedEvents", state.droppedEvents}}}};
+    return trace.dump();
+}
+
+bool BootTrace::exportTrace(const std::string& path) {
+    try {
+        std::ofstream file(path, std::ios::trunc);
+        ThrowIfNot(file.is_open(), "openFileFailed");
+        file << toJson();
+        file.close();
+        ThrowIf(file.fail(), "writeFileFailed");
+
+        AACE_INFO(LX(TAG, "exportTrace").d("path", path));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "exportTrace").d("reason", ex.what()).d("path", path));
+        return false;
+    }
+}
+
+}  // namespace trace
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
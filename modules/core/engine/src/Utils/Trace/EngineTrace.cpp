@@ -0,0 +1,339 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/JSON/JSON.h>
+#include <AACE/Engine/Utils/Trace/EngineTrace.h>
+
+namespace aace {
+namespace engine {
+namespace utils {
+namespace trace {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.engine.utils.trace.EngineTrace");
+
+/// The process id of the exported events, the trace only has the engine process.
+static const int TRACE_PID = 1;
+
+/// The ftrace markers, in the order they are tried
+static const char* FTRACE_MARKERS[] = {"/sys/kernel/tracing/trace_marker", "/sys/kernel/debug/tracing/trace_marker"};
+
+const size_t EngineTrace::DEFAULT_EVENTS_PER_THREAD;
+const size_t EngineTrace::MAX_NAME_LENGTH;
+
+std::atomic<bool> EngineTrace::s_recording{false};
+
+namespace {
+
+struct Event {
+    int64_t timestamp;
+    int64_t value;
+    const char* category;
+    char phase;
+    char name[EngineTrace::MAX_NAME_LENGTH + 1];
+};
+
+/**
+ * The events of a thread. Only the thread writes its events, and it publishes each event by incrementing
+ * @c count, so the events below @c count can be read without a lock while the thread records the next ones.
+ */
+struct ThreadBuffer {
+    std::vector<Event> events;
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> droppedEvents{0};
+    // the trace the events belong to, the buffer is cleared by its thread when a new trace starts
+    std::atomic<uint64_t> generation{0};
+    std::atomic<bool> exited{false};
+    int tid = 0;
+    // guarded by the mutex of the trace state
+    std::string name;
+};
+
+struct TraceState {
+    std::mutex mutex;
+    std::atomic<uint64_t> generation{0};
+    std::atomic<size_t> eventsPerThread{EngineTrace::DEFAULT_EVENTS_PER_THREAD};
+    std::atomic<int> ftraceFd{-1};
+    EngineTrace::Clock::time_point origin;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    // the threads are numbered in the order they first record an event
+    int nextTid = 1;
+};
+
+TraceState& getState() {
+    static TraceState s_state;
+    return s_state;
+}
+
+/// Owns the buffer of a thread, and releases it once the thread exits and the buffer is no longer exported
+struct ThreadBufferHolder {
+    std::shared_ptr<ThreadBuffer> buffer;
+    std::string name;
+
+    ~ThreadBufferHolder() {
+        if (buffer != nullptr) {
+            buffer->exited = true;
+        }
+    }
+};
+
+ThreadBufferHolder& getThreadBufferHolder() {
+    static thread_local ThreadBufferHolder t_holder;
+    return t_holder;
+}
+
+ThreadBuffer* getThreadBuffer() {
+    auto& holder = getThreadBufferHolder();
+    if (holder.buffer == nullptr) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        buffer->name = holder.name;
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        buffer->tid = state.nextTid++;
+        state.buffers.push_back(buffer);
+        holder.buffer = buffer;
+    }
+    return holder.buffer.get();
+}
+
+int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(EngineTrace::Clock::now().time_since_epoch()).count();
+}
+
+void writeFtrace(int fd, char phase, const char* name, size_t nameLength, int64_t value) {
+    static const int s_pid = static_cast<int>(getpid());
+    char marker[EngineTrace::MAX_NAME_LENGTH + 64];
+    int length = 0;
+    auto nameWidth = static_cast<int>(nameLength);
+    if (phase == 'B') {
+        length = snprintf(marker, sizeof(marker), "B|%d|%.*s", s_pid, nameWidth, name);
+    } else if (phase == 'E') {
+        length = snprintf(marker, sizeof(marker), "E|%d", s_pid);
+    } else {
+        length = snprintf(
+            marker, sizeof(marker), "C|%d|%.*s|%lld", s_pid, nameWidth, name, static_cast<long long>(value));
+    }
+    if (length > 0) {
+        // a marker that can't be written is dropped, the trace point must not block the thread
+        auto written = ::write(fd, marker, std::min(static_cast<size_t>(length), sizeof(marker) - 1));
+        (void)written;
+    }
+}
+
+}  // namespace
+
+EngineTrace::Scope::Scope(const char* category, const char* name) :
+        m_category(category), m_recording(isRecording()) {
+    if (m_recording) {
+        begin(category, name);
+    }
+}
+
+EngineTrace::Scope::Scope(const char* category, const std::string& name) :
+        m_category(category), m_recording(isRecording()) {
+    if (m_recording) {
+        begin(category, name);
+    }
+}
+
+EngineTrace::Scope::~Scope() {
+    if (m_recording) {
+        end(m_category);
+    }
+}
+
+bool EngineTrace::start(size_t eventsPerThread, Output output) {
+    try {
+        ThrowIf(eventsPerThread == 0, "invalidEventsPerThread");
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (output == Output::FTRACE) {
+            // the marker stays open, since a thread may still be writing to it after the trace stops
+            if (state.ftraceFd < 0) {
+                for (auto marker : FTRACE_MARKERS) {
+                    state.ftraceFd = ::open(marker, O_WRONLY | O_CLOEXEC);
+                    if (state.ftraceFd >= 0) {
+                        break;
+                    }
+                }
+            }
+            ThrowIf(state.ftraceFd < 0, "openFtraceMarkerFailed");
+        }
+
+        // the buffers of the threads that exited since the last trace are released
+        state.buffers.erase(
+            std::remove_if(
+                state.buffers.begin(),
+                state.buffers.end(),
+                [](const std::shared_ptr<ThreadBuffer>& buffer) { return buffer->exited.load(); }),
+            state.buffers.end());
+        state.eventsPerThread = output == Output::FTRACE ? 0 : eventsPerThread;
+        state.origin = Clock::now();
+        state.generation++;
+        s_recording = true;
+
+        AACE_INFO(LX(TAG).d("eventsPerThread", eventsPerThread).d("ftrace", output == Output::FTRACE));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return false;
+    }
+}
+
+void EngineTrace::stop() {
+    s_recording = false;
+}
+
+void EngineTrace::begin(const char* category, const char* name) {
+    record('B', category, name, strlen(name), 0);
+}
+
+void EngineTrace::begin(const char* category, const std::string& name) {
+    record('B', category, name.c_str(), name.size(), 0);
+}
+
+void EngineTrace::end(const char* category) {
+    record('E', category, "", 0, 0);
+}
+
+void EngineTrace::counter(const char* category, const char* name, int64_t value) {
+    record('C', category, name, strlen(name), value);
+}
+
+void EngineTrace::setCurrentThreadName(const std::string& name) {
+    auto& holder = getThreadBufferHolder();
+    holder.name = name;
+    if (holder.buffer != nullptr) {
+        std::lock_guard<std::mutex> lock(getState().mutex);
+        holder.buffer->name = name;
+    }
+}
+
+void EngineTrace::record(char phase, const char* category, const char* name, size_t nameLength, int64_t value) {
+    if (!isRecording()) {
+        return;
+    }
+    auto& state = getState();
+    auto generation = state.generation.load(std::memory_order_acquire);
+    auto eventsPerThread = state.eventsPerThread.load(std::memory_order_relaxed);
+    nameLength = std::min(nameLength, MAX_NAME_LENGTH);
+    if (eventsPerThread == 0) {
+        writeFtrace(state.ftraceFd, phase, name, nameLength, value);
+        return;
+    }
+
+    auto buffer = getThreadBuffer();
+    if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+        // the first event of the thread since the trace started
+        buffer->events.resize(eventsPerThread);
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->droppedEvents.store(0, std::memory_order_relaxed);
+        buffer->generation.store(generation, std::memory_order_release);
+    }
+    auto index = buffer->count.load(std::memory_order_relaxed);
+    if (index >= buffer->events.size()) {
+        buffer->droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    auto& event = buffer->events[index];
+    event.timestamp = now();
+    event.value = value;
+    event.category = category;
+    event.phase = phase;
+    memcpy(event.name, name, nameLength);
+    event.name[nameLength] = '\0';
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+std::string EngineTrace::toJson() {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto generation = state.generation.load();
+    auto origin = std::chrono::duration_cast<std::chrono::nanoseconds>(state.origin.time_since_epoch()).count();
+
+    json::Value traceEvents = json::Value::array();
+    traceEvents.push_back(
+        {{"name", "process_name"}, {"ph", "M"}, {"pid", TRACE_PID}, {"args", {{"name", "Auto SDK Engine"}}}});
+    size_t droppedEvents = 0;
+    for (auto& buffer : state.buffers) {
+        if (buffer->generation.load(std::memory_order_acquire) != generation) {
+            continue;
+        }
+        if (!buffer->name.empty()) {
+            traceEvents.push_back(
+                {{"name", "thread_name"},
+                 {"ph", "M"},
+                 {"pid", TRACE_PID},
+                 {"tid", buffer->tid},
+                 {"args", {{"name", buffer->name}}}});
+        }
+        auto count = buffer->count.load(std::memory_order_acquire);
+        for (size_t index = 0; index < count; index++) {
+            auto& event = buffer->events[index];
+            // the times of the trace event format are in microseconds
+            json::Value next = {
+                {"ph", std::string(1, event.phase)},
+                {"cat", event.category},
+                {"ts", (event.timestamp - origin) / 1000.0},
+                {"pid", TRACE_PID},
+                {"tid", buffer->tid}};
+            if (event.phase != 'E') {
+                next["name"] = event.name;
+            }
+            if (event.phase == 'C') {
+                next["args"] = {{event.name, event.value}};
+            }
+            traceEvents.push_back(std::move(next));
+        }
+        droppedEvents += buffer->droppedEvents.load(std::memory_order_relaxed);
+    }
+
+    json::Value trace = {
+        {"traceEvents", traceEvents}, {"displayTimeUnit", "ms"}, {"otherData", {{"droppedEvents", droppedEvents}}}};
+    return trace.dump();
+}
+
+bool EngineTrace::exportTrace(const std::string& path) {
+    try {
+        std::ofstream file(path, std::ios::trunc);
+        ThrowIfNot(file.is_open(), "openFileFailed");
+        file << toJson();
+        file.close();
+        ThrowIf(file.fail(), "writeFileFailed");
+
+        AACE_INFO(LX(TAG, "exportTrace").d("path", path));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "exportTrace").d("reason", ex.what()).d("path", path));
+        return false;
+    }
+}
+
+}  // namespace trace
+}  // namespace utils
+}  // namespace engine
+}  // namespace aace
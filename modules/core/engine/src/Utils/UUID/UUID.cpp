@@ -14,122 +14,90 @@
  */
 
 #include <AACE/Engine/Utils/UUID/UUID.h>
-#include <AACE/Engine/Core/EngineMacros.h>
 
-#include <random>
-#include <chrono>
-#include <sstream>
-#include <iomanip>
-#include <mutex>
-#include <climits>
 #include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <random>
+#include <thread>
 
 namespace aace {
 namespace engine {
 namespace utils {
 namespace uuid {
 
-/// The UUID version (Version 4), shifted into the correct position in the byte.
-static const uint8_t UUID_VERSION_VALUE = 4 << 4;
+/// Number of random bytes in a UUID.
+static const size_t UUID_BYTE_COUNT = 16;
 
-/// The UUID variant (Variant 1), shifted into the correct position in the byte.
-static const size_t UUID_VARIANT_VALUE = 2 << 6;
+/// Length of the UUID text, with its four separators.
+static const size_t UUID_TEXT_LENGTH = 36;
 
-/// Separator used between UUID fields.
-static const std::string SEPARATOR("-");
+/// Index of the byte holding the UUID version.
+static const size_t UUID_VERSION_BYTE = 6;
 
-/// Number of bits in the replacement value.
-static const size_t MAX_NUM_REPLACEMENT_BITS = CHAR_BIT;
-
-/// Number of bits in a hex digit.
-static const size_t BITS_IN_HEX_DIGIT = 4;
+/// The UUID version (Version 4), shifted into the correct position in the byte.
+static const uint8_t UUID_VERSION_VALUE = 4 << 4;
 
-// String to identify log entries originating from this file.
-static const std::string TAG("aace.engine.utils.uuid.UUID");
+/// Index of the byte holding the UUID variant.
+static const size_t UUID_VARIANT_BYTE = 8;
 
-/**
- * Randomly generate a string of hex digits. Before the conversion of hex to string,
- * the function allows replacement of the bits of the first two generated hex digits.
- * Replacement happens starting at the most significant, to the least significant bit.
- *
- * @param ibe A random number generator.
- * @param numDigits The number of hex digits [0-9],[a-f] to generate.
- * @param replacementBits The replacement value for up to the first two digits generated.
- * @param numReplacementBits The number of bits of @c replacementBits to use.
- *
- * @return A hex string of length @c numDigits.
- */
-static const std::string generateHexWithReplacement(
-    std::independent_bits_engine<std::default_random_engine, CHAR_BIT, uint8_t>& ibe,
-    unsigned int numDigits,
-    uint8_t replacementBits,
-    unsigned short numReplacementBits) {
-    try {
-        ThrowIf(numReplacementBits > MAX_NUM_REPLACEMENT_BITS, "replacingMoreBitsThanProvided");
-        ThrowIf(numReplacementBits > (numDigits * BITS_IN_HEX_DIGIT), "replacingMoreBitsThanGenerated");
-
-        // Makes assumption that 1 digit = 4 bits.
-        std::vector<uint8_t> bytes(ceil(numDigits / 2.0));
-        std::generate(bytes.begin(), bytes.end(), std::ref(ibe));
-
-        // Replace the specified number of bits from the first byte.
-        bytes.at(0) &= (0xff >> numReplacementBits);
-        replacementBits &= (0xff << (MAX_NUM_REPLACEMENT_BITS - numReplacementBits));
-        bytes.at(0) |= replacementBits;
-
-        std::ostringstream oss;
-        for (const auto& byte : bytes) {
-            oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(byte);
-        }
+/// The UUID variant (Variant 1), shifted into the correct position in the byte.
+static const uint8_t UUID_VARIANT_VALUE = 2 << 6;
 
-        std::string bytesText = oss.str();
-        // Remove the last digit for odd numDigits case.
-        bytesText.resize(numDigits);
+/// Separator used between UUID fields.
+static const char SEPARATOR = '-';
 
-        return bytesText;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG, "generateHexWithReplacement").d("reason", ex.what()));
-        return std::string();
-    }
-}
+/// Lower case hex digits, indexed by their value.
+static const char HEX_DIGITS[] = "0123456789abcdef";
 
 /**
- * Randomly generate a string of hex digits.
- *
- * @param ibe A random number generator.
- * @param numDigits The number of hex digits [0-9],[a-f] to generate.
- *
- * @return A hex string of length @c numDigits.
+ * Returns the random number generator of the calling thread. Each thread seeds its own generator on its first UUID,
+ * so generating UUIDs never takes a lock.
  */
-static const std::string generateHex(
-    std::independent_bits_engine<std::default_random_engine, CHAR_BIT, uint8_t>& ibe,
-    unsigned int numDigits) {
-    return generateHexWithReplacement(ibe, numDigits, 0, 0);
+static std::mt19937_64& getGenerator() {
+    static thread_local std::mt19937_64 s_generator = []() {
+        std::random_device rd;
+        // the clock and the thread id are mixed in, since std::random_device may be deterministic on some platforms
+        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        auto threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+        std::seed_seq seed{rd(),
+                           rd(),
+                           rd(),
+                           rd(),
+                           static_cast<uint32_t>(now),
+                           static_cast<uint32_t>(static_cast<uint64_t>(now) >> 32),
+                           static_cast<uint32_t>(threadId),
+                           static_cast<uint32_t>(static_cast<uint64_t>(threadId) >> 32)};
+        return std::mt19937_64(seed);
+    }();
+    return s_generator;
 }
 
 const std::string generateUUID() {
-    static bool seeded = false;
-    static std::independent_bits_engine<std::default_random_engine, CHAR_BIT, uint8_t> ibe;
-    static std::mutex mutex;
-    std::unique_lock<std::mutex> lock(mutex);
-    if (!seeded) {
-        std::random_device rd;
-        ibe.seed(
-            rd() +
-            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
-                .count());
-        seeded = true;
+    auto& generator = getGenerator();
+    uint8_t bytes[UUID_BYTE_COUNT];
+    for (size_t i = 0; i < UUID_BYTE_COUNT; i += sizeof(uint64_t)) {
+        auto value = generator();
+        for (size_t j = 0; j < sizeof(uint64_t); j++) {
+            bytes[i + j] = static_cast<uint8_t>(value >> (j * 8));
+        }
     }
-
-    std::ostringstream uuidText;
-    uuidText << generateHex(ibe, 8) << SEPARATOR << generateHex(ibe, 4) << SEPARATOR
-             << generateHexWithReplacement(ibe, 4, UUID_VERSION_VALUE, 4) << SEPARATOR
-             << generateHexWithReplacement(ibe, 4, UUID_VARIANT_VALUE, 2) << SEPARATOR << generateHex(ibe, 12);
-
-    lock.unlock();
-
-    return uuidText.str();
+    bytes[UUID_VERSION_BYTE] = (bytes[UUID_VERSION_BYTE] & 0x0f) | UUID_VERSION_VALUE;
+    bytes[UUID_VARIANT_BYTE] = (bytes[UUID_VARIANT_BYTE] & 0x3f) | UUID_VARIANT_VALUE;
+
+    // xxxxxxxx-xxxx-Mxxx-Nxxx-xxxxxxxxxxxx, with a separator before the bytes 4, 6, 8 and 10
+    char text[UUID_TEXT_LENGTH];
+    size_t pos = 0;
+    for (size_t i = 0; i < UUID_BYTE_COUNT; i++) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) {
+            text[pos++] = SEPARATOR;
+        }
+        text[pos++] = HEX_DIGITS[bytes[i] >> 4];
+        text[pos++] = HEX_DIGITS[bytes[i] & 0x0f];
+    }
+    return std::string(text, UUID_TEXT_LENGTH);
 }
 
 bool compare(const std::string& uuid1, const std::string& uuid2) {
@@ -112,7 +112,8 @@ bool VehicleEngineService::registerProperties() {
                 std::placeholders::_2,
                 std::placeholders::_3,
                 std::placeholders::_4),
-            std::bind(&VehicleEngineService::getProperty_operatingCountry, this)));
+            std::bind(&VehicleEngineService::getProperty_operatingCountry, this),
+            true));
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -184,6 +185,9 @@ bool VehicleEngineService::configure(std::shared_ptr<std::istream> configuration
             m_vehicleInfoConfigured = true;
         }
 
+        // the properties do not change after configuration, so the metric data points are built once
+        buildMetricDataPoints();
+
         auto operatingCountry = json::get(root, "/operatingCountry", json::Type::string);
         if (operatingCountry != nullptr) {
             m_operatingCountry = operatingCountry;
@@ -235,15 +239,10 @@ std::string VehicleEngineService::getProperty_operatingCountry() {
     return m_operatingCountry;
 }
 
-std::shared_ptr<aace::engine::metrics::MetricEvent> VehicleEngineService::generateVehiclePropertiesMetric() {
-    std::string program = "AlexaAuto_Vehicle";
-    std::string source = "VehicleConfiguration";
-    std::shared_ptr<aace::engine::metrics::MetricEvent> currentMetric =
-        std::shared_ptr<aace::engine::metrics::MetricEvent>(new aace::engine::metrics::MetricEvent(program, source));
-    AACE_INFO(LX(TAG, "generateMetric").m("Added vehicle properties"));
+void VehicleEngineService::buildMetricDataPoints() {
+    m_metricDataPoints.clear();
     for (auto itr : m_vehiclePropertyMap) {
-        VehiclePropertyType property = itr.first;
-        std::string dataPointName = getPropertyAttributeForMetric(property);
+        std::string dataPointName = getPropertyAttributeForMetric(itr.first);
         std::string dataPointValue = itr.second;
 
         // sanitize any delimiter characters from dataPointValue to maintain metric formatting
@@ -252,7 +251,18 @@ std::shared_ptr<aace::engine::metrics::MetricEvent> VehicleEngineService::genera
             std::replace(dataPointValue.begin(), dataPointValue.end(), delimiter, '-');
         }
 
-        currentMetric->addString(dataPointName, dataPointValue);
+        m_metricDataPoints.emplace_back(dataPointName, dataPointValue);
+    }
+}
+
+std::shared_ptr<aace::engine::metrics::MetricEvent> VehicleEngineService::generateVehiclePropertiesMetric() {
+    std::string program = "AlexaAuto_Vehicle";
+    std::string source = "VehicleConfiguration";
+    std::shared_ptr<aace::engine::metrics::MetricEvent> currentMetric =
+        std::shared_ptr<aace::engine::metrics::MetricEvent>(new aace::engine::metrics::MetricEvent(program, source));
+    AACE_INFO(LX(TAG, "generateMetric").m("Added vehicle properties"));
+    for (const auto& dataPoint : m_metricDataPoints) {
+        currentMetric->addString(dataPoint.first, dataPoint.second);
     }
 
     return currentMetric;
@@ -107,6 +107,7 @@ public:
     virtual void onMediaStateChanged(MediaState state) = 0;
     virtual void onMediaError(MediaError error, const std::string& description) = 0;
     virtual void onAudioFocusEvent(FocusAction action) = 0;
+    virtual void onMediaPositionChanged(int64_t position) = 0;
 };
 
 inline std::ostream& operator<<(std::ostream& stream, const AudioOutputEngineInterface::MediaState& state) {
@@ -214,6 +214,24 @@ public:
      */
     virtual int64_t getNumBytesBuffered();
 
+    /**
+     * Notifies the platform implementation of the duration of audio to buffer before the playback of the next
+     * audio source starts, or resumes after a buffer underrun. The Engine calls it before @c prepare() when the
+     * adaptive buffering is enabled, with a longer duration after the recent playbacks of the channel on the
+     * current network ran out of buffered audio. The default implementation ignores the hint.
+     *
+     * @param [in] prebufferDuration The duration of audio to buffer in milliseconds
+     */
+    virtual void setBufferingHint(int64_t prebufferDuration);
+
+    /**
+     * Notifies the platform implementation to open the device of the channel and build its playback pipeline
+     * ahead of the first playback, and leave the channel idle, so that the first @c prepare() after the Engine starts
+     * is as fast as the following ones. The Engine calls it once, when the Engine starts, for the channels configured
+     * to be pre-warmed. The call must not block the Engine start. The default implementation ignores it.
+     */
+    virtual void prewarm();
+
     /**
      * Notifies the platform implementation to set the volume of the output channel. The
      * @c volume value should be scaled to fit the needs of the platform.
@@ -245,6 +263,16 @@ public:
      */
     void mediaStateChanged(MediaState state);
 
+    /**
+     * Notifies the Engine of the playback position of the platform media player. While the media is playing, the
+     * Engine interpolates the position from the last position reported, so the platform implementation may call
+     * this function periodically, such as every second, instead of the Engine calling @c getPosition() each time
+     * the playback state changes. The position should also be reported after a seek.
+     *
+     * @param [in] position The platform media player's playback position in milliseconds
+     */
+    void mediaPositionChanged(int64_t position);
+
     /**
      * Notifies the Engine of an error during audio playback
      *
@@ -16,6 +16,7 @@
 #ifndef AACE_AUDIO_AUDIO_STREAM_H
 #define AACE_AUDIO_AUDIO_STREAM_H
 
+#include <chrono>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -61,6 +62,20 @@ public:
      */
     virtual ssize_t read(char* data, const size_t size) = 0;
 
+    /**
+     * Reads audio data from the stream, waiting up to @c timeout for data to become available.
+     * The call returns as soon as any data is read or the stream is closed, so consumers don't
+     * have to poll @c read(). The default implementation polls @c read() at a short interval,
+     * and streams that can be notified when data arrives should override it.
+     *
+     * @param [out] data The buffer where audio data should be copied
+     * @param [in] size The size of the buffer
+     * @param [in] timeout The maximum time to wait for data
+     * @return The number of bytes read, 0 if the end of stream is reached or no data was available
+     * before the timeout, or -1 if an error occurred
+     */
+    virtual ssize_t timedRead(char* data, const size_t size, std::chrono::milliseconds timeout);
+
     /**
      * Checks if the audio stream from the no more data available to read.
      *
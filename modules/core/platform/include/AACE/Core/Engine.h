@@ -36,6 +36,28 @@ namespace core {
  */
 class Engine {
 public:
+    /**
+     * The memory pressure levels, in increasing severity
+     */
+    enum class MemoryPressureLevel {
+        /**
+         * The memory is not under pressure, the Engine caches and buffers grow back to their configured sizes
+         */
+        NORMAL,
+        /**
+         * The system is getting low on memory, the Engine trims its caches
+         */
+        MODERATE,
+        /**
+         * The system is low on memory, the Engine drops its caches and shrinks its buffers
+         */
+        LOW,
+        /**
+         * The process is about to be killed, the Engine releases all the memory it can do without
+         */
+        CRITICAL
+    };
+
     static std::shared_ptr<Engine> create();
 
     virtual ~Engine() = default;
@@ -85,6 +107,41 @@ public:
      */
     virtual bool stop() = 0;
 
+    /**
+     * Suspends the running Engine, such as when the device enters suspend-to-RAM or a short ignition cycle
+     *
+     * The Engine services close their network connections and pause their work, but they keep their state, so
+     * @c resume() restores them without setting them up again, which is much faster than @c start() after
+     * @c stop(). The Engine is still running while it is suspended, and it can be stopped or shut down.
+     *
+     * @return @c true if the Engine was suspended, else @c false. The services that suspended are resumed by
+     * @c resume() even if the Engine failed to suspend.
+     *
+     * @sa resume()
+     */
+    virtual bool suspend() = 0;
+
+    /**
+     * Resumes the suspended Engine, and reconnects to AVS
+     *
+     * @return @c true if the Engine was resumed, else @c false
+     *
+     * @sa suspend()
+     */
+    virtual bool resume() = 0;
+
+    /**
+     * Reports the memory pressure of the system, such as when Android calls @c onTrimMemory(), so the Engine
+     * caches and buffers shrink in priority order instead of the process being killed
+     *
+     * The level is shared by the Engines of the process, and applies until another level is reported. The
+     * platform reports the @c NORMAL level once the pressure is relieved, so the caches and buffers grow back.
+     *
+     * @param [in] level The memory pressure level
+     * @return @c true if the level was reported, else @c false
+     */
+    virtual bool reportMemoryPressure(MemoryPressureLevel level) = 0;
+
     /**
      * Shuts down the Engine and releases all of its resources
      *
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <functional>
+#include <vector>
 
 #include "MessageStream.h"
 
@@ -39,6 +40,16 @@ public:
      */
     virtual void publish(const std::string& message) = 0;
 
+    /**
+     * Publishes a batch of messages to the Engine. The messages are dispatched in order, with
+     * less overhead than publishing each message separately.
+     *
+     * @param [in] messages The messages.
+     * @param [in] coalesce If @c true, only the last message with each topic and action in the
+     *             batch is dispatched. Use this for state updates where only the latest value matters.
+     */
+    virtual void publishBatch(const std::vector<std::string>& messages, bool coalesce = false) = 0;
+
     /**
      * Subscribes to messages that are sent from the Engine.
      *
@@ -70,6 +70,16 @@ public:
      */
     void locationServiceAccessChanged(LocationServiceAccess access);
 
+    /**
+     * Notifies the Engine of a new geolocation of the device. Use this function to push the location
+     * each time the location service reports a new fix, so the Engine answers its location requests
+     * from the latest fix instead of calling @c getLocation(), as long as the fix is not older than
+     * the maximum age configured for the location cache.
+     *
+     * @param [in] location The new location
+     */
+    void locationChanged(const Location& location);
+
     /**
      * @internal
      * Sets the Engine interface delegate.
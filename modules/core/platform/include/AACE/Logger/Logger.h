@@ -18,6 +18,7 @@
 
 #include <string>
 #include <chrono>
+#include <vector>
 
 #include "AACE/Core/PlatformInterface.h"
 #include "LoggerEngineInterfaces.h"
@@ -64,6 +65,32 @@ public:
         const std::string& source,
         const std::string& message);
 
+    /**
+     * A log event from the AAC SDK logger
+     */
+    struct LogEvent {
+        /// The log level
+        Level level;
+        /// The timestamp of the logged message
+        std::chrono::system_clock::time_point time;
+        /// The source of the log message
+        std::string source;
+        /// The log message
+        std::string message;
+    };
+
+    /**
+     * Notifies the platform implementation of a batch of log events from the AAC SDK logger, in the order
+     * they were logged. The Engine calls @c logEvents() instead of @c logEvent() when batched delivery is
+     * enabled with the @c aace.logger.platformLogger.batch configuration. The default implementation calls
+     * @c logEvent() for each event, so the platform implementation only overrides it to handle a batch in
+     * a single call.
+     *
+     * @param [in] events The log events
+     * @return @c true if the platform implementation successfully handled the log events, else @c false
+     */
+    virtual bool logEvents(const std::vector<LogEvent>& events);
+
     /**
      * Notifies the Engine to use the AAC SDK logger to log a message originating on the platform.
      * The log event will be received by the platform with a call to @c logEvent() from the Engine.
@@ -74,6 +101,13 @@ public:
      */
     void log(Level level, const std::string& tag, const std::string& message);
 
+    /**
+     * Notifies the Engine to write out the log entries kept in memory by the flight recorder sinks
+     * configured with the @c aace.logger.sink.flightRecorder type, for example when the user reports a problem.
+     * The entries are written asynchronously.
+     */
+    void dumpLogs();
+
     /**
      * @internal
      * Sets the Engine interface delegate.
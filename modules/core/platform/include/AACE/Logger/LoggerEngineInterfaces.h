@@ -68,6 +68,8 @@ public:
     };
 
     virtual void log(Level level, const std::string& tag, const std::string& message) = 0;
+
+    virtual void onDumpLogs() = 0;
 };
 
 inline std::ostream& operator<<(std::ostream& stream, const LoggerEngineInterface::Level& level) {
@@ -56,6 +56,9 @@ public:
 
     /**
      * Datapoint class that contains name of the data being capture, it's value, and how many times recorded
+     *
+     * When the Engine aggregates metrics, the value of a counter is the sum of its count samples, and the value of a
+     * timer is the value of its count samples.
      */
     class Datapoint {
     public:
@@ -18,6 +18,7 @@
 
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include "AACE/Core/PlatformInterface.h"
 #include "PropertyManagerEngineInterface.h"
 
@@ -63,6 +64,22 @@ public:
      */
     bool setProperty(const std::string& name, const std::string& value);
 
+    /**
+     * Sets several property values in the Engine together, such as the
+     * properties changed at boot or on a profile switch. The values are applied
+     * one after the other, without any other property being set in between, and
+     * the Engine components depending on the properties are notified once, after
+     * all the values are applied. The Engine calls propertyStateChanged() with
+     * the status of each property when it is completed.
+     *
+     * @param [in] values The setting of each property, by the name used by the
+     *        Engine to identify the property.
+     * @return @c true if the property values are being set, else @c false if a
+     *         property is not recognized by the Engine or is read only, in which
+     *         case no value is set.
+     */
+    bool setProperties(const std::unordered_map<std::string, std::string>& values);
+
     /**
      * Notifies the platform implementation of the status of a property change
      * after a call to setProperty().
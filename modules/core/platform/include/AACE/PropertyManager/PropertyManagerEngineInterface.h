@@ -16,6 +16,9 @@
 #ifndef AACE_PROPERTY_MANAGER_PROPERTY_MANAGER_ENGINE_INTERFACE_H
 #define AACE_PROPERTY_MANAGER_PROPERTY_MANAGER_ENGINE_INTERFACE_H
 
+#include <string>
+#include <unordered_map>
+
 /** @file */
 
 namespace aace {
@@ -42,6 +45,7 @@ public:
 
     };
     virtual bool onSetProperty(const std::string& name, const std::string& value) = 0;
+    virtual bool onSetProperties(const std::unordered_map<std::string, std::string>& values) = 0;
     virtual std::string onGetProperty(const std::string& name) = 0;
 };
 
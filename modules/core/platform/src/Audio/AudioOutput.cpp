@@ -24,12 +24,24 @@ int64_t AudioOutput::getNumBytesBuffered() {
     return 0;
 }
 
+void AudioOutput::setBufferingHint(int64_t prebufferDuration) {
+}
+
+void AudioOutput::prewarm() {
+}
+
 void AudioOutput::mediaStateChanged(MediaState state) {
     if (auto m_audioOutputEngineInterface_lock = m_audioOutputEngineInterface.lock()) {
         m_audioOutputEngineInterface_lock->onMediaStateChanged(state);
     }
 }
 
+void AudioOutput::mediaPositionChanged(int64_t position) {
+    if (auto m_audioOutputEngineInterface_lock = m_audioOutputEngineInterface.lock()) {
+        m_audioOutputEngineInterface_lock->onMediaPositionChanged(position);
+    }
+}
+
 void AudioOutput::mediaError(MediaError error, const std::string& description) {
     if (auto m_audioOutputEngineInterface_lock = m_audioOutputEngineInterface.lock()) {
         m_audioOutputEngineInterface_lock->onMediaError(error, description);
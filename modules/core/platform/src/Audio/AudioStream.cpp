@@ -15,11 +15,30 @@
 
 #include <AACE/Audio/AudioStream.h>
 
+#include <algorithm>
+#include <thread>
+
 namespace aace {
 namespace audio {
 
+/// The interval at which the default @c timedRead() implementation polls for data
+static const std::chrono::milliseconds TIMED_READ_POLL_INTERVAL(5);
+
 AudioStream::~AudioStream() = default;
 
+ssize_t AudioStream::timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto count = read(data, size);
+        auto now = std::chrono::steady_clock::now();
+        if (count != 0 || isClosed() || now >= deadline) {
+            return count;
+        }
+        std::this_thread::sleep_for(
+            std::min<std::chrono::steady_clock::duration>(TIMED_READ_POLL_INTERVAL, deadline - now));
+    }
+}
+
 AudioStream::Encoding AudioStream::getEncoding() {
     return getAudioFormat().getEncoding();
 }
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2017-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Core/MessageStream.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace aace {
+namespace core {
+
+/// The interval at which the default @c timedRead() implementation polls for data
+static const std::chrono::milliseconds TIMED_READ_POLL_INTERVAL(5);
+
+ssize_t MessageStream::timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto count = read(data, size);
+        auto now = std::chrono::steady_clock::now();
+        if (count != 0 || isClosed() || now >= deadline) {
+            return count;
+        }
+        std::this_thread::sleep_for(
+            std::min<std::chrono::steady_clock::duration>(TIMED_READ_POLL_INTERVAL, deadline - now));
+    }
+}
+
+}  // namespace core
+}  // namespace aace
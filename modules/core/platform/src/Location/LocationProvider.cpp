@@ -30,6 +30,12 @@ void LocationProvider::locationServiceAccessChanged(LocationServiceAccess access
     }
 }
 
+void LocationProvider::locationChanged(const Location& location) {
+    if (m_locationProviderEngineInterface != nullptr) {
+        m_locationProviderEngineInterface->onLocationChanged(location);
+    }
+}
+
 void LocationProvider::setEngineInterface(
     std::shared_ptr<LocationProviderEngineInterface> locationProviderEngineInterface) {
     m_locationProviderEngineInterface = locationProviderEngineInterface;
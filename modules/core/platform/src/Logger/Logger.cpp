@@ -28,12 +28,26 @@ bool Logger::logEvent(
     return false;
 }
 
+bool Logger::logEvents(const std::vector<LogEvent>& events) {
+    bool result = true;
+    for (const auto& next : events) {
+        result = logEvent(next.level, next.time, next.source, next.message) && result;
+    }
+    return result;
+}
+
 void Logger::log(Level level, const std::string& tag, const std::string& message) {
     if (m_loggerEngineInterface != nullptr) {
         m_loggerEngineInterface->log(level, tag, message);
     }
 }
 
+void Logger::dumpLogs() {
+    if (m_loggerEngineInterface != nullptr) {
+        m_loggerEngineInterface->onDumpLogs();
+    }
+}
+
 void Logger::setEngineInterface(std::shared_ptr<aace::logger::LoggerEngineInterface> loggerEngineInterface) {
     m_loggerEngineInterface = loggerEngineInterface;
 }
@@ -25,6 +25,11 @@ bool PropertyManager::setProperty(const std::string& name, const std::string& va
                                                        : false;
 }
 
+bool PropertyManager::setProperties(const std::unordered_map<std::string, std::string>& values) {
+    return m_propertyManagerEngineInterface != nullptr ? m_propertyManagerEngineInterface->onSetProperties(values)
+                                                       : false;
+}
+
 std::string PropertyManager::getProperty(const std::string& name) {
     return m_propertyManagerEngineInterface != nullptr ? m_propertyManagerEngineInterface->onGetProperty(name) : "";
 }
@@ -0,0 +1,345 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * Micro-benchmarks of the core utilities on the hot paths of the Engine: UUID generation, JSON get, set and merge,
+ * string comparison and case conversion, Base64 encoding and decoding, log entry construction, message parsing and
+ * serialization, and the executor round trip.
+ *
+ * The @c aasb cases parse and serialize typical AASB messages of increasing size: a media state change, a navigation
+ * route, and an address book upload. The @c lazy cases scan the message header with the JSON header scanner selected
+ * by @c AAC_JSON_HEADER_SCANNER, so the scanners are compared by saving the baseline of a build with one scanner and
+ * running a build with the other scanner against it. The throughput of each case is its message size per op.
+ *
+ * Each case is run in batches of doubling size until a batch takes at least the minimum time, and the time per
+ * operation of the last batch is reported. The result of every case is checked, so a broken utility fails the run.
+ *
+ * To catch regressions, save the results of a reference build with @c --save-baseline, and run the benchmark of a
+ * later build with @c --baseline on the same machine. The run fails if a case is slower than its baseline by more
+ * than the tolerance. When the unit tests are enabled, the benchmark runs with them, labeled @c benchmark.
+ *
+ * Usage: CoreUtilsBenchmark [--min-time <ms>] [--filter <text>] [--baseline <file>] [--save-baseline <file>]
+ *                           [--tolerance <percent>]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/MessageBroker/Message.h>
+#include <AACE/Engine/Utils/Encoding/Base64.h>
+#include <AACE/Engine/Utils/JSON/JSON.h>
+#include <AACE/Engine/Utils/String/StringUtils.h>
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/UUID/UUID.h>
+
+using aace::engine::messageBroker::Message;
+using Clock = std::chrono::steady_clock;
+
+namespace json = aace::engine::utils::json;
+
+static const std::string TAG("aace.core.CoreUtilsBenchmark");
+
+/// Benchmark options parsed from the command line
+struct BenchmarkOptions {
+    std::chrono::milliseconds minTime = std::chrono::milliseconds(100);
+    std::string filter;
+    std::string baseline;
+    std::string saveBaseline;
+    double tolerance = 25;
+};
+
+/// A benchmark case, which runs an operation and returns @c false if its result is wrong
+struct BenchmarkCase {
+    std::string name;
+    std::function<bool()> operation;
+};
+
+/// Accumulates the results of the operations, so they are not optimized away
+static volatile size_t s_sink = 0;
+
+static const std::string MESSAGE_TEXT =
+    R"({"header":{"id":"3c6b4a7e-6f1c-4d6e-9a55-1f6c1e9a2b01","messageType":"Publish","version":"4.0",)"
+    R"("messageDescription":{"topic":"AudioOutput","action":"MediaStateChanged"}},)"
+    R"("payload":{"channel":"SpeechSynthesizer","token":"token-1","state":"PLAYING"}})";
+
+static const std::string NAVIGATION_MESSAGE_TEXT = []() {
+    std::string waypoints;
+    for (int i = 0; i < 20; i++) {
+        waypoints += std::string(i > 0 ? "," : "") + R"({"type":"STOP","address":{"addressLine1":"2795 Augustine )" +
+                     std::to_string(i) + R"( Drive","city":"Santa Clara","stateOrRegion":"CA","postalCode":"95054"},)" +
+                     R"("coordinate":[37.3809,-121.9794],"name":"Stop )" + std::to_string(i) + R"("})";
+    }
+    return R"({"header":{"id":"9a1c2b3d-4e5f-4a6b-8c7d-0e1f2a3b4c5d","messageType":"Publish","version":"4.0",)"
+           R"("messageDescription":{"topic":"Navigation","action":"StartNavigation"}},)"
+           R"("payload":{"payload":"{\"transportationMode\":\"DRIVING\"}","waypoints":[)" +
+           waypoints + "]}}";
+}();
+
+static const std::string ADDRESS_BOOK_MESSAGE_TEXT = []() {
+    std::string entries;
+    for (int i = 0; i < 500; i++) {
+        entries += std::string(i > 0 ? "," : "") + R"({"entryId":"entry-)" + std::to_string(i) +
+                   R"(","name":{"firstName":"First )" + std::to_string(i) + R"(","lastName":"Last"},)" +
+                   R"("phoneNumbers":[{"label":"mobile","number":"+1 555 01)" + std::to_string(i % 100) + R"("}]})";
+    }
+    return R"({"payload":{"addressBookSourceId":"phone","entries":[)" + entries +
+           R"(]},"header":{"id":"7f6e5d4c-3b2a-4190-8f7e-6d5c4b3a2f1e","messageType":"Publish","version":"4.0",)"
+           R"("messageDescription":{"topic":"AddressBook","action":"AddAddressBook"}}})";
+}();
+
+static char firstCharacter(const aace::engine::logger::LogEntry& entry) {
+    return entry.c_str()[0];
+}
+
+static std::vector<BenchmarkCase> createCases() {
+    std::vector<BenchmarkCase> cases;
+
+    cases.push_back({"uuid.generateUUID", []() {
+                         auto uuid = aace::engine::utils::uuid::generateUUID();
+                         s_sink = s_sink + uuid.size();
+                         return uuid.size() == 36;
+                     }});
+
+    auto config = std::make_shared<json::Value>(json::toJson(
+        R"({"aace.alexa":{"avsDeviceSDK":{"deviceInfo":{"clientId":"client","productId":"product"}},)"
+        R"("speechRecognizer":{"encoder":{"name":"opus"}}},"aace.storage":{"localStoragePath":"/tmp/aace.db"}})"));
+    cases.push_back({"json.get", [config]() {
+                         std::string name = json::get(*config, "/aace.alexa/speechRecognizer/encoder/name", "");
+                         s_sink = s_sink + name.size();
+                         return name == "opus";
+                     }});
+    cases.push_back({"json.set", [config]() {
+                         return json::set(*config, "/aace.alexa/speechRecognizer/encoder/name", "opus");
+                     }});
+    // the configuration of a module adds its values to the tree, since a value can't be specified twice
+    auto overrides = json::toJson(R"({"aace.alexa":{"speechRecognizer":{"encoder":{"bitrate":32000}}}})");
+    cases.push_back({"json.merge", [config, overrides]() {
+                         auto merged = *config;
+                         return json::merge(merged, overrides) && merged.size() == 2;
+                     }});
+
+    cases.push_back({"string.equal", []() {
+                         static const std::string a = "ExternalMediaPlayer", b = "externalmediaplayer";
+                         return aace::engine::utils::string::equal(a, b, false);
+                     }});
+    cases.push_back({"string.toLower", []() {
+                         static const std::string text = "ExternalMediaPlayer.ReportDiscoveredPlayers";
+                         auto lower = aace::engine::utils::string::toLower(text);
+                         s_sink = s_sink + lower.size();
+                         return lower == "externalmediaplayer.reportdiscoveredplayers";
+                     }});
+
+    auto binary = std::make_shared<std::string>();
+    for (int i = 0; i < 1024; i++) {
+        binary->push_back(static_cast<char>(i * 31));
+    }
+    auto encoded = std::make_shared<std::string>();
+    {
+        std::istringstream src(*binary);
+        std::ostringstream dest;
+        aace::engine::utils::encoding::Base64::encode(src, dest);
+        *encoded = dest.str();
+    }
+    cases.push_back({"base64.encode (1 KB)", [binary, encoded]() {
+                         std::istringstream src(*binary);
+                         std::ostringstream dest;
+                         return aace::engine::utils::encoding::Base64::encode(src, dest) && dest.str() == *encoded;
+                     }});
+    cases.push_back({"base64.decode (1 KB)", [binary, encoded]() {
+                         std::istringstream src(*encoded);
+                         std::ostringstream dest;
+                         return aace::engine::utils::encoding::Base64::decode(src, dest) && dest.str() == *binary;
+                     }});
+
+    cases.push_back({"LogEntry.d/sensitive", []() {
+                         static const std::string token = "token-1";
+                         // the entry lives until the end of the expression, like the entries passed to the logger
+                         auto first = firstCharacter(
+                             LX(TAG, "benchmark").d("messageId", token).d("count", 42).sensitive("text", token));
+                         s_sink = s_sink + first;
+                         return first != '\0';
+                     }});
+
+    cases.push_back({"Message.parse", []() {
+                         Message message(MESSAGE_TEXT, Message::Direction::INCOMING);
+                         s_sink = s_sink + message.topic().size();
+                         return message.valid() && message.action() == "MediaStateChanged";
+                     }});
+    auto message = std::make_shared<Message>(MESSAGE_TEXT, Message::Direction::INCOMING);
+    cases.push_back({"Message.str", [message]() {
+                         auto text = message->str();
+                         s_sink = s_sink + text.size();
+                         return !text.empty();
+                     }});
+
+    // the header of the address book message follows its payload, so the scan of the header reads the whole text
+    std::vector<std::pair<std::string, const std::string*>> aasbMessages = {
+        {"small", &MESSAGE_TEXT},
+        {"navigation", &NAVIGATION_MESSAGE_TEXT},
+        {"addressBook", &ADDRESS_BOOK_MESSAGE_TEXT}};
+    for (auto& next : aasbMessages) {
+        auto text = next.second;
+        cases.push_back({"aasb." + next.first + ".parse", [text]() {
+                             auto document = nlohmann::json::parse(*text);
+                             return document.is_object() && document.size() == 2;
+                         }});
+        cases.push_back({"aasb." + next.first + ".lazy", [text]() {
+                             Message message(*text, Message::Direction::INCOMING, Message::ParseMode::LAZY);
+                             s_sink = s_sink + message.topic().size();
+                             return message.valid() && !message.action().empty();
+                         }});
+        auto document = std::make_shared<nlohmann::json>(nlohmann::json::parse(*text));
+        cases.push_back({"aasb." + next.first + ".dump", [document]() {
+                             auto serialized = document->dump();
+                             s_sink = s_sink + serialized.size();
+                             return !serialized.empty();
+                         }});
+    }
+
+    auto executor = std::make_shared<aace::engine::utils::threading::Executor>();
+    cases.push_back({"Executor.submit round trip", [executor]() {
+                         return executor->submit([]() { return 1; }).get() == 1;
+                     }});
+
+    return cases;
+}
+
+/// Runs a case and returns its time per operation in nanoseconds, or a negative value if a result was wrong
+static double run(const BenchmarkCase& benchmarkCase, std::chrono::milliseconds minTime) {
+    for (size_t iterations = 1;; iterations *= 2) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            if (!benchmarkCase.operation()) {
+                return -1;
+            }
+        }
+        auto elapsed = Clock::now() - start;
+        if (elapsed >= minTime) {
+            return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+        }
+    }
+}
+
+/// Reads a baseline of lines "<ns/op> <case name>"
+static std::map<std::string, double> readBaseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    std::ifstream file(path);
+    double nanoseconds;
+    std::string name;
+    while (file >> nanoseconds && std::getline(file >> std::ws, name)) {
+        baseline[name] = nanoseconds;
+    }
+    return baseline;
+}
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--min-time" && std::strtoul(value.c_str(), nullptr, 10) > 0) {
+            options.minTime = std::chrono::milliseconds(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--baseline") {
+            options.baseline = value;
+        } else if (arg == "--save-baseline") {
+            options.saveBaseline = value;
+        } else if (arg == "--tolerance" && std::strtod(value.c_str(), nullptr) > 0) {
+            options.tolerance = std::strtod(value.c_str(), nullptr);
+        } else {
+            std::cerr << "invalid argument: " << arg << " " << value << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--min-time <ms>] [--filter <text>] [--baseline <file>] [--save-baseline <file>]"
+                     " [--tolerance <percent>]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::map<std::string, double> baseline;
+    if (!options.baseline.empty()) {
+        baseline = readBaseline(options.baseline);
+        if (baseline.empty()) {
+            std::cerr << "invalid baseline: " << options.baseline << std::endl;
+            return 1;
+        }
+    }
+    std::ofstream saveBaseline;
+    if (!options.saveBaseline.empty()) {
+        saveBaseline.open(options.saveBaseline);
+        if (!saveBaseline) {
+            std::cerr << "unable to write baseline: " << options.saveBaseline << std::endl;
+            return 1;
+        }
+    }
+
+    std::printf("min time: %lld ms\n\n", static_cast<long long>(options.minTime.count()));
+    std::printf("%-28s %12s %12s %10s\n", "case", "ns/op", "baseline", "change");
+
+    bool succeeded = true;
+    for (auto& benchmarkCase : createCases()) {
+        if (benchmarkCase.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        auto nanoseconds = run(benchmarkCase, options.minTime);
+        if (nanoseconds < 0) {
+            std::printf("%-28s %12s\n", benchmarkCase.name.c_str(), "FAILED");
+            succeeded = false;
+            continue;
+        }
+        if (saveBaseline.is_open()) {
+            saveBaseline << nanoseconds << " " << benchmarkCase.name << "\n";
+        }
+
+        auto it = baseline.find(benchmarkCase.name);
+        if (it == baseline.end() || it->second <= 0) {
+            std::printf("%-28s %12.1f\n", benchmarkCase.name.c_str(), nanoseconds);
+            continue;
+        }
+        auto change = (nanoseconds / it->second - 1) * 100;
+        auto regressed = change > options.tolerance;
+        std::printf(
+            "%-28s %12.1f %12.1f %+9.1f%%%s\n",
+            benchmarkCase.name.c_str(),
+            nanoseconds,
+            it->second,
+            change,
+            regressed ? " REGRESSED" : "");
+        succeeded = succeeded && !regressed;
+    }
+
+    return succeeded ? 0 : 1;
+}
@@ -0,0 +1,338 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * Load generator for @c MessageBrokerImpl.
+ *
+ * Each scenario publishes a fixed number of AASB-like messages through a fresh broker and reports
+ * the throughput, the publish-to-handler (or request-to-reply) latency percentiles, and the number
+ * of heap allocations per message. Messages are generated before the measurement starts so only the
+ * broker's own work is measured.
+ *
+ * Usage: MessageBrokerBenchmark [--messages <count>] [--lanes <count>] [--payload-size <bytes>]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/MessageBroker/Message.h>
+#include <AACE/Engine/MessageBroker/MessageBrokerImpl.h>
+
+using aace::engine::messageBroker::Message;
+using aace::engine::messageBroker::MessageBrokerImpl;
+using Clock = std::chrono::steady_clock;
+
+// counts every heap allocation made by the process
+static std::atomic<size_t> s_allocationCount{0};
+
+void* operator new(size_t size) {
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+/// Benchmark options parsed from the command line
+struct BenchmarkOptions {
+    size_t messages = 20000;
+    size_t lanes = 1;
+    size_t payloadSize = 64 * 1024;
+};
+
+/// Measurements collected for a single scenario
+struct ScenarioResult {
+    std::string name;
+    size_t messages = 0;
+    Clock::duration elapsed{};
+    size_t allocations = 0;
+    std::vector<Clock::duration> latencies;
+};
+
+static const std::string MESSAGE_ID_PREFIX = "bench-";
+static const size_t EVENT_TOPIC_COUNT = 16;
+
+static std::string createMessageId(size_t sequence) {
+    return MESSAGE_ID_PREFIX + std::to_string(sequence);
+}
+
+static size_t parseSequence(const Message& message) {
+    auto id = message.messageId();
+    return std::strtoul(id.c_str() + MESSAGE_ID_PREFIX.size(), nullptr, 10);
+}
+
+static std::string createEvent(const std::string& topic, size_t sequence, const std::string& payload) {
+    return R"({"header":{"id":")" + createMessageId(sequence) + R"(","messageType":"Publish","version":"4.0",)" +
+           R"("messageDescription":{"topic":")" + topic + R"(","action":"Event"}},"payload":)" + payload + "}";
+}
+
+static std::string createRequest(size_t sequence) {
+    return R"({"header":{"id":")" + createMessageId(sequence) + R"(","messageType":"Publish","version":"4.0",)" +
+           R"("messageDescription":{"topic":"LocationProvider","action":"GetLocation"}}})";
+}
+
+static std::string createReply(const std::string& replyToId) {
+    return R"({"header":{"id":"reply-)" + replyToId + R"(","messageType":"Reply","version":"4.0",)" +
+           R"("messageDescription":{"topic":"LocationProvider","action":"GetLocation","replyToId":")" + replyToId +
+           R"("}},"payload":{"location":{"latitude":47.6062,"longitude":-122.3321,"accuracy":10}}})";
+}
+
+// builds a payload of roughly the requested size shaped like a template runtime or navigation message
+static std::string createLargePayload(size_t size) {
+    std::string payload = R"({"items":[)";
+    for (size_t i = 0; payload.size() < size; i++) {
+        if (i > 0) {
+            payload += ",";
+        }
+        payload += R"({"index":)" + std::to_string(i) +
+                   R"(,"title":"Lorem ipsum dolor sit amet","subtitle":"consectetur adipiscing elit",)" +
+                   R"("enabled":true,"score":0.75,"tags":["alpha","beta","gamma"]})";
+    }
+    payload += "]}";
+    return payload;
+}
+
+static std::shared_ptr<MessageBrokerImpl> createBroker(const BenchmarkOptions& options) {
+    auto broker = MessageBrokerImpl::create();
+    broker->setDispatchLaneCount(options.lanes);
+    broker->setMessageTimeout(std::chrono::milliseconds(5000));
+    return broker;
+}
+
+/**
+ * Publishes pre-generated events asynchronously and records the latency from @c send() to the last
+ * subscriber notification of each message.
+ */
+static ScenarioResult runAsyncScenario(
+    const std::string& name,
+    const BenchmarkOptions& options,
+    const std::vector<std::string>& messages,
+    size_t topicSubscribers,
+    size_t wildcardSubscribers) {
+    auto broker = createBroker(options);
+
+    const size_t notificationsPerMessage = topicSubscribers + wildcardSubscribers;
+    std::vector<Clock::time_point> sent(messages.size());
+    std::vector<Clock::time_point> received(messages.size());
+    std::vector<std::atomic<size_t>> notified(messages.size());
+    std::atomic<size_t> completed{0};
+    std::promise<void> done;
+
+    auto handler = [&](const Message& message) {
+        auto sequence = parseSequence(message);
+        if (notified[sequence].fetch_add(1) + 1 == notificationsPerMessage) {
+            received[sequence] = Clock::now();
+            if (completed.fetch_add(1) + 1 == messages.size()) {
+                done.set_value();
+            }
+        }
+    };
+
+    for (size_t t = 0; t < EVENT_TOPIC_COUNT; t++) {
+        for (size_t s = 0; s < topicSubscribers; s++) {
+            broker->subscribe("Topic" + std::to_string(t), handler, Message::Direction::OUTGOING);
+        }
+    }
+    for (size_t s = 0; s < wildcardSubscribers; s++) {
+        broker->subscribe("*", handler, Message::Direction::OUTGOING);
+    }
+
+    ScenarioResult result;
+    result.name = name;
+    result.messages = messages.size();
+
+    auto allocations = s_allocationCount.load();
+    auto start = Clock::now();
+    for (size_t i = 0; i < messages.size(); i++) {
+        sent[i] = Clock::now();
+        broker->publish(messages[i]).send();
+    }
+    done.get_future().wait();
+    result.elapsed = Clock::now() - start;
+    result.allocations = s_allocationCount.load() - allocations;
+
+    result.latencies.reserve(messages.size());
+    for (size_t i = 0; i < messages.size(); i++) {
+        result.latencies.push_back(received[i] - sent[i]);
+    }
+
+    broker->shutdown();
+    return result;
+}
+
+/**
+ * Sends blocking requests that are answered by a subscriber, and records the round trip latency
+ * of each @c get().
+ */
+static ScenarioResult runSyncScenario(const BenchmarkOptions& options) {
+    auto broker = createBroker(options);
+    std::weak_ptr<MessageBrokerImpl> weakBroker = broker;
+
+    broker->subscribe(
+        "LocationProvider",
+        [weakBroker](const Message& message) {
+            if (auto broker = weakBroker.lock()) {
+                broker->publish(createReply(message.messageId()), Message::Direction::INCOMING).send();
+            }
+        },
+        Message::Direction::OUTGOING);
+
+    // the replies are generated by the subscriber, so only the requests are prepared up front
+    std::vector<std::string> requests;
+    requests.reserve(options.messages);
+    for (size_t i = 0; i < options.messages; i++) {
+        requests.push_back(createRequest(i));
+    }
+
+    ScenarioResult result;
+    result.name = "sync request/reply";
+    result.messages = requests.size();
+    result.latencies.reserve(requests.size());
+
+    size_t failures = 0;
+    auto allocations = s_allocationCount.load();
+    auto start = Clock::now();
+    for (auto& next : requests) {
+        auto sent = Clock::now();
+        if (!broker->publish(next).get().valid()) {
+            failures++;
+        }
+        result.latencies.push_back(Clock::now() - sent);
+    }
+    result.elapsed = Clock::now() - start;
+    result.allocations = s_allocationCount.load() - allocations;
+
+    if (failures > 0) {
+        std::cerr << "sync request/reply: " << failures << " requests failed" << std::endl;
+    }
+
+    broker->shutdown();
+    return result;
+}
+
+static double toMicroseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+static Clock::duration percentile(const std::vector<Clock::duration>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return Clock::duration::zero();
+    }
+    auto index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static void printHeader() {
+    std::printf(
+        "%-24s %10s %12s %10s %10s %10s %12s\n",
+        "scenario",
+        "messages",
+        "msgs/sec",
+        "p50 (us)",
+        "p99 (us)",
+        "p999 (us)",
+        "allocs/msg");
+}
+
+static void printResult(ScenarioResult& result) {
+    std::sort(result.latencies.begin(), result.latencies.end());
+    auto seconds = std::chrono::duration<double>(result.elapsed).count();
+    std::printf(
+        "%-24s %10zu %12.0f %10.1f %10.1f %10.1f %12.1f\n",
+        result.name.c_str(),
+        result.messages,
+        seconds > 0 ? result.messages / seconds : 0,
+        toMicroseconds(percentile(result.latencies, 0.50)),
+        toMicroseconds(percentile(result.latencies, 0.99)),
+        toMicroseconds(percentile(result.latencies, 0.999)),
+        result.messages > 0 ? static_cast<double>(result.allocations) / result.messages : 0);
+}
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << arg << std::endl;
+            return false;
+        }
+        auto value = std::strtoul(argv[++i], nullptr, 10);
+        if (arg == "--messages" && value > 0) {
+            options.messages = value;
+        } else if (arg == "--lanes" && value > 0) {
+            options.lanes = value;
+        } else if (arg == "--payload-size" && value > 0) {
+            options.payloadSize = value;
+        } else {
+            std::cerr << "invalid argument: " << arg << " " << argv[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0] << " [--messages <count>] [--lanes <count>] [--payload-size <bytes>]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> events;
+    std::vector<std::string> largeEvents;
+    auto largePayload = createLargePayload(options.payloadSize);
+    // large messages are capped so the pre-generated set stays within a reasonable amount of memory
+    auto largeCount = std::min<size_t>(options.messages, std::max<size_t>(1, (256 * 1024 * 1024) / largePayload.size()));
+    for (size_t i = 0; i < options.messages; i++) {
+        auto topic = "Topic" + std::to_string(i % EVENT_TOPIC_COUNT);
+        events.push_back(createEvent(topic, i, R"({"value":)" + std::to_string(i) + "}"));
+        if (i < largeCount) {
+            largeEvents.push_back(createEvent(topic, i, largePayload));
+        }
+    }
+
+    std::printf(
+        "messages: %zu, dispatch lanes: %zu, large payload: %zu bytes\n\n",
+        options.messages,
+        options.lanes,
+        largePayload.size());
+    printHeader();
+
+    std::vector<ScenarioResult> results;
+    results.push_back(runAsyncScenario("async publish", options, events, 1, 0));
+    results.push_back(runSyncScenario(options));
+    results.push_back(runAsyncScenario("wildcard fan-out", options, events, 2, 4));
+    results.push_back(runAsyncScenario("large payload", options, largeEvents, 1, 0));
+
+    for (auto& next : results) {
+        printResult(next);
+    }
+
+    return 0;
+}
@@ -0,0 +1,372 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * Load generator for @c SQLiteStorage.
+ *
+ * For every combination of journal mode, value size and transaction batch size, a fresh database is
+ * created at the given path and used to measure:
+ *
+ * - put: keys written with @c put(), grouped into transactions of the batch size (a batch size of 1
+ *   commits every put on its own), with the latency measured per transaction;
+ * - putBatch: the same keys written with @c putBatch(), with the latency measured per batch;
+ * - get: randomly chosen keys read with @c get(), with the latency measured per read;
+ * - list and forEach: the whole table read with @c list() and @c forEach(), with the latency measured
+ *   per pass over the table.
+ *
+ * The throughput is reported in operations (keys) per second and in megabytes of values per second.
+ * Run it with @c --path on the target's storage to measure the flash the database will live on.
+ *
+ * Usage: StorageBenchmark [--path <file>] [--operations <count>] [--journal-mode <mode>]
+ *                         [--synchronous <level>] [--batch-size <count>] [--value-size <bytes>]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/Storage/SQLiteStorage.h>
+
+using aace::engine::storage::SQLiteStorage;
+using Clock = std::chrono::steady_clock;
+
+/// Benchmark options parsed from the command line
+struct BenchmarkOptions {
+    std::string path = "StorageBenchmark.db";
+    size_t operations = 2000;
+    std::string synchronous = "full";
+    std::vector<std::string> journalModes = {"delete", "truncate", "wal"};
+    std::vector<size_t> batchSizes = {1, 16, 256};
+    std::vector<size_t> valueSizes = {64, 4096};
+};
+
+/// Measurements collected for a single scenario
+struct ScenarioResult {
+    std::string name;
+    std::string journalMode;
+    size_t valueSize = 0;
+    size_t operations = 0;
+    size_t failures = 0;
+    Clock::duration elapsed{};
+    std::vector<Clock::duration> latencies;
+};
+
+static const std::string TABLE = "benchmark";
+// the number of passes over the table measured by the list and forEach scenarios
+static const size_t TABLE_SCAN_COUNT = 20;
+
+static void removeDatabase(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-journal").c_str());
+    std::remove((path + "-wal").c_str());
+    std::remove((path + "-shm").c_str());
+}
+
+static std::string createKey(size_t index) {
+    return "key-" + std::to_string(index);
+}
+
+static std::vector<SQLiteStorage::KeyValuePair> createValues(size_t count, size_t valueSize) {
+    std::vector<SQLiteStorage::KeyValuePair> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        // values are shaped like the JSON documents kept by the engine services
+        std::string value = R"({"index":)" + std::to_string(i) + R"(,"data":")";
+        value.append(valueSize > value.size() + 2 ? valueSize - value.size() - 2 : 0, 'a' + i % 26);
+        value += R"("})";
+        values.emplace_back(createKey(i), std::move(value));
+    }
+    return values;
+}
+
+static std::shared_ptr<SQLiteStorage> createStorage(const BenchmarkOptions& options, const std::string& journalMode) {
+    removeDatabase(options.path);
+    auto storage = SQLiteStorage::create(options.path, journalMode, options.synchronous);
+    if (storage == nullptr) {
+        std::cerr << "failed to open " << options.path << " with journal mode " << journalMode << std::endl;
+    }
+    return storage;
+}
+
+static ScenarioResult createResult(const std::string& name, const std::string& journalMode, size_t valueSize) {
+    ScenarioResult result;
+    result.name = name;
+    result.journalMode = journalMode;
+    result.valueSize = valueSize;
+    return result;
+}
+
+/**
+ * Writes the values with @c put(), committing a transaction every @c batchSize puts.
+ */
+static ScenarioResult runPutScenario(
+    SQLiteStorage& storage,
+    const std::string& journalMode,
+    const std::vector<SQLiteStorage::KeyValuePair>& values,
+    size_t valueSize,
+    size_t batchSize) {
+    auto result = createResult("put x" + std::to_string(batchSize), journalMode, valueSize);
+    result.operations = values.size();
+    result.latencies.reserve(values.size() / batchSize + 1);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < values.size(); i += batchSize) {
+        auto end = std::min(i + batchSize, values.size());
+        auto sent = Clock::now();
+        // a single put is committed on its own, just like a put made outside of a transaction
+        bool transaction = end - i > 1 && storage.begin();
+        for (size_t j = i; j < end; j++) {
+            if (!storage.put(TABLE, values[j].first, values[j].second)) {
+                result.failures++;
+            }
+        }
+        if (transaction && !storage.commit()) {
+            result.failures += end - i;
+        }
+        result.latencies.push_back(Clock::now() - sent);
+    }
+    result.elapsed = Clock::now() - start;
+    return result;
+}
+
+/**
+ * Writes the values with @c putBatch(), @c batchSize values at a time.
+ */
+static ScenarioResult runPutBatchScenario(
+    SQLiteStorage& storage,
+    const std::string& journalMode,
+    const std::vector<SQLiteStorage::KeyValuePair>& values,
+    size_t valueSize,
+    size_t batchSize) {
+    auto result = createResult("putBatch x" + std::to_string(batchSize), journalMode, valueSize);
+    result.operations = values.size();
+    result.latencies.reserve(values.size() / batchSize + 1);
+
+    // the batches are prepared before the measurement starts
+    std::vector<std::vector<SQLiteStorage::KeyValuePair>> batches;
+    for (size_t i = 0; i < values.size(); i += batchSize) {
+        batches.emplace_back(values.begin() + i, values.begin() + std::min(i + batchSize, values.size()));
+    }
+
+    auto start = Clock::now();
+    for (auto& next : batches) {
+        auto sent = Clock::now();
+        if (!storage.putBatch(TABLE, next)) {
+            result.failures += next.size();
+        }
+        result.latencies.push_back(Clock::now() - sent);
+    }
+    result.elapsed = Clock::now() - start;
+    return result;
+}
+
+/**
+ * Reads randomly chosen keys of the table with @c get().
+ */
+static ScenarioResult runGetScenario(
+    SQLiteStorage& storage,
+    const std::string& journalMode,
+    const std::vector<SQLiteStorage::KeyValuePair>& values,
+    size_t valueSize) {
+    auto result = createResult("get", journalMode, valueSize);
+    result.operations = values.size();
+    result.latencies.reserve(values.size());
+
+    std::mt19937 random(values.size());
+    std::vector<const SQLiteStorage::KeyValuePair*> order;
+    for (size_t i = 0; i < values.size(); i++) {
+        order.push_back(&values[random() % values.size()]);
+    }
+
+    auto start = Clock::now();
+    for (auto next : order) {
+        auto sent = Clock::now();
+        if (storage.get(TABLE, next->first) != next->second) {
+            result.failures++;
+        }
+        result.latencies.push_back(Clock::now() - sent);
+    }
+    result.elapsed = Clock::now() - start;
+    return result;
+}
+
+/**
+ * Reads the whole table with @c list() or, if @c streaming is @c true, with @c forEach().
+ */
+static ScenarioResult runScanScenario(
+    SQLiteStorage& storage,
+    const std::string& journalMode,
+    size_t rowCount,
+    size_t valueSize,
+    bool streaming) {
+    auto result = createResult(streaming ? "forEach" : "list", journalMode, valueSize);
+    result.operations = rowCount * TABLE_SCAN_COUNT;
+    result.latencies.reserve(TABLE_SCAN_COUNT);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < TABLE_SCAN_COUNT; i++) {
+        size_t rows = 0;
+        auto sent = Clock::now();
+        if (streaming) {
+            storage.forEach(TABLE, [&rows](const std::string& key, const std::string& value) {
+                rows++;
+                return true;
+            });
+        } else {
+            rows = storage.list(TABLE).size();
+        }
+        result.latencies.push_back(Clock::now() - sent);
+        result.failures += rowCount - std::min(rows, rowCount);
+    }
+    result.elapsed = Clock::now() - start;
+    return result;
+}
+
+static double toMicroseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+static Clock::duration percentile(const std::vector<Clock::duration>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return Clock::duration::zero();
+    }
+    auto index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static void printHeader() {
+    std::printf(
+        "%-16s %-9s %8s %10s %12s %10s %12s %12s %12s\n",
+        "scenario",
+        "journal",
+        "value",
+        "ops",
+        "ops/sec",
+        "MB/sec",
+        "p50 (us)",
+        "p99 (us)",
+        "p999 (us)");
+}
+
+static void printResult(ScenarioResult& result) {
+    std::sort(result.latencies.begin(), result.latencies.end());
+    auto seconds = std::chrono::duration<double>(result.elapsed).count();
+    auto opsPerSecond = seconds > 0 ? result.operations / seconds : 0;
+    std::printf(
+        "%-16s %-9s %8zu %10zu %12.0f %10.2f %12.1f %12.1f %12.1f\n",
+        result.name.c_str(),
+        result.journalMode.c_str(),
+        result.valueSize,
+        result.operations,
+        opsPerSecond,
+        opsPerSecond * result.valueSize / (1024 * 1024),
+        toMicroseconds(percentile(result.latencies, 0.50)),
+        toMicroseconds(percentile(result.latencies, 0.99)),
+        toMicroseconds(percentile(result.latencies, 0.999)));
+    if (result.failures > 0) {
+        std::cerr << result.name << " (" << result.journalMode << "): " << result.failures << " operations failed"
+                  << std::endl;
+    }
+}
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string text = argv[++i];
+        auto value = std::strtoul(text.c_str(), nullptr, 10);
+        if (arg == "--path" && !text.empty()) {
+            options.path = text;
+        } else if (arg == "--journal-mode" && !text.empty()) {
+            options.journalModes = {text};
+        } else if (arg == "--synchronous" && !text.empty()) {
+            options.synchronous = text;
+        } else if (arg == "--operations" && value > 0) {
+            options.operations = value;
+        } else if (arg == "--batch-size" && value > 0) {
+            options.batchSizes = {value};
+        } else if (arg == "--value-size" && value > 0) {
+            options.valueSizes = {value};
+        } else {
+            std::cerr << "invalid argument: " << arg << " " << text << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--path <file>] [--operations <count>] [--journal-mode <mode>] [--synchronous <level>]"
+                  << " [--batch-size <count>] [--value-size <bytes>]" << std::endl;
+        return 1;
+    }
+
+    std::printf(
+        "database: %s, operations: %zu, synchronous: %s\n\n",
+        options.path.c_str(),
+        options.operations,
+        options.synchronous.c_str());
+    printHeader();
+
+    for (auto& journalMode : options.journalModes) {
+        for (auto valueSize : options.valueSizes) {
+            auto values = createValues(options.operations, valueSize);
+            std::vector<ScenarioResult> results;
+
+            for (auto batchSize : options.batchSizes) {
+                auto storage = createStorage(options, journalMode);
+                if (storage == nullptr) {
+                    return 1;
+                }
+                results.push_back(runPutScenario(*storage, journalMode, values, valueSize, batchSize));
+                storage = createStorage(options, journalMode);
+                if (storage == nullptr) {
+                    return 1;
+                }
+                results.push_back(runPutBatchScenario(*storage, journalMode, values, valueSize, batchSize));
+            }
+
+            // the read scenarios use the table written by the last putBatch scenario
+            {
+                auto storage = SQLiteStorage::create(options.path, journalMode, options.synchronous);
+                if (storage == nullptr) {
+                    return 1;
+                }
+                results.push_back(runGetScenario(*storage, journalMode, values, valueSize));
+                results.push_back(runScanScenario(*storage, journalMode, values.size(), valueSize, false));
+                results.push_back(runScanScenario(*storage, journalMode, values.size(), valueSize, true));
+            }
+
+            for (auto& next : results) {
+                printResult(next);
+            }
+        }
+    }
+
+    removeDatabase(options.path);
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * Load generator for @c generateUUID().
+ *
+ * Each scenario generates UUIDs from a number of threads at once, the way message ids and stream ids are generated
+ * while messages are published concurrently, and reports the throughput. The same load is run against a copy of the
+ * previous generator, which shared one random number generator behind a mutex and formatted the UUIDs with a
+ * @c std::ostringstream, to show the difference.
+ *
+ * Usage: UUIDBenchmark [--uuids <count>] [--threads <count>]
+ */
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Utils/UUID/UUID.h>
+
+using Clock = std::chrono::steady_clock;
+
+/// Benchmark options parsed from the command line
+struct BenchmarkOptions {
+    size_t uuids = 200000;
+    size_t maxThreads = 8;
+};
+
+using RandomBytes = std::independent_bits_engine<std::default_random_engine, CHAR_BIT, uint8_t>;
+
+static std::string generateLockedHex(RandomBytes& ibe, unsigned int numDigits, uint8_t bits, unsigned short count) {
+    std::vector<uint8_t> bytes((numDigits + 1) / 2);
+    for (auto& byte : bytes) {
+        byte = ibe();
+    }
+    bytes[0] = static_cast<uint8_t>((bytes[0] & (0xff >> count)) | (bits & (0xff << (CHAR_BIT - count))));
+    std::ostringstream oss;
+    for (auto byte : bytes) {
+        oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(byte);
+    }
+    auto text = oss.str();
+    text.resize(numDigits);
+    return text;
+}
+
+/// The previous generator, kept as the reference of the benchmark
+static std::string generateLockedUUID() {
+    static RandomBytes ibe(std::random_device{}());
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ostringstream uuidText;
+    uuidText << generateLockedHex(ibe, 8, 0, 0) << "-" << generateLockedHex(ibe, 4, 0, 0) << "-"
+             << generateLockedHex(ibe, 4, 4 << 4, 4) << "-" << generateLockedHex(ibe, 4, 2 << 6, 2) << "-"
+             << generateLockedHex(ibe, 12, 0, 0);
+    return uuidText.str();
+}
+
+/// Generates @c uuids UUIDs split across @c threads threads, and returns how long it took
+template <typename Generator>
+static Clock::duration run(Generator generator, size_t uuids, size_t threads) {
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (size_t t = 0; t < threads; t++) {
+        auto count = uuids / threads + (t < uuids % threads ? 1 : 0);
+        workers.emplace_back([generator, count]() {
+            size_t length = 0;
+            for (size_t i = 0; i < count; i++) {
+                length += generator().size();
+            }
+            // keeps the generated UUIDs from being optimized away
+            if (length != count * 36) {
+                std::cerr << "unexpected UUID length" << std::endl;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return Clock::now() - start;
+}
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << arg << std::endl;
+            return false;
+        }
+        auto value = std::strtoul(argv[++i], nullptr, 10);
+        if (arg == "--uuids" && value > 0) {
+            options.uuids = value;
+        } else if (arg == "--threads" && value > 0) {
+            options.maxThreads = value;
+        } else {
+            std::cerr << "invalid argument: " << arg << " " << argv[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0] << " [--uuids <count>] [--threads <count>]" << std::endl;
+        return 1;
+    }
+
+    std::printf("uuids: %zu\n\n", options.uuids);
+    std::printf("%-10s %16s %16s %10s\n", "threads", "locked (/sec)", "current (/sec)", "speedup");
+    for (size_t threads = 1; threads <= options.maxThreads; threads *= 2) {
+        auto locked = std::chrono::duration<double>(run(generateLockedUUID, options.uuids, threads)).count();
+        auto current =
+            std::chrono::duration<double>(run(aace::engine::utils::uuid::generateUUID, options.uuids, threads)).count();
+        std::printf(
+            "%-10zu %16.0f %16.0f %9.1fx\n",
+            threads,
+            locked > 0 ? options.uuids / locked : 0,
+            current > 0 ? options.uuids / current : 0,
+            current > 0 ? locked / current : 0);
+    }
+
+    return 0;
+}
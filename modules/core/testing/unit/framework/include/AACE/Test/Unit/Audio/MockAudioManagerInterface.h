@@ -36,6 +36,8 @@ public:
         std::shared_ptr<aace::engine::audio::AudioOutputChannelInterface>(
             const std::string& name,
             AudioOutputType audioOutputType));
+    MOCK_METHOD0(isAudioOutputPlaying, bool());
+    MOCK_METHOD1(addAudioInputProcessor, void(aace::engine::audio::AudioInputProcessorFactory factory));
 };
 
 }  // namespace audio
@@ -38,6 +38,7 @@ public:
     MOCK_METHOD1(setPosition, bool(int64_t position));
     MOCK_METHOD0(getDuration, int64_t());
     MOCK_METHOD0(getNumBytesBuffered, int64_t());
+    MOCK_METHOD1(setBufferingHint, void(int64_t prebufferDuration));
     MOCK_METHOD1(volumeChanged, bool(float volume));
     MOCK_METHOD1(mutedStateChanged, bool(MutedState state));
     MOCK_METHOD0(mayDuck, void());
@@ -41,7 +41,10 @@ public:
             const std::string& name,
             std::shared_ptr<aace::engine::propertyManager::PropertyListenerInterface> listener));
     MOCK_METHOD3(setProperty, bool(const std::string&, const std::string&, const bool&));
+    MOCK_METHOD2(setProperties, bool(const std::unordered_map<std::string, std::string>&, const bool&));
     MOCK_METHOD1(getProperty, std::string(const std::string& name));
+    MOCK_METHOD1(getPropertyHandle, PropertyHandle(const std::string& name));
+    MOCK_METHOD1(getPropertyValue, std::string(PropertyHandle handle));
 };
 
 }  // namespace core
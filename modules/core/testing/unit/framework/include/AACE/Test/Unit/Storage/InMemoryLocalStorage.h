@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_TEST_UNIT_STORAGE_IN_MEMORY_LOCAL_STORAGE_H
+#define AACE_TEST_UNIT_STORAGE_IN_MEMORY_LOCAL_STORAGE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "AACE/Engine/Storage/LocalStorageInterface.h"
+
+namespace aace {
+namespace test {
+namespace unit {
+namespace storage {
+
+/// Local storage keeping its tables in memory
+class InMemoryLocalStorage : public aace::engine::storage::LocalStorageInterface {
+public:
+    bool put(const std::string& table, const std::string& key, const std::string& value) override {
+        m_tables[table][key] = value;
+        return true;
+    }
+    std::string get(const std::string& table, const std::string& key) override {
+        return get(table, key, "");
+    }
+    std::string get(const std::string& table, const std::string& key, const std::string& defaultValue) override {
+        return containsKey(table, key) ? m_tables[table][key] : defaultValue;
+    }
+    bool removeKey(const std::string& table, const std::string& key) override {
+        return containsKey(table, key) && m_tables[table].erase(key) > 0;
+    }
+    bool removeTable(const std::string& table) override {
+        return m_tables.erase(table) > 0;
+    }
+    bool containsKey(const std::string& table, const std::string& key) override {
+        return containsTable(table) && m_tables[table].count(key) > 0;
+    }
+    bool containsTable(const std::string& table) override {
+        return m_tables.count(table) > 0;
+    }
+    std::vector<std::string> keys(const std::string& table) override {
+        std::vector<std::string> keys;
+        for (const auto& entry : m_tables[table]) {
+            keys.push_back(entry.first);
+        }
+        return keys;
+    }
+    std::vector<KeyValuePair> list(const std::string& table) override {
+        auto& values = m_tables[table];
+        return std::vector<KeyValuePair>(values.begin(), values.end());
+    }
+    bool begin() override {
+        return true;
+    }
+    bool commit() override {
+        return true;
+    }
+    bool cancel() override {
+        return true;
+    }
+
+    size_t getTableCount() {
+        return m_tables.size();
+    }
+
+private:
+    std::map<std::string, std::map<std::string, std::string>> m_tables;
+};
+
+}  // namespace storage
+}  // namespace unit
+}  // namespace test
+}  // namespace aace
+
+#endif  // AACE_TEST_UNIT_STORAGE_IN_MEMORY_LOCAL_STORAGE_H
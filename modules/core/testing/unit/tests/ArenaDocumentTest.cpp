@@ -0,0 +1,84 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+#include <AACE/Engine/Utils/JSON/ArenaDocument.h>
+
+using aace::engine::utils::json::ArenaDocument;
+
+static const char* PAYLOAD =
+    R"({"callId":"1234","callee":{"details":"Bob","defaultAddress":{"value":"+12065550100"}}})";
+
+TEST(ArenaDocumentTest, parsesFromTheArenaOfTheThread) {
+    ArenaDocument arenaDocument;
+    EXPECT_TRUE(arenaDocument.isArenaAllocated());
+    auto& document = arenaDocument.get();
+    ASSERT_FALSE(document.Parse(PAYLOAD).HasParseError());
+    EXPECT_STREQ(document["callId"].GetString(), "1234");
+    EXPECT_STREQ(document["callee"]["defaultAddress"]["value"].GetString(), "+12065550100");
+}
+
+TEST(ArenaDocumentTest, nestedDocumentHasItsOwnAllocator) {
+    ArenaDocument outer;
+    ASSERT_FALSE(outer.get().Parse(PAYLOAD).HasParseError());
+    {
+        ArenaDocument inner;
+        EXPECT_FALSE(inner.isArenaAllocated());
+        ASSERT_FALSE(inner.get().Parse(R"({"callId":"5678"})").HasParseError());
+        EXPECT_STREQ(inner.get()["callId"].GetString(), "5678");
+    }
+    // the outer document is not reset by the inner one
+    EXPECT_STREQ(outer.get()["callId"].GetString(), "1234");
+    EXPECT_STREQ(outer.get()["callee"]["details"].GetString(), "Bob");
+}
+
+TEST(ArenaDocumentTest, arenaIsReusedAfterTheDocument) {
+    for (int i = 0; i < 100; i++) {
+        ArenaDocument arenaDocument;
+        EXPECT_TRUE(arenaDocument.isArenaAllocated());
+        auto payload = R"({"index":)" + std::to_string(i) + "}";
+        ASSERT_FALSE(arenaDocument.get().Parse(payload.c_str()).HasParseError());
+        EXPECT_EQ(arenaDocument.get()["index"].GetInt(), i);
+    }
+}
+
+TEST(ArenaDocumentTest, parsesPayloadsLargerThanTheBlock) {
+    std::string payload = R"({"items":[)";
+    for (size_t i = 0; payload.size() < ArenaDocument::getBlockSize() * 4; i++) {
+        payload += (i > 0 ? "," : "") + std::string(R"({"name":"item )") + std::to_string(i) + R"("})";
+    }
+    payload += "]}";
+    for (int pass = 0; pass < 2; pass++) {
+        ArenaDocument arenaDocument;
+        EXPECT_TRUE(arenaDocument.isArenaAllocated());
+        ASSERT_FALSE(arenaDocument.get().Parse(payload.c_str()).HasParseError());
+        EXPECT_STREQ(arenaDocument.get()["items"][0]["name"].GetString(), "item 0");
+    }
+}
+
+TEST(ArenaDocumentTest, eachThreadHasItsArena) {
+    ArenaDocument arenaDocument;
+    EXPECT_TRUE(arenaDocument.isArenaAllocated());
+    bool otherThreadArenaAllocated = false;
+    std::thread thread([&otherThreadArenaAllocated]() {
+        ArenaDocument otherThreadDocument;
+        otherThreadArenaAllocated = otherThreadDocument.isArenaAllocated();
+    });
+    thread.join();
+    EXPECT_TRUE(otherThreadArenaAllocated);
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <AACE/Engine/Utils/Threading/AsyncFlow.h>
+
+using aace::engine::utils::threading::AsyncFlow;
+using aace::engine::utils::threading::ThreadPool;
+using aace::engine::utils::threading::TimerWheel;
+using Next = AsyncFlow::Next;
+
+static const std::chrono::milliseconds TIMEOUT(2000);
+
+class AsyncFlowTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_threadPool = ThreadPool::create(2);
+        m_timerWheel = TimerWheel::create(std::chrono::milliseconds(1));
+    }
+
+    void TearDown() override {
+        // a task may still hold a flow, which must not release the last reference to the pool or the wheel
+        m_timerWheel->shutdown();
+        m_threadPool->shutdown();
+    }
+
+protected:
+    std::shared_ptr<ThreadPool> m_threadPool;
+    std::shared_ptr<TimerWheel> m_timerWheel;
+};
+
+TEST_F(AsyncFlowTest, runsTheStepsUntilDone) {
+    int steps = 0;
+    std::atomic<int> running{0};
+    auto flow = AsyncFlow::create(
+        "test",
+        [&]() {
+            EXPECT_EQ(running++, 0);
+            steps++;
+            running--;
+            return steps < 3 ? Next::now() : steps < 5 ? Next::after(std::chrono::milliseconds(5)) : Next::done();
+        },
+        m_threadPool,
+        m_timerWheel);
+    ASSERT_NE(flow, nullptr);
+
+    ASSERT_TRUE(flow->start());
+    EXPECT_FALSE(flow->start());
+    ASSERT_TRUE(flow->waitForCompletion(TIMEOUT));
+    EXPECT_TRUE(flow->isDone());
+    EXPECT_EQ(steps, 5);
+}
+
+TEST_F(AsyncFlowTest, holdsNoThreadWhileSuspended) {
+    // many flows wait on a single worker, and the worker runs the steps of each of them once they are woken up
+    auto threadPool = ThreadPool::create(1);
+    std::atomic<int> steps{0};
+    std::vector<std::shared_ptr<AsyncFlow>> flows;
+    for (int j = 0; j < 50; j++) {
+        auto first = std::make_shared<bool>(true);
+        auto flow = AsyncFlow::create(
+            "test",
+            [&steps, first]() {
+                steps++;
+                if (*first) {
+                    *first = false;
+                    return Next::suspend();
+                }
+                return Next::done();
+            },
+            threadPool,
+            m_timerWheel);
+        ASSERT_NE(flow, nullptr);
+        ASSERT_TRUE(flow->start());
+        flows.push_back(flow);
+    }
+
+    // a flow that is woken up before its first step has run has no condition to check yet
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (steps < 50 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(steps, 50);
+    for (auto& flow : flows) {
+        flow->wake();
+    }
+    for (auto& flow : flows) {
+        ASSERT_TRUE(flow->waitForCompletion(TIMEOUT));
+    }
+    EXPECT_EQ(steps, 100);
+    threadPool->shutdown();
+}
+
+TEST_F(AsyncFlowTest, wakesUpBeforeTheDeadline) {
+    auto start = AsyncFlow::Clock::now();
+    std::promise<void> stepStarted;
+    int steps = 0;
+    auto flow = AsyncFlow::create(
+        "test",
+        [&]() {
+            if (steps++ > 0) {
+                return Next::done();
+            }
+            stepStarted.set_value();
+            return Next::after(std::chrono::hours(1));
+        },
+        m_threadPool,
+        m_timerWheel);
+    ASSERT_NE(flow, nullptr);
+    ASSERT_TRUE(flow->start());
+
+    // the flow is woken up whether it is suspended or still running its first step
+    stepStarted.get_future().wait();
+    flow->wake();
+    ASSERT_TRUE(flow->waitForCompletion(TIMEOUT));
+    EXPECT_EQ(steps, 2);
+    EXPECT_LT(AsyncFlow::Clock::now() - start, std::chrono::minutes(1));
+    EXPECT_EQ(m_timerWheel->size(), 0u);
+}
+
+TEST_F(AsyncFlowTest, keepsTheWakeUpOfTheRunningStep) {
+    std::promise<void> stepStarted;
+    std::promise<void> woken;
+    auto wokenFuture = woken.get_future().share();
+    int steps = 0;
+    auto flow = AsyncFlow::create(
+        "test",
+        [&]() {
+            if (steps++ > 0) {
+                return Next::done();
+            }
+            stepStarted.set_value();
+            wokenFuture.wait();
+            return Next::suspend();
+        },
+        m_threadPool,
+        m_timerWheel);
+    ASSERT_NE(flow, nullptr);
+    ASSERT_TRUE(flow->start());
+
+    // the wake up is for the condition the running step checked before it suspends
+    stepStarted.get_future().wait();
+    flow->wake();
+    woken.set_value();
+    ASSERT_TRUE(flow->waitForCompletion(TIMEOUT));
+    EXPECT_EQ(steps, 2);
+}
+
+TEST_F(AsyncFlowTest, cancelWaitsForTheRunningStep) {
+    std::promise<void> stepStarted;
+    std::atomic<bool> stepReturned{false};
+    std::atomic<int> steps{0};
+    auto flow = AsyncFlow::create(
+        "test",
+        [&]() {
+            if (steps++ == 0) {
+                stepStarted.set_value();
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+            stepReturned = true;
+            return Next::now();
+        },
+        m_threadPool,
+        m_timerWheel);
+    ASSERT_NE(flow, nullptr);
+    ASSERT_TRUE(flow->start());
+
+    stepStarted.get_future().wait();
+    flow->cancel();
+    EXPECT_TRUE(stepReturned);
+    EXPECT_TRUE(flow->isDone());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(steps, 1);
+
+    // a cancelled flow doesn't start again
+    EXPECT_FALSE(flow->start());
+}
+
+TEST_F(AsyncFlowTest, cancelsTheTimerOfASuspendedFlow) {
+    std::promise<void> suspended;
+    auto flow = AsyncFlow::create(
+        "test",
+        [&]() {
+            suspended.set_value();
+            return Next::after(std::chrono::hours(1));
+        },
+        m_threadPool,
+        m_timerWheel);
+    ASSERT_NE(flow, nullptr);
+    ASSERT_TRUE(flow->start());
+    suspended.get_future().wait();
+    EXPECT_FALSE(flow->isRunningStep());
+
+    // the step may not have returned yet, in which case cancel() waits for it
+    flow->cancel();
+    EXPECT_TRUE(flow->waitForCompletion(TIMEOUT));
+    EXPECT_EQ(m_timerWheel->size(), 0u);
+}
+
+TEST_F(AsyncFlowTest, endsTheFlowWhenTheStepThrows) {
+    auto flow = AsyncFlow::create(
+        "test", []() -> Next { throw std::runtime_error("stepFailed"); }, m_threadPool, m_timerWheel);
+    ASSERT_NE(flow, nullptr);
+    ASSERT_TRUE(flow->start());
+    EXPECT_TRUE(flow->waitForCompletion(TIMEOUT));
+}
+
+TEST_F(AsyncFlowTest, rejectsInvalidArguments) {
+    EXPECT_EQ(AsyncFlow::create("test", nullptr, m_threadPool, m_timerWheel), nullptr);
+    EXPECT_EQ(AsyncFlow::create("test", []() { return Next::done(); }, nullptr, m_timerWheel), nullptr);
+    EXPECT_EQ(AsyncFlow::create("test", []() { return Next::done(); }, m_threadPool, nullptr), nullptr);
+}
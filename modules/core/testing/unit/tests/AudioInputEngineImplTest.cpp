@@ -0,0 +1,451 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Audio/AudioInputEngineImpl.h>
+
+using aace::engine::audio::AudioInputBlock;
+using aace::engine::audio::AudioInputEngineImpl;
+using aace::engine::audio::AudioInputProcessor;
+using aace::engine::audio::AudioReferenceTap;
+
+static const AudioInputEngineImpl::ChannelId INVALID_CHANNEL = AudioInputEngineImpl::INVALID_CHANNEL;
+
+class TestAudioInput : public aace::audio::AudioInput {
+public:
+    bool startAudioInput() override {
+        started++;
+        return true;
+    }
+
+    bool stopAudioInput() override {
+        stopped++;
+        return true;
+    }
+
+    std::atomic<int> started{0};
+    std::atomic<int> stopped{0};
+};
+
+class AudioInputEngineImplTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_platformAudioInput = std::make_shared<TestAudioInput>();
+    }
+
+    static std::vector<int16_t> createSamples(size_t count, int16_t first) {
+        std::vector<int16_t> samples(count);
+        for (size_t j = 0; j < count; j++) {
+            samples[j] = static_cast<int16_t>(first + j);
+        }
+        return samples;
+    }
+
+    static bool waitFor(const std::function<bool()>& condition) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+protected:
+    std::shared_ptr<TestAudioInput> m_platformAudioInput;
+};
+
+TEST_F(AudioInputEngineImplTest, directFanOutCallsChannelsOnWriter) {
+    auto audioInput = AudioInputEngineImpl::create(m_platformAudioInput, "test");
+    ASSERT_NE(audioInput, nullptr);
+
+    std::vector<std::thread::id> threads;
+    auto callback = [&threads](const int16_t* data, const size_t size) {
+        threads.push_back(std::this_thread::get_id());
+    };
+    auto first = audioInput->start(callback);
+    auto second = audioInput->start(callback);
+    ASSERT_NE(first, INVALID_CHANNEL);
+    ASSERT_NE(second, INVALID_CHANNEL);
+    EXPECT_EQ(m_platformAudioInput->started, 1);
+
+    auto samples = createSamples(160, 0);
+    EXPECT_EQ(m_platformAudioInput->write(samples.data(), samples.size()), 160);
+    ASSERT_EQ(threads.size(), 2u);
+    EXPECT_EQ(threads[0], std::this_thread::get_id());
+    EXPECT_EQ(threads[1], std::this_thread::get_id());
+
+    audioInput->stop(first);
+    EXPECT_EQ(m_platformAudioInput->stopped, 0);
+    audioInput->stop(second);
+    EXPECT_EQ(m_platformAudioInput->stopped, 1);
+    audioInput->doShutdown();
+}
+
+TEST_F(AudioInputEngineImplTest, bufferedFanOutDeliversInOrderOnChannelThreads) {
+    auto audioInput =
+        AudioInputEngineImpl::create(m_platformAudioInput, "test", AudioInputEngineImpl::FanOut::BUFFERED, 1 << 20);
+    ASSERT_NE(audioInput, nullptr);
+
+    std::mutex mutex;
+    std::vector<int16_t> received;
+    std::thread::id receivingThread;
+    auto id = audioInput->start([&](const int16_t* data, const size_t size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        receivingThread = std::this_thread::get_id();
+        received.insert(received.end(), data, data + size);
+    });
+    ASSERT_NE(id, INVALID_CHANNEL);
+
+    for (int j = 0; j < 100; j++) {
+        auto samples = createSamples(160, static_cast<int16_t>(j * 160));
+        EXPECT_EQ(m_platformAudioInput->write(samples.data(), samples.size()), 160);
+    }
+
+    ASSERT_TRUE(waitFor([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return received.size() == 16000u;
+    }));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_NE(receivingThread, std::this_thread::get_id());
+        for (size_t j = 0; j < received.size(); j++) {
+            ASSERT_EQ(received[j], static_cast<int16_t>(j));
+        }
+    }
+    // the channel thread is stopped before the locals its callback uses are destroyed
+    audioInput->stop(id);
+    audioInput->doShutdown();
+}
+
+TEST_F(AudioInputEngineImplTest, slowChannelDoesNotBlockWriterOrOtherChannels) {
+    auto audioInput =
+        AudioInputEngineImpl::create(m_platformAudioInput, "test", AudioInputEngineImpl::FanOut::BUFFERED, 1024);
+    ASSERT_NE(audioInput, nullptr);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<size_t> slowSamples{0};
+    auto slow = audioInput->start([&](const int16_t* data, const size_t size) {
+        released.wait();
+        slowSamples += size;
+    });
+    std::atomic<size_t> fastSamples{0};
+    auto fast = audioInput->start([&](const int16_t* data, const size_t size) { fastSamples += size; });
+
+    // the writes return while the slow channel is blocked, and the audio that does not fit is dropped for it
+    for (int j = 0; j < 50; j++) {
+        auto samples = createSamples(160, 0);
+        EXPECT_EQ(m_platformAudioInput->write(samples.data(), samples.size()), 160);
+        ASSERT_TRUE(waitFor([&] { return fastSamples == (j + 1) * 160u; }));
+    }
+
+    release.set_value();
+    ASSERT_TRUE(waitFor([&] { return slowSamples > 0; }));
+    audioInput->stop(slow);
+    audioInput->stop(fast);
+    EXPECT_LE(slowSamples, 160u + 1024u / sizeof(int16_t));
+    EXPECT_EQ(m_platformAudioInput->stopped, 1);
+    audioInput->doShutdown();
+}
+
+TEST_F(AudioInputEngineImplTest, callbackIsNotCalledAfterStop) {
+    auto audioInput =
+        AudioInputEngineImpl::create(m_platformAudioInput, "test", AudioInputEngineImpl::FanOut::BUFFERED, 1 << 16);
+    ASSERT_NE(audioInput, nullptr);
+
+    std::atomic<bool> stopped{false};
+    std::atomic<bool> calledAfterStop{false};
+    std::atomic<size_t> calls{0};
+    auto id = audioInput->start([&](const int16_t* data, const size_t size) {
+        calledAfterStop = calledAfterStop || stopped;
+        calls++;
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    });
+
+    std::atomic<bool> writing{true};
+    std::thread writer([&] {
+        auto samples = createSamples(160, 0);
+        while (writing) {
+            m_platformAudioInput->write(samples.data(), samples.size());
+            std::this_thread::yield();
+        }
+    });
+
+    ASSERT_TRUE(waitFor([&] { return calls > 10; }));
+    audioInput->stop(id);
+    stopped = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    writing = false;
+    writer.join();
+    EXPECT_FALSE(calledAfterStop);
+
+    // a channel can stop itself from its callback
+    std::promise<void> selfStopped;
+    std::atomic<AudioInputEngineImpl::ChannelId> selfId{INVALID_CHANNEL};
+    std::atomic<bool> once{false};
+    selfId = audioInput->start([&](const int16_t* data, const size_t size) {
+        if (!once.exchange(true)) {
+            while (selfId == INVALID_CHANNEL) {
+                std::this_thread::yield();
+            }
+            audioInput->stop(selfId);
+            selfStopped.set_value();
+        }
+    });
+    auto samples = createSamples(160, 0);
+    m_platformAudioInput->write(samples.data(), samples.size());
+    EXPECT_EQ(selfStopped.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    audioInput->doShutdown();
+}
+
+TEST_F(AudioInputEngineImplTest, convertsInputFormat) {
+    AudioInputEngineImpl::InputFormat inputFormat(48000, 2);
+    auto audioInput = AudioInputEngineImpl::create(
+        m_platformAudioInput, "test", AudioInputEngineImpl::FanOut::DIRECT, 0, inputFormat);
+    ASSERT_NE(audioInput, nullptr);
+
+    std::vector<int16_t> received;
+    auto id = audioInput->start(
+        [&received](const int16_t* data, const size_t size) { received.insert(received.end(), data, data + size); });
+    ASSERT_NE(id, INVALID_CHANNEL);
+
+    // 100 ms of 48 kHz stereo audio whose channels average 100, with a frame split between two writes
+    std::vector<int16_t> samples;
+    for (int j = 0; j < 4800; j++) {
+        samples.insert(samples.end(), {50, 150});
+    }
+    EXPECT_EQ(m_platformAudioInput->write(samples.data(), 3), 3);
+    EXPECT_EQ(m_platformAudioInput->write(samples.data() + 3, samples.size() - 3), 9597);
+    ASSERT_EQ(received.size(), 1600u);
+
+    // the level is kept once the filter is filled
+    for (size_t j = 100; j < received.size(); j++) {
+        ASSERT_NEAR(received[j], 100, 1);
+    }
+
+    EXPECT_EQ(
+        AudioInputEngineImpl::create(m_platformAudioInput, "test", AudioInputEngineImpl::FanOut::DIRECT, 0, {0, 1}),
+        nullptr);
+
+    // a rate of no small ratio to 16 kHz is not supported by the resampler
+    EXPECT_EQ(
+        AudioInputEngineImpl::create(
+            m_platformAudioInput, "test", AudioInputEngineImpl::FanOut::DIRECT, 0, {44101, 1}),
+        nullptr);
+    audioInput->stop(id);
+    audioInput->doShutdown();
+}
+
+TEST_F(AudioInputEngineImplTest, bufferedFanOutConvertsOnConverterThread) {
+    // the converter buffer does not hold a whole number of 3-channel frames, so frames are split when it wraps
+    AudioInputEngineImpl::InputFormat inputFormat(48000, 3);
+    auto audioInput = AudioInputEngineImpl::create(
+        m_platformAudioInput, "test", AudioInputEngineImpl::FanOut::BUFFERED, 2048, inputFormat);
+    ASSERT_NE(audioInput, nullptr);
+
+    std::mutex mutex;
+    std::vector<int16_t> received;
+    std::thread::id receivingThread;
+    auto id = audioInput->start([&](const int16_t* data, const size_t size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        receivingThread = std::this_thread::get_id();
+        received.insert(received.end(), data, data + size);
+    });
+    ASSERT_NE(id, INVALID_CHANNEL);
+
+    // 1 s of audio whose channels average 100, written 10 ms at a time once the previous write is delivered
+    std::vector<int16_t> samples;
+    for (int j = 0; j < 480; j++) {
+        samples.insert(samples.end(), {0, 100, 200});
+    }
+    for (size_t j = 1; j <= 100; j++) {
+        EXPECT_EQ(m_platformAudioInput->write(samples.data(), samples.size()), 1440);
+        ASSERT_TRUE(waitFor([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return received.size() == j * 160;
+        }));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_NE(receivingThread, std::this_thread::get_id());
+        for (size_t j = 100; j < received.size(); j++) {
+            ASSERT_NEAR(received[j], 100, 1);
+        }
+    }
+    audioInput->stop(id);
+    EXPECT_EQ(m_platformAudioInput->stopped, 1);
+    audioInput->doShutdown();
+}
+
+// a processor keeping the first channel of each frame, less the reference
+class TestProcessor : public AudioInputProcessor {
+public:
+    void reset() override {
+        resets++;
+    }
+
+    void process(AudioInputBlock& block) override {
+        for (size_t j = 0; j < block.frames; j++) {
+            auto reference = block.reference != nullptr ? block.reference[j] : 0;
+            block.samples[j] = static_cast<int16_t>(block.samples[j * block.channels] - reference);
+        }
+        block.channels = 1;
+        processed += block.frames;
+    }
+
+    int resets = 0;
+    size_t processed = 0;
+};
+
+TEST_F(AudioInputEngineImplTest, processesInputBeforeConversion) {
+    auto processor = std::make_shared<TestProcessor>();
+    auto referenceTap = AudioReferenceTap::create(16000);
+    ASSERT_NE(referenceTap, nullptr);
+    auto audioInput = AudioInputEngineImpl::create(
+        m_platformAudioInput,
+        "test",
+        AudioInputEngineImpl::FanOut::DIRECT,
+        0,
+        {16000, 2},
+        {processor},
+        referenceTap);
+    ASSERT_NE(audioInput, nullptr);
+
+    std::vector<int16_t> received;
+    auto id = audioInput->start(
+        [&received](const int16_t* data, const size_t size) { received.insert(received.end(), data, data + size); });
+    ASSERT_NE(id, INVALID_CHANNEL);
+
+    // the outputs played nothing, so the first channel is delivered as it is, and the written audio isn't changed
+    std::vector<int16_t> samples = {1, 100, 2, 200, 3, 300};
+    auto written = samples;
+    EXPECT_EQ(m_platformAudioInput->write(samples.data(), samples.size()), 6);
+    EXPECT_EQ(received, std::vector<int16_t>({1, 2, 3}));
+    EXPECT_EQ(samples, written);
+    EXPECT_EQ(processor->resets, 1);
+    EXPECT_EQ(processor->processed, 3u);
+
+    // a reference of the wrong sample rate is rejected
+    EXPECT_EQ(
+        AudioInputEngineImpl::create(
+            m_platformAudioInput,
+            "test",
+            AudioInputEngineImpl::FanOut::DIRECT,
+            0,
+            {48000, 2},
+            {processor},
+            referenceTap),
+        nullptr);
+    audioInput->stop(id);
+    audioInput->doShutdown();
+}
+
+TEST_F(AudioInputEngineImplTest, standbyKeepsInputStartedAndDeliversPreRoll) {
+    // a 10 ms pre-roll is 160 samples
+    AudioInputEngineImpl::Standby standby(std::chrono::seconds(10), std::chrono::milliseconds(10));
+    auto audioInput = AudioInputEngineImpl::create(
+        m_platformAudioInput, "test", AudioInputEngineImpl::FanOut::DIRECT, 0, {}, {}, nullptr, standby);
+    ASSERT_NE(audioInput, nullptr);
+
+    std::vector<int16_t> received;
+    auto callback = [&received](const int16_t* data, const size_t size) {
+        received.insert(received.end(), data, data + size);
+    };
+    audioInput->stop(audioInput->start(callback));
+    EXPECT_EQ(m_platformAudioInput->started, 1);
+    EXPECT_EQ(m_platformAudioInput->stopped, 0);
+
+    // the audio written in standby is not delivered, and only the latest pre-roll is kept
+    received.clear();
+    for (int j = 0; j < 4; j++) {
+        auto samples = createSamples(100, static_cast<int16_t>(j * 100));
+        m_platformAudioInput->write(samples.data(), samples.size());
+    }
+    EXPECT_TRUE(received.empty());
+
+    // the next channel starts without starting the platform input, and the pre-roll precedes the written audio
+    auto id = audioInput->start(callback);
+    ASSERT_NE(id, INVALID_CHANNEL);
+    EXPECT_EQ(m_platformAudioInput->started, 1);
+    auto samples = createSamples(100, 400);
+    m_platformAudioInput->write(samples.data(), samples.size());
+    ASSERT_EQ(received, createSamples(260, 240));
+
+    // the platform input started for the standby is stopped by the shutdown
+    audioInput->stop(id);
+    EXPECT_EQ(m_platformAudioInput->stopped, 0);
+    audioInput->doShutdown();
+    EXPECT_EQ(m_platformAudioInput->stopped, 1);
+}
+
+TEST_F(AudioInputEngineImplTest, standbyStopsInputAfterHoldTime) {
+    AudioInputEngineImpl::Standby standby(std::chrono::milliseconds(50), std::chrono::milliseconds(10));
+    auto audioInput = AudioInputEngineImpl::create(
+        m_platformAudioInput, "test", AudioInputEngineImpl::FanOut::DIRECT, 0, {}, {}, nullptr, standby);
+    ASSERT_NE(audioInput, nullptr);
+    auto callback = [](const int16_t* data, const size_t size) {};
+
+    audioInput->stop(audioInput->start(callback));
+    ASSERT_TRUE(waitFor([this] { return m_platformAudioInput->stopped == 1; }));
+
+    // the input is started again from cold
+    auto id = audioInput->start(callback);
+    EXPECT_EQ(m_platformAudioInput->started, 2);
+    audioInput->stop(id);
+    audioInput->doShutdown();
+}
+
+TEST_F(AudioInputEngineImplTest, bufferedFanOutDeliversPreRollBeforeWrittenAudio) {
+    AudioInputEngineImpl::Standby standby(std::chrono::seconds(10), std::chrono::milliseconds(10));
+    auto audioInput = AudioInputEngineImpl::create(
+        m_platformAudioInput, "test", AudioInputEngineImpl::FanOut::BUFFERED, 1 << 16, {}, {}, nullptr, standby);
+    ASSERT_NE(audioInput, nullptr);
+
+    std::mutex mutex;
+    std::vector<int16_t> received;
+    auto callback = [&](const int16_t* data, const size_t size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.insert(received.end(), data, data + size);
+    };
+    audioInput->stop(audioInput->start(callback));
+    auto samples = createSamples(200, 0);
+    m_platformAudioInput->write(samples.data(), samples.size());
+
+    auto id = audioInput->start(callback);
+    ASSERT_NE(id, INVALID_CHANNEL);
+    samples = createSamples(100, 200);
+    m_platformAudioInput->write(samples.data(), samples.size());
+    ASSERT_TRUE(waitFor([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return received.size() >= 260u;
+    }));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(received, createSamples(260, 40));
+    }
+    audioInput->stop(id);
+    audioInput->doShutdown();
+}
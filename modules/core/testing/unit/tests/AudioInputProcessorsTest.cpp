@@ -0,0 +1,126 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include <AACE/Engine/Audio/AudioInputProcessors.h>
+#include <AACE/Engine/Utils/PCM/PCMUtils.h>
+
+using namespace aace::engine::audio;
+
+static const uint32_t SAMPLE_RATE = 16000;
+
+// 10 ms blocks
+static const size_t BLOCK_FRAMES = 160;
+
+// a 1 kHz tone of an amplitude, plus an offset
+static std::vector<int16_t> createTone(size_t frames, uint32_t channels, double amplitude, int16_t offset = 0) {
+    std::vector<int16_t> samples(frames * channels);
+    for (size_t j = 0; j < frames; j++) {
+        auto value = amplitude * std::sin(2.0 * 3.14159265358979323846 * 1000.0 * j / SAMPLE_RATE) + offset;
+        for (uint32_t channel = 0; channel < channels; channel++) {
+            samples[j * channels + channel] = static_cast<int16_t>(std::lrint(value));
+        }
+    }
+    return samples;
+}
+
+static AudioInputBlock createBlock(std::vector<int16_t>& samples, uint32_t channels) {
+    return {samples.data(), samples.size() / channels, channels, SAMPLE_RATE, nullptr};
+}
+
+TEST(AudioInputProcessorsTest, highPassFilterRemovesOffset) {
+    EXPECT_EQ(HighPassFilterProcessor::create(SAMPLE_RATE, 0.0f), nullptr);
+    EXPECT_EQ(HighPassFilterProcessor::create(SAMPLE_RATE, 8000.0f), nullptr);
+
+    auto filter = HighPassFilterProcessor::create(SAMPLE_RATE);
+    ASSERT_NE(filter, nullptr);
+
+    // 1 s of a tone on a large offset, in blocks, so the state is kept between the blocks
+    auto samples = createTone(SAMPLE_RATE, 2, 1000.0, 8000);
+    for (size_t offset = 0; offset < samples.size(); offset += BLOCK_FRAMES * 2) {
+        AudioInputBlock block = {samples.data() + offset, BLOCK_FRAMES, 2, SAMPLE_RATE, nullptr};
+        filter->process(block);
+        EXPECT_EQ(block.channels, 2u);
+    }
+
+    // the end of the audio is the tone alone, and the tone is hardly attenuated
+    std::vector<int16_t> end(samples.end() - BLOCK_FRAMES * 2, samples.end());
+    double sum = 0;
+    for (auto next : end) {
+        sum += next;
+    }
+    EXPECT_NEAR(sum / end.size(), 0.0, 20.0);
+    auto toneLevel = 20 * std::log10(1000.0 / std::sqrt(2) / 32768);
+    EXPECT_NEAR(aace::engine::utils::pcm::levelDbfs(end.data(), end.size()), toneLevel, 0.5);
+}
+
+TEST(AudioInputProcessorsTest, automaticGainControlApproachesTarget) {
+    EXPECT_EQ(AutomaticGainControlProcessor::create(0), nullptr);
+    EXPECT_EQ(AutomaticGainControlProcessor::create(SAMPLE_RATE, {-20.0f, 18.0f, -60.0f, 0.0f}), nullptr);
+
+    // a target of -20 dBFS, up to 12 dB of gain raised by 6 dB a second
+    auto agc = AutomaticGainControlProcessor::create(SAMPLE_RATE, {-20.0f, 12.0f, -60.0f, 6.0f});
+    ASSERT_NE(agc, nullptr);
+
+    // a tone at -40 dBFS is raised gradually, up to the largest gain
+    auto quiet = createTone(BLOCK_FRAMES, 1, 328.0 * std::sqrt(2));
+    auto block = quiet;
+    auto audioBlock = createBlock(block, 1);
+    agc->process(audioBlock);
+    EXPECT_NEAR(agc->getGain(), 0.06f, 0.001f);
+    for (int j = 0; j < 300; j++) {
+        block = quiet;
+        agc->process(audioBlock);
+    }
+    EXPECT_FLOAT_EQ(agc->getGain(), 12.0f);
+    EXPECT_NEAR(aace::engine::utils::pcm::levelDbfs(block.data(), block.size()), -28.0f, 0.1f);
+
+    // the gain is held under the noise gate
+    std::vector<int16_t> silence(BLOCK_FRAMES, 0);
+    auto silentBlock = createBlock(silence, 1);
+    agc->process(silentBlock);
+    EXPECT_FLOAT_EQ(agc->getGain(), 12.0f);
+
+    // a tone at -12 dBFS is attenuated at once
+    auto loud = createTone(BLOCK_FRAMES, 1, 8192.0 * std::sqrt(2));
+    auto loudBlock = createBlock(loud, 1);
+    agc->process(loudBlock);
+    EXPECT_NEAR(agc->getGain(), -7.96f, 0.05f);
+    EXPECT_NEAR(aace::engine::utils::pcm::levelDbfs(loud.data(), loud.size()), -20.0f, 0.1f);
+
+    agc->reset();
+    EXPECT_FLOAT_EQ(agc->getGain(), 0.0f);
+}
+
+TEST(AudioInputProcessorsTest, downmixMixesToMono) {
+    auto downmix = DownmixProcessor::create();
+    ASSERT_NE(downmix, nullptr);
+
+    std::vector<int16_t> samples = {100, 200, 300, 400, -4, -8, -12, -16};
+    auto block = createBlock(samples, 4);
+    downmix->process(block);
+    EXPECT_EQ(block.channels, 1u);
+    EXPECT_EQ(block.frames, 2u);
+    EXPECT_EQ(samples[0], 250);
+    EXPECT_EQ(samples[1], -10);
+
+    // a mono block is not changed
+    downmix->process(block);
+    EXPECT_EQ(block.channels, 1u);
+    EXPECT_EQ(samples[0], 250);
+}
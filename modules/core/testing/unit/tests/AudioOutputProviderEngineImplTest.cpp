@@ -0,0 +1,134 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/Audio/AudioOutputProviderEngineImpl.h>
+
+using aace::engine::audio::AudioOutputProviderEngineImpl;
+using AudioOutputType = aace::audio::AudioOutputProvider::AudioOutputType;
+
+class TestAudioOutput : public aace::audio::AudioOutput {
+public:
+    bool prepare(std::shared_ptr<aace::audio::AudioStream> stream, bool repeating) override {
+        return true;
+    }
+    bool prepare(const std::string& url, bool repeating) override {
+        return true;
+    }
+    void mayDuck() override {
+    }
+    bool play() override {
+        return true;
+    }
+    bool stop() override {
+        return true;
+    }
+    bool pause() override {
+        return true;
+    }
+    bool resume() override {
+        return true;
+    }
+    bool startDucking() override {
+        return true;
+    }
+    bool stopDucking() override {
+        return true;
+    }
+    int64_t getPosition() override {
+        return 0;
+    }
+    bool setPosition(int64_t position) override {
+        return true;
+    }
+    int64_t getDuration() override {
+        return 0;
+    }
+    bool volumeChanged(float volume) override {
+        return true;
+    }
+    bool mutedStateChanged(MutedState state) override {
+        return true;
+    }
+    void prewarm() override {
+        prewarmed++;
+    }
+
+    int prewarmed = 0;
+};
+
+class TestAudioOutputProvider : public aace::audio::AudioOutputProvider {
+public:
+    std::shared_ptr<aace::audio::AudioOutput> openChannel(const std::string& name, AudioOutputType type) override {
+        auto audioOutput = std::make_shared<TestAudioOutput>();
+        opened.push_back(audioOutput);
+        return audioOutput;
+    }
+
+    std::vector<std::shared_ptr<TestAudioOutput>> opened;
+};
+
+class AudioOutputProviderEngineImplTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_platformAudioOutputProvider = std::make_shared<TestAudioOutputProvider>();
+        m_audioOutputProvider = AudioOutputProviderEngineImpl::create(m_platformAudioOutputProvider);
+        ASSERT_NE(m_audioOutputProvider, nullptr);
+    }
+
+    void TearDown() override {
+        m_audioOutputProvider->doShutdown();
+    }
+
+protected:
+    std::shared_ptr<TestAudioOutputProvider> m_platformAudioOutputProvider;
+    std::shared_ptr<AudioOutputProviderEngineImpl> m_audioOutputProvider;
+};
+
+TEST_F(AudioOutputProviderEngineImplTest, prewarmsTheOpenedChannel) {
+    auto channel = m_audioOutputProvider->openChannel("SpeechSynthesizer", AudioOutputType::TTS);
+    ASSERT_NE(channel, nullptr);
+    ASSERT_TRUE(m_audioOutputProvider->prewarmChannel("SpeechSynthesizer", AudioOutputType::TTS));
+
+    ASSERT_EQ(m_platformAudioOutputProvider->opened.size(), 1u);
+    EXPECT_EQ(m_platformAudioOutputProvider->opened[0]->prewarmed, 1);
+}
+
+TEST_F(AudioOutputProviderEngineImplTest, keepsThePrewarmedChannelOfAnotherType) {
+    ASSERT_TRUE(m_audioOutputProvider->prewarmChannel("SystemSoundPlayer", AudioOutputType::EARCON));
+    ASSERT_EQ(m_platformAudioOutputProvider->opened.size(), 1u);
+    EXPECT_EQ(m_platformAudioOutputProvider->opened[0]->prewarmed, 1);
+
+    // the channel of another type is opened for the component
+    EXPECT_NE(m_audioOutputProvider->openChannel("SystemSoundPlayer", AudioOutputType::ALARM), nullptr);
+    EXPECT_EQ(m_platformAudioOutputProvider->opened.size(), 2u);
+}
+
+TEST_F(AudioOutputProviderEngineImplTest, handsThePrewarmedChannelToTheFirstComponent) {
+    ASSERT_TRUE(m_audioOutputProvider->prewarmChannel("Alerts", AudioOutputType::ALARM));
+    auto prewarmed = m_audioOutputProvider->openChannel("Alerts", AudioOutputType::ALARM);
+    ASSERT_NE(prewarmed, nullptr);
+    EXPECT_EQ(m_platformAudioOutputProvider->opened.size(), 1u);
+
+    // the pre-warmed channel is handed out once
+    auto next = m_audioOutputProvider->openChannel("Alerts", AudioOutputType::ALARM);
+    ASSERT_NE(next, nullptr);
+    EXPECT_NE(next, prewarmed);
+    EXPECT_EQ(m_platformAudioOutputProvider->opened.size(), 2u);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <AACE/Engine/Audio/AudioReferenceTap.h>
+
+using aace::engine::audio::AudioReferenceTap;
+using Clock = AudioReferenceTap::Clock;
+
+// 1 kHz, so a sample is a millisecond
+static const uint32_t SAMPLE_RATE = 1000;
+
+static std::vector<int16_t> read(AudioReferenceTap& tap, size_t count, Clock::time_point now) {
+    std::vector<int16_t> samples(count, -1);
+    tap.read(samples.data(), count, now);
+    return samples;
+}
+
+static void write(AudioReferenceTap::Source& source, const std::vector<int16_t>& samples, Clock::time_point now) {
+    source.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(int16_t), now);
+}
+
+class AudioReferenceTapTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        // a 100 ms timeline, which a stream can be written 50 ms ahead of
+        m_tap = AudioReferenceTap::create(SAMPLE_RATE, std::chrono::milliseconds(100));
+        ASSERT_NE(m_tap, nullptr);
+        m_start = Clock::now() + std::chrono::seconds(1);
+    }
+
+    Clock::time_point at(int milliseconds) {
+        return m_start + std::chrono::milliseconds(milliseconds);
+    }
+
+protected:
+    std::shared_ptr<AudioReferenceTap> m_tap;
+    Clock::time_point m_start;
+};
+
+TEST_F(AudioReferenceTapTest, rejectsInvalidArguments) {
+    EXPECT_EQ(AudioReferenceTap::create(0), nullptr);
+    EXPECT_EQ(AudioReferenceTap::create(SAMPLE_RATE, std::chrono::milliseconds(0)), nullptr);
+    EXPECT_EQ(m_tap->createSource(0, 1), nullptr);
+    EXPECT_EQ(m_tap->createSource(SAMPLE_RATE, 0), nullptr);
+}
+
+TEST_F(AudioReferenceTapTest, readsTheAudioOfTheTime) {
+    auto source = m_tap->createSource(SAMPLE_RATE, 1);
+    ASSERT_NE(source, nullptr);
+
+    // nothing was played
+    EXPECT_EQ(read(*m_tap, 10, at(0)), std::vector<int16_t>(10, 0));
+
+    // 20 ms of audio read at once are played from the time they were read
+    std::vector<int16_t> samples(20);
+    for (size_t j = 0; j < samples.size(); j++) {
+        samples[j] = static_cast<int16_t>(j + 1);
+    }
+    write(*source, samples, at(0));
+    EXPECT_EQ(read(*m_tap, 10, at(10)), std::vector<int16_t>(samples.begin(), samples.begin() + 10));
+
+    // the audio following on is placed after the previous audio, and silence follows it
+    write(*source, {100, 200}, at(5));
+    auto expected = std::vector<int16_t>(samples.begin() + 10, samples.end());
+    expected.insert(expected.end(), {100, 200, 0, 0, 0, 0, 0, 0, 0, 0});
+    EXPECT_EQ(read(*m_tap, 20, at(30)), expected);
+}
+
+TEST_F(AudioReferenceTapTest, mixesTheStreams) {
+    // a stereo stream at twice the rate, and a mono stream
+    auto stereo = m_tap->createSource(SAMPLE_RATE * 2, 2);
+    auto mono = m_tap->createSource(SAMPLE_RATE, 1);
+    ASSERT_NE(stereo, nullptr);
+    ASSERT_NE(mono, nullptr);
+
+    // 4 ms of stereo audio, whose channels average 1000, split within a frame
+    std::vector<int16_t> frames;
+    for (int j = 0; j < 8; j++) {
+        frames.insert(frames.end(), {500, 1500});
+    }
+    auto bytes = reinterpret_cast<const char*>(frames.data());
+    stereo->write(bytes, 3, at(0));
+    stereo->write(bytes + 3, frames.size() * sizeof(int16_t) - 3, at(0));
+    write(*mono, {32000, 32000, -5, -5}, at(0));
+
+    EXPECT_EQ(read(*m_tap, 4, at(4)), std::vector<int16_t>({INT16_MAX, INT16_MAX, 995, 995}));
+}
+
+TEST_F(AudioReferenceTapTest, restartsLateStreamsAndDropsEarlyAudio) {
+    auto source = m_tap->createSource(SAMPLE_RATE, 1);
+    ASSERT_NE(source, nullptr);
+
+    // the audio more than 50 ms ahead of the time is dropped
+    write(*source, std::vector<int16_t>(60, 7), at(0));
+    auto samples = read(*m_tap, 60, at(60));
+    EXPECT_EQ(std::vector<int16_t>(samples.begin(), samples.begin() + 50), std::vector<int16_t>(50, 7));
+    EXPECT_EQ(std::vector<int16_t>(samples.begin() + 50, samples.end()), std::vector<int16_t>(10, 0));
+
+    // the stream is late, so its next audio is played from the time it was read
+    write(*source, {9, 9}, at(80));
+    EXPECT_EQ(read(*m_tap, 4, at(82)), std::vector<int16_t>({0, 0, 9, 9}));
+
+    // the audio older than the timeline is not read
+    EXPECT_EQ(read(*m_tap, 4, at(200)), std::vector<int16_t>(4, 0));
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Network/BackgroundTransferScheduler.h>
+
+using aace::engine::network::BackgroundTransferScheduler;
+using NetworkStatus = aace::engine::network::NetworkInfoObserver::NetworkStatus;
+using Priority = BackgroundTransferScheduler::Priority;
+
+/// Records the names of the transfers run
+class TransferRecorder {
+public:
+    BackgroundTransferScheduler::Transfer transfer(const std::string& name) {
+        return [this, name]() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_names.push_back(name);
+            m_ran.notify_all();
+        };
+    }
+
+    std::vector<std::string> getNames() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_names;
+    }
+
+    bool waitForCount(size_t count, std::chrono::milliseconds timeout = std::chrono::seconds(2)) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_ran.wait_for(lock, timeout, [this, count]() { return m_names.size() >= count; });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_ran;
+    std::vector<std::string> m_names;
+};
+
+class BackgroundTransferSchedulerTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        if (m_scheduler != nullptr) {
+            m_scheduler->shutdown();
+        }
+    }
+
+    void createScheduler(
+        std::chrono::milliseconds maxDeferral = std::chrono::minutes(1),
+        std::chrono::milliseconds minInterval = std::chrono::milliseconds::zero()) {
+        BackgroundTransferScheduler::Configuration configuration;
+        configuration.maxDeferral = maxDeferral;
+        configuration.minInterval = minInterval;
+        m_scheduler = BackgroundTransferScheduler::create(configuration);
+        ASSERT_NE(nullptr, m_scheduler);
+    }
+
+    std::shared_ptr<BackgroundTransferScheduler> m_scheduler;
+    TransferRecorder m_recorder;
+};
+
+TEST_F(BackgroundTransferSchedulerTest, createWithInvalidConfiguration) {
+    BackgroundTransferScheduler::Configuration configuration;
+    configuration.maxDeferral = std::chrono::milliseconds(-1);
+    EXPECT_EQ(nullptr, BackgroundTransferScheduler::create(configuration));
+
+    configuration.maxDeferral = std::chrono::minutes(1);
+    configuration.minInterval = std::chrono::milliseconds(-1);
+    EXPECT_EQ(nullptr, BackgroundTransferScheduler::create(configuration));
+}
+
+TEST_F(BackgroundTransferSchedulerTest, transfersRunWhenTheNetworkIsConnected) {
+    createScheduler();
+    m_scheduler->onNetworkInfoChanged(NetworkStatus::DISCONNECTED, 0);
+    ASSERT_TRUE(m_scheduler->submit("upload", Priority::BACKGROUND, m_recorder.transfer("upload")));
+    ASSERT_TRUE(m_scheduler->submit("request", Priority::INTERACTIVE, m_recorder.transfer("request")));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(m_recorder.getNames().empty());
+    EXPECT_EQ(2u, m_scheduler->getPendingTransferCount());
+
+    // the interactive transfer runs first
+    m_scheduler->onNetworkInfoChanged(NetworkStatus::CONNECTED, -50);
+    ASSERT_TRUE(m_recorder.waitForCount(2));
+    EXPECT_EQ((std::vector<std::string>{"request", "upload"}), m_recorder.getNames());
+    EXPECT_EQ(0u, m_scheduler->getPendingTransferCount());
+}
+
+TEST_F(BackgroundTransferSchedulerTest, transfersWaitForTheEndOfTheVoiceInteraction) {
+    createScheduler();
+    m_scheduler->setVoiceActive(true);
+    ASSERT_TRUE(m_scheduler->submit("request", Priority::INTERACTIVE, m_recorder.transfer("request")));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(m_recorder.getNames().empty());
+
+    m_scheduler->setVoiceActive(false);
+    EXPECT_TRUE(m_recorder.waitForCount(1));
+}
+
+TEST_F(BackgroundTransferSchedulerTest, backgroundTransfersAreDeferredOnMeteredLink) {
+    createScheduler(std::chrono::milliseconds(300));
+    m_scheduler->setMetered(true);
+    ASSERT_TRUE(m_scheduler->submit("upload", Priority::BACKGROUND, m_recorder.transfer("upload")));
+    ASSERT_TRUE(m_scheduler->submit("request", Priority::INTERACTIVE, m_recorder.transfer("request")));
+
+    // the interactive transfer isn't deferred, and the background transfer runs after the max deferral
+    ASSERT_TRUE(m_recorder.waitForCount(1));
+    EXPECT_EQ((std::vector<std::string>{"request"}), m_recorder.getNames());
+    ASSERT_TRUE(m_recorder.waitForCount(2));
+    EXPECT_EQ((std::vector<std::string>{"request", "upload"}), m_recorder.getNames());
+}
+
+TEST_F(BackgroundTransferSchedulerTest, backgroundTransfersAreDeferredOnWeakWifiSignal) {
+    createScheduler();
+    m_scheduler->onNetworkInfoChanged(NetworkStatus::CONNECTED, -90);
+    ASSERT_TRUE(m_scheduler->submit("upload", Priority::BACKGROUND, m_recorder.transfer("upload")));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(m_recorder.getNames().empty());
+
+    m_scheduler->onNetworkInfoChanged(NetworkStatus::CONNECTED, -60);
+    EXPECT_TRUE(m_recorder.waitForCount(1));
+}
+
+TEST_F(BackgroundTransferSchedulerTest, pendingTransferOfTheSameNameIsReplaced) {
+    createScheduler();
+    m_scheduler->onNetworkInfoChanged(NetworkStatus::DISCONNECTED, 0);
+    ASSERT_TRUE(m_scheduler->submit("upload", Priority::BACKGROUND, m_recorder.transfer("first")));
+    ASSERT_TRUE(m_scheduler->submit("upload", Priority::BACKGROUND, m_recorder.transfer("second")));
+    EXPECT_EQ(1u, m_scheduler->getPendingTransferCount());
+
+    m_scheduler->onNetworkInfoChanged(NetworkStatus::CONNECTED, 0);
+    ASSERT_TRUE(m_recorder.waitForCount(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ((std::vector<std::string>{"second"}), m_recorder.getNames());
+}
+
+TEST_F(BackgroundTransferSchedulerTest, transfersRunAtLeastTheMinIntervalApart) {
+    createScheduler(std::chrono::minutes(1), std::chrono::milliseconds(200));
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(m_scheduler->submit("first", Priority::INTERACTIVE, m_recorder.transfer("first")));
+    ASSERT_TRUE(m_scheduler->submit("second", Priority::INTERACTIVE, m_recorder.transfer("second")));
+    ASSERT_TRUE(m_recorder.waitForCount(2));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(200));
+    EXPECT_EQ((std::vector<std::string>{"first", "second"}), m_recorder.getNames());
+}
+
+TEST_F(BackgroundTransferSchedulerTest, shutdownDropsThePendingTransfers) {
+    createScheduler();
+    m_scheduler->onNetworkInfoChanged(NetworkStatus::DISCONNECTED, 0);
+    ASSERT_TRUE(m_scheduler->submit("upload", Priority::BACKGROUND, m_recorder.transfer("upload")));
+    m_scheduler->shutdown();
+    EXPECT_EQ(0u, m_scheduler->getPendingTransferCount());
+    EXPECT_FALSE(m_scheduler->submit("upload", Priority::BACKGROUND, m_recorder.transfer("upload")));
+    EXPECT_TRUE(m_recorder.getNames().empty());
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <AACE/Engine/Logger/LogEntry.h>
+#include <AACE/Engine/Logger/Sinks/BinarySink.h>
+
+using aace::engine::logger::LogEntry;
+using aace::engine::logger::sink::BinarySink;
+using aace::engine::logger::sink::Sink;
+using Level = Sink::Level;
+
+class BinarySinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char path[] = "/tmp/aace-binary-sink-XXXXXX";
+        ASSERT_NE(mkdtemp(path), nullptr);
+        m_path = path;
+    }
+
+    void TearDown() override {
+        for (auto name : {"test.blog", "test.blog.1", "test.blog.2", "test.blog.3"}) {
+            unlink((m_path + "/" + name).c_str());
+        }
+        rmdir(m_path.c_str());
+    }
+
+    std::string read(const std::string& name) {
+        std::ifstream file(m_path + "/" + name, std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    uint64_t recordsSize(const std::string& contents) {
+        uint64_t size = 0;
+        for (int j = 7; j >= 0; j--) {
+            size = (size << 8) | static_cast<unsigned char>(contents[16 + j]);
+        }
+        return size;
+    }
+
+    void log(const std::shared_ptr<Sink>& sink, const LogEntry& entry) {
+        sink->log(Level::INFO, std::chrono::system_clock::now(), "AAC", "1", entry.c_str());
+    }
+
+    std::string m_path;
+};
+
+TEST_F(BinarySinkTest, writesHeaderAndRecords) {
+    std::shared_ptr<Sink> sink = BinarySink::create("test", m_path, "test");
+    ASSERT_NE(sink, nullptr);
+
+    log(sink, LogEntry("aace.test", "event").d("key", "value").m("message"));
+    sink.reset();
+
+    // the file is truncated to the header and records when the sink is closed
+    auto contents = read("test.blog");
+    ASSERT_GT(contents.size(), 32u);
+    EXPECT_EQ(std::memcmp(contents.data(), "AACBLOG", 8), 0);
+    EXPECT_EQ(recordsSize(contents), contents.size() - 32);
+
+    // the strings are written once, and the metadata value and message are copied
+    EXPECT_NE(contents.find("aace.test"), std::string::npos);
+    EXPECT_NE(contents.find("value"), std::string::npos);
+    EXPECT_NE(contents.find("message"), std::string::npos);
+}
+
+TEST_F(BinarySinkTest, stringsAreWrittenOnce) {
+    std::shared_ptr<Sink> sink = BinarySink::create("test", m_path, "test");
+    ASSERT_NE(sink, nullptr);
+
+    log(sink, LogEntry("aace.test", "event").d("key", "1"));
+    sink->flush();
+    auto first = recordsSize(read("test.blog"));
+
+    log(sink, LogEntry("aace.test", "event").d("key", "2"));
+    sink->flush();
+    auto second = recordsSize(read("test.blog")) - first;
+
+    // the second record only refers to the strings defined by the first one
+    EXPECT_LT(second, first);
+    EXPECT_LT(second, std::strlen("aace.test:event:key=2") + 16);
+}
+
+TEST_F(BinarySinkTest, rotatesLogFiles) {
+    {
+        std::shared_ptr<Sink> sink = BinarySink::create("test", m_path, "test", 256, 2);
+        ASSERT_NE(sink, nullptr);
+        for (int j = 0; j < 20; j++) {
+            log(sink, LogEntry("aace.test", "event").d("index", j).m(std::string(32, '.')));
+        }
+    }
+
+    auto current = read("test.blog");
+    auto rotated = read("test.blog.1");
+    ASSERT_GT(rotated.size(), 32u);
+    EXPECT_LE(rotated.size(), 256u);
+    EXPECT_EQ(recordsSize(rotated), rotated.size() - 32);
+
+    // each file defines the strings its records refer to
+    EXPECT_NE(current.find("aace.test"), std::string::npos);
+    EXPECT_NE(rotated.find("aace.test"), std::string::npos);
+
+    // creating the sink again keeps the log of the previous session
+    auto sink = BinarySink::create("test", m_path, "test", 256, 2);
+    ASSERT_NE(sink, nullptr);
+    EXPECT_EQ(read("test.blog.1"), current);
+}
+
+TEST_F(BinarySinkTest, dropsEntriesLargerThanFile) {
+    auto sink = BinarySink::create("test", m_path, "test", 128, 1);
+    ASSERT_NE(sink, nullptr);
+
+    std::shared_ptr<Sink> baseSink = sink;
+    log(baseSink, LogEntry("aace.test", "event").m(std::string(256, '.')));
+    EXPECT_EQ(sink->getDroppedEntries(), 1u);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#include <AACE/Engine/Utils/Trace/BootTrace.h>
+
+using aace::engine::utils::trace::BootTrace;
+
+class BootTraceTest : public ::testing::Test {
+public:
+    void TearDown() override {
+        BootTrace::stop();
+    }
+
+    /// Returns the complete events of the trace
+    static std::vector<nlohmann::json> getEvents(const std::string& trace) {
+        std::vector<nlohmann::json> events;
+        auto root = nlohmann::json::parse(trace);
+        for (auto& event : root["traceEvents"]) {
+            if (event["ph"] == "X") {
+                events.push_back(event);
+            }
+        }
+        return events;
+    }
+};
+
+TEST_F(BootTraceTest, recordsScopes) {
+    BootTrace::start();
+    EXPECT_TRUE(BootTrace::isRecording());
+    {
+        BootTrace::Scope outer("configure", "engine");
+        BootTrace::Scope inner("aace.alexa", "configure");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::thread([]() { BootTrace::Scope scope("aace.storage", "start"); }).join();
+
+    auto events = getEvents(BootTrace::toJson());
+    ASSERT_EQ(events.size(), 3u);
+
+    // the scopes are recorded when they end
+    EXPECT_EQ(events[0]["name"], "aace.alexa");
+    EXPECT_EQ(events[0]["cat"], "configure");
+    EXPECT_EQ(events[1]["name"], "configure");
+    EXPECT_EQ(events[1]["cat"], "engine");
+    EXPECT_GE(events[1]["dur"].get<int64_t>(), 5000);
+    EXPECT_LE(events[1]["ts"].get<int64_t>(), events[0]["ts"].get<int64_t>());
+    EXPECT_EQ(events[0]["tid"], events[1]["tid"]);
+    EXPECT_NE(events[2]["tid"], events[1]["tid"]);
+}
+
+TEST_F(BootTraceTest, stopsRecording) {
+    BootTrace::start();
+    { BootTrace::Scope scope("recorded", "engine"); }
+    BootTrace::stop();
+    EXPECT_FALSE(BootTrace::isRecording());
+    { BootTrace::Scope scope("dropped", "engine"); }
+
+    // a scope started while recording isn't recorded once the trace stops
+    BootTrace::start();
+    {
+        BootTrace::Scope scope("stopped", "engine");
+        BootTrace::stop();
+    }
+    EXPECT_TRUE(getEvents(BootTrace::toJson()).empty());
+}
+
+TEST_F(BootTraceTest, exportsTrace) {
+    BootTrace::start();
+    { BootTrace::Scope scope("initialize", "engine"); }
+    BootTrace::stop();
+
+    auto path = "BootTraceTest.json";
+    ASSERT_TRUE(BootTrace::exportTrace(path));
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::remove(path);
+
+    auto events = getEvents(contents.str());
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0]["name"], "initialize");
+    EXPECT_FALSE(BootTrace::exportTrace("/nonexistent/BootTraceTest.json"));
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <AACE/Engine/Storage/CachingLocalStorage.h>
+#include <AACE/Engine/Storage/SQLiteStorage.h>
+#include <AACE/Engine/Utils/Memory/MemoryPressure.h>
+#include <AACE/Test/Unit/Storage/InMemoryLocalStorage.h>
+
+using aace::engine::storage::CachingLocalStorage;
+using aace::engine::storage::SQLiteStorage;
+using aace::engine::utils::memory::MemoryPressure;
+using aace::engine::utils::memory::MemoryPressureLevel;
+using aace::test::unit::storage::InMemoryLocalStorage;
+
+static const std::string DATABASE_PATH("CachingLocalStorageTest.db");
+
+/// Storage writing the puts of a transaction when it is committed, which can block the puts and fail the commits
+class BlockingStorage : public InMemoryLocalStorage {
+public:
+    bool put(const std::string& table, const std::string& key, const std::string& value) override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_blockPuts) {
+            m_putBlocked = true;
+            m_changed.notify_all();
+            m_changed.wait(lock, [this]() { return !m_blockPuts; });
+        }
+        if (m_transactionInProgress) {
+            m_pending.emplace_back(table, KeyValuePair(key, value));
+            return true;
+        }
+        return InMemoryLocalStorage::put(table, key, value);
+    }
+    bool begin() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_transactionInProgress = true;
+        return true;
+    }
+    bool commit() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_failCommits) {
+            return false;
+        }
+        for (auto& next : m_pending) {
+            InMemoryLocalStorage::put(next.first, next.second.first, next.second.second);
+        }
+        m_pending.clear();
+        m_transactionInProgress = false;
+        return true;
+    }
+    bool cancel() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.clear();
+        m_transactionInProgress = false;
+        return true;
+    }
+
+    void blockPuts() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blockPuts = true;
+    }
+
+    bool waitForBlockedPut() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, std::chrono::seconds(5), [this]() { return m_putBlocked; });
+    }
+
+    void releasePuts() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blockPuts = false;
+        m_changed.notify_all();
+    }
+
+    void failCommits(bool fail) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_failCommits = fail;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_blockPuts = false;
+    bool m_putBlocked = false;
+    bool m_failCommits = false;
+    bool m_transactionInProgress = false;
+    std::vector<std::pair<std::string, KeyValuePair>> m_pending;
+};
+
+class CachingLocalStorageTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        removeDatabase();
+        m_storage = SQLiteStorage::create(DATABASE_PATH);
+        ASSERT_NE(m_storage, nullptr);
+    }
+
+    void TearDown() override {
+        m_storage.reset();
+        removeDatabase();
+    }
+
+    static void removeDatabase() {
+        std::remove(DATABASE_PATH.c_str());
+        std::remove((DATABASE_PATH + "-wal").c_str());
+        std::remove((DATABASE_PATH + "-shm").c_str());
+    }
+
+protected:
+    std::shared_ptr<SQLiteStorage> m_storage;
+};
+
+TEST_F(CachingLocalStorageTest, readsThroughAndWritesOnFlush) {
+    ASSERT_TRUE(m_storage->put("settings", "locale", "en-US"));
+
+    auto cache = CachingLocalStorage::create(m_storage, std::chrono::hours(1));
+    ASSERT_NE(cache, nullptr);
+    EXPECT_EQ(cache->get("settings", "locale"), "en-US");
+    EXPECT_TRUE(cache->containsTable("settings"));
+    EXPECT_FALSE(cache->containsTable("auth"));
+
+    // the changes are served from the cache until they are written
+    EXPECT_TRUE(cache->put("settings", "locale", "fr-CA"));
+    EXPECT_TRUE(cache->put("settings", "timezone", "UTC"));
+    EXPECT_TRUE(cache->put("auth", "state", "REFRESHED"));
+    EXPECT_EQ(cache->get("settings", "locale"), "fr-CA");
+    EXPECT_EQ(cache->keys("settings").size(), 2u);
+    EXPECT_EQ(m_storage->get("settings", "locale"), "en-US");
+    EXPECT_FALSE(m_storage->containsTable("auth"));
+
+    ASSERT_TRUE(cache->flush());
+    EXPECT_EQ(m_storage->get("settings", "locale"), "fr-CA");
+    EXPECT_EQ(m_storage->get("settings", "timezone"), "UTC");
+    EXPECT_EQ(m_storage->get("auth", "state"), "REFRESHED");
+}
+
+TEST_F(CachingLocalStorageTest, removesKeysAndTables) {
+    ASSERT_TRUE(m_storage->put("settings", "locale", "en-US"));
+    ASSERT_TRUE(m_storage->put("settings", "timezone", "UTC"));
+
+    auto cache = CachingLocalStorage::create(m_storage, std::chrono::hours(1));
+    ASSERT_NE(cache, nullptr);
+    EXPECT_TRUE(cache->removeKey("settings", "timezone"));
+    EXPECT_FALSE(cache->removeKey("settings", "timezone"));
+    EXPECT_FALSE(cache->containsKey("settings", "timezone"));
+
+    // a key written and removed before the flush is never written
+    EXPECT_TRUE(cache->put("settings", "temporary", "value"));
+    EXPECT_TRUE(cache->removeKey("settings", "temporary"));
+    ASSERT_TRUE(cache->flush());
+    EXPECT_FALSE(m_storage->containsKey("settings", "timezone"));
+    EXPECT_FALSE(m_storage->containsKey("settings", "temporary"));
+    EXPECT_TRUE(m_storage->containsKey("settings", "locale"));
+
+    // the table is removed before the keys written after the removal
+    EXPECT_TRUE(cache->removeTable("settings"));
+    EXPECT_FALSE(cache->containsTable("settings"));
+    EXPECT_FALSE(cache->removeTable("settings"));
+    EXPECT_TRUE(cache->put("settings", "timezone", "PST"));
+    ASSERT_TRUE(cache->flush());
+    EXPECT_FALSE(m_storage->containsKey("settings", "locale"));
+    EXPECT_EQ(m_storage->get("settings", "timezone"), "PST");
+}
+
+TEST_F(CachingLocalStorageTest, writesAfterFlushDelayAndOnDestruction) {
+    auto cache = CachingLocalStorage::create(m_storage, std::chrono::milliseconds(20));
+    ASSERT_NE(cache, nullptr);
+    EXPECT_TRUE(cache->put("settings", "locale", "en-US"));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!m_storage->containsKey("settings", "locale") && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(m_storage->get("settings", "locale"), "en-US");
+
+    cache = CachingLocalStorage::create(m_storage, std::chrono::hours(1));
+    ASSERT_NE(cache, nullptr);
+    EXPECT_TRUE(cache->put("settings", "locale", "de-DE"));
+    cache.reset();
+    EXPECT_EQ(m_storage->get("settings", "locale"), "de-DE");
+}
+
+TEST_F(CachingLocalStorageTest, transactionsWriteThrough) {
+    auto cache = CachingLocalStorage::create(m_storage, std::chrono::hours(1));
+    ASSERT_NE(cache, nullptr);
+
+    // the changes made before a transaction are written when it begins
+    EXPECT_TRUE(cache->put("settings", "locale", "en-US"));
+    ASSERT_TRUE(cache->begin());
+    EXPECT_EQ(m_storage->get("settings", "locale"), "en-US");
+    EXPECT_TRUE(cache->put("settings", "locale", "fr-CA"));
+    ASSERT_TRUE(cache->commit());
+    EXPECT_EQ(m_storage->get("settings", "locale"), "fr-CA");
+
+    // a cancelled transaction is cancelled in the cache
+    ASSERT_TRUE(cache->begin());
+    EXPECT_TRUE(cache->put("settings", "locale", "ja-JP"));
+    EXPECT_EQ(cache->get("settings", "locale"), "ja-JP");
+    ASSERT_TRUE(cache->cancel());
+    EXPECT_EQ(cache->get("settings", "locale"), "fr-CA");
+    EXPECT_FALSE(cache->commit());
+}
+
+TEST_F(CachingLocalStorageTest, batchesAndForEach) {
+    auto cache = CachingLocalStorage::create(m_storage, std::chrono::hours(1));
+    ASSERT_NE(cache, nullptr);
+
+    ASSERT_TRUE(cache->putBatch("table", {{"a", "1"}, {"b", "2"}, {"c", "3"}}));
+    auto batch = cache->getBatch("table", {"c", "missing", "a"});
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch[0], CachingLocalStorage::KeyValuePair("c", "3"));
+    EXPECT_EQ(batch[1], CachingLocalStorage::KeyValuePair("a", "1"));
+
+    // the callback can use the cache
+    size_t count = 0;
+    EXPECT_TRUE(cache->forEach("table", [&](const std::string& key, const std::string& value) {
+        count++;
+        return cache->get("table", key) == value;
+    }));
+    EXPECT_EQ(count, 3u);
+
+    ASSERT_TRUE(cache->flush());
+    EXPECT_EQ(m_storage->keys("table").size(), 3u);
+}
+
+TEST_F(CachingLocalStorageTest, dropsTheTablesUnderMemoryPressure) {
+    ASSERT_TRUE(m_storage->put("settings", "locale", "en-US"));
+    auto cache = CachingLocalStorage::create(m_storage, std::chrono::hours(1));
+    ASSERT_NE(cache, nullptr);
+    EXPECT_EQ(cache->get("settings", "locale"), "en-US");
+    EXPECT_TRUE(cache->put("auth", "state", "REFRESHED"));
+
+    // a table without changes is dropped, and read again from the storage, the changes are kept
+    ASSERT_TRUE(m_storage->put("settings", "locale", "fr-CA"));
+    MemoryPressure::report(MemoryPressureLevel::MODERATE);
+    EXPECT_EQ(cache->get("settings", "locale"), "fr-CA");
+    EXPECT_EQ(cache->get("auth", "state"), "REFRESHED");
+    EXPECT_FALSE(m_storage->containsTable("auth"));
+
+    // the changes are written right away when the memory is low
+    MemoryPressure::report(MemoryPressureLevel::LOW);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!m_storage->containsTable("auth") && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(m_storage->get("auth", "state"), "REFRESHED");
+
+    MemoryPressure::report(MemoryPressureLevel::NORMAL);
+    ASSERT_TRUE(m_storage->put("settings", "locale", "de-DE"));
+    EXPECT_EQ(cache->get("settings", "locale"), "de-DE");
+    ASSERT_TRUE(m_storage->put("settings", "locale", "ja-JP"));
+    EXPECT_EQ(cache->get("settings", "locale"), "de-DE");
+}
+
+TEST_F(CachingLocalStorageTest, keepsTheTablesBeingWrittenUnderMemoryPressure) {
+    auto storage = std::make_shared<BlockingStorage>();
+    ASSERT_TRUE(storage->put("settings", "locale", "en-US"));
+    auto cache = CachingLocalStorage::create(storage, std::chrono::hours(1));
+    ASSERT_NE(cache, nullptr);
+    EXPECT_TRUE(cache->put("settings", "locale", "fr-CA"));
+
+    // the memory is low while the change is written, before it is committed
+    storage->blockPuts();
+    auto flushed = std::async(std::launch::async, [&cache]() { return cache->flush(); });
+    ASSERT_TRUE(storage->waitForBlockedPut());
+    MemoryPressure::report(MemoryPressureLevel::LOW);
+    EXPECT_EQ(cache->get("settings", "locale"), "fr-CA");
+
+    storage->releasePuts();
+    EXPECT_TRUE(flushed.get());
+    EXPECT_EQ(cache->get("settings", "locale"), "fr-CA");
+    EXPECT_EQ(storage->get("settings", "locale"), "fr-CA");
+
+    MemoryPressure::report(MemoryPressureLevel::NORMAL);
+}
+
+TEST_F(CachingLocalStorageTest, keepsTheChangesOfAFailedWriteUnderMemoryPressure) {
+    auto storage = std::make_shared<BlockingStorage>();
+    ASSERT_TRUE(storage->put("settings", "locale", "en-US"));
+    ASSERT_TRUE(storage->put("settings", "timezone", "UTC"));
+    auto cache = CachingLocalStorage::create(storage, std::chrono::hours(1));
+    ASSERT_NE(cache, nullptr);
+    EXPECT_TRUE(cache->put("settings", "locale", "fr-CA"));
+
+    // the memory is low while the change is written, and the commit fails
+    storage->blockPuts();
+    storage->failCommits(true);
+    auto flushed = std::async(std::launch::async, [&cache]() { return cache->flush(); });
+    ASSERT_TRUE(storage->waitForBlockedPut());
+    MemoryPressure::report(MemoryPressureLevel::LOW);
+    storage->releasePuts();
+    EXPECT_FALSE(flushed.get());
+    EXPECT_EQ(cache->get("settings", "locale"), "fr-CA");
+    EXPECT_EQ(cache->get("settings", "timezone"), "UTC");
+    EXPECT_EQ(storage->get("settings", "locale"), "en-US");
+
+    // the change is written again with the next write
+    storage->failCommits(false);
+    EXPECT_TRUE(cache->flush());
+    EXPECT_EQ(storage->get("settings", "locale"), "fr-CA");
+    EXPECT_EQ(storage->get("settings", "timezone"), "UTC");
+
+    MemoryPressure::report(MemoryPressureLevel::NORMAL);
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/DeviceUsage/DeviceUsageEngineImpl.h>
+
+using namespace aace::engine::deviceUsage;
+
+using NetworkDataUsage = DeviceUsageEngineImpl::NetworkDataUsage;
+
+/**
+ * Test DeviceUsage platform interface.
+ */
+class TestDeviceUsagePlatformInterface : public aace::deviceUsage::DeviceUsage {};
+
+/**
+ * Unit test for @c DeviceUsageEngineImpl class.
+ */
+class DeviceUsageEngineImplTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_deviceUsagePlatformInterface = std::make_shared<TestDeviceUsagePlatformInterface>();
+    }
+
+    void TearDown() override {
+        m_deviceUsagePlatformInterface.reset();
+    }
+
+    std::shared_ptr<aace::deviceUsage::DeviceUsage> m_deviceUsagePlatformInterface;
+};
+
+TEST_F(DeviceUsageEngineImplTest, parseNetworkDataUsage) {
+    NetworkDataUsage dataUsage;
+    DeviceUsageEngineImpl::parseNetworkDataUsage(
+        R"({"startTimeStamp":1000,"endTimeStamp":2000,"networkInterfaceType":"WIFI","dataPlanType":"PAID",)"
+        R"("bytesUsage":{"rxBytes":300,"txBytes":40}})",
+        dataUsage);
+    EXPECT_EQ(1000, dataUsage.startTimeStamp);
+    EXPECT_EQ(2000, dataUsage.endTimeStamp);
+    EXPECT_EQ("WIFI", dataUsage.networkInterfaceType);
+    EXPECT_EQ("PAID", dataUsage.dataPlanType);
+    EXPECT_EQ(300, dataUsage.rxBytes);
+    EXPECT_EQ(40, dataUsage.txBytes);
+}
+
+TEST_F(DeviceUsageEngineImplTest, parseNetworkDataUsageSkipsOtherFields) {
+    NetworkDataUsage dataUsage;
+    DeviceUsageEngineImpl::parseNetworkDataUsage(
+        R"({"apps":[{"name":"a","bytesUsage":{"rxBytes":1}}],"extra":{"startTimeStamp":5,"rxBytes":7},)"
+        R"("startTimeStamp":1000,"endTimeStamp":2000.0,"networkInterfaceType":"MOBILE",)"
+        R"("bytesUsage":{"rxBytes":300,"txBytes":40,"other":{"txBytes":1}}})",
+        dataUsage);
+    EXPECT_EQ(1000, dataUsage.startTimeStamp);
+    EXPECT_EQ(2000, dataUsage.endTimeStamp);
+    EXPECT_EQ("MOBILE", dataUsage.networkInterfaceType);
+    EXPECT_TRUE(dataUsage.dataPlanType.empty());
+    EXPECT_EQ(300, dataUsage.rxBytes);
+    EXPECT_EQ(40, dataUsage.txBytes);
+}
+
+TEST_F(DeviceUsageEngineImplTest, parseInvalidNetworkDataUsage) {
+    std::vector<std::string> invalidUsages = {
+        R"({"startTimeStamp":1000,"endTimeStamp":2000,"networkInterfaceType":"WIFI")",
+        R"({})",
+        R"([{"startTimeStamp":1000},1])",
+        R"({"startTimeStamp":"1000","endTimeStamp":2000,"networkInterfaceType":"WIFI",)"
+        R"("bytesUsage":{"rxBytes":300,"txBytes":40}})",
+        R"({"startTimeStamp":1000,"networkInterfaceType":"WIFI","bytesUsage":{"rxBytes":300,"txBytes":40}})",
+        R"({"startTimeStamp":1000,"endTimeStamp":2000,"networkInterfaceType":"WIFI"})",
+        R"({"startTimeStamp":1000,"endTimeStamp":2000,"networkInterfaceType":"WIFI","bytesUsage":{}})",
+        R"({"startTimeStamp":1000,"endTimeStamp":2000,"networkInterfaceType":"WIFI","bytesUsage":{"rxBytes":300}})",
+        R"({"startTimeStamp":1000,"endTimeStamp":2000,"networkInterfaceType":1,)"
+        R"("bytesUsage":{"rxBytes":300,"txBytes":40}})",
+    };
+    for (const auto& usage : invalidUsages) {
+        NetworkDataUsage dataUsage;
+        EXPECT_ANY_THROW(DeviceUsageEngineImpl::parseNetworkDataUsage(usage, dataUsage)) << usage;
+    }
+}
+
+TEST_F(DeviceUsageEngineImplTest, createWithNullPlatformInterface) {
+    EXPECT_EQ(nullptr, DeviceUsageEngineImpl::create(nullptr));
+}
+
+TEST_F(DeviceUsageEngineImplTest, createWithNegativeAggregationPeriod) {
+    EXPECT_EQ(
+        nullptr, DeviceUsageEngineImpl::create(m_deviceUsagePlatformInterface, std::chrono::milliseconds(-1)));
+}
+
+TEST_F(DeviceUsageEngineImplTest, reportNetworkDataUsageWithAggregation) {
+    auto deviceUsageEngineImpl =
+        DeviceUsageEngineImpl::create(m_deviceUsagePlatformInterface, std::chrono::milliseconds(60000));
+    ASSERT_NE(nullptr, deviceUsageEngineImpl);
+    m_deviceUsagePlatformInterface->reportNetworkDataUsage(
+        R"({"startTimeStamp":1000,"endTimeStamp":2000,"networkInterfaceType":"WIFI",)"
+        R"("bytesUsage":{"rxBytes":300,"txBytes":40}})");
+    m_deviceUsagePlatformInterface->reportNetworkDataUsage(
+        R"({"startTimeStamp":2000,"endTimeStamp":3000,"networkInterfaceType":"WIFI",)"
+        R"("bytesUsage":{"rxBytes":100,"txBytes":10}})");
+    m_deviceUsagePlatformInterface->reportNetworkDataUsage("{invalid");
+    deviceUsageEngineImpl->flush();
+    deviceUsageEngineImpl->doShutdown();
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/MessageBroker/DispatchLane.h>
+
+using aace::engine::messageBroker::DispatchLane;
+using Priority = DispatchLane::Priority;
+using OverflowPolicy = DispatchLane::OverflowPolicy;
+
+/// Test harness for @c DispatchLane class
+class DispatchLaneTest : public ::testing::Test {
+protected:
+    /// Creates a lane with priority classes, and blocks it until @c release() is called.
+    std::shared_ptr<DispatchLane> createBlockedLane(size_t starvationLimit, size_t queueSize = 0) {
+        auto config = std::make_shared<DispatchLane::Config>();
+        config->priorities["Voice"] = Priority::HIGH;
+        config->priorities["Bulk"] = Priority::LOW;
+        config->starvationLimit = starvationLimit;
+        config->overflowPolicies["State"] = OverflowPolicy::COALESCE;
+        config->overflowPolicies["*"] = OverflowPolicy::DROP_OLDEST;
+        auto lane = std::make_shared<DispatchLane>("DispatchLaneTest", config, queueSize);
+
+        // wait for the lane to run the blocking task, so it doesn't compete with the tasks posted after
+        std::promise<void> started;
+        auto released = m_release.get_future().share();
+        lane->post("Blocker", "", [&started, released]() {
+            started.set_value();
+            released.wait();
+        });
+        started.get_future().wait();
+        return lane;
+    }
+
+    void release() {
+        m_release.set_value();
+    }
+
+    /// Posts a task recording its name when it runs.
+    bool post(DispatchLane& lane, const std::string& topic, const std::string& name, const std::string& key = "") {
+        return lane.post(topic, key.empty() ? topic : key, [this, name]() { record(name); });
+    }
+
+    void record(const std::string& name) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_order.push_back(name);
+    }
+
+    std::vector<std::string> getOrder() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_order;
+    }
+
+private:
+    std::promise<void> m_release;
+    std::mutex m_mutex;
+    std::vector<std::string> m_order;
+};
+
+TEST_F(DispatchLaneTest, dispatchesHigherClassesFirst) {
+    auto lane = createBlockedLane(DispatchLane::DEFAULT_STARVATION_LIMIT);
+    post(*lane, "Bulk", "bulk-1");
+    post(*lane, "Other", "normal-1");
+    post(*lane, "Voice", "voice-1");
+    post(*lane, "Bulk", "bulk-2");
+    post(*lane, "Voice", "voice-2");
+
+    release();
+    lane->waitForSubmittedTasks();
+    std::vector<std::string> expected = {"voice-1", "voice-2", "normal-1", "bulk-1", "bulk-2"};
+    EXPECT_EQ(getOrder(), expected);
+    lane->shutdown();
+}
+
+TEST_F(DispatchLaneTest, dispatchesStarvedClass) {
+    auto lane = createBlockedLane(2);
+    post(*lane, "Bulk", "bulk-1");
+    post(*lane, "Bulk", "bulk-2");
+    for (int i = 1; i <= 5; i++) {
+        post(*lane, "Voice", "voice-" + std::to_string(i));
+    }
+
+    release();
+    lane->waitForSubmittedTasks();
+    std::vector<std::string> expected = {
+        "voice-1", "voice-2", "bulk-1", "voice-3", "voice-4", "bulk-2", "voice-5"};
+    EXPECT_EQ(getOrder(), expected);
+    lane->shutdown();
+}
+
+TEST_F(DispatchLaneTest, dispatchesInOrderWithoutPriorities) {
+    DispatchLane lane("DispatchLaneTest");
+    EXPECT_EQ(lane.getPriority("Voice"), Priority::NORMAL);
+    post(lane, "Bulk", "bulk-1");
+    post(lane, "Voice", "voice-1");
+    lane.waitForSubmittedTasks();
+    std::vector<std::string> expected = {"bulk-1", "voice-1"};
+    EXPECT_EQ(getOrder(), expected);
+    lane.shutdown();
+}
+
+TEST_F(DispatchLaneTest, shutdownBreaksSubmittedTasks) {
+    auto lane = createBlockedLane(DispatchLane::DEFAULT_STARVATION_LIMIT);
+    auto future = lane->submit("Voice", []() { return 1; });
+    ASSERT_TRUE(future.valid());
+
+    std::thread releaser([this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        release();
+    });
+    lane->shutdown();
+    releaser.join();
+    EXPECT_THROW(future.get(), std::future_error);
+    EXPECT_FALSE(lane->submit("Voice", []() { return 1; }).valid());
+    EXPECT_FALSE(lane->post("Bulk", "Bulk", []() {}));
+}
+
+TEST_F(DispatchLaneTest, rejectsTaskWhenQueueIsFull) {
+    auto lane = createBlockedLane(DispatchLane::DEFAULT_STARVATION_LIMIT, 2);
+    EXPECT_TRUE(lane->post("Other", "", [this]() { record("request-1"); }));
+    EXPECT_TRUE(lane->post("Other", "", [this]() { record("request-2"); }));
+    // the waiting requests are never dropped for a newer task
+    EXPECT_FALSE(post(*lane, "Other", "other-1"));
+    EXPECT_FALSE(lane->submit("Other", []() { return 1; }).valid());
+    // a completion is queued even if the queue is full
+    EXPECT_TRUE(lane->postCompletion("Voice", [this]() { record("completion"); }));
+
+    auto metrics = lane->getMetrics();
+    EXPECT_EQ(metrics.queueDepth, 3u);
+    EXPECT_EQ(metrics.rejected, 2u);
+
+    release();
+    lane->waitForSubmittedTasks();
+    std::vector<std::string> expected = {"completion", "request-1", "request-2"};
+    EXPECT_EQ(getOrder(), expected);
+    lane->shutdown();
+}
+
+TEST_F(DispatchLaneTest, dropsOldestTaskOfTopic) {
+    auto lane = createBlockedLane(DispatchLane::DEFAULT_STARVATION_LIMIT, 3);
+    EXPECT_TRUE(post(*lane, "Other", "other-1"));
+    EXPECT_TRUE(post(*lane, "Bulk", "bulk-1"));
+    EXPECT_TRUE(post(*lane, "Other", "other-2"));
+    EXPECT_TRUE(post(*lane, "Other", "other-3"));
+    EXPECT_TRUE(post(*lane, "Bulk", "bulk-2"));
+    EXPECT_EQ(lane->getMetrics().dropped, 2u);
+
+    release();
+    lane->waitForSubmittedTasks();
+    std::vector<std::string> expected = {"other-2", "other-3", "bulk-2"};
+    EXPECT_EQ(getOrder(), expected);
+    lane->shutdown();
+}
+
+TEST_F(DispatchLaneTest, coalescesTaskWithSameKey) {
+    auto lane = createBlockedLane(DispatchLane::DEFAULT_STARVATION_LIMIT, 2);
+    EXPECT_TRUE(post(*lane, "State", "location-1", "State:Location"));
+    EXPECT_TRUE(post(*lane, "State", "media-1", "State:Media"));
+    EXPECT_TRUE(post(*lane, "State", "location-2", "State:Location"));
+    EXPECT_FALSE(post(*lane, "State", "speed-1", "State:Speed"));
+
+    auto metrics = lane->getMetrics();
+    EXPECT_EQ(metrics.coalesced, 1u);
+    EXPECT_EQ(metrics.rejected, 1u);
+    EXPECT_EQ(metrics.maxQueueDepth, 2u);
+
+    release();
+    lane->waitForSubmittedTasks();
+    std::vector<std::string> expected = {"media-1", "location-2"};
+    EXPECT_EQ(getOrder(), expected);
+    lane->shutdown();
+}
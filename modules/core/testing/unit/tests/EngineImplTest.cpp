@@ -115,3 +115,77 @@ TEST_F(EngineImplTest, shutdown) {
     // test shutdown valid
     ASSERT_TRUE(m_engine->shutdown()) << "Shutdown engine failed!";
 }
+
+TEST_F(EngineImplTest, suspendResume) {
+    // test suspend before start
+    ASSERT_FALSE(m_engine->suspend()) << "Suspend engine did not fail!";
+    ASSERT_TRUE(m_engine->configure(CoreTestHelper::createDefaultConfiguration())) << "Configure engine failed!";
+    ASSERT_FALSE(m_engine->suspend()) << "Suspend engine did not fail!";
+    ASSERT_TRUE(m_engine->start()) << "Start engine failed!";
+
+    // test resume when not suspended - should return true since the engine is not suspended
+    ASSERT_TRUE(m_engine->resume()) << "Resume engine failed!";
+
+    // test valid suspend and resume, twice to make sure the engine can be suspended again
+    for (int i = 0; i < 2; i++) {
+        ASSERT_TRUE(m_engine->suspend()) << "Suspend engine failed!";
+        ASSERT_TRUE(m_engine->suspend()) << "Suspend engine twice failed!";
+        ASSERT_TRUE(m_engine->resume()) << "Resume engine failed!";
+    }
+
+    // test stop while suspended, the engine can't be resumed once stopped
+    ASSERT_TRUE(m_engine->suspend()) << "Suspend engine failed!";
+    ASSERT_TRUE(m_engine->stop()) << "Stop engine failed!";
+    ASSERT_FALSE(m_engine->resume()) << "Resume engine did not fail!";
+    ASSERT_TRUE(m_engine->start()) << "Start engine failed!";
+}
+
+TEST_F(EngineImplTest, multipleEngines) {
+    // a second engine of the process shares the logger, but not the storage of the first engine
+    auto engine = aace::engine::core::EngineImpl::create();
+    ASSERT_NE(engine, nullptr) << "Create engine failed!";
+    ASSERT_TRUE(m_engine->configure(
+        {CoreTestHelper::createDefaultConfiguration(),
+         aace::core::config::StreamConfiguration::create(
+             std::make_shared<std::stringstream>(R"({"aace.logger":{"async":{"enabled":true}}})"))}))
+        << "Configure engine failed!";
+    ASSERT_TRUE(engine->configure(
+        {aace::core::config::StreamConfiguration::create(std::make_shared<std::stringstream>(
+             R"({"aace.storage":{"localStoragePath":"storage-rear.db","storageType":"sqlite"}})")),
+         aace::core::config::StreamConfiguration::create(
+             std::make_shared<std::stringstream>(R"({"aace.logger":{"async":{"enabled":true}}})"))}))
+        << "Configure second engine failed!";
+    ASSERT_TRUE(m_engine->start()) << "Start engine failed!";
+    ASSERT_TRUE(engine->start()) << "Start second engine failed!";
+
+    // the engines stop and shut down independently
+    ASSERT_TRUE(m_engine->stop()) << "Stop engine failed!";
+    ASSERT_TRUE(engine->suspend()) << "Suspend second engine failed!";
+    ASSERT_TRUE(m_engine->shutdown()) << "Shutdown engine failed!";
+    ASSERT_TRUE(engine->resume()) << "Resume second engine failed!";
+    ASSERT_TRUE(engine->shutdown()) << "Shutdown second engine failed!";
+}
+
+TEST_F(EngineImplTest, startPolicies) {
+    // test invalid start policies
+    ASSERT_FALSE(m_engine->configure(
+        {CoreTestHelper::createDefaultConfiguration(),
+         aace::core::config::StreamConfiguration::create(std::make_shared<std::stringstream>(
+             R"({"aace.threading":{"serviceStartPolicies":{"aace.deviceUsage":"later"}}})"))}))
+        << "Configure engine did not fail!";
+    ASSERT_FALSE(m_engine->configure(
+        {CoreTestHelper::createDefaultConfiguration(),
+         aace::core::config::StreamConfiguration::create(std::make_shared<std::stringstream>(
+             R"({"aace.threading":{"serviceStartPolicies":{"aace.unknown":"deferred"}}})"))}))
+        << "Configure engine did not fail!";
+
+    // test valid start policies, the services are started once the engine is running
+    ASSERT_TRUE(m_engine->configure(
+        {CoreTestHelper::createDefaultConfiguration(),
+         aace::core::config::StreamConfiguration::create(std::make_shared<std::stringstream>(
+             R"({"aace.threading":{"serviceStartPolicies":)"
+             R"({"aace.deviceUsage":"deferred","aace.network":"onFirstUse"}}})"))}))
+        << "Configure engine failed!";
+    ASSERT_TRUE(m_engine->start()) << "Start engine failed!";
+    ASSERT_TRUE(m_engine->stop()) << "Stop engine failed!";
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Logger/EngineLogger.h>
+
+using aace::engine::logger::EngineLogger;
+using aace::engine::logger::LogEntry;
+using aace::engine::logger::LogEventObserver;
+using Level = EngineLogger::Level;
+
+class CountingObserver : public LogEventObserver {
+public:
+    bool onLogEvent(Level level, std::chrono::system_clock::time_point time, const char* source, const char* text)
+        override {
+        if (std::string(text).find("aace.test.EngineLogger") == 0) {
+            // the observers are called one entry at a time
+            EXPECT_FALSE(m_inside.exchange(true));
+            m_count++;
+            m_inside = false;
+        }
+        return true;
+    }
+
+    std::atomic<bool> m_inside{false};
+    std::atomic<int> m_count{0};
+};
+
+TEST(EngineLoggerTest, concurrentLoggingWhileObserversChange) {
+    auto logger = EngineLogger::getInstance();
+    auto observer = std::make_shared<CountingObserver>();
+    logger->addObserver(observer);
+
+    const int threadCount = 4;
+    const int entryCount = 1000;
+    std::atomic<bool> done{false};
+
+    // another observer is added and removed while the threads log
+    std::thread toggler([logger, &done]() {
+        auto other = std::make_shared<CountingObserver>();
+        while (!done) {
+            logger->addObserver(other);
+            logger->removeObserver(other);
+        }
+    });
+
+    std::vector<std::thread> threads;
+    for (int j = 0; j < threadCount; j++) {
+        threads.emplace_back([logger, entryCount]() {
+            for (int k = 0; k < entryCount; k++) {
+                logger->log(Level::VERBOSE, LogEntry("aace.test.EngineLogger", "entry").d("index", k));
+            }
+        });
+    }
+    for (auto& next : threads) {
+        next.join();
+    }
+    done = true;
+    toggler.join();
+
+    logger->removeObserver(observer);
+    EXPECT_EQ(observer->m_count, threadCount * entryCount);
+
+    // removed observers don't receive entries
+    logger->log(Level::VERBOSE, LogEntry("aace.test.EngineLogger", "removed"));
+    EXPECT_EQ(observer->m_count, threadCount * entryCount);
+}
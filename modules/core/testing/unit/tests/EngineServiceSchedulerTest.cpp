@@ -0,0 +1,168 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Core/EngineServiceScheduler.h>
+
+using aace::engine::core::EngineServiceScheduler;
+
+/// A core service, two services depending on it, and a service depending on both
+static std::vector<EngineServiceScheduler::Service> createServices() {
+    return {{"core", {}}, {"left", {0}}, {"right", {0}}, {"top", {1, 2}}};
+}
+
+TEST(EngineServiceSchedulerTest, rejectsDependencyOnLaterService) {
+    EXPECT_EQ(EngineServiceScheduler::create({{"first", {1}}, {"second", {}}}), nullptr);
+    EXPECT_EQ(EngineServiceScheduler::create({{"self", {0}}}), nullptr);
+    EXPECT_NE(EngineServiceScheduler::create(createServices()), nullptr);
+}
+
+TEST(EngineServiceSchedulerTest, serialRunsServicesInOrder) {
+    auto scheduler = EngineServiceScheduler::create(createServices());
+    ASSERT_NE(scheduler, nullptr);
+    EXPECT_FALSE(scheduler->isParallel());
+
+    std::vector<size_t> order;
+    std::thread::id thread;
+    EXPECT_TRUE(scheduler->run("start", [&](size_t index) {
+        order.push_back(index);
+        thread = std::this_thread::get_id();
+        return true;
+    }));
+    EXPECT_EQ(order, (std::vector<size_t>{0, 1, 2, 3}));
+    EXPECT_EQ(thread, std::this_thread::get_id());
+
+    auto timings = scheduler->getTimings();
+    ASSERT_EQ(timings.size(), 4u);
+    EXPECT_EQ(timings[3].type, "top");
+    EXPECT_TRUE(timings[3].success);
+}
+
+TEST(EngineServiceSchedulerTest, parallelRespectsDependencies) {
+    auto scheduler = EngineServiceScheduler::create(createServices(), 4);
+    ASSERT_NE(scheduler, nullptr);
+    EXPECT_TRUE(scheduler->isParallel());
+
+    std::mutex mutex;
+    std::vector<size_t> order;
+    std::atomic<int> concurrent{0};
+    std::atomic<int> maxConcurrent{0};
+    EXPECT_TRUE(scheduler->run("setup", [&](size_t index) {
+        auto current = ++concurrent;
+        int previous = maxConcurrent;
+        while (current > previous && !maxConcurrent.compare_exchange_weak(previous, current)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(index);
+        }
+        concurrent--;
+        return true;
+    }));
+
+    // left and right only depend on core, so they run together
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order.front(), 0u);
+    EXPECT_EQ(order.back(), 3u);
+    EXPECT_EQ(maxConcurrent, 2);
+    EXPECT_EQ(scheduler->getTimings().size(), 4u);
+}
+
+TEST(EngineServiceSchedulerTest, failureStopsDependents) {
+    for (size_t threadCount : {0, 4}) {
+        auto scheduler = EngineServiceScheduler::create(createServices(), threadCount);
+        ASSERT_NE(scheduler, nullptr);
+
+        std::atomic<bool> topRan{false};
+        EXPECT_FALSE(scheduler->run("configure", [&](size_t index) {
+            if (index == 3) {
+                topRan = true;
+            }
+            return index != 1;
+        }));
+        EXPECT_FALSE(topRan);
+
+        bool leftFailed = false;
+        for (auto& timing : scheduler->getTimings()) {
+            if (timing.type == "left") {
+                leftFailed = !timing.success;
+            }
+        }
+        EXPECT_TRUE(leftFailed);
+    }
+}
+
+TEST(EngineServiceSchedulerTest, exceptionFailsService) {
+    auto scheduler = EngineServiceScheduler::create(createServices(), 2);
+    ASSERT_NE(scheduler, nullptr);
+    EXPECT_FALSE(scheduler->run("start", [](size_t index) -> bool { throw std::runtime_error("failed"); }));
+    ASSERT_EQ(scheduler->getTimings().size(), 1u);
+    EXPECT_FALSE(scheduler->getTimings()[0].success);
+}
+
+TEST(EngineServiceSchedulerTest, serialSkipsServicesAfterDeadline) {
+    auto scheduler = EngineServiceScheduler::create(createServices());
+    ASSERT_NE(scheduler, nullptr);
+
+    std::vector<size_t> order;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(30);
+    EXPECT_FALSE(scheduler->run(
+        "shutdown",
+        [&](size_t index) {
+            order.push_back(index);
+            std::this_thread::sleep_for(std::chrono::milliseconds(60));
+            return true;
+        },
+        deadline));
+    EXPECT_EQ(order, (std::vector<size_t>{0}));
+    EXPECT_EQ(scheduler->getTimedOut(), (std::vector<std::string>{"left", "right", "top"}));
+}
+
+TEST(EngineServiceSchedulerTest, parallelReturnsAtDeadline) {
+    auto scheduler = EngineServiceScheduler::create(createServices(), 4);
+    ASSERT_NE(scheduler, nullptr);
+
+    // the handler is still running after the run returns, so it doesn't refer to the state of the test
+    auto topStarted = std::make_shared<std::atomic<bool>>(false);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(scheduler->run(
+        "shutdown",
+        [topStarted](size_t index) {
+            if (index == 1) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            } else if (index == 3) {
+                *topStarted = true;
+            }
+            return true;
+        },
+        start + std::chrono::milliseconds(50)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(250));
+    EXPECT_EQ(scheduler->getTimedOut(), (std::vector<std::string>{"left", "top"}));
+
+    // the service still running at the deadline completes, and the services depending on it are not started
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    EXPECT_FALSE(*topStarted);
+
+    // the event is not dispatched once the deadline has passed
+    EXPECT_FALSE(scheduler->run("shutdown", [](size_t) { return true; }, start));
+    EXPECT_EQ(scheduler->getTimedOut().size(), 4u);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#include <AACE/Engine/Utils/Trace/EngineTrace.h>
+
+using aace::engine::utils::trace::EngineTrace;
+
+class EngineTraceTest : public ::testing::Test {
+public:
+    void TearDown() override {
+        EngineTrace::stop();
+    }
+
+    /// Returns the events of the trace, without the metadata events
+    static std::vector<nlohmann::json> getEvents(const std::string& trace) {
+        std::vector<nlohmann::json> events;
+        auto root = nlohmann::json::parse(trace);
+        for (auto& event : root["traceEvents"]) {
+            if (event["ph"] != "M") {
+                events.push_back(event);
+            }
+        }
+        return events;
+    }
+};
+
+TEST_F(EngineTraceTest, recordsEvents) {
+    ASSERT_TRUE(EngineTrace::start());
+    EXPECT_TRUE(EngineTrace::isRecording());
+    {
+        EngineTrace::Scope scope("messageBroker", std::string("AudioOutput"));
+        EngineTrace::counter("platform", "queue", 3);
+    }
+    std::thread([]() {
+        EngineTrace::setCurrentThreadName("Test.thread");
+        EngineTrace::begin("directive", "handleDirective");
+        EngineTrace::end("directive");
+    }).join();
+
+    auto root = nlohmann::json::parse(EngineTrace::toJson());
+    auto events = getEvents(EngineTrace::toJson());
+    ASSERT_EQ(events.size(), 5u);
+    EXPECT_EQ(events[0]["ph"], "B");
+    EXPECT_EQ(events[0]["name"], "AudioOutput");
+    EXPECT_EQ(events[0]["cat"], "messageBroker");
+    EXPECT_EQ(events[1]["ph"], "C");
+    EXPECT_EQ(events[1]["args"]["queue"], 3);
+    EXPECT_EQ(events[2]["ph"], "E");
+    EXPECT_LE(events[0]["ts"].get<double>(), events[2]["ts"].get<double>());
+    EXPECT_EQ(events[3]["name"], "handleDirective");
+    EXPECT_EQ(events[3]["tid"], events[4]["tid"]);
+    EXPECT_NE(events[0]["tid"], events[3]["tid"]);
+
+    // the exited thread keeps its name
+    bool named = false;
+    for (auto& event : root["traceEvents"]) {
+        named |= event["name"] == "thread_name" && event["args"]["name"] == "Test.thread";
+    }
+    EXPECT_TRUE(named);
+}
+
+TEST_F(EngineTraceTest, dropsEventsOfFullBuffer) {
+    ASSERT_TRUE(EngineTrace::start(2));
+    EngineTrace::begin("engine", "first");
+    EngineTrace::end("engine");
+    EngineTrace::begin("engine", "dropped");
+
+    auto root = nlohmann::json::parse(EngineTrace::toJson());
+    EXPECT_EQ(getEvents(root.dump()).size(), 2u);
+    EXPECT_EQ(root["otherData"]["droppedEvents"], 1);
+    EXPECT_FALSE(EngineTrace::start(0));
+}
+
+TEST_F(EngineTraceTest, truncatesLongNames) {
+    ASSERT_TRUE(EngineTrace::start());
+    EngineTrace::begin("engine", std::string(100, 'a'));
+
+    auto events = getEvents(EngineTrace::toJson());
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0]["name"], std::string(EngineTrace::MAX_NAME_LENGTH, 'a'));
+}
+
+TEST_F(EngineTraceTest, stopsRecording) {
+    ASSERT_TRUE(EngineTrace::start());
+    EngineTrace::begin("engine", "recorded");
+    EngineTrace::stop();
+    EXPECT_FALSE(EngineTrace::isRecording());
+    EngineTrace::end("engine");
+    EXPECT_EQ(getEvents(EngineTrace::toJson()).size(), 1u);
+
+    // a new trace clears the events of the previous one
+    ASSERT_TRUE(EngineTrace::start());
+    EXPECT_TRUE(getEvents(EngineTrace::toJson()).empty());
+}
+
+TEST_F(EngineTraceTest, exportsTrace) {
+    ASSERT_TRUE(EngineTrace::start());
+    { EngineTrace::Scope scope("engine", "shutdown"); }
+    EngineTrace::stop();
+
+    auto path = "EngineTraceTest.json";
+    ASSERT_TRUE(EngineTrace::exportTrace(path));
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::remove(path);
+
+    auto events = getEvents(contents.str());
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0]["name"], "shutdown");
+    EXPECT_FALSE(EngineTrace::exportTrace("/nonexistent/EngineTraceTest.json"));
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/ExecutorStats.h>
+#include <AACE/Engine/Utils/Threading/SerialExecutor.h>
+
+using aace::engine::utils::threading::Executor;
+using aace::engine::utils::threading::ExecutorStats;
+using aace::engine::utils::threading::SerialExecutor;
+
+TEST(ExecutorStatsTest, unnamedExecutorHasNoStats) {
+    Executor executor;
+    EXPECT_EQ(executor.getStats(), nullptr);
+}
+
+TEST(ExecutorStatsTest, recordsQueuedAndCompletedTasks) {
+    Executor executor("ExecutorStatsTest.executor");
+    auto stats = executor.getStats();
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->getName(), "ExecutorStatsTest.executor");
+
+    std::promise<void> blocked;
+    auto blockedFuture = blocked.get_future().share();
+    executor.submit([blockedFuture]() { blockedFuture.wait(); });
+    for (int j = 0; j < 3; j++) {
+        executor.post([]() {});
+    }
+
+    // the blocking task is running and the other tasks are queued behind it
+    while (!stats->getSnapshot().running) {
+        std::this_thread::yield();
+    }
+    auto snapshot = stats->getSnapshot();
+    EXPECT_EQ(snapshot.queueDepth, 3u);
+    EXPECT_GE(snapshot.maxQueueDepth, 3u);
+    EXPECT_FALSE(snapshot.runningCallSite.empty());
+
+    blocked.set_value();
+    executor.waitForSubmittedTasks();
+
+    // the flush task is recorded as completed after it has released the waiting thread
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (stats->getSnapshot().completedTasks < 5u && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    snapshot = stats->getSnapshot();
+    EXPECT_EQ(snapshot.queueDepth, 0u);
+    EXPECT_EQ(snapshot.completedTasks, 5u);
+    EXPECT_EQ(snapshot.runTime.count, 5u);
+    EXPECT_GE(snapshot.waitTime.count, 4u);
+
+    stats->reset();
+    EXPECT_EQ(stats->getSnapshot().completedTasks, 0u);
+}
+
+TEST(ExecutorStatsTest, snapshotsOfNamedExecutors) {
+    auto executor = std::unique_ptr<SerialExecutor>(new SerialExecutor("ExecutorStatsTest.serial"));
+    executor->submit([]() {}).wait();
+    // the future is ready before the task is recorded as completed, the shutdown waits for the running task
+    executor->shutdown();
+
+    auto snapshots = ExecutorStats::getSnapshots();
+    auto found = std::find_if(snapshots.begin(), snapshots.end(), [](const ExecutorStats::Snapshot& snapshot) {
+        return snapshot.name == "ExecutorStatsTest.serial";
+    });
+    ASSERT_NE(found, snapshots.end());
+    EXPECT_EQ(found->completedTasks, 1u);
+
+    // the statistics are removed with the executor, once the pool worker returns from the executor's last run
+    executor.reset();
+    auto removed = [](const std::vector<ExecutorStats::Snapshot>& snapshots) {
+        return std::none_of(snapshots.begin(), snapshots.end(), [](const ExecutorStats::Snapshot& snapshot) {
+            return snapshot.name == "ExecutorStatsTest.serial";
+        });
+    };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!removed(ExecutorStats::getSnapshots()) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(removed(ExecutorStats::getSnapshots()));
+}
+
+TEST(ExecutorStatsTest, slowTaskThreshold) {
+    EXPECT_EQ(ExecutorStats::getSlowTaskThreshold().count(), 0);
+    ExecutorStats::setSlowTaskThreshold(std::chrono::milliseconds(20));
+    EXPECT_EQ(ExecutorStats::getSlowTaskThreshold().count(), 20);
+
+    // the watchdog logs the slow task while it runs
+    Executor executor("ExecutorStatsTest.slow");
+    auto stats = executor.getStats();
+    executor.submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(60)); }).wait();
+    // the task is recorded as completed before the thread is joined
+    executor.shutdown();
+    EXPECT_GE(stats->getSnapshot().runTime.maxUs, 60000u);
+
+    ExecutorStats::setSlowTaskThreshold(std::chrono::milliseconds::zero());
+    EXPECT_EQ(ExecutorStats::getSlowTaskThreshold().count(), 0);
+}
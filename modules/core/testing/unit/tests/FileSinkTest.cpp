@@ -0,0 +1,144 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <AACE/Engine/Logger/Sinks/FileSink.h>
+
+using aace::engine::logger::sink::FileSink;
+using aace::engine::logger::sink::Sink;
+using Level = Sink::Level;
+
+class FileSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char path[] = "/tmp/aace-file-sink-XXXXXX";
+        ASSERT_NE(mkdtemp(path), nullptr);
+        m_path = path;
+    }
+
+    void TearDown() override {
+        for (auto name : {"test.log", "test.log.1", "test.log.2", "test.log.3", "test.log.1.gz", "test.log.2.gz"}) {
+            unlink((m_path + "/" + name).c_str());
+        }
+        rmdir(m_path.c_str());
+    }
+
+    std::string read(const std::string& name) {
+        std::ifstream file(m_path + "/" + name);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    bool exists(const std::string& name) {
+        struct stat info;
+        return stat((m_path + "/" + name).c_str(), &info) == 0;
+    }
+
+    void log(const std::shared_ptr<Sink>& sink, const std::string& text) {
+        sink->log(Level::INFO, std::chrono::system_clock::now(), "AAC", "1", text.c_str());
+    }
+
+    std::string m_path;
+};
+
+TEST_F(FileSinkTest, writesEachEntryWithoutBuffer) {
+    std::shared_ptr<Sink> sink = FileSink::create("test", m_path, "test");
+    ASSERT_NE(sink, nullptr);
+
+    log(sink, "first entry");
+    EXPECT_NE(read("test.log").find("first entry"), std::string::npos);
+}
+
+TEST_F(FileSinkTest, buffersEntriesUntilFlush) {
+    std::shared_ptr<Sink> sink =
+        FileSink::create("test", m_path, "test", 1048576, 3, false, 4096, std::chrono::milliseconds(0));
+    ASSERT_NE(sink, nullptr);
+
+    log(sink, "buffered entry");
+    EXPECT_TRUE(read("test.log").empty());
+
+    sink->flush();
+    EXPECT_NE(read("test.log").find("buffered entry"), std::string::npos);
+}
+
+TEST_F(FileSinkTest, writesBufferWhenFull) {
+    std::shared_ptr<Sink> sink =
+        FileSink::create("test", m_path, "test", 1048576, 3, false, 256, std::chrono::milliseconds(0));
+    ASSERT_NE(sink, nullptr);
+
+    for (int j = 0; j < 10; j++) {
+        log(sink, "entry " + std::to_string(j) + std::string(32, '.'));
+    }
+    auto contents = read("test.log");
+    EXPECT_NE(contents.find("entry 0"), std::string::npos);
+    EXPECT_EQ(contents.find("entry 9"), std::string::npos);
+}
+
+TEST_F(FileSinkTest, writesBufferAfterFlushInterval) {
+    std::shared_ptr<Sink> sink =
+        FileSink::create("test", m_path, "test", 1048576, 3, false, 4096, std::chrono::milliseconds(10), true);
+    ASSERT_NE(sink, nullptr);
+
+    log(sink, "timed entry");
+    for (int j = 0; j < 200 && read("test.log").empty(); j++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_NE(read("test.log").find("timed entry"), std::string::npos);
+}
+
+TEST_F(FileSinkTest, rotatesLogFiles) {
+    std::shared_ptr<Sink> sink = FileSink::create("test", m_path, "test", 200, 2, false);
+    ASSERT_NE(sink, nullptr);
+
+    for (int j = 0; j < 4; j++) {
+        log(sink, "entry " + std::to_string(j) + std::string(128, '.'));
+    }
+
+    // destroying the sink waits for the background thread to finish the pending rotations
+    sink.reset();
+    EXPECT_NE(read("test.log").find("entry 3"), std::string::npos);
+    EXPECT_NE(read("test.log.1").find("entry 2"), std::string::npos);
+    EXPECT_NE(read("test.log.2").find("entry 1"), std::string::npos);
+    EXPECT_FALSE(exists("test.log.3"));
+}
+
+TEST_F(FileSinkTest, compressesRotatedLogFiles) {
+    if (!FileSink::isCompressionSupported()) {
+        return;
+    }
+
+    std::shared_ptr<Sink> sink =
+        FileSink::create("test", m_path, "test", 200, 2, false, 0, std::chrono::milliseconds(0), false, true);
+    ASSERT_NE(sink, nullptr);
+
+    for (int j = 0; j < 2; j++) {
+        log(sink, "entry " + std::to_string(j) + std::string(128, '.'));
+    }
+
+    sink.reset();
+    EXPECT_TRUE(exists("test.log.1.gz"));
+    EXPECT_FALSE(exists("test.log.1"));
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <AACE/Engine/Logger/LogEntry.h>
+#include <AACE/Engine/Logger/Sinks/FlightRecorderSink.h>
+
+using aace::engine::logger::LogEntry;
+using aace::engine::logger::sink::FlightRecorderSink;
+using aace::engine::logger::sink::Sink;
+using Level = Sink::Level;
+
+class FlightRecorderSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char path[] = "/tmp/aace-flight-recorder-sink-XXXXXX";
+        ASSERT_NE(mkdtemp(path), nullptr);
+        m_path = path;
+    }
+
+    void TearDown() override {
+        for (auto name : {"test.dump.blog", "test.dump.blog.1", "test.dump.blog.2", "test.crash.blog"}) {
+            unlink((m_path + "/" + name).c_str());
+        }
+        rmdir(m_path.c_str());
+    }
+
+    bool exists(const std::string& name) {
+        struct stat info;
+        return stat((m_path + "/" + name).c_str(), &info) == 0;
+    }
+
+    std::string read(const std::string& name) {
+        std::ifstream file(m_path + "/" + name, std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    uint64_t recordsSize(const std::string& contents) {
+        uint64_t size = 0;
+        for (int j = 7; j >= 0; j--) {
+            size = (size << 8) | static_cast<unsigned char>(contents[16 + j]);
+        }
+        return size;
+    }
+
+    void log(const std::shared_ptr<Sink>& sink, Level level, const std::string& message) {
+        sink->log(level, std::chrono::system_clock::now(), "AAC", "1", LogEntry("aace.test", message).c_str());
+    }
+
+    std::string m_path;
+};
+
+TEST_F(FlightRecorderSinkTest, rejectsInvalidArguments) {
+    EXPECT_EQ(FlightRecorderSink::create("test", m_path + "/missing", "test"), nullptr);
+    EXPECT_EQ(FlightRecorderSink::create("test", m_path, "test", 0, 3, false), nullptr);
+    EXPECT_EQ(FlightRecorderSink::create("test", m_path, "test", 4096, 0, false), nullptr);
+}
+
+TEST_F(FlightRecorderSinkTest, keepsEntriesInMemoryUntilError) {
+    auto sink = FlightRecorderSink::create("test", m_path, "test", 4096, 3, false);
+    ASSERT_NE(sink, nullptr);
+
+    log(sink, Level::VERBOSE, "verbose");
+    log(sink, Level::INFO, "info");
+    EXPECT_FALSE(exists("test.dump.blog"));
+    EXPECT_GT(sink->getRecordedSize(), 0u);
+
+    // the error dumps the entries logged before it, and itself
+    log(sink, Level::ERROR, "error");
+    EXPECT_EQ(sink->getDumpCount(), 1u);
+    EXPECT_EQ(sink->getRecordedSize(), 0u);
+
+    auto contents = read("test.dump.blog");
+    ASSERT_GE(contents.size(), 32u);
+    EXPECT_EQ(std::memcmp(contents.data(), "AACBLOG\0", 8), 0);
+    EXPECT_EQ(recordsSize(contents), contents.size() - 32);
+    auto verbose = contents.find("verbose");
+    auto info = contents.find("info");
+    auto error = contents.find("error");
+    ASSERT_NE(verbose, std::string::npos);
+    ASSERT_NE(info, std::string::npos);
+    ASSERT_NE(error, std::string::npos);
+    EXPECT_LT(verbose, info);
+    EXPECT_LT(info, error);
+}
+
+TEST_F(FlightRecorderSinkTest, overwritesOldestEntries) {
+    auto sink = FlightRecorderSink::create("test", m_path, "test", 512, 3, false);
+    ASSERT_NE(sink, nullptr);
+
+    for (int j = 0; j < 100; j++) {
+        log(sink, Level::VERBOSE, "message" + std::to_string(j));
+        EXPECT_LE(sink->getRecordedSize(), 512u);
+    }
+    ASSERT_TRUE(sink->dump());
+
+    // the ring wrapped around, and only the latest entries are dumped
+    auto contents = read("test.dump.blog");
+    EXPECT_EQ(recordsSize(contents), contents.size() - 32);
+    EXPECT_EQ(contents.find("message0"), std::string::npos);
+    EXPECT_NE(contents.find("message99"), std::string::npos);
+}
+
+TEST_F(FlightRecorderSinkTest, shrinksUnderMemoryPressure) {
+    using aace::engine::utils::memory::MemoryPressureLevel;
+    auto sink = FlightRecorderSink::create("test", m_path, "test", 1048576, 3, false);
+    ASSERT_NE(sink, nullptr);
+    for (int j = 0; j < 20000; j++) {
+        log(sink, Level::VERBOSE, "message" + std::to_string(j));
+    }
+    EXPECT_GT(sink->getRecordedSize(), 262144u);
+
+    // the oldest entries are dropped to fit the smaller ring
+    sink->onMemoryPressure(MemoryPressureLevel::LOW);
+    EXPECT_EQ(sink->getCapacity(), 262144u);
+    EXPECT_LE(sink->getRecordedSize(), 262144u);
+    sink->onMemoryPressure(MemoryPressureLevel::CRITICAL);
+    EXPECT_EQ(sink->getCapacity(), 65536u);
+    EXPECT_LE(sink->getRecordedSize(), 65536u);
+    EXPECT_GT(sink->getRecordedSize(), 0u);
+
+    sink->onMemoryPressure(MemoryPressureLevel::NORMAL);
+    EXPECT_EQ(sink->getCapacity(), 1048576u);
+    log(sink, Level::VERBOSE, "latest");
+    ASSERT_TRUE(sink->dump());
+    auto contents = read("test.dump.blog");
+    EXPECT_EQ(recordsSize(contents), contents.size() - 32);
+    EXPECT_EQ(contents.find("message0\n"), std::string::npos);
+    EXPECT_NE(contents.find("message19999"), std::string::npos);
+    EXPECT_NE(contents.find("latest"), std::string::npos);
+}
+
+TEST_F(FlightRecorderSinkTest, dumpsOnlyWhenEntriesAreRecorded) {
+    auto sink = FlightRecorderSink::create("test", m_path, "test", 4096, 3, false);
+    ASSERT_NE(sink, nullptr);
+    EXPECT_FALSE(sink->dump());
+    EXPECT_FALSE(exists("test.dump.blog"));
+
+    log(sink, Level::VERBOSE, "verbose");
+    EXPECT_TRUE(sink->dump());
+    EXPECT_FALSE(sink->dump());
+    EXPECT_EQ(sink->getDumpCount(), 1u);
+}
+
+TEST_F(FlightRecorderSinkTest, rotatesDumps) {
+    auto sink = FlightRecorderSink::create("test", m_path, "test", 4096, 3, false);
+    ASSERT_NE(sink, nullptr);
+
+    for (int j = 0; j < 4; j++) {
+        log(sink, Level::VERBOSE, "dump" + std::to_string(j));
+        ASSERT_TRUE(sink->dump());
+    }
+
+    // the oldest dump is removed after maxDumps files
+    EXPECT_NE(read("test.dump.blog").find("dump3"), std::string::npos);
+    EXPECT_NE(read("test.dump.blog.1").find("dump2"), std::string::npos);
+    EXPECT_NE(read("test.dump.blog.2").find("dump1"), std::string::npos);
+    EXPECT_FALSE(exists("test.dump.blog.3"));
+}
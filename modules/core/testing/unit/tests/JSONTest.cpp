@@ -0,0 +1,127 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+#include <AACE/Engine/Utils/JSON/JSON.h>
+
+namespace json = aace::engine::utils::json;
+
+static const json::Value CONFIGURATION = {
+    {"aace.alexa", {{"system", {{"firmwareVersion", 42u}}}, {"locale", "en-US"}, {"enabled", true}}},
+    {"aace.vehicle", {{"info", {{"ratio", 0.5}, {"offset", -3}, {"empty", nullptr}}}}}};
+
+TEST(JSONTest, getWithAndWithoutLeadingSlash) {
+    EXPECT_EQ(json::get(CONFIGURATION, "aace.alexa/locale", ""), "en-US");
+    EXPECT_EQ(json::get(CONFIGURATION, "/aace.alexa/locale", ""), "en-US");
+    EXPECT_EQ(json::get(CONFIGURATION, "aace.alexa/system/firmwareVersion", (uint64_t)0), 42u);
+    EXPECT_EQ(json::get(CONFIGURATION, "aace.vehicle/info/offset", (int64_t)0), -3);
+    EXPECT_EQ(json::get(CONFIGURATION, "aace.vehicle/info/ratio", 0.0), 0.5);
+    EXPECT_TRUE(json::get(CONFIGURATION, "aace.alexa/enabled", false));
+    EXPECT_EQ(json::get(CONFIGURATION, "aace.alexa/system", json::Type::object), CONFIGURATION["aace.alexa"]["system"]);
+    EXPECT_EQ(json::get(CONFIGURATION, "", json::Type::object), CONFIGURATION);
+}
+
+TEST(JSONTest, getReturnsTheDefaultValue) {
+    EXPECT_EQ(json::get(CONFIGURATION, "aace.alexa/missing", "default"), "default");
+    EXPECT_EQ(json::get(CONFIGURATION, "aace.alexa/enabled", "default"), "default");
+    EXPECT_EQ(json::get(CONFIGURATION, "aace.alexa/locale", (uint64_t)7), 7u);
+    EXPECT_EQ(json::get(CONFIGURATION, "aace.alexa/locale/missing", false), false);
+    EXPECT_TRUE(json::get(CONFIGURATION, "aace.alexa/locale", json::Type::object).is_null());
+    EXPECT_TRUE(json::get(CONFIGURATION, "aace.alexa/missing").is_null());
+}
+
+TEST(JSONTest, has) {
+    EXPECT_TRUE(json::has(CONFIGURATION, "aace.alexa/locale"));
+    EXPECT_TRUE(json::has(CONFIGURATION, "aace.alexa/locale", json::Type::string));
+    EXPECT_FALSE(json::has(CONFIGURATION, "aace.alexa/locale", json::Type::object));
+    EXPECT_FALSE(json::has(CONFIGURATION, "aace.alexa/missing"));
+    EXPECT_FALSE(json::has(CONFIGURATION, "aace.vehicle/info/empty"));
+}
+
+TEST(JSONTest, pointerOverloads) {
+    static const json::Pointer LOCALE_PTR = json::pointer("aace.alexa/locale");
+    static const json::Pointer SYSTEM_PTR = json::pointer("/aace.alexa/system");
+    EXPECT_EQ(json::get(CONFIGURATION, LOCALE_PTR, ""), "en-US");
+    EXPECT_TRUE(json::has(CONFIGURATION, SYSTEM_PTR, json::Type::object));
+    EXPECT_EQ(json::get(CONFIGURATION, SYSTEM_PTR, json::Type::object)["firmwareVersion"], 42);
+
+    json::Value root;
+    EXPECT_TRUE(json::set(root, LOCALE_PTR, "de-DE"));
+    EXPECT_TRUE(json::set(root, SYSTEM_PTR, json::Value{{"firmwareVersion", 1u}}));
+    EXPECT_EQ(json::get(root, "aace.alexa/locale", ""), "de-DE");
+    EXPECT_EQ(json::get(root, "aace.alexa/system/firmwareVersion", (uint64_t)0), 1u);
+}
+
+TEST(JSONTest, setCreatesTheParents) {
+    json::Value root;
+    EXPECT_TRUE(json::set(root, "a/b/string", std::string("value")));
+    EXPECT_TRUE(json::set(root, "a/b/bool", true));
+    EXPECT_TRUE(json::set(root, "a/b/unsigned", (uint64_t)1));
+    EXPECT_TRUE(json::set(root, "a/b/signed", (int64_t)-1));
+    EXPECT_TRUE(json::set(root, "a/b/double", 1.5));
+    EXPECT_TRUE(json::set(root, "/a/b/value", json::Value::array()));
+    EXPECT_EQ(
+        root,
+        json::Value(
+            {{"a",
+              {{"b",
+                {{"string", "value"},
+                 {"bool", true},
+                 {"unsigned", 1},
+                 {"signed", -1},
+                 {"double", 1.5},
+                 {"value", json::Value::array()}}}}}}));
+}
+
+TEST(JSONTest, pathsAreCachedPerThread) {
+    // more paths than the cache holds, read several times from two threads
+    auto readAll = []() {
+        json::Value root;
+        for (int pass = 0; pass < 3; pass++) {
+            for (int i = 0; i < 1000; i++) {
+                auto path = "paths/" + std::to_string(i);
+                if (pass == 0) {
+                    ASSERT_TRUE(json::set(root, path, (uint64_t)i));
+                }
+                ASSERT_EQ(json::get(root, path, (uint64_t)0), (uint64_t)i);
+            }
+        }
+    };
+    std::thread thread(readAll);
+    readAll();
+    thread.join();
+}
+
+TEST(JSONTest, merge) {
+    json::Value into = {{"a", {{"x", 1}}}, {"b", 2}};
+    json::Value from = {{"a", {{"y", {{"z", 3}}}}}, {"c", "four"}};
+    EXPECT_TRUE(json::merge(into, from));
+    EXPECT_EQ(into, json::Value({{"a", {{"x", 1}, {"y", {{"z", 3}}}}}, {"b", 2}, {"c", "four"}}));
+    EXPECT_EQ(from["c"], "four");
+
+    EXPECT_FALSE(json::merge(into, json::Value({{"b", 5}})));
+}
+
+TEST(JSONTest, mergeMovesTheValues) {
+    json::Value into = {{"a", {{"x", 1}}}};
+    json::Value from = {{"a", {{"y", "moved"}}}, {"c", {1, 2, 3}}};
+    EXPECT_TRUE(json::merge(into, std::move(from)));
+    EXPECT_EQ(into, json::Value({{"a", {{"x", 1}, {"y", "moved"}}}, {"c", {1, 2, 3}}}));
+
+    EXPECT_FALSE(json::merge(into, json::Value({{"a", {{"x", 2}}}})));
+}
@@ -164,4 +164,69 @@ TEST_F(LocationProviderEngineImplTest, test_onLocationServiceAccessChangedCalled
     m_locationProviderEngineImpl->addObserver(m_mockLocationServiceObserverInterface);
     m_locationProviderEngineImpl->shutdown();
     m_locationProviderEngineImpl->onLocationServiceAccessChanged(LocationServiceAccess::ENABLED);
-}
\ No newline at end of file
+}
+/**
+ * @test getLocationFromPushedLocation
+ */
+TEST_F(LocationProviderEngineImplTest, test_getLocationFromPushedLocation) {
+    auto locationProviderEngineImpl =
+        LocationProviderEngineImpl::create(m_mockLocationProviderPlatformInterface, std::chrono::minutes(1));
+    ASSERT_NE(nullptr, locationProviderEngineImpl);
+
+    EXPECT_CALL(*m_mockLocationProviderPlatformInterface, getLocation()).Times(Exactly(0));
+    locationProviderEngineImpl->onLocationChanged(Location(47.6, -122.3, Location::UNDEFINED, 5));
+    auto location = locationProviderEngineImpl->getLocation();
+    ASSERT_EQ(47.6, location.getLatitude());
+    ASSERT_EQ(5, location.getAccuracy());
+    locationProviderEngineImpl->shutdown();
+}
+
+/**
+ * @test getLocationWithStaleCachedLocation
+ */
+TEST_F(LocationProviderEngineImplTest, test_getLocationWithStaleCachedLocation) {
+    auto locationProviderEngineImpl =
+        LocationProviderEngineImpl::create(m_mockLocationProviderPlatformInterface, std::chrono::minutes(1));
+    ASSERT_NE(nullptr, locationProviderEngineImpl);
+
+    // the platform is queried for a stale fix, and its location is cached
+    auto staleTime = std::chrono::system_clock::now() - std::chrono::minutes(2);
+    locationProviderEngineImpl->onLocationChanged(Location(1, 1, Location::UNDEFINED, Location::UNDEFINED, staleTime));
+    EXPECT_CALL(*m_mockLocationProviderPlatformInterface, getLocation())
+        .Times(Exactly(1))
+        .WillOnce(testing::Return(Location(2, 2)));
+    ASSERT_EQ(2, locationProviderEngineImpl->getLocation().getLatitude());
+    ASSERT_EQ(2, locationProviderEngineImpl->getLocation().getLatitude());
+    locationProviderEngineImpl->shutdown();
+}
+
+/**
+ * @test getLocationWithCacheDisabled
+ */
+TEST_F(LocationProviderEngineImplTest, test_getLocationWithCacheDisabled) {
+    ASSERT_NE(nullptr, m_locationProviderEngineImpl);
+
+    m_locationProviderEngineImpl->onLocationChanged(Location(1, 1));
+    EXPECT_CALL(*m_mockLocationProviderPlatformInterface, getLocation())
+        .Times(Exactly(2))
+        .WillRepeatedly(testing::Return(Location(2, 2)));
+    ASSERT_EQ(2, m_locationProviderEngineImpl->getLocation().getLatitude());
+    ASSERT_EQ(2, m_locationProviderEngineImpl->getLocation().getLatitude());
+}
+
+/**
+ * @test getLocationAfterLocationServiceAccessDisabled
+ */
+TEST_F(LocationProviderEngineImplTest, test_getLocationAfterLocationServiceAccessDisabled) {
+    auto locationProviderEngineImpl =
+        LocationProviderEngineImpl::create(m_mockLocationProviderPlatformInterface, std::chrono::minutes(1));
+    ASSERT_NE(nullptr, locationProviderEngineImpl);
+
+    locationProviderEngineImpl->onLocationChanged(Location(1, 1));
+    locationProviderEngineImpl->onLocationServiceAccessChanged(LocationServiceAccess::DISABLED);
+    EXPECT_CALL(*m_mockLocationProviderPlatformInterface, getLocation())
+        .Times(Exactly(1))
+        .WillOnce(testing::Return(Location()));
+    ASSERT_FALSE(locationProviderEngineImpl->getLocation().isValid());
+    locationProviderEngineImpl->shutdown();
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Logger/LogQueue.h>
+
+using aace::engine::logger::LogQueue;
+
+static LogQueue::Record createRecord(const std::string& tag, const std::string& text) {
+    return {"AAC", tag, LogQueue::Level::INFO, std::chrono::system_clock::now(), "1", text};
+}
+
+TEST(LogQueueTest, recordsArePoppedInOrder) {
+    LogQueue queue(4);
+    ASSERT_EQ(queue.capacity(), 4u);
+
+    ASSERT_TRUE(queue.push(createRecord("tag", "first")));
+    ASSERT_TRUE(queue.push(createRecord("tag", "second")));
+    EXPECT_EQ(queue.size(), 2u);
+
+    LogQueue::Record record;
+    ASSERT_TRUE(queue.pop(record));
+    EXPECT_EQ(record.text, "first");
+    ASSERT_TRUE(queue.pop(record));
+    EXPECT_EQ(record.text, "second");
+    EXPECT_FALSE(queue.pop(record));
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(LogQueueTest, pushFailsWhenFull) {
+    LogQueue queue(3);
+    ASSERT_EQ(queue.capacity(), 4u);
+
+    for (int j = 0; j < 4; j++) {
+        ASSERT_TRUE(queue.push(createRecord("tag", std::to_string(j))));
+    }
+
+    auto record = createRecord("tag", "overflow");
+    EXPECT_FALSE(queue.push(std::move(record)));
+
+    // a failed push leaves the record to the caller
+    EXPECT_EQ(record.text, "overflow");
+
+    LogQueue::Record popped;
+    ASSERT_TRUE(queue.pop(popped));
+    EXPECT_TRUE(queue.push(std::move(record)));
+}
+
+TEST(LogQueueTest, multipleProducers) {
+    LogQueue queue(64);
+    const int producerCount = 4;
+    const int recordsPerProducer = 10000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; p++) {
+        producers.emplace_back([&queue, p, recordsPerProducer]() {
+            for (int j = 0; j < recordsPerProducer; j++) {
+                auto record = createRecord(std::to_string(p), std::to_string(j));
+                while (!queue.push(std::move(record))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // the records of each producer are received in the order they were pushed
+    std::vector<int> next(producerCount, 0);
+    bool ordered = true;
+    int received = 0;
+    LogQueue::Record record;
+    while (received < producerCount * recordsPerProducer) {
+        if (!queue.pop(record)) {
+            std::this_thread::yield();
+            continue;
+        }
+        auto producer = std::stoi(record.tag);
+        ordered = ordered && std::stoi(record.text) == next[producer];
+        next[producer]++;
+        received++;
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(queue.size(), 0u);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+
+#include <AACE/Engine/Logger/LogRateLimiter.h>
+
+using aace::engine::logger::LogRateLimiter;
+using Level = LogRateLimiter::Level;
+using Clock = LogRateLimiter::Clock;
+
+static int allowed(LogRateLimiter& limiter, const std::string& tag, Level level, int count, Clock::time_point now) {
+    int result = 0;
+    for (int j = 0; j < count; j++) {
+        if (limiter.allow(tag, level, now)) {
+            result++;
+        }
+    }
+    return result;
+}
+
+TEST(LogRateLimiterTest, rejectsInvalidLimits) {
+    EXPECT_EQ(LogRateLimiter::create({0, 10}), nullptr);
+    EXPECT_EQ(LogRateLimiter::create({10, 0}), nullptr);
+    EXPECT_EQ(LogRateLimiter::create({10, 10}, std::chrono::milliseconds(0)), nullptr);
+
+    auto limiter = LogRateLimiter::create();
+    ASSERT_NE(limiter, nullptr);
+    EXPECT_FALSE(limiter->setLimit("aace.test", {-1, 10}));
+    EXPECT_FALSE(limiter->setLimit("aace.test", Level::ERROR, {10, 0.5}));
+}
+
+TEST(LogRateLimiterTest, limitsEachTagAndLevel) {
+    auto limiter = LogRateLimiter::create({10, 5});
+    ASSERT_NE(limiter, nullptr);
+    auto now = Clock::now();
+
+    // the burst is logged at once, the other tags and levels have their own buckets
+    EXPECT_EQ(allowed(*limiter, "aace.test.a", Level::ERROR, 20, now), 5);
+    EXPECT_EQ(allowed(*limiter, "aace.test.a", Level::INFO, 20, now), 5);
+    EXPECT_EQ(allowed(*limiter, "aace.test.b", Level::ERROR, 20, now), 5);
+    EXPECT_EQ(limiter->getSuppressedEntries(), 45u);
+
+    // the bucket refills at the rate
+    EXPECT_EQ(allowed(*limiter, "aace.test.a", Level::ERROR, 20, now + std::chrono::milliseconds(200)), 2);
+    EXPECT_EQ(allowed(*limiter, "aace.test.a", Level::ERROR, 20, now + std::chrono::seconds(10)), 5);
+}
+
+TEST(LogRateLimiterTest, neverSuppressesCriticalEntries) {
+    auto limiter = LogRateLimiter::create({1, 1});
+    ASSERT_NE(limiter, nullptr);
+    EXPECT_EQ(allowed(*limiter, "aace.test", Level::CRITICAL, 100, Clock::now()), 100);
+    EXPECT_EQ(limiter->getSuppressedEntries(), 0u);
+}
+
+TEST(LogRateLimiterTest, appliesTheLimitsOfTheTags) {
+    auto limiter = LogRateLimiter::create({10, 5});
+    ASSERT_NE(limiter, nullptr);
+    ASSERT_TRUE(limiter->setLimit("aace.test.noisy", {1, 2}));
+    ASSERT_TRUE(limiter->setLimit("aace.test.noisy", Level::VERBOSE, {1, 1}));
+    ASSERT_TRUE(limiter->setLimit("aace.test.other", Level::WARN, {1, 3}));
+    auto now = Clock::now();
+
+    EXPECT_EQ(allowed(*limiter, "aace.test.noisy", Level::ERROR, 10, now), 2);
+    EXPECT_EQ(allowed(*limiter, "aace.test.noisy", Level::VERBOSE, 10, now), 1);
+    EXPECT_EQ(allowed(*limiter, "aace.test.other", Level::WARN, 10, now), 3);
+
+    // the other levels of the tag keep the default limit
+    EXPECT_EQ(allowed(*limiter, "aace.test.other", Level::ERROR, 10, now), 5);
+}
+
+TEST(LogRateLimiterTest, summarizesSuppressedEntriesPeriodically) {
+    auto limiter = LogRateLimiter::create({10, 5}, std::chrono::milliseconds(1000));
+    ASSERT_NE(limiter, nullptr);
+    auto now = Clock::now();
+
+    allowed(*limiter, "aace.test", Level::ERROR, 8, now);
+    EXPECT_TRUE(limiter->takeSummary(now).empty());
+
+    auto summary = limiter->takeSummary(now + std::chrono::seconds(2));
+    ASSERT_EQ(summary.size(), 1u);
+    EXPECT_EQ(summary[0].tag, "aace.test");
+    EXPECT_EQ(summary[0].level, Level::ERROR);
+    EXPECT_EQ(summary[0].count, 3u);
+
+    // the counts are reset by the summary, and the next summary waits for the interval
+    allowed(*limiter, "aace.test", Level::ERROR, 20, now + std::chrono::seconds(2));
+    EXPECT_TRUE(limiter->takeSummary(now + std::chrono::milliseconds(2500)).empty());
+    summary = limiter->takeSummary(now + std::chrono::seconds(4));
+    ASSERT_EQ(summary.size(), 1u);
+    EXPECT_EQ(summary[0].count, 15u);
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/Logger/LoggerEngineImpl.h>
+
+using aace::engine::logger::EngineLogger;
+using aace::engine::logger::LoggerEngineImpl;
+using Level = aace::logger::Logger::Level;
+
+/// A platform logger which records the calls from the Engine
+class RecordingLogger : public aace::logger::Logger {
+public:
+    bool logEvent(
+        Level level,
+        std::chrono::system_clock::time_point time,
+        const std::string& source,
+        const std::string& message) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_calls.push_back({{level, time, source, message}});
+        m_cv.notify_all();
+        return true;
+    }
+
+    bool logEvents(const std::vector<LogEvent>& events) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_calls.push_back(events);
+        m_cv.notify_all();
+        return true;
+    }
+
+    bool waitForCalls(size_t count, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_cv.wait_for(lock, timeout, [this, count] { return m_calls.size() >= count; });
+    }
+
+    std::vector<std::vector<LogEvent>> getCalls() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_calls;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<std::vector<LogEvent>> m_calls;
+};
+
+/// Test harness for @c LoggerEngineImpl class
+class LoggerEngineImplTest : public ::testing::Test {
+public:
+    void TearDown() override {
+        if (m_platformLogger != nullptr) {
+            m_platformLogger->setEngineInterface(nullptr);
+        }
+    }
+
+protected:
+    std::shared_ptr<LoggerEngineImpl> create(const LoggerEngineImpl::BatchConfig& batchConfig) {
+        m_platformLogger = std::make_shared<RecordingLogger>();
+        m_loggerEngineImpl = LoggerEngineImpl::create(m_platformLogger, EngineLogger::getInstance(), batchConfig);
+        // the events are delivered to the observer directly in the test
+        EngineLogger::getInstance()->removeObserver(m_loggerEngineImpl);
+        return m_loggerEngineImpl;
+    }
+
+    static void logEvent(std::shared_ptr<LoggerEngineImpl> impl, Level level, const std::string& text) {
+        impl->onLogEvent(level, std::chrono::system_clock::now(), "AVS", text.c_str());
+    }
+
+    std::shared_ptr<RecordingLogger> m_platformLogger;
+    std::shared_ptr<LoggerEngineImpl> m_loggerEngineImpl;
+};
+
+TEST_F(LoggerEngineImplTest, deliversEachEventWithoutBatching) {
+    auto impl = create(LoggerEngineImpl::BatchConfig());
+    ASSERT_NE(impl, nullptr);
+    logEvent(impl, Level::INFO, "first");
+    logEvent(impl, Level::INFO, "second");
+
+    auto calls = m_platformLogger->getCalls();
+    ASSERT_EQ(calls.size(), 2u);
+    EXPECT_EQ(calls[0][0].message, "first");
+    EXPECT_EQ(calls[1][0].message, "second");
+}
+
+TEST_F(LoggerEngineImplTest, deliversFullBatches) {
+    LoggerEngineImpl::BatchConfig batchConfig;
+    batchConfig.enabled = true;
+    batchConfig.maxEvents = 3;
+    batchConfig.maxDelay = std::chrono::seconds(60);
+    auto impl = create(batchConfig);
+    ASSERT_NE(impl, nullptr);
+
+    for (int i = 0; i < 7; i++) {
+        logEvent(impl, Level::VERBOSE, "event " + std::to_string(i));
+    }
+    auto calls = m_platformLogger->getCalls();
+    ASSERT_EQ(calls.size(), 2u);
+    ASSERT_EQ(calls[0].size(), 3u);
+    EXPECT_EQ(calls[0][0].message, "event 0");
+    EXPECT_EQ(calls[1][2].message, "event 5");
+
+    EXPECT_TRUE(impl->flush());
+    calls = m_platformLogger->getCalls();
+    ASSERT_EQ(calls.size(), 3u);
+    ASSERT_EQ(calls[2].size(), 1u);
+    EXPECT_EQ(calls[2][0].message, "event 6");
+    EXPECT_EQ(calls[2][0].source, "AVS");
+}
+
+TEST_F(LoggerEngineImplTest, deliversErrorsImmediately) {
+    LoggerEngineImpl::BatchConfig batchConfig;
+    batchConfig.enabled = true;
+    batchConfig.maxDelay = std::chrono::seconds(60);
+    auto impl = create(batchConfig);
+    ASSERT_NE(impl, nullptr);
+
+    logEvent(impl, Level::INFO, "before");
+    EXPECT_TRUE(m_platformLogger->getCalls().empty());
+    logEvent(impl, Level::ERROR, "failure");
+
+    auto calls = m_platformLogger->getCalls();
+    ASSERT_EQ(calls.size(), 1u);
+    ASSERT_EQ(calls[0].size(), 2u);
+    EXPECT_EQ(calls[0][0].message, "before");
+    EXPECT_EQ(calls[0][1].level, Level::ERROR);
+}
+
+TEST_F(LoggerEngineImplTest, deliversBatchAfterDelay) {
+    LoggerEngineImpl::BatchConfig batchConfig;
+    batchConfig.enabled = true;
+    batchConfig.maxDelay = std::chrono::milliseconds(50);
+    auto impl = create(batchConfig);
+    ASSERT_NE(impl, nullptr);
+
+    logEvent(impl, Level::INFO, "first");
+    logEvent(impl, Level::WARN, "second");
+    ASSERT_TRUE(m_platformLogger->waitForCalls(1, std::chrono::seconds(5)));
+    auto calls = m_platformLogger->getCalls();
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_EQ(calls[0].size(), 2u);
+}
+
+TEST_F(LoggerEngineImplTest, rejectsInvalidBatchConfig) {
+    LoggerEngineImpl::BatchConfig batchConfig;
+    batchConfig.enabled = true;
+    batchConfig.maxEvents = 0;
+    m_platformLogger = std::make_shared<RecordingLogger>();
+    EXPECT_EQ(LoggerEngineImpl::create(m_platformLogger, EngineLogger::getInstance(), batchConfig), nullptr);
+}
+
+TEST(LoggerTest, defaultLogEventsCallsLogEvent) {
+    class CountingLogger : public aace::logger::Logger {
+    public:
+        bool logEvent(Level, std::chrono::system_clock::time_point, const std::string&, const std::string&)
+            override {
+            return ++m_count != 2;
+        }
+        int m_count = 0;
+    };
+    CountingLogger logger;
+    auto now = std::chrono::system_clock::now();
+    std::vector<aace::logger::Logger::LogEvent> events = {
+        {Level::INFO, now, "AVS", "a"}, {Level::INFO, now, "AVS", "b"}, {Level::INFO, now, "AVS", "c"}};
+    // every event is delivered, and the failure of one is reported
+    EXPECT_FALSE(logger.logEvents(events));
+    EXPECT_EQ(logger.m_count, 3);
+}
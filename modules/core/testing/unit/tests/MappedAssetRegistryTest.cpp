@@ -0,0 +1,95 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <AACE/Engine/Utils/Memory/MappedAssetRegistry.h>
+
+using aace::engine::utils::memory::MappedAsset;
+using aace::engine::utils::memory::MappedAssetRegistry;
+
+/// The file of the test asset
+static const std::string ASSET_PATH = "MappedAssetRegistryTest.bin";
+
+class MappedAssetRegistryTest : public ::testing::Test {
+public:
+    void TearDown() override {
+        std::remove(ASSET_PATH.c_str());
+        std::remove((ASSET_PATH + ".new").c_str());
+    }
+
+    /// Writes a file, replacing it by a rename like a model update.
+    static void writeFile(const std::string& path, const std::string& contents) {
+        auto temporary = path + ".new";
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file << contents;
+        file.close();
+        ASSERT_EQ(std::rename(temporary.c_str(), path.c_str()), 0);
+    }
+
+    static std::string getContents(const std::shared_ptr<const MappedAsset>& asset) {
+        return std::string(reinterpret_cast<const char*>(asset->data()), asset->size());
+    }
+};
+
+TEST_F(MappedAssetRegistryTest, sharesViewOfFile) {
+    writeFile(ASSET_PATH, "wakeword model");
+    auto first = MappedAssetRegistry::open(ASSET_PATH);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(getContents(first), "wakeword model");
+    EXPECT_EQ(first->getPath(), ASSET_PATH);
+    first->willNeed();
+
+    auto second = MappedAssetRegistry::open(ASSET_PATH);
+    EXPECT_EQ(second, first);
+    auto stats = MappedAssetRegistry::getStats();
+    EXPECT_EQ(stats.assets, 1u);
+    EXPECT_EQ(stats.mappedBytes, first->size());
+
+    first.reset();
+    second.reset();
+    EXPECT_EQ(MappedAssetRegistry::getStats().assets, 0u);
+}
+
+TEST_F(MappedAssetRegistryTest, mapsReplacedFileAgain) {
+    writeFile(ASSET_PATH, "en-US");
+    auto previous = MappedAssetRegistry::open(ASSET_PATH);
+    ASSERT_NE(previous, nullptr);
+
+    writeFile(ASSET_PATH, "en-US updated");
+    auto current = MappedAssetRegistry::open(ASSET_PATH);
+    ASSERT_NE(current, nullptr);
+    EXPECT_NE(current, previous);
+    // the readers of the previous view keep its contents
+    EXPECT_EQ(getContents(previous), "en-US");
+    EXPECT_EQ(getContents(current), "en-US updated");
+    EXPECT_EQ(MappedAssetRegistry::getStats().assets, 2u);
+}
+
+TEST_F(MappedAssetRegistryTest, mapsEmptyFile) {
+    writeFile(ASSET_PATH, "");
+    auto asset = MappedAssetRegistry::open(ASSET_PATH);
+    ASSERT_NE(asset, nullptr);
+    EXPECT_EQ(asset->data(), nullptr);
+    EXPECT_EQ(asset->size(), 0u);
+}
+
+TEST_F(MappedAssetRegistryTest, rejectsInvalidFile) {
+    EXPECT_EQ(MappedAssetRegistry::open("/nonexistent/MappedAssetRegistryTest.bin"), nullptr);
+    EXPECT_EQ(MappedAssetRegistry::open("."), nullptr);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+#include <AACE/Engine/Utils/Memory/MemoryAccounting.h>
+#include <AACE/Engine/Utils/Threading/Executor.h>
+
+namespace aace {
+namespace test {
+namespace unit {
+namespace core {
+
+using MemoryAccounting = aace::engine::utils::memory::MemoryAccounting;
+using Executor = aace::engine::utils::threading::Executor;
+
+/// Returns the snapshot of a module
+static MemoryAccounting::Snapshot getSnapshot(uint32_t module) {
+    auto snapshots = MemoryAccounting::getSnapshots();
+    return module < snapshots.size() ? snapshots[module] : MemoryAccounting::Snapshot();
+}
+
+TEST(MemoryAccountingTest, RegisterModuleShouldReturnTheSameIdForTheSameName) {
+    auto module = MemoryAccounting::registerModule("test.register");
+    EXPECT_NE(module, MemoryAccounting::UNTAGGED);
+    EXPECT_EQ(MemoryAccounting::registerModule("test.register"), module);
+    EXPECT_NE(MemoryAccounting::registerModule("test.register.other"), module);
+    EXPECT_EQ(MemoryAccounting::registerModule(""), MemoryAccounting::UNTAGGED);
+    EXPECT_EQ(getSnapshot(module).module, "test.register");
+    EXPECT_EQ(getSnapshot(MemoryAccounting::UNTAGGED).module, "untagged");
+
+    // a thread or executor name is accounted to its first component
+    auto named = MemoryAccounting::registerModule("TestNamed");
+    EXPECT_EQ(MemoryAccounting::registerNamedModule("TestNamed.worker.1"), named);
+}
+
+TEST(MemoryAccountingTest, ScopeShouldSetAndRestoreTheCurrentModule) {
+    auto outer = MemoryAccounting::registerModule("test.outer");
+    auto inner = MemoryAccounting::registerModule("test.inner");
+    EXPECT_EQ(MemoryAccounting::getCurrentModule(), MemoryAccounting::UNTAGGED);
+    {
+        MemoryAccounting::Scope outerScope("test.outer");
+        EXPECT_EQ(MemoryAccounting::getCurrentModule(), outer);
+        {
+            MemoryAccounting::Scope innerScope("test.inner");
+            EXPECT_EQ(MemoryAccounting::getCurrentModule(), inner);
+        }
+        EXPECT_EQ(MemoryAccounting::getCurrentModule(), outer);
+
+        // the scope is per thread
+        std::thread([]() { EXPECT_EQ(MemoryAccounting::getCurrentModule(), MemoryAccounting::UNTAGGED); }).join();
+    }
+    EXPECT_EQ(MemoryAccounting::getCurrentModule(), MemoryAccounting::UNTAGGED);
+}
+
+TEST(MemoryAccountingTest, CountersShouldTrackLiveAndPeakBytes) {
+    auto module = MemoryAccounting::registerModule("test.counters");
+    auto start = getSnapshot(module);
+
+    MemoryAccounting::recordAllocation(module, 100);
+    MemoryAccounting::recordAllocation(module, 50);
+    MemoryAccounting::recordDeallocation(module, 100);
+    MemoryAccounting::recordAllocation(module, 20);
+
+    auto snapshot = getSnapshot(module);
+    EXPECT_EQ(snapshot.liveBytes - start.liveBytes, 70);
+    EXPECT_EQ(snapshot.peakBytes, 150);
+    EXPECT_EQ(snapshot.allocations - start.allocations, 3u);
+    EXPECT_EQ(snapshot.deallocations - start.deallocations, 1u);
+    EXPECT_EQ(snapshot.allocatedBytes - start.allocatedBytes, 170u);
+}
+
+TEST(MemoryAccountingTest, AllocationRateShouldBeComputedBetweenSnapshots) {
+    MemoryAccounting::Snapshot previous;
+    previous.allocations = 100;
+    MemoryAccounting::Snapshot current = previous;
+    current.allocations = 400;
+    current.time = previous.time + std::chrono::seconds(2);
+    EXPECT_DOUBLE_EQ(MemoryAccounting::getAllocationRate(previous, current), 150.0);
+    EXPECT_DOUBLE_EQ(MemoryAccounting::getAllocationRate(current, current), 0.0);
+}
+
+TEST(MemoryAccountingTest, ExecutorTaskShouldRunInTheModuleOfTheSubmitter) {
+    auto module = MemoryAccounting::registerModule("test.submitter");
+    auto executorModule = MemoryAccounting::registerModule("TestExecutor");
+    Executor executor("TestExecutor.lane");
+
+    uint32_t taskModule = MemoryAccounting::UNTAGGED;
+    {
+        MemoryAccounting::Scope scope("test.submitter");
+        executor.submit([&taskModule]() { taskModule = MemoryAccounting::getCurrentModule(); }).wait();
+    }
+    EXPECT_EQ(taskModule, module);
+
+    // outside of any module the task runs in the module of the executor
+    executor.submit([&taskModule]() { taskModule = MemoryAccounting::getCurrentModule(); }).wait();
+    EXPECT_EQ(taskModule, executorModule);
+    executor.shutdown();
+}
+
+#if defined(AAC_MEMORY_ACCOUNTING)
+TEST(MemoryAccountingTest, AllocationsShouldBeAccountedToTheCurrentModule) {
+    ASSERT_TRUE(MemoryAccounting::isEnabled());
+    auto module = MemoryAccounting::registerModule("test.allocations");
+    auto start = getSnapshot(module);
+
+    std::unique_ptr<char[]> block;
+    {
+        MemoryAccounting::Scope scope("test.allocations");
+        block.reset(new char[4096]);
+    }
+    auto allocated = getSnapshot(module);
+    EXPECT_EQ(allocated.liveBytes - start.liveBytes, 4096);
+    EXPECT_EQ(allocated.allocations - start.allocations, 1u);
+
+    // the block is released to the module that allocated it
+    block.reset();
+    EXPECT_EQ(getSnapshot(module).liveBytes, start.liveBytes);
+}
+#endif
+
+}  // namespace core
+}  // namespace unit
+}  // namespace test
+}  // namespace aace
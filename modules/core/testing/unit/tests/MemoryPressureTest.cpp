@@ -0,0 +1,130 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <AACE/Engine/Utils/Memory/MemoryPressure.h>
+
+using aace::engine::utils::memory::MemoryPressure;
+using aace::engine::utils::memory::MemoryPressureLevel;
+using aace::engine::utils::memory::MemoryPressureObserverInterface;
+
+using Notifications = std::vector<std::pair<std::string, MemoryPressureLevel>>;
+
+class TestObserver : public MemoryPressureObserverInterface {
+public:
+    TestObserver(const std::string& name, Notifications& notifications) :
+            m_name(name), m_notifications(notifications) {
+    }
+
+    void onMemoryPressure(MemoryPressureLevel level) override {
+        m_notifications.emplace_back(m_name, level);
+    }
+
+private:
+    std::string m_name;
+    Notifications& m_notifications;
+};
+
+class MemoryPressureTest : public ::testing::Test {
+public:
+    void TearDown() override {
+        // the level is shared by the process
+        MemoryPressure::report(MemoryPressureLevel::NORMAL);
+    }
+
+protected:
+    Notifications m_notifications;
+};
+
+TEST_F(MemoryPressureTest, notifiesThePrioritiesInOrderFromTheirLevel) {
+    auto essential = std::make_shared<TestObserver>("essential", m_notifications);
+    auto buffer = std::make_shared<TestObserver>("buffer", m_notifications);
+    auto cache = std::make_shared<TestObserver>("cache", m_notifications);
+    MemoryPressure::addObserver(essential, MemoryPressure::Priority::ESSENTIAL);
+    MemoryPressure::addObserver(buffer, MemoryPressure::Priority::BUFFER);
+    MemoryPressure::addObserver(cache, MemoryPressure::Priority::CACHE);
+    EXPECT_TRUE(m_notifications.empty());
+
+    MemoryPressure::report(MemoryPressureLevel::MODERATE);
+    EXPECT_EQ(m_notifications, Notifications({{"cache", MemoryPressureLevel::MODERATE}}));
+    EXPECT_EQ(MemoryPressure::getLevel(), MemoryPressureLevel::MODERATE);
+
+    m_notifications.clear();
+    MemoryPressure::report(MemoryPressureLevel::CRITICAL);
+    EXPECT_EQ(
+        m_notifications,
+        Notifications({{"cache", MemoryPressureLevel::CRITICAL},
+                       {"buffer", MemoryPressureLevel::CRITICAL},
+                       {"essential", MemoryPressureLevel::CRITICAL}}));
+
+    // each observer grows back once the level drops below its own
+    m_notifications.clear();
+    MemoryPressure::report(MemoryPressureLevel::LOW);
+    EXPECT_EQ(m_notifications, Notifications({{"cache", MemoryPressureLevel::LOW},
+                                              {"buffer", MemoryPressureLevel::LOW},
+                                              {"essential", MemoryPressureLevel::NORMAL}}));
+
+    m_notifications.clear();
+    MemoryPressure::report(MemoryPressureLevel::LOW);
+    EXPECT_TRUE(m_notifications.empty());
+
+    MemoryPressure::report(MemoryPressureLevel::NORMAL);
+    EXPECT_EQ(
+        m_notifications,
+        Notifications({{"cache", MemoryPressureLevel::NORMAL}, {"buffer", MemoryPressureLevel::NORMAL}}));
+}
+
+TEST_F(MemoryPressureTest, notifiesAnObserverAddedUnderPressure) {
+    MemoryPressure::report(MemoryPressureLevel::LOW);
+
+    auto essential = std::make_shared<TestObserver>("essential", m_notifications);
+    auto cache = std::make_shared<TestObserver>("cache", m_notifications);
+    MemoryPressure::addObserver(essential, MemoryPressure::Priority::ESSENTIAL);
+    MemoryPressure::addObserver(cache, MemoryPressure::Priority::CACHE);
+    EXPECT_EQ(m_notifications, Notifications({{"cache", MemoryPressureLevel::LOW}}));
+}
+
+TEST_F(MemoryPressureTest, removesTheObservers) {
+    auto removed = std::make_shared<TestObserver>("removed", m_notifications);
+    auto released = std::make_shared<TestObserver>("released", m_notifications);
+    auto kept = std::make_shared<TestObserver>("kept", m_notifications);
+    MemoryPressure::addObserver(removed, MemoryPressure::Priority::CACHE);
+    MemoryPressure::addObserver(released, MemoryPressure::Priority::CACHE);
+    MemoryPressure::addObserver(kept, MemoryPressure::Priority::CACHE);
+
+    MemoryPressure::removeObserver(removed);
+    released.reset();
+    MemoryPressure::report(MemoryPressureLevel::MODERATE);
+    EXPECT_EQ(m_notifications, Notifications({{"kept", MemoryPressureLevel::MODERATE}}));
+}
+
+TEST_F(MemoryPressureTest, mapsTheLevelsOfThePriorities) {
+    using Priority = MemoryPressure::Priority;
+    EXPECT_EQ(MemoryPressure::getLevelFor(Priority::CACHE, MemoryPressureLevel::NORMAL), MemoryPressureLevel::NORMAL);
+    EXPECT_EQ(
+        MemoryPressure::getLevelFor(Priority::CACHE, MemoryPressureLevel::MODERATE), MemoryPressureLevel::MODERATE);
+    EXPECT_EQ(
+        MemoryPressure::getLevelFor(Priority::BUFFER, MemoryPressureLevel::MODERATE), MemoryPressureLevel::NORMAL);
+    EXPECT_EQ(MemoryPressure::getLevelFor(Priority::BUFFER, MemoryPressureLevel::LOW), MemoryPressureLevel::LOW);
+    EXPECT_EQ(MemoryPressure::getLevelFor(Priority::ESSENTIAL, MemoryPressureLevel::LOW), MemoryPressureLevel::NORMAL);
+    EXPECT_EQ(
+        MemoryPressure::getLevelFor(Priority::ESSENTIAL, MemoryPressureLevel::CRITICAL),
+        MemoryPressureLevel::CRITICAL);
+}
@@ -16,7 +16,12 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <sstream>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
 
 // testing includes
 #include <AACE/Test/Unit/Core/CoreTestHelper.h>
@@ -80,6 +85,41 @@ static auto SAMPLE_REPLY = R"({
   }
 })";
 
+namespace {
+
+// a message in the shape of the generated AASB messages
+struct GetLocationMessage {
+    struct Header {
+        std::string id = "23b578ed-6dc3-460a-998e-1647ba6cde42";
+    };
+    static std::string topic() {
+        return "LocationProvider";
+    }
+    static std::string action() {
+        return "GetLocation";
+    }
+    static std::string messageType() {
+        return "Publish";
+    }
+    Header header;
+};
+
+void to_json(nlohmann::json& j, const GetLocationMessage& c) {
+    j = nlohmann::json{
+        {"header",
+         {{"id", c.header.id},
+          {"messageType", c.messageType()},
+          {"version", "4.0"},
+          {"messageDescription", {{"topic", c.topic()}, {"action", c.action()}}}}},
+    };
+}
+
+void from_json(const nlohmann::json& j, GetLocationMessage& c) {
+    j.at("header").at("id").get_to(c.header.id);
+}
+
+}  // namespace
+
 TEST_F(MessageBrokerImplTest, sendEmptyMessage) {
     auto reply = m_broker->publish("{}").get();
     ASSERT_FALSE(reply.valid());
@@ -116,3 +156,664 @@ TEST_F(MessageBrokerImplTest, noSubscriberNoWait) {
     ASSERT_TRUE(duration < pm.timeout() / 2);
     ASSERT_FALSE(reply.valid());
 }
+
+static auto SAMPLE_EVENT = R"({
+  "header": {
+    "id": "7e2c09e4-1d5f-4a84-a2e1-3f0f5c4b8a61",
+    "messageType": "Publish",
+    "version": "4.0",
+    "messageDescription": {
+        "topic": "Navigation",
+        "action": "NavigationEvent"
+    }
+  }
+})";
+
+TEST_F(MessageBrokerImplTest, wildcardSubscribersNotifiedInOrder) {
+    std::mutex mutex;
+    std::vector<std::string> notified;
+    std::promise<void> done;
+
+    auto record = [&](const std::string& name, const Message& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        notified.push_back(name + ":" + message.topic());
+    };
+
+    m_broker->subscribe(
+        "*",
+        [&](const Message& message) {
+            record("all", message);
+            if (message.topic() == "LocationProvider") {
+                done.set_value();
+            }
+        },
+        Message::Direction::OUTGOING);
+    m_broker->subscribe(
+        "Navigation", "*", [&](const Message& message) { record("topic", message); }, Message::Direction::OUTGOING);
+    m_broker->subscribe(
+        "Navigation",
+        "NavigationEvent",
+        [&](const Message& message) { record("action", message); },
+        Message::Direction::OUTGOING);
+    m_broker->subscribe(
+        "Navigation",
+        "OtherAction",
+        [&](const Message& message) { record("other", message); },
+        Message::Direction::OUTGOING);
+    m_broker->subscribe(
+        "Navigation", [&](const Message& message) { record("incoming", message); }, Message::Direction::INCOMING);
+
+    m_broker->publish(SAMPLE_EVENT).send();
+    m_broker->publish(SAMPLE_REQUEST).send();
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> expected = {
+        "action:Navigation", "topic:Navigation", "all:Navigation", "all:LocationProvider"};
+    ASSERT_EQ(notified, expected);
+}
+
+TEST_F(MessageBrokerImplTest, actionSubscribedInOtherDirectionRoutesToWildcards) {
+    std::mutex mutex;
+    std::vector<std::string> notified;
+    std::promise<void> done;
+
+    auto record = [&](const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        notified.push_back(name);
+    };
+
+    m_broker->subscribe(
+        "Navigation", "*", [&](const Message& message) { record("topic"); }, Message::Direction::OUTGOING);
+    m_broker->subscribe(
+        "*",
+        [&](const Message& message) {
+            record("all");
+            done.set_value();
+        },
+        Message::Direction::OUTGOING);
+    // the action is only subscribed for incoming messages, after the outgoing routes were compiled
+    m_broker->subscribe(
+        "Navigation",
+        "NavigationEvent",
+        [&](const Message& message) { record("incoming"); },
+        Message::Direction::INCOMING);
+
+    m_broker->publish(SAMPLE_EVENT).send();
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> expected = {"topic", "all"};
+    ASSERT_EQ(notified, expected);
+}
+
+TEST_F(MessageBrokerImplTest, unsubscribe) {
+    std::atomic<int> removedCount{0};
+    std::promise<void> done;
+
+    auto id = m_broker->subscribe(
+        "Navigation", [&](const Message& message) { removedCount++; }, Message::Direction::OUTGOING);
+    ASSERT_NE(id, 0u);
+    m_broker->subscribe(
+        "Navigation", [&](const Message& message) { done.set_value(); }, Message::Direction::OUTGOING);
+
+    ASSERT_TRUE(m_broker->unsubscribe(id));
+    ASSERT_FALSE(m_broker->unsubscribe(id));
+
+    m_broker->publish(SAMPLE_EVENT).send();
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    ASSERT_EQ(removedCount, 0);
+}
+
+static std::string createEvent(const std::string& topic, const std::string& id) {
+    return R"({"header":{"id":")" + id + R"(","messageType":"Publish","version":"4.0",)" +
+           R"("messageDescription":{"topic":")" + topic + R"(","action":"Event"}}})";
+}
+
+TEST_F(MessageBrokerImplTest, dispatchLanesPreserveTopicOrder) {
+    m_broker->setDispatchLaneCount(4);
+
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::promise<void> done;
+    const int count = 100;
+
+    m_broker->subscribe(
+        "Ordered",
+        [&](const Message& message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            received.push_back(message.messageId());
+            if (received.size() == count) {
+                done.set_value();
+            }
+        },
+        Message::Direction::OUTGOING);
+
+    std::vector<std::string> expected;
+    for (int i = 0; i < count; i++) {
+        expected.push_back(std::to_string(i));
+        m_broker->publish(createEvent("Ordered", expected.back())).send();
+    }
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(received, expected);
+}
+
+TEST_F(MessageBrokerImplTest, blockedLaneDoesNotDelayOtherTopics) {
+    m_broker->setDispatchLaneCount(64);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    // the lanes deliver the queued messages after the test returns, so the subscriber owns what it uses
+    auto fastReceived = std::make_shared<std::promise<void>>();
+    auto fastNotified = std::make_shared<std::atomic<bool>>(false);
+    auto fastReceivedFuture = fastReceived->get_future();
+
+    m_broker->subscribe(
+        "Slow", [released](const Message& message) { released.wait(); }, Message::Direction::OUTGOING);
+    m_broker->subscribe(
+        "*",
+        [fastReceived, fastNotified](const Message& message) {
+            if (message.topic() != "Slow" && !fastNotified->exchange(true)) {
+                fastReceived->set_value();
+            }
+        },
+        Message::Direction::OUTGOING);
+
+    m_broker->publish(createEvent("Slow", "slow")).send();
+
+    // at least one of the topics is assigned to a different lane than the blocked topic
+    for (int i = 0; i < 10; i++) {
+        m_broker->publish(createEvent("Fast" + std::to_string(i), std::to_string(i))).send();
+    }
+
+    auto status = fastReceivedFuture.wait_for(std::chrono::seconds(1));
+    release.set_value();
+    ASSERT_EQ(status, std::future_status::ready);
+}
+
+static std::string createRequest(const std::string& id) {
+    return R"({"header":{"id":")" + id + R"(","messageType":"Publish","version":"4.0",)" +
+           R"("messageDescription":{"topic":"LocationProvider","action":"GetLocation"}}})";
+}
+
+static std::string createReply(const std::string& replyToId) {
+    return R"({"header":{"id":"reply-)" + replyToId + R"(","messageType":"Reply","version":"4.0",)" +
+           R"("messageDescription":{"topic":"LocationProvider","action":"GetLocation","replyToId":")" +
+           replyToId + R"("}},"payload":{}})";
+}
+
+TEST_F(MessageBrokerImplTest, concurrentSyncRequestsOverlap) {
+    m_broker->setMessageTimeout(std::chrono::milliseconds{1000});
+
+    std::mutex mutex;
+    std::vector<std::thread> replyThreads;
+
+    // reply to each request from another thread after a delay
+    m_broker->subscribe(
+        "LocationProvider",
+        [&](const Message& message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto id = message.messageId();
+            replyThreads.emplace_back([this, id]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                m_broker->publish(createReply(id), Message::Direction::INCOMING).send();
+            });
+        },
+        Message::Direction::OUTGOING);
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto first = std::async(std::launch::async, [this]() { return m_broker->publish(createRequest("first")).get(); });
+    auto second = std::async(std::launch::async, [this]() { return m_broker->publish(createRequest("second")).get(); });
+
+    EXPECT_EQ(first.get().replyTo(), "first");
+    EXPECT_EQ(second.get().replyTo(), "second");
+
+    // the requests wait for their replies at the same time
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(550));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& next : replyThreads) {
+        next.join();
+    }
+}
+
+TEST_F(MessageBrokerImplTest, asyncRequestSuccess) {
+    m_broker->subscribe(
+        "LocationProvider",
+        [=](const Message& message) {
+            m_broker->publish(createReply(message.messageId()), Message::Direction::INCOMING).send();
+        },
+        Message::Direction::OUTGOING);
+
+    std::promise<std::string> replied;
+    std::atomic<bool> failed{false};
+
+    m_broker->publish(createRequest("async"))
+        .success([&](const Message& reply) { replied.set_value(reply.replyTo()); })
+        .error([&]() { failed = true; })
+        .send();
+
+    auto future = replied.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(future.get(), "async");
+    EXPECT_FALSE(failed);
+}
+
+TEST_F(MessageBrokerImplTest, asyncRequestTimeout) {
+    m_broker->subscribe(
+        "LocationProvider",
+        [=](const Message& message) {
+            // do nothing
+        },
+        Message::Direction::OUTGOING);
+
+    std::promise<void> failed;
+    auto startTime = std::chrono::steady_clock::now();
+
+    m_broker->publish(createRequest("timeout"))
+        .timeout(std::chrono::milliseconds(100))
+        .success([&](const Message& reply) { FAIL() << "Unexpected reply"; })
+        .error([&]() { failed.set_value(); })
+        .send();
+
+    // send() returns without waiting for the reply
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(100));
+
+    ASSERT_EQ(failed.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_GE(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(100));
+}
+
+TEST_F(MessageBrokerImplTest, asyncRequestNoSubscribers) {
+    std::promise<void> failed;
+
+    m_broker->publish(createRequest("none")).error([&]() { failed.set_value(); }).send();
+
+    ASSERT_EQ(failed.get_future().wait_for(std::chrono::milliseconds(250)), std::future_status::ready);
+}
+
+TEST_F(MessageBrokerImplTest, metricsSampling) {
+    std::atomic<int> received{0};
+    std::promise<void> done;
+    const int count = 10;
+
+    m_broker->subscribe(
+        "Sampled",
+        [&](const Message& message) {
+            if (++received == count) {
+                done.set_value();
+            }
+        },
+        Message::Direction::OUTGOING);
+
+    // messages published while sampling is disabled are not recorded
+    m_broker->publish(createEvent("Sampled", "disabled")).send();
+    m_broker->setMetricsSampleInterval(2);
+    for (int i = 1; i < count; i++) {
+        m_broker->publish(createEvent("Sampled", std::to_string(i))).send();
+    }
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    auto snapshot = m_broker->getMetricsSnapshot();
+    EXPECT_EQ(snapshot.sampleInterval, 2u);
+    EXPECT_EQ(snapshot.publishedMessages, 9u);
+    ASSERT_EQ(snapshot.outgoingQueueDepth.size(), 1u);
+    ASSERT_EQ(snapshot.topics.size(), 1u);
+
+    auto& topic = snapshot.topics.front();
+    EXPECT_EQ(topic.topic, "Sampled");
+    EXPECT_EQ(topic.action, "Event");
+    EXPECT_EQ(topic.samples, 5u);
+    EXPECT_EQ(topic.dispatchLatency.count, 5u);
+    EXPECT_EQ(topic.handlerTime.count, 5u);
+}
+
+TEST_F(MessageBrokerImplTest, publishBatchPreservesOrder) {
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::promise<void> done;
+
+    m_broker->subscribe(
+        "Batched",
+        [&](const Message& message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            received.push_back(message.messageId());
+            if (received.size() == 3) {
+                done.set_value();
+            }
+        },
+        Message::Direction::OUTGOING);
+
+    std::vector<std::string> batch = {
+        createEvent("Batched", "1"), "invalid", createEvent("Batched", "2"), createEvent("Batched", "3")};
+    ASSERT_EQ(m_broker->publishBatch(batch), 3u);
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(received, std::vector<std::string>({"1", "2", "3"}));
+}
+
+TEST_F(MessageBrokerImplTest, publishBatchCoalescesState) {
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::promise<void> done;
+
+    m_broker->subscribe(
+        "*",
+        [&](const Message& message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            received.push_back(message.messageId());
+            if (received.size() == 2) {
+                done.set_value();
+            }
+        },
+        Message::Direction::OUTGOING);
+
+    std::vector<std::string> batch = {
+        createEvent("Location", "1"), createEvent("Vehicle", "2"), createEvent("Location", "3")};
+    ASSERT_EQ(m_broker->publishBatch(batch, Message::Direction::OUTGOING, true), 2u);
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(received, std::vector<std::string>({"2", "3"}));
+}
+
+TEST_F(MessageBrokerImplTest, publishObjectWithoutSerializing) {
+    std::shared_ptr<const GetLocationMessage> received;
+    m_broker->subscribe(
+        "LocationProvider",
+        [&](const Message& message) {
+            received = message.as<GetLocationMessage>();
+            m_broker->publish(SAMPLE_REPLY).send();
+        },
+        Message::Direction::OUTGOING);
+
+    auto request = std::make_shared<GetLocationMessage>();
+    auto reply = m_broker->publish(request).get();
+    ASSERT_TRUE(reply.valid());
+    EXPECT_EQ(received, request) << "The subscriber should receive the published object";
+}
+
+static std::string createState(const std::string& id, const std::string& channel) {
+    return R"({"header":{"id":")" + id + R"(","messageType":"Publish","version":"4.0",)" +
+           R"("messageDescription":{"topic":"AudioOutput","action":"MediaPositionChanged"}},)" +
+           R"("payload":{"channel":")" + channel + R"("}})";
+}
+
+TEST_F(MessageBrokerImplTest, coalescingKeepsLatestPendingState) {
+    m_broker->setCoalescingPolicy("AudioOutput", "*", std::chrono::milliseconds(0));
+
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::promise<void> done;
+
+    // block the incoming lane, so the states queue behind the blocking message
+    m_broker->subscribe("Blocker", [released](const Message& message) { released.wait(); });
+    m_broker->subscribe("AudioOutput", [&](const Message& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(message.messageId());
+        if (message.messageId() == "5") {
+            done.set_value();
+        }
+    });
+
+    m_broker->publish(createEvent("Blocker", "0"), Message::Direction::INCOMING).send();
+    for (int i = 1; i <= 5; i++) {
+        m_broker->publish(createState(std::to_string(i), "Dialog"), Message::Direction::INCOMING).send();
+    }
+    release.set_value();
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(received, std::vector<std::string>({"5"}));
+}
+
+TEST_F(MessageBrokerImplTest, coalescingThrottlesStates) {
+    const auto minInterval = std::chrono::milliseconds(100);
+    m_broker->setCoalescingPolicy("AudioOutput", "MediaPositionChanged", minInterval);
+
+    std::mutex mutex;
+    std::vector<std::pair<std::string, std::chrono::steady_clock::time_point>> received;
+    std::promise<void> done;
+    m_broker->subscribe("AudioOutput", [&](const Message& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.emplace_back(message.messageId(), std::chrono::steady_clock::now());
+        if (message.messageId() == "3") {
+            done.set_value();
+        }
+    });
+
+    m_broker->publish(createState("1", "Dialog"), Message::Direction::INCOMING).send();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    m_broker->publish(createState("2", "Dialog"), Message::Direction::INCOMING).send();
+    m_broker->publish(createState("3", "Dialog"), Message::Direction::INCOMING).send();
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0].first, "1");
+    EXPECT_EQ(received[1].first, "3");
+    EXPECT_GE(received[1].second - received[0].second, minInterval - std::chrono::milliseconds(10));
+}
+
+TEST_F(MessageBrokerImplTest, coalescingPartitionsStates) {
+    m_broker->setCoalescingPolicy("AudioOutput", "*", std::chrono::milliseconds(1000), "/channel");
+
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::promise<void> done;
+    m_broker->subscribe("AudioOutput", [&](const Message& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(message.messageId());
+        if (received.size() == 2) {
+            done.set_value();
+        }
+    });
+
+    // each channel has its own interval
+    m_broker->publish(createState("1", "Dialog"), Message::Direction::INCOMING).send();
+    m_broker->publish(createState("2", "Content"), Message::Direction::INCOMING).send();
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    std::sort(received.begin(), received.end());
+    ASSERT_EQ(received, std::vector<std::string>({"1", "2"}));
+}
+
+TEST_F(MessageBrokerImplTest, topicPrioritiesDispatchHigherClassesFirst) {
+    using Priority = aace::engine::messageBroker::DispatchLane::Priority;
+    m_broker->setTopicPriorities({{"SpeechRecognizer", Priority::HIGH}, {"AddressBook", Priority::LOW}});
+
+    std::promise<void> started;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    m_broker->subscribe(
+        "Blocker",
+        [&started, released](const Message& message) {
+            started.set_value();
+            released.wait();
+        },
+        Message::Direction::OUTGOING);
+
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::promise<void> done;
+    m_broker->subscribe(
+        "*",
+        [&](const Message& message) {
+            if (message.topic() == "Blocker") {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            received.push_back(message.messageId());
+            if (received.size() == 5) {
+                done.set_value();
+            }
+        },
+        Message::Direction::OUTGOING);
+
+    // the messages wait behind the blocked message, then the speech recognizer messages are dispatched first
+    m_broker->publish(createEvent("Blocker", "blocker")).send();
+    ASSERT_EQ(started.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    m_broker->publish(createEvent("AddressBook", "bulk-1")).send();
+    m_broker->publish(createEvent("Navigation", "normal-1")).send();
+    m_broker->publish(createEvent("SpeechRecognizer", "voice-1")).send();
+    m_broker->publish(createEvent("AddressBook", "bulk-2")).send();
+    m_broker->publish(createEvent("SpeechRecognizer", "voice-2")).send();
+    release.set_value();
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(received, std::vector<std::string>({"voice-1", "voice-2", "normal-1", "bulk-1", "bulk-2"}));
+}
+
+TEST_F(MessageBrokerImplTest, boundedLaneShedsMessages) {
+    using OverflowPolicy = aace::engine::messageBroker::DispatchLane::OverflowPolicy;
+    m_broker->setDispatchQueueSize(0, 2, {{"Navigation", OverflowPolicy::COALESCE}});
+    m_broker->setMessageTimeout(std::chrono::seconds(5));
+
+    std::promise<void> started;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    m_broker->subscribe(
+        "Blocker",
+        [&started, released](const Message& message) {
+            started.set_value();
+            released.wait();
+        },
+        Message::Direction::OUTGOING);
+
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::promise<void> done;
+    m_broker->subscribe(
+        "Navigation",
+        [&](const Message& message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            received.push_back(message.messageId());
+            if (received.size() == 2) {
+                done.set_value();
+            }
+        },
+        Message::Direction::OUTGOING);
+    m_broker->subscribe("LocationProvider", [](const Message& message) {}, Message::Direction::OUTGOING);
+
+    m_broker->publish(createEvent("Blocker", "blocker")).send();
+    ASSERT_EQ(started.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    // the latest navigation state replaces the oldest, and the other topics are rejected
+    m_broker->publish(createEvent("Navigation", "nav-1")).send();
+    m_broker->publish(createEvent("Navigation", "nav-2")).send();
+    m_broker->publish(createEvent("Navigation", "nav-3")).send();
+    m_broker->publish(createEvent("AddressBook", "bulk-1")).send();
+
+    // a rejected request fails on its lane without waiting for its timeout
+    std::promise<void> failed;
+    m_broker->publish(createRequest("rejected")).error([&]() { failed.set_value(); }).send();
+
+    auto snapshot = m_broker->getMetricsSnapshot();
+    ASSERT_EQ(snapshot.outgoingLanes.size(), 1u);
+    EXPECT_EQ(snapshot.outgoingLanes[0].queueDepth, 3u);
+    EXPECT_EQ(snapshot.outgoingLanes[0].maxQueueDepth, 3u);
+    EXPECT_EQ(snapshot.outgoingLanes[0].coalesced, 1u);
+    EXPECT_EQ(snapshot.outgoingLanes[0].rejected, 2u);
+    release.set_value();
+    EXPECT_EQ(failed.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(received, std::vector<std::string>({"nav-2", "nav-3"}));
+}
+
+TEST_F(MessageBrokerImplTest, adaptiveTimeoutsFollowReplyLatency) {
+    aace::engine::messageBroker::ReplyLatencyTracker::Config config;
+    config.enabled = true;
+    config.minSamples = 4;
+    config.limits.minTimeout = std::chrono::milliseconds(20);
+    config.limits.maxTimeout = std::chrono::milliseconds(2000);
+    m_broker->setAdaptiveTimeouts(config);
+
+    std::mutex mutex;
+    std::vector<std::thread> replyThreads;
+    std::atomic<int> replyDelay{0};
+
+    // reply at once, or from another thread after a delay
+    m_broker->subscribe(
+        "LocationProvider",
+        [&](const Message& message) {
+            auto id = message.messageId();
+            if (replyDelay == 0) {
+                m_broker->publish(createReply(id), Message::Direction::INCOMING).send();
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            auto delay = std::chrono::milliseconds(replyDelay);
+            replyThreads.emplace_back([this, id, delay]() {
+                std::this_thread::sleep_for(delay);
+                m_broker->publish(createReply(id), Message::Direction::INCOMING).send();
+            });
+        },
+        Message::Direction::OUTGOING);
+
+    // the fast replies shorten the timeout to the shortest timeout
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(m_broker->publish(createRequest("fast-" + std::to_string(i))).get().valid());
+    }
+    auto stats = m_broker->getReplyLatencySnapshot();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].topic, "LocationProvider");
+    EXPECT_EQ(stats[0].action, "GetLocation");
+    EXPECT_EQ(stats[0].replies, 4u);
+    EXPECT_EQ(stats[0].timeout, std::chrono::milliseconds(20));
+
+    // a slow reply times out well before the default timeout, and raises the timeout
+    replyDelay = 100;
+    auto startTime = std::chrono::steady_clock::now();
+    EXPECT_FALSE(m_broker->publish(createRequest("slow")).get().valid());
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(100));
+    stats = m_broker->getReplyLatencySnapshot();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].timeouts, 1u);
+    EXPECT_EQ(stats[0].timeout, std::chrono::milliseconds(40));
+
+    // the timeout set by the publisher is kept
+    EXPECT_TRUE(
+        m_broker->publish(createRequest("explicit")).timeout(std::chrono::milliseconds(1000)).get().valid());
+
+    // the asynchronous requests use the adaptive timeout
+    std::promise<void> failed;
+    m_broker->publish(createRequest("async")).error([&]() { failed.set_value(); }).send();
+    EXPECT_EQ(failed.get_future().wait_for(std::chrono::milliseconds(90)), std::future_status::ready);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& next : replyThreads) {
+        next.join();
+    }
+}
+
+TEST_F(MessageBrokerImplTest, adaptiveTimeoutsApplyTopicLimits) {
+    aace::engine::messageBroker::ReplyLatencyTracker::Config config;
+    config.enabled = true;
+    config.minSamples = 1;
+    config.topicLimits["LocationProvider:GetLocation"] = {
+        std::chrono::milliseconds(300), std::chrono::milliseconds(400)};
+    m_broker->setAdaptiveTimeouts(config);
+
+    m_broker->subscribe(
+        "LocationProvider",
+        [&](const Message& message) {
+            m_broker->publish(createReply(message.messageId()), Message::Direction::INCOMING).send();
+        },
+        Message::Direction::OUTGOING);
+    EXPECT_TRUE(m_broker->publish(createRequest("first")).get().valid());
+
+    auto stats = m_broker->getReplyLatencySnapshot();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].timeout, std::chrono::milliseconds(300));
+}
@@ -0,0 +1,331 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// engine includes
+#include <AACE/Engine/MessageBroker/Message.h>
+#include <AACE/Engine/MessageBroker/PublishMessage.h>
+
+using aace::engine::messageBroker::Message;
+using aace::engine::messageBroker::PublishMessage;
+
+// count heap allocations so the tests can measure the allocations made per message
+static std::atomic<size_t> s_allocationCount{0};
+
+void* operator new(std::size_t size) {
+    s_allocationCount++;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+static auto SAMPLE_REPLY = R"({
+  "header": {
+    "id": "4c4d13b6-6a8d-445b-931a-a3feb0878311",
+    "messageType": "Reply",
+    "version": "4.0",
+    "messageDescription": {
+      "topic": "LocationProvider",
+      "action": "GetLocation",
+      "replyToId": "23b578ed-6dc3-460a-998e-1647ba6cde42"
+    }
+  },
+  "payload": {
+    "location": {
+      "latitude": 37.410,
+      "longitude": -122.025
+    }
+  }
+})";
+
+static auto SAMPLE_MALFORMED_PAYLOAD = R"({
+  "header": {
+    "id": "7e2c09e4-1d5f-4a84-a2e1-3f0f5c4b8a61",
+    "messageType": "Publish",
+    "version": "4.0",
+    "messageDescription": {
+        "topic": "Navigation",
+        "action": "NavigationEvent"
+    }
+  },
+  "payload": { "event": )";
+
+namespace {
+
+// messages in the shape of the generated AASB messages
+struct SetVolumeMessage {
+    struct Header {
+        std::string id = "a8b1c0de-5f4e-4c1b-9d3a-6b7e2f1a0c9d";
+    };
+    struct Payload {
+        int volume = 0;
+    };
+    static std::string topic() {
+        return "AlexaSpeaker";
+    }
+    static std::string action() {
+        return "SetVolume";
+    }
+    static std::string messageType() {
+        return "Publish";
+    }
+    Header header;
+    Payload payload;
+};
+
+struct SetVolumeMessageReply {
+    struct Header {
+        struct MessageDescription {
+            std::string replyToId;
+        };
+        std::string id = "0f6e9d4c-2b7a-4e3f-8c1d-5a9b8e7f6d5c";
+        MessageDescription messageDescription;
+    };
+    static std::string topic() {
+        return "AlexaSpeaker";
+    }
+    static std::string action() {
+        return "SetVolume";
+    }
+    static std::string messageType() {
+        return "Reply";
+    }
+    Header header;
+};
+
+void to_json(nlohmann::json& j, const SetVolumeMessage& c) {
+    j = nlohmann::json{
+        {"header",
+         {{"id", c.header.id},
+          {"messageType", c.messageType()},
+          {"version", "4.0"},
+          {"messageDescription", {{"topic", c.topic()}, {"action", c.action()}}}}},
+        {"payload", {{"volume", c.payload.volume}}},
+    };
+}
+
+void from_json(const nlohmann::json& j, SetVolumeMessage& c) {
+    j.at("header").at("id").get_to(c.header.id);
+    j.at("payload").at("volume").get_to(c.payload.volume);
+}
+
+void to_json(nlohmann::json& j, const SetVolumeMessageReply& c) {
+    j = nlohmann::json{
+        {"header",
+         {{"id", c.header.id},
+          {"messageType", c.messageType()},
+          {"version", "4.0"},
+          {"messageDescription",
+           {{"topic", c.topic()}, {"action", c.action()}, {"replyToId", c.header.messageDescription.replyToId}}}}},
+    };
+}
+
+}  // namespace
+
+TEST(MessageTest, fullParseReadsHeader) {
+    Message message(SAMPLE_REPLY, Message::Direction::OUTGOING);
+    ASSERT_TRUE(message.valid());
+    EXPECT_EQ(message.messageType(), Message::MessageType::REPLY);
+    EXPECT_EQ(message.messageId(), "4c4d13b6-6a8d-445b-931a-a3feb0878311");
+    EXPECT_EQ(message.topic(), "LocationProvider");
+    EXPECT_EQ(message.action(), "GetLocation");
+    EXPECT_EQ(message.replyTo(), "23b578ed-6dc3-460a-998e-1647ba6cde42");
+}
+
+TEST(MessageTest, lazyParseReadsHeader) {
+    Message message(SAMPLE_REPLY, Message::Direction::OUTGOING, Message::ParseMode::LAZY);
+    ASSERT_TRUE(message.valid());
+    EXPECT_EQ(message.messageType(), Message::MessageType::REPLY);
+    EXPECT_EQ(message.messageId(), "4c4d13b6-6a8d-445b-931a-a3feb0878311");
+    EXPECT_EQ(message.topic(), "LocationProvider");
+    EXPECT_EQ(message.action(), "GetLocation");
+    EXPECT_EQ(message.replyTo(), "23b578ed-6dc3-460a-998e-1647ba6cde42");
+}
+
+TEST(MessageTest, lazyParsePayloadMatchesFullParse) {
+    Message full(SAMPLE_REPLY, Message::Direction::OUTGOING);
+    Message lazy(SAMPLE_REPLY, Message::Direction::OUTGOING, Message::ParseMode::LAZY);
+
+    EXPECT_EQ(lazy.payloadJson()["location"]["latitude"], 37.410);
+    EXPECT_EQ(lazy.payload(), full.payload());
+    EXPECT_EQ(lazy.str(), full.str());
+}
+
+TEST(MessageTest, lazyParseDefersPayloadParsing) {
+    Message full(SAMPLE_MALFORMED_PAYLOAD, Message::Direction::INCOMING);
+    EXPECT_FALSE(full.valid());
+
+    Message lazy(SAMPLE_MALFORMED_PAYLOAD, Message::Direction::INCOMING, Message::ParseMode::LAZY);
+    ASSERT_TRUE(lazy.valid());
+    EXPECT_EQ(lazy.topic(), "Navigation");
+    EXPECT_EQ(lazy.action(), "NavigationEvent");
+    EXPECT_TRUE(lazy.payload().empty());
+}
+
+TEST(MessageTest, lazyParseRejectsInvalidHeader) {
+    EXPECT_FALSE(Message("{}", Message::Direction::OUTGOING, Message::ParseMode::LAZY).valid());
+    EXPECT_FALSE(Message("not json", Message::Direction::OUTGOING, Message::ParseMode::LAZY).valid());
+    EXPECT_FALSE(Message(
+                     R"({"header":{"id":"1","messageType":"Publish","messageDescription":{"topic":"Test"}}})",
+                     Message::Direction::OUTGOING,
+                     Message::ParseMode::LAZY)
+                     .valid());
+}
+
+TEST(MessageTest, lazyParseSkipsFieldsBeforeHeader) {
+    Message lazy(
+        R"({"payload":{"items":[{"name":"a\"}"},[1,2.5e3,true,null]]},)"
+        R"("header":{"version":"4.0","id":"1","messageDescription":{"topic":"Test\u00e9","action":"Event"},)"
+        R"("messageType":"Publish"}})",
+        Message::Direction::OUTGOING,
+        Message::ParseMode::LAZY);
+    ASSERT_TRUE(lazy.valid());
+    EXPECT_EQ(lazy.messageId(), "1");
+    EXPECT_EQ(lazy.topic(), "Test\xc3\xa9");
+    EXPECT_EQ(lazy.action(), "Event");
+    EXPECT_EQ(lazy.payloadJson()["items"][0]["name"], "a\"}");
+}
+
+TEST(MessageTest, compactSerialization) {
+    Message::setSerializationFormat(Message::SerializationFormat::COMPACT);
+
+    // messages forward the original message text
+    Message full(SAMPLE_REPLY, Message::Direction::OUTGOING);
+    EXPECT_EQ(full.str(), SAMPLE_REPLY);
+    EXPECT_EQ(full.payload(), R"({"location":{"latitude":37.41,"longitude":-122.025}})");
+
+    Message lazy(SAMPLE_REPLY, Message::Direction::OUTGOING, Message::ParseMode::LAZY);
+    EXPECT_EQ(lazy.str(), SAMPLE_REPLY);
+    EXPECT_EQ(lazy.str(Message::SerializationFormat::PRETTY), nlohmann::json::parse(SAMPLE_REPLY).dump(3));
+
+    Message::setSerializationFormat(Message::SerializationFormat::PRETTY);
+    EXPECT_EQ(lazy.str(), nlohmann::json::parse(SAMPLE_REPLY).dump(3));
+}
+
+TEST(MessageTest, binaryEncodesMessageDocument) {
+    Message message(SAMPLE_REPLY, Message::Direction::OUTGOING, Message::ParseMode::LAZY);
+    auto binary = message.binary();
+    ASSERT_FALSE(binary.empty());
+    EXPECT_LT(binary.size(), std::string(SAMPLE_REPLY).size());
+    EXPECT_EQ(nlohmann::json::from_cbor(binary), nlohmann::json::parse(SAMPLE_REPLY));
+
+    EXPECT_TRUE(Message::INVALID.binary().empty());
+}
+
+TEST(MessageTest, objectMessagePassesObject) {
+    auto object = std::make_shared<SetVolumeMessage>();
+    object->payload.volume = 7;
+    auto message = Message::fromObject<SetVolumeMessage>(object, Message::Direction::INCOMING);
+    ASSERT_TRUE(message.valid());
+    EXPECT_EQ(message.messageType(), Message::MessageType::PUBLISH);
+    EXPECT_EQ(message.messageId(), object->header.id);
+    EXPECT_EQ(message.topic(), "AlexaSpeaker");
+    EXPECT_EQ(message.action(), "SetVolume");
+
+    // the subscribers get the published object, and the text is only created when it is read
+    EXPECT_EQ(message.as<SetVolumeMessage>(), object);
+    EXPECT_EQ(nlohmann::json::parse(message.payload()), nlohmann::json::parse(R"({"volume":7})"));
+    EXPECT_EQ(nlohmann::json::parse(message.raw()), nlohmann::json(*object));
+    EXPECT_EQ(message.str(Message::SerializationFormat::COMPACT), message.raw());
+}
+
+TEST(MessageTest, objectReplyReadsReplyTo) {
+    auto object = std::make_shared<SetVolumeMessageReply>();
+    auto message = Message::fromObject<SetVolumeMessageReply>(object, Message::Direction::INCOMING);
+    EXPECT_FALSE(message.valid()) << "A reply requires the id of the message it replies to";
+
+    object = std::make_shared<SetVolumeMessageReply>();
+    object->header.messageDescription.replyToId = "a8b1c0de-5f4e-4c1b-9d3a-6b7e2f1a0c9d";
+    message = Message::fromObject<SetVolumeMessageReply>(object, Message::Direction::INCOMING);
+    ASSERT_TRUE(message.valid());
+    EXPECT_EQ(message.messageType(), Message::MessageType::REPLY);
+    EXPECT_EQ(message.replyTo(), "a8b1c0de-5f4e-4c1b-9d3a-6b7e2f1a0c9d");
+}
+
+TEST(MessageTest, textMessageConvertsToObject) {
+    SetVolumeMessage object;
+    object.payload.volume = 3;
+    Message message(nlohmann::json(object).dump(), Message::Direction::INCOMING, Message::ParseMode::LAZY);
+
+    auto converted = message.as<SetVolumeMessage>();
+    ASSERT_NE(converted, nullptr);
+    EXPECT_EQ(converted->header.id, object.header.id);
+    EXPECT_EQ(converted->payload.volume, 3);
+}
+
+TEST(MessageTest, copiesShareMessageEnvelope) {
+    Message message(SAMPLE_REPLY, Message::Direction::OUTGOING, Message::ParseMode::LAZY);
+    ASSERT_TRUE(message.valid());
+
+    const size_t count = 1000;
+    auto allocations = s_allocationCount.load();
+    for (size_t i = 0; i < count; i++) {
+        Message copy(message);
+        ASSERT_EQ(&copy.raw(), &message.raw());
+        ASSERT_EQ(&copy.topic(), &message.topic());
+    }
+    auto allocationsPerCopy = static_cast<double>(s_allocationCount.load() - allocations) / count;
+
+    // copying the message previously copied the message text and four header strings
+    RecordProperty("allocationsPerCopy", std::to_string(allocationsPerCopy));
+    EXPECT_EQ(allocationsPerCopy, 0);
+}
+
+TEST(MessageTest, publishMessageParsesMessageOnce) {
+    PublishMessage pm(
+        Message::Direction::OUTGOING,
+        SAMPLE_REPLY,
+        std::chrono::milliseconds(500),
+        [](const PublishMessage& pm, bool sync) { return Message::INVALID; });
+
+    auto& message = pm.message();
+    ASSERT_TRUE(message.valid());
+
+    auto allocations = s_allocationCount.load();
+    for (size_t i = 0; i < 1000; i++) {
+        auto next = pm.message();
+        ASSERT_EQ(next.messageId(), message.messageId());
+    }
+    EXPECT_EQ(s_allocationCount.load(), allocations);
+
+    // the payload is parsed once and shared by all copies of the message
+    PublishMessage copy(pm);
+    EXPECT_EQ(&copy.message().payloadJson(), &message.payloadJson());
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/MessageBroker/MessageBrokerImpl.h>
+#include <AACE/Engine/MessageBroker/MessageTrafficRecorder.h>
+#include <AACE/Engine/MessageBroker/MessageTrafficReplayer.h>
+
+using namespace aace::engine::messageBroker;
+using RecordType = MessageTrafficRecorder::RecordType;
+
+/// A stream which reads back the data written to it
+class LoopbackStream : public aace::core::MessageStream {
+public:
+    ssize_t read(char* data, const size_t size) override {
+        auto count = std::min(size, m_data.size());
+        std::copy(m_data.begin(), m_data.begin() + count, data);
+        m_data.erase(0, count);
+        return count;
+    }
+    ssize_t write(const char* data, const size_t size) override {
+        m_data.append(data, size);
+        return size;
+    }
+    bool isClosed() override {
+        return false;
+    }
+    Mode getMode() override {
+        return Mode::READ_WRITE;
+    }
+
+private:
+    std::string m_data;
+};
+
+/// Test harness for @c MessageTrafficRecorder and @c MessageTrafficReplayer classes
+class MessageTrafficRecorderTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_path = ::testing::TempDir() + "MessageTrafficRecorderTest.trace";
+        m_broker = MessageBrokerImpl::create();
+    }
+
+    void TearDown() override {
+        m_broker->shutdown();
+        std::remove(m_path.c_str());
+    }
+
+protected:
+    static std::string createEvent(const std::string& topic, const std::string& action) {
+        return R"({"header":{"id":"id-)" + topic + "-" + action + R"(","messageType":"Publish","version":"4.0",)" +
+               R"("messageDescription":{"topic":")" + topic + R"(","action":")" + action + R"("}}})";
+    }
+
+    std::vector<MessageTrafficRecorder::Record> readRecords() {
+        std::vector<MessageTrafficRecorder::Record> records;
+        auto reader = MessageTrafficRecorder::Reader::open(m_path);
+        EXPECT_NE(reader, nullptr);
+        MessageTrafficRecorder::Record record;
+        while (reader != nullptr && reader->next(record)) {
+            records.push_back(record);
+        }
+        return records;
+    }
+
+    std::string m_path;
+    std::shared_ptr<MessageBrokerImpl> m_broker;
+};
+
+TEST_F(MessageTrafficRecorderTest, recordsPublishedMessages) {
+    auto recorder = MessageTrafficRecorder::create(m_path);
+    ASSERT_NE(recorder, nullptr);
+    m_broker->setTrafficRecorder(recorder);
+
+    m_broker->publish(createEvent("SpeechRecognizer", "StartCapture"), Message::Direction::INCOMING).send();
+    m_broker->publish(createEvent("SpeechRecognizer", "EndOfSpeechDetected"), Message::Direction::OUTGOING).send();
+    m_broker->publishBatch({createEvent("Navigation", "GetNavigationState")}, Message::Direction::INCOMING);
+    recorder->close();
+
+    auto records = readRecords();
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].type, RecordType::INCOMING_MESSAGE);
+    EXPECT_EQ(records[1].type, RecordType::OUTGOING_MESSAGE);
+    EXPECT_EQ(records[2].type, RecordType::INCOMING_MESSAGE);
+    EXPECT_LE(records[0].timestamp, records[1].timestamp);
+    EXPECT_TRUE(records[0].streamId.empty());
+
+    Message message(records[1].data, Message::Direction::OUTGOING);
+    EXPECT_EQ(message.topic(), "SpeechRecognizer");
+    EXPECT_EQ(message.action(), "EndOfSpeechDetected");
+}
+
+TEST_F(MessageTrafficRecorderTest, recordsStreamData) {
+    auto recorder = MessageTrafficRecorder::create(m_path, true);
+    ASSERT_NE(recorder, nullptr);
+    auto stream = recorder->wrapStream("audio-1", std::make_shared<LoopbackStream>());
+
+    char buffer[4];
+    EXPECT_EQ(stream->write("abcdef", 6), 6);
+    EXPECT_EQ(stream->read(buffer, sizeof(buffer)), 4);
+    recorder->close();
+
+    auto records = readRecords();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].type, RecordType::STREAM_WRITE);
+    EXPECT_EQ(records[0].streamId, "audio-1");
+    EXPECT_EQ(records[0].data, "abcdef");
+    EXPECT_EQ(records[1].type, RecordType::STREAM_READ);
+    EXPECT_EQ(records[1].data, "abcd");
+}
+
+TEST_F(MessageTrafficRecorderTest, replaysIncomingMessages) {
+    auto recorder = MessageTrafficRecorder::create(m_path);
+    ASSERT_NE(recorder, nullptr);
+    m_broker->setTrafficRecorder(recorder);
+    for (int i = 0; i < 3; i++) {
+        m_broker->publish(createEvent("AudioInput", "StartAudioInput"), Message::Direction::INCOMING).send();
+        m_broker->publish(createEvent("AudioInput", "StopAudioInput"), Message::Direction::OUTGOING).send();
+    }
+    m_broker->setTrafficRecorder(nullptr);
+    recorder->close();
+
+    auto target = MessageBrokerImpl::create();
+    auto broker = target.get();
+    std::atomic<int> received{0};
+    target->subscribe(
+        "AudioInput",
+        [&received, broker](const Message& message) {
+            received++;
+            broker->publish(createEvent("AudioInput", "StopAudioInput"), Message::Direction::OUTGOING).send();
+        },
+        Message::Direction::INCOMING);
+
+    auto replayer = MessageTrafficReplayer::create(target, m_path, 0);
+    ASSERT_NE(replayer, nullptr);
+    EXPECT_TRUE(replayer->replay());
+    EXPECT_FALSE(replayer->replay());
+    EXPECT_EQ(received, 3);
+
+    auto report = replayer->getReport();
+    EXPECT_EQ(report.replayedMessages, 3u);
+    EXPECT_EQ(report.skippedRecords, 3u);
+    ASSERT_EQ(report.metrics.topics.size(), 2u);
+    for (auto& next : report.metrics.topics) {
+        EXPECT_EQ(next.topic, "AudioInput");
+        EXPECT_EQ(next.samples, 3u);
+        EXPECT_EQ(next.handlerCpuTime.count, 3u);
+    }
+    EXPECT_EQ(target->getMetricsSampleInterval(), 0u);
+
+    auto reportPath = m_path + ".json";
+    EXPECT_TRUE(replayer->writeReport(reportPath));
+    std::ifstream reportFile(reportPath);
+    EXPECT_TRUE(reportFile.good());
+    std::remove(reportPath.c_str());
+    target->shutdown();
+}
+
+TEST_F(MessageTrafficRecorderTest, rejectsInvalidRecording) {
+    {
+        std::ofstream file(m_path);
+        file << "not a recording";
+    }
+    EXPECT_EQ(MessageTrafficRecorder::Reader::open(m_path), nullptr);
+    EXPECT_EQ(MessageTrafficReplayer::create(m_broker, m_path), nullptr);
+    EXPECT_EQ(MessageTrafficReplayer::create(m_broker, m_path + ".missing"), nullptr);
+}
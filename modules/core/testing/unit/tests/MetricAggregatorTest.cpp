@@ -0,0 +1,136 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Metrics/MetricAggregator.h>
+
+using aace::engine::metrics::MetricAggregator;
+
+TEST(MetricAggregatorTest, disabledAggregatorDoesNotAggregate) {
+    auto aggregator = MetricAggregator::create();
+    ASSERT_NE(aggregator, nullptr);
+    EXPECT_FALSE(aggregator->isEnabled());
+    EXPECT_FALSE(aggregator->addCounter("program", "source", "counter", 1));
+    EXPECT_FALSE(aggregator->addTimer("program", "source", "timer", 10));
+    EXPECT_TRUE(aggregator->collect().empty());
+}
+
+TEST(MetricAggregatorTest, sumsCountersByProgramAndSource) {
+    auto aggregator = MetricAggregator::create();
+    ASSERT_NE(aggregator, nullptr);
+    aggregator->setFlushInterval(std::chrono::hours(1));
+    ASSERT_TRUE(aggregator->isEnabled());
+
+    EXPECT_TRUE(aggregator->addCounter("program", "source1", "counter", 1));
+    EXPECT_TRUE(aggregator->addCounter("program", "source1", "counter", 2));
+    EXPECT_TRUE(aggregator->addCounter("program", "source1", "other", 5));
+    EXPECT_TRUE(aggregator->addCounter("program", "source2", "counter", 1));
+
+    auto metrics = aggregator->collect();
+    ASSERT_EQ(metrics.size(), 2u);
+    EXPECT_EQ(metrics[0].program, "program");
+    EXPECT_EQ(metrics[0].source, "source1");
+    ASSERT_EQ(metrics[0].counters.size(), 2u);
+    EXPECT_EQ(metrics[0].counters[0].name, "counter");
+    EXPECT_EQ(metrics[0].counters[0].sum, 3);
+    EXPECT_EQ(metrics[0].counters[0].sampleCount, 2u);
+    EXPECT_EQ(metrics[0].counters[1].name, "other");
+    EXPECT_EQ(metrics[0].counters[1].sum, 5);
+    EXPECT_EQ(metrics[1].source, "source2");
+    EXPECT_EQ(metrics[1].counters[0].sampleCount, 1u);
+
+    // the collected datapoints are cleared
+    EXPECT_TRUE(aggregator->collect().empty());
+    aggregator->setFlushInterval(std::chrono::milliseconds::zero());
+}
+
+TEST(MetricAggregatorTest, countsTimersInHistogramBuckets) {
+    auto aggregator = MetricAggregator::create();
+    ASSERT_NE(aggregator, nullptr);
+    aggregator->setFlushInterval(std::chrono::hours(1));
+
+    for (int j = 0; j < 3; j++) {
+        aggregator->addTimer("program", "source", "timer", 100);
+    }
+    aggregator->addTimer("program", "source", "timer", 101);
+    aggregator->addTimer("program", "source", "timer", 1000);
+
+    auto metrics = aggregator->collect();
+    ASSERT_EQ(metrics.size(), 1u);
+    ASSERT_EQ(metrics[0].timers.size(), 2u);
+    EXPECT_EQ(metrics[0].timers[0].name, "timer");
+    EXPECT_EQ(metrics[0].timers[0].sampleCount, 4u);
+    EXPECT_NEAR(metrics[0].timers[0].value, 100, 7);
+    EXPECT_EQ(metrics[0].timers[1].sampleCount, 1u);
+    EXPECT_NEAR(metrics[0].timers[1].value, 1000, 70);
+    aggregator->setFlushInterval(std::chrono::milliseconds::zero());
+}
+
+TEST(MetricAggregatorTest, timerBucketsKeepValuesWithinSevenPercent) {
+    uint32_t previous = 0;
+    for (double value = 0; value < 1e7; value = std::max(value + 1, value * 1.01)) {
+        auto bucket = MetricAggregator::getTimerBucket(value);
+        EXPECT_GE(bucket, previous);
+        previous = bucket;
+        EXPECT_LE(std::abs(MetricAggregator::getTimerBucketValue(bucket) - std::round(value)), 0.07 * value + 0.5);
+    }
+    EXPECT_EQ(MetricAggregator::getTimerBucket(-1), 0u);
+    EXPECT_EQ(MetricAggregator::getTimerBucket(std::nan("")), 0u);
+}
+
+TEST(MetricAggregatorTest, mergesDatapointsOfAllThreads) {
+    auto aggregator = MetricAggregator::create();
+    ASSERT_NE(aggregator, nullptr);
+    aggregator->setFlushInterval(std::chrono::hours(1));
+
+    std::vector<std::thread> threads;
+    for (int j = 0; j < 8; j++) {
+        threads.emplace_back([aggregator]() {
+            for (int k = 0; k < 1000; k++) {
+                aggregator->addCounter("program", "source", "counter", 1);
+                aggregator->addTimer("program", "source", "timer", 5);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto metrics = aggregator->collect();
+    ASSERT_EQ(metrics.size(), 1u);
+    ASSERT_EQ(metrics[0].counters.size(), 1u);
+    EXPECT_EQ(metrics[0].counters[0].sum, 8000);
+    EXPECT_EQ(metrics[0].counters[0].sampleCount, 8000u);
+    ASSERT_EQ(metrics[0].timers.size(), 1u);
+    EXPECT_EQ(metrics[0].timers[0].value, 5);
+    EXPECT_EQ(metrics[0].timers[0].sampleCount, 8000u);
+    aggregator->setFlushInterval(std::chrono::milliseconds::zero());
+}
+
+TEST(MetricAggregatorTest, disablingAggregationFlushesDatapoints) {
+    auto aggregator = MetricAggregator::create();
+    ASSERT_NE(aggregator, nullptr);
+    aggregator->setFlushInterval(std::chrono::hours(1));
+    EXPECT_EQ(aggregator->getFlushInterval(), std::chrono::hours(1));
+    aggregator->addCounter("program", "source", "counter", 1);
+
+    aggregator->setFlushInterval(std::chrono::milliseconds::zero());
+    EXPECT_FALSE(aggregator->isEnabled());
+    EXPECT_TRUE(aggregator->collect().empty());
+}
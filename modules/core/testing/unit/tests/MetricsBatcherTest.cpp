@@ -0,0 +1,213 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/Metrics/MetricsBatcher.h>
+#include <AACE/Test/Unit/Storage/InMemoryLocalStorage.h>
+
+using aace::engine::metrics::MetricsBatcher;
+using aace::engine::network::BackgroundTransferScheduler;
+using aace::metrics::MetricsUploader;
+using aace::test::unit::storage::InMemoryLocalStorage;
+using NetworkStatus = aace::engine::network::NetworkInfoObserver::NetworkStatus;
+
+/// Records the names of the metrics it is given
+class TestMetricsUploader : public MetricsUploader {
+public:
+    bool record(
+        const std::vector<Datapoint>& datapoints,
+        const std::unordered_map<std::string, std::string>& metadata,
+        bool buffer,
+        bool unique) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_names.push_back(metadata.at("Source"));
+        m_recorded.notify_all();
+        return true;
+    }
+
+    std::vector<std::string> getNames() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_names;
+    }
+
+    bool waitForCount(size_t count, std::chrono::milliseconds timeout = std::chrono::seconds(2)) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_recorded.wait_for(lock, timeout, [this, count]() { return m_names.size() >= count; });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_recorded;
+    std::vector<std::string> m_names;
+};
+
+/// Returns a metric with a counter, identified by its source.
+static MetricsBatcher::Metric createMetric(const std::string& source) {
+    return {{MetricsUploader::Datapoint(MetricsUploader::DatapointType::COUNTER, "counter", "1", 1)},
+            {{"Program", "program"}, {"Source", source}, {"Priority", "NR"}},
+            false,
+            false};
+}
+
+class MetricsBatcherTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_uploader = std::make_shared<TestMetricsUploader>();
+        m_storage = std::make_shared<InMemoryLocalStorage>();
+        m_configuration.maxBatchSize = 3;
+        m_configuration.maxBatchDelay = std::chrono::hours(1);
+        m_configuration.maxSpooledBatches = 2;
+        m_configuration.drainInterval = std::chrono::milliseconds(10);
+    }
+
+protected:
+    std::shared_ptr<TestMetricsUploader> m_uploader;
+    std::shared_ptr<InMemoryLocalStorage> m_storage;
+    MetricsBatcher::Configuration m_configuration;
+};
+
+TEST_F(MetricsBatcherTest, createWithInvalidParametersShouldFail) {
+    EXPECT_EQ(MetricsBatcher::create(nullptr, m_configuration), nullptr);
+    m_configuration.maxBatchSize = 0;
+    EXPECT_EQ(MetricsBatcher::create(m_uploader, m_configuration), nullptr);
+}
+
+TEST_F(MetricsBatcherTest, sendsFullBatches) {
+    auto batcher = MetricsBatcher::create(m_uploader, m_configuration);
+    ASSERT_NE(batcher, nullptr);
+    batcher->add(createMetric("1"));
+    batcher->add(createMetric("2"));
+    EXPECT_FALSE(m_uploader->waitForCount(1, std::chrono::milliseconds(50)));
+
+    batcher->add(createMetric("3"));
+    ASSERT_TRUE(m_uploader->waitForCount(3));
+    EXPECT_EQ(m_uploader->getNames(), std::vector<std::string>({"1", "2", "3"}));
+    batcher->shutdown();
+}
+
+TEST_F(MetricsBatcherTest, sendsBatchAfterMaxDelay) {
+    m_configuration.maxBatchDelay = std::chrono::milliseconds(20);
+    auto batcher = MetricsBatcher::create(m_uploader, m_configuration);
+    ASSERT_NE(batcher, nullptr);
+    batcher->add(createMetric("1"));
+    EXPECT_TRUE(m_uploader->waitForCount(1));
+    batcher->shutdown();
+}
+
+TEST_F(MetricsBatcherTest, spoolsBatchesWhileDisconnectedAndDrainsThemInOrder) {
+    auto batcher = MetricsBatcher::create(m_uploader, m_configuration);
+    ASSERT_NE(batcher, nullptr);
+    batcher->setLocalStorage(m_storage, NetworkStatus::DISCONNECTED);
+
+    for (int j = 0; j < 3; j++) {
+        batcher->add(createMetric(std::to_string(j)));
+    }
+    batcher->flush();
+    EXPECT_EQ(batcher->getSpooledBatchCount(), 1u);
+    EXPECT_EQ(m_storage->keys(MetricsBatcher::SPOOL_TABLE).size(), 1u);
+    EXPECT_TRUE(m_uploader->getNames().empty());
+
+    batcher->add(createMetric("3"));
+    batcher->onNetworkInfoChanged(NetworkStatus::CONNECTED, 0);
+    ASSERT_TRUE(m_uploader->waitForCount(3));
+    batcher->flush();
+    ASSERT_TRUE(m_uploader->waitForCount(4));
+    EXPECT_EQ(m_uploader->getNames(), std::vector<std::string>({"0", "1", "2", "3"}));
+    EXPECT_EQ(batcher->getSpooledBatchCount(), 0u);
+    EXPECT_TRUE(m_storage->keys(MetricsBatcher::SPOOL_TABLE).empty());
+    batcher->shutdown();
+}
+
+TEST_F(MetricsBatcherTest, dropsOldestSpooledBatches) {
+    m_configuration.maxBatchSize = 1;
+    auto batcher = MetricsBatcher::create(m_uploader, m_configuration);
+    ASSERT_NE(batcher, nullptr);
+    batcher->setLocalStorage(m_storage, NetworkStatus::DISCONNECTED);
+    for (int j = 0; j < 4; j++) {
+        batcher->add(createMetric(std::to_string(j)));
+    }
+    batcher->flush();
+    EXPECT_EQ(batcher->getSpooledBatchCount(), 2u);
+
+    batcher->onNetworkInfoChanged(NetworkStatus::CONNECTED, 0);
+    ASSERT_TRUE(m_uploader->waitForCount(2));
+    EXPECT_EQ(m_uploader->getNames(), std::vector<std::string>({"2", "3"}));
+    batcher->shutdown();
+}
+
+TEST_F(MetricsBatcherTest, drainsSpooledBatchesThroughBackgroundTransferScheduler) {
+    auto scheduler = BackgroundTransferScheduler::create(BackgroundTransferScheduler::Configuration());
+    ASSERT_NE(scheduler, nullptr);
+    scheduler->setVoiceActive(true);
+    auto batcher = MetricsBatcher::create(m_uploader, m_configuration);
+    ASSERT_NE(batcher, nullptr);
+    batcher->setBackgroundTransferScheduler(scheduler);
+    batcher->setLocalStorage(m_storage, NetworkStatus::DISCONNECTED);
+    batcher->add(createMetric("1"));
+    batcher->flush();
+
+    // the spooled batch waits for the end of the voice interaction
+    batcher->onNetworkInfoChanged(NetworkStatus::CONNECTED, 0);
+    EXPECT_FALSE(m_uploader->waitForCount(1, std::chrono::milliseconds(100)));
+    EXPECT_EQ(scheduler->getPendingTransferCount(), 1u);
+    scheduler->setVoiceActive(false);
+    ASSERT_TRUE(m_uploader->waitForCount(1));
+    batcher->shutdown();
+    scheduler->shutdown();
+}
+
+TEST_F(MetricsBatcherTest, sendsBatchesSpooledByPreviousBatcher) {
+    auto batcher = MetricsBatcher::create(m_uploader, m_configuration);
+    ASSERT_NE(batcher, nullptr);
+    batcher->setLocalStorage(m_storage, NetworkStatus::DISCONNECTED);
+    batcher->add(createMetric("1"));
+    batcher->shutdown();
+    batcher.reset();
+    EXPECT_EQ(m_storage->keys(MetricsBatcher::SPOOL_TABLE).size(), 1u);
+
+    batcher = MetricsBatcher::create(m_uploader, m_configuration);
+    ASSERT_NE(batcher, nullptr);
+    batcher->setLocalStorage(m_storage, NetworkStatus::CONNECTED);
+    ASSERT_TRUE(m_uploader->waitForCount(1));
+    EXPECT_EQ(m_uploader->getNames(), std::vector<std::string>({"1"}));
+    batcher->shutdown();
+}
+
+TEST_F(MetricsBatcherTest, serializeShouldRoundTrip) {
+    std::vector<MetricsBatcher::Metric> batch = {createMetric("1"), createMetric("2")};
+    batch[1].datapoints.emplace_back(MetricsUploader::DatapointType::TIMER, "timer", "12.5", 3);
+    batch[1].unique = true;
+
+    std::vector<MetricsBatcher::Metric> deserialized;
+    ASSERT_TRUE(MetricsBatcher::deserialize(MetricsBatcher::serialize(batch), deserialized));
+    ASSERT_EQ(deserialized.size(), 2u);
+    EXPECT_EQ(deserialized[1].metadata, batch[1].metadata);
+    EXPECT_TRUE(deserialized[1].unique);
+    EXPECT_FALSE(deserialized[1].buffer);
+    ASSERT_EQ(deserialized[1].datapoints.size(), 2u);
+    EXPECT_EQ(deserialized[1].datapoints[1].getType(), MetricsUploader::DatapointType::TIMER);
+    EXPECT_EQ(deserialized[1].datapoints[1].getName(), "timer");
+    EXPECT_EQ(deserialized[1].datapoints[1].getValue(), "12.5");
+    EXPECT_EQ(deserialized[1].datapoints[1].getCount(), 3);
+
+    EXPECT_FALSE(MetricsBatcher::deserialize("not json", deserialized));
+    EXPECT_FALSE(MetricsBatcher::deserialize("[[1]]", deserialized));
+}
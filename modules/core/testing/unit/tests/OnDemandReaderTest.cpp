@@ -0,0 +1,131 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/Utils/JSON/OnDemandReader.h>
+
+using aace::engine::utils::json::OnDemandReader;
+
+TEST(OnDemandReaderTest, readsFieldsOfNestedObjects) {
+    OnDemandReader reader(R"( { "a" : "x", "b" : { "c" : "y" }, "d" : "z" } )");
+    std::string key;
+    std::string value;
+
+    ASSERT_TRUE(reader.enterObject());
+    ASSERT_TRUE(reader.nextField(key));
+    EXPECT_EQ(key, "a");
+    ASSERT_TRUE(reader.readString(value));
+    EXPECT_EQ(value, "x");
+
+    ASSERT_TRUE(reader.nextField(key));
+    EXPECT_EQ(key, "b");
+    ASSERT_TRUE(reader.enterObject());
+    ASSERT_TRUE(reader.nextField(key));
+    EXPECT_EQ(key, "c");
+    ASSERT_TRUE(reader.readString(value));
+    EXPECT_EQ(value, "y");
+    EXPECT_FALSE(reader.nextField(key));
+
+    ASSERT_TRUE(reader.nextField(key));
+    EXPECT_EQ(key, "d");
+    EXPECT_FALSE(reader.nextField(key));
+    EXPECT_FALSE(reader.failed());
+}
+
+TEST(OnDemandReaderTest, skipsValuesThatAreNotRead) {
+    OnDemandReader reader(
+        R"({"object":{"a":[1,{"b":"]}"}],"c":null},"array":[[],{}],"number":-1.5e-3,"true":true,"false":false,)"
+        R"("string":"\"}","last":"value"})");
+    std::string key;
+    std::vector<std::string> keys;
+    std::string value;
+
+    ASSERT_TRUE(reader.enterObject());
+    while (reader.nextField(key)) {
+        keys.push_back(key);
+        if (key == "last") {
+            ASSERT_TRUE(reader.readString(value));
+        }
+    }
+    EXPECT_FALSE(reader.failed()) << reader.error();
+    EXPECT_EQ(keys, (std::vector<std::string>{"object", "array", "number", "true", "false", "string", "last"}));
+    EXPECT_EQ(value, "value");
+}
+
+TEST(OnDemandReaderTest, leavesValuesOfOtherTypes) {
+    OnDemandReader reader(R"({"a":42,"b":"x"})");
+    std::string key;
+    std::string value;
+
+    ASSERT_TRUE(reader.enterObject());
+    ASSERT_TRUE(reader.nextField(key));
+    EXPECT_FALSE(reader.readString(value));
+    EXPECT_FALSE(reader.enterObject());
+    ASSERT_TRUE(reader.nextField(key));
+    EXPECT_EQ(key, "b");
+    EXPECT_TRUE(reader.readString(value));
+    EXPECT_FALSE(reader.failed());
+}
+
+TEST(OnDemandReaderTest, skipsDeepValues) {
+    auto depth = OnDemandReader::MAX_DEPTH * 2;
+    auto text = R"({"deep":)" + std::string(depth, '[') + std::string(depth, ']') + R"(,"last":"value"})";
+    OnDemandReader reader(text);
+    std::string key;
+    std::string value;
+
+    ASSERT_TRUE(reader.enterObject());
+    ASSERT_TRUE(reader.nextField(key));
+    ASSERT_TRUE(reader.nextField(key));
+    EXPECT_EQ(key, "last");
+    EXPECT_TRUE(reader.readString(value));
+    EXPECT_FALSE(reader.failed()) << reader.error();
+}
+
+TEST(OnDemandReaderTest, decodesEscapes) {
+    OnDemandReader reader(R"("a\"b\\c\/d\n\t\u00e9\u20AC\ud83d\ude00")");
+    std::string value;
+    ASSERT_TRUE(reader.readString(value));
+    EXPECT_EQ(value, "a\"b\\c/d\n\t\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+}
+
+TEST(OnDemandReaderTest, failsOnMalformedText) {
+    std::string key;
+    std::string value;
+    for (auto text : {R"({"a" "b"})",
+                      R"({"a":"b" "c":"d"})",
+                      R"({"a":"b",})",
+                      R"({"a":[1,2})",
+                      R"({"a":"b)",
+                      R"({"a":"\x"})",
+                      R"({"a":"\ud83d"})",
+                      R"({"a":tru})",
+                      R"({"a":)"}) {
+        OnDemandReader reader(text);
+        ASSERT_TRUE(reader.enterObject()) << text;
+        while (reader.nextField(key)) {
+            reader.readString(value);
+        }
+        EXPECT_TRUE(reader.failed()) << text;
+        EXPECT_FALSE(reader.error().empty()) << text;
+
+        // the reader stays failed
+        EXPECT_FALSE(reader.enterObject());
+        EXPECT_FALSE(reader.skipValue());
+    }
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <AACE/Engine/Utils/PCM/PCMUtils.h>
+
+using namespace aace::engine::utils::pcm;
+
+// a count that is not a multiple of the vector size, so the vectorized and the scalar paths are both used
+static const size_t SAMPLE_COUNT = 1001;
+
+static std::vector<int16_t> createSamples(size_t count) {
+    std::vector<int16_t> samples(count);
+    for (size_t j = 0; j < count; j++) {
+        samples[j] = static_cast<int16_t>((j * 7919) % 65536 - 32768);
+    }
+    samples[0] = INT16_MIN;
+    samples[1] = INT16_MAX;
+    return samples;
+}
+
+TEST(PCMUtilsTest, convertsBetweenInt16AndFloat) {
+    auto samples = createSamples(SAMPLE_COUNT);
+    std::vector<float> floats(SAMPLE_COUNT);
+    int16ToFloat(samples.data(), floats.data(), SAMPLE_COUNT);
+    for (size_t j = 0; j < SAMPLE_COUNT; j++) {
+        ASSERT_FLOAT_EQ(floats[j], samples[j] / 32768.0f) << "sample " << j;
+    }
+
+    std::vector<int16_t> converted(SAMPLE_COUNT);
+    floatToInt16(floats.data(), converted.data(), SAMPLE_COUNT);
+    EXPECT_EQ(converted, samples);
+
+    // the samples out of range are clamped
+    std::vector<float> outOfRange(SAMPLE_COUNT, 2.0f);
+    for (size_t j = 0; j < SAMPLE_COUNT; j += 2) {
+        outOfRange[j] = -2.0f;
+    }
+    floatToInt16(outOfRange.data(), converted.data(), SAMPLE_COUNT);
+    for (size_t j = 0; j < SAMPLE_COUNT; j++) {
+        ASSERT_EQ(converted[j], j % 2 == 0 ? INT16_MIN : INT16_MAX) << "sample " << j;
+    }
+}
+
+TEST(PCMUtilsTest, appliesGain) {
+    auto samples = createSamples(SAMPLE_COUNT);
+    auto ducked = samples;
+    applyGain(ducked.data(), ducked.size(), 0.25f);
+    for (size_t j = 0; j < SAMPLE_COUNT; j++) {
+        ASSERT_EQ(ducked[j], static_cast<int16_t>(std::lrint(samples[j] * 0.25f))) << "sample " << j;
+    }
+
+    auto boosted = samples;
+    applyGain(boosted.data(), boosted.size(), 4.0f);
+    for (size_t j = 0; j < SAMPLE_COUNT; j++) {
+        auto expected = std::min(std::max(samples[j] * 4.0f, -32768.0f), 32767.0f);
+        ASSERT_EQ(boosted[j], static_cast<int16_t>(expected)) << "sample " << j;
+    }
+
+    std::vector<float> floats(SAMPLE_COUNT, 0.5f);
+    applyGain(floats.data(), floats.size(), 0.5f);
+    for (auto next : floats) {
+        ASSERT_FLOAT_EQ(next, 0.25f);
+    }
+}
+
+TEST(PCMUtilsTest, downmixesToMono) {
+    auto samples = createSamples(SAMPLE_COUNT * 2);
+    std::vector<int16_t> mono(SAMPLE_COUNT);
+    downmixToMono(samples.data(), mono.data(), SAMPLE_COUNT, 2);
+    for (size_t j = 0; j < SAMPLE_COUNT; j++) {
+        ASSERT_EQ(mono[j], (samples[j * 2] + samples[j * 2 + 1]) >> 1) << "frame " << j;
+    }
+
+    // the channels of a microphone array are averaged, in place
+    std::vector<int16_t> array = {100, 200, 300, 400, -4, -8, -12, -16};
+    downmixToMono(array.data(), array.data(), 2, 4);
+    EXPECT_EQ(array[0], 250);
+    EXPECT_EQ(array[1], -10);
+
+    // the vectorized 4 channel frames, in place
+    auto quad = createSamples(SAMPLE_COUNT * 4);
+    auto expected = quad;
+    downmixToMono(quad.data(), quad.data(), SAMPLE_COUNT, 4);
+    for (size_t j = 0; j < SAMPLE_COUNT; j++) {
+        auto* frame = &expected[j * 4];
+        ASSERT_EQ(quad[j], (frame[0] + frame[1] + frame[2] + frame[3]) >> 2) << "frame " << j;
+    }
+}
+
+TEST(PCMUtilsTest, measuresLevel) {
+    std::vector<int16_t> silence(SAMPLE_COUNT, 0);
+    EXPECT_EQ(levelDbfs(silence.data(), silence.size()), SILENCE_DBFS);
+    EXPECT_EQ(levelDbfs(silence.data(), 0), SILENCE_DBFS);
+
+    // a full scale square wave, including the pairs of minimum samples that overflow a signed 32-bit sum
+    std::vector<int16_t> fullScale(SAMPLE_COUNT, INT16_MIN);
+    EXPECT_NEAR(levelDbfs(fullScale.data(), fullScale.size()), 0.0f, 0.001f);
+
+    // the level of any samples is the level of their mean square
+    auto samples = createSamples(SAMPLE_COUNT);
+    double sum = 0;
+    for (auto next : samples) {
+        sum += static_cast<double>(next) * next;
+    }
+    auto expected = 10.0 * std::log10(sum / SAMPLE_COUNT / (32768.0 * 32768.0));
+    EXPECT_NEAR(levelDbfs(samples.data(), samples.size()), expected, 0.001);
+
+    std::vector<int16_t> quiet(SAMPLE_COUNT, 328);
+    EXPECT_NEAR(levelDbfs(quiet.data(), quiet.size()), -40.0f, 0.01f);
+}
+
+TEST(PCMUtilsTest, filtersHighPass) {
+    // 6 channels, so the vectorized 4 channels and the scalar channels of a frame are both used
+    const size_t channels = 6;
+    auto samples = createSamples(SAMPLE_COUNT * channels);
+    auto filtered = samples;
+    auto coefficient = highPassCoefficient(100.0f, 16000);
+    EXPECT_NEAR(coefficient, 0.9622f, 0.0001f);
+
+    // the blocks are filtered in 2 calls, keeping the state
+    std::vector<float> state(channels * 2, 0.0f);
+    highPassFilter(filtered.data(), 500, channels, coefficient, state.data());
+    highPassFilter(filtered.data() + 500 * channels, SAMPLE_COUNT - 500, channels, coefficient, state.data());
+
+    std::vector<double> lastInput(channels, 0.0), lastOutput(channels, 0.0);
+    for (size_t j = 0; j < SAMPLE_COUNT * channels; j++) {
+        auto channel = j % channels;
+        double output = coefficient * (lastOutput[channel] + samples[j] - lastInput[channel]);
+        lastInput[channel] = samples[j];
+        lastOutput[channel] = output;
+        auto expected = std::min(std::max(output, -32768.0), 32767.0);
+        ASSERT_NEAR(filtered[j], expected, 1.0) << "sample " << j;
+    }
+
+    // a constant signal is removed
+    std::vector<int16_t> offset(16000, 1000);
+    std::vector<float> monoState(2, 0.0f);
+    highPassFilter(offset.data(), offset.size(), 1, coefficient, monoState.data());
+    EXPECT_EQ(offset.back(), 0);
+}
+
+TEST(PCMUtilsTest, decimatesIntegerRatios) {
+    Resampler resampler(48000, 16000);
+    std::vector<int16_t> input = {3, 6, 9, 30, 60, 90, -3};
+    std::vector<int16_t> output;
+    EXPECT_EQ(resampler.process(input.data(), input.size(), output), 2u);
+    EXPECT_EQ(output, (std::vector<int16_t>{6, 60}));
+
+    // the period in progress is completed by the next call
+    input = {-6, -9};
+    EXPECT_EQ(resampler.process(input.data(), input.size(), output), 1u);
+    EXPECT_EQ(output.back(), -6);
+
+    resampler.reset();
+    input = {1, 1};
+    EXPECT_EQ(resampler.process(input.data(), input.size(), output), 0u);
+}
+
+TEST(PCMUtilsTest, interpolatesOtherRatios) {
+    // a ramp keeps its slope when it is resampled in several calls
+    Resampler resampler(44100, 16000);
+    std::vector<int16_t> output;
+    for (int call = 0; call < 10; call++) {
+        std::vector<int16_t> input;
+        for (int j = 0; j < 441; j++) {
+            input.push_back(static_cast<int16_t>(call * 441 + j));
+        }
+        resampler.process(input.data(), input.size(), output);
+    }
+    ASSERT_NEAR(output.size(), 1600u, 1u);
+    for (size_t j = 0; j < output.size(); j++) {
+        ASSERT_NEAR(output[j], j * 44100.0 / 16000.0, 1.0) << "sample " << j;
+    }
+
+    Resampler upsampler(8000, 16000);
+    std::vector<int16_t> input = {0, 100, 200};
+    output.clear();
+    upsampler.process(input.data(), input.size(), output);
+    input = {300};
+    upsampler.process(input.data(), input.size(), output);
+    EXPECT_EQ(output, (std::vector<int16_t>{0, 50, 100, 150, 200, 250}));
+}
+
+// a tone of a frequency, at -6 dBFS
+static std::vector<int16_t> createTone(uint32_t sampleRate, double frequency, size_t count) {
+    std::vector<int16_t> samples(count);
+    for (size_t j = 0; j < count; j++) {
+        auto phase = 2 * 3.14159265358979323846 * frequency * j / sampleRate;
+        samples[j] = static_cast<int16_t>(std::lrint(16384 * std::sin(phase)));
+    }
+    return samples;
+}
+
+// the level of the output of a resampler after its delay, in blocks of 480 samples
+static float resampledLevel(PolyphaseResampler& resampler, const std::vector<int16_t>& input) {
+    std::vector<int16_t> output;
+    for (size_t offset = 0; offset < input.size(); offset += 480) {
+        resampler.process(input.data() + offset, std::min<size_t>(480, input.size() - offset), output);
+    }
+    return levelDbfs(output.data() + resampler.getTaps(), output.size() - resampler.getTaps());
+}
+
+TEST(PCMUtilsTest, resamplesWithPolyphaseFilter) {
+    EXPECT_EQ(PolyphaseResampler::create(0, 16000), nullptr);
+    EXPECT_EQ(PolyphaseResampler::create(48000, 16000, 0), nullptr);
+    // the ratio of 44101 Hz to 16 kHz can't be reduced
+    EXPECT_EQ(PolyphaseResampler::create(44101, 16000), nullptr);
+
+    auto resampler = PolyphaseResampler::create(48000, 16000);
+    ASSERT_NE(resampler, nullptr);
+    EXPECT_EQ(resampler->getTaps() % 8, 0u);
+    auto toneLevel = levelDbfs(createTone(16000, 1000, 16000).data(), 16000);
+
+    // the speech band is kept, and the tones above 8 kHz are removed rather than folded back
+    EXPECT_NEAR(resampledLevel(*resampler, createTone(48000, 1000, 48000)), toneLevel, 0.1f);
+    resampler->reset();
+    EXPECT_LT(resampledLevel(*resampler, createTone(48000, 10000, 48000)), toneLevel - 50);
+
+    // an arbitrary ratio, whose output has the expected length whatever the blocks
+    resampler = PolyphaseResampler::create(44100, 16000);
+    ASSERT_NE(resampler, nullptr);
+    auto input = createTone(44100, 1000, 44100);
+    EXPECT_NEAR(resampledLevel(*resampler, input), toneLevel, 0.1f);
+    resampler->reset();
+    std::vector<int16_t> whole, blocks;
+    resampler->process(input.data(), input.size(), whole);
+    resampler->reset();
+    for (size_t offset = 0; offset < input.size(); offset += 100) {
+        resampler->process(input.data() + offset, std::min<size_t>(100, input.size() - offset), blocks);
+    }
+    EXPECT_EQ(whole.size(), 16000u);
+    EXPECT_EQ(blocks, whole);
+
+    // upsampling
+    resampler = PolyphaseResampler::create(8000, 16000);
+    ASSERT_NE(resampler, nullptr);
+    EXPECT_NEAR(resampledLevel(*resampler, createTone(8000, 1000, 8000)), toneLevel, 0.1f);
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/PropertyManager/PropertyRegistry.h>
+
+namespace aace {
+namespace test {
+namespace unit {
+namespace core {
+
+using aace::engine::propertyManager::PropertyDescription;
+using aace::engine::propertyManager::PropertyRegistry;
+
+class PropertyRegistryTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_getterCallCount = 0;
+        m_value = "en-US";
+    }
+
+protected:
+    PropertyDescription createProperty(const std::string& name, bool cacheable) {
+        return PropertyDescription(
+            name,
+            nullptr,
+            [this]() {
+                m_getterCallCount++;
+                return m_value;
+            },
+            cacheable);
+    }
+
+    PropertyRegistry m_registry;
+    int m_getterCallCount;
+    std::string m_value;
+};
+
+TEST_F(PropertyRegistryTest, AddShouldAssignDistinctHandles) {
+    auto first = m_registry.add(createProperty("first", false));
+    auto second = m_registry.add(createProperty("second", false));
+    EXPECT_NE(first, 0u);
+    EXPECT_NE(second, 0u);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(m_registry.getHandle("first"), first);
+    EXPECT_EQ(m_registry.getHandle("second"), second);
+    EXPECT_EQ(m_registry.getDescription(second)->getPropertyName(), "second");
+}
+
+TEST_F(PropertyRegistryTest, AddDuplicateOrUnnamedPropertyShouldFail) {
+    ASSERT_NE(m_registry.add(createProperty("name", false)), 0u);
+    EXPECT_EQ(m_registry.add(createProperty("name", true)), 0u);
+    EXPECT_EQ(m_registry.add(createProperty("", false)), 0u);
+}
+
+TEST_F(PropertyRegistryTest, UnknownHandleShouldNotIdentifyAProperty) {
+    EXPECT_EQ(m_registry.getHandle("unknown"), 0u);
+    EXPECT_EQ(m_registry.getDescription(0), nullptr);
+    EXPECT_EQ(m_registry.getDescription(1), nullptr);
+    EXPECT_THROW(m_registry.getValue(1, true), std::exception);
+}
+
+TEST_F(PropertyRegistryTest, WriteOnlyPropertyValueShouldThrow) {
+    auto handle = m_registry.add(PropertyDescription("writeOnly", nullptr, nullptr));
+    ASSERT_NE(handle, 0u);
+    EXPECT_THROW(m_registry.getValue(handle, true), std::exception);
+}
+
+TEST_F(PropertyRegistryTest, PropertyNotCacheableShouldCallGetterOnEveryRead) {
+    auto handle = m_registry.add(createProperty("locale", false));
+    EXPECT_EQ(m_registry.getValue(handle, true), "en-US");
+    m_value = "fr-FR";
+    EXPECT_EQ(m_registry.getValue(handle, true), "fr-FR");
+    EXPECT_EQ(m_getterCallCount, 2);
+}
+
+TEST_F(PropertyRegistryTest, CacheablePropertyShouldBeReadOnceUntilInvalidated) {
+    auto handle = m_registry.add(createProperty("locale", true));
+    EXPECT_EQ(m_registry.getValue(handle, true), "en-US");
+    m_value = "fr-FR";
+    EXPECT_EQ(m_registry.getValue(handle, true), "en-US");
+    EXPECT_EQ(m_getterCallCount, 1);
+
+    m_registry.invalidate(handle);
+    EXPECT_EQ(m_registry.getValue(handle, true), "fr-FR");
+    EXPECT_EQ(m_registry.getValue(handle, true), "fr-FR");
+    EXPECT_EQ(m_getterCallCount, 2);
+}
+
+TEST_F(PropertyRegistryTest, ValueReadWithoutCachingShouldNotBeCached) {
+    auto handle = m_registry.add(createProperty("locale", true));
+    EXPECT_EQ(m_registry.getValue(handle, false), "en-US");
+    m_value = "fr-FR";
+    EXPECT_EQ(m_registry.getValue(handle, true), "fr-FR");
+    EXPECT_EQ(m_registry.getValue(handle, true), "fr-FR");
+    EXPECT_EQ(m_getterCallCount, 2);
+}
+
+TEST_F(PropertyRegistryTest, ValueInvalidatedWhileReadShouldNotBeCached) {
+    PropertyRegistry::PropertyHandle handle = 0;
+    bool invalidate = true;
+    handle = m_registry.add(PropertyDescription(
+        "locale",
+        nullptr,
+        [this, &handle, &invalidate]() {
+            m_getterCallCount++;
+            auto value = m_value;
+            // the value changes after the getter read it
+            if (invalidate) {
+                invalidate = false;
+                m_value = "fr-FR";
+                m_registry.invalidate(handle);
+            }
+            return value;
+        },
+        true));
+    EXPECT_EQ(m_registry.getValue(handle, true), "en-US");
+    EXPECT_EQ(m_registry.getValue(handle, true), "fr-FR");
+    EXPECT_EQ(m_registry.getValue(handle, true), "fr-FR");
+    EXPECT_EQ(m_getterCallCount, 2);
+}
+
+TEST_F(PropertyRegistryTest, ClearShouldRemoveAllProperties) {
+    auto handle = m_registry.add(createProperty("locale", true));
+    m_registry.clear();
+    EXPECT_EQ(m_registry.getHandle("locale"), 0u);
+    EXPECT_EQ(m_registry.getDescription(handle), nullptr);
+    EXPECT_NE(m_registry.add(createProperty("locale", true)), 0u);
+}
+
+}  // namespace core
+}  // namespace unit
+}  // namespace test
+}  // namespace aace
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Audio/IStreamAudioStream.h>
+#include <AACE/Engine/Audio/ReadAheadBuffer.h>
+
+using aace::engine::audio::IStreamAudioStream;
+using aace::engine::audio::ReadAheadBuffer;
+
+/// Returns a string of a size with a repeating pattern
+static std::string createData(size_t size) {
+    std::string data(size, 0);
+    for (size_t j = 0; j < size; j++) {
+        data[j] = static_cast<char>('a' + j % 26);
+    }
+    return data;
+}
+
+/// Reads a buffer until it is closed
+static std::string readAll(ReadAheadBuffer& buffer, size_t chunkSize) {
+    std::string output;
+    std::vector<char> chunk(chunkSize);
+    while (!buffer.isClosed()) {
+        auto count = buffer.read(chunk.data(), chunk.size(), std::chrono::seconds(1));
+        output.append(chunk.data(), count);
+    }
+    return output;
+}
+
+TEST(ReadAheadBufferTest, rejectsInvalidArguments) {
+    EXPECT_EQ(ReadAheadBuffer::create(0, [](char*, size_t, bool& closed) { return size_t(0); }), nullptr);
+    EXPECT_EQ(ReadAheadBuffer::create(1024, nullptr), nullptr);
+}
+
+TEST(ReadAheadBufferTest, readsSourceInOrder) {
+    auto data = createData(100000);
+    size_t offset = 0;
+    auto buffer = ReadAheadBuffer::create(4096, [&](char* output, size_t size, bool& closed) {
+        auto count = std::min(size, data.size() - offset);
+        data.copy(output, count, offset);
+        offset += count;
+        closed = offset == data.size();
+        return count;
+    });
+    ASSERT_NE(buffer, nullptr);
+
+    // the reads are smaller than the chunks of the filler, and wrap around the end of the buffer
+    EXPECT_EQ(readAll(*buffer, 300), data);
+    EXPECT_EQ(buffer->read(&data[0], 1, std::chrono::milliseconds(10)), 0);
+}
+
+TEST(ReadAheadBufferTest, fillsAheadOfReader) {
+    std::atomic<size_t> sourceReads{0};
+    auto buffer = ReadAheadBuffer::create(4096, [&](char* output, size_t size, bool& closed) {
+        sourceReads++;
+        std::fill(output, output + size, 'x');
+        return size;
+    });
+    ASSERT_NE(buffer, nullptr);
+
+    // the filler stops once the buffer is full
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (buffer->size() < 4096 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(buffer->size(), 4096u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto reads = sourceReads.load();
+    EXPECT_EQ(buffer->size(), 4096u);
+
+    char chunk[2048];
+    EXPECT_EQ(buffer->read(chunk, sizeof(chunk), std::chrono::milliseconds(0)), 2048);
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (sourceReads == reads && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GT(sourceReads.load(), reads);
+}
+
+TEST(ReadAheadBufferTest, readDoesNotWaitForSlowSource) {
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto buffer = ReadAheadBuffer::create(1024, [released](char* output, size_t size, bool& closed) {
+        released.wait();
+        closed = true;
+        return size_t(0);
+    });
+    ASSERT_NE(buffer, nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    char chunk[256];
+    EXPECT_EQ(buffer->read(chunk, sizeof(chunk), std::chrono::milliseconds(20)), 0);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_FALSE(buffer->isClosed());
+
+    release.set_value();
+    EXPECT_EQ(buffer->read(chunk, sizeof(chunk), std::chrono::seconds(1)), 0);
+    EXPECT_TRUE(buffer->isClosed());
+}
+
+TEST(ReadAheadBufferTest, iStreamAudioStreamReadsAhead) {
+    auto data = createData(10000);
+    auto stream = IStreamAudioStream::create(std::make_shared<std::istringstream>(data), {}, 2048);
+    ASSERT_NE(stream, nullptr);
+
+    std::string output;
+    char chunk[100];
+    while (!stream->isClosed()) {
+        auto count = stream->read(chunk, sizeof(chunk));
+        ASSERT_GE(count, 0);
+        output.append(chunk, count);
+    }
+    EXPECT_EQ(output, data);
+}
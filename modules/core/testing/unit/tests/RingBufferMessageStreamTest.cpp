@@ -0,0 +1,160 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include <AACE/Engine/MessageBroker/RingBufferMessageStream.h>
+#include <AACE/Engine/MessageBroker/StreamManagerImpl.h>
+
+using aace::core::MessageStream;
+using aace::engine::messageBroker::RingBufferMessageStream;
+using aace::engine::messageBroker::StreamManagerImpl;
+
+TEST(RingBufferMessageStreamTest, capacityIsRoundedUp) {
+    auto stream = RingBufferMessageStream::create(1000);
+    ASSERT_NE(stream, nullptr);
+    EXPECT_EQ(stream->capacity(), 1024u);
+    EXPECT_EQ(RingBufferMessageStream::create(0), nullptr);
+}
+
+TEST(RingBufferMessageStreamTest, readWriteWrapsAround) {
+    auto stream = RingBufferMessageStream::create(8);
+    ASSERT_NE(stream, nullptr);
+
+    char data[8];
+    ASSERT_EQ(stream->write("abcdef", 6), 6);
+    ASSERT_EQ(stream->read(data, 4), 4);
+    EXPECT_EQ(std::string(data, 4), "abcd");
+
+    // the write is split at the end of the buffer, and is truncated once the buffer is full
+    ASSERT_EQ(stream->write("ghijklmnop", 10), 6);
+    ASSERT_EQ(stream->available(), 8u);
+    ASSERT_EQ(stream->read(data, sizeof(data)), 8);
+    EXPECT_EQ(std::string(data, 8), "efghijkl");
+    EXPECT_EQ(stream->read(data, sizeof(data)), 0);
+}
+
+TEST(RingBufferMessageStreamTest, acquireAndCommitRegions) {
+    auto stream = RingBufferMessageStream::create(16);
+    ASSERT_NE(stream, nullptr);
+
+    auto writeRegion = stream->acquireWriteRegion(5);
+    ASSERT_EQ(writeRegion.size, 5u);
+    std::memcpy(writeRegion.data, "hello", 5);
+
+    // uncommitted data is not visible to the consumer
+    EXPECT_EQ(stream->acquireReadRegion().size, 0u);
+    stream->commitWriteRegion(5);
+
+    auto readRegion = stream->acquireReadRegion();
+    ASSERT_EQ(readRegion.size, 5u);
+    EXPECT_EQ(std::string(readRegion.data, readRegion.size), "hello");
+
+    // the consumer reads the data in place from the same buffer the producer wrote
+    EXPECT_EQ(readRegion.data, writeRegion.data);
+    stream->commitReadRegion(readRegion.size);
+    EXPECT_EQ(stream->available(), 0u);
+}
+
+TEST(RingBufferMessageStreamTest, closeDrainsRemainingData) {
+    auto stream = RingBufferMessageStream::create(16);
+    ASSERT_NE(stream, nullptr);
+
+    ASSERT_EQ(stream->write("data", 4), 4);
+    stream->close();
+    EXPECT_LT(stream->write("more", 4), 0);
+    EXPECT_FALSE(stream->isClosed());
+
+    char data[4];
+    ASSERT_EQ(stream->read(data, sizeof(data)), 4);
+    EXPECT_TRUE(stream->isClosed());
+}
+
+TEST(RingBufferMessageStreamTest, producerAndConsumerThreads) {
+    auto stream = RingBufferMessageStream::create(256);
+    ASSERT_NE(stream, nullptr);
+
+    const size_t total = 100000;
+    std::thread producer([stream, total]() {
+        size_t written = 0;
+        while (written < total) {
+            auto region = stream->acquireWriteRegion(total - written);
+            if (region.size == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < region.size; i++) {
+                region.data[i] = static_cast<char>((written + i) % 251);
+            }
+            stream->commitWriteRegion(region.size);
+            written += region.size;
+        }
+        stream->close();
+    });
+
+    size_t received = 0;
+    bool ordered = true;
+    while (!stream->isClosed()) {
+        auto region = stream->acquireReadRegion();
+        if (region.size == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < region.size; i++) {
+            ordered = ordered && region.data[i] == static_cast<char>((received + i) % 251);
+        }
+        stream->commitReadRegion(region.size);
+        received += region.size;
+    }
+    producer.join();
+
+    EXPECT_EQ(received, total);
+    EXPECT_TRUE(ordered);
+}
+
+TEST(RingBufferMessageStreamTest, sharedMemory) {
+    auto name = "/aace-ring-buffer-test-" + std::to_string(getpid());
+    auto stream = RingBufferMessageStream::createShared(name, 32, MessageStream::Mode::READ);
+    ASSERT_NE(stream, nullptr);
+
+    // a second mapping of the same name, as a client process would open it
+    auto client = RingBufferMessageStream::openShared(name, MessageStream::Mode::WRITE);
+    ASSERT_NE(client, nullptr);
+    EXPECT_EQ(client->capacity(), 32u);
+    EXPECT_EQ(RingBufferMessageStream::createShared(name, 32), nullptr);
+
+    ASSERT_EQ(client->write("audio", 5), 5);
+    char data[8];
+    ASSERT_EQ(stream->read(data, sizeof(data)), 5);
+    EXPECT_EQ(std::string(data, 5), "audio");
+
+    client.reset();
+    stream.reset();
+    EXPECT_EQ(RingBufferMessageStream::openShared(name), nullptr);
+}
+
+TEST(RingBufferMessageStreamTest, registeredWithStreamManager) {
+    auto streamManager = StreamManagerImpl::create();
+    auto stream = streamManager->createRingBufferStream("stream-1", 64, MessageStream::Mode::WRITE);
+    ASSERT_NE(stream, nullptr);
+    EXPECT_EQ(streamManager->createRingBufferStream("stream-1", 64, MessageStream::Mode::WRITE), nullptr);
+
+    EXPECT_EQ(streamManager->requestStreamHandler("stream-1", MessageStream::Mode::WRITE), stream);
+}
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <AACE/Engine/Storage/SQLiteStorage.h>
+
+using aace::engine::storage::SQLiteStorage;
+
+static const std::string DATABASE_PATH("SQLiteStorageTest.db");
+
+class SQLiteStorageTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        removeDatabase();
+    }
+
+    void TearDown() override {
+        removeDatabase();
+    }
+
+    static void removeDatabase() {
+        std::remove(DATABASE_PATH.c_str());
+        std::remove((DATABASE_PATH + "-wal").c_str());
+        std::remove((DATABASE_PATH + "-shm").c_str());
+    }
+
+    static std::string journalMode(sqlite3* db) {
+        std::string mode;
+        sqlite3_exec(
+            db,
+            "PRAGMA journal_mode;",
+            [](void* data, int argc, char** argv, char**) {
+                *static_cast<std::string*>(data) = argv[0];
+                return SQLITE_OK;
+            },
+            &mode,
+            nullptr);
+        return mode;
+    }
+};
+
+TEST_F(SQLiteStorageTest, putGetAndRemove) {
+    auto storage = SQLiteStorage::create(DATABASE_PATH);
+    ASSERT_NE(storage, nullptr);
+
+    EXPECT_FALSE(storage->containsTable("settings"));
+    EXPECT_TRUE(storage->put("settings", "locale", "en-US"));
+    EXPECT_TRUE(storage->containsTable("settings"));
+    EXPECT_TRUE(storage->containsKey("settings", "locale"));
+    EXPECT_EQ(storage->get("settings", "locale"), "en-US");
+
+    // a put replaces the value of an existing key
+    EXPECT_TRUE(storage->put("settings", "locale", "fr-CA"));
+    EXPECT_EQ(storage->get("settings", "locale"), "fr-CA");
+    EXPECT_EQ(storage->get("settings", "timezone", "UTC"), "UTC");
+
+    EXPECT_TRUE(storage->removeKey("settings", "locale"));
+    EXPECT_FALSE(storage->containsKey("settings", "locale"));
+    EXPECT_FALSE(storage->removeKey("settings", "locale"));
+
+    EXPECT_TRUE(storage->removeTable("settings"));
+    EXPECT_FALSE(storage->containsTable("settings"));
+
+    // the table is created again with new statements
+    EXPECT_TRUE(storage->put("settings", "locale", "de-DE"));
+    EXPECT_EQ(storage->get("settings", "locale"), "de-DE");
+}
+
+TEST_F(SQLiteStorageTest, valuesAreNotInterpretedAsSql) {
+    auto storage = SQLiteStorage::create(DATABASE_PATH);
+    ASSERT_NE(storage, nullptr);
+
+    std::string value("{\"name\":\"it's\"}'); DROP TABLE 'quoted'; --");
+    EXPECT_TRUE(storage->put("quoted 'table'", "it's", value));
+    EXPECT_EQ(storage->get("quoted 'table'", "it's"), value);
+
+    auto list = storage->list("quoted 'table'");
+    ASSERT_EQ(list.size(), 1u);
+    EXPECT_EQ(list[0].first, "it's");
+    EXPECT_EQ(list[0].second, value);
+}
+
+TEST_F(SQLiteStorageTest, keysAndTransactions) {
+    auto storage = SQLiteStorage::create(DATABASE_PATH);
+    ASSERT_NE(storage, nullptr);
+
+    ASSERT_TRUE(storage->begin());
+    for (int j = 0; j < 10; j++) {
+        EXPECT_TRUE(storage->put("table", "key" + std::to_string(j), std::to_string(j)));
+    }
+    ASSERT_TRUE(storage->commit());
+    EXPECT_EQ(storage->keys("table").size(), 10u);
+
+    ASSERT_TRUE(storage->begin());
+    EXPECT_TRUE(storage->put("table", "key10", "10"));
+    EXPECT_TRUE(storage->put("cancelled", "key", "value"));
+    ASSERT_TRUE(storage->cancel());
+    EXPECT_EQ(storage->keys("table").size(), 10u);
+    EXPECT_FALSE(storage->containsTable("cancelled"));
+}
+
+TEST_F(SQLiteStorageTest, journalModeAndSynchronous) {
+    EXPECT_EQ(SQLiteStorage::create(DATABASE_PATH, "unknown"), nullptr);
+    EXPECT_EQ(SQLiteStorage::create(DATABASE_PATH, "wal", "sometimes"), nullptr);
+
+    {
+        auto storage = SQLiteStorage::create(DATABASE_PATH, "wal", "normal");
+        ASSERT_NE(storage, nullptr);
+        EXPECT_TRUE(storage->put("table", "key", "value"));
+    }
+
+    // the journal mode is kept in the database, and the values are persisted
+    sqlite3* db = nullptr;
+    ASSERT_EQ(sqlite3_open_v2(DATABASE_PATH.c_str(), &db, SQLITE_OPEN_READONLY, nullptr), SQLITE_OK);
+    EXPECT_EQ(journalMode(db), "wal");
+    sqlite3_close(db);
+
+    auto storage = SQLiteStorage::create(DATABASE_PATH, "delete");
+    ASSERT_NE(storage, nullptr);
+    EXPECT_EQ(storage->get("table", "key"), "value");
+}
+
+TEST_F(SQLiteStorageTest, putAndGetBatch) {
+    auto storage = SQLiteStorage::create(DATABASE_PATH);
+    ASSERT_NE(storage, nullptr);
+
+    std::vector<SQLiteStorage::KeyValuePair> values;
+    for (int j = 0; j < 100; j++) {
+        values.emplace_back("key" + std::to_string(j), "value" + std::to_string(j));
+    }
+    ASSERT_TRUE(storage->putBatch("table", values));
+    EXPECT_EQ(storage->keys("table").size(), 100u);
+
+    auto batch = storage->getBatch("table", {"key42", "missing", "key7"});
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch[0], SQLiteStorage::KeyValuePair("key42", "value42"));
+    EXPECT_EQ(batch[1], SQLiteStorage::KeyValuePair("key7", "value7"));
+    EXPECT_TRUE(storage->getBatch("missing", {"key42"}).empty());
+
+    // a batch nested in a cancelled transaction is cancelled with it
+    ASSERT_TRUE(storage->begin());
+    ASSERT_TRUE(storage->putBatch("table", {{"key100", "value100"}}));
+    ASSERT_TRUE(storage->cancel());
+    EXPECT_FALSE(storage->containsKey("table", "key100"));
+}
+
+TEST_F(SQLiteStorageTest, forEach) {
+    auto storage = SQLiteStorage::create(DATABASE_PATH);
+    ASSERT_NE(storage, nullptr);
+    ASSERT_TRUE(storage->putBatch("table", {{"a", "1"}, {"b", "2"}, {"c", "3"}}));
+
+    size_t count = 0;
+    EXPECT_TRUE(storage->forEach("table", [&count](const std::string& key, const std::string& value) {
+        count++;
+        return true;
+    }));
+    EXPECT_EQ(count, 3u);
+
+    // the iteration stops when the callback returns false, and can be nested
+    count = 0;
+    size_t nestedCount = 0;
+    EXPECT_TRUE(storage->forEach("table", [&](const std::string& key, const std::string& value) {
+        count++;
+        storage->forEach("table", [&nestedCount](const std::string& key, const std::string& value) {
+            nestedCount++;
+            return true;
+        });
+        return false;
+    }));
+    EXPECT_EQ(count, 1u);
+    EXPECT_EQ(nestedCount, 3u);
+
+    EXPECT_FALSE(storage->forEach("missing", [](const std::string& key, const std::string& value) { return true; }));
+}
+
+TEST_F(SQLiteStorageTest, maintenanceReturnsFreePages) {
+    auto storage = SQLiteStorage::create(DATABASE_PATH);
+    ASSERT_NE(storage, nullptr);
+
+    std::vector<SQLiteStorage::KeyValuePair> values;
+    for (int j = 0; j < 200; j++) {
+        values.emplace_back("key" + std::to_string(j), std::string(1000, 'x'));
+    }
+    ASSERT_TRUE(storage->putBatch("table", values));
+    ASSERT_TRUE(storage->removeTable("table"));
+    ASSERT_TRUE(storage->put("settings", "locale", "en-US"));
+
+    SQLiteStorage::MaintenanceReport report;
+    ASSERT_TRUE(storage->runMaintenance(std::chrono::seconds(5), report));
+    EXPECT_GE(report.vacuumedPageCount, 40);
+    EXPECT_EQ(report.freePageCount, 0);
+    EXPECT_LT(report.pageCount, 10);
+    EXPECT_TRUE(report.checkpointed);
+    EXPECT_TRUE(report.analyzed);
+    EXPECT_FALSE(report.budgetExceeded);
+    EXPECT_EQ(storage->get("settings", "locale"), "en-US");
+
+    // the maintenance isn't run during a transaction
+    ASSERT_TRUE(storage->begin());
+    EXPECT_FALSE(storage->runMaintenance(std::chrono::seconds(5), report));
+    ASSERT_TRUE(storage->commit());
+}
+
+TEST_F(SQLiteStorageTest, maintenanceConvertsSmallDatabase) {
+    // a database created without incremental vacuum
+    sqlite3* db = nullptr;
+    ASSERT_EQ(sqlite3_open(DATABASE_PATH.c_str(), &db), SQLITE_OK);
+    ASSERT_EQ(
+        sqlite3_exec(
+            db,
+            "CREATE TABLE \"table\" (key STRING PRIMARY KEY NOT NULL,value STRING NOT NULL);"
+            "INSERT INTO \"table\" VALUES ('key','value');",
+            nullptr,
+            nullptr,
+            nullptr),
+        SQLITE_OK);
+    sqlite3_close(db);
+
+    auto storage = SQLiteStorage::create(DATABASE_PATH);
+    ASSERT_NE(storage, nullptr);
+    SQLiteStorage::MaintenanceReport report;
+    ASSERT_TRUE(storage->runMaintenance(std::chrono::seconds(5), report));
+    EXPECT_EQ(storage->get("table", "key"), "value");
+    storage.reset();
+
+    int64_t autoVacuum = 0;
+    ASSERT_EQ(sqlite3_open_v2(DATABASE_PATH.c_str(), &db, SQLITE_OPEN_READONLY, nullptr), SQLITE_OK);
+    sqlite3_exec(
+        db,
+        "PRAGMA auto_vacuum;",
+        [](void* data, int argc, char** argv, char**) {
+            *static_cast<int64_t*>(data) = std::atoll(argv[0]);
+            return SQLITE_OK;
+        },
+        &autoVacuum,
+        nullptr);
+    sqlite3_close(db);
+    EXPECT_EQ(autoVacuum, 2);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <AACE/Engine/Utils/Threading/SerialExecutor.h>
+
+using aace::engine::utils::threading::SerialExecutor;
+using aace::engine::utils::threading::ThreadPool;
+
+TEST(SerialExecutorTest, runsTasksInOrder) {
+    auto pool = ThreadPool::create(4);
+    std::vector<std::unique_ptr<SerialExecutor>> executors;
+    std::vector<std::vector<int>> results(8);
+    std::atomic<int> running[8];
+
+    for (size_t j = 0; j < results.size(); j++) {
+        executors.emplace_back(new SerialExecutor(pool));
+        running[j] = 0;
+    }
+
+    // the executors share the pool, but each runs its own tasks one at a time and in order
+    for (int k = 0; k < 500; k++) {
+        for (size_t j = 0; j < executors.size(); j++) {
+            executors[j]->submit([&results, &running, j, k]() {
+                EXPECT_EQ(running[j]++, 0);
+                results[j].push_back(k);
+                running[j]--;
+            });
+        }
+    }
+
+    for (size_t j = 0; j < executors.size(); j++) {
+        executors[j]->waitForSubmittedTasks();
+        ASSERT_EQ(results[j].size(), 500u);
+        for (int k = 0; k < 500; k++) {
+            EXPECT_EQ(results[j][k], k);
+        }
+    }
+}
+
+TEST(SerialExecutorTest, submitReturnsFuture) {
+    SerialExecutor executor(ThreadPool::create(2));
+    auto future = executor.submit([](int value) { return value * 2; }, 21);
+    ASSERT_TRUE(future.valid());
+    EXPECT_EQ(future.get(), 42);
+}
+
+TEST(SerialExecutorTest, submitToFront) {
+    SerialExecutor executor(ThreadPool::create(1));
+    std::vector<int> order;
+    std::promise<void> blocked;
+    auto blockedFuture = blocked.get_future().share();
+
+    executor.submit([blockedFuture]() { blockedFuture.wait(); });
+    executor.submit([&order]() { order.push_back(1); });
+    executor.submitToFront([&order]() { order.push_back(0); });
+    blocked.set_value();
+    executor.waitForSubmittedTasks();
+
+    ASSERT_EQ(order.size(), 2u);
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[1], 1);
+}
+
+TEST(SerialExecutorTest, shutdownWaitsForRunningTask) {
+    auto executor = std::unique_ptr<SerialExecutor>(new SerialExecutor(ThreadPool::create(1)));
+    std::atomic<bool> started{false};
+    std::atomic<bool> finished{false};
+
+    executor->submit([&started, &finished]() {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+
+    executor->shutdown();
+    EXPECT_TRUE(finished);
+    EXPECT_TRUE(executor->isShutdown());
+    EXPECT_FALSE(executor->submit([]() {}).valid());
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/Logger/Sinks/Sink.h>
+
+using aace::engine::logger::sink::Rule;
+using aace::engine::logger::sink::Sink;
+using Level = Sink::Level;
+
+class TestSink : public Sink {
+public:
+    TestSink() : Sink("test") {
+    }
+
+    void log(
+        Level level,
+        std::chrono::system_clock::time_point time,
+        const char* source,
+        const char* threadMoniker,
+        const char* text) override {
+        m_entries.push_back(text);
+    }
+
+    std::vector<std::string> m_entries;
+};
+
+TEST(SinkTest, minimumLevelOfRules) {
+    TestSink sink;
+    EXPECT_EQ(sink.getMinimumLevel(), Level::CRITICAL);
+
+    sink.addRule(Level::WARN, Rule::EMPTY, Rule::EMPTY, Rule::EMPTY);
+    EXPECT_EQ(sink.getMinimumLevel(), Level::WARN);
+
+    sink.addRule(Level::VERBOSE, Rule::EMPTY, "aace\\.audio\\..*", Rule::EMPTY);
+    EXPECT_EQ(sink.getMinimumLevel(), Level::VERBOSE);
+
+    // replacing the rule with the same pattern changes the level
+    sink.addRule(Level::INFO, Rule::EMPTY, "aace\\.audio\\..*", Rule::EMPTY);
+    EXPECT_EQ(sink.getMinimumLevel(), Level::INFO);
+}
+
+TEST(SinkTest, emitMatchesRules) {
+    TestSink sink;
+    auto now = std::chrono::system_clock::now();
+    sink.addRule(Level::WARN, Rule::EMPTY, Rule::EMPTY, Rule::EMPTY);
+    sink.addRule(Level::VERBOSE, Rule::EMPTY, "aace\\.audio\\..*", Rule::EMPTY);
+
+    sink.emit("AAC", "aace.audio.AudioOutput", Level::VERBOSE, now, "1", "audio");
+    sink.emit("AAC", "aace.alexa.SpeechRecognizer", Level::INFO, now, "1", "info");
+    sink.emit("AAC", "aace.alexa.SpeechRecognizer", Level::ERROR, now, "1", "error");
+
+    ASSERT_EQ(sink.m_entries.size(), 2u);
+    EXPECT_EQ(sink.m_entries[0], "audio");
+    EXPECT_EQ(sink.m_entries[1], "error");
+}
+
+TEST(SinkTest, messageRulesMatchEachEntry) {
+    TestSink sink;
+    auto now = std::chrono::system_clock::now();
+    sink.addRule(Level::ERROR, Rule::EMPTY, Rule::EMPTY, Rule::EMPTY);
+    sink.addRule(Level::INFO, Rule::EMPTY, "aace\\.alexa\\..*", ".*dialog.*");
+
+    // the entries share the same source and tag, so they are matched against the same cached rule set
+    sink.emit("AAC", "aace.alexa.SpeechRecognizer", Level::INFO, now, "1", "dialog started");
+    sink.emit("AAC", "aace.alexa.SpeechRecognizer", Level::INFO, now, "1", "wakeword detected");
+    sink.emit("AAC", "aace.alexa.SpeechRecognizer", Level::VERBOSE, now, "1", "dialog finished");
+    sink.emit("AAC", "aace.alexa.SpeechRecognizer", Level::ERROR, now, "1", "error");
+    sink.emit("AAC", "aace.audio.AudioOutput", Level::INFO, now, "1", "dialog audio");
+
+    ASSERT_EQ(sink.m_entries.size(), 2u);
+    EXPECT_EQ(sink.m_entries[0], "dialog started");
+    EXPECT_EQ(sink.m_entries[1], "error");
+}
+
+TEST(SinkTest, addRuleUpdatesCachedRules) {
+    TestSink sink;
+    auto now = std::chrono::system_clock::now();
+    sink.addRule(Level::WARN, Rule::EMPTY, Rule::EMPTY, Rule::EMPTY);
+
+    sink.emit("AAC", "aace.audio.AudioOutput", Level::INFO, now, "1", "before");
+    sink.addRule(Level::INFO, Rule::EMPTY, "aace\\.audio\\..*", Rule::EMPTY);
+    sink.emit("AAC", "aace.audio.AudioOutput", Level::INFO, now, "1", "after");
+
+    ASSERT_EQ(sink.m_entries.size(), 1u);
+    EXPECT_EQ(sink.m_entries[0], "after");
+}
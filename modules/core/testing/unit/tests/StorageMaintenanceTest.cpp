@@ -0,0 +1,150 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include <AACE/Engine/Storage/SQLiteStorage.h>
+#include <AACE/Engine/Storage/StorageMaintenance.h>
+
+using aace::engine::storage::SQLiteStorage;
+using aace::engine::storage::StorageMaintenance;
+
+static const std::string DATABASE_PATH("StorageMaintenanceTest.db");
+
+class StorageMaintenanceTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        removeDatabase();
+        m_storage = SQLiteStorage::create(DATABASE_PATH);
+        ASSERT_NE(m_storage, nullptr);
+
+        // the removed table leaves free pages in the database file
+        std::vector<SQLiteStorage::KeyValuePair> values;
+        for (int j = 0; j < 100; j++) {
+            values.emplace_back("key" + std::to_string(j), std::string(1000, 'x'));
+        }
+        ASSERT_TRUE(m_storage->putBatch("table", values));
+        ASSERT_TRUE(m_storage->removeTable("table"));
+        ASSERT_GT(freePageCount(), 0);
+
+        m_config.interval = std::chrono::milliseconds(50);
+        m_config.idleDelay = std::chrono::milliseconds(100);
+        m_config.budget = std::chrono::seconds(1);
+    }
+
+    void TearDown() override {
+        m_storage.reset();
+        removeDatabase();
+    }
+
+    static void removeDatabase() {
+        std::remove(DATABASE_PATH.c_str());
+        std::remove((DATABASE_PATH + "-wal").c_str());
+        std::remove((DATABASE_PATH + "-shm").c_str());
+    }
+
+    /// Returns the free pages of the database, read with another connection
+    static int64_t freePageCount() {
+        sqlite3* db = nullptr;
+        int64_t count = -1;
+        if (sqlite3_open_v2(DATABASE_PATH.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) == SQLITE_OK) {
+            sqlite3_exec(
+                db,
+                "PRAGMA freelist_count;",
+                [](void* data, int argc, char** argv, char**) {
+                    *static_cast<int64_t*>(data) = std::atoll(argv[0]);
+                    return SQLITE_OK;
+                },
+                &count,
+                nullptr);
+        }
+        sqlite3_close(db);
+        return count;
+    }
+
+    /// Waits until the free pages are returned to the file system
+    static bool waitForVacuum(std::chrono::milliseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (freePageCount() != 0) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return true;
+    }
+
+protected:
+    std::shared_ptr<SQLiteStorage> m_storage;
+    StorageMaintenance::Config m_config;
+};
+
+TEST_F(StorageMaintenanceTest, rejectsInvalidConfiguration) {
+    EXPECT_EQ(StorageMaintenance::create(nullptr, m_config, nullptr), nullptr);
+
+    auto config = m_config;
+    config.interval = std::chrono::milliseconds::zero();
+    EXPECT_EQ(StorageMaintenance::create(m_storage, config, nullptr), nullptr);
+
+    config = m_config;
+    config.budget = std::chrono::milliseconds(-1);
+    EXPECT_EQ(StorageMaintenance::create(m_storage, config, nullptr), nullptr);
+}
+
+TEST_F(StorageMaintenanceTest, runsWhenIdle) {
+    auto maintenance = StorageMaintenance::create(m_storage, m_config, []() { return false; });
+    ASSERT_NE(maintenance, nullptr);
+
+    // the maintenance doesn't run before it is started
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_GT(freePageCount(), 0);
+
+    maintenance->start();
+    EXPECT_TRUE(waitForVacuum(std::chrono::seconds(5)));
+    maintenance->shutdown();
+}
+
+TEST_F(StorageMaintenanceTest, deferredWhileActive) {
+    std::atomic<bool> active{true};
+    std::atomic<int> checks{0};
+    auto maintenance = StorageMaintenance::create(m_storage, m_config, [&]() {
+        checks++;
+        return active.load();
+    });
+    ASSERT_NE(maintenance, nullptr);
+    maintenance->start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_GT(checks, 0);
+    EXPECT_GT(freePageCount(), 0);
+
+    // the writes to the storage defer the maintenance too
+    active = false;
+    for (int j = 0; j < 25; j++) {
+        ASSERT_TRUE(m_storage->put("settings", "counter", std::to_string(j)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_GT(freePageCount(), 0);
+
+    EXPECT_TRUE(waitForVacuum(std::chrono::seconds(5)));
+    EXPECT_EQ(m_storage->get("settings", "counter"), "24");
+    maintenance->shutdown();
+}
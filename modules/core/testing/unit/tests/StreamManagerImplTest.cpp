@@ -0,0 +1,59 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/MessageBroker/RingBufferMessageStream.h>
+#include <AACE/Engine/MessageBroker/StreamManagerImpl.h>
+
+using aace::core::MessageStream;
+using aace::engine::messageBroker::RingBufferMessageStream;
+using aace::engine::messageBroker::StreamManagerImpl;
+
+TEST(StreamManagerImplTest, requestRemovesStream) {
+    auto streamManager = StreamManagerImpl::create();
+    auto stream = RingBufferMessageStream::create(16, MessageStream::Mode::READ);
+    ASSERT_TRUE(streamManager->registerStreamHandler("stream-1", stream));
+    EXPECT_FALSE(streamManager->registerStreamHandler("stream-1", stream));
+
+    // a stream can't be requested with a different mode
+    EXPECT_EQ(streamManager->requestStreamHandler("stream-1", MessageStream::Mode::WRITE), nullptr);
+
+    EXPECT_EQ(streamManager->requestStreamHandler("stream-1", MessageStream::Mode::READ), stream);
+    EXPECT_EQ(streamManager->requestStreamHandler("stream-1", MessageStream::Mode::READ), nullptr);
+    EXPECT_FALSE(streamManager->unregisterStreamHandler("stream-1"));
+}
+
+TEST(StreamManagerImplTest, persistentStreamIsReused) {
+    auto streamManager = StreamManagerImpl::create();
+    auto stream = RingBufferMessageStream::create(16, MessageStream::Mode::WRITE);
+    ASSERT_TRUE(streamManager->registerStreamHandler("pooled", stream, true));
+
+    EXPECT_EQ(streamManager->requestStreamHandler("pooled", MessageStream::Mode::WRITE), stream);
+    EXPECT_EQ(streamManager->requestStreamHandler("pooled", MessageStream::Mode::WRITE), stream);
+
+    EXPECT_TRUE(streamManager->unregisterStreamHandler("pooled"));
+    EXPECT_EQ(streamManager->requestStreamHandler("pooled", MessageStream::Mode::WRITE), nullptr);
+}
+
+TEST(StreamManagerImplTest, shutdownReleasesStreams) {
+    auto streamManager = StreamManagerImpl::create();
+    auto stream = RingBufferMessageStream::create(16);
+    ASSERT_TRUE(streamManager->registerStreamHandler("pooled", stream, true));
+
+    streamManager->shutdown();
+    EXPECT_EQ(stream.use_count(), 1);
+    EXPECT_EQ(streamManager->requestStreamHandler("pooled", MessageStream::Mode::READ), nullptr);
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <AACE/Engine/Logger/LogEntry.h>
+#include <AACE/Engine/Logger/Sinks/SyslogSink.h>
+
+using aace::engine::logger::LogEntry;
+using aace::engine::logger::sink::Sink;
+using aace::engine::logger::sink::SyslogSink;
+using Level = Sink::Level;
+
+/// Test harness for @c SyslogSink class, which receives the syslog messages on a local socket
+class SyslogSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char path[] = "/tmp/aace-syslog-sink-XXXXXX";
+        ASSERT_NE(mkdtemp(path), nullptr);
+        m_path = path;
+        m_socketPath = m_path + "/log";
+
+        m_socket = socket(AF_UNIX, SOCK_DGRAM, 0);
+        ASSERT_GE(m_socket, 0);
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_socketPath.c_str(), sizeof(address.sun_path) - 1);
+        ASSERT_EQ(bind(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    }
+
+    void TearDown() override {
+        if (m_socket >= 0) {
+            close(m_socket);
+        }
+        unlink(m_socketPath.c_str());
+        rmdir(m_path.c_str());
+    }
+
+    /// Returns the messages received within the timeout
+    std::vector<std::string> receive(int timeoutMs = 0) {
+        std::vector<std::string> messages;
+        pollfd fd = {m_socket, POLLIN, 0};
+        while (poll(&fd, 1, messages.empty() ? timeoutMs : 0) > 0) {
+            char buffer[4096];
+            auto size = recv(m_socket, buffer, sizeof(buffer), 0);
+            if (size < 0) {
+                break;
+            }
+            messages.emplace_back(buffer, static_cast<size_t>(size));
+        }
+        return messages;
+    }
+
+    void log(const std::shared_ptr<Sink>& sink, Level level, const LogEntry& entry) {
+        sink->log(level, std::chrono::system_clock::now(), "AAC", "1", entry.c_str());
+    }
+
+    std::string m_path;
+    std::string m_socketPath;
+    int m_socket = -1;
+};
+
+TEST_F(SyslogSinkTest, sendsFullBatches) {
+    std::shared_ptr<Sink> sink = SyslogSink::create("test", 3, std::chrono::milliseconds(0), m_socketPath);
+    ASSERT_NE(sink, nullptr);
+
+    log(sink, Level::INFO, LogEntry("aace.test", "first"));
+    log(sink, Level::WARN, LogEntry("aace.test", "second"));
+    EXPECT_TRUE(receive().empty());
+    log(sink, Level::VERBOSE, LogEntry("aace.test", "third"));
+
+    auto messages = receive(1000);
+    ASSERT_EQ(messages.size(), 3u);
+    // the priority is the user facility and the severity of the level
+    EXPECT_EQ(messages[0].find("<14>"), 0u);
+    EXPECT_EQ(messages[1].find("<12>"), 0u);
+    EXPECT_EQ(messages[2].find("<15>"), 0u);
+    EXPECT_NE(messages[0].find("[" + std::to_string(getpid()) + "]: "), std::string::npos);
+    EXPECT_NE(messages[0].find("first"), std::string::npos);
+    EXPECT_NE(messages[2].find("third"), std::string::npos);
+}
+
+TEST_F(SyslogSinkTest, sendsErrorsAndFlushedBatches) {
+    std::shared_ptr<Sink> sink = SyslogSink::create("test", 10, std::chrono::milliseconds(0), m_socketPath);
+    ASSERT_NE(sink, nullptr);
+
+    log(sink, Level::INFO, LogEntry("aace.test", "before"));
+    log(sink, Level::ERROR, LogEntry("aace.test", "failure"));
+    auto messages = receive(1000);
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[1].find("<11>"), 0u);
+
+    log(sink, Level::INFO, LogEntry("aace.test", "after"));
+    sink->flush();
+    messages = receive(1000);
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_NE(messages[0].find("after"), std::string::npos);
+}
+
+TEST_F(SyslogSinkTest, sendsBatchEveryFlushInterval) {
+    std::shared_ptr<Sink> sink = SyslogSink::create("test", 10, std::chrono::milliseconds(20), m_socketPath);
+    ASSERT_NE(sink, nullptr);
+
+    log(sink, Level::INFO, LogEntry("aace.test", "delayed"));
+    auto messages = receive(2000);
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_NE(messages[0].find("delayed"), std::string::npos);
+}
+
+TEST_F(SyslogSinkTest, rejectsInvalidSocketPath) {
+    EXPECT_EQ(SyslogSink::create("test", 10, std::chrono::milliseconds(0), std::string(200, 'x')), nullptr);
+}
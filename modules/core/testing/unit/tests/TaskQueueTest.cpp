@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/TaskQueue.h>
+#include <AACE/Engine/Utils/Threading/UniqueTask.h>
+
+using aace::engine::utils::threading::Executor;
+using aace::engine::utils::threading::TaskQueue;
+using aace::engine::utils::threading::UniqueTask;
+
+/// A callable that can be moved but not copied
+struct MoveOnlyCallable {
+    std::unique_ptr<int> value;
+    int* result;
+
+    void operator()() {
+        *result = *value;
+    }
+};
+
+TEST(UniqueTaskTest, holdsMoveOnlyCallables) {
+    int result = 0;
+    UniqueTask task(MoveOnlyCallable{std::unique_ptr<int>(new int(1)), &result});
+    ASSERT_TRUE(static_cast<bool>(task));
+
+    UniqueTask moved(std::move(task));
+    EXPECT_FALSE(static_cast<bool>(task));
+    moved();
+    EXPECT_EQ(result, 1);
+
+    moved.reset();
+    EXPECT_FALSE(static_cast<bool>(moved));
+}
+
+TEST(UniqueTaskTest, destroysLargeCallables) {
+    auto counter = std::make_shared<int>(0);
+    std::array<char, UniqueTask::INLINE_SIZE * 2> padding{};
+    {
+        // too large to be stored inline, so the callable is moved to the heap
+        UniqueTask task([counter, padding]() { (*counter)++; });
+        UniqueTask other;
+        other = std::move(task);
+        other();
+        EXPECT_EQ(counter.use_count(), 2);
+    }
+    EXPECT_EQ(*counter, 1);
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(TaskQueueTest, postKeepsOrder) {
+    TaskQueue queue;
+    std::vector<int> order;
+    for (int j = 1; j <= 40; j++) {
+        ASSERT_TRUE(queue.post([&order, j]() { order.push_back(j); }));
+    }
+    ASSERT_TRUE(queue.postToFront([&order]() { order.push_back(0); }));
+    EXPECT_EQ(queue.size(), 41u);
+
+    while (auto task = queue.tryPop()) {
+        task();
+    }
+    ASSERT_EQ(order.size(), 41u);
+    for (int j = 0; j <= 40; j++) {
+        EXPECT_EQ(order[j], j);
+    }
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(TaskQueueTest, shutdownDropsTasks) {
+    TaskQueue queue;
+    auto counter = std::make_shared<int>(0);
+    ASSERT_TRUE(queue.post([counter]() {}));
+    queue.shutdown();
+    EXPECT_EQ(counter.use_count(), 1);
+    EXPECT_FALSE(queue.post([counter]() {}));
+    EXPECT_FALSE(static_cast<bool>(queue.pop()));
+}
+
+TEST(TaskQueueTest, executorPost) {
+    Executor executor;
+    std::promise<std::string> promise;
+    EXPECT_TRUE(executor.post([&promise]() { promise.set_value("done"); }));
+    EXPECT_EQ(promise.get_future().get(), "done");
+
+    executor.shutdown();
+    EXPECT_FALSE(executor.post([]() {}));
+}
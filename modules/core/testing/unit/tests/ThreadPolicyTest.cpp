@@ -0,0 +1,129 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <future>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+
+using aace::engine::utils::threading::Executor;
+using aace::engine::utils::threading::ThreadPolicy;
+
+class ThreadPolicyTest : public ::testing::Test {
+public:
+    void TearDown() override {
+        ThreadPolicy::clearPolicies();
+    }
+};
+
+TEST_F(ThreadPolicyTest, matchesNamesAndPrefixes) {
+    EXPECT_TRUE(ThreadPolicy::matches("SystemAudio.AudioOutput.TTS", "SystemAudio.AudioOutput.TTS"));
+    EXPECT_FALSE(ThreadPolicy::matches("SystemAudio.AudioOutput.TTS", "SystemAudio.AudioOutput.Music"));
+    EXPECT_TRUE(ThreadPolicy::matches("SystemAudio.*", "SystemAudio.AudioOutput.TTS"));
+    EXPECT_TRUE(ThreadPolicy::matches("*", "AddressBook.uploader"));
+    EXPECT_FALSE(ThreadPolicy::matches("SystemAudio.*", "System"));
+}
+
+TEST_F(ThreadPolicyTest, parsesScheduling) {
+    ThreadPolicy::Scheduling scheduling;
+    ASSERT_TRUE(ThreadPolicy::parseScheduling("FIFO", scheduling));
+    EXPECT_EQ(scheduling, ThreadPolicy::Scheduling::FIFO);
+    ASSERT_TRUE(ThreadPolicy::parseScheduling("rr", scheduling));
+    EXPECT_EQ(scheduling, ThreadPolicy::Scheduling::RR);
+    ASSERT_TRUE(ThreadPolicy::parseScheduling("Other", scheduling));
+    EXPECT_EQ(scheduling, ThreadPolicy::Scheduling::OTHER);
+    EXPECT_FALSE(ThreadPolicy::parseScheduling("batch", scheduling));
+}
+
+#if defined(__linux__)
+
+static int getNice() {
+    return getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+}
+
+TEST_F(ThreadPolicyTest, appliesPolicyToNewThread) {
+    // the first cpu the process may run on
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) {
+        cpu++;
+    }
+
+    ThreadPolicy::Policy policy;
+    policy.hasNice = true;
+    policy.nice = 10;
+    policy.cpus = {cpu};
+    ThreadPolicy::setPolicy("ThreadPolicyTest.*", policy);
+
+    Executor executor("ThreadPolicyTest.executor");
+    auto result = executor.submit([cpu]() {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        sched_getaffinity(0, sizeof(cpus), &cpus);
+        return std::make_pair(getNice(), CPU_COUNT(&cpus) == 1 && CPU_ISSET(cpu, &cpus));
+    });
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    auto applied = result.get();
+    EXPECT_EQ(applied.first, 10);
+    EXPECT_TRUE(applied.second);
+}
+
+TEST_F(ThreadPolicyTest, appliesPolicyToRunningThread) {
+    Executor executor("ThreadPolicyTest.running");
+    auto before = executor.submit([]() { return getNice(); });
+    ASSERT_EQ(before.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    auto nice = before.get();
+
+    // the exact name is preferred to the prefix
+    ThreadPolicy::Policy prefixPolicy;
+    prefixPolicy.hasNice = true;
+    prefixPolicy.nice = std::min(nice + 1, 19);
+    ThreadPolicy::Policy namePolicy;
+    namePolicy.hasNice = true;
+    namePolicy.nice = std::min(nice + 2, 19);
+    ThreadPolicy::setPolicy("ThreadPolicyTest.running", namePolicy);
+    ThreadPolicy::setPolicy("ThreadPolicyTest.*", prefixPolicy);
+
+    auto after = executor.submit([]() { return getNice(); });
+    ASSERT_EQ(after.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(after.get(), namePolicy.nice);
+}
+
+TEST_F(ThreadPolicyTest, unnamedThreadGetsNoPolicy) {
+    ThreadPolicy::Policy policy;
+    policy.hasNice = true;
+    policy.nice = 19;
+    ThreadPolicy::setPolicy("*", policy);
+
+    Executor executor;
+    auto nice = executor.submit([]() { return getNice(); });
+    ASSERT_EQ(nice.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_NE(nice.get(), 19);
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <AACE/Engine/Utils/Threading/ThreadPool.h>
+
+using aace::engine::utils::threading::ThreadPool;
+
+TEST(ThreadPoolTest, create) {
+    EXPECT_EQ(ThreadPool::create(0), nullptr);
+    auto pool = ThreadPool::create(3);
+    ASSERT_NE(pool, nullptr);
+    EXPECT_EQ(pool->getThreadCount(), 3u);
+    EXPECT_FALSE(pool->isWorkerThread());
+    EXPECT_GE(ThreadPool::getDefault()->getThreadCount(), 2u);
+
+    auto named = ThreadPool::create(2, "ThreadPoolTest");
+    ASSERT_NE(named, nullptr);
+    EXPECT_EQ(named->getThreadCount(), 2u);
+    std::promise<bool> ran;
+    ASSERT_TRUE(named->post([&ran, &named]() { ran.set_value(named->isWorkerThread()); }));
+    EXPECT_TRUE(ran.get_future().get());
+}
+
+TEST(ThreadPoolTest, runsPostedTasks) {
+    auto pool = ThreadPool::create(4);
+    std::atomic<int> count{0};
+    std::promise<void> done;
+    const int total = 10000;
+
+    for (int j = 0; j < total; j++) {
+        ASSERT_TRUE(pool->post([&count, &done, total]() {
+            if (++count == total) {
+                done.set_value();
+            }
+        }));
+    }
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_EQ(count, total);
+}
+
+TEST(ThreadPoolTest, idleWorkersStealTasks) {
+    auto pool = ThreadPool::create(4);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> count{0};
+    std::promise<void> done;
+    const int total = 8;
+
+    // the tasks posted by a worker are queued on that worker, so the other workers can only run
+    // them by stealing them while the worker is busy
+    pool->post([&]() {
+        EXPECT_TRUE(pool->isWorkerThread());
+        for (int j = 0; j < total; j++) {
+            pool->post([&]() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    threads.insert(std::this_thread::get_id());
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                if (++count == total) {
+                    done.set_value();
+                }
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_GT(threads.size(), 1u);
+}
+
+TEST(ThreadPoolTest, shutdownRefusesTasks) {
+    auto pool = ThreadPool::create(2);
+    pool->shutdown();
+    EXPECT_FALSE(pool->post([]() {}));
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+
+using aace::engine::utils::threading::TimerWheel;
+
+TEST(TimerWheelTest, create) {
+    EXPECT_EQ(TimerWheel::create(std::chrono::milliseconds(0)), nullptr);
+    EXPECT_NE(TimerWheel::create(), nullptr);
+    EXPECT_NE(TimerWheel::getDefault(), nullptr);
+}
+
+TEST(TimerWheelTest, submitAfterWaitsForDelay) {
+    auto timerWheel = TimerWheel::create(std::chrono::milliseconds(1));
+    std::promise<TimerWheel::Clock::time_point> promise;
+    auto start = TimerWheel::Clock::now();
+
+    auto id = timerWheel->submitAfter(
+        std::chrono::milliseconds(50), [&promise]() { promise.set_value(TimerWheel::Clock::now()); });
+    EXPECT_NE(id, TimerWheel::INVALID_TIMER);
+
+    auto future = promise.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_GE(future.get() - start, std::chrono::milliseconds(50));
+    EXPECT_FALSE(timerWheel->cancel(id));
+}
+
+TEST(TimerWheelTest, timersExpireInDeadlineOrder) {
+    auto timerWheel = TimerWheel::create(std::chrono::milliseconds(1));
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> done;
+
+    // the later timers start in the higher levels of the wheel and move down as they expire
+    std::vector<int> delays = {150, 5, 90, 64, 70, 1, 130, 20, 63, 100};
+    auto start = TimerWheel::Clock::now();
+    for (auto delay : delays) {
+        timerWheel->submitAt(start + std::chrono::milliseconds(delay), [&, delay]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(delay);
+            if (order.size() == delays.size()) {
+                done.set_value();
+            }
+        });
+    }
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    std::sort(delays.begin(), delays.end());
+    EXPECT_EQ(order, delays);
+    EXPECT_EQ(timerWheel->size(), 0u);
+}
+
+TEST(TimerWheelTest, cancelPendingTimer) {
+    auto timerWheel = TimerWheel::create(std::chrono::milliseconds(1));
+    std::atomic<bool> ran{false};
+    std::promise<void> done;
+
+    auto id = timerWheel->submitAfter(std::chrono::milliseconds(20), [&ran]() { ran = true; });
+    timerWheel->submitAfter(std::chrono::milliseconds(40), [&done]() { done.set_value(); });
+    EXPECT_TRUE(timerWheel->cancel(id));
+    EXPECT_FALSE(timerWheel->cancel(id));
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_FALSE(ran);
+}
+
+TEST(TimerWheelTest, periodicTimerRunsUntilCancelled) {
+    auto timerWheel = TimerWheel::create(std::chrono::milliseconds(1));
+    std::atomic<int> count{0};
+    std::promise<void> done;
+
+    auto id = timerWheel->submitPeriodic(std::chrono::milliseconds(5), [&count, &done]() {
+        if (++count == 3) {
+            done.set_value();
+        }
+    });
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_TRUE(timerWheel->cancel(id));
+
+    // the timer may be running while it is cancelled, but doesn't run again
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto cancelledCount = count.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(count, cancelledCount);
+    EXPECT_LE(cancelledCount, 4);
+}
+
+TEST(TimerWheelTest, shutdownCancelsTimers) {
+    auto timerWheel = TimerWheel::create(std::chrono::milliseconds(1));
+    auto counter = std::make_shared<int>(0);
+    timerWheel->submitAfter(std::chrono::seconds(60), [counter]() { (*counter)++; });
+    EXPECT_EQ(timerWheel->size(), 1u);
+
+    timerWheel->shutdown();
+    EXPECT_EQ(timerWheel->size(), 0u);
+    EXPECT_EQ(counter.use_count(), 1);
+    EXPECT_EQ(timerWheel->submitAfter(std::chrono::milliseconds(1), []() {}), TimerWheel::INVALID_TIMER);
+}
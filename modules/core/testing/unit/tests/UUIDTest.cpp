@@ -0,0 +1,80 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cctype>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <AACE/Engine/Utils/UUID/UUID.h>
+
+using aace::engine::utils::uuid::compare;
+using aace::engine::utils::uuid::generateUUID;
+
+static bool isHexDigit(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+}
+
+TEST(UUIDTest, generateUUIDFormat) {
+    for (int i = 0; i < 1000; i++) {
+        auto uuid = generateUUID();
+        ASSERT_EQ(uuid.size(), 36u);
+        for (size_t pos = 0; pos < uuid.size(); pos++) {
+            if (pos == 8 || pos == 13 || pos == 18 || pos == 23) {
+                ASSERT_EQ(uuid[pos], '-') << uuid;
+            } else {
+                ASSERT_TRUE(isHexDigit(uuid[pos])) << uuid;
+            }
+        }
+        // version 4, variant 1
+        ASSERT_EQ(uuid[14], '4') << uuid;
+        ASSERT_NE(std::string("89ab").find(uuid[19]), std::string::npos) << uuid;
+    }
+}
+
+TEST(UUIDTest, generateUUIDIsUniqueAcrossThreads) {
+    const size_t threadCount = 8;
+    const size_t uuidsPerThread = 10000;
+    std::mutex mutex;
+    std::unordered_set<std::string> uuids;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&]() {
+            std::vector<std::string> generated;
+            for (size_t i = 0; i < uuidsPerThread; i++) {
+                generated.push_back(generateUUID());
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            uuids.insert(generated.begin(), generated.end());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(uuids.size(), threadCount * uuidsPerThread);
+}
+
+TEST(UUIDTest, compareIgnoresCase) {
+    auto uuid = generateUUID();
+    auto upper = uuid;
+    for (auto& c : upper) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    EXPECT_TRUE(compare(uuid, upper));
+    EXPECT_FALSE(compare(uuid, generateUUID()));
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <AACE/Engine/Audio/VoiceActivityGate.h>
+
+using aace::engine::audio::VoiceActivityGate;
+
+// 10 ms of 16 kHz audio
+static const size_t BLOCK_SIZE = 160;
+
+class VoiceActivityGateTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_writer = [this](const int16_t* data, size_t size) -> ssize_t {
+            m_written.insert(m_written.end(), data, data + size);
+            return static_cast<ssize_t>(size);
+        };
+    }
+
+    // blocks of a square wave, whose first sample is the index of the block
+    static std::vector<int16_t> createBlocks(size_t count, int16_t amplitude, int16_t firstBlock) {
+        std::vector<int16_t> samples(count * BLOCK_SIZE);
+        for (size_t j = 0; j < samples.size(); j++) {
+            samples[j] = static_cast<int16_t>(j % 2 == 0 ? amplitude : -amplitude);
+        }
+        for (size_t j = 0; j < count; j++) {
+            samples[j * BLOCK_SIZE] = static_cast<int16_t>(firstBlock + j);
+        }
+        return samples;
+    }
+
+protected:
+    VoiceActivityGate::Writer m_writer;
+    std::vector<int16_t> m_written;
+};
+
+TEST_F(VoiceActivityGateTest, holdsBackSilenceAndWritesPreRollOnOnset) {
+    // 30 ms of pre-roll, and 20 ms of hangover
+    auto gate = VoiceActivityGate::create(
+        16000, {true, -50.0f, std::chrono::milliseconds(30), std::chrono::milliseconds(20)});
+    ASSERT_NE(gate, nullptr);
+
+    auto silence = createBlocks(10, 0, 0);
+    EXPECT_EQ(gate->process(silence.data(), silence.size(), false, m_writer), static_cast<ssize_t>(silence.size()));
+    EXPECT_FALSE(gate->isOpen());
+    EXPECT_TRUE(m_written.empty());
+
+    // the speech is written after the last 3 blocks of silence
+    auto speech = createBlocks(2, 1000, 10);
+    EXPECT_EQ(gate->process(speech.data(), speech.size(), false, m_writer), static_cast<ssize_t>(speech.size()));
+    EXPECT_TRUE(gate->isOpen());
+    ASSERT_EQ(m_written.size(), 5 * BLOCK_SIZE);
+    std::vector<int16_t> expected(silence.end() - 3 * BLOCK_SIZE, silence.end());
+    expected.insert(expected.end(), speech.begin(), speech.end());
+    EXPECT_EQ(m_written, expected);
+
+    // the silence after the speech is written until the hangover time
+    m_written.clear();
+    silence = createBlocks(5, 0, 12);
+    gate->process(silence.data(), silence.size(), false, m_writer);
+    EXPECT_FALSE(gate->isOpen());
+    EXPECT_EQ(m_written, std::vector<int16_t>(silence.begin(), silence.begin() + 2 * BLOCK_SIZE));
+}
+
+TEST_F(VoiceActivityGateTest, bypassWritesAllAudio) {
+    auto gate = VoiceActivityGate::create(16000, {true});
+    ASSERT_NE(gate, nullptr);
+
+    auto silence = createBlocks(10, 0, 0);
+    gate->process(silence.data(), silence.size(), false, m_writer);
+    EXPECT_TRUE(m_written.empty());
+
+    // the silence of a capture is written, without the audio held back before it
+    gate->process(silence.data(), silence.size(), true, m_writer);
+    EXPECT_TRUE(gate->isOpen());
+    EXPECT_EQ(m_written, silence);
+
+    // and the gate closes after the hangover once the capture is over
+    m_written.clear();
+    auto hangover = createBlocks(110, 0, 0);
+    gate->process(hangover.data(), hangover.size(), false, m_writer);
+    EXPECT_FALSE(gate->isOpen());
+    EXPECT_EQ(m_written.size(), 100 * BLOCK_SIZE);
+}
+
+TEST_F(VoiceActivityGateTest, reportsWriteErrors) {
+    auto gate = VoiceActivityGate::create(16000, {true});
+    ASSERT_NE(gate, nullptr);
+
+    auto speech = createBlocks(1, 1000, 0);
+    EXPECT_EQ(gate->process(speech.data(), speech.size(), false, [](const int16_t*, size_t) { return -1; }), -1);
+    EXPECT_EQ(VoiceActivityGate::create(0, {true}), nullptr);
+    EXPECT_EQ(VoiceActivityGate::create(16000, {true, -50.0f, std::chrono::milliseconds(-1)}), nullptr);
+}
@@ -22,6 +22,7 @@
 #include <AASB/Message/CustomDomain/CustomDomain/ReportDirectiveHandlingResultMessage.h>
 #include <AASB/Message/CustomDomain/CustomDomain/ResultType.h>
 #include <AASB/Message/CustomDomain/CustomDomain/SendEventMessage.h>
+#include <AASB/Message/CustomDomain/CustomDomain/UpdateContextMessage.h>
 
 namespace aasb {
 namespace engine {
@@ -80,6 +81,21 @@ bool AASBCustomDomain::initialize(std::shared_ptr<aace::engine::messageBroker::M
                 }
             });
 
+        messageBroker->subscribe(
+            aasb::message::customDomain::customDomain::UpdateContextMessage::topic(),
+            aasb::message::customDomain::customDomain::UpdateContextMessage::action(),
+            [wp](const Message& message) {
+                try {
+                    auto sp = wp.lock();
+                    ThrowIfNull(sp, "invalidWeakPtrReference");
+                    aasb::message::customDomain::customDomain::UpdateContextMessage::Payload payload =
+                        nlohmann::json::parse(message.payload());
+                    sp->updateContext(payload.contextNamespace, payload.customContext);
+                } catch (std::exception& ex) {
+                    AACE_ERROR(LX(TAG).d("reason", ex.what()));
+                }
+            });
+
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "initialize").d("reason", ex.what()));
@@ -154,6 +154,23 @@ JNIEXPORT void JNICALL Java_com_amazon_aace_customDomain_CustomDomain_sendEvent(
     }
 }
 
+JNIEXPORT void JNICALL Java_com_amazon_aace_customDomain_CustomDomain_updateContext(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong ref,
+    jstring contextNamespace,
+    jstring customContext) {
+    try {
+        auto customDomainBinder = CUSTOM_DOMAIN_BINDER(ref);
+        ThrowIfNull(customDomainBinder, "invalidCustomDomainBinder");
+
+        customDomainBinder->getCustomDomain()->updateContext(
+            JString(contextNamespace).toStdStr(), JString(customContext).toStdStr());
+    } catch (const std::exception& ex) {
+        AACE_JNI_ERROR(TAG, __func__, ex.what());
+    }
+}
+
 JNIEXPORT void JNICALL Java_com_amazon_aace_customDomain_CustomDomain_reportDirectiveHandlingResult(
     JNIEnv* env,
     jobject /* this */,
@@ -202,6 +202,22 @@ abstract public class CustomDomain extends PlatformInterface {
         sendEvent(getNativeRef(), eventNamespace, name, payload, requiresContext, correlationToken, customContext);
     }
 
+    /**
+     * Notifies the engine about the current custom states under @c contextNamespace.
+     *
+     * When @c contextTimeToLiveInMilliseconds is configured for the interface, the engine serves the last context
+     * notified by this method to the context requests for the configured time, instead of calling
+     * @c getContext() and waiting for its result. The context should be notified when the interface is registered
+     * and whenever the states change.
+     *
+     * @param contextNamespace The namespace of the context.
+     * @param customContext The context corresponding to @a contextNamespace, in the JSON structure described in
+     * @c getContext().
+     */
+    public final void updateContext(String contextNamespace, String customContext) {
+        updateContext(getNativeRef(), contextNamespace, customContext);
+    }
+
     // NativeRef implementation
     final protected long createNativeRef() {
         return createBinder();
@@ -216,6 +232,7 @@ abstract public class CustomDomain extends PlatformInterface {
     private native void disposeBinder(long nativeRef);
     private native void sendEvent(long nativeRef, String eventNamespace, String name, String payload,
             boolean requiresContext, String correlationToken, String customContext);
+    private native void updateContext(long nativeRef, String contextNamespace, String customContext);
     private native void reportDirectiveHandlingResult(
             long nativeRef, String directiveNamespace, String messageId, ResultType result);
 }
\ No newline at end of file
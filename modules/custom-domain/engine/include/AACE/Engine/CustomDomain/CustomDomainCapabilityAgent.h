@@ -16,6 +16,8 @@
 #ifndef AACE_ENGINE_CUSTOMDOMAIN_CUSTOMDOMAIN_CAPABILITY_AGENT_H
 #define AACE_ENGINE_CUSTOMDOMAIN_CUSTOMDOMAIN_CAPABILITY_AGENT_H
 
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <unordered_map>
 
@@ -59,6 +61,12 @@ public:
      * @param exceptionSender Interface to report exceptions to AVS.
      * @param contextManager Interface to provide custom state to AVS.
      * @param messageSender Interface to send events to AVS.
+     * @param contextTimeToLive How long the context pushed with @c updateContext() is served to the context
+     * requests. A positive value enables the cache-first mode, in which the context requests never wait for the
+     * platform. Zero queries the platform on each context request.
+     * @param maxConcurrentDirectives The most directives handled by the platform at the same time. A positive value
+     * also handles the directives of a dialog request one at a time, in order, each after the result of the previous
+     * one is reported. Zero hands each directive to the platform as soon as it is received.
      * @return A new instance of @c CustomDomainCapabilityAgent on success, @c nullptr otherwise.
      */
     static std::shared_ptr<CustomDomainCapabilityAgent> create(
@@ -68,7 +76,9 @@ public:
         std::shared_ptr<CustomDomainHandlerInterface> customDomainHandler,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender);
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
+        std::chrono::milliseconds contextTimeToLive = std::chrono::milliseconds::zero(),
+        size_t maxConcurrentDirectives = 0);
 
     /// @name CapabilityAgent Functions
     /// @{
@@ -143,7 +153,22 @@ public:
         alexaClientSDK::avsCommon::avs::ExceptionErrorType errorType =
             alexaClientSDK::avsCommon::avs::ExceptionErrorType::INTERNAL_ERROR);
 
+    /**
+     * Caches the context pushed by the platform, which is served to the context requests for
+     * @c contextTimeToLive in the cache-first mode.
+     * @param customContext The context for this namespace in string
+     */
+    void updateContext(const std::string& customContext);
+
 private:
+    /** 
+     * Maps CapabilityTag (representing a state name) to the corresponding state.
+     */
+    using StatesMap = std::
+        unordered_map<alexaClientSDK::avsCommon::avs::CapabilityTag, alexaClientSDK::avsCommon::avs::CapabilityState>;
+
+    using ContextRequestState = std::pair<alexaClientSDK::avsCommon::sdkInterfaces::ContextRequestToken, StatesMap>;
+
     /**
      * Constructor.
      * @param exceptionSender Interface to report exceptions to AVS.
@@ -152,6 +177,8 @@ private:
      * @param customDomainHandler Handler to handle the directives and getContext() requests.
      * @param interfaceNamespace The namespace of the capability interface.
      * @param interfaceVersion The version of the capability interface. 
+     * @param contextTimeToLive How long the pushed context is served, or zero to disable the cache-first mode.
+     * @param maxConcurrentDirectives The most directives handled at the same time, or zero for no limit.
      */
     CustomDomainCapabilityAgent(
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
@@ -159,7 +186,9 @@ private:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
         std::shared_ptr<CustomDomainHandlerInterface> customDomainHandler,
         const std::string& interfaceNamespace,
-        const std::string& interfaceVersion);
+        const std::string& interfaceVersion,
+        std::chrono::milliseconds contextTimeToLive,
+        size_t maxConcurrentDirectives);
 
     /**
      * Initialize capability configuration & set provider for the states.
@@ -176,6 +205,13 @@ private:
         const alexaClientSDK::avsCommon::avs::CapabilityTag& stateProviderName,
         const alexaClientSDK::avsCommon::sdkInterfaces::ContextRequestToken contextRequestToken);
 
+    /**
+     * Parse the given context in string.
+     * @param customContext The context for this namespace in string
+     * @param [out] statesMap The parsed states
+     */
+    bool parseContext(const std::string& customContext, StatesMap& statesMap);
+
     /**
      * Parse the given context in string and update the cache.
      * @param customContext The context for this namespace in string
@@ -192,6 +228,45 @@ private:
     bool getCandidateContextIfAvailable(
         const alexaClientSDK::avsCommon::sdkInterfaces::ContextRequestToken contextRequestToken);
 
+    /**
+     * Check if the context cached in the cache-first mode is fresh.
+     * @param contextRequestToken The token of the current context request
+     */
+    bool getCachedContextIfFresh(
+        const alexaClientSDK::avsCommon::sdkInterfaces::ContextRequestToken contextRequestToken);
+
+    /**
+     * Update the context cached in the cache-first mode.
+     * @param statesMap The states of the context
+     */
+    void cacheContext(const StatesMap& statesMap);
+
+    /**
+     * Query the context from the device on the refresh executor, so the context requests don't wait for it.
+     */
+    void refreshCachedContext();
+
+    /**
+     * Hand a directive to the platform.
+     * @param info The @c DirectiveInfo of the directive.
+     */
+    void dispatchDirective(std::shared_ptr<DirectiveInfo> info);
+
+    /**
+     * Hand the queued directives to the platform, in order, while fewer than @c m_maxConcurrentDirectives are being
+     * handled. A directive waits for the directive of the same dialog request being handled, and for the directives
+     * of the same dialog request queued before it.
+     */
+    void dispatchQueuedDirectives();
+
+    /**
+     * Release the dialog request of a directive whose handling completed, and dispatch the queued directives.
+     * The queued directives of a failed dialog request are dropped, since they are cancelled.
+     * @param info The @c DirectiveInfo of the completed directive.
+     * @param succeeded Whether the handling of the directive succeeded.
+     */
+    void completeDirective(std::shared_ptr<DirectiveInfo> info, bool succeeded);
+
     /**
      * Remove a directive from the map of message IDs to @c DirectiveInfo instances.
      * @param [in] info The @c DirectiveInfo containing the @c AVSDirective whose message ID is to be removed.
@@ -223,13 +298,11 @@ private:
     /// The version of the interface
     const std::string m_interfaceVersion;
 
-    /** 
-     * Maps CapabilityTag (representing a state name) to the corresponding state.
-     */
-    using StatesMap = std::
-        unordered_map<alexaClientSDK::avsCommon::avs::CapabilityTag, alexaClientSDK::avsCommon::avs::CapabilityState>;
+    /// How long the cached context is served, zero when the cache-first mode is disabled
+    const std::chrono::milliseconds m_contextTimeToLive;
 
-    using ContextRequestState = std::pair<alexaClientSDK::avsCommon::sdkInterfaces::ContextRequestToken, StatesMap>;
+    /// The most directives handled by the platform at the same time, zero when they are not queued
+    const size_t m_maxConcurrentDirectives;
 
     /**
      * Caches the context request token with its states being queried by Context Manager. It will be updated every time when Context Manager
@@ -256,8 +329,25 @@ private:
      */
     std::unordered_map<std::string, std::shared_ptr<CapabilityAgent::DirectiveInfo>> m_pendingDirectives;
 
+    /// The directives waiting to be handed to the platform, in the order they were received
+    std::deque<std::shared_ptr<CapabilityAgent::DirectiveInfo>> m_queuedDirectives;
+
+    /// The dialog request IDs of the directives being handled by the platform
+    std::unordered_set<std::string> m_activeDialogRequestIds;
+
     /// Vector of the state names this interface reports in its context
     std::unordered_set<alexaClientSDK::avsCommon::avs::NamespaceAndName> m_states;
+
+    /// The last known context in the cache-first mode, and the time it was received
+    StatesMap m_cachedContext;
+    std::chrono::steady_clock::time_point m_cachedContextTime;
+    bool m_hasCachedContext;
+
+    /// Whether a context query is in progress on @c m_contextRefreshExecutor
+    bool m_contextRefreshPending;
+
+    /// An executor used for querying the context from the device in the cache-first mode.
+    alexaClientSDK::avsCommon::utils::threading::Executor m_contextRefreshExecutor;
 };
 
 }  // namespace customDomain
@@ -54,7 +54,9 @@ private:
      *   {
      *      "namespace": {{String}},
      *      "version": {{String}},
-     *      "states": [{{String}}, {{String}}, ...]      
+     *      "states": [{{String}}, {{String}}, ...],
+     *      "contextTimeToLiveInMilliseconds": {{Integer}},
+     *      "maxConcurrentDirectives": {{Integer}}
      *   },
      *   {
      *      "namespace": {{String}},
@@ -95,6 +97,7 @@ public:
         const std::string& directiveNamespace,
         const std::string& messageId,
         ResultType result) override;
+    void onUpdateContext(const std::string& contextNamespace, const std::string& customContext) override;
     /// @}
 
     /// @name CustomDomainHandlerInterface
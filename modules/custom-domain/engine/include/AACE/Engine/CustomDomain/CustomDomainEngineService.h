@@ -34,7 +34,7 @@ public:
     virtual ~CustomDomainEngineService() = default;
 
 protected:
-    bool configure(std::shared_ptr<std::istream> configuration) override;
+    bool configureFromJson(const aace::engine::utils::json::Value& configuration) override;
     bool shutdown() override;
     bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) override;
 
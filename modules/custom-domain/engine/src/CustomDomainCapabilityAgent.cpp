@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
 
 #include <AACE/Engine/Core/EngineMacros.h>
@@ -44,13 +45,19 @@ CustomDomainCapabilityAgent::CustomDomainCapabilityAgent(
     std::shared_ptr<MessageSenderInterface> messageSender,
     std::shared_ptr<CustomDomainHandlerInterface> customDomainHandler,
     const std::string& interfaceNamespace,
-    const std::string& interfaceVersion) :
+    const std::string& interfaceVersion,
+    std::chrono::milliseconds contextTimeToLive,
+    size_t maxConcurrentDirectives) :
         CapabilityAgent{interfaceNamespace, exceptionSender},
         RequiresShutdown{"CustomDomainCapabilityAgent"},
         m_contextManager{contextManager},
         m_messageSender{messageSender},
         m_customDomainHandler{customDomainHandler},
-        m_interfaceVersion{interfaceVersion} {
+        m_interfaceVersion{interfaceVersion},
+        m_contextTimeToLive{contextTimeToLive},
+        m_maxConcurrentDirectives{maxConcurrentDirectives},
+        m_hasCachedContext{false},
+        m_contextRefreshPending{false} {
 }
 
 std::shared_ptr<CustomDomainCapabilityAgent> CustomDomainCapabilityAgent::create(
@@ -60,7 +67,9 @@ std::shared_ptr<CustomDomainCapabilityAgent> CustomDomainCapabilityAgent::create
     std::shared_ptr<CustomDomainHandlerInterface> customDomainHandler,
     std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender,
     std::shared_ptr<ContextManagerInterface> contextManager,
-    std::shared_ptr<MessageSenderInterface> messageSender) {
+    std::shared_ptr<MessageSenderInterface> messageSender,
+    std::chrono::milliseconds contextTimeToLive,
+    size_t maxConcurrentDirectives) {
     try {
         ThrowIfNull(contextManager, "invalidContextManager");
         ThrowIfNull(exceptionSender, "invalidExceptionSender");
@@ -68,9 +77,17 @@ std::shared_ptr<CustomDomainCapabilityAgent> CustomDomainCapabilityAgent::create
         ThrowIfNull(customDomainHandler, "invalidCustomDomainHandler");
         ThrowIf(interfaceNamespace.empty(), "invalidInterfaceNamespace");
         ThrowIf(interfaceVersion.empty(), "invalidInterfaceVersion");
+        ThrowIf(contextTimeToLive.count() < 0, "invalidContextTimeToLive");
 
         auto customDomainCapabilityAgent = std::shared_ptr<CustomDomainCapabilityAgent>(new CustomDomainCapabilityAgent(
-            exceptionSender, contextManager, messageSender, customDomainHandler, interfaceNamespace, interfaceVersion));
+            exceptionSender,
+            contextManager,
+            messageSender,
+            customDomainHandler,
+            interfaceNamespace,
+            interfaceVersion,
+            contextTimeToLive,
+            maxConcurrentDirectives));
 
         customDomainCapabilityAgent->initialize(states);
 
@@ -134,9 +151,12 @@ void CustomDomainCapabilityAgent::handleDirective(std::shared_ptr<DirectiveInfo>
             ThrowIf(correlationToken.empty(), "invalidCorrelationToken");
             auto messageId = info->directive->getMessageId();
             ThrowIf(messageId.empty(), "invalidMessageId");
-            m_customDomainHandler->handleDirective(
-                directiveNamespace, directiveName, info->directive->getPayload(), correlationToken, messageId);
-            m_pendingDirectives[messageId] = info;
+            if (m_maxConcurrentDirectives == 0) {
+                dispatchDirective(info);
+                return;
+            }
+            m_queuedDirectives.push_back(info);
+            dispatchQueuedDirectives();
         } catch (std::exception& ex) {
             AACE_ERROR(LX(TAG, "handleDirective").d("reason", ex.what()));
             sendExceptionEncounteredAndReportFailed(
@@ -147,6 +167,63 @@ void CustomDomainCapabilityAgent::handleDirective(std::shared_ptr<DirectiveInfo>
     });
 }
 
+void CustomDomainCapabilityAgent::dispatchDirective(std::shared_ptr<DirectiveInfo> info) {
+    auto directive = info->directive;
+    m_customDomainHandler->handleDirective(
+        directive->getNamespace(),
+        directive->getName(),
+        directive->getPayload(),
+        directive->getCorrelationToken(),
+        directive->getMessageId());
+    m_pendingDirectives[directive->getMessageId()] = info;
+    if (m_maxConcurrentDirectives > 0 && !directive->getDialogRequestId().empty()) {
+        m_activeDialogRequestIds.insert(directive->getDialogRequestId());
+    }
+}
+
+void CustomDomainCapabilityAgent::dispatchQueuedDirectives() {
+    // Dialog requests with a directive queued before the current one, which must be handled first
+    std::unordered_set<std::string> blockedDialogRequestIds;
+    auto it = m_queuedDirectives.begin();
+    while (it != m_queuedDirectives.end() && m_pendingDirectives.size() < m_maxConcurrentDirectives) {
+        auto info = *it;
+        auto dialogRequestId = info->directive->getDialogRequestId();
+        if (!dialogRequestId.empty() && (m_activeDialogRequestIds.count(dialogRequestId) > 0 ||
+                                         blockedDialogRequestIds.count(dialogRequestId) > 0)) {
+            blockedDialogRequestIds.insert(dialogRequestId);
+            ++it;
+            continue;
+        }
+        it = m_queuedDirectives.erase(it);
+        dispatchDirective(info);
+    }
+    AACE_DEBUG(LX(TAG)
+                   .d("namespace", m_namespace)
+                   .d("handling", m_pendingDirectives.size())
+                   .d("queued", m_queuedDirectives.size()));
+}
+
+void CustomDomainCapabilityAgent::completeDirective(std::shared_ptr<DirectiveInfo> info, bool succeeded) {
+    if (m_maxConcurrentDirectives == 0 || info == nullptr || info->directive == nullptr) {
+        return;
+    }
+    auto dialogRequestId = info->directive->getDialogRequestId();
+    if (!dialogRequestId.empty()) {
+        m_activeDialogRequestIds.erase(dialogRequestId);
+        if (!succeeded) {
+            m_queuedDirectives.erase(
+                std::remove_if(
+                    m_queuedDirectives.begin(),
+                    m_queuedDirectives.end(),
+                    [&dialogRequestId](const std::shared_ptr<DirectiveInfo>& queued) {
+                        return queued->directive->getDialogRequestId() == dialogRequestId;
+                    }),
+                m_queuedDirectives.end());
+        }
+    }
+    dispatchQueuedDirectives();
+}
+
 void CustomDomainCapabilityAgent::reportDirectiveHandlingResult(
     const std::string& messageId,
     bool succeeded,
@@ -174,6 +251,7 @@ void CustomDomainCapabilityAgent::reportDirectiveHandlingResult(
         }
 
         m_pendingDirectives.erase(messageId);
+        completeDirective(directiveInfo, succeeded);
     });
 }
 
@@ -189,8 +267,26 @@ void CustomDomainCapabilityAgent::cancelDirective(std::shared_ptr<DirectiveInfo>
             ThrowIf(correlationToken.empty(), "invalidCorrelationToken");
             auto messageId = info->directive->getMessageId();
             ThrowIf(messageId.empty(), "invalidMessageId");
+            if (m_maxConcurrentDirectives > 0) {
+                auto queued = std::find_if(
+                    m_queuedDirectives.begin(),
+                    m_queuedDirectives.end(),
+                    [&messageId](const std::shared_ptr<DirectiveInfo>& queuedInfo) {
+                        return queuedInfo->directive->getMessageId() == messageId;
+                    });
+                if (queued != m_queuedDirectives.end()) {
+                    // The platform was never asked to handle the directive
+                    m_queuedDirectives.erase(queued);
+                    return;
+                }
+                if (m_pendingDirectives.find(messageId) == m_pendingDirectives.end()) {
+                    AACE_DEBUG(LX(TAG, "cancelDirective").m("directiveNotHandled").d("messageId", messageId));
+                    return;
+                }
+            }
             m_customDomainHandler->cancelDirective(directiveNamespace, directiveName, correlationToken, messageId);
             m_pendingDirectives.erase(messageId);
+            completeDirective(info, false);
         } catch (std::exception& ex) {
             AACE_ERROR(LX(TAG, "cancelDirective").d("reason", ex.what()));
         }
@@ -235,12 +331,22 @@ void CustomDomainCapabilityAgent::executeProvideState(
     if (m_stateProviderCache.first != contextRequestToken) {
         // Check candidate cache first
         if (!getCandidateContextIfAvailable(contextRequestToken)) {
-            // If no candidate is available, query device instead
-            auto namespaceContext = m_customDomainHandler->getContext(m_namespace);
-            if (!parseAndUpdateContext(namespaceContext, contextRequestToken)) {
-                AACE_ERROR(LX(TAG, "executeProvideState").d("reason", "invalidContextFormat"));
-                m_contextManager->provideStateUnavailableResponse(stateProviderName, contextRequestToken, false);
-                return;
+            if (m_contextTimeToLive.count() > 0) {
+                // In the cache-first mode the context request never waits for the device
+                if (!getCachedContextIfFresh(contextRequestToken)) {
+                    AACE_WARN(LX(TAG, "executeProvideState").d("reason", "cachedContextUnavailable"));
+                    refreshCachedContext();
+                    m_contextManager->provideStateUnavailableResponse(stateProviderName, contextRequestToken, false);
+                    return;
+                }
+            } else {
+                // If no candidate is available, query device instead
+                auto namespaceContext = m_customDomainHandler->getContext(m_namespace);
+                if (!parseAndUpdateContext(namespaceContext, contextRequestToken)) {
+                    AACE_ERROR(LX(TAG, "executeProvideState").d("reason", "invalidContextFormat"));
+                    m_contextManager->provideStateUnavailableResponse(stateProviderName, contextRequestToken, false);
+                    return;
+                }
             }
         }
     }
@@ -267,15 +373,85 @@ bool CustomDomainCapabilityAgent::getCandidateContextIfAvailable(const ContextRe
     return result;
 }
 
+bool CustomDomainCapabilityAgent::getCachedContextIfFresh(const ContextRequestToken contextRequestToken) {
+    if (!m_hasCachedContext) {
+        AACE_DEBUG(LX(TAG).m("cachedContextNotAvailable").d("token", contextRequestToken));
+        return false;
+    }
+    auto age = std::chrono::steady_clock::now() - m_cachedContextTime;
+    if (age > m_contextTimeToLive) {
+        AACE_DEBUG(LX(TAG)
+                       .m("cachedContextExpired")
+                       .d("token", contextRequestToken)
+                       .d("ageInMilliseconds", std::chrono::duration_cast<std::chrono::milliseconds>(age).count()));
+        return false;
+    }
+    m_stateProviderCache = std::make_pair(contextRequestToken, m_cachedContext);
+    return true;
+}
+
+void CustomDomainCapabilityAgent::cacheContext(const StatesMap& statesMap) {
+    m_cachedContext = statesMap;
+    m_cachedContextTime = std::chrono::steady_clock::now();
+    m_hasCachedContext = true;
+}
+
+void CustomDomainCapabilityAgent::refreshCachedContext() {
+    if (m_contextRefreshPending) {
+        return;
+    }
+    m_contextRefreshPending = true;
+    m_contextRefreshExecutor.submit([this] {
+        auto customContext = m_customDomainHandler->getContext(m_namespace);
+        m_executor.submit([this, customContext] {
+            m_contextRefreshPending = false;
+            StatesMap statesMap;
+            if (parseContext(customContext, statesMap)) {
+                cacheContext(statesMap);
+            }
+        });
+    });
+}
+
+void CustomDomainCapabilityAgent::updateContext(const std::string& customContext) {
+    AACE_INFO(LX(TAG));
+    m_executor.submit([this, customContext] {
+        if (m_contextTimeToLive.count() == 0) {
+            AACE_WARN(LX(TAG, "updateContext").d("reason", "contextCacheDisabled").d("namespace", m_namespace));
+            return;
+        }
+        StatesMap statesMap;
+        if (!parseContext(customContext, statesMap)) {
+            AACE_ERROR(LX(TAG, "updateContext").d("reason", "invalidContextFormat"));
+            return;
+        }
+        cacheContext(statesMap);
+    });
+}
+
 bool CustomDomainCapabilityAgent::parseAndUpdateContext(
     const std::string& customContext,
     const ContextRequestToken contextRequestToken) {
+    StatesMap statesMap;
+    if (!parseContext(customContext, statesMap)) {
+        return false;
+    }
+
+    // Update m_stateProviderCache
+    m_stateProviderCache = std::make_pair(contextRequestToken, statesMap);
+    if (m_contextTimeToLive.count() > 0) {
+        cacheContext(statesMap);
+    }
+    return true;
+}
+
+bool CustomDomainCapabilityAgent::parseContext(const std::string& customContext, StatesMap& statesMap) {
     try {
         ThrowIf(customContext.empty(), "invalidContextProvided");
         auto contextJson = json::parse(customContext);
         ThrowIfNot(contextJson.contains("context") && contextJson["context"].is_array(), "invalidContextProvided");
 
-        StatesMap statesMap;
+        statesMap.clear();
         for (auto& state : contextJson["context"]) {
             // Parse
             ThrowIfNot(state.contains("name") && state["name"].is_string(), "invalidStateName");
@@ -285,7 +461,7 @@ bool CustomDomainCapabilityAgent::parseAndUpdateContext(
 
             if (m_states.find(NamespaceAndName{m_namespace, stateName}) == m_states.end()) {
                 // Skip the unknown state
-                AACE_ERROR(LX(TAG, "parseAndUpdateContext").m("unknownStateProvided"));
+                AACE_ERROR(LX(TAG, "parseContext").m("unknownStateProvided"));
                 continue;
             }
 
@@ -303,13 +479,10 @@ bool CustomDomainCapabilityAgent::parseAndUpdateContext(
             statesMap[NamespaceAndName{m_namespace, stateName}] =
                 CapabilityState{value.dump(), timeOfSample, uncertaintyInMilliseconds};
         }
-
-        // Update m_stateProviderCache
-        m_stateProviderCache = std::make_pair(contextRequestToken, statesMap);
         return true;
 
     } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG, "parseAndUpdateContext").d("reason", ex.what()));
+        AACE_ERROR(LX(TAG, "parseContext").d("reason", ex.what()));
         return false;
     }
 }
@@ -409,6 +582,7 @@ void CustomDomainCapabilityAgent::onExceptionReceived(const std::string& excepti
 }
 
 void CustomDomainCapabilityAgent::doShutdown() {
+    m_contextRefreshExecutor.shutdown();
     m_executor.shutdown();
     m_messageSender.reset();
     // Remove state provider
@@ -417,8 +591,11 @@ void CustomDomainCapabilityAgent::doShutdown() {
     }
     m_contextManager.reset();
     m_sendEventStateCache.clear();
+    m_cachedContext.clear();
     m_pendingEvents.clear();
     m_pendingDirectives.clear();
+    m_queuedDirectives.clear();
+    m_activeDialogRequestIds.clear();
     m_states.clear();
 }
 
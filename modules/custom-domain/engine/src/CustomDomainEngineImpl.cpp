@@ -39,12 +39,15 @@ static const std::string METRIC_CUSTOM_DOMAIN_CANCEL_DIRECTIVE = "CancelDirectiv
 static const std::string METRIC_CUSTOM_DOMAIN_REPORT_DIRECTIVE_HANDLING_RESULT = "ReportDirectiveHandlingResult";
 static const std::string METRIC_CUSTOM_DOMAIN_GET_CONTEXT = "GetContext";
 static const std::string METRIC_CUSTOM_DOMAIN_SEND_EVENT = "SendEvent";
+static const std::string METRIC_CUSTOM_DOMAIN_UPDATE_CONTEXT = "UpdateContext";
 
 /// String constants in configuration
 static const std::string INTERFACES = "interfaces";
 static const std::string NAMESPACE = "namespace";
 static const std::string VERSION = "version";
 static const std::string STATES = "states";
+static const std::string CONTEXT_TIME_TO_LIVE = "contextTimeToLiveInMilliseconds";
+static const std::string MAX_CONCURRENT_DIRECTIVES = "maxConcurrentDirectives";
 
 CustomDomainEngineImpl::CustomDomainEngineImpl(
     std::shared_ptr<aace::customDomain::CustomDomain> customDomainPlatformInterface) :
@@ -91,11 +94,34 @@ bool CustomDomainEngineImpl::initialize(
                 states = interface[STATES].get<std::vector<std::string>>();
             }
 
+            // Get the time to live of the context pushed by the platform, if the cache-first mode is enabled
+            std::chrono::milliseconds contextTimeToLive = std::chrono::milliseconds::zero();
+            if (interface.contains(CONTEXT_TIME_TO_LIVE)) {
+                ThrowIfNot(
+                    interface[CONTEXT_TIME_TO_LIVE].is_number_unsigned(), "invalidContextTimeToLiveInMilliseconds");
+                contextTimeToLive = std::chrono::milliseconds(interface[CONTEXT_TIME_TO_LIVE].get<uint64_t>());
+            }
+
+            // Get the most directives handled in parallel, if the directives are queued
+            size_t maxConcurrentDirectives = 0;
+            if (interface.contains(MAX_CONCURRENT_DIRECTIVES)) {
+                ThrowIfNot(interface[MAX_CONCURRENT_DIRECTIVES].is_number_unsigned(), "invalidMaxConcurrentDirectives");
+                maxConcurrentDirectives = interface[MAX_CONCURRENT_DIRECTIVES].get<size_t>();
+            }
+
             AACE_DEBUG(
                 LX(TAG).m("Creating Custom Domain capability agent").d("interfaceName", name).d("version", version));
 
             auto capabilityAgent = CustomDomainCapabilityAgent::create(
-                name, version, states, shared_from_this(), exceptionSender, contextManager, messageSender);
+                name,
+                version,
+                states,
+                shared_from_this(),
+                exceptionSender,
+                contextManager,
+                messageSender,
+                contextTimeToLive,
+                maxConcurrentDirectives);
             ThrowIfNull(capabilityAgent, "couldNotCreateCapabilityAgent");
 
             // Register capability with the default endpoint
@@ -254,6 +280,17 @@ void CustomDomainEngineImpl::onSendEvent(
     m_capabilityAgentMap[eventNamespace]->sendEvent(name, payload, requiresContext, correlationToken, customContext);
 }
 
+void CustomDomainEngineImpl::onUpdateContext(const std::string& contextNamespace, const std::string& customContext) {
+    AACE_INFO(LX(TAG));
+    emitCounterMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX, "onUpdateContext", {METRIC_CUSTOM_DOMAIN_UPDATE_CONTEXT, contextNamespace});
+    if (m_capabilityAgentMap.find(contextNamespace) == m_capabilityAgentMap.end()) {
+        AACE_ERROR(LX(TAG).d("reason", "invalidNamespace").d("namespace", contextNamespace));
+        return;
+    }
+    m_capabilityAgentMap[contextNamespace]->updateContext(customContext);
+}
+
 }  // namespace customDomain
 }  // namespace engine
 }  // namespace aace
@@ -34,13 +34,10 @@ CustomDomainEngineService::CustomDomainEngineService(const aace::engine::core::S
         aace::engine::core::EngineService(description) {
 }
 
-bool CustomDomainEngineService::configure(std::shared_ptr<std::istream> configuration) {
+bool CustomDomainEngineService::configureFromJson(const aace::engine::utils::json::Value& configuration) {
     AACE_INFO(LX(TAG));
     try {
-        json jconfiguration;
-        jconfiguration = json::parse(*configuration);
-
-        m_customInterfaceMetadata = jconfiguration.dump();
+        m_customInterfaceMetadata = configuration.dump();
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
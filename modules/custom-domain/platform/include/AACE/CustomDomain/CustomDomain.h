@@ -166,6 +166,21 @@ public:
         const std::string& correlationToken = "",
         const std::string& customContext = "");
 
+    /**
+    * Notifies the engine about the current custom states under @c contextNamespace.
+    *
+    * When @c contextTimeToLiveInMilliseconds is configured for the interface, the engine serves the last context
+    * notified by this method to the context requests, for the configured time after the notification, instead of
+    * calling @c getContext() and waiting for its result. The context should be notified when the interface is
+    * registered and whenever the states change. While no fresh context is available, the custom states are reported
+    * as unavailable and the engine calls @c getContext() in the background to refresh them.
+    *
+    * @param [in] contextNamespace The namespace of the context.
+    * @param [in] customContext The context corresponding to @a contextNamespace, in the JSON structure described
+    * in @c getContext().
+    */
+    void updateContext(const std::string& contextNamespace, const std::string& customContext);
+
     /**
     * @internal
     * Sets the Engine interface delegate
@@ -122,6 +122,22 @@ public:
     std::unique_ptr<testing::StrictMock<alexaClientSDK::avsCommon::sdkInterfaces::test::MockDirectiveHandlerResult>>
         m_mockDirectiveHandlerResult;
     std::shared_ptr<testing::StrictMock<MockHandler>> m_mockHandler;
+
+    /**
+     * Sends a directive of the test namespace to the capability agent.
+     */
+    static void sendDirective(
+        std::shared_ptr<aace::engine::customDomain::CustomDomainCapabilityAgent> capAgent,
+        const std::string& messageId,
+        const std::string& dialogRequestId) {
+        auto attachmentManager = std::make_shared<testing::StrictMock<aace::test::unit::avs::MockAttachmentManager>>();
+        auto avsMessageHeader = std::make_shared<alexaClientSDK::avsCommon::avs::AVSMessageHeader>(
+            "TEST_NAMESPACE", "TEST_NAME", messageId, dialogRequestId, "TEST_CORRELATION_TOKEN");
+        auto directive = alexaClientSDK::avsCommon::avs::AVSDirective::create(
+            "", avsMessageHeader, "TEST_PAYLOAD", attachmentManager, "");
+        capAgent->CapabilityAgent::preHandleDirective(directive, nullptr);
+        capAgent->CapabilityAgent::handleDirective(messageId);
+    }
 };
 
 TEST_F(CustomDomainCapabilityAgentTest, create) {
@@ -308,6 +324,146 @@ TEST_F(CustomDomainCapabilityAgentTest, testProvideMultipleState) {
     m_wakeSetCompletedFuture.wait_for(TIMEOUT);
 }
 
+TEST_F(CustomDomainCapabilityAgentTest, createWithNegativeContextTimeToLive) {
+    std::shared_ptr<aace::engine::customDomain::CustomDomainCapabilityAgent> capAgent;
+    capAgent = aace::engine::customDomain::CustomDomainCapabilityAgent::create(
+        "TEST_NAMESPACE",
+        "TEST_VERSION",
+        {},
+        m_mockHandler,
+        m_mockExceptionSender,
+        m_mockContextManager,
+        m_mockMessageSender,
+        std::chrono::milliseconds(-1));
+    EXPECT_EQ(nullptr, capAgent);
+}
+
+TEST_F(CustomDomainCapabilityAgentTest, testProvideStateFromPushedContext) {
+    alexaClientSDK::avsCommon::utils::WaitEvent waitEvent;
+
+    EXPECT_CALL(*m_mockContextManager, addStateProvider(testing::_, ::testing::NotNull())).Times(testing::Exactly(2));
+    std::vector<std::string> states{"TEST_STATE_1", "TEST_STATE_2"};
+    auto capAgent = aace::engine::customDomain::CustomDomainCapabilityAgent::create(
+        "TEST_NAMESPACE",
+        "TEST_VERSION",
+        states,
+        m_mockHandler,
+        m_mockExceptionSender,
+        m_mockContextManager,
+        m_mockMessageSender,
+        std::chrono::minutes(1));
+    ASSERT_NE(nullptr, capAgent);
+    EXPECT_CALL(*m_mockContextManager, provideStateResponse(testing::_, testing::_, 42))
+        .Times(testing::Exactly(2))
+        .WillOnce(testing::Return())
+        .WillOnce(testing::InvokeWithoutArgs([&waitEvent]() { waitEvent.wakeUp(); }));
+    EXPECT_CALL(*m_mockHandler, getContext(testing::_)).Times(testing::Exactly(0));
+
+    capAgent->updateContext(TEST_CONTEXT);
+    for (const auto& state : states) {
+        capAgent->provideState(NamespaceAndName{"TEST_NAMESPACE", state}, 42);
+    }
+    EXPECT_TRUE(waitEvent.wait(TIMEOUT));
+}
+
+TEST_F(CustomDomainCapabilityAgentTest, testProvideStateWithoutFreshContextRefreshesInBackground) {
+    alexaClientSDK::avsCommon::utils::WaitEvent unavailableEvent;
+    alexaClientSDK::avsCommon::utils::WaitEvent providedEvent;
+
+    EXPECT_CALL(*m_mockContextManager, addStateProvider(testing::_, ::testing::NotNull()));
+    auto capAgent = aace::engine::customDomain::CustomDomainCapabilityAgent::create(
+        "TEST_NAMESPACE",
+        "TEST_VERSION",
+        {"TEST_STATE_1"},
+        m_mockHandler,
+        m_mockExceptionSender,
+        m_mockContextManager,
+        m_mockMessageSender,
+        std::chrono::minutes(1));
+    ASSERT_NE(nullptr, capAgent);
+
+    // The context request doesn't wait for the device while the context is refreshed
+    EXPECT_CALL(*m_mockContextManager, provideStateUnavailableResponse(testing::_, 42, false))
+        .WillOnce(testing::InvokeWithoutArgs([&unavailableEvent]() { unavailableEvent.wakeUp(); }));
+    EXPECT_CALL(*m_mockHandler, getContext("TEST_NAMESPACE"))
+        .Times(testing::Exactly(1))
+        .WillOnce(testing::Return(TEST_CONTEXT));
+    capAgent->provideState(NamespaceAndName{"TEST_NAMESPACE", "TEST_STATE_1"}, 42);
+    ASSERT_TRUE(unavailableEvent.wait(TIMEOUT));
+    m_wakeSetCompletedFuture.wait_for(TIMEOUT);
+
+    // The next context request is served from the refreshed context
+    EXPECT_CALL(*m_mockContextManager, provideStateResponse(testing::_, testing::_, 43))
+        .WillOnce(testing::InvokeWithoutArgs([&providedEvent]() { providedEvent.wakeUp(); }));
+    capAgent->provideState(NamespaceAndName{"TEST_NAMESPACE", "TEST_STATE_1"}, 43);
+    EXPECT_TRUE(providedEvent.wait(TIMEOUT));
+}
+
+TEST_F(CustomDomainCapabilityAgentTest, testConcurrentDirectivesAreLimited) {
+    alexaClientSDK::avsCommon::utils::WaitEvent firstEvent;
+    alexaClientSDK::avsCommon::utils::WaitEvent secondEvent;
+
+    auto capAgent = aace::engine::customDomain::CustomDomainCapabilityAgent::create(
+        "TEST_NAMESPACE",
+        "TEST_VERSION",
+        {},
+        m_mockHandler,
+        m_mockExceptionSender,
+        m_mockContextManager,
+        m_mockMessageSender,
+        std::chrono::milliseconds::zero(),
+        1);
+    ASSERT_NE(nullptr, capAgent);
+
+    EXPECT_CALL(*m_mockHandler, handleDirective(testing::_, testing::_, testing::_, testing::_, "MESSAGE_ID_1"))
+        .WillOnce(testing::InvokeWithoutArgs([&firstEvent]() { firstEvent.wakeUp(); }));
+    sendDirective(capAgent, "MESSAGE_ID_1", "DIALOG_REQUEST_ID_1");
+    sendDirective(capAgent, "MESSAGE_ID_2", "DIALOG_REQUEST_ID_2");
+    ASSERT_TRUE(firstEvent.wait(TIMEOUT));
+    m_wakeSetCompletedFuture.wait_for(TIMEOUT);
+
+    // The second directive is handed to the platform once the first one completes
+    EXPECT_CALL(*m_mockHandler, handleDirective(testing::_, testing::_, testing::_, testing::_, "MESSAGE_ID_2"))
+        .WillOnce(testing::InvokeWithoutArgs([&secondEvent]() { secondEvent.wakeUp(); }));
+    capAgent->reportDirectiveHandlingResult("MESSAGE_ID_1", true);
+    EXPECT_TRUE(secondEvent.wait(TIMEOUT));
+    capAgent->shutdown();
+}
+
+TEST_F(CustomDomainCapabilityAgentTest, testDirectivesOfDialogRequestAreOrdered) {
+    alexaClientSDK::avsCommon::utils::WaitEvent parallelEvent;
+    alexaClientSDK::avsCommon::utils::WaitEvent orderedEvent;
+
+    auto capAgent = aace::engine::customDomain::CustomDomainCapabilityAgent::create(
+        "TEST_NAMESPACE",
+        "TEST_VERSION",
+        {},
+        m_mockHandler,
+        m_mockExceptionSender,
+        m_mockContextManager,
+        m_mockMessageSender,
+        std::chrono::milliseconds::zero(),
+        2);
+    ASSERT_NE(nullptr, capAgent);
+
+    // The directive of another dialog request runs in parallel with the first one
+    EXPECT_CALL(*m_mockHandler, handleDirective(testing::_, testing::_, testing::_, testing::_, "MESSAGE_ID_1"));
+    EXPECT_CALL(*m_mockHandler, handleDirective(testing::_, testing::_, testing::_, testing::_, "MESSAGE_ID_3"))
+        .WillOnce(testing::InvokeWithoutArgs([&parallelEvent]() { parallelEvent.wakeUp(); }));
+    sendDirective(capAgent, "MESSAGE_ID_1", "DIALOG_REQUEST_ID_1");
+    sendDirective(capAgent, "MESSAGE_ID_2", "DIALOG_REQUEST_ID_1");
+    sendDirective(capAgent, "MESSAGE_ID_3", "DIALOG_REQUEST_ID_2");
+    ASSERT_TRUE(parallelEvent.wait(TIMEOUT));
+    m_wakeSetCompletedFuture.wait_for(TIMEOUT);
+
+    // The second directive of the first dialog request waits for the first one
+    EXPECT_CALL(*m_mockHandler, handleDirective(testing::_, testing::_, testing::_, testing::_, "MESSAGE_ID_2"))
+        .WillOnce(testing::InvokeWithoutArgs([&orderedEvent]() { orderedEvent.wakeUp(); }));
+    capAgent->reportDirectiveHandlingResult("MESSAGE_ID_1", true);
+    EXPECT_TRUE(orderedEvent.wait(TIMEOUT));
+    capAgent->shutdown();
+}
+
 TEST_F(CustomDomainCapabilityAgentTest, testCancelDirective) {
     auto attachmentManager = std::make_shared<testing::StrictMock<aace::test::unit::avs::MockAttachmentManager>>();
     auto avsMessageHeader = std::make_shared<alexaClientSDK::avsCommon::avs::AVSMessageHeader>(
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <AACE/Engine/Utils/PCM/PCMUtils.h>
+
+#include "LoopbackCorrelator.h"
+
+namespace aace {
+namespace engine {
+namespace loopbackDetector {
+
+/// The duration of a frame of the level contours.
+static const uint32_t FRAME_DURATION_MS = 10;
+
+/// The lowest level of a frame, so the frames of digital silence don't outweigh the frames of speech.
+static const float LEVEL_FLOOR_DBFS = -80.0f;
+
+/// The fewest frames compared, under which a correlation is meaningless.
+static const size_t MIN_FRAMES = 10;
+
+LoopbackCorrelator::LoopbackCorrelator(uint32_t sampleRate, float silenceThreshold) :
+        m_frameSize(std::max<size_t>(1, sampleRate * FRAME_DURATION_MS / 1000)), m_silenceThreshold(silenceThreshold) {
+}
+
+std::vector<float> LoopbackCorrelator::envelope(const int16_t* samples, size_t size) const {
+    std::vector<float> levels(size / m_frameSize);
+    for (size_t j = 0; j < levels.size(); j++) {
+        levels[j] = std::max(LEVEL_FLOOR_DBFS, utils::pcm::levelDbfs(samples + j * m_frameSize, m_frameSize));
+    }
+    return levels;
+}
+
+float LoopbackCorrelator::correlate(
+    const int16_t* wakeword,
+    size_t wakewordSize,
+    const int16_t* loopback,
+    size_t loopbackSize) const {
+    auto wakewordLevels = envelope(wakeword, wakewordSize);
+    auto loopbackLevels = envelope(loopback, loopbackSize);
+    auto frames = wakewordLevels.size();
+    if (frames < MIN_FRAMES || loopbackLevels.size() < frames) {
+        return 0.0f;
+    }
+    if (*std::max_element(loopbackLevels.begin(), loopbackLevels.end()) < m_silenceThreshold) {
+        return 0.0f;
+    }
+
+    // the wakeword contour is centered once, and each window of the loopback contour at each delay
+    double mean = 0;
+    for (auto level : wakewordLevels) {
+        mean += level;
+    }
+    mean /= frames;
+    double wakewordEnergy = 0;
+    for (auto& level : wakewordLevels) {
+        level -= static_cast<float>(mean);
+        wakewordEnergy += level * level;
+    }
+    if (wakewordEnergy <= 0) {
+        return 0.0f;
+    }
+
+    double best = 0;
+    for (size_t delay = 0; delay + frames <= loopbackLevels.size(); delay++) {
+        const float* window = loopbackLevels.data() + delay;
+        double windowMean = 0;
+        for (size_t j = 0; j < frames; j++) {
+            windowMean += window[j];
+        }
+        windowMean /= frames;
+        double product = 0;
+        double windowEnergy = 0;
+        for (size_t j = 0; j < frames; j++) {
+            double centered = window[j] - windowMean;
+            product += wakewordLevels[j] * centered;
+            windowEnergy += centered * centered;
+        }
+        if (windowEnergy > 0) {
+            best = std::max(best, product / std::sqrt(wakewordEnergy * windowEnergy));
+        }
+    }
+
+    return static_cast<float>(best);
+}
+
+}  // namespace loopbackDetector
+}  // namespace engine
+}  // namespace aace
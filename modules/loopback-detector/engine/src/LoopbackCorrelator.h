@@ -0,0 +1,65 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_LOOPBACKDETECTOR_LOOPBACK_CORRELATOR_H
+#define AACE_ENGINE_LOOPBACKDETECTOR_LOOPBACK_CORRELATOR_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace loopbackDetector {
+
+/**
+ * Compares a wakeword captured by the microphone with the loopback audio played around the same time.
+ *
+ * The speakers, the cabin and the echo canceller change the waveform of the output audio too much for the samples
+ * of the microphone and of the loopback to correlate, but not the loudness contour of the speech. The correlator
+ * measures the level of each 10 ms frame of both audios, and returns the highest normalized cross-correlation of the
+ * level contour of the wakeword with the contour of the loopback audio, at any delay of the loopback audio.
+ */
+class LoopbackCorrelator {
+public:
+    /**
+     * @param sampleRate The sample rate of both audios.
+     * @param silenceThreshold The level in dBFS under which the loopback audio is silent, so nothing is played.
+     */
+    LoopbackCorrelator(uint32_t sampleRate, float silenceThreshold);
+
+    /**
+     * Returns the correlation of the wakeword with the loopback audio, from 0 to 1, or 0 if the loopback audio is
+     * silent or too short to contain the wakeword.
+     *
+     * @param wakeword The samples of the wakeword captured by the microphone.
+     * @param wakewordSize The number of samples of the wakeword.
+     * @param loopback The samples of the loopback audio, from the earliest delay to the latest delay of the wakeword.
+     * @param loopbackSize The number of samples of the loopback audio.
+     */
+    float correlate(const int16_t* wakeword, size_t wakewordSize, const int16_t* loopback, size_t loopbackSize) const;
+
+private:
+    std::vector<float> envelope(const int16_t* samples, size_t size) const;
+
+    const size_t m_frameSize;
+    const float m_silenceThreshold;
+};
+
+}  // namespace loopbackDetector
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_LOOPBACKDETECTOR_LOOPBACK_CORRELATOR_H
@@ -15,7 +15,9 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <climits>
+#include <vector>
 #include <AACE/Engine/Core/EngineMacros.h>
 #include "LoopbackDetector.h"
 
@@ -23,19 +25,61 @@ namespace aace {
 namespace engine {
 namespace loopbackDetector {
 
-/// The maximum number of readers of the stream.
-static const size_t MAX_READERS = 2;
-
-/// The amount of audio data to keep in the ring buffer.
-static const std::chrono::seconds AMOUNT_OF_AUDIO_DATA_IN_BUFFER = std::chrono::seconds(5);
-
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.alexa.LoopbackDetector");
 
-LoopbackDetector::LoopbackDetector(const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat) :
+constexpr std::chrono::milliseconds LoopbackDetector::DEFAULT_AUDIO_BUFFER_DURATION;
+constexpr size_t LoopbackDetector::DEFAULT_AUDIO_BUFFER_MAX_READERS;
+constexpr float LoopbackDetector::DEFAULT_CORRELATION_THRESHOLD;
+constexpr std::chrono::milliseconds LoopbackDetector::DEFAULT_CORRELATION_MAX_DELAY;
+constexpr float LoopbackDetector::DEFAULT_CORRELATION_SILENCE_THRESHOLD;
+
+/// The longest wakeword correlated with the loopback audio, whose end is kept if it is longer.
+static const std::chrono::milliseconds MAX_CORRELATED_WAKEWORD_DURATION = std::chrono::milliseconds(2000);
+
+// Returns the index of the next sample written to a stream.
+static alexaClientSDK::avsCommon::avs::AudioInputStream::Index getWriterIndex(
+    const std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream>& stream) {
+    using Reader = alexaClientSDK::avsCommon::avs::AudioInputStream::Reader;
+    auto reader = stream->createReader(Reader::Policy::NONBLOCKING, true);
+    ThrowIfNull(reader, "createReaderFailed");
+    return reader->tell();
+}
+
+// Reads the samples of a stream that are already written, from an absolute index.
+static void readSamples(
+    const std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream>& stream,
+    alexaClientSDK::avsCommon::avs::AudioInputStream::Index index,
+    std::vector<int16_t>& samples) {
+    using Reader = alexaClientSDK::avsCommon::avs::AudioInputStream::Reader;
+    auto reader = stream->createReader(Reader::Policy::NONBLOCKING);
+    ThrowIfNull(reader, "createReaderFailed");
+    ThrowIfNot(reader->seek(index, Reader::Reference::ABSOLUTE), "seekFailed");
+
+    size_t count = 0;
+    while (count < samples.size()) {
+        auto result = reader->read(samples.data() + count, samples.size() - count);
+        ThrowIf(result <= 0, "readFailed");
+        count += static_cast<size_t>(result);
+    }
+}
+
+LoopbackDetector::LoopbackDetector(
+    const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat,
+    std::chrono::milliseconds audioBufferDuration,
+    size_t audioBufferMaxReaders,
+    const audio::VoiceActivityGate::Config& voiceActivityGateConfig,
+    Mode mode,
+    const CorrelationConfig& correlationConfig) :
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
         m_audioFormat(audioFormat),
-        m_wordSize(audioFormat.sampleSizeInBits / CHAR_BIT) {
+        m_audioBufferDuration(audioBufferDuration),
+        m_audioBufferMaxReaders(audioBufferMaxReaders),
+        m_voiceActivityGateConfig(voiceActivityGateConfig),
+        m_wordSize(audioFormat.sampleSizeInBits / CHAR_BIT),
+        m_mode(mode),
+        m_correlationConfig(correlationConfig),
+        m_correlator(audioFormat.sampleRateHz, correlationConfig.silenceThreshold) {
 }
 
 bool LoopbackDetector::initialize(
@@ -52,16 +96,19 @@ bool LoopbackDetector::initialize(
 
         ThrowIfNot(initializeAudioInputStream(), "initializeAudioInputStreamFailed");
 
-        m_wakewordEngineAdapter = wakewordEngineAdapter;
-        ThrowIfNull(m_wakewordEngineAdapter, "invalidWakewordEngineAdapter");
+        // the correlation only reads the loopback audio of each wakeword, so no wakeword engine is needed
+        if (m_mode == Mode::WAKEWORD) {
+            m_wakewordEngineAdapter = wakewordEngineAdapter;
+            ThrowIfNull(m_wakewordEngineAdapter, "invalidWakewordEngineAdapter");
 
-        ThrowIfNot(
-            m_wakewordEngineAdapter->initialize(defaultLocale, m_audioInputStream, m_audioFormat),
-            "wakewordInitializeFailed");
-        m_wakewordEngineAdapter->addKeyWordObserver(shared_from_this());
+            ThrowIfNot(
+                m_wakewordEngineAdapter->initialize(defaultLocale, m_audioInputStream, m_audioFormat),
+                "wakewordInitializeFailed");
+            m_wakewordEngineAdapter->addKeyWordObserver(shared_from_this());
 
-        // Enable WW
-        ThrowIfNot(m_wakewordEngineAdapter->enable(), "enableFailed");
+            // Enable WW
+            ThrowIfNot(m_wakewordEngineAdapter->enable(), "enableFailed");
+        }
 
         // tell the platform interface to start providing audio input
         ThrowIfNot(startAudioInput(), "platformStartAudioInputFailed");
@@ -77,11 +124,30 @@ std::shared_ptr<LoopbackDetector> LoopbackDetector::create(
     const std::string& defaultLocale,
     const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat,
     std::shared_ptr<audio::AudioManagerInterface> audioManager,
-    std::shared_ptr<alexa::WakewordEngineAdapter> wakewordEngineAdapter) {
+    std::shared_ptr<alexa::WakewordEngineAdapter> wakewordEngineAdapter,
+    std::chrono::milliseconds audioBufferDuration,
+    size_t audioBufferMaxReaders,
+    const audio::VoiceActivityGate::Config& voiceActivityGateConfig,
+    Mode mode,
+    const CorrelationConfig& correlationConfig) {
     std::shared_ptr<LoopbackDetector> loopbackDetector = nullptr;
 
     try {
-        loopbackDetector = std::shared_ptr<LoopbackDetector>(new LoopbackDetector(audioFormat));
+        ThrowIf(audioBufferDuration.count() <= 0, "invalidAudioBufferDuration");
+        ThrowIf(audioBufferMaxReaders == 0, "invalidAudioBufferMaxReaders");
+        ThrowIf(correlationConfig.maxDelay.count() < 0, "invalidCorrelationMaxDelay");
+        if (mode == Mode::CORRELATION) {
+            auto correlatedDuration = correlationConfig.maxDelay + MAX_CORRELATED_WAKEWORD_DURATION;
+            ThrowIf(correlatedDuration > audioBufferDuration, "audioBufferTooShortForCorrelation");
+        }
+
+        loopbackDetector = std::shared_ptr<LoopbackDetector>(new LoopbackDetector(
+            audioFormat,
+            audioBufferDuration,
+            audioBufferMaxReaders,
+            voiceActivityGateConfig,
+            mode,
+            correlationConfig));
 
         ThrowIfNot(
             loopbackDetector->initialize(defaultLocale, audioManager, wakewordEngineAdapter),
@@ -112,20 +178,37 @@ void LoopbackDetector::doShutdown() {
 
 bool LoopbackDetector::initializeAudioInputStream() {
     try {
+        auto words = static_cast<size_t>(m_audioFormat.sampleRateHz * m_audioBufferDuration.count() / 1000);
         size_t size = alexaClientSDK::avsCommon::avs::AudioInputStream::calculateBufferSize(
-            m_audioFormat.sampleRateHz * AMOUNT_OF_AUDIO_DATA_IN_BUFFER.count(), m_wordSize, MAX_READERS);
+            words, m_wordSize, m_audioBufferMaxReaders);
         auto buffer = std::make_shared<alexaClientSDK::avsCommon::avs::AudioInputStream::Buffer>(size);
         ThrowIfNull(buffer, "couldNotCreateAudioInputBuffer");
 
         // create the audio input stream
-        m_audioInputStream = alexaClientSDK::avsCommon::avs::AudioInputStream::create(buffer, m_wordSize, MAX_READERS);
+        m_audioInputStream =
+            alexaClientSDK::avsCommon::avs::AudioInputStream::create(buffer, m_wordSize, m_audioBufferMaxReaders);
         ThrowIfNull(m_audioInputStream, "couldNotCreateAudioInputStream");
 
+        // report the memory the buffer takes, which is resident for the lifetime of the engine
+        AACE_INFO(LX(TAG, "initializeAudioInputStream")
+                      .d("bufferSize", size)
+                      .d("duration", m_audioBufferDuration.count())
+                      .d("maxReaders", m_audioBufferMaxReaders));
+
         // create the audio input writer
         m_audioInputWriter = m_audioInputStream->createWriter(
             alexaClientSDK::avsCommon::avs::AudioInputStream::Writer::Policy::NONBLOCKABLE);
         ThrowIfNull(m_audioInputWriter, "couldNotCreateAudioInputWriter");
 
+        // the gate would shift the loopback audio from the time it was played, which the correlation relies on
+        if (m_voiceActivityGateConfig.enabled && m_mode == Mode::CORRELATION) {
+            AACE_WARN(LX(TAG, "initializeAudioInputStream").d("reason", "voiceActivityGateIgnoredInCorrelationMode"));
+        } else if (m_voiceActivityGateConfig.enabled) {
+            m_voiceActivityGate =
+                audio::VoiceActivityGate::create(m_audioFormat.sampleRateHz, m_voiceActivityGateConfig);
+            ThrowIfNull(m_voiceActivityGate, "couldNotCreateVoiceActivityGate");
+        }
+
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "initializeAudioInputStream").d("reason", ex.what()));
@@ -178,7 +261,14 @@ ssize_t LoopbackDetector::write(const int16_t* data, const size_t size) {
     try {
         ThrowIfNull(m_audioInputWriter, "nullAudioInputWriter");
 
-        ssize_t result = m_audioInputWriter->write(data, size);
+        ssize_t result;
+        if (m_voiceActivityGate != nullptr) {
+            result = m_voiceActivityGate->process(data, size, false, [this](const int16_t* samples, size_t count) {
+                return m_audioInputWriter->write(samples, count);
+            });
+        } else {
+            result = m_audioInputWriter->write(data, size);
+        }
         ThrowIf(result < 0, "errorWritingData");
 
         return result;
@@ -205,6 +295,65 @@ bool LoopbackDetector::shouldBlock(const std::string& wakeword, const std::chron
     return (std::chrono::system_clock::now() - m_lastDetection) < timeout;
 }
 
+bool LoopbackDetector::shouldBlock(
+    const std::string& wakeword,
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+    alexaClientSDK::avsCommon::avs::AudioInputStream::Index beginIndex,
+    alexaClientSDK::avsCommon::avs::AudioInputStream::Index endIndex,
+    const std::chrono::milliseconds& timeout) {
+    if (m_mode == Mode::WAKEWORD) {
+        return shouldBlock(wakeword, timeout);
+    }
+
+    AACE_DEBUG(LX(TAG, "shouldBlock").d("wakeword", wakeword).d("beginIndex", beginIndex).d("endIndex", endIndex));
+
+    // the loopback audio of the wakeword is already written when the wakeword is detected, so there is no wait
+    return correlatesWithLoopback(stream, beginIndex, endIndex);
+}
+
+bool LoopbackDetector::correlatesWithLoopback(
+    std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+    alexaClientSDK::avsCommon::avs::AudioInputStream::Index beginIndex,
+    alexaClientSDK::avsCommon::avs::AudioInputStream::Index endIndex) {
+    try {
+        ThrowIfNull(stream, "invalidStream");
+        ThrowIf(
+            beginIndex == KeyWordObserverInterface::UNSPECIFIED_INDEX ||
+                endIndex == KeyWordObserverInterface::UNSPECIFIED_INDEX || endIndex <= beginIndex,
+            "invalidWakewordIndices");
+
+        auto micIndex = getWriterIndex(stream);
+        ThrowIf(micIndex < endIndex, "invalidWakewordEndIndex");
+
+        // only the end of a long wakeword is compared
+        auto maxWakewordSize = m_audioFormat.sampleRateHz * MAX_CORRELATED_WAKEWORD_DURATION.count() / 1000;
+        beginIndex = std::max(beginIndex, endIndex - std::min<decltype(endIndex)>(endIndex, maxWakewordSize));
+        std::vector<int16_t> wakeword(static_cast<size_t>(endIndex - beginIndex));
+        readSamples(stream, beginIndex, wakeword);
+
+        // the loopback audio of the wakeword was played up to the maximum delay before the wakeword was captured,
+        // assuming both streams are written as the audio is captured
+        auto maxDelaySize = m_audioFormat.sampleRateHz * m_correlationConfig.maxDelay.count() / 1000;
+        auto loopbackIndex = getWriterIndex(m_audioInputStream);
+        auto earliestAge = micIndex - beginIndex + maxDelaySize;
+        auto latestAge = micIndex - endIndex;
+        if (loopbackIndex < earliestAge) {
+            AACE_DEBUG(LX(TAG, "correlatesWithLoopback").d("reason", "notEnoughLoopbackAudio"));
+            return false;
+        }
+        std::vector<int16_t> loopback(static_cast<size_t>(earliestAge - latestAge));
+        readSamples(m_audioInputStream, loopbackIndex - earliestAge, loopback);
+
+        auto correlation = m_correlator.correlate(wakeword.data(), wakeword.size(), loopback.data(), loopback.size());
+        AACE_DEBUG(LX(TAG, "correlatesWithLoopback").d("correlation", correlation));
+
+        return correlation >= m_correlationConfig.threshold;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "correlatesWithLoopback").d("reason", ex.what()));
+        return false;
+    }
+}
+
 void LoopbackDetector::onKeyWordDetected(
     std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
     std::string keyword,
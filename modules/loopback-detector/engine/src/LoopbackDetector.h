@@ -25,9 +25,12 @@
 #include <AVSCommon/Utils/AudioFormat.h>
 #include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
 #include <AACE/Engine/Audio/AudioManagerInterface.h>
+#include <AACE/Engine/Audio/VoiceActivityGate.h>
 #include <AACE/Engine/Alexa/InitiatorVerifier.h>
 #include <AACE/Engine/Alexa/WakewordEngineAdapter.h>
 
+#include "LoopbackCorrelator.h"
+
 namespace aace {
 namespace engine {
 namespace loopbackDetector {
@@ -37,8 +40,51 @@ class LoopbackDetector
         , public alexaClientSDK::avsCommon::utils::RequiresShutdown
         , public std::enable_shared_from_this<LoopbackDetector>
         , public alexa::InitiatorVerifier {
+public:
+    /// The amount of audio data to keep in the ring buffer, by default.
+    static constexpr std::chrono::milliseconds DEFAULT_AUDIO_BUFFER_DURATION{5000};
+
+    /// The maximum number of readers of the stream, by default.
+    static constexpr size_t DEFAULT_AUDIO_BUFFER_MAX_READERS = 2;
+
+    /// The correlation of a wakeword with the loopback audio above which the wakeword is blocked, by default.
+    static constexpr float DEFAULT_CORRELATION_THRESHOLD = 0.7f;
+
+    /// The longest time the loopback audio takes to reach the microphone, by default.
+    static constexpr std::chrono::milliseconds DEFAULT_CORRELATION_MAX_DELAY{300};
+
+    /// The level under which the loopback audio is silent, by default.
+    static constexpr float DEFAULT_CORRELATION_SILENCE_THRESHOLD = -60.0f;
+
+    /// How the wakewords spoken by the speakers are detected.
+    enum class Mode {
+        /// A secondary wakeword engine looks for the wakeword in the loopback audio.
+        WAKEWORD,
+        /// The audio of each wakeword is correlated with the recent loopback audio, without a wakeword engine.
+        CORRELATION
+    };
+
+    struct CorrelationConfig {
+        CorrelationConfig(
+            float threshold = DEFAULT_CORRELATION_THRESHOLD,
+            std::chrono::milliseconds maxDelay = DEFAULT_CORRELATION_MAX_DELAY,
+            float silenceThreshold = DEFAULT_CORRELATION_SILENCE_THRESHOLD) :
+                threshold(threshold), maxDelay(maxDelay), silenceThreshold(silenceThreshold) {
+        }
+
+        float threshold;
+        std::chrono::milliseconds maxDelay;
+        float silenceThreshold;
+    };
+
 private:
-    LoopbackDetector(const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat);
+    LoopbackDetector(
+        const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat,
+        std::chrono::milliseconds audioBufferDuration,
+        size_t audioBufferMaxReaders,
+        const audio::VoiceActivityGate::Config& voiceActivityGateConfig,
+        Mode mode,
+        const CorrelationConfig& correlationConfig);
 
     bool initialize(
         const std::string& defaultLocale,
@@ -50,10 +96,24 @@ public:
         const std::string& defaultLocale,
         const alexaClientSDK::avsCommon::utils::AudioFormat& audioFormat,
         std::shared_ptr<audio::AudioManagerInterface> audioManager,
-        std::shared_ptr<alexa::WakewordEngineAdapter> wakewordEngineAdapter = nullptr);
+        std::shared_ptr<alexa::WakewordEngineAdapter> wakewordEngineAdapter = nullptr,
+        std::chrono::milliseconds audioBufferDuration = DEFAULT_AUDIO_BUFFER_DURATION,
+        size_t audioBufferMaxReaders = DEFAULT_AUDIO_BUFFER_MAX_READERS,
+        const audio::VoiceActivityGate::Config& voiceActivityGateConfig = audio::VoiceActivityGate::Config(),
+        Mode mode = Mode::WAKEWORD,
+        const CorrelationConfig& correlationConfig = CorrelationConfig());
+
+    using alexa::InitiatorVerifier::shouldBlock;
 
     bool shouldBlock(const std::string& wakeword, const std::chrono::milliseconds& timeout) override;
 
+    bool shouldBlock(
+        const std::string& wakeword,
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+        alexaClientSDK::avsCommon::avs::AudioInputStream::Index beginIndex,
+        alexaClientSDK::avsCommon::avs::AudioInputStream::Index endIndex,
+        const std::chrono::milliseconds& timeout) override;
+
     // KeyWordObserverInterface
     void onKeyWordDetected(
         std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
@@ -73,17 +133,32 @@ private:
     bool stopAudioInput();
     ssize_t write(const int16_t* data, const size_t size);
 
+    bool correlatesWithLoopback(
+        std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> stream,
+        alexaClientSDK::avsCommon::avs::AudioInputStream::Index beginIndex,
+        alexaClientSDK::avsCommon::avs::AudioInputStream::Index endIndex);
+
 private:
     alexaClientSDK::avsCommon::utils::AudioFormat m_audioFormat;
+    std::chrono::milliseconds m_audioBufferDuration;
+    size_t m_audioBufferMaxReaders;
     std::shared_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream> m_audioInputStream;
     std::unique_ptr<alexaClientSDK::avsCommon::avs::AudioInputStream::Writer> m_audioInputWriter;
 
+    // holds back the silence of the loopback audio from the wakeword engine, if it is enabled
+    audio::VoiceActivityGate::Config m_voiceActivityGateConfig;
+    std::unique_ptr<audio::VoiceActivityGate> m_voiceActivityGate;
+
     std::shared_ptr<audio::AudioInputChannelInterface> m_audioInputChannel;
     audio::AudioInputChannelInterface::ChannelId m_currentChannelId =
         audio::AudioInputChannelInterface::INVALID_CHANNEL;
 
     unsigned int m_wordSize;
 
+    Mode m_mode;
+    CorrelationConfig m_correlationConfig;
+    LoopbackCorrelator m_correlator;
+
     std::shared_ptr<alexa::WakewordEngineAdapter> m_wakewordEngineAdapter;
 
     std::mutex m_detectionMutex;
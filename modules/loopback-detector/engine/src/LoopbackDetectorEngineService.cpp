@@ -42,7 +42,9 @@ static const std::string FACTORY_NAME("aace.loopbackDetector");
 REGISTER_SERVICE(LoopbackDetectorEngineService);
 
 LoopbackDetectorEngineService::LoopbackDetectorEngineService(const core::ServiceDescription& description) :
-        core::EngineService(description) {
+        core::EngineService(description),
+        m_audioBufferDuration(LoopbackDetector::DEFAULT_AUDIO_BUFFER_DURATION),
+        m_audioBufferMaxReaders(LoopbackDetector::DEFAULT_AUDIO_BUFFER_MAX_READERS) {
 }
 
 bool LoopbackDetectorEngineService::configure(std::shared_ptr<std::istream> configuration) {
@@ -56,6 +58,58 @@ bool LoopbackDetectorEngineService::configure(std::shared_ptr<std::istream> conf
             m_wakewordEngineName = configRoot["wakewordEngine"].GetString();
         }
 
+        if (configRoot.HasMember("audioBuffer") && configRoot["audioBuffer"].IsObject()) {
+            auto audioBuffer = configRoot["audioBuffer"].GetObject();
+
+            if (audioBuffer.HasMember("duration") && audioBuffer["duration"].IsUint()) {
+                m_audioBufferDuration = std::chrono::milliseconds(audioBuffer["duration"].GetUint());
+            }
+            if (audioBuffer.HasMember("maxReaders") && audioBuffer["maxReaders"].IsUint()) {
+                m_audioBufferMaxReaders = audioBuffer["maxReaders"].GetUint();
+            }
+        }
+
+        if (configRoot.HasMember("voiceActivityGate") && configRoot["voiceActivityGate"].IsObject()) {
+            auto gate = configRoot["voiceActivityGate"].GetObject();
+
+            if (gate.HasMember("enabled") && gate["enabled"].IsBool()) {
+                m_voiceActivityGateConfig.enabled = gate["enabled"].GetBool();
+            }
+            if (gate.HasMember("threshold") && gate["threshold"].IsNumber()) {
+                m_voiceActivityGateConfig.threshold = gate["threshold"].GetFloat();
+            }
+            if (gate.HasMember("preRoll") && gate["preRoll"].IsUint()) {
+                m_voiceActivityGateConfig.preRoll = std::chrono::milliseconds(gate["preRoll"].GetUint());
+            }
+            if (gate.HasMember("hangover") && gate["hangover"].IsUint()) {
+                m_voiceActivityGateConfig.hangover = std::chrono::milliseconds(gate["hangover"].GetUint());
+            }
+        }
+
+        if (configRoot.HasMember("mode") && configRoot["mode"].IsString()) {
+            std::string mode = configRoot["mode"].GetString();
+            if (mode == "CORRELATION") {
+                m_mode = LoopbackDetector::Mode::CORRELATION;
+            } else {
+                ThrowIfNot(mode == "WAKEWORD", "invalidMode");
+                m_mode = LoopbackDetector::Mode::WAKEWORD;
+            }
+        }
+
+        if (configRoot.HasMember("correlation") && configRoot["correlation"].IsObject()) {
+            auto correlation = configRoot["correlation"].GetObject();
+
+            if (correlation.HasMember("threshold") && correlation["threshold"].IsNumber()) {
+                m_correlationConfig.threshold = correlation["threshold"].GetFloat();
+            }
+            if (correlation.HasMember("maxDelay") && correlation["maxDelay"].IsUint()) {
+                m_correlationConfig.maxDelay = std::chrono::milliseconds(correlation["maxDelay"].GetUint());
+            }
+            if (correlation.HasMember("silenceThreshold") && correlation["silenceThreshold"].IsNumber()) {
+                m_correlationConfig.silenceThreshold = correlation["silenceThreshold"].GetFloat();
+            }
+        }
+
         return true;
     } catch (std::exception& ex) {
         AACE_WARN(LX(TAG, "configure").d("reason", ex.what()));
@@ -94,8 +148,12 @@ bool LoopbackDetectorEngineService::prepareVerifier() {
         auto wwManager = alexaEngineService->getServiceInterface<alexa::WakewordEngineManager>();
         ThrowIfNull(wwManager, "WakewordEngineManager has not been registered");
 
-        auto secondaryAdapter =
-            wwManager->createAdapter(alexa::WakewordEngineManager::AdapterType::SECONDARY, m_wakewordEngineName);
+        // the correlation mode doesn't run a second wakeword engine
+        std::shared_ptr<alexa::WakewordEngineAdapter> secondaryAdapter;
+        if (m_mode == LoopbackDetector::Mode::WAKEWORD) {
+            secondaryAdapter =
+                wwManager->createAdapter(alexa::WakewordEngineManager::AdapterType::SECONDARY, m_wakewordEngineName);
+        }
 
         AudioFormat audioFormat;
         audioFormat.sampleRateHz = 16000;
@@ -112,7 +170,16 @@ bool LoopbackDetectorEngineService::prepareVerifier() {
         ThrowIfNull(propertyManager, "nullPropertyManagerServiceInterface");
         auto locale = propertyManager->getProperty(aace::alexa::property::LOCALE);
 
-        m_initiatorVerifier = LoopbackDetector::create(locale, audioFormat, audioManager, secondaryAdapter);
+        m_initiatorVerifier = LoopbackDetector::create(
+            locale,
+            audioFormat,
+            audioManager,
+            secondaryAdapter,
+            m_audioBufferDuration,
+            m_audioBufferMaxReaders,
+            m_voiceActivityGateConfig,
+            m_mode,
+            m_correlationConfig);
         ThrowIfNull(m_initiatorVerifier, "Failed to create LoopbackDetector");
 
         return true;
@@ -18,11 +18,15 @@
 #ifndef AACE_ENGINE_LOOPBACKDETECTOR_LOOPBACK_DETECTOR_ENGINE_SERVICE_H
 #define AACE_ENGINE_LOOPBACKDETECTOR_LOOPBACK_DETECTOR_ENGINE_SERVICE_H
 
+#include <chrono>
 #include <memory>
+#include <AACE/Engine/Audio/VoiceActivityGate.h>
 #include <AACE/Engine/Core/EngineService.h>
 #include <AACE/Engine/Alexa/AlexaEngineService.h>
 #include <AACE/Engine/Alexa/InitiatorVerifier.h>
 
+#include "LoopbackDetector.h"
+
 namespace aace {
 namespace engine {
 namespace loopbackDetector {
@@ -43,6 +47,11 @@ private:
     bool prepareVerifier();
 
     std::string m_wakewordEngineName;
+    std::chrono::milliseconds m_audioBufferDuration;
+    size_t m_audioBufferMaxReaders;
+    audio::VoiceActivityGate::Config m_voiceActivityGateConfig;
+    LoopbackDetector::Mode m_mode = LoopbackDetector::Mode::WAKEWORD;
+    LoopbackDetector::CorrelationConfig m_correlationConfig;
     std::shared_ptr<alexa::InitiatorVerifier> m_initiatorVerifier;
 };
 
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_MESSAGING_CONVERSATIONS_REPORT_INDEX_H
+#define AACE_ENGINE_MESSAGING_CONVERSATIONS_REPORT_INDEX_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <AACE/Engine/Storage/LocalStorageInterface.h>
+
+namespace aace {
+namespace engine {
+namespace messaging {
+
+/**
+ * Persists a content hash of each conversation of the last conversations report uploaded to the cloud, and the
+ * time of the upload. The next report is compared to it to find whether any conversation was added, changed or
+ * removed since, so a report the cloud already has is not uploaded again.
+ */
+class ConversationsReportIndex {
+public:
+    /// Maps the id of a conversation to the hash of its content
+    using ConversationHashes = std::unordered_map<std::string, std::string>;
+
+    /**
+     * Creates a conversations report index.
+     *
+     * @param localStorage The storage of the index.
+     * @param refreshInterval The time after which an unchanged report is uploaded again, since the cloud only
+     *        keeps the unread messages for a limited time.
+     */
+    static std::shared_ptr<ConversationsReportIndex> create(
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage,
+        std::chrono::seconds refreshInterval = std::chrono::hours(12));
+
+    /**
+     * Computes the hash of each conversation of a conversations report. The report is walked one conversation at
+     * a time, so a large report is never parsed as a whole.
+     *
+     * @param conversations The conversations report, a JSON array of conversations.
+     * @param [out] conversationHashes The hashes of the conversations of the report.
+     * @return @c false if the report is not a valid conversations report.
+     */
+    static bool computeHashes(const std::string& conversations, ConversationHashes& conversationHashes);
+
+    /**
+     * Records a conversations report uploaded to the cloud, replacing the previous report.
+     *
+     * @param conversations The conversations report.
+     * @return @c true if the report differs from the previous report, the previous report was recorded more than
+     *         the refresh interval ago, or the report could not be compared.
+     */
+    bool record(const std::string& conversations);
+
+    /// Forgets the last report, so the next report is considered changed.
+    bool clear();
+
+private:
+    ConversationsReportIndex(
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage,
+        std::chrono::seconds refreshInterval);
+
+    /// Forgets the last report. @c m_mutex must be held.
+    bool clearLocked();
+
+    /// Loads the hashes and the time of the last report. @c m_mutex must be held.
+    bool loadLocked(ConversationHashes& conversationHashes, std::chrono::system_clock::time_point& recordTime);
+
+    /// Saves the hashes of a report recorded now. @c m_mutex must be held.
+    bool saveLocked(const ConversationHashes& conversationHashes);
+
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> m_localStorage;
+    const std::chrono::seconds m_refreshInterval;
+
+    /// Serializes the updates of the index
+    std::mutex m_mutex;
+};
+
+}  // namespace messaging
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_MESSAGING_CONVERSATIONS_REPORT_INDEX_H
@@ -24,6 +24,11 @@
 #include <AVSCommon/Utils/DeviceInfo.h>
 #include <Messaging/MessagingCapabilityAgent.h>
 
+#include <AACE/Engine/Network/BackgroundTransferScheduler.h>
+#include <AACE/Engine/Storage/LocalStorageInterface.h>
+
+#include "AACE/Engine/Messaging/ConversationsReportIndex.h"
+
 #include "AACE/Messaging/Messaging.h"
 #include "AACE/Messaging/MessagingEngineInterface.h"
 
@@ -50,7 +55,9 @@ private:
     /**
      * Constructor.
      */
-    MessagingEngineImpl(std::shared_ptr<aace::messaging::Messaging> messagingPlatformInterface);
+    MessagingEngineImpl(
+        std::shared_ptr<aace::messaging::Messaging> messagingPlatformInterface,
+        std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler);
 
     /**
      * Initialize the @c MessagingEngineImpl and @c MessagingCapabilityAgent.
@@ -67,6 +74,11 @@ public:
      * Factory method for creating instance of @c MessagingEngineImpl which handles
      * instantiation of @c MessagingCapabilityAgent as well as adding itself as an observer
      * for messaging directives.
+     *
+     * The conversations are uploaded through the @c backgroundTransferScheduler if it is provided, so the upload
+     * is deferred on a weak wifi signal, a metered link or during a voice interaction. The last conversations
+     * report uploaded is recorded in the @c localStorage if it is provided, so an unsolicited report with the same
+     * conversations is not uploaded again.
      */
     static std::shared_ptr<MessagingEngineImpl> create(
         std::shared_ptr<aace::messaging::Messaging> messagingPlatformInterface,
@@ -74,7 +86,9 @@ public:
             capabilitiesRegistrar,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender);
+        std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
+        std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler = nullptr,
+        std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage = nullptr);
 
     /// @name MessagingEngineInterface
     /// @{
@@ -105,6 +119,13 @@ protected:
     /// @}
 
 private:
+    /**
+     * Asks the platform to upload the conversations.
+     *
+     * @param token The token of the upload request.
+     */
+    void executeUploadConversations(const std::string& token);
+
     /**
      * Convert from @c ErrorCode to capability agent @c StatusErrorCode 
      * by explicitly comparing enum values instead of static casting.
@@ -135,6 +156,12 @@ private:
     /// Auto SDK Messaging platform interface handler instance
     std::shared_ptr<aace::messaging::Messaging> m_messagingPlatformInterface;
 
+    /// Defers the conversation uploads, null if not available
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> m_backgroundTransferScheduler;
+
+    /// Records the last conversations report uploaded, null if the local storage is not available
+    std::shared_ptr<ConversationsReportIndex> m_conversationsReportIndex;
+
     /// AVS MessagingCapabilityAgent instance
     std::shared_ptr<alexaClientSDK::capabilityAgents::messaging::MessagingCapabilityAgent> m_messagingCapabilityAgent;
 };
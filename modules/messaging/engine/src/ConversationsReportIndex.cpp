@@ -0,0 +1,255 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "AACE/Engine/Messaging/ConversationsReportIndex.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+
+using json = nlohmann::json;
+
+namespace aace {
+namespace engine {
+namespace messaging {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.messaging.ConversationsReportIndex");
+
+/// Table of the time of the last report. The report is only recorded once its time is written, after the hashes of
+/// its conversations, so an interrupted save never leaves a partial report behind.
+static const std::string MESSAGING_TABLE = "aace.messaging";
+
+/// Key of the time of the last report, in milliseconds since the epoch
+static const std::string REPORT_TIME_KEY = "conversationsReportTime";
+
+/// Table of the hashes of the conversations of the last report
+static const std::string CONVERSATIONS_TABLE = "aace.messaging.conversationsReport";
+
+/// FNV-1a 64 bit offset basis
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+/// FNV-1a 64 bit prime
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/// Returns a hash of a conversation, which is stable across Engine runs.
+static std::string hashConversation(const std::string& content) {
+    // std::hash is not guaranteed to be the same across Engine builds, so the persisted hashes use FNV-1a
+    uint64_t value = FNV_OFFSET_BASIS;
+    for (auto c : content) {
+        value ^= static_cast<uint8_t>(c);
+        value *= FNV_PRIME;
+    }
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return std::string(buffer);
+}
+
+static bool isWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+std::shared_ptr<ConversationsReportIndex> ConversationsReportIndex::create(
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage,
+    std::chrono::seconds refreshInterval) {
+    try {
+        ThrowIfNull(localStorage, "invalidLocalStorage");
+        ThrowIf(refreshInterval.count() <= 0, "invalidRefreshInterval");
+        return std::shared_ptr<ConversationsReportIndex>(new ConversationsReportIndex(localStorage, refreshInterval));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+ConversationsReportIndex::ConversationsReportIndex(
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage,
+    std::chrono::seconds refreshInterval) :
+        m_localStorage(localStorage), m_refreshInterval(refreshInterval) {
+}
+
+bool ConversationsReportIndex::computeHashes(
+    const std::string& conversations,
+    ConversationHashes& conversationHashes) {
+    try {
+        conversationHashes.clear();
+
+        // find the bounds of each conversation of the top level array, and parse the conversations one at a time
+        size_t pos = 0;
+        while (pos < conversations.size() && isWhitespace(conversations[pos])) {
+            pos++;
+        }
+        ThrowIf(pos == conversations.size() || conversations[pos] != '[', "reportNotAnArray");
+        pos++;
+
+        size_t depth = 0;
+        size_t start = 0;
+        bool inString = false;
+        bool escaped = false;
+        bool closed = false;
+        for (; pos < conversations.size() && !closed; pos++) {
+            auto c = conversations[pos];
+            if (inString) {
+                if (escaped) {
+                    escaped = false;
+                } else if (c == '\\') {
+                    escaped = true;
+                } else if (c == '"') {
+                    inString = false;
+                }
+                continue;
+            }
+            switch (c) {
+                case '"':
+                    ThrowIf(depth == 0, "conversationNotAnObject");
+                    inString = true;
+                    break;
+                case '{':
+                case '[':
+                    if (depth == 0) {
+                        start = pos;
+                    }
+                    depth++;
+                    break;
+                case '}':
+                case ']':
+                    if (depth == 0) {
+                        ThrowIf(c != ']', "unexpectedEndOfObject");
+                        closed = true;
+                    } else if (--depth == 0) {
+                        auto conversation =
+                            json::parse(conversations.begin() + start, conversations.begin() + pos + 1);
+                        ThrowIfNot(conversation.is_object(), "conversationNotAnObject");
+                        auto id = conversation.find("id");
+                        ThrowIf(id == conversation.end() || !id->is_string(), "invalidConversationId");
+                        conversationHashes[id->get<std::string>()] = hashConversation(conversation.dump());
+                    }
+                    break;
+                default:
+                    ThrowIf(depth == 0 && c != ',' && !isWhitespace(c), "conversationNotAnObject");
+                    break;
+            }
+        }
+        ThrowIfNot(closed, "unterminatedReport");
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "computeHashes").d("reason", ex.what()));
+        conversationHashes.clear();
+        return false;
+    }
+}
+
+bool ConversationsReportIndex::record(const std::string& conversations) {
+    try {
+        ConversationHashes conversationHashes;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!computeHashes(conversations, conversationHashes)) {
+            // the report can't be compared, so it is uploaded as it is, and the next report is always uploaded
+            clearLocked();
+            return true;
+        }
+
+        ConversationHashes recordedHashes;
+        std::chrono::system_clock::time_point recordTime;
+        auto loaded = loadLocked(recordedHashes, recordTime);
+        auto changed = !loaded || recordedHashes != conversationHashes ||
+                       std::chrono::system_clock::now() - recordTime >= m_refreshInterval;
+        if (changed) {
+            ThrowIfNot(saveLocked(conversationHashes), "saveReportFailed");
+        }
+        AACE_DEBUG(LX(TAG).d("conversations", conversationHashes.size()).d("changed", changed));
+        return changed;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "record").d("reason", ex.what()));
+        return true;
+    }
+}
+
+bool ConversationsReportIndex::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return clearLocked();
+}
+
+bool ConversationsReportIndex::clearLocked() {
+    try {
+        if (m_localStorage->containsKey(MESSAGING_TABLE, REPORT_TIME_KEY)) {
+            ThrowIfNot(m_localStorage->removeKey(MESSAGING_TABLE, REPORT_TIME_KEY), "removeReportTimeFailed");
+        }
+        if (m_localStorage->containsTable(CONVERSATIONS_TABLE)) {
+            ThrowIfNot(m_localStorage->removeTable(CONVERSATIONS_TABLE), "removeConversationsFailed");
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "clear").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool ConversationsReportIndex::loadLocked(
+    ConversationHashes& conversationHashes,
+    std::chrono::system_clock::time_point& recordTime) {
+    try {
+        if (!m_localStorage->containsKey(MESSAGING_TABLE, REPORT_TIME_KEY)) {
+            return false;
+        }
+        recordTime = std::chrono::system_clock::time_point(
+            std::chrono::milliseconds(std::stoll(m_localStorage->get(MESSAGING_TABLE, REPORT_TIME_KEY))));
+
+        conversationHashes.clear();
+        if (m_localStorage->containsTable(CONVERSATIONS_TABLE)) {
+            ThrowIfNot(
+                m_localStorage->forEach(
+                    CONVERSATIONS_TABLE,
+                    [&conversationHashes](const std::string& key, const std::string& value) {
+                        conversationHashes[key] = value;
+                        return true;
+                    }),
+                "readConversationsFailed");
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "load").d("reason", ex.what()));
+        return false;
+    }
+}
+
+bool ConversationsReportIndex::saveLocked(const ConversationHashes& conversationHashes) {
+    try {
+        // forget the previous report first, so the report is not recorded until all of its conversations are written
+        ThrowIfNot(clearLocked(), "clearReportFailed");
+
+        std::vector<aace::engine::storage::LocalStorageInterface::KeyValuePair> values(
+            conversationHashes.begin(), conversationHashes.end());
+        if (!values.empty()) {
+            ThrowIfNot(m_localStorage->putBatch(CONVERSATIONS_TABLE, values), "putConversationsFailed");
+        }
+        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch());
+        ThrowIfNot(
+            m_localStorage->put(MESSAGING_TABLE, REPORT_TIME_KEY, std::to_string(now.count())),
+            "putReportTimeFailed");
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "save").d("reason", ex.what()));
+        return false;
+    }
+}
+
+}  // namespace messaging
+}  // namespace engine
+}  // namespace aace
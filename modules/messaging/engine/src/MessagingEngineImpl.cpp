@@ -39,15 +39,19 @@ static const std::string METRIC_MESSAGING_UPDATE_MESSAGES_STATUS = "UpdateMessag
 static const std::string METRIC_MESSAGING_SEND_MESSAGE_SUCCEEDED = "SendMessageSucceeded";
 static const std::string METRIC_MESSAGING_SEND_MESSAGE_FAILED = "SendMessageFailed";
 static const std::string METRIC_MESSAGING_CONVERSATIONS_REPORT = "ConversationsReport";
+static const std::string METRIC_MESSAGING_CONVERSATIONS_REPORT_UNCHANGED = "ConversationsReportUnchanged";
 static const std::string METRIC_MESSAGING_UPDATE_MESSAGES_STATUS_SUCCEEDED = "UpdateMessagesStatusSucceeded";
 static const std::string METRIC_MESSAGING_UPDATE_MESSAGES_STATUS_FAILED = "UpdateMessagesStatusFailed";
 static const std::string METRIC_MESSAGING_UPDATE_MESSAGING_ENDPOINT_STATE = "UpdateMessagingEndpointState";
 
 using namespace alexaClientSDK::capabilityAgents::messaging;
 
-MessagingEngineImpl::MessagingEngineImpl(std::shared_ptr<aace::messaging::Messaging> messagingPlatformInterface) :
+MessagingEngineImpl::MessagingEngineImpl(
+    std::shared_ptr<aace::messaging::Messaging> messagingPlatformInterface,
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler) :
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
-        m_messagingPlatformInterface(messagingPlatformInterface) {
+        m_messagingPlatformInterface(messagingPlatformInterface),
+        m_backgroundTransferScheduler(backgroundTransferScheduler) {
 }
 
 bool MessagingEngineImpl::initialize(
@@ -82,7 +86,9 @@ std::shared_ptr<MessagingEngineImpl> MessagingEngineImpl::create(
         capabilitiesRegistrar,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender) {
+    std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
+    std::shared_ptr<aace::engine::network::BackgroundTransferScheduler> backgroundTransferScheduler,
+    std::shared_ptr<aace::engine::storage::LocalStorageInterface> localStorage) {
     try {
         ThrowIfNull(messagingPlatformInterface, "nullPlatformInterface");
         ThrowIfNull(capabilitiesRegistrar, "nullCapabilitiesRegistrar");
@@ -90,13 +96,18 @@ std::shared_ptr<MessagingEngineImpl> MessagingEngineImpl::create(
         ThrowIfNull(exceptionSender, "nullExceptionSender");
         ThrowIfNull(messageSender, "nullMessageSender");
 
-        auto messagingEngineImpl =
-            std::shared_ptr<MessagingEngineImpl>(new MessagingEngineImpl(messagingPlatformInterface));
+        auto messagingEngineImpl = std::shared_ptr<MessagingEngineImpl>(
+            new MessagingEngineImpl(messagingPlatformInterface, backgroundTransferScheduler));
 
         ThrowIfNot(
             messagingEngineImpl->initialize(capabilitiesRegistrar, exceptionSender, contextManager, messageSender),
             "initializeMessagingEngineImplFailed");
 
+        // without the index every conversations report is uploaded
+        if (localStorage != nullptr) {
+            messagingEngineImpl->m_conversationsReportIndex = ConversationsReportIndex::create(localStorage);
+        }
+
         // set the platform engine interface reference
         messagingPlatformInterface->setEngineInterface(messagingEngineImpl);
 
@@ -184,6 +195,26 @@ void MessagingEngineImpl::uploadConversations(
     const std::string& payload) {
     AACE_INFO(LX(TAG).sensitive("payload", payload));
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "uploadConversations", {METRIC_MESSAGING_UPLOAD_CONVERSATIONS});
+
+    // a request received while the previous one is deferred replaces it, so the conversations are uploaded once
+    if (m_backgroundTransferScheduler != nullptr) {
+        std::weak_ptr<MessagingEngineImpl> wp = shared_from_this();
+        auto submitted = m_backgroundTransferScheduler->submit(
+            "Messaging.uploadConversations",
+            aace::engine::network::BackgroundTransferScheduler::Priority::BACKGROUND,
+            [wp, token]() {
+                if (auto messagingEngineImpl = wp.lock()) {
+                    messagingEngineImpl->executeUploadConversations(token);
+                }
+            });
+        if (submitted) {
+            return;
+        }
+    }
+    executeUploadConversations(token);
+}
+
+void MessagingEngineImpl::executeUploadConversations(const std::string& token) {
     if (m_messagingPlatformInterface != nullptr) {
         m_messagingPlatformInterface->uploadConversations(token);
     }
@@ -192,6 +223,16 @@ void MessagingEngineImpl::uploadConversations(
 void MessagingEngineImpl::onConversationsReport(const std::string& token, const std::string& conversations) {
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "onConversationsReport", {METRIC_MESSAGING_CONVERSATIONS_REPORT});
     if (m_messagingCapabilityAgent != nullptr) {
+        // the report replaces the unread messages of the cloud, so it is uploaded as a whole, but an unsolicited
+        // report with the same conversations as the last one uploaded is dropped. A report requested by the cloud
+        // is always uploaded, since the cloud waits for its token.
+        auto changed = m_conversationsReportIndex == nullptr || m_conversationsReportIndex->record(conversations);
+        if (token.empty() && !changed) {
+            AACE_INFO(LX(TAG).m("conversationsReportUnchanged"));
+            emitCounterMetrics(
+                METRIC_PROGRAM_NAME_SUFFIX, "onConversationsReport", {METRIC_MESSAGING_CONVERSATIONS_REPORT_UNCHANGED});
+            return;
+        }
         AACE_INFO(LX(TAG).d("token", token).sensitive("conversations", conversations));
         m_messagingCapabilityAgent->conversationsReport(token, conversations);
     }
@@ -263,6 +304,12 @@ void MessagingEngineImpl::onUpdateMessagingEndpointState(
             convertPermissionState(readPermission));
         m_messagingCapabilityAgent->updateMessagingEndpointState(messagingEndpointState, MessagingEndpoint::DEFAULT);
     }
+
+    // the cloud drops the messages of an endpoint it can't read, so the next report is uploaded as changed
+    if (m_conversationsReportIndex != nullptr &&
+        (connectionState == ConnectionState::DISCONNECTED || readPermission == PermissionState::OFF)) {
+        m_conversationsReportIndex->clear();
+    }
 }
 
 MessagingCapabilityAgent::StatusErrorCode MessagingEngineImpl::convertErrorCode(ErrorCode code) {
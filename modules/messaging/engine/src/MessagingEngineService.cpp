@@ -81,8 +81,22 @@ bool MessagingEngineService::registerPlatformInterfaceType(std::shared_ptr<aace:
         auto contextManager = alexaComponents->getContextManager();
         ThrowIfNull(contextManager, "contextManagerInvalid");
 
+        // the conversation uploads are deferred on a weak wifi signal, a metered link or during a voice interaction
+        auto backgroundTransferScheduler =
+            getContext()->getServiceInterface<aace::engine::network::BackgroundTransferScheduler>("aace.network");
+
+        // the last conversations report uploaded is recorded, so an unchanged report is not uploaded again
+        auto localStorage =
+            getContext()->getServiceInterface<aace::engine::storage::LocalStorageInterface>("aace.storage");
+
         m_messagingEngineImpl = aace::engine::messaging::MessagingEngineImpl::create(
-            messaging, defaultCapabilitiesRegistrar, exceptionSender, contextManager, messageSender);
+            messaging,
+            defaultCapabilitiesRegistrar,
+            exceptionSender,
+            contextManager,
+            messageSender,
+            backgroundTransferScheduler,
+            localStorage);
         ThrowIfNull(m_messagingEngineImpl, "createMessagingEngineImplFailed");
 
         return true;
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/Messaging/ConversationsReportIndex.h>
+#include <AACE/Test/Unit/Storage/InMemoryLocalStorage.h>
+
+namespace aace {
+namespace test {
+namespace unit {
+namespace messaging {
+
+using aace::engine::messaging::ConversationsReportIndex;
+using aace::test::unit::storage::InMemoryLocalStorage;
+
+/// A report of two conversations
+static const std::string REPORT = R"([
+    {"id": "1", "otherParticipants": [], "messages": [{"id": "a", "payload": {"@type": "text", "text": "[hi]"}}]},
+    {"id": "2", "otherParticipants": [], "messages": [{"id": "b", "payload": {"@type": "text", "text": "\"}{"}}]}
+])";
+
+class ConversationsReportIndexTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_localStorage = std::make_shared<InMemoryLocalStorage>();
+        m_reportIndex = ConversationsReportIndex::create(m_localStorage);
+        ASSERT_NE(m_reportIndex, nullptr);
+    }
+
+protected:
+    std::shared_ptr<InMemoryLocalStorage> m_localStorage;
+    std::shared_ptr<ConversationsReportIndex> m_reportIndex;
+};
+
+TEST_F(ConversationsReportIndexTest, CreateWithInvalidArgumentsShouldFail) {
+    EXPECT_EQ(ConversationsReportIndex::create(nullptr), nullptr);
+    EXPECT_EQ(ConversationsReportIndex::create(m_localStorage, std::chrono::seconds(0)), nullptr);
+}
+
+TEST_F(ConversationsReportIndexTest, ComputeHashesShouldHashEachConversation) {
+    ConversationsReportIndex::ConversationHashes hashes;
+    ASSERT_TRUE(ConversationsReportIndex::computeHashes(REPORT, hashes));
+    ASSERT_EQ(hashes.size(), 2u);
+    EXPECT_NE(hashes["1"], hashes["2"]);
+
+    // the hash doesn't depend on the formatting of the report
+    ConversationsReportIndex::ConversationHashes compactHashes;
+    ASSERT_TRUE(ConversationsReportIndex::computeHashes(
+        R"([{"id":"1","otherParticipants":[],"messages":[{"id":"a","payload":{"@type":"text","text":"[hi]"}}]}])",
+        compactHashes));
+    EXPECT_EQ(compactHashes["1"], hashes["1"]);
+
+    ASSERT_TRUE(ConversationsReportIndex::computeHashes(" [ ] ", hashes));
+    EXPECT_TRUE(hashes.empty());
+}
+
+TEST_F(ConversationsReportIndexTest, ComputeHashesOfInvalidReportShouldFail) {
+    ConversationsReportIndex::ConversationHashes hashes;
+    EXPECT_FALSE(ConversationsReportIndex::computeHashes("", hashes));
+    EXPECT_FALSE(ConversationsReportIndex::computeHashes("{\"id\":\"1\"}", hashes));
+    EXPECT_FALSE(ConversationsReportIndex::computeHashes("[{\"id\":\"1\"}", hashes));
+    EXPECT_FALSE(ConversationsReportIndex::computeHashes("[\"1\"]", hashes));
+    EXPECT_FALSE(ConversationsReportIndex::computeHashes("[{\"messages\":[]}]", hashes));
+    EXPECT_FALSE(ConversationsReportIndex::computeHashes("[{\"id\":1}]", hashes));
+    EXPECT_FALSE(ConversationsReportIndex::computeHashes("[[]]", hashes));
+    EXPECT_TRUE(hashes.empty());
+}
+
+TEST_F(ConversationsReportIndexTest, RecordShouldDetectChangedReports) {
+    EXPECT_TRUE(m_reportIndex->record(REPORT));
+    EXPECT_FALSE(m_reportIndex->record(REPORT));
+
+    // a conversation removed
+    auto report =
+        R"([{"id":"1","otherParticipants":[],"messages":[{"id":"a","payload":{"@type":"text","text":"[hi]"}}]}])";
+    EXPECT_TRUE(m_reportIndex->record(report));
+    EXPECT_FALSE(m_reportIndex->record(report));
+
+    // a message read
+    EXPECT_TRUE(m_reportIndex->record(R"([{"id":"1","otherParticipants":[],"messages":[]}])"));
+}
+
+TEST_F(ConversationsReportIndexTest, RecordShouldKeepTheReportAcrossInstances) {
+    EXPECT_TRUE(m_reportIndex->record(REPORT));
+    auto reportIndex = ConversationsReportIndex::create(m_localStorage);
+    ASSERT_NE(reportIndex, nullptr);
+    EXPECT_FALSE(reportIndex->record(REPORT));
+}
+
+TEST_F(ConversationsReportIndexTest, RecordShouldRefreshReportAfterTheRefreshInterval) {
+    auto reportIndex = ConversationsReportIndex::create(m_localStorage, std::chrono::seconds(1));
+    ASSERT_NE(reportIndex, nullptr);
+    EXPECT_TRUE(reportIndex->record(REPORT));
+    EXPECT_FALSE(reportIndex->record(REPORT));
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    EXPECT_TRUE(reportIndex->record(REPORT));
+}
+
+TEST_F(ConversationsReportIndexTest, RecordInvalidReportShouldForgetTheLastReport) {
+    EXPECT_TRUE(m_reportIndex->record(REPORT));
+    EXPECT_TRUE(m_reportIndex->record("invalid"));
+    EXPECT_TRUE(m_reportIndex->record(REPORT));
+}
+
+TEST_F(ConversationsReportIndexTest, ClearShouldForgetTheLastReport) {
+    EXPECT_TRUE(m_reportIndex->record(REPORT));
+    ASSERT_TRUE(m_reportIndex->clear());
+    EXPECT_FALSE(m_localStorage->containsTable("aace.messaging.conversationsReport"));
+    EXPECT_TRUE(m_reportIndex->record(REPORT));
+}
+
+}  // namespace messaging
+}  // namespace unit
+}  // namespace test
+}  // namespace aace
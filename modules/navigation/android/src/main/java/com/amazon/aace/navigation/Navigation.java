@@ -706,6 +706,18 @@ abstract public class Navigation extends PlatformInterface {
         showAlternativeRoutesSucceeded(getNativeRef(), payload);
     }
 
+    /**
+     * Notifies the Engine of a change of the navigation state. Once the platform implementation publishes the
+     * navigation state, the Engine answers the navigation context requests with the latest published state, and no
+     * longer calls {@link #getNavigationState()}.
+     *
+     * @param navigationState The current navigation state JSON payload, in the format of
+     * {@link #getNavigationState()}
+     */
+    final protected void navigationStateChanged(String navigationState) {
+        navigationStateChanged(getNativeRef(), navigationState);
+    }
+
     // NativeRef implementation
     final protected long createNativeRef() {
         return createBinder();
@@ -721,6 +733,7 @@ abstract public class Navigation extends PlatformInterface {
     private native void navigationError(long nativeRef, ErrorType type, ErrorCode code, String description);
     private native void navigationEvent(long nativeRef, EventName event);
     private native void showAlternativeRoutesSucceeded(long nativeRef, String payload);
+    private native void navigationStateChanged(long nativeRef, String navigationState);
 }
 
 // END OF FILE
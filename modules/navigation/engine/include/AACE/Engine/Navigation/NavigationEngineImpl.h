@@ -16,6 +16,10 @@
 #ifndef AACE_ENGINE_NAVIGATION_NAVIGATION_ENGINE_IMPL_H
 #define AACE_ENGINE_NAVIGATION_NAVIGATION_ENGINE_IMPL_H
 
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <AVSCommon/SDKInterfaces/Endpoints/EndpointCapabilitiesRegistrarInterface.h>
 
 #include <AACE/Navigation/Navigation.h>
@@ -26,6 +30,7 @@
 #include "NavigationHandlerInterface.h"
 #include "DisplayManagerCapabilityAgent.h"
 #include "NavigationAssistanceCapabilityAgent.h"
+#include "RouteShapeProcessor.h"
 
 namespace aace {
 namespace engine {
@@ -40,7 +45,8 @@ class NavigationEngineImpl
 private:
     NavigationEngineImpl(
         std::shared_ptr<aace::navigation::Navigation> navigationPlatformInterface,
-        const std::string& navigationProviderName);
+        const std::string& navigationProviderName,
+        std::shared_ptr<RouteShapeProcessor> routeShapeProcessor);
 
     bool initialize(
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::endpoints::EndpointCapabilitiesRegistrarInterface>
@@ -59,7 +65,8 @@ public:
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
         std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-        const std::string& navigationProviderName);
+        const std::string& navigationProviderName,
+        std::shared_ptr<RouteShapeProcessor> routeShapeProcessor = nullptr);
 
     /// @name @c NavigationHandlerInterface functions.
     /// @{
@@ -86,8 +93,27 @@ public:
         aace::navigation::NavigationEngineInterface::ErrorCode code,
         const std::string& description) override;
     void onShowAlternativeRoutesSucceeded(const std::string& payload) override;
+    void onNavigationStateChanged(const std::string& navigationState) override;
     /// @}
 
+    /**
+     * Extracts the alternate route of a @c ShowAlternativeRoutesSucceeded payload of the platform. The payload is
+     * streamed rather than parsed into a document, so the fields the event doesn't send, such as the route shapes,
+     * are skipped as they are read. The labels and savings beyond the limits of the event are dropped, and the
+     * labels are truncated to the longest label of the event.
+     *
+     * @param payload The payload of the platform.
+     * @param [out] queryType The inquiry type of the alternate route.
+     * @param [out] labels The labels of the alternate route, not empty.
+     * @param [out] savings The savings of the alternate route.
+     * @throws std::exception if the payload is not a valid alternate route.
+     */
+    static void parseAlternateRoute(
+        const std::string& payload,
+        aace::engine::navigation::AlternativeRoutesQueryType& queryType,
+        std::vector<std::string>& labels,
+        std::vector<aace::engine::navigation::RouteSavings>& savings);
+
 protected:
     void doShutdown() override;
 
@@ -109,6 +135,19 @@ private:
     std::shared_ptr<DisplayManagerCapabilityAgent> m_displayManagerCapabilityAgent;
     std::shared_ptr<navigationassistance::NavigationAssistanceCapabilityAgent> m_navigationAssistanceCapabilityAgent;
     std::string m_navigationProviderName;
+
+    /// Simplifies the route shapes of the navigation state, or @c nullptr to send the shapes as provided
+    std::shared_ptr<RouteShapeProcessor> m_routeShapeProcessor;
+
+    /// The latest navigation state published by the platform, which answers the context requests once published
+    std::string m_navigationState;
+    bool m_navigationStatePublished = false;
+    std::mutex m_navigationStateMutex;
+
+    /// The latest navigation state returned by the platform and its processed state, so the route shapes are only
+    /// simplified when the state changes
+    std::string m_rawNavigationState;
+    std::string m_processedNavigationState;
 };
 
 }  // namespace navigation
@@ -19,6 +19,7 @@
 #include "AACE/Engine/Alexa/AlexaEngineService.h"
 #include "AACE/Navigation/Navigation.h"
 #include "NavigationEngineImpl.h"
+#include "RouteShapeProcessor.h"
 
 namespace aace {
 namespace engine {
@@ -54,6 +55,10 @@ private:
 
     // Capability meta data for provider name passed by platform config
     std::string m_navigationProviderName;
+
+    // Fidelity of the route shapes sent in the navigation context, passed by platform config
+    size_t m_maxRouteShapePoints = RouteShapeProcessor::DEFAULT_MAX_POINT_COUNT;
+    double m_routeShapeTolerance = RouteShapeProcessor::DEFAULT_TOLERANCE;
 };
 
 }  // namespace navigation
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_NAVIGATION_PAYLOAD_SCANNER_H
+#define AACE_ENGINE_NAVIGATION_PAYLOAD_SCANNER_H
+
+#include <string>
+
+namespace aace {
+namespace engine {
+namespace navigation {
+
+/**
+ * Finds the string value of a top level member of a directive payload.
+ *
+ * The payload is scanned without building a document, and the scan stops at the value of the member, so a payload
+ * forwarded to the platform as it was received is only read up to the field the engine validates. The directive
+ * JSON is validated when the directive is parsed, before its payload is handled.
+ *
+ * @param payload The directive payload.
+ * @param name The name of the member.
+ * @param [out] value The value of the member.
+ * @return @c true if the payload is an object with a string member @c name before any JSON error, else @c false.
+ */
+bool findPayloadString(const std::string& payload, const std::string& name, std::string& value);
+
+}  // namespace navigation
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_NAVIGATION_PAYLOAD_SCANNER_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_NAVIGATION_ROUTE_SHAPE_PROCESSOR_H
+#define AACE_ENGINE_NAVIGATION_ROUTE_SHAPE_PROCESSOR_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace navigation {
+
+/**
+ * Simplifies the route shapes of the navigation state, so the navigation context sent with the events stays small.
+ *
+ * The shapes are simplified with the Douglas-Peucker algorithm: the points of the route closer than the tolerance
+ * to the simplified route are dropped. The points furthest from the simplified route are kept first, so when the
+ * route has more points than the point budget, the simplified route keeps the points that best describe it.
+ */
+class RouteShapeProcessor {
+public:
+    /// A latitude and longitude pair, in degrees
+    using Coordinate = std::pair<double, double>;
+
+    /// The default number of points of the simplified route, which is the most the navigation context accepts
+    static const size_t DEFAULT_MAX_POINT_COUNT;
+
+    /// The default tolerance, in meters, which only drops the points on a straight line
+    static const double DEFAULT_TOLERANCE;
+
+    /**
+     * Creates a route shape processor.
+     *
+     * @param maxPointCount The most points of the simplified route, at least 2.
+     * @param tolerance The distance in meters under which a point is dropped from the route, not negative.
+     */
+    static std::shared_ptr<RouteShapeProcessor> create(
+        size_t maxPointCount = DEFAULT_MAX_POINT_COUNT,
+        double tolerance = DEFAULT_TOLERANCE);
+
+    /**
+     * Simplifies the "shapes" of a navigation state.
+     *
+     * @param navigationState The navigation state JSON payload.
+     * @return The navigation state with the simplified shapes, or @c navigationState if its shapes don't need to
+     * be simplified or it is not a valid navigation state.
+     */
+    std::string process(const std::string& navigationState) const;
+
+    /**
+     * Simplifies a route.
+     *
+     * @param route The points of the route.
+     * @return The indices of the points of the simplified route, in the order of the route.
+     */
+    std::vector<size_t> simplify(const std::vector<Coordinate>& route) const;
+
+    size_t getMaxPointCount() const;
+
+    double getTolerance() const;
+
+private:
+    RouteShapeProcessor(size_t maxPointCount, double tolerance);
+
+    const size_t m_maxPointCount;
+    const double m_tolerance;
+};
+
+}  // namespace navigation
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_NAVIGATION_ROUTE_SHAPE_PROCESSOR_H
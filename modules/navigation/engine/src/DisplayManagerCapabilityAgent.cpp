@@ -16,7 +16,6 @@
 
 #include <string>
 #include <nlohmann/json.hpp>
-#include <rapidjson/error/en.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
@@ -24,6 +23,7 @@
 
 #include "AACE/Engine/Navigation/DisplayManagerCapabilityAgent.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Navigation/PayloadScanner.h"
 
 namespace aace {
 namespace engine {
@@ -128,6 +128,7 @@ void DisplayManagerCapabilityAgent::preHandleDirective(std::shared_ptr<Directive
 }
 
 void DisplayManagerCapabilityAgent::handleDirective(std::shared_ptr<DirectiveInfo> info) {
+    AACE_TRACE_SCOPE("directive", "DisplayManager.handleDirective");
     try {
         ThrowIfNot(info && info->directive, "nullDirectiveInfo");
 
@@ -212,27 +213,17 @@ void DisplayManagerCapabilityAgent::setHandlingCompleted(std::shared_ptr<Directi
 
 void DisplayManagerCapabilityAgent::handleControlDisplayDirective(std::shared_ptr<DirectiveInfo> info) {
     std::string payload = info->directive->getPayload();
-    rapidjson::Document json;
-    rapidjson::ParseResult result = json.Parse(&payload[0]);
-    if (!result) {
+    std::string mode;
+    if (!findPayloadString(payload, "mode", mode)) {
         AACE_ERROR(LX(TAG, "handleControlDisplayDirective")
-                       .d("reason", rapidjson::GetParseError_En(result.Code()))
+                       .d("reason", "missing mode value")
                        .d("messageId", info->directive->getMessageId()));
-        sendExceptionEncounteredAndReportFailed(
-            info,
-            "Unable to parse payload",
-            alexaClientSDK::avsCommon::avs::ExceptionErrorType::UNEXPECTED_INFORMATION_RECEIVED);
-        return;
-    }
-    if (!json.HasMember("mode")) {
-        AACE_ERROR(LX(TAG, "handleControlDisplayDirective").d("reason", "missing mode value"));
         sendExceptionEncounteredAndReportFailed(
             info,
             "Missing mode value",
             alexaClientSDK::avsCommon::avs::ExceptionErrorType::UNEXPECTED_INFORMATION_RECEIVED);
         return;
     }
-    std::string mode = json["mode"].GetString();
     const auto& iter = controlDisplayStringToEnumMap.find(mode);
     if (iter != controlDisplayStringToEnumMap.end()) {
         aace::engine::navigation::DisplayMode control = iter->second;
@@ -252,27 +243,17 @@ void DisplayManagerCapabilityAgent::handleControlDisplayDirective(std::shared_pt
 
 void DisplayManagerCapabilityAgent::handleShowAlternativeRoutesDirective(std::shared_ptr<DirectiveInfo> info) {
     std::string payload = info->directive->getPayload();
-    rapidjson::Document json;
-    rapidjson::ParseResult result = json.Parse(&payload[0]);
-    if (!result) {
+    std::string mode;
+    if (!findPayloadString(payload, "inquiryType", mode)) {
         AACE_ERROR(LX(TAG, "handleShowAlternativeRoutesDirective")
-                       .d("reason", rapidjson::GetParseError_En(result.Code()))
+                       .d("reason", "missing inquiryType value")
                        .d("messageId", info->directive->getMessageId()));
-        sendExceptionEncounteredAndReportFailed(
-            info,
-            "Unable to parse payload",
-            alexaClientSDK::avsCommon::avs::ExceptionErrorType::UNEXPECTED_INFORMATION_RECEIVED);
-        return;
-    }
-    if (!json.HasMember("inquiryType")) {
-        AACE_ERROR(LX(TAG, "handleControlDisplayDirective").d("reason", "missing inquiryType value"));
         sendExceptionEncounteredAndReportFailed(
             info,
             "Missing inquiryType value",
             alexaClientSDK::avsCommon::avs::ExceptionErrorType::UNEXPECTED_INFORMATION_RECEIVED);
         return;
     }
-    std::string mode = json["inquiryType"].GetString();
     if (alternateRouteTypeStringToEnumMap.find(mode) == alternateRouteTypeStringToEnumMap.end()) {
         AACE_ERROR(LX(TAG, "handleShowAlternativeRoutesDirective").m("invalidInquiryTypeValue"));
         sendExceptionEncounteredAndReportFailed(
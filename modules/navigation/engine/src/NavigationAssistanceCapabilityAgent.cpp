@@ -15,13 +15,13 @@
 #include <iostream>
 
 #include <string>
-#include <rapidjson/error/en.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <AVSCommon/Utils/JSON/JSONUtils.h>
 
 #include "AACE/Engine/Navigation/NavigationAssistanceCapabilityAgent.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Navigation/PayloadScanner.h"
 
 namespace aace {
 namespace engine {
@@ -105,6 +105,7 @@ void NavigationAssistanceCapabilityAgent::preHandleDirective(std::shared_ptr<Dir
 }
 
 void NavigationAssistanceCapabilityAgent::handleDirective(std::shared_ptr<DirectiveInfo> info) {
+    AACE_TRACE_SCOPE("directive", "NavigationAssistance.handleDirective");
     try {
         ThrowIfNot(info && info->directive, "nullDirectiveInfo");
 
@@ -200,27 +201,17 @@ void NavigationAssistanceCapabilityAgent::setHandlingCompleted(std::shared_ptr<D
 
 void NavigationAssistanceCapabilityAgent::handleAnnounceManeuverDirective(std::shared_ptr<DirectiveInfo> info) {
     std::string payload = info->directive->getPayload();
-    rapidjson::Document document;
-    rapidjson::ParseResult result = document.Parse(&payload[0]);
-    if (!result) {
+    std::string manueuverType;
+    if (!findPayloadString(payload, "type", manueuverType)) {
         AACE_ERROR(LX(TAG, "handleAnnounceManeuverDirective")
-                       .d("reason", rapidjson::GetParseError_En(result.Code()))
+                       .d("reason", "missing maneuverType value")
                        .d("messageId", info->directive->getMessageId()));
-        sendExceptionEncounteredAndReportFailed(
-            info,
-            "Unable to parse payload",
-            alexaClientSDK::avsCommon::avs::ExceptionErrorType::UNEXPECTED_INFORMATION_RECEIVED);
-        return;
-    }
-    if (!document.HasMember("type")) {
-        AACE_ERROR(LX(TAG, "handleAnnounceManeuverDirective").d("reason", "missing maneuverType value"));
         sendExceptionEncounteredAndReportFailed(
             info,
             "Missing maneuverType value",
             alexaClientSDK::avsCommon::avs::ExceptionErrorType::UNEXPECTED_INFORMATION_RECEIVED);
         return;
     }
-    std::string manueuverType = document["type"].GetString();
     if (announceManeuverTypeValues.find(manueuverType) == announceManeuverTypeValues.end()) {
         AACE_ERROR(LX(TAG, "handleAnnounceManeuverDirective").m("invalidManeuverTypeValue"));
         sendExceptionEncounteredAndReportFailed(
@@ -237,27 +228,17 @@ void NavigationAssistanceCapabilityAgent::handleAnnounceManeuverDirective(std::s
 
 void NavigationAssistanceCapabilityAgent::handleAnnounceRoadRegulationDirective(std::shared_ptr<DirectiveInfo> info) {
     std::string payload = info->directive->getPayload();
-    rapidjson::Document document;
-    rapidjson::ParseResult result = document.Parse(&payload[0]);
-    if (!result) {
+    std::string roadRegulationType;
+    if (!findPayloadString(payload, "type", roadRegulationType)) {
         AACE_ERROR(LX(TAG, "handleAnnounceRoadRegulationDirective")
-                       .d("reason", rapidjson::GetParseError_En(result.Code()))
+                       .d("reason", "missing roadRegulationType value")
                        .d("messageId", info->directive->getMessageId()));
-        sendExceptionEncounteredAndReportFailed(
-            info,
-            "Unable to parse payload",
-            alexaClientSDK::avsCommon::avs::ExceptionErrorType::UNEXPECTED_INFORMATION_RECEIVED);
-        return;
-    }
-    if (!document.HasMember("type")) {
-        AACE_ERROR(LX(TAG, "handleAnnounceRoadRegulationDirective").d("reason", "missing roadRegulationType value"));
         sendExceptionEncounteredAndReportFailed(
             info,
             "Missing roadRegulationType value",
             alexaClientSDK::avsCommon::avs::ExceptionErrorType::UNEXPECTED_INFORMATION_RECEIVED);
         return;
     }
-    std::string roadRegulationType = document["type"].GetString();
     if (roadRegulationTypeStringToEnumMap.find(roadRegulationType) == roadRegulationTypeStringToEnumMap.end()) {
         AACE_ERROR(LX(TAG, "handleAnnounceRoadRegulationDirective").m("invalidRoadRegulationTypeValue"));
         sendExceptionEncounteredAndReportFailed(
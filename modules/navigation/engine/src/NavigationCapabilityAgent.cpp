@@ -22,6 +22,7 @@
 
 #include "AACE/Engine/Navigation/NavigationCapabilityAgent.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/JSON/ArenaDocument.h"
 
 namespace aace {
 namespace engine {
@@ -131,6 +132,7 @@ void NavigationCapabilityAgent::preHandleDirective( std::shared_ptr<DirectiveInf
 }
 
 void NavigationCapabilityAgent::handleDirective( std::shared_ptr<DirectiveInfo> info ) {
+    AACE_TRACE_SCOPE( "directive", "Navigation.handleDirective" );
     try
     {
         ThrowIfNot( info && info->directive, "nullDirectiveInfo" );
@@ -242,7 +244,8 @@ void NavigationCapabilityAgent::setHandlingCompleted( std::shared_ptr<DirectiveI
 void NavigationCapabilityAgent::handleStartNavigationDirective( std::shared_ptr<DirectiveInfo> info )
 {
     std::string payload = info->directive->getPayload();
-    rapidjson::Document json;
+    aace::engine::utils::json::ArenaDocument arenaDocument;
+    auto& json = arenaDocument.get();
     rapidjson::ParseResult result = json.Parse( &payload[0]);
     if( !result ) {
         AACE_ERROR(LX(TAG, "handleStartNavigationDirective").d("reason", rapidjson::GetParseError_En(result.Code())).d("messageId", info->directive->getMessageId()));
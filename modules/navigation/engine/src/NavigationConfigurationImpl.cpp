@@ -42,6 +42,30 @@ std::shared_ptr<aace::core::config::EngineConfiguration> NavigationConfiguration
     return aace::core::config::StreamConfiguration::create(aace::engine::utils::json::toStream(document));
 }
 
+std::shared_ptr<aace::core::config::EngineConfiguration> NavigationConfiguration::createNavigationConfig(
+    const std::string& providerName,
+    unsigned int maxRouteShapePoints,
+    double routeShapeTolerance) {
+    rapidjson::Document document(rapidjson::kObjectType);
+    rapidjson::Value aaceNavigationElement(rapidjson::kObjectType);
+    rapidjson::Value routeShapeElement(rapidjson::kObjectType);
+
+    aaceNavigationElement.AddMember(
+        "providerName",
+        rapidjson::Value().SetString(providerName.c_str(), providerName.length()),
+        document.GetAllocator());
+
+    routeShapeElement.AddMember(
+        "maxPointCount", rapidjson::Value().SetUint(maxRouteShapePoints), document.GetAllocator());
+    routeShapeElement.AddMember(
+        "tolerance", rapidjson::Value().SetDouble(routeShapeTolerance), document.GetAllocator());
+    aaceNavigationElement.AddMember("routeShape", routeShapeElement, document.GetAllocator());
+
+    document.AddMember("aace.navigation", aaceNavigationElement, document.GetAllocator());
+
+    return aace::core::config::StreamConfiguration::create(aace::engine::utils::json::toStream(document));
+}
+
 }  // namespace config
 }  // namespace navigation
 }  // namespace aace
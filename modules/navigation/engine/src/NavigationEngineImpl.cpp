@@ -47,6 +47,7 @@ static const std::string METRIC_NAVIGATION_ANNOUNCE_ROADREGULATION = "AnnounceRo
 static const std::string METRIC_NAVIGATION_NAVIGATION_EVENT = "NavigationEvent";
 static const std::string METRIC_NAVIGATION_NAVIGATION_ERROR = "NavigationError";
 static const std::string METRIC_NAVIGATION_SHOW_ALTERNATIVE_ROUTES_SUCCEEDED = "ShowAlternativeRoutesSucceeded";
+static const std::string METRIC_NAVIGATION_NAVIGATION_STATE_CHANGED = "NavigationStateChanged";
 
 static const std::string ALT_ROUTE_INQUERY_TYPE_DEFAULT = "DEFAULT";
 static const std::string ALT_ROUTE_INQUERY_TYPE_SHORTER_TIME = "SHORTER_TIME";
@@ -61,12 +62,222 @@ static const std::string ALT_ROUTE_SAVINGS_UNIT_MILE = "MILE";
 static const std::string ALT_ROUTE_SAVINGS_UNIT_METER = "METER";
 static const std::string ALT_ROUTE_SAVINGS_UNIT_KILOMETER = "KILOMETER";
 
+/// The most labels of the alternate route sent in the event, the labels after them are dropped
+static const size_t MAX_ALTERNATE_ROUTE_LABEL_COUNT = 10;
+
+/// The longest label of the alternate route sent in the event, in bytes, longer labels are truncated
+static const size_t MAX_ALTERNATE_ROUTE_LABEL_LENGTH = 128;
+
+/// The most savings of the alternate route sent in the event, one for the time and one for the distance
+static const size_t MAX_ALTERNATE_ROUTE_SAVINGS_COUNT = 2;
+
+namespace {
+
+/**
+ * Extracts the fields of the @c ShowAlternativeRoutesSucceeded event from the payload of the platform, as the payload
+ * is read. The containers are tracked on a stack, and the values outside of the fields of the event are skipped.
+ */
+class AlternateRouteExtractor : public nlohmann::json::json_sax_t {
+public:
+    /// A savings of the alternate route
+    struct Savings {
+        double amount = 0;
+        std::string type;
+        std::string unit;
+        bool hasAmount = false;
+        bool hasType = false;
+        bool hasUnit = false;
+    };
+
+    bool null() override {
+        return setOther();
+    }
+
+    bool boolean(bool) override {
+        return setOther();
+    }
+
+    bool number_integer(number_integer_t value) override {
+        return setNumber(static_cast<double>(value));
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        return setNumber(static_cast<double>(value));
+    }
+
+    bool number_float(number_float_t value, const string_t&) override {
+        return setNumber(value);
+    }
+
+    bool string(string_t& value) override {
+        switch (getContext()) {
+            case Context::ROOT:
+                if (m_key == "inquiryType") {
+                    inquiryType = std::move(value);
+                    return true;
+                }
+                break;
+            case Context::LABELS:
+                if (labels.size() < MAX_ALTERNATE_ROUTE_LABEL_COUNT) {
+                    truncateLabel(value);
+                    labels.push_back(std::move(value));
+                } else {
+                    droppedLabelCount++;
+                }
+                return true;
+            case Context::SAVINGS_ENTRY:
+                if (m_key == "type") {
+                    savings.back().type = std::move(value);
+                    savings.back().hasType = true;
+                    return true;
+                } else if (m_key == "unit") {
+                    savings.back().unit = std::move(value);
+                    savings.back().hasUnit = true;
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+        return setOther();
+    }
+
+    bool binary(binary_t&) override {
+        return setOther();
+    }
+
+    bool start_object(std::size_t) override {
+        auto context = Context::OTHER;
+        if (m_contexts.empty()) {
+            context = Context::ROOT;
+        } else if (getContext() == Context::ROOT && m_key == "alternateRoute") {
+            context = Context::ALTERNATE_ROUTE;
+            hasAlternateRoute = true;
+        } else if (getContext() == Context::SAVINGS) {
+            if (savings.size() < MAX_ALTERNATE_ROUTE_SAVINGS_COUNT) {
+                context = Context::SAVINGS_ENTRY;
+                savings.emplace_back();
+            } else {
+                droppedSavingsCount++;
+            }
+        } else {
+            setOther();
+        }
+        m_contexts.push_back(context);
+        return true;
+    }
+
+    bool end_object() override {
+        m_contexts.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        auto context = Context::OTHER;
+        if (getContext() == Context::ALTERNATE_ROUTE && m_key == "labels") {
+            context = Context::LABELS;
+            hasLabels = true;
+        } else if (getContext() == Context::ALTERNATE_ROUTE && m_key == "savings") {
+            context = Context::SAVINGS;
+            hasSavings = true;
+        } else {
+            setOther();
+        }
+        m_contexts.push_back(context);
+        return true;
+    }
+
+    bool end_array() override {
+        m_contexts.pop_back();
+        return true;
+    }
+
+    bool key(string_t& value) override {
+        m_key = std::move(value);
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        AACE_ERROR(LX(TAG, "parseError").d("reason", ex.what()));
+        return false;
+    }
+
+    std::string inquiryType;
+    std::vector<std::string> labels;
+    std::vector<Savings> savings;
+    bool hasAlternateRoute = false;
+    bool hasLabels = false;
+    bool hasSavings = false;
+    size_t droppedLabelCount = 0;
+    size_t droppedSavingsCount = 0;
+
+    /// Whether a field of the event has a value of another type
+    bool invalid = false;
+
+private:
+    /// The containers of the payload with fields of the event
+    enum class Context { ROOT, ALTERNATE_ROUTE, LABELS, SAVINGS, SAVINGS_ENTRY, OTHER };
+
+    Context getContext() const {
+        return m_contexts.empty() ? Context::OTHER : m_contexts.back();
+    }
+
+    bool setNumber(double value) {
+        if (getContext() == Context::SAVINGS_ENTRY && m_key == "amount") {
+            savings.back().amount = value;
+            savings.back().hasAmount = true;
+            return true;
+        }
+        return setOther();
+    }
+
+    /// Records a value that is not of the type of its field, the values outside of the fields are skipped
+    bool setOther() {
+        switch (getContext()) {
+            case Context::ROOT:
+                invalid = invalid || m_key == "inquiryType" || m_key == "alternateRoute";
+                break;
+            case Context::ALTERNATE_ROUTE:
+                invalid = invalid || m_key == "labels" || m_key == "savings";
+                break;
+            case Context::LABELS:
+            case Context::SAVINGS:
+                invalid = true;
+                break;
+            case Context::SAVINGS_ENTRY:
+                invalid = invalid || m_key == "amount" || m_key == "type" || m_key == "unit";
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    /// Truncates a label to the longest label of the event, without splitting a UTF-8 character
+    static void truncateLabel(std::string& label) {
+        if (label.size() > MAX_ALTERNATE_ROUTE_LABEL_LENGTH) {
+            auto length = MAX_ALTERNATE_ROUTE_LABEL_LENGTH;
+            while (length > 0 && (static_cast<unsigned char>(label[length]) & 0xC0) == 0x80) {
+                length--;
+            }
+            label.resize(length);
+        }
+    }
+
+    std::vector<Context> m_contexts;
+    std::string m_key;
+};
+
+}  // namespace
+
 NavigationEngineImpl::NavigationEngineImpl(
     std::shared_ptr<aace::navigation::Navigation> navigationPlatformInterface,
-    const std::string& navigationProviderName) :
+    const std::string& navigationProviderName,
+    std::shared_ptr<RouteShapeProcessor> routeShapeProcessor) :
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
         m_navigationPlatformInterface(navigationPlatformInterface),
-        m_navigationProviderName{navigationProviderName} {
+        m_navigationProviderName{navigationProviderName},
+        m_routeShapeProcessor(routeShapeProcessor) {
 }
 
 bool NavigationEngineImpl::initialize(
@@ -108,7 +319,8 @@ std::shared_ptr<NavigationEngineImpl> NavigationEngineImpl::create(
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-    const std::string& navigationProviderName) {
+    const std::string& navigationProviderName,
+    std::shared_ptr<RouteShapeProcessor> routeShapeProcessor) {
     try {
         ThrowIfNull(navigationPlatformInterface, "nullNavigationPlatformInterface");
         ThrowIfNull(capabilitiesRegistrar, "nullCapabilitiesRegistrar");
@@ -116,7 +328,7 @@ std::shared_ptr<NavigationEngineImpl> NavigationEngineImpl::create(
         ThrowIfNull(contextManager, "nullNavigationContextManager");
 
         std::shared_ptr<NavigationEngineImpl> navigationEngineImpl = std::shared_ptr<NavigationEngineImpl>(
-            new NavigationEngineImpl(navigationPlatformInterface, navigationProviderName));
+            new NavigationEngineImpl(navigationPlatformInterface, navigationProviderName, routeShapeProcessor));
 
         ThrowIfNot(
             navigationEngineImpl->initialize(capabilitiesRegistrar, exceptionSender, messageSender, contextManager),
@@ -287,8 +499,38 @@ void NavigationEngineImpl::cancelNavigation() {
 
 std::string NavigationEngineImpl::getNavigationState() {
     AACE_DEBUG(LX(TAG));
+    {
+        // answer from the published state, without a round trip to the platform on the recognize path
+        std::lock_guard<std::mutex> lock(m_navigationStateMutex);
+        if (m_navigationStatePublished) {
+            return m_navigationState;
+        }
+    }
     emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "getNavigationState", {METRIC_NAVIGATION_GET_NAVIGATION_STATE});
-    return m_navigationPlatformInterface->getNavigationState();
+    auto navigationState = m_navigationPlatformInterface->getNavigationState();
+    if (m_routeShapeProcessor == nullptr) {
+        return navigationState;
+    }
+
+    // the platform returns the same state until the route changes, so only a changed state is simplified again
+    std::lock_guard<std::mutex> lock(m_navigationStateMutex);
+    if (navigationState != m_rawNavigationState) {
+        m_processedNavigationState = m_routeShapeProcessor->process(navigationState);
+        m_rawNavigationState = std::move(navigationState);
+    }
+    return m_processedNavigationState;
+}
+
+void NavigationEngineImpl::onNavigationStateChanged(const std::string& navigationState) {
+    AACE_DEBUG(LX(TAG).d("size", navigationState.size()));
+    emitCounterMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX, "onNavigationStateChanged", {METRIC_NAVIGATION_NAVIGATION_STATE_CHANGED});
+    // simplify the route shapes once here, rather than for each context request
+    auto processedNavigationState =
+        m_routeShapeProcessor != nullptr ? m_routeShapeProcessor->process(navigationState) : navigationState;
+    std::lock_guard<std::mutex> lock(m_navigationStateMutex);
+    m_navigationState = std::move(processedNavigationState);
+    m_navigationStatePublished = true;
 }
 
 void NavigationEngineImpl::onNavigationEvent(EventName event) {
@@ -402,75 +644,81 @@ void NavigationEngineImpl::onShowAlternativeRoutesSucceeded(const std::string& p
     std::vector<std::string> labels;
     std::vector<aace::engine::navigation::RouteSavings> savingsList;
     try {
-        nlohmann::json payloadJson = nlohmann::json::parse(payload);
+        parseAlternateRoute(payload, queryType, labels, savingsList);
+        m_displayManagerCapabilityAgent->showAlternativeRoutesSucceeded(queryType, {labels, savingsList});
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+    }
+}
 
-        std::string inquiryType = payloadJson.at("inquiryType");
-        if (inquiryType == ALT_ROUTE_INQUERY_TYPE_DEFAULT) {
-            queryType = aace::engine::navigation::AlternativeRoutesQueryType::DEFAULT;
-        } else if (inquiryType == ALT_ROUTE_INQUERY_TYPE_SHORTER_TIME) {
-            queryType = aace::engine::navigation::AlternativeRoutesQueryType::SHORTER_TIME;
-        } else if (inquiryType == ALT_ROUTE_INQUERY_TYPE_SHORTER_DISTANCE) {
-            queryType = aace::engine::navigation::AlternativeRoutesQueryType::SHORTER_DISTANCE;
-        } else {
-            AACE_ERROR(LX(TAG).d("Invalid inquiryType", inquiryType));
-            return;
-        }
+void NavigationEngineImpl::parseAlternateRoute(
+    const std::string& payload,
+    aace::engine::navigation::AlternativeRoutesQueryType& queryType,
+    std::vector<std::string>& labels,
+    std::vector<aace::engine::navigation::RouteSavings>& savings) {
+    AlternateRouteExtractor extractor;
+    ThrowIfNot(nlohmann::json::sax_parse(payload, &extractor), "invalidJSON");
+    ThrowIf(extractor.invalid, "invalidAlternateRoute");
+
+    if (extractor.inquiryType == ALT_ROUTE_INQUERY_TYPE_DEFAULT) {
+        queryType = aace::engine::navigation::AlternativeRoutesQueryType::DEFAULT;
+    } else if (extractor.inquiryType == ALT_ROUTE_INQUERY_TYPE_SHORTER_TIME) {
+        queryType = aace::engine::navigation::AlternativeRoutesQueryType::SHORTER_TIME;
+    } else if (extractor.inquiryType == ALT_ROUTE_INQUERY_TYPE_SHORTER_DISTANCE) {
+        queryType = aace::engine::navigation::AlternativeRoutesQueryType::SHORTER_DISTANCE;
+    } else {
+        Throw("invalidInquiryType:" + extractor.inquiryType);
+    }
 
-        nlohmann::json alternateRouteJson = payloadJson.at("alternateRoute");
-        labels = alternateRouteJson.at("labels").get<std::vector<std::string>>();
-        if (labels.empty()) {
-            AACE_ERROR(LX(TAG).m("alternateRoute.labels must be nonempty"));
-            return;
-        }
+    ThrowIfNot(extractor.hasAlternateRoute && extractor.hasLabels, "missingAlternateRouteLabels");
+    ThrowIf(extractor.labels.empty(), "alternateRoute.labels must be nonempty");
+    if (extractor.droppedLabelCount > 0) {
+        AACE_WARN(LX(TAG).m("alternateRoute.labels truncated").d("dropped", extractor.droppedLabelCount));
+    }
 
-        if (alternateRouteJson.contains("savings")) {
-            nlohmann::json savingsJson = alternateRouteJson.at("savings");
-            for (auto& saving : savingsJson.items()) {
-                double amount = saving.value().at("amount");
-
-                aace::engine::navigation::RouteSavingsType savingsType;
-                const std::string& savingsTypeStr = saving.value().at("type");
-                if (savingsTypeStr == ALT_ROUTE_SAVINGS_TYPE_DISTANCE) {
-                    savingsType = aace::engine::navigation::RouteSavingsType::DISTANCE;
-                } else if (savingsTypeStr == ALT_ROUTE_SAVINGS_TYPE_TIME) {
-                    savingsType = aace::engine::navigation::RouteSavingsType::TIME;
-                } else {
-                    AACE_ERROR(LX(TAG).d("Invalid savings.type", savingsTypeStr));
-                    return;
-                }
+    std::vector<aace::engine::navigation::RouteSavings> savingsList;
+    for (auto& saving : extractor.savings) {
+        ThrowIfNot(saving.hasAmount && saving.hasType && saving.hasUnit, "missingSavingsField");
+
+        aace::engine::navigation::RouteSavingsType savingsType;
+        if (saving.type == ALT_ROUTE_SAVINGS_TYPE_DISTANCE) {
+            savingsType = aace::engine::navigation::RouteSavingsType::DISTANCE;
+        } else if (saving.type == ALT_ROUTE_SAVINGS_TYPE_TIME) {
+            savingsType = aace::engine::navigation::RouteSavingsType::TIME;
+        } else {
+            Throw("invalidSavingsType:" + saving.type);
+        }
 
-                aace::engine::navigation::SavingsUnit savingsUnit;
-                const std::string& savingsUnitStr = saving.value().at("unit");
-                if (savingsUnitStr == ALT_ROUTE_SAVINGS_UNIT_MINUTE) {
-                    savingsUnit = aace::engine::navigation::SavingsUnit::MINUTE;
-                } else if (savingsUnitStr == ALT_ROUTE_SAVINGS_UNIT_HOUR) {
-                    savingsUnit = aace::engine::navigation::SavingsUnit::HOUR;
-                } else if (savingsUnitStr == ALT_ROUTE_SAVINGS_UNIT_FOOT) {
-                    savingsUnit = aace::engine::navigation::SavingsUnit::FOOT;
-                } else if (savingsUnitStr == ALT_ROUTE_SAVINGS_UNIT_YARD) {
-                    savingsUnit = aace::engine::navigation::SavingsUnit::YARD;
-                } else if (savingsUnitStr == ALT_ROUTE_SAVINGS_UNIT_MILE) {
-                    savingsUnit = aace::engine::navigation::SavingsUnit::MILE;
-                } else if (savingsUnitStr == ALT_ROUTE_SAVINGS_UNIT_METER) {
-                    savingsUnit = aace::engine::navigation::SavingsUnit::METER;
-                } else if (savingsUnitStr == ALT_ROUTE_SAVINGS_UNIT_KILOMETER) {
-                    savingsUnit = aace::engine::navigation::SavingsUnit::KILOMETER;
-                } else {
-                    AACE_ERROR(LX(TAG).d("Invalid savings.unit", savingsUnitStr));
-                    return;
-                }
-                savingsList.push_back({savingsType, amount, savingsUnit});
-            }
-            if (savingsList.empty()) {
-                // non-fatal error since the savings list is optional
-                AACE_WARN(LX(TAG).m("alternateRoute.savings must have at least one value if present"));
-            }
+        aace::engine::navigation::SavingsUnit savingsUnit;
+        if (saving.unit == ALT_ROUTE_SAVINGS_UNIT_MINUTE) {
+            savingsUnit = aace::engine::navigation::SavingsUnit::MINUTE;
+        } else if (saving.unit == ALT_ROUTE_SAVINGS_UNIT_HOUR) {
+            savingsUnit = aace::engine::navigation::SavingsUnit::HOUR;
+        } else if (saving.unit == ALT_ROUTE_SAVINGS_UNIT_FOOT) {
+            savingsUnit = aace::engine::navigation::SavingsUnit::FOOT;
+        } else if (saving.unit == ALT_ROUTE_SAVINGS_UNIT_YARD) {
+            savingsUnit = aace::engine::navigation::SavingsUnit::YARD;
+        } else if (saving.unit == ALT_ROUTE_SAVINGS_UNIT_MILE) {
+            savingsUnit = aace::engine::navigation::SavingsUnit::MILE;
+        } else if (saving.unit == ALT_ROUTE_SAVINGS_UNIT_METER) {
+            savingsUnit = aace::engine::navigation::SavingsUnit::METER;
+        } else if (saving.unit == ALT_ROUTE_SAVINGS_UNIT_KILOMETER) {
+            savingsUnit = aace::engine::navigation::SavingsUnit::KILOMETER;
+        } else {
+            Throw("invalidSavingsUnit:" + saving.unit);
         }
-        m_displayManagerCapabilityAgent->showAlternativeRoutesSucceeded(queryType, {labels, savingsList});
-    } catch (nlohmann::json::exception& ex) {
-        AACE_ERROR(LX(TAG).d("exception", ex.what()));
-        return;
+        savingsList.push_back({savingsType, saving.amount, savingsUnit});
     }
+    if (extractor.hasSavings && savingsList.empty()) {
+        // non-fatal error since the savings list is optional
+        AACE_WARN(LX(TAG).m("alternateRoute.savings must have at least one value if present"));
+    }
+    if (extractor.droppedSavingsCount > 0) {
+        AACE_WARN(LX(TAG).m("alternateRoute.savings truncated").d("dropped", extractor.droppedSavingsCount));
+    }
+
+    labels = std::move(extractor.labels);
+    savings = std::move(savingsList);
 }
 
 void NavigationEngineImpl::handleControlDisplaySuccess(aace::navigation::NavigationEngineInterface::EventName event) {
@@ -55,6 +55,19 @@ bool NavigationEngineService::configure(std::shared_ptr<std::istream> configurat
             m_navigationProviderName = root["providerName"].GetString();
             AACE_DEBUG(LX(TAG, "configure").d("providerName", m_navigationProviderName));
         }
+
+        if (root.HasMember("routeShape") && root["routeShape"].IsObject()) {
+            auto routeShape = root["routeShape"].GetObject();
+            if (routeShape.HasMember("maxPointCount") && routeShape["maxPointCount"].IsUint()) {
+                m_maxRouteShapePoints = routeShape["maxPointCount"].GetUint();
+            }
+            if (routeShape.HasMember("tolerance") && routeShape["tolerance"].IsNumber()) {
+                m_routeShapeTolerance = routeShape["tolerance"].GetDouble();
+            }
+            AACE_DEBUG(LX(TAG, "configure")
+                           .d("maxRouteShapePoints", m_maxRouteShapePoints)
+                           .d("routeShapeTolerance", m_routeShapeTolerance));
+        }
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG, "configure").d("reason", ex.what()));
@@ -102,13 +115,17 @@ bool NavigationEngineService::registerPlatformInterfaceType(std::shared_ptr<aace
         auto contextManager = alexaComponents->getContextManager();
         ThrowIfNull(contextManager, "contextManagerInvalid");
 
+        auto routeShapeProcessor = RouteShapeProcessor::create(m_maxRouteShapePoints, m_routeShapeTolerance);
+        ThrowIfNull(routeShapeProcessor, "createRouteShapeProcessorFailed");
+
         m_navigationEngineImpl = aace::engine::navigation::NavigationEngineImpl::create(
             navigation,
             defaultCapabilitiesRegistrar,
             exceptionSender,
             messageSender,
             contextManager,
-            m_navigationProviderName);
+            m_navigationProviderName,
+            routeShapeProcessor);
         ThrowIfNull(m_navigationEngineImpl, "createNavigationEngineImplFailed");
 
         return true;
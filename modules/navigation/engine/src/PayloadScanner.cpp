@@ -0,0 +1,106 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <rapidjson/reader.h>
+
+#include "AACE/Engine/Navigation/PayloadScanner.h"
+
+namespace aace {
+namespace engine {
+namespace navigation {
+
+namespace {
+
+/**
+ * Handles the events of the scan of a payload, and stops the scan at the value of the member it looks for.
+ */
+class MemberStringHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, MemberStringHandler> {
+public:
+    MemberStringHandler(const std::string& name, std::string& value) : m_name(name), m_value(value) {
+    }
+
+    bool found() const {
+        return m_found;
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool) {
+        m_matched = m_depth == 1 && m_name.compare(0, std::string::npos, str, length) == 0;
+        return true;
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool) {
+        if (m_matched) {
+            m_value.assign(str, length);
+            m_found = true;
+            return false;
+        }
+        return m_depth > 0;
+    }
+
+    bool StartObject() {
+        // the payload must be an object, and a member with an object value is not a string
+        if (m_matched || (m_depth == 0 && m_started)) {
+            return false;
+        }
+        m_started = true;
+        m_depth++;
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        m_depth--;
+        return true;
+    }
+
+    bool StartArray() {
+        if (m_matched || m_depth == 0) {
+            return false;
+        }
+        m_depth++;
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        m_depth--;
+        return true;
+    }
+
+    /// Handles the values other than strings, objects and arrays.
+    bool Default() {
+        return !m_matched && m_depth > 0;
+    }
+
+private:
+    const std::string& m_name;
+    std::string& m_value;
+    int m_depth = 0;
+    bool m_started = false;
+    bool m_matched = false;
+    bool m_found = false;
+};
+
+}  // namespace
+
+bool findPayloadString(const std::string& payload, const std::string& name, std::string& value) {
+    MemberStringHandler handler(name, value);
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(payload.c_str());
+    reader.Parse(stream, handler);
+    return handler.found();
+}
+
+}  // namespace navigation
+}  // namespace engine
+}  // namespace aace
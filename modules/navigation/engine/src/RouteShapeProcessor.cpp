@@ -0,0 +1,207 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+#include <nlohmann/json.hpp>
+
+#include "AACE/Engine/Navigation/RouteShapeProcessor.h"
+#include "AACE/Engine/Core/EngineMacros.h"
+
+namespace aace {
+namespace engine {
+namespace navigation {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.navigation.RouteShapeProcessor");
+
+/// Mean radius of the Earth, in meters
+static const double EARTH_RADIUS = 6371008.8;
+
+/// Degrees to radians
+static const double DEGREES_TO_RADIANS = 3.14159265358979323846 / 180.0;
+
+const size_t RouteShapeProcessor::DEFAULT_MAX_POINT_COUNT = 100;
+const double RouteShapeProcessor::DEFAULT_TOLERANCE = 0;
+
+namespace {
+
+/// A point of the route projected on a plane, in meters
+struct Point {
+    double x;
+    double y;
+};
+
+/// A segment of the simplified route, with the point of the route between its ends furthest from it
+struct Segment {
+    size_t first;
+    size_t last;
+    size_t furthest;
+    double distance;
+
+    bool operator<(const Segment& other) const {
+        return distance < other.distance;
+    }
+};
+
+/// Returns the distance from @c point to the segment from @c a to @c b.
+double distanceToSegment(const Point& point, const Point& a, const Point& b) {
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double lengthSquared = dx * dx + dy * dy;
+    double t = 0;
+    if (lengthSquared > 0) {
+        t = std::max(0.0, std::min(1.0, ((point.x - a.x) * dx + (point.y - a.y) * dy) / lengthSquared));
+    }
+    return std::hypot(point.x - (a.x + t * dx), point.y - (a.y + t * dy));
+}
+
+/// Returns the segment from @c first to @c last, with the point between them furthest from it.
+Segment makeSegment(const std::vector<Point>& points, size_t first, size_t last) {
+    Segment segment{first, last, first, -1};
+    for (size_t index = first + 1; index < last; index++) {
+        double distance = distanceToSegment(points[index], points[first], points[last]);
+        if (distance > segment.distance) {
+            segment.furthest = index;
+            segment.distance = distance;
+        }
+    }
+    return segment;
+}
+
+}  // namespace
+
+std::shared_ptr<RouteShapeProcessor> RouteShapeProcessor::create(size_t maxPointCount, double tolerance) {
+    try {
+        ThrowIf(maxPointCount < 2, "invalidMaxPointCount");
+        ThrowIf(std::isnan(tolerance) || tolerance < 0, "invalidTolerance");
+        return std::shared_ptr<RouteShapeProcessor>(new RouteShapeProcessor(maxPointCount, tolerance));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create")
+                       .d("maxPointCount", maxPointCount)
+                       .d("tolerance", tolerance)
+                       .d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+RouteShapeProcessor::RouteShapeProcessor(size_t maxPointCount, double tolerance) :
+        m_maxPointCount(maxPointCount), m_tolerance(tolerance) {
+}
+
+size_t RouteShapeProcessor::getMaxPointCount() const {
+    return m_maxPointCount;
+}
+
+double RouteShapeProcessor::getTolerance() const {
+    return m_tolerance;
+}
+
+std::vector<size_t> RouteShapeProcessor::simplify(const std::vector<Coordinate>& route) const {
+    if (route.size() <= 2) {
+        std::vector<size_t> indices;
+        for (size_t index = 0; index < route.size(); index++) {
+            indices.push_back(index);
+        }
+        return indices;
+    }
+
+    // an equirectangular projection around the start of the route is accurate enough for the route of a trip
+    double metersPerDegree = EARTH_RADIUS * DEGREES_TO_RADIANS;
+    double metersPerLongitudeDegree = metersPerDegree * std::cos(route.front().first * DEGREES_TO_RADIANS);
+    std::vector<Point> points;
+    points.reserve(route.size());
+    for (const auto& coordinate : route) {
+        points.push_back({coordinate.second * metersPerLongitudeDegree, coordinate.first * metersPerDegree});
+    }
+
+    // split the segment furthest from the route first, until the route is within the tolerance or the point budget
+    // is spent
+    std::vector<bool> kept(route.size(), false);
+    kept.front() = kept.back() = true;
+    size_t keptCount = 2;
+    std::priority_queue<Segment> segments;
+    segments.push(makeSegment(points, 0, route.size() - 1));
+    while (!segments.empty() && keptCount < m_maxPointCount) {
+        Segment segment = segments.top();
+        segments.pop();
+        if (segment.distance <= m_tolerance) {
+            break;
+        }
+        kept[segment.furthest] = true;
+        keptCount++;
+        if (segment.furthest - segment.first > 1) {
+            segments.push(makeSegment(points, segment.first, segment.furthest));
+        }
+        if (segment.last - segment.furthest > 1) {
+            segments.push(makeSegment(points, segment.furthest, segment.last));
+        }
+    }
+
+    std::vector<size_t> indices;
+    indices.reserve(keptCount);
+    for (size_t index = 0; index < kept.size(); index++) {
+        if (kept[index]) {
+            indices.push_back(index);
+        }
+    }
+    return indices;
+}
+
+std::string RouteShapeProcessor::process(const std::string& navigationState) const {
+    try {
+        auto state = nlohmann::json::parse(navigationState);
+        if (!state.is_object() || state.find("shapes") == state.end()) {
+            return navigationState;
+        }
+        auto& shapes = state["shapes"];
+        ThrowIfNot(shapes.is_array(), "invalidShapes");
+        if (shapes.size() <= 2) {
+            return navigationState;
+        }
+
+        std::vector<Coordinate> route;
+        route.reserve(shapes.size());
+        for (const auto& shape : shapes) {
+            ThrowIfNot(
+                shape.is_array() && shape.size() == 2 && shape[0].is_number() && shape[1].is_number(),
+                "invalidCoordinate");
+            route.emplace_back(shape[0].get<double>(), shape[1].get<double>());
+        }
+
+        auto indices = simplify(route);
+        if (indices.size() == route.size()) {
+            return navigationState;
+        }
+        auto simplified = nlohmann::json::array();
+        for (auto index : indices) {
+            simplified.push_back(std::move(shapes[index]));
+        }
+        shapes = std::move(simplified);
+
+        AACE_DEBUG(LX(TAG).d("pointCount", route.size()).d("simplifiedPointCount", indices.size()));
+        return state.dump();
+    } catch (std::exception& ex) {
+        // the state is sent as the platform provided it, so an unexpected payload is never lost
+        AACE_WARN(LX(TAG, "process").d("reason", ex.what()));
+        return navigationState;
+    }
+}
+
+}  // namespace navigation
+}  // namespace engine
+}  // namespace aace
@@ -448,6 +448,16 @@ public:
      */
     void showAlternativeRoutesSucceeded(const std::string& payload);
 
+    /**
+     * Notifies the Engine of a change of the navigation state. Once the platform implementation publishes the
+     * navigation state, the Engine answers the navigation context requests with the latest published state, and no
+     * longer calls @c getNavigationState(). The platform implementation should publish the navigation state on
+     * each change of the navigation state, waypoints or route shapes.
+     *
+     * @param [in] navigationState The current navigation state JSON payload, in the format of @c getNavigationState()
+     */
+    void navigationStateChanged(const std::string& navigationState);
+
     void setEngineInterface(std::shared_ptr<NavigationEngineInterface> navigationEngineInterface);
 
 private:
@@ -48,6 +48,35 @@ public:
      */
     static std::shared_ptr<aace::core::config::EngineConfiguration> createNavigationConfig(
         const std::string& providerName);
+
+    /**
+     * Factory method used to programmatically generate navigation configuration data with the fidelity of the
+     * route shapes of the navigation context. The data generated by this method is equivalent to providing the
+     * following JSON values in a configuration file:
+     *
+     * @code{.json}
+     * {
+     *   "aace.navigation": {
+     *      "providerName": "<SERVICE_NAME>",
+     *      "routeShape": {
+     *          "maxPointCount": <MAX_POINT_COUNT>,
+     *          "tolerance": <TOLERANCE_IN_METERS>
+     *      }
+     *   }
+     * }
+     * @endcode
+     *
+     * @param [in] providerName The navigation service provider name.
+     * @param [in] maxRouteShapePoints The most coordinates of the route shapes sent in the navigation context.
+     * The Engine keeps the coordinates that best describe the route. Defaults to 100, the most the navigation
+     * context accepts.
+     * @param [in] routeShapeTolerance The distance in meters under which a coordinate of the route shapes is dropped
+     * from the route. Defaults to 0, which only drops the coordinates on a straight line.
+     */
+    static std::shared_ptr<aace::core::config::EngineConfiguration> createNavigationConfig(
+        const std::string& providerName,
+        unsigned int maxRouteShapePoints,
+        double routeShapeTolerance = 0);
 };
 
 }  // namespace config
@@ -364,6 +364,7 @@ public:
     virtual void onNavigationEvent(EventName event) = 0;
     virtual void onNavigationError(ErrorType type, ErrorCode code, const std::string& description) = 0;
     virtual void onShowAlternativeRoutesSucceeded(const std::string& payload) = 0;
+    virtual void onNavigationStateChanged(const std::string& navigationState) = 0;
 };
 
 }  // namespace navigation
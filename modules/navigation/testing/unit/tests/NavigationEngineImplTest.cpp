@@ -147,6 +147,72 @@ TEST_F(NavigationEngineImplTest, createWithNullContextManager) {
     EXPECT_EQ(nullptr, testNavigationEngineImpl);
 }
 
+TEST_F(NavigationEngineImplTest, getNavigationStateFromPlatformUntilPublished) {
+    auto mockPlatformInterface = std::static_pointer_cast<MockNavigationPlatformInterface>(m_mockPlatformInterface);
+    EXPECT_CALL(*mockPlatformInterface, getNavigationState())
+        .Times(1)
+        .WillOnce(testing::Return("{\"state\":\"NOT_NAVIGATING\"}"));
+    EXPECT_EQ("{\"state\":\"NOT_NAVIGATING\"}", m_navigationEngineImpl->getNavigationState());
+
+    // once published, the state is answered without calling the platform
+    m_mockPlatformInterface->navigationStateChanged("{\"state\":\"NAVIGATING\"}");
+    EXPECT_EQ("{\"state\":\"NAVIGATING\"}", m_navigationEngineImpl->getNavigationState());
+    m_mockPlatformInterface->navigationStateChanged("{\"state\":\"NOT_NAVIGATING\"}");
+    EXPECT_EQ("{\"state\":\"NOT_NAVIGATING\"}", m_navigationEngineImpl->getNavigationState());
+}
+
+TEST_F(NavigationEngineImplTest, parseAlternateRouteSkipsOtherFields) {
+    engine::navigation::AlternativeRoutesQueryType queryType;
+    std::vector<std::string> labels;
+    std::vector<engine::navigation::RouteSavings> savings;
+    engine::navigation::NavigationEngineImpl::parseAlternateRoute(
+        R"({"inquiryType":"SHORTER_TIME","alternateRoute":{"labels":["US-101 N","CA-237 E"],)"
+        R"("shapes":[[37.4,-122.0],[37.5,-122.1]],"savings":[{"type":"TIME","amount":12,"unit":"MINUTE"}]}})",
+        queryType,
+        labels,
+        savings);
+    EXPECT_EQ(engine::navigation::AlternativeRoutesQueryType::SHORTER_TIME, queryType);
+    EXPECT_EQ(std::vector<std::string>({"US-101 N", "CA-237 E"}), labels);
+    ASSERT_EQ(1u, savings.size());
+    EXPECT_EQ(12, savings[0].amount);
+}
+
+TEST_F(NavigationEngineImplTest, parseAlternateRouteCapsLabelsAndSavings) {
+    std::string payload = R"({"inquiryType":"DEFAULT","alternateRoute":{"labels":[")" + std::string(200, 'x') + "\"";
+    for (int index = 0; index < 20; index++) {
+        payload += ",\"label\"";
+    }
+    payload += R"(],"savings":[{"type":"TIME","amount":1,"unit":"HOUR"},{"type":"DISTANCE","amount":2,"unit":"MILE"},)"
+               R"({"type":"TIME","amount":3,"unit":"MINUTE"}]}})";
+
+    engine::navigation::AlternativeRoutesQueryType queryType;
+    std::vector<std::string> labels;
+    std::vector<engine::navigation::RouteSavings> savings;
+    engine::navigation::NavigationEngineImpl::parseAlternateRoute(payload, queryType, labels, savings);
+    EXPECT_EQ(10u, labels.size());
+    EXPECT_EQ(128u, labels[0].size());
+    EXPECT_EQ(2u, savings.size());
+}
+
+TEST_F(NavigationEngineImplTest, parseInvalidAlternateRoute) {
+    std::vector<std::string> payloads = {
+        R"({"inquiryType":"DEFAULT","alternateRoute":{"labels":[]}})",
+        R"({"inquiryType":"DEFAULT","alternateRoute":{}})",
+        R"({"inquiryType":"UNKNOWN","alternateRoute":{"labels":["a"]}})",
+        R"({"inquiryType":"DEFAULT","alternateRoute":{"labels":["a",1]}})",
+        R"({"inquiryType":"DEFAULT","alternateRoute":{"labels":["a"],"savings":[{"type":"TIME","unit":"HOUR"}]}})",
+        R"({"inquiryType":"DEFAULT","alternateRoute":{"labels":["a"]})",
+    };
+    for (auto& payload : payloads) {
+        engine::navigation::AlternativeRoutesQueryType queryType;
+        std::vector<std::string> labels;
+        std::vector<engine::navigation::RouteSavings> savings;
+        EXPECT_ANY_THROW(
+            engine::navigation::NavigationEngineImpl::parseAlternateRoute(payload, queryType, labels, savings))
+            << payload;
+    }
+}
+
 }  // namespace navigation
 }  // namespace unit
 }  // namespace test
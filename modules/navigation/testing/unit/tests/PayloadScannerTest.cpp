@@ -0,0 +1,67 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AACE/Engine/Navigation/PayloadScanner.h>
+
+namespace aace {
+namespace test {
+namespace unit {
+namespace navigation {
+
+using aace::engine::navigation::findPayloadString;
+
+TEST(PayloadScannerTest, findsTopLevelString) {
+    std::string value;
+    ASSERT_TRUE(findPayloadString(
+        R"({"targetLocation":{"type":"nested","address":["type"]},"type":"TURN","instruction":{"x":1}})",
+        "type",
+        value));
+    EXPECT_EQ("TURN", value);
+}
+
+TEST(PayloadScannerTest, stopsAtTheMember) {
+    // the scan ends at the value of the member, so the rest of the payload is not read
+    std::string value;
+    ASSERT_TRUE(findPayloadString(R"({"mode":"SHOW_ROUTE_OVERVIEW", not JSON)", "mode", value));
+    EXPECT_EQ("SHOW_ROUTE_OVERVIEW", value);
+}
+
+TEST(PayloadScannerTest, rejectsMissingOrInvalidMember) {
+    std::vector<std::string> payloads = {
+        R"({"inquiryType":"SHORTER_TIME"})",
+        R"({"mode":1})",
+        R"({"mode":{"value":"ZOOM_IN"}})",
+        R"({"mode":["ZOOM_IN"]})",
+        R"({"other":{"mode":"ZOOM_IN"}})",
+        R"(["mode","ZOOM_IN"])",
+        R"("mode")",
+        R"({"other":1,,"mode":"ZOOM_IN"})",
+        "",
+    };
+    for (auto& payload : payloads) {
+        std::string value;
+        EXPECT_FALSE(findPayloadString(payload, "mode", value)) << payload;
+    }
+}
+
+}  // namespace navigation
+}  // namespace unit
+}  // namespace test
+}  // namespace aace
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <AACE/Engine/Navigation/RouteShapeProcessor.h>
+
+namespace aace {
+namespace test {
+namespace unit {
+namespace navigation {
+
+using aace::engine::navigation::RouteShapeProcessor;
+
+/// Returns a route along a sine wave, with about 111 meters between its points.
+static std::vector<RouteShapeProcessor::Coordinate> createRoute(size_t pointCount) {
+    std::vector<RouteShapeProcessor::Coordinate> route;
+    for (size_t index = 0; index < pointCount; index++) {
+        route.emplace_back(37.0 + 0.01 * std::sin(index / 10.0), -122.0 + 0.001 * index);
+    }
+    return route;
+}
+
+/// Returns a navigation state with the route as its shapes.
+static std::string createNavigationState(const std::vector<RouteShapeProcessor::Coordinate>& route) {
+    nlohmann::json shapes = nlohmann::json::array();
+    for (const auto& coordinate : route) {
+        shapes.push_back({coordinate.first, coordinate.second});
+    }
+    return nlohmann::json({{"state", "NAVIGATING"}, {"waypoints", nlohmann::json::array()}, {"shapes", shapes}})
+        .dump();
+}
+
+TEST(RouteShapeProcessorTest, createWithInvalidParametersShouldFail) {
+    EXPECT_EQ(RouteShapeProcessor::create(1, 0), nullptr);
+    EXPECT_EQ(RouteShapeProcessor::create(100, -1), nullptr);
+    EXPECT_EQ(RouteShapeProcessor::create(100, std::nan("")), nullptr);
+    EXPECT_NE(RouteShapeProcessor::create(), nullptr);
+}
+
+TEST(RouteShapeProcessorTest, simplifyShouldDropPointsOnStraightLines) {
+    auto processor = RouteShapeProcessor::create();
+    ASSERT_NE(processor, nullptr);
+    // a straight line, then a right angle
+    std::vector<RouteShapeProcessor::Coordinate> route = {{37.0, -122.0}, {37.0, -121.99}, {37.0, -121.98},
+                                                          {37.01, -121.98}, {37.02, -121.98}};
+    EXPECT_EQ(processor->simplify(route), std::vector<size_t>({0, 2, 4}));
+}
+
+TEST(RouteShapeProcessorTest, simplifyShouldKeepPointBudget) {
+    auto processor = RouteShapeProcessor::create(20, 0);
+    ASSERT_NE(processor, nullptr);
+    auto indices = processor->simplify(createRoute(500));
+    ASSERT_EQ(indices.size(), 20u);
+    EXPECT_EQ(indices.front(), 0u);
+    EXPECT_EQ(indices.back(), 499u);
+    for (size_t index = 1; index < indices.size(); index++) {
+        EXPECT_LT(indices[index - 1], indices[index]);
+    }
+}
+
+TEST(RouteShapeProcessorTest, simplifyShouldDropPointsWithinTolerance) {
+    auto route = createRoute(500);
+    auto coarse = RouteShapeProcessor::create(500, 100)->simplify(route);
+    auto fine = RouteShapeProcessor::create(500, 1)->simplify(route);
+    EXPECT_LT(coarse.size(), fine.size());
+    EXPECT_LT(fine.size(), route.size());
+}
+
+TEST(RouteShapeProcessorTest, processShouldSimplifyShapes) {
+    auto processor = RouteShapeProcessor::create(10, 0);
+    ASSERT_NE(processor, nullptr);
+    auto route = createRoute(200);
+    auto state = nlohmann::json::parse(processor->process(createNavigationState(route)));
+
+    EXPECT_EQ(state["state"], "NAVIGATING");
+    EXPECT_TRUE(state["waypoints"].is_array());
+    ASSERT_EQ(state["shapes"].size(), 10u);
+    EXPECT_EQ(state["shapes"].front()[0].get<double>(), route.front().first);
+    EXPECT_EQ(state["shapes"].back()[1].get<double>(), route.back().second);
+}
+
+TEST(RouteShapeProcessorTest, processShouldKeepStatesWithoutShapesToSimplify) {
+    auto processor = RouteShapeProcessor::create(10, 0);
+    ASSERT_NE(processor, nullptr);
+
+    std::string notNavigating = R"({"state":"NOT_NAVIGATING","waypoints":[],"shapes":[]})";
+    EXPECT_EQ(processor->process(notNavigating), notNavigating);
+
+    std::string invalidCoordinate = R"({"state":"NAVIGATING","shapes":[[37.0,-122.0],[37.1],[37.2,-122.2]]})";
+    EXPECT_EQ(processor->process(invalidCoordinate), invalidCoordinate);
+
+    EXPECT_EQ(processor->process("not json"), "not json");
+
+    auto simple = createNavigationState({{37.0, -122.0}, {37.1, -122.0}, {37.1, -122.1}});
+    EXPECT_EQ(processor->process(simple), simple);
+}
+
+}  // namespace navigation
+}  // namespace unit
+}  // namespace test
+}  // namespace aace
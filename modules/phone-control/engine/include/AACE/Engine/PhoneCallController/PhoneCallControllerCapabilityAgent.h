@@ -28,6 +28,8 @@
 #include <AVSCommon/Utils/Threading/Executor.h>
 #include <AVSCommon/Utils/UUIDGeneration/UUIDGeneration.h>
 
+#include <mutex>
+
 #include <AACE/PhoneCallController/PhoneCallControllerEngineInterfaces.h>
 #include "PhoneCallControllerInterface.h"
 
@@ -154,6 +156,7 @@ private:
     void addCall(std::string callId, CallState state);
     void setCallState(std::string callId, CallState state);
     void removeCall(std::string callId);
+    void setCurrentCall(const std::string& callId);
 
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> m_contextManager;
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::MessageSenderInterface> m_messageSender;
@@ -171,6 +174,14 @@ private:
         bool>
         m_deviceConfigurationMap;
     aace::phoneCallController::PhoneCallControllerEngineInterface::ConnectionState m_connectionState;
+
+    /// The serialized sections of the context, each rebuilt only after its state changes, or empty if stale.
+    /// The context state and its sections are protected by @c m_contextMutex.
+    std::mutex m_contextMutex;
+    std::string m_deviceContext;
+    std::string m_configurationContext;
+    std::string m_callsContext;
+
     alexaClientSDK::avsCommon::utils::threading::Executor m_executor;
 };
 
@@ -119,6 +119,10 @@ private:
     /// Flag indicating the auth refresh status
     bool m_isAuthRefreshed;
 
+    /// Flag requesting the account check, set on the auth refresh and when the phone connects, until the account
+    /// is found provisioned
+    bool m_isAccountCheckRequested;
+
     /// This represents phone connection state.
     aace::phoneCallController::PhoneCallControllerEngineInterface::ConnectionState m_connectionState;
 
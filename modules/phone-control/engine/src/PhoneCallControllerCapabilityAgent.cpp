@@ -15,6 +15,7 @@
 
 #include "AACE/Engine/PhoneCallController/PhoneCallControllerCapabilityAgent.h"
 #include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/Utils/JSON/ArenaDocument.h"
 
 #include "rapidjson/document.h"
 #include "rapidjson/prettywriter.h"
@@ -51,6 +52,19 @@ static const std::string CHANNEL_NAME =
 static std::shared_ptr<alexaClientSDK::avsCommon::avs::CapabilityConfiguration>
 getPhoneCallControllerCapabilityConfiguration();
 
+/**
+ * Serializes a JSON value.
+ *
+ * @param value The value.
+ * @return The serialized value.
+ */
+static std::string toJsonString(const rapidjson::Value& value) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    ThrowIfNot(value.Accept(writer), "failedToWriteJsonDocument");
+    return buffer.GetString();
+}
+
 std::shared_ptr<PhoneCallControllerCapabilityAgent> PhoneCallControllerCapabilityAgent::create(
     std::shared_ptr<PhoneCallControllerInterface> phoneCallController,
     std::shared_ptr<alexaClientSDK::avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
@@ -85,6 +99,7 @@ void PhoneCallControllerCapabilityAgent::preHandleDirective(std::shared_ptr<Dire
 }
 
 void PhoneCallControllerCapabilityAgent::handleDirective(std::shared_ptr<DirectiveInfo> info) {
+    AACE_TRACE_SCOPE("directive", "PhoneCallController.handleDirective");
     try {
         ThrowIfNot(info && info->directive, "nullDirectiveInfo");
 
@@ -209,7 +224,8 @@ void PhoneCallControllerCapabilityAgent::setHandlingCompleted(std::shared_ptr<Di
 
 void PhoneCallControllerCapabilityAgent::handleDialDirective(std::shared_ptr<DirectiveInfo> info) {
     m_executor.submit([this, info]() {
-        rapidjson::Document document;
+        aace::engine::utils::json::ArenaDocument arenaDocument;
+        auto& document = arenaDocument.get();
         rapidjson::ParseResult result = document.Parse(info->directive->getPayload().c_str());
         if (!result) {
             AACE_ERROR(LX(TAG, "handleDialDirective")
@@ -235,7 +251,7 @@ void PhoneCallControllerCapabilityAgent::handleDialDirective(std::shared_ptr<Dir
 
         if (m_phoneCallController->dial(info->directive->getPayload())) {
             m_callMethodMap[callId] = CallMethod::DIAL;
-            m_currentCallId = callId;
+            setCurrentCall(callId);
         } else {
             removeCall(callId);
         }
@@ -247,7 +263,8 @@ void PhoneCallControllerCapabilityAgent::handleDialDirective(std::shared_ptr<Dir
 
 void PhoneCallControllerCapabilityAgent::handleRedialDirective(std::shared_ptr<DirectiveInfo> info) {
     m_executor.submit([this, info]() {
-        rapidjson::Document document;
+        aace::engine::utils::json::ArenaDocument arenaDocument;
+        auto& document = arenaDocument.get();
         rapidjson::ParseResult result = document.Parse(info->directive->getPayload().c_str());
         if (!result) {
             AACE_ERROR(LX(TAG, "handleRedialDirective")
@@ -273,7 +290,7 @@ void PhoneCallControllerCapabilityAgent::handleRedialDirective(std::shared_ptr<D
 
         if (m_phoneCallController->redial(info->directive->getPayload())) {
             m_callMethodMap[callId] = CallMethod::REDIAL;
-            m_currentCallId = callId;
+            setCurrentCall(callId);
         } else {
             removeCall(callId);
         }
@@ -285,7 +302,8 @@ void PhoneCallControllerCapabilityAgent::handleRedialDirective(std::shared_ptr<D
 
 void PhoneCallControllerCapabilityAgent::handleAnswerDirective(std::shared_ptr<DirectiveInfo> info) {
     m_executor.submit([this, info]() {
-        rapidjson::Document document;
+        aace::engine::utils::json::ArenaDocument arenaDocument;
+        auto& document = arenaDocument.get();
         rapidjson::ParseResult result = document.Parse(info->directive->getPayload().c_str());
         if (!result) {
             AACE_ERROR(LX(TAG, "handleAnswerDirective")
@@ -305,7 +323,8 @@ void PhoneCallControllerCapabilityAgent::handleAnswerDirective(std::shared_ptr<D
 
 void PhoneCallControllerCapabilityAgent::handleStopDirective(std::shared_ptr<DirectiveInfo> info) {
     m_executor.submit([this, info]() {
-        rapidjson::Document document;
+        aace::engine::utils::json::ArenaDocument arenaDocument;
+        auto& document = arenaDocument.get();
         rapidjson::ParseResult result = document.Parse(info->directive->getPayload().c_str());
         if (!result) {
             AACE_ERROR(LX(TAG, "handleStopDirective")
@@ -325,7 +344,8 @@ void PhoneCallControllerCapabilityAgent::handleStopDirective(std::shared_ptr<Dir
 
 void PhoneCallControllerCapabilityAgent::handlePlayRingtoneDirective(std::shared_ptr<DirectiveInfo> info) {
     m_executor.submit([this, info]() {
-        rapidjson::Document document;
+        aace::engine::utils::json::ArenaDocument arenaDocument;
+        auto& document = arenaDocument.get();
         rapidjson::ParseResult result = document.Parse(info->directive->getPayload().c_str());
         if (!result) {
             AACE_ERROR(LX(TAG, "handlePlayRingtoneDirective")
@@ -345,7 +365,8 @@ void PhoneCallControllerCapabilityAgent::handlePlayRingtoneDirective(std::shared
 
 void PhoneCallControllerCapabilityAgent::handleSendDTMFDirective(std::shared_ptr<DirectiveInfo> info) {
     m_executor.submit([this, info]() {
-        rapidjson::Document document;
+        aace::engine::utils::json::ArenaDocument arenaDocument;
+        auto& document = arenaDocument.get();
         rapidjson::ParseResult result = document.Parse(info->directive->getPayload().c_str());
         if (!result) {
             AACE_ERROR(LX(TAG, "handleSendDTMFDirective")
@@ -391,7 +412,11 @@ PhoneCallControllerCapabilityAgent::getCapabilityConfigurations() {
 
 void PhoneCallControllerCapabilityAgent::connectionStateChanged(
     aace::phoneCallController::PhoneCallControllerEngineInterface::ConnectionState state) {
-    m_connectionState = state;
+    {
+        std::lock_guard<std::mutex> lock(m_contextMutex);
+        m_connectionState = state;
+        m_deviceContext.clear();
+    }
     std::string context = getContextString();
     updateContextManager(context);
 }
@@ -453,7 +478,11 @@ void PhoneCallControllerCapabilityAgent::deviceConfigurationUpdated(
     std::unordered_map<
         aace::phoneCallController::PhoneCallControllerEngineInterface::CallingDeviceConfigurationProperty,
         bool> configurationMap) {
-    m_deviceConfigurationMap = configurationMap;
+    {
+        std::lock_guard<std::mutex> lock(m_contextMutex);
+        m_deviceConfigurationMap = configurationMap;
+        m_configurationContext.clear();
+    }
     std::string context = getContextString();
     updateContextManager(context);
 }
@@ -472,57 +501,64 @@ void PhoneCallControllerCapabilityAgent::updateContextManager(const std::string&
 
 std::string PhoneCallControllerCapabilityAgent::getContextString() {
     try {
-        rapidjson::Document document(rapidjson::kObjectType);
+        std::lock_guard<std::mutex> lock(m_contextMutex);
+
+        // the events carry the context, so only the sections whose state changed since the last event are serialized
+        if (m_deviceContext.empty()) {
+            rapidjson::Document device(rapidjson::kObjectType);
+            device.AddMember(
+                "connectionState",
+                rapidjson::Value(connectionStateToString(m_connectionState).c_str(), device.GetAllocator()),
+                device.GetAllocator());
+            m_deviceContext = toJsonString(device);
+        }
 
-        rapidjson::StringBuffer buffer;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-        rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
-
-        rapidjson::Value device(rapidjson::kObjectType);
-        device.AddMember(
-            "connectionState",
-            rapidjson::Value(connectionStateToString(m_connectionState).c_str(), allocator),
-            allocator);
-        document.AddMember("device", device, allocator);
-
-        rapidjson::Value configuration(rapidjson::kObjectType);
-        rapidjson::Value callingFeature(rapidjson::kArrayType);
-        for (auto it : m_deviceConfigurationMap) {
+        if (m_configurationContext.empty()) {
+            rapidjson::Document configuration(rapidjson::kObjectType);
+            rapidjson::Document::AllocatorType& allocator = configuration.GetAllocator();
+            rapidjson::Value callingFeature(rapidjson::kArrayType);
+            for (auto it : m_deviceConfigurationMap) {
+                rapidjson::Value tempConfig(rapidjson::kObjectType);
+                tempConfig.AddMember(
+                    rapidjson::Value(configurationFeatureToString(it.first).c_str(), allocator),
+                    rapidjson::Value().SetBool(it.second),
+                    allocator);
+                callingFeature.PushBack(tempConfig, allocator);
+            }
             rapidjson::Value tempConfig(rapidjson::kObjectType);
-            tempConfig.AddMember(
-                rapidjson::Value(configurationFeatureToString(it.first).c_str(), allocator),
-                rapidjson::Value().SetBool(it.second),
-                allocator);
+            tempConfig.AddMember("OVERRIDE_RINGTONE_SUPPORTED", rapidjson::Value().SetBool(false), allocator);
             callingFeature.PushBack(tempConfig, allocator);
+            configuration.AddMember("callingFeature", callingFeature, allocator);
+            m_configurationContext = toJsonString(configuration);
         }
-        rapidjson::Value tempConfig(rapidjson::kObjectType);
-        tempConfig.AddMember("OVERRIDE_RINGTONE_SUPPORTED", rapidjson::Value().SetBool(false), allocator);
-        callingFeature.PushBack(tempConfig, allocator);
 
-        configuration.AddMember("callingFeature", callingFeature, allocator);
-        document.AddMember("configuration", configuration, allocator);
-
-        rapidjson::Value allCalls(rapidjson::kArrayType);
-        for (auto it : m_allCallsMap) {
-            if (it.second == CallState::IDLE) {
-                continue;
+        if (m_callsContext.empty()) {
+            rapidjson::Document allCalls(rapidjson::kArrayType);
+            rapidjson::Document::AllocatorType& allocator = allCalls.GetAllocator();
+            for (auto it : m_allCallsMap) {
+                if (it.second == CallState::IDLE) {
+                    continue;
+                }
+                rapidjson::Value tempCall(rapidjson::kObjectType);
+                tempCall.AddMember("callId", rapidjson::Value(it.first.c_str(), allocator), allocator);
+                tempCall.AddMember(
+                    "callState", rapidjson::Value(callStateToString(it.second).c_str(), allocator), allocator);
+                allCalls.PushBack(tempCall, allocator);
+            }
+            m_callsContext = "\"allCalls\":" + toJsonString(allCalls);
+
+            if (callExist(m_currentCallId) && getCallState(m_currentCallId) != CallState::IDLE) {
+                rapidjson::Document currentCall(rapidjson::kObjectType);
+                currentCall.AddMember(
+                    "callId",
+                    rapidjson::Value(m_currentCallId.c_str(), currentCall.GetAllocator()),
+                    currentCall.GetAllocator());
+                m_callsContext += ",\"currentCall\":" + toJsonString(currentCall);
             }
-            rapidjson::Value tempCall(rapidjson::kObjectType);
-            tempCall.AddMember("callId", rapidjson::Value(it.first.c_str(), allocator), allocator);
-            tempCall.AddMember(
-                "callState", rapidjson::Value(callStateToString(it.second).c_str(), allocator), allocator);
-            allCalls.PushBack(tempCall, allocator);
-        }
-        document.AddMember("allCalls", allCalls, allocator);
-
-        if (callExist(m_currentCallId) && getCallState(m_currentCallId) != CallState::IDLE) {
-            rapidjson::Value currentCall(rapidjson::kObjectType);
-            currentCall.AddMember("callId", rapidjson::Value(m_currentCallId.c_str(), allocator), allocator);
-            document.AddMember("currentCall", currentCall, allocator);
         }
 
-        ThrowIfNot(document.Accept(writer), "failedToWriteJsonDocument");
-        return buffer.GetString();
+        return "{\"device\":" + m_deviceContext + ",\"configuration\":" + m_configurationContext + "," +
+               m_callsContext + "}";
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return "";
@@ -534,30 +570,16 @@ const std::pair<std::string, std::string> PhoneCallControllerCapabilityAgent::bu
     const std::string& payload) {
     const std::pair<std::string, std::string> emptyPair;
     std::string context = getContextString();
-    rapidjson::Document contextPayload;
-    if (contextPayload.Parse(context.c_str()).HasParseError()) {
-        AACE_ERROR(LX(TAG).d("reason", "failedToParseContextPayload"));
-        return emptyPair;
-    }
-    rapidjson::Document document(rapidjson::kArrayType);
-    rapidjson::StringBuffer buffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-    rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
-
-    rapidjson::Value contextObject(rapidjson::kObjectType);
-    contextObject.AddMember("payload", contextPayload, allocator);
-    rapidjson::Value header(rapidjson::kObjectType);
-    header.AddMember("namespace", rapidjson::Value(NAMESPACE.c_str(), allocator), allocator);
-    header.AddMember("name", rapidjson::Value("PhoneCallControllerState", allocator), allocator);
-    contextObject.AddMember("header", header, allocator);
-    document.PushBack(contextObject, allocator);
-
-    if (!document.Accept(writer)) {
-        AACE_ERROR(LX(TAG).d("reason", "failedToCreateContextWithHeader"));
+    if (context.empty()) {
+        AACE_ERROR(LX(TAG).d("reason", "failedToCreateContextPayload"));
         return emptyPair;
     }
+
+    // the context is already serialized, so it is wrapped in its header without being parsed again
+    auto contextWithHeader = "[{\"payload\":" + context + ",\"header\":{\"namespace\":\"" + NAMESPACE +
+                             "\",\"name\":\"" + CONTEXT_MANAGER_PHONE_CONTROL_STATE.name + "\"}}]";
     updateContextManager(context);
-    return buildJsonEventString(eventName, "", payload, buffer.GetString());
+    return buildJsonEventString(eventName, "", payload, contextWithHeader);
 }
 
 void PhoneCallControllerCapabilityAgent::executeOnFocusChanged(
@@ -587,7 +609,7 @@ void PhoneCallControllerCapabilityAgent::executeCallStateChanged(
     rapidjson::StringBuffer buffer;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
 
-    m_currentCallId = callId;
+    setCurrentCall(callId);
 
     // Context Handling
     if (state == CallState::IDLE) {
@@ -873,7 +895,9 @@ std::string PhoneCallControllerCapabilityAgent::dtmfErrorToString(
 }
 
 void PhoneCallControllerCapabilityAgent::addCall(std::string callId, CallState state) {
+    std::lock_guard<std::mutex> lock(m_contextMutex);
     m_allCallsMap[callId] = state;
+    m_callsContext.clear();
 }
 
 PhoneCallControllerCapabilityAgent::CallState PhoneCallControllerCapabilityAgent::getCallState(std::string callId) {
@@ -881,11 +905,21 @@ PhoneCallControllerCapabilityAgent::CallState PhoneCallControllerCapabilityAgent
 }
 
 void PhoneCallControllerCapabilityAgent::setCallState(std::string callId, CallState state) {
+    std::lock_guard<std::mutex> lock(m_contextMutex);
     m_allCallsMap[callId] = state;
+    m_callsContext.clear();
 }
 
 void PhoneCallControllerCapabilityAgent::removeCall(std::string callId) {
+    std::lock_guard<std::mutex> lock(m_contextMutex);
     m_allCallsMap.erase(callId);
+    m_callsContext.clear();
+}
+
+void PhoneCallControllerCapabilityAgent::setCurrentCall(const std::string& callId) {
+    std::lock_guard<std::mutex> lock(m_contextMutex);
+    m_currentCallId = callId;
+    m_callsContext.clear();
 }
 
 bool PhoneCallControllerCapabilityAgent::callExist(std::string callId) {
@@ -74,7 +74,8 @@ PhoneCallControllerEngineImpl::PhoneCallControllerEngineImpl(
         alexaClientSDK::avsCommon::utils::RequiresShutdown(TAG),
         m_phoneCallControllerPlatformInterface(phoneCallControllerPlatformInterface),
         m_isShuttingDown(false),
-        m_isAuthRefreshed(false) {
+        m_isAuthRefreshed(false),
+        m_isAccountCheckRequested(true) {
 }
 
 bool PhoneCallControllerEngineImpl::initialize(
@@ -200,6 +201,14 @@ void PhoneCallControllerEngineImpl::onConnectionStateChanged(ConnectionState sta
     if (m_phoneCallControllerCapabilityAgent != nullptr) {
         m_phoneCallControllerCapabilityAgent->connectionStateChanged(state);
     }
+
+    // the account is checked when the phone connects, so a call placed right after doesn't wait for it
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (state == ConnectionState::CONNECTED && m_connectionState != ConnectionState::CONNECTED) {
+        m_isAccountCheckRequested = true;
+        m_wakeAutoProvisioningLoop.notify_one();
+    }
+    m_connectionState = state;
 }
 
 void PhoneCallControllerEngineImpl::onCallStateChanged(
@@ -319,7 +328,11 @@ void PhoneCallControllerEngineImpl::onAuthStateChange(
     AACE_DEBUG(LX(TAG, "onAuthStateChange").d("newState", newState));
 
     std::unique_lock<std::mutex> lock(m_mutex);
-    m_isAuthRefreshed = (AuthObserverInterface::State::REFRESHED == newState);
+    auto isAuthRefreshed = (AuthObserverInterface::State::REFRESHED == newState);
+    if (isAuthRefreshed && !m_isAuthRefreshed) {
+        m_isAccountCheckRequested = true;
+    }
+    m_isAuthRefreshed = isAuthRefreshed;
     lock.unlock();
 
     if (m_isAuthRefreshed) {
@@ -329,7 +342,7 @@ void PhoneCallControllerEngineImpl::onAuthStateChange(
 
 void PhoneCallControllerEngineImpl::autoProvisioningThread() {
     AACE_DEBUG(LX(TAG, __func__));
-    auto waitOnCondition = [this]() { return (m_isShuttingDown || m_isAuthRefreshed); };
+    auto waitOnCondition = [this]() { return (m_isShuttingDown || (m_isAuthRefreshed && m_isAccountCheckRequested)); };
 
     while (true) {
         std::unique_lock<std::mutex> lock(m_mutex);
@@ -341,6 +354,7 @@ void PhoneCallControllerEngineImpl::autoProvisioningThread() {
             AACE_DEBUG(LX(TAG, __func__).m("autoProvisioning worker thread shutting down"));
             return;
         }
+        m_isAccountCheckRequested = false;
         lock.unlock();
 
         AlexaAccountInfo alexaAccountInfo;
@@ -362,8 +376,9 @@ void PhoneCallControllerEngineImpl::autoProvisioningThread() {
         }
 
         if (AlexaAccountInfo::AccountProvisionStatus::INVALID == alexaAccountInfo.provisionStatus) {
+            // the account is checked again on the next auth refresh or phone connection
             AACE_ERROR(LX(TAG, __func__).m("failedToGetAccountInfo"));
-            return;
+            continue;
         }
 
         if (AlexaAccountInfo::AccountProvisionStatus::DEPROVISIONED == alexaAccountInfo.provisionStatus) {
@@ -401,6 +416,7 @@ void PhoneCallControllerEngineImpl::autoProvisioningThread() {
                 emitCounterMetrics(METRIC_PROGRAM_NAME_SUFFIX, "autoProvisioningThread", {METRIC_AUTO_PROVISION});
             } else {
                 AACE_ERROR(LX(TAG, __func__).m("autoProvisioningAccountFailed"));
+                continue;
             }
 
             return;
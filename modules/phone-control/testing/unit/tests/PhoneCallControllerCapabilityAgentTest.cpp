@@ -138,6 +138,42 @@ static const std::string PHONE_CONNECTED_CONTEXT =
         "allCalls": []
     })";
 
+static const std::string PHONE_DISCONNECTED_DTMF_SUPPORTED_CONTEXT =
+    R"({
+        "device": {
+            "connectionState": "DISCONNECTED"
+        },
+        "configuration": {
+            "callingFeature": [
+                {
+                    "DTMF_SUPPORTED": true
+                },
+                {
+                    "OVERRIDE_RINGTONE_SUPPORTED": false
+                }
+            ]
+        },
+        "allCalls": []
+    })";
+
+static const std::string PHONE_CONNECTED_DTMF_SUPPORTED_CONTEXT =
+    R"({
+        "device": {
+            "connectionState": "CONNECTED"
+        },
+        "configuration": {
+            "callingFeature": [
+                {
+                    "DTMF_SUPPORTED": true
+                },
+                {
+                    "OVERRIDE_RINGTONE_SUPPORTED": false
+                }
+            ]
+        },
+        "allCalls": []
+    })";
+
 static const std::string CALL_FAILED_EVENT_NAME = "CallFailed";
 
 static const std::string CALL_FAILED_NO_ANSWER_EVENT_PAYLOAD =
@@ -908,6 +944,18 @@ TEST_F(PhoneCallControllerCapabilityAgentTest, testCallStateChangedInboundRingin
         aace::engine::phoneCallController::PhoneCallControllerCapabilityAgent::CallState::INBOUND_RINGING);
 }
 
+TEST_F(PhoneCallControllerCapabilityAgentTest, testContextSectionsAreUpdatedIndependently) {
+    setupExpectedContextUpdate(PHONE_DISCONNECTED_DTMF_SUPPORTED_CONTEXT, 1);
+    setupExpectedContextUpdate(PHONE_CONNECTED_DTMF_SUPPORTED_CONTEXT, 1);
+
+    m_capAgent->deviceConfigurationUpdated(
+        {{aace::phoneCallController::PhoneCallControllerEngineInterface::CallingDeviceConfigurationProperty::
+              DTMF_SUPPORTED,
+          true}});
+    m_capAgent->connectionStateChanged(
+        aace::phoneCallController::PhoneCallControllerEngineInterface::ConnectionState::CONNECTED);
+}
+
 }  // namespace phoneCallController
 }  // namespace unit
 }  // namespace test
@@ -43,6 +43,8 @@ typedef struct {
     void (*on_almost_done)(void* user_data);
     void (*on_data)(const int16_t* data, const size_t length, void* user_data);
     void (*on_data_requested)(void* user_data);
+    // the player reads an AAL_STREAM_ENCODED stream from another offset, returns false if it can't be read there
+    bool (*on_seek_data)(uint64_t offset, void* user_data);
 } aal_listener_t;
 
 typedef struct {
@@ -52,9 +54,11 @@ typedef struct {
     const aal_listener_t* listener;  // listener callback
     void* user_data;                 // user data for listener callback
     int module_id;                   // the AAL module to use
+    int64_t buffer_time;             // the audio buffered by the device in microseconds, 0 for the default
+    int64_t period_time;             // the audio transferred to the device at once in microseconds, 0 for the default
 } aal_attributes_t;
 
-typedef enum { AAL_STREAM_LPCM, AAL_STREAM_UNKNOWN } aal_stream_type_t;
+typedef enum { AAL_STREAM_LPCM, AAL_STREAM_UNKNOWN, AAL_STREAM_ENCODED } aal_stream_type_t;
 
 typedef struct {
     /**
@@ -81,10 +85,19 @@ typedef struct {
     int sample_rate;
 } aal_lpcm_parameters_t;
 
+typedef struct {
+    /**
+	 * The size of the encoded media in bytes, or -1 if it is unknown. The player detects the format of the media,
+	 * and seeks in it by calling the on_seek_data listener callback with the offset of the data written next.
+	 */
+    int64_t size;
+} aal_encoded_parameters_t;
+
 typedef struct {
     aal_stream_type_t stream_type;
     union {
         aal_lpcm_parameters_t lpcm;
+        aal_encoded_parameters_t encoded;
     };
 } aal_audio_parameters_t;
 
@@ -95,6 +108,7 @@ typedef void* aal_handle_t;
 #define AAL_MODULE_CAP_STREAM_PLAYBACK 0x01u
 #define AAL_MODULE_CAP_URL_PLAYBACK 0x02u
 #define AAL_MODULE_CAP_LPCM_PLAYBACK 0x04u
+#define AAL_MODULE_CAP_ENCODED_STREAM_PLAYBACK 0x08u
 
 int aal_get_module_count();
 int aal_find_module_by_capability(uint32_t caps);
@@ -113,6 +127,8 @@ void aal_player_stop(aal_handle_t handle);
 int64_t aal_player_get_position(aal_handle_t handle);
 int64_t aal_player_get_duration(aal_handle_t handle);
 int64_t aal_player_get_num_bytes_buffered(aal_handle_t handle);
+// the latency of the audio device in microseconds once the player started, or -1 if it is unknown
+int64_t aal_player_get_latency(aal_handle_t handle);
 void aal_player_seek(aal_handle_t handle, int64_t position);
 void aal_player_set_volume(aal_handle_t handle, double volume);
 void aal_player_set_mute(aal_handle_t handle, bool mute);
@@ -123,6 +139,8 @@ void aal_player_destroy(aal_handle_t handle);
 aal_handle_t aal_recorder_create(const aal_attributes_t* attr, aal_lpcm_parameters_t* params);
 void aal_recorder_play(aal_handle_t handle);
 void aal_recorder_stop(aal_handle_t handle);
+// the latency of the audio device in microseconds once the recorder started, or -1 if it is unknown
+int64_t aal_recorder_get_latency(aal_handle_t handle);
 void aal_recorder_destroy(aal_handle_t handle);
 
 #ifdef __cplusplus
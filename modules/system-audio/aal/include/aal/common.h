@@ -48,6 +48,7 @@ typedef struct {
     int64_t (*get_position)(aal_handle_t handle);
     int64_t (*get_duration)(aal_handle_t handle);
     int64_t (*get_num_bytes_buffered)(aal_handle_t handle);
+    int64_t (*get_latency)(aal_handle_t handle);
     void (*seek)(aal_handle_t handle, int64_t position);
     void (*set_volume)(aal_handle_t handle, double volume);
     void (*set_mute)(aal_handle_t handle, bool mute);
@@ -60,6 +61,7 @@ typedef struct {
     aal_handle_t (*create)(const aal_attributes_t* attr, aal_lpcm_parameters_t* params);
     void (*play)(aal_handle_t handle);
     void (*stop)(aal_handle_t handle);
+    int64_t (*get_latency)(aal_handle_t handle);
     void (*destroy)(aal_handle_t handle);
 } aal_recorder_ops_t;
 
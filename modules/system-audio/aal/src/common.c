@@ -181,6 +181,14 @@ int64_t aal_player_get_num_bytes_buffered(aal_handle_t handle) {
     return MODULE(handle)->player_ops->get_num_bytes_buffered(handle);
 }
 
+int64_t aal_player_get_latency(aal_handle_t handle) {
+    aal_module_t** modules = aal_modules();
+    if (!MODULE(handle)->player_ops->get_latency) {
+        return -1;
+    }
+    return MODULE(handle)->player_ops->get_latency(handle);
+}
+
 void aal_player_seek(aal_handle_t handle, int64_t position) {
     aal_module_t** modules = aal_modules();
     MODULE(handle)->player_ops->seek(handle, position);
@@ -240,6 +248,14 @@ void aal_recorder_stop(aal_handle_t handle) {
     MODULE(handle)->recorder_ops->stop(handle);
 }
 
+int64_t aal_recorder_get_latency(aal_handle_t handle) {
+    aal_module_t** modules = aal_modules();
+    if (!MODULE(handle)->recorder_ops->get_latency) {
+        return -1;
+    }
+    return MODULE(handle)->recorder_ops->get_latency(handle);
+}
+
 void aal_recorder_destroy(aal_handle_t handle) {
     aal_module_t** modules = aal_modules();
     MODULE(handle)->recorder_ops->destroy(handle);
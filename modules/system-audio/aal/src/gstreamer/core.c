@@ -18,6 +18,8 @@
 #include <stdlib.h>
 
 #include <gst/gstdebugutils.h>
+#include <gst/audio/gstaudiobasesink.h>
+#include <gst/audio/gstaudiobasesrc.h>
 
 #define UNUSED(x) (void)(x)
 
@@ -331,6 +333,83 @@ void gstreamer_destroy(aal_handle_t handle) {
     free(ctx);
 }
 
+static void set_device_times(GstElement* element, const aal_gst_context_t* ctx) {
+    // only the audio devices have the buffer and latency times of their ring buffer
+    if (!GST_IS_AUDIO_BASE_SINK(element) && !GST_IS_AUDIO_BASE_SRC(element)) return;
+
+    g_debug(
+        "%s: buffer-time=%" G_GINT64_FORMAT " latency-time=%" G_GINT64_FORMAT " on %s",
+        ctx->name,
+        ctx->buffer_time,
+        ctx->period_time,
+        GST_ELEMENT_NAME(element));
+    if (ctx->buffer_time > 0) g_object_set(G_OBJECT(element), "buffer-time", (gint64)ctx->buffer_time, NULL);
+    if (ctx->period_time > 0) g_object_set(G_OBJECT(element), "latency-time", (gint64)ctx->period_time, NULL);
+}
+
+static void set_device_times_foreach(const GValue* item, gpointer pointer) {
+    set_device_times(GST_ELEMENT(g_value_get_object(item)), (aal_gst_context_t*)pointer);
+}
+
+static void deep_element_added_callback(GstBin* bin, GstBin* sub_bin, GstElement* element, gpointer pointer) {
+    UNUSED(bin);
+    UNUSED(sub_bin);
+    set_device_times(element, (aal_gst_context_t*)pointer);
+}
+
+void gstreamer_set_device_times(aal_gst_context_t* ctx, GstElement* bin, const aal_attributes_t* attr) {
+    ctx->buffer_time = attr->buffer_time;
+    ctx->period_time = attr->period_time;
+    if (ctx->buffer_time <= 0 && ctx->period_time <= 0) return;
+
+    GstIterator* it = gst_bin_iterate_recurse(GST_BIN(bin));
+    gst_iterator_foreach(it, set_device_times_foreach, ctx);
+    gst_iterator_free(it);
+    // the devices created on the state changes, such as the device of autoaudiosink
+    g_signal_connect(bin, "deep-element-added", G_CALLBACK(deep_element_added_callback), ctx);
+}
+
+static gint find_audio_device(gconstpointer item, gconstpointer unused) {
+    UNUSED(unused);
+    GstElement* element = GST_ELEMENT(g_value_get_object((const GValue*)item));
+    return (GST_IS_AUDIO_BASE_SINK(element) || GST_IS_AUDIO_BASE_SRC(element)) ? 0 : 1;
+}
+
+int64_t gstreamer_get_latency(aal_handle_t handle) {
+    aal_gst_context_t* ctx = (aal_gst_context_t*)handle;
+    int64_t latency = -1;
+
+    GValue item = G_VALUE_INIT;
+    GstIterator* it = gst_bin_iterate_recurse(GST_BIN(ctx->pipeline));
+    gboolean found = gst_iterator_find_custom(it, find_audio_device, &item, NULL);
+    gst_iterator_free(it);
+    if (!found) return -1;
+
+    GstElement* element = GST_ELEMENT(g_value_get_object(&item));
+    gboolean is_sink = GST_IS_AUDIO_BASE_SINK(element);
+    GstAudioRingBuffer* ringbuffer = NULL;
+    GST_OBJECT_LOCK(element);
+    ringbuffer = is_sink ? GST_AUDIO_BASE_SINK(element)->ringbuffer : GST_AUDIO_BASE_SRC(element)->ringbuffer;
+    if (ringbuffer) gst_object_ref(ringbuffer);
+    GST_OBJECT_UNLOCK(element);
+
+    if (ringbuffer) {
+        GST_OBJECT_LOCK(ringbuffer);
+        GstAudioRingBufferSpec* spec = &ringbuffer->spec;
+        int64_t bytes_per_second = (int64_t)GST_AUDIO_INFO_BPF(&spec->info) * GST_AUDIO_INFO_RATE(&spec->info);
+        if (ringbuffer->acquired && bytes_per_second > 0) {
+            // a sink plays a sample after the segments queued before it, a source delivers a full segment
+            int64_t bytes = is_sink ? (int64_t)spec->segsize * spec->segtotal : spec->segsize;
+            latency = bytes * G_USEC_PER_SEC / bytes_per_second;
+        }
+        GST_OBJECT_UNLOCK(ringbuffer);
+        gst_object_unref(ringbuffer);
+    }
+    g_value_unset(&item);
+
+    return latency;
+}
+
 void gstreamer_play(aal_handle_t handle) {
     aal_gst_context_t* ctx = (aal_gst_context_t*)handle;
     gst_element_set_state(ctx->pipeline, GST_STATE_PLAYING);
@@ -576,7 +655,8 @@ extern const aal_recorder_ops_t gstreamer_recorder_ops;
 // clang-format off
 const aal_module_t gstreamer_module = {
 	.name = "GStreamer",
-	.capabilities = AAL_MODULE_CAP_STREAM_PLAYBACK | AAL_MODULE_CAP_URL_PLAYBACK | AAL_MODULE_CAP_LPCM_PLAYBACK,
+	.capabilities = AAL_MODULE_CAP_STREAM_PLAYBACK | AAL_MODULE_CAP_URL_PLAYBACK | AAL_MODULE_CAP_LPCM_PLAYBACK |
+			AAL_MODULE_CAP_ENCODED_STREAM_PLAYBACK,
 	.initialize = gstreamer_initialize,
 	.deinitialize = NULL,
 	.player_ops = &gstreamer_player_ops,
@@ -40,6 +40,10 @@ typedef struct {
     GMainContext* worker_context;
 
     aal_audio_parameters_t audio_params;
+
+    // the buffer and period times of the audio device in microseconds, or 0 for the defaults
+    int64_t buffer_time;
+    int64_t period_time;
 } aal_gst_context_t;
 
 aal_gst_context_t* gstreamer_create_context(GstElement* pipeline, const char* element, const aal_attributes_t* attr);
@@ -49,6 +53,8 @@ void gstreamer_destroy(aal_handle_t handle);
 void gstreamer_play(aal_handle_t handle);
 void gstreamer_stop(aal_handle_t handle);
 void gstreamer_pause(aal_handle_t handle);
+void gstreamer_set_device_times(aal_gst_context_t* ctx, GstElement* bin, const aal_attributes_t* attr);
+int64_t gstreamer_get_latency(aal_handle_t handle);
 
 char* gstreamer_audio_pcm_caps(GstAudioFormat sample_format, int channels, int sample_rate);
 char* gstreamer_audio_mp3_caps(int mpeg_version, int mpeg_audio_version, int layer);
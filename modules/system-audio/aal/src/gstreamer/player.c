@@ -48,6 +48,11 @@ static void enough_data_callback(GstAppSrc* src, gpointer pointer) {
 }
 
 static gboolean seek_data_callback(GstAppSrc* src, guint64 offset, gpointer pointer) {
+    aal_gst_context_t* ctx = (aal_gst_context_t*)pointer;
+    g_debug("onSeekData: offset=%" G_GUINT64_FORMAT "\n", offset);
+    // only the encoded streams are random access
+    if (ctx->audio_params.stream_type != AAL_STREAM_ENCODED) return false;
+    if (ctx->listener && ctx->listener->on_seek_data) return ctx->listener->on_seek_data(offset, ctx->user_data);
     return false;
 }
 
@@ -67,8 +72,13 @@ static void source_setup_callback(GstElement* playbin, GstElement* source, gpoin
 
     if (!GST_IS_APP_SRC(source)) return;
 
-    // Set appsrc stream type
-    gst_app_src_set_stream_type(GST_APP_SRC(source), GST_APP_STREAM_TYPE_STREAM);
+    // Set appsrc stream type. The player seeks in the encoded streams by their byte offset.
+    if (ctx->audio_params.stream_type == AAL_STREAM_ENCODED) {
+        gst_app_src_set_stream_type(GST_APP_SRC(source), GST_APP_STREAM_TYPE_RANDOM_ACCESS);
+        gst_app_src_set_size(GST_APP_SRC(source), ctx->audio_params.encoded.size);
+    } else {
+        gst_app_src_set_stream_type(GST_APP_SRC(source), GST_APP_STREAM_TYPE_STREAM);
+    }
 
     // Setup appsrc Callbacks
 #ifdef USE_APPSRC_CALLBACK
@@ -100,7 +110,12 @@ static void source_setup_callback(GstElement* playbin, GstElement* source, gpoin
         g_free(caps_string);
     }
 
-    g_object_set(G_OBJECT(source), "format", GST_FORMAT_TIME, NULL);
+    // the format of the encoded streams is detected from their data
+    if (ctx->audio_params.stream_type == AAL_STREAM_ENCODED) {
+        g_object_set(G_OBJECT(source), "format", GST_FORMAT_BYTES, NULL);
+    } else {
+        g_object_set(G_OBJECT(source), "format", GST_FORMAT_TIME, NULL);
+    }
 }
 
 static aal_handle_t gstreamer_player_create(const aal_attributes_t* attr, aal_audio_parameters_t* params) {
@@ -111,8 +126,8 @@ static aal_handle_t gstreamer_player_create(const aal_attributes_t* attr, aal_au
     GstElement* volume = NULL;
 
     if (!attr->uri || IS_EMPTY_STRING(attr->uri)) {
-        if (params != NULL && params->stream_type != AAL_STREAM_LPCM) {
-            g_debug("Should only specify audio parameters for LPCM stream");
+        if (params != NULL && params->stream_type != AAL_STREAM_LPCM && params->stream_type != AAL_STREAM_ENCODED) {
+            g_debug("Should only specify audio parameters for LPCM or encoded stream");
             goto exit;
         }
     } else {
@@ -188,6 +203,7 @@ static aal_handle_t gstreamer_player_create(const aal_attributes_t* attr, aal_au
     } else {
         g_object_set(GST_OBJECT(ctx->pipeline), "uri", attr->uri, NULL);
     }
+    gstreamer_set_device_times(ctx, bin, attr);
     g_object_set(GST_OBJECT(ctx->pipeline), "audio-sink", bin, NULL);
 
     g_signal_connect(ctx->pipeline, "about-to-finish", G_CALLBACK(about_to_finish_callback), ctx);
@@ -379,6 +395,7 @@ const aal_player_ops_t gstreamer_player_ops = {.create = gstreamer_player_create
                                                .get_position = gstreamer_player_get_position,
                                                .get_duration = gstreamer_player_get_duration,
                                                .get_num_bytes_buffered = gstreamer_player_get_num_bytes_buffered,
+                                               .get_latency = gstreamer_get_latency,
                                                .seek = gstreamer_player_seek,
                                                .set_volume = gstreamer_player_set_volume,
                                                .set_mute = gstreamer_player_set_mute,
@@ -112,6 +112,7 @@ static aal_handle_t gstreamer_recorder_create(const aal_attributes_t* attr, aal_
     ctx = gstreamer_create_context(pipeline, NULL, attr);
     if (!ctx) goto failed;
     ctx->audio_params.lpcm = *params;
+    gstreamer_set_device_times(ctx, pipeline, attr);
 
     sink = gst_bin_get_by_name(GST_BIN(pipeline), "sink");
     gst_app_sink_set_callbacks(GST_APP_SINK(sink), &app_sink_callbacks, ctx, NULL);
@@ -139,4 +140,5 @@ exit:
 const aal_recorder_ops_t gstreamer_recorder_ops = {.create = gstreamer_recorder_create,
                                                    .play = gstreamer_play,
                                                    .stop = gstreamer_stop,
+                                                   .get_latency = gstreamer_get_latency,
                                                    .destroy = gstreamer_destroy};
@@ -347,6 +347,21 @@ TEST(FunctionalTest, CreateWithFile) {
         aal_player_stop(player);
         aal_player_destroy(player);
     }
+    {  // Can play file with the buffer and period times of the device
+        attr.buffer_time = 50000;
+        attr.period_time = 10000;
+        aal_handle_t player = aal_player_create(&attr, nullptr);
+        ASSERT_NE(player, nullptr);
+        aal_player_play(player);
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        // the latency is -1 if the module can't measure it
+        int64_t latency = aal_player_get_latency(player);
+        EXPECT_TRUE(latency == -1 || latency > 0);
+        aal_player_stop(player);
+        aal_player_destroy(player);
+        attr.buffer_time = 0;
+        attr.period_time = 0;
+    }
     {  // Cannot play file with AAL_STREAM_LPCM parameter
         aal_audio_parameters_t audio_params;
         audio_params.stream_type = AAL_STREAM_LPCM;
@@ -391,4 +406,17 @@ TEST(FunctionalTest, CreateWithStream) {
         aal_handle_t player = aal_player_create(&attr, &audio_params);
         ASSERT_EQ(player, nullptr);
     }
+    if (aal_get_module_capabilities(param_module_id) & AAL_MODULE_CAP_ENCODED_STREAM_PLAYBACK) {
+        // Can play with encoded parameters, of a known or unknown size
+        aal_audio_parameters_t audio_params;
+        audio_params.stream_type = AAL_STREAM_ENCODED;
+
+        for (auto size : {(int64_t)-1, (int64_t)100000}) {
+            audio_params.encoded.size = size;
+
+            aal_handle_t player = aal_player_create(&attr, &audio_params);
+            ASSERT_NE(player, nullptr);
+            aal_player_destroy(player);
+        }
+    }
 }
\ No newline at end of file
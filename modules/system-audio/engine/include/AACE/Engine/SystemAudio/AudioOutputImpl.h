@@ -17,9 +17,14 @@
 #define AACE_ENGINE_SYSTEMAUDIO_AUDIO_OUTPUT_IMPL_H
 
 #include <AACE/Audio/AudioOutput.h>
+#include <AACE/Engine/SystemAudio/LatencyProfile.h>
+#include <AACE/Engine/SystemAudio/MediaCache.h>
+#include <AACE/Engine/SystemAudio/PlaylistResolver.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -34,19 +39,27 @@ namespace systemAudio {
 
 class AudioOutputImpl : public aace::audio::AudioOutput {
 public:
+    /// The duration of audio read ahead of the player's pipeline for the LPCM streams, by default.
+    static constexpr std::chrono::milliseconds DEFAULT_PREFETCH{300};
+
     ~AudioOutputImpl() override;
 
     // Factory
     static std::unique_ptr<AudioOutputImpl> create(
         int moduleId,
         const std::string& deviceName,
-        const std::string& name = "");
+        const std::string& name = "",
+        std::chrono::milliseconds prefetch = DEFAULT_PREFETCH,
+        std::shared_ptr<PlaylistResolver> playlistResolver = nullptr,
+        std::shared_ptr<MediaCache> mediaCache = nullptr,
+        const LatencyProfile& latencyProfile = LatencyProfile());
 
     // AAL callbacks
     void onStart();
     void onStop(aal_status_t reason);
     void onDataRequested();
     void onAlmostDone();
+    bool onSeekData(uint64_t offset);
 
     // aace::audio::AudioOutput
     bool prepare(std::shared_ptr<aace::audio::AudioStream> stream, bool repeating) override;
@@ -62,17 +75,29 @@ public:
     bool setPosition(int64_t position) override;
     int64_t getDuration() override;
     int64_t getNumBytesBuffered() override;
+    void setBufferingHint(int64_t prebufferDuration) override;
+    void prewarm() override;
     bool volumeChanged(float volume) override;
     bool mutedStateChanged(MutedState state) override;
 
 private:
-    AudioOutputImpl(int moduleId, std::string deviceName, std::string name);
+    AudioOutputImpl(
+        int moduleId,
+        std::string deviceName,
+        std::string name,
+        std::chrono::milliseconds prefetch,
+        std::shared_ptr<PlaylistResolver> playlistResolver,
+        std::shared_ptr<MediaCache> mediaCache,
+        const LatencyProfile& latencyProfile);
     bool initialize();
     bool writeStreamToFile(aace::audio::AudioStream* stream, const std::string& path);
     bool writeStreamToPipeline();
+    void applyPendingSeek();
+    void waitForDataRequested(std::chrono::milliseconds timeout);
     void streamingLoop();
 
     void executeOnStart();
+    void reportLatency();
     void executeOnStop(aal_status_t reason);
     void executeStartStreaming();
     void executeStopStreaming();
@@ -80,11 +105,19 @@ private:
     bool executePrepare(
         const std::string& url,
         const std::shared_ptr<aace::audio::AudioStream>& stream,
-        bool repeating);
-    bool prepareUrl(const std::string& url);
+        bool repeating,
+        const std::shared_future<PlaylistResolver::Entries>& playlist = {});
+    bool prepareUrl(const std::string& url, std::shared_future<PlaylistResolver::Entries> playlist = {});
     bool prepareStream(const std::shared_ptr<aace::audio::AudioStream>& stream);
+    bool prepareCachedMedia(const std::string& url);
+    void releaseCachedMedia();
     void preparePlayer(
         const std::function<aal_audio_parameters_t*(aal_attributes_t*, aal_audio_parameters_t*)>& configure);
+    void preloadNextPlayer();
+    bool playNextPlayer(const std::string& url);
+    void discardNextPlayer();
+    void executePrewarm();
+    void releasePrewarmedPlayer();
     bool executePlay();
     bool executeStop();
     bool executePause();
@@ -98,8 +131,6 @@ private:
     bool executeVolumeChanged(float volume);
     bool executeMutedStateChanged(MutedState state);
 
-    std::vector<std::string> parsePlaylistUrl(const std::string& url);
-
     // States ending with 'ing' are intermediate states that are not allowed outside an execute* method.
     // That means an execute* method should end with an *ed state by calling waitForState.
     enum class State {
@@ -124,9 +155,33 @@ private:
     void setStateLocked(State state);
     bool waitForState(State state);
 
+    // The context of the AAL callbacks of a player. The callbacks of an inactive player, such as the player
+    // preloaded for the next media, are not delivered to the audio output.
+    struct PlayerContext {
+        PlayerContext(AudioOutputImpl* audioOutput, bool active) : audioOutput(audioOutput), active(active) {
+        }
+        AudioOutputImpl* const audioOutput;
+        std::atomic<bool> active;
+        // set when an inactive player fails, so that it is not played
+        std::atomic<bool> failed{false};
+    };
+
+    aal_handle_t createPlayer(
+        const std::function<aal_audio_parameters_t*(aal_attributes_t*, aal_audio_parameters_t*)>& configure,
+        PlayerContext* context);
+
     int m_moduleId;
     std::string m_name;
     aal_handle_t m_player = nullptr;
+    std::unique_ptr<PlayerContext> m_playerContext;
+    // The player of the next media, created and pre-rolled before the current media ends for gapless playback
+    aal_handle_t m_nextPlayer = nullptr;
+    std::unique_ptr<PlayerContext> m_nextPlayerContext;
+    std::string m_nextPlayerUrl;
+    // The idle player created when the Engine pre-warms the channel, which keeps the device open and the pipeline
+    // elements loaded until the first media is prepared
+    aal_handle_t m_prewarmedPlayer = nullptr;
+    std::unique_ptr<PlayerContext> m_prewarmedPlayerContext;
     std::shared_ptr<aace::audio::AudioStream> m_currentStream;
     std::string m_mediaUrl;
     std::deque<std::string> m_mediaQueue;
@@ -139,6 +194,31 @@ private:
     std::thread m_streamingThread;
     std::atomic<bool> m_streaming;
     std::string m_deviceName;
+    // the buffer and period times of the device, and the profile its measured latency is reported with
+    LatencyProfile m_latencyProfile;
+    std::shared_ptr<PlaylistResolver> m_playlistResolver;
+
+    // The media of the current URL read from the cache, as the current stream. The player seeks in the media by
+    // setting the pending seek offset, which the streaming thread applies before its next read or write.
+    std::shared_ptr<MediaCache> m_mediaCache;
+    std::shared_ptr<MediaCache::Stream> m_cachedStream;
+    std::atomic<int64_t> m_pendingSeek{-1};
+    // set by the streaming thread once the end of the cached media is notified, until the player seeks again
+    bool m_endOfStream = false;
+
+    // The audio of the current stream read ahead of the pipeline. The data from m_prefetchStart to m_prefetchEnd
+    // has not been written yet, so a partial write resumes at m_prefetchStart.
+    std::chrono::milliseconds m_prefetch;
+    // the prebuffer the Engine hinted for the next stream, which extends the prefetch on a poor network
+    std::atomic<int64_t> m_bufferingHint{0};
+    std::vector<char> m_prefetchBuffer;
+    size_t m_prefetchStart = 0;
+    size_t m_prefetchEnd = 0;
+
+    // Set when the pipeline requests more data, to wake up the streaming thread waiting for the pipeline
+    bool m_dataRequested = false;
+    std::mutex m_dataRequestedMutex;
+    std::condition_variable m_cvDataRequested;
 
     State m_state;
     std::mutex m_stateMutex;
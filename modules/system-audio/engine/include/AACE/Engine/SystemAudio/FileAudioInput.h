@@ -0,0 +1,82 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_SYSTEMAUDIO_FILE_AUDIO_INPUT_H
+#define AACE_ENGINE_SYSTEMAUDIO_FILE_AUDIO_INPUT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <AACE/Audio/AudioInput.h>
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+/**
+ * An audio input that reads the audio from a file instead of a recording device, so the audio path of the Engine
+ * runs without sound hardware. The file is a WAV file or raw LPCM in the format of the Engine, 16 kHz, 16-bit
+ * signed little endian mono. The audio is written to the Engine in 10 ms fragments at @c speed times the real-time
+ * rate, from the start of the file each time the input is started, and silence is written after the end of the file
+ * until the input is stopped, like a microphone in a quiet room.
+ */
+class FileAudioInput : public aace::audio::AudioInput {
+public:
+    ~FileAudioInput() override;
+
+    // Factory
+    static std::unique_ptr<FileAudioInput> create(
+        const std::string& path,
+        double speed = 1.0,
+        bool loop = false,
+        const std::string& name = "");
+
+    // aace::audio::AudioInput
+    bool startAudioInput() override;
+    bool stopAudioInput() override;
+
+private:
+    FileAudioInput(std::string path, double speed, bool loop, std::string name);
+    bool initialize();
+    void streamingLoop();
+    size_t readAudio(int16_t* buffer, size_t samples);
+
+    std::string m_path;
+    double m_speed;
+    bool m_loop;
+    std::string m_name;
+
+    // The range of the audio samples in the file, after the WAV header if any
+    std::ifstream m_file;
+    std::streamoff m_dataOffset = 0;
+    std::streamoff m_dataSize = 0;
+    std::streamoff m_dataRead = 0;
+
+    std::thread m_streamingThread;
+    bool m_streaming = false;
+    std::mutex m_mutex;
+    std::condition_variable m_cvStreaming;
+};
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_SYSTEMAUDIO_FILE_AUDIO_INPUT_H
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_SYSTEMAUDIO_FILE_AUDIO_OUTPUT_H
+#define AACE_ENGINE_SYSTEMAUDIO_FILE_AUDIO_OUTPUT_H
+
+#include <AACE/Audio/AudioOutput.h>
+#include <AACE/Engine/Utils/JSON/JSON.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+/**
+ * An audio output that writes the audio to files instead of a playback device, so the audio path of the Engine runs
+ * without sound hardware. Each media prepared is written to a file in @c directory, named after the channel and
+ * numbered in order, with LPCM streams written as WAV files and encoded streams as they are read. The stream is
+ * consumed at @c speed times the real-time rate of the LPCM audio, and as fast as it is read for encoded audio whose
+ * duration is not known. Media URLs are not downloaded, they are recorded and finish as soon as they are played.
+ *
+ * A JSON file next to each audio file records the timing of the media: the time of each call of the Engine, such as
+ * @c play() and @c stop(), the time the first audio was read, and the time the media finished, in milliseconds since
+ * the epoch with the position of the media at the time.
+ */
+class FileAudioOutput : public aace::audio::AudioOutput {
+public:
+    ~FileAudioOutput() override;
+
+    // Factory
+    static std::unique_ptr<FileAudioOutput> create(
+        const std::string& directory,
+        double speed = 1.0,
+        const std::string& name = "");
+
+    // aace::audio::AudioOutput
+    bool prepare(std::shared_ptr<aace::audio::AudioStream> stream, bool repeating) override;
+    bool prepare(const std::string& url, bool repeating) override;
+    void mayDuck() override;
+    bool play() override;
+    bool stop() override;
+    bool pause() override;
+    bool resume() override;
+    bool startDucking() override;
+    bool stopDucking() override;
+    int64_t getPosition() override;
+    bool setPosition(int64_t position) override;
+    int64_t getDuration() override;
+    bool volumeChanged(float volume) override;
+    bool mutedStateChanged(MutedState state) override;
+
+private:
+    FileAudioOutput(std::string directory, double speed, std::string name);
+
+    bool executePrepare(const std::shared_ptr<aace::audio::AudioStream>& stream, const std::string& url);
+    bool executeStart(const std::string& event);
+    bool executeStop(const std::string& event);
+    void executeFinished(int media);
+    void executeClose();
+    void startStreaming();
+    void stopStreaming();
+    void streamingLoop(int media);
+
+    /// Completes the audio file and the timing metadata of the current media, so they can be read while it is open.
+    void flushFiles();
+
+    /// Records an event of the current media in its timing metadata.
+    void recordEvent(const std::string& event, const aace::engine::utils::json::Value& value = nullptr);
+
+    std::string m_directory;
+    double m_speed;
+    std::string m_name;
+    int m_mediaCount = 0;
+
+    // The current media, accessed on the executor. The stream and the file are written by the streaming thread
+    // while it is running.
+    std::shared_ptr<aace::audio::AudioStream> m_stream;
+    std::string m_url;
+    bool m_repeating = false;
+    bool m_playing = false;
+    std::string m_path;
+    std::fstream m_file;
+    bool m_wave = false;
+    int64_t m_bytesPerSecond = 0;
+    std::atomic<int64_t> m_bytesWritten{0};
+    std::atomic<int64_t> m_position{0};
+
+    // The timing metadata of the current media, recorded by the executor and the streaming thread
+    aace::engine::utils::json::Value m_metadata;
+    std::mutex m_metadataMutex;
+
+    std::thread m_streamingThread;
+    bool m_streaming = false;
+    std::mutex m_mutex;
+    std::condition_variable m_cvStreaming;
+
+    // Executor to serialize AudioOutput operations
+    alexaClientSDK::avsCommon::utils::threading::Executor m_executor;
+};
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_SYSTEMAUDIO_FILE_AUDIO_OUTPUT_H
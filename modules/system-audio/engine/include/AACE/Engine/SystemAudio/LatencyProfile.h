@@ -0,0 +1,56 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_SYSTEMAUDIO_LATENCY_PROFILE_H
+#define AACE_ENGINE_SYSTEMAUDIO_LATENCY_PROFILE_H
+
+#include <chrono>
+#include <string>
+#include <utility>
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+/**
+ * The buffer and period times the audio device of a player or a recorder is opened with. The "lowLatency" profile
+ * of the dialog and the earcons trades the power of the shorter periods for a shorter delay, and the "powerSaving"
+ * profile of the media lets the device wake up less often.
+ */
+struct LatencyProfile {
+    static constexpr const char* DEFAULT = "default";
+    static constexpr const char* LOW_LATENCY = "lowLatency";
+    static constexpr const char* POWER_SAVING = "powerSaving";
+
+    LatencyProfile(
+        std::string name = DEFAULT,
+        std::chrono::microseconds bufferTime = std::chrono::microseconds(0),
+        std::chrono::microseconds periodTime = std::chrono::microseconds(0)) :
+            name(std::move(name)), bufferTime(bufferTime), periodTime(periodTime) {
+    }
+
+    /// The name of the profile, which the latency metrics are reported with.
+    std::string name;
+    /// The audio buffered by the device, or 0 for the default of the AAL module.
+    std::chrono::microseconds bufferTime;
+    /// The audio transferred to the device at once, or 0 for the default of the AAL module.
+    std::chrono::microseconds periodTime;
+};
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_SYSTEMAUDIO_LATENCY_PROFILE_H
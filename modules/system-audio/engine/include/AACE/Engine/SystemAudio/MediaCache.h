@@ -0,0 +1,180 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_SYSTEMAUDIO_MEDIA_CACHE_H
+#define AACE_ENGINE_SYSTEMAUDIO_MEDIA_CACHE_H
+
+#include <AACE/Audio/AudioStream.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+/**
+ * MediaCache downloads the media of the HTTP URLs played by the audio outputs to files, and plays them from the
+ * files while they are downloaded.
+ *
+ * Each URL is downloaded progressively in its own thread, from the start of the media to its end. An interrupted
+ * download resumes with a byte range request from the end of the data downloaded so far, when the media is played
+ * again or its stream waits for the missing data. The stream of a URL reads the downloaded data, so the seeks,
+ * resumes, and repeats of the media are served from the file instead of the network.
+ *
+ * The cache is bounded: the full size of a media is reserved when its download starts, and the least recently
+ * played media that are not being played are removed to make room for it. The media are kept across the runs of
+ * the Engine, and their last access is the modification time of their files.
+ */
+class MediaCache : public std::enable_shared_from_this<MediaCache> {
+    struct Entry;
+    struct Download;
+
+public:
+    /// The size of the cache, by default.
+    static constexpr uint64_t DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+    /// The size of the largest media cached, by default.
+    static constexpr uint64_t DEFAULT_MAX_ENTRY_SIZE = 64 * 1024 * 1024;
+
+    /// The time @c open waits for the response to the download of a media, by default.
+    static constexpr std::chrono::seconds DEFAULT_OPEN_TIMEOUT{5};
+
+    struct Config {
+        /// The directory of the cached files, which is created if it doesn't exist.
+        std::string path;
+        /// The total size of the cached media.
+        uint64_t maxSize = DEFAULT_MAX_SIZE;
+        /// The size of the largest media cached. The larger media are played from the network.
+        uint64_t maxEntrySize = DEFAULT_MAX_ENTRY_SIZE;
+    };
+
+    /**
+     * A stream of the media of a URL, which reads the data downloaded to the cache. The reads wait for the data
+     * that is not downloaded yet, and the stream can seek to any offset of the media.
+     */
+    class Stream : public aace::audio::AudioStream {
+    public:
+        ~Stream() override;
+
+        // aace::audio::AudioStream
+        ssize_t read(char* data, const size_t size) override;
+        ssize_t timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) override;
+        bool isClosed() override;
+
+        /// Returns the size of the media in bytes.
+        uint64_t getSize();
+
+        /**
+         * Moves the position of the next read.
+         *
+         * @return @c false if @c offset is past the end of the media.
+         */
+        bool seek(uint64_t offset);
+
+    private:
+        friend class MediaCache;
+        Stream(std::shared_ptr<MediaCache> cache, std::shared_ptr<Entry> entry, int fd);
+
+        std::shared_ptr<MediaCache> m_cache;
+        std::shared_ptr<Entry> m_entry;
+        // the data file, opened for reading
+        int m_fd;
+        std::mutex m_mutex;
+        uint64_t m_position = 0;
+    };
+
+    ~MediaCache();
+
+    // Factory
+    static std::shared_ptr<MediaCache> create(const Config& config);
+
+    /// Returns @c true if @c url is an HTTP URL of a media that can be cached, which excludes the playlists.
+    static bool isCacheableUrl(const std::string& url);
+
+    /**
+     * Opens the stream of a URL, and starts or resumes its download.
+     *
+     * @return The stream, or @c nullptr if the media can't be cached because its size is unknown or too large,
+     * or the download failed before the timeout. The URL should then be played from the network.
+     */
+    std::shared_ptr<Stream> open(const std::string& url, std::chrono::milliseconds timeout = DEFAULT_OPEN_TIMEOUT);
+
+    /// Stops the downloads in progress. The opened streams are closed.
+    void shutdown();
+
+private:
+    MediaCache(const Config& config);
+
+    struct Entry {
+        std::string url;
+        // the name of the files of the media in the cache directory
+        std::string key;
+        // the size of the media, and of the data downloaded. The size is 0 until the response of the first
+        // download is received.
+        uint64_t size = 0;
+        uint64_t downloaded = 0;
+        bool downloading = false;
+        // set to stop the download
+        bool aborted = false;
+        // the failed downloads since the last progress, and the time of the last download
+        int failures = 0;
+        std::chrono::steady_clock::time_point lastAttempt;
+        // set when the media can't be cached, so the entry is removed when it is no longer used
+        bool invalid = false;
+        int readers = 0;
+        std::list<std::string>::iterator lru;
+        std::thread thread;
+    };
+
+    void loadEntries();
+    void startDownloadLocked(const std::shared_ptr<Entry>& entry);
+    void download(std::shared_ptr<Entry> entry);
+    size_t writeData(Download& download, const char* data, size_t size);
+    bool isAborted(const std::shared_ptr<Entry>& entry);
+    bool reserveLocked(const std::shared_ptr<Entry>& entry, uint64_t size);
+    void removeLocked(const std::string& key);
+    bool writeMetadata(const Entry& entry);
+    void release(const std::shared_ptr<Entry>& entry);
+
+    std::string getDataPath(const std::string& key);
+    std::string getMetadataPath(const std::string& key);
+    static std::string getKey(const std::string& url);
+
+    const Config m_config;
+
+    std::mutex m_mutex;
+    // notified when a download progresses or ends
+    std::condition_variable m_cvDownload;
+    bool m_shutdown = false;
+    // the cached media, from the most recently used
+    std::list<std::string> m_lru;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> m_entries;
+    // the sum of the sizes of the cached media
+    uint64_t m_reserved = 0;
+};
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_SYSTEMAUDIO_MEDIA_CACHE_H
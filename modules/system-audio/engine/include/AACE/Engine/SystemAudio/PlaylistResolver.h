@@ -0,0 +1,110 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_SYSTEMAUDIO_PLAYLIST_RESOLVER_H
+#define AACE_ENGINE_SYSTEMAUDIO_PLAYLIST_RESOLVER_H
+
+#include <AVSCommon/Utils/LibcurlUtils/HTTPContentFetcherFactory.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+#include <PlaylistParser/PlaylistParser.h>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+/**
+ * PlaylistResolver resolves the playlist URLs played by the audio outputs into the URLs of their entries.
+ *
+ * The playlists are fetched and parsed in the resolver's own thread, with a fetcher factory and a parser that are
+ * shared by all the resolutions. The resolved entries are kept in a bounded LRU cache for a limited time, so that
+ * playing the same station again, or repeating it, doesn't fetch its playlist again. The concurrent resolutions of
+ * the same URL share one fetch.
+ */
+class PlaylistResolver {
+public:
+    using Entries = std::vector<std::string>;
+
+    /// The number of playlists cached, by default.
+    static constexpr size_t DEFAULT_CAPACITY = 16;
+
+    /// The time the entries of a playlist are cached, by default.
+    static constexpr std::chrono::seconds DEFAULT_TTL{300};
+
+    ~PlaylistResolver();
+
+    // Factory
+    static std::shared_ptr<PlaylistResolver> create(
+        size_t capacity = DEFAULT_CAPACITY,
+        std::chrono::seconds ttl = DEFAULT_TTL);
+
+    /// Returns @c true if @c url is an HTTP URL of a playlist.
+    static bool isPlaylistUrl(const std::string& url);
+
+    /**
+     * Resolves a playlist URL.
+     *
+     * @return The future entries of the playlist, from the cache if they were resolved recently. If the playlist
+     * can't be parsed, the entries are the entries parsed so far, or @c url itself, and they are not cached.
+     */
+    std::shared_future<Entries> resolve(const std::string& url);
+
+    /// Stops the resolutions in progress.
+    void shutdown();
+
+private:
+    PlaylistResolver(size_t capacity, std::chrono::seconds ttl);
+
+    Entries executeResolve(const std::string& url, uint64_t id);
+    bool parse(const std::string& url, Entries& entries);
+
+    struct CacheEntry {
+        std::shared_future<Entries> entries;
+        // time_point::max() while the playlist is being resolved
+        std::chrono::steady_clock::time_point expiry;
+        std::list<std::string>::iterator lru;
+        uint64_t id;
+    };
+
+    const size_t m_capacity;
+    const std::chrono::seconds m_ttl;
+
+    std::shared_ptr<alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPContentFetcherFactory> m_fetcherFactory;
+    std::shared_ptr<alexaClientSDK::playlistParser::PlaylistParser> m_parser;
+
+    std::mutex m_mutex;
+    // the cached URLs, from the most recently used
+    std::list<std::string> m_lru;
+    std::unordered_map<std::string, CacheEntry> m_cache;
+    uint64_t m_nextId = 0;
+
+    // Executor to resolve the playlists one at a time
+    alexaClientSDK::avsCommon::utils::threading::Executor m_executor;
+};
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_SYSTEMAUDIO_PLAYLIST_RESOLVER_H
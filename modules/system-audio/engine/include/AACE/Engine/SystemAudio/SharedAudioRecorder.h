@@ -0,0 +1,106 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_SYSTEMAUDIO_SHARED_AUDIO_RECORDER_H
+#define AACE_ENGINE_SYSTEMAUDIO_SHARED_AUDIO_RECORDER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <AACE/Audio/AudioInput.h>
+#include <AACE/Engine/SystemAudio/LatencyProfile.h>
+#include <AACE/Engine/SystemAudio/Throttle.h>
+#include <aal/aal.h>
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+/**
+ * SharedAudioRecorder owns the single @c aal_recorder of a capture device, and fans out the captured
+ * audio to every started audio input of the device. The device is opened when the first input starts,
+ * it keeps capturing while any input is started, and it is stopped when the last input stops, so the
+ * voice, communication and loopback inputs configured on the same device share one open device, one
+ * capture thread and one buffer.
+ */
+class SharedAudioRecorder {
+public:
+    ~SharedAudioRecorder();
+
+    // Factory
+    static std::shared_ptr<SharedAudioRecorder> create(
+        int moduleId,
+        const std::string& deviceName,
+        int sampleRate,
+        const std::string& name = "",
+        const LatencyProfile& latencyProfile = LatencyProfile());
+
+    /**
+     * Starts writing the captured audio to an input, and starts the capture if no input was started.
+     *
+     * @param input The audio input.
+     * @return @c true if the capture is started, else @c false
+     */
+    bool start(aace::audio::AudioInput* input);
+
+    /**
+     * Stops writing the captured audio to an input, and stops the capture if no other input is started.
+     *
+     * @param input The audio input.
+     * @return @c true if the input is stopped, else @c false
+     */
+    bool stop(aace::audio::AudioInput* input);
+
+    void onStreamData(const int16_t* data, const size_t length);
+
+private:
+    SharedAudioRecorder(
+        int moduleId,
+        const std::string& deviceName,
+        int sampleRate,
+        const std::string& name,
+        const LatencyProfile& latencyProfile);
+    aal_handle_t createRecorder();
+    void fanOut(const int16_t* data, const size_t length);
+    void reportLatency();
+
+    int m_moduleId;
+    std::string m_deviceName;
+    int m_sampleRate;
+    std::string m_name;
+    LatencyProfile m_latencyProfile;
+
+    // Serializes the start and the stop of the recorder
+    std::mutex m_mutex;
+    aal_handle_t m_recorder = nullptr;
+    // set when the capture starts, so the latency of the device is reported with its first audio
+    std::atomic<bool> m_latencyPending{false};
+
+    // Guards the started inputs, which the recorder thread writes to
+    std::mutex m_inputsMutex;
+    std::vector<aace::audio::AudioInput*> m_inputs;
+#ifdef THROTTLE_AUDIO
+    Throttle<int16_t> m_throttle;
+#endif
+};
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_SYSTEMAUDIO_SHARED_AUDIO_RECORDER_H
@@ -19,17 +19,27 @@
 #include <set>
 #include <AACE/Engine/Utils/JSON/JSON.h>
 #include <AACE/Engine/Audio/AudioEngineService.h>
+#include <AACE/Engine/SystemAudio/LatencyProfile.h>
 
 namespace aace {
 namespace engine {
 namespace systemAudio {
 
+class MediaCache;
+class PlaylistResolver;
+
 struct DeviceConfig {
     std::string name;
     std::string module;
     std::string card;
     int rate;  // sample rate in Hz, e.g. 48000
     bool shared;
+    int prefetch;      // audio read ahead of an output pipeline in ms, or 0 for the default
+    std::string path;  // the file read by an input or the directory written by an output of the File module
+    double speed;      // the rate the File module reads and writes the audio, relative to real time
+    bool loop;         // true if an input of the File module repeats the file
+    // the buffer and period times of the device, from its profile and the times configured
+    LatencyProfile latencyProfile;
 };
 
 class SystemAudioEngineService
@@ -43,6 +53,8 @@ public:
 
     int prepareModule(const std::string& target);
     std::unique_ptr<DeviceConfig> getDeviceConfig(const std::string& name, const std::string& type);
+    std::shared_ptr<PlaylistResolver> getPlaylistResolver();
+    std::shared_ptr<MediaCache> getMediaCache();
 
 private:
     explicit SystemAudioEngineService(const aace::engine::core::ServiceDescription& description);
@@ -53,9 +65,16 @@ private:
     bool shutdown() override;
 
     bool isConfigEnabled(const std::string& name);
+    std::shared_ptr<MediaCache> createMediaCache();
 
     std::shared_ptr<rapidjson::Document> m_configuration;
     std::set<int> m_modulesInUse;
+
+    // Resolves the playlists of all the audio outputs, which share its cache
+    std::shared_ptr<PlaylistResolver> m_playlistResolver;
+
+    // Caches the media of the URLs played by the audio outputs, if it is enabled
+    std::shared_ptr<MediaCache> m_mediaCache;
 };
 
 }  // namespace systemAudio
@@ -15,11 +15,6 @@
 
 #include <AACE/Engine/SystemAudio/AudioInputImpl.h>
 #include <AACE/Engine/Core/EngineMacros.h>
-#include <cstdio>
-#include <thread>
-
-#define DEFAULT_AUDIO_FRAGMENT_DURATION 20
-#define DEFAULT_AUDIO_FRAGMENT_SAMPLES 320
 
 namespace aace {
 namespace engine {
@@ -28,181 +23,39 @@ namespace systemAudio {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.systemAudio.AudioInputImpl");
 
-void AudioInputImpl::onStreamStart() {
-#ifdef DUMP_AUDIO
-    std::string dumpFile = std::tmpnam(nullptr);
-    AACE_VERBOSE(LX("microphone").d("name", m_name).d("audioDump", dumpFile));
-    m_audioDump.open(dumpFile, std::ios::out | std::ios::binary);
-#endif
-}
-
-// static
-void AudioInputImpl::onStreamStop(aal_status_t reason) {
-#ifdef DUMP_AUDIO
-    m_audioDump.close();
-#endif
-}
-
-// static
-void AudioInputImpl::onStreamDataCallback(const int16_t* data, const size_t length) {
-#ifdef DUMP_AUDIO
-    if (m_audioDump.is_open()) {
-        m_audioDump.write(reinterpret_cast<const char*>(data), length * 2);
-    }
-#endif
-#ifdef THROTTLE_AUDIO
-    m_throttle.write(data, length);
-#else
-    write(data, length);
-#endif
-}
-
-// clang-format off
-static aal_listener_t aalListener = {
-    .on_start = [](void *user_data) {
-        ReturnIf(!user_data);
-        auto self = static_cast<AudioInputImpl*>(user_data);
-        self->onStreamStart();
-    },
-    .on_stop = [](aal_status_t reason, void *user_data) {
-        ReturnIf(!user_data);
-        auto self = static_cast<AudioInputImpl*>(user_data);
-        self->onStreamStop(reason);
-    },
-    .on_almost_done = nullptr,
-    .on_data = [](const int16_t* data, const size_t length, void* user_data) {
-        ReturnIf(!user_data);
-        auto self = static_cast<AudioInputImpl*>(user_data);
-        self->onStreamDataCallback(data, length);
-    },
-    .on_data_requested = nullptr
-};
-// clang-format on
-
-AudioInputImpl::AudioInputImpl(
-    const int moduleId,
-    const std::string& deviceName,
-    int sampleRate,
-    const std::string& name) :
-        m_moduleId(moduleId),
-        m_name(name),
-        m_deviceName(deviceName),
-        m_sampleRate(sampleRate)
-#ifdef THROTTLE_AUDIO
-        ,
-        m_throttle(
-            DEFAULT_AUDIO_FRAGMENT_SAMPLES,
-            std::chrono::milliseconds(DEFAULT_AUDIO_FRAGMENT_DURATION),
-            [this](const int16_t* data, size_t length) { write(data, length); })
-#endif
-{
+AudioInputImpl::AudioInputImpl(std::shared_ptr<SharedAudioRecorder> recorder, const std::string& name) :
+        m_recorder(std::move(recorder)), m_name(name) {
 }
 
 AudioInputImpl::~AudioInputImpl() {
-    if (m_recorder) {
-        aal_recorder_destroy(m_recorder);
-    }
+    // the recorder outlives the input when other inputs share it
+    m_recorder->stop(this);
 }
 
 std::unique_ptr<AudioInputImpl> AudioInputImpl::create(
-    const int moduleId,
-    const std::string& deviceName,
-    int sampleRate,
+    std::shared_ptr<SharedAudioRecorder> recorder,
     const std::string& name) {
     try {
-        ThrowIf(moduleId < 0 || moduleId >= aal_get_module_count(), "invalidModuleId");
-        return std::unique_ptr<AudioInputImpl>(new AudioInputImpl(moduleId, deviceName, sampleRate, name));
+        ThrowIfNull(recorder, "invalidRecorder");
+        return std::unique_ptr<AudioInputImpl>(new AudioInputImpl(std::move(recorder), name));
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return nullptr;
     }
 }
 
-aal_handle_t AudioInputImpl::createRecorder() {
-    AACE_VERBOSE(LX(TAG));
-
-    // clang-format off
-    const aal_attributes_t attr = {
-        .name = m_name.c_str(),
-        .device = m_deviceName.c_str(),
-        .uri = nullptr,
-        .listener = &aalListener,
-        .user_data = this,
-        .module_id = m_moduleId,
-    };
-    aal_lpcm_parameters_t params = {
-        .sample_format = AAL_SAMPLE_FORMAT_DEFAULT,
-        .channels = 0,
-        .sample_rate = m_sampleRate,
-    };
-    // clang-format on
-
-    return aal_recorder_create(&attr, &params);
-}
-
 //
 // aace::audio::AudioInput
 //
 
 bool AudioInputImpl::startAudioInput() {
-#ifdef UTTERANCE_FILE_INPUT
-    m_utterance.open("__utterance__", std::ios::binary);
-    if (m_utterance.is_open()) {
-        AACE_VERBOSE(LX(TAG).m("Read audio from file"));
-        std::thread thread([this]() {
-            auto fragTime = std::chrono::high_resolution_clock::now();
-            int16_t buffer[DEFAULT_AUDIO_FRAGMENT_SAMPLES] = {0};
-            for (;;) {
-                if (!m_utterance.is_open() || m_utterance.eof()) {
-                    break;
-                }
-
-                m_utterance.read(reinterpret_cast<char*>(buffer), sizeof(buffer));
-                auto count = m_utterance.gcount();
-                m_utterance.tellg();
-
-                write(buffer, count / sizeof(int16_t));
-
-                fragTime += std::chrono::milliseconds(DEFAULT_AUDIO_FRAGMENT_DURATION);
-                std::this_thread::sleep_until(fragTime);
-            }
-        });
-        thread.detach();
-        return true;
-    }
-#endif
-
-    try {
-        if (m_recorder == nullptr) {
-            m_recorder = createRecorder();
-            ThrowIfNull(m_recorder, "createRecorderFailed");
-        }
-
-        aal_recorder_play(m_recorder);
-        return true;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return false;
-    }
+    AACE_VERBOSE(LX(TAG).d("name", m_name));
+    return m_recorder->start(this);
 }
 
 bool AudioInputImpl::stopAudioInput() {
-#ifdef UTTERANCE_FILE_INPUT
-    if (m_utterance.is_open()) {
-        m_utterance.close();
-        return true;
-    }
-#endif
-
-    try {
-        AACE_VERBOSE(LX(TAG));
-        ThrowIfNull(m_recorder, "nullRecorder");
-        aal_recorder_stop(m_recorder);
-        return true;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        return false;
-    }
+    AACE_VERBOSE(LX(TAG).d("name", m_name));
+    return m_recorder->stop(this);
 }
 
 }  // namespace systemAudio
@@ -13,12 +13,13 @@
  * permissions and limitations under the License.
  */
 
-#include <AVSCommon/Utils/LibcurlUtils/HTTPContentFetcherFactory.h>
-#include <PlaylistParser/PlaylistParser.h>
 #include <AACE/Engine/SystemAudio/AudioOutputImpl.h>
 #include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
 #include <AACE/Audio/AudioFormat.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cstring>
 #include <utility>
 #include "curl/curl.h"
@@ -32,8 +33,23 @@ namespace systemAudio {
 // String to identify log entries originating from this file.
 static const char* TAG("aace.systemAudio.AudioOutputImpl");
 
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "AudioOutputImpl";
+
 static constexpr size_t READ_BUFFER_SIZE = 4096;
 
+/// The size of the prefetch buffer of the media read from the cache, which are read from a local file
+static constexpr size_t CACHED_MEDIA_PREFETCH_SIZE = 64 * 1024;
+
+/// The maximum time the streaming thread waits for the stream or the pipeline before checking it is still streaming
+static constexpr std::chrono::milliseconds RETRY_INTERVAL(100);
+
+/// The time a read waits to top up the prefetch buffer while there is still data to write. It is not zero because
+/// reading an attachment without a timeout waits for data indefinitely.
+static constexpr std::chrono::milliseconds PREFETCH_READ_TIMEOUT(1);
+
+constexpr std::chrono::milliseconds AudioOutputImpl::DEFAULT_PREFETCH;
+
 std::ostream& operator<<(std::ostream& stream, AudioOutputImpl::State state) {
     switch (state) {
         case AudioOutputImpl::State::Created:
@@ -151,17 +167,33 @@ bool AudioOutputImpl::waitForState(State state) {
     return true;
 }
 
-AudioOutputImpl::AudioOutputImpl(const int moduleId, std::string deviceName, std::string name) :
+AudioOutputImpl::AudioOutputImpl(
+    const int moduleId,
+    std::string deviceName,
+    std::string name,
+    std::chrono::milliseconds prefetch,
+    std::shared_ptr<PlaylistResolver> playlistResolver,
+    std::shared_ptr<MediaCache> mediaCache,
+    const LatencyProfile& latencyProfile) :
         m_moduleId(moduleId),
         m_name(std::move(name)),
+        m_playerContext(new PlayerContext(this, true)),
+        m_nextPlayerContext(new PlayerContext(this, false)),
+        m_prewarmedPlayerContext(new PlayerContext(this, false)),
         m_streaming(false),
         m_deviceName(std::move(deviceName)),
+        m_latencyProfile(latencyProfile),
+        m_playlistResolver(std::move(playlistResolver)),
+        m_mediaCache(std::move(mediaCache)),
+        m_prefetch(prefetch),
         m_state(State::Created) {
 }
 
 AudioOutputImpl::~AudioOutputImpl() {
     m_executor.submit([this] {
         executeStopStreaming();
+        discardNextPlayer();
+        releasePrewarmedPlayer();
         if (m_player) {
             aal_player_destroy(m_player);
         }
@@ -175,11 +207,31 @@ AudioOutputImpl::~AudioOutputImpl() {
 std::unique_ptr<AudioOutputImpl> AudioOutputImpl::create(
     const int moduleId,
     const std::string& deviceName,
-    const std::string& name) {
+    const std::string& name,
+    std::chrono::milliseconds prefetch,
+    std::shared_ptr<PlaylistResolver> playlistResolver,
+    std::shared_ptr<MediaCache> mediaCache,
+    const LatencyProfile& latencyProfile) {
     try {
         ThrowIf(moduleId < 0 || moduleId >= aal_get_module_count(), "invalidModuleId");
+        ThrowIf(prefetch.count() <= 0, "invalidPrefetch");
+        ThrowIf(
+            latencyProfile.bufferTime.count() < 0 || latencyProfile.periodTime.count() < 0, "invalidLatencyProfile");
+
+        // an audio output that is not given the shared resolver caches its own playlists
+        if (!playlistResolver) {
+            playlistResolver = PlaylistResolver::create();
+            ThrowIfNull(playlistResolver, "createPlaylistResolverFailed");
+        }
 
-        auto audioOutput = std::unique_ptr<AudioOutputImpl>(new AudioOutputImpl(moduleId, deviceName, name));
+        auto audioOutput = std::unique_ptr<AudioOutputImpl>(new AudioOutputImpl(
+            moduleId,
+            deviceName,
+            name,
+            prefetch,
+            std::move(playlistResolver),
+            std::move(mediaCache),
+            latencyProfile));
 
         ThrowIfNot(audioOutput->initialize(), "initializeFailed");
 
@@ -236,35 +288,64 @@ bool AudioOutputImpl::writeStreamToFile(aace::audio::AudioStream* stream, const
 bool AudioOutputImpl::writeStreamToPipeline() {
     try {
         ThrowIfNull(m_currentStream, "invalidAudioStream");
-
-        constexpr std::chrono::milliseconds RETRY_INTERVAL(100);
-        char buffer[READ_BUFFER_SIZE];
-        ssize_t size = 0;
-
-        while (m_streaming) {
-            size = m_currentStream->read(buffer, READ_BUFFER_SIZE);
+        applyPendingSeek();
+
+        // top up the prefetch buffer with as much data as is available. The read waits for the next data
+        // only when there is nothing left to write, and returns at least every retry interval so that the
+        // streaming can be stopped.
+        if (m_prefetchEnd == m_prefetchBuffer.size() && m_prefetchStart > 0) {
+            std::memmove(
+                m_prefetchBuffer.data(), m_prefetchBuffer.data() + m_prefetchStart, m_prefetchEnd - m_prefetchStart);
+            m_prefetchEnd -= m_prefetchStart;
+            m_prefetchStart = 0;
+        }
+        if (m_prefetchEnd < m_prefetchBuffer.size() && !m_currentStream->isClosed()) {
+            auto timeout = m_prefetchStart == m_prefetchEnd ? RETRY_INTERVAL : PREFETCH_READ_TIMEOUT;
+            ssize_t size = m_currentStream->timedRead(
+                m_prefetchBuffer.data() + m_prefetchEnd, m_prefetchBuffer.size() - m_prefetchEnd, timeout);
             ThrowIf(size < 0, "readFromStreamFailed");
-            if (size > 0) {
-                break;
-            }
+            m_prefetchEnd += size;
+        }
+
+        if (m_prefetchStart == m_prefetchEnd) {
             if (m_currentStream->isClosed()) {
+                if (m_cachedStream) {
+                    // the player may seek back in the cached media after its end, so the streaming continues
+                    if (!m_endOfStream) {
+                        aal_player_notify_end_of_stream(m_player);
+                        m_endOfStream = true;
+                    }
+                    waitForDataRequested(RETRY_INTERVAL);
+                    return true;
+                }
                 aal_player_notify_end_of_stream(m_player);
                 return false;
             }
-            // if we didn't read any data and the stream is not closed, then
-            // sleep some mount of time before next read
-            std::this_thread::sleep_for(RETRY_INTERVAL);
-        }
-
-        // write the data to the player's pipeline
-        while (m_streaming) {
-            int written = aal_player_write(m_player, buffer, size);
-            ThrowIf(written < 0, "writeToPipelineFailed");
-            if (written > 0) {
-                ThrowIf(written != size, "writeToPipelinePartially");
-                break;
-            }
-            std::this_thread::sleep_for(RETRY_INTERVAL);
+            return true;
+        }
+
+        // write the pending data to the player's pipeline, which may accept only part of it. The data read
+        // before a seek is not written.
+        applyPendingSeek();
+        if (m_prefetchStart == m_prefetchEnd) {
+            return true;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_dataRequestedMutex);
+            m_dataRequested = false;
+        }
+        int written = aal_player_write(
+            m_player, m_prefetchBuffer.data() + m_prefetchStart, m_prefetchEnd - m_prefetchStart);
+        ThrowIf(written < 0, "writeToPipelineFailed");
+        if (written == 0) {
+            // the pipeline is full, so wait until it requests more data
+            waitForDataRequested(RETRY_INTERVAL);
+            return true;
+        }
+
+        m_prefetchStart += written;
+        if (m_prefetchStart == m_prefetchEnd) {
+            m_prefetchStart = m_prefetchEnd = 0;
         }
 
         return true;
@@ -278,6 +359,23 @@ bool AudioOutputImpl::writeStreamToPipeline() {
     }
 }
 
+void AudioOutputImpl::applyPendingSeek() {
+    auto offset = m_pendingSeek.exchange(-1);
+    if (offset < 0) {
+        return;
+    }
+    AACE_DEBUG(LXT.d("offset", offset));
+    ThrowIfNot(m_cachedStream && m_cachedStream->seek(offset), "seekFailed");
+    m_prefetchStart = m_prefetchEnd = 0;
+    m_endOfStream = false;
+}
+
+void AudioOutputImpl::waitForDataRequested(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_dataRequestedMutex);
+    m_cvDataRequested.wait_for(lock, timeout, [this] { return m_dataRequested || !m_streaming; });
+    m_dataRequested = false;
+}
+
 void AudioOutputImpl::onStart() {
     m_executorCallback.submit([this] { executeOnStart(); });
 }
@@ -297,7 +395,26 @@ void AudioOutputImpl::executeOnStart() {
         return;
     }
 
+    // the device is opened, and its latency known, once the first start of the media is notified
+    bool first = checkState(State::Starting);
     setState(State::Started);
+    if (first) {
+        reportLatency();
+    }
+}
+
+void AudioOutputImpl::reportLatency() {
+    int64_t latency = aal_player_get_latency(m_player);
+    AACE_DEBUG(LXT.d("profile", m_latencyProfile.name).d("latency", latency));
+    if (latency < 0) {
+        return;
+    }
+    aace::engine::utils::metrics::emitMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX,
+        "reportLatency",
+        {},
+        {{"Name", m_name}, {"Profile", m_latencyProfile.name}},
+        {{"PipelineLatency", static_cast<double>(latency) / 1000}});
 }
 
 void AudioOutputImpl::onStop(aal_status_t reason) {
@@ -307,6 +424,15 @@ void AudioOutputImpl::onStop(aal_status_t reason) {
 void AudioOutputImpl::onAlmostDone() {
     int64_t almostDonePosition = aal_player_get_position(m_player);
     m_executorCallback.submit([this, almostDonePosition] { m_currentPosition = almostDonePosition; });
+
+    // the current media has been read to its end, so the next media can be prepared without competing with it
+    m_executor.submit([this] { preloadNextPlayer(); });
+}
+
+bool AudioOutputImpl::onSeekData(uint64_t offset) {
+    // only the media read from the cache are played as random access streams
+    m_pendingSeek = static_cast<int64_t>(offset);
+    return true;
 }
 
 void AudioOutputImpl::executeOnStop(aal_status_t reason) {
@@ -348,22 +474,32 @@ void AudioOutputImpl::executeOnStop(aal_status_t reason) {
                         m_mediaQueue.pop_front();
                     }
                     if (!m_mediaQueue.empty()) {
-                        // play next media item
-                        preparePlayer([this](aal_attributes_t* attr, aal_audio_parameters_t*) {
-                            attr->uri = m_mediaQueue.front().c_str();
-                            return nullptr;
-                        });
+                        // play next media item, with the preloaded player if it is ready
+                        if (playNextPlayer(m_mediaQueue.front())) {
+                            return;  // no state change
+                        }
+                        if (!prepareCachedMedia(m_mediaQueue.front())) {
+                            preparePlayer([this](aal_attributes_t* attr, aal_audio_parameters_t*) {
+                                attr->uri = m_mediaQueue.front().c_str();
+                                return nullptr;
+                            });
+                        }
                         if (m_player) {
                             aal_player_play(m_player);
                             return;  // no state change
                         }
                     } else if (m_repeating && !m_mediaUrl.empty()) {
                         // play the URL again
+                        if (playNextPlayer(m_mediaUrl)) {
+                            m_mediaQueue.emplace_back(m_mediaUrl);
+                            return;  // no state change
+                        }
                         if (prepareUrl(m_mediaUrl)) {
                             aal_player_play(m_player);
                             return;  // no state change
                         }
                     }
+                    discardNextPlayer();
                     setState(State::Stopped);
                 })
                 .wait();
@@ -376,6 +512,7 @@ void AudioOutputImpl::executeOnStop(aal_status_t reason) {
 }
 
 void AudioOutputImpl::streamingLoop() {
+    aace::engine::utils::threading::ThreadPolicy::ScopedThread scopedThread("SystemAudio.AudioOutput." + m_name);
     do {
         if (!writeStreamToPipeline()) break;
     } while (m_streaming);
@@ -392,13 +529,23 @@ void AudioOutputImpl::executeStartStreaming() {
 }
 
 void AudioOutputImpl::executeStopStreaming() {
-    m_streaming = false;
+    {
+        std::lock_guard<std::mutex> lock(m_dataRequestedMutex);
+        m_streaming = false;
+    }
+    m_cvDataRequested.notify_all();
     if (m_streamingThread.joinable()) {
         m_streamingThread.join();
     }
 }
 
 void AudioOutputImpl::onDataRequested() {
+    // wake up the streaming thread if it is waiting for the pipeline, without waiting for the executor
+    {
+        std::lock_guard<std::mutex> lock(m_dataRequestedMutex);
+        m_dataRequested = true;
+    }
+    m_cvDataRequested.notify_all();
     m_executorCallback.submit([this]() { executeStartStreaming(); });
 }
 
@@ -413,7 +560,8 @@ bool AudioOutputImpl::prepare(std::shared_ptr<aace::audio::AudioStream> stream,
 bool AudioOutputImpl::executePrepare(
     const std::string& url,
     const std::shared_ptr<aace::audio::AudioStream>& stream,
-    bool repeating) {
+    bool repeating,
+    const std::shared_future<PlaylistResolver::Entries>& playlist) {
     AACE_INFO(LXT.d("repeating", repeating));
     if (!checkState({
             State::Initialized,  // new one
@@ -428,10 +576,12 @@ bool AudioOutputImpl::executePrepare(
     try {
         setState(State::Preparing);
         m_mediaQueue.clear();
+        discardNextPlayer();
 
         if (!url.empty()) {
-            ThrowIfNot(prepareUrl(url), "prepareUrlFailed");
+            ThrowIfNot(prepareUrl(url, playlist), "prepareUrlFailed");
         } else if (stream) {
+            releaseCachedMedia();
             AACE_VERBOSE(LXT.d("encoding", stream->getEncoding()));
             switch (stream->getEncoding()) {
                 case audio::AudioStream::Encoding::UNKNOWN:
@@ -475,101 +625,85 @@ bool AudioOutputImpl::executePrepare(
 }
 
 bool AudioOutputImpl::prepare(const std::string& url, bool repeating) {
-    return m_executor.submit([this, url, repeating]() { return executePrepare(url, nullptr, repeating); }).get();
+    // resolve a playlist before the preparation is submitted, so that the executor is not blocked while
+    // the playlist is fetched
+    std::shared_future<PlaylistResolver::Entries> playlist;
+    if (PlaylistResolver::isPlaylistUrl(url)) {
+        playlist = m_playlistResolver->resolve(url);
+        playlist.wait();
+    }
+    return m_executor
+        .submit([this, url, repeating, playlist]() { return executePrepare(url, nullptr, repeating, playlist); })
+        .get();
 }
 
-void AudioOutputImpl::mayDuck() {
-    AACE_INFO(LXT.d("mayDuck", "true"));
+void AudioOutputImpl::setBufferingHint(int64_t prebufferDuration) {
+    AACE_DEBUG(LXT.d("prebufferDuration", prebufferDuration));
+    m_bufferingHint = std::max<int64_t>(prebufferDuration, 0);
 }
 
-using alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPContentFetcherFactory;
-using alexaClientSDK::avsCommon::utils::playlistParser::PlaylistEntry;
-using alexaClientSDK::avsCommon::utils::playlistParser::PlaylistParseResult;
-using alexaClientSDK::avsCommon::utils::playlistParser::PlaylistParserObserverInterface;
-using alexaClientSDK::playlistParser::PlaylistParser;
-
-struct PlaylistParserObserver : public PlaylistParserObserverInterface {
-    std::vector<std::string> entries;
-    std::promise<std::vector<std::string>> promise;
-    std::promise<std::vector<std::string>> fallbackPromise;
-    void onPlaylistEntryParsed(int requestId, PlaylistEntry playlistEntry) override {
-        if (playlistEntry.parseResult == PlaylistParseResult::STILL_ONGOING) {
-            entries.emplace_back(playlistEntry.url);
-            if (entries.size() == 1) {
-                // We got the first entry. Use it as the fallback solution.
-                fallbackPromise.set_value(entries);
-            }
-        } else if (playlistEntry.parseResult == PlaylistParseResult::FINISHED) {
-            entries.emplace_back(playlistEntry.url);
-            promise.set_value(entries);
-        } else if (playlistEntry.parseResult == PlaylistParseResult::ERROR) {
-            if (entries.empty()) {
-                try {
-                    throw std::runtime_error("error occurred while parsing playlist");
-                } catch (...) {
-                    // store anything thrown in the promise
-                    promise.set_exception(std::current_exception());
-                }
-            } else {
-                // We got some entries. Ignore the final error result.
-                promise.set_value(entries);
-            }
-        }
-    }
-};
-
-std::vector<std::string> AudioOutputImpl::parsePlaylistUrl(const std::string& url) {
-    auto fetcherFactory = std::make_shared<HTTPContentFetcherFactory>();
-    auto parser = PlaylistParser::create(fetcherFactory);
-    auto observer = std::make_shared<PlaylistParserObserver>();
-
-    if (parser->parsePlaylist(url, observer, {PlaylistParser::PlaylistParserInterface::PlaylistType::EXT_M3U}) ==
-        PlaylistParser::START_FAILURE) {
-        AACE_ERROR(LXT.d("reason", "failed to start playlist parser"));
-        return {url};
-    }
+void AudioOutputImpl::prewarm() {
+    m_executor.submit([this] { executePrewarm(); });
+}
 
+void AudioOutputImpl::executePrewarm() {
     try {
-        const auto PLAYLIST_TIMEOUT = std::chrono::seconds(10);
-        auto future = observer->promise.get_future();
-        if (future.wait_for(PLAYLIST_TIMEOUT) == std::future_status::ready) {
-            parser->shutdown();
-            return future.get();  // return successfully parsed entries
-        }
-
-        AACE_ERROR(LXT.d("reason", "parsing playlist timeout"));
-        parser->shutdown();
-
-        auto fallbackFuture = observer->fallbackPromise.get_future();
-        if (fallbackFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-            AACE_INFO(LXT.m("use what we got so far"));
-            return fallbackFuture.get();
+        // a channel that prepared its media already is warm
+        if (m_prewarmedPlayer || m_player || !checkState(State::Initialized)) {
+            return;
         }
+        const uint32_t lpcm_stream_caps = AAL_MODULE_CAP_STREAM_PLAYBACK | AAL_MODULE_CAP_LPCM_PLAYBACK;
+        ThrowIf(
+            (aal_get_module_capabilities(m_moduleId) & lpcm_stream_caps) != lpcm_stream_caps, "LpcmStreamUnsupported");
+
+        m_prewarmedPlayer = createPlayer(
+            [](aal_attributes_t*, aal_audio_parameters_t* params) {
+                params->stream_type = AAL_STREAM_LPCM;
+                params->lpcm = {.sample_format = AAL_SAMPLE_FORMAT_S16LE, .channels = 1, .sample_rate = 16000};
+                return params;
+            },
+            m_prewarmedPlayerContext.get());
+        ThrowIfNull(m_prewarmedPlayer, "createPrewarmedPlayerFailed");
+
+        // pausing the player opens the device and builds the pipeline, which stays idle without data
+        aal_player_pause(m_prewarmedPlayer);
+        AACE_DEBUG(LXT.m("playerPrewarmed"));
+    } catch (std::exception& ex) {
+        AACE_WARN(LXT.d("reason", ex.what()));
+    }
+}
 
-        return {url};
-    } catch (const std::exception& e) {
-        AACE_ERROR(LXT.d("reason", e.what()));
-        return {url};
+void AudioOutputImpl::releasePrewarmedPlayer() {
+    if (m_prewarmedPlayer) {
+        aal_player_destroy(m_prewarmedPlayer);
+        m_prewarmedPlayer = nullptr;
     }
 }
 
-bool AudioOutputImpl::prepareUrl(const std::string& url) {
+void AudioOutputImpl::mayDuck() {
+    AACE_INFO(LXT.d("mayDuck", "true"));
+}
+
+bool AudioOutputImpl::prepareUrl(const std::string& url, std::shared_future<PlaylistResolver::Entries> playlist) {
     try {
         AACE_INFO(LXT.sensitive("url", url));
 
-        static std::regex regex_playlist(
-            R"(^(http|https):\/\/.+\.(ashx|m3u|pls)(\?.*)?$)", std::regex::optimize | std::regex::icase);
-        if (std::regex_match(url, regex_playlist)) {
-            auto entries = parsePlaylistUrl(url);
+        if (PlaylistResolver::isPlaylistUrl(url)) {
+            if (!playlist.valid()) {
+                playlist = m_playlistResolver->resolve(url);
+            }
+            auto entries = playlist.get();
             std::copy(entries.begin(), entries.end(), std::back_inserter(m_mediaQueue));
         } else {
             m_mediaQueue.emplace_back(url);
         }
         ThrowIf(m_mediaQueue.empty(), "mediaQueueEmpty");
-        preparePlayer([this](aal_attributes_t* attr, aal_audio_parameters_t*) {
-            attr->uri = m_mediaQueue.front().c_str();
-            return nullptr;
-        });
+        if (!prepareCachedMedia(m_mediaQueue.front())) {
+            preparePlayer([this](aal_attributes_t* attr, aal_audio_parameters_t*) {
+                attr->uri = m_mediaQueue.front().c_str();
+                return nullptr;
+            });
+        }
         ThrowIfNull(m_player, "createPlayerFailed");
 
         m_mediaUrl = url;  // save it for repeating
@@ -583,6 +717,9 @@ bool AudioOutputImpl::prepareUrl(const std::string& url) {
 
 bool AudioOutputImpl::prepareStream(const std::shared_ptr<aace::audio::AudioStream>& stream) {
     try {
+        // the streaming thread of the previous stream owns the prefetch buffer until it is stopped
+        executeStopStreaming();
+
         auto af = stream->getAudioFormat();
         preparePlayer([this, &af](aal_attributes_t* attr, aal_audio_parameters_t* params) {
             ThrowIf(af.getEncoding() != aace::audio::AudioFormat::Encoding::LPCM, "unsupported encoding");
@@ -602,6 +739,14 @@ bool AudioOutputImpl::prepareStream(const std::shared_ptr<aace::audio::AudioStre
             return params;
         });
         ThrowIfNull(m_player, "createPlayerFailed");
+
+        // size the prefetch buffer for the stream's format and the buffering hint, and drop the data left from
+        // the previous stream
+        size_t bytesPerSecond = af.getSampleRate() * af.getNumChannels() * sizeof(int16_t);
+        auto prefetch = std::max<int64_t>(m_prefetch.count(), m_bufferingHint);
+        m_prefetchBuffer.resize(std::max(READ_BUFFER_SIZE, bytesPerSecond * prefetch / 1000));
+        m_prefetchStart = m_prefetchEnd = 0;
+        AACE_DEBUG(LXT.d("prefetch", prefetch).d("prefetchBufferSize", m_prefetchBuffer.size()));
     } catch (std::exception& ex) {
         AACE_ERROR(LXT.d("reason", ex.what()));
         return false;
@@ -610,35 +755,114 @@ bool AudioOutputImpl::prepareStream(const std::shared_ptr<aace::audio::AudioStre
     return true;
 }
 
+bool AudioOutputImpl::prepareCachedMedia(const std::string& url) {
+    try {
+        // the media is played from the network if it can't be cached. The stream is opened before the stream of
+        // the previous media is released, so that the download of a repeated media continues.
+        std::shared_ptr<MediaCache::Stream> stream;
+        if (m_mediaCache && MediaCache::isCacheableUrl(url) &&
+            (aal_get_module_capabilities(m_moduleId) & AAL_MODULE_CAP_ENCODED_STREAM_PLAYBACK) != 0) {
+            stream = m_mediaCache->open(url);
+        }
+        releaseCachedMedia();
+        if (!stream) {
+            return false;
+        }
+
+        // the streaming thread of the previous stream owns the prefetch buffer until it is stopped
+        executeStopStreaming();
+        auto size = static_cast<int64_t>(stream->getSize());
+        preparePlayer([size](aal_attributes_t* attr, aal_audio_parameters_t* params) {
+            params->stream_type = AAL_STREAM_ENCODED;
+            params->encoded = {.size = size};
+            return params;
+        });
+        ThrowIfNull(m_player, "createPlayerFailed");
+
+        m_cachedStream = stream;
+        m_currentStream = stream;
+        m_pendingSeek = -1;
+        m_endOfStream = false;
+        m_prefetchBuffer.resize(CACHED_MEDIA_PREFETCH_SIZE);
+        m_prefetchStart = m_prefetchEnd = 0;
+        AACE_DEBUG(LXT.m("cachedMediaPrepared").d("size", size));
+    } catch (std::exception& ex) {
+        AACE_WARN(LXT.d("reason", ex.what()));
+        return false;
+    }
+
+    return true;
+}
+
+void AudioOutputImpl::releaseCachedMedia() {
+    if (!m_cachedStream) {
+        return;
+    }
+    // the streaming thread reads the cached stream until it is stopped
+    executeStopStreaming();
+    if (m_currentStream == m_cachedStream) {
+        m_currentStream.reset();
+    }
+    m_cachedStream.reset();
+}
+
 void AudioOutputImpl::preparePlayer(
     const std::function<aal_audio_parameters_t*(aal_attributes_t*, aal_audio_parameters_t*)>& configure) {
+    // the device of the pre-warmed player is released for the player of the media
+    releasePrewarmedPlayer();
     if (m_player) {
         aal_player_destroy(m_player);
         m_player = nullptr;
     }
 
+    m_player = createPlayer(configure, m_playerContext.get());
+
+    if (m_player) {
+        executeVolumeChanged(m_currentVolume);
+        executeMutedStateChanged(m_currentMutedState);
+    }
+}
+
+aal_handle_t AudioOutputImpl::createPlayer(
+    const std::function<aal_audio_parameters_t*(aal_attributes_t*, aal_audio_parameters_t*)>& configure,
+    PlayerContext* context) {
     // clang-format off
     static aal_listener_t aalListener = {
         .on_start = [](void* user_data) {
           ReturnIf(!user_data);
-          auto *self = static_cast<AudioOutputImpl*>(user_data);
-          self->onStart();
+          auto *context = static_cast<PlayerContext*>(user_data);
+          ReturnIf(!context->active);
+          context->audioOutput->onStart();
         },
         .on_stop = [](aal_status_t reason, void* user_data) {
           ReturnIf(!user_data);
-          auto *self = static_cast<AudioOutputImpl*>(user_data);
-          self->onStop(reason);
+          auto *context = static_cast<PlayerContext*>(user_data);
+          if (!context->active) {
+              if (reason == AAL_ERROR) {
+                  context->failed = true;
+              }
+              return;
+          }
+          context->audioOutput->onStop(reason);
         },
         .on_almost_done = [](void* user_data) {
           ReturnIf(!user_data);
-          auto *self = static_cast<AudioOutputImpl*>(user_data);
-          self->onAlmostDone();
+          auto *context = static_cast<PlayerContext*>(user_data);
+          ReturnIf(!context->active);
+          context->audioOutput->onAlmostDone();
         },
         .on_data = nullptr,
         .on_data_requested = [](void* user_data) {
           ReturnIf(!user_data);
-          auto *self = static_cast<AudioOutputImpl*>(user_data);
-          self->onDataRequested();
+          auto *context = static_cast<PlayerContext*>(user_data);
+          ReturnIf(!context->active);
+          context->audioOutput->onDataRequested();
+        },
+        .on_seek_data = [](uint64_t offset, void* user_data) {
+          ReturnIf(!user_data, false);
+          auto *context = static_cast<PlayerContext*>(user_data);
+          ReturnIf(!context->active, false);
+          return context->audioOutput->onSeekData(offset);
         }
     };
     // clang-format on
@@ -649,19 +873,91 @@ void AudioOutputImpl::preparePlayer(
         .device = m_deviceName.c_str(),
         .uri = nullptr,
         .listener = &aalListener,
-        .user_data = this,
+        .user_data = context,
         .module_id = m_moduleId,
+        .buffer_time = m_latencyProfile.bufferTime.count(),
+        .period_time = m_latencyProfile.periodTime.count(),
     };
     // clang-format on
 
     aal_audio_parameters_t audio_params;
     auto* params = configure(&attr, &audio_params);
-    m_player = aal_player_create(&attr, params);
+    return aal_player_create(&attr, params);
+}
 
-    if (m_player) {
-        executeVolumeChanged(m_currentVolume);
-        executeMutedStateChanged(m_currentMutedState);
+void AudioOutputImpl::preloadNextPlayer() {
+    try {
+        if (m_nextPlayer || !checkState(State::Started)) {
+            return;
+        }
+
+        // the next entry of a playlist, or the same media when it is repeated
+        std::string url;
+        if (m_mediaQueue.size() > 1) {
+            url = m_mediaQueue[1];
+        } else if (
+            m_mediaQueue.size() == 1 && m_repeating && !m_mediaUrl.empty() &&
+            !PlaylistResolver::isPlaylistUrl(m_mediaUrl) && !m_cachedStream) {
+            // a media played from the cache is repeated from the cache
+            url = m_mediaUrl;
+        } else {
+            return;
+        }
+
+        m_nextPlayerContext->failed = false;
+        m_nextPlayer = createPlayer(
+            [&url](aal_attributes_t* attr, aal_audio_parameters_t*) {
+                attr->uri = url.c_str();
+                return nullptr;
+            },
+            m_nextPlayerContext.get());
+        ThrowIfNull(m_nextPlayer, "createNextPlayerFailed");
+        m_nextPlayerUrl = url;
+
+        // pausing the player pre-rolls the media, so that it plays as soon as the current media ends
+        aal_player_pause(m_nextPlayer);
+        AACE_DEBUG(LXT.m("nextPlayerPreloaded").sensitive("url", url));
+    } catch (std::exception& ex) {
+        AACE_WARN(LXT.d("reason", ex.what()));
+    }
+}
+
+bool AudioOutputImpl::playNextPlayer(const std::string& url) {
+    if (!m_nextPlayer) {
+        return false;
+    }
+    if (m_nextPlayerUrl != url || m_nextPlayerContext->failed) {
+        AACE_WARN(LXT.m("nextPlayerDiscarded").d("failed", m_nextPlayerContext->failed.load()));
+        discardNextPlayer();
+        return false;
+    }
+
+    // the completed player is destroyed after the next one plays, so that its teardown doesn't delay the next media
+    auto completedPlayer = m_player;
+    m_playerContext->active = false;
+    m_player = m_nextPlayer;
+    m_nextPlayer = nullptr;
+    m_nextPlayerUrl.clear();
+    std::swap(m_playerContext, m_nextPlayerContext);
+    m_playerContext->active = true;
+
+    executeVolumeChanged(m_currentVolume);
+    executeMutedStateChanged(m_currentMutedState);
+    aal_player_play(m_player);
+    if (completedPlayer) {
+        aal_player_destroy(completedPlayer);
+    }
+
+    AACE_DEBUG(LXT.m("nextPlayerStarted"));
+    return true;
+}
+
+void AudioOutputImpl::discardNextPlayer() {
+    if (m_nextPlayer) {
+        aal_player_destroy(m_nextPlayer);
+        m_nextPlayer = nullptr;
     }
+    m_nextPlayerUrl.clear();
 }
 
 bool AudioOutputImpl::play() {
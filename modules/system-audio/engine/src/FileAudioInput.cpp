@@ -0,0 +1,242 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/SystemAudio/FileAudioInput.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+#define LXT LX(TAG).d("name", m_name)
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.systemAudio.FileAudioInput");
+
+/// The format of the audio the Engine expects from an audio input
+static constexpr uint32_t SAMPLE_RATE = 16000;
+static constexpr uint16_t CHANNELS = 1;
+static constexpr uint16_t BITS_PER_SAMPLE = 16;
+
+/// The duration and the size of the fragments written to the Engine
+static constexpr std::chrono::milliseconds FRAGMENT_DURATION(10);
+static constexpr size_t FRAGMENT_SAMPLES = SAMPLE_RATE / 1000 * 10;
+
+/// The WAV format tags of integer LPCM
+static constexpr uint16_t WAVE_FORMAT_PCM = 0x0001;
+static constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+namespace {
+
+uint32_t readLittleEndian(std::istream& stream, int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(stream.get())) << (8 * i);
+    }
+    return value;
+}
+
+std::string readFourCC(std::istream& stream) {
+    char fourcc[4] = {0};
+    stream.read(fourcc, sizeof(fourcc));
+    return std::string(fourcc, stream.gcount());
+}
+
+}  // namespace
+
+FileAudioInput::FileAudioInput(std::string path, double speed, bool loop, std::string name) :
+        m_path(std::move(path)), m_speed(speed), m_loop(loop), m_name(std::move(name)) {
+}
+
+FileAudioInput::~FileAudioInput() {
+    stopAudioInput();
+}
+
+std::unique_ptr<FileAudioInput> FileAudioInput::create(
+    const std::string& path,
+    double speed,
+    bool loop,
+    const std::string& name) {
+    try {
+        ThrowIf(path.empty(), "invalidPath");
+        ThrowIfNot(speed > 0, "invalidSpeed");
+        auto audioInput = std::unique_ptr<FileAudioInput>(new FileAudioInput(path, speed, loop, name));
+        ThrowIfNot(audioInput->initialize(), "initializeFailed");
+        return audioInput;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("path", path));
+        return nullptr;
+    }
+}
+
+bool FileAudioInput::initialize() {
+    try {
+        m_file.open(m_path, std::ios::binary);
+        ThrowIfNot(m_file.is_open(), "openFileFailed");
+        m_file.seekg(0, std::ios::end);
+        auto fileSize = static_cast<std::streamoff>(m_file.tellg());
+        m_file.seekg(0);
+
+        // a file without the RIFF header is raw LPCM in the format of the Engine
+        if (readFourCC(m_file) != "RIFF") {
+            m_dataOffset = 0;
+            m_dataSize = fileSize;
+        } else {
+            readLittleEndian(m_file, 4);
+            ThrowIf(readFourCC(m_file) != "WAVE", "invalidWaveFile");
+            bool formatFound = false;
+            bool dataFound = false;
+            while (!dataFound && m_file.good()) {
+                auto chunkId = readFourCC(m_file);
+                std::streamoff chunkSize = readLittleEndian(m_file, 4);
+                ThrowIfNot(m_file.good(), "dataChunkNotFound");
+                auto chunkStart = static_cast<std::streamoff>(m_file.tellg());
+                if (chunkId == "fmt ") {
+                    auto format = readLittleEndian(m_file, 2);
+                    auto channels = readLittleEndian(m_file, 2);
+                    auto sampleRate = readLittleEndian(m_file, 4);
+                    // the byte rate and the block align follow from the other fields
+                    m_file.ignore(6);
+                    auto bitsPerSample = readLittleEndian(m_file, 2);
+                    ThrowIfNot(format == WAVE_FORMAT_PCM || format == WAVE_FORMAT_EXTENSIBLE, "unsupportedEncoding");
+                    ThrowIfNot(
+                        channels == CHANNELS && sampleRate == SAMPLE_RATE && bitsPerSample == BITS_PER_SAMPLE,
+                        "unsupportedFormat (expected 16 kHz 16-bit mono)");
+                    formatFound = true;
+                } else if (chunkId == "data") {
+                    ThrowIfNot(formatFound, "formatChunkNotFound");
+                    m_dataOffset = chunkStart;
+                    m_dataSize = std::min(chunkSize, fileSize - chunkStart);
+                    dataFound = true;
+                }
+                // the chunks are padded to an even size
+                m_file.seekg(chunkStart + chunkSize + (chunkSize & 1));
+            }
+            ThrowIfNot(dataFound, "dataChunkNotFound");
+        }
+        m_file.clear();
+
+        AACE_INFO(LXT.d("path", m_path)
+                      .d("duration", m_dataSize / (SAMPLE_RATE * BITS_PER_SAMPLE / 8 / 1000))
+                      .d("speed", m_speed)
+                      .d("loop", m_loop));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LXT.d("reason", ex.what()).d("path", m_path));
+        return false;
+    }
+}
+
+size_t FileAudioInput::readAudio(int16_t* buffer, size_t samples) {
+    size_t read = 0;
+    while (read < samples) {
+        auto remaining = m_dataSize - m_dataRead;
+        if (remaining < static_cast<std::streamoff>(sizeof(int16_t))) {
+            if (!m_loop || m_dataSize < static_cast<std::streamoff>(sizeof(int16_t))) {
+                break;
+            }
+            m_file.clear();
+            m_file.seekg(m_dataOffset);
+            m_dataRead = 0;
+            continue;
+        }
+        auto bytes = std::min<std::streamoff>((samples - read) * sizeof(int16_t), remaining & ~1);
+        m_file.read(reinterpret_cast<char*>(buffer + read), bytes);
+        auto count = m_file.gcount() & ~1;
+        if (count <= 0) {
+            // the file was truncated after it was opened
+            m_dataSize = m_dataRead;
+            continue;
+        }
+        m_dataRead += count;
+        read += count / sizeof(int16_t);
+    }
+    // the rest of the fragment is silence
+    std::fill(buffer + read, buffer + samples, 0);
+    return read;
+}
+
+void FileAudioInput::streamingLoop() {
+    aace::engine::utils::threading::ThreadPolicy::ScopedThread scopedThread("SystemAudio.FileAudioInput." + m_name);
+    auto start = std::chrono::steady_clock::now();
+    auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(FRAGMENT_DURATION.count() / m_speed));
+    auto next = start;
+    bool endOfFile = false;
+    int16_t buffer[FRAGMENT_SAMPLES];
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_streaming) {
+        lock.unlock();
+        if (readAudio(buffer, FRAGMENT_SAMPLES) < FRAGMENT_SAMPLES && !endOfFile) {
+            endOfFile = true;
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            AACE_INFO(LXT.m("end of file")
+                          .d("elapsed", std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()));
+        }
+        write(buffer, FRAGMENT_SAMPLES);
+        lock.lock();
+
+        // the fragments are scheduled from the start, so the rate does not drift with the time taken by a write
+        next += interval;
+        m_cvStreaming.wait_until(lock, next, [this] { return !m_streaming; });
+    }
+}
+
+//
+// aace::audio::AudioInput
+//
+
+bool FileAudioInput::startAudioInput() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    AACE_VERBOSE(LXT);
+    if (m_streaming) {
+        return true;
+    }
+    if (m_streamingThread.joinable()) {
+        // the thread of a stop from the input itself has not been joined
+        lock.unlock();
+        m_streamingThread.join();
+        lock.lock();
+    }
+    m_file.clear();
+    m_file.seekg(m_dataOffset);
+    m_dataRead = 0;
+    m_streaming = true;
+    m_streamingThread = std::thread(&FileAudioInput::streamingLoop, this);
+    return true;
+}
+
+bool FileAudioInput::stopAudioInput() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        AACE_VERBOSE(LXT);
+        m_streaming = false;
+    }
+    m_cvStreaming.notify_all();
+    if (m_streamingThread.joinable() && m_streamingThread.get_id() != std::this_thread::get_id()) {
+        m_streamingThread.join();
+    }
+    return true;
+}
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
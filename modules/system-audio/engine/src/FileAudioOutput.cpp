@@ -0,0 +1,442 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/SystemAudio/FileAudioOutput.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+#include <AACE/Audio/AudioFormat.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <iomanip>
+#include <sstream>
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+#define LXT LX(TAG).d("name", m_name)
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.systemAudio.FileAudioOutput");
+
+static constexpr size_t READ_BUFFER_SIZE = 4096;
+
+/// The maximum time the streaming thread waits for the stream before checking it is still streaming
+static constexpr std::chrono::milliseconds RETRY_INTERVAL(100);
+
+/// The size of the header of the WAV files, and the offsets of its size fields
+static constexpr std::streamoff WAVE_HEADER_SIZE = 44;
+static constexpr std::streamoff WAVE_RIFF_SIZE_OFFSET = 4;
+static constexpr std::streamoff WAVE_DATA_SIZE_OFFSET = 40;
+
+using MediaState = aace::audio::AudioOutput::MediaState;
+using MediaError = aace::audio::AudioOutput::MediaError;
+using Encoding = aace::audio::AudioFormat::Encoding;
+
+namespace json = aace::engine::utils::json;
+
+namespace {
+
+void writeLittleEndian(std::ostream& stream, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        stream.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void writeWaveHeader(std::ostream& stream, uint32_t sampleRate, uint16_t channels, uint16_t bitsPerSample) {
+    stream.write("RIFF", 4);
+    // the sizes are written when the file is flushed
+    writeLittleEndian(stream, 0, 4);
+    stream.write("WAVEfmt ", 8);
+    writeLittleEndian(stream, 16, 4);
+    writeLittleEndian(stream, 1, 2);
+    writeLittleEndian(stream, channels, 2);
+    writeLittleEndian(stream, sampleRate, 4);
+    writeLittleEndian(stream, sampleRate * channels * bitsPerSample / 8, 4);
+    writeLittleEndian(stream, channels * bitsPerSample / 8, 2);
+    writeLittleEndian(stream, bitsPerSample, 2);
+    stream.write("data", 4);
+    writeLittleEndian(stream, 0, 4);
+}
+
+int64_t now() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+std::string getExtension(Encoding encoding) {
+    switch (encoding) {
+        case Encoding::LPCM:
+            return ".wav";
+        case Encoding::MP3:
+            return ".mp3";
+        case Encoding::OPUS:
+            return ".opus";
+        default:
+            return ".bin";
+    }
+}
+
+}  // namespace
+
+FileAudioOutput::FileAudioOutput(std::string directory, double speed, std::string name) :
+        m_directory(std::move(directory)), m_speed(speed), m_name(std::move(name)) {
+}
+
+FileAudioOutput::~FileAudioOutput() {
+    m_executor.submit([this] { executeClose(); });
+    m_executor.waitForSubmittedTasks();
+}
+
+std::unique_ptr<FileAudioOutput> FileAudioOutput::create(
+    const std::string& directory,
+    double speed,
+    const std::string& name) {
+    try {
+        ThrowIf(directory.empty(), "invalidDirectory");
+        ThrowIfNot(speed > 0, "invalidSpeed");
+        ThrowIf(mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST, "createDirectoryFailed");
+        return std::unique_ptr<FileAudioOutput>(new FileAudioOutput(directory, speed, name));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("directory", directory));
+        return nullptr;
+    }
+}
+
+void FileAudioOutput::recordEvent(const std::string& event, const json::Value& value) {
+    json::Value entry = {{"event", event}, {"time", now()}, {"position", m_position.load()}};
+    if (!value.is_null()) {
+        entry["value"] = value;
+    }
+    std::lock_guard<std::mutex> lock(m_metadataMutex);
+    m_metadata["events"].push_back(entry);
+}
+
+void FileAudioOutput::flushFiles() {
+    if (m_path.empty()) {
+        return;
+    }
+    if (m_file.is_open()) {
+        if (m_wave) {
+            auto dataSize = static_cast<uint32_t>(m_bytesWritten.load());
+            m_file.seekp(WAVE_RIFF_SIZE_OFFSET);
+            writeLittleEndian(m_file, dataSize + WAVE_HEADER_SIZE - 8, 4);
+            m_file.seekp(WAVE_DATA_SIZE_OFFSET);
+            writeLittleEndian(m_file, dataSize, 4);
+            m_file.seekp(0, std::ios::end);
+        }
+        m_file.flush();
+    }
+
+    std::lock_guard<std::mutex> lock(m_metadataMutex);
+    m_metadata["bytes"] = m_bytesWritten.load();
+    std::ofstream metadata(m_path + ".json", std::ios::trunc);
+    metadata << m_metadata.dump(2);
+    if (metadata.fail()) {
+        AACE_ERROR(LXT.d("reason", "writeMetadataFailed").d("path", m_path));
+    }
+}
+
+void FileAudioOutput::startStreaming() {
+    if (m_streamingThread.joinable()) {
+        return;
+    }
+    m_streaming = true;
+    m_streamingThread = std::thread(&FileAudioOutput::streamingLoop, this, m_mediaCount);
+}
+
+void FileAudioOutput::stopStreaming() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_streaming = false;
+    }
+    m_cvStreaming.notify_all();
+    if (m_streamingThread.joinable()) {
+        m_streamingThread.join();
+    }
+}
+
+void FileAudioOutput::streamingLoop(int media) {
+    aace::engine::utils::threading::ThreadPolicy::ScopedThread scopedThread("SystemAudio.FileAudioOutput." + m_name);
+    auto startTime = std::chrono::steady_clock::now();
+    auto startPosition = m_position.load();
+    int64_t bytesRead = 0;
+    bool endOfStream = false;
+    char buffer[READ_BUFFER_SIZE];
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_streaming) {
+        if (endOfStream) {
+            // a repeating media, such as an alarm, sounds until it is stopped
+            m_cvStreaming.wait(lock, [this] { return !m_streaming; });
+            break;
+        }
+        lock.unlock();
+        auto size = m_stream->timedRead(buffer, READ_BUFFER_SIZE, RETRY_INTERVAL);
+        if (size < 0) {
+            AACE_ERROR(LXT.d("reason", "readFromStreamFailed"));
+            m_executor.submit([this, media] {
+                if (media == m_mediaCount && m_playing) {
+                    m_playing = false;
+                    recordEvent("error");
+                    mediaError(MediaError::MEDIA_ERROR_INTERNAL_DEVICE_ERROR, "readFromStreamFailed");
+                }
+            });
+            return;
+        }
+        if (size == 0 && m_stream->isClosed()) {
+            endOfStream = true;
+            recordEvent("endOfStream");
+            if (!m_repeating) {
+                m_executor.submit([this, media] { executeFinished(media); });
+                return;
+            }
+            lock.lock();
+            continue;
+        }
+        if (size > 0) {
+            if (m_bytesWritten == 0) {
+                recordEvent("firstAudio");
+            }
+            m_file.write(buffer, size);
+            m_bytesWritten += size;
+            bytesRead += size;
+        }
+
+        // the LPCM audio is consumed at the rate it would be played, and the other audio as it is read
+        std::chrono::steady_clock::time_point due;
+        if (m_bytesPerSecond > 0) {
+            auto played = bytesRead * 1000 / m_bytesPerSecond;
+            m_position = startPosition + played;
+            due = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                  std::chrono::duration<double, std::milli>(played / m_speed));
+        } else {
+            auto elapsed = std::chrono::steady_clock::now() - startTime;
+            m_position = startPosition + std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+            due = std::chrono::steady_clock::now();
+        }
+        lock.lock();
+        m_cvStreaming.wait_until(lock, due, [this] { return !m_streaming; });
+    }
+}
+
+//
+// aace::audio::AudioOutput
+//
+
+bool FileAudioOutput::prepare(std::shared_ptr<aace::audio::AudioStream> stream, bool repeating) {
+    return m_executor
+        .submit([this, stream, repeating] {
+            m_repeating = repeating;
+            return executePrepare(stream, "");
+        })
+        .get();
+}
+
+bool FileAudioOutput::prepare(const std::string& url, bool repeating) {
+    return m_executor
+        .submit([this, url, repeating] {
+            m_repeating = repeating;
+            return executePrepare(nullptr, url);
+        })
+        .get();
+}
+
+bool FileAudioOutput::executePrepare(const std::shared_ptr<aace::audio::AudioStream>& stream, const std::string& url) {
+    try {
+        executeClose();
+        m_mediaCount++;
+        m_stream = stream;
+        m_url = url;
+        m_bytesWritten = 0;
+        m_position = 0;
+        m_bytesPerSecond = 0;
+
+        std::stringstream ss;
+        ss << m_directory << '/' << (m_name.empty() ? "audio" : m_name) << '-' << std::setw(4) << std::setfill('0')
+           << m_mediaCount;
+        json::Value metadata = {{"name", m_name}, {"repeating", m_repeating}, {"events", json::Value::array()}};
+        if (m_stream) {
+            auto format = m_stream->getAudioFormat();
+            auto encoding = m_stream->getEncoding();
+            m_wave = encoding == Encoding::LPCM;
+            m_path = ss.str() + getExtension(encoding);
+            m_file.open(m_path, std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+            ThrowIfNot(m_file.is_open(), "openFileFailed");
+
+            std::stringstream encodingName;
+            encodingName << encoding;
+            metadata["encoding"] = encodingName.str();
+            if (m_wave) {
+                uint16_t bitsPerSample = format.getSampleSize() > 0 ? format.getSampleSize() : 16;
+                uint16_t channels = format.getNumChannels() > 0 ? format.getNumChannels() : 1;
+                ThrowIf(format.getSampleRate() == 0, "unknownSampleRate");
+                writeWaveHeader(m_file, format.getSampleRate(), channels, bitsPerSample);
+                m_bytesPerSecond = format.getSampleRate() * channels * bitsPerSample / 8;
+                metadata["sampleRate"] = format.getSampleRate();
+                metadata["channels"] = channels;
+                metadata["sampleSize"] = bitsPerSample;
+            }
+        } else {
+            // the audio of a URL is not downloaded, only its timing is recorded
+            m_wave = false;
+            m_path = ss.str() + ".url";
+            metadata["url"] = m_url;
+        }
+        metadata["file"] = m_path;
+        {
+            std::lock_guard<std::mutex> lock(m_metadataMutex);
+            m_metadata = metadata;
+        }
+        recordEvent("prepare");
+
+        AACE_VERBOSE(LXT.d("path", m_path));
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LXT.d("reason", ex.what()).d("path", m_path));
+        m_stream.reset();
+        m_path.clear();
+        return false;
+    }
+}
+
+void FileAudioOutput::mayDuck() {
+    m_executor.submit([this] { recordEvent("mayDuck"); });
+}
+
+bool FileAudioOutput::play() {
+    m_executor.submit([this] { return executeStart("play"); });
+    return true;
+}
+
+bool FileAudioOutput::resume() {
+    m_executor.submit([this] { return executeStart("resume"); });
+    return true;
+}
+
+bool FileAudioOutput::executeStart(const std::string& event) {
+    AACE_VERBOSE(LXT.d("event", event));
+    if (m_path.empty()) {
+        AACE_ERROR(LXT.d("reason", "notPrepared"));
+        return false;
+    }
+    if (m_playing) {
+        AACE_WARN(LXT.m("already started"));
+        return false;
+    }
+    m_playing = true;
+    recordEvent(event);
+    mediaStateChanged(MediaState::PLAYING);
+    if (m_stream) {
+        startStreaming();
+    } else if (!m_repeating) {
+        executeFinished(m_mediaCount);
+    }
+    return true;
+}
+
+bool FileAudioOutput::stop() {
+    m_executor.submit([this] { return executeStop("stop"); });
+    return true;
+}
+
+bool FileAudioOutput::pause() {
+    m_executor.submit([this] { return executeStop("pause"); });
+    return true;
+}
+
+bool FileAudioOutput::executeStop(const std::string& event) {
+    AACE_VERBOSE(LXT.d("event", event));
+    if (!m_playing) {
+        AACE_WARN(LXT.m("already stopped"));
+        return false;
+    }
+    stopStreaming();
+    m_playing = false;
+    recordEvent(event);
+    flushFiles();
+    mediaStateChanged(MediaState::STOPPED);
+    return true;
+}
+
+void FileAudioOutput::executeFinished(int media) {
+    // the media finished after it was stopped or replaced
+    if (media != m_mediaCount || !m_playing) {
+        return;
+    }
+    stopStreaming();
+    m_playing = false;
+    recordEvent("finished");
+    flushFiles();
+    AACE_VERBOSE(LXT.m("finished").d("path", m_path).d("bytes", m_bytesWritten.load()));
+    mediaStateChanged(MediaState::STOPPED);
+}
+
+void FileAudioOutput::executeClose() {
+    stopStreaming();
+    if (m_playing) {
+        m_playing = false;
+        recordEvent("close");
+    }
+    flushFiles();
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+    m_stream.reset();
+    m_path.clear();
+}
+
+bool FileAudioOutput::startDucking() {
+    m_executor.submit([this] { recordEvent("startDucking"); });
+    return true;
+}
+
+bool FileAudioOutput::stopDucking() {
+    m_executor.submit([this] { recordEvent("stopDucking"); });
+    return true;
+}
+
+int64_t FileAudioOutput::getPosition() {
+    return m_position;
+}
+
+bool FileAudioOutput::setPosition(int64_t position) {
+    return m_executor
+        .submit([this, position] {
+            // a stream cannot seek, the position of the following audio is offset instead
+            m_position = position;
+            recordEvent("setPosition", position);
+            return true;
+        })
+        .get();
+}
+
+int64_t FileAudioOutput::getDuration() {
+    return TIME_UNKNOWN;
+}
+
+bool FileAudioOutput::volumeChanged(float volume) {
+    m_executor.submit([this, volume] { recordEvent("volumeChanged", volume); });
+    return true;
+}
+
+bool FileAudioOutput::mutedStateChanged(MutedState state) {
+    m_executor.submit([this, state] { recordEvent("mutedStateChanged", state == MutedState::MUTED); });
+    return true;
+}
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,599 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/SystemAudio/MediaCache.h>
+#include <AACE/Engine/SystemAudio/PlaylistResolver.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Threading/ThreadPolicy.h>
+#include <AVSCommon/Utils/LibcurlUtils/CurlEasyHandleWrapper.h>
+#include "curl/curl.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <regex>
+#include <sstream>
+#include <vector>
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+// String to identify log entries originating from this file.
+static const char* TAG("aace.systemAudio.MediaCache");
+
+/// The suffixes of the files of a media: its data, and its URL and size
+static const std::string DATA_SUFFIX = ".data";
+static const std::string METADATA_SUFFIX = ".meta";
+
+/// The maximum time to connect to the server of a media
+static const auto CONNECTION_TIMEOUT = std::chrono::seconds(10);
+
+/// The time without data after which a download is abandoned, to be resumed later
+static const long STALL_TIMEOUT_SECONDS = 30;
+
+/// The minimum time between the downloads of a media resumed for a stream waiting for its data
+static const auto RESUME_INTERVAL = std::chrono::seconds(1);
+
+/// The failed downloads without progress after which the streams of a media fail
+static const int MAX_FAILURES = 3;
+
+static const long HTTP_OK = 200;
+static const long HTTP_PARTIAL_CONTENT = 206;
+static const long HTTP_BAD_REQUEST = 400;
+static const long HTTP_INTERNAL_SERVER_ERROR = 500;
+
+constexpr uint64_t MediaCache::DEFAULT_MAX_SIZE;
+constexpr uint64_t MediaCache::DEFAULT_MAX_ENTRY_SIZE;
+constexpr std::chrono::seconds MediaCache::DEFAULT_OPEN_TIMEOUT;
+
+using alexaClientSDK::avsCommon::utils::libcurlUtils::CurlEasyHandleWrapper;
+
+/// The state of a download, shared with the libcurl callbacks
+struct MediaCache::Download {
+    MediaCache* cache;
+    std::shared_ptr<Entry> entry;
+    CurlEasyHandleWrapper* curl;
+    // the offset of the requested range
+    uint64_t offset;
+    // the data file, opened when the response starts
+    int fd;
+    long responseCode;
+};
+
+//
+// MediaCache::Stream
+//
+
+MediaCache::Stream::Stream(std::shared_ptr<MediaCache> cache, std::shared_ptr<Entry> entry, int fd) :
+        m_cache(std::move(cache)), m_entry(std::move(entry)), m_fd(fd) {
+}
+
+MediaCache::Stream::~Stream() {
+    ::close(m_fd);
+    m_cache->release(m_entry);
+}
+
+ssize_t MediaCache::Stream::read(char* data, const size_t size) {
+    return timedRead(data, size, std::chrono::milliseconds(0));
+}
+
+ssize_t MediaCache::Stream::timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) {
+    std::lock_guard<std::mutex> streamLock(m_mutex);
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    uint64_t available;
+    {
+        std::unique_lock<std::mutex> lock(m_cache->m_mutex);
+        auto& entry = *m_entry;
+        while (true) {
+            if (m_cache->m_shutdown || m_position >= entry.size) {
+                return 0;
+            }
+            if (entry.downloaded > m_position) {
+                break;
+            }
+            auto now = std::chrono::steady_clock::now();
+            auto wakeup = deadline;
+            if (!entry.downloading) {
+                if (entry.invalid || entry.failures >= MAX_FAILURES) {
+                    AACE_ERROR(LX(TAG).d("reason", "downloadFailed").d("failures", entry.failures));
+                    return -1;
+                }
+                // resume the interrupted download, at most once per resume interval
+                if (now - entry.lastAttempt >= RESUME_INTERVAL) {
+                    m_cache->startDownloadLocked(m_entry);
+                } else {
+                    wakeup = std::min(deadline, entry.lastAttempt + RESUME_INTERVAL);
+                }
+            }
+            if (now >= deadline) {
+                return 0;
+            }
+            m_cache->m_cvDownload.wait_until(lock, wakeup);
+        }
+        available = entry.downloaded - m_position;
+    }
+
+    // the downloaded data is not written again, so it is read without the lock
+    auto count = ::pread(m_fd, data, std::min<uint64_t>(size, available), m_position);
+    if (count < 0) {
+        AACE_ERROR(LX(TAG).d("reason", "readFailed").d("errno", errno));
+        return -1;
+    }
+    m_position += count;
+    return count;
+}
+
+bool MediaCache::Stream::isClosed() {
+    std::lock_guard<std::mutex> streamLock(m_mutex);
+    std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+    auto& entry = *m_entry;
+    if (m_cache->m_shutdown || m_position >= entry.size) {
+        return true;
+    }
+    return !entry.downloading && m_position >= entry.downloaded &&
+           (entry.invalid || entry.failures >= MAX_FAILURES);
+}
+
+uint64_t MediaCache::Stream::getSize() {
+    std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+    return m_entry->size;
+}
+
+bool MediaCache::Stream::seek(uint64_t offset) {
+    std::lock_guard<std::mutex> streamLock(m_mutex);
+    std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+    if (offset > m_entry->size) {
+        AACE_ERROR(LX(TAG).d("reason", "invalidOffset").d("offset", offset).d("size", m_entry->size));
+        return false;
+    }
+    m_position = offset;
+    return true;
+}
+
+//
+// MediaCache
+//
+
+MediaCache::MediaCache(const Config& config) : m_config(config) {
+}
+
+MediaCache::~MediaCache() {
+    shutdown();
+}
+
+std::shared_ptr<MediaCache> MediaCache::create(const Config& config) {
+    try {
+        ThrowIf(config.path.empty(), "invalidPath");
+        ThrowIf(config.maxSize == 0, "invalidMaxSize");
+        ThrowIf(config.maxEntrySize == 0 || config.maxEntrySize > config.maxSize, "invalidMaxEntrySize");
+        ThrowIf(::mkdir(config.path.c_str(), 0700) != 0 && errno != EEXIST, "createDirectoryFailed");
+
+        auto cache = std::shared_ptr<MediaCache>(new MediaCache(config));
+        cache->loadEntries();
+
+        return cache;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("path", config.path));
+        return nullptr;
+    }
+}
+
+bool MediaCache::isCacheableUrl(const std::string& url) {
+    // the adaptive streaming manifests reference the URLs of their segments, so they are played from the network
+    static const std::regex regex_http(R"(^(http|https):\/\/.+)", std::regex::optimize | std::regex::icase);
+    static const std::regex regex_manifest(
+        R"(^[^?]+\.(m3u8|mpd)(\?.*)?$)", std::regex::optimize | std::regex::icase);
+    return std::regex_match(url, regex_http) && !std::regex_match(url, regex_manifest) &&
+           !PlaylistResolver::isPlaylistUrl(url);
+}
+
+void MediaCache::loadEntries() {
+    DIR* dir = ::opendir(m_config.path.c_str());
+    if (dir == nullptr) {
+        AACE_ERROR(LX(TAG).d("reason", "openDirectoryFailed").d("path", m_config.path));
+        return;
+    }
+
+    // load the media with a complete metadata file, and remove the other files
+    std::vector<std::pair<time_t, std::shared_ptr<Entry>>> entries;
+    std::vector<std::string> orphans;
+    while (auto item = ::readdir(dir)) {
+        std::string name = item->d_name;
+        if (name.size() > DATA_SUFFIX.size() &&
+            name.compare(name.size() - DATA_SUFFIX.size(), DATA_SUFFIX.size(), DATA_SUFFIX) == 0) {
+            struct stat metadata;
+            auto key = name.substr(0, name.size() - DATA_SUFFIX.size());
+            if (::stat(getMetadataPath(key).c_str(), &metadata) != 0) {
+                orphans.push_back(getDataPath(key));
+            }
+            continue;
+        }
+        if (name.size() <= METADATA_SUFFIX.size() ||
+            name.compare(name.size() - METADATA_SUFFIX.size(), METADATA_SUFFIX.size(), METADATA_SUFFIX) != 0) {
+            continue;
+        }
+
+        auto entry = std::make_shared<Entry>();
+        entry->key = name.substr(0, name.size() - METADATA_SUFFIX.size());
+        std::ifstream metadata(getMetadataPath(entry->key));
+        std::getline(metadata, entry->url);
+        metadata >> entry->size;
+        struct stat data;
+        if (metadata.fail() || entry->url.empty() || getKey(entry->url) != entry->key || entry->size == 0 ||
+            entry->size > m_config.maxEntrySize || ::stat(getDataPath(entry->key).c_str(), &data) != 0 ||
+            static_cast<uint64_t>(data.st_size) > entry->size) {
+            orphans.push_back(getMetadataPath(entry->key));
+            orphans.push_back(getDataPath(entry->key));
+            continue;
+        }
+        entry->downloaded = data.st_size;
+        entries.emplace_back(data.st_mtime, entry);
+    }
+    ::closedir(dir);
+
+    for (auto& path : orphans) {
+        std::remove(path.c_str());
+    }
+
+    // the most recently accessed media first
+    std::sort(entries.begin(), entries.end(), [](const std::pair<time_t, std::shared_ptr<Entry>>& a,
+                                                 const std::pair<time_t, std::shared_ptr<Entry>>& b) {
+        return a.first > b.first;
+    });
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& item : entries) {
+        auto& entry = item.second;
+        if (m_reserved + entry->size > m_config.maxSize) {
+            // the cache was reduced since the media was downloaded
+            std::remove(getMetadataPath(entry->key).c_str());
+            std::remove(getDataPath(entry->key).c_str());
+            continue;
+        }
+        m_reserved += entry->size;
+        entry->lru = m_lru.insert(m_lru.end(), entry->key);
+        m_entries[entry->key] = entry;
+    }
+    AACE_INFO(LX(TAG).d("entries", m_entries.size()).d("size", m_reserved));
+}
+
+std::shared_ptr<MediaCache::Stream> MediaCache::open(const std::string& url, std::chrono::milliseconds timeout) {
+    try {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ThrowIf(m_shutdown, "cacheShutdown");
+
+        auto key = getKey(url);
+        std::shared_ptr<Entry> entry;
+        auto it = m_entries.find(key);
+        if (it != m_entries.end() && it->second->url == url) {
+            entry = it->second;
+            ThrowIf(entry->invalid, "mediaNotCacheable");
+            m_lru.splice(m_lru.begin(), m_lru, entry->lru);
+        } else {
+            if (it != m_entries.end()) {
+                // another URL with the same key, which is replaced unless it is played
+                ThrowIf(it->second->readers > 0 || it->second->downloading, "keyInUse");
+                removeLocked(key);
+            }
+            entry = std::make_shared<Entry>();
+            entry->url = url;
+            entry->key = key;
+            entry->lru = m_lru.insert(m_lru.begin(), key);
+            m_entries[key] = entry;
+        }
+
+        // a new stream retries the downloads that failed
+        entry->failures = 0;
+        if ((entry->size == 0 || entry->downloaded < entry->size) && !entry->downloading) {
+            startDownloadLocked(entry);
+        }
+
+        // wait for the response of the first download, which gives the size of the media
+        m_cvDownload.wait_for(lock, timeout, [this, &entry]() {
+            return m_shutdown || entry->size > 0 || entry->invalid || !entry->downloading;
+        });
+        ThrowIf(m_shutdown, "cacheShutdown");
+        ThrowIf(entry->invalid, "mediaNotCacheable");
+        if (entry->size == 0) {
+            entry->aborted = true;
+            Throw(entry->downloading ? "openTimeout" : "downloadFailed");
+        }
+
+        // the modification time of the data file records the last access to the media
+        auto path = getDataPath(key);
+        int fd = ::open(path.c_str(), O_RDONLY | O_CREAT, 0600);
+        ThrowIf(fd < 0, "openDataFileFailed");
+        ::utime(path.c_str(), nullptr);
+        entry->readers++;
+
+        AACE_DEBUG(LX(TAG).sensitive("url", url).d("size", entry->size).d("downloaded", entry->downloaded));
+        return std::shared_ptr<Stream>(new Stream(shared_from_this(), entry, fd));
+    } catch (std::exception& ex) {
+        AACE_WARN(LX(TAG).d("reason", ex.what()).sensitive("url", url));
+        return nullptr;
+    }
+}
+
+void MediaCache::release(const std::shared_ptr<Entry>& entry) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--entry->readers > 0) {
+        return;
+    }
+    // the download of a media that is no longer played resumes when it is played again
+    entry->aborted = true;
+    auto it = m_entries.find(entry->key);
+    if (entry->invalid && !entry->downloading && it != m_entries.end() && it->second == entry) {
+        removeLocked(entry->key);
+    }
+}
+
+void MediaCache::startDownloadLocked(const std::shared_ptr<Entry>& entry) {
+    if (m_shutdown) {
+        return;
+    }
+    // the previous download of the media has ended
+    if (entry->thread.joinable()) {
+        entry->thread.join();
+    }
+    entry->downloading = true;
+    entry->aborted = false;
+    entry->lastAttempt = std::chrono::steady_clock::now();
+    entry->thread = std::thread(&MediaCache::download, this, entry);
+}
+
+void MediaCache::download(std::shared_ptr<Entry> entry) {
+    aace::engine::utils::threading::ThreadPolicy::ScopedThread scopedThread("SystemAudio.MediaCache");
+    std::string url;
+    uint64_t downloaded = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        url = entry->url;
+        downloaded = entry->downloaded;
+    }
+
+    CurlEasyHandleWrapper curl;
+    Download download{this, entry, &curl, downloaded, -1, 0};
+    try {
+        AACE_DEBUG(LX(TAG).sensitive("url", url).d("offset", download.offset));
+        ThrowIfNot(curl.setURL(url), "setURLFailed");
+        if (download.offset > 0) {
+            auto range = "Range: bytes=" + std::to_string(download.offset) + "-";
+            ThrowIfNot(curl.addHTTPHeader(range), "addHTTPHeaderFailed");
+        }
+        ThrowIfNot(curl.setConnectionTimeout(CONNECTION_TIMEOUT), "setConnectionTimeoutFailed");
+        ThrowIfNot(
+            curl.setWriteCallback(
+                [](char* buffer, size_t blockSize, size_t numBlocks, void* userData) -> size_t {
+                    auto download = static_cast<Download*>(userData);
+                    return download->cache->writeData(*download, buffer, blockSize * numBlocks);
+                },
+                &download),
+            "setWriteCallbackFailed");
+
+        // the progress callback stops an aborted download while it waits for data, and a stalled download is
+        // abandoned to be resumed later
+        auto handle = curl.getCurlHandle();
+        curl_xferinfo_callback progress = [](void* userData, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+            auto download = static_cast<Download*>(userData);
+            return download->cache->isAborted(download->entry) ? 1 : 0;
+        };
+        ThrowIf(
+            curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L) != CURLE_OK ||
+                curl_easy_setopt(handle, CURLOPT_LOW_SPEED_LIMIT, 1L) != CURLE_OK ||
+                curl_easy_setopt(handle, CURLOPT_LOW_SPEED_TIME, STALL_TIMEOUT_SECONDS) != CURLE_OK ||
+                curl_easy_setopt(handle, CURLOPT_XFERINFOFUNCTION, progress) != CURLE_OK ||
+                curl_easy_setopt(handle, CURLOPT_XFERINFODATA, &download) != CURLE_OK ||
+                curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 0L) != CURLE_OK,
+            "setOptionFailed");
+
+        auto result = curl.perform();
+        if (download.responseCode == 0) {
+            download.responseCode = curl.getHTTPResponseCode();
+        }
+        ThrowIf(result != CURLE_OK && !isAborted(entry), curl_easy_strerror(result));
+    } catch (std::exception& ex) {
+        AACE_WARN(LX(TAG).d("reason", ex.what()).d("responseCode", download.responseCode));
+    }
+    if (download.fd >= 0) {
+        ::close(download.fd);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (download.responseCode >= HTTP_BAD_REQUEST && download.responseCode < HTTP_INTERNAL_SERVER_ERROR) {
+        // the client errors are not resolved by resuming the download
+        entry->invalid = true;
+    }
+    if (entry->size == 0 || entry->downloaded < entry->size) {
+        entry->failures++;
+    }
+    entry->downloading = false;
+    AACE_DEBUG(LX(TAG)
+                   .d("size", entry->size)
+                   .d("downloaded", entry->downloaded)
+                   .d("failures", entry->failures)
+                   .d("invalid", entry->invalid));
+    m_cvDownload.notify_all();
+}
+
+size_t MediaCache::writeData(Download& download, const char* data, size_t size) {
+    auto& entry = download.entry;
+    if (download.fd < 0) {
+        // the response starts, restarting from the start of the media if the server ignored the range
+        download.responseCode = download.curl->getHTTPResponseCode();
+        curl_off_t length = -1;
+        curl_easy_getinfo(download.curl->getCurlHandle(), CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+        if (download.responseCode == HTTP_OK) {
+            download.offset = 0;
+        } else if (download.responseCode != HTTP_PARTIAL_CONTENT) {
+            AACE_WARN(LX(TAG).d("reason", "unexpectedResponse").d("responseCode", download.responseCode));
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_shutdown || entry->aborted) {
+            return 0;
+        }
+        if (length < 0) {
+            AACE_WARN(LX(TAG).d("reason", "unknownSize"));
+            entry->invalid = true;
+            return 0;
+        }
+        auto size = download.offset + static_cast<uint64_t>(length);
+        if (entry->size == 0) {
+            if (!reserveLocked(entry, size)) {
+                AACE_WARN(LX(TAG).d("reason", "mediaTooLarge").d("size", size));
+                entry->invalid = true;
+                return 0;
+            }
+            entry->size = size;
+            if (!writeMetadata(*entry)) {
+                entry->invalid = true;
+                return 0;
+            }
+        } else if (entry->size != size) {
+            AACE_WARN(LX(TAG).d("reason", "mediaChanged").d("size", size).d("expected", entry->size));
+            entry->invalid = true;
+            return 0;
+        }
+
+        download.fd = ::open(getDataPath(entry->key).c_str(), O_WRONLY | O_CREAT, 0600);
+        if (download.fd < 0 || ::ftruncate(download.fd, download.offset) != 0 ||
+            ::lseek(download.fd, download.offset, SEEK_SET) < 0) {
+            AACE_ERROR(LX(TAG).d("reason", "openDataFileFailed").d("errno", errno));
+            return 0;
+        }
+        entry->downloaded = download.offset;
+        m_cvDownload.notify_all();
+    }
+
+    if (isAborted(entry)) {
+        return 0;
+    }
+    for (size_t written = 0; written < size;) {
+        auto count = ::write(download.fd, data + written, size - written);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            AACE_ERROR(LX(TAG).d("reason", "writeDataFileFailed").d("errno", errno));
+            return 0;
+        }
+        written += count;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    entry->downloaded = std::min(entry->downloaded + size, entry->size);
+    entry->failures = 0;
+    m_cvDownload.notify_all();
+    return size;
+}
+
+bool MediaCache::isAborted(const std::shared_ptr<Entry>& entry) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_shutdown || entry->aborted || entry->invalid;
+}
+
+bool MediaCache::reserveLocked(const std::shared_ptr<Entry>& entry, uint64_t size) {
+    if (size > m_config.maxEntrySize) {
+        return false;
+    }
+
+    // evict the least recently used media that are not played or downloaded
+    auto it = m_lru.end();
+    while (m_reserved + size > m_config.maxSize && it != m_lru.begin()) {
+        auto candidate = m_entries[*--it];
+        if (candidate != entry && candidate->readers == 0 && !candidate->downloading) {
+            it = std::next(it);
+            AACE_DEBUG(LX(TAG).m("evicted").d("key", candidate->key).d("size", candidate->size));
+            removeLocked(candidate->key);
+        }
+    }
+    if (m_reserved + size > m_config.maxSize) {
+        return false;
+    }
+    m_reserved += size;
+    return true;
+}
+
+void MediaCache::removeLocked(const std::string& key) {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+    auto entry = it->second;
+    if (entry->thread.joinable()) {
+        entry->thread.join();
+    }
+    m_reserved -= entry->size;
+    m_lru.erase(entry->lru);
+    m_entries.erase(it);
+    std::remove(getDataPath(key).c_str());
+    std::remove(getMetadataPath(key).c_str());
+}
+
+bool MediaCache::writeMetadata(const Entry& entry) {
+    std::ofstream metadata(getMetadataPath(entry.key), std::ios::trunc);
+    metadata << entry.url << '\n' << entry.size << '\n';
+    metadata.close();
+    if (metadata.fail()) {
+        AACE_ERROR(LX(TAG).d("reason", "writeMetadataFailed").d("key", entry.key));
+        return false;
+    }
+    return true;
+}
+
+void MediaCache::shutdown() {
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+        for (auto& item : m_entries) {
+            if (item.second->thread.joinable()) {
+                threads.push_back(std::move(item.second->thread));
+            }
+        }
+    }
+    m_cvDownload.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+std::string MediaCache::getDataPath(const std::string& key) {
+    return m_config.path + "/" + key + DATA_SUFFIX;
+}
+
+std::string MediaCache::getMetadataPath(const std::string& key) {
+    return m_config.path + "/" + key + METADATA_SUFFIX;
+}
+
+std::string MediaCache::getKey(const std::string& url) {
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>()(url);
+    return key.str();
+}
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
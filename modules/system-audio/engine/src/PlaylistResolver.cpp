@@ -0,0 +1,223 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AACE/Engine/SystemAudio/PlaylistResolver.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+
+#include <regex>
+#include <stdexcept>
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+// String to identify log entries originating from this file.
+static const char* TAG("aace.systemAudio.PlaylistResolver");
+
+/// The maximum time to wait for a playlist to be parsed
+static const auto PLAYLIST_TIMEOUT = std::chrono::seconds(10);
+
+constexpr size_t PlaylistResolver::DEFAULT_CAPACITY;
+constexpr std::chrono::seconds PlaylistResolver::DEFAULT_TTL;
+
+using alexaClientSDK::avsCommon::utils::libcurlUtils::HTTPContentFetcherFactory;
+using alexaClientSDK::avsCommon::utils::playlistParser::PlaylistEntry;
+using alexaClientSDK::avsCommon::utils::playlistParser::PlaylistParseResult;
+using alexaClientSDK::avsCommon::utils::playlistParser::PlaylistParserObserverInterface;
+using alexaClientSDK::playlistParser::PlaylistParser;
+
+struct PlaylistParserObserver : public PlaylistParserObserverInterface {
+    std::vector<std::string> entries;
+    std::promise<std::vector<std::string>> promise;
+    std::promise<std::vector<std::string>> fallbackPromise;
+    void onPlaylistEntryParsed(int requestId, PlaylistEntry playlistEntry) override {
+        if (playlistEntry.parseResult == PlaylistParseResult::STILL_ONGOING) {
+            entries.emplace_back(playlistEntry.url);
+            if (entries.size() == 1) {
+                // We got the first entry. Use it as the fallback solution.
+                fallbackPromise.set_value(entries);
+            }
+        } else if (playlistEntry.parseResult == PlaylistParseResult::FINISHED) {
+            entries.emplace_back(playlistEntry.url);
+            promise.set_value(entries);
+        } else if (playlistEntry.parseResult == PlaylistParseResult::ERROR) {
+            if (entries.empty()) {
+                try {
+                    throw std::runtime_error("error occurred while parsing playlist");
+                } catch (...) {
+                    // store anything thrown in the promise
+                    promise.set_exception(std::current_exception());
+                }
+            } else {
+                // We got some entries. Ignore the final error result.
+                promise.set_value(entries);
+            }
+        }
+    }
+};
+
+PlaylistResolver::PlaylistResolver(size_t capacity, std::chrono::seconds ttl) : m_capacity(capacity), m_ttl(ttl) {
+}
+
+PlaylistResolver::~PlaylistResolver() {
+    shutdown();
+}
+
+std::shared_ptr<PlaylistResolver> PlaylistResolver::create(size_t capacity, std::chrono::seconds ttl) {
+    try {
+        ThrowIf(capacity == 0, "invalidCapacity");
+
+        auto resolver = std::shared_ptr<PlaylistResolver>(new PlaylistResolver(capacity, ttl));
+        resolver->m_fetcherFactory = std::make_shared<HTTPContentFetcherFactory>();
+        resolver->m_parser = PlaylistParser::create(resolver->m_fetcherFactory);
+        ThrowIfNull(resolver->m_parser, "createPlaylistParserFailed");
+
+        return resolver;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+bool PlaylistResolver::isPlaylistUrl(const std::string& url) {
+    static const std::regex regex_playlist(
+        R"(^(http|https):\/\/.+\.(ashx|m3u|pls)(\?.*)?$)", std::regex::optimize | std::regex::icase);
+    return std::regex_match(url, regex_playlist);
+}
+
+std::shared_future<PlaylistResolver::Entries> PlaylistResolver::resolve(const std::string& url) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_parser) {
+        // the resolver is shut down, so the URL is played as it is
+        std::promise<Entries> promise;
+        promise.set_value({url});
+        return promise.get_future().share();
+    }
+
+    auto it = m_cache.find(url);
+    if (it != m_cache.end()) {
+        if (std::chrono::steady_clock::now() < it->second.expiry) {
+            AACE_DEBUG(LX(TAG).m("cached").sensitive("url", url));
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+            return it->second.entries;
+        }
+        m_lru.erase(it->second.lru);
+        m_cache.erase(it);
+    }
+
+    // evict the least recently used playlists
+    while (m_cache.size() >= m_capacity) {
+        m_cache.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+
+    // the resolution can't complete before it is cached, since it locks the cache to record its result
+    auto id = ++m_nextId;
+    auto entries = m_executor.submit([this, url, id] { return executeResolve(url, id); }).share();
+    m_lru.push_front(url);
+    m_cache[url] = CacheEntry{entries, std::chrono::steady_clock::time_point::max(), m_lru.begin(), id};
+
+    return entries;
+}
+
+PlaylistResolver::Entries PlaylistResolver::executeResolve(const std::string& url, uint64_t id) {
+    Entries entries;
+    bool complete = parse(url, entries);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_cache.find(url);
+    if (it != m_cache.end() && it->second.id == id) {
+        if (complete) {
+            it->second.expiry = std::chrono::steady_clock::now() + m_ttl;
+        } else {
+            // an incomplete playlist is fetched again the next time
+            m_lru.erase(it->second.lru);
+            m_cache.erase(it);
+        }
+    }
+
+    return entries;
+}
+
+bool PlaylistResolver::parse(const std::string& url, Entries& entries) {
+    std::shared_ptr<PlaylistParser> parser;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        parser = m_parser;
+    }
+    if (!parser) {
+        entries = {url};
+        return false;
+    }
+
+    auto observer = std::make_shared<PlaylistParserObserver>();
+    if (parser->parsePlaylist(url, observer, {PlaylistParser::PlaylistParserInterface::PlaylistType::EXT_M3U}) ==
+        PlaylistParser::START_FAILURE) {
+        AACE_ERROR(LX(TAG).d("reason", "failed to start playlist parser"));
+        entries = {url};
+        return false;
+    }
+
+    try {
+        auto future = observer->promise.get_future();
+        if (future.wait_for(PLAYLIST_TIMEOUT) == std::future_status::ready) {
+            entries = future.get();  // return successfully parsed entries
+            return true;
+        }
+
+        AACE_ERROR(LX(TAG).d("reason", "parsing playlist timeout"));
+
+        // the parser handles one playlist at a time, so the parser stuck on this playlist is replaced
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_parser == parser) {
+                m_parser = PlaylistParser::create(m_fetcherFactory);
+            }
+        }
+        parser->shutdown();
+
+        auto fallbackFuture = observer->fallbackPromise.get_future();
+        if (fallbackFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            AACE_INFO(LX(TAG).m("use what we got so far"));
+            entries = fallbackFuture.get();
+            return false;
+        }
+
+        entries = {url};
+        return false;
+    } catch (const std::exception& e) {
+        AACE_ERROR(LX(TAG).d("reason", e.what()));
+        entries = {url};
+        return false;
+    }
+}
+
+void PlaylistResolver::shutdown() {
+    std::shared_ptr<PlaylistParser> parser;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        parser = std::move(m_parser);
+        m_cache.clear();
+        m_lru.clear();
+    }
+    if (parser) {
+        parser->shutdown();
+    }
+    m_executor.shutdown();
+}
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AACE/Engine/SystemAudio/SharedAudioRecorder.h>
+#include <AACE/Engine/Core/EngineMacros.h>
+#include <AACE/Engine/Utils/Metrics/Metrics.h>
+
+#define DEFAULT_AUDIO_FRAGMENT_DURATION 20
+#define DEFAULT_AUDIO_FRAGMENT_SAMPLES 320
+
+namespace aace {
+namespace engine {
+namespace systemAudio {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.systemAudio.SharedAudioRecorder");
+
+/// Program Name for Metrics
+static const std::string METRIC_PROGRAM_NAME_SUFFIX = "SharedAudioRecorder";
+
+// clang-format off
+static aal_listener_t aalListener = {
+    .on_start = nullptr,
+    .on_stop = nullptr,
+    .on_almost_done = nullptr,
+    .on_data = [](const int16_t* data, const size_t length, void* user_data) {
+        ReturnIf(!user_data);
+        auto self = static_cast<SharedAudioRecorder*>(user_data);
+        self->onStreamData(data, length);
+    },
+    .on_data_requested = nullptr
+};
+// clang-format on
+
+SharedAudioRecorder::SharedAudioRecorder(
+    int moduleId,
+    const std::string& deviceName,
+    int sampleRate,
+    const std::string& name,
+    const LatencyProfile& latencyProfile) :
+        m_moduleId(moduleId),
+        m_deviceName(deviceName),
+        m_sampleRate(sampleRate),
+        m_name(name),
+        m_latencyProfile(latencyProfile)
+#ifdef THROTTLE_AUDIO
+        ,
+        m_throttle(
+            DEFAULT_AUDIO_FRAGMENT_SAMPLES,
+            std::chrono::milliseconds(DEFAULT_AUDIO_FRAGMENT_DURATION),
+            [this](const int16_t* data, size_t length) { fanOut(data, length); })
+#endif
+{
+}
+
+SharedAudioRecorder::~SharedAudioRecorder() {
+    if (m_recorder) {
+        aal_recorder_destroy(m_recorder);
+    }
+}
+
+std::shared_ptr<SharedAudioRecorder> SharedAudioRecorder::create(
+    int moduleId,
+    const std::string& deviceName,
+    int sampleRate,
+    const std::string& name,
+    const LatencyProfile& latencyProfile) {
+    try {
+        ThrowIf(moduleId < 0 || moduleId >= aal_get_module_count(), "invalidModuleId");
+        ThrowIf(
+            latencyProfile.bufferTime.count() < 0 || latencyProfile.periodTime.count() < 0, "invalidLatencyProfile");
+        return std::shared_ptr<SharedAudioRecorder>(
+            new SharedAudioRecorder(moduleId, deviceName, sampleRate, name, latencyProfile));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+aal_handle_t SharedAudioRecorder::createRecorder() {
+    AACE_VERBOSE(LX(TAG).d("device", m_deviceName).d("profile", m_latencyProfile.name));
+
+    // clang-format off
+    const aal_attributes_t attr = {
+        .name = m_name.c_str(),
+        .device = m_deviceName.c_str(),
+        .uri = nullptr,
+        .listener = &aalListener,
+        .user_data = this,
+        .module_id = m_moduleId,
+        .buffer_time = m_latencyProfile.bufferTime.count(),
+        .period_time = m_latencyProfile.periodTime.count(),
+    };
+    aal_lpcm_parameters_t params = {
+        .sample_format = AAL_SAMPLE_FORMAT_DEFAULT,
+        .channels = 0,
+        .sample_rate = m_sampleRate,
+    };
+    // clang-format on
+
+    return aal_recorder_create(&attr, &params);
+}
+
+bool SharedAudioRecorder::start(aace::audio::AudioInput* input) {
+    try {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_recorder == nullptr) {
+            m_recorder = createRecorder();
+            ThrowIfNull(m_recorder, "createRecorderFailed");
+        }
+
+        bool first = false;
+        {
+            std::lock_guard<std::mutex> inputsLock(m_inputsMutex);
+            ReturnIf(std::find(m_inputs.begin(), m_inputs.end(), input) != m_inputs.end(), true);
+            first = m_inputs.empty();
+            m_inputs.push_back(input);
+        }
+        AACE_VERBOSE(LX(TAG).d("device", m_deviceName).d("first", first));
+
+        // the capture is already running for the other inputs
+        if (first) {
+            m_latencyPending = true;
+            aal_recorder_play(m_recorder);
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()).d("device", m_deviceName));
+        return false;
+    }
+}
+
+bool SharedAudioRecorder::stop(aace::audio::AudioInput* input) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool last = false;
+    {
+        // the recorder thread doesn't write to the input once it is removed
+        std::lock_guard<std::mutex> inputsLock(m_inputsMutex);
+        auto it = std::find(m_inputs.begin(), m_inputs.end(), input);
+        ReturnIf(it == m_inputs.end(), true);
+        m_inputs.erase(it);
+        last = m_inputs.empty();
+    }
+    AACE_VERBOSE(LX(TAG).d("device", m_deviceName).d("last", last));
+
+    // stopping the recorder may wait for its thread, so the inputs mutex must not be held
+    if (last) {
+        aal_recorder_stop(m_recorder);
+    }
+    return true;
+}
+
+void SharedAudioRecorder::onStreamData(const int16_t* data, const size_t length) {
+    if (m_latencyPending.exchange(false)) {
+        reportLatency();
+    }
+#ifdef THROTTLE_AUDIO
+    m_throttle.write(data, length);
+#else
+    fanOut(data, length);
+#endif
+}
+
+void SharedAudioRecorder::fanOut(const int16_t* data, const size_t length) {
+    std::lock_guard<std::mutex> lock(m_inputsMutex);
+    for (auto input : m_inputs) {
+        input->write(data, length);
+    }
+}
+
+void SharedAudioRecorder::reportLatency() {
+    // the device is opened once the capture delivers audio
+    int64_t latency = aal_recorder_get_latency(m_recorder);
+    AACE_DEBUG(LX(TAG).d("device", m_deviceName).d("profile", m_latencyProfile.name).d("latency", latency));
+    if (latency < 0) {
+        return;
+    }
+    aace::engine::utils::metrics::emitMetrics(
+        METRIC_PROGRAM_NAME_SUFFIX,
+        "reportLatency",
+        {},
+        {{"Device", m_deviceName}, {"Profile", m_latencyProfile.name}},
+        {{"PipelineLatency", static_cast<double>(latency) / 1000}});
+}
+
+}  // namespace systemAudio
+}  // namespace engine
+}  // namespace aace
@@ -20,6 +20,11 @@
 #include <AACE/Audio/AudioOutputProvider.h>
 #include <AACE/Engine/SystemAudio/AudioInputImpl.h>
 #include <AACE/Engine/SystemAudio/AudioOutputImpl.h>
+#include <AACE/Engine/SystemAudio/FileAudioInput.h>
+#include <AACE/Engine/SystemAudio/FileAudioOutput.h>
+#include <AACE/Engine/SystemAudio/MediaCache.h>
+#include <AACE/Engine/SystemAudio/PlaylistResolver.h>
+#include <AACE/Engine/SystemAudio/SharedAudioRecorder.h>
 #include <AACE/Engine/Core/EngineMacros.h>
 #include <aal/aal.h>
 #include <unordered_map>
@@ -34,6 +39,46 @@ using namespace aace::audio;
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.systemAudio.SystemAudioEngineService");
 
+/// The name of the module that reads and writes the audio from files instead of the audio devices
+static const std::string FILE_MODULE_NAME = "File";
+
+/// The directory of the media cache, by default
+static const std::string DEFAULT_MEDIA_CACHE_PATH = "/tmp/aac_media_cache";
+
+/**
+ * Returns the buffer and period times of a latency profile.
+ *
+ * @throw std::exception if the profile is unknown
+ */
+static LatencyProfile getLatencyProfile(const std::string& name) {
+    if (name == LatencyProfile::LOW_LATENCY) {
+        return LatencyProfile(name, std::chrono::milliseconds(50), std::chrono::milliseconds(10));
+    }
+    if (name == LatencyProfile::POWER_SAVING) {
+        return LatencyProfile(name, std::chrono::milliseconds(200), std::chrono::milliseconds(50));
+    }
+    ThrowIfNot(name == LatencyProfile::DEFAULT, "unknownLatencyProfile");
+    return LatencyProfile();
+}
+
+/**
+ * Returns the latency profile of the devices of a type, unless the device is configured with another profile. The
+ * inputs of a device share its recorder whatever their type, so the profile of the inputs is only configured.
+ */
+static LatencyProfile getDefaultLatencyProfile(const std::string& name, const std::string& type) {
+    if (name != "AudioOutputProvider") {
+        return LatencyProfile();
+    }
+    // the dialog and the earcons answer the user, while the media play long enough to save the power
+    if (type == "TTS" || type == "EARCON" || type == "COMMUNICATION") {
+        return getLatencyProfile(LatencyProfile::LOW_LATENCY);
+    }
+    if (type == "MUSIC") {
+        return getLatencyProfile(LatencyProfile::POWER_SAVING);
+    }
+    return LatencyProfile();
+}
+
 // register the service
 REGISTER_SERVICE(SystemAudioEngineService);
 
@@ -65,6 +110,15 @@ bool SystemAudioEngineService::configure(std::shared_ptr<std::istream> configura
 }
 
 bool SystemAudioEngineService::shutdown() {
+    if (m_playlistResolver) {
+        m_playlistResolver->shutdown();
+        m_playlistResolver.reset();
+    }
+    if (m_mediaCache) {
+        m_mediaCache->shutdown();
+        m_mediaCache.reset();
+    }
+
     // Deinitialize all modules marked as in-use
     for (int id : m_modulesInUse) {
         AACE_DEBUG(LX(TAG, "AAL Module deinit").d("id", id));
@@ -92,6 +146,57 @@ int SystemAudioEngineService::prepareModule(const std::string& target) {
     Throw("Module not found");
 }
 
+std::shared_ptr<PlaylistResolver> SystemAudioEngineService::getPlaylistResolver() {
+    return m_playlistResolver;
+}
+
+std::shared_ptr<MediaCache> SystemAudioEngineService::getMediaCache() {
+    return m_mediaCache;
+}
+
+std::shared_ptr<MediaCache> SystemAudioEngineService::createMediaCache() {
+    // the cache is disabled unless it is configured
+    MediaCache::Config cacheConfig;
+    cacheConfig.path = DEFAULT_MEDIA_CACHE_PATH;
+    try {
+        ThrowIfNull(m_configuration, "JSON configuration is not available");
+        auto root = m_configuration->GetObject();
+
+        if (!root.HasMember("AudioOutputProvider") || !root["AudioOutputProvider"].IsObject()) {
+            return nullptr;
+        }
+        auto config = root["AudioOutputProvider"].GetObject();
+        if (!config.HasMember("mediaCache") || !config["mediaCache"].IsObject()) {
+            return nullptr;
+        }
+        auto cache = config["mediaCache"].GetObject();
+
+        if (!cache.HasMember("enabled") || !cache["enabled"].IsBool() || !cache["enabled"].GetBool()) {
+            return nullptr;
+        }
+        if (cache.HasMember("path") && cache["path"].IsString()) {
+            cacheConfig.path = cache["path"].GetString();
+        }
+        if (cache.HasMember("maxSize") && cache["maxSize"].IsUint64()) {
+            cacheConfig.maxSize = cache["maxSize"].GetUint64();
+        }
+        if (cache.HasMember("maxEntrySize") && cache["maxEntrySize"].IsUint64()) {
+            cacheConfig.maxEntrySize = cache["maxEntrySize"].GetUint64();
+        }
+    } catch (std::exception& ex) {
+        AACE_WARN(LX(TAG, "Config not found, media cache is disabled"));
+        return nullptr;
+    }
+
+    AACE_DEBUG(LX(TAG, "Use media cache")
+                   .d("path", cacheConfig.path)
+                   .d("maxSize", cacheConfig.maxSize)
+                   .d("maxEntrySize", cacheConfig.maxEntrySize));
+
+    // the media are played from the network if the cache can't be created
+    return MediaCache::create(cacheConfig);
+}
+
 bool SystemAudioEngineService::isConfigEnabled(const std::string& name) {
     bool enabled = true;
     try {
@@ -118,6 +223,8 @@ std::unique_ptr<DeviceConfig> SystemAudioEngineService::getDeviceConfig(
     std::unique_ptr<DeviceConfig> deviceConfig(new DeviceConfig{
         .name = "default",
         .module = "GStreamer",
+        .speed = 1.0,
+        .latencyProfile = getDefaultLatencyProfile(name, type),
     });
 
     try {
@@ -159,6 +266,33 @@ std::unique_ptr<DeviceConfig> SystemAudioEngineService::getDeviceConfig(
         if (deviceObj.HasMember("shared") && deviceObj["shared"].IsBool()) {
             deviceConfig->shared = deviceObj["shared"].GetBool();
         }
+        if (deviceObj.HasMember("prefetch") && deviceObj["prefetch"].IsInt()) {
+            deviceConfig->prefetch = deviceObj["prefetch"].GetInt();
+        }
+        if (deviceObj.HasMember("path") && deviceObj["path"].IsString()) {
+            deviceConfig->path = deviceObj["path"].GetString();
+        }
+        if (deviceObj.HasMember("speed") && deviceObj["speed"].IsNumber()) {
+            deviceConfig->speed = deviceObj["speed"].GetDouble();
+        }
+        if (deviceObj.HasMember("loop") && deviceObj["loop"].IsBool()) {
+            deviceConfig->loop = deviceObj["loop"].GetBool();
+        }
+        if (deviceObj.HasMember("profile") && deviceObj["profile"].IsString()) {
+            std::string profile = deviceObj["profile"].GetString();
+            try {
+                deviceConfig->latencyProfile = getLatencyProfile(profile);
+            } catch (std::exception& ex) {
+                AACE_WARN(LX(TAG).d("reason", ex.what()).d("device", deviceConfig->name).d("profile", profile));
+            }
+        }
+        // the times configured override the times of the profile
+        if (deviceObj.HasMember("bufferTime") && deviceObj["bufferTime"].IsUint()) {
+            deviceConfig->latencyProfile.bufferTime = std::chrono::milliseconds(deviceObj["bufferTime"].GetUint());
+        }
+        if (deviceObj.HasMember("periodTime") && deviceObj["periodTime"].IsUint()) {
+            deviceConfig->latencyProfile.periodTime = std::chrono::milliseconds(deviceObj["periodTime"].GetUint());
+        }
     } catch (std::exception& ex) {
         AACE_WARN(LX(TAG, "Config not found, will use default settings").d("name", name).d("type", type));
     }
@@ -168,7 +302,14 @@ std::unique_ptr<DeviceConfig> SystemAudioEngineService::getDeviceConfig(
                    .d("module", deviceConfig->module)
                    .d("card", deviceConfig->card)
                    .d("rate", deviceConfig->rate)
-                   .d("shared", deviceConfig->shared));
+                   .d("shared", deviceConfig->shared)
+                   .d("prefetch", deviceConfig->prefetch)
+                   .d("path", deviceConfig->path)
+                   .d("speed", deviceConfig->speed)
+                   .d("loop", deviceConfig->loop)
+                   .d("profile", deviceConfig->latencyProfile.name)
+                   .d("bufferTime", deviceConfig->latencyProfile.bufferTime.count())
+                   .d("periodTime", deviceConfig->latencyProfile.periodTime.count()));
 
     return deviceConfig;
 }
@@ -183,8 +324,15 @@ public:
     std::shared_ptr<aace::audio::AudioInput> openChannel(const std::string& name, AudioInputType type) override;
 
 private:
+    std::shared_ptr<SharedAudioRecorder> getRecorder(
+        int moduleId,
+        const DeviceConfig& config,
+        const std::string& name);
+
     std::weak_ptr<SystemAudioEngineService> m_service;
     std::unordered_map<std::string, std::shared_ptr<AudioInputImpl>> m_sharedInputs;
+    // The recorders of the capture devices, shared by the inputs of each device
+    std::unordered_map<std::string, std::weak_ptr<SharedAudioRecorder>> m_recorders;
 };
 
 AudioInputProviderImpl::AudioInputProviderImpl(std::weak_ptr<SystemAudioEngineService> service) :
@@ -201,21 +349,24 @@ std::shared_ptr<AudioInput> AudioInputProviderImpl::openChannel(const std::strin
         if (type == AudioInputType::LOOPBACK && config->name == "default") {
             Throw("Loopback device must be configured explicitly");
         }
+        if (config->module == FILE_MODULE_NAME) {
+            return FileAudioInput::create(config->path, config->speed, config->loop, name);
+        }
         auto moduleId = service->prepareModule(config->module);
         std::shared_ptr<AudioInputImpl> impl;
         if (config->shared) {
             auto search = m_sharedInputs.find(config->name);
             if (search == m_sharedInputs.end()) {
                 AACE_DEBUG(LX(TAG, "Create the new shared input").d("device", config->name));
-                impl = AudioInputImpl::create(moduleId, config->card, config->rate, name);
+                impl = AudioInputImpl::create(getRecorder(moduleId, *config, name), name);
                 ThrowIfNull(impl, "Failed to create AudioInputImpl");
                 m_sharedInputs[config->name] = impl;
             } else {
                 impl = search->second;
             }
         } else {
-            // Non-shared input
-            impl = AudioInputImpl::create(moduleId, config->card, config->rate, name);
+            // Non-shared input, which still shares the recorder of the device
+            impl = AudioInputImpl::create(getRecorder(moduleId, *config, name), name);
         }
         return impl;
     } catch (std::exception& ex) {
@@ -224,6 +375,26 @@ std::shared_ptr<AudioInput> AudioInputProviderImpl::openChannel(const std::strin
     }
 }
 
+std::shared_ptr<SharedAudioRecorder> AudioInputProviderImpl::getRecorder(
+    int moduleId,
+    const DeviceConfig& config,
+    const std::string& name) {
+    // the inputs of a device opened with other buffer and period times don't share its recorder
+    std::stringstream key;
+    key << moduleId << ":" << config.card << ":" << config.rate << ":" << config.latencyProfile.bufferTime.count()
+        << ":" << config.latencyProfile.periodTime.count();
+    auto recorder = m_recorders[key.str()].lock();
+    if (recorder == nullptr) {
+        AACE_DEBUG(LX(TAG, "Create the recorder of the device")
+                       .d("card", config.card)
+                       .d("rate", config.rate)
+                       .d("profile", config.latencyProfile.name));
+        recorder = SharedAudioRecorder::create(moduleId, config.card, config.rate, name, config.latencyProfile);
+        m_recorders[key.str()] = recorder;
+    }
+    return recorder;
+}
+
 //
 // AudioOutputProvider
 //
@@ -248,9 +419,21 @@ std::shared_ptr<AudioOutput> AudioOutputProviderImpl::openChannel(const std::str
         std::stringstream ss;
         ss << type;
         auto config = service->getDeviceConfig("AudioOutputProvider", ss.str());
+        if (config->module == FILE_MODULE_NAME) {
+            return FileAudioOutput::create(config->path, config->speed, name);
+        }
 
         auto moduleId = service->prepareModule(config->module);
-        auto impl = AudioOutputImpl::create(moduleId, config->card, name);
+        auto prefetch =
+            config->prefetch > 0 ? std::chrono::milliseconds(config->prefetch) : AudioOutputImpl::DEFAULT_PREFETCH;
+        auto impl = AudioOutputImpl::create(
+            moduleId,
+            config->card,
+            name,
+            prefetch,
+            service->getPlaylistResolver(),
+            service->getMediaCache(),
+            config->latencyProfile);
         return std::move(impl);
     } catch (std::exception& ex) {
         AACE_WARN(LX(TAG).d("reason", ex.what()));
@@ -267,6 +450,9 @@ bool SystemAudioEngineService::preRegister() {
         }
         if (isConfigEnabled("AudioOutputProvider")) {
             AACE_DEBUG(LX(TAG, "register AudioOutputProvider"));
+            m_playlistResolver = PlaylistResolver::create();
+            ThrowIfNull(m_playlistResolver, "createPlaylistResolverFailed");
+            m_mediaCache = createMediaCache();
             auto intf = std::shared_ptr<AudioOutputProvider>(new AudioOutputProviderImpl(shared_from_this()));
             getContext()->registerPlatformInterface(intf);
         }
@@ -100,6 +100,8 @@ public:
 
 private:
     void createVoiceIdMapping(const std::string& voiceConfiguration);
+    /// Builds the capabilities of the voices for a locale, or an empty string if a voice does not support it.
+    std::string buildCapabilities(const std::string& locale);
     aace::engine::textToSpeech::PrepareSpeechResult createPrepareSpeechFailedResponse(
         const std::string& speechId,
         const std::string& reason);
@@ -115,6 +117,8 @@ private:
     std::unordered_map<std::string, std::string> m_voiceIdToAssistantIdMap;
     std::unordered_map<std::string, std::vector<std::string>> m_voiceIdToLocalesMap;
     std::string m_currentLocale;
+    // the capabilities of each locale, cleared when the locale or the connection status changes
+    std::unordered_map<std::string, std::string> m_capabilitiesCache;
     std::mutex m_mutex;
     std::mutex m_connectionMutex;
     alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status m_connectionStatus =
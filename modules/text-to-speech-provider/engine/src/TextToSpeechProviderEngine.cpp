@@ -200,49 +200,57 @@ std::future<std::string> TextToSpeechProviderEngine::getCapabilities(const std::
             ThrowIfNull(m_propertyManager_lock, "nullPropertyManagerServiceInterface");
             m_currentLocale = m_propertyManager_lock->getProperty(aace::alexa::property::LOCALE);
         }
-        // Construct the capability
-        json voices = {{"voices", json::array()}};
-        for (auto& voiceId : m_voiceIdToAssistantIdMap) {
-            // Current locale is not in the supported locales list
-            auto supportedLocales = m_voiceIdToLocalesMap.find(voiceId.first)->second;
-            if (std::find(supportedLocales.begin(), supportedLocales.end(), m_currentLocale) ==
-                supportedLocales.end()) {
-                AACE_ERROR(LX(TAG).m("Current locale is not supported").d("currentLocale", m_currentLocale));
-                getCapabilitiesPromise->set_value(EMPTY_STRING);
-                return getCapabilitiesPromiseFuture;
-            }
 
-            // clang-format off
-            json voice = {
-                {VOICE_ID_KEY, voiceId.first},
-                {LOCALES_KEY , {m_currentLocale}}
-            };
-            // clang-format on
+        // the capabilities only change with the locale and the connection, so they are built once for each locale
+        auto it = m_capabilitiesCache.find(m_currentLocale);
+        if (it == m_capabilitiesCache.end()) {
+            it = m_capabilitiesCache.emplace(m_currentLocale, buildCapabilities(m_currentLocale)).first;
+        }
+        getCapabilitiesPromise->set_value(it->second);
+        return getCapabilitiesPromiseFuture;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        getCapabilitiesPromise->set_exception(std::current_exception());
+        return getCapabilitiesPromiseFuture;
+    }
+}
 
-            voices.at("voices").push_back(voice);
+std::string TextToSpeechProviderEngine::buildCapabilities(const std::string& locale) {
+    // Construct the capability
+    json voices = {{"voices", json::array()}};
+    for (auto& voiceId : m_voiceIdToAssistantIdMap) {
+        // Current locale is not in the supported locales list
+        auto supportedLocales = m_voiceIdToLocalesMap.find(voiceId.first)->second;
+        if (std::find(supportedLocales.begin(), supportedLocales.end(), locale) == supportedLocales.end()) {
+            AACE_ERROR(LX(TAG).m("Current locale is not supported").d("currentLocale", locale));
+            return EMPTY_STRING;
         }
 
         // clang-format off
-        json defaultAlexaVoice = {
-            {VOICE_ID_KEY, ALEXA_VOICE_ID},
-            {LOCALES_KEY , {m_currentLocale}}
+        json voice = {
+            {VOICE_ID_KEY, voiceId.first},
+            {LOCALES_KEY , {locale}}
         };
         // clang-format on
 
-        voices.at("voices").push_back(defaultAlexaVoice);
-
-        // clang-format off
-        json capabilities = {
-            {PROVIDER_KEY, voices}
-        };
-        // clang-format on
-        getCapabilitiesPromise->set_value(capabilities.dump());
-        return getCapabilitiesPromiseFuture;
-    } catch (std::exception& ex) {
-        AACE_ERROR(LX(TAG).d("reason", ex.what()));
-        getCapabilitiesPromise->set_exception(std::current_exception());
-        return getCapabilitiesPromiseFuture;
+        voices.at("voices").push_back(voice);
     }
+
+    // clang-format off
+    json defaultAlexaVoice = {
+        {VOICE_ID_KEY, ALEXA_VOICE_ID},
+        {LOCALES_KEY , {locale}}
+    };
+    // clang-format on
+
+    voices.at("voices").push_back(defaultAlexaVoice);
+
+    // clang-format off
+    json capabilities = {
+        {PROVIDER_KEY, voices}
+    };
+    // clang-format on
+    return capabilities.dump();
 }
 
 void TextToSpeechProviderEngine::prepareSpeechCompleted(
@@ -283,6 +291,9 @@ void TextToSpeechProviderEngine::prepareSpeechFailed(const std::string& speechId
 void TextToSpeechProviderEngine::propertyChanged(const std::string& key, const std::string& newValue) {
     AACE_INFO(LX(TAG).d("key", key).sensitive("newValue", newValue));
     std::lock_guard<std::mutex> lock(m_mutex);
+    if (key == aace::alexa::property::LOCALE && newValue != m_currentLocale) {
+        m_capabilitiesCache.clear();
+    }
     m_currentLocale = newValue;
 }
 
@@ -297,8 +308,15 @@ void TextToSpeechProviderEngine::onConnectionStatusChanged(
     const std::vector<
         alexaClientSDK::avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::EngineConnectionStatus>&
         engineStatuses) {
-    std::lock_guard<std::mutex> lock(m_connectionMutex);
-    m_connectionStatus = status;
+    {
+        std::lock_guard<std::mutex> lock(m_connectionMutex);
+        ReturnIf(m_connectionStatus == status);
+        m_connectionStatus = status;
+    }
+
+    // the provider may offer other voices once it reconnects, so the capabilities are built again
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capabilitiesCache.clear();
 }
 
 void TextToSpeechProviderEngine::createVoiceIdMapping(const std::string& voiceConfiguration) {
@@ -382,6 +400,7 @@ void TextToSpeechProviderEngine::doShutdown() {
     m_speechRequestsMap.clear();
     m_voiceIdToAssistantIdMap.clear();
     m_voiceIdToLocalesMap.clear();
+    m_capabilitiesCache.clear();
 }
 
 }  // namespace textToSpeechProvider
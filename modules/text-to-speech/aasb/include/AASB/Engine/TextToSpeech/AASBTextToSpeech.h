@@ -68,6 +68,7 @@ private:
 
         // aace::core::MessageStream
         ssize_t read(char* data, const size_t size) override;
+        ssize_t timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) override;
         ssize_t write(const char* data, const size_t size) override;
         bool isClosed() override;
         MessageStream::Mode getMode() override;
@@ -186,6 +186,13 @@ ssize_t AASBTextToSpeech::AudioOutputStreamHandler::read(char* data, const size_
     return m_stream->read(data, size);
 }
 
+ssize_t AASBTextToSpeech::AudioOutputStreamHandler::timedRead(
+    char* data,
+    const size_t size,
+    std::chrono::milliseconds timeout) {
+    return m_stream->timedRead(data, size, timeout);
+}
+
 ssize_t AASBTextToSpeech::AudioOutputStreamHandler::write(const char* data, const size_t size) {
     AACE_ERROR(LX(TAG).d("reason", "invalidOperation"));
     return -1;
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef AACE_ENGINE_TEXTTOSPEECH_SPEECH_CACHE_H
+#define AACE_ENGINE_TEXTTOSPEECH_SPEECH_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <AACE/Audio/AudioStream.h>
+
+namespace aace {
+namespace engine {
+namespace textToSpeech {
+
+/**
+ * Caches the speech prepared by the text to speech providers, keyed by the provider, the text or SSML, and the
+ * request payload, which holds the voice and locale of the speech.
+ *
+ * The prepared audio is cached while the platform reads it, so a prepared speech plays as soon as the provider
+ * streams it, and it is cached once the platform has read it to the end. A cached speech is returned as a new audio
+ * stream over the cached audio, without a request to the provider.
+ *
+ * The speech is cached in memory up to @c maxMemorySize bytes, and in the @c path directory up to @c maxDiskSize
+ * bytes, so the speech prepared by a previous Engine plays offline. Both tiers evict the least recently used speech
+ * first, and a speech larger than @c maxEntrySize is not cached.
+ */
+class SpeechCache : public std::enable_shared_from_this<SpeechCache> {
+public:
+    struct Configuration {
+        /// The most bytes of audio cached in memory
+        size_t maxMemorySize = 2 * 1024 * 1024;
+        /// The most bytes of audio cached on disk, @c 0 disables the disk tier
+        size_t maxDiskSize = 0;
+        /// The existing directory of the disk tier
+        std::string path;
+        /// The largest audio cached
+        size_t maxEntrySize = 512 * 1024;
+    };
+
+    /**
+     * Creates a speech cache.
+     *
+     * @param configuration The limits of the cache, and the directory of its disk tier.
+     */
+    static std::shared_ptr<SpeechCache> create(const Configuration& configuration);
+
+    /**
+     * Returns the stream of a cached speech.
+     *
+     * @param provider The name of the text to speech provider.
+     * @param text The text or SSML of the speech.
+     * @param requestPayload The request payload of the speech.
+     * @param [out] metadata The metadata of the cached speech.
+     * @return A new stream over the cached audio, or @c nullptr if the speech is not cached.
+     */
+    std::shared_ptr<aace::audio::AudioStream> get(
+        const std::string& provider,
+        const std::string& text,
+        const std::string& requestPayload,
+        std::string& metadata);
+
+    /**
+     * Wraps the stream of a prepared speech, so the speech is cached once the stream has been read to the end.
+     *
+     * @param provider The name of the text to speech provider.
+     * @param text The text or SSML of the speech.
+     * @param requestPayload The request payload of the speech.
+     * @param preparedAudio The stream of the prepared speech.
+     * @param metadata The metadata of the prepared speech.
+     * @return The stream to read the prepared speech from.
+     */
+    std::shared_ptr<aace::audio::AudioStream> wrap(
+        const std::string& provider,
+        const std::string& text,
+        const std::string& requestPayload,
+        std::shared_ptr<aace::audio::AudioStream> preparedAudio,
+        const std::string& metadata);
+
+    /// Returns the bytes of audio cached in memory.
+    size_t getMemorySize();
+
+    /// Returns the bytes of audio cached on disk.
+    size_t getDiskSize();
+
+    /// Removes the cached speech from memory and disk.
+    void clear();
+
+private:
+    /// Reads a prepared stream, and caches its audio once it is read to the end
+    class CachingAudioStream;
+
+    /// Reads a cached speech
+    class CachedAudioStream;
+
+    /// A cached speech
+    struct Speech {
+        /// The provider, text and request payload of the speech, compared on lookup in case of a key collision
+        std::string identity;
+        std::string metadata;
+        aace::audio::AudioStream::Encoding encoding;
+        aace::audio::AudioFormat audioFormat;
+        aace::audio::AudioStream::MediaType mediaType;
+        std::shared_ptr<const std::string> audio;
+    };
+
+    /// A speech cached on disk
+    struct DiskEntry {
+        std::string key;
+        size_t size;
+    };
+
+    SpeechCache(const Configuration& configuration);
+
+    /// Loads the index of the disk tier.
+    void loadDiskIndex();
+
+    /// Writes the index of the disk tier. @c m_mutex must be held.
+    void saveDiskIndexLocked();
+
+    /// Adds a speech to the cache.
+    void put(const std::string& key, std::shared_ptr<const Speech> speech);
+
+    /// Adds a speech to the memory tier, evicting the least recently used speech. @c m_mutex must be held.
+    void putInMemoryLocked(const std::string& key, std::shared_ptr<const Speech> speech);
+
+    /// Returns the path of the file of a speech cached on disk.
+    std::string getSpeechPath(const std::string& key) const;
+
+    /// Writes a speech to a file.
+    static bool writeSpeech(const std::string& path, const Speech& speech);
+
+    /// Reads a speech from a file.
+    static std::shared_ptr<const Speech> readSpeech(const std::string& path);
+
+    /// Returns the identity of a speech.
+    static std::string makeIdentity(
+        const std::string& provider,
+        const std::string& text,
+        const std::string& requestPayload);
+
+    /// Returns the key of a speech, the hexadecimal FNV-1a hash of its identity.
+    static std::string makeKey(const std::string& identity);
+
+    const Configuration m_configuration;
+
+    std::mutex m_mutex;
+
+    /// The memory tier, most recently used first
+    std::list<std::pair<std::string, std::shared_ptr<const Speech>>> m_memoryEntries;
+    std::unordered_map<std::string, decltype(m_memoryEntries)::iterator> m_memoryIndex;
+    size_t m_memorySize;
+
+    /// The disk tier, most recently used first
+    std::list<DiskEntry> m_diskEntries;
+    std::unordered_map<std::string, std::list<DiskEntry>::iterator> m_diskIndex;
+    size_t m_diskSize;
+};
+
+}  // namespace textToSpeech
+}  // namespace engine
+}  // namespace aace
+
+#endif  // AACE_ENGINE_TEXTTOSPEECH_SPEECH_CACHE_H
@@ -16,13 +16,19 @@
 #ifndef AACE_ENGINE_TEXTTOSPEECH_TEXTTOSPEECH_ENGINE_IMPL_H
 #define AACE_ENGINE_TEXTTOSPEECH_TEXTTOSPEECH_ENGINE_IMPL_H
 
+#include <cstdint>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <AACE/Engine/Utils/Threading/Executor.h>
+#include <AACE/Engine/Utils/Threading/ThreadPool.h>
 
 #include "AACE/TextToSpeech/TextToSpeech.h"
 #include "AACE/TextToSpeech/TextToSpeechEngineInterface.h"
+#include "PrepareSpeechResult.h"
+#include "SpeechCache.h"
 #include "TextToSpeechServiceInterface.h"
 
 namespace aace {
@@ -33,12 +39,32 @@ class TextToSpeechEngineImpl : public aace::textToSpeech::TextToSpeechEngineInte
 private:
     TextToSpeechEngineImpl(std::shared_ptr<aace::textToSpeech::TextToSpeech> textToSpeechPlatformInterface);
 
-    bool initialize(std::shared_ptr<TextToSpeechServiceInterface> textToSpeechServiceInterface);
+    bool initialize(
+        std::shared_ptr<TextToSpeechServiceInterface> textToSpeechServiceInterface,
+        std::shared_ptr<SpeechCache> speechCache,
+        size_t maxConcurrentRequests);
 
 public:
+    /// The default number of prepare speech requests sent to the providers at the same time
+    static const size_t DEFAULT_MAX_CONCURRENT_REQUESTS = 3;
+
+    /**
+     * Creates the engine implementation of the TextToSpeech platform interface.
+     *
+     * The prepare speech requests are sent to the providers up to @c maxConcurrentRequests at a time, the requests
+     * with the highest @c priority option first. A request with a @c group option supersedes the earlier request of
+     * its group that hasn't completed, which fails with @c REQUEST_SUPERSEDED.
+     *
+     * @param textToSpeechPlatformInterface The TextToSpeech platform interface.
+     * @param textToSpeechServiceInterface The service providing the text to speech providers.
+     * @param speechCache The cache of the prepared speech, or @c nullptr to request every speech from its provider.
+     * @param maxConcurrentRequests The number of prepare speech requests sent to the providers at the same time.
+     */
     static std::shared_ptr<TextToSpeechEngineImpl> create(
         std::shared_ptr<aace::textToSpeech::TextToSpeech> textToSpeechPlatformInterface,
-        std::shared_ptr<TextToSpeechServiceInterface> textToSpeechServiceInterface);
+        std::shared_ptr<TextToSpeechServiceInterface> textToSpeechServiceInterface,
+        std::shared_ptr<SpeechCache> speechCache = nullptr,
+        size_t maxConcurrentRequests = DEFAULT_MAX_CONCURRENT_REQUESTS);
 
     // TextToSpeechEngineInterface
     bool onPrepareSpeech(
@@ -51,20 +77,52 @@ public:
     void shutdown();
 
 private:
+    /// A prepare speech request
+    struct PrepareSpeechRequest {
+        std::string speechId;
+        std::string text;
+        std::string provider;
+        std::string requestPayload;
+        std::shared_ptr<TextToSpeechSynthesizerInterface> textToSpeechProvider;
+        std::shared_ptr<aace::textToSpeech::TextToSpeech> textToSpeechPlatformInterface;
+        int priority;
+        std::string group;
+        uint64_t sequence;
+        /// Whether a later request of the group superseded the request, protected by @c m_requestMutex
+        bool superseded;
+    };
+
     bool executeOnPrepareSpeech(
         const std::string& speechId,
         const std::string& text,
+        const std::string& provider,
         std::shared_ptr<TextToSpeechSynthesizerInterface> textToSpeechProvider,
         const std::string& options);
     bool executeOnGetCapabilities(
         const std::string& requestId,
         std::shared_ptr<TextToSpeechSynthesizerInterface> textToSpeechProvider);
 
+    /// Runs the pending request with the highest priority, and reports its result. Runs on the request pool.
+    void executeNextPrepareSpeechRequest();
+
+    /// Prepares the speech of a request from the cache or its provider. Runs on the request pool.
+    PrepareSpeechResult executePrepareSpeechRequest(const PrepareSpeechRequest& request);
+
     std::shared_ptr<aace::textToSpeech::TextToSpeech> m_textToSpeechPlatformInterface;
     std::weak_ptr<TextToSpeechServiceInterface> m_textToSpeechServiceInterface;
+    std::shared_ptr<SpeechCache> m_speechCache;
 
-    // executor for speech synthesis requests
+    // executor for capabilities requests
     aace::engine::utils::threading::Executor m_executor;
+
+    // the requests waiting for a worker of the request pool, and the latest unfinished request of each group
+    std::mutex m_requestMutex;
+    std::vector<std::shared_ptr<PrepareSpeechRequest>> m_pendingRequests;
+    std::unordered_map<std::string, std::shared_ptr<PrepareSpeechRequest>> m_requestGroups;
+    uint64_t m_nextRequestSequence;
+
+    // workers sending the speech synthesis requests, declared last so they stop before the other members are destroyed
+    std::shared_ptr<aace::engine::utils::threading::ThreadPool> m_requestPool;
 };
 
 }  // namespace textToSpeech
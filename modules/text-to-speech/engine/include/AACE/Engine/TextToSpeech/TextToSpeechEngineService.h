@@ -17,8 +17,10 @@
 #define AACE_ENGINE_TEXTTOSPEECH_TEXTTOSPEECH_ENGINE_SERVICE_H
 
 #include "AACE/Engine/Core/EngineService.h"
+#include "AACE/Engine/Utils/JSON/JSON.h"
 #include "AACE/TextToSpeech/TextToSpeech.h"
 
+#include "SpeechCache.h"
 #include "TextToSpeechEngineImpl.h"
 #include "TextToSpeechServiceInterface.h"
 #include "TextToSpeechSynthesizerInterface.h"
@@ -49,6 +51,7 @@ public:
 protected:
     bool registerPlatformInterface(std::shared_ptr<aace::core::PlatformInterface> platformInterface) override;
     bool initialize() override;
+    bool configureFromJson(const aace::engine::utils::json::Value& configuration) override;
     bool shutdown() override;
 
 private:
@@ -63,6 +66,8 @@ private:
 
 private:
     std::shared_ptr<TextToSpeechEngineImpl> m_textToSpeechEngineImpl;
+    std::shared_ptr<SpeechCache> m_speechCache;
+    size_t m_maxConcurrentRequests;
     std::mutex m_textToSpeechProviderMutex;
     std::string m_preferedProvider;
     // Map to store Text To Speech provider name and the associated Text To Speech Providers
@@ -0,0 +1,525 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "AACE/Engine/Core/EngineMacros.h"
+#include "AACE/Engine/TextToSpeech/SpeechCache.h"
+
+namespace aace {
+namespace engine {
+namespace textToSpeech {
+
+// String to identify log entries originating from this file.
+static const std::string TAG("aace.textToSpeech.SpeechCache");
+
+/// The first bytes of a speech file, with the version of its format
+static const char SPEECH_FILE_MAGIC[] = {'A', 'T', 'S', '1'};
+
+/// The extension of the speech files
+static const std::string SPEECH_FILE_EXTENSION = ".speech";
+
+/// The file listing the speech cached on disk, most recently used first
+static const std::string DISK_INDEX_FILENAME = "index";
+
+using AudioStream = aace::audio::AudioStream;
+using AudioFormat = aace::audio::AudioFormat;
+
+//
+// CachingAudioStream
+//
+
+class SpeechCache::CachingAudioStream : public AudioStream {
+public:
+    CachingAudioStream(
+        std::weak_ptr<SpeechCache> speechCache,
+        const std::string& key,
+        std::shared_ptr<Speech> speech,
+        std::shared_ptr<AudioStream> preparedAudio,
+        size_t maxSize) :
+            m_speechCache{speechCache},
+            m_key{key},
+            m_speech{speech},
+            m_preparedAudio{preparedAudio},
+            m_maxSize{maxSize},
+            m_discarded{false},
+            m_cached{false} {
+    }
+
+    ssize_t read(char* data, const size_t size) override {
+        auto count = m_preparedAudio->read(data, size);
+        append(data, count);
+        return count;
+    }
+
+    ssize_t timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) override {
+        auto count = m_preparedAudio->timedRead(data, size, timeout);
+        append(data, count);
+        return count;
+    }
+
+    bool isClosed() override {
+        auto closed = m_preparedAudio->isClosed();
+        if (closed) {
+            cache();
+        }
+        return closed;
+    }
+
+    Encoding getEncoding() override {
+        return m_speech->encoding;
+    }
+
+    AudioFormat getAudioFormat() override {
+        return m_speech->audioFormat;
+    }
+
+    MediaType getMediaType() override {
+        return m_speech->mediaType;
+    }
+
+    std::vector<aace::audio::AudioStreamProperty> getProperties() override {
+        return m_preparedAudio->getProperties();
+    }
+
+private:
+    void append(const char* data, ssize_t count) {
+        if (m_discarded || count == 0) {
+            return;
+        }
+        // a speech that failed or is too large is played, but not cached
+        if (count < 0 || m_audio.size() + count > m_maxSize) {
+            m_discarded = true;
+            std::string().swap(m_audio);
+            return;
+        }
+        m_audio.append(data, count);
+    }
+
+    void cache() {
+        if (m_cached || m_discarded || m_audio.empty()) {
+            return;
+        }
+        m_cached = true;
+        if (auto speechCache = m_speechCache.lock()) {
+            m_speech->audio = std::make_shared<const std::string>(std::move(m_audio));
+            speechCache->put(m_key, m_speech);
+        }
+    }
+
+    std::weak_ptr<SpeechCache> m_speechCache;
+    std::string m_key;
+    std::shared_ptr<Speech> m_speech;
+    std::shared_ptr<AudioStream> m_preparedAudio;
+    size_t m_maxSize;
+    std::string m_audio;
+    bool m_discarded;
+    bool m_cached;
+};
+
+//
+// CachedAudioStream
+//
+
+class SpeechCache::CachedAudioStream : public AudioStream {
+public:
+    CachedAudioStream(std::shared_ptr<const Speech> speech) : m_speech{speech}, m_offset{0} {
+    }
+
+    ssize_t read(char* data, const size_t size) override {
+        auto count = std::min(size, m_speech->audio->size() - m_offset);
+        std::memcpy(data, m_speech->audio->data() + m_offset, count);
+        m_offset += count;
+        return static_cast<ssize_t>(count);
+    }
+
+    ssize_t timedRead(char* data, const size_t size, std::chrono::milliseconds timeout) override {
+        // the cached audio is always available
+        return read(data, size);
+    }
+
+    bool isClosed() override {
+        return m_offset >= m_speech->audio->size();
+    }
+
+    Encoding getEncoding() override {
+        return m_speech->encoding;
+    }
+
+    AudioFormat getAudioFormat() override {
+        return m_speech->audioFormat;
+    }
+
+    MediaType getMediaType() override {
+        return m_speech->mediaType;
+    }
+
+private:
+    std::shared_ptr<const Speech> m_speech;
+    size_t m_offset;
+};
+
+//
+// SpeechCache
+//
+
+std::shared_ptr<SpeechCache> SpeechCache::create(const Configuration& configuration) {
+    try {
+        ThrowIf(configuration.maxMemorySize == 0 && configuration.maxDiskSize == 0, "invalidCacheSize");
+        ThrowIf(configuration.maxDiskSize > 0 && configuration.path.empty(), "invalidPath");
+        ThrowIf(configuration.maxEntrySize == 0, "invalidMaxEntrySize");
+
+        auto speechCache = std::shared_ptr<SpeechCache>(new SpeechCache(configuration));
+        if (configuration.maxDiskSize > 0) {
+            speechCache->loadDiskIndex();
+        }
+
+        return speechCache;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "create").d("reason", ex.what()));
+        return nullptr;
+    }
+}
+
+SpeechCache::SpeechCache(const Configuration& configuration) :
+        m_configuration{configuration}, m_memorySize{0}, m_diskSize{0} {
+}
+
+std::shared_ptr<AudioStream> SpeechCache::get(
+    const std::string& provider,
+    const std::string& text,
+    const std::string& requestPayload,
+    std::string& metadata) {
+    auto identity = makeIdentity(provider, text, requestPayload);
+    auto key = makeKey(identity);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto diskIt = m_diskIndex.find(key);
+    if (diskIt != m_diskIndex.end()) {
+        m_diskEntries.splice(m_diskEntries.begin(), m_diskEntries, diskIt->second);
+    }
+
+    auto memoryIt = m_memoryIndex.find(key);
+    if (memoryIt != m_memoryIndex.end()) {
+        m_memoryEntries.splice(m_memoryEntries.begin(), m_memoryEntries, memoryIt->second);
+        auto speech = memoryIt->second->second;
+        if (speech->identity == identity) {
+            metadata = speech->metadata;
+            return std::make_shared<CachedAudioStream>(speech);
+        }
+    }
+
+    if (diskIt == m_diskIndex.end()) {
+        return nullptr;
+    }
+
+    // the speech is read from disk without holding the lock, and kept in memory for the next requests
+    lock.unlock();
+    auto speech = readSpeech(getSpeechPath(key));
+    if (speech == nullptr || speech->identity != identity) {
+        return nullptr;
+    }
+    if (speech->audio->size() <= m_configuration.maxMemorySize) {
+        lock.lock();
+        putInMemoryLocked(key, speech);
+        saveDiskIndexLocked();
+        lock.unlock();
+    }
+    metadata = speech->metadata;
+    return std::make_shared<CachedAudioStream>(speech);
+}
+
+std::shared_ptr<AudioStream> SpeechCache::wrap(
+    const std::string& provider,
+    const std::string& text,
+    const std::string& requestPayload,
+    std::shared_ptr<AudioStream> preparedAudio,
+    const std::string& metadata) {
+    if (preparedAudio == nullptr) {
+        return nullptr;
+    }
+    auto speech = std::make_shared<Speech>();
+    speech->identity = makeIdentity(provider, text, requestPayload);
+    speech->metadata = metadata;
+    speech->encoding = preparedAudio->getEncoding();
+    speech->audioFormat = preparedAudio->getAudioFormat();
+    speech->mediaType = preparedAudio->getMediaType();
+    auto key = makeKey(speech->identity);
+    return std::make_shared<CachingAudioStream>(
+        shared_from_this(), key, speech, preparedAudio, m_configuration.maxEntrySize);
+}
+
+size_t SpeechCache::getMemorySize() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memorySize;
+}
+
+size_t SpeechCache::getDiskSize() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_diskSize;
+}
+
+void SpeechCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_memoryEntries.clear();
+    m_memoryIndex.clear();
+    m_memorySize = 0;
+    for (const auto& entry : m_diskEntries) {
+        std::remove(getSpeechPath(entry.key).c_str());
+    }
+    m_diskEntries.clear();
+    m_diskIndex.clear();
+    m_diskSize = 0;
+    if (m_configuration.maxDiskSize > 0) {
+        saveDiskIndexLocked();
+    }
+}
+
+void SpeechCache::put(const std::string& key, std::shared_ptr<const Speech> speech) {
+    try {
+        auto size = speech->audio->size();
+        bool onDisk = false;
+        if (m_configuration.maxDiskSize > 0 && size <= m_configuration.maxDiskSize) {
+            // the file is written before the speech is indexed, so the index never lists a partial file
+            onDisk = writeSpeech(getSpeechPath(key), *speech);
+            if (!onDisk) {
+                AACE_WARN(LX(TAG, "put").d("reason", "writeSpeechFailed").d("key", key));
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (size <= m_configuration.maxMemorySize) {
+            putInMemoryLocked(key, speech);
+        }
+        if (onDisk) {
+            auto it = m_diskIndex.find(key);
+            if (it != m_diskIndex.end()) {
+                m_diskSize -= it->second->size;
+                m_diskEntries.erase(it->second);
+            }
+            m_diskEntries.push_front({key, size});
+            m_diskIndex[key] = m_diskEntries.begin();
+            m_diskSize += size;
+            while (m_diskSize > m_configuration.maxDiskSize) {
+                const auto& entry = m_diskEntries.back();
+                std::remove(getSpeechPath(entry.key).c_str());
+                m_diskSize -= entry.size;
+                m_diskIndex.erase(entry.key);
+                m_diskEntries.pop_back();
+            }
+            saveDiskIndexLocked();
+        }
+        AACE_DEBUG(LX(TAG, "put")
+                       .d("key", key)
+                       .d("size", size)
+                       .d("memorySize", m_memorySize)
+                       .d("diskSize", m_diskSize));
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "put").d("reason", ex.what()));
+    }
+}
+
+void SpeechCache::putInMemoryLocked(const std::string& key, std::shared_ptr<const Speech> speech) {
+    auto it = m_memoryIndex.find(key);
+    if (it != m_memoryIndex.end()) {
+        m_memorySize -= it->second->second->audio->size();
+        m_memoryEntries.erase(it->second);
+    }
+    m_memoryEntries.emplace_front(key, speech);
+    m_memoryIndex[key] = m_memoryEntries.begin();
+    m_memorySize += speech->audio->size();
+    while (m_memorySize > m_configuration.maxMemorySize) {
+        const auto& entry = m_memoryEntries.back();
+        m_memorySize -= entry.second->audio->size();
+        m_memoryIndex.erase(entry.first);
+        m_memoryEntries.pop_back();
+    }
+}
+
+void SpeechCache::loadDiskIndex() {
+    std::ifstream index(m_configuration.path + "/" + DISK_INDEX_FILENAME);
+    if (!index.is_open()) {
+        return;
+    }
+    std::string key;
+    size_t size;
+    while (index >> key >> size) {
+        if (m_diskIndex.find(key) != m_diskIndex.end()) {
+            continue;
+        }
+        // the least recently used speech of a previous configuration with a larger limit is removed
+        if (m_diskSize + size > m_configuration.maxDiskSize) {
+            std::remove(getSpeechPath(key).c_str());
+            continue;
+        }
+        m_diskEntries.push_back({key, size});
+        m_diskIndex[key] = std::prev(m_diskEntries.end());
+        m_diskSize += size;
+    }
+    AACE_INFO(LX(TAG).d("diskEntries", m_diskEntries.size()).d("diskSize", m_diskSize));
+}
+
+void SpeechCache::saveDiskIndexLocked() {
+    auto path = m_configuration.path + "/" + DISK_INDEX_FILENAME;
+    auto tempPath = path + ".tmp";
+    {
+        std::ofstream index(tempPath, std::ios::trunc);
+        for (const auto& entry : m_diskEntries) {
+            index << entry.key << ' ' << entry.size << '\n';
+        }
+        if (!index.good()) {
+            AACE_WARN(LX(TAG).d("reason", "writeDiskIndexFailed"));
+            return;
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        AACE_WARN(LX(TAG).d("reason", "renameDiskIndexFailed"));
+        std::remove(tempPath.c_str());
+    }
+}
+
+std::string SpeechCache::getSpeechPath(const std::string& key) const {
+    return m_configuration.path + "/" + key + SPEECH_FILE_EXTENSION;
+}
+
+static void writeUint32(std::ostream& stream, uint32_t value) {
+    char bytes[4] = {static_cast<char>(value & 0xff),
+                     static_cast<char>((value >> 8) & 0xff),
+                     static_cast<char>((value >> 16) & 0xff),
+                     static_cast<char>((value >> 24) & 0xff)};
+    stream.write(bytes, sizeof(bytes));
+}
+
+static bool readUint32(std::istream& stream, uint32_t& value) {
+    unsigned char bytes[4];
+    if (!stream.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+        return false;
+    }
+    value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    return true;
+}
+
+static void writeString(std::ostream& stream, const std::string& value) {
+    writeUint32(stream, static_cast<uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+}
+
+static bool readString(std::istream& stream, std::string& value) {
+    uint32_t size;
+    if (!readUint32(stream, size)) {
+        return false;
+    }
+    value.resize(size);
+    return size == 0 || static_cast<bool>(stream.read(&value[0], size));
+}
+
+bool SpeechCache::writeSpeech(const std::string& path, const Speech& speech) {
+    auto tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        auto audioFormat = speech.audioFormat;
+        file.write(SPEECH_FILE_MAGIC, sizeof(SPEECH_FILE_MAGIC));
+        writeString(file, speech.identity);
+        writeString(file, speech.metadata);
+        writeUint32(file, static_cast<uint32_t>(speech.encoding));
+        writeUint32(file, static_cast<uint32_t>(audioFormat.getEncoding()));
+        writeUint32(file, static_cast<uint32_t>(audioFormat.getSampleFormat()));
+        writeUint32(file, static_cast<uint32_t>(audioFormat.getLayout()));
+        writeUint32(file, static_cast<uint32_t>(audioFormat.getEndianness()));
+        writeUint32(file, audioFormat.getSampleRate());
+        writeUint32(file, audioFormat.getSampleSize());
+        writeUint32(file, audioFormat.getNumChannels());
+        writeUint32(file, static_cast<uint32_t>(speech.mediaType));
+        writeString(file, *speech.audio);
+        if (!file.good()) {
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const SpeechCache::Speech> SpeechCache::readSpeech(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return nullptr;
+    }
+    char magic[sizeof(SPEECH_FILE_MAGIC)];
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, SPEECH_FILE_MAGIC, sizeof(magic)) != 0) {
+        AACE_WARN(LX(TAG, "readSpeech").d("reason", "invalidSpeechFile").d("path", path));
+        return nullptr;
+    }
+    auto speech = std::make_shared<Speech>();
+    uint32_t fields[9];
+    auto audio = std::make_shared<std::string>();
+    bool valid = readString(file, speech->identity) && readString(file, speech->metadata);
+    for (auto& field : fields) {
+        valid = valid && readUint32(file, field);
+    }
+    valid = valid && readString(file, *audio);
+    if (!valid) {
+        AACE_WARN(LX(TAG, "readSpeech").d("reason", "truncatedSpeechFile").d("path", path));
+        return nullptr;
+    }
+    speech->encoding = static_cast<AudioStream::Encoding>(fields[0]);
+    speech->audioFormat = AudioFormat(
+        static_cast<AudioFormat::Encoding>(fields[1]),
+        static_cast<AudioFormat::SampleFormat>(fields[2]),
+        static_cast<AudioFormat::Layout>(fields[3]),
+        static_cast<AudioFormat::Endianness>(fields[4]),
+        fields[5],
+        static_cast<uint8_t>(fields[6]),
+        static_cast<uint8_t>(fields[7]));
+    speech->mediaType = static_cast<AudioStream::MediaType>(fields[8]);
+    speech->audio = audio;
+    return speech;
+}
+
+std::string SpeechCache::makeIdentity(
+    const std::string& provider,
+    const std::string& text,
+    const std::string& requestPayload) {
+    // the lengths keep the parts apart, so no two requests share an identity
+    std::ostringstream identity;
+    identity << provider.size() << ':' << provider << text.size() << ':' << text << requestPayload;
+    return identity.str();
+}
+
+std::string SpeechCache::makeKey(const std::string& identity) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : identity) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+    return key;
+}
+
+}  // namespace textToSpeech
+}  // namespace engine
+}  // namespace aace
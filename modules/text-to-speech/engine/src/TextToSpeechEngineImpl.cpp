@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <unordered_map>
 
 #include "AACE/Engine/Core/EngineMacros.h"
@@ -40,9 +41,18 @@ static const std::string REQUEST_TIMED_OUT = "REQUEST_TIMED_OUT";
 // Error string for internal error
 static const std::string INTERNAL_ERROR = "INTERNAL_ERROR";
 
+// Error string for a request replaced by a later request of its group
+static const std::string REQUEST_SUPERSEDED = "REQUEST_SUPERSEDED";
+
 // String to identify the request payload key in the options parameter passed for a speech synthesis request
 static const std::string REQUEST_PAYLOAD_KEY = "requestPayload";
 
+// String to identify the priority key in the options, the requests with a higher priority are prepared first
+static const std::string PRIORITY_KEY = "priority";
+
+// String to identify the group key in the options, a request supersedes the earlier request of its group
+static const std::string GROUP_KEY = "group";
+
 static const std::string EMPTY_STRING = "";
 
 /// Program Name suffix for metrics
@@ -53,29 +63,39 @@ static const std::string METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH = "PrepareSpeech";
 static const std::string METRIC_TEXT_TO_SPEECH_GET_CAPABILITIES = "GetCapabilities";
 static const std::string METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_COMPLETED = "PrepareSpeechCompleted";
 static const std::string METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_FAILED = "PrepareSpeechFailed";
+static const std::string METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_CACHE_HIT = "PrepareSpeechCacheHit";
 static const std::string METRIC_TEXT_TO_SPEECH_CAPABILITIES_RECEIVED = "CapabilitiesReceived";
 
 TextToSpeechEngineImpl::TextToSpeechEngineImpl(
     std::shared_ptr<aace::textToSpeech::TextToSpeech> textToSpeechPlatformInterface) :
-        m_textToSpeechPlatformInterface(textToSpeechPlatformInterface) {
+        m_textToSpeechPlatformInterface(textToSpeechPlatformInterface), m_nextRequestSequence(0) {
 }
 
-bool TextToSpeechEngineImpl::initialize(std::shared_ptr<TextToSpeechServiceInterface> textToSpeechServiceInterface) {
+bool TextToSpeechEngineImpl::initialize(
+    std::shared_ptr<TextToSpeechServiceInterface> textToSpeechServiceInterface,
+    std::shared_ptr<SpeechCache> speechCache,
+    size_t maxConcurrentRequests) {
     m_textToSpeechServiceInterface = textToSpeechServiceInterface;
-    return true;
+    m_speechCache = speechCache;
+    m_requestPool = aace::engine::utils::threading::ThreadPool::create(maxConcurrentRequests);
+    return m_requestPool != nullptr;
 }
 
 std::shared_ptr<TextToSpeechEngineImpl> TextToSpeechEngineImpl::create(
     std::shared_ptr<aace::textToSpeech::TextToSpeech> textToSpeechPlatformInterface,
-    std::shared_ptr<TextToSpeechServiceInterface> textToSpeechServiceInterface) {
+    std::shared_ptr<TextToSpeechServiceInterface> textToSpeechServiceInterface,
+    std::shared_ptr<SpeechCache> speechCache,
+    size_t maxConcurrentRequests) {
     try {
         ThrowIfNull(textToSpeechPlatformInterface, "nullTextToSpeechPlatformInterface");
         ThrowIfNull(textToSpeechServiceInterface, "nullTextToSpeechServiceInterface");
+        ThrowIf(maxConcurrentRequests == 0, "invalidMaxConcurrentRequests");
         auto textToSpeechEngineImpl =
             std::shared_ptr<TextToSpeechEngineImpl>(new TextToSpeechEngineImpl(textToSpeechPlatformInterface));
 
         ThrowIfNot(
-            textToSpeechEngineImpl->initialize(textToSpeechServiceInterface), "initializeTextToSpeechEngineImplFailed");
+            textToSpeechEngineImpl->initialize(textToSpeechServiceInterface, speechCache, maxConcurrentRequests),
+            "initializeTextToSpeechEngineImplFailed");
 
         // Set the Engine Interface reference
         textToSpeechPlatformInterface->setEngineInterface(textToSpeechEngineImpl);
@@ -105,7 +125,7 @@ bool TextToSpeechEngineImpl::onPrepareSpeech(
         ThrowIfNull(m_textToSpeechServiceInterface_lock, "nullTextToSpeechServiceInterface");
         auto textToSpeechProvider = m_textToSpeechServiceInterface_lock->getTextToSpeechProvider(provider);
         ThrowIfNull(textToSpeechProvider, "nullTextToSpeechProvider");
-        return executeOnPrepareSpeech(speechId, text, textToSpeechProvider, options);
+        return executeOnPrepareSpeech(speechId, text, provider, textToSpeechProvider, options);
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
         return false;
@@ -129,68 +149,64 @@ bool TextToSpeechEngineImpl::onGetCapabilities(const std::string& requestId, con
 bool TextToSpeechEngineImpl::executeOnPrepareSpeech(
     const std::string& speechId,
     const std::string& text,
+    const std::string& provider,
     std::shared_ptr<TextToSpeechSynthesizerInterface> textToSpeechProvider,
     const std::string& options) {
     try {
         AACE_INFO(LX(TAG));
         ThrowIfNull(m_textToSpeechPlatformInterface, "nullTextToSpeechPlatformInterface");
-        auto textToSpeechPlatformInterface = m_textToSpeechPlatformInterface;
-        std::string requestPayload;
-        std::string requestTimeout;
+        auto request = std::make_shared<PrepareSpeechRequest>();
+        request->speechId = speechId;
+        request->text = text;
+        request->provider = provider;
+        request->textToSpeechProvider = textToSpeechProvider;
+        request->textToSpeechPlatformInterface = m_textToSpeechPlatformInterface;
+        request->priority = 0;
+        request->superseded = false;
         if (!options.empty()) {
             nlohmann::json optionsPayload = nlohmann::json::parse(options);
             if (optionsPayload.contains(REQUEST_PAYLOAD_KEY)) {
-                requestPayload = optionsPayload.at(REQUEST_PAYLOAD_KEY).dump();
+                request->requestPayload = optionsPayload.at(REQUEST_PAYLOAD_KEY).dump();
             } else {
-                requestPayload = options;
+                request->requestPayload = options;
+            }
+            if (optionsPayload.is_object()) {
+                request->priority = optionsPayload.value(PRIORITY_KEY, 0);
+                request->group = optionsPayload.value(GROUP_KEY, EMPTY_STRING);
             }
         }
-        m_executor.submit(
-            [speechId, text, textToSpeechProvider, requestTimeout, requestPayload, textToSpeechPlatformInterface] {
-                try {
-                    AACE_DEBUG(LX(TAG).m("Executing prepare speech"));
-                    auto prepareSpeechFuture = textToSpeechProvider->prepareSpeech(speechId, text, requestPayload);
-                    auto status = prepareSpeechFuture.wait_for(DEFAULT_REQUEST_TIMEOUT);
-                    if (status == std::future_status::timeout) {
-                        emitCounterMetrics(
-                            METRIC_PROGRAM_NAME_SUFFIX,
-                            "executeOnPrepareSpeech",
-                            METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_FAILED,
-                            1);
-                        textToSpeechPlatformInterface->prepareSpeechFailed(speechId, REQUEST_TIMED_OUT);
-                    } else {
-                        auto prepareSpeechResult = prepareSpeechFuture.get();
-                        auto speechId = prepareSpeechResult.getSpeechId();
-                        auto failureReason = prepareSpeechResult.getFailureReason();
-                        auto metadata = prepareSpeechResult.getSpeechMetadata();
-                        auto synthesizedSpeech = prepareSpeechResult.getPreparedAudio();
-                        if (!failureReason.empty()) {
-                            emitCounterMetrics(
-                                METRIC_PROGRAM_NAME_SUFFIX,
-                                "executeOnPrepareSpeech",
-                                METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_FAILED,
-                                1);
-                            textToSpeechPlatformInterface->prepareSpeechFailed(speechId, failureReason);
-                        } else {
-                            emitCounterMetrics(
-                                METRIC_PROGRAM_NAME_SUFFIX,
-                                "executeOnPrepareSpeech",
-                                METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_COMPLETED,
-                                1);
-                            textToSpeechPlatformInterface->prepareSpeechCompleted(
-                                speechId, synthesizedSpeech, metadata);
-                        }
-                    }
-                } catch (std::exception& ex) {
-                    AACE_ERROR(LX(TAG).d("reason", ex.what()));
-                    emitCounterMetrics(
-                        METRIC_PROGRAM_NAME_SUFFIX,
-                        "executeOnPrepareSpeech",
-                        METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_FAILED,
-                        1);
-                    textToSpeechPlatformInterface->prepareSpeechFailed(speechId, INTERNAL_ERROR);
+
+        // a request replaces the earlier request of its group that hasn't completed
+        std::shared_ptr<PrepareSpeechRequest> supersededRequest;
+        {
+            std::lock_guard<std::mutex> lock(m_requestMutex);
+            request->sequence = m_nextRequestSequence++;
+            if (!request->group.empty()) {
+                auto it = m_requestGroups.find(request->group);
+                if (it != m_requestGroups.end()) {
+                    supersededRequest = it->second;
+                    supersededRequest->superseded = true;
+                    m_pendingRequests.erase(
+                        std::remove(m_pendingRequests.begin(), m_pendingRequests.end(), supersededRequest),
+                        m_pendingRequests.end());
                 }
-            });
+                m_requestGroups[request->group] = request;
+            }
+            m_pendingRequests.push_back(request);
+        }
+        if (supersededRequest != nullptr) {
+            AACE_INFO(LX(TAG)
+                          .m("Superseded prepare speech request")
+                          .sensitive("speechId", supersededRequest->speechId)
+                          .d("group", supersededRequest->group));
+            emitCounterMetrics(
+                METRIC_PROGRAM_NAME_SUFFIX, "executeOnPrepareSpeech", METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_FAILED, 1);
+            supersededRequest->textToSpeechPlatformInterface->prepareSpeechFailed(
+                supersededRequest->speechId, REQUEST_SUPERSEDED);
+        }
+
+        // each request queues a task, which runs the request with the highest priority when a worker is available
+        ThrowIfNot(m_requestPool->post([this] { executeNextPrepareSpeechRequest(); }), "postRequestFailed");
         return true;
     } catch (std::exception& ex) {
         AACE_ERROR(LX(TAG).d("reason", ex.what()));
@@ -198,6 +214,95 @@ bool TextToSpeechEngineImpl::executeOnPrepareSpeech(
     }
 }
 
+void TextToSpeechEngineImpl::executeNextPrepareSpeechRequest() {
+    std::shared_ptr<PrepareSpeechRequest> request;
+    {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+        if (m_pendingRequests.empty()) {
+            // the request of this task was superseded before it ran
+            return;
+        }
+        auto it = std::max_element(
+            m_pendingRequests.begin(),
+            m_pendingRequests.end(),
+            [](const std::shared_ptr<PrepareSpeechRequest>& a, const std::shared_ptr<PrepareSpeechRequest>& b) {
+                return a->priority < b->priority || (a->priority == b->priority && a->sequence > b->sequence);
+            });
+        request = *it;
+        m_pendingRequests.erase(it);
+    }
+
+    auto result = executePrepareSpeechRequest(*request);
+
+    {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+        if (request->superseded) {
+            // the failure of the superseded request was reported when it was superseded
+            AACE_DEBUG(LX(TAG).m("Dropping superseded prepare speech result").sensitive("speechId", request->speechId));
+            return;
+        }
+        auto it = m_requestGroups.find(request->group);
+        if (it != m_requestGroups.end() && it->second == request) {
+            m_requestGroups.erase(it);
+        }
+    }
+
+    auto failureReason = result.getFailureReason();
+    if (!failureReason.empty()) {
+        emitCounterMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX, "executeOnPrepareSpeech", METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_FAILED, 1);
+        request->textToSpeechPlatformInterface->prepareSpeechFailed(request->speechId, failureReason);
+    } else {
+        emitCounterMetrics(
+            METRIC_PROGRAM_NAME_SUFFIX, "executeOnPrepareSpeech", METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_COMPLETED, 1);
+        request->textToSpeechPlatformInterface->prepareSpeechCompleted(
+            request->speechId, result.getPreparedAudio(), result.getSpeechMetadata());
+    }
+}
+
+PrepareSpeechResult TextToSpeechEngineImpl::executePrepareSpeechRequest(const PrepareSpeechRequest& request) {
+    try {
+        // a speech prepared before is played from the cache without a request to the provider
+        if (m_speechCache != nullptr) {
+            std::string cachedMetadata;
+            auto cachedSpeech =
+                m_speechCache->get(request.provider, request.text, request.requestPayload, cachedMetadata);
+            if (cachedSpeech != nullptr) {
+                AACE_DEBUG(LX(TAG).m("Prepared speech from cache"));
+                emitCounterMetrics(
+                    METRIC_PROGRAM_NAME_SUFFIX,
+                    "executeOnPrepareSpeech",
+                    METRIC_TEXT_TO_SPEECH_PREPARE_SPEECH_CACHE_HIT,
+                    1);
+                return PrepareSpeechResult(request.speechId, cachedSpeech, cachedMetadata);
+            }
+        }
+        AACE_DEBUG(LX(TAG).m("Executing prepare speech"));
+        auto prepareSpeechFuture =
+            request.textToSpeechProvider->prepareSpeech(request.speechId, request.text, request.requestPayload);
+        auto status = prepareSpeechFuture.wait_for(DEFAULT_REQUEST_TIMEOUT);
+        if (status == std::future_status::timeout) {
+            return PrepareSpeechResult(request.speechId, nullptr, EMPTY_STRING, REQUEST_TIMED_OUT);
+        }
+        auto prepareSpeechResult = prepareSpeechFuture.get();
+        auto synthesizedSpeech = prepareSpeechResult.getPreparedAudio();
+        if (prepareSpeechResult.getFailureReason().empty() && m_speechCache != nullptr &&
+            synthesizedSpeech != nullptr) {
+            // the speech streams to the platform as the provider prepares it, and is cached once it is read
+            prepareSpeechResult.setPreparedAudio(m_speechCache->wrap(
+                request.provider,
+                request.text,
+                request.requestPayload,
+                synthesizedSpeech,
+                prepareSpeechResult.getSpeechMetadata()));
+        }
+        return prepareSpeechResult;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG).d("reason", ex.what()));
+        return PrepareSpeechResult(request.speechId, nullptr, EMPTY_STRING, INTERNAL_ERROR);
+    }
+}
+
 bool TextToSpeechEngineImpl::executeOnGetCapabilities(
     const std::string& requestId,
     std::shared_ptr<TextToSpeechSynthesizerInterface> textToSpeechProvider) {
@@ -239,6 +344,9 @@ void TextToSpeechEngineImpl::shutdown() {
         m_textToSpeechPlatformInterface.reset();
     }
     m_executor.shutdown();
+    if (m_requestPool != nullptr) {
+        m_requestPool->shutdown();
+    }
 }
 
 }  // namespace textToSpeech
@@ -23,11 +23,14 @@ namespace textToSpeech {
 // String to identify log entries originating from this file.
 static const std::string TAG("aace.textToSpeech.TextToSpeechEngineService");
 
+namespace json = aace::engine::utils::json;
+
 // register the service
 REGISTER_SERVICE(TextToSpeechEngineService);
 
 TextToSpeechEngineService::TextToSpeechEngineService(const aace::engine::core::ServiceDescription& description) :
-        aace::engine::core::EngineService(description) {
+        aace::engine::core::EngineService(description),
+        m_maxConcurrentRequests(TextToSpeechEngineImpl::DEFAULT_MAX_CONCURRENT_REQUESTS) {
 }
 
 bool TextToSpeechEngineService::initialize() {
@@ -43,12 +46,41 @@ bool TextToSpeechEngineService::initialize() {
     }
 }
 
+bool TextToSpeechEngineService::configureFromJson(const json::Value& configuration) {
+    try {
+        // the number of prepare speech requests sent to the providers at the same time
+        m_maxConcurrentRequests =
+            json::get(configuration, "/maxConcurrentRequests", (uint64_t)m_maxConcurrentRequests);
+        ThrowIf(m_maxConcurrentRequests == 0, "invalidMaxConcurrentRequests");
+
+        // cache the prepared speech, so repeated prompts play without a request to the provider
+        auto speechCache = json::get(configuration, "/speechCache", json::Type::object);
+        if (speechCache != nullptr) {
+            SpeechCache::Configuration speechCacheConfiguration;
+            speechCacheConfiguration.maxMemorySize =
+                json::get(speechCache, "/maxMemorySize", (uint64_t)speechCacheConfiguration.maxMemorySize);
+            speechCacheConfiguration.maxDiskSize =
+                json::get(speechCache, "/maxDiskSize", (uint64_t)speechCacheConfiguration.maxDiskSize);
+            speechCacheConfiguration.maxEntrySize =
+                json::get(speechCache, "/maxEntrySize", (uint64_t)speechCacheConfiguration.maxEntrySize);
+            speechCacheConfiguration.path = json::get(speechCache, "/path", speechCacheConfiguration.path);
+            m_speechCache = SpeechCache::create(speechCacheConfiguration);
+            ThrowIfNull(m_speechCache, "createSpeechCacheFailed");
+        }
+        return true;
+    } catch (std::exception& ex) {
+        AACE_ERROR(LX(TAG, "configureFromJson").d("reason", ex.what()));
+        return false;
+    }
+}
+
 bool TextToSpeechEngineService::shutdown() {
     AACE_INFO(LX(TAG));
     if (m_textToSpeechEngineImpl != nullptr) {
         m_textToSpeechEngineImpl->shutdown();
         m_textToSpeechEngineImpl.reset();
     }
+    m_speechCache.reset();
     m_registeredTextToSpeechProviders.clear();
     return true;
 }
@@ -70,8 +102,8 @@ bool TextToSpeechEngineService::registerPlatformInterfaceType(
     try {
         ThrowIfNotNull(m_textToSpeechEngineImpl, "platformInterfaceAlreadyRegistered");
 
-        m_textToSpeechEngineImpl =
-            aace::engine::textToSpeech::TextToSpeechEngineImpl::create(textToSpeech, shared_from_this());
+        m_textToSpeechEngineImpl = aace::engine::textToSpeech::TextToSpeechEngineImpl::create(
+            textToSpeech, shared_from_this(), m_speechCache, m_maxConcurrentRequests);
         ThrowIfNull(m_textToSpeechEngineImpl, "createTextToSpeechEngineImplFailed");
 
         return true;
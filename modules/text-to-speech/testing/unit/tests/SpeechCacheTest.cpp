@@ -0,0 +1,227 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <string>
+
+#include <unistd.h>
+
+#include <AACE/Engine/TextToSpeech/SpeechCache.h>
+
+namespace aace {
+namespace test {
+namespace unit {
+namespace textToSpeech {
+
+using aace::engine::textToSpeech::SpeechCache;
+
+/**
+ * Audio stream returning its audio a few bytes at a time, as a provider streams it.
+ */
+class FakeAudioStream : public aace::audio::AudioStream {
+public:
+    FakeAudioStream(const std::string& audio) : m_audio{audio}, m_offset{0} {
+    }
+
+    ssize_t read(char* data, const size_t size) override {
+        auto count = std::min(std::min(size, (size_t)7), m_audio.size() - m_offset);
+        m_audio.copy(data, count, m_offset);
+        m_offset += count;
+        return count;
+    }
+
+    bool isClosed() override {
+        return m_offset == m_audio.size();
+    }
+
+    MediaType getMediaType() override {
+        return MediaType::MPEG;
+    }
+
+private:
+    std::string m_audio;
+    size_t m_offset;
+};
+
+class SpeechCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char path[] = "/tmp/aace-speech-cache-XXXXXX";
+        ASSERT_NE(mkdtemp(path), nullptr);
+        m_path = path;
+    }
+
+    void TearDown() override {
+        // the cache removes its speech files, and leaves its empty index
+        if (auto speechCache = SpeechCache::create(diskConfiguration())) {
+            speechCache->clear();
+        }
+        unlink((m_path + "/index").c_str());
+        rmdir(m_path.c_str());
+    }
+
+    SpeechCache::Configuration diskConfiguration() {
+        SpeechCache::Configuration configuration;
+        configuration.maxMemorySize = 1024;
+        configuration.maxDiskSize = 1024;
+        configuration.path = m_path;
+        return configuration;
+    }
+
+    static std::string readAll(std::shared_ptr<aace::audio::AudioStream> stream) {
+        std::string audio;
+        char buffer[16];
+        while (!stream->isClosed()) {
+            auto count = stream->read(buffer, sizeof(buffer));
+            if (count <= 0) {
+                break;
+            }
+            audio.append(buffer, count);
+        }
+        return audio;
+    }
+
+    static void prepare(
+        std::shared_ptr<SpeechCache> speechCache,
+        const std::string& text,
+        const std::string& payload,
+        const std::string& audio) {
+        auto stream =
+            speechCache->wrap("provider", text, payload, std::make_shared<FakeAudioStream>(audio), "metadata");
+        ASSERT_EQ(audio, readAll(stream));
+    }
+
+    std::string m_path;
+};
+
+TEST_F(SpeechCacheTest, createWithInvalidConfiguration) {
+    SpeechCache::Configuration configuration;
+    configuration.maxMemorySize = 0;
+    EXPECT_EQ(nullptr, SpeechCache::create(configuration));
+
+    configuration.maxDiskSize = 1024;
+    EXPECT_EQ(nullptr, SpeechCache::create(configuration)) << "The disk tier requires a path";
+}
+
+TEST_F(SpeechCacheTest, speechIsCachedOnceReadToTheEnd) {
+    SpeechCache::Configuration configuration;
+    auto speechCache = SpeechCache::create(configuration);
+    ASSERT_NE(nullptr, speechCache);
+
+    std::string metadata;
+    auto stream = speechCache->wrap(
+        "provider", "Turn left", "{}", std::make_shared<FakeAudioStream>("turn-left-audio"), "metadata");
+    char buffer[4];
+    ASSERT_EQ(4, stream->read(buffer, sizeof(buffer)));
+    EXPECT_EQ(nullptr, speechCache->get("provider", "Turn left", "{}", metadata));
+
+    readAll(stream);
+    auto cached = speechCache->get("provider", "Turn left", "{}", metadata);
+    ASSERT_NE(nullptr, cached);
+    EXPECT_EQ("metadata", metadata);
+    EXPECT_EQ(aace::audio::AudioStream::MediaType::MPEG, cached->getMediaType());
+    EXPECT_EQ("turn-left-audio", readAll(cached));
+    EXPECT_TRUE(cached->isClosed());
+}
+
+TEST_F(SpeechCacheTest, keyIncludesProviderTextAndPayload) {
+    SpeechCache::Configuration configuration;
+    auto speechCache = SpeechCache::create(configuration);
+    ASSERT_NE(nullptr, speechCache);
+    prepare(speechCache, "Turn left", "{\"voiceId\":\"A\"}", "voice-a");
+
+    std::string metadata;
+    EXPECT_EQ(nullptr, speechCache->get("provider", "Turn left", "{\"voiceId\":\"B\"}", metadata));
+    EXPECT_EQ(nullptr, speechCache->get("provider", "Turn right", "{\"voiceId\":\"A\"}", metadata));
+    EXPECT_EQ(nullptr, speechCache->get("other", "Turn left", "{\"voiceId\":\"A\"}", metadata));
+    EXPECT_NE(nullptr, speechCache->get("provider", "Turn left", "{\"voiceId\":\"A\"}", metadata));
+}
+
+TEST_F(SpeechCacheTest, leastRecentlyUsedSpeechIsEvicted) {
+    SpeechCache::Configuration configuration;
+    configuration.maxMemorySize = 20;
+    auto speechCache = SpeechCache::create(configuration);
+    ASSERT_NE(nullptr, speechCache);
+    prepare(speechCache, "one", "", "0123456789");
+    prepare(speechCache, "two", "", "0123456789");
+
+    // using the first speech makes the second one the least recently used
+    std::string metadata;
+    EXPECT_NE(nullptr, speechCache->get("provider", "one", "", metadata));
+    prepare(speechCache, "three", "", "0123456789");
+
+    EXPECT_EQ(20u, speechCache->getMemorySize());
+    EXPECT_NE(nullptr, speechCache->get("provider", "one", "", metadata));
+    EXPECT_EQ(nullptr, speechCache->get("provider", "two", "", metadata));
+    EXPECT_NE(nullptr, speechCache->get("provider", "three", "", metadata));
+}
+
+TEST_F(SpeechCacheTest, speechLargerThanTheEntryLimitIsNotCached) {
+    SpeechCache::Configuration configuration;
+    configuration.maxEntrySize = 8;
+    auto speechCache = SpeechCache::create(configuration);
+    ASSERT_NE(nullptr, speechCache);
+    prepare(speechCache, "long", "", "0123456789");
+
+    std::string metadata;
+    EXPECT_EQ(nullptr, speechCache->get("provider", "long", "", metadata));
+    EXPECT_EQ(0u, speechCache->getMemorySize());
+}
+
+TEST_F(SpeechCacheTest, diskTierKeepsSpeechAcrossInstances) {
+    {
+        auto speechCache = SpeechCache::create(diskConfiguration());
+        ASSERT_NE(nullptr, speechCache);
+        prepare(speechCache, "Parking assist on", "{\"locale\":\"en-US\"}", "parking-assist-audio");
+        EXPECT_EQ(20u, speechCache->getDiskSize());
+    }
+
+    auto speechCache = SpeechCache::create(diskConfiguration());
+    ASSERT_NE(nullptr, speechCache);
+    EXPECT_EQ(0u, speechCache->getMemorySize());
+    EXPECT_EQ(20u, speechCache->getDiskSize());
+
+    std::string metadata;
+    auto cached = speechCache->get("provider", "Parking assist on", "{\"locale\":\"en-US\"}", metadata);
+    ASSERT_NE(nullptr, cached);
+    EXPECT_EQ("metadata", metadata);
+    EXPECT_EQ(aace::audio::AudioStream::MediaType::MPEG, cached->getMediaType());
+    EXPECT_EQ("parking-assist-audio", readAll(cached));
+    EXPECT_EQ(20u, speechCache->getMemorySize());
+}
+
+TEST_F(SpeechCacheTest, diskTierEvictsLeastRecentlyUsedSpeech) {
+    auto configuration = diskConfiguration();
+    configuration.maxMemorySize = 1;
+    configuration.maxDiskSize = 25;
+    auto speechCache = SpeechCache::create(configuration);
+    ASSERT_NE(nullptr, speechCache);
+    prepare(speechCache, "one", "", "0123456789");
+    prepare(speechCache, "two", "", "0123456789");
+    prepare(speechCache, "three", "", "0123456789");
+
+    std::string metadata;
+    EXPECT_EQ(20u, speechCache->getDiskSize());
+    EXPECT_EQ(nullptr, speechCache->get("provider", "one", "", metadata));
+    EXPECT_NE(nullptr, speechCache->get("provider", "two", "", metadata));
+    EXPECT_NE(nullptr, speechCache->get("provider", "three", "", metadata));
+    EXPECT_EQ(0, access((m_path + "/index").c_str(), F_OK));
+}
+
+}  // namespace textToSpeech
+}  // namespace unit
+}  // namespace test
+}  // namespace aace
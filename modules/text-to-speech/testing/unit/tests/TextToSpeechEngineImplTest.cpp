@@ -232,6 +232,96 @@ TEST_F(TextToSpeechEngineImplTest, getCapabilitiesWithInvalidProvider) {
         << "Call to onPrepareSpeech() expected to fail!";
 }
 
+/**
+ * @test prepareSpeechSupersededByLaterRequestOfGroup
+ */
+TEST_F(TextToSpeechEngineImplTest, prepareSpeechSupersededByLaterRequestOfGroup) {
+    auto testTextToSpeechEngineImpl = engine::textToSpeech::TextToSpeechEngineImpl::create(
+        m_mockTextToSpeechPlatformInterface, m_mockTextToSpeechServiceInterface, nullptr, 1);
+    ASSERT_NE(nullptr, testTextToSpeechEngineImpl);
+    auto mockPlatform =
+        std::static_pointer_cast<MockTextToSpeechPlatformInterface>(m_mockTextToSpeechPlatformInterface);
+    const std::string provider = "text-to-speech-provider";
+    EXPECT_CALL(*m_mockTextToSpeechServiceInterface, getTextToSpeechProvider(provider))
+        .WillRepeatedly(testing::Return(m_mockTextToSpeechSynthesizerInterface));
+
+    // the first request keeps the only worker busy until its speech is prepared
+    std::promise<aace::engine::textToSpeech::PrepareSpeechResult> firstPromise;
+    std::promise<void> firstStarted;
+    std::promise<void> done;
+    EXPECT_CALL(*m_mockTextToSpeechSynthesizerInterface, prepareSpeech("SPEECH-1", testing::_, testing::_))
+        .WillOnce(testing::Invoke([&](const std::string&, const std::string&, const std::string&) {
+            firstStarted.set_value();
+            return firstPromise.get_future();
+        }));
+    EXPECT_CALL(*m_mockTextToSpeechSynthesizerInterface, prepareSpeech("SPEECH-3", testing::_, testing::_))
+        .WillOnce(testing::Invoke([](const std::string& speechId, const std::string&, const std::string&) {
+            std::promise<aace::engine::textToSpeech::PrepareSpeechResult> promise;
+            promise.set_value(aace::engine::textToSpeech::PrepareSpeechResult(speechId, nullptr));
+            return promise.get_future();
+        }));
+    EXPECT_CALL(*mockPlatform, prepareSpeechFailed("SPEECH-2", "REQUEST_SUPERSEDED")).Times(1);
+    EXPECT_CALL(*mockPlatform, prepareSpeechCompleted("SPEECH-1", testing::_, testing::_)).Times(1);
+    EXPECT_CALL(*mockPlatform, prepareSpeechCompleted("SPEECH-3", testing::_, testing::_))
+        .WillOnce(testing::InvokeWithoutArgs([&done] { done.set_value(); }));
+
+    const std::string groupOptions = R"({"group":"maneuver","requestPayload":{}})";
+    ASSERT_TRUE(testTextToSpeechEngineImpl->onPrepareSpeech("SPEECH-1", "In 1 mile, exit", provider, "{}"));
+    firstStarted.get_future().wait();
+    ASSERT_TRUE(testTextToSpeechEngineImpl->onPrepareSpeech("SPEECH-2", "Turn left", provider, groupOptions));
+    ASSERT_TRUE(testTextToSpeechEngineImpl->onPrepareSpeech("SPEECH-3", "Turn right", provider, groupOptions));
+    firstPromise.set_value(aace::engine::textToSpeech::PrepareSpeechResult("SPEECH-1", nullptr));
+    EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds(2)));
+    testTextToSpeechEngineImpl->shutdown();
+}
+
+/**
+ * @test prepareSpeechWithHigherPriorityFirst
+ */
+TEST_F(TextToSpeechEngineImplTest, prepareSpeechWithHigherPriorityFirst) {
+    auto testTextToSpeechEngineImpl = engine::textToSpeech::TextToSpeechEngineImpl::create(
+        m_mockTextToSpeechPlatformInterface, m_mockTextToSpeechServiceInterface, nullptr, 1);
+    ASSERT_NE(nullptr, testTextToSpeechEngineImpl);
+    auto mockPlatform =
+        std::static_pointer_cast<MockTextToSpeechPlatformInterface>(m_mockTextToSpeechPlatformInterface);
+    const std::string provider = "text-to-speech-provider";
+    EXPECT_CALL(*m_mockTextToSpeechServiceInterface, getTextToSpeechProvider(provider))
+        .WillRepeatedly(testing::Return(m_mockTextToSpeechSynthesizerInterface));
+
+    std::promise<aace::engine::textToSpeech::PrepareSpeechResult> firstPromise;
+    std::promise<void> firstStarted;
+    std::promise<void> done;
+    auto prepared = [](const std::string& speechId, const std::string&, const std::string&) {
+        std::promise<aace::engine::textToSpeech::PrepareSpeechResult> promise;
+        promise.set_value(aace::engine::textToSpeech::PrepareSpeechResult(speechId, nullptr));
+        return promise.get_future();
+    };
+    {
+        testing::InSequence sequence;
+        EXPECT_CALL(*m_mockTextToSpeechSynthesizerInterface, prepareSpeech("SPEECH-1", testing::_, testing::_))
+            .WillOnce(testing::Invoke([&](const std::string&, const std::string&, const std::string&) {
+                firstStarted.set_value();
+                return firstPromise.get_future();
+            }));
+        EXPECT_CALL(*m_mockTextToSpeechSynthesizerInterface, prepareSpeech("SPEECH-3", testing::_, testing::_))
+            .WillOnce(testing::Invoke(prepared));
+        EXPECT_CALL(*m_mockTextToSpeechSynthesizerInterface, prepareSpeech("SPEECH-2", testing::_, testing::_))
+            .WillOnce(testing::Invoke(prepared));
+    }
+    EXPECT_CALL(*mockPlatform, prepareSpeechCompleted(testing::_, testing::_, testing::_)).Times(2);
+    EXPECT_CALL(*mockPlatform, prepareSpeechCompleted("SPEECH-2", testing::_, testing::_))
+        .WillOnce(testing::InvokeWithoutArgs([&done] { done.set_value(); }));
+
+    ASSERT_TRUE(testTextToSpeechEngineImpl->onPrepareSpeech("SPEECH-1", "Parking assist on", provider, "{}"));
+    firstStarted.get_future().wait();
+    ASSERT_TRUE(testTextToSpeechEngineImpl->onPrepareSpeech("SPEECH-2", "Destination ahead", provider, "{}"));
+    ASSERT_TRUE(testTextToSpeechEngineImpl->onPrepareSpeech(
+        "SPEECH-3", "Turn left now", provider, R"({"priority":10,"requestPayload":{}})"));
+    firstPromise.set_value(aace::engine::textToSpeech::PrepareSpeechResult("SPEECH-1", nullptr));
+    EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds(2)));
+    testTextToSpeechEngineImpl->shutdown();
+}
+
 }  // namespace textToSpeech
 }  // namespace unit
 }  // namespace test
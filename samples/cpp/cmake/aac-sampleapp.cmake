@@ -4,8 +4,6 @@ set(CXX_SOURCE_FILES
     ${CMAKE_CURRENT_SOURCE_DIR}/src/ApplicationContext.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/Executor.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/Extension.cpp
-    ${CMAKE_CURRENT_SOURCE_DIR}/src/TaskQueue.cpp
-    ${CMAKE_CURRENT_SOURCE_DIR}/src/TaskThread.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/Views.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp
 )
@@ -25,6 +23,7 @@ set(CXX_SOURCE_FILES ${CXX_SOURCE_FILES}
     ${CMAKE_CURRENT_SOURCE_DIR}/src/Audio/AudioOutputProviderHandler.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/Authorization/AuthorizationHandler.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/Authorization/AuthProviderAuthorizationHandler.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/Dashboard/Dashboard.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/Location/LocationProviderHandler.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/Logger/LoggerHandler.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/Network/NetworkInfoProviderHandler.cpp
@@ -48,6 +47,7 @@ if(AAC_ALEXA)
         ${CMAKE_CURRENT_SOURCE_DIR}/src/Alexa/SpeechSynthesizerHandler.cpp
         ${CMAKE_CURRENT_SOURCE_DIR}/src/Alexa/TemplateRuntimeHandler.cpp
         ${CMAKE_CURRENT_SOURCE_DIR}/src/Alexa/AlexaSpeakerHandler.cpp
+        ${CMAKE_CURRENT_SOURCE_DIR}/src/Benchmark/VoiceBenchmark.cpp
     )
 endif()
 
@@ -38,6 +38,9 @@
 // Sample Authorization Interfaces
 #include "SampleApp/Authorization/AuthorizationHandler.h"
 
+// Sample Performance Dashboard
+#include "SampleApp/Dashboard/Dashboard.h"
+
 // Sample Location Interfaces
 #include "SampleApp/Location/LocationProviderHandler.h"
 
@@ -67,6 +70,7 @@
 #include "SampleApp/Alexa/DeviceSetupHandler.h"
 #include "SampleApp/Alexa/FeatureDiscoveryHandler.h"
 #include "SampleApp/Alexa/MediaPlaybackRequestorHandler.h"
+#include "SampleApp/Benchmark/VoiceBenchmark.h"
 #endif
 
 // Sample Communications Interfaces
@@ -44,11 +44,13 @@ class ApplicationContext {
 private:
     bool m_audioFileSupported{false};
     bool m_authProviderAvailable{false};
+    bool m_benchmarkWakeword{false};
     bool m_disableAutoAuthorization{false};
     bool m_logEnabled{false};
     bool m_messagingResponsesEnabled{true};
     bool m_singleThreadedUI{false};
     bool m_testAutomation{false};
+    int m_benchmarkIterations{0};
     json m_menuRegister{};
     logger::LoggerHandler::Level m_level{};
     std::mutex m_mutex;
@@ -80,7 +82,9 @@ public:
     auto executeCommand(const char* command) -> std::string;
     auto getApplicationDirPath() -> std::string;
     auto getApplicationPath() -> std::string;
+    auto getAudioFilePaths() -> std::vector<std::string>;
     auto getAudioInputDevice() -> std::string;
+    auto getBenchmarkIterations() -> int;
     auto getBrowserCommand() -> std::string;
     auto getBuildIdentifier() -> std::string;
     auto getConfigFilePath(size_t index = 0) -> std::string;
@@ -102,6 +106,7 @@ public:
     auto isAlexaCommsSupported() -> bool;
     auto isAudioFileSupported() -> bool;
     auto isAutoAuthorizationDisabled() -> bool;
+    auto isBenchmarkWakeword() -> bool;
     auto isConnectivitySupported() -> bool;
     auto isDcmSupported() -> bool;
     auto isLocalVoiceControlSupported() -> bool;
@@ -124,6 +129,8 @@ public:
     auto setAudioInputDevice(const std::string& audioInputDevice) -> void;
     auto setAuthorizationInProgress(const std::string& service) -> void;
     auto setAuthProviderAvailability(bool available) -> void;
+    auto setBenchmarkIterations(int benchmarkIterations) -> void;
+    auto setBenchmarkWakeword(bool benchmarkWakeword) -> void;
     auto setBrowserCommand(const std::string& browserCommand) -> void;
     auto setDisableAutoAuthorizationCommand(bool disable) -> void;
     auto setLevel(logger::LoggerHandler::Level level) -> void;
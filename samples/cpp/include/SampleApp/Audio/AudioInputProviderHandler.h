@@ -20,9 +20,12 @@
 #include "SampleApp/Logger/LoggerHandler.h"
 
 #include <AACE/Core/MessageBroker.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
 
+#include <atomic>
 #include <queue>
 #include <fstream>
+#include <mutex>
 
 namespace sampleApp {
 namespace audio {
@@ -33,7 +36,18 @@ namespace audio {
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-class AudioInputProviderHandler {
+class AudioInputProviderHandler : public std::enable_shared_from_this<AudioInputProviderHandler> {
+public:
+    /// The statistics of the audio written to the Engine
+    struct Stats {
+        /// @c true while the audio is streamed to the Engine
+        bool running = false;
+        /// The bytes written to the audio input streams
+        uint64_t writtenBytes = 0;
+        /// The bytes the audio input streams did not accept, because the buffer of the Engine was full
+        uint64_t rejectedBytes = 0;
+    };
+
 private:
     std::weak_ptr<Activity> m_activity;
     std::weak_ptr<logger::LoggerHandler> m_loggerHandler;
@@ -51,10 +65,14 @@ public:
     static auto create(Args&&... args) -> std::shared_ptr<AudioInputProviderHandler> {
         return std::shared_ptr<AudioInputProviderHandler>(new AudioInputProviderHandler(args...));
     }
+    ~AudioInputProviderHandler();
     auto getActivity() -> std::weak_ptr<Activity>;
     auto getLoggerHandler() -> std::weak_ptr<logger::LoggerHandler>;
     auto setupUI() -> void;
 
+    /// Returns the statistics of the audio written to the Engine.
+    auto getStats() -> Stats;
+
 private:
     auto subscribeToAASBMessages() -> void;
 
@@ -82,9 +100,19 @@ private:
      */
     void stopAudioInput();
 
+    /**
+     * Writes the next chunk of the audio file to the audio input stream.
+     */
+    void writeAudio(std::shared_ptr<aace::core::MessageStream> stream);
+
 private:
-    bool m_running;
-    Executor m_executer;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_writtenBytes{0};
+    std::atomic<uint64_t> m_rejectedBytes{0};
+    Executor m_executer{"SampleApp.AudioInput"};
+    std::mutex m_mutex;
+    aace::engine::utils::threading::TimerWheel::TimerId m_timer{
+        aace::engine::utils::threading::TimerWheel::INVALID_TIMER};
     std::string m_path;
     std::ifstream m_stream;
     std::weak_ptr<View> m_console{};
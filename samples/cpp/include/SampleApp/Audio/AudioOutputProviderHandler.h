@@ -27,6 +27,7 @@
 #include <AASB/Message/Audio/AudioOutput/MutedStateChangedMessage.h>
 #include <AASB/Message/Audio/AudioOutput/PrepareStreamMessage.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <chrono>
@@ -43,6 +44,21 @@ namespace audio {
 class DefaultAudioOutput;
 
 class AudioOutputProviderHandler {
+public:
+    /// The statistics of the audio output
+    struct Stats {
+        /// @c true while an audio source is played
+        bool playing = false;
+        /// @c true while the audio source is paused
+        bool paused = false;
+        /// The position of the audio source, in milliseconds
+        int64_t positionMs = 0;
+        /// The streams being read from the Engine
+        uint64_t openStreams = 0;
+        /// The bytes read from the Engine streams
+        uint64_t streamedBytes = 0;
+    };
+
 private:
     std::weak_ptr<Activity> m_activity;
     std::weak_ptr<logger::LoggerHandler> m_loggerHandler;
@@ -68,6 +84,9 @@ public:
     auto log(logger::LoggerHandler::Level level, const std::string& message) -> void;
     auto writeStreamToFile(std::shared_ptr<aace::core::MessageStream> stream) -> void;
 
+    /// Returns the statistics of the audio output.
+    auto getStats() -> Stats;
+
 private:
     auto subscribeToAASBMessages() -> void;
 
@@ -307,12 +326,14 @@ private:
     std::chrono::milliseconds m_minPlayDuration;
     std::chrono::milliseconds m_maxPlayDuration;
     std::string m_name;
-    Executor m_executer;
+    Executor m_executer{"SampleApp.AudioOutput"};
     int64_t m_position;
     bool m_playing;
     bool m_paused;
     std::condition_variable m_cv;
     std::mutex m_mutex;
+    std::atomic<uint64_t> m_openStreams{0};
+    std::atomic<uint64_t> m_streamedBytes{0};
 };
 
 }  // namespace audio
@@ -178,7 +178,7 @@ private:
     std::mutex m_refreshTokenMutex;
 
     /// Thread for responding to authorization request.
-    Executor m_executer;
+    Executor m_executer{"SampleApp.AuthProvider"};
 };
 
 }  // namespace authorization
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef SAMPLEAPP_BENCHMARK_VOICEBENCHMARK_H
+#define SAMPLEAPP_BENCHMARK_VOICEBENCHMARK_H
+
+#include "SampleApp/Activity.h"
+#include "SampleApp/Logger/LoggerHandler.h"
+
+#include <AACE/Core/MessageBroker.h>
+
+// C++ Standard Library
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sampleApp {
+namespace benchmark {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  VoiceBenchmark
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Measures the latency of the voice pipeline end to end. Each iteration injects a recorded utterance through the
+ * @c AudioInputProviderHandler, and timestamps the stages of the interaction from the start of the injection until
+ * the first audio of the response is played through the @c AudioOutputProviderHandler. The breakdown of the latency
+ * over all the iterations is printed when the benchmark completes.
+ */
+class VoiceBenchmark {
+public:
+    /// The stages of an interaction, in the order they happen
+    enum class Stage {
+        /// The Engine detected the wake word in the injected audio
+        WAKEWORD_DETECTED,
+        /// The Engine started listening, and sent the Recognize event with the audio
+        RECOGNIZE_SENT,
+        /// The Engine detected the end of the speech in the injected audio
+        END_OF_SPEECH,
+        /// The Engine handled the first directive of the response with audio, such as Speak
+        FIRST_DIRECTIVE,
+        /// The first byte of the speech was read from the TTS stream
+        TTS_FIRST_BYTE,
+        /// The first audio of the speech was played
+        FIRST_AUDIO_PLAYED
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::weak_ptr<Activity> m_activity;
+    std::weak_ptr<logger::LoggerHandler> m_loggerHandler;
+    std::shared_ptr<aace::core::MessageBroker> m_messageBroker;
+    std::vector<std::string> m_audioFilePaths;
+    int m_iterations;
+    bool m_wakeword;
+
+    std::mutex m_mutex;
+    size_t m_next{0};
+    bool m_running{false};
+    Clock::time_point m_start;
+    std::map<Stage, Clock::time_point> m_stages;
+    std::vector<std::map<Stage, double>> m_results;
+
+protected:
+    VoiceBenchmark(
+        std::weak_ptr<Activity> activity,
+        std::weak_ptr<logger::LoggerHandler> loggerHandler,
+        std::shared_ptr<aace::core::MessageBroker> messageBroker,
+        std::vector<std::string> audioFilePaths,
+        int iterations,
+        bool wakeword);
+
+public:
+    template <typename... Args>
+    static auto create(Args&&... args) -> std::shared_ptr<VoiceBenchmark> {
+        auto voiceBenchmark = std::shared_ptr<VoiceBenchmark>(new VoiceBenchmark(args...));
+        voiceBenchmark->setupUI();
+        return voiceBenchmark;
+    }
+
+    /**
+     * Completes the current iteration, and starts the next one.
+     *
+     * @return The audio file to inject for the next iteration, or an empty string when the benchmark is complete.
+     */
+    auto next() -> std::string;
+
+    /// Returns @c true if the utterances start with the wake word, so they are injected without tap-to-talk.
+    auto isWakeword() -> bool;
+
+    /// Returns the latency breakdown of the completed iterations.
+    auto getReport() -> std::string;
+
+private:
+    auto subscribeToAASBMessages() -> void;
+    auto setupUI() -> void;
+    auto mark(Stage stage) -> void;
+    auto log(logger::LoggerHandler::Level level, const std::string& message) -> void;
+
+    /// Returns the name of a stage, as printed in the report.
+    static auto stageToString(Stage stage) -> std::string;
+};
+
+}  // namespace benchmark
+}  // namespace sampleApp
+
+#endif  // SAMPLEAPP_BENCHMARK_VOICEBENCHMARK_H
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef SAMPLEAPP_DASHBOARD_DASHBOARD_H
+#define SAMPLEAPP_DASHBOARD_DASHBOARD_H
+
+#include "SampleApp/Activity.h"
+#include "SampleApp/Audio/AudioInputProviderHandler.h"
+#include "SampleApp/Audio/AudioOutputProviderHandler.h"
+#include "SampleApp/Executor.h"
+#include "SampleApp/Logger/LoggerHandler.h"
+
+#include <AACE/Core/MessageBroker.h>
+#include <AACE/Engine/Utils/Memory/MemoryAccounting.h>
+#include <AACE/Engine/Utils/Threading/TimerWheel.h>
+
+// C++ Standard Library
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sampleApp {
+namespace dashboard {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Dashboard
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Prints the health of the Engine and the application in the console. The dashboard shows:
+ * - The messages the Engine publishes to the application per second, by topic.
+ * - The queue depth and throughput of the message broker dispatch lanes and of the other named executors, from
+ *   their @c ExecutorStats.
+ * - The audio written to the Engine by the @c AudioInputProviderHandler, and read from the Engine by the
+ *   @c AudioOutputProviderHandler.
+ * - The log entries the Engine logger dropped because its asynchronous queue was full.
+ * - The heap memory of each module, when the Engine is built with memory accounting.
+ * - The latency breakdown of the recent voice turns, from the wake word to the first audio of the response.
+ *
+ * The rates are computed since the previous print of the dashboard.
+ */
+class Dashboard : public std::enable_shared_from_this<Dashboard> {
+public:
+    /// The stages of a voice turn, in the order they happen
+    enum class Stage {
+        /// The Engine detected the wake word
+        WAKEWORD_DETECTED,
+        /// The Engine started listening
+        LISTENING,
+        /// The Engine detected the end of the speech
+        END_OF_SPEECH,
+        /// The first directive of the response with audio prepared an audio output
+        FIRST_DIRECTIVE,
+        /// The first audio of the speech was played
+        FIRST_AUDIO_PLAYED
+    };
+
+    /// The number of voice turns shown in the dashboard
+    static const size_t MAX_VOICE_TURNS = 5;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using MemoryAccounting = aace::engine::utils::memory::MemoryAccounting;
+    using TimerWheel = aace::engine::utils::threading::TimerWheel;
+
+    std::weak_ptr<Activity> m_activity;
+    std::weak_ptr<logger::LoggerHandler> m_loggerHandler;
+    std::shared_ptr<aace::core::MessageBroker> m_messageBroker;
+    std::weak_ptr<audio::AudioInputProviderHandler> m_audioInputProvider;
+    std::weak_ptr<audio::AudioOutputProviderHandler> m_audioOutputProvider;
+
+    std::weak_ptr<View> m_console{};
+    Executor m_executor{"SampleApp.Dashboard"};
+
+    std::mutex m_mutex;
+    TimerWheel::TimerId m_timer{TimerWheel::INVALID_TIMER};
+
+    // the messages published by the Engine, by topic
+    std::unordered_map<std::string, uint64_t> m_messages;
+
+    // the voice turn in progress, and the completed voice turns, the latest last
+    std::map<Stage, Clock::time_point> m_turn;
+    std::deque<std::map<Stage, Clock::time_point>> m_turns;
+
+    // the counters at the previous print, to compute the rates
+    std::mutex m_reportMutex;
+    Clock::time_point m_previousTime;
+    std::unordered_map<std::string, uint64_t> m_previousMessages;
+    std::unordered_map<std::string, uint64_t> m_previousCompletedTasks;
+    std::unordered_map<std::string, MemoryAccounting::Snapshot> m_previousMemory;
+    uint64_t m_previousDroppedEntries{0};
+
+protected:
+    Dashboard(
+        std::weak_ptr<Activity> activity,
+        std::weak_ptr<logger::LoggerHandler> loggerHandler,
+        std::shared_ptr<aace::core::MessageBroker> messageBroker,
+        std::weak_ptr<audio::AudioInputProviderHandler> audioInputProvider = {},
+        std::weak_ptr<audio::AudioOutputProviderHandler> audioOutputProvider = {});
+
+public:
+    template <typename... Args>
+    static auto create(Args&&... args) -> std::shared_ptr<Dashboard> {
+        auto dashboard = std::shared_ptr<Dashboard>(new Dashboard(args...));
+        dashboard->setupUI();
+        return dashboard;
+    }
+    ~Dashboard();
+
+    /// Returns the dashboard, and updates the counters the next rates are computed from.
+    auto getReport() -> std::string;
+
+    /**
+     * Prints the dashboard in the console periodically, until @c stopLive() is called.
+     *
+     * @param interval The time between two prints of the dashboard.
+     */
+    auto startLive(std::chrono::seconds interval) -> void;
+
+    /// Stops printing the dashboard periodically.
+    auto stopLive() -> void;
+
+private:
+    auto subscribeToAASBMessages() -> void;
+    auto setupUI() -> void;
+    auto printReport() -> void;
+    auto countMessage(const std::string& message) -> void;
+    auto mark(Stage stage) -> void;
+    auto log(logger::LoggerHandler::Level level, const std::string& message) -> void;
+
+    /// Returns the topic of a message, without parsing the whole message.
+    static auto getTopic(const std::string& message) -> std::string;
+};
+
+}  // namespace dashboard
+}  // namespace sampleApp
+
+#endif  // SAMPLEAPP_DASHBOARD_DASHBOARD_H
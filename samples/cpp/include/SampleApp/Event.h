@@ -40,6 +40,15 @@ enum class Event {
     // AudioManager
     onAudioManagerSpeaker,
 
+    // AudioOutput
+    onAudioOutputFirstByte,
+    onAudioOutputPlay,
+
+    // Dashboard
+    onDashboardShow,
+    onDashboardStartLive,
+    onDashboardStopLive,
+
     // Communication
     onCommunicationAcceptCall,
     onCommunicationStopCall,
@@ -161,6 +170,15 @@ static const std::map<std::string, Event> EventEnumerator{
     // AudioManager
     {"onAudioManagerSpeaker", Event::onAudioManagerSpeaker},
 
+    // AudioOutput
+    {"onAudioOutputFirstByte", Event::onAudioOutputFirstByte},
+    {"onAudioOutputPlay", Event::onAudioOutputPlay},
+
+    // Dashboard
+    {"onDashboardShow", Event::onDashboardShow},
+    {"onDashboardStartLive", Event::onDashboardStartLive},
+    {"onDashboardStopLive", Event::onDashboardStopLive},
+
     // Communications
     {"onCommunicationAcceptCall", Event::onCommunicationAcceptCall},
     {"onCommunicationStopCall", Event::onCommunicationStopCall},
@@ -16,11 +16,12 @@
 #ifndef SAMPLEAPP_EXECUTOR_H
 #define SAMPLEAPP_EXECUTOR_H
 
-#include "SampleApp/TaskQueue.h"
-#include "SampleApp/TaskThread.h"
+#include <AACE/Engine/Utils/Threading/SerialExecutor.h>
+#include <AACE/Engine/Utils/Threading/ThreadPool.h>
 
 // C++ Standard Library
 #include <future>
+#include <string>
 #include <utility>
 
 namespace sampleApp {
@@ -32,15 +33,28 @@ namespace sampleApp {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * An Executor is used to run callable types asynchronously.
+ * An Executor is used to run callable types asynchronously, one at a time and in the order they are submitted.
+ *
+ * The executors of the application don't own a thread: they share the threads of one thread pool, which can also be
+ * the thread pool of the Engine. A named executor records its statistics (queue depth, wait and run times), which are
+ * reported with the statistics of the Engine executors.
  */
 class Executor {
 public:
+    using ThreadPool = aace::engine::utils::threading::ThreadPool;
+
     /**
      * Constructs an Executor.
      */
     Executor();
 
+    /**
+     * Constructs a named Executor, which records its statistics.
+     *
+     * @param name The name of the executor.
+     */
+    explicit Executor(const std::string& name);
+
     /**
      * Destructs an Executor.
      */
@@ -80,22 +94,35 @@ public:
     /// Returns whether or not the executor is shutdown.
     bool isShutdown();
 
-private:
-    /// The queue of tasks to execute.
-    std::shared_ptr<TaskQueue> m_taskQueue;
+    /**
+     * Returns the thread pool of the executors, by default a pool of @c DEFAULT_THREAD_COUNT threads owned by the
+     * application.
+     */
+    static std::shared_ptr<ThreadPool> getThreadPool();
 
-    /// The thread to execute tasks on. The thread must be declared last to be destructed first.
-    std::unique_ptr<TaskThread> m_taskThread;
+    /**
+     * Sets the thread pool of the executors created after the call, such as the thread pool of the Engine.
+     *
+     * @param threadPool The thread pool.
+     */
+    static void setThreadPool(std::shared_ptr<ThreadPool> threadPool);
+
+    /// The number of threads of the default thread pool
+    static const size_t DEFAULT_THREAD_COUNT = 4;
+
+private:
+    /// The serial executor running the tasks on the thread pool.
+    aace::engine::utils::threading::SerialExecutor m_serialExecutor;
 };
 
 template <typename Task, typename... Args>
 auto Executor::submit(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
-    return m_taskQueue->push(task, std::forward<Args>(args)...);
+    return m_serialExecutor.submit(task, std::forward<Args>(args)...);
 }
 
 template <typename Task, typename... Args>
 auto Executor::submitToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
-    return m_taskQueue->pushToFront(task, std::forward<Args>(args)...);
+    return m_serialExecutor.submitToFront(task, std::forward<Args>(args)...);
 }
 
 }  // namespace sampleApp
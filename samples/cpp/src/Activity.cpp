@@ -31,7 +31,7 @@ namespace sampleApp {
 Activity::Activity(std::shared_ptr<ApplicationContext> applicationContext, std::vector<std::shared_ptr<View>> views) :
         m_applicationContext{std::move(applicationContext)}, m_views{std::move(views)} {
     // Expects(m_applicationContext != nullptr);
-    m_executor = std::make_shared<Executor>();
+    m_executor = std::make_shared<Executor>("SampleApp.Activity");
     m_singleThreadedUI = m_applicationContext->isSingleThreadedUI();
 }
 
@@ -16,6 +16,8 @@
 #include "SampleApp/Application.h"
 #include "SampleApp/Extension.h"
 
+#include <AACE/Engine/Utils/Threading/ExecutorStats.h>
+
 // C++ Standard Library
 #ifdef __linux__
 #include <linux/limits.h>  // PATH_MAX
@@ -294,6 +296,9 @@ Status Application::run(std::shared_ptr<ApplicationContext> applicationContext)
     std::condition_variable conditionVariable;
     std::atomic<bool> connected{false};
     std::atomic<bool> processed{false};
+#ifdef AAC_ALEXA
+    std::shared_ptr<benchmark::VoiceBenchmark> voiceBenchmark;
+#endif
 
     // Prepare the UI views
     std::vector<std::shared_ptr<View>> views{};
@@ -336,10 +341,18 @@ Status Application::run(std::shared_ptr<ApplicationContext> applicationContext)
         activity->registerObserver(Event::onTestAutomationProcess, [&](const std::string&) {
             if (connected) {
                 auto audioFilePath = applicationContext->popAudioFilePath();
+                auto tapToTalk = true;
+#ifdef AAC_ALEXA
+                // The benchmark repeats the audio files for its iterations
+                if (voiceBenchmark != nullptr) {
+                    audioFilePath = voiceBenchmark->next();
+                    tapToTalk = !voiceBenchmark->isWakeword();
+                }
+#endif
                 if (!audioFilePath.empty()) {
                     console->printLine("Process:", audioFilePath);
                     if (activity->notify(Event::onSpeechRecognizerStartStreamingAudioFile, audioFilePath)) {
-                        return activity->notify(Event::onSpeechRecognizerTapToTalk);
+                        return !tapToTalk || activity->notify(Event::onSpeechRecognizerTapToTalk);
                     }
                     return false;
                 }
@@ -454,6 +467,15 @@ Status Application::run(std::shared_ptr<ApplicationContext> applicationContext)
         network::NetworkInfoProviderHandler::create(activity, loggerHandler, messageBroker);
     Ensures(networkInfoProviderHandler != nullptr);
 
+    // Performance Dashboard
+#ifndef AAC_SYSTEM_AUDIO
+    auto performanceDashboard = dashboard::Dashboard::create(
+        activity, loggerHandler, messageBroker, defaultAudioInputProvider, defaultAudioOutputProvider);
+#else
+    auto performanceDashboard = dashboard::Dashboard::create(activity, loggerHandler, messageBroker);
+#endif
+    Ensures(performanceDashboard != nullptr);
+
     // Authorization
     auto authorizationHandler = authorization::AuthorizationHandler::create(activity, loggerHandler, messageBroker);
     Ensures(authorizationHandler != nullptr);
@@ -536,6 +558,18 @@ Status Application::run(std::shared_ptr<ApplicationContext> applicationContext)
     // Feature Discovery
     auto featureDiscoveryHandler = alexa::FeatureDiscoveryHandler::create(activity, loggerHandler, messageBroker);
     Ensures(featureDiscoveryHandler != nullptr);
+
+    // Voice Benchmark (Important: Voice Benchmark must be created before the engine is started)
+    if (applicationContext->getBenchmarkIterations() > 0) {
+        voiceBenchmark = benchmark::VoiceBenchmark::create(
+            activity,
+            loggerHandler,
+            messageBroker,
+            applicationContext->getAudioFilePaths(),
+            applicationContext->getBenchmarkIterations(),
+            applicationContext->isBenchmarkWakeword());
+        Ensures(voiceBenchmark != nullptr);
+    }
 #endif
 
     // Text To Speech Handler
@@ -646,6 +680,11 @@ Status Application::run(std::shared_ptr<ApplicationContext> applicationContext)
     if (applicationContext->isTestAutomation()) {
         std::unique_lock<std::mutex> lock(mutex);
         conditionVariable.wait(lock, [&processed] { return processed.load(); });
+#ifdef AAC_ALEXA
+        if (voiceBenchmark != nullptr) {
+            console->print(voiceBenchmark->getReport());
+        }
+#endif
     } else {
         // Run the main loop (i.e. interactive text based menu system)
         auto id = std::string("main");
@@ -656,7 +695,17 @@ Status Application::run(std::shared_ptr<ApplicationContext> applicationContext)
         status = runMenu(applicationContext, engine, propertyManagerHandler, activity, console, id);
     }
 
+    // Log the statistics of the application and Engine executors
+    for (auto& snapshot : aace::engine::utils::threading::ExecutorStats::getSnapshots()) {
+        std::stringstream ss;
+        ss << snapshot.name << ": completedTasks=" << snapshot.completedTasks
+           << " maxQueueDepth=" << snapshot.maxQueueDepth << " maxWaitTimeUs=" << snapshot.waitTime.maxUs
+           << " maxRunTimeUs=" << snapshot.runTime.maxUs;
+        loggerHandler->log(Level::INFO, "Application:Executor", ss.str());
+    }
+
     // Stop notifications
+    performanceDashboard->stopLive();
     activity->clearObservers();
 
     // Stop the engine
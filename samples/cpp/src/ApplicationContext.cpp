@@ -102,11 +102,21 @@ std::string ApplicationContext::getApplicationPath() {
     return m_applicationPath;
 }
 
+std::vector<std::string> ApplicationContext::getAudioFilePaths() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<std::string>(m_audioFilePaths.begin(), m_audioFilePaths.end());
+}
+
 std::string ApplicationContext::getAudioInputDevice() {
     std::lock_guard<std::mutex> lock(m_mutex);
     return m_audioInputDevice;
 }
 
+int ApplicationContext::getBenchmarkIterations() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_benchmarkIterations;
+}
+
 std::string ApplicationContext::getBrowserCommand() {
     std::lock_guard<std::mutex> lock(m_mutex);
     return m_browserCommand;
@@ -243,6 +253,11 @@ bool ApplicationContext::isAutoAuthorizationDisabled() {
     return m_disableAutoAuthorization;
 }
 
+bool ApplicationContext::isBenchmarkWakeword() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_benchmarkWakeword;
+}
+
 bool ApplicationContext::isConnectivitySupported() {
 #ifdef AAC_CONNECTIVITY
     return true;
@@ -410,6 +425,16 @@ void ApplicationContext::setAuthProviderAvailability(bool available) {
     m_authProviderAvailable = available;
 }
 
+void ApplicationContext::setBenchmarkIterations(int benchmarkIterations) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_benchmarkIterations = benchmarkIterations;
+}
+
+void ApplicationContext::setBenchmarkWakeword(bool benchmarkWakeword) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_benchmarkWakeword = benchmarkWakeword;
+}
+
 void ApplicationContext::setBrowserCommand(const std::string& browserCommand) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_browserCommand = browserCommand;
@@ -19,6 +19,7 @@
 #include <AASB/Message/Audio/AudioInput/StartAudioInputMessage.h>
 
 // C++ Standard Library
+#include <algorithm>
 #include <sstream>
 #include <array>
 #include <cstring>
@@ -41,6 +42,7 @@ using namespace aasb::message::audio::audioInput;
 
 using aace::core::MessageBroker;
 using aace::core::MessageStream;
+using aace::engine::utils::threading::TimerWheel;
 
 AudioInputProviderHandler::AudioInputProviderHandler(
     std::weak_ptr<Activity> activity,
@@ -56,6 +58,10 @@ AudioInputProviderHandler::AudioInputProviderHandler(
     subscribeToAASBMessages();
 }
 
+AudioInputProviderHandler::~AudioInputProviderHandler() {
+    stopAudioInput();
+}
+
 std::weak_ptr<Activity> AudioInputProviderHandler::getActivity() {
     return m_activity;
 }
@@ -94,40 +100,63 @@ void AudioInputProviderHandler::handleStopAudioInputMessage(const std::string& m
 #define NUM_SAMPLES 160
 
 void AudioInputProviderHandler::startAudioInput(std::shared_ptr<MessageStream> stream) {
-    int16_t buffer[NUM_SAMPLES] = {0};
-    size_t bsize = NUM_SAMPLES * 2;
-
-    m_running = true;
+    stopAudioInput();
 
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (m_stream.is_open()) {
         m_stream.close();
     }
     m_stream.open(m_path, std::ios::binary);
+    m_running = true;
 
-    m_executer.submit([=]() {
-        while (m_running) {
-            if (stream != nullptr) {
-                if (stream->isClosed()) {
-                    std::memset((char*)buffer, 0, bsize);
-                } else {
-                    ssize_t count = read((char*)buffer, bsize);
-                    if (count < bsize) {
-                        std::memset(((char*)buffer) + count, 0, bsize - count);
-                    }
+    // a timer streams the audio in chunks of 10 ms, so the streaming doesn't hold a thread of the executor pool
+    std::weak_ptr<AudioInputProviderHandler> weakSelf = shared_from_this();
+    m_timer = TimerWheel::getDefault()->submitPeriodic(std::chrono::milliseconds(10), [weakSelf, stream]() {
+        if (auto self = weakSelf.lock()) {
+            self->m_executer.submit([weakSelf, stream]() {
+                if (auto self = weakSelf.lock()) {
+                    self->writeAudio(stream);
                 }
-            }
-            if (!stream->isClosed()) {
-                stream->write((char*)buffer, NUM_SAMPLES);
-            }
-
-            // sleep
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            });
         }
     });
 }
 
+void AudioInputProviderHandler::writeAudio(std::shared_ptr<MessageStream> stream) {
+    int16_t buffer[NUM_SAMPLES] = {0};
+    size_t bsize = NUM_SAMPLES * 2;
+
+    if (!m_running || stream == nullptr || stream->isClosed()) {
+        return;
+    }
+    ssize_t count = read((char*)buffer, bsize);
+    if (count < bsize) {
+        std::memset(((char*)buffer) + count, 0, bsize - count);
+    }
+    auto written = stream->write((char*)buffer, bsize);
+    if (written > 0) {
+        m_writtenBytes += written;
+    }
+    if (written < static_cast<ssize_t>(bsize)) {
+        m_rejectedBytes += bsize - std::max<ssize_t>(written, 0);
+    }
+}
+
+AudioInputProviderHandler::Stats AudioInputProviderHandler::getStats() {
+    Stats stats;
+    stats.running = m_running;
+    stats.writtenBytes = m_writtenBytes;
+    stats.rejectedBytes = m_rejectedBytes;
+    return stats;
+}
+
 void AudioInputProviderHandler::stopAudioInput() {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_running = false;
+    if (m_timer != TimerWheel::INVALID_TIMER) {
+        TimerWheel::getDefault()->cancel(m_timer);
+        m_timer = TimerWheel::INVALID_TIMER;
+    }
 }
 
 void AudioInputProviderHandler::log(logger::LoggerHandler::Level level, const std::string& message) {
@@ -139,6 +168,7 @@ void AudioInputProviderHandler::log(logger::LoggerHandler::Level level, const st
 }
 
 ssize_t AudioInputProviderHandler::read(char* data, const size_t size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (m_stream.eof()) {
         return 0;
     }
@@ -165,7 +195,15 @@ void AudioInputProviderHandler::setupUI() {
     m_console = activity->findViewById("id:console");
     activity->registerObserver(Event::onSpeechRecognizerStartStreamingAudioFile, [=](const std::string& value) {
         log(logger::LoggerHandler::Level::VERBOSE, "onSpeechRecognizerStartStreamingAudioFile:" + value);
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_path = value;
+        // the audio input keeps running while the wake word is enabled, so the file is streamed right away
+        if (m_running) {
+            if (m_stream.is_open()) {
+                m_stream.close();
+            }
+            m_stream.open(m_path, std::ios::binary);
+        }
         return true;
     });
 }
@@ -360,13 +360,19 @@ void AudioOutputProviderHandler::play(const std::string& channel, const std::str
     m_playing = true;
     m_paused = false;
     mediaStateChanged(channel, token, MediaState::PLAYING);
+    if (auto activity = m_activity.lock()) {
+        activity->notify(Event::onAudioOutputPlay, channel);
+    }
+    // the benchmark plays each source for the same time, so the iterations are comparable
+    auto applicationContext = m_applicationContext.lock();
+    auto benchmark = applicationContext && applicationContext->getBenchmarkIterations() > 0;
     m_executer.submit([=]() {
         std::random_device seeder;
         std::mt19937 engine(seeder());
         std::uniform_int_distribution<int> dist(m_minPlayDuration.count(), m_maxPlayDuration.count());
         int sleepTime = 100;
         int reportInterval = 1000;
-        auto playTime = dist(engine);
+        auto playTime = benchmark ? static_cast<int>(m_minPlayDuration.count()) : dist(engine);
         auto lastReportPosition = 0;
         while (m_position < playTime && m_playing) {
             std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
@@ -499,13 +505,22 @@ void AudioOutputProviderHandler::writeStreamToFile(std::shared_ptr<MessageStream
     char buffer[4096];
     ssize_t bytes = 0;
     ssize_t count;
+    auto name = m_name;
+    m_openStreams++;
     while (!stream->isClosed()) {
         count = stream->read(buffer, 4096);
         if (count > 0) {
+            if (bytes == 0) {
+                if (auto activity = m_activity.lock()) {
+                    activity->notify(Event::onAudioOutputFirstByte, name);
+                }
+            }
             bytes += count;
+            m_streamedBytes += count;
             output->write(buffer, count);
         }
     }
+    m_openStreams--;
     output->close();
 
     ss.clear();
@@ -513,6 +528,19 @@ void AudioOutputProviderHandler::writeStreamToFile(std::shared_ptr<MessageStream
     log(logger::LoggerHandler::Level::INFO, ss.str());
 }
 
+AudioOutputProviderHandler::Stats AudioOutputProviderHandler::getStats() {
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stats.playing = m_playing;
+        stats.paused = m_paused;
+        stats.positionMs = m_position;
+    }
+    stats.openStreams = m_openStreams;
+    stats.streamedBytes = m_streamedBytes;
+    return stats;
+}
+
 void AudioOutputProviderHandler::log(logger::LoggerHandler::Level level, const std::string& message) {
     auto loggerHandler = m_loggerHandler.lock();
     if (!loggerHandler) {
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "SampleApp/Benchmark/VoiceBenchmark.h"
+
+#include <AASB/Message/Alexa/AlexaClient/DialogStateChangedMessage.h>
+#include <AASB/Message/Alexa/SpeechRecognizer/EndOfSpeechDetectedMessage.h>
+#include <AASB/Message/Alexa/SpeechRecognizer/WakewordDetectedMessage.h>
+#include <AASB/Message/Audio/AudioOutput/PrepareStreamMessage.h>
+#include <AASB/Message/Audio/AudioOutput/PrepareURLMessage.h>
+
+// C++ Standard Library
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+// JSON for Modern C++
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+namespace sampleApp {
+namespace benchmark {
+
+using namespace aasb::message::alexa::alexaClient;
+using namespace aasb::message::alexa::speechRecognizer;
+using namespace aasb::message::audio::audioOutput;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  VoiceBenchmark
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// The channel of the Alexa speech, whose first audio ends the interaction
+static const std::string SPEECH_CHANNEL = "SpeechSynthesizer";
+
+/// The stages in the order of the report
+static const std::vector<VoiceBenchmark::Stage> STAGES = {VoiceBenchmark::Stage::WAKEWORD_DETECTED,
+                                                          VoiceBenchmark::Stage::RECOGNIZE_SENT,
+                                                          VoiceBenchmark::Stage::END_OF_SPEECH,
+                                                          VoiceBenchmark::Stage::FIRST_DIRECTIVE,
+                                                          VoiceBenchmark::Stage::TTS_FIRST_BYTE,
+                                                          VoiceBenchmark::Stage::FIRST_AUDIO_PLAYED};
+
+VoiceBenchmark::VoiceBenchmark(
+    std::weak_ptr<Activity> activity,
+    std::weak_ptr<logger::LoggerHandler> loggerHandler,
+    std::shared_ptr<aace::core::MessageBroker> messageBroker,
+    std::vector<std::string> audioFilePaths,
+    int iterations,
+    bool wakeword) :
+        m_activity{std::move(activity)},
+        m_loggerHandler{std::move(loggerHandler)},
+        m_messageBroker{std::move(messageBroker)},
+        m_audioFilePaths{std::move(audioFilePaths)},
+        m_iterations{iterations},
+        m_wakeword{wakeword} {
+    subscribeToAASBMessages();
+}
+
+void VoiceBenchmark::subscribeToAASBMessages() {
+    m_messageBroker->subscribe(
+        [=](const std::string& message) { mark(Stage::WAKEWORD_DETECTED); },
+        WakewordDetectedMessage::topic(),
+        WakewordDetectedMessage::action());
+
+    m_messageBroker->subscribe(
+        [=](const std::string& message) { mark(Stage::END_OF_SPEECH); },
+        EndOfSpeechDetectedMessage::topic(),
+        EndOfSpeechDetectedMessage::action());
+
+    // the Recognize event is sent with the audio when the Engine starts listening
+    m_messageBroker->subscribe(
+        [=](const std::string& message) {
+            DialogStateChangedMessage msg = json::parse(message);
+            if (msg.payload.state == DialogState::LISTENING) {
+                mark(Stage::RECOGNIZE_SENT);
+            }
+        },
+        DialogStateChangedMessage::topic(),
+        DialogStateChangedMessage::action());
+
+    // the directives of the response are not published, the first one with audio prepares an audio output
+    m_messageBroker->subscribe(
+        [=](const std::string& message) { mark(Stage::FIRST_DIRECTIVE); },
+        PrepareStreamMessage::topic(),
+        PrepareStreamMessage::action());
+
+    m_messageBroker->subscribe(
+        [=](const std::string& message) { mark(Stage::FIRST_DIRECTIVE); },
+        PrepareURLMessage::topic(),
+        PrepareURLMessage::action());
+}
+
+void VoiceBenchmark::setupUI() {
+    auto activity = m_activity.lock();
+    if (!activity) {
+        return;
+    }
+    activity->registerObserver(Event::onAudioOutputFirstByte, [=](const std::string& value) {
+        if (value == SPEECH_CHANNEL) {
+            mark(Stage::TTS_FIRST_BYTE);
+        }
+        return false;
+    });
+    activity->registerObserver(Event::onAudioOutputPlay, [=](const std::string& value) {
+        if (value == SPEECH_CHANNEL) {
+            mark(Stage::FIRST_AUDIO_PLAYED);
+        }
+        return false;
+    });
+}
+
+std::string VoiceBenchmark::next() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running) {
+        std::map<Stage, double> result;
+        std::stringstream ss;
+        ss << "iteration " << m_results.size() + 1 << ":";
+        for (auto& stage : m_stages) {
+            auto latency = std::chrono::duration<double, std::milli>(stage.second - m_start).count();
+            result[stage.first] = latency;
+            ss << ' ' << stageToString(stage.first) << '=' << latency;
+        }
+        log(logger::LoggerHandler::Level::INFO, ss.str());
+        m_results.push_back(result);
+        m_running = false;
+    }
+
+    auto total = m_audioFilePaths.size() * static_cast<size_t>(std::max(m_iterations, 0));
+    if (m_next >= total) {
+        return {};
+    }
+
+    // each iteration injects all the audio files in turn, so each file sees the same conditions
+    auto audioFilePath = m_audioFilePaths[m_next % m_audioFilePaths.size()];
+    m_next++;
+    m_stages.clear();
+    m_start = Clock::now();
+    m_running = true;
+    return audioFilePath;
+}
+
+bool VoiceBenchmark::isWakeword() {
+    return m_wakeword;
+}
+
+void VoiceBenchmark::mark(Stage stage) {
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // only the first time of each stage in an interaction is measured, such as the first of several directives
+    if (m_running) {
+        m_stages.emplace(stage, now);
+    }
+}
+
+std::string VoiceBenchmark::getReport() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<std::pair<std::string, std::vector<double>>> rows;
+    for (auto stage : STAGES) {
+        rows.push_back({stageToString(stage), {}});
+    }
+    // the response latency perceived by the user, from the end of the speech to the first audio played
+    rows.push_back({"EndOfSpeechToFirstAudio", {}});
+    for (auto& result : m_results) {
+        for (size_t j = 0; j < STAGES.size(); j++) {
+            auto it = result.find(STAGES[j]);
+            if (it != result.end()) {
+                rows[j].second.push_back(it->second);
+            }
+        }
+        auto endOfSpeech = result.find(Stage::END_OF_SPEECH);
+        auto firstAudio = result.find(Stage::FIRST_AUDIO_PLAYED);
+        if (endOfSpeech != result.end() && firstAudio != result.end()) {
+            rows.back().second.push_back(firstAudio->second - endOfSpeech->second);
+        }
+    }
+
+    std::stringstream ss;
+    ss << "Voice benchmark: " << m_results.size() << " iterations of " << m_audioFilePaths.size()
+       << " audio file(s), latency in ms from the start of the audio\n";
+    ss << std::left << std::setw(26) << "Stage" << std::right << std::setw(8) << "Count" << std::setw(10) << "Min"
+       << std::setw(10) << "Median" << std::setw(10) << "P90" << std::setw(10) << "Max" << '\n';
+    ss << std::fixed << std::setprecision(1);
+    for (auto& row : rows) {
+        auto& values = row.second;
+        ss << std::left << std::setw(26) << row.first << std::right << std::setw(8) << values.size();
+        if (values.empty()) {
+            ss << std::setw(10) << '-' << std::setw(10) << '-' << std::setw(10) << '-' << std::setw(10) << '-' << '\n';
+            continue;
+        }
+        // nearest rank percentiles
+        std::sort(values.begin(), values.end());
+        auto percentile = [&values](double p) { return values[static_cast<size_t>(p * (values.size() - 1) + 0.5)]; };
+        ss << std::setw(10) << values.front() << std::setw(10) << percentile(0.5) << std::setw(10) << percentile(0.9)
+           << std::setw(10) << values.back() << '\n';
+    }
+    return ss.str();
+}
+
+std::string VoiceBenchmark::stageToString(Stage stage) {
+    switch (stage) {
+        case Stage::WAKEWORD_DETECTED:
+            return "WakewordDetected";
+        case Stage::RECOGNIZE_SENT:
+            return "RecognizeSent";
+        case Stage::END_OF_SPEECH:
+            return "EndOfSpeech";
+        case Stage::FIRST_DIRECTIVE:
+            return "FirstDirective";
+        case Stage::TTS_FIRST_BYTE:
+            return "TTSFirstByte";
+        case Stage::FIRST_AUDIO_PLAYED:
+            return "FirstAudioPlayed";
+    }
+    return "Unknown";
+}
+
+void VoiceBenchmark::log(logger::LoggerHandler::Level level, const std::string& message) {
+    auto loggerHandler = m_loggerHandler.lock();
+    if (!loggerHandler) {
+        return;
+    }
+    loggerHandler->log(level, "VoiceBenchmark", message);
+}
+
+}  // namespace benchmark
+}  // namespace sampleApp
@@ -0,0 +1,411 @@
+/*
+ * Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "SampleApp/Dashboard/Dashboard.h"
+
+#include <AACE/Engine/Logger/EngineLogger.h>
+#include <AACE/Engine/Utils/Threading/ExecutorStats.h>
+
+#include <AASB/Message/Audio/AudioOutput/PrepareStreamMessage.h>
+#include <AASB/Message/Audio/AudioOutput/PrepareURLMessage.h>
+
+#ifdef AAC_ALEXA
+#include <AASB/Message/Alexa/AlexaClient/DialogStateChangedMessage.h>
+#include <AASB/Message/Alexa/SpeechRecognizer/EndOfSpeechDetectedMessage.h>
+#include <AASB/Message/Alexa/SpeechRecognizer/WakewordDetectedMessage.h>
+#endif
+
+// C++ Standard Library
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+// JSON for Modern C++
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+namespace sampleApp {
+namespace dashboard {
+
+using namespace aasb::message::audio::audioOutput;
+#ifdef AAC_ALEXA
+using namespace aasb::message::alexa::alexaClient;
+using namespace aasb::message::alexa::speechRecognizer;
+#endif
+
+using ExecutorStats = aace::engine::utils::threading::ExecutorStats;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Dashboard
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// The channel of the Alexa speech, whose first audio ends the response of a voice turn
+static const std::string SPEECH_CHANNEL = "SpeechSynthesizer";
+
+/// The prefix of the names of the message broker dispatch lanes
+static const std::string MESSAGE_BROKER_LANE_PREFIX = "MessageBroker.";
+
+/// The number of topics shown in the message broker section
+static const size_t MAX_TOPICS = 8;
+
+/// The latencies of a voice turn shown in the dashboard, from one stage to another
+static const std::vector<std::pair<Dashboard::Stage, Dashboard::Stage>> VOICE_TURN_LATENCIES = {
+    {Dashboard::Stage::WAKEWORD_DETECTED, Dashboard::Stage::LISTENING},
+    {Dashboard::Stage::LISTENING, Dashboard::Stage::END_OF_SPEECH},
+    {Dashboard::Stage::END_OF_SPEECH, Dashboard::Stage::FIRST_DIRECTIVE},
+    {Dashboard::Stage::FIRST_DIRECTIVE, Dashboard::Stage::FIRST_AUDIO_PLAYED},
+    {Dashboard::Stage::END_OF_SPEECH, Dashboard::Stage::FIRST_AUDIO_PLAYED}};
+
+/// Returns the rate of a counter between two prints, in events per second
+static double rate(uint64_t current, uint64_t previous, double elapsed) {
+    return elapsed > 0 && current >= previous ? (current - previous) / elapsed : 0;
+}
+
+/// Returns a duration in milliseconds, as printed in the dashboard
+static std::string formatMs(std::chrono::steady_clock::duration duration) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(0) << std::chrono::duration<double, std::milli>(duration).count();
+    return ss.str();
+}
+
+Dashboard::Dashboard(
+    std::weak_ptr<Activity> activity,
+    std::weak_ptr<logger::LoggerHandler> loggerHandler,
+    std::shared_ptr<aace::core::MessageBroker> messageBroker,
+    std::weak_ptr<audio::AudioInputProviderHandler> audioInputProvider,
+    std::weak_ptr<audio::AudioOutputProviderHandler> audioOutputProvider) :
+        m_activity{std::move(activity)},
+        m_loggerHandler{std::move(loggerHandler)},
+        m_messageBroker{std::move(messageBroker)},
+        m_audioInputProvider{std::move(audioInputProvider)},
+        m_audioOutputProvider{std::move(audioOutputProvider)},
+        m_previousTime{Clock::now()} {
+    subscribeToAASBMessages();
+}
+
+Dashboard::~Dashboard() {
+    stopLive();
+}
+
+void Dashboard::subscribeToAASBMessages() {
+    // a subscription without a topic receives all the messages published by the Engine
+    m_messageBroker->subscribe([=](const std::string& message) { countMessage(message); });
+
+    // the directives of the response are not published, the first one with audio prepares an audio output
+    m_messageBroker->subscribe(
+        [=](const std::string& message) { mark(Stage::FIRST_DIRECTIVE); },
+        PrepareStreamMessage::topic(),
+        PrepareStreamMessage::action());
+
+    m_messageBroker->subscribe(
+        [=](const std::string& message) { mark(Stage::FIRST_DIRECTIVE); },
+        PrepareURLMessage::topic(),
+        PrepareURLMessage::action());
+
+#ifdef AAC_ALEXA
+    m_messageBroker->subscribe(
+        [=](const std::string& message) { mark(Stage::WAKEWORD_DETECTED); },
+        WakewordDetectedMessage::topic(),
+        WakewordDetectedMessage::action());
+
+    m_messageBroker->subscribe(
+        [=](const std::string& message) { mark(Stage::END_OF_SPEECH); },
+        EndOfSpeechDetectedMessage::topic(),
+        EndOfSpeechDetectedMessage::action());
+
+    m_messageBroker->subscribe(
+        [=](const std::string& message) {
+            DialogStateChangedMessage msg = json::parse(message);
+            if (msg.payload.state == DialogState::LISTENING) {
+                mark(Stage::LISTENING);
+            } else if (msg.payload.state == DialogState::IDLE) {
+                // the turn is complete when the dialog ends
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_turn.empty()) {
+                    m_turns.push_back(std::move(m_turn));
+                    m_turn.clear();
+                    if (m_turns.size() > MAX_VOICE_TURNS) {
+                        m_turns.pop_front();
+                    }
+                }
+            }
+        },
+        DialogStateChangedMessage::topic(),
+        DialogStateChangedMessage::action());
+#endif
+}
+
+void Dashboard::setupUI() {
+    auto activity = m_activity.lock();
+    if (!activity) {
+        return;
+    }
+    m_console = activity->findViewById("id:console");
+
+    activity->registerObserver(Event::onAudioOutputPlay, [=](const std::string& value) {
+        if (value == SPEECH_CHANNEL) {
+            mark(Stage::FIRST_AUDIO_PLAYED);
+        }
+        return false;
+    });
+
+    // onDashboardShow
+    activity->registerObserver(Event::onDashboardShow, [=](const std::string&) {
+        log(logger::LoggerHandler::Level::VERBOSE, "onDashboardShow");
+        printReport();
+        return true;
+    });
+
+    // onDashboardStartLive
+    activity->registerObserver(Event::onDashboardStartLive, [=](const std::string& value) {
+        log(logger::LoggerHandler::Level::VERBOSE, "onDashboardStartLive:" + value);
+        auto interval = std::chrono::seconds(5);
+        try {
+            if (!value.empty()) {
+                interval = std::chrono::seconds(std::max(1, std::stoi(value)));
+            }
+        } catch (std::exception& ex) {
+            log(logger::LoggerHandler::Level::WARN, "invalid interval: " + value);
+        }
+        startLive(interval);
+        return true;
+    });
+
+    // onDashboardStopLive
+    activity->registerObserver(Event::onDashboardStopLive, [=](const std::string&) {
+        log(logger::LoggerHandler::Level::VERBOSE, "onDashboardStopLive");
+        stopLive();
+        return true;
+    });
+}
+
+void Dashboard::startLive(std::chrono::seconds interval) {
+    stopLive();
+    printReport();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // the timer only queues the print, so building the dashboard doesn't delay the other timers of the Engine
+    std::weak_ptr<Dashboard> weakSelf = shared_from_this();
+    m_timer = TimerWheel::getDefault()->submitPeriodic(interval, [weakSelf]() {
+        if (auto self = weakSelf.lock()) {
+            self->m_executor.submit([weakSelf]() {
+                if (auto self = weakSelf.lock()) {
+                    self->printReport();
+                }
+            });
+        }
+    });
+}
+
+void Dashboard::stopLive() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_timer != TimerWheel::INVALID_TIMER) {
+        TimerWheel::getDefault()->cancel(m_timer);
+        m_timer = TimerWheel::INVALID_TIMER;
+    }
+}
+
+void Dashboard::printReport() {
+    auto report = getReport();
+    if (auto activity = m_activity.lock()) {
+        activity->runOnUIThread([=]() {
+            if (auto console = m_console.lock()) {
+                console->print(report);
+            }
+        });
+    }
+}
+
+std::string Dashboard::getReport() {
+    std::unordered_map<std::string, uint64_t> messages;
+    std::deque<std::map<Stage, Clock::time_point>> turns;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        messages = m_messages;
+        turns = m_turns;
+    }
+    // the report updates the counters of the previous print
+    std::lock_guard<std::mutex> lock(m_reportMutex);
+    auto now = Clock::now();
+    auto elapsed = std::chrono::duration<double>(now - m_previousTime).count();
+    m_previousTime = now;
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::endl;
+    ss << "################################################################################" << std::endl;
+    ss << "#                            Performance Dashboard                             #" << std::endl;
+    ss << "################################################################################" << std::endl;
+
+    // the messages published by the Engine, the busiest topics first
+    uint64_t total = 0;
+    uint64_t previousTotal = 0;
+    std::vector<std::pair<double, std::string>> topics;
+    for (auto& next : messages) {
+        auto previous = m_previousMessages[next.first];
+        total += next.second;
+        previousTotal += previous;
+        topics.emplace_back(rate(next.second, previous, elapsed), next.first);
+    }
+    std::sort(topics.begin(), topics.end(), [](const std::pair<double, std::string>& a,
+                                               const std::pair<double, std::string>& b) { return a.first > b.first; });
+    ss << std::endl << "Message broker: " << total << " messages from the Engine, ";
+    ss << rate(total, previousTotal, elapsed) << " msg/s" << std::endl;
+    for (size_t i = 0; i < topics.size() && i < MAX_TOPICS && topics[i].first > 0; i++) {
+        ss << "  " << std::left << std::setw(40) << topics[i].second << std::right << std::setw(10)
+           << topics[i].first << " msg/s" << std::endl;
+    }
+    m_previousMessages = messages;
+
+    // the dispatch lanes of the message broker and the other named executors
+    std::stringstream lanes;
+    std::stringstream executors;
+    for (auto& snapshot : ExecutorStats::getSnapshots()) {
+        auto& out = snapshot.name.compare(0, MESSAGE_BROKER_LANE_PREFIX.size(), MESSAGE_BROKER_LANE_PREFIX) == 0
+                        ? lanes
+                        : executors;
+        auto tasksPerSecond = rate(snapshot.completedTasks, m_previousCompletedTasks[snapshot.name], elapsed);
+        m_previousCompletedTasks[snapshot.name] = snapshot.completedTasks;
+        auto averageWaitUs = snapshot.waitTime.count > 0 ? snapshot.waitTime.totalUs / snapshot.waitTime.count : 0;
+        out << "  " << std::left << std::setw(32) << snapshot.name << std::right << std::setw(6) << snapshot.queueDepth
+            << std::setw(6) << snapshot.maxQueueDepth << std::setw(10) << tasksPerSecond << std::setw(10)
+            << averageWaitUs << std::setw(10) << snapshot.runTime.maxUs;
+        if (snapshot.running) {
+            out << "  running " << formatMs(snapshot.runningFor) << " ms";
+        }
+        out << std::endl;
+    }
+    std::stringstream header;
+    header << "  " << std::left << std::setw(32) << "name" << std::right << std::setw(6) << "depth" << std::setw(6)
+           << "max" << std::setw(10) << "tasks/s" << std::setw(10) << "avgWaitUs" << std::setw(10) << "maxRunUs"
+           << std::endl;
+    ss << std::endl << "Message broker lanes" << std::endl << header.str() << lanes.str();
+    ss << std::endl << "Executors" << std::endl << header.str() << executors.str();
+
+    // the audio streamed between the application and the Engine
+    ss << std::endl << "Audio" << std::endl;
+    auto audioInputProvider = m_audioInputProvider.lock();
+    auto audioOutputProvider = m_audioOutputProvider.lock();
+    if (audioInputProvider != nullptr) {
+        auto stats = audioInputProvider->getStats();
+        ss << "  input: " << (stats.running ? "streaming" : "stopped") << ", " << stats.writtenBytes
+           << " bytes written, " << stats.rejectedBytes << " bytes rejected by a full Engine buffer" << std::endl;
+    }
+    if (audioOutputProvider != nullptr) {
+        auto stats = audioOutputProvider->getStats();
+        ss << "  output: " << (stats.playing ? (stats.paused ? "paused" : "playing") : "stopped") << " at "
+           << stats.positionMs << " ms, " << stats.openStreams << " streams open, " << stats.streamedBytes
+           << " bytes read" << std::endl;
+    }
+    if (audioInputProvider == nullptr && audioOutputProvider == nullptr) {
+        ss << "  the audio is provided by the Engine" << std::endl;
+    }
+
+    // the log entries dropped by the asynchronous queue of the Engine logger
+    auto droppedEntries = aace::engine::logger::EngineLogger::getInstance()->getDroppedEntries();
+    ss << std::endl << "Logger: " << droppedEntries << " entries dropped, ";
+    ss << rate(droppedEntries, m_previousDroppedEntries, elapsed) << " entries/s" << std::endl;
+    m_previousDroppedEntries = droppedEntries;
+
+    // the heap memory of the modules
+    ss << std::endl << "Memory" << std::endl;
+    if (MemoryAccounting::isEnabled()) {
+        ss << "  " << std::left << std::setw(32) << "module" << std::right << std::setw(12) << "liveKB"
+           << std::setw(12) << "peakKB" << std::setw(12) << "allocs/s" << std::endl;
+        for (auto& snapshot : MemoryAccounting::getSnapshots()) {
+            if (snapshot.allocations == 0) {
+                continue;
+            }
+            auto it = m_previousMemory.find(snapshot.module);
+            auto allocationRate =
+                it != m_previousMemory.end() ? MemoryAccounting::getAllocationRate(it->second, snapshot) : 0;
+            ss << "  " << std::left << std::setw(32) << (snapshot.module.empty() ? "untagged" : snapshot.module)
+               << std::right << std::setw(12) << snapshot.liveBytes / 1024.0 << std::setw(12)
+               << snapshot.peakBytes / 1024.0 << std::setw(12) << allocationRate << std::endl;
+            m_previousMemory[snapshot.module] = snapshot;
+        }
+    } else {
+        ss << "  not accounted, the Engine is built without AAC_MEMORY_ACCOUNTING" << std::endl;
+    }
+
+    // the latency breakdown of the recent voice turns, in milliseconds
+    ss << std::endl << "Voice turns (ms)" << std::endl;
+    ss << "  " << std::setw(10) << "WW>Listen" << std::setw(12) << "Listen>EOS" << std::setw(12) << "EOS>Dir"
+       << std::setw(12) << "Dir>Audio" << std::setw(12) << "EOS>Audio" << std::endl;
+    for (auto& turn : turns) {
+        ss << "  ";
+        auto width = 10;
+        for (auto& latency : VOICE_TURN_LATENCIES) {
+            auto from = turn.find(latency.first);
+            auto to = turn.find(latency.second);
+            auto found = from != turn.end() && to != turn.end();
+            ss << std::setw(width) << (found ? formatMs(to->second - from->second) : "-");
+            width = 12;
+        }
+        ss << std::endl;
+    }
+    if (turns.empty()) {
+        ss << "  no voice turn yet" << std::endl;
+    }
+    return ss.str();
+}
+
+void Dashboard::countMessage(const std::string& message) {
+    auto topic = getTopic(message);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_messages[topic]++;
+}
+
+void Dashboard::mark(Stage stage) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // a turn starts with the wake word, or when the Engine starts listening for a tap-to-talk
+    if (stage == Stage::WAKEWORD_DETECTED || (stage == Stage::LISTENING && m_turn.count(Stage::LISTENING) > 0)) {
+        m_turn.clear();
+    }
+    if (m_turn.empty() && stage != Stage::WAKEWORD_DETECTED && stage != Stage::LISTENING) {
+        return;
+    }
+    // only the first time of each stage is kept, such as the first directive of the response
+    m_turn.insert({stage, Clock::now()});
+}
+
+void Dashboard::log(logger::LoggerHandler::Level level, const std::string& message) {
+    auto loggerHandler = m_loggerHandler.lock();
+    if (!loggerHandler) {
+        return;
+    }
+    loggerHandler->log(level, "Dashboard", message);
+}
+
+std::string Dashboard::getTopic(const std::string& message) {
+    // the topic is the first "topic" member of the message header
+    auto key = message.find("\"topic\"");
+    if (key == std::string::npos) {
+        return "unknown";
+    }
+    auto start = message.find('"', message.find(':', key));
+    if (start == std::string::npos) {
+        return "unknown";
+    }
+    auto end = message.find('"', start + 1);
+    if (end == std::string::npos) {
+        return "unknown";
+    }
+    return message.substr(start + 1, end - start - 1);
+}
+
+}  // namespace dashboard
+}  // namespace sampleApp
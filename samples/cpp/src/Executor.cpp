@@ -15,6 +15,9 @@
 
 #include "SampleApp/Executor.h"
 
+// C++ Standard Library
+#include <mutex>
+
 namespace sampleApp {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -23,10 +26,18 @@ namespace sampleApp {
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Executor::Executor() :
-        m_taskQueue{std::make_shared<TaskQueue>()},
-        m_taskThread{std::unique_ptr<TaskThread>(new TaskThread(m_taskQueue))} {
-    m_taskThread->start();
+const size_t Executor::DEFAULT_THREAD_COUNT;
+
+/// Guards the thread pool of the executors
+static std::mutex s_threadPoolMutex;
+
+/// The thread pool of the executors, created on first use if it isn't set
+static std::shared_ptr<Executor::ThreadPool> s_threadPool;
+
+Executor::Executor() : m_serialExecutor{getThreadPool()} {
+}
+
+Executor::Executor(const std::string& name) : m_serialExecutor{name, getThreadPool()} {
 }
 
 Executor::~Executor() {
@@ -34,20 +45,28 @@ Executor::~Executor() {
 }
 
 void Executor::waitForSubmittedTasks() {
-    std::promise<void> flushedPromise;
-    auto flushedFuture = flushedPromise.get_future();
-    auto task = [&flushedPromise]() { flushedPromise.set_value(); };
-    submit(task);
-    flushedFuture.get();
+    m_serialExecutor.waitForSubmittedTasks();
 }
 
 void Executor::shutdown() {
-    m_taskQueue->shutdown();
-    m_taskThread.reset();
+    m_serialExecutor.shutdown();
 }
 
 bool Executor::isShutdown() {
-    return m_taskQueue->isShutdown();
+    return m_serialExecutor.isShutdown();
+}
+
+std::shared_ptr<Executor::ThreadPool> Executor::getThreadPool() {
+    std::lock_guard<std::mutex> lock(s_threadPoolMutex);
+    if (s_threadPool == nullptr) {
+        s_threadPool = ThreadPool::create(DEFAULT_THREAD_COUNT, "SampleApp");
+    }
+    return s_threadPool;
+}
+
+void Executor::setThreadPool(std::shared_ptr<ThreadPool> threadPool) {
+    std::lock_guard<std::mutex> lock(s_threadPoolMutex);
+    s_threadPool = std::move(threadPool);
 }
 
 }  // namespace sampleApp
@@ -16,6 +16,7 @@
 #include "SampleApp/Application.h"
 #include "SampleApp/ApplicationContext.h"
 #include "SampleApp/Args.h"
+#include "SampleApp/Executor.h"
 #include "SampleApp/Status.h"
 #include "SampleApp/TTY.h"
 
@@ -24,6 +25,7 @@ using Status = sampleApp::Status;
 
 // C++ Standard Library
 #include <csignal>   // std::signal and SIG_ERR macro
+#include <cstdlib>   // std::atoi
 #include <fstream>   // std::ifstream and std::ifstream::in
 #include <iostream>  // std::cerr and std::cout
 #include <memory>    // std::unique_ptr
@@ -91,6 +93,13 @@ static void usageExit(std::string& name) {
                  "  --audio-input-device DEVICE\n"
                  "      Specify the audio input device.\n"
                  "\n"
+                 "  --benchmark ITERATIONS\n"
+                 "      Measure the voice latency over the given number of iterations of the audio files,\n"
+                 "      given as arguments, and print the latency breakdown.\n"
+                 "\n"
+                 "  --benchmark-wake-word\n"
+                 "      The benchmark audio files start with the wake word (default is tap-to-talk).\n"
+                 "\n"
                  "  --browser COMMAND\n"
                  "      Open URL with the specified browser.\n"
                  "\n"
@@ -107,6 +116,12 @@ static void usageExit(std::string& name) {
                  "  --single-threaded-ui\n"
                  "      Application UI runs on the main thread (default is async).\n"
                  "\n"
+                 "  --thread-pool-size SIZE\n"
+                 "      Number of threads shared by the application executors (default 4).\n"
+                 "\n"
+                 "  --engine-thread-pool\n"
+                 "      Application executors share the threads of the Engine thread pool.\n"
+                 "\n"
                  "  --disable-auto-authorization COMMAND\n"
                  "      Disable the starting previously active authorization.\n"
                  "\n"
@@ -132,6 +147,8 @@ int main(int argc, const char* argv[]) {
         auto applicationContext = sampleApp::ApplicationContext::create(name);
         Ensures(applicationContext != nullptr);
         auto cbreak = false;
+        auto engineThreadPool = false;
+        auto threadPoolSize = 0;
         auto options = true;
         for (size_t i = 0; i < size; ++i) {
             auto arg = list[i];
@@ -186,6 +203,18 @@ int main(int argc, const char* argv[]) {
                     }
                     input.close();
                     applicationContext->addMenuFilePath(arg);
+                } else if (c2(arg, ' ', "benchmark")) {
+                    if (++i == size) {
+                        missingArgumentExit(name, arg);
+                    }
+                    arg = list[i];
+                    auto iterations = std::atoi(arg.c_str());
+                    if (iterations <= 0) {
+                        errorExit(name, "invalid benchmark iterations " + arg);
+                    }
+                    applicationContext->setBenchmarkIterations(iterations);
+                } else if (c2(arg, ' ', "benchmark-wake-word")) {
+                    applicationContext->setBenchmarkWakeword(true);
                 } else if (c2(arg, ' ', "browser")) {
                     if (++i == size) {
                         missingArgumentExit(name, arg);
@@ -228,6 +257,17 @@ int main(int argc, const char* argv[]) {
                     std::cerr << "--wake-word option is deprecated (" << support << ")\n";
                 } else if (c2(arg, 'h', "help") || c2(arg, '?')) {
                     usageExit(name);
+                } else if (c2(arg, ' ', "thread-pool-size")) {
+                    if (++i == size) {
+                        missingArgumentExit(name, arg);
+                    }
+                    arg = list[i];
+                    threadPoolSize = std::atoi(arg.c_str());
+                    if (threadPoolSize <= 0) {
+                        errorExit(name, "invalid thread pool size " + arg);
+                    }
+                } else if (c2(arg, ' ', "engine-thread-pool")) {
+                    engineThreadPool = true;
                 } else if (c2(arg, ' ', "disable-auto-authorization")) {
                     applicationContext->setDisableAutoAuthorizationCommand(true);
                 } else {
@@ -243,6 +283,9 @@ int main(int argc, const char* argv[]) {
         if (applicationContext->getMenuFilePaths().empty()) {
             errorExit(name, "Menu file is required");
         }
+        if (applicationContext->getBenchmarkIterations() > 0 && applicationContext->getAudioFilePaths().empty()) {
+            errorExit(name, "Benchmark audio file is required");
+        }
         if (cbreak) {
             Ensures(tty.isatty(fileno(stdin)));
             Ensures(tty.cbreak(fileno(stdin)) != -1);
@@ -254,6 +297,12 @@ int main(int argc, const char* argv[]) {
             // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
             Ensures(std::signal(SIGTERM, cbreakSigCatch) != SIG_ERR);
         }
+        // The thread pool must be set before the application executors are created
+        if (engineThreadPool) {
+            sampleApp::Executor::setThreadPool(sampleApp::Executor::ThreadPool::getDefault());
+        } else if (threadPoolSize > 0) {
+            sampleApp::Executor::setThreadPool(sampleApp::Executor::ThreadPool::create(threadPoolSize, "SampleApp"));
+        }
         std::unique_ptr<Application> application{};
         Status status;
         do {
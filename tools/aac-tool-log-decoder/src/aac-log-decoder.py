@@ -0,0 +1,140 @@
+#!/usr/bin/python3
+#
+# Decodes the binary log files written by the Auto SDK binary log sink (aace.logger.sink.binary), and the dumps
+# written by the flight recorder log sink (aace.logger.sink.flightRecorder), into the plain text format written by
+# the file log sink.
+#
+import argparse, datetime, struct, sys
+
+BINARY_LOG_MAGIC = b"AACBLOG\0"
+BINARY_LOG_VERSION = 1
+
+RECORD_STRING = 0x01
+RECORD_ENTRY = 0x02
+
+# level characters, indexed by the value of aace::logger::LoggerEngineInterface::Level
+LEVELS = "VIMWEC"
+
+
+class DecodeError(Exception):
+    pass
+
+
+class Reader:
+    def __init__(self, data, offset, end):
+        self.data = data
+        self.offset = offset
+        self.end = end
+
+    def remaining(self):
+        return self.end - self.offset
+
+    def byte(self):
+        if self.offset >= self.end:
+            raise DecodeError(f"truncated record at offset {self.offset}")
+        value = self.data[self.offset]
+        self.offset += 1
+        return value
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            next = self.byte()
+            value |= (next & 0x7f) << shift
+            if next < 0x80:
+                return value
+            shift += 7
+
+    def bytes(self, size):
+        if self.offset + size > self.end:
+            raise DecodeError(f"truncated record at offset {self.offset}")
+        value = self.data[self.offset:self.offset + size]
+        self.offset += size
+        return value
+
+    def string(self):
+        return self.bytes(self.varint()).decode("utf-8", errors="replace")
+
+
+def format_time(microseconds):
+    if microseconds == 0:
+        return ""
+    seconds, remainder = divmod(microseconds, 1000000)
+    time = datetime.datetime(1970, 1, 1) + datetime.timedelta(seconds=seconds)
+    return f"{time:%Y-%m-%d %H:%M:%S}.{remainder // 1000:03d}"
+
+
+def decode(data, thread_moniker=True):
+    if len(data) < 32 or data[0:8] != BINARY_LOG_MAGIC:
+        raise DecodeError("not a binary log file")
+    version, header_size, records_size = struct.unpack_from("<IIQ", data, 8)
+    if version != BINARY_LOG_VERSION:
+        raise DecodeError(f"unsupported binary log version {version}")
+
+    reader = Reader(data, header_size, min(len(data), header_size + records_size))
+    strings = {}
+    while reader.remaining() > 0:
+        type = reader.byte()
+        if type == RECORD_STRING:
+            id = reader.varint()
+            strings[id] = reader.string()
+        elif type == RECORD_ENTRY:
+            time = struct.unpack("<q", reader.bytes(8))[0]
+            level = reader.byte()
+            source = strings[reader.varint()]
+            moniker = strings[reader.varint()]
+            sections = reader.byte()
+            if sections == 1:
+                text = reader.string()
+            else:
+                text = strings[reader.varint()] + ":" + strings[reader.varint()]
+                if sections >= 3:
+                    pairs = []
+                    for _ in range(reader.varint()):
+                        key = strings[reader.varint()]
+                        pairs.append(key + "=" + reader.string() if reader.byte() else key)
+                    text += ":" + ",".join(pairs)
+                if sections == 4:
+                    text += ":" + reader.string()
+            line = format_time(time) + " [" + source + "]"
+            if thread_moniker:
+                line += "[" + moniker + "]"
+            yield line + " " + (LEVELS[level] if level < len(LEVELS) else "?") + " " + text
+        else:
+            raise DecodeError(f"unknown record type {type} at offset {reader.offset - 1}")
+
+
+parser = argparse.ArgumentParser(description="Auto SDK binary log decoder")
+
+parser.add_argument("input",
+    metavar="FILE",
+    nargs="+",
+    help="binary log files, decoded in the given order, e.g. aace.blog.2 aace.blog.1 aace.blog"
+)
+
+parser.add_argument("-o", "--output",
+    metavar="FILE",
+    help="file to write the decoded log to, defaults to the standard output"
+)
+
+parser.add_argument("--no-thread-moniker",
+    action="store_true",
+    default=False,
+    help="omit the thread moniker, for SDK builds without thread moniker logs"
+)
+
+args = parser.parse_args()
+output = open(args.output, "w") if args.output else sys.stdout
+try:
+    for filename in args.input:
+        with open(filename, "rb") as file:
+            for line in decode(file.read(), not args.no_thread_moniker):
+                output.write(line + "\n")
+except DecodeError as ex:
+    sys.exit(f"ERROR: {filename}: {ex}")
+except KeyError as ex:
+    sys.exit(f"ERROR: {filename}: undefined string {ex}")
+finally:
+    if output is not sys.stdout:
+        output.close()
@@ -0,0 +1,121 @@
+#!/usr/bin/python3
+#
+# Inspects the message broker recordings written by the traffic recorder (aace.messageBroker.trafficRecorder),
+# and compares the reports written by the traffic replay (aace.messageBroker.trafficReplay).
+#
+import argparse, json, struct, sys
+
+RECORDING_MAGIC = b"AACTRF01"
+
+# the record header: type, time in microseconds, stream id length, data length
+RECORD_HEADER = struct.Struct("<BQHI")
+
+RECORD_TYPES = {1: "INCOMING", 2: "OUTGOING", 3: "STREAM_WRITE", 4: "STREAM_READ"}
+
+
+class DecodeError(Exception):
+    pass
+
+
+def records(data):
+    if data[:len(RECORDING_MAGIC)] != RECORDING_MAGIC:
+        raise DecodeError("not a message broker recording")
+    offset = len(RECORDING_MAGIC)
+    while offset < len(data):
+        if offset + RECORD_HEADER.size > len(data):
+            raise DecodeError(f"truncated record at offset {offset}")
+        type, time, id_size, data_size = RECORD_HEADER.unpack_from(data, offset)
+        offset += RECORD_HEADER.size
+        if offset + id_size + data_size > len(data):
+            raise DecodeError(f"truncated record at offset {offset - RECORD_HEADER.size}")
+        stream_id = data[offset:offset + id_size].decode("utf-8", "replace")
+        offset += id_size
+        yield type, time, stream_id, data[offset:offset + data_size]
+        offset += data_size
+
+
+def dump(args):
+    with open(args.recording, "rb") as file:
+        data = file.read()
+    for type, time, stream_id, payload in records(data):
+        name = RECORD_TYPES.get(type, str(type))
+        if stream_id:
+            if not args.streams:
+                continue
+            line = f"{time / 1000000:12.6f} {name} {stream_id} {len(payload)} bytes"
+        else:
+            header = json.loads(payload).get("header", {})
+            description = header.get("messageDescription", {})
+            line = (f"{time / 1000000:12.6f} {name} {header.get('messageType', '?')} "
+                    f"{description.get('topic', '?')}.{description.get('action', '?')}")
+            if args.payload:
+                line += " " + payload.decode("utf-8", "replace")
+        print(line)
+
+
+def load_topics(filename):
+    with open(filename) as file:
+        report = json.load(file)
+    return report, {(t["direction"], t["topic"], t["action"]): t for t in report.get("topics", [])}
+
+
+def compare(args):
+    baseline, baseline_topics = load_topics(args.baseline)
+    candidate, candidate_topics = load_topics(args.candidate)
+    regressions = 0
+    print(f"{'topic':48} {'metric':16} {'baseline':>10} {'candidate':>10} {'change':>8}")
+    for key in sorted(set(baseline_topics) | set(candidate_topics)):
+        name = f"{key[0]} {key[1]}.{key[2]}"
+        if key not in baseline_topics or key not in candidate_topics:
+            print(f"{name:48} {'only in ' + ('candidate' if key in candidate_topics else 'baseline')}")
+            continue
+        for metric in ["dispatchLatency", "handlerTime", "handlerCpuTime"]:
+            before = baseline_topics[key][metric][args.statistic]
+            after = candidate_topics[key][metric][args.statistic]
+            change = (after - before) / before * 100 if before else 0
+            flag = ""
+            if after - before >= args.min_us and change >= args.threshold:
+                flag = " REGRESSION"
+                regressions += 1
+            print(f"{name:48} {metric:16} {before:10} {after:10} {change:+7.1f}%{flag}")
+    print(f"process CPU time: {baseline['processCpuTimeUs']} us -> {candidate['processCpuTimeUs']} us")
+    return 1 if regressions else 0
+
+
+parser = argparse.ArgumentParser(description="Auto SDK message broker traffic tool")
+commands = parser.add_subparsers(dest="command", required=True)
+
+dump_parser = commands.add_parser("dump", help="print the records of a recording")
+dump_parser.add_argument("recording", metavar="FILE", help="recording written by the traffic recorder")
+dump_parser.add_argument("--payload", action="store_true", help="print the serialized messages")
+dump_parser.add_argument("--streams", action="store_true", help="print the stream data records")
+
+compare_parser = commands.add_parser("compare", help="compare two replay reports, per topic and action")
+compare_parser.add_argument("baseline", metavar="BASELINE", help="replay report of the baseline build")
+compare_parser.add_argument("candidate", metavar="CANDIDATE", help="replay report of the candidate build")
+compare_parser.add_argument("--statistic",
+    choices=["meanUs", "p50Us", "p95Us", "maxUs"],
+    default="p95Us",
+    help="histogram statistic compared, defaults to p95Us"
+)
+compare_parser.add_argument("--threshold",
+    type=float,
+    default=20,
+    help="percent increase reported as a regression, defaults to 20"
+)
+compare_parser.add_argument("--min-us",
+    type=int,
+    default=100,
+    help="smallest increase in microseconds reported as a regression, defaults to 100"
+)
+
+args = parser.parse_args()
+try:
+    if args.command == "dump":
+        dump(args)
+    else:
+        sys.exit(compare(args))
+except DecodeError as ex:
+    sys.exit(f"ERROR: {args.recording}: {ex}")
+except (KeyError, ValueError) as ex:
+    sys.exit(f"ERROR: invalid report or message: {ex}")